@@ -272,6 +272,7 @@ else:
         "bmesh.geometry",
         "bpy.app",
         "bpy.app.handlers",
+        "bpy.app.memory_profiler",
         "bpy.app.timers",
         "bpy.app.translations",
         "bpy.context",
@@ -2287,6 +2288,7 @@ def write_rst_importable_modules(basepath):
         "bpy.app.handlers": "Application Handlers",
         "bpy.app.translations": "Application Translations",
         "bpy.app.icons": "Application Icons",
+        "bpy.app.memory_profiler": "Application Memory Profiler",
         "bpy.app.timers": "Application Timers",
         "bpy.props": "Property Definitions",
         "idprop.types": "ID Property Access",
@@ -48,6 +48,7 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  int checkpoint_interval;
 } options;
 
 static void session_print(const string &str)
@@ -137,7 +138,10 @@ static void session_init()
 
   if (!options.output_filepath.empty()) {
     options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
+        options.output_filepath,
+        options.output_pass,
+        options.checkpoint_interval,
+        session_print));
   }
 
   if (options.session_params.background && !options.quiet)
@@ -405,9 +409,17 @@ static void options_parse(int argc, const char **argv)
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
+             "--sample-offset %d",
+             &options.session_params.sample_offset,
+             "Number of samples to skip, to render different samples of the same image on "
+             "multiple machines",
              "--output %s",
              &options.output_filepath,
              "File path to write output image",
+             "--checkpoint-interval %d",
+             &options.checkpoint_interval,
+             "Also write the output image every N seconds while rendering. An interrupted render "
+             "can be resumed with --sample-offset and merged with the last written image",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
@@ -520,6 +532,14 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.session_params.sample_offset < 0) {
+    fprintf(stderr, "Invalid sample offset: %d\n", options.session_params.sample_offset);
+    exit(EXIT_FAILURE);
+  }
+  else if (options.checkpoint_interval < 0) {
+    fprintf(stderr, "Invalid checkpoint interval: %d\n", options.checkpoint_interval);
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath == "") {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
@@ -5,15 +5,25 @@
 
 #include "scene/colorspace.h"
 
+#include "util/path.h"
+#include "util/time.h"
+
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 
+#include <stdio.h>
+
 CCL_NAMESPACE_BEGIN
 
 OIIOOutputDriver::OIIOOutputDriver(const string_view filepath,
                                    const string_view pass,
+                                   const double checkpoint_interval,
                                    LogFunction log)
-    : filepath_(filepath), pass_(pass), log_(log)
+    : filepath_(filepath),
+      pass_(pass),
+      checkpoint_interval_(checkpoint_interval),
+      last_checkpoint_time_(time_dt()),
+      log_(log)
 {
 }
 
@@ -30,25 +40,69 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
 
   log_(string_printf("Writing image %s", filepath_.c_str()));
 
+  write_image(tile, filepath_);
+}
+
+bool OIIOOutputDriver::update_render_tile(const Tile &tile)
+{
+  if (checkpoint_interval_ <= 0.0 || !(tile.size == tile.full_size) || tile.num_samples == 0) {
+    return false;
+  }
+
+  const double time_now = time_dt();
+  if (time_now - last_checkpoint_time_ < checkpoint_interval_) {
+    return false;
+  }
+  last_checkpoint_time_ = time_now;
+
+  /* Write to a temporary file first, so that the previous checkpoint stays intact if the process
+   * gets killed while writing. */
+  const string checkpoint_filepath = filepath_ + ".tmp";
+  if (!write_image(tile, checkpoint_filepath)) {
+    return false;
+  }
+  if (rename(checkpoint_filepath.c_str(), filepath_.c_str()) != 0) {
+    /* Renaming does not replace existing files on all platforms. */
+    path_remove(filepath_);
+    if (rename(checkpoint_filepath.c_str(), filepath_.c_str()) != 0) {
+      log_("Failed to write checkpoint image");
+      return false;
+    }
+  }
+
+  log_(string_printf(
+      "Wrote checkpoint with %d samples to %s", tile.num_samples, filepath_.c_str()));
+  return true;
+}
+
+bool OIIOOutputDriver::write_image(const Tile &tile, const string &filepath)
+{
+  /* File format is determined from the output file path, also for temporary files. */
   unique_ptr<ImageOutput> image_output(ImageOutput::create(filepath_));
   if (image_output == nullptr) {
     log_("Failed to create image file");
-    return;
+    return false;
   }
 
   const int width = tile.size.x;
   const int height = tile.size.y;
 
   ImageSpec spec(width, height, 4, TypeDesc::FLOAT);
-  if (!image_output->open(filepath_, spec)) {
+
+  /* Store the number of samples the same way as Blender does, so that images rendered with
+   * different sample offsets (e.g. on multiple machines) can be combined with the image merger. */
+  const string layer = (tile.layer.empty()) ? "RenderLayer" : tile.layer;
+  spec.attribute("cycles." + layer + ".samples", TypeDesc::STRING, to_string(tile.num_samples));
+
+  if (!image_output->open(filepath, spec)) {
     log_("Failed to create image file");
-    return;
+    return false;
   }
 
   vector<float> pixels(width * height * 4);
   if (!tile.get_pass_pixels(pass_, 4, pixels.data())) {
     log_("Failed to read render pass pixels");
-    return;
+    return false;
   }
 
   /* Manipulate offset and stride to convert from bottom-up to top-down convention. */
@@ -70,6 +124,8 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
   image_buffer.set_write_format(TypeDesc::FLOAT);
   image_buffer.write(image_output.get());
   image_output->close();
+
+  return true;
 }
 
 CCL_NAMESPACE_END
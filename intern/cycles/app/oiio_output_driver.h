@@ -15,14 +15,24 @@ class OIIOOutputDriver : public OutputDriver {
  public:
   typedef function<void(const string &)> LogFunction;
 
-  OIIOOutputDriver(const string_view filepath, const string_view pass, LogFunction log);
+  /* When checkpoint_interval is non-zero, the image is also written every that many seconds
+   * while rendering, so that an interrupted render can be resumed from the written samples. */
+  OIIOOutputDriver(const string_view filepath,
+                   const string_view pass,
+                   const double checkpoint_interval,
+                   LogFunction log);
   virtual ~OIIOOutputDriver();
 
   void write_render_tile(const Tile &tile) override;
+  bool update_render_tile(const Tile &tile) override;
 
  protected:
+  bool write_image(const Tile &tile, const string &filepath);
+
   string filepath_;
   string pass_;
+  double checkpoint_interval_;
+  double last_checkpoint_time_;
   LogFunction log_;
 };
 
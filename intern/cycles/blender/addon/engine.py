@@ -16,6 +16,10 @@ def _configure_argument_parser():
                              "Valid options are 'CPU', 'CUDA', 'OPTIX', 'HIP', 'ONEAPI', or 'METAL'."
                              "Additionally, you can append '+CPU' to any GPU type for hybrid rendering.",
                         default=None)
+    parser.add_argument("--cycles-compile-kernels-only",
+                        help="Load the render kernels needed by the scene without rendering, to fill the kernel cache. "
+                             "Set the CYCLES_CACHE_PATH environment variable to share the cache between machines.",
+                        action='store_true')
     return parser
 
 
@@ -37,6 +41,10 @@ def _parse_command_line():
         import _cycles
         _cycles.set_device_override(args.cycles_device)
 
+    if args.cycles_compile_kernels_only:
+        import _cycles
+        _cycles.enable_compile_kernels_only()
+
 
 def init():
     import bpy
@@ -347,6 +347,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_denoising_input_passes,
         default='RGB_ALBEDO_NORMAL',
     )
+    denoising_max_memory: IntProperty(
+        name="Denoising Memory Limit",
+        description="Approximate limit of the memory used by OpenImageDenoise, in megabytes. "
+        "Larger images are denoised in overlapping tiles. Zero means no limit",
+        default=0,
+        min=0,
+    )
 
     use_preview_denoising: BoolProperty(
         name="Use Viewport Denoising",
@@ -377,6 +384,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0, max=(1 << 24),
         default=1,
     )
+    preview_denoising_use_async: BoolProperty(
+        name="Asynchronous Viewport Denoising",
+        description="Denoise the viewport in the background while rendering continues. "
+        "The displayed result lags one denoising update behind and uses more memory",
+        default=False,
+    )
 
     samples: IntProperty(
         name="Samples",
@@ -903,6 +916,21 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_texture_limit
     )
 
+    texture_memory_limit: IntProperty(
+        name="Texture Memory Limit",
+        description="Scale down the largest image textures until all of them fit in this amount of memory, in megabytes. "
+        "Pre-filtered MIP levels of tiled .tx files are loaded directly. Zero means no limit",
+        default=0,
+        min=0,
+    )
+
+    use_half_float_textures: BoolProperty(
+        name="Half Float Textures",
+        description="Store floating point image files with half precision, halving their memory usage "
+        "at the cost of precision",
+        default=False,
+    )
+
     use_fast_gi: BoolProperty(
         name="Fast GI Approximation",
         description="Approximate diffuse indirect light with background tinted ambient occlusion. This provides fast alternative to full global illumination, for interactive viewport rendering or final renders with reduced quality",
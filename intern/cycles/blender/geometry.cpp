@@ -240,4 +240,14 @@ void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
   }
 }
 
+bool BlenderSync::geometry_is_modified(Geometry *geom) const
+{
+  /* Geometry that was synced in this loop may still be written to by the task pool, so assume
+   * it is modified instead of reading its sockets. Other geometry is not touched by any task. */
+  if (geometry_synced.find(geom) != geometry_synced.end()) {
+    return true;
+  }
+  return geom->is_modified();
+}
+
 CCL_NAMESPACE_END
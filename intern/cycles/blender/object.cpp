@@ -235,9 +235,12 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
-  /* Use task pool only for non-instances, since sync_dupli_particle accesses
-   * geometry. This restriction should be removed for better performance. */
-  TaskPool *object_geom_task_pool = (is_instance) ? NULL : geom_task_pool;
+  /* Instances of real object data are synced in the task pool like any other object. Geometry
+   * of other instances (e.g. from geometry nodes) is used directly and may be modified while
+   * syncing, so it is synced immediately in case the same data is also used elsewhere. */
+  TaskPool *object_geom_task_pool = (is_instance && !b_ob_info.is_real_object_data()) ?
+                                        NULL :
+                                        geom_task_pool;
 
   /* key to lookup object */
   ObjectKey key(b_parent, persistent_id, b_ob_info.real_object, use_particle_hair);
@@ -325,7 +328,7 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
    * transform comparison should not be needed, but duplis don't work perfect
    * in the depsgraph and may not signal changes, so this is a workaround */
   if (object->is_modified() || object_updated ||
-      (object->get_geometry() && object->get_geometry()->is_modified())) {
+      (object->get_geometry() && geometry_is_modified(object->get_geometry()))) {
     object->name = b_ob.name().c_str();
     object->set_pass_id(b_ob.pass_index());
     const BL::Array<float, 4> object_color = b_ob.color();
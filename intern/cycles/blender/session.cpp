@@ -40,6 +40,7 @@ CCL_NAMESPACE_BEGIN
 DeviceTypeMask BlenderSession::device_override = DEVICE_MASK_ALL;
 bool BlenderSession::headless = false;
 bool BlenderSession::print_render_stats = false;
+bool BlenderSession::compile_kernels_only = false;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -326,6 +327,20 @@ void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_
                             time_human_readable_from_seconds(render_time).c_str());
   b_rr.stamp_data_add_field((prefix + "synchronization_time").c_str(),
                             time_human_readable_from_seconds(total_time - render_time).c_str());
+
+  /* Store time spent in the device kernels and the occupancy of the path states. They are only
+   * collected when CYCLES_DEBUG_PER_KERNEL_PERFORMANCE is set, and are accumulated over the
+   * lifetime of the session. */
+  RenderStats stats;
+  session->collect_device_statistics(&stats);
+  for (const NamedTimeEntry &entry : stats.device_kernels.entries) {
+    b_rr.stamp_data_add_field((prefix + "kernel_time." + entry.name).c_str(),
+                              string_printf("%.6f", entry.time).c_str());
+  }
+  for (size_t i = 0; i < stats.device_occupancy.size(); i++) {
+    b_rr.stamp_data_add_field((prefix + "occupancy." + to_string(i)).c_str(),
+                              string_printf("%.4f", stats.device_occupancy[i]).c_str());
+  }
 }
 
 void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
@@ -410,6 +425,12 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       free_blender_memory_if_possible();
     }
 
+    if (compile_kernels_only) {
+      thread_scoped_lock scene_lock(scene->mutex);
+      scene->load_kernels(session->progress);
+      continue;
+    }
+
     /* Make sure all views have different noise patterns. - hardcoded value just to make it random
      */
     if (view_index != 0) {
@@ -657,7 +678,10 @@ void BlenderSession::bake(BL::Depsgraph &b_depsgraph_,
   session->set_output_driver(make_unique<BlenderOutputDriver>(b_engine));
   session->full_buffer_written_cb = [&](string_view filename) { full_buffer_written(filename); };
 
-  /* Sync scene. */
+  /* Sync scene.
+   * Blender bakes all images and objects of a bake operation with the same engine, so the scene is
+   * only synchronized fully for the first one. Following calls only compare the data against the
+   * existing scene. */
   BL::Object b_camera_override(b_engine.camera_override());
   sync->sync_camera(b_render, b_camera_override, width, height, "");
   sync->sync_data(
@@ -119,6 +119,10 @@ class BlenderSession {
 
   static bool print_render_stats;
 
+  /* Only load the render kernels needed by the scene without rendering anything, which fills the
+   * kernel cache. */
+  static bool compile_kernels_only;
+
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
 
@@ -463,6 +463,8 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
     integrator->set_use_denoise_pass_albedo(denoise_params.use_pass_albedo);
     integrator->set_use_denoise_pass_normal(denoise_params.use_pass_normal);
     integrator->set_denoiser_prefilter(denoise_params.prefilter);
+    integrator->set_denoiser_max_memory(denoise_params.max_memory);
+    integrator->set_use_denoise_async(denoise_params.use_async);
   }
 
   /* UPDATE_NONE as we don't want to tag the integrator as modified (this was done by the
@@ -825,6 +827,8 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   else {
     params.texture_limit = 0;
   }
+  params.texture_memory_limit = (size_t)get_int(cscene, "texture_memory_limit") * 1024 * 1024;
+  params.use_half_float_textures = get_boolean(cscene, "use_half_float_textures");
 
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
@@ -956,6 +960,7 @@ DenoiseParams BlenderSync::get_denoise_params(BL::Scene &b_scene,
     denoising.type = (DenoiserType)get_enum(cscene, "denoiser", DENOISER_NUM, DENOISER_NONE);
     denoising.prefilter = (DenoiserPrefilter)get_enum(
         cscene, "denoising_prefilter", DENOISER_PREFILTER_NUM, DENOISER_PREFILTER_NONE);
+    denoising.max_memory = get_int(cscene, "denoising_max_memory");
 
     input_passes = (DenoiserInput)get_enum(
         cscene, "denoising_input_passes", DENOISER_INPUT_NUM, DENOISER_INPUT_RGB_ALBEDO_NORMAL);
@@ -975,6 +980,7 @@ DenoiseParams BlenderSync::get_denoise_params(BL::Scene &b_scene,
     denoising.prefilter = (DenoiserPrefilter)get_enum(
         cscene, "preview_denoising_prefilter", DENOISER_PREFILTER_NUM, DENOISER_PREFILTER_FAST);
     denoising.start_sample = get_int(cscene, "preview_denoising_start_sample");
+    denoising.use_async = get_boolean(cscene, "preview_denoising_use_async");
 
     input_passes = (DenoiserInput)get_enum(
         cscene, "preview_denoising_input_passes", DENOISER_INPUT_NUM, DENOISER_INPUT_RGB_ALBEDO);
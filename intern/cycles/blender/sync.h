@@ -186,6 +186,8 @@ class BlenderSync {
                             bool use_particle_hair,
                             TaskPool *task_pool);
 
+  bool geometry_is_modified(Geometry *geom) const;
+
   /* Light */
   void sync_light(BL::Object &b_parent,
                   int persistent_id[OBJECT_PERSISTENT_ID_SIZE],
@@ -10,7 +10,9 @@
 
 #include "util/algorithm.h"
 #include "util/boundbox.h"
+#include "util/tbb.h"
 #include "util/types.h"
+#include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -56,6 +58,77 @@ __forceinline int get_best_dimension(const float4 &bestSAH)
 
 /* BVH Object Binning */
 
+void BVHObjectBinning::bin_prims(const BVHReference *prims,
+                                 const size_t prims_start,
+                                 const size_t prims_end,
+                                 BoundBox bin_bounds[][4],
+                                 int4 bin_count[]) const
+{
+  for (size_t i = 0; i < num_bins; i++) {
+    bin_count[i] = make_int4(0);
+    bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
+  }
+
+  /* map geometry to bins, unrolled once */
+  const int64_t num_prims = int64_t(prims_end - prims_start);
+  int64_t i;
+
+  for (i = 0; i < num_prims - 1; i += 2) {
+    prefetch_L2(&prims[prims_start + i + 8]);
+
+    /* map even and odd primitive to bin */
+    const BVHReference &prim0 = prims[prims_start + i + 0];
+    const BVHReference &prim1 = prims[prims_start + i + 1];
+
+    BoundBox bounds0 = get_prim_bounds(prim0);
+    BoundBox bounds1 = get_prim_bounds(prim1);
+
+    int4 bin0 = get_bin(bounds0);
+    int4 bin1 = get_bin(bounds1);
+
+    /* increase bounds for bins for even primitive */
+    int b00 = (int)extract<0>(bin0);
+    bin_count[b00][0]++;
+    bin_bounds[b00][0].grow(bounds0);
+    int b01 = (int)extract<1>(bin0);
+    bin_count[b01][1]++;
+    bin_bounds[b01][1].grow(bounds0);
+    int b02 = (int)extract<2>(bin0);
+    bin_count[b02][2]++;
+    bin_bounds[b02][2].grow(bounds0);
+
+    /* increase bounds of bins for odd primitive */
+    int b10 = (int)extract<0>(bin1);
+    bin_count[b10][0]++;
+    bin_bounds[b10][0].grow(bounds1);
+    int b11 = (int)extract<1>(bin1);
+    bin_count[b11][1]++;
+    bin_bounds[b11][1].grow(bounds1);
+    int b12 = (int)extract<2>(bin1);
+    bin_count[b12][2]++;
+    bin_bounds[b12][2].grow(bounds1);
+  }
+
+  /* for uneven number of primitives */
+  if (i < num_prims) {
+    /* map primitive to bin */
+    const BVHReference &prim0 = prims[prims_start + i];
+    BoundBox bounds0 = get_prim_bounds(prim0);
+    int4 bin0 = get_bin(bounds0);
+
+    /* increase bounds of bins */
+    int b00 = (int)extract<0>(bin0);
+    bin_count[b00][0]++;
+    bin_bounds[b00][0].grow(bounds0);
+    int b01 = (int)extract<1>(bin0);
+    bin_count[b01][1]++;
+    bin_bounds[b01][1].grow(bounds0);
+    int b02 = (int)extract<2>(bin0);
+    bin_count[b02][2]++;
+    bin_bounds[b02][2].grow(bounds0);
+  }
+}
+
 BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
                                    BVHReference *prims,
                                    const BVHUnaligned *unaligned_heuristic,
@@ -87,68 +160,39 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   BoundBox bin_bounds[MAX_BINS][4]; /* bounds for every bin in every dimension */
   int4 bin_count[MAX_BINS];         /* number of primitives mapped to bin */
 
-  for (size_t i = 0; i < num_bins; i++) {
-    bin_count[i] = make_int4(0);
-    bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
+  if (size() < PARALLEL_BINNING_SIZE) {
+    bin_prims(prims, start(), end(), bin_bounds, bin_count);
   }
-
-  /* map geometry to bins, unrolled once */
-  {
-    int64_t i;
-
-    for (i = 0; i < int64_t(size()) - 1; i += 2) {
-      prefetch_L2(&prims[start() + i + 8]);
-
-      /* map even and odd primitive to bin */
-      const BVHReference &prim0 = prims[start() + i + 0];
-      const BVHReference &prim1 = prims[start() + i + 1];
-
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      BoundBox bounds1 = get_prim_bounds(prim1);
-
-      int4 bin0 = get_bin(bounds0);
-      int4 bin1 = get_bin(bounds1);
-
-      /* increase bounds for bins for even primitive */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
-
-      /* increase bounds of bins for odd primitive */
-      int b10 = (int)extract<0>(bin1);
-      bin_count[b10][0]++;
-      bin_bounds[b10][0].grow(bounds1);
-      int b11 = (int)extract<1>(bin1);
-      bin_count[b11][1]++;
-      bin_bounds[b11][1].grow(bounds1);
-      int b12 = (int)extract<2>(bin1);
-      bin_count[b12][2]++;
-      bin_bounds[b12][2].grow(bounds1);
-    }
-
-    /* for uneven number of primitives */
-    if (i < int64_t(size())) {
-      /* map primitive to bin */
-      const BVHReference &prim0 = prims[start() + i];
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      int4 bin0 = get_bin(bounds0);
-
-      /* increase bounds of bins */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
+  else {
+    /* Bin blocks of primitives in parallel, and merge the bins afterwards. This is mainly to speed
+     * up the top levels of the tree, where the binning of all primitives is not threaded by the
+     * builder yet. Merging happens in a fixed order, so the result is deterministic. */
+    struct Bins {
+      BoundBox bounds[MAX_BINS][4];
+      int4 count[MAX_BINS];
+    };
+    const size_t num_blocks = divide_up(size(), PARALLEL_BINNING_SIZE);
+    vector<Bins> block_bins(num_blocks);
+
+    parallel_for(blocked_range<size_t>(0, num_blocks, 1), [&](const blocked_range<size_t> &r) {
+      for (size_t block = r.begin(); block != r.end(); block++) {
+        const size_t block_start = start() + block * PARALLEL_BINNING_SIZE;
+        const size_t block_end = min(block_start + PARALLEL_BINNING_SIZE, size_t(end()));
+        bin_prims(
+            prims, block_start, block_end, block_bins[block].bounds, block_bins[block].count);
+      }
+    });
+
+    for (size_t i = 0; i < num_bins; i++) {
+      bin_count[i] = make_int4(0);
+      bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
+
+      for (const Bins &bins : block_bins) {
+        bin_count[i] = bin_count[i] + bins.count[i];
+        bin_bounds[i][0] = merge(bin_bounds[i][0], bins.bounds[i][0]);
+        bin_bounds[i][1] = merge(bin_bounds[i][1], bins.bounds[i][1]);
+        bin_bounds[i][2] = merge(bin_bounds[i][2], bins.bounds[i][2]);
+      }
     }
   }
 
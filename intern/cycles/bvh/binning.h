@@ -57,6 +57,15 @@ class BVHObjectBinning : public BVHRange {
 
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
+  /* Ranges with at least this many primitives are binned in parallel, in blocks of this size. */
+  enum { PARALLEL_BINNING_SIZE = 65536 };
+
+  /* Map primitives in the given range to bins, initializing the bins. */
+  void bin_prims(const BVHReference *prims,
+                 const size_t prims_start,
+                 const size_t prims_end,
+                 BoundBox bin_bounds[][4],
+                 int4 bin_count[]) const;
 
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
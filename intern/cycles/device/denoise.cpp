@@ -67,6 +67,10 @@ NODE_DEFINE(DenoiseParams)
 
   SOCKET_ENUM(prefilter, "Prefilter", *prefilter_enum, DENOISER_PREFILTER_FAST);
 
+  SOCKET_INT(max_memory, "Max Memory", 0);
+
+  SOCKET_BOOLEAN(use_async, "Use Async", false);
+
   return type;
 }
 
@@ -64,6 +64,14 @@ class DenoiseParams : public Node {
 
   DenoiserPrefilter prefilter = DENOISER_PREFILTER_FAST;
 
+  /* Approximate limit of the scratch memory used by the denoiser, in megabytes. Zero means no
+   * limit. OpenImageDenoise stays within the limit by denoising the image in overlapping tiles. */
+  int max_memory = 0;
+
+  /* Denoise intermediate viewport results in the background while path tracing continues.
+   * The last sample is always denoised synchronously. */
+  bool use_async = false;
+
   static const NodeEnum *get_type_enum();
   static const NodeEnum *get_prefilter_enum();
 
@@ -74,7 +82,8 @@ class DenoiseParams : public Node {
     return !(use == other.use && type == other.type && start_sample == other.start_sample &&
              use_pass_albedo == other.use_pass_albedo &&
              use_pass_normal == other.use_pass_normal &&
-             temporally_stable == other.temporally_stable && prefilter == other.prefilter);
+             temporally_stable == other.temporally_stable && prefilter == other.prefilter &&
+             max_memory == other.max_memory && use_async == other.use_async);
   }
 };
 
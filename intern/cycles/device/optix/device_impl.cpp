@@ -92,6 +92,14 @@ OptiXDevice::OptiXDevice(const DeviceInfo &info, Stats &stats, Profiler &profile
       context, options.logCallbackFunction, options.logCallbackData, options.logCallbackLevel));
 #  endif
 
+  /* Store compiled OptiX modules and pipelines next to the other kernels when the cache location
+   * is overridden, otherwise keep the default location of the driver. */
+  if (getenv("CYCLES_CACHE_PATH")) {
+    const string optix_cache_path = path_cache_get("optix");
+    path_create_directories(path_join(optix_cache_path, ""));
+    optix_assert(optixDeviceContextSetCacheLocation(context, optix_cache_path.c_str()));
+  }
+
   /* Fix weird compiler bug that assigns wrong size. */
   launch_params.data_elements = sizeof(KernelParamsOptiX);
 
@@ -53,7 +53,7 @@ DeviceQueue::~DeviceQueue()
 
 void DeviceQueue::debug_init_execution()
 {
-  if (VLOG_DEVICE_STATS_IS_ON) {
+  if (VLOG_DEVICE_STATS_IS_ON || is_per_kernel_performance_) {
     last_sync_time_ = time_dt();
   }
 
@@ -72,17 +72,20 @@ void DeviceQueue::debug_enqueue_begin(DeviceKernel kernel, const int work_size)
 
 void DeviceQueue::debug_enqueue_end()
 {
-  if (VLOG_DEVICE_STATS_IS_ON && is_per_kernel_performance_) {
+  if (is_per_kernel_performance_) {
     synchronize();
   }
 }
 
 void DeviceQueue::debug_synchronize()
 {
-  if (VLOG_DEVICE_STATS_IS_ON) {
+  if (VLOG_DEVICE_STATS_IS_ON || is_per_kernel_performance_) {
     const double new_time = time_dt();
     const double elapsed_time = new_time - last_sync_time_;
-    VLOG_DEVICE_STATS << "GPU queue synchronize, elapsed " << std::setw(10) << elapsed_time << "s";
+    if (VLOG_DEVICE_STATS_IS_ON) {
+      VLOG_DEVICE_STATS << "GPU queue synchronize, elapsed " << std::setw(10) << elapsed_time
+                        << "s";
+    }
 
     /* There is no sense to have an entries in the performance data
      * container without related kernel information. */
@@ -153,6 +153,22 @@ class DeviceQueue {
     return nullptr;
   }
 
+  /* Accumulated execution time for combinations of kernels launched together.
+   *
+   * The times are only recorded when device statistics logging is enabled or when the
+   * CYCLES_DEBUG_PER_KERNEL_PERFORMANCE environment variable is set. In the latter case the queue
+   * is synchronized after every kernel, so that every entry corresponds to a single kernel. */
+  const map<DeviceKernelMask, double> &get_kernel_stats() const
+  {
+    return stats_kernel_time_;
+  }
+
+  /* Whether the CYCLES_DEBUG_PER_KERNEL_PERFORMANCE environment variable is set. */
+  bool is_per_kernel_performance() const
+  {
+    return is_per_kernel_performance_;
+  }
+
   /* Device this queue has been created for. */
   Device *device;
 
@@ -11,6 +11,7 @@
 #include "scene/object.h"
 #include "scene/scene.h"
 #include "util/hash.h"
+#include "util/tbb.h"
 
 #include <pxr/imaging/hd/sceneDelegate.h>
 
@@ -151,15 +152,21 @@ void HdCyclesGeometry<Base, CyclesBase>::Sync(HdSceneDelegate *sceneDelegate,
       InitializeInstance(static_cast<int>(i));
     }
 
-    // Update transforms of all instances
-    for (size_t i = 0; i < transforms.size(); ++i) {
-      const float metersPerUnit =
-          static_cast<HdCyclesSession *>(renderParam)->GetStageMetersPerUnit();
-
-      const Transform tfm = transform_scale(make_float3(metersPerUnit)) *
-                            convert_transform(_geomTransform * transforms[i]);
-      _instances[i]->set_tfm(tfm);
-    }
+    // Update transforms of all instances, in parallel since instancers can have millions of them
+    const float metersPerUnit =
+        static_cast<HdCyclesSession *>(renderParam)->GetStageMetersPerUnit();
+    const Transform scale = transform_scale(make_float3(metersPerUnit));
+    // Use const access, the non-const array accessors are not thread-safe
+    const GfMatrix4d *transformsData = transforms.cdata();
+    static const int INSTANCES_PER_TASK = 1024;
+    parallel_for(blocked_range<size_t>(0, transforms.size(), INSTANCES_PER_TASK),
+                 [&](const blocked_range<size_t> &r) {
+                   for (size_t i = r.begin(); i != r.end(); ++i) {
+                     const Transform tfm = scale *
+                                           convert_transform(_geomTransform * transformsData[i]);
+                     _instances[i]->set_tfm(tfm);
+                   }
+                 });
   }
 
   if (HdChangeTracker::IsVisibilityDirty(*dirtyBits, id)) {
@@ -173,12 +180,17 @@ void HdCyclesGeometry<Base, CyclesBase>::Sync(HdSceneDelegate *sceneDelegate,
   bool rebuild = false;
   Populate(sceneDelegate, *dirtyBits, rebuild);
 
-  if (_geom->is_modified() || rebuild) {
+  const bool geom_modified = _geom->is_modified() || rebuild;
+  if (geom_modified) {
     _geom->tag_update(lock.scene, rebuild);
   }
 
+  // Only tag instances when they or their geometry changed (like the Blender sync does), so that
+  // syncing a prim with many instances without any change does not trigger an object update
   for (Object *instance : _instances) {
-    instance->tag_update(lock.scene);
+    if (geom_modified || instance->is_modified()) {
+      instance->tag_update(lock.scene);
+    }
   }
 
   *dirtyBits = HdChangeTracker::Clean;
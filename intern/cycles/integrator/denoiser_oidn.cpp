@@ -167,6 +167,7 @@ class OIDNDenoiseContext {
         denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE) {
       oidn_filter.set("cleanAux", true);
     }
+    set_max_memory(oidn_filter);
     oidn_filter.commit();
 
     filter_guiding_pass_if_needed(oidn_device, oidn_albedo_pass_);
@@ -196,12 +197,22 @@ class OIDNDenoiseContext {
     oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
     set_pass(oidn_filter, oidn_pass);
     set_output_pass(oidn_filter, oidn_pass);
+    set_max_memory(oidn_filter);
     oidn_filter.commit();
     oidn_filter.execute();
 
     oidn_pass.is_filtered = true;
   }
 
+  /* Limit the scratch memory of the filter. When the full image does not fit into the limit OIDN
+   * denoises overlapping tiles, so that the result has no visible seams. */
+  void set_max_memory(oidn::FilterRef &oidn_filter)
+  {
+    if (denoise_params_.max_memory > 0) {
+      oidn_filter.set("maxMemoryMB", denoise_params_.max_memory);
+    }
+  }
+
   /* Make pixels of a guiding pass available by the denoiser. */
   void read_guiding_pass(OIDNPass &oidn_pass)
   {
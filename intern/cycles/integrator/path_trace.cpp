@@ -63,6 +63,8 @@ PathTrace::~PathTrace()
 
 void PathTrace::load_kernels()
 {
+  denoise_async_wait(false);
+
   if (denoiser_) {
     /* Activate graphics interop while denoiser device is created, so that it can choose a device
      * that supports interop for faster display updates. */
@@ -113,6 +115,9 @@ void PathTrace::reset(const BufferParams &full_params,
                       const BufferParams &big_tile_params,
                       const bool reset_rendering)
 {
+  /* Result of the asynchronous denoising does not correspond to the new render. */
+  denoise_async_wait(false);
+
   if (big_tile_params_.modified(big_tile_params)) {
     big_tile_params_ = big_tile_params;
     render_state_.need_reset_params = true;
@@ -135,6 +140,8 @@ void PathTrace::reset(const BufferParams &full_params,
 
 void PathTrace::device_free()
 {
+  denoise_async_wait(false);
+
   /* Free render buffers used by the path trace work to reduce memory peak. */
   BufferParams empty_params;
   empty_params.pass_stride = 0;
@@ -142,6 +149,9 @@ void PathTrace::device_free()
   for (auto &&path_trace_work : path_trace_works_) {
     path_trace_work->get_render_buffers()->reset(empty_params);
   }
+  if (async_denoise_.work) {
+    async_denoise_.work->get_render_buffers()->reset(empty_params);
+  }
   render_state_.need_reset_params = true;
 }
 
@@ -480,6 +490,14 @@ void PathTrace::set_denoiser_params(const DenoiseParams &params)
 {
   render_scheduler_.set_denoiser_params(params);
 
+  /* This is called for every render iteration, so only interrupt the asynchronous denoising when
+   * the denoiser is actually re-configured. */
+  if (denoiser_ && params.use && !denoiser_->get_params().modified(params)) {
+    return;
+  }
+
+  denoise_async_wait(false);
+
   if (!params.use) {
     denoiser_.reset();
     return;
@@ -529,6 +547,14 @@ void PathTrace::denoise(const RenderWork &render_work)
     return;
   }
 
+  if (render_work.tile.denoise_async) {
+    denoise_async(render_work);
+    return;
+  }
+
+  /* The pending asynchronous result is older than the one which is about to be denoised. */
+  denoise_async_wait(false);
+
   VLOG_WORK << "Perform denoising work.";
 
   const double start_time = time_dt();
@@ -564,11 +590,80 @@ void PathTrace::denoise(const RenderWork &render_work)
                                 get_num_samples_in_buffer(),
                                 allow_inplace_modification)) {
     render_state_.has_denoised_result = true;
+    render_state_.big_tile_denoise_num_samples = get_num_samples_in_buffer();
   }
 
   render_scheduler_.report_denoise_time(render_work, time_dt() - start_time);
 }
 
+void PathTrace::denoise_async(const RenderWork &render_work)
+{
+  Device *denoiser_device = denoiser_->get_denoiser_device();
+  if (!denoiser_device) {
+    return;
+  }
+
+  VLOG_WORK << "Perform asynchronous denoising work.";
+
+  const double start_time = time_dt();
+
+  /* Normally the previous snapshot is denoised while its following samples were path traced, so
+   * this does not block. */
+  denoise_async_wait(true);
+
+  if (!async_denoise_.work) {
+    async_denoise_.work = PathTraceWork::create(denoiser_device, film_, device_scene_, nullptr);
+  }
+
+  const BufferParams &buffer_params = render_state_.effective_big_tile_params;
+
+  async_denoise_.work->set_effective_buffer_params(buffer_params, buffer_params, buffer_params);
+
+  RenderBuffers *buffer_to_denoise = async_denoise_.work->get_render_buffers();
+  buffer_to_denoise->reset(buffer_params);
+
+  copy_to_render_buffers(buffer_to_denoise);
+
+  async_denoise_.buffer_params = buffer_params;
+  async_denoise_.num_samples = get_num_samples_in_buffer();
+  async_denoise_.success = false;
+  async_denoise_.is_finished = false;
+
+  async_denoise_.denoise_thread = make_unique<thread>([this, buffer_to_denoise]() {
+    async_denoise_.success = denoiser_->denoise_buffer(
+        async_denoise_.buffer_params, buffer_to_denoise, async_denoise_.num_samples, true);
+    async_denoise_.is_finished = true;
+  });
+
+  /* Only report the time during which path tracing was blocked, so that the scheduler does not
+   * hold back display updates to compensate for the denoising which happens in background. */
+  render_scheduler_.report_denoise_time(render_work, time_dt() - start_time);
+}
+
+void PathTrace::denoise_async_wait(const bool use_result)
+{
+  if (!async_denoise_.denoise_thread) {
+    return;
+  }
+
+  async_denoise_.denoise_thread->join();
+  async_denoise_.denoise_thread.reset();
+
+  if (!use_result || !async_denoise_.success) {
+    return;
+  }
+
+  /* The resolution might have changed since the snapshot was taken. */
+  if (async_denoise_.buffer_params.modified(render_state_.effective_big_tile_params)) {
+    return;
+  }
+
+  swap(big_tile_denoise_work_, async_denoise_.work);
+
+  render_state_.has_denoised_result = true;
+  render_state_.big_tile_denoise_num_samples = async_denoise_.num_samples;
+}
+
 void PathTrace::set_output_driver(unique_ptr<OutputDriver> driver)
 {
   output_driver_ = move(driver);
@@ -632,6 +727,11 @@ void PathTrace::update_display(const RenderWork &render_work)
 
   const double start_time = time_dt();
 
+  /* Display the result of the asynchronous denoising as soon as it is available. */
+  if (async_denoise_.denoise_thread && async_denoise_.is_finished) {
+    denoise_async_wait(true);
+  }
+
   if (output_driver_) {
     VLOG_WORK << "Invoke buffer update callback.";
 
@@ -656,11 +756,12 @@ void PathTrace::update_display(const RenderWork &render_work)
 
     /* TODO(sergey): When using multi-device rendering map the GPUDisplay once and copy data from
      * all works in parallel. */
-    const int num_samples = get_num_samples_in_buffer();
     if (big_tile_denoise_work_ && render_state_.has_denoised_result) {
-      big_tile_denoise_work_->copy_to_display(display_.get(), pass_mode, num_samples);
+      big_tile_denoise_work_->copy_to_display(
+          display_.get(), pass_mode, render_state_.big_tile_denoise_num_samples);
     }
     else {
+      const int num_samples = get_num_samples_in_buffer();
       for (auto &&path_trace_work : path_trace_works_) {
         path_trace_work->copy_to_display(display_.get(), pass_mode, num_samples);
       }
@@ -796,6 +897,13 @@ int PathTrace::get_num_samples_in_buffer()
   return render_scheduler_.get_num_rendered_samples();
 }
 
+void PathTrace::collect_statistics(RenderStats &render_stats)
+{
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->collect_statistics(render_stats);
+  }
+}
+
 bool PathTrace::is_cancel_requested()
 {
   if (render_cancel_.is_requested) {
@@ -1022,6 +1130,10 @@ int PathTrace::get_num_render_tile_samples() const
     return full_frame_state_.render_buffers->params.samples;
   }
 
+  if (big_tile_denoise_work_ && render_state_.has_denoised_result) {
+    return render_state_.big_tile_denoise_num_samples;
+  }
+
   return render_scheduler_.get_num_rendered_samples();
 }
 
@@ -1109,6 +1221,8 @@ bool PathTrace::has_denoised_result() const
 
 void PathTrace::destroy_gpu_resources()
 {
+  denoise_async_wait(false);
+
   /* Destroy any GPU resource which was used for graphics interop.
    * Need to have access to the PathTraceDisplay as it is the only source of drawing context which
    * is used for interop. */
@@ -1120,6 +1234,10 @@ void PathTrace::destroy_gpu_resources()
     if (big_tile_denoise_work_) {
       big_tile_denoise_work_->destroy_gpu_resources(display_.get());
     }
+
+    if (async_denoise_.work) {
+      async_denoise_.work->destroy_gpu_resources(display_.get());
+    }
   }
 }
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "integrator/denoiser.h"
 #include "integrator/guiding.h"
 #include "integrator/pass_accessor.h"
@@ -26,6 +28,7 @@ class DisplayDriver;
 class Film;
 class RenderBuffers;
 class RenderScheduler;
+class RenderStats;
 class RenderWork;
 class PathTraceDisplay;
 class OutputDriver;
@@ -140,6 +143,10 @@ class PathTrace {
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
 
+  /* Add statistics of the device side execution, such as the kernel times and the occupancy of
+   * the path states, to the render statistics. */
+  void collect_statistics(RenderStats &render_stats);
+
   /* Get pass data of the entire big tile.
    * This call puts pass render result from all devices into the final pixels storage.
    *
@@ -213,6 +220,15 @@ class PathTrace {
   void write_tile_buffer(const RenderWork &render_work);
   void finalize_full_buffer_on_disk(const RenderWork &render_work);
 
+  /* Start denoising of a snapshot of the render buffers in a background thread, after making the
+   * result of the previous asynchronous denoising available for display. */
+  void denoise_async(const RenderWork &render_work);
+
+  /* Wait for the asynchronous denoising to finish.
+   * When `use_result` is true the denoised snapshot replaces the big tile denoise work, otherwise
+   * the result is discarded. */
+  void denoise_async_wait(bool use_result);
+
   /* Updates/initializes the guiding structures after a rendering iteration.
    * The structures are updated using the training data/samples generated during the previous
    * rendering iteration */
@@ -282,6 +298,25 @@ class PathTrace {
   /* Denoiser device descriptor which holds the denoised big tile for multi-device workloads. */
   unique_ptr<PathTraceWork> big_tile_denoise_work_;
 
+  /* State of the denoising which runs in the background while path tracing continues. */
+  struct {
+    /* Holds the snapshot of the render buffers which is being denoised. Swapped with the big tile
+     * denoise work once denoising is finished. */
+    unique_ptr<PathTraceWork> work;
+
+    unique_ptr<thread> denoise_thread;
+
+    /* Parameters and number of samples of the snapshot. */
+    BufferParams buffer_params;
+    int num_samples = 0;
+
+    /* Written by the denoise thread, only to be accessed after it has been joined. */
+    bool success = false;
+
+    /* Allows to check whether the result is ready without blocking. */
+    std::atomic<bool> is_finished = false;
+  } async_denoise_;
+
 #ifdef WITH_PATH_GUIDING
   /* Guiding related attributes */
   GuidingParams guiding_params_;
@@ -319,6 +354,10 @@ class PathTrace {
     /* Denoiser was run and there are denoised versions of the passes in the render buffers. */
     bool has_denoised_result = false;
 
+    /* Number of samples in the render buffers of the big tile denoise work. Lags behind the number
+     * of rendered samples when denoising runs asynchronously. */
+    int big_tile_denoise_num_samples = 0;
+
     /* Current tile has been written (to either disk or callback.
      * Indicates that no more work will be done on this tile. */
     bool tile_written = false;
@@ -17,6 +17,7 @@ class DeviceScene;
 class Film;
 class PathTraceDisplay;
 class RenderBuffers;
+class RenderStats;
 
 class PathTraceWork {
  public:
@@ -125,6 +126,12 @@ class PathTraceWork {
   /* Run cryptomatte pass post-processing kernels. */
   virtual void cryptomatte_postproces() = 0;
 
+  /* Add statistics of the device side execution of this work, such as the time spent in the
+   * individual kernels, to the render statistics. */
+  virtual void collect_statistics(RenderStats & /*render_stats*/)
+  {
+  }
+
   /* Cheap-ish request to see whether rendering is requested and is to be stopped as soon as
    * possible, without waiting for any samples to be finished. */
   inline bool is_cancel_requested() const
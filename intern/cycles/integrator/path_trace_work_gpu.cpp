@@ -8,6 +8,7 @@
 
 #include "integrator/pass_accessor_gpu.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "util/log.h"
 #include "util/string.h"
@@ -18,6 +19,10 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Size in pixels of the image cells for which the adaptive sampling convergence is tracked, to
+ * skip scheduling of tiles that have fully converged. */
+static constexpr int ADAPTIVE_SAMPLING_CELL_SIZE = 16;
+
 static size_t estimate_single_state_size(const uint kernel_features)
 {
   size_t state_size = 0;
@@ -77,6 +82,7 @@ PathTraceWorkGPU::PathTraceWorkGPU(Device *device,
       queued_paths_(device, "queued_paths", MEM_READ_WRITE),
       num_queued_paths_(device, "num_queued_paths", MEM_READ_WRITE),
       work_tiles_(device, "work_tiles", MEM_READ_WRITE),
+      adaptive_sampling_active_cells_(device, "adaptive_sampling_active_cells", MEM_READ_WRITE),
       display_rgba_half_(device, "display buffer half", MEM_READ_WRITE),
       max_num_paths_(0),
       min_num_active_main_paths_(0),
@@ -340,6 +346,9 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
   }
 
   statistics.occupancy = static_cast<float>(num_busy_accum) / num_iterations / max_num_paths_;
+
+  stats_num_busy_paths_ += num_busy_accum;
+  stats_num_iterations_ += num_iterations;
 }
 
 DeviceKernel PathTraceWorkGPU::get_most_queued_kernel() const
@@ -1005,6 +1014,13 @@ int PathTraceWorkGPU::adaptive_sampling_convergence_check_count_active(float thr
 
   queue_->zero_to_device(num_active_pixels);
 
+  const int2 image_size = make_int2(effective_buffer_params_.width,
+                                    effective_buffer_params_.height);
+  const int cell_size = ADAPTIVE_SAMPLING_CELL_SIZE;
+  adaptive_sampling_active_cells_.alloc(divide_up(image_size.x, cell_size) *
+                                        divide_up(image_size.y, cell_size));
+  queue_->zero_to_device(adaptive_sampling_active_cells_);
+
   const int work_size = effective_buffer_params_.width * effective_buffer_params_.height;
 
   DeviceKernelArguments args(&buffers_->buffer.device_pointer,
@@ -1016,13 +1032,21 @@ int PathTraceWorkGPU::adaptive_sampling_convergence_check_count_active(float thr
                              &reset,
                              &effective_buffer_params_.offset,
                              &effective_buffer_params_.stride,
-                             &num_active_pixels.device_pointer);
+                             &num_active_pixels.device_pointer,
+                             &adaptive_sampling_active_cells_.device_pointer,
+                             &cell_size);
 
   queue_->enqueue(DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_CHECK, work_size, args);
 
   queue_->copy_from_device(num_active_pixels);
+  queue_->copy_from_device(adaptive_sampling_active_cells_);
   queue_->synchronize();
 
+  /* Stop scheduling tiles in which all pixels have converged, so that the path states go to
+   * regions of the image that still need samples. */
+  work_tile_scheduler_.set_active_cells(
+      adaptive_sampling_active_cells_.data(), image_size, cell_size);
+
   return num_active_pixels.data()[0];
 }
 
@@ -1068,6 +1092,38 @@ void PathTraceWorkGPU::cryptomatte_postproces()
   queue_->enqueue(DEVICE_KERNEL_CRYPTOMATTE_POSTPROCESS, work_size, args);
 }
 
+void PathTraceWorkGPU::collect_statistics(RenderStats &render_stats)
+{
+  /* Only report the statistics when they are explicitly requested, so that regular renders don't
+   * get kernel times and occupancy in their metadata. */
+  if (!queue_->is_per_kernel_performance()) {
+    return;
+  }
+
+  for (const auto &[mask, time] : queue_->get_kernel_stats()) {
+    const string name = device_kernel_mask_as_string(mask);
+
+    /* Merge times of the same kernels executed on different devices. */
+    bool found = false;
+    for (NamedTimeEntry &entry : render_stats.device_kernels.entries) {
+      if (entry.name == name) {
+        entry.time += time;
+        render_stats.device_kernels.total_time += time;
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      render_stats.device_kernels.add_entry(NamedTimeEntry(name, time));
+    }
+  }
+
+  if (stats_num_iterations_ != 0 && max_num_paths_ != 0) {
+    render_stats.device_occupancy.push_back(static_cast<float>(stats_num_busy_paths_) /
+                                            stats_num_iterations_ / max_num_paths_);
+  }
+}
+
 bool PathTraceWorkGPU::copy_render_buffers_from_device()
 {
   queue_->copy_from_device(buffers_->buffer);
@@ -1080,6 +1136,9 @@ bool PathTraceWorkGPU::copy_render_buffers_to_device()
 {
   queue_->copy_to_device(buffers_->buffer);
 
+  /* Convergence of pixels is not known for the new buffer content. */
+  work_tile_scheduler_.clear_active_cells();
+
   /* NOTE: The direct device access to the buffers only happens within this path trace work. The
    * rest of communication happens via API calls which involves `copy_render_buffers_from_device()`
    * which will perform synchronization as needed. */
@@ -1091,6 +1150,9 @@ bool PathTraceWorkGPU::zero_render_buffers()
 {
   queue_->zero_to_device(buffers_->buffer);
 
+  /* All pixels need samples again. */
+  work_tile_scheduler_.clear_active_cells();
+
   return true;
 }
 
@@ -48,6 +48,8 @@ class PathTraceWorkGPU : public PathTraceWork {
   virtual int adaptive_sampling_converge_filter_count_active(float threshold, bool reset) override;
   virtual void cryptomatte_postproces() override;
 
+  virtual void collect_statistics(RenderStats &render_stats) override;
+
  protected:
   void alloc_integrator_soa();
   void alloc_integrator_queue();
@@ -146,6 +148,9 @@ class PathTraceWorkGPU : public PathTraceWork {
   /* Temporary buffer for passing work tiles to kernel. */
   device_vector<KernelWorkTile> work_tiles_;
 
+  /* Cells of the image with pixels that did not converge yet, used to skip converged tiles. */
+  device_vector<uint> adaptive_sampling_active_cells_;
+
   /* Temporary buffer used by the copy_to_display() whenever graphics interoperability is not
    * available. Is allocated on-demand. */
   device_vector<half4> display_rgba_half_;
@@ -170,6 +175,11 @@ class PathTraceWorkGPU : public PathTraceWork {
    * the size of the integrator_state_ buffer so can avoid iterating over the
    * full buffer. */
   int max_active_main_path_index_;
+
+  /* Number of busy main paths accumulated over all path iterations, and the number of these
+   * iterations. Used to report the average occupancy of the path states. */
+  uint64_t stats_num_busy_paths_ = 0;
+  uint64_t stats_num_iterations_ = 0;
 };
 
 CCL_NAMESPACE_END
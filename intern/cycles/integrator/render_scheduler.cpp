@@ -338,6 +338,7 @@ RenderWork RenderScheduler::get_render_work()
 
   bool denoiser_delayed, denoiser_ready_to_display;
   render_work.tile.denoise = work_need_denoise(denoiser_delayed, denoiser_ready_to_display);
+  render_work.tile.denoise_async = render_work.tile.denoise && work_can_denoise_async();
 
   render_work.tile.write = done();
 
@@ -988,6 +989,32 @@ bool RenderScheduler::work_need_denoise(bool &delayed, bool &ready_to_display)
   return !delayed;
 }
 
+bool RenderScheduler::work_can_denoise_async() const
+{
+  if (!denoiser_params_.use_async) {
+    return false;
+  }
+
+  /* Only viewport renders denoise intermediate results. */
+  if (background_) {
+    return false;
+  }
+
+  /* Result of the last sample is to be denoised synchronously, so that the final result is
+   * denoised and displayed as soon as the rendering is finished. */
+  if (done()) {
+    return false;
+  }
+
+  /* Navigation changes resolution too often for the snapshot to be useful by the time it is
+   * denoised. */
+  if (state_.resolution_divider != pixel_size_) {
+    return false;
+  }
+
+  return true;
+}
+
 bool RenderScheduler::work_need_update_display(const bool denoiser_delayed)
 {
   if (headless_) {
@@ -52,6 +52,10 @@ class RenderWork {
     bool write = false;
 
     bool denoise = false;
+
+    /* Denoise a snapshot of the render buffers in the background while the following samples are
+     * path traced. */
+    bool denoise_async = false;
   } tile;
 
   /* Work related on the full-frame render buffer. */
@@ -257,6 +261,10 @@ class RenderScheduler {
    * increased samples. */
   bool work_need_denoise(bool &delayed, bool &ready_to_display);
 
+  /* Check whether denoising which was scheduled for the current work can run in the background,
+   * overlapping with path tracing of the following work. */
+  bool work_can_denoise_async() const;
+
   /* Check whether current work need to update display.
    *
    * The `denoiser_delayed` is what `work_need_denoise()` returned as delayed denoiser flag. */
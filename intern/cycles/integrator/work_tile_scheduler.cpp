@@ -87,16 +87,27 @@ bool WorkTileScheduler::get_work(KernelWorkTile *work_tile_, const int max_work_
 
   DCHECK_NE(max_num_path_states_, 0);
 
-  const int work_index = next_work_index_++;
-  if (work_index >= total_work_size_) {
-    return false;
+  int work_index, tile_index, tile_x, tile_y;
+  while (true) {
+    work_index = next_work_index_++;
+    if (work_index >= total_work_size_) {
+      return false;
+    }
+
+    tile_index = work_index / num_tiles_per_sample_range_;
+    tile_y = tile_index / num_tiles_x_;
+    tile_x = tile_index - tile_y * num_tiles_x_;
+
+    if (tile_is_active(tile_x, tile_y)) {
+      break;
+    }
+
+    /* All pixels of the tile have converged, skip all of its sample ranges. */
+    next_work_index_ = (tile_index + 1) * num_tiles_per_sample_range_;
   }
 
   const int sample_range_index = work_index % num_tiles_per_sample_range_;
   const int start_sample = sample_range_index * tile_size_.num_samples;
-  const int tile_index = work_index / num_tiles_per_sample_range_;
-  const int tile_y = tile_index / num_tiles_x_;
-  const int tile_x = tile_index - tile_y * num_tiles_x_;
 
   KernelWorkTile work_tile;
   work_tile.x = tile_x * tile_size_.width;
@@ -122,7 +133,7 @@ bool WorkTileScheduler::get_work(KernelWorkTile *work_tile_, const int max_work_
   if (max_work_size && tile_work_size > max_work_size) {
     /* The work did not fit into the requested limit of the work size. Unschedule the tile,
      * so it can be picked up again later. */
-    next_work_index_--;
+    next_work_index_ = work_index;
     return false;
   }
 
@@ -131,4 +142,48 @@ bool WorkTileScheduler::get_work(KernelWorkTile *work_tile_, const int max_work_
   return true;
 }
 
+void WorkTileScheduler::set_active_cells(const uint *active_cells,
+                                         const int2 image_size,
+                                         const int cell_size)
+{
+  active_cell_size_ = cell_size;
+  active_cells_image_size_ = image_size;
+  num_active_cells_x_ = divide_up(image_size.x, cell_size);
+
+  const int num_cells = num_active_cells_x_ * divide_up(image_size.y, cell_size);
+  active_cells_.resize(num_cells);
+  for (int i = 0; i < num_cells; i++) {
+    active_cells_[i] = active_cells[i] != 0;
+  }
+}
+
+void WorkTileScheduler::clear_active_cells()
+{
+  active_cells_.clear();
+}
+
+bool WorkTileScheduler::tile_is_active(const int tile_x, const int tile_y) const
+{
+  if (active_cells_.empty() || !(active_cells_image_size_ == image_size_px_)) {
+    return true;
+  }
+
+  const int x_start = tile_x * tile_size_.width;
+  const int y_start = tile_y * tile_size_.height;
+  const int x_end = min(x_start + tile_size_.width, image_size_px_.x);
+  const int y_end = min(y_start + tile_size_.height, image_size_px_.y);
+
+  for (int cell_y = y_start / active_cell_size_; cell_y <= (y_end - 1) / active_cell_size_;
+       cell_y++) {
+    for (int cell_x = x_start / active_cell_size_; cell_x <= (x_end - 1) / active_cell_size_;
+         cell_x++) {
+      if (active_cells_[cell_y * num_active_cells_x_ + cell_x]) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 CCL_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include "integrator/tile.h"
 #include "util/types.h"
+#include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -42,9 +43,21 @@ class WorkTileScheduler {
    * Optionally pass max_work_size to do nothing if there is no tile small enough. */
   bool get_work(KernelWorkTile *work_tile, const int max_work_size = 0);
 
+  /* Only schedule tiles which contain pixels that still need samples, as found by an adaptive
+   * sampling convergence check. The map has one value per cell of cell_size by cell_size pixels
+   * of an image of the given size, in scanline order. Non-zero values mark cells with pixels
+   * that need samples. The map is ignored when rendering an image of a different size. */
+  void set_active_cells(const uint *active_cells, const int2 image_size, const int cell_size);
+
+  /* Schedule all tiles again, for example after the render buffer has been reset. */
+  void clear_active_cells();
+
  protected:
   void reset_scheduler_state();
 
+  /* Check whether any pixel of the tile still needs samples. */
+  bool tile_is_active(int tile_x, int tile_y) const;
+
   /* Used to indicate if there is accelerated ray tracing. */
   bool accelerated_rt_ = false;
 
@@ -94,6 +107,12 @@ class WorkTileScheduler {
 
   int next_work_index_ = 0;
   int total_work_size_ = 0;
+
+  /* Cells of the image which still need samples. Empty if all tiles are to be scheduled. */
+  vector<bool> active_cells_;
+  int2 active_cells_image_size_ = make_int2(0, 0);
+  int active_cell_size_ = 0;
+  int num_active_cells_x_ = 0;
 };
 
 CCL_NAMESPACE_END
@@ -491,7 +491,9 @@ ccl_gpu_kernel(GPU_KERNEL_BLOCK_NUM_THREADS, GPU_KERNEL_MAX_REGISTERS)
                              bool reset,
                              int offset,
                              int stride,
-                             ccl_global uint *num_active_pixels)
+                             ccl_global uint *num_active_pixels,
+                             ccl_global uint *active_cells,
+                             int cell_size)
 {
   const int work_index = ccl_gpu_global_id_x();
   const int y = work_index / sw;
@@ -502,6 +504,19 @@ ccl_gpu_kernel(GPU_KERNEL_BLOCK_NUM_THREADS, GPU_KERNEL_MAX_REGISTERS)
   if (x < sw && y < sh) {
     converged = ccl_gpu_kernel_call(film_adaptive_sampling_convergence_check(
         nullptr, render_buffer, sx + x, sy + y, threshold, reset, offset, stride));
+
+    if (!converged) {
+      /* The filter passes also make the direct neighbors of this pixel need samples, so mark the
+       * cells of all of them. */
+      const int num_cells_x = (sw + cell_size - 1) / cell_size;
+      const int cell_x_end = min(x + 1, sw - 1) / cell_size;
+      const int cell_y_end = min(y + 1, sh - 1) / cell_size;
+      for (int cell_y = max(y - 1, 0) / cell_size; cell_y <= cell_y_end; cell_y++) {
+        for (int cell_x = max(x - 1, 0) / cell_size; cell_x <= cell_x_end; cell_x++) {
+          active_cells[cell_y * num_cells_x + cell_x] = 1;
+        }
+      }
+    }
   }
 
   /* NOTE: All threads specified in the mask must execute the intrinsic. */
@@ -5,22 +5,26 @@
 
 CCL_NAMESPACE_BEGIN
 
-ccl_device_noinline void svm_node_math(KernelGlobals kg,
-                                       ccl_private ShaderData *sd,
-                                       ccl_private float *stack,
-                                       uint type,
-                                       uint inputs_stack_offsets,
-                                       uint result_stack_offset)
+ccl_device_noinline int svm_node_math(KernelGlobals kg,
+                                      ccl_private ShaderData *sd,
+                                      ccl_private float *stack,
+                                      uint type,
+                                      uint inputs_stack_offsets,
+                                      uint result_stack_offset,
+                                      int offset)
 {
   uint a_stack_offset, b_stack_offset, c_stack_offset;
   svm_unpack_node_uchar3(inputs_stack_offsets, &a_stack_offset, &b_stack_offset, &c_stack_offset);
 
-  float a = stack_load_float(stack, a_stack_offset);
-  float b = stack_load_float(stack, b_stack_offset);
-  float c = stack_load_float(stack, c_stack_offset);
+  uint4 defaults = read_node(kg, &offset);
+
+  float a = stack_load_float_default(stack, a_stack_offset, defaults.x);
+  float b = stack_load_float_default(stack, b_stack_offset, defaults.y);
+  float c = stack_load_float_default(stack, c_stack_offset, defaults.z);
   float result = svm_math((NodeMathType)type, a, b, c);
 
   stack_store_float(stack, result_stack_offset, result);
+  return offset;
 }
 
 ccl_device_noinline int svm_node_vector_math(KernelGlobals kg,
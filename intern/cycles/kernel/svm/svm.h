@@ -414,7 +414,7 @@ ccl_device void svm_eval_nodes(KernelGlobals kg,
       }
       break;
       SVM_CASE(NODE_MATH)
-      svm_node_math(kg, sd, stack, node.y, node.z, node.w);
+      offset = svm_node_math(kg, sd, stack, node.y, node.z, node.w, offset);
       break;
       SVM_CASE(NODE_VECTOR_MATH)
       offset = svm_node_vector_math(kg, sd, stack, node.y, node.z, node.w, offset);
@@ -17,6 +17,10 @@ class BakeManager {
   BakeManager();
   ~BakeManager();
 
+  /* Set the object to bake next. The session and scene are reused for all objects, but they are
+   * baked one after another: the bake primitive pass stores the triangle index relative to the
+   * object, and does not have space for an object index, which would be needed to bake multiple
+   * objects into shared work tiles. */
   void set(Scene *scene, const std::string &object_name);
   bool get_baking() const;
 
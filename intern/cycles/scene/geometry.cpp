@@ -25,6 +25,7 @@
 
 #include "kernel/osl/globals.h"
 
+#include "util/algorithm.h"
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
@@ -970,7 +971,23 @@ void GeometryManager::geom_calc_offset(Scene *scene, BVHLayout bvh_layout)
   size_t face_size = 0;
   size_t corner_size = 0;
 
-  foreach (Geometry *geom, scene->geometry) {
+  /* Place geometry that needs a BVH rebuild last, and keep the order of the previous offsets
+   * otherwise. Geometry that was placed after geometry which now needs a rebuild still moves
+   * once, when that geometry is moved to the end. From then on its offsets stay the same across
+   * updates (e.g. frames of an animation render with persistent data) while only the geometry
+   * after it changes, so its BVH is kept instead of being refit, or rebuilt with OptiX, whenever
+   * geometry before it changes size. */
+  vector<Geometry *> geometry_order = scene->geometry;
+  stable_sort(geometry_order.begin(),
+              geometry_order.end(),
+              [](const Geometry *a, const Geometry *b) {
+                if (a->need_update_rebuild != b->need_update_rebuild) {
+                  return b->need_update_rebuild;
+                }
+                return a->prim_offset < b->prim_offset;
+              });
+
+  foreach (Geometry *geom, geometry_order) {
     bool prim_offset_changed = false;
 
     if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
@@ -1064,7 +1081,6 @@ void GeometryManager::device_update_mesh(Device *,
 
         /* patch tables are stored in same array so include them in patch_size */
         if (mesh->patch_table) {
-          mesh->patch_table_offset = patch_size;
           patch_size += mesh->patch_table->total_size();
         }
       }
@@ -205,6 +205,9 @@ class GeometryManager {
   void device_update(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
   void device_free(Device *device, DeviceScene *dscene, bool force_free);
 
+  /* Compute verts/triangles/curves offsets in global arrays. */
+  void geom_calc_offset(Scene *scene, BVHLayout bvh_layout);
+
   /* Updates */
   void tag_update(Scene *scene, uint32_t flag);
 
@@ -226,9 +229,6 @@ class GeometryManager {
                              vector<AttributeRequestSet> &geom_attributes,
                              vector<AttributeRequestSet> &object_attributes);
 
-  /* Compute verts/triangles/curves offsets in global arrays. */
-  void geom_calc_offset(Scene *scene, BVHLayout bvh_layout);
-
   void device_update_object(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
 
   void device_update_mesh(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
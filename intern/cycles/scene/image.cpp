@@ -239,6 +239,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
+      mip_levels(1),
+      mip_level(0),
       compress_as_srgb(false)
 {
 }
@@ -316,7 +318,7 @@ bool ImageLoader::is_vdb_loader() const
 
 /* Image Manager */
 
-ImageManager::ImageManager(const DeviceInfo &info)
+ImageManager::ImageManager(const DeviceInfo &info, const SceneParams &params)
 {
   need_update_ = true;
   osl_texture_system = NULL;
@@ -324,6 +326,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   features.has_nanovdb = info.has_nanovdb;
+  features.use_half_float = params.use_half_float_textures;
 }
 
 ImageManager::~ImageManager()
@@ -483,6 +486,7 @@ int ImageManager::add_image_slot(ImageLoader *loader,
   img->builtin = builtin;
   img->users = 1;
   img->mem = NULL;
+  img->max_resolution = 0;
 
   images[slot] = img;
 
@@ -528,16 +532,29 @@ static bool image_associate_alpha(ImageManager::Image *img)
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 bool ImageManager::file_load_image(Image *img, int texture_limit)
 {
+  ImageMetaData metadata = img->metadata;
+
   /* Ignore empty images. */
-  if (!(img->metadata.channels > 0)) {
+  if (!(metadata.channels > 0)) {
     return false;
   }
 
+  /* Read a lower resolution directly when the file has pre-filtered MIP levels,
+   * instead of loading full resolution and scaling it down. */
+  if (texture_limit > 0 && metadata.depth <= 1) {
+    while (metadata.mip_level + 1 < metadata.mip_levels &&
+           max(metadata.width, metadata.height) > texture_limit) {
+      metadata.mip_level++;
+      metadata.width = max(metadata.width / 2, (size_t)1);
+      metadata.height = max(metadata.height / 2, (size_t)1);
+    }
+  }
+
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -564,15 +581,22 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  if (!img->loader->load_pixels(
+          metadata, pixels, num_pixels * components, image_associate_alpha(img)) &&
+      metadata.mip_level > 0) {
+    /* Fall back to scaling down the full resolution image. */
+    VLOG_WARNING << "Failed to load MIP level " << metadata.mip_level << " of image "
+                 << img->loader->name() << ".";
+    img->metadata.mip_levels = 1;
+    return file_load_image<FileFormat, StorageType>(img, texture_limit);
+  }
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
-  bool is_rgba = (img->metadata.type == IMAGE_DATA_TYPE_FLOAT4 ||
-                  img->metadata.type == IMAGE_DATA_TYPE_HALF4 ||
-                  img->metadata.type == IMAGE_DATA_TYPE_BYTE4 ||
-                  img->metadata.type == IMAGE_DATA_TYPE_USHORT4);
+  bool is_rgba = (metadata.type == IMAGE_DATA_TYPE_FLOAT4 ||
+                  metadata.type == IMAGE_DATA_TYPE_HALF4 ||
+                  metadata.type == IMAGE_DATA_TYPE_BYTE4 ||
+                  metadata.type == IMAGE_DATA_TYPE_USHORT4);
 
   if (is_rgba) {
     const StorageType one = util_image_cast_from_float<StorageType>(1.0f);
@@ -613,11 +637,10 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
     }
   }
 
-  if (img->metadata.colorspace != u_colorspace_raw &&
-      img->metadata.colorspace != u_colorspace_srgb) {
+  if (metadata.colorspace != u_colorspace_raw && metadata.colorspace != u_colorspace_srgb) {
     /* Convert to scene linear. */
     ColorSpaceManager::to_scene_linear(
-        img->metadata.colorspace, pixels, num_pixels, is_rgba, img->metadata.compress_as_srgb);
+        metadata.colorspace, pixels, num_pixels, is_rgba, metadata.compress_as_srgb);
   }
 
   /* Make sure we don't have buggy values. */
@@ -691,7 +714,11 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  int texture_limit = scene->params.texture_limit;
+  if (img->max_resolution > 0) {
+    texture_limit = (texture_limit > 0) ? min(texture_limit, img->max_resolution) :
+                                          img->max_resolution;
+  }
 
   load_image_metadata(img);
   ImageDataType type = img->metadata.type;
@@ -699,7 +726,11 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
   /* Name for debugging. */
   img->mem_name = string_printf("tex_image_%s_%03d", name_from_type(type), slot);
 
-  /* Free previous texture in slot. */
+  /* Free previous texture in slot.
+   *
+   * The texture is not reused, even when reloading an image with the same resolution as for
+   * animated volumes: devices which map host memory free the host pixels along with the device
+   * texture, so new pixels can not be written into the previous allocation. */
   if (img->mem) {
     thread_scoped_lock device_lock(device_mutex);
     delete img->mem;
@@ -856,13 +887,19 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
-  TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
     if (img && img->users == 0) {
       device_free_image(device, slot);
     }
-    else if (img && img->need_load) {
+  }
+
+  fit_texture_memory_limit(scene);
+
+  TaskPool pool;
+  for (size_t slot = 0; slot < images.size(); slot++) {
+    Image *img = images[slot];
+    if (img && img->need_load) {
       pool.push(
           function_bind(&ImageManager::device_load_image, this, device, scene, slot, &progress));
     }
@@ -873,6 +910,125 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
   need_update_ = false;
 }
 
+static bool image_type_is_nanovdb(const ImageDataType type)
+{
+  return (type == IMAGE_DATA_TYPE_NANOVDB_FLOAT || type == IMAGE_DATA_TYPE_NANOVDB_FLOAT3 ||
+          type == IMAGE_DATA_TYPE_NANOVDB_FPN || type == IMAGE_DATA_TYPE_NANOVDB_FP16);
+}
+
+/* Memory used by the texture of an image scaled down to the given resolution, following the
+ * scaling in file_load_image(). */
+static size_t image_texture_memory_size(const ImageMetaData &metadata, const int max_resolution)
+{
+  if (image_type_is_nanovdb(metadata.type)) {
+    return metadata.byte_size;
+  }
+
+  size_t width = metadata.width;
+  size_t height = metadata.height;
+  size_t depth = max(metadata.depth, (size_t)1);
+  const size_t max_size = max(max(width, height), depth);
+
+  if (max_resolution > 0 && max_size > max_resolution) {
+    float scale_factor = 1.0f;
+    while (max_size * scale_factor > max_resolution) {
+      scale_factor *= 0.5f;
+    }
+    width = max((size_t)(width * scale_factor), (size_t)1);
+    height = max((size_t)(height * scale_factor), (size_t)1);
+    depth = max((size_t)(depth * scale_factor), (size_t)1);
+  }
+
+  const bool is_rgba = (metadata.type == IMAGE_DATA_TYPE_FLOAT4 ||
+                        metadata.type == IMAGE_DATA_TYPE_HALF4 ||
+                        metadata.type == IMAGE_DATA_TYPE_BYTE4 ||
+                        metadata.type == IMAGE_DATA_TYPE_USHORT4);
+  size_t channel_size = sizeof(uchar);
+  if (metadata.type == IMAGE_DATA_TYPE_FLOAT4 || metadata.type == IMAGE_DATA_TYPE_FLOAT) {
+    channel_size = sizeof(float);
+  }
+  else if (metadata.type == IMAGE_DATA_TYPE_HALF4 || metadata.type == IMAGE_DATA_TYPE_HALF) {
+    channel_size = sizeof(half);
+  }
+  else if (metadata.type == IMAGE_DATA_TYPE_USHORT4 || metadata.type == IMAGE_DATA_TYPE_USHORT) {
+    channel_size = sizeof(uint16_t);
+  }
+
+  return width * height * depth * channel_size * (is_rgba ? 4 : 1);
+}
+
+void ImageManager::fit_texture_memory_limit(Scene *scene)
+{
+  const size_t memory_limit = scene->params.texture_memory_limit;
+  if (memory_limit == 0) {
+    return;
+  }
+
+  /* Images that are already in device memory are kept as they are,
+   * only the images that still need to be loaded are scaled down. */
+  size_t memory_used = 0;
+  vector<Image *> scalable_images;
+  vector<size_t> scalable_sizes;
+
+  foreach (Image *img, images) {
+    if (img == NULL) {
+      continue;
+    }
+    if (!img->need_load) {
+      if (img->mem) {
+        memory_used += img->mem->memory_size();
+      }
+      continue;
+    }
+
+    load_image_metadata(img);
+    img->max_resolution = 0;
+
+    const size_t size = image_texture_memory_size(img->metadata, scene->params.texture_limit);
+    memory_used += size;
+
+    if (!img->builtin && !image_type_is_nanovdb(img->metadata.type)) {
+      scalable_images.push_back(img);
+      scalable_sizes.push_back(size);
+    }
+  }
+
+  /* Halve the resolution of the largest texture until all of them fit. */
+  while (memory_used > memory_limit && !scalable_images.empty()) {
+    size_t largest = 0;
+    for (size_t i = 1; i < scalable_images.size(); i++) {
+      if (scalable_sizes[i] > scalable_sizes[largest]) {
+        largest = i;
+      }
+    }
+
+    Image *img = scalable_images[largest];
+    const ImageMetaData &metadata = img->metadata;
+    int resolution = (int)max(max(metadata.width, metadata.height), metadata.depth);
+    if (img->max_resolution > 0) {
+      resolution = min(resolution, img->max_resolution);
+    }
+    if (scene->params.texture_limit > 0) {
+      resolution = min(resolution, scene->params.texture_limit);
+    }
+    if (resolution <= 1) {
+      /* The largest texture is a single pixel, nothing left to scale down. */
+      break;
+    }
+    img->max_resolution = resolution / 2;
+
+    const size_t size = image_texture_memory_size(metadata, img->max_resolution);
+    memory_used -= scalable_sizes[largest] - size;
+    scalable_sizes[largest] = size;
+  }
+
+  if (memory_used > memory_limit) {
+    VLOG_WARNING << "Image textures use " << string_human_readable_size(memory_used)
+                 << ", more than the texture memory limit of "
+                 << string_human_readable_size(memory_limit) << ".";
+  }
+}
+
 void ImageManager::device_update_slot(Device *device, Scene *scene, int slot, Progress *progress)
 {
   Image *img = images[slot];
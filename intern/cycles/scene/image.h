@@ -25,6 +25,7 @@ class ImageManager;
 class Progress;
 class RenderStats;
 class Scene;
+class SceneParams;
 class ColorSpaceProcessor;
 class VDBImageLoader;
 
@@ -76,6 +77,12 @@ class ImageMetaData {
   bool use_transform_3d;
   Transform transform_3d;
 
+  /* Optional number of pre-filtered MIP levels stored in the file, for loaders that can read
+   * a lower resolution directly. The image manager sets the level to load before calling
+   * ImageLoader.load_pixels(), along with the width and height of that level. */
+  int mip_levels;
+  int mip_level;
+
   /* Automatically set. */
   bool compress_as_srgb;
 
@@ -89,6 +96,9 @@ class ImageMetaData {
 class ImageDeviceFeatures {
  public:
   bool has_nanovdb;
+  /* Store floating point images with half precision to reduce memory usage. Loaders which can not
+   * convert the pixels on load keep using full precision. */
+  bool use_half_float;
 };
 
 /* Image loader base class, that can be subclassed to load image data
@@ -166,7 +176,7 @@ class ImageHandle {
  * texture images and 3D volume images. */
 class ImageManager {
  public:
-  explicit ImageManager(const DeviceInfo &info);
+  ImageManager(const DeviceInfo &info, const SceneParams &params);
   ~ImageManager();
 
   ImageHandle add_image(const string &filename, const ImageParams &params);
@@ -205,6 +215,10 @@ class ImageManager {
     string mem_name;
     device_texture *mem;
 
+    /* Resolution the image is scaled down to, to fit in the texture memory limit.
+     * Zero when the image is loaded at full resolution. */
+    int max_resolution;
+
     int users;
     thread_mutex mutex;
   };
@@ -226,6 +240,7 @@ class ImageManager {
   void remove_image_user(int slot);
 
   void load_image_metadata(Image *img);
+  void fit_texture_memory_limit(Scene *scene);
 
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
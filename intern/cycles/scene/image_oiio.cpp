@@ -17,7 +17,7 @@ OIIOImageLoader::~OIIOImageLoader()
 {
 }
 
-bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
+bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures &features,
                                     ImageMetaData &metadata)
 {
   /* Perform preliminary checks, with meaningful logging. */
@@ -67,6 +67,10 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
   if (spec.format == TypeDesc::HALF) {
     is_half = true;
   }
+  else if (is_float && features.use_half_float) {
+    /* OpenImageIO converts the pixels to half float on read. */
+    is_half = true;
+  }
 
   /* set type and channels */
   metadata.channels = spec.nchannels;
@@ -87,6 +91,14 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
   metadata.colorspace_file_format = in->format_name();
   metadata.colorspace_file_hint = spec.get_string_attribute("oiio:ColorSpace");
 
+  /* Pre-filtered MIP levels, as written by maketx for tiled `.tx` files. */
+  if (metadata.depth <= 1) {
+    ImageSpec mip_spec;
+    while (in->seek_subimage(0, metadata.mip_levels, mip_spec)) {
+      metadata.mip_levels++;
+    }
+  }
+
   in->close();
 
   return true;
@@ -193,6 +205,16 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  if (metadata.mip_level > 0) {
+    /* Read a lower resolution MIP level, which is expected to match the size the image manager
+     * computed from the full resolution. */
+    if (!in->seek_subimage(0, metadata.mip_level, spec) || spec.width != (int)metadata.width ||
+        spec.height != (int)metadata.height) {
+      in->close();
+      return false;
+    }
+  }
+
   bool do_associate_alpha = false;
   if (associate_alpha) {
     do_associate_alpha = spec.get_int_attribute("oiio:UnassociatedAlpha", 0);
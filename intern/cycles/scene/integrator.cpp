@@ -135,6 +135,8 @@ NODE_DEFINE(Integrator)
               "Denoiser Prefilter",
               denoiser_prefilter_enum,
               DENOISER_PREFILTER_ACCURATE);
+  SOCKET_INT(denoiser_max_memory, "Denoiser Max Memory", 0);
+  SOCKET_BOOLEAN(use_denoise_async, "Use Asynchronous Denoising", false);
 
   return type;
 }
@@ -393,6 +395,10 @@ DenoiseParams Integrator::get_denoise_params() const
 
   denoise_params.prefilter = denoiser_prefilter;
 
+  denoise_params.max_memory = denoiser_max_memory;
+
+  denoise_params.use_async = use_denoise_async;
+
   return denoise_params;
 }
 
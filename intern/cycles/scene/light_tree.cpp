@@ -5,6 +5,8 @@
 #include "scene/mesh.h"
 #include "scene/object.h"
 
+#include "util/task.h"
+
 CCL_NAMESPACE_BEGIN
 
 float OrientationBounds::calculate_measure() const
@@ -201,8 +203,8 @@ LightTree::LightTree(vector<LightTreePrimitive> &prims,
   /* The amount of nodes is estimated to be twice the amount of primitives */
   nodes_.reserve(2 * num_prims);
 
-  nodes_.emplace_back();                             /* root node */
-  recursive_build(0, num_local_lights, prims, 0, 1); /* build tree */
+  nodes_.emplace_back();                                     /* root node */
+  recursive_build(0, num_local_lights, prims, 0, 1, nodes_); /* build tree */
   nodes_[0].make_interior(nodes_.size());
 
   /* All distant lights are grouped to one node (right child of the root node) */
@@ -224,15 +226,19 @@ const vector<LightTreeNode> &LightTree::get_nodes() const
   return nodes_;
 }
 
-int LightTree::recursive_build(
-    int start, int end, vector<LightTreePrimitive> &prims, uint bit_trail, int depth)
+int LightTree::recursive_build(int start,
+                               int end,
+                               vector<LightTreePrimitive> &prims,
+                               uint bit_trail,
+                               int depth,
+                               vector<LightTreeNode> &nodes)
 {
   BoundBox bbox = BoundBox::empty;
   OrientationBounds bcone = OrientationBounds::empty;
   BoundBox centroid_bounds = BoundBox::empty;
   float energy_total = 0.0;
   int num_prims = end - start;
-  int current_index = nodes_.size();
+  int current_index = nodes.size();
 
   for (int i = start; i < end; i++) {
     const LightTreePrimitive &prim = prims.at(i);
@@ -243,7 +249,7 @@ int LightTree::recursive_build(
     energy_total += prim.energy;
   }
 
-  nodes_.emplace_back(bbox, bcone, energy_total, bit_trail);
+  nodes.emplace_back(bbox, bcone, energy_total, bit_trail);
 
   bool try_splitting = num_prims > 1 && len(centroid_bounds.size()) > 0.0f;
   int split_dim = -1, split_bucket = 0, num_left_prims = 0;
@@ -274,13 +280,45 @@ int LightTree::recursive_build(
       middle = (start + end) / 2;
     }
 
-    [[maybe_unused]] int left_index = recursive_build(start, middle, prims, bit_trail, depth + 1);
-    int right_index = recursive_build(middle, end, prims, bit_trail | (1u << depth), depth + 1);
-    assert(left_index == current_index + 1);
-    nodes_[current_index].make_interior(right_index);
+    const uint right_bit_trail = bit_trail | (1u << depth);
+    int right_index;
+
+    if (end - middle >= THREAD_TASK_SIZE) {
+      /* Build the right subtree into its own array in parallel with the left subtree. Both work
+       * on disjoint ranges of the primitives. Once the left subtree is done, the right one is
+       * appended so the nodes end up in the same order as when built serially. */
+      vector<LightTreeNode> right_nodes;
+      TaskPool pool;
+      pool.push([&]() {
+        right_nodes.reserve(2 * (end - middle));
+        recursive_build(middle, end, prims, right_bit_trail, depth + 1, right_nodes);
+      });
+
+      [[maybe_unused]] int left_index = recursive_build(
+          start, middle, prims, bit_trail, depth + 1, nodes);
+      assert(left_index == current_index + 1);
+
+      pool.wait_work();
+
+      right_index = nodes.size();
+      for (LightTreeNode &node : right_nodes) {
+        if (!node.is_leaf()) {
+          node.right_child_index += right_index;
+        }
+      }
+      nodes.insert(nodes.end(), right_nodes.begin(), right_nodes.end());
+    }
+    else {
+      [[maybe_unused]] int left_index = recursive_build(
+          start, middle, prims, bit_trail, depth + 1, nodes);
+      assert(left_index == current_index + 1);
+      right_index = recursive_build(middle, end, prims, right_bit_trail, depth + 1, nodes);
+    }
+
+    nodes[current_index].make_interior(right_index);
   }
   else {
-    nodes_[current_index].make_leaf(start, num_prims);
+    nodes[current_index].make_leaf(start, num_prims);
   }
   return current_index;
 }
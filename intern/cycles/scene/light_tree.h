@@ -134,6 +134,9 @@ class LightTree {
   vector<LightTreeNode> nodes_;
   uint max_lights_in_leaf_;
 
+  /* Subtrees with at least this many primitives are built in parallel. */
+  enum { THREAD_TASK_SIZE = 4096 };
+
  public:
   LightTree(vector<LightTreePrimitive> &prims,
             const int &num_distant_lights,
@@ -142,8 +145,12 @@ class LightTree {
   const vector<LightTreeNode> &get_nodes() const;
 
  private:
-  int recursive_build(
-      int start, int end, vector<LightTreePrimitive> &prims, uint bit_trail, int depth);
+  int recursive_build(int start,
+                      int end,
+                      vector<LightTreePrimitive> &prims,
+                      uint bit_trail,
+                      int depth,
+                      vector<LightTreeNode> &nodes);
   float min_split_saoh(const BoundBox &centroid_bbox,
                        int start,
                        int end,
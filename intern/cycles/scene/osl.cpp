@@ -182,7 +182,18 @@ void OSLShaderManager::device_update_specific(Device *device,
      * stop task scheduler threads to make sure all TLS is clean and don't
      * have issues with TLS data free accessing freed memory if task scheduler
      * is being freed after the Session is freed.
+     *
+     * Groups of shaders which were not modified keep their references and are not optimized
+     * again. There is no way to store the optimized groups on disk for the next session though:
+     * OSL does not expose the JIT output, and the group parameters refer to texture handles
+     * which are unique per session.
      */
+    scoped_callback_timer timer([scene](double time) {
+      if (scene->update_stats) {
+        scene->update_stats->osl.times.add_entry({"device_update_optimize", time});
+      }
+    });
+
     thread_scoped_lock lock(ss_shared_mutex);
     for (const auto &[device_type, ss] : ss_shared) {
       ss->optimize_all_groups();
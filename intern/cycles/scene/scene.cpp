@@ -110,7 +110,7 @@ Scene::Scene(const SceneParams &params_, Device *device)
   light_manager = new LightManager();
   geometry_manager = new GeometryManager();
   object_manager = new ObjectManager();
-  image_manager = new ImageManager(device->info);
+  image_manager = new ImageManager(device->info, params);
   particle_system_manager = new ParticleSystemManager();
   bake_manager = new BakeManager();
   procedural_manager = new ProceduralManager();
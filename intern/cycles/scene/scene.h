@@ -160,6 +160,10 @@ class SceneParams {
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Scale down image textures until they fit in this many bytes, zero for no limit. */
+  size_t texture_memory_limit;
+  /* Store floating point image textures with half precision. */
+  bool use_half_float_textures;
 
   bool background;
 
@@ -175,6 +179,8 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    texture_memory_limit = 0;
+    use_half_float_textures = false;
     background = true;
   }
 
@@ -187,7 +193,9 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             texture_memory_limit == params.texture_memory_limit &&
+             use_half_float_textures == params.use_half_float_textures);
   }
 
   int curve_subdivisions()
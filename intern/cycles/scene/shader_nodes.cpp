@@ -6554,16 +6554,22 @@ void MathNode::compile(SVMCompiler &compiler)
   ShaderInput *value3_in = input("Value3");
   ShaderOutput *value_out = output("Value");
 
-  int value1_stack_offset = compiler.stack_assign(value1_in);
-  int value2_stack_offset = compiler.stack_assign(value2_in);
-  int value3_stack_offset = compiler.stack_assign(value3_in);
+  int value1_stack_offset = compiler.stack_assign_if_linked(value1_in);
+  int value2_stack_offset = compiler.stack_assign_if_linked(value2_in);
+  int value3_stack_offset = compiler.stack_assign_if_linked(value3_in);
   int value_stack_offset = compiler.stack_assign(value_out);
 
+  /* Unlinked inputs are stored in the node instead of being loaded onto the stack first, which
+   * saves evaluating a separate value node for every one of them. */
   compiler.add_node(
       NODE_MATH,
       math_type,
       compiler.encode_uchar4(value1_stack_offset, value2_stack_offset, value3_stack_offset),
       value_stack_offset);
+  compiler.add_node(__float_as_int(value1),
+                    __float_as_int(value2),
+                    __float_as_int(value3),
+                    SVM_STACK_INVALID);
 }
 
 void MathNode::compile(OSLCompiler &compiler)
@@ -308,7 +308,16 @@ string RenderStats::full_report()
     result += "Object statistics:\n" + objects.full_report(1);
   }
   else {
-    result += "Profiling information not available (only works with CPU rendering)";
+    result += "Profiling information not available (only works with CPU rendering)\n";
+  }
+  if (!device_kernels.entries.empty()) {
+    result += "Device kernel statistics:\n" + device_kernels.full_report(1);
+  }
+  if (!device_occupancy.empty()) {
+    result += "Device occupancy:\n";
+    for (size_t i = 0; i < device_occupancy.size(); i++) {
+      result += string_printf("  Device %d: %.1f%%\n", (int)i, device_occupancy[i] * 100.0f);
+    }
   }
   return result;
 }
@@ -178,6 +178,13 @@ class RenderStats {
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  /* Time spent in the kernels of GPU devices. Only available when the device queues record
+   * per-kernel performance, see DeviceQueue::get_kernel_stats(). */
+  NamedTimeStats device_kernels;
+  /* Average fraction of the path states which were busy during path tracing, one entry per GPU
+   * device. */
+  vector<float> device_occupancy;
 };
 
 class UpdateTimeStats {
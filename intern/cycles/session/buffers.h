@@ -155,7 +155,11 @@ class RenderBuffers {
   /* buffer parameters */
   BufferParams params;
 
-  /* float buffer */
+  /* float buffer
+   *
+   * All passes are stored with full precision: the kernels accumulate the sum of all samples in
+   * place, and with half floats this sum would lose precision after a few hundred samples and
+   * overflow for bright pixels. Memory usage of big frames is bounded by rendering in tiles. */
   device_vector<float> buffer;
 
   explicit RenderBuffers(Device *device);
@@ -717,6 +717,12 @@ void Session::collect_statistics(RenderStats *render_stats)
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
+  path_trace_->collect_statistics(*render_stats);
+}
+
+void Session::collect_device_statistics(RenderStats *render_stats)
+{
+  path_trace_->collect_statistics(*render_stats);
 }
 
 /* --------------------------------------------------------------------
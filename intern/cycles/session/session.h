@@ -146,6 +146,8 @@ class Session {
   float get_progress();
 
   void collect_statistics(RenderStats *stats);
+  /* Only collect the statistics of the device side execution, without the scene statistics. */
+  void collect_device_statistics(RenderStats *stats);
 
   /* --------------------------------------------------------------------
    * Full-frame on-disk storage.
@@ -32,8 +32,14 @@ void EdgeDice::reserve(int num_verts, int num_triangles)
   vert_offset = mesh->get_verts().size();
   tri_offset = mesh->num_triangles();
 
-  mesh->resize_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles());
-  mesh->reserve_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles() + num_triangles);
+  /* Triangles are written at the index known from the subpatch, rather than appended, so that
+   * subpatches can be diced in any order. */
+  mesh->resize_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles() + num_triangles);
+
+  mesh->tag_triangles_modified();
+  mesh->tag_shader_modified();
+  mesh->tag_smooth_modified();
+  mesh->tag_triangle_patch_modified();
 
   Attribute *attr_vN = mesh->attributes.add(ATTR_STD_VERTEX_NORMAL);
 
@@ -56,17 +62,22 @@ void EdgeDice::set_vert(Patch *patch, int index, float2 uv)
   params.mesh->vert_patch_uv[index + vert_offset] = make_float2(uv.x, uv.y);
 }
 
-void EdgeDice::add_triangle(Patch *patch, int v0, int v1, int v2)
+void EdgeDice::add_triangle(Patch *patch, int index, int v0, int v1, int v2)
 {
   Mesh *mesh = params.mesh;
+  const size_t triangle = tri_offset + index;
 
-  mesh->add_triangle(v0 + vert_offset, v1 + vert_offset, v2 + vert_offset, patch->shader, true);
-  params.mesh->triangle_patch[params.mesh->num_triangles() - 1] = patch->patch_index;
+  assert(triangle < mesh->num_triangles());
 
-  tri_offset++;
+  mesh->triangles[triangle * 3 + 0] = v0 + vert_offset;
+  mesh->triangles[triangle * 3 + 1] = v1 + vert_offset;
+  mesh->triangles[triangle * 3 + 2] = v2 + vert_offset;
+  mesh->shader[triangle] = patch->shader;
+  mesh->smooth[triangle] = true;
+  mesh->triangle_patch[triangle] = patch->patch_index;
 }
 
-void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
+void EdgeDice::stitch_triangles(Subpatch &sub, int edge, int &triangle_index)
 {
   int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
   int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
@@ -109,7 +120,7 @@ void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
         v2 = sub.get_vert_along_grid_edge(edge, ++i);
     }
 
-    add_triangle(sub.patch, v1, v0, v2);
+    add_triangle(sub.patch, triangle_index++, v1, v0, v2);
   }
 }
 
@@ -211,7 +222,7 @@ float QuadDice::scale_factor(Subpatch &sub, int Mu, int Mv)
   return S;
 }
 
-void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset, int &triangle_index)
 {
   /* create inner grid */
   float du = 1.0f / (float)Mu;
@@ -230,14 +241,21 @@ void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
         int i3 = offset + i + j * (Mu - 1);
         int i4 = offset + (i - 1) + j * (Mu - 1);
 
-        add_triangle(sub.patch, i1, i2, i3);
-        add_triangle(sub.patch, i1, i3, i4);
+        add_triangle(sub.patch, triangle_index++, i1, i2, i3);
+        add_triangle(sub.patch, triangle_index++, i1, i3, i4);
       }
     }
   }
 }
 
 void QuadDice::dice(Subpatch &sub)
+{
+  dice_grid(sub);
+  dice_sides(sub);
+  dice_stitch(sub);
+}
+
+void QuadDice::dice_grid(Subpatch &sub)
 {
   /* compute inner grid size with scale factor */
   int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
@@ -253,18 +271,32 @@ void QuadDice::dice(Subpatch &sub)
   Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
 
   /* inner grid */
-  add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
+  int triangle_index = sub.triangle_offset;
+  add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset, triangle_index);
+}
 
-  /* sides */
+void QuadDice::dice_sides(Subpatch &sub)
+{
   set_side(sub, 0);
   set_side(sub, 1);
   set_side(sub, 2);
   set_side(sub, 3);
+}
+
+void QuadDice::dice_stitch(Subpatch &sub)
+{
+  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
+  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+  Mu = max(Mu, 2);
+  Mv = max(Mv, 2);
+
+  /* Stitching triangles follow the triangles of the inner grid. */
+  int triangle_index = sub.triangle_offset + (Mu - 2) * (Mv - 2) * 2;
 
-  stitch_triangles(sub, 0);
-  stitch_triangles(sub, 1);
-  stitch_triangles(sub, 2);
-  stitch_triangles(sub, 3);
+  stitch_triangles(sub, 0, triangle_index);
+  stitch_triangles(sub, 1, triangle_index);
+  stitch_triangles(sub, 2, triangle_index);
+  stitch_triangles(sub, 3, triangle_index);
 }
 
 CCL_NAMESPACE_END
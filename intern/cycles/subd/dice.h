@@ -59,9 +59,9 @@ class EdgeDice {
   void reserve(int num_verts, int num_triangles);
 
   void set_vert(Patch *patch, int index, float2 uv);
-  void add_triangle(Patch *patch, int v0, int v1, int v2);
+  void add_triangle(Patch *patch, int index, int v0, int v1, int v2);
 
-  void stitch_triangles(Subpatch &sub, int edge);
+  void stitch_triangles(Subpatch &sub, int edge, int &triangle_index);
 };
 
 /* Quad EdgeDice */
@@ -75,7 +75,7 @@ class QuadDice : public EdgeDice {
   float2 map_uv(Subpatch &sub, float u, float v);
   void set_vert(Subpatch &sub, int index, float u, float v);
 
-  void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
+  void add_grid(Subpatch &sub, int Mu, int Mv, int offset, int &triangle_index);
 
   void set_side(Subpatch &sub, int edge);
 
@@ -83,6 +83,15 @@ class QuadDice : public EdgeDice {
   float scale_factor(Subpatch &sub, int Mu, int Mv);
 
   void dice(Subpatch &sub);
+
+  /* Dicing split into stages, so that multiple subpatches can be diced in parallel.
+   *
+   * The inner grid and the triangles only write data which is owned by the subpatch, and can be
+   * done for all subpatches concurrently. The vertices on the sides are shared with neighbor
+   * subpatches, so their evaluation is to happen serially, before the sides are stitched. */
+  void dice_grid(Subpatch &sub);
+  void dice_sides(Subpatch &sub);
+  void dice_stitch(Subpatch &sub);
 };
 
 CCL_NAMESPACE_END
@@ -12,6 +12,7 @@
 #include "util/foreach.h"
 #include "util/hash.h"
 #include "util/math.h"
+#include "util/tbb.h"
 #include "util/types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -708,14 +709,6 @@ void DiagSplit::post_split()
   int num_verts = num_alloced_verts;
   int num_triangles = 0;
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    subpatches[i].inner_grid_vert_offset = num_verts;
-    num_verts += subpatches[i].calc_num_inner_verts();
-    num_triangles += subpatches[i].calc_num_triangles();
-  }
-
-  dice.reserve(num_verts, num_triangles);
-
   for (size_t i = 0; i < subpatches.size(); i++) {
     Subpatch &sub = subpatches[i];
 
@@ -724,9 +717,40 @@ void DiagSplit::post_split()
     sub.edge_v0.T = max(sub.edge_v0.T, 1);
     sub.edge_v1.T = max(sub.edge_v1.T, 1);
 
-    dice.dice(sub);
+    /* Prefix sum of the vertices and triangles, so that every subpatch knows where to write its
+     * data to and they can be diced independently. */
+    sub.inner_grid_vert_offset = num_verts;
+    sub.triangle_offset = num_triangles;
+    num_verts += sub.calc_num_inner_verts();
+    num_triangles += sub.calc_num_triangles();
   }
 
+  dice.reserve(num_verts, num_triangles);
+
+  static const int SUBPATCHES_PER_TASK = 64;
+
+  /* The inner grids only write vertices which are owned by their subpatch. */
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), SUBPATCHES_PER_TASK),
+               [&](const blocked_range<size_t> &range) {
+                 for (size_t i = range.begin(); i != range.end(); i++) {
+                   dice.dice_grid(subpatches[i]);
+                 }
+               });
+
+  /* Vertices on the sides are shared between subpatches. Evaluate them serially, so that the
+   * result does not depend on the order in which the subpatches are diced. */
+  for (size_t i = 0; i < subpatches.size(); i++) {
+    dice.dice_sides(subpatches[i]);
+  }
+
+  /* Stitching reads the side vertices, and only writes triangles owned by the subpatch. */
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), SUBPATCHES_PER_TASK),
+               [&](const blocked_range<size_t> &range) {
+                 for (size_t i = range.begin(); i != range.end(); i++) {
+                   dice.dice_stitch(subpatches[i]);
+                 }
+               });
+
   /* Cleanup */
   subpatches.clear();
   edges.clear();
@@ -0,0 +1,152 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "device/device.h"
+
+#include "scene/geometry.h"
+#include "scene/mesh.h"
+#include "scene/scene.h"
+
+#include "util/foreach.h"
+#include "util/stats.h"
+
+CCL_NAMESPACE_BEGIN
+
+class SceneGeometry : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+  SceneParams scene_params;
+  Scene *scene;
+
+  virtual void SetUp()
+  {
+    device_cpu = Device::create(device_info, stats, profiler);
+    scene = new Scene(scene_params, device_cpu);
+  }
+
+  virtual void TearDown()
+  {
+    delete scene;
+    delete device_cpu;
+  }
+
+  /* New geometry needs a BVH build, like geometry synced from Blender. */
+  Mesh *add_mesh(const int num_triangles)
+  {
+    Mesh *mesh = scene->create_node<Mesh>();
+    set_triangles(mesh, num_triangles);
+    return mesh;
+  }
+
+  /* Replace the triangles of the mesh, which changes its topology so it needs a BVH rebuild. */
+  void set_triangles(Mesh *mesh, const int num_triangles)
+  {
+    mesh->clear();
+    mesh->reserve_mesh(num_triangles * 3, num_triangles);
+    for (int i = 0; i < num_triangles; i++) {
+      mesh->add_vertex(make_float3(i, 0.0f, 0.0f));
+      mesh->add_vertex(make_float3(i, 1.0f, 0.0f));
+      mesh->add_vertex(make_float3(i, 0.0f, 1.0f));
+      mesh->add_triangle(i * 3, i * 3 + 1, i * 3 + 2, 0, false);
+    }
+    mesh->tag_update(scene, true);
+  }
+
+  /* Reset the update flags like a BVH build or refit does. */
+  void clear_update_flags()
+  {
+    foreach (Geometry *geom, scene->geometry) {
+      geom->need_update_rebuild = false;
+      geom->need_update_bvh_for_offset = false;
+    }
+  }
+};
+
+TEST_F(SceneGeometry, offsets_with_rebuild_and_refit)
+{
+  Mesh *mesh_a = add_mesh(2);
+  Mesh *mesh_b = add_mesh(1);
+  Mesh *mesh_c = add_mesh(3);
+
+  /* All geometry is new, so it is packed in scene order. */
+  scene->geometry_manager->geom_calc_offset(scene, BVH_LAYOUT_BVH2);
+  EXPECT_EQ(mesh_a->prim_offset, 0u);
+  EXPECT_EQ(mesh_b->prim_offset, 2u);
+  EXPECT_EQ(mesh_c->prim_offset, 3u);
+  clear_update_flags();
+
+  /* The first mesh changes topology and the last one is only deformed. The changed mesh is moved
+   * to the end, so the other meshes move once and their BVHs are refit. */
+  set_triangles(mesh_a, 4);
+  mesh_c->tag_update(scene, false);
+  scene->geometry_manager->geom_calc_offset(scene, BVH_LAYOUT_BVH2);
+  EXPECT_EQ(mesh_b->prim_offset, 0u);
+  EXPECT_EQ(mesh_c->prim_offset, 1u);
+  EXPECT_EQ(mesh_a->prim_offset, 4u);
+  EXPECT_TRUE(mesh_b->need_update_bvh_for_offset);
+  EXPECT_TRUE(mesh_c->need_update_bvh_for_offset);
+  EXPECT_FALSE(mesh_b->need_update_rebuild);
+  EXPECT_FALSE(mesh_c->need_update_rebuild);
+  clear_update_flags();
+
+  /* From then on, topology changes of the first mesh no longer move the others. */
+  set_triangles(mesh_a, 5);
+  mesh_c->tag_update(scene, false);
+  scene->geometry_manager->geom_calc_offset(scene, BVH_LAYOUT_BVH2);
+  EXPECT_EQ(mesh_b->prim_offset, 0u);
+  EXPECT_EQ(mesh_c->prim_offset, 1u);
+  EXPECT_EQ(mesh_a->prim_offset, 4u);
+  EXPECT_FALSE(mesh_b->need_update_bvh_for_offset);
+  EXPECT_FALSE(mesh_c->need_update_bvh_for_offset);
+  EXPECT_FALSE(mesh_a->need_update_bvh_for_offset);
+  EXPECT_TRUE(mesh_a->need_update_rebuild);
+  clear_update_flags();
+
+  /* Another mesh that changes topology is moved to the end, which moves the mesh after it once. */
+  set_triangles(mesh_c, 2);
+  scene->geometry_manager->geom_calc_offset(scene, BVH_LAYOUT_BVH2);
+  EXPECT_EQ(mesh_b->prim_offset, 0u);
+  EXPECT_EQ(mesh_a->prim_offset, 1u);
+  EXPECT_EQ(mesh_c->prim_offset, 6u);
+  EXPECT_FALSE(mesh_b->need_update_bvh_for_offset);
+  EXPECT_TRUE(mesh_a->need_update_bvh_for_offset);
+}
+
+TEST_F(SceneGeometry, offsets_with_rebuild_optix)
+{
+  Mesh *mesh_a = add_mesh(2);
+  Mesh *mesh_b = add_mesh(1);
+  Mesh *mesh_c = add_mesh(3);
+  scene->geometry_manager->geom_calc_offset(scene, BVH_LAYOUT_OPTIX);
+  clear_update_flags();
+
+  /* OptiX can't refit geometry that moved, so moved geometry is rebuilt. */
+  set_triangles(mesh_b, 2);
+  mesh_c->tag_update(scene, false);
+  scene->geometry_manager->geom_calc_offset(scene, BVH_LAYOUT_OPTIX);
+  EXPECT_EQ(mesh_a->prim_offset, 0u);
+  EXPECT_EQ(mesh_c->prim_offset, 2u);
+  EXPECT_EQ(mesh_b->prim_offset, 5u);
+  EXPECT_FALSE(mesh_a->need_update_rebuild);
+  EXPECT_TRUE(mesh_c->need_update_rebuild);
+  clear_update_flags();
+
+  /* Deforming the meshes that did not move doesn't need a rebuild. */
+  mesh_a->tag_update(scene, false);
+  mesh_c->tag_update(scene, false);
+  set_triangles(mesh_b, 3);
+  scene->geometry_manager->geom_calc_offset(scene, BVH_LAYOUT_OPTIX);
+  EXPECT_EQ(mesh_a->prim_offset, 0u);
+  EXPECT_EQ(mesh_c->prim_offset, 2u);
+  EXPECT_EQ(mesh_b->prim_offset, 5u);
+  EXPECT_FALSE(mesh_a->need_update_rebuild);
+  EXPECT_FALSE(mesh_c->need_update_rebuild);
+  EXPECT_TRUE(mesh_b->need_update_rebuild);
+}
+
+CCL_NAMESPACE_END
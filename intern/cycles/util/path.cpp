@@ -360,6 +360,13 @@ string path_user_get(const string &sub)
 
 string path_cache_get(const string &sub)
 {
+  /* Allows to share the cache between machines, so that kernels are compiled only once for all
+   * nodes of a render farm. */
+  static const char *env_cache_path = getenv("CYCLES_CACHE_PATH");
+  if (env_cache_path != NULL) {
+    return path_join(env_cache_path, sub);
+  }
+
 #if defined(__linux__) || defined(__APPLE__)
   if (cached_xdg_cache_path == "") {
     cached_xdg_cache_path = path_xdg_cache_get();
@@ -1056,6 +1056,14 @@ int GHOST_XrSessionIsRunning(const GHOST_XrContextHandle xr_context);
  */
 int GHOST_XrSessionNeedsUpsideDownDrawing(const GHOST_XrContextHandle xr_context);
 
+/**
+ * Set the fraction of the recommended view resolution that views are drawn with. Views are drawn
+ * into a sub-image of the swapchain images, which the OpenXR runtime scales up to the display
+ * resolution. Takes effect on the next #GHOST_XrSessionDrawViews() call.
+ * \note Only to be called after session start.
+ */
+void GHOST_XrSessionSetResolutionScale(GHOST_XrContextHandle xr_context, float scale);
+
 /* events */
 /**
  * Invoke handling of all OpenXR events for \a xr_context. Should be called on every main-loop
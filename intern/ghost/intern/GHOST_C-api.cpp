@@ -1016,6 +1016,13 @@ int GHOST_XrSessionNeedsUpsideDownDrawing(const GHOST_XrContextHandle xr_context
   return 0; /* Only reached if exception is thrown. */
 }
 
+void GHOST_XrSessionSetResolutionScale(GHOST_XrContextHandle xr_contexthandle, float scale)
+{
+  GHOST_IXrContext *xr_context = (GHOST_IXrContext *)xr_contexthandle;
+  GHOST_XrSession *xr_session = xr_context->getSession();
+  GHOST_XR_CAPI_CALL(xr_session->setResolutionScale(scale), xr_context);
+}
+
 int GHOST_XrCreateActionSet(GHOST_XrContextHandle xr_contexthandle,
                             const GHOST_XrActionSetInfo *info)
 {
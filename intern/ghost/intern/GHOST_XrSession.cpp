@@ -481,7 +481,8 @@ void GHOST_XrSession::drawView(GHOST_XrSwapchain &swapchain,
   r_proj_layer_view.type = XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW;
   r_proj_layer_view.pose = view.pose;
   r_proj_layer_view.fov = view.fov;
-  swapchain.updateCompositionLayerProjectViewSubImage(r_proj_layer_view.subImage);
+  swapchain.updateCompositionLayerProjectViewSubImage(r_proj_layer_view.subImage,
+                                                      m_resolution_scale);
 
   assert(view_idx < 256);
   draw_view_info.view_idx = char(view_idx);
@@ -558,6 +559,11 @@ bool GHOST_XrSession::needsUpsideDownDrawing() const
   return m_gpu_binding && m_gpu_binding->needsUpsideDownDrawing(*m_gpu_ctx);
 }
 
+void GHOST_XrSession::setResolutionScale(float scale)
+{
+  m_resolution_scale = std::clamp(scale, 0.0f, 1.0f);
+}
+
 /** \} */ /* Drawing */
 
 /* -------------------------------------------------------------------- */
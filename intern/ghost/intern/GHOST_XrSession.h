@@ -33,6 +33,7 @@ class GHOST_XrSession {
 
   bool isRunning() const;
   bool needsUpsideDownDrawing() const;
+  void setResolutionScale(float scale);
 
   void unbindGraphicsContext(); /* Public so context can ensure it's unbound as needed. */
 
@@ -95,6 +96,8 @@ class GHOST_XrSession {
 
   /** Rendering information. Set when drawing starts. */
   std::unique_ptr<GHOST_XrDrawInfo> m_draw_info;
+  /** Fraction of the swapchain image size that views are drawn with. */
+  float m_resolution_scale = 1.0f;
 
   void initSystem();
   void beginSession();
@@ -4,6 +4,7 @@
  * \ingroup GHOST
  */
 
+#include <algorithm>
 #include <cassert>
 
 #include "GHOST_C-api.h"
@@ -114,11 +115,15 @@ XrSwapchainImageBaseHeader *GHOST_XrSwapchain::acquireDrawableSwapchainImage()
   return m_oxr->swapchain_images[image_idx];
 }
 
-void GHOST_XrSwapchain::updateCompositionLayerProjectViewSubImage(XrSwapchainSubImage &r_sub_image)
+void GHOST_XrSwapchain::updateCompositionLayerProjectViewSubImage(XrSwapchainSubImage &r_sub_image,
+                                                                  float resolution_scale)
 {
+  const int32_t width = std::max(int32_t(m_image_width * resolution_scale + 0.5f), 1);
+  const int32_t height = std::max(int32_t(m_image_height * resolution_scale + 0.5f), 1);
+
   r_sub_image.swapchain = m_oxr->swapchain;
   r_sub_image.imageRect.offset = {0, 0};
-  r_sub_image.imageRect.extent = {m_image_width, m_image_height};
+  r_sub_image.imageRect.extent = {width, height};
 }
 
 GHOST_TXrSwapchainFormat GHOST_XrSwapchain::getFormat() const
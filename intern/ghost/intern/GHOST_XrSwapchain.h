@@ -21,7 +21,12 @@ class GHOST_XrSwapchain {
   XrSwapchainImageBaseHeader *acquireDrawableSwapchainImage();
   void releaseImage();
 
-  void updateCompositionLayerProjectViewSubImage(XrSwapchainSubImage &r_sub_image);
+  /**
+   * \param resolution_scale: Fraction of the image size to use for the sub-image, so that views
+   * can be drawn at a lower resolution than the swapchain was created with.
+   */
+  void updateCompositionLayerProjectViewSubImage(XrSwapchainSubImage &r_sub_image,
+                                                 float resolution_scale);
 
   GHOST_TXrSwapchainFormat getFormat() const;
   bool isBufferSRGB() const;
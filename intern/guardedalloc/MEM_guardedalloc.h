@@ -247,6 +247,40 @@ void MEM_use_lockfree_allocator(void);
  * NOTE: The switch between allocator types can only happen before any allocation did happen. */
 void MEM_use_guarded_allocator(void);
 
+/**
+ * Start recording every \a sample_interval-th allocation of the lock-free allocator per thread,
+ * with its name, size and a hash of its call-stack. Sampled blocks are tracked until they are
+ * freed, so snapshots show which allocations hold the memory that is in use. Restarting the
+ * profiler discards the previous samples.
+ *
+ * Unlike the guarded allocator this is cheap enough to be used in production, the overhead of
+ * allocations that aren't sampled is a thread-local counter.
+ */
+void MEM_profiler_start(unsigned int sample_interval);
+void MEM_profiler_stop(void);
+bool MEM_profiler_is_running(void);
+
+/**
+ * Call \a func for every group of sampled blocks that are still allocated, grouped by name and
+ * call-stack. The sizes are the sampled ones, multiply them by the sample interval for an
+ * estimate of the total. Allocations done by \a func are not sampled.
+ */
+void MEM_profiler_snapshot(void (*func)(void *user_data,
+                                        const char *name,
+                                        unsigned int stack_hash,
+                                        size_t blocks_num,
+                                        size_t size),
+                           void *user_data);
+/**
+ * Write a snapshot as comma separated values, sorted by size.
+ * \return false when the profiler isn't running or the file can't be written.
+ */
+bool MEM_profiler_snapshot_write(const char *filepath);
+/** Set file a snapshot is written to by #MEM_profiler_exit. */
+void MEM_profiler_exit_filepath_set(const char *filepath);
+/** Write a snapshot to the file set by #MEM_profiler_exit_filepath_set, if any. */
+void MEM_profiler_exit(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -89,6 +89,28 @@ void aligned_free(void *ptr);
 extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
+/* Memory usage counters of the lock-free allocator, see `memory_usage.cc`. */
+void memory_usage_block_alloc(size_t size);
+void memory_usage_block_free(size_t size);
+size_t memory_usage_block_num(void);
+size_t memory_usage_current(void);
+size_t memory_usage_peak(void);
+void memory_usage_peak_reset(void);
+
+/* Sampling profiler of the lock-free allocator, see `memory_profiler.cc`. */
+extern bool memory_profiler_active;
+/** Returns true when the block is sampled and #memory_profiler_free has to be called for it. */
+bool memory_profiler_alloc(const void *ptr, size_t len, const char *str);
+void memory_profiler_free(const void *ptr);
+
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+/* Per-thread cache of small blocks for the lock-free allocator, see `small_block_cache.cc`.
+ * The size passed to the free function must be the one the block was allocated with. */
+void *small_block_cache_malloc(size_t size);
+void *small_block_cache_calloc(size_t size);
+void small_block_cache_free(void *ptr, size_t size);
+#endif
+
 /* Prototypes for counted allocator functions */
 size_t MEM_lockfree_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_lockfree_freeN(void *vmemh);
@@ -6,6 +6,7 @@
  * Memory allocation which keeps track on allocated memory counters
  */
 
+#include <assert.h>
 #include <stdarg.h>
 #include <stdio.h> /* printf */
 #include <stdlib.h>
@@ -17,7 +18,6 @@
 /* to ensure strict conversions */
 #include "../../source/blender/blenlib/BLI_strict_flags.h"
 
-#include "atomic_ops.h"
 #include "mallocn_intern.h"
 
 typedef struct MemHead {
@@ -30,33 +30,33 @@ typedef struct MemHeadAligned {
   size_t len;
 } MemHeadAligned;
 
-static unsigned int totblock = 0;
-static size_t mem_in_use = 0, peak_mem = 0;
 static bool malloc_debug_memset = false;
 
 static void (*error_callback)(const char *) = NULL;
 
 enum {
   MEMHEAD_ALIGN_FLAG = 1,
+  /* Lengths are aligned to 4 bytes, so another bit is available. */
+  MEMHEAD_SAMPLED_FLAG = 2,
 };
 
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG)))
-
-/* Uncomment this to have proper peak counter. */
-#define USE_ATOMIC_MAX
-
-MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
-{
-#ifdef USE_ATOMIC_MAX
-  atomic_fetch_and_update_max_z(maximum_value, value);
+#define MEMHEAD_IS_SAMPLED(memhead) ((memhead)->len & (size_t)MEMHEAD_SAMPLED_FLAG)
+#define MEMHEAD_LEN(memhead) \
+  ((memhead)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG | MEMHEAD_SAMPLED_FLAG)))
+
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+#  define MEMHEAD_MALLOC(size) small_block_cache_malloc(size)
+#  define MEMHEAD_CALLOC(size) small_block_cache_calloc(size)
+#  define MEMHEAD_FREE(memhead, size) small_block_cache_free(memhead, size)
 #else
-  *maximum_value = value > *maximum_value ? value : *maximum_value;
+#  define MEMHEAD_MALLOC(size) malloc(size)
+#  define MEMHEAD_CALLOC(size) calloc(1, size)
+#  define MEMHEAD_FREE(memhead, size) free(memhead)
 #endif
-}
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
@@ -103,8 +103,10 @@ void MEM_lockfree_freeN(void *vmemh)
   MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
   size_t len = MEMHEAD_LEN(memh);
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  memory_usage_block_free(len);
+  if (UNLIKELY(MEMHEAD_IS_SAMPLED(memh))) {
+    memory_profiler_free(vmemh);
+  }
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -114,7 +116,7 @@ void MEM_lockfree_freeN(void *vmemh)
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
   else {
-    free(memh);
+    MEMHEAD_FREE(memh, len + sizeof(MemHead));
   }
 }
 
@@ -220,20 +222,21 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  memh = (MemHead *)MEMHEAD_CALLOC(len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_block_alloc(len);
+    if (UNLIKELY(memory_profiler_active) && memory_profiler_alloc(memh + 1, len, str)) {
+      memh->len |= (size_t)MEMHEAD_SAMPLED_FLAG;
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (uint)mem_in_use);
+              (uint)memory_usage_current());
   return NULL;
 }
 
@@ -247,7 +250,7 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)memory_usage_current());
     abort();
     return NULL;
   }
@@ -261,7 +264,7 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  memh = (MemHead *)MEMHEAD_MALLOC(len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
@@ -269,16 +272,17 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
     }
 
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_block_alloc(len);
+    if (UNLIKELY(memory_profiler_active) && memory_profiler_alloc(memh + 1, len, str)) {
+      memh->len |= (size_t)MEMHEAD_SAMPLED_FLAG;
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (uint)mem_in_use);
+              (uint)memory_usage_current());
   return NULL;
 }
 
@@ -292,7 +296,7 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (uint)mem_in_use);
+        (uint)memory_usage_current());
     abort();
     return NULL;
   }
@@ -340,16 +344,17 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
 
     memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_block_alloc(len);
+    if (UNLIKELY(memory_profiler_active) && memory_profiler_alloc(memh + 1, len, str)) {
+      memh->len |= (size_t)MEMHEAD_SAMPLED_FLAG;
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (uint)mem_in_use);
+              (uint)memory_usage_current());
   return NULL;
 }
 
@@ -369,8 +374,8 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n", (double)memory_usage_current() / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n", (double)memory_usage_peak() / (double)(1024 * 1024));
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -398,23 +403,22 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
-  return mem_in_use;
+  return memory_usage_current();
 }
 
 uint MEM_lockfree_get_memory_blocks_in_use(void)
 {
-  return totblock;
+  return (uint)memory_usage_block_num();
 }
 
-/* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  memory_usage_peak_reset();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
-  return peak_mem;
+  return memory_usage_peak();
 }
 
 #ifndef NDEBUG
@@ -0,0 +1,323 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Sampling allocation profiler of the lock-free allocator.
+ *
+ * Every N-th allocation of each thread is recorded with its name, size and a hash of its
+ * call-stack, the block is flagged in its #MemHead so that freeing it removes the record again.
+ * Only the sampled allocations take the lock of the profiler, so the overhead scales with the
+ * sample interval.
+ *
+ * The profiler doesn't allocate memory with the allocator it profiles, its containers use the
+ * system allocator directly. That avoids recursion and keeps its own memory out of the usage
+ * counters and the leak detector.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#elif defined(HAVE_EXECINFO_H)
+#  include <execinfo.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+/** Frames of the profiler and the allocator itself. */
+constexpr int stack_frames_skip = 2;
+constexpr int stack_frames_max = 24;
+
+template<typename T> struct SystemAllocator {
+  using value_type = T;
+
+  SystemAllocator() = default;
+  template<typename U> SystemAllocator(const SystemAllocator<U> & /*other*/)
+  {
+  }
+
+  T *allocate(const size_t n)
+  {
+    void *ptr = malloc(n * sizeof(T));
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *ptr, const size_t /*n*/)
+  {
+    free(ptr);
+  }
+
+  template<typename U> bool operator==(const SystemAllocator<U> & /*other*/) const
+  {
+    return true;
+  }
+  template<typename U> bool operator!=(const SystemAllocator<U> & /*other*/) const
+  {
+    return false;
+  }
+};
+
+struct Sample {
+  const char *name;
+  size_t size;
+  uint32_t stack_hash;
+};
+
+struct SampleGroup {
+  const char *name;
+  uint32_t stack_hash;
+  size_t blocks_num;
+  size_t size;
+};
+
+struct Profiler {
+  std::mutex mutex;
+  std::unordered_map<const void *,
+                     Sample,
+                     std::hash<const void *>,
+                     std::equal_to<const void *>,
+                     SystemAllocator<std::pair<const void *const, Sample>>>
+      samples;
+};
+
+/**
+ * Created on first use and never destroyed, blocks that are freed in static destructors may still
+ * have to be removed from it.
+ */
+std::atomic<Profiler *> profiler = nullptr;
+/** Zero when the profiler is not running. */
+std::atomic<unsigned int> sample_interval = 0;
+
+/** Set from the command line, see #MEM_profiler_exit. */
+char exit_filepath[1024] = "";
+
+thread_local unsigned int allocations_until_sample = 0;
+/** Allocations done while recording or while reporting a snapshot are not sampled. */
+thread_local bool is_recording = false;
+
+uint32_t stack_hash_get()
+{
+  void *frames[stack_frames_max];
+#if defined(_WIN32)
+  ULONG hash = 0;
+  RtlCaptureStackBackTrace(stack_frames_skip, stack_frames_max, frames, &hash);
+  return uint32_t(hash);
+#elif defined(HAVE_EXECINFO_H)
+  const int frames_num = backtrace(frames, stack_frames_max);
+  /* FNV-1a over the return addresses. */
+  uint32_t hash = 2166136261u;
+  for (int i = stack_frames_skip; i < frames_num; i++) {
+    const uintptr_t address = uintptr_t(frames[i]);
+    for (size_t byte = 0; byte < sizeof(address); byte++) {
+      hash = (hash ^ uint32_t((address >> (byte * 8)) & 0xff)) * 16777619u;
+    }
+  }
+  return hash;
+#else
+  (void)frames;
+  return 0;
+#endif
+}
+
+std::vector<SampleGroup, SystemAllocator<SampleGroup>> snapshot_groups()
+{
+  std::vector<SampleGroup, SystemAllocator<SampleGroup>> groups;
+  Profiler *prof = profiler.load(std::memory_order_acquire);
+  if (prof == nullptr) {
+    return groups;
+  }
+
+  struct GroupKey {
+    const char *name;
+    uint32_t stack_hash;
+    bool operator==(const GroupKey &other) const
+    {
+      return name == other.name && stack_hash == other.stack_hash;
+    }
+  };
+  struct GroupKeyHash {
+    size_t operator()(const GroupKey &key) const
+    {
+      return std::hash<const void *>()(key.name) ^ (size_t(key.stack_hash) * 0x9e3779b97f4a7c15);
+    }
+  };
+  std::unordered_map<GroupKey,
+                     size_t,
+                     GroupKeyHash,
+                     std::equal_to<GroupKey>,
+                     SystemAllocator<std::pair<const GroupKey, size_t>>>
+      group_indices;
+
+  std::lock_guard<std::mutex> lock(prof->mutex);
+  for (const auto &item : prof->samples) {
+    const Sample &sample = item.second;
+    const auto [it, is_new] = group_indices.insert({{sample.name, sample.stack_hash}, 0});
+    if (is_new) {
+      it->second = groups.size();
+      groups.push_back({sample.name, sample.stack_hash, 0, 0});
+    }
+    SampleGroup &group = groups[it->second];
+    group.blocks_num++;
+    group.size += sample.size;
+  }
+  return groups;
+}
+
+}  // namespace
+
+bool memory_profiler_active = false;
+
+bool memory_profiler_alloc(const void *ptr, size_t len, const char *str)
+{
+  if (is_recording) {
+    return false;
+  }
+  if (allocations_until_sample > 1) {
+    allocations_until_sample--;
+    return false;
+  }
+  const unsigned int interval = sample_interval.load(std::memory_order_acquire);
+  if (interval == 0) {
+    return false;
+  }
+  allocations_until_sample = interval;
+
+  is_recording = true;
+  const uint32_t stack_hash = stack_hash_get();
+  Profiler *prof = profiler.load(std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(prof->mutex);
+    prof->samples.insert_or_assign(ptr, Sample{str, len, stack_hash});
+  }
+  is_recording = false;
+  return true;
+}
+
+void memory_profiler_free(const void *ptr)
+{
+  Profiler *prof = profiler.load(std::memory_order_acquire);
+  if (prof == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(prof->mutex);
+  prof->samples.erase(ptr);
+}
+
+void MEM_profiler_start(unsigned int interval)
+{
+  if (interval == 0) {
+    MEM_profiler_stop();
+    return;
+  }
+  Profiler *prof = profiler.load(std::memory_order_acquire);
+  if (prof == nullptr) {
+    prof = new (malloc(sizeof(Profiler))) Profiler();
+    profiler.store(prof, std::memory_order_release);
+  }
+  {
+    std::lock_guard<std::mutex> lock(prof->mutex);
+    prof->samples.clear();
+  }
+  sample_interval.store(interval, std::memory_order_release);
+  memory_profiler_active = true;
+}
+
+void MEM_profiler_stop(void)
+{
+  memory_profiler_active = false;
+  sample_interval.store(0, std::memory_order_release);
+  Profiler *prof = profiler.load(std::memory_order_acquire);
+  if (prof != nullptr) {
+    std::lock_guard<std::mutex> lock(prof->mutex);
+    prof->samples.clear();
+  }
+}
+
+bool MEM_profiler_is_running(void)
+{
+  return sample_interval.load(std::memory_order_relaxed) != 0;
+}
+
+void MEM_profiler_snapshot(void (*func)(void *user_data,
+                                        const char *name,
+                                        unsigned int stack_hash,
+                                        size_t blocks_num,
+                                        size_t size),
+                           void *user_data)
+{
+  const bool was_recording = is_recording;
+  is_recording = true;
+  for (const SampleGroup &group : snapshot_groups()) {
+    func(user_data, group.name, group.stack_hash, group.blocks_num, group.size);
+  }
+  is_recording = was_recording;
+}
+
+bool MEM_profiler_snapshot_write(const char *filepath)
+{
+  const unsigned int interval = sample_interval.load(std::memory_order_relaxed);
+  if (interval == 0) {
+    return false;
+  }
+  FILE *file = fopen(filepath, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  const bool was_recording = is_recording;
+  is_recording = true;
+  std::vector<SampleGroup, SystemAllocator<SampleGroup>> groups = snapshot_groups();
+  std::sort(groups.begin(), groups.end(), [](const SampleGroup &a, const SampleGroup &b) {
+    return a.size > b.size;
+  });
+
+  fprintf(file, "estimated_size,sampled_size,sampled_blocks,stack_hash,name\n");
+  for (const SampleGroup &group : groups) {
+    fprintf(file,
+            "%llu,%llu,%llu,%08x,\"%s\"\n",
+            (unsigned long long)group.size * interval,
+            (unsigned long long)group.size,
+            (unsigned long long)group.blocks_num,
+            group.stack_hash,
+            group.name ? group.name : "");
+  }
+  is_recording = was_recording;
+
+  const bool success = !ferror(file);
+  return (fclose(file) == 0) && success;
+}
+
+void MEM_profiler_exit_filepath_set(const char *filepath)
+{
+  strncpy(exit_filepath, filepath, sizeof(exit_filepath) - 1);
+}
+
+void MEM_profiler_exit(void)
+{
+  if (exit_filepath[0] == '\0' || !MEM_profiler_is_running()) {
+    return;
+  }
+  if (MEM_profiler_snapshot_write(exit_filepath)) {
+    printf("Memory profile written to '%s'\n", exit_filepath);
+  }
+  else {
+    fprintf(stderr, "Failed to write memory profile to '%s'\n", exit_filepath);
+  }
+  exit_filepath[0] = '\0';
+}
@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Memory usage counters of the lock-free allocator.
+ *
+ * The counters are split into shards which each live in their own cache line, every thread only
+ * updates the shard it was assigned to. This avoids that all threads write to the same cache line
+ * on every allocation. The totals are only summed up when they are queried, which happens rarely
+ * compared to allocations.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+/** More shards than threads would not reduce contention any further. */
+constexpr int shards_num = 64;
+
+/**
+ * The peak is only updated after a thread allocated this much memory since its last update, so
+ * that the shards don't have to be summed up on every allocation. This makes the peak less exact
+ * by up to this amount per thread.
+ */
+constexpr int64_t peak_update_threshold = 1024 * 1024;
+
+struct alignas(64) Shard {
+  /* Memory can be freed by other threads than the one that allocated it, so the values of a
+   * single shard can be negative, only their sum is meaningful. */
+  std::atomic<int64_t> blocks_num;
+  std::atomic<int64_t> mem_in_use;
+};
+
+/* These have static storage and trivial destructors, so they are zero initialized before any
+ * allocation happens and remain valid for allocations in static destructors. */
+Shard shards[shards_num];
+std::atomic<int> next_shard_index;
+std::atomic<size_t> peak_mem;
+
+thread_local int shard_index = -1;
+thread_local int64_t mem_allocated_since_peak_update = 0;
+
+Shard &get_shard()
+{
+  if (UNLIKELY(shard_index == -1)) {
+    shard_index = next_shard_index.fetch_add(1, std::memory_order_relaxed) % shards_num;
+  }
+  return shards[shard_index];
+}
+
+int64_t sum_shards(std::atomic<int64_t> Shard::*counter)
+{
+  int64_t sum = 0;
+  for (const Shard &shard : shards) {
+    sum += (shard.*counter).load(std::memory_order_relaxed);
+  }
+  return std::max<int64_t>(sum, 0);
+}
+
+void update_peak()
+{
+  mem_allocated_since_peak_update = 0;
+  const size_t mem_in_use = memory_usage_current();
+  size_t peak = peak_mem.load(std::memory_order_relaxed);
+  while (mem_in_use > peak &&
+         !peak_mem.compare_exchange_weak(peak, mem_in_use, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+void memory_usage_block_alloc(size_t size)
+{
+  Shard &shard = get_shard();
+  /* Relaxed atomics are enough, the counters are not used to synchronize anything. */
+  shard.blocks_num.fetch_add(1, std::memory_order_relaxed);
+  shard.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+
+  mem_allocated_since_peak_update += int64_t(size);
+  if (UNLIKELY(mem_allocated_since_peak_update >= peak_update_threshold)) {
+    update_peak();
+  }
+}
+
+void memory_usage_block_free(size_t size)
+{
+  Shard &shard = get_shard();
+  shard.blocks_num.fetch_sub(1, std::memory_order_relaxed);
+  shard.mem_in_use.fetch_sub(int64_t(size), std::memory_order_relaxed);
+}
+
+size_t memory_usage_block_num()
+{
+  return size_t(sum_shards(&Shard::blocks_num));
+}
+
+size_t memory_usage_current()
+{
+  return size_t(sum_shards(&Shard::mem_in_use));
+}
+
+size_t memory_usage_peak()
+{
+  update_peak();
+  return peak_mem.load(std::memory_order_relaxed);
+}
+
+void memory_usage_peak_reset()
+{
+  peak_mem.store(memory_usage_current(), std::memory_order_relaxed);
+}
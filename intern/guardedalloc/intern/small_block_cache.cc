@@ -0,0 +1,233 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Per-thread cache of small memory blocks for the lock-free allocator.
+ *
+ * Small blocks are rounded up to a fixed set of size classes. Freed blocks are kept in a list per
+ * size class of the freeing thread and handed out again by the next allocation of that class,
+ * without going through the system allocator. When a thread caches too many blocks of a class, a
+ * batch of them is moved to a shared depot, where threads which allocate more than they free can
+ * pick them up again. Moving whole batches keeps the time spent in the (short) depot lock low.
+ *
+ * Every block is an ordinary allocation of the system allocator with the size of its class, so
+ * it can always be given back with `free()`, for example when the cache of a thread is gone
+ * already. The caller is responsible for passing the same size to the free function as it
+ * allocated, the lock-free allocator gets it from the #MemHead.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+constexpr size_t size_class_step = 16;
+constexpr int size_classes_num = 32;
+/** Larger blocks are passed on to the system allocator directly. */
+constexpr size_t small_block_size_max = size_class_step * size_classes_num;
+
+/** Number of blocks moved between a thread cache and the depot at once. */
+constexpr int batch_size = 32;
+/** Maximum number of blocks of each size class that are kept by a thread. */
+constexpr int thread_blocks_max = 2 * batch_size;
+/** Maximum number of batches of each size class in the depot, others are freed. */
+constexpr int depot_batches_max = 64;
+
+/** Stored in the memory of the free blocks themselves. */
+struct FreeBlock {
+  FreeBlock *next;
+  /** Only used by the first block of a batch in the depot. */
+  FreeBlock *next_batch;
+};
+static_assert(sizeof(FreeBlock) <= size_class_step, "Free blocks must fit in every size class");
+
+struct ThreadBin {
+  FreeBlock *blocks;
+  int blocks_num;
+};
+
+struct alignas(64) DepotBin {
+  std::atomic_flag lock = ATOMIC_FLAG_INIT;
+  /** Every batch in the depot has exactly #batch_size blocks. */
+  FreeBlock *batches = nullptr;
+  int batches_num = 0;
+};
+
+enum class ThreadCacheState : uint8_t {
+  Unused,
+  Active,
+  Destroyed,
+};
+
+/* These have static storage and trivial destructors, so they are still valid for allocations in
+ * static destructors and thread exit handlers. */
+DepotBin depot[size_classes_num];
+thread_local ThreadBin thread_bins[size_classes_num];
+thread_local ThreadCacheState thread_cache_state = ThreadCacheState::Unused;
+
+void free_block_list(FreeBlock *block)
+{
+  while (block) {
+    FreeBlock *next = block->next;
+    free(block);
+    block = next;
+  }
+}
+
+/** Gives the blocks back to the system when the thread exits. */
+struct ThreadCacheLifetime {
+  ThreadCacheLifetime()
+  {
+    thread_cache_state = ThreadCacheState::Active;
+  }
+  ~ThreadCacheLifetime()
+  {
+    thread_cache_state = ThreadCacheState::Destroyed;
+    for (ThreadBin &bin : thread_bins) {
+      free_block_list(bin.blocks);
+      bin.blocks = nullptr;
+      bin.blocks_num = 0;
+    }
+  }
+};
+
+int size_class_index(const size_t size)
+{
+  return int((size - 1) / size_class_step);
+}
+
+size_t size_class_size(const int index)
+{
+  return size_t(index + 1) * size_class_step;
+}
+
+/** Returns null when the cache of this thread has been destroyed already. */
+ThreadBin *thread_bin_get(const int index)
+{
+  if (UNLIKELY(thread_cache_state != ThreadCacheState::Active)) {
+    if (thread_cache_state == ThreadCacheState::Destroyed) {
+      return nullptr;
+    }
+    static thread_local ThreadCacheLifetime lifetime;
+    (void)lifetime;
+  }
+  return &thread_bins[index];
+}
+
+void depot_lock(DepotBin &depot_bin)
+{
+  while (depot_bin.lock.test_and_set(std::memory_order_acquire)) {
+    /* Spin, the lock is only held for a few instructions. */
+  }
+}
+
+void depot_unlock(DepotBin &depot_bin)
+{
+  depot_bin.lock.clear(std::memory_order_release);
+}
+
+void thread_bin_refill(ThreadBin &bin, const int index)
+{
+  DepotBin &depot_bin = depot[index];
+  depot_lock(depot_bin);
+  FreeBlock *batch = depot_bin.batches;
+  if (batch) {
+    depot_bin.batches = batch->next_batch;
+    depot_bin.batches_num--;
+  }
+  depot_unlock(depot_bin);
+
+  if (batch) {
+    bin.blocks = batch;
+    bin.blocks_num = batch_size;
+  }
+}
+
+void thread_bin_release_batch(ThreadBin &bin, const int index)
+{
+  FreeBlock *batch = bin.blocks;
+  FreeBlock *batch_last = batch;
+  for (int i = 1; i < batch_size; i++) {
+    batch_last = batch_last->next;
+  }
+  bin.blocks = batch_last->next;
+  bin.blocks_num -= batch_size;
+  batch_last->next = nullptr;
+
+  DepotBin &depot_bin = depot[index];
+  depot_lock(depot_bin);
+  const bool depot_full = depot_bin.batches_num >= depot_batches_max;
+  if (!depot_full) {
+    batch->next_batch = depot_bin.batches;
+    depot_bin.batches = batch;
+    depot_bin.batches_num++;
+  }
+  depot_unlock(depot_bin);
+
+  if (depot_full) {
+    free_block_list(batch);
+  }
+}
+
+}  // namespace
+
+void *small_block_cache_malloc(size_t size)
+{
+  if (size > small_block_size_max) {
+    return malloc(size);
+  }
+  const int index = size_class_index(size);
+  ThreadBin *bin = thread_bin_get(index);
+  if (LIKELY(bin)) {
+    if (UNLIKELY(bin->blocks == nullptr)) {
+      thread_bin_refill(*bin, index);
+    }
+    if (LIKELY(bin->blocks)) {
+      FreeBlock *block = bin->blocks;
+      bin->blocks = block->next;
+      bin->blocks_num--;
+      return block;
+    }
+  }
+  /* Always allocate the full size of the class, the block may be reused for any size of it. */
+  return malloc(size_class_size(index));
+}
+
+void *small_block_cache_calloc(size_t size)
+{
+  if (size > small_block_size_max) {
+    return calloc(1, size);
+  }
+  void *ptr = small_block_cache_malloc(size);
+  if (LIKELY(ptr)) {
+    memset(ptr, 0, size);
+  }
+  return ptr;
+}
+
+void small_block_cache_free(void *ptr, size_t size)
+{
+  if (size > small_block_size_max) {
+    free(ptr);
+    return;
+  }
+  const int index = size_class_index(size);
+  ThreadBin *bin = thread_bin_get(index);
+  if (UNLIKELY(bin == nullptr)) {
+    free(ptr);
+    return;
+  }
+  FreeBlock *block = static_cast<FreeBlock *>(ptr);
+  block->next = bin->blocks;
+  bin->blocks = block;
+  bin->blocks_num++;
+  if (UNLIKELY(bin->blocks_num > thread_blocks_max)) {
+    thread_bin_release_batch(*bin, index);
+  }
+}
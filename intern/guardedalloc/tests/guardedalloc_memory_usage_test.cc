@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <thread>
+#include <vector>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, MemoryUsageAcrossThreads)
+{
+  const uint blocks_before = MEM_get_memory_blocks_in_use();
+  const size_t mem_before = MEM_get_memory_in_use();
+
+  const int threads_num = 8;
+  const int blocks_per_thread = 100;
+  const size_t block_size = 64;
+
+  /* Allocate on worker threads and free on the main thread, so that the counters of the
+   * allocating threads are decremented by another thread. */
+  std::vector<void *> blocks(threads_num * blocks_per_thread);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&blocks, i]() {
+      for (int j = 0; j < blocks_per_thread; j++) {
+        blocks[i * blocks_per_thread + j] = MEM_mallocN(block_size, __func__);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_before + threads_num * blocks_per_thread);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_before + threads_num * blocks_per_thread * block_size);
+  EXPECT_GE(MEM_get_peak_memory(), MEM_get_memory_in_use());
+
+  for (void *block : blocks) {
+    MEM_freeN(block);
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_before);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_before);
+}
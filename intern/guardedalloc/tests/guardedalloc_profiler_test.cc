@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <cstring>
+#include <vector>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+struct SnapshotGroup {
+  size_t blocks_num = 0;
+  size_t size = 0;
+};
+
+static const char *profiled_block_name = "profiled_block";
+
+void snapshot_group_find(void *user_data,
+                         const char *name,
+                         unsigned int /*stack_hash*/,
+                         size_t blocks_num,
+                         size_t size)
+{
+  if (strcmp(name, profiled_block_name) == 0) {
+    SnapshotGroup *group = static_cast<SnapshotGroup *>(user_data);
+    group->blocks_num += blocks_num;
+    group->size += size;
+  }
+}
+
+SnapshotGroup snapshot_group_get()
+{
+  SnapshotGroup group;
+  MEM_profiler_snapshot(snapshot_group_find, &group);
+  return group;
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, ProfilerSamplesLiveBlocks)
+{
+  MEM_profiler_start(1);
+  EXPECT_TRUE(MEM_profiler_is_running());
+
+  std::vector<void *> blocks;
+  for (int i = 0; i < 10; i++) {
+    blocks.push_back(MEM_mallocN(64, profiled_block_name));
+  }
+  SnapshotGroup group = snapshot_group_get();
+  EXPECT_EQ(group.blocks_num, 10);
+  EXPECT_EQ(group.size, 10 * 64);
+
+  for (int i = 0; i < 5; i++) {
+    MEM_freeN(blocks[i]);
+  }
+  group = snapshot_group_get();
+  EXPECT_EQ(group.blocks_num, 5);
+  EXPECT_EQ(group.size, 5 * 64);
+
+  /* Sampled blocks still report their original length. */
+  EXPECT_EQ(MEM_allocN_len(blocks[5]), 64);
+
+  MEM_profiler_stop();
+  EXPECT_FALSE(MEM_profiler_is_running());
+  EXPECT_EQ(snapshot_group_get().blocks_num, 0);
+
+  for (int i = 5; i < 10; i++) {
+    MEM_freeN(blocks[i]);
+  }
+}
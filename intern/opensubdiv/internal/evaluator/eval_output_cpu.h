@@ -25,13 +25,42 @@
 #include <opensubdiv/osd/cpuPatchTable.h>
 #include <opensubdiv/osd/cpuVertexBuffer.h>
 
+// The TBB evaluator is only available when OpenSubdiv itself was compiled with TBB.
+#if defined(WITH_TBB) && __has_include(<opensubdiv/osd/tbbEvaluator.h>)
+#  include <opensubdiv/osd/tbbEvaluator.h>
+#  define OPENSUBDIV_USE_TBB_EVALUATOR
+#endif
+
 using OpenSubdiv::Far::StencilTable;
-using OpenSubdiv::Osd::CpuEvaluator;
 using OpenSubdiv::Osd::CpuVertexBuffer;
 
 namespace blender {
 namespace opensubdiv {
 
+#ifdef OPENSUBDIV_USE_TBB_EVALUATOR
+// Evaluator that updates the refined control points from the stencils with multiple threads,
+// using the TBB evaluator, which works with the same CPU buffers. This is done for all refined
+// vertices at once and is single threaded in the CPU evaluator. Patches are evaluated with the
+// CPU evaluator, since limit points are requested one by one from already threaded code.
+class CpuEvaluator : public OpenSubdiv::Osd::CpuEvaluator {
+ public:
+  template<typename SRC_BUFFER, typename DST_BUFFER, typename STENCIL_TABLE>
+  static bool EvalStencils(SRC_BUFFER *src_buffer,
+                           const OpenSubdiv::Osd::BufferDescriptor &src_desc,
+                           DST_BUFFER *dst_buffer,
+                           const OpenSubdiv::Osd::BufferDescriptor &dst_desc,
+                           const STENCIL_TABLE *stencil_table,
+                           const CpuEvaluator * /*instance*/ = NULL,
+                           void * /*device_context*/ = NULL)
+  {
+    return OpenSubdiv::Osd::TbbEvaluator::EvalStencils(
+        src_buffer, src_desc, dst_buffer, dst_desc, stencil_table);
+  }
+};
+#else
+using OpenSubdiv::Osd::CpuEvaluator;
+#endif
+
 // NOTE: Define as a class instead of typedef to make it possible
 // to have anonymous class in opensubdiv_evaluator_internal.h
 class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
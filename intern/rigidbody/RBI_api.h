@@ -49,7 +49,8 @@ typedef struct rbConstraint rbConstraint;
 
 /* Create a new dynamics world instance */
 /* TODO: add args to set the type of constraint solvers, etc. */
-rbDynamicsWorld *RB_dworld_new(const float gravity[3]);
+/* use_multithreading: step independent simulation islands on multiple threads */
+rbDynamicsWorld *RB_dworld_new(const float gravity[3], bool use_multithreading);
 
 /* Delete the given dynamics world, and free any extra data it may require */
 void RB_dworld_delete(rbDynamicsWorld *world);
@@ -51,12 +51,19 @@
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 #include "BulletCollision/Gimpact/btGImpactShape.h"
 
+#if BT_THREADSAFE
+#  include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#  include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#endif
+
 struct rbDynamicsWorld {
   btDiscreteDynamicsWorld *dynamicsWorld;
   btDefaultCollisionConfiguration *collisionConfiguration;
   btDispatcher *dispatcher;
   btBroadphaseInterface *pairCache;
   btConstraintSolver *constraintSolver;
+  /* Solver for islands too big to be solved by a single thread, only for multi-threaded worlds. */
+  btConstraintSolver *constraintSolverMt;
   btOverlapFilterCallback *filterCallback;
 };
 struct rbRigidBody {
@@ -120,7 +127,23 @@ static inline void copy_quat_btquat(float quat[4], const btQuaternion &btquat)
 
 /* Setup ---------------------------- */
 
-rbDynamicsWorld *RB_dworld_new(const float gravity[3])
+#if BT_THREADSAFE
+/* Bullet uses a single global task scheduler for all multi-threaded worlds. It is created on first
+ * use and kept until exit, its threads go to sleep when no simulation is stepped. */
+static btITaskScheduler *rb_task_scheduler_ensure()
+{
+  static btITaskScheduler *scheduler = []() {
+    btITaskScheduler *default_scheduler = btCreateDefaultTaskScheduler();
+    if (default_scheduler) {
+      btSetTaskScheduler(default_scheduler);
+    }
+    return default_scheduler;
+  }();
+  return scheduler;
+}
+#endif
+
+rbDynamicsWorld *RB_dworld_new(const float gravity[3], bool use_multithreading)
 {
   rbDynamicsWorld *world = new rbDynamicsWorld;
 
@@ -135,12 +158,36 @@ rbDynamicsWorld *RB_dworld_new(const float gravity[3])
   world->filterCallback = new rbFilterCallback();
   world->pairCache->getOverlappingPairCache()->setOverlapFilterCallback(world->filterCallback);
 
-  /* constraint solving */
-  world->constraintSolver = new btSequentialImpulseConstraintSolver();
-
-  /* world */
-  world->dynamicsWorld = new btDiscreteDynamicsWorld(
-      world->dispatcher, world->pairCache, world->constraintSolver, world->collisionConfiguration);
+  world->constraintSolverMt = NULL;
+#if BT_THREADSAFE
+  btITaskScheduler *scheduler = use_multithreading ? rb_task_scheduler_ensure() : NULL;
+  if (scheduler && scheduler->getNumThreads() > 1) {
+    /* Simulation islands are solved in parallel, one solver per thread. */
+    btConstraintSolverPoolMt *solver_pool = new btConstraintSolverPoolMt(
+        scheduler->getNumThreads());
+    world->constraintSolver = solver_pool;
+    world->constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+
+    world->dynamicsWorld = new btDiscreteDynamicsWorldMt(world->dispatcher,
+                                                         world->pairCache,
+                                                         solver_pool,
+                                                         world->constraintSolverMt,
+                                                         world->collisionConfiguration);
+  }
+  else
+#else
+  (void)use_multithreading;
+#endif
+  {
+    /* constraint solving */
+    world->constraintSolver = new btSequentialImpulseConstraintSolver();
+
+    /* world */
+    world->dynamicsWorld = new btDiscreteDynamicsWorld(world->dispatcher,
+                                                       world->pairCache,
+                                                       world->constraintSolver,
+                                                       world->collisionConfiguration);
+  }
 
   RB_dworld_set_gravity(world, gravity);
 
@@ -152,6 +199,7 @@ void RB_dworld_delete(rbDynamicsWorld *world)
   /* bullet doesn't like if we free these in a different order */
   delete world->dynamicsWorld;
   delete world->constraintSolver;
+  delete world->constraintSolverMt;
   delete world->pairCache;
   delete world->dispatcher;
   delete world->collisionConfiguration;
@@ -0,0 +1,124 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Keep a Blender process with a loaded blend-file alive and render frames on request.
+
+This avoids paying for startup and file loading for every frame on render farms.
+Start it from the command line (after the blend-file)::
+
+   blender -b file.blend --render-server 8765
+
+Or from a script::
+
+   import bl_render_server
+   bl_render_server.serve(8765)
+
+Clients connect over TCP and send one request per line, every request gets a single line reply:
+
+``frame <number>``
+   Render the frame and save it, like ``-f <number>``.
+   Replies ``ok <filepath>`` or ``error <message>``.
+``ping``
+   Replies ``ok``.
+``quit``
+   Replies ``ok`` and stops the server, the remaining command line arguments are processed.
+"""
+
+__all__ = (
+    "render_frame",
+    "serve",
+)
+
+
+def render_frame(scene, frame):
+    """
+    Render a single frame of the scene and write it to the output path,
+    the same way as the ``-f`` command line argument does.
+
+    :arg scene: The scene to render.
+    :type scene: :class:`bpy.types.Scene`
+    :arg frame: The frame to render.
+    :type frame: int
+    :return: The path of the written file.
+    :rtype: str
+    """
+    import bpy
+
+    frame_start = scene.frame_start
+    frame_end = scene.frame_end
+    # Render through the animation code-path, so that the file is named and written
+    # just like it would be by running Blender for this single frame.
+    scene.frame_start = frame
+    scene.frame_end = frame
+    try:
+        bpy.ops.render.render(animation=True, scene=scene.name)
+    finally:
+        scene.frame_start = frame_start
+        scene.frame_end = frame_end
+    return scene.render.frame_path(frame=frame)
+
+
+def _handle_request(scene, line):
+    command, _, argument = line.strip().partition(" ")
+    if command == "ping":
+        return "ok", False
+    if command == "quit":
+        return "ok", True
+    if command == "frame":
+        try:
+            frame = int(argument)
+        except ValueError:
+            return "error invalid frame {!r}".format(argument), False
+        try:
+            filepath = render_frame(scene, frame)
+        except Exception as ex:
+            return "error {:s}".format(str(ex).replace("\n", " ")), False
+        return "ok {:s}".format(filepath), False
+    return "error unknown command {!r}".format(command), False
+
+
+def _serve_connection(scene, connection):
+    # Return true when a ``quit`` request was received.
+    with connection, connection.makefile("rw", encoding="utf-8", newline="\n") as stream:
+        for line in stream:
+            if not line.strip():
+                continue
+            reply, do_quit = _handle_request(scene, line)
+            stream.write(reply + "\n")
+            stream.flush()
+            if do_quit:
+                return True
+    return False
+
+
+def serve(port, *, host="127.0.0.1", scene=None):
+    """
+    Render frames requested by clients until a ``quit`` request is received.
+    Connections are handled one at a time, since only a single render can run per process.
+
+    :arg port: The TCP port to listen on.
+    :type port: int
+    :arg host: The address to listen on, only local connections are accepted by default.
+    :type host: str
+    :arg scene: The scene to render, the context scene when not set.
+    :type scene: :class:`bpy.types.Scene`
+    """
+    import socket
+    import bpy
+
+    if scene is None:
+        scene = bpy.context.scene
+
+    with socket.create_server((host, port)) as server:
+        print("Render server listening on {:s}:{:d}".format(host, port))
+        while True:
+            connection, address = server.accept()
+            try:
+                do_quit = _serve_connection(scene, connection)
+            except (BrokenPipeError, ConnectionResetError) as ex:
+                # A client going away must not stop the server, continue with the next one.
+                print("Render server lost connection to {:s}: {:s}".format(str(address), str(ex)))
+                continue
+            if do_quit:
+                print("Render server stopped")
+                return
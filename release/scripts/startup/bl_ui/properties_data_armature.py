@@ -46,6 +46,10 @@ class DATA_PT_skeleton(ArmatureButtonsPanel, Panel):
 
         layout.row().prop(arm, "pose_position", expand=True)
 
+        ob = context.object
+        if ob and ob.pose:
+            layout.prop(ob.pose, "use_playback_cache")
+
         col = layout.column()
         col.label(text="Layers:")
         col.prop(arm, "layers", text="")
@@ -673,6 +673,9 @@ class NODE_PT_quality(bpy.types.Panel):
         col = layout.column()
         if prefs.experimental.use_full_frame_compositor:
             col.prop(tree, "execution_mode")
+            if tree.execution_mode == 'FULL_FRAME':
+                col.prop(tree, "cache_limit")
+                col.prop(tree, "memory_limit")
 
         col.prop(tree, "render_quality", text="Render")
         col.prop(tree, "edit_quality", text="Edit")
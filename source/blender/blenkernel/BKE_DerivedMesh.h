@@ -125,10 +125,10 @@ struct DerivedMesh {
    * and freed on the next ->release(). consider using getVert/Edge/Face if
    * you are only interested in a few verts/edges/faces.
    */
-  struct MVert *(*getVertArray)(DerivedMesh *dm);
-  struct MEdge *(*getEdgeArray)(DerivedMesh *dm);
-  struct MLoop *(*getLoopArray)(DerivedMesh *dm);
-  struct MPoly *(*getPolyArray)(DerivedMesh *dm);
+  const struct MVert *(*getVertArray)(DerivedMesh *dm);
+  const struct MEdge *(*getEdgeArray)(DerivedMesh *dm);
+  const struct MLoop *(*getLoopArray)(DerivedMesh *dm);
+  const struct MPoly *(*getPolyArray)(DerivedMesh *dm);
 
   /** Copy all verts/edges/faces from the derived mesh into
    * *{vert/edge/face}_r (must point to a buffer large enough)
@@ -142,10 +142,10 @@ struct DerivedMesh {
    * from the derived mesh (this gives a pointer to the actual data, not
    * a copy)
    */
-  void *(*getVertDataArray)(DerivedMesh *dm, int type);
-  void *(*getEdgeDataArray)(DerivedMesh *dm, int type);
-  void *(*getLoopDataArray)(DerivedMesh *dm, int type);
-  void *(*getPolyDataArray)(DerivedMesh *dm, int type);
+  const void *(*getVertDataArray)(DerivedMesh *dm, int type);
+  const void *(*getEdgeDataArray)(DerivedMesh *dm, int type);
+  const void *(*getLoopDataArray)(DerivedMesh *dm, int type);
+  const void *(*getPolyDataArray)(DerivedMesh *dm, int type);
 
   /** Optional grid access for subsurf */
   int (*getNumGrids)(DerivedMesh *dm);
@@ -224,10 +224,10 @@ void DM_set_only_copy(DerivedMesh *dm, const struct CustomData_MeshMasks *mask);
  * \note these return pointers - any change modifies the internals of the mesh.
  * \{ */
 
-void *DM_get_vert_data_layer(struct DerivedMesh *dm, int type);
-void *DM_get_edge_data_layer(struct DerivedMesh *dm, int type);
-void *DM_get_poly_data_layer(struct DerivedMesh *dm, int type);
-void *DM_get_loop_data_layer(struct DerivedMesh *dm, int type);
+const void *DM_get_vert_data_layer(struct DerivedMesh *dm, int type);
+const void *DM_get_edge_data_layer(struct DerivedMesh *dm, int type);
+const void *DM_get_poly_data_layer(struct DerivedMesh *dm, int type);
+const void *DM_get_loop_data_layer(struct DerivedMesh *dm, int type);
 
 /** \} */
 
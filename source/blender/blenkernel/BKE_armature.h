@@ -625,7 +625,14 @@ void BKE_pose_splineik_evaluate(struct Depsgraph *depsgraph,
                                 struct Object *object,
                                 int rootchan_index);
 
-void BKE_pose_eval_done(struct Depsgraph *depsgraph, struct Object *object);
+void BKE_pose_eval_done(struct Depsgraph *depsgraph, struct Scene *scene, struct Object *object);
+
+/**
+ * Free the evaluated poses which were stored for playback, see #POSE_USE_CACHE.
+ */
+void BKE_pose_cache_free(struct bPose *pose);
+
+void BKE_pose_eval_cache_reset(struct Depsgraph *depsgraph, struct Object *object);
 
 void BKE_pose_eval_cleanup(struct Depsgraph *depsgraph,
                            struct Scene *scene,
@@ -206,6 +206,26 @@ void BKE_blendfile_library_relocate(struct BlendfileLinkAppendContext *lapp_cont
                                     struct Library *library,
                                     bool do_reload);
 
+/**
+ * Read the linked IDs tagged with both #LIB_TAG_DEFERRED and #LIB_TAG_DOIT from their libraries,
+ * and replace their placeholders by them.
+ *
+ * \note Clears #LIB_TAG_DOIT from all IDs in `bmain`.
+ */
+void BKE_blendfile_link_deferred_tagged_load(struct Main *bmain, struct ReportList *reports);
+/**
+ * Read the linked IDs tagged #LIB_TAG_DEFERRED that are used by objects visible in any view layer
+ * of the given `scene`, i.e. not in excluded collections, and not hidden both in viewports and
+ * renders. Also handles objects in instanced collections.
+ *
+ * Meant to be called after linking with #BLO_LIBLINK_DEFER_HIDDEN_OBDATA (done by
+ * #BKE_blendfile_link when a context scene is given), and whenever more of the scene becomes
+ * visible.
+ */
+void BKE_blendfile_link_deferred_visible_load(struct Main *bmain,
+                                              struct Scene *scene,
+                                              struct ReportList *reports);
+
 #ifdef __cplusplus
 }
 #endif
@@ -195,6 +195,16 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                    const struct Mesh *mesh,
                                    BVHCacheType bvh_cache_type,
                                    int tree_type);
+/**
+ * Same as #BKE_bvhtree_from_mesh_get, with \a balance_flag passed to #BLI_bvhtree_balance_ex
+ * when the tree is not cached yet. Use #BVH_BALANCE_MORTON_ORDER for large meshes where the
+ * time to build the tree matters more than the time of the queries.
+ */
+BVHTree *BKE_bvhtree_from_mesh_get_ex(struct BVHTreeFromMesh *data,
+                                      const struct Mesh *mesh,
+                                      BVHCacheType bvh_cache_type,
+                                      int tree_type,
+                                      int balance_flag);
 
 /**
  * Builds or queries a BVH-cache for the cache BVH-tree of the request type.
@@ -254,6 +264,33 @@ struct BVHCache *bvhcache_init(void);
  */
 void bvhcache_free(struct BVHCache *bvh_cache);
 
+/**
+ * BVHTreeStash
+ *
+ * Keeps the vertex, edge and face corner triangle trees of a mesh when its positions change or
+ * when it is freed, so that the trees can be refitted instead of rebuilt when they are requested
+ * for a mesh with the same topology afterwards.
+ */
+
+/**
+ * Free the BVH cache of the mesh, moving its vertex, edge and face corner triangle trees (if any)
+ * to the stash of the mesh. Should be used when only the positions of the mesh change.
+ */
+void BKE_bvhtree_stash_from_mesh_cache(struct Mesh *mesh);
+/**
+ * Take the stash out of the mesh to use it for a different mesh later on, see
+ * #BKE_bvhtree_stash_assign_to_mesh. The trees in the cache of the mesh are stashed first.
+ *
+ * \return Null when there is no tree to stash.
+ */
+struct BVHTreeStash *BKE_bvhtree_stash_take_from_mesh(struct Mesh *mesh);
+/**
+ * Give the stash to a mesh. It is only used if the topology of the mesh is the same as the one of
+ * the mesh the stash was taken from.
+ */
+void BKE_bvhtree_stash_assign_to_mesh(struct BVHTreeStash *stash, struct Mesh *mesh);
+void BKE_bvhtree_stash_free(struct BVHTreeStash *stash);
+
 #ifdef __cplusplus
 }
 #endif
@@ -128,6 +128,18 @@ bool BKE_collection_viewlayer_object_add(struct Main *bmain,
                                          struct Collection *collection,
                                          struct Object *ob);
 
+/**
+ * Add many objects to given collection like #BKE_collection_object_add, but only syncing the
+ * view layers and tagging the collection for update once. Objects that are already in the
+ * collection are skipped.
+ *
+ * \return The number of added objects.
+ */
+int BKE_collection_object_add_multiple(struct Main *bmain,
+                                       struct Collection *collection,
+                                       struct Object **objects,
+                                       int objects_num);
+
 /**
  * Same as #BKE_collection_object_add, but unconditionally adds the object to the given collection.
  *
@@ -31,6 +31,9 @@ bool BKE_curves_attribute_required(const struct Curves *curves, const char *name
 
 struct Curves *BKE_curves_copy_for_eval(struct Curves *curves_src, bool reference);
 
+/** Free the topology cached by `blender::bke::curve_to_mesh_sweep`. */
+void BKE_curves_to_mesh_cache_free(void);
+
 void BKE_curves_data_update(struct Depsgraph *depsgraph,
                             struct Scene *scene,
                             struct Object *object);
@@ -9,8 +9,10 @@
  * \brief Low-level operations for curves.
  */
 
+#include <memory>
 #include <mutex>
 
+#include "BLI_array.hh"
 #include "BLI_float3x3.hh"
 #include "BLI_float4x4.hh"
 #include "BLI_generic_virtual_array.hh"
@@ -74,16 +76,30 @@ class CurvesGeometryRuntime {
    */
   std::array<int, CURVE_TYPES_NUM> type_counts;
 
+  /**
+   * The caches below that only depend on the topology (the offsets and the curve types, cyclic
+   * state, resolution, handle types and NURBS settings) are never modified once they are
+   * computed. They are shared between copies of the geometry, so that they aren't recomputed
+   * when a copy only changes positions or other attributes.
+   */
+  struct EvaluatedOffsets {
+    Vector<int> evaluated_offsets;
+    Vector<int> bezier_evaluated_offsets;
+  };
+
   /**
    * Cache of offsets into the evaluated array for each curve, accounting for all previous
    * evaluated points, Bezier curve vector segments, different resolutions per curve, etc.
+   * The spans reference the shared data, to avoid an indirection when they are accessed.
    */
-  mutable Vector<int> evaluated_offsets_cache;
-  mutable Vector<int> bezier_evaluated_offsets;
+  mutable std::shared_ptr<const EvaluatedOffsets> evaluated_offsets_data;
+  mutable Span<int> evaluated_offsets_cache;
+  mutable Span<int> bezier_evaluated_offsets;
   mutable std::mutex offsets_cache_mutex;
   mutable bool offsets_cache_dirty = true;
 
-  mutable Vector<curves::nurbs::BasisCache> nurbs_basis_cache;
+  mutable std::shared_ptr<const Array<curves::nurbs::BasisCache>> nurbs_basis_data;
+  mutable Span<curves::nurbs::BasisCache> nurbs_basis_cache;
   mutable std::mutex nurbs_basis_cache_mutex;
   mutable bool nurbs_basis_cache_dirty = true;
 
@@ -910,7 +926,7 @@ inline int CurvesGeometry::evaluated_points_num() const
 inline IndexRange CurvesGeometry::evaluated_points_for_curve(int index) const
 {
   BLI_assert(!this->runtime->offsets_cache_dirty);
-  return offsets_to_range(this->runtime->evaluated_offsets_cache.as_span(), index);
+  return offsets_to_range(this->runtime->evaluated_offsets_cache, index);
 }
 
 inline IndexRange CurvesGeometry::evaluated_points_for_curves(const IndexRange curves) const
@@ -925,7 +941,7 @@ inline IndexRange CurvesGeometry::evaluated_points_for_curves(const IndexRange c
 inline Span<int> CurvesGeometry::bezier_evaluated_offsets_for_curve(const int curve_index) const
 {
   const IndexRange points = this->points_for_curve(curve_index);
-  return this->runtime->bezier_evaluated_offsets.as_span().slice(points);
+  return this->runtime->bezier_evaluated_offsets.slice(points);
 }
 
 inline IndexRange CurvesGeometry::lengths_range_for_curve(const int curve_index,
@@ -66,6 +66,12 @@ typedef enum eCDAllocType {
    * if all layer values will be set by the caller after creating the layer.
    */
   CD_CONSTRUCT = 5,
+  /**
+   * Share the data arrays with the source instead of copying them. The new layers add a user to
+   * the shared data, which is freed once its last user is freed. Layers with more than one user
+   * are read-only, the first write access through the `*_for_write` getters makes a private copy.
+   */
+  CD_SHARE = 6,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (eCustomDataMask)((eCustomDataMask)1 << (eCustomDataMask)(_type))
@@ -273,7 +279,8 @@ int CustomData_number_of_layers(const struct CustomData *data, int type);
 int CustomData_number_of_layers_typemask(const struct CustomData *data, eCustomDataMask mask);
 
 /**
- * Duplicate data of a layer with flag NOFREE, and remove that flag.
+ * Duplicate data of a layer with flag NOFREE or with data shared with other layers, and remove
+ * that flag.
  * \return the layer data.
  */
 void *CustomData_duplicate_referenced_layer(struct CustomData *data, int type, int totelem);
@@ -403,8 +410,10 @@ void CustomData_swap(struct CustomData *data, int index_a, int index_b);
  * Gets a pointer to the data element at index from the first layer of type.
  * \return NULL if there is no layer of type.
  */
-void *CustomData_get(const struct CustomData *data, int index, int type);
-void *CustomData_get_n(const struct CustomData *data, int type, int index, int n);
+const void *CustomData_get(const struct CustomData *data, int index, int type);
+void *CustomData_get_for_write(struct CustomData *data, int index, int type, int totelem);
+const void *CustomData_get_n(const struct CustomData *data, int type, int index, int n);
+void *CustomData_get_n_for_write(struct CustomData *data, int type, int index, int n, int totelem);
 
 /* BMesh Custom Data Functions.
  * Should replace edit-mesh ones with these as well, due to more efficient memory alloc. */
@@ -425,9 +434,20 @@ const char *CustomData_get_layer_name(const struct CustomData *data, int type, i
  * Gets a pointer to the active or first layer of type.
  * \return NULL if there is no layer of type.
  */
-void *CustomData_get_layer(const struct CustomData *data, int type);
-void *CustomData_get_layer_n(const struct CustomData *data, int type, int n);
-void *CustomData_get_layer_named(const struct CustomData *data, int type, const char *name);
+const void *CustomData_get_layer(const struct CustomData *data, int type);
+const void *CustomData_get_layer_n(const struct CustomData *data, int type, int n);
+const void *CustomData_get_layer_named(const struct CustomData *data, int type, const char *name);
+
+/**
+ * Same as the getters above, but makes a private copy of referenced or shared layers first
+ * (see #CustomData_duplicate_referenced_layer), so that the returned data can be modified.
+ */
+void *CustomData_get_layer_for_write(struct CustomData *data, int type, int totelem);
+void *CustomData_get_layer_n_for_write(struct CustomData *data, int type, int n, int totelem);
+void *CustomData_get_layer_named_for_write(struct CustomData *data,
+                                           int type,
+                                           const char *name,
+                                           int totelem);
 int CustomData_get_offset(const struct CustomData *data, int type);
 int CustomData_get_offset_named(const CustomData *data, int type, const char *name);
 int CustomData_get_n_offset(const struct CustomData *data, int type, int n);
@@ -489,6 +509,11 @@ void CustomData_set_layer_flag(struct CustomData *data, int type, int flag);
 void CustomData_clear_layer_flag(struct CustomData *data, int type, int flag);
 
 void CustomData_bmesh_set_default(struct CustomData *data, void **block);
+/**
+ * Allocate an uninitialized block from the pool of \a data, freeing the previous one if any.
+ * Allocating the blocks upfront allows to fill them from multiple threads afterwards.
+ */
+void CustomData_bmesh_alloc_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block(struct CustomData *data, void **block);
 /**
  * Same as #CustomData_bmesh_free_block but zero the memory rather than freeing.
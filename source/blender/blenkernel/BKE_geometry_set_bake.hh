@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Store a #GeometrySet in a binary file, e.g. to bake the output of a geometry nodes modifier.
+ *
+ * Meshes, point clouds, curves and instances are stored with all their named attributes whose
+ * type can be copied as raw memory. Anonymous attributes, volumes and edit data are not stored.
+ * References to objects, collections and materials are stored by their name and the name of their
+ * library, and resolved again when reading. Files use the native byte order, they are meant as a local cache.
+ */
+
+#include <optional>
+
+#include "BLI_function_ref.hh"
+#include "BLI_string_ref.hh"
+
+#include "BKE_geometry_set.hh"
+
+struct ID;
+
+namespace blender::bke {
+
+/**
+ * Find the data-block for the name (including the two character ID code prefix) of a
+ * data-block referenced by a baked geometry. The library name is the name of the library
+ * data-block (without the prefix) the data-block is linked from, or empty for local data-blocks.
+ * May return null when it doesn't exist anymore.
+ */
+using BakeIDResolveFn = FunctionRef<ID *(StringRefNull id_name, StringRefNull library_name)>;
+
+/**
+ * Write the geometry to the file, which is replaced if it exists already.
+ * \return False when the file could not be written.
+ */
+bool geometry_set_bake_write(const GeometrySet &geometry_set, const char *filepath);
+
+/**
+ * Read a geometry written by #geometry_set_bake_write. The file is memory mapped while reading.
+ * \return None when the file doesn't exist or is invalid.
+ */
+std::optional<GeometrySet> geometry_set_bake_read(const char *filepath,
+                                                  BakeIDResolveFn resolve_id);
+
+}  // namespace blender::bke
@@ -197,8 +197,11 @@ enum {
   G_DEBUG_XR = (1 << 20),                     /* XR/OpenXR messages */
   G_DEBUG_XR_TIME = (1 << 21),                /* XR/OpenXR timing messages */
 
-  G_DEBUG_GHOST = (1 << 22),  /* Debug GHOST module. */
-  G_DEBUG_WINTAB = (1 << 23), /* Debug Wintab. */
+  G_DEBUG_GHOST = (1 << 22),              /* Debug GHOST module. */
+  G_DEBUG_WINTAB = (1 << 23),             /* Debug Wintab. */
+  G_DEBUG_DEPSGRAPH_PRIORITY = (1 << 24), /* Schedule depsgraph operations by their critical
+                                           * path, measured during previous evaluations. */
+  G_DEBUG_DEPSGRAPH_PROFILE = (1 << 25),  /* Record timing of every depsgraph operation. */
 };
 
 #define G_DEBUG_ALL \
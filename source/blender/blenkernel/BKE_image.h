@@ -139,6 +139,25 @@ struct RenderResult;
  */
 bool BKE_image_has_ibuf(struct Image *ima, struct ImageUser *iuser);
 
+/**
+ * Load the image buffer for given image and user in a background thread, so that drawing does
+ * not have to wait for the image file to be read. Pending loads with a higher \a priority are
+ * done first. Only images read from a single file are loaded in the background.
+ *
+ * \return True when the image buffer is not available yet, false when it can be acquired
+ * without waiting for the file to be read.
+ */
+bool BKE_image_load_async(struct Image *ima, struct ImageUser *iuser, float priority);
+/**
+ * Check whether any background load finished since the last call, in which case everything that
+ * was drawn with a placeholder should be redrawn.
+ */
+bool BKE_image_async_load_finished_pop(void);
+/**
+ * Cancel pending background loads and free the task pool.
+ */
+void BKE_image_async_load_exit(void);
+
 /**
  * Return image buffer for given image and user:
  * - will lock render result if image type is render result and lock is not NULL
@@ -508,6 +527,15 @@ struct GPUTexture *BKE_image_get_gpu_tiles(struct Image *image,
 struct GPUTexture *BKE_image_get_gpu_tilemap(struct Image *image,
                                              struct ImageUser *iuser,
                                              struct ImBuf *ibuf);
+/**
+ * Same as #BKE_image_get_gpu_texture, but instead of reading the image file when it is not
+ * loaded yet, it is loaded in the background with #BKE_image_load_async and NULL is returned.
+ * The caller is expected to draw with a placeholder until then. Because no texture is created in
+ * that case, the next call after the load finished will create it with the loaded image.
+ */
+struct GPUTexture *BKE_image_get_gpu_texture_async(struct Image *image,
+                                                   struct ImageUser *iuser,
+                                                   float priority);
 /**
  * Is the alpha of the `GPUTexture` for a given image/ibuf premultiplied.
  */
@@ -159,6 +159,12 @@ enum {
   /** When copying local sub-data (like constraints or modifiers), do not set their "library
    * override local data" flag. */
   LIB_ID_COPY_NO_LIB_OVERRIDE_LOCAL_DATA_FLAG = 1 << 22,
+  /**
+   * Mesh, point cloud and curves: Share CD data layers with the source (see #CD_SHARE), they are
+   * only copied once either of the data-blocks writes to them. Data must be written through the
+   * functions requesting write access to the layers.
+   */
+  LIB_ID_COPY_CD_SHARE = 1 << 23,
 
   /* *** XXX Hackish/not-so-nice specific behaviors needed for some corner cases. *** */
   /* *** Ideally we should not have those, but we need them for now... *** */
@@ -324,6 +330,11 @@ size_t BKE_id_multi_tagged_delete(struct Main *bmain) ATTR_NONNULL();
  * Add a 'NO_MAIN' data-block to given main (also sets user-counts of its IDs if needed).
  */
 void BKE_libblock_management_main_add(struct Main *bmain, void *idv);
+/**
+ * Same as #BKE_libblock_management_main_add for many data-blocks of the same type, giving them
+ * unique names and sorting them into the list in a single pass instead of one lookup per ID.
+ */
+void BKE_libblock_management_main_add_multiple(struct Main *bmain, struct ID **ids, int ids_num);
 /** Remove a data-block from given main (set it to 'NO_MAIN' status). */
 void BKE_libblock_management_main_remove(struct Main *bmain, void *idv);
 
@@ -486,6 +497,14 @@ void BKE_lib_id_swap_full(struct Main *bmain, struct ID *id_a, struct ID *id_b);
  * immediately before or after that pointer. It must always be into given \a lb list.
  */
 void id_sort_by_name(struct ListBase *lb, struct ID *id, struct ID *id_sorting_hint);
+/**
+ * Same as #id_sort_by_name for many IDs at once. All the given IDs have to be in the list
+ * already, all other IDs are assumed to be properly sorted.
+ *
+ * The IDs are sorted and then merged into the list in a single pass for every library, instead
+ * of searching the insertion position for every ID separately.
+ */
+void id_sort_by_name_multiple(struct ListBase *lb, struct ID **ids, int ids_num);
 /**
  * Expand ID usages of given id as 'extern' (and no more indirect) linked data.
  * Used by ID copy/make_local functions.
@@ -507,6 +526,17 @@ bool BKE_id_new_name_validate(struct Main *bmain,
                               struct ID *id,
                               const char *name,
                               bool do_linked_data) ATTR_NONNULL(1, 2, 3);
+/**
+ * Same as #BKE_id_new_name_validate for many IDs of the same list at once, keeping their current
+ * names as base. The names of the IDs must not be registered in the name maps yet.
+ *
+ * \return true if any new name had to be created.
+ */
+bool BKE_id_new_name_validate_multiple(struct Main *bmain,
+                                       struct ListBase *lb,
+                                       struct ID **ids,
+                                       int ids_num,
+                                       bool do_linked_data) ATTR_NONNULL(1, 2);
 
 /**
  * Pull an ID out of a library (make it local). Only call this for IDs that
@@ -38,6 +38,19 @@ void BKE_main_namemap_destroy(struct UniqueName_Map **r_name_map) ATTR_NONNULL()
  */
 bool BKE_main_namemap_get_name(struct Main *bmain, struct ID *id, char *name) ATTR_NONNULL();
 
+/**
+ * Same as #BKE_main_namemap_get_name for many new IDs at once, using their current names. The
+ * unique names are written back to the IDs.
+ *
+ * This is much faster than calling #BKE_main_namemap_get_name for every ID when the name maps do
+ * not exist yet, since they are only populated once. The names of the given IDs must not be
+ * registered in the name maps yet.
+ *
+ * \return true if any of the names had to be adjusted for uniqueness.
+ */
+bool BKE_main_namemap_reserve_names(struct Main *bmain, struct ID **ids, int ids_num)
+    ATTR_NONNULL(1);
+
 /**
  * Remove a given name from usage.
  *
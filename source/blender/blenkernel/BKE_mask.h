@@ -401,6 +401,16 @@ void BKE_maskrasterize_handle_init(MaskRasterHandle *mr_handle,
                                    bool do_mask_aa,
                                    bool do_feather);
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2]);
+/**
+ * Sample \a len points of a row, starting at \a xy_start and advancing by \a x_step.
+ * Gives the same values as #BKE_maskrasterize_handle_sample, but is faster than sampling the
+ * points one by one.
+ */
+void BKE_maskrasterize_handle_sample_row(MaskRasterHandle *mr_handle,
+                                         const float xy_start[2],
+                                         float x_step,
+                                         unsigned int len,
+                                         float *r_values);
 
 /**
  * \brief Rasterize a buffer from a single mask (threaded execution).
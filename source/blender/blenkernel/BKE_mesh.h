@@ -426,6 +426,20 @@ float (*BKE_mesh_poly_normals_for_write(struct Mesh *mesh))[3];
  */
 void BKE_mesh_clear_derived_normals(struct Mesh *mesh);
 
+/**
+ * Share the cached vertex to corner map used for vertex normal calculation with a copy of the
+ * mesh. This should only be done when the copy references or shares the same topology arrays,
+ * because the cache is only used when they match. A cache is created on the source mesh if
+ * necessary, so that it is built at most once for all copies.
+ */
+void BKE_mesh_vert_to_loop_cache_share(const struct Mesh *mesh_src, struct Mesh *mesh_dst);
+/**
+ * Drop the reference to the cached vertex to corner map and increment the topology update count,
+ * for when the topology changes. This is done automatically when the edges, faces or corners are
+ * accessed for writing and when the runtime geometry data is cleared.
+ */
+void BKE_mesh_vert_to_loop_cache_release(struct Mesh *mesh);
+
 /**
  * Mark the mesh's vertex normals non-dirty, for when they are calculated or assigned manually.
  */
@@ -793,7 +807,7 @@ void BKE_mesh_mdisp_flip(struct MDisps *md, bool use_loop_mdisp_flip);
  *
  * \param mpoly: the polygon to flip.
  * \param mloop: the full loops array.
- * \param ldata: the loops custom data.
+ * \param ldata: the loops custom data, its layers must not be shared with other meshes.
  */
 void BKE_mesh_polygon_flip_ex(const struct MPoly *mpoly,
                               struct MLoop *mloop,
@@ -803,7 +817,8 @@ void BKE_mesh_polygon_flip_ex(const struct MPoly *mpoly,
                               bool use_loop_mdisp_flip);
 void BKE_mesh_polygon_flip(const struct MPoly *mpoly,
                            struct MLoop *mloop,
-                           struct CustomData *ldata);
+                           struct CustomData *ldata,
+                           int totloop);
 /**
  * Flip (invert winding of) all polygons (used to inverse their normals).
  *
@@ -812,6 +827,7 @@ void BKE_mesh_polygon_flip(const struct MPoly *mpoly,
 void BKE_mesh_polys_flip(const struct MPoly *mpoly,
                          struct MLoop *mloop,
                          struct CustomData *ldata,
+                         int totloop,
                          int totpoly);
 
 /* Merge verts. */
@@ -1003,8 +1019,25 @@ void BKE_mesh_eval_geometry(struct Depsgraph *depsgraph, struct Mesh *mesh);
 void BKE_mesh_batch_cache_dirty_tag(struct Mesh *me, eMeshBatchDirtyMode mode);
 void BKE_mesh_batch_cache_free(struct Mesh *me);
 
+/**
+ * Take the batch cache out of an evaluated mesh that is about to be freed, so that it can be
+ * passed on to the next evaluated mesh of the same object with #BKE_mesh_batch_cache_stash_assign.
+ * Only meshes that are deformed from their input are supported, otherwise null is returned.
+ */
+struct MeshBatchCacheStash *BKE_mesh_batch_cache_stash_take(struct Mesh *mesh);
+/**
+ * Give the stashed batch cache to \a mesh if it only differs in the vertex positions, in which
+ * case only the buffers depending on positions are extracted again. The stash is freed otherwise.
+ * \param mesh_input: The input of the modifier stack that created \a mesh.
+ */
+void BKE_mesh_batch_cache_stash_assign(struct MeshBatchCacheStash *stash,
+                                       struct Mesh *mesh,
+                                       const struct Mesh *mesh_input);
+void BKE_mesh_batch_cache_stash_free(struct MeshBatchCacheStash *stash);
+
 extern void (*BKE_mesh_batch_cache_dirty_tag_cb)(struct Mesh *me, eMeshBatchDirtyMode mode);
 extern void (*BKE_mesh_batch_cache_free_cb)(struct Mesh *me);
+extern void (*BKE_mesh_batch_cache_free_data_cb)(void *batch_cache);
 
 /* mesh_debug.c */
 
@@ -1057,6 +1090,7 @@ BLI_INLINE const MEdge *BKE_mesh_edges(const Mesh *mesh)
 }
 BLI_INLINE MEdge *BKE_mesh_edges_for_write(Mesh *mesh)
 {
+  BKE_mesh_vert_to_loop_cache_release(mesh);
   return (MEdge *)CustomData_duplicate_referenced_layer(&mesh->edata, CD_MEDGE, mesh->totedge);
 }
 
@@ -1066,6 +1100,7 @@ BLI_INLINE const MPoly *BKE_mesh_polys(const Mesh *mesh)
 }
 BLI_INLINE MPoly *BKE_mesh_polys_for_write(Mesh *mesh)
 {
+  BKE_mesh_vert_to_loop_cache_release(mesh);
   return (MPoly *)CustomData_duplicate_referenced_layer(&mesh->pdata, CD_MPOLY, mesh->totpoly);
 }
 
@@ -1075,6 +1110,7 @@ BLI_INLINE const MLoop *BKE_mesh_loops(const Mesh *mesh)
 }
 BLI_INLINE MLoop *BKE_mesh_loops_for_write(Mesh *mesh)
 {
+  BKE_mesh_vert_to_loop_cache_release(mesh);
   return (MLoop *)CustomData_duplicate_referenced_layer(&mesh->ldata, CD_MLOOP, mesh->totloop);
 }
 
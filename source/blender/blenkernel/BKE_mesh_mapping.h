@@ -7,6 +7,8 @@
  */
 
 #ifdef __cplusplus
+#  include <optional>
+
 #  include "BLI_array.hh"
 #endif
 
@@ -17,6 +19,7 @@ extern "C" {
 struct MEdge;
 struct MLoop;
 struct MLoopTri;
+struct Mesh;
 struct MLoopUV;
 struct MPoly;
 struct MVert;
@@ -348,5 +351,37 @@ inline int previous_poly_loop(const MPoly &poly, int loop_i)
   return loop_i - 1 + (loop_i == poly.loopstart) * poly.totloop;
 }
 
+inline int next_poly_loop(const MPoly &poly, int loop_i)
+{
+  return loop_i + 1 - (loop_i == poly.loopstart + poly.totloop - 1) * poly.totloop;
+}
+
+/**
+ * The face corners of every vertex or edge of a mesh, in increasing order, and the face of every
+ * corner. The spans reference a cache on the mesh, see #cached_vert_to_loop_map.
+ */
+struct CachedLoopMap {
+  Span<int> offsets;
+  Span<int> loops;
+  Span<int> loop_to_poly;
+
+  Span<int> element_loops(const int index) const
+  {
+    return loops.slice(offsets[index], offsets[index + 1] - offsets[index]);
+  }
+};
+
+/**
+ * Access the vertex to corner map cached on the mesh, building it if necessary. The cache is
+ * released when the topology is accessed for writing, and shared with copies that reference or
+ * share the same topology arrays (see #BKE_mesh_vert_to_loop_cache_share).
+ *
+ * \return None when the topology of the mesh changed since the cache was built without the cache
+ * being released, the caller has to compute the topology it needs itself.
+ */
+std::optional<CachedLoopMap> cached_vert_to_loop_map(const Mesh &mesh);
+/** Like #cached_vert_to_loop_map, for the corners that start at every edge (#MLoop.e). */
+std::optional<CachedLoopMap> cached_edge_to_loop_map(const Mesh &mesh);
+
 }  // namespace blender::mesh_topology
 #endif
@@ -8,6 +8,8 @@
  * This file contains access functions for the Mesh.runtime struct.
  */
 
+#include "BLI_sys_types.h"
+
 //#include "BKE_customdata.h"  /* for eCustomDataMask */
 
 #ifdef __cplusplus
@@ -42,6 +44,13 @@ void BKE_mesh_runtime_free_data(struct Mesh *mesh);
  */
 void BKE_mesh_runtime_reset_on_copy(struct Mesh *mesh, int flag);
 int BKE_mesh_runtime_looptri_len(const struct Mesh *mesh);
+
+/**
+ * A hash of the vertex, edge, face and face corner connectivity of the mesh. Attributes and flags
+ * are not taken into account. Meshes with equal hashes (and element counts) are expected to have
+ * the same topology, allowing caches derived from the topology to be reused.
+ */
+uint32_t BKE_mesh_topology_hash(const struct Mesh *mesh);
 void BKE_mesh_runtime_looptri_recalc(struct Mesh *mesh);
 /**
  * \note This function only fills a cache, and therefore the mesh argument can
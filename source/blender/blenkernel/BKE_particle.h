@@ -321,6 +321,10 @@ void BKE_particlesettings_fluid_default_settings(struct ParticleSettings *part);
  * Free cache path.
  */
 void psys_free_path_cache(struct ParticleSystem *psys, struct PTCacheEdit *edit);
+/**
+ * Free the child path cache only, the parent paths are kept.
+ */
+void psys_free_child_path_cache(struct ParticleSystem *psys);
 /**
  * Free everything.
  */
@@ -379,6 +383,8 @@ void psys_unique_name(struct Object *object, struct ParticleSystem *psys, const
  * - Useful for making use of opengl vertex arrays for super fast strand drawing.
  * - Makes child strands possible and creates them too into the cache.
  * - Cached path data is also used to determine cut position for the edit-mode tool.
+ * - The child path cache is kept, #psys_cache_child_paths reuses it when the parents and emitter
+ *   did not change.
  */
 void psys_cache_paths(struct ParticleSimulationData *sim, float cfra, bool use_render_params);
 void psys_cache_edit_paths(struct Depsgraph *depsgraph,
@@ -581,8 +587,8 @@ void psys_get_texture(struct ParticleSimulationData *sim,
 void psys_interpolate_face(struct Mesh *mesh,
                            const struct MVert *mvert,
                            const float (*vert_normals)[3],
-                           struct MFace *mface,
-                           struct MTFace *tface,
+                           const struct MFace *mface,
+                           const struct MTFace *tface,
                            const float (*orcodata)[3],
                            float w[4],
                            float vec[3],
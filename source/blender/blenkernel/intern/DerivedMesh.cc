@@ -91,57 +91,61 @@ static void editbmesh_calc_modifier_final_normals_or_defer(
 
 /* -------------------------------------------------------------------- */
 
-static MVert *dm_getVertArray(DerivedMesh *dm)
+static const MVert *dm_getVertArray(DerivedMesh *dm)
 {
-  MVert *mvert = (MVert *)CustomData_get_layer(&dm->vertData, CD_MVERT);
+  const MVert *mvert = (const MVert *)CustomData_get_layer(&dm->vertData, CD_MVERT);
 
   if (!mvert) {
-    mvert = (MVert *)CustomData_add_layer(
+    MVert *mvert_new = (MVert *)CustomData_add_layer(
         &dm->vertData, CD_MVERT, CD_SET_DEFAULT, nullptr, dm->getNumVerts(dm));
     CustomData_set_layer_flag(&dm->vertData, CD_MVERT, CD_FLAG_TEMPORARY);
-    dm->copyVertArray(dm, mvert);
+    dm->copyVertArray(dm, mvert_new);
+    mvert = mvert_new;
   }
 
   return mvert;
 }
 
-static MEdge *dm_getEdgeArray(DerivedMesh *dm)
+static const MEdge *dm_getEdgeArray(DerivedMesh *dm)
 {
-  MEdge *medge = (MEdge *)CustomData_get_layer(&dm->edgeData, CD_MEDGE);
+  const MEdge *medge = (const MEdge *)CustomData_get_layer(&dm->edgeData, CD_MEDGE);
 
   if (!medge) {
-    medge = (MEdge *)CustomData_add_layer(
+    MEdge *medge_new = (MEdge *)CustomData_add_layer(
         &dm->edgeData, CD_MEDGE, CD_SET_DEFAULT, nullptr, dm->getNumEdges(dm));
     CustomData_set_layer_flag(&dm->edgeData, CD_MEDGE, CD_FLAG_TEMPORARY);
-    dm->copyEdgeArray(dm, medge);
+    dm->copyEdgeArray(dm, medge_new);
+    medge = medge_new;
   }
 
   return medge;
 }
 
-static MLoop *dm_getLoopArray(DerivedMesh *dm)
+static const MLoop *dm_getLoopArray(DerivedMesh *dm)
 {
-  MLoop *mloop = (MLoop *)CustomData_get_layer(&dm->loopData, CD_MLOOP);
+  const MLoop *mloop = (const MLoop *)CustomData_get_layer(&dm->loopData, CD_MLOOP);
 
   if (!mloop) {
-    mloop = (MLoop *)CustomData_add_layer(
+    MLoop *mloop_new = (MLoop *)CustomData_add_layer(
         &dm->loopData, CD_MLOOP, CD_SET_DEFAULT, nullptr, dm->getNumLoops(dm));
     CustomData_set_layer_flag(&dm->loopData, CD_MLOOP, CD_FLAG_TEMPORARY);
-    dm->copyLoopArray(dm, mloop);
+    dm->copyLoopArray(dm, mloop_new);
+    mloop = mloop_new;
   }
 
   return mloop;
 }
 
-static MPoly *dm_getPolyArray(DerivedMesh *dm)
+static const MPoly *dm_getPolyArray(DerivedMesh *dm)
 {
-  MPoly *mpoly = (MPoly *)CustomData_get_layer(&dm->polyData, CD_MPOLY);
+  const MPoly *mpoly = (const MPoly *)CustomData_get_layer(&dm->polyData, CD_MPOLY);
 
   if (!mpoly) {
-    mpoly = (MPoly *)CustomData_add_layer(
+    MPoly *mpoly_new = (MPoly *)CustomData_add_layer(
         &dm->polyData, CD_MPOLY, CD_SET_DEFAULT, nullptr, dm->getNumPolys(dm));
     CustomData_set_layer_flag(&dm->polyData, CD_MPOLY, CD_FLAG_TEMPORARY);
-    dm->copyPolyArray(dm, mpoly);
+    dm->copyPolyArray(dm, mpoly_new);
+    mpoly = mpoly_new;
   }
 
   return mpoly;
@@ -347,7 +351,7 @@ static void mesh_set_only_copy(Mesh *mesh, const CustomData_MeshMasks *mask)
 #endif
 }
 
-void *DM_get_vert_data_layer(DerivedMesh *dm, int type)
+const void *DM_get_vert_data_layer(DerivedMesh *dm, int type)
 {
   if (type == CD_MVERT) {
     return dm->getVertArray(dm);
@@ -356,7 +360,7 @@ void *DM_get_vert_data_layer(DerivedMesh *dm, int type)
   return CustomData_get_layer(&dm->vertData, type);
 }
 
-void *DM_get_edge_data_layer(DerivedMesh *dm, int type)
+const void *DM_get_edge_data_layer(DerivedMesh *dm, int type)
 {
   if (type == CD_MEDGE) {
     return dm->getEdgeArray(dm);
@@ -365,12 +369,12 @@ void *DM_get_edge_data_layer(DerivedMesh *dm, int type)
   return CustomData_get_layer(&dm->edgeData, type);
 }
 
-void *DM_get_poly_data_layer(DerivedMesh *dm, int type)
+const void *DM_get_poly_data_layer(DerivedMesh *dm, int type)
 {
   return CustomData_get_layer(&dm->polyData, type);
 }
 
-void *DM_get_loop_data_layer(DerivedMesh *dm, int type)
+const void *DM_get_loop_data_layer(DerivedMesh *dm, int type)
 {
   return CustomData_get_layer(&dm->loopData, type);
 }
@@ -501,10 +505,10 @@ static void add_orco_mesh(Object *ob, BMEditMesh *em, Mesh *mesh, Mesh *mesh_orc
       BKE_mesh_orco_verts_transform((Mesh *)ob->data, orco, totvert, 0);
     }
 
-    if (!(layerorco = (float(*)[3])CustomData_get_layer(&mesh->vdata, layer))) {
-      CustomData_add_layer(&mesh->vdata, layer, CD_SET_DEFAULT, nullptr, mesh->totvert);
-
-      layerorco = (float(*)[3])CustomData_get_layer(&mesh->vdata, layer);
+    if (!(layerorco = (float(*)[3])CustomData_get_layer_for_write(
+              &mesh->vdata, layer, mesh->totvert))) {
+      layerorco = (float(*)[3])CustomData_add_layer(
+          &mesh->vdata, layer, CD_SET_DEFAULT, nullptr, mesh->totvert);
     }
 
     memcpy(layerorco, orco, sizeof(float[3]) * totvert);
@@ -928,13 +932,16 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
 
           /* Not worth parallelizing this,
            * gives less than 0.1% overall speedup in best of best cases... */
-          range_vn_i((int *)CustomData_get_layer(&mesh_final->vdata, CD_ORIGINDEX),
+          range_vn_i((int *)CustomData_get_layer_for_write(
+                         &mesh_final->vdata, CD_ORIGINDEX, mesh_final->totvert),
                      mesh_final->totvert,
                      0);
-          range_vn_i((int *)CustomData_get_layer(&mesh_final->edata, CD_ORIGINDEX),
+          range_vn_i((int *)CustomData_get_layer_for_write(
+                         &mesh_final->edata, CD_ORIGINDEX, mesh_final->totedge),
                      mesh_final->totedge,
                      0);
-          range_vn_i((int *)CustomData_get_layer(&mesh_final->pdata, CD_ORIGINDEX),
+          range_vn_i((int *)CustomData_get_layer_for_write(
+                         &mesh_final->pdata, CD_ORIGINDEX, mesh_final->totpoly),
                      mesh_final->totpoly,
                      0);
         }
@@ -1934,8 +1941,8 @@ static void mesh_init_origspace(Mesh *mesh)
 {
   const float default_osf[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
 
-  OrigSpaceLoop *lof_array = (OrigSpaceLoop *)CustomData_get_layer(&mesh->ldata,
-                                                                   CD_ORIGSPACE_MLOOP);
+  OrigSpaceLoop *lof_array = (OrigSpaceLoop *)CustomData_get_layer_for_write(
+      &mesh->ldata, CD_ORIGSPACE_MLOOP, mesh->totloop);
   const int numpoly = mesh->totpoly;
   // const int numloop = mesh->totloop;
   const Span<MVert> verts = mesh->verts();
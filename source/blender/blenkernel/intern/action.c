@@ -1119,6 +1119,8 @@ void BKE_pose_free_data_ex(bPose *pose, bool do_id_user)
   if (pose->ikparam) {
     MEM_freeN(pose->ikparam);
   }
+
+  BKE_pose_cache_free(pose);
 }
 
 void BKE_pose_free_data(bPose *pose)
@@ -1924,6 +1926,7 @@ void BKE_pose_blend_read_data(BlendDataReader *reader, bPose *pose)
     pchan->draw_data = NULL;
   }
   pose->ikdata = NULL;
+  pose->cache = NULL;
   if (pose->ikparam != NULL) {
     BLO_read_data_address(reader, &pose->ikparam);
   }
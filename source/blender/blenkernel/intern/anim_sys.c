@@ -364,18 +364,19 @@ static bool is_fcurve_evaluatable(FCurve *fcu)
   return true;
 }
 
-bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
-                                  /* typically 'fcu->rna_path', 'fcu->array_index' */
-                                  const char *rna_path,
-                                  const int array_index,
-                                  PathResolvedRNA *r_result)
+/* Resolve the property of the path, the array index is checked separately. */
+static bool animsys_rna_path_resolve_property(PointerRNA *ptr,
+                                              const char *rna_path,
+                                              const int array_index,
+                                              PointerRNA *r_ptr,
+                                              PropertyRNA **r_prop)
 {
   if (rna_path == NULL) {
     return false;
   }
 
   const char *path = rna_path;
-  if (!RNA_path_resolve_property(ptr, path, &r_result->ptr, &r_result->prop)) {
+  if (!RNA_path_resolve_property(ptr, path, r_ptr, r_prop)) {
     /* failed to get path */
     /* XXX don't tag as failed yet though, as there are some legit situations (Action Constraint)
      * where some channels will not exist, but shouldn't lock up Action */
@@ -389,17 +390,24 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
     return false;
   }
 
-  if (ptr->owner_id != NULL && !RNA_property_animateable(&r_result->ptr, r_result->prop)) {
+  if (ptr->owner_id != NULL && !RNA_property_animateable(r_ptr, *r_prop)) {
     return false;
   }
+  return true;
+}
 
-  int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+static bool animsys_rna_path_resolve_index(const PointerRNA *ptr,
+                                           const char *rna_path,
+                                           const int array_index,
+                                           const int array_len,
+                                           PathResolvedRNA *r_result)
+{
   if (array_len && array_index >= array_len) {
     if (G.debug & G_DEBUG) {
       CLOG_WARN(&LOG,
                 "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
                 (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                path,
+                rna_path,
                 array_index,
                 array_len - 1);
     }
@@ -410,6 +418,61 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
   return true;
 }
 
+bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
+                                  /* typically 'fcu->rna_path', 'fcu->array_index' */
+                                  const char *rna_path,
+                                  const int array_index,
+                                  PathResolvedRNA *r_result)
+{
+  if (!animsys_rna_path_resolve_property(
+          ptr, rna_path, array_index, &r_result->ptr, &r_result->prop)) {
+    return false;
+  }
+  const int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+  return animsys_rna_path_resolve_index(ptr, rna_path, array_index, array_len, r_result);
+}
+
+/**
+ * The last resolved property path, to resolve consecutive F-Curves with the same path only once.
+ * Actions store the F-Curves of the items of array properties next to each other, so this avoids
+ * most path lookups for vector, color and rotation properties, which are the majority of the
+ * animated properties of rigs.
+ */
+typedef struct AnimsysPathCache {
+  /** Path of the last resolved F-Curve, NULL when nothing was resolved yet. */
+  const char *rna_path;
+  bool is_valid;
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  int array_len;
+} AnimsysPathCache;
+
+/* Same as #BKE_animsys_rna_path_resolve, reusing the cached result when the path is the same. */
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            AnimsysPathCache *cache,
+                                            const char *rna_path,
+                                            const int array_index,
+                                            PathResolvedRNA *r_result)
+{
+  if (rna_path == NULL) {
+    return false;
+  }
+  if (cache->rna_path == NULL || !STREQ(cache->rna_path, rna_path)) {
+    cache->rna_path = rna_path;
+    cache->is_valid = animsys_rna_path_resolve_property(
+        ptr, rna_path, array_index, &cache->ptr, &cache->prop);
+    if (cache->is_valid) {
+      cache->array_len = RNA_property_array_length(&cache->ptr, cache->prop);
+    }
+  }
+  if (!cache->is_valid) {
+    return false;
+  }
+  r_result->ptr = cache->ptr;
+  r_result->prop = cache->prop;
+  return animsys_rna_path_resolve_index(ptr, rna_path, array_index, cache->array_len, r_result);
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -564,7 +627,12 @@ static bool animsys_construct_orig_pointer_rna(const PointerRNA *ptr, PointerRNA
   return true;
 }
 
+/**
+ * \param orig_cache: Optional cache of the last path resolved for the original data, see
+ * #AnimsysPathCache.
+ */
 static void animsys_write_orig_anim_rna(PointerRNA *ptr,
+                                        AnimsysPathCache *orig_cache,
                                         const char *rna_path,
                                         int array_index,
                                         float value)
@@ -575,7 +643,15 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
   PathResolvedRNA orig_anim_rna;
   /* TODO(sergey): Should be possible to cache resolved path in dependency graph somehow. */
-  if (BKE_animsys_rna_path_resolve(&ptr_orig, rna_path, array_index, &orig_anim_rna)) {
+  bool resolved;
+  if (orig_cache) {
+    resolved = animsys_rna_path_resolve_cached(
+        &ptr_orig, orig_cache, rna_path, array_index, &orig_anim_rna);
+  }
+  else {
+    resolved = BKE_animsys_rna_path_resolve(&ptr_orig, rna_path, array_index, &orig_anim_rna);
+  }
+  if (resolved) {
     BKE_animsys_write_to_rna_path(&orig_anim_rna, value);
   }
 }
@@ -590,6 +666,9 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  AnimsysPathCache path_cache = {NULL};
+  AnimsysPathCache orig_path_cache = {NULL};
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -598,11 +677,13 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(
+            ptr, &path_cache, fcu->rna_path, fcu->array_index, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        animsys_write_orig_anim_rna(
+            ptr, &orig_path_cache, fcu->rna_path, fcu->array_index, curval);
       }
     }
   }
@@ -834,12 +915,15 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     return;
   }
 
+  AnimsysPathCache path_cache = {NULL};
+
   /* calculate then execute each curve */
   for (fcu = agrp->channels.first; (fcu) && (fcu->grp == agrp); fcu = fcu->next) {
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_rna_path_resolve_cached(
+              ptr, &path_cache, fcu->rna_path, fcu->array_index, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_to_rna_path(&anim_rna, curval);
       }
@@ -3037,7 +3121,7 @@ void nladata_flush_channels(PointerRNA *ptr,
         }
         BKE_animsys_write_to_rna_path(&rna, value);
         if (flush_to_original) {
-          animsys_write_orig_anim_rna(ptr, nec->rna_path, rna.prop_index, value);
+          animsys_write_orig_anim_rna(ptr, NULL, nec->rna_path, rna.prop_index, value);
         }
       }
     }
@@ -4165,7 +4249,7 @@ void BKE_animsys_eval_driver(Depsgraph *depsgraph, ID *id, int driver_index, FCu
 
         /* Flush results & status codes to original data for UI (T59984) */
         if (ok && DEG_is_active(depsgraph)) {
-          animsys_write_orig_anim_rna(&id_ptr, fcu->rna_path, fcu->array_index, curval);
+          animsys_write_orig_anim_rna(&id_ptr, NULL, fcu->rna_path, fcu->array_index, curval);
 
           /* curval is displayed in the UI, and flag contains error-status codes */
           fcu_orig->curval = fcu->curval;
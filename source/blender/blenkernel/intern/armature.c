@@ -2409,6 +2409,9 @@ void BKE_pose_rebuild(Main *bmain, Object *ob, bArmature *arm, const bool do_id_
   pose->flag &= ~POSE_RECALC;
   pose->flag |= POSE_WAS_REBUILT;
 
+  /* Stored poses refer to channels by index. */
+  BKE_pose_cache_free(pose);
+
   /* Rebuilding poses forces us to also rebuild the dependency graph,
    * since there is one node per pose/bone. */
   if (bmain != NULL) {
@@ -242,6 +242,12 @@ typedef struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /**
+   * Deform matrices of the bones in #pchan_from_defbase, combined with #premat and #postmat.
+   * Only used by the linear blend skinning fast path, NULL otherwise.
+   */
+  float (*deform_mats_from_defbase)[4][4];
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -438,6 +444,79 @@ static void armature_vert_task(void *__restrict userdata,
   armature_vert_task_with_dvert(data, i, dvert);
 }
 
+/**
+ * Linear blend skinning of vertices that are only deformed through vertex groups, by bones
+ * without B-Bone segments. The bone matrices are already in the space of the target object,
+ * so every influence is a single matrix multiplication without further branching.
+ */
+static void armature_vert_task_linear_blend(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ArmatureUserdata *data = userdata;
+  if (i >= data->dverts_len) {
+    return;
+  }
+  const MDeformVert *dvert = &data->dverts[i];
+  if (dvert->totweight == 0) {
+    return;
+  }
+
+  float armature_weight = 1.0f;
+  if (data->armature_def_nr != -1) {
+    armature_weight = BKE_defvert_find_weight(dvert, data->armature_def_nr);
+    if (data->invert_vgroup) {
+      armature_weight = 1.0f - armature_weight;
+    }
+    if (armature_weight == 0.0f) {
+      return;
+    }
+  }
+
+  float *co = data->vert_coords[i];
+  float sumvec[3] = {0.0f, 0.0f, 0.0f};
+  float contrib = 0.0f;
+  const MDeformWeight *dw = dvert->dw;
+  for (uint j = dvert->totweight; j != 0; j--, dw++) {
+    const uint index = dw->def_nr;
+    if (index < data->defbase_len && data->pchan_from_defbase[index] && dw->weight != 0.0f) {
+      float tmp[3];
+      mul_v3_m4v3(tmp, data->deform_mats_from_defbase[index], co);
+      sub_v3_v3(tmp, co);
+      madd_v3_v3fl(sumvec, tmp, dw->weight);
+      contrib += dw->weight;
+    }
+  }
+
+  /* Same threshold as #armature_vert_task_with_dvert. */
+  if (contrib > 0.0001f) {
+    madd_v3_v3fl(co, sumvec, armature_weight / contrib);
+  }
+}
+
+/**
+ * The linear blend fast path supports deforming bones without B-Bone segments, which don't
+ * need the vertex position in armature space to compute their influence.
+ */
+static bool armature_deform_bones_are_linear(bPoseChannel **pchan_from_defbase,
+                                             const int defbase_len)
+{
+  for (int i = 0; i < defbase_len; i++) {
+    const bPoseChannel *pchan = pchan_from_defbase[i];
+    if (pchan == NULL) {
+      continue;
+    }
+    const Bone *bone = pchan->bone;
+    if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+      return false;
+    }
+    if (bone->flag & BONE_MULT_VG_ENV) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static void armature_vert_task_editmesh(void *__restrict userdata,
                                         MempoolIterData *iter,
                                         const TaskParallelTLS *__restrict UNUSED(tls))
@@ -604,6 +683,29 @@ static void armature_deform_coords_impl(const Object *ob_arm,
           em_target->bm->vpool, &data, armature_vert_task_editmesh_no_dvert, &settings);
     }
   }
+  else if (use_dverts && !use_envelope && !use_quaternion && vert_coords_prev == NULL &&
+           vert_deform_mats == NULL &&
+           armature_deform_bones_are_linear(pchan_from_defbase, defbase_len)) {
+    /* Combine the bone matrices with the transforms between the object spaces once, instead of
+     * transforming every vertex into armature space and back. */
+    data.deform_mats_from_defbase = MEM_mallocN(
+        sizeof(*data.deform_mats_from_defbase) * defbase_len, __func__);
+    for (int i = 0; i < defbase_len; i++) {
+      if (pchan_from_defbase[i]) {
+        mul_m4_series(data.deform_mats_from_defbase[i],
+                      data.postmat,
+                      pchan_from_defbase[i]->chan_mat,
+                      data.premat);
+      }
+    }
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task_linear_blend, &settings);
+
+    MEM_freeN(data.deform_mats_from_defbase);
+  }
   else {
     TaskParallelSettings settings;
     BLI_parallel_range_settings_defaults(&settings);
@@ -7,6 +7,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
@@ -28,6 +29,7 @@
 #include "BIK_api.h"
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
 
 /* ********************** SPLINE IK SOLVER ******************* */
 
@@ -782,6 +784,124 @@ void BKE_splineik_execute_tree(
   splineik_execute_tree(depsgraph, scene, ob, pchan_root, ctime);
 }
 
+/* ********************** POSE CACHE ******************* */
+
+/* Final matrices of a pose channel, enough to skip its evaluation. */
+typedef struct PoseCacheChannel {
+  float pose_mat[4][4];
+  float pose_tail[3];
+} PoseCacheChannel;
+
+/* Evaluated poses stored per frame while #POSE_USE_CACHE is enabled. Lives on the original pose
+ * and is only accessed from the active depsgraph. */
+typedef struct PoseCache {
+  /* Frame number -> array of #PoseCacheChannel, in the order of #bPose.chan_array. */
+  GHash *frames;
+  int channels_num;
+} PoseCache;
+
+void BKE_pose_cache_free(bPose *pose)
+{
+  if (pose->cache == NULL) {
+    return;
+  }
+  BLI_ghash_free(pose->cache->frames, NULL, MEM_freeN);
+  MEM_freeN(pose->cache);
+  pose->cache = NULL;
+}
+
+/**
+ * Get the original pose which caches the evaluation of the given object at the current frame,
+ * or NULL when the cache can not be used. Only whole frames are cached.
+ */
+static bPose *pose_cache_pose_get(struct Depsgraph *depsgraph,
+                                  Scene *scene,
+                                  Object *object,
+                                  int *r_frame)
+{
+  if (!DEG_is_active(depsgraph)) {
+    return NULL;
+  }
+  const bArmature *armature = (bArmature *)object->data;
+  if (armature->edbo != NULL || (armature->flag & ARM_RESTPOS)) {
+    return NULL;
+  }
+  bPose *pose_orig = DEG_get_original_object(object)->pose;
+  if (pose_orig == NULL || (pose_orig->flag & POSE_USE_CACHE) == 0) {
+    return NULL;
+  }
+  const float ctime = BKE_scene_ctime_get(scene);
+  if (ctime != (float)(int)ctime) {
+    return NULL;
+  }
+  *r_frame = (int)ctime;
+  return pose_orig;
+}
+
+/**
+ * Copy the cached matrices of the current frame to the evaluated pose channels and mark them as
+ * done, so that their constraints and IK solvers are skipped.
+ */
+static bool pose_cache_restore(struct Depsgraph *depsgraph, Scene *scene, Object *object)
+{
+  int frame;
+  bPose *pose_orig = pose_cache_pose_get(depsgraph, scene, object, &frame);
+  if (pose_orig == NULL || pose_orig->cache == NULL) {
+    return false;
+  }
+  bPose *pose = object->pose;
+  const int channels_num = BLI_listbase_count(&pose->chanbase);
+  if (pose_orig->cache->channels_num != channels_num) {
+    BKE_pose_cache_free(pose_orig);
+    return false;
+  }
+  const PoseCacheChannel *cached = BLI_ghash_lookup(pose_orig->cache->frames,
+                                                    POINTER_FROM_INT(frame));
+  if (cached == NULL) {
+    return false;
+  }
+  for (int i = 0; i < channels_num; i++) {
+    bPoseChannel *pchan = pose->chan_array[i];
+    copy_m4_m4(pchan->pose_mat, cached[i].pose_mat);
+    copy_v3_v3(pchan->pose_head, pchan->pose_mat[3]);
+    copy_v3_v3(pchan->pose_tail, cached[i].pose_tail);
+    pchan->flag |= POSE_DONE;
+  }
+  return true;
+}
+
+/** Store the evaluated pose channels of the current frame, when they are not cached yet. */
+static void pose_cache_store(struct Depsgraph *depsgraph, Scene *scene, Object *object)
+{
+  int frame;
+  bPose *pose_orig = pose_cache_pose_get(depsgraph, scene, object, &frame);
+  if (pose_orig == NULL) {
+    return;
+  }
+  bPose *pose = object->pose;
+  const int channels_num = BLI_listbase_count(&pose->chanbase);
+  if (pose_orig->cache != NULL && pose_orig->cache->channels_num != channels_num) {
+    BKE_pose_cache_free(pose_orig);
+  }
+  if (pose_orig->cache == NULL) {
+    pose_orig->cache = MEM_callocN(sizeof(PoseCache), __func__);
+    pose_orig->cache->frames = BLI_ghash_int_new(__func__);
+    pose_orig->cache->channels_num = channels_num;
+  }
+  void **value_p;
+  if (BLI_ghash_ensure_p(pose_orig->cache->frames, POINTER_FROM_INT(frame), &value_p)) {
+    return;
+  }
+  PoseCacheChannel *cached = MEM_malloc_arrayN(
+      MAX2(channels_num, 1), sizeof(PoseCacheChannel), __func__);
+  for (int i = 0; i < channels_num; i++) {
+    const bPoseChannel *pchan = pose->chan_array[i];
+    copy_m4_m4(cached[i].pose_mat, pchan->pose_mat);
+    copy_v3_v3(cached[i].pose_tail, pchan->pose_tail);
+  }
+  *value_p = cached;
+}
+
 /* *************** Depsgraph evaluation callbacks ************ */
 
 void BKE_pose_pchan_index_rebuild(bPose *pose)
@@ -843,6 +963,10 @@ void BKE_pose_eval_init_ik(struct Depsgraph *depsgraph, Scene *scene, Object *ob
   if (armature->flag & ARM_RESTPOS) {
     return;
   }
+  /* Bones restored from the cache are done, no IK trees are needed for them. */
+  if (pose_cache_restore(depsgraph, scene, object)) {
+    return;
+  }
   /* construct the IK tree (standard IK) */
   BIK_init_tree(depsgraph, scene, object, ctime);
   /* construct the Spline IK trees
@@ -1027,13 +1151,26 @@ static void pose_eval_cleanup_common(Object *object)
   UNUSED_VARS_NDEBUG(pose);
 }
 
-void BKE_pose_eval_done(struct Depsgraph *depsgraph, Object *object)
+void BKE_pose_eval_done(struct Depsgraph *depsgraph, Scene *scene, Object *object)
 {
   bPose *pose = object->pose;
   BLI_assert(pose != NULL);
   UNUSED_VARS_NDEBUG(pose);
   DEG_debug_print_eval(depsgraph, __func__, object->id.name, object);
   BLI_assert(object->type == OB_ARMATURE);
+  pose_cache_store(depsgraph, scene, object);
+}
+
+void BKE_pose_eval_cache_reset(struct Depsgraph *depsgraph, Object *object)
+{
+  DEG_debug_print_eval(depsgraph, __func__, object->id.name, object);
+  if (!DEG_is_active(depsgraph)) {
+    return;
+  }
+  bPose *pose_orig = DEG_get_original_object(object)->pose;
+  if (pose_orig != NULL) {
+    BKE_pose_cache_free(pose_orig);
+  }
 }
 
 void BKE_pose_eval_cleanup(struct Depsgraph *depsgraph, Scene *scene, Object *object)
@@ -28,6 +28,7 @@
 #include "BKE_brush.h"
 #include "BKE_cachefile.h"
 #include "BKE_callbacks.h"
+#include "BKE_curves.h"
 #include "BKE_global.h"
 #include "BKE_idprop.h"
 #include "BKE_image.h"
@@ -72,6 +73,7 @@ void BKE_blender_free(void)
 
   IMB_exit();
   BKE_cachefiles_exit();
+  BKE_curves_to_mesh_cache_free();
   DEG_free_node_types();
 
   BKE_brush_system_exit();
@@ -35,6 +35,7 @@
 #include "BKE_bpath.h"
 #include "BKE_colorband.h"
 #include "BKE_context.h"
+#include "BKE_curves.h"
 #include "BKE_global.h"
 #include "BKE_ipo.h"
 #include "BKE_keyconfig.h"
@@ -181,6 +182,11 @@ static void setup_app_data(bContext *C,
     RE_FreeAllRenderResults();
   }
 
+  /* Cached curve to mesh topologies are unlikely to be used by another file. */
+  if (mode != LOAD_UNDO) {
+    BKE_curves_to_mesh_cache_free();
+  }
+
   /* Only make filepaths compatible when loading for real (not undo) */
   if (mode != LOAD_UNDO) {
     clean_paths(bfd->main);
@@ -959,10 +965,18 @@ bool BKE_blendfile_write_partial(Main *bmain_src,
     ID *id;
     ListBase *lb_dst = lbarray_dst[a], *lb_src = lbarray_src[a];
 
+    const int ids_num = BLI_listbase_count(lb_src);
+    if (ids_num == 0) {
+      continue;
+    }
+    ID **ids = MEM_mallocN(sizeof(*ids) * (size_t)ids_num, __func__);
+    int i = 0;
     while ((id = BLI_pophead(lb_src))) {
       BLI_addtail(lb_dst, id);
-      id_sort_by_name(lb_dst, id, NULL);
+      ids[i++] = id;
     }
+    id_sort_by_name_multiple(lb_dst, ids, ids_num);
+    MEM_freeN(ids);
   }
 
   MEM_freeN(bmain_dst);
@@ -1017,6 +1017,8 @@ void BKE_blendfile_append(BlendfileLinkAppendContext *lapp_context, ReportList *
   Main *bmain = lapp_context->params->bmain;
 
   BLI_assert((lapp_context->params->flag & FILE_LINK) == 0);
+  /* Appending placeholders would make them local, empty data-blocks. */
+  BLI_assert((lapp_context->params->flag & BLO_LIBLINK_DEFER_HIDDEN_OBDATA) == 0);
 
   const bool set_fakeuser = (lapp_context->params->flag & BLO_LIBLINK_APPEND_SET_FAKEUSER) != 0;
   const bool do_reuse_local_id = (lapp_context->params->flag &
@@ -1316,6 +1318,13 @@ void BKE_blendfile_link(BlendfileLinkAppendContext *lapp_context, ReportList *re
   if ((lapp_context->params->flag & FILE_LINK) != 0) {
     blendfile_link_append_proxies_convert(lapp_context->params->bmain, reports);
   }
+
+  if ((lapp_context->params->flag & BLO_LIBLINK_DEFER_HIDDEN_OBDATA) != 0 &&
+      lapp_context->params->context.scene != NULL) {
+    /* Only read the deferred object data used by what is visible in the scene. */
+    BKE_blendfile_link_deferred_visible_load(
+        lapp_context->params->bmain, lapp_context->params->context.scene, reports);
+  }
 }
 
 /** \} */
@@ -1636,3 +1645,160 @@ void BKE_blendfile_library_relocate(BlendfileLinkAppendContext *lapp_context,
 }
 
 /** \} */
+
+/** \name Deferred loading of linked data.
+ * \{ */
+
+static void link_deferred_tag_visible_collection(Collection *collection);
+
+static void link_deferred_tag_visible_object(Object *ob)
+{
+  if ((ob->visibility_flag & OB_HIDE_VIEWPORT) && (ob->visibility_flag & OB_HIDE_RENDER)) {
+    return;
+  }
+  ID *obdata = ob->data;
+  if (obdata != NULL && (obdata->tag & LIB_TAG_DEFERRED)) {
+    obdata->tag |= LIB_TAG_DOIT;
+  }
+  if ((ob->transflag & OB_DUPLICOLLECTION) && ob->instance_collection != NULL) {
+    link_deferred_tag_visible_collection(ob->instance_collection);
+  }
+}
+
+static bool link_deferred_collection_is_hidden(const Collection *collection)
+{
+  return (collection->flag & COLLECTION_HIDE_VIEWPORT) &&
+         (collection->flag & COLLECTION_HIDE_RENDER);
+}
+
+/* Used for instanced collections, which are not part of the view layers. */
+static void link_deferred_tag_visible_collection(Collection *collection)
+{
+  /* Also protects against (invalid) cycles of collection instances. */
+  if (collection->id.tag & LIB_TAG_DOIT) {
+    return;
+  }
+  collection->id.tag |= LIB_TAG_DOIT;
+
+  LISTBASE_FOREACH (CollectionObject *, cob, &collection->gobject) {
+    link_deferred_tag_visible_object(cob->ob);
+  }
+  LISTBASE_FOREACH (CollectionChild *, child, &collection->children) {
+    if (!link_deferred_collection_is_hidden(child->collection)) {
+      link_deferred_tag_visible_collection(child->collection);
+    }
+  }
+}
+
+static void link_deferred_tag_visible_layer_collections(ListBase *layer_collections)
+{
+  LISTBASE_FOREACH (LayerCollection *, layer_collection, layer_collections) {
+    if ((layer_collection->flag & LAYER_COLLECTION_EXCLUDE) ||
+        link_deferred_collection_is_hidden(layer_collection->collection)) {
+      continue;
+    }
+    LISTBASE_FOREACH (CollectionObject *, cob, &layer_collection->collection->gobject) {
+      link_deferred_tag_visible_object(cob->ob);
+    }
+    link_deferred_tag_visible_layer_collections(&layer_collection->layer_collections);
+  }
+}
+
+void BKE_blendfile_link_deferred_visible_load(Main *bmain, Scene *scene, ReportList *reports)
+{
+  BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+  LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
+    link_deferred_tag_visible_layer_collections(&view_layer->layer_collections);
+  }
+  BKE_blendfile_link_deferred_tagged_load(bmain, reports);
+}
+
+void BKE_blendfile_link_deferred_tagged_load(Main *bmain, ReportList *reports)
+{
+  /* Gather the placeholders to load first, since linking and remapping may use the tags. */
+  LinkNode *deferred_ids = NULL;
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if ((id->tag & (LIB_TAG_DEFERRED | LIB_TAG_DOIT)) == (LIB_TAG_DEFERRED | LIB_TAG_DOIT)) {
+      BLI_linklist_prepend(&deferred_ids, id);
+    }
+  }
+  FOREACH_MAIN_ID_END;
+
+  if (deferred_ids == NULL) {
+    BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+    return;
+  }
+
+  LISTBASE_FOREACH (Library *, library, &bmain->libraries) {
+    LibraryLink_Params lapp_params;
+    BLO_library_link_params_init(
+        &lapp_params, bmain, BLO_LIBLINK_USE_PLACEHOLDERS | BLO_LIBLINK_FORCE_INDIRECT, 0);
+    BlendfileLinkAppendContext *lapp_context = BKE_blendfile_link_append_context_new(&lapp_params);
+    BKE_blendfile_link_append_context_library_add(lapp_context, library->filepath_abs, NULL);
+
+    /* Remove the placeholders from Main, so that the real IDs get read instead of finding them
+     * as already linked, see #BKE_blendfile_library_relocate. */
+    for (LinkNode *ln = deferred_ids; ln; ln = ln->next) {
+      ID *old_id = ln->link;
+      if (old_id->lib != library) {
+        continue;
+      }
+      BLI_remlink(which_libbase(bmain, GS(old_id->name)), old_id);
+      BlendfileLinkAppendContextItem *item = BKE_blendfile_link_append_context_item_add(
+          lapp_context, old_id->name + 2, GS(old_id->name), old_id);
+      BLI_bitmap_set_all(item->libraries, true, (size_t)lapp_context->num_libraries);
+    }
+
+    if (lapp_context->num_items == 0) {
+      BKE_blendfile_link_append_context_free(lapp_context);
+      continue;
+    }
+
+    BKE_blendfile_link(lapp_context, reports);
+
+    BKE_main_lock(bmain);
+
+    LinkNode *itemlink;
+    for (itemlink = lapp_context->items.list; itemlink; itemlink = itemlink->next) {
+      BlendfileLinkAppendContextItem *item = itemlink->link;
+      ID *old_id = item->userdata;
+      BLI_addtail(which_libbase(bmain, GS(old_id->name)), old_id);
+    }
+    BKE_main_id_refcount_recompute(bmain, false);
+
+    for (itemlink = lapp_context->items.list; itemlink; itemlink = itemlink->next) {
+      BlendfileLinkAppendContextItem *item = itemlink->link;
+      /* Placeholders are requested, so there always is a new ID, even if the library or the
+       * data-block went missing in the mean time. */
+      BLI_assert(item->new_id != NULL);
+      BKE_libblock_remap_locked(
+          bmain, item->userdata, item->new_id, ID_REMAP_SKIP_NEVER_NULL_USAGE);
+    }
+
+    BKE_main_unlock(bmain);
+
+    BKE_blendfile_link_append_context_free(lapp_context);
+  }
+
+  /* Placeholders do not have any material, objects using the loaded data need to be updated
+   * (this does nothing for the other ones). */
+  LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+    ID *obdata = ob->data;
+    if (obdata != NULL && ID_IS_LINKED(obdata)) {
+      BKE_object_materials_test(bmain, ob, obdata);
+    }
+  }
+
+  /* Delete the no more used placeholders. */
+  BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+  for (LinkNode *ln = deferred_ids; ln; ln = ln->next) {
+    ((ID *)ln->link)->tag |= LIB_TAG_DOIT;
+  }
+  BKE_id_multi_tagged_delete(bmain);
+  BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+
+  BLI_linklist_free(deferred_ids, NULL);
+}
+
+/** \} */
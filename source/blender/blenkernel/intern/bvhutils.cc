@@ -17,6 +17,7 @@
 #include "BLI_math.h"
 #include "BLI_span.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -38,17 +39,21 @@ using blender::VArray;
 struct BVHCacheItem {
   bool is_filled;
   BVHTree *tree;
+  /**
+   * Every type has its own lock, so that different trees of the same mesh can be built at the
+   * same time, e.g. by modifiers that use the vertex and the triangle tree of the same object.
+   */
+  ThreadMutex mutex;
 };
 
 struct BVHCache {
   BVHCacheItem items[BVHTREE_MAX_ITEM];
-  ThreadMutex mutex;
 };
 
 /**
  * Queries a bvhcache for the cache bvhtree of the request type
  *
- * When the `r_locked` is filled and the tree could not be found the caches mutex will be
+ * When the `r_locked` is filled and the tree could not be found the mutex of the type will be
  * locked. This mutex can be unlocked by calling `bvhcache_unlock`.
  *
  * When `r_locked` is used the `mesh_eval_mutex` must contain the `Mesh_Runtime.eval_mutex`.
@@ -82,10 +87,10 @@ static bool bvhcache_find(BVHCache **bvh_cache_p,
     return true;
   }
   if (do_lock) {
-    BLI_mutex_lock(&bvh_cache->mutex);
+    BLI_mutex_lock(&bvh_cache->items[type].mutex);
     bool in_cache = bvhcache_find(bvh_cache_p, type, r_tree, nullptr, nullptr);
     if (in_cache) {
-      BLI_mutex_unlock(&bvh_cache->mutex);
+      BLI_mutex_unlock(&bvh_cache->items[type].mutex);
       return in_cache;
     }
     *r_locked = true;
@@ -93,10 +98,10 @@ static bool bvhcache_find(BVHCache **bvh_cache_p,
   return false;
 }
 
-static void bvhcache_unlock(BVHCache *bvh_cache, bool lock_started)
+static void bvhcache_unlock(BVHCache *bvh_cache, BVHCacheType type, bool lock_started)
 {
   if (lock_started) {
-    BLI_mutex_unlock(&bvh_cache->mutex);
+    BLI_mutex_unlock(&bvh_cache->items[type].mutex);
   }
 }
 
@@ -117,7 +122,9 @@ bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree)
 BVHCache *bvhcache_init()
 {
   BVHCache *cache = MEM_cnew<BVHCache>(__func__);
-  BLI_mutex_init(&cache->mutex);
+  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    BLI_mutex_init(&cache->items[index].mutex);
+  }
   return cache;
 }
 /**
@@ -142,8 +149,8 @@ void bvhcache_free(BVHCache *bvh_cache)
     BVHCacheItem *item = &bvh_cache->items[index];
     BLI_bvhtree_free(item->tree);
     item->tree = nullptr;
+    BLI_mutex_end(&item->mutex);
   }
-  BLI_mutex_end(&bvh_cache->mutex);
   MEM_freeN(bvh_cache);
 }
 
@@ -152,20 +159,251 @@ void bvhcache_free(BVHCache *bvh_cache)
  * is multithreaded, and we do not want the current thread to start another task
  * that may involve acquiring the same mutex lock that it is waiting for.
  */
+struct BVHTreeBalanceData {
+  BVHTree *tree;
+  int flag;
+};
+
 static void bvhtree_balance_isolated(void *userdata)
 {
-  BLI_bvhtree_balance((BVHTree *)userdata);
+  const BVHTreeBalanceData *data = static_cast<const BVHTreeBalanceData *>(userdata);
+  BLI_bvhtree_balance_ex(data->tree, data->flag);
 }
 
-static void bvhtree_balance(BVHTree *tree, const bool isolate)
+static void bvhtree_balance(BVHTree *tree, const bool isolate, const int balance_flag = 0)
 {
   if (tree) {
     if (isolate) {
-      BLI_task_isolate(bvhtree_balance_isolated, tree);
+      BVHTreeBalanceData data = {tree, balance_flag};
+      BLI_task_isolate(bvhtree_balance_isolated, &data);
     }
     else {
-      BLI_bvhtree_balance(tree);
+      BLI_bvhtree_balance_ex(tree, balance_flag);
+    }
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name BVHTreeStash
+ *
+ * Building a BVH tree is much more expensive than updating the bounds of the nodes of an existing
+ * tree. Refitting gives slightly worse trees when the positions change a lot, but that is usually
+ * a good trade-off for deforming meshes, which are re-evaluated often.
+ * \{ */
+
+struct BVHTreeStash {
+  /**
+   * Trees indexed by #BVHCacheType, only for the types that contain every element of the mesh,
+   * see #bvhtree_stash_supports_type.
+   */
+  BVHTree *trees[BVHTREE_MAX_ITEM];
+
+  /** The topology of the mesh the trees were built for. */
+  uint32_t topology_hash;
+  int verts_num;
+  int edges_num;
+  int polys_num;
+  int loops_num;
+};
+
+/**
+ * The leafs of these trees are in the same order as the elements, so they can be updated from
+ * the positions of the elements directly.
+ */
+static bool bvhtree_stash_supports_type(const int type)
+{
+  return ELEM(type, BVHTREE_FROM_VERTS, BVHTREE_FROM_EDGES, BVHTREE_FROM_LOOPTRI);
+}
+
+static BVHTreeStash *bvhtree_stash_new(const Mesh *mesh)
+{
+  BVHTreeStash *stash = MEM_cnew<BVHTreeStash>(__func__);
+  stash->verts_num = mesh->totvert;
+  stash->edges_num = mesh->totedge;
+  stash->polys_num = mesh->totpoly;
+  stash->loops_num = mesh->totloop;
+  /* Only needed when the stash is used for a different mesh. */
+  stash->topology_hash = 0;
+  return stash;
+}
+
+void BKE_bvhtree_stash_free(BVHTreeStash *stash)
+{
+  if (stash == nullptr) {
+    return;
+  }
+  for (BVHTree *tree : stash->trees) {
+    if (tree != nullptr) {
+      BLI_bvhtree_free(tree);
+    }
+  }
+  MEM_freeN(stash);
+}
+
+void BKE_bvhtree_stash_from_mesh_cache(Mesh *mesh)
+{
+  BVHCache *bvh_cache = mesh->runtime.bvh_cache;
+  if (bvh_cache == nullptr) {
+    return;
+  }
+  for (int type = 0; type < BVHTREE_MAX_ITEM; type++) {
+    BVHCacheItem &item = bvh_cache->items[type];
+    if (!bvhtree_stash_supports_type(type) || !item.is_filled || item.tree == nullptr) {
+      continue;
+    }
+    if (mesh->runtime.bvh_stash == nullptr) {
+      mesh->runtime.bvh_stash = bvhtree_stash_new(mesh);
+    }
+    BVHTree *&stashed_tree = mesh->runtime.bvh_stash->trees[type];
+    if (stashed_tree != nullptr) {
+      BLI_bvhtree_free(stashed_tree);
+    }
+    stashed_tree = item.tree;
+    item.tree = nullptr;
+  }
+  bvhcache_free(bvh_cache);
+  mesh->runtime.bvh_cache = nullptr;
+}
+
+BVHTreeStash *BKE_bvhtree_stash_take_from_mesh(Mesh *mesh)
+{
+  BKE_bvhtree_stash_from_mesh_cache(mesh);
+  BVHTreeStash *stash = mesh->runtime.bvh_stash;
+  if (stash == nullptr) {
+    return nullptr;
+  }
+  mesh->runtime.bvh_stash = nullptr;
+  stash->topology_hash = BKE_mesh_topology_hash(mesh);
+  return stash;
+}
+
+void BKE_bvhtree_stash_assign_to_mesh(BVHTreeStash *stash, Mesh *mesh)
+{
+  if (stash == nullptr) {
+    return;
+  }
+  if (stash->verts_num != mesh->totvert || stash->edges_num != mesh->totedge ||
+      stash->polys_num != mesh->totpoly || stash->loops_num != mesh->totloop ||
+      stash->topology_hash != BKE_mesh_topology_hash(mesh)) {
+    BKE_bvhtree_stash_free(stash);
+    return;
+  }
+  BKE_bvhtree_stash_free(mesh->runtime.bvh_stash);
+  mesh->runtime.bvh_stash = stash;
+}
+
+/**
+ * Take the stashed tree of the given type out of the stash of the mesh, if it is compatible.
+ *
+ * \note Must be called while the #BVHCache mutex is locked.
+ * \return The tree which is now owned by the caller, or null.
+ */
+static BVHTree *bvhtree_stash_take_tree(Mesh *mesh,
+                                        const BVHCacheType bvh_cache_type,
+                                        const float epsilon,
+                                        const int tree_type,
+                                        const int leafs_num)
+{
+  BVHTreeStash *stash = mesh->runtime.bvh_stash;
+  if (stash == nullptr) {
+    return nullptr;
+  }
+  BVHTree *tree = stash->trees[bvh_cache_type];
+  if (tree == nullptr) {
+    return nullptr;
+  }
+  stash->trees[bvh_cache_type] = nullptr;
+
+  if (BLI_bvhtree_get_len(tree) != leafs_num || BLI_bvhtree_get_tree_type(tree) != tree_type ||
+      BLI_bvhtree_get_epsilon(tree) != epsilon) {
+    BLI_bvhtree_free(tree);
+    return nullptr;
+  }
+  return tree;
+}
+
+/**
+ * Update the leafs in parallel, followed by the branches, see #BLI_bvhtree_update_tree.
+ * \param get_coords: Fills the coordinates of a leaf and returns their number.
+ */
+template<typename GetCoordsFn>
+static void bvhtree_refit_parallel(BVHTree *tree,
+                                   const int leafs_num,
+                                   const GetCoordsFn get_coords)
+{
+  using namespace blender;
+  /* The mutex is locked, so the current thread must not pick up unrelated tasks that may try to
+   * lock it again, see #bvhtree_balance_isolated. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(IndexRange(leafs_num), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        float co[3][3];
+        const int points_num = get_coords(i, co);
+        BLI_bvhtree_update_node(tree, i, co[0], nullptr, points_num);
+      }
+    });
+    BLI_bvhtree_update_tree(tree);
+  });
+}
+
+/**
+ * Refit the stashed tree of the mesh to its current positions, if it is compatible.
+ *
+ * \note Must be called while the #BVHCache mutex is locked.
+ * \return The refitted tree which is now owned by the caller, or null.
+ */
+static BVHTree *bvhtree_from_mesh_refit_stash(Mesh *mesh,
+                                              const BVHCacheType bvh_cache_type,
+                                              const float epsilon,
+                                              const int tree_type,
+                                              const MVert *vert,
+                                              const MEdge *edge,
+                                              const MLoop *mloop,
+                                              const MLoopTri *looptri,
+                                              const int looptri_num)
+{
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS: {
+      BVHTree *tree = bvhtree_stash_take_tree(
+          mesh, bvh_cache_type, epsilon, tree_type, mesh->totvert);
+      if (tree != nullptr) {
+        bvhtree_refit_parallel(tree, mesh->totvert, [&](const int i, float co[3][3]) {
+          copy_v3_v3(co[0], vert[i].co);
+          return 1;
+        });
+      }
+      return tree;
     }
+    case BVHTREE_FROM_EDGES: {
+      BVHTree *tree = bvhtree_stash_take_tree(
+          mesh, bvh_cache_type, epsilon, tree_type, mesh->totedge);
+      if (tree != nullptr) {
+        bvhtree_refit_parallel(tree, mesh->totedge, [&](const int i, float co[3][3]) {
+          copy_v3_v3(co[0], vert[edge[i].v1].co);
+          copy_v3_v3(co[1], vert[edge[i].v2].co);
+          return 2;
+        });
+      }
+      return tree;
+    }
+    case BVHTREE_FROM_LOOPTRI: {
+      BVHTree *tree = bvhtree_stash_take_tree(
+          mesh, bvh_cache_type, epsilon, tree_type, looptri_num);
+      if (tree != nullptr) {
+        bvhtree_refit_parallel(tree, looptri_num, [&](const int i, float co[3][3]) {
+          copy_v3_v3(co[0], vert[mloop[looptri[i].tri[0]].v].co);
+          copy_v3_v3(co[1], vert[mloop[looptri[i].tri[1]].v].co);
+          copy_v3_v3(co[2], vert[mloop[looptri[i].tri[2]].v].co);
+          return 3;
+        });
+      }
+      return tree;
+    }
+    default:
+      BLI_assert_unreachable();
+      return nullptr;
   }
 }
 
@@ -1221,6 +1459,15 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                    const struct Mesh *mesh,
                                    const BVHCacheType bvh_cache_type,
                                    const int tree_type)
+{
+  return BKE_bvhtree_from_mesh_get_ex(data, mesh, bvh_cache_type, tree_type, 0);
+}
+
+BVHTree *BKE_bvhtree_from_mesh_get_ex(struct BVHTreeFromMesh *data,
+                                      const struct Mesh *mesh,
+                                      const BVHCacheType bvh_cache_type,
+                                      const int tree_type,
+                                      const int balance_flag)
 {
   BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime.bvh_cache;
   ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
@@ -1261,6 +1508,7 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
 
   BLI_bitmap *mask = nullptr;
   int mask_bits_act_len = -1;
+  bool is_refitted = false;
 
   switch (bvh_cache_type) {
     case BVHTREE_FROM_LOOSEVERTS:
@@ -1268,16 +1516,50 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
           edges.data(), mesh->totedge, verts.data(), mesh->totvert, &mask_bits_act_len);
       ATTR_FALLTHROUGH;
     case BVHTREE_FROM_VERTS:
-      data->tree = bvhtree_from_mesh_verts_create_tree(
-          0.0f, tree_type, 6, verts.data(), mesh->totvert, mask, mask_bits_act_len);
+      if (mask == nullptr) {
+        data->tree = bvhtree_from_mesh_refit_stash(const_cast<Mesh *>(mesh),
+                                                   BVHTREE_FROM_VERTS,
+                                                   0.0f,
+                                                   tree_type,
+                                                   verts.data(),
+                                                   edges.data(),
+                                                   loops.data(),
+                                                   looptri,
+                                                   looptri_len);
+        is_refitted = data->tree != nullptr;
+      }
+      if (!is_refitted) {
+        data->tree = bvhtree_from_mesh_verts_create_tree(
+            0.0f, tree_type, 6, verts.data(), mesh->totvert, mask, mask_bits_act_len);
+      }
       break;
 
     case BVHTREE_FROM_LOOSEEDGES:
       mask = loose_edges_map_get(edges.data(), mesh->totedge, &mask_bits_act_len);
       ATTR_FALLTHROUGH;
     case BVHTREE_FROM_EDGES:
-      data->tree = bvhtree_from_mesh_edges_create_tree(
-          verts.data(), edges.data(), mesh->totedge, mask, mask_bits_act_len, 0.0f, tree_type, 6);
+      if (mask == nullptr) {
+        data->tree = bvhtree_from_mesh_refit_stash(const_cast<Mesh *>(mesh),
+                                                   BVHTREE_FROM_EDGES,
+                                                   0.0f,
+                                                   tree_type,
+                                                   verts.data(),
+                                                   edges.data(),
+                                                   loops.data(),
+                                                   looptri,
+                                                   looptri_len);
+        is_refitted = data->tree != nullptr;
+      }
+      if (!is_refitted) {
+        data->tree = bvhtree_from_mesh_edges_create_tree(verts.data(),
+                                                         edges.data(),
+                                                         mesh->totedge,
+                                                         mask,
+                                                         mask_bits_act_len,
+                                                         0.0f,
+                                                         tree_type,
+                                                         6);
+      }
       break;
 
     case BVHTREE_FROM_FACES:
@@ -1303,15 +1585,29 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
       ATTR_FALLTHROUGH;
     }
     case BVHTREE_FROM_LOOPTRI:
-      data->tree = bvhtree_from_mesh_looptri_create_tree(0.0f,
-                                                         tree_type,
-                                                         6,
-                                                         verts.data(),
-                                                         loops.data(),
-                                                         looptri,
-                                                         looptri_len,
-                                                         mask,
-                                                         mask_bits_act_len);
+      if (mask == nullptr) {
+        data->tree = bvhtree_from_mesh_refit_stash(const_cast<Mesh *>(mesh),
+                                                   BVHTREE_FROM_LOOPTRI,
+                                                   0.0f,
+                                                   tree_type,
+                                                   verts.data(),
+                                                   edges.data(),
+                                                   loops.data(),
+                                                   looptri,
+                                                   looptri_len);
+        is_refitted = data->tree != nullptr;
+      }
+      if (!is_refitted) {
+        data->tree = bvhtree_from_mesh_looptri_create_tree(0.0f,
+                                                           tree_type,
+                                                           6,
+                                                           verts.data(),
+                                                           loops.data(),
+                                                           looptri,
+                                                           looptri_len,
+                                                           mask,
+                                                           mask_bits_act_len);
+      }
       break;
     case BVHTREE_FROM_EM_VERTS:
     case BVHTREE_FROM_EM_EDGES:
@@ -1325,14 +1621,16 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
     MEM_freeN(mask);
   }
 
-  bvhtree_balance(data->tree, lock_started);
+  if (!is_refitted) {
+    bvhtree_balance(data->tree, lock_started, balance_flag);
+  }
 
   /* Save on cache for later use */
   // printf("BVHTree built and saved on cache\n");
   BLI_assert(data->cached == false);
   data->cached = true;
   bvhcache_insert(*bvh_cache_p, data->tree, bvh_cache_type);
-  bvhcache_unlock(*bvh_cache_p, lock_started);
+  bvhcache_unlock(*bvh_cache_p, bvh_cache_type, lock_started);
 
 #ifdef DEBUG
   if (data->tree != nullptr) {
@@ -1398,7 +1696,7 @@ BVHTree *BKE_bvhtree_from_editmesh_get(BVHTreeFromEditMesh *data,
     BLI_assert(data->cached == false);
     data->cached = true;
     bvhcache_insert(*bvh_cache_p, data->tree, bvh_cache_type);
-    bvhcache_unlock(*bvh_cache_p, lock_started);
+    bvhcache_unlock(*bvh_cache_p, bvh_cache_type, lock_started);
   }
 
 #ifdef DEBUG
@@ -38,12 +38,12 @@ typedef struct {
 
   /* these point to data in the DerivedMesh custom data layers,
    * they are only here for efficiency and convenience */
-  MVert *mvert;
+  const MVert *mvert;
   const float (*vert_normals)[3];
-  MEdge *medge;
-  MFace *mface;
-  MLoop *mloop;
-  MPoly *mpoly;
+  const MEdge *medge;
+  const MFace *mface;
+  const MLoop *mloop;
+  const MPoly *mpoly;
 
   /* Cached */
   struct PBVH *pbvh;
@@ -12,6 +12,7 @@
 #include <string.h>
 
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
 #include "BLI_iterator.h"
 #include "BLI_listbase.h"
 #include "BLI_math_base.h"
@@ -1176,6 +1177,70 @@ bool BKE_collection_viewlayer_object_add(Main *bmain,
   return BKE_collection_object_add_notest(bmain, collection, ob);
 }
 
+int BKE_collection_object_add_multiple(Main *bmain,
+                                       Collection *collection,
+                                       Object **objects,
+                                       const int objects_num)
+{
+  if (collection == NULL) {
+    return 0;
+  }
+
+  collection = collection_parent_editable_find_recursive(NULL, collection);
+
+  if (collection == NULL) {
+    return 0;
+  }
+
+  /* Avoid searching the list of objects for every added object. */
+  GSet *collection_objects = BLI_gset_ptr_new_ex(
+      __func__, (uint)(BLI_listbase_count(&collection->gobject) + objects_num));
+  LISTBASE_FOREACH (CollectionObject *, cob, &collection->gobject) {
+    BLI_gset_insert(collection_objects, cob->ob);
+  }
+
+  int added_num = 0;
+  for (int i = 0; i < objects_num; i++) {
+    Object *ob = objects[i];
+    if (ob == NULL) {
+      continue;
+    }
+    if (ob->instance_collection) {
+      /* Cyclic dependency check. */
+      if (collection_find_child_recursive(ob->instance_collection, collection) ||
+          ob->instance_collection == collection) {
+        continue;
+      }
+    }
+    if (!BLI_gset_add(collection_objects, ob)) {
+      continue;
+    }
+
+    CollectionObject *cob = MEM_callocN(sizeof(CollectionObject), __func__);
+    cob->ob = ob;
+    BLI_addtail(&collection->gobject, cob);
+    id_us_plus(&ob->id);
+    BKE_rigidbody_main_collection_object_add(bmain, collection, ob);
+    added_num++;
+  }
+  BLI_gset_free(collection_objects, NULL);
+
+  if (added_num == 0) {
+    return 0;
+  }
+
+  BKE_collection_object_cache_free(collection);
+  collection_tag_update_parent_recursive(bmain, collection, ID_RECALC_COPY_ON_WRITE);
+
+  if (BKE_collection_is_in_scene(collection)) {
+    BKE_main_collection_sync(bmain);
+  }
+
+  DEG_id_tag_update(&collection->id, ID_RECALC_GEOMETRY);
+
+  return added_num;
+}
+
 void BKE_collection_object_add_from(Main *bmain, Scene *scene, Object *ob_src, Object *ob_dst)
 {
   bool is_instantiated = false;
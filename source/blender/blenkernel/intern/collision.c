@@ -653,274 +653,361 @@ static void cloth_collision_impulse_vert(const float clamp_sq,
   vert->impulse_count++;
 }
 
-static int cloth_collision_response_static(ClothModifierData *clmd,
-                                           CollisionModifierData *collmd,
-                                           Object *collob,
-                                           CollPair *collpair,
-                                           uint collision_count,
-                                           const float dt)
+/**
+ * Compute the impulses of a single collision pair of cloth and a collision object, for the
+ * vertices of the cloth triangle. Only reads the simulation state, so pairs can be handled in
+ * parallel.
+ */
+static bool cloth_collision_pair_impulse(const ClothModifierData *clmd,
+                                         const CollisionModifierData *collmd,
+                                         const Object *collob,
+                                         const CollPair *collpair,
+                                         const float min_distance,
+                                         const float time_multiplier,
+                                         float r_impulse[3][3])
 {
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
-  const float min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f);
-
+  const Cloth *cloth = clmd->clothObject;
   const bool is_hair = (clmd->hairdata != NULL);
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float i1[3], i2[3], i3[3];
-    float w1, w2, w3, u1, u2, u3;
-    float v1[3], v2[3], relativeVelocity[3];
-    zero_v3(i1);
-    zero_v3(i2);
-    zero_v3(i3);
-
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
+  float *i1 = r_impulse[0], *i2 = r_impulse[1], *i3 = r_impulse[2];
+  float w1, w2, w3, u1, u2, u3;
+  float v1[3], v2[3], relativeVelocity[3];
+  bool result = false;
+  zero_v3(i1);
+  zero_v3(i2);
+  zero_v3(i3);
+
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return false;
+  }
 
-    /* Compute barycentric coordinates and relative "velocity" for both collision points. */
-    if (is_hair) {
-      w2 = line_point_factor_v3(
-          collpair->pa, cloth->verts[collpair->ap1].tx, cloth->verts[collpair->ap2].tx);
+  /* Compute barycentric coordinates and relative "velocity" for both collision points. */
+  if (is_hair) {
+    w2 = line_point_factor_v3(
+        collpair->pa, cloth->verts[collpair->ap1].tx, cloth->verts[collpair->ap2].tx);
 
-      w1 = 1.0f - w2;
+    w1 = 1.0f - w2;
 
-      interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
-    }
-    else {
-      collision_compute_barycentric(collpair->pa,
-                                    cloth->verts[collpair->ap1].tx,
-                                    cloth->verts[collpair->ap2].tx,
-                                    cloth->verts[collpair->ap3].tx,
-                                    &w1,
-                                    &w2,
-                                    &w3);
-
-      collision_interpolateOnTriangle(v1,
-                                      cloth->verts[collpair->ap1].tv,
-                                      cloth->verts[collpair->ap2].tv,
-                                      cloth->verts[collpair->ap3].tv,
-                                      w1,
-                                      w2,
-                                      w3);
-    }
+    interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
+  }
+  else {
+    collision_compute_barycentric(collpair->pa,
+                                  cloth->verts[collpair->ap1].tx,
+                                  cloth->verts[collpair->ap2].tx,
+                                  cloth->verts[collpair->ap3].tx,
+                                  &w1,
+                                  &w2,
+                                  &w3);
 
-    collision_compute_barycentric(collpair->pb,
-                                  collmd->current_xnew[collpair->bp1].co,
-                                  collmd->current_xnew[collpair->bp2].co,
-                                  collmd->current_xnew[collpair->bp3].co,
-                                  &u1,
-                                  &u2,
-                                  &u3);
-
-    collision_interpolateOnTriangle(v2,
-                                    collmd->current_v[collpair->bp1].co,
-                                    collmd->current_v[collpair->bp2].co,
-                                    collmd->current_v[collpair->bp3].co,
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(i1, vrel_t_pre, (double)w1 * impulse);
-        VECADDMUL(i2, vrel_t_pre, (double)w2 * impulse);
-
-        if (!is_hair) {
-          VECADDMUL(i3, vrel_t_pre, (double)w3 * impulse);
-        }
-      }
+    collision_interpolateOnTriangle(v1,
+                                    cloth->verts[collpair->ap1].tv,
+                                    cloth->verts[collpair->ap2].tv,
+                                    cloth->verts[collpair->ap3].tv,
+                                    w1,
+                                    w2,
+                                    w3);
+  }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 1.5f;
+  collision_compute_barycentric(collpair->pb,
+                                collmd->current_xnew[collpair->bp1].co,
+                                collmd->current_xnew[collpair->bp2].co,
+                                collmd->current_xnew[collpair->bp3].co,
+                                &u1,
+                                &u2,
+                                &u3);
 
-      VECADDMUL(i1, collpair->normal, (double)w1 * impulse);
-      VECADDMUL(i2, collpair->normal, (double)w2 * impulse);
-      if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, (double)w3 * impulse);
-      }
+  collision_interpolateOnTriangle(v2,
+                                  collmd->current_v[collpair->bp1].co,
+                                  collmd->current_v[collpair->bp2].co,
+                                  collmd->current_v[collpair->bp3].co,
+                                  u1,
+                                  u2,
+                                  u3);
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-        /* Stay on the safe side and clamp repulse. */
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0f * impulse);
-        }
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-        repulse = max_ff(impulse, repulse);
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
 
-        impulse = repulse / 1.5f;
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
 
-        VECADDMUL(i1, collpair->normal, impulse);
-        VECADDMUL(i2, collpair->normal, impulse);
-        if (!is_hair) {
-          VECADDMUL(i3, collpair->normal, impulse);
-        }
-      }
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d / time_multiplier;
-      float impulse = repulse / 4.5f;
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-      VECADDMUL(i1, collpair->normal, w1 * impulse);
-      VECADDMUL(i2, collpair->normal, w2 * impulse);
+      impulse = magtangent / 1.5;
+
+      VECADDMUL(i1, vrel_t_pre, (double)w1 * impulse);
+      VECADDMUL(i2, vrel_t_pre, (double)w2 * impulse);
 
       if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, w3 * impulse);
+        VECADDMUL(i3, vrel_t_pre, (double)w3 * impulse);
       }
+    }
+
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 1.5f;
 
-      result = 1;
+    VECADDMUL(i1, collpair->normal, (double)w1 * impulse);
+    VECADDMUL(i2, collpair->normal, (double)w2 * impulse);
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, (double)w3 * impulse);
     }
 
-    if (result) {
-      cloth_collision_impulse_vert(clamp_sq, i1, &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, i2, &cloth->verts[collpair->ap2]);
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      /* Stay on the safe side and clamp repulse. */
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0f * impulse);
+      }
+
+      repulse = max_ff(impulse, repulse);
+
+      impulse = repulse / 1.5f;
+
+      VECADDMUL(i1, collpair->normal, impulse);
+      VECADDMUL(i2, collpair->normal, impulse);
       if (!is_hair) {
-        cloth_collision_impulse_vert(clamp_sq, i3, &cloth->verts[collpair->ap3]);
+        VECADDMUL(i3, collpair->normal, impulse);
       }
     }
+
+    result = true;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d / time_multiplier;
+    float impulse = repulse / 4.5f;
+
+    VECADDMUL(i1, collpair->normal, w1 * impulse);
+    VECADDMUL(i2, collpair->normal, w2 * impulse);
+
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, w3 * impulse);
+    }
+
+    result = true;
   }
 
   return result;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+typedef struct CollisionResponseData {
+  const ClothModifierData *clmd;
+  const CollisionModifierData *collmd;
+  const Object *collob;
+  const CollPair *collisions;
+  float min_distance;
+  float time_multiplier;
+  /* Per collision pair: three impulses, and whether they are to be applied. */
+  float (*impulses)[3][3];
+  bool *use_impulse;
+} CollisionResponseData;
+
+static void cloth_collision_response_static_cb(void *__restrict userdata,
+                                               const int index,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CollisionResponseData *data = (CollisionResponseData *)userdata;
+  data->use_impulse[index] = cloth_collision_pair_impulse(data->clmd,
+                                                          data->collmd,
+                                                          data->collob,
+                                                          &data->collisions[index],
+                                                          data->min_distance,
+                                                          data->time_multiplier,
+                                                          data->impulses[index]);
+}
+
+static int cloth_collision_response_static(ClothModifierData *clmd,
+                                           CollisionModifierData *collmd,
+                                           Object *collob,
+                                           CollPair *collpair,
+                                           uint collision_count,
+                                           const float dt)
 {
   int result = 0;
   Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
+  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
+  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
+  const bool is_hair = (clmd->hairdata != NULL);
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
-    float w1, w2, w3, u1, u2, u3;
-    float v1[3], v2[3], relativeVelocity[3];
+  /* Impulses of all pairs are computed in parallel, and then applied in order. Vertices keep the
+   * largest impulse per axis, so the result does not depend on the order of the pairs. */
+  CollisionResponseData data = {
+      .clmd = clmd,
+      .collmd = collmd,
+      .collob = collob,
+      .collisions = collpair,
+      .min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f),
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .impulses = MEM_malloc_arrayN(collision_count, sizeof(*data.impulses), __func__),
+      .use_impulse = MEM_malloc_arrayN(collision_count, sizeof(bool), __func__),
+  };
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = true;
+  BLI_task_parallel_range(
+      0, collision_count, &data, cloth_collision_response_static_cb, &settings);
+
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    if (!data.use_impulse[i]) {
       continue;
     }
+    cloth_collision_impulse_vert(clamp_sq, data.impulses[i][0], &cloth->verts[collpair->ap1]);
+    cloth_collision_impulse_vert(clamp_sq, data.impulses[i][1], &cloth->verts[collpair->ap2]);
+    if (!is_hair) {
+      cloth_collision_impulse_vert(clamp_sq, data.impulses[i][2], &cloth->verts[collpair->ap3]);
+    }
+    result = 1;
+  }
 
-    /* Compute barycentric coordinates for both collision points. */
-    collision_compute_barycentric(collpair->pa,
-                                  cloth->verts[collpair->ap1].tx,
-                                  cloth->verts[collpair->ap2].tx,
-                                  cloth->verts[collpair->ap3].tx,
-                                  &w1,
-                                  &w2,
-                                  &w3);
+  MEM_freeN(data.impulses);
+  MEM_freeN(data.use_impulse);
 
-    collision_compute_barycentric(collpair->pb,
-                                  cloth->verts[collpair->bp1].tx,
-                                  cloth->verts[collpair->bp2].tx,
-                                  cloth->verts[collpair->bp3].tx,
-                                  &u1,
-                                  &u2,
-                                  &u3);
+  return result;
+}
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth->verts[collpair->ap1].tv,
-                                    cloth->verts[collpair->ap2].tv,
-                                    cloth->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+/**
+ * Compute the impulses of a single self collision pair, for the vertices of both triangles.
+ * Only reads the simulation state, so pairs can be handled in parallel.
+ */
+static bool cloth_selfcollision_pair_impulse(const ClothModifierData *clmd,
+                                             const CollPair *collpair,
+                                             const float min_distance,
+                                             const float time_multiplier,
+                                             float r_impulse_a[3][3],
+                                             float r_impulse_b[3][3])
+{
+  const Cloth *cloth = clmd->clothObject;
+  float(*ia)[3] = r_impulse_a, (*ib)[3] = r_impulse_b;
+  float w1, w2, w3, u1, u2, u3;
+  float v1[3], v2[3], relativeVelocity[3];
+  bool result = false;
+  zero_m3(ia);
+  zero_m3(ib);
+
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return false;
+  }
+
+  /* Compute barycentric coordinates for both collision points. */
+  collision_compute_barycentric(collpair->pa,
+                                cloth->verts[collpair->ap1].tx,
+                                cloth->verts[collpair->ap2].tx,
+                                cloth->verts[collpair->ap3].tx,
+                                &w1,
+                                &w2,
+                                &w3);
+
+  collision_compute_barycentric(collpair->pb,
+                                cloth->verts[collpair->bp1].tx,
+                                cloth->verts[collpair->bp2].tx,
+                                cloth->verts[collpair->bp3].tx,
+                                &u1,
+                                &u2,
+                                &u3);
+
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth->verts[collpair->ap1].tv,
+                                  cloth->verts[collpair->ap2].tv,
+                                  cloth->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
+
+  collision_interpolateOnTriangle(v2,
+                                  cloth->verts[collpair->bp1].tv,
+                                  cloth->verts[collpair->bp2].tv,
+                                  cloth->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
+
+  sub_v3_v3v3(relativeVelocity, v2, v1);
+
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth->verts[collpair->bp1].tv,
-                                    cloth->verts[collpair->bp2].tv,
-                                    cloth->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(ia[0], vrel_t_pre, (double)w1 * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, (double)w2 * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, (double)w3 * impulse);
-
-        VECADDMUL(ib[0], vrel_t_pre, (double)u1 * -impulse);
-        VECADDMUL(ib[1], vrel_t_pre, (double)u2 * -impulse);
-        VECADDMUL(ib[2], vrel_t_pre, (double)u3 * -impulse);
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
+
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
+
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
+
+      impulse = magtangent / 1.5;
+
+      VECADDMUL(ia[0], vrel_t_pre, (double)w1 * impulse);
+      VECADDMUL(ia[1], vrel_t_pre, (double)w2 * impulse);
+      VECADDMUL(ia[2], vrel_t_pre, (double)w3 * impulse);
+
+      VECADDMUL(ib[0], vrel_t_pre, (double)u1 * -impulse);
+      VECADDMUL(ib[1], vrel_t_pre, (double)u2 * -impulse);
+      VECADDMUL(ib[2], vrel_t_pre, (double)u3 * -impulse);
+    }
+
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
+
+    VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
+
+    VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
+
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+      impulse = repulse / 1.5f;
 
       VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
       VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
@@ -929,55 +1016,97 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
       VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
       VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
+    }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+    result = true;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d * 1.0f / time_multiplier;
+    float impulse = repulse / 9.0f;
 
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
+    VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        repulse = max_ff(impulse, repulse);
-        impulse = repulse / 1.5f;
+    VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
 
-        VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
-        VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
-        VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
+    result = true;
+  }
 
-        VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
-        VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
-        VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
-      }
+  return result;
+}
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d * 1.0f / time_multiplier;
-      float impulse = repulse / 9.0f;
+typedef struct SelfCollisionResponseData {
+  const ClothModifierData *clmd;
+  const CollPair *collisions;
+  float min_distance;
+  float time_multiplier;
+  /* Per collision pair: the impulses of both triangles, and whether they are to be applied. */
+  float (*impulses)[2][3][3];
+  bool *use_impulse;
+} SelfCollisionResponseData;
+
+static void cloth_selfcollision_response_static_cb(void *__restrict userdata,
+                                                   const int index,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SelfCollisionResponseData *data = (SelfCollisionResponseData *)userdata;
+  data->use_impulse[index] = cloth_selfcollision_pair_impulse(data->clmd,
+                                                              &data->collisions[index],
+                                                              data->min_distance,
+                                                              data->time_multiplier,
+                                                              data->impulses[index][0],
+                                                              data->impulses[index][1]);
+}
+
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
 
-      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+  /* Same as for object collisions, impulses are computed in parallel and applied in order. */
+  SelfCollisionResponseData data = {
+      .clmd = clmd,
+      .collisions = collpair,
+      .min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f),
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .impulses = MEM_malloc_arrayN(collision_count, sizeof(*data.impulses), __func__),
+      .use_impulse = MEM_malloc_arrayN(collision_count, sizeof(bool), __func__),
+  };
 
-      VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = true;
+  BLI_task_parallel_range(
+      0, collision_count, &data, cloth_selfcollision_response_static_cb, &settings);
 
-      result = 1;
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    if (!data.use_impulse[i]) {
+      continue;
     }
+    const float(*ia)[3] = data.impulses[i][0];
+    const float(*ib)[3] = data.impulses[i][1];
 
-    if (result) {
-      cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
-      cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
+    cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
+    cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
+    cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
 
-      cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
-      cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
-      cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
-    }
+    cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
+    cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
+    cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
+    result = 1;
   }
 
+  MEM_freeN(data.impulses);
+  MEM_freeN(data.use_impulse);
+
   return result;
 }
 
@@ -16,11 +16,14 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_compiler_attrs.h"
 #include "BLI_dynstr.h"
 #include "BLI_hash_mm3.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "RE_pipeline.h"
 
@@ -53,21 +56,46 @@ struct CryptomatteSession {
 #endif
 };
 
+/**
+ * Add all IDs of the list to the layer. The names are hashed in parallel, only adding them to the
+ * layer is done serially.
+ */
+static void cryptomatte_layer_add_IDs(blender::bke::cryptomatte::CryptomatteLayer &layer,
+                                      const ListBase &ids)
+{
+  blender::Vector<const ID *> id_vector;
+  LISTBASE_FOREACH (const ID *, id, &ids) {
+    id_vector.append(id);
+  }
+
+  blender::Array<blender::StringRef> names(id_vector.size());
+  blender::Array<uint32_t> hashes(id_vector.size());
+  blender::threading::parallel_for(id_vector.index_range(), 1024, [&](blender::IndexRange range) {
+    for (const int64_t i : range) {
+      const char *name = &id_vector[i]->name[2];
+      const int name_len = BLI_strnlen(name, MAX_NAME - 2);
+      names[i] = blender::StringRef(name, name_len);
+      hashes[i] = BKE_cryptomatte_hash(name, name_len);
+    }
+  });
+
+  layer.hashes.reserve(layer.hashes.size() + id_vector.size());
+  for (const int64_t i : id_vector.index_range()) {
+    layer.add_hash(names[i], hashes[i]);
+  }
+}
+
 CryptomatteSession::CryptomatteSession(const Main *bmain)
 {
   if (!BLI_listbase_is_empty(&bmain->objects)) {
     blender::bke::cryptomatte::CryptomatteLayer &objects = add_layer(
         RE_PASSNAME_CRYPTOMATTE_OBJECT);
-    LISTBASE_FOREACH (ID *, id, &bmain->objects) {
-      objects.add_ID(*id);
-    }
+    cryptomatte_layer_add_IDs(objects, bmain->objects);
   }
   if (!BLI_listbase_is_empty(&bmain->materials)) {
     blender::bke::cryptomatte::CryptomatteLayer &materials = add_layer(
         RE_PASSNAME_CRYPTOMATTE_MATERIAL);
-    LISTBASE_FOREACH (ID *, id, &bmain->materials) {
-      materials.add_ID(*id);
-    }
+    cryptomatte_layer_add_IDs(materials, bmain->materials);
   }
 }
 
@@ -452,22 +480,36 @@ static bool from_manifest(CryptomatteLayer &layer, blender::StringRefNull manife
 
 static std::string to_manifest(const CryptomatteLayer *layer)
 {
-  std::stringstream manifest;
+  /* The manifest can contain hundreds of thousands of entries, so it is written directly into a
+   * string instead of using a string stream. Names are quoted the same way as `std::quoted`. */
+  std::string manifest;
+  manifest.reserve(layer->hashes.size() * 32 + 2);
 
   bool is_first = true;
   const blender::Map<std::string, CryptomatteHash> &const_map = layer->hashes;
-  manifest << "{";
+  manifest += '{';
   for (blender::Map<std::string, CryptomatteHash>::Item item : const_map.items()) {
     if (is_first) {
       is_first = false;
     }
     else {
-      manifest << ",";
+      manifest += ',';
+    }
+    manifest += '\"';
+    for (const char c : item.key) {
+      if (ELEM(c, '\"', '\\')) {
+        manifest += '\\';
+      }
+      manifest += c;
     }
-    manifest << quoted(item.key) << ":\"" << item.value.hex_encoded() << "\"";
+    char hex_encoded[sizeof(uint32_t) * 2 + 1];
+    BLI_snprintf(hex_encoded, sizeof(hex_encoded), "%08x", item.value.hash);
+    manifest += "\":\"";
+    manifest += hex_encoded;
+    manifest += '\"';
   }
-  manifest << "}";
-  return manifest.str();
+  manifest += '}';
+  return manifest;
 }
 
 }  // namespace manifest
@@ -540,7 +582,8 @@ uint32_t CryptomatteLayer::add_ID(const ID &id)
 
 void CryptomatteLayer::add_hash(blender::StringRef name, CryptomatteHash cryptomatte_hash)
 {
-  hashes.add_overwrite(name, cryptomatte_hash);
+  /* Only construct the key when the name wasn't added before. */
+  hashes.add_overwrite_as(name, cryptomatte_hash);
 }
 
 std::optional<std::string> CryptomatteLayer::operator[](float encoded_hash) const
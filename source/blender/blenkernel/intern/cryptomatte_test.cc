@@ -51,6 +51,22 @@ TEST(cryptomatte, layer_quoted)
   ASSERT_EQ("{\"\\\"Object\\\"\":\"0000007b\"}", layer.manifest());
 }
 
+TEST(cryptomatte, layer_quoted_backslash)
+{
+  blender::bke::cryptomatte::CryptomatteLayer layer;
+  layer.add_hash("Obj\\ect", 123);
+  ASSERT_EQ("{\"Obj\\\\ect\":\"0000007b\"}", layer.manifest());
+}
+
+TEST(cryptomatte, layer_add_hash_overwrite)
+{
+  blender::bke::cryptomatte::CryptomatteLayer layer;
+  layer.add_hash("Object", 123);
+  layer.add_hash("Object", 456);
+  ASSERT_EQ(1, layer.hashes.size());
+  ASSERT_EQ("{\"Object\":\"000001c8\"}", layer.manifest());
+}
+
 static void test_cryptomatte_manifest(std::string expected, std::string manifest)
 {
   EXPECT_EQ(expected,
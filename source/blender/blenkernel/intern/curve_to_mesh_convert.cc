@@ -1,7 +1,10 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <mutex>
+
 #include "BLI_array.hh"
 #include "BLI_devirtualize_parameters.hh"
+#include "BLI_hash_mm2a.h"
 #include "BLI_set.hh"
 #include "BLI_task.hh"
 
@@ -9,7 +12,9 @@
 #include "DNA_meshdata_types.h"
 
 #include "BKE_attribute_math.hh"
+#include "BKE_curves.h"
 #include "BKE_curves.hh"
+#include "BKE_customdata.h"
 #include "BKE_geometry_set.hh"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -194,31 +199,45 @@ static void fill_mesh_positions(const int main_point_num,
                                 MutableSpan<MVert> mesh_positions)
 {
   if (profile_point_num == 1) {
-    for (const int i_ring : IndexRange(main_point_num)) {
-      float4x4 point_matrix = float4x4::from_normalized_axis_data(
-          main_positions[i_ring], normals[i_ring], tangents[i_ring]);
-      if (!radii.is_empty()) {
-        point_matrix.apply_scale(radii[i_ring]);
+    const float3 profile_position = profile_positions.first();
+    threading::parallel_for(IndexRange(main_point_num), 4096, [&](const IndexRange range) {
+      if (profile_position == float3(0)) {
+        /* The transform has no effect when creating a wire mesh, skip building the matrices. */
+        for (const int i_ring : range) {
+          copy_v3_v3(mesh_positions[i_ring].co, main_positions[i_ring]);
+        }
+        return;
       }
-
-      MVert &vert = mesh_positions[i_ring];
-      copy_v3_v3(vert.co, point_matrix * profile_positions.first());
-    }
+      for (const int i_ring : range) {
+        float4x4 point_matrix = float4x4::from_normalized_axis_data(
+            main_positions[i_ring], normals[i_ring], tangents[i_ring]);
+        if (!radii.is_empty()) {
+          point_matrix.apply_scale(radii[i_ring]);
+        }
+
+        MVert &vert = mesh_positions[i_ring];
+        copy_v3_v3(vert.co, point_matrix * profile_position);
+      }
+    });
   }
   else {
-    for (const int i_ring : IndexRange(main_point_num)) {
-      float4x4 point_matrix = float4x4::from_normalized_axis_data(
-          main_positions[i_ring], normals[i_ring], tangents[i_ring]);
-      if (!radii.is_empty()) {
-        point_matrix.apply_scale(radii[i_ring]);
+    /* Also split up single long curves, e.g. for wires and cables. */
+    const int64_t grain_size = std::max(1, 4096 / profile_point_num);
+    threading::parallel_for(IndexRange(main_point_num), grain_size, [&](const IndexRange range) {
+      for (const int i_ring : range) {
+        float4x4 point_matrix = float4x4::from_normalized_axis_data(
+            main_positions[i_ring], normals[i_ring], tangents[i_ring]);
+        if (!radii.is_empty()) {
+          point_matrix.apply_scale(radii[i_ring]);
+        }
+
+        const int ring_vert_start = i_ring * profile_point_num;
+        for (const int i_profile : IndexRange(profile_point_num)) {
+          MVert &vert = mesh_positions[ring_vert_start + i_profile];
+          copy_v3_v3(vert.co, point_matrix * profile_positions[i_profile]);
+        }
       }
-
-      const int ring_vert_start = i_ring * profile_point_num;
-      for (const int i_profile : IndexRange(profile_point_num)) {
-        MVert &vert = mesh_positions[ring_vert_start + i_profile];
-        copy_v3_v3(vert.co, point_matrix * profile_positions[i_profile]);
-      }
-    }
+    });
   }
 }
 
@@ -314,6 +333,201 @@ static ResultOffsets calculate_result_offsets(const CurvesInfo &info, const bool
   return result;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Topology Cache
+ *
+ * Geometry nodes create new curves for every evaluation, but the topology of the result often
+ * stays the same for animated curves. The most recently created topologies are kept in a global
+ * cache, and their edge, face and corner layers are shared with new meshes (see #CD_SHARE), so
+ * that only positions and attributes have to be computed again. The cache is limited in the
+ * number of entries and in memory, and cleared when a file is loaded.
+ * \{ */
+
+/**
+ * Everything that the topology of the result depends on: the number of evaluated points and the
+ * cyclic state of all curves, and the sharp control points of Bezier profiles.
+ */
+struct SweepTopologyKey {
+  Array<int> main_offsets;
+  Array<bool> main_cyclic;
+  Array<int> profile_offsets;
+  Array<bool> profile_cyclic;
+  /** Evaluated profile points whose edges along the main curve are marked sharp. */
+  Vector<int> profile_sharp_points;
+  bool fill_caps;
+  uint64_t hash;
+
+  int64_t memory() const
+  {
+    return main_offsets.as_span().size_in_bytes() + main_cyclic.as_span().size_in_bytes() +
+           profile_offsets.as_span().size_in_bytes() + profile_cyclic.as_span().size_in_bytes() +
+           profile_sharp_points.as_span().size_in_bytes();
+  }
+
+  friend bool operator==(const SweepTopologyKey &a, const SweepTopologyKey &b)
+  {
+    return a.hash == b.hash && a.fill_caps == b.fill_caps &&
+           a.main_offsets.as_span() == b.main_offsets.as_span() &&
+           a.main_cyclic.as_span() == b.main_cyclic.as_span() &&
+           a.profile_offsets.as_span() == b.profile_offsets.as_span() &&
+           a.profile_cyclic.as_span() == b.profile_cyclic.as_span() &&
+           a.profile_sharp_points.as_span() == b.profile_sharp_points.as_span();
+  }
+};
+
+template<typename T> static uint32_t hash_span(const Span<T> span)
+{
+  return BLI_hash_mm2(reinterpret_cast<const uchar *>(span.data()), span.size_in_bytes(), 0);
+}
+
+static Vector<int> get_profile_sharp_points(const CurvesGeometry &profile)
+{
+  Vector<int> sharp_points;
+  if (profile.curve_type_counts()[CURVE_TYPE_BEZIER] == 0) {
+    return sharp_points;
+  }
+  const VArray<int8_t> curve_types = profile.curve_types();
+  const VArraySpan<int8_t> handle_types_left{profile.handle_types_left()};
+  const VArraySpan<int8_t> handle_types_right{profile.handle_types_right()};
+  for (const int i_curve : profile.curves_range()) {
+    if (curve_types[i_curve] != CURVE_TYPE_BEZIER) {
+      continue;
+    }
+    const IndexRange points = profile.points_for_curve(i_curve);
+    const int evaluated_start = profile.evaluated_points_for_curve(i_curve).start();
+    const Span<int> offsets = profile.bezier_evaluated_offsets_for_curve(i_curve);
+    for (const int i : IndexRange(points.size())) {
+      if (curves::bezier::point_is_sharp(
+              handle_types_left.slice(points), handle_types_right.slice(points), i)) {
+        sharp_points.append(evaluated_start + (i == 0 ? 0 : offsets[i - 1]));
+      }
+    }
+  }
+  return sharp_points;
+}
+
+static SweepTopologyKey create_topology_key(const CurvesInfo &info, const bool fill_caps)
+{
+  info.main.ensure_evaluated_offsets();
+  info.profile.ensure_evaluated_offsets();
+
+  SweepTopologyKey key;
+  key.main_offsets = Array<int>(info.main.evaluated_offsets());
+  key.main_cyclic = Array<bool>(Span<bool>(info.main_cyclic));
+  key.profile_offsets = Array<int>(info.profile.evaluated_offsets());
+  key.profile_cyclic = Array<bool>(Span<bool>(info.profile_cyclic));
+  key.profile_sharp_points = get_profile_sharp_points(info.profile);
+  key.fill_caps = fill_caps;
+  key.hash = get_default_hash_3(get_default_hash_4(hash_span(key.main_offsets.as_span()),
+                                                   hash_span(key.main_cyclic.as_span()),
+                                                   hash_span(key.profile_offsets.as_span()),
+                                                   hash_span(key.profile_cyclic.as_span())),
+                                hash_span(key.profile_sharp_points.as_span()),
+                                fill_caps);
+  return key;
+}
+
+/** The offsets and the edge, face and corner data of a result mesh. */
+struct SweepTopology : NonCopyable, NonMovable {
+  ResultOffsets offsets;
+
+  int edges_num = 0;
+  int polys_num = 0;
+  int loops_num = 0;
+  CustomData edata;
+  CustomData pdata;
+  CustomData ldata;
+
+  /** Approximate memory used by the topology and its key. */
+  int64_t memory = 0;
+
+  SweepTopology()
+  {
+    CustomData_reset(&edata);
+    CustomData_reset(&pdata);
+    CustomData_reset(&ldata);
+  }
+
+  ~SweepTopology()
+  {
+    CustomData_free(&edata, edges_num);
+    CustomData_free(&pdata, polys_num);
+    CustomData_free(&ldata, loops_num);
+  }
+};
+
+static int64_t custom_data_memory(const CustomData &data, const int num)
+{
+  int64_t memory = 0;
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    memory += int64_t(CustomData_sizeof(layer.type)) * num;
+  }
+  return memory;
+}
+
+static void share_layers(const CustomData &src, const int src_num, CustomData &dst, int &dst_num)
+{
+  CustomData_free(&dst, dst_num);
+  CustomData_copy(&src, &dst, CD_MASK_ALL, CD_SHARE, src_num);
+  dst_num = src_num;
+}
+
+class SweepTopologyCache {
+ private:
+  static constexpr int max_entries_num = 8;
+  static constexpr int64_t max_memory = 256 * 1024 * 1024;
+
+  std::mutex mutex_;
+  /** Ordered from least to most recently used. */
+  Vector<std::pair<SweepTopologyKey, std::shared_ptr<const SweepTopology>>> entries_;
+  int64_t memory_ = 0;
+
+ public:
+  std::shared_ptr<const SweepTopology> lookup(const SweepTopologyKey &key)
+  {
+    std::lock_guard lock{mutex_};
+    for (const int i : entries_.index_range()) {
+      if (entries_[i].first == key) {
+        auto entry = std::move(entries_[i]);
+        entries_.remove(i);
+        entries_.append(std::move(entry));
+        return entries_.last().second;
+      }
+    }
+    return {};
+  }
+
+  void add(SweepTopologyKey key, std::shared_ptr<const SweepTopology> topology)
+  {
+    if (topology->memory > max_memory) {
+      return;
+    }
+    std::lock_guard lock{mutex_};
+    while (entries_.size() == max_entries_num ||
+           (!entries_.is_empty() && memory_ + topology->memory > max_memory)) {
+      memory_ -= entries_.first().second->memory;
+      entries_.remove(0);
+    }
+    memory_ += topology->memory;
+    entries_.append({std::move(key), std::move(topology)});
+  }
+
+  void clear()
+  {
+    std::lock_guard lock{mutex_};
+    entries_.clear();
+    memory_ = 0;
+  }
+};
+
+static SweepTopologyCache &get_topology_cache()
+{
+  static SweepTopologyCache cache;
+  return cache;
+}
+
+/** \} */
+
 static eAttrDomain get_attribute_domain_for_mesh(const AttributeAccessor &mesh_attributes,
                                                  const AttributeIDRef &attribute_id)
 {
@@ -625,25 +839,14 @@ static void copy_curve_domain_attribute_to_mesh(const ResultOffsets &mesh_offset
   });
 }
 
-Mesh *curve_to_mesh_sweep(const CurvesGeometry &main,
-                          const CurvesGeometry &profile,
-                          const bool fill_caps)
+static void fill_mesh_topology(const CurvesInfo &curves_info,
+                               const ResultOffsets &offsets,
+                               const bool fill_caps,
+                               Mesh &mesh)
 {
-  const CurvesInfo curves_info = get_curves_info(main, profile);
-
-  const ResultOffsets offsets = calculate_result_offsets(curves_info, fill_caps);
-  if (offsets.vert.last() == 0) {
-    return nullptr;
-  }
-
-  Mesh *mesh = BKE_mesh_new_nomain(
-      offsets.vert.last(), offsets.edge.last(), 0, offsets.loop.last(), offsets.poly.last());
-  mesh->flag |= ME_AUTOSMOOTH;
-  mesh->smoothresh = DEG2RADF(180.0f);
-  MutableSpan<MVert> verts = mesh->verts_for_write();
-  MutableSpan<MEdge> edges = mesh->edges_for_write();
-  MutableSpan<MPoly> polys = mesh->polys_for_write();
-  MutableSpan<MLoop> loops = mesh->loops_for_write();
+  MutableSpan<MEdge> edges = mesh.edges_for_write();
+  MutableSpan<MPoly> polys = mesh.polys_for_write();
+  MutableSpan<MLoop> loops = mesh.loops_for_write();
 
   foreach_curve_combination(curves_info, offsets, [&](const CombinationInfo &info) {
     fill_mesh_topology(info.vert_range.start(),
@@ -660,11 +863,94 @@ Mesh *curve_to_mesh_sweep(const CurvesGeometry &main,
                        polys);
   });
 
+  const CurvesGeometry &profile = curves_info.profile;
+  if (profile.curve_type_counts()[CURVE_TYPE_BEZIER] > 0) {
+    const VArray<int8_t> curve_types = profile.curve_types();
+    const VArraySpan<int8_t> handle_types_left{profile.handle_types_left()};
+    const VArraySpan<int8_t> handle_types_right{profile.handle_types_right()};
+
+    foreach_curve_combination(curves_info, offsets, [&](const CombinationInfo &info) {
+      if (curve_types[info.i_profile] == CURVE_TYPE_BEZIER) {
+        const IndexRange points = profile.points_for_curve(info.i_profile);
+        mark_bezier_vector_edges_sharp(points.size(),
+                                       info.main_segment_num,
+                                       profile.bezier_evaluated_offsets_for_curve(info.i_profile),
+                                       handle_types_left.slice(points),
+                                       handle_types_right.slice(points),
+                                       edges.slice(info.edge_range));
+      }
+    });
+  }
+}
+
+Mesh *curve_to_mesh_sweep(const CurvesGeometry &main,
+                          const CurvesGeometry &profile,
+                          const bool fill_caps)
+{
+  const CurvesInfo curves_info = get_curves_info(main, profile);
+
+  /* Caching very small meshes isn't worth building the key and the lookup. Every combination of
+   * main and profile curves has its evaluated points multiplied, and more edges and corners. */
+  const bool use_cache = int64_t(main.evaluated_points_num()) * profile.evaluated_points_num() >=
+                         256;
+
+  SweepTopologyCache &cache = get_topology_cache();
+  SweepTopologyKey key;
+  std::shared_ptr<const SweepTopology> cached_topology;
+  if (use_cache) {
+    key = create_topology_key(curves_info, fill_caps);
+    cached_topology = cache.lookup(key);
+  }
+
+  std::shared_ptr<SweepTopology> new_topology;
+  if (!cached_topology) {
+    new_topology = std::make_shared<SweepTopology>();
+    new_topology->offsets = calculate_result_offsets(curves_info, fill_caps);
+  }
+  const ResultOffsets &offsets = cached_topology ? cached_topology->offsets :
+                                                   new_topology->offsets;
+  if (offsets.vert.last() == 0) {
+    return nullptr;
+  }
+
+  Mesh *mesh;
+  if (cached_topology) {
+    mesh = BKE_mesh_new_nomain(offsets.vert.last(), 0, 0, 0, 0);
+    share_layers(cached_topology->edata, cached_topology->edges_num, mesh->edata, mesh->totedge);
+    share_layers(cached_topology->pdata, cached_topology->polys_num, mesh->pdata, mesh->totpoly);
+    share_layers(cached_topology->ldata, cached_topology->loops_num, mesh->ldata, mesh->totloop);
+  }
+  else {
+    mesh = BKE_mesh_new_nomain(
+        offsets.vert.last(), offsets.edge.last(), 0, offsets.loop.last(), offsets.poly.last());
+    fill_mesh_topology(curves_info, offsets, fill_caps, *mesh);
+
+    if (use_cache) {
+      share_layers(mesh->edata, mesh->totedge, new_topology->edata, new_topology->edges_num);
+      share_layers(mesh->pdata, mesh->totpoly, new_topology->pdata, new_topology->polys_num);
+      share_layers(mesh->ldata, mesh->totloop, new_topology->ldata, new_topology->loops_num);
+      new_topology->memory = custom_data_memory(new_topology->edata, new_topology->edges_num) +
+                             custom_data_memory(new_topology->pdata, new_topology->polys_num) +
+                             custom_data_memory(new_topology->ldata, new_topology->loops_num) +
+                             key.memory();
+      /* Keep a reference, the offsets are still used below. */
+      cache.add(std::move(key), new_topology);
+    }
+  }
+  mesh->flag |= ME_AUTOSMOOTH;
+  mesh->smoothresh = DEG2RADF(180.0f);
+  MutableSpan<MVert> verts = mesh->verts_for_write();
+
   const Span<float3> main_positions = main.evaluated_positions();
-  const Span<float3> tangents = main.evaluated_tangents();
-  const Span<float3> normals = main.evaluated_normals();
   const Span<float3> profile_positions = profile.evaluated_positions();
 
+  /* The transform isn't used for a single profile point at the origin, e.g. for curve to wire
+   * conversion, so the tangents and normals don't have to be calculated. */
+  const bool use_transform = profile_positions.size() != 1 ||
+                             profile_positions.first() != float3(0);
+  const Span<float3> tangents = use_transform ? main.evaluated_tangents() : Span<float3>();
+  const Span<float3> normals = use_transform ? main.evaluated_normals() : Span<float3>();
+
   Vector<std::byte> eval_buffer;
 
   const AttributeAccessor main_attributes = main.attributes();
@@ -685,30 +971,12 @@ Mesh *curve_to_mesh_sweep(const CurvesGeometry &main,
                         info.profile_points.size(),
                         main_positions.slice(info.main_points),
                         profile_positions.slice(info.profile_points),
-                        tangents.slice(info.main_points),
-                        normals.slice(info.main_points),
+                        tangents.is_empty() ? tangents : tangents.slice(info.main_points),
+                        normals.is_empty() ? normals : normals.slice(info.main_points),
                         radii.is_empty() ? radii : radii.slice(info.main_points),
                         verts.slice(info.vert_range));
   });
 
-  if (profile.curve_type_counts()[CURVE_TYPE_BEZIER] > 0) {
-    const VArray<int8_t> curve_types = profile.curve_types();
-    const VArraySpan<int8_t> handle_types_left{profile.handle_types_left()};
-    const VArraySpan<int8_t> handle_types_right{profile.handle_types_right()};
-
-    foreach_curve_combination(curves_info, offsets, [&](const CombinationInfo &info) {
-      if (curve_types[info.i_profile] == CURVE_TYPE_BEZIER) {
-        const IndexRange points = profile.points_for_curve(info.i_profile);
-        mark_bezier_vector_edges_sharp(points.size(),
-                                       info.main_segment_num,
-                                       profile.bezier_evaluated_offsets_for_curve(info.i_profile),
-                                       handle_types_left.slice(points),
-                                       handle_types_right.slice(points),
-                                       edges.slice(info.edge_range));
-      }
-    });
-  }
-
   Set<AttributeIDRef> main_attributes_set;
 
   MutableAttributeAccessor mesh_attributes = mesh->attributes_for_write();
@@ -802,3 +1070,8 @@ Mesh *curve_to_wire_mesh(const CurvesGeometry &curve)
 }
 
 }  // namespace blender::bke
+
+void BKE_curves_to_mesh_cache_free()
+{
+  blender::bke::get_topology_cache().clear();
+}
@@ -10,6 +10,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_bounds.hh"
+#include "BLI_devirtualize_parameters.hh"
 #include "BLI_index_mask_ops.hh"
 #include "BLI_length_parameterize.hh"
 #include "BLI_math_rotation.hh"
@@ -74,6 +75,27 @@ CurvesGeometry::CurvesGeometry(const int point_num, const int curve_num)
   this->runtime->type_counts[CURVE_TYPE_CATMULL_ROM] = curve_num;
 }
 
+/**
+ * The evaluated offsets and the NURBS basis only depend on the topology of the curves and are
+ * immutable once computed, so they don't have to be computed again for the copy.
+ */
+static void share_topology_caches(const CurvesGeometryRuntime &src, CurvesGeometryRuntime &dst)
+{
+  if (!src.offsets_cache_dirty) {
+    std::scoped_lock lock{src.offsets_cache_mutex};
+    dst.evaluated_offsets_data = src.evaluated_offsets_data;
+    dst.evaluated_offsets_cache = src.evaluated_offsets_cache;
+    dst.bezier_evaluated_offsets = src.bezier_evaluated_offsets;
+    dst.offsets_cache_dirty = false;
+  }
+  if (!src.nurbs_basis_cache_dirty) {
+    std::scoped_lock lock{src.nurbs_basis_cache_mutex};
+    dst.nurbs_basis_data = src.nurbs_basis_data;
+    dst.nurbs_basis_cache = src.nurbs_basis_cache;
+    dst.nurbs_basis_cache_dirty = false;
+  }
+}
+
 /**
  * \note Expects `dst` to be initialized, since the original attributes must be freed.
  */
@@ -83,8 +105,9 @@ static void copy_curves_geometry(CurvesGeometry &dst, const CurvesGeometry &src)
   CustomData_free(&dst.curve_data, dst.curve_num);
   dst.point_num = src.point_num;
   dst.curve_num = src.curve_num;
-  CustomData_copy(&src.point_data, &dst.point_data, CD_MASK_ALL, CD_DUPLICATE, dst.point_num);
-  CustomData_copy(&src.curve_data, &dst.curve_data, CD_MASK_ALL, CD_DUPLICATE, dst.curve_num);
+  /* The attribute arrays are only copied once either of the geometries modifies them. */
+  CustomData_copy(&src.point_data, &dst.point_data, CD_MASK_ALL, CD_SHARE, dst.point_num);
+  CustomData_copy(&src.curve_data, &dst.curve_data, CD_MASK_ALL, CD_SHARE, dst.curve_num);
 
   MEM_SAFE_FREE(dst.curve_offsets);
   dst.curve_offsets = (int *)MEM_malloc_arrayN(dst.point_num + 1, sizeof(int), __func__);
@@ -94,6 +117,8 @@ static void copy_curves_geometry(CurvesGeometry &dst, const CurvesGeometry &src)
 
   /* Though type counts are a cache, they must be copied because they are calculated eagerly. */
   dst.runtime->type_counts = src.runtime->type_counts;
+
+  share_topology_caches(*src.runtime, *dst.runtime);
 }
 
 CurvesGeometry::CurvesGeometry(const CurvesGeometry &other)
@@ -199,7 +224,7 @@ static Span<T> get_span_attribute(const CurvesGeometry &curves,
   const CustomData &custom_data = domain_custom_data(curves, domain);
   const eCustomDataType type = cpp_type_to_custom_data_type(CPPType::get<T>());
 
-  T *data = (T *)CustomData_get_layer_named(&custom_data, type, name.c_str());
+  const T *data = (const T *)CustomData_get_layer_named(&custom_data, type, name.c_str());
   if (data == nullptr) {
     return {};
   }
@@ -520,20 +545,21 @@ void CurvesGeometry::ensure_evaluated_offsets() const
     return;
   }
 
+  /* The previous data may be shared with other geometries, so it is never modified. */
+  auto data = std::make_shared<CurvesGeometryRuntime::EvaluatedOffsets>();
   threading::isolate_task([&]() {
-    this->runtime->evaluated_offsets_cache.resize(this->curves_num() + 1);
+    data->evaluated_offsets.resize(this->curves_num() + 1);
 
     if (this->has_curve_with_type(CURVE_TYPE_BEZIER)) {
-      this->runtime->bezier_evaluated_offsets.resize(this->points_num());
-    }
-    else {
-      this->runtime->bezier_evaluated_offsets.clear_and_make_inline();
+      data->bezier_evaluated_offsets.resize(this->points_num());
     }
 
-    calculate_evaluated_offsets(
-        *this, this->runtime->evaluated_offsets_cache, this->runtime->bezier_evaluated_offsets);
+    calculate_evaluated_offsets(*this, data->evaluated_offsets, data->bezier_evaluated_offsets);
   });
 
+  this->runtime->evaluated_offsets_cache = data->evaluated_offsets;
+  this->runtime->bezier_evaluated_offsets = data->bezier_evaluated_offsets;
+  this->runtime->evaluated_offsets_data = std::move(data);
   this->runtime->offsets_cache_dirty = false;
 }
 
@@ -578,6 +604,8 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
     return;
   }
 
+  /* The previous data may be shared with other geometries, so it is never modified. */
+  auto data = std::make_shared<Array<curves::nurbs::BasisCache>>();
   threading::isolate_task([&]() {
     Vector<int64_t> nurbs_indices;
     const IndexMask nurbs_mask = this->indices_for_curve_type(CURVE_TYPE_NURBS, nurbs_indices);
@@ -585,8 +613,8 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
       return;
     }
 
-    this->runtime->nurbs_basis_cache.resize(this->curves_num());
-    MutableSpan<curves::nurbs::BasisCache> basis_caches(this->runtime->nurbs_basis_cache);
+    data->reinitialize(this->curves_num());
+    MutableSpan<curves::nurbs::BasisCache> basis_caches = *data;
 
     VArray<bool> cyclic = this->cyclic();
     VArray<int8_t> orders = this->nurbs_orders();
@@ -619,6 +647,8 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
     });
   });
 
+  this->runtime->nurbs_basis_cache = *data;
+  this->runtime->nurbs_basis_data = std::move(data);
   this->runtime->nurbs_basis_cache_dirty = false;
 }
 
@@ -865,7 +895,7 @@ void CurvesGeometry::interpolate_to_evaluated(const int curve_index,
       return;
     case CURVE_TYPE_BEZIER:
       curves::bezier::interpolate_to_evaluated(
-          src, this->runtime->bezier_evaluated_offsets.as_span().slice(points), dst);
+          src, this->runtime->bezier_evaluated_offsets.slice(points), dst);
       return;
     case CURVE_TYPE_NURBS:
       curves::nurbs::interpolate_to_evaluated(this->runtime->nurbs_basis_cache[curve_index],
@@ -905,7 +935,7 @@ void CurvesGeometry::interpolate_to_evaluated(const GSpan src, GMutableSpan dst)
         case CURVE_TYPE_BEZIER:
           curves::bezier::interpolate_to_evaluated(
               src.slice(points),
-              this->runtime->bezier_evaluated_offsets.as_span().slice(points),
+              this->runtime->bezier_evaluated_offsets.slice(points),
               dst.slice(evaluated_points));
           continue;
         case CURVE_TYPE_NURBS:
@@ -1476,13 +1506,15 @@ static void adapt_curve_domain_point_to_curve_impl(const CurvesGeometry &curves,
 {
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  threading::parallel_for(curves.curves_range(), 128, [&](const IndexRange range) {
-    for (const int i_curve : range) {
-      for (const int i_point : curves.points_for_curve(i_curve)) {
-        mixer.mix_in(i_curve, old_values[i_point]);
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    threading::parallel_for(curves.curves_range(), 128, [&](const IndexRange range) {
+      for (const int i_curve : range) {
+        for (const int i_point : curves.points_for_curve(i_curve)) {
+          mixer.mix_in(i_curve, old_values[i_point]);
+        }
       }
-    }
-    mixer.finalize(range);
+      mixer.finalize(range);
+    });
   });
 }
 
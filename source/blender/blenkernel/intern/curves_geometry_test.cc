@@ -63,6 +63,29 @@ TEST(curves_geometry, Move)
   EXPECT_EQ(second_other.offsets().data(), offsets_data);
 }
 
+TEST(curves_geometry, CopySharesEvaluatedOffsets)
+{
+  CurvesGeometry curves = create_basic_curves(100, 10);
+  curves.fill_curve_types(CURVE_TYPE_CATMULL_ROM);
+  curves.resolution_for_write().fill(4);
+  const Span<int> evaluated_offsets = curves.evaluated_offsets();
+
+  CurvesGeometry copy = curves;
+  EXPECT_EQ(copy.evaluated_offsets().data(), evaluated_offsets.data());
+
+  /* Changing positions doesn't affect the evaluated offsets. */
+  copy.positions_for_write().first() = float3(1.0f, 2.0f, 3.0f);
+  copy.tag_positions_changed();
+  EXPECT_EQ(copy.evaluated_offsets().data(), evaluated_offsets.data());
+
+  /* Changing the topology of the copy must not change the original's offsets. */
+  copy.resolution_for_write().fill(2);
+  copy.tag_topology_changed();
+  EXPECT_NE(copy.evaluated_offsets().data(), evaluated_offsets.data());
+  EXPECT_EQ(copy.evaluated_points_num(), 190);
+  EXPECT_EQ(curves.evaluated_points_num(), 370);
+}
+
 TEST(curves_geometry, TypeCount)
 {
   CurvesGeometry curves = create_basic_curves(100, 10);
@@ -55,6 +55,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 /* only for customdata_data_transfer_interp_normal_normals */
 #include "data_transfer_intern.h"
 
@@ -2275,6 +2277,84 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+/* -------------------------------------------------------------------- */
+/** \name Shared Layer Data
+ *
+ * Layers which own their data array also own a #CustomDataSharingInfo, which counts the layers
+ * using the array. Copies made with #CD_SHARE add a user to it instead of copying the array, the
+ * source layer itself is not modified. The last user frees the data. A layer with more than one
+ * user is read-only, requesting write access makes a private copy of the data first.
+ * \{ */
+
+struct CustomDataSharingInfo {
+  int users;
+};
+
+static CustomDataSharingInfo *customdata_sharing_info_new()
+{
+  CustomDataSharingInfo *sharing_info = MEM_cnew<CustomDataSharingInfo>(__func__);
+  sharing_info->users = 1;
+  return sharing_info;
+}
+
+static bool customdata_layer_is_shared(const CustomDataLayer *layer)
+{
+  return layer->sharing_info != nullptr && atomic_load_int32(&layer->sharing_info->users) > 1;
+}
+
+/** Whether the data array can be modified without affecting any other layer. */
+static bool customdata_layer_is_mutable(const CustomDataLayer *layer)
+{
+  return !(layer->flag & CD_FLAG_NOFREE) && !customdata_layer_is_shared(layer);
+}
+
+static bool customdata_layer_can_share(const CustomDataLayer *layer)
+{
+  /* Externally stored layers are freed and read back in place. */
+  return layer->data != nullptr && layer->sharing_info != nullptr &&
+         !(layer->flag & CD_FLAG_EXTERNAL);
+}
+
+/**
+ * Add a user to the shared data of the layer. Only the separately allocated sharing info is
+ * modified, so the same source can be copied from multiple threads.
+ */
+static CustomDataSharingInfo *customdata_layer_sharing_add_user(const CustomDataLayer *layer)
+{
+  BLI_assert(customdata_layer_can_share(layer));
+  atomic_add_and_fetch_int32(&layer->sharing_info->users, 1);
+  return layer->sharing_info;
+}
+
+/**
+ * Remove the user of the layer from its shared data.
+ * \return True when it was the last user, the caller has to free the data then.
+ */
+static bool customdata_layer_sharing_remove_user(CustomDataLayer *layer)
+{
+  CustomDataSharingInfo *sharing_info = layer->sharing_info;
+  layer->sharing_info = nullptr;
+  if (atomic_sub_and_fetch_int32(&sharing_info->users, 1) != 0) {
+    return false;
+  }
+  MEM_freeN(sharing_info);
+  return true;
+}
+
+static void customdata_layer_free_data(const int type, void *data, const int totelem)
+{
+  if (data == nullptr) {
+    return;
+  }
+  const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+  if (typeInfo->free) {
+    typeInfo->free(data, totelem, typeInfo->size);
+  }
+  MEM_freeN(data);
+}
+
+/** \} */
+
 bool CustomData_merge(const CustomData *source,
                       CustomData *dest,
                       eCustomDataMask mask,
@@ -2320,11 +2400,18 @@ bool CustomData_merge(const CustomData *source,
       continue;
     }
 
+    /* Layers which can not be shared are copied instead. */
+    const eCDAllocType layer_alloctype = (alloctype == CD_SHARE &&
+                                          !customdata_layer_can_share(layer)) ?
+                                             CD_DUPLICATE :
+                                             alloctype;
+
     void *data;
-    switch (alloctype) {
+    switch (layer_alloctype) {
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -2332,12 +2419,13 @@ bool CustomData_merge(const CustomData *source,
         break;
     }
 
-    if ((alloctype == CD_ASSIGN) && (flag & CD_FLAG_NOFREE)) {
+    if ((layer_alloctype == CD_ASSIGN) && (flag & CD_FLAG_NOFREE)) {
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
     else {
-      newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
+      newlayer = customData_add_layer__internal(
+          dest, type, layer_alloctype, data, totelem, layer->name);
     }
 
     if (newlayer) {
@@ -2360,6 +2448,17 @@ bool CustomData_merge(const CustomData *source,
           BKE_anonymous_attribute_id_increment_weak(layer->anonymous_id);
         }
       }
+      if (newlayer->data == data) {
+        if (layer_alloctype == CD_SHARE && newlayer->sharing_info == nullptr) {
+          newlayer->sharing_info = customdata_layer_sharing_add_user(layer);
+        }
+        else if (layer_alloctype == CD_ASSIGN && layer->sharing_info != nullptr) {
+          /* Move the user of the data to the new layer, other layers may still share it. */
+          MEM_SAFE_FREE(newlayer->sharing_info);
+          newlayer->sharing_info = layer->sharing_info;
+          layer->sharing_info = nullptr;
+        }
+      }
       if (alloctype == CD_ASSIGN) {
         layer->data = nullptr;
       }
@@ -2423,8 +2522,8 @@ void CustomData_realloc(CustomData *data, const int old_size, const int new_size
 
     const int64_t old_size_in_bytes = int64_t(old_size) * typeInfo->size;
     const int64_t new_size_in_bytes = int64_t(new_size) * typeInfo->size;
-    if (layer->flag & CD_FLAG_NOFREE) {
-      const void *old_data = layer->data;
+    if (!customdata_layer_is_mutable(layer)) {
+      void *old_data = layer->data;
       layer->data = MEM_malloc_arrayN(new_size, typeInfo->size, __func__);
       if (typeInfo->copy) {
         typeInfo->copy(old_data, layer->data, std::min(old_size, new_size));
@@ -2432,10 +2531,18 @@ void CustomData_realloc(CustomData *data, const int old_size, const int new_size
       else {
         std::memcpy(layer->data, old_data, std::min(old_size_in_bytes, new_size_in_bytes));
       }
+      if (layer->sharing_info != nullptr && customdata_layer_sharing_remove_user(layer)) {
+        /* The other users have been freed in the meantime. */
+        customdata_layer_free_data(layer->type, old_data, old_size);
+      }
+      layer->sharing_info = customdata_sharing_info_new();
       layer->flag &= ~CD_FLAG_NOFREE;
     }
     else {
       layer->data = MEM_reallocN(layer->data, new_size_in_bytes);
+      if (layer->sharing_info == nullptr && layer->data != nullptr) {
+        layer->sharing_info = customdata_sharing_info_new();
+      }
     }
 
     if (new_size > old_size) {
@@ -2476,22 +2583,16 @@ void CustomData_copy_mesh_to_bmesh(const CustomData *source,
 
 static void customData_free_layer__internal(CustomDataLayer *layer, const int totelem)
 {
-  const LayerTypeInfo *typeInfo;
-
   if (layer->anonymous_id != nullptr) {
     BKE_anonymous_attribute_id_decrement_weak(layer->anonymous_id);
     layer->anonymous_id = nullptr;
   }
+  if (layer->sharing_info != nullptr && !customdata_layer_sharing_remove_user(layer)) {
+    /* Other layers still use the data. */
+    return;
+  }
   if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
-    typeInfo = layerType_getInfo(layer->type);
-
-    if (typeInfo->free) {
-      typeInfo->free(layer->data, totelem, typeInfo->size);
-    }
-
-    if (layer->data) {
-      MEM_freeN(layer->data);
-    }
+    customdata_layer_free_data(layer->type, layer->data, totelem);
   }
 }
 
@@ -2857,6 +2958,13 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
         flag |= CD_FLAG_NOFREE;
       }
       break;
+    case CD_SHARE:
+      /* The caller adds the layer as a user of the shared data. */
+      if (totelem > 0) {
+        BLI_assert(layerdata != nullptr);
+        newlayerdata = layerdata;
+      }
+      break;
     case CD_DUPLICATE:
       if (totelem > 0) {
         newlayerdata = MEM_malloc_arrayN(totelem, typeInfo->size, layerType_getName(type));
@@ -2899,6 +3007,9 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
   new_layer.type = type;
   new_layer.flag = flag;
   new_layer.data = newlayerdata;
+  if (newlayerdata != nullptr && !ELEM(alloctype, CD_REFERENCE, CD_SHARE)) {
+    new_layer.sharing_info = customdata_sharing_info_new();
+  }
 
   /* Set default name if none exists. Note we only call DATA_()  once
    * we know there is a default name, to avoid overhead of locale lookups
@@ -3110,12 +3221,13 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  if (layer->flag & CD_FLAG_NOFREE) {
+  if (!customdata_layer_is_mutable(layer)) {
     /* MEM_dupallocN won't work in case of complex layers, like e.g.
      * CD_MDEFORMVERT, which has pointers to allocated data...
      * So in case a custom copy function is defined, use it!
      */
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    void *old_data = layer->data;
 
     if (typeInfo->copy) {
       void *dst_data = MEM_malloc_arrayN(
@@ -3127,6 +3239,11 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
       layer->data = MEM_dupallocN(layer->data);
     }
 
+    if (layer->sharing_info != nullptr && customdata_layer_sharing_remove_user(layer)) {
+      /* The other users have been freed in the meantime. */
+      customdata_layer_free_data(layer->type, old_data, totelem);
+    }
+    layer->sharing_info = customdata_sharing_info_new();
     layer->flag &= ~CD_FLAG_NOFREE;
   }
 
@@ -3193,7 +3310,7 @@ bool CustomData_is_referenced_layer(CustomData *data, const int type)
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  return (layer->flag & CD_FLAG_NOFREE) != 0;
+  return !customdata_layer_is_mutable(layer);
 }
 
 void CustomData_free_temporary(CustomData *data, const int totelem)
@@ -3264,6 +3381,7 @@ void CustomData_copy_data_layer(const CustomData *source,
 
   const void *src_data = source->layers[src_layer_index].data;
   void *dst_data = dest->layers[dst_layer_index].data;
+  BLI_assert(!customdata_layer_is_shared(&dest->layers[dst_layer_index]));
 
   typeInfo = layerType_getInfo(source->layers[src_layer_index].type);
 
@@ -3373,7 +3491,7 @@ void CustomData_copy_layer_type_data(const CustomData *source,
 void CustomData_free_elem(CustomData *data, const int index, const int count)
 {
   for (int i = 0; i < data->totlayer; i++) {
-    if (!(data->layers[i].flag & CD_FLAG_NOFREE)) {
+    if (customdata_layer_is_mutable(&data->layers[i])) {
       const LayerTypeInfo *typeInfo = layerType_getInfo(data->layers[i].type);
 
       if (typeInfo->free) {
@@ -3442,6 +3560,7 @@ void CustomData_interp(const CustomData *source,
     /* if we found a matching layer, copy the data */
     if (dest->layers[dest_i].type == source->layers[src_i].type) {
       void *src_data = source->layers[src_i].data;
+      BLI_assert(!customdata_layer_is_shared(&dest->layers[dest_i]));
 
       for (int j = 0; j < count; j++) {
         sources[j] = POINTER_OFFSET(src_data, size_t(src_indices[j]) * typeInfo->size);
@@ -3476,6 +3595,7 @@ void CustomData_swap_corners(CustomData *data, const int index, const int *corne
     const LayerTypeInfo *typeInfo = layerType_getInfo(data->layers[i].type);
 
     if (typeInfo->swap) {
+      BLI_assert(!customdata_layer_is_shared(&data->layers[i]));
       const size_t offset = size_t(index) * typeInfo->size;
 
       typeInfo->swap(POINTER_OFFSET(data->layers[i].data, offset), corner_indices);
@@ -3497,6 +3617,7 @@ void CustomData_swap(CustomData *data, const int index_a, const int index_b)
     const size_t offset_a = size * index_a;
     const size_t offset_b = size * index_b;
 
+    BLI_assert(!customdata_layer_is_shared(&data->layers[i]));
     void *buff = size <= sizeof(buff_static) ? buff_static : MEM_mallocN(size, __func__);
     memcpy(buff, POINTER_OFFSET(data->layers[i].data, offset_a), size);
     memcpy(POINTER_OFFSET(data->layers[i].data, offset_a),
@@ -3510,20 +3631,33 @@ void CustomData_swap(CustomData *data, const int index_a, const int index_b)
   }
 }
 
-void *CustomData_get(const CustomData *data, const int index, const int type)
+const void *CustomData_get(const CustomData *data, const int index, const int type)
+{
+  BLI_assert(index >= 0);
+  const void *layer_data = CustomData_get_layer(data, type);
+  if (!layer_data) {
+    return nullptr;
+  }
+  return POINTER_OFFSET(layer_data, size_t(index) * layerType_getInfo(type)->size);
+}
+
+void *CustomData_get_for_write(CustomData *data,
+                               const int index,
+                               const int type,
+                               const int totelem)
 {
   BLI_assert(index >= 0);
-  void *layer_data = CustomData_get_layer(data, type);
+  void *layer_data = CustomData_get_layer_for_write(data, type, totelem);
   if (!layer_data) {
     return nullptr;
   }
   return POINTER_OFFSET(layer_data, size_t(index) * layerType_getInfo(type)->size);
 }
 
-void *CustomData_get_n(const CustomData *data, const int type, const int index, const int n)
+const void *CustomData_get_n(const CustomData *data, const int type, const int index, const int n)
 {
   BLI_assert(index >= 0);
-  void *layer_data = CustomData_get_layer_n(data, type, n);
+  const void *layer_data = CustomData_get_layer_n(data, type, n);
   if (!layer_data) {
     return nullptr;
   }
@@ -3531,7 +3665,19 @@ void *CustomData_get_n(const CustomData *data, const int type, const int index,
   return POINTER_OFFSET(layer_data, size_t(index) * layerType_getInfo(type)->size);
 }
 
-void *CustomData_get_layer(const CustomData *data, const int type)
+void *CustomData_get_n_for_write(
+    CustomData *data, const int type, const int index, const int n, const int totelem)
+{
+  BLI_assert(index >= 0);
+  void *layer_data = CustomData_get_layer_n_for_write(data, type, n, totelem);
+  if (!layer_data) {
+    return nullptr;
+  }
+
+  return POINTER_OFFSET(layer_data, size_t(index) * layerType_getInfo(type)->size);
+}
+
+const void *CustomData_get_layer(const CustomData *data, const int type)
 {
   int layer_index = CustomData_get_active_layer_index(data, type);
   if (layer_index == -1) {
@@ -3541,7 +3687,13 @@ void *CustomData_get_layer(const CustomData *data, const int type)
   return data->layers[layer_index].data;
 }
 
-void *CustomData_get_layer_n(const CustomData *data, const int type, const int n)
+void *CustomData_get_layer_for_write(CustomData *data, const int type, const int totelem)
+{
+  const int layer_index = CustomData_get_active_layer_index(data, type);
+  return customData_duplicate_referenced_layer_index(data, layer_index, totelem);
+}
+
+const void *CustomData_get_layer_n(const CustomData *data, const int type, const int n)
 {
   int layer_index = CustomData_get_layer_index_n(data, type, n);
   if (layer_index == -1) {
@@ -3551,7 +3703,16 @@ void *CustomData_get_layer_n(const CustomData *data, const int type, const int n
   return data->layers[layer_index].data;
 }
 
-void *CustomData_get_layer_named(const CustomData *data, const int type, const char *name)
+void *CustomData_get_layer_n_for_write(CustomData *data,
+                                       const int type,
+                                       const int n,
+                                       const int totelem)
+{
+  const int layer_index = CustomData_get_layer_index_n(data, type, n);
+  return customData_duplicate_referenced_layer_index(data, layer_index, totelem);
+}
+
+const void *CustomData_get_layer_named(const CustomData *data, const int type, const char *name)
 {
   int layer_index = CustomData_get_named_layer_index(data, type, name);
   if (layer_index == -1) {
@@ -3561,6 +3722,15 @@ void *CustomData_get_layer_named(const CustomData *data, const int type, const c
   return data->layers[layer_index].data;
 }
 
+void *CustomData_get_layer_named_for_write(CustomData *data,
+                                           const int type,
+                                           const char *name,
+                                           const int totelem)
+{
+  const int layer_index = CustomData_get_named_layer_index(data, type, name);
+  return customData_duplicate_referenced_layer_index(data, layer_index, totelem);
+}
+
 int CustomData_get_offset(const CustomData *data, const int type)
 {
   int layer_index = CustomData_get_active_layer_index(data, type);
@@ -3813,7 +3983,7 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
   if (*block) {
     CustomData_bmesh_free_block(data, block);
@@ -4035,7 +4205,7 @@ bool CustomData_has_interp(const CustomData *data)
 bool CustomData_has_referenced(const CustomData *data)
 {
   for (int i = 0; i < data->totlayer; i++) {
-    if (data->layers[i].flag & CD_FLAG_NOFREE) {
+    if (!customdata_layer_is_mutable(&data->layers[i])) {
       return true;
     }
   }
@@ -4313,6 +4483,7 @@ void CustomData_from_bmesh_block(const CustomData *source,
       const LayerTypeInfo *typeInfo = layerType_getInfo(dest->layers[dest_i].type);
       int offset = source->layers[src_i].offset;
       const void *src_data = POINTER_OFFSET(src_block, offset);
+      BLI_assert(!customdata_layer_is_shared(&dest->layers[dest_i]));
       void *dst_data = POINTER_OFFSET(dest->layers[dest_i].data,
                                       size_t(dest_index) * typeInfo->size);
 
@@ -4355,6 +4526,8 @@ void CustomData_blend_write_prepare(CustomData &data,
       continue;
     }
     layers_to_write.append(layer);
+    /* Sharing is a run-time state, the written layer owns its data when read back. */
+    layers_to_write.last().sharing_info = nullptr;
   }
   data.totlayer = layers_to_write.size();
   data.maxlayer = data.totlayer;
@@ -5308,6 +5481,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing_info = nullptr;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
@@ -5319,6 +5493,9 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
                   "Allocated custom data layer that was not saved correctly for layer->type = %d.",
                   layer->type);
       }
+      if (layer->data != nullptr) {
+        layer->sharing_info = customdata_sharing_info_new();
+      }
 
       if (layer->type == CD_MDISPS) {
         blend_read_mdisps(
@@ -0,0 +1,75 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_customdata.h"
+
+#include "DNA_customdata_types.h"
+
+namespace blender::bke::tests {
+
+static float *add_float_layer(CustomData *data, const int totelem)
+{
+  float *values = static_cast<float *>(
+      CustomData_add_layer_named(data, CD_PROP_FLOAT, CD_SET_DEFAULT, nullptr, totelem, "test"));
+  for (int i = 0; i < totelem; i++) {
+    values[i] = float(i);
+  }
+  return values;
+}
+
+TEST(customdata, SharedCopyUsesSameData)
+{
+  CustomData src;
+  CustomData_reset(&src);
+  const float *src_values = add_float_layer(&src, 4);
+
+  CustomData dst;
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, 4);
+  EXPECT_EQ(CustomData_get_layer_named(&dst, CD_PROP_FLOAT, "test"), src_values);
+  EXPECT_TRUE(CustomData_is_referenced_layer(&src, CD_PROP_FLOAT));
+  EXPECT_TRUE(CustomData_is_referenced_layer(&dst, CD_PROP_FLOAT));
+
+  /* Freeing the source keeps the data alive for the copy. */
+  CustomData_free(&src, 4);
+  const float *dst_values = static_cast<const float *>(
+      CustomData_get_layer_named(&dst, CD_PROP_FLOAT, "test"));
+  EXPECT_EQ(dst_values[3], 3.0f);
+
+  /* The last user takes over the data without copying it. */
+  float *dst_values_for_write = static_cast<float *>(
+      CustomData_duplicate_referenced_layer_named(&dst, CD_PROP_FLOAT, "test", 4));
+  EXPECT_EQ(dst_values_for_write, dst_values);
+  EXPECT_FALSE(CustomData_is_referenced_layer(&dst, CD_PROP_FLOAT));
+
+  CustomData_free(&dst, 4);
+}
+
+TEST(customdata, SharedCopyWriteMakesCopy)
+{
+  CustomData src;
+  CustomData_reset(&src);
+  const float *src_values = add_float_layer(&src, 4);
+
+  CustomData dst;
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, 4);
+
+  float *dst_values = static_cast<float *>(
+      CustomData_get_layer_named_for_write(&dst, CD_PROP_FLOAT, "test", 4));
+  EXPECT_NE(dst_values, src_values);
+  dst_values[0] = 10.0f;
+  EXPECT_EQ(src_values[0], 0.0f);
+  EXPECT_EQ(dst_values[1], 1.0f);
+
+  /* The source is the only user left, so it owns its data again. */
+  float *src_values_for_write = static_cast<float *>(
+      CustomData_duplicate_referenced_layer_named(&src, CD_PROP_FLOAT, "test", 4));
+  EXPECT_EQ(src_values_for_write, src_values);
+
+  CustomData_free(&src, 4);
+  CustomData_free(&dst, 4);
+}
+
+}  // namespace blender::bke::tests
@@ -19,6 +19,8 @@
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #include "BLT_translation.h"
 
 #include "BKE_action.h"
@@ -45,6 +47,11 @@ static ThreadMutex python_driver_lock = BLI_MUTEX_INITIALIZER;
 #endif
 
 static CLG_LogRef LOG = {"bke.fcurve"};
+/* Drivers that need Python are evaluated one at a time, because they take the Python driver
+ * lock. Log every such evaluation with its timing, so the drivers that serialize the evaluation
+ * the most can be found and rewritten as simple expressions. Enabled with:
+ * `--log "bke.driver.python"`. */
+static CLG_LogRef LOG_PYTHON = {"bke.driver.python"};
 
 /* -------------------------------------------------------------------- */
 /** \name Driver Variables
@@ -1226,11 +1233,28 @@ static void evaluate_driver_python(PathResolvedRNA *anim_rna,
 #ifdef WITH_PYTHON
     /* This evaluates the expression using Python, and returns its result:
      * - on errors it reports, then returns 0.0f. */
+    const bool use_profile = CLOG_CHECK(&LOG_PYTHON, 1);
+    const double time_start = use_profile ? PIL_check_seconds_timer() : 0.0;
+
     BLI_mutex_lock(&python_driver_lock);
+    const double time_locked = use_profile ? PIL_check_seconds_timer() : 0.0;
 
     driver->curval = BPY_driver_exec(anim_rna, driver, driver_orig, anim_eval_context);
 
     BLI_mutex_unlock(&python_driver_lock);
+
+    if (use_profile) {
+      const double time_end = PIL_check_seconds_timer();
+      const ID *id = anim_rna ? anim_rna->ptr.owner_id : NULL;
+      CLOG_INFO(&LOG_PYTHON,
+                1,
+                "'%s' driving '%s' of '%s': waited %.3f ms for the lock, evaluated in %.3f ms",
+                driver_orig->expression,
+                anim_rna ? RNA_property_identifier(anim_rna->prop) : "<none>",
+                id ? id->name + 2 : "<No ID>",
+                (time_locked - time_start) * 1000.0,
+                (time_end - time_locked) * 1000.0);
+    }
 #else  /* WITH_PYTHON */
     UNUSED_VARS(anim_rna, anim_eval_context);
 #endif /* WITH_PYTHON */
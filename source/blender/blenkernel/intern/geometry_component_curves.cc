@@ -22,6 +22,16 @@ using blender::GVArray;
 /** \name Geometry Component Implementation
  * \{ */
 
+/**
+ * Copy the curves for a component that has to be modified, sharing the attribute arrays with the
+ * source until either of them changes the arrays.
+ */
+static Curves *copy_curves_shared(const Curves &curves)
+{
+  return reinterpret_cast<Curves *>(
+      BKE_id_copy_ex(nullptr, &curves.id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE));
+}
+
 CurveComponent::CurveComponent() : GeometryComponent(GEO_COMPONENT_TYPE_CURVE)
 {
 }
@@ -35,7 +45,7 @@ GeometryComponent *CurveComponent::copy() const
 {
   CurveComponent *new_component = new CurveComponent();
   if (curves_ != nullptr) {
-    new_component->curves_ = BKE_curves_copy_for_eval(curves_, false);
+    new_component->curves_ = copy_curves_shared(*curves_);
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
@@ -89,7 +99,7 @@ Curves *CurveComponent::get_for_write()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ == GeometryOwnershipType::ReadOnly) {
-    curves_ = BKE_curves_copy_for_eval(curves_, false);
+    curves_ = copy_curves_shared(*curves_);
     ownership_ = GeometryOwnershipType::Owned;
   }
   return curves_;
@@ -109,7 +119,7 @@ void CurveComponent::ensure_owns_direct_data()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ != GeometryOwnershipType::Owned) {
-    curves_ = BKE_curves_copy_for_eval(curves_, false);
+    curves_ = copy_curves_shared(*curves_);
     ownership_ = GeometryOwnershipType::Owned;
   }
 }
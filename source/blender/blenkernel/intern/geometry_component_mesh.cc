@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_devirtualize_parameters.hh"
 #include "BLI_listbase.h"
 #include "BLI_task.hh"
 
@@ -25,6 +26,16 @@ extern "C" MDeformVert *BKE_object_defgroup_data_create(ID *id);
 /** \name Geometry Component Implementation
  * \{ */
 
+/**
+ * Copy the mesh for a component that has to be modified, sharing the attribute arrays with the
+ * source until either of them changes the arrays.
+ */
+static Mesh *copy_mesh_shared(const Mesh &mesh)
+{
+  return reinterpret_cast<Mesh *>(
+      BKE_id_copy_ex(nullptr, &mesh.id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE));
+}
+
 MeshComponent::MeshComponent() : GeometryComponent(GEO_COMPONENT_TYPE_MESH)
 {
 }
@@ -38,7 +49,7 @@ GeometryComponent *MeshComponent::copy() const
 {
   MeshComponent *new_component = new MeshComponent();
   if (mesh_ != nullptr) {
-    new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    new_component->mesh_ = copy_mesh_shared(*mesh_);
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
@@ -85,7 +96,7 @@ Mesh *MeshComponent::get_for_write()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ == GeometryOwnershipType::ReadOnly) {
-    mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    mesh_ = copy_mesh_shared(*mesh_);
     ownership_ = GeometryOwnershipType::Owned;
   }
   return mesh_;
@@ -105,7 +116,7 @@ void MeshComponent::ensure_owns_direct_data()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ != GeometryOwnershipType::Owned) {
-    mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    mesh_ = copy_mesh_shared(*mesh_);
     ownership_ = GeometryOwnershipType::Owned;
   }
 }
@@ -172,22 +183,56 @@ VArray<float3> mesh_normals_varray(const Mesh &mesh,
 
 namespace blender::bke {
 
+/**
+ * Mix values for every vertex or edge from its face corners, using a topology map cached on the
+ * mesh. Compared to mixing into the values of all elements while iterating over the corners, this
+ * can be done in parallel.
+ *
+ * \param mix_loop: Called with a mixer, the mixer index of the element and a corner index.
+ */
+template<typename T, typename MixLoopFn>
+static void mix_cached_loop_groups(const mesh_topology::CachedLoopMap &map,
+                                   MutableSpan<T> r_values,
+                                   const MixLoopFn &mix_loop)
+{
+  threading::parallel_for(r_values.index_range(), 1024, [&](const IndexRange range) {
+    attribute_math::DefaultMixer<T> mixer(r_values.slice(range));
+    for (const int i : range) {
+      for (const int loop_i : map.element_loops(i)) {
+        mix_loop(mixer, i - range.start(), loop_i);
+      }
+    }
+    mixer.finalize();
+  });
+}
+
 template<typename T>
 static void adapt_mesh_domain_corner_to_point_impl(const Mesh &mesh,
                                                    const VArray<T> &old_values,
                                                    MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
+  if (const std::optional<mesh_topology::CachedLoopMap> map =
+          mesh_topology::cached_vert_to_loop_map(mesh)) {
+    devirtualize_varray(old_values, [&](const auto old_values) {
+      mix_cached_loop_groups(*map, r_values, [&](auto &mixer, const int64_t i, const int loop_i) {
+        mixer.mix_in(i, old_values[loop_i]);
+      });
+    });
+    return;
+  }
   const Span<MLoop> loops = mesh.loops();
 
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  for (const int loop_index : IndexRange(mesh.totloop)) {
-    const T value = old_values[loop_index];
-    const MLoop &loop = loops[loop_index];
-    const int point_index = loop.v;
-    mixer.mix_in(point_index, value);
-  }
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int loop_index : IndexRange(mesh.totloop)) {
+      const T value = old_values[loop_index];
+      const MLoop &loop = loops[loop_index];
+      const int point_index = loop.v;
+      mixer.mix_in(point_index, value);
+    }
+  });
   mixer.finalize();
 }
 
@@ -198,6 +243,19 @@ void adapt_mesh_domain_corner_to_point_impl(const Mesh &mesh,
                                             MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
+  if (const std::optional<mesh_topology::CachedLoopMap> map =
+          mesh_topology::cached_vert_to_loop_map(mesh)) {
+    threading::parallel_for(r_values.index_range(), 2048, [&](const IndexRange range) {
+      for (const int vert_index : range) {
+        const Span<int> vert_loops = map->element_loops(vert_index);
+        r_values[vert_index] = !vert_loops.is_empty() &&
+                               std::all_of(vert_loops.begin(),
+                                           vert_loops.end(),
+                                           [&](const int loop_i) { return old_values[loop_i]; });
+      }
+    });
+    return;
+  }
   const Span<MLoop> loops = mesh.loops();
 
   Array<bool> loose_verts(mesh.totvert, true);
@@ -308,22 +366,37 @@ static void adapt_mesh_domain_corner_to_edge_impl(const Mesh &mesh,
   const Span<MPoly> polys = mesh.polys();
   const Span<MLoop> loops = mesh.loops();
 
+  if (const std::optional<mesh_topology::CachedLoopMap> map =
+          mesh_topology::cached_edge_to_loop_map(mesh)) {
+    devirtualize_varray(old_values, [&](const auto old_values) {
+      mix_cached_loop_groups(*map, r_values, [&](auto &mixer, const int64_t i, const int loop_i) {
+        const MPoly &poly = polys[map->loop_to_poly[loop_i]];
+        mixer.mix_in(i, old_values[loop_i]);
+        mixer.mix_in(i, old_values[mesh_topology::next_poly_loop(poly, loop_i)]);
+      });
+    });
+    return;
+  }
+
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  for (const int poly_index : polys.index_range()) {
-    const MPoly &poly = polys[poly_index];
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int poly_index : polys.index_range()) {
+      const MPoly &poly = polys[poly_index];
 
-    /* For every edge, mix values from the two adjacent corners (the current and next corner). */
-    for (const int i : IndexRange(poly.totloop)) {
-      const int next_i = (i + 1) % poly.totloop;
-      const int loop_i = poly.loopstart + i;
-      const int next_loop_i = poly.loopstart + next_i;
-      const MLoop &loop = loops[loop_i];
-      const int edge_index = loop.e;
-      mixer.mix_in(edge_index, old_values[loop_i]);
-      mixer.mix_in(edge_index, old_values[next_loop_i]);
+      /* For every edge, mix values from the two adjacent corners (the current and next
+       * corner). */
+      for (const int i : IndexRange(poly.totloop)) {
+        const int next_i = (i + 1) % poly.totloop;
+        const int loop_i = poly.loopstart + i;
+        const int next_loop_i = poly.loopstart + next_i;
+        const MLoop &loop = loops[loop_i];
+        const int edge_index = loop.e;
+        mixer.mix_in(edge_index, old_values[loop_i]);
+        mixer.mix_in(edge_index, old_values[next_loop_i]);
+      }
     }
-  }
+  });
 
   mixer.finalize();
 }
@@ -338,6 +411,25 @@ void adapt_mesh_domain_corner_to_edge_impl(const Mesh &mesh,
   const Span<MPoly> polys = mesh.polys();
   const Span<MLoop> loops = mesh.loops();
 
+  if (const std::optional<mesh_topology::CachedLoopMap> map =
+          mesh_topology::cached_edge_to_loop_map(mesh)) {
+    threading::parallel_for(r_values.index_range(), 2048, [&](const IndexRange range) {
+      for (const int edge_index : range) {
+        const Span<int> edge_loops = map->element_loops(edge_index);
+        bool selected = !edge_loops.is_empty();
+        for (const int loop_i : edge_loops) {
+          const MPoly &poly = polys[map->loop_to_poly[loop_i]];
+          if (!old_values[loop_i] || !old_values[mesh_topology::next_poly_loop(poly, loop_i)]) {
+            selected = false;
+            break;
+          }
+        }
+        r_values[edge_index] = selected;
+      }
+    });
+    return;
+  }
+
   /* It may be possible to rely on the #ME_LOOSEEDGE flag, but that seems error-prone. */
   Array<bool> loose_edges(mesh.totedge, true);
 
@@ -389,20 +481,31 @@ void adapt_mesh_domain_face_to_point_impl(const Mesh &mesh,
                                           MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
+  if (const std::optional<mesh_topology::CachedLoopMap> map =
+          mesh_topology::cached_vert_to_loop_map(mesh)) {
+    devirtualize_varray(old_values, [&](const auto old_values) {
+      mix_cached_loop_groups(*map, r_values, [&](auto &mixer, const int64_t i, const int loop_i) {
+        mixer.mix_in(i, old_values[map->loop_to_poly[loop_i]]);
+      });
+    });
+    return;
+  }
   const Span<MPoly> polys = mesh.polys();
   const Span<MLoop> loops = mesh.loops();
 
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  for (const int poly_index : polys.index_range()) {
-    const MPoly &poly = polys[poly_index];
-    const T value = old_values[poly_index];
-    for (const int loop_index : IndexRange(poly.loopstart, poly.totloop)) {
-      const MLoop &loop = loops[loop_index];
-      const int point_index = loop.v;
-      mixer.mix_in(point_index, value);
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int poly_index : polys.index_range()) {
+      const MPoly &poly = polys[poly_index];
+      const T value = old_values[poly_index];
+      for (const int loop_index : IndexRange(poly.loopstart, poly.totloop)) {
+        const MLoop &loop = loops[loop_index];
+        const int point_index = loop.v;
+        mixer.mix_in(point_index, value);
+      }
     }
-  }
+  });
 
   mixer.finalize();
 }
@@ -480,19 +583,30 @@ void adapt_mesh_domain_face_to_edge_impl(const Mesh &mesh,
                                          MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totedge);
+  if (const std::optional<mesh_topology::CachedLoopMap> map =
+          mesh_topology::cached_edge_to_loop_map(mesh)) {
+    devirtualize_varray(old_values, [&](const auto old_values) {
+      mix_cached_loop_groups(*map, r_values, [&](auto &mixer, const int64_t i, const int loop_i) {
+        mixer.mix_in(i, old_values[map->loop_to_poly[loop_i]]);
+      });
+    });
+    return;
+  }
   const Span<MPoly> polys = mesh.polys();
   const Span<MLoop> loops = mesh.loops();
 
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  for (const int poly_index : polys.index_range()) {
-    const MPoly &poly = polys[poly_index];
-    const T value = old_values[poly_index];
-    for (const int loop_index : IndexRange(poly.loopstart, poly.totloop)) {
-      const MLoop &loop = loops[loop_index];
-      mixer.mix_in(loop.e, value);
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int poly_index : polys.index_range()) {
+      const MPoly &poly = polys[poly_index];
+      const T value = old_values[poly_index];
+      for (const int loop_index : IndexRange(poly.loopstart, poly.totloop)) {
+        const MLoop &loop = loops[loop_index];
+        mixer.mix_in(loop.e, value);
+      }
     }
-  }
+  });
   mixer.finalize();
 }
 
@@ -619,18 +733,20 @@ void adapt_mesh_domain_edge_to_corner_impl(const Mesh &mesh,
 
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  for (const int poly_index : polys.index_range()) {
-    const MPoly &poly = polys[poly_index];
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int poly_index : polys.index_range()) {
+      const MPoly &poly = polys[poly_index];
 
-    /* For every corner, mix the values from the adjacent edges on the face. */
-    for (const int loop_index : IndexRange(poly.loopstart, poly.totloop)) {
-      const int loop_index_prev = mesh_topology::previous_poly_loop(poly, loop_index);
-      const MLoop &loop = loops[loop_index];
-      const MLoop &loop_prev = loops[loop_index_prev];
-      mixer.mix_in(loop_index, old_values[loop.e]);
-      mixer.mix_in(loop_index, old_values[loop_prev.e]);
+      /* For every corner, mix the values from the adjacent edges on the face. */
+      for (const int loop_index : IndexRange(poly.loopstart, poly.totloop)) {
+        const int loop_index_prev = mesh_topology::previous_poly_loop(poly, loop_index);
+        const MLoop &loop = loops[loop_index];
+        const MLoop &loop_prev = loops[loop_index_prev];
+        mixer.mix_in(loop_index, old_values[loop.e]);
+        mixer.mix_in(loop_index, old_values[loop_prev.e]);
+      }
     }
-  }
+  });
 
   mixer.finalize();
 }
@@ -685,12 +801,14 @@ static void adapt_mesh_domain_edge_to_point_impl(const Mesh &mesh,
 
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  for (const int edge_index : IndexRange(mesh.totedge)) {
-    const MEdge &edge = edges[edge_index];
-    const T value = old_values[edge_index];
-    mixer.mix_in(edge.v1, value);
-    mixer.mix_in(edge.v2, value);
-  }
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int edge_index : IndexRange(mesh.totedge)) {
+      const MEdge &edge = edges[edge_index];
+      const T value = old_values[edge_index];
+      mixer.mix_in(edge.v1, value);
+      mixer.mix_in(edge.v2, value);
+    }
+  });
 
   mixer.finalize();
 }
@@ -12,6 +12,16 @@
 /** \name Geometry Component Implementation
  * \{ */
 
+/**
+ * Copy the point cloud for a component that has to be modified, sharing the attribute arrays with
+ * the source until either of them changes the arrays.
+ */
+static PointCloud *copy_pointcloud_shared(const PointCloud &pointcloud)
+{
+  return reinterpret_cast<PointCloud *>(BKE_id_copy_ex(
+      nullptr, &pointcloud.id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE));
+}
+
 PointCloudComponent::PointCloudComponent() : GeometryComponent(GEO_COMPONENT_TYPE_POINT_CLOUD)
 {
 }
@@ -25,7 +35,7 @@ GeometryComponent *PointCloudComponent::copy() const
 {
   PointCloudComponent *new_component = new PointCloudComponent();
   if (pointcloud_ != nullptr) {
-    new_component->pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    new_component->pointcloud_ = copy_pointcloud_shared(*pointcloud_);
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
@@ -72,7 +82,7 @@ PointCloud *PointCloudComponent::get_for_write()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ == GeometryOwnershipType::ReadOnly) {
-    pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    pointcloud_ = copy_pointcloud_shared(*pointcloud_);
     ownership_ = GeometryOwnershipType::Owned;
   }
   return pointcloud_;
@@ -92,7 +102,7 @@ void PointCloudComponent::ensure_owns_direct_data()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ != GeometryOwnershipType::Owned) {
-    pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    pointcloud_ = copy_pointcloud_shared(*pointcloud_);
     ownership_ = GeometryOwnershipType::Owned;
   }
 }
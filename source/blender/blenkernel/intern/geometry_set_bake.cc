@@ -0,0 +1,605 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ *
+ * The file starts with #bake_file_magic, followed by a geometry block. Every geometry block
+ * stores the number of components, followed by the type and the data of each component.
+ * Counts are stored as `int32_t`, strings are stored with their length first. References to
+ * data-blocks are stored as the name of the data-block followed by the name of its library, which
+ * is empty for local data-blocks.
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <type_traits>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_mmap.h"
+#include "BLI_vector.hh"
+
+#include "DNA_ID.h"
+#include "DNA_collection_types.h"
+#include "DNA_curves_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_attribute.hh"
+#include "BKE_curves.hh"
+#include "BKE_geometry_set_bake.hh"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_pointcloud.h"
+
+namespace blender::bke {
+
+static constexpr char bake_file_magic[8] = {'B', 'G', 'N', 'B', 'A', 'K', 'E', '2'};
+
+/* -------------------------------------------------------------------- */
+/** \name Writing
+ * \{ */
+
+class BakeWriter {
+ private:
+  Vector<char> buffer_;
+
+ public:
+  void write_bytes(const void *data, const int64_t size)
+  {
+    buffer_.extend(Span<char>(static_cast<const char *>(data), size));
+  }
+
+  template<typename T> void write(const T &value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    this->write_bytes(&value, sizeof(T));
+  }
+
+  template<typename T> void write_span(const Span<T> values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    this->write_bytes(values.data(), values.size_in_bytes());
+  }
+
+  void write_string(const StringRef str)
+  {
+    this->write<int32_t>(int32_t(str.size()));
+    this->write_bytes(str.data(), str.size());
+  }
+
+  Span<char> data() const
+  {
+    return buffer_;
+  }
+};
+
+/** Whether the attribute can be stored by copying its values as raw memory. */
+static bool attribute_is_bakeable(const AttributeIDRef &attribute_id,
+                                  const AttributeMetaData &meta_data)
+{
+  if (!attribute_id.is_named()) {
+    return false;
+  }
+  const CPPType *type = custom_data_type_to_cpp_type(meta_data.data_type);
+  return type != nullptr && type->is_trivial();
+}
+
+/**
+ * \param skip_names: Attributes that are stored as part of the geometry itself or that are
+ * derived from the geometry.
+ */
+static void write_attributes(BakeWriter &writer,
+                             const AttributeAccessor &attributes,
+                             const Span<StringRef> skip_names)
+{
+  Vector<std::pair<std::string, AttributeMetaData>> bakeable_attributes;
+  attributes.for_all([&](const AttributeIDRef &attribute_id, const AttributeMetaData &meta_data) {
+    if (attribute_is_bakeable(attribute_id, meta_data) &&
+        !skip_names.contains(attribute_id.name())) {
+      bakeable_attributes.append({attribute_id.name(), meta_data});
+    }
+    return true;
+  });
+
+  writer.write<int32_t>(int32_t(bakeable_attributes.size()));
+  for (const auto &[name, meta_data] : bakeable_attributes) {
+    const GVArray varray = attributes.lookup(name, meta_data.domain, meta_data.data_type);
+    const GVArraySpan values{varray};
+    writer.write_string(name);
+    writer.write<int8_t>(int8_t(meta_data.domain));
+    writer.write<int16_t>(int16_t(meta_data.data_type));
+    writer.write<int32_t>(int32_t(values.size()));
+    writer.write_bytes(values.data(), values.size() * values.type().size());
+  }
+}
+
+static void write_id_reference(BakeWriter &writer, const ID *id)
+{
+  writer.write_string(id ? id->name : "");
+  writer.write_string((id && id->lib) ? id->lib->id.name + 2 : "");
+}
+
+static void write_materials(BakeWriter &writer, Material *const *materials, const short totcol)
+{
+  writer.write<int32_t>(totcol);
+  for (const int i : IndexRange(totcol)) {
+    write_id_reference(writer, materials[i] ? &materials[i]->id : nullptr);
+  }
+}
+
+static void write_mesh(BakeWriter &writer, const Mesh &mesh)
+{
+  writer.write<int32_t>(mesh.totvert);
+  writer.write<int32_t>(mesh.totedge);
+  writer.write<int32_t>(mesh.totpoly);
+  writer.write<int32_t>(mesh.totloop);
+  writer.write_span(mesh.verts());
+  writer.write_span(mesh.edges());
+  writer.write_span(mesh.polys());
+  writer.write_span(mesh.loops());
+  write_materials(writer, mesh.mat, mesh.totcol);
+  /* Positions and smooth shading are stored in the element structs, normals are derived. */
+  write_attributes(writer, mesh.attributes(), {"position", "shade_smooth", "normal"});
+}
+
+static void write_pointcloud(BakeWriter &writer, const PointCloud &pointcloud)
+{
+  writer.write<int32_t>(pointcloud.totpoint);
+  write_materials(writer, pointcloud.mat, pointcloud.totcol);
+  write_attributes(writer, pointcloud.attributes(), {});
+}
+
+static void write_curves(BakeWriter &writer, const Curves &curves_id)
+{
+  const CurvesGeometry &curves = CurvesGeometry::wrap(curves_id.geometry);
+  writer.write<int32_t>(curves.points_num());
+  writer.write<int32_t>(curves.curves_num());
+  writer.write_span(curves.offsets());
+  write_materials(writer, curves_id.mat, curves_id.totcol);
+  write_attributes(writer, curves.attributes(), {});
+}
+
+static void write_geometry(BakeWriter &writer, const GeometrySet &geometry_set);
+
+static void write_instances(BakeWriter &writer, const InstancesComponent &instances)
+{
+  const Span<InstanceReference> references = instances.references();
+  writer.write<int32_t>(instances.instances_num());
+  writer.write<int32_t>(int32_t(references.size()));
+  for (const InstanceReference &reference : references) {
+    writer.write<int8_t>(int8_t(reference.type()));
+    switch (reference.type()) {
+      case InstanceReference::Type::None:
+        break;
+      case InstanceReference::Type::Object:
+        write_id_reference(writer, &reference.object().id);
+        break;
+      case InstanceReference::Type::Collection:
+        write_id_reference(writer, &reference.collection().id);
+        break;
+      case InstanceReference::Type::GeometrySet:
+        write_geometry(writer, reference.geometry_set());
+        break;
+    }
+  }
+  writer.write_span(instances.instance_reference_handles());
+  writer.write_span(instances.instance_transforms());
+  write_attributes(writer, *instances.attributes(), {});
+}
+
+static void write_geometry(BakeWriter &writer, const GeometrySet &geometry_set)
+{
+  const Mesh *mesh = geometry_set.get_mesh_for_read();
+  const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read();
+  const Curves *curves = geometry_set.get_curves_for_read();
+  const InstancesComponent *instances =
+      geometry_set.get_component_for_read<InstancesComponent>();
+  if (instances != nullptr && instances->instances_num() == 0) {
+    instances = nullptr;
+  }
+
+  writer.write<int32_t>(int32_t(mesh != nullptr) + int32_t(pointcloud != nullptr) +
+                        int32_t(curves != nullptr) + int32_t(instances != nullptr));
+  if (mesh != nullptr) {
+    writer.write<int8_t>(GEO_COMPONENT_TYPE_MESH);
+    write_mesh(writer, *mesh);
+  }
+  if (pointcloud != nullptr) {
+    writer.write<int8_t>(GEO_COMPONENT_TYPE_POINT_CLOUD);
+    write_pointcloud(writer, *pointcloud);
+  }
+  if (curves != nullptr) {
+    writer.write<int8_t>(GEO_COMPONENT_TYPE_CURVE);
+    write_curves(writer, *curves);
+  }
+  if (instances != nullptr) {
+    writer.write<int8_t>(GEO_COMPONENT_TYPE_INSTANCES);
+    write_instances(writer, *instances);
+  }
+}
+
+bool geometry_set_bake_write(const GeometrySet &geometry_set, const char *filepath)
+{
+  BakeWriter writer;
+  writer.write_bytes(bake_file_magic, sizeof(bake_file_magic));
+  write_geometry(writer, geometry_set);
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  const Span<char> data = writer.data();
+  const bool success = fwrite(data.data(), 1, size_t(data.size()), file) == size_t(data.size());
+  fclose(file);
+  if (!success) {
+    BLI_delete(filepath, false, false);
+  }
+  return success;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Reading
+ * \{ */
+
+/**
+ * Reads from the memory mapped file. All reads are bounds checked, after the first failed read
+ * all further reads fail as well and return zeroed values.
+ */
+class BakeReader {
+ private:
+  Span<char> data_;
+  int64_t offset_ = 0;
+  bool failed_ = false;
+
+ public:
+  BakeReader(const Span<char> data) : data_(data)
+  {
+  }
+
+  bool failed() const
+  {
+    return failed_;
+  }
+
+  /** Whether the file contains at least `num` more elements of the given size. */
+  bool can_read(const int64_t num, const int64_t element_size)
+  {
+    if (failed_ || num < 0 || num > (data_.size() - offset_) / std::max<int64_t>(element_size, 1)) {
+      failed_ = true;
+    }
+    return !failed_;
+  }
+
+  bool read_bytes(void *r_data, const int64_t size)
+  {
+    if (!this->can_read(size, 1)) {
+      memset(r_data, 0, size_t(std::max<int64_t>(size, 0)));
+      return false;
+    }
+    memcpy(r_data, data_.data() + offset_, size_t(size));
+    offset_ += size;
+    return true;
+  }
+
+  template<typename T> T read()
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    this->read_bytes(&value, sizeof(T));
+    return value;
+  }
+
+  /** Read a count that is expected to be followed by `num` elements of the given size. */
+  int read_num(const int64_t element_size)
+  {
+    const int32_t num = this->read<int32_t>();
+    return this->can_read(num, element_size) ? num : 0;
+  }
+
+  template<typename T> void read_span(MutableSpan<T> r_values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    this->read_bytes(r_values.data(), r_values.as_span().size_in_bytes());
+  }
+
+  std::string read_string()
+  {
+    const int size = this->read_num(1);
+    std::string str(size_t(size), '\0');
+    this->read_bytes(str.data(), size);
+    return str;
+  }
+};
+
+static bool read_attributes(BakeReader &reader, MutableAttributeAccessor attributes)
+{
+  const int attributes_num = reader.read_num(1);
+  for ([[maybe_unused]] const int i : IndexRange(attributes_num)) {
+    const std::string name = reader.read_string();
+    const eAttrDomain domain = eAttrDomain(reader.read<int8_t>());
+    const eCustomDataType data_type = eCustomDataType(reader.read<int16_t>());
+    const int values_num = reader.read<int32_t>();
+    if (reader.failed()) {
+      return false;
+    }
+    const CPPType *type = custom_data_type_to_cpp_type(data_type);
+    if (type == nullptr || !type->is_trivial() || !attributes.domain_supported(domain) ||
+        values_num != attributes.domain_size(domain) ||
+        !reader.can_read(values_num, type->size())) {
+      return false;
+    }
+    GSpanAttributeWriter attribute = attributes.lookup_or_add_for_write_only_span(
+        name, domain, data_type);
+    if (!attribute) {
+      return false;
+    }
+    reader.read_bytes(attribute.span.data(), int64_t(values_num) * type->size());
+    attribute.finish();
+  }
+  return !reader.failed();
+}
+
+static ID *read_id_reference(BakeReader &reader, BakeIDResolveFn resolve_id)
+{
+  const std::string name = reader.read_string();
+  const std::string library_name = reader.read_string();
+  if (name.empty() || reader.failed()) {
+    return nullptr;
+  }
+  return resolve_id(name, library_name);
+}
+
+static short read_materials(BakeReader &reader,
+                            BakeIDResolveFn resolve_id,
+                            Material ***r_materials)
+{
+  const int totcol = std::min<int>(reader.read_num(sizeof(int32_t)), MAXMAT);
+  *r_materials = totcol > 0 ? MEM_cnew_array<Material *>(size_t(totcol), __func__) : nullptr;
+  for (const int i : IndexRange(totcol)) {
+    ID *id = read_id_reference(reader, resolve_id);
+    if (id != nullptr && GS(id->name) == ID_MA) {
+      (*r_materials)[i] = reinterpret_cast<Material *>(id);
+    }
+  }
+  return short(totcol);
+}
+
+/** Cheap check that the topology doesn't reference elements out of range. */
+static bool mesh_indices_valid(const Mesh &mesh)
+{
+  for (const MEdge &edge : mesh.edges()) {
+    if (edge.v1 >= uint(mesh.totvert) || edge.v2 >= uint(mesh.totvert)) {
+      return false;
+    }
+  }
+  for (const MPoly &poly : mesh.polys()) {
+    if (poly.loopstart < 0 || poly.totloop < 0 || poly.loopstart > mesh.totloop - poly.totloop) {
+      return false;
+    }
+  }
+  for (const MLoop &loop : mesh.loops()) {
+    if (loop.v >= uint(mesh.totvert) || loop.e >= uint(mesh.totedge)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static Mesh *read_mesh(BakeReader &reader, BakeIDResolveFn resolve_id)
+{
+  const int verts_num = reader.read<int32_t>();
+  const int edges_num = reader.read<int32_t>();
+  const int polys_num = reader.read<int32_t>();
+  const int loops_num = reader.read<int32_t>();
+  if (!reader.can_read(verts_num, sizeof(MVert)) || !reader.can_read(edges_num, sizeof(MEdge)) ||
+      !reader.can_read(polys_num, sizeof(MPoly)) || !reader.can_read(loops_num, sizeof(MLoop))) {
+    return nullptr;
+  }
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, edges_num, 0, loops_num, polys_num);
+  reader.read_span(mesh->verts_for_write());
+  reader.read_span(mesh->edges_for_write());
+  reader.read_span(mesh->polys_for_write());
+  reader.read_span(mesh->loops_for_write());
+  mesh->totcol = read_materials(reader, resolve_id, &mesh->mat);
+  if (!read_attributes(reader, mesh->attributes_for_write())) {
+    BKE_id_free(nullptr, mesh);
+    return nullptr;
+  }
+  if (!mesh_indices_valid(*mesh)) {
+    BKE_id_free(nullptr, mesh);
+    return nullptr;
+  }
+  return mesh;
+}
+
+static PointCloud *read_pointcloud(BakeReader &reader, BakeIDResolveFn resolve_id)
+{
+  const int points_num = reader.read_num(1);
+  if (reader.failed()) {
+    return nullptr;
+  }
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(points_num);
+  pointcloud->totcol = read_materials(reader, resolve_id, &pointcloud->mat);
+  if (!read_attributes(reader, pointcloud->attributes_for_write())) {
+    BKE_id_free(nullptr, pointcloud);
+    return nullptr;
+  }
+  return pointcloud;
+}
+
+static Curves *read_curves(BakeReader &reader, BakeIDResolveFn resolve_id)
+{
+  const int points_num = reader.read<int32_t>();
+  const int curves_num = reader.read<int32_t>();
+  if (points_num < 0 || !reader.can_read(int64_t(curves_num) + 1, sizeof(int))) {
+    return nullptr;
+  }
+  Curves *curves_id = curves_new_nomain(points_num, curves_num);
+  CurvesGeometry &curves = CurvesGeometry::wrap(curves_id->geometry);
+  reader.read_span(curves.offsets_for_write());
+  curves_id->totcol = read_materials(reader, resolve_id, &curves_id->mat);
+  const Span<int> offsets = curves.offsets();
+  bool valid = offsets.first() == 0 && offsets.last() == points_num;
+  for (const int i : curves.curves_range()) {
+    valid &= offsets[i] <= offsets[i + 1];
+  }
+  if (!valid || !read_attributes(reader, curves.attributes_for_write())) {
+    BKE_id_free(nullptr, curves_id);
+    return nullptr;
+  }
+  curves.update_curve_types();
+  curves.tag_topology_changed();
+  return curves_id;
+}
+
+static bool read_geometry(BakeReader &reader, BakeIDResolveFn resolve_id, GeometrySet &r_geometry);
+
+static bool read_instances(BakeReader &reader,
+                           BakeIDResolveFn resolve_id,
+                           InstancesComponent &instances)
+{
+  const int instances_num = reader.read_num(sizeof(int) + sizeof(float4x4));
+  const int references_num = reader.read_num(1);
+  if (reader.failed()) {
+    return false;
+  }
+  /* References that can't be resolved anymore become empty references, which are deduplicated
+   * when added to the component. Therefore the handles have to be remapped. */
+  Array<int> handle_map(references_num);
+  for (const int i : IndexRange(references_num)) {
+    const InstanceReference::Type type = InstanceReference::Type(reader.read<int8_t>());
+    switch (type) {
+      case InstanceReference::Type::None:
+        handle_map[i] = instances.add_reference(InstanceReference());
+        break;
+      case InstanceReference::Type::Object: {
+        ID *id = read_id_reference(reader, resolve_id);
+        handle_map[i] = instances.add_reference(
+            (id && GS(id->name) == ID_OB) ? InstanceReference(*reinterpret_cast<Object *>(id)) :
+                                            InstanceReference());
+        break;
+      }
+      case InstanceReference::Type::Collection: {
+        ID *id = read_id_reference(reader, resolve_id);
+        handle_map[i] = instances.add_reference(
+            (id && GS(id->name) == ID_GR) ?
+                InstanceReference(*reinterpret_cast<Collection *>(id)) :
+                InstanceReference());
+        break;
+      }
+      case InstanceReference::Type::GeometrySet: {
+        GeometrySet geometry_set;
+        if (!read_geometry(reader, resolve_id, geometry_set)) {
+          return false;
+        }
+        handle_map[i] = instances.add_reference(std::move(geometry_set));
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  instances.resize(instances_num);
+  const MutableSpan<int> handles = instances.instance_reference_handles();
+  reader.read_span(handles);
+  reader.read_span(instances.instance_transforms());
+  for (int &handle : handles) {
+    if (handle < 0 || handle >= references_num) {
+      return false;
+    }
+    handle = handle_map[handle];
+  }
+  return read_attributes(reader, *instances.attributes_for_write());
+}
+
+static bool read_geometry(BakeReader &reader, BakeIDResolveFn resolve_id, GeometrySet &r_geometry)
+{
+  const int components_num = reader.read_num(1);
+  for ([[maybe_unused]] const int i : IndexRange(components_num)) {
+    switch (GeometryComponentType(reader.read<int8_t>())) {
+      case GEO_COMPONENT_TYPE_MESH: {
+        Mesh *mesh = read_mesh(reader, resolve_id);
+        if (mesh == nullptr) {
+          return false;
+        }
+        r_geometry.replace_mesh(mesh);
+        break;
+      }
+      case GEO_COMPONENT_TYPE_POINT_CLOUD: {
+        PointCloud *pointcloud = read_pointcloud(reader, resolve_id);
+        if (pointcloud == nullptr) {
+          return false;
+        }
+        r_geometry.replace_pointcloud(pointcloud);
+        break;
+      }
+      case GEO_COMPONENT_TYPE_CURVE: {
+        Curves *curves = read_curves(reader, resolve_id);
+        if (curves == nullptr) {
+          return false;
+        }
+        r_geometry.replace_curves(curves);
+        break;
+      }
+      case GEO_COMPONENT_TYPE_INSTANCES: {
+        InstancesComponent &instances = r_geometry.get_component_for_write<InstancesComponent>();
+        if (!read_instances(reader, resolve_id, instances)) {
+          return false;
+        }
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return !reader.failed();
+}
+
+std::optional<GeometrySet> geometry_set_bake_read(const char *filepath,
+                                                  BakeIDResolveFn resolve_id)
+{
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    return std::nullopt;
+  }
+  const size_t file_size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = file_size > 0 ? BLI_mmap_open(file) : nullptr;
+  close(file);
+  if (mmap_file == nullptr) {
+    return std::nullopt;
+  }
+
+  const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+  BakeReader reader(Span<char>(data, int64_t(file_size)));
+  char magic[sizeof(bake_file_magic)];
+  reader.read_bytes(magic, sizeof(magic));
+
+  std::optional<GeometrySet> geometry_set;
+  if (!reader.failed() && memcmp(magic, bake_file_magic, sizeof(magic)) == 0) {
+    geometry_set.emplace();
+    if (!read_geometry(reader, resolve_id, *geometry_set)) {
+      geometry_set.reset();
+    }
+  }
+  BLI_mmap_free(mmap_file);
+  return geometry_set;
+}
+
+/** \} */
+
+}  // namespace blender::bke
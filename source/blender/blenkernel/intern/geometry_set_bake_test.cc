@@ -0,0 +1,307 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <fstream>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_math_vector.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_curves_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_appdir.h"
+#include "BKE_attribute.hh"
+#include "BKE_curves.hh"
+#include "BKE_geometry_set_bake.hh"
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_pointcloud.h"
+
+namespace blender::bke::tests {
+
+class GeometrySetBakeTest : public testing::Test {
+ protected:
+  char filepath_[FILE_MAX];
+  Material *material_ = nullptr;
+  Library *library_ = nullptr;
+  Object *object_ = nullptr;
+
+  void SetUp() override
+  {
+    BKE_idtype_init();
+    BKE_tempdir_init(nullptr);
+    BLI_path_join(
+        filepath_, sizeof(filepath_), BKE_tempdir_base(), "geometry_set_bake_test.gnbake", nullptr);
+
+    material_ = static_cast<Material *>(BKE_id_new_nomain(ID_MA, "Material"));
+    library_ = static_cast<Library *>(BKE_id_new_nomain(ID_LI, "lib.blend"));
+    object_ = static_cast<Object *>(BKE_id_new_nomain(ID_OB, "Object"));
+    /* Linked the same way as a data-block from another file. */
+    object_->id.lib = library_;
+  }
+
+  void TearDown() override
+  {
+    BLI_delete(filepath_, false, false);
+    BKE_id_free(nullptr, object_);
+    BKE_id_free(nullptr, library_);
+    BKE_id_free(nullptr, material_);
+  }
+
+  ID *resolve_id(const StringRefNull id_name, const StringRefNull library_name)
+  {
+    for (ID *id : {&material_->id, &object_->id}) {
+      const char *id_library_name = id->lib ? id->lib->id.name + 2 : "";
+      if (STREQ(id_name.c_str(), id->name) && STREQ(library_name.c_str(), id_library_name)) {
+        return id;
+      }
+    }
+    return nullptr;
+  }
+
+  std::optional<GeometrySet> write_and_read(const GeometrySet &geometry_set)
+  {
+    EXPECT_TRUE(geometry_set_bake_write(geometry_set, filepath_));
+    return geometry_set_bake_read(
+        filepath_, [&](const StringRefNull id_name, const StringRefNull library_name) {
+          return this->resolve_id(id_name, library_name);
+        });
+  }
+};
+
+/** A single quad with a point and a face attribute and a material. */
+static Mesh *create_quad_mesh(Material *material)
+{
+  Mesh *mesh = BKE_mesh_new_nomain(4, 4, 0, 4, 1);
+  const float positions[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+  MutableSpan<MVert> verts = mesh->verts_for_write();
+  MutableSpan<MEdge> edges = mesh->edges_for_write();
+  MutableSpan<MLoop> loops = mesh->loops_for_write();
+  for (const int i : IndexRange(4)) {
+    copy_v3_v3(verts[i].co, positions[i]);
+    edges[i].v1 = i;
+    edges[i].v2 = (i + 1) % 4;
+    loops[i].v = i;
+    loops[i].e = i;
+  }
+  mesh->polys_for_write()[0].loopstart = 0;
+  mesh->polys_for_write()[0].totloop = 4;
+
+  MutableAttributeAccessor attributes = mesh->attributes_for_write();
+  SpanAttributeWriter<float> weight = attributes.lookup_or_add_for_write_only_span<float>(
+      "weight", ATTR_DOMAIN_POINT);
+  weight.span.copy_from({0.0f, 0.25f, 0.5f, 1.0f});
+  weight.finish();
+  SpanAttributeWriter<int> face_id = attributes.lookup_or_add_for_write_only_span<int>(
+      "face_id", ATTR_DOMAIN_FACE);
+  face_id.span[0] = 42;
+  face_id.finish();
+
+  mesh->totcol = 1;
+  mesh->mat = MEM_cnew_array<Material *>(1, __func__);
+  mesh->mat[0] = material;
+  return mesh;
+}
+
+static void expect_quad_mesh_eq(const Mesh &mesh, const Material *material)
+{
+  EXPECT_EQ(mesh.totvert, 4);
+  EXPECT_EQ(mesh.totedge, 4);
+  EXPECT_EQ(mesh.totpoly, 1);
+  EXPECT_EQ(mesh.totloop, 4);
+  EXPECT_EQ(mesh.verts()[2].co[0], 1.0f);
+  EXPECT_EQ(mesh.verts()[2].co[1], 1.0f);
+  EXPECT_EQ(mesh.edges()[3].v2, 0);
+  EXPECT_EQ(mesh.polys()[0].totloop, 4);
+  EXPECT_EQ(mesh.loops()[3].v, 3);
+
+  const AttributeAccessor attributes = mesh.attributes();
+  const VArray<float> weight = attributes.lookup<float>("weight", ATTR_DOMAIN_POINT);
+  ASSERT_TRUE(weight);
+  EXPECT_EQ(weight[1], 0.25f);
+  EXPECT_EQ(weight[3], 1.0f);
+  const VArray<int> face_id = attributes.lookup<int>("face_id", ATTR_DOMAIN_FACE);
+  ASSERT_TRUE(face_id);
+  EXPECT_EQ(face_id[0], 42);
+
+  ASSERT_EQ(mesh.totcol, 1);
+  EXPECT_EQ(mesh.mat[0], material);
+}
+
+TEST_F(GeometrySetBakeTest, mesh)
+{
+  const GeometrySet geometry_set = GeometrySet::create_with_mesh(create_quad_mesh(material_));
+  const std::optional<GeometrySet> result = this->write_and_read(geometry_set);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_TRUE(result->has_mesh());
+  EXPECT_FALSE(result->has_pointcloud());
+  EXPECT_FALSE(result->has_curves());
+  expect_quad_mesh_eq(*result->get_mesh_for_read(), material_);
+}
+
+TEST_F(GeometrySetBakeTest, curves)
+{
+  Curves *curves_id = curves_new_nomain(5, 2);
+  CurvesGeometry &curves = CurvesGeometry::wrap(curves_id->geometry);
+  curves.offsets_for_write().copy_from({0, 2, 5});
+  curves.fill_curve_types(CURVE_TYPE_POLY);
+  MutableSpan<float3> positions = curves.positions_for_write();
+  for (const int i : positions.index_range()) {
+    positions[i] = float3(float(i), 0.0f, 0.0f);
+  }
+  SpanAttributeWriter<float> radius =
+      curves.attributes_for_write().lookup_or_add_for_write_only_span<float>("radius",
+                                                                              ATTR_DOMAIN_POINT);
+  radius.span.fill(0.5f);
+  radius.finish();
+
+  const std::optional<GeometrySet> result = this->write_and_read(
+      GeometrySet::create_with_curves(curves_id));
+  ASSERT_TRUE(result.has_value());
+  ASSERT_TRUE(result->has_curves());
+  const CurvesGeometry &result_curves = CurvesGeometry::wrap(
+      result->get_curves_for_read()->geometry);
+  EXPECT_EQ(result_curves.points_num(), 5);
+  EXPECT_EQ(result_curves.curves_num(), 2);
+  EXPECT_EQ(result_curves.offsets()[1], 2);
+  EXPECT_EQ(result_curves.positions()[4], float3(4.0f, 0.0f, 0.0f));
+  EXPECT_TRUE(result_curves.has_curve_with_type(CURVE_TYPE_POLY));
+  const VArray<float> result_radius = result_curves.attributes().lookup<float>(
+      "radius", ATTR_DOMAIN_POINT);
+  ASSERT_TRUE(result_radius);
+  EXPECT_EQ(result_radius[3], 0.5f);
+}
+
+TEST_F(GeometrySetBakeTest, pointcloud)
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(3);
+  MutableAttributeAccessor attributes = pointcloud->attributes_for_write();
+  SpanAttributeWriter<float3> positions = attributes.lookup_or_add_for_write_only_span<float3>(
+      "position", ATTR_DOMAIN_POINT);
+  positions.span.copy_from({float3(1, 2, 3), float3(4, 5, 6), float3(7, 8, 9)});
+  positions.finish();
+  SpanAttributeWriter<ColorGeometry4f> color =
+      attributes.lookup_or_add_for_write_only_span<ColorGeometry4f>("color", ATTR_DOMAIN_POINT);
+  color.span.fill(ColorGeometry4f(1.0f, 0.5f, 0.0f, 1.0f));
+  color.finish();
+
+  const std::optional<GeometrySet> result = this->write_and_read(
+      GeometrySet::create_with_pointcloud(pointcloud));
+  ASSERT_TRUE(result.has_value());
+  ASSERT_TRUE(result->has_pointcloud());
+  const PointCloud &result_pointcloud = *result->get_pointcloud_for_read();
+  EXPECT_EQ(result_pointcloud.totpoint, 3);
+  const AttributeAccessor result_attributes = result_pointcloud.attributes();
+  const VArray<float3> result_positions = result_attributes.lookup<float3>("position",
+                                                                           ATTR_DOMAIN_POINT);
+  EXPECT_EQ(result_positions[2], float3(7, 8, 9));
+  const VArray<ColorGeometry4f> result_color = result_attributes.lookup<ColorGeometry4f>(
+      "color", ATTR_DOMAIN_POINT);
+  ASSERT_TRUE(result_color);
+  EXPECT_EQ(result_color[1], ColorGeometry4f(1.0f, 0.5f, 0.0f, 1.0f));
+}
+
+TEST_F(GeometrySetBakeTest, instances)
+{
+  GeometrySet geometry_set;
+  InstancesComponent &instances = geometry_set.get_component_for_write<InstancesComponent>();
+  const int object_handle = instances.add_reference(*object_);
+  const int mesh_handle = instances.add_reference(
+      GeometrySet::create_with_mesh(create_quad_mesh(material_)));
+  float4x4 transform = float4x4::identity();
+  transform.values[3][0] = 2.0f;
+  instances.add_instance(mesh_handle, transform);
+  instances.add_instance(object_handle, float4x4::identity());
+  SpanAttributeWriter<int> index =
+      instances.attributes_for_write()->lookup_or_add_for_write_only_span<int>(
+          "index_test", ATTR_DOMAIN_INSTANCE);
+  index.span.copy_from({7, 8});
+  index.finish();
+
+  const std::optional<GeometrySet> result = this->write_and_read(geometry_set);
+  ASSERT_TRUE(result.has_value());
+  const InstancesComponent *result_instances =
+      result->get_component_for_read<InstancesComponent>();
+  ASSERT_NE(result_instances, nullptr);
+  ASSERT_EQ(result_instances->instances_num(), 2);
+
+  const Span<InstanceReference> references = result_instances->references();
+  const Span<int> handles = result_instances->instance_reference_handles();
+  const InstanceReference &mesh_reference = references[handles[0]];
+  ASSERT_EQ(mesh_reference.type(), InstanceReference::Type::GeometrySet);
+  ASSERT_TRUE(mesh_reference.geometry_set().has_mesh());
+  expect_quad_mesh_eq(*mesh_reference.geometry_set().get_mesh_for_read(), material_);
+  EXPECT_EQ(result_instances->instance_transforms()[0].values[3][0], 2.0f);
+
+  /* The linked object is found again by its name and the name of its library. */
+  const InstanceReference &object_reference = references[handles[1]];
+  ASSERT_EQ(object_reference.type(), InstanceReference::Type::Object);
+  EXPECT_EQ(&object_reference.object(), object_);
+
+  const VArray<int> result_index = result_instances->attributes()->lookup<int>(
+      "index_test", ATTR_DOMAIN_INSTANCE);
+  ASSERT_TRUE(result_index);
+  EXPECT_EQ(result_index[0], 7);
+  EXPECT_EQ(result_index[1], 8);
+}
+
+TEST_F(GeometrySetBakeTest, local_reference_does_not_resolve_linked)
+{
+  GeometrySet geometry_set;
+  InstancesComponent &instances = geometry_set.get_component_for_write<InstancesComponent>();
+  instances.add_instance(instances.add_reference(*object_), float4x4::identity());
+  EXPECT_TRUE(geometry_set_bake_write(geometry_set, filepath_));
+
+  /* A local object with the same name as the linked one is not used. */
+  object_->id.lib = nullptr;
+  const std::optional<GeometrySet> result = geometry_set_bake_read(
+      filepath_, [&](const StringRefNull id_name, const StringRefNull library_name) {
+        return this->resolve_id(id_name, library_name);
+      });
+  ASSERT_TRUE(result.has_value());
+  const InstancesComponent &result_instances =
+      *result->get_component_for_read<InstancesComponent>();
+  ASSERT_EQ(result_instances.instances_num(), 1);
+  EXPECT_EQ(result_instances.references()[0].type(), InstanceReference::Type::None);
+}
+
+TEST_F(GeometrySetBakeTest, invalid_file)
+{
+  const auto resolve_none = [](const StringRefNull /*id_name*/,
+                               const StringRefNull /*library_name*/) -> ID * { return nullptr; };
+  EXPECT_FALSE(geometry_set_bake_read(filepath_, resolve_none).has_value());
+
+  {
+    std::ofstream file(filepath_, std::ios::binary);
+    file << "NOTABAKE";
+  }
+  EXPECT_FALSE(geometry_set_bake_read(filepath_, resolve_none).has_value());
+
+  /* A truncated file is rejected instead of reading past its end. */
+  EXPECT_TRUE(geometry_set_bake_write(
+      GeometrySet::create_with_mesh(create_quad_mesh(nullptr)), filepath_));
+  const size_t size = BLI_file_size(filepath_);
+  std::string data(size, '\0');
+  {
+    std::ifstream file(filepath_, std::ios::binary);
+    file.read(data.data(), std::streamsize(size));
+  }
+  {
+    std::ofstream file(filepath_, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), std::streamsize(size / 2));
+  }
+  EXPECT_FALSE(geometry_set_bake_read(filepath_, resolve_none).has_value());
+}
+
+}  // namespace blender::bke::tests
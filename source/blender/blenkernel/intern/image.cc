@@ -17,10 +17,13 @@
 #  include <io.h>
 #endif
 
+#include <condition_variable>
+#include <mutex>
 #include <regex>
 #include <string>
 
 #include "BLI_array.hh"
+#include "BLI_vector.hh"
 
 #include "CLG_log.h"
 
@@ -106,6 +109,7 @@ using blender::Array;
 static CLG_LogRef LOG = {"bke.image"};
 
 static void image_init(Image *ima, short source, short type);
+static void image_async_load_cancel(Image *ima);
 static void image_free_packedfiles(Image *ima);
 static void copy_image_packedfiles(ListBase *lb_dst, const ListBase *lb_src);
 
@@ -200,6 +204,9 @@ static void image_free_data(ID *id)
 {
   Image *image = (Image *)id;
 
+  /* Make sure no background thread is still loading into this image. */
+  image_async_load_cancel(image);
+
   /* Also frees animations (#Image.anims list). */
   BKE_image_free_buffers(image);
 
@@ -4792,6 +4799,150 @@ bool BKE_image_has_ibuf(Image *ima, ImageUser *iuser)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Asynchronous Loading
+ *
+ * Image files are read and decoded by a background task pool, so drawing does not have to wait
+ * for them. Pending loads are kept in a single list, and every task loads the pending image with
+ * the highest priority at the time it runs.
+ * \{ */
+
+struct ImageAsyncLoad {
+  Image *image;
+  ImageUser iuser;
+  float priority;
+};
+
+static struct {
+  std::mutex mutex;
+  /** Notified when a task finished loading an image. */
+  std::condition_variable finished_cond;
+  TaskPool *pool = nullptr;
+  blender::Vector<ImageAsyncLoad> pending;
+  /** Images that are being loaded by a task right now. */
+  blender::Vector<const Image *> loading;
+  /** A load finished since the last call to #BKE_image_async_load_finished_pop. */
+  bool finished = false;
+} g_async_load;
+
+static void image_async_load_task(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  ImageAsyncLoad load;
+  {
+    std::scoped_lock lock(g_async_load.mutex);
+    if (g_async_load.pending.is_empty()) {
+      /* The load was canceled. */
+      return;
+    }
+    int64_t best_index = 0;
+    for (const int64_t i : g_async_load.pending.index_range()) {
+      if (g_async_load.pending[i].priority > g_async_load.pending[best_index].priority) {
+        best_index = i;
+      }
+    }
+    load = g_async_load.pending[best_index];
+    g_async_load.pending.remove_and_reorder(best_index);
+    g_async_load.loading.append(load.image);
+  }
+
+  if (!BLI_task_pool_current_canceled(pool)) {
+    /* Loading stores the buffer in the image cache, that is all that is needed here. */
+    ImBuf *ibuf = BKE_image_acquire_ibuf(load.image, &load.iuser, nullptr);
+    BKE_image_release_ibuf(load.image, ibuf, nullptr);
+  }
+
+  {
+    std::scoped_lock lock(g_async_load.mutex);
+    g_async_load.loading.remove_first_occurrence_and_reorder(load.image);
+    g_async_load.finished = true;
+  }
+  g_async_load.finished_cond.notify_all();
+}
+
+bool BKE_image_load_async(Image *ima, ImageUser *iuser, const float priority)
+{
+  if (ima->source != IMA_SRC_FILE || ima->type != IMA_TYPE_IMAGE ||
+      !image_quick_test(ima, iuser)) {
+    return false;
+  }
+
+  std::scoped_lock lock(g_async_load.mutex);
+
+  if (g_async_load.loading.contains(ima)) {
+    return true;
+  }
+  for (ImageAsyncLoad &load : g_async_load.pending) {
+    if (load.image == ima) {
+      load.priority = max_ff(load.priority, priority);
+      return true;
+    }
+  }
+
+  /* A failed load is cached as well, acquiring the buffer will not try to load it again. */
+  bool is_cached_empty = false;
+  BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+  ImBuf *ibuf = image_get_cached_ibuf(ima, iuser, nullptr, nullptr, &is_cached_empty);
+  BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+  if (ibuf != nullptr || is_cached_empty) {
+    IMB_freeImBuf(ibuf);
+    return false;
+  }
+
+  ImageAsyncLoad load;
+  load.image = ima;
+  if (iuser) {
+    load.iuser = *iuser;
+    load.iuser.scene = nullptr;
+  }
+  else {
+    BKE_imageuser_default(&load.iuser);
+  }
+  load.priority = priority;
+  g_async_load.pending.append(load);
+
+  if (g_async_load.pool == nullptr) {
+    g_async_load.pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  }
+  BLI_task_pool_push(g_async_load.pool, image_async_load_task, nullptr, false, nullptr);
+
+  return true;
+}
+
+bool BKE_image_async_load_finished_pop()
+{
+  std::scoped_lock lock(g_async_load.mutex);
+  const bool finished = g_async_load.finished;
+  g_async_load.finished = false;
+  return finished;
+}
+
+static void image_async_load_cancel(Image *ima)
+{
+  std::unique_lock lock(g_async_load.mutex);
+  g_async_load.pending.remove_if([&](const ImageAsyncLoad &load) { return load.image == ima; });
+  g_async_load.finished_cond.wait(lock, [&]() { return !g_async_load.loading.contains(ima); });
+}
+
+void BKE_image_async_load_exit()
+{
+  if (g_async_load.pool == nullptr) {
+    return;
+  }
+  {
+    std::scoped_lock lock(g_async_load.mutex);
+    g_async_load.pending.clear();
+  }
+  BLI_task_pool_cancel(g_async_load.pool);
+  BLI_task_pool_free(g_async_load.pool);
+  g_async_load.pool = nullptr;
+
+  /* Free the buffers before the guarded allocator checks for leaks. */
+  g_async_load.pending.clear_and_make_inline();
+  g_async_load.loading.clear_and_make_inline();
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Pool for Image Buffers
  * \{ */
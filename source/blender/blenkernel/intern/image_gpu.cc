@@ -460,6 +460,23 @@ GPUTexture *BKE_image_get_gpu_tilemap(Image *image, ImageUser *iuser, ImBuf *ibu
   return image_get_gpu_texture(image, iuser, ibuf, TEXTARGET_TILE_MAPPING);
 }
 
+GPUTexture *BKE_image_get_gpu_texture_async(Image *image, ImageUser *iuser, const float priority)
+{
+  if (image == nullptr) {
+    return nullptr;
+  }
+
+  int current_view = iuser ? iuser->multi_index : 0;
+  if (current_view >= 2) {
+    current_view = 0;
+  }
+  GPUTexture **tex = get_image_gpu_texture_ptr(image, TEXTARGET_2D, current_view);
+  if (*tex == nullptr && BKE_image_load_async(image, iuser, priority)) {
+    return nullptr;
+  }
+  return image_get_gpu_texture(image, iuser, nullptr, TEXTARGET_2D);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
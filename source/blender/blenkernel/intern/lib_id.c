@@ -909,6 +909,45 @@ void BKE_libblock_management_main_add(Main *bmain, void *idv)
   BKE_lib_libblock_session_uuid_ensure(id);
 }
 
+void BKE_libblock_management_main_add_multiple(Main *bmain, ID **ids, const int ids_num)
+{
+  BLI_assert(bmain != NULL);
+  if (ids_num == 0) {
+    return;
+  }
+
+  ID **ids_to_add = MEM_mallocN(sizeof(*ids_to_add) * (size_t)ids_num, __func__);
+  int ids_to_add_num = 0;
+  for (int i = 0; i < ids_num; i++) {
+    ID *id = ids[i];
+    BLI_assert(GS(id->name) == GS(ids[0]->name));
+    if ((id->tag & LIB_TAG_NO_MAIN) == 0 || (id->tag & LIB_TAG_NOT_ALLOCATED) != 0) {
+      continue;
+    }
+    if ((id->tag & LIB_TAG_NO_USER_REFCOUNT) != 0) {
+      BKE_library_foreach_ID_link(bmain, id, libblock_management_us_plus, NULL, IDWALK_NOP);
+    }
+    ids_to_add[ids_to_add_num++] = id;
+  }
+
+  ListBase *lb = which_libbase(bmain, GS(ids[0]->name));
+  BKE_main_lock(bmain);
+  for (int i = 0; i < ids_to_add_num; i++) {
+    BLI_addtail(lb, ids_to_add[i]);
+  }
+  BKE_id_new_name_validate_multiple(bmain, lb, ids_to_add, ids_to_add_num, true);
+  for (int i = 0; i < ids_to_add_num; i++) {
+    ids_to_add[i]->tag &= ~(LIB_TAG_NO_MAIN | LIB_TAG_NO_USER_REFCOUNT);
+  }
+  bmain->is_memfile_undo_written = false;
+  BKE_main_unlock(bmain);
+
+  for (int i = 0; i < ids_to_add_num; i++) {
+    BKE_lib_libblock_session_uuid_ensure(ids_to_add[i]);
+  }
+  MEM_freeN(ids_to_add);
+}
+
 void BKE_libblock_management_main_remove(Main *bmain, void *idv)
 {
   ID *id = idv;
@@ -1029,21 +1068,17 @@ void BKE_main_id_repair_duplicate_names_listbase(Main *bmain, ListBase *lb)
     return;
   }
 
-  /* Fill an array because renaming sorts. */
+  /* Collect all duplicates first and rename them at once, because renaming sorts. */
   ID **id_array = MEM_mallocN(sizeof(*id_array) * lb_len, __func__);
   GSet *gset = BLI_gset_str_new_ex(__func__, lb_len);
-  int i = 0;
+  int duplicates_num = 0;
   LISTBASE_FOREACH (ID *, id, lb) {
-    if (!ID_IS_LINKED(id)) {
-      id_array[i] = id;
-      i++;
-    }
-  }
-  for (i = 0; i < lb_len; i++) {
-    if (!BLI_gset_add(gset, id_array[i]->name + 2)) {
-      BKE_id_new_name_validate(bmain, lb, id_array[i], NULL, false);
+    if (!ID_IS_LINKED(id) && !BLI_gset_add(gset, id->name + 2)) {
+      id_array[duplicates_num] = id;
+      duplicates_num++;
     }
   }
+  BKE_id_new_name_validate_multiple(bmain, lb, id_array, duplicates_num, false);
   BLI_gset_free(gset, NULL);
   MEM_freeN(id_array);
 }
@@ -1477,6 +1512,94 @@ void id_sort_by_name(ListBase *lb, ID *id, ID *id_sorting_hint)
 #undef ID_SORT_STEP_SIZE
 }
 
+static int id_sort_by_name_multiple_cmp(const void *a, const void *b)
+{
+  const ID *id_a = *(const ID **)a;
+  const ID *id_b = *(const ID **)b;
+  if (id_a->lib != id_b->lib) {
+    /* Only used to group the IDs by library. */
+    return (uintptr_t)id_a->lib < (uintptr_t)id_b->lib ? -1 : 1;
+  }
+  return BLI_strcasecmp(id_a->name, id_b->name);
+}
+
+void id_sort_by_name_multiple(ListBase *lb, ID **ids, const int ids_num)
+{
+  if (ids_num <= 1) {
+    if (ids_num == 1) {
+      id_sort_by_name(lb, ids[0], NULL);
+    }
+    return;
+  }
+
+  ID **ids_sorted = MEM_mallocN(sizeof(*ids_sorted) * (size_t)ids_num, __func__);
+  memcpy(ids_sorted, ids, sizeof(*ids_sorted) * (size_t)ids_num);
+  qsort(ids_sorted, (size_t)ids_num, sizeof(*ids_sorted), id_sort_by_name_multiple_cmp);
+
+  for (int i = 0; i < ids_num; i++) {
+    BLI_remlink(lb, ids_sorted[i]);
+  }
+
+  int group_start = 0;
+  while (group_start < ids_num) {
+    Library *lib = ids_sorted[group_start]->lib;
+    int group_end = group_start + 1;
+    while (group_end < ids_num && ids_sorted[group_end]->lib == lib) {
+      group_end++;
+    }
+
+    /* Find the start of the range of IDs from the same library in the list. */
+    ID *id_iter = lb->first;
+    while (id_iter != NULL && id_iter->lib != lib) {
+      id_iter = id_iter->next;
+    }
+
+    /* Merge the sorted IDs into that range. Like #id_sort_by_name, IDs are inserted after all
+     * existing IDs with the same name. */
+    ID *id_prev = NULL;
+    for (int i = group_start; i < group_end; i++) {
+      ID *id = ids_sorted[i];
+      while (id_iter != NULL && id_iter->lib == lib &&
+             BLI_strcasecmp(id_iter->name, id->name) <= 0) {
+        id_prev = id_iter;
+        id_iter = id_iter->next;
+      }
+      if (id_prev != NULL) {
+        BLI_insertlinkafter(lb, id_prev, id);
+      }
+      else if (id_iter != NULL && id_iter->lib == lib) {
+        BLI_insertlinkbefore(lb, id_iter, id);
+      }
+      else if (ID_IS_LINKED(id)) {
+        /* First ID of its library. */
+        BLI_addtail(lb, id);
+      }
+      else {
+        BLI_addhead(lb, id);
+      }
+      id_prev = id;
+    }
+
+    group_start = group_end;
+  }
+
+  MEM_freeN(ids_sorted);
+}
+
+/** Replace names that must not be used for IDs. */
+static void id_name_sanitize(const ID *id, char *name, const size_t name_maxncpy)
+{
+  if (name[0] == '\0') {
+    /* Disallow empty names. */
+    BLI_strncpy(name, DATA_(BKE_idtype_idcode_to_name(GS(id->name))), name_maxncpy);
+  }
+  else {
+    /* disallow non utf8 chars,
+     * the interface checks for this but new ID's based on file names don't */
+    BLI_str_utf8_invalid_strip(name, strlen(name));
+  }
+}
+
 bool BKE_id_new_name_validate(
     struct Main *bmain, ListBase *lb, ID *id, const char *tname, const bool do_linked_data)
 {
@@ -1497,16 +1620,7 @@ bool BKE_id_new_name_validate(
   }
 
   BLI_strncpy(name, tname, sizeof(name));
-
-  if (name[0] == '\0') {
-    /* Disallow empty names. */
-    BLI_strncpy(name, DATA_(BKE_idtype_idcode_to_name(GS(id->name))), sizeof(name));
-  }
-  else {
-    /* disallow non utf8 chars,
-     * the interface checks for this but new ID's based on file names don't */
-    BLI_str_utf8_invalid_strip(name, strlen(name));
-  }
+  id_name_sanitize(id, name, sizeof(name));
 
   result = BKE_main_namemap_get_name(bmain, id, name);
 
@@ -1515,6 +1629,32 @@ bool BKE_id_new_name_validate(
   return result;
 }
 
+bool BKE_id_new_name_validate_multiple(
+    struct Main *bmain, ListBase *lb, ID **ids, const int ids_num, const bool do_linked_data)
+{
+  if (ids_num == 0) {
+    return false;
+  }
+
+  /* If library, don't rename (unless explicitly required), but do ensure proper sorting. */
+  ID **ids_to_name = MEM_mallocN(sizeof(*ids_to_name) * (size_t)ids_num, __func__);
+  int ids_to_name_num = 0;
+  for (int i = 0; i < ids_num; i++) {
+    ID *id = ids[i];
+    if (!do_linked_data && ID_IS_LINKED(id)) {
+      continue;
+    }
+    id_name_sanitize(id, id->name + 2, sizeof(id->name) - 2);
+    ids_to_name[ids_to_name_num++] = id;
+  }
+
+  const bool result = BKE_main_namemap_reserve_names(bmain, ids_to_name, ids_to_name_num);
+  MEM_freeN(ids_to_name);
+
+  id_sort_by_name_multiple(lb, ids, ids_num);
+  return result;
+}
+
 void BKE_main_id_newptr_and_tag_clear(Main *bmain)
 {
   ID *id;
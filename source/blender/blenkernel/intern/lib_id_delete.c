@@ -224,6 +224,7 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
      * containing thousands of those.
      * This also means that we have to be very careful here, as we by-pass many 'common'
      * processing, hence risking to 'corrupt' at least user counts, if not IDs themselves. */
+    struct IDRemapper *remapper = BKE_id_remapper_create();
     bool keep_looping = true;
     while (keep_looping) {
       ID *id, *id_next;
@@ -255,19 +256,27 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
         dummy_link.next = tagged_deleted_ids.first;
         last_remapped_id = (ID *)(&dummy_link);
       }
+      BKE_id_remapper_clear(remapper);
       for (id = last_remapped_id->next; id; id = id->next) {
-        /* Will tag 'never NULL' users of this ID too.
+        BKE_id_remapper_add(remapper, id, NULL);
+      }
+      if (!BKE_id_remapper_is_empty(remapper)) {
+        /* Will tag 'never NULL' users of these IDs too.
+         *
+         * All IDs removed from Main in this iteration are remapped together, so that Main is
+         * only iterated once for all of them, instead of once per deleted ID.
          *
          * NOTE: #BKE_libblock_unlink() cannot be used here, since it would ignore indirect
          * links, this can lead to nasty crashing here in second, actual deleting loop.
          * Also, this will also flag users of deleted data that cannot be unlinked
          * (object using deleted obdata, etc.), so that they also get deleted. */
-        BKE_libblock_remap_locked(bmain,
-                                  id,
-                                  NULL,
-                                  (ID_REMAP_FLAG_NEVER_NULL_USAGE |
-                                   ID_REMAP_FORCE_NEVER_NULL_USAGE |
-                                   ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS));
+        BKE_libblock_remap_multiple_locked(bmain,
+                                           remapper,
+                                           (ID_REMAP_FLAG_NEVER_NULL_USAGE |
+                                            ID_REMAP_FORCE_NEVER_NULL_USAGE |
+                                            ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS));
+      }
+      for (id = last_remapped_id->next; id; id = id->next) {
         /* Since we removed ID from Main,
          * we also need to unlink its own other IDs usages ourself. */
         BKE_libblock_relink_ex(
@@ -278,6 +287,7 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
             (ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS | ID_REMAP_SKIP_USER_CLEAR));
       }
     }
+    BKE_id_remapper_free(remapper);
 
     /* Now we can safely mark that ID as not being in Main database anymore. */
     /* NOTE: This needs to be done in a separate loop than above, otherwise some user-counts of
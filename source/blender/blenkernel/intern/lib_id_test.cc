@@ -109,6 +109,36 @@ TEST(lib_id_main_sort, linked_ids_1)
   EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
 }
 
+TEST(lib_id_main_sort, multiple_ids)
+{
+  LibIDMainSortTestContext ctx;
+
+  Library *lib_a = static_cast<Library *>(BKE_id_new(ctx.bmain, ID_LI, "LI_A"));
+  ID *id_b = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "OB_B"));
+  ID *id_d = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "OB_D"));
+  ID *id_a = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "OB_A"));
+  ID *id_c = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "OB_C"));
+  ID *id_e = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "OB_E"));
+  ID *id_la = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "OB_LA"));
+  ID *id_lb = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "OB_LB"));
+  change_lib(ctx.bmain, id_la, lib_a);
+  change_lib(ctx.bmain, id_lb, lib_a);
+
+  /* Move the IDs to the end of the list in an arbitrary order. */
+  ID *ids[] = {id_lb, id_e, id_a, id_la, id_c};
+  for (ID *id : ids) {
+    BLI_remlink(&ctx.bmain->objects, id);
+    BLI_addtail(&ctx.bmain->objects, id);
+  }
+  id_sort_by_name_multiple(&ctx.bmain->objects, ids, ARRAY_SIZE(ids));
+
+  EXPECT_TRUE(ctx.bmain->objects.first == id_a);
+  EXPECT_TRUE(ctx.bmain->objects.last == id_lb);
+  test_lib_id_main_sort_check_order({id_a, id_b, id_c, id_d, id_e, id_la, id_lb});
+  /* The given array is not reordered. */
+  EXPECT_EQ(ids[0], id_lb);
+}
+
 TEST(lib_id_main_unique_name, local_ids_1)
 {
   LibIDMainSortTestContext ctx;
@@ -214,6 +244,59 @@ TEST(lib_id_main_unique_name, ids_sorted_by_default_with_libraries)
   EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
 }
 
+TEST(lib_id_main_unique_name, validate_multiple)
+{
+  LibIDMainSortTestContext ctx;
+
+  ID *id_foo = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Foo"));
+  ID *id_bar = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Bar"));
+
+  /* Give new objects conflicting names, like they would have after being created in bulk. */
+  const int new_ids_num = 5;
+  ID *new_ids[new_ids_num];
+  for (int i = 0; i < new_ids_num; i++) {
+    new_ids[i] = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "New"));
+    BKE_main_namemap_remove_name(ctx.bmain, new_ids[i], new_ids[i]->name + 2);
+    BLI_strncpy(new_ids[i]->name + 2, (i == 2) ? "" : "Foo", MAX_NAME);
+  }
+
+  EXPECT_TRUE(BKE_id_new_name_validate_multiple(
+      ctx.bmain, &ctx.bmain->objects, new_ids, new_ids_num, true));
+
+  EXPECT_STREQ(id_foo->name + 2, "Foo");
+  EXPECT_STREQ(new_ids[0]->name + 2, "Foo.001");
+  EXPECT_STREQ(new_ids[1]->name + 2, "Foo.002");
+  EXPECT_STREQ(new_ids[2]->name + 2, "Object");
+  EXPECT_STREQ(new_ids[3]->name + 2, "Foo.003");
+  EXPECT_STREQ(new_ids[4]->name + 2, "Foo.004");
+  test_lib_id_main_sort_check_order(
+      {id_bar, id_foo, new_ids[0], new_ids[1], new_ids[3], new_ids[4], new_ids[2]});
+
+  EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
+}
+
+TEST(lib_id_main_unique_name, reserve_names_without_name_map)
+{
+  LibIDMainSortTestContext ctx;
+
+  ID *id_a = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Foo"));
+  ID *id_b = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Foo"));
+  ID *id_c = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Bar"));
+  EXPECT_STREQ(id_b->name + 2, "Foo.001");
+
+  /* Without an existing name map, the given IDs must not collide with their own names. */
+  BKE_main_namemap_destroy(&ctx.bmain->name_map);
+  BLI_strncpy(id_b->name + 2, "Foo", MAX_NAME);
+  ID *ids[] = {id_b, id_c};
+  EXPECT_TRUE(BKE_main_namemap_reserve_names(ctx.bmain, ids, ARRAY_SIZE(ids)));
+
+  EXPECT_STREQ(id_a->name + 2, "Foo");
+  EXPECT_STREQ(id_b->name + 2, "Foo.001");
+  EXPECT_STREQ(id_c->name + 2, "Bar");
+
+  EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
+}
+
 TEST(lib_id_main_unique_name, name_too_long_handling)
 {
   LibIDMainSortTestContext ctx;
@@ -49,6 +49,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "PIL_time.h"
 
@@ -1931,8 +1932,11 @@ static bool lib_override_library_resync(Main *bmain,
     return success;
   }
 
+  /* New overrides without an old one, added to Main together for each list. */
+  blender::Vector<ID *> ids_override_new_to_add;
   ListBase *lb;
   FOREACH_MAIN_LISTBASE_BEGIN (bmain, lb) {
+    ids_override_new_to_add.clear();
     FOREACH_MAIN_LISTBASE_ID_BEGIN (lb, id) {
       if ((id->tag & LIB_TAG_DOIT) == 0 || id->newid == nullptr ||
           id->lib != id_root_reference->lib) {
@@ -1987,12 +1991,15 @@ static bool lib_override_library_resync(Main *bmain,
         BLI_addtail(no_main_ids_list, id_override_old);
       }
       else {
-        /* Add to proper main list, ensure unique name for local ID, sort, and clear relevant
-         * tags. */
-        BKE_libblock_management_main_add(bmain, id_override_new);
+        ids_override_new_to_add.append(id_override_new);
       }
     }
     FOREACH_MAIN_LISTBASE_ID_END;
+
+    /* Add to proper main list, ensure unique name for local IDs, sort, and clear relevant tags.
+     * Done after iterating over the list, since it adds the IDs to it. */
+    BKE_libblock_management_main_add_multiple(
+        bmain, ids_override_new_to_add.data(), int(ids_override_new_to_add.size()));
   }
   FOREACH_MAIN_LISTBASE_END;
 
@@ -2556,6 +2563,7 @@ static void lib_override_library_main_resync_on_library_indirect_level(
               id_root->name,
               reinterpret_cast<void *>(library),
               reinterpret_cast<ID *>(id_resync_roots->list->link)->name);
+    const double hierarchy_start_time = PIL_check_seconds_timer();
     const bool success = lib_override_library_resync(bmain,
                                                      scene,
                                                      view_layer,
@@ -2566,7 +2574,11 @@ static void lib_override_library_main_resync_on_library_indirect_level(
                                                      false,
                                                      false,
                                                      reports);
-    CLOG_INFO(&LOG, 2, "\tSuccess: %d", success);
+    CLOG_INFO(&LOG,
+              2,
+              "\tSuccess: %d, resynced in %.3f ms",
+              success,
+              (PIL_check_seconds_timer() - hierarchy_start_time) * 1000.0);
     if (success) {
       reports->count.resynced_lib_overrides++;
       if (library_indirect_level > 0 && reports->do_resynced_lib_overrides_libraries_list &&
@@ -2786,18 +2798,19 @@ void BKE_lib_override_library_delete(Main *bmain, ID *id_root)
   BKE_main_relations_free(bmain);
   lib_override_group_tag_data_clear(&data);
 
+  /* Remap the whole local IDs to use the linked data, in a single pass over Main. */
+  IDRemapper *id_remapper = BKE_id_remapper_create();
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if (id->tag & LIB_TAG_DOIT) {
       if (ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
-        ID *id_override_reference = id->override_library->reference;
-
-        /* Remap the whole local IDs to use the linked data. */
-        BKE_libblock_remap(bmain, id, id_override_reference, ID_REMAP_SKIP_INDIRECT_USAGE);
+        BKE_id_remapper_add(id_remapper, id, id->override_library->reference);
       }
     }
   }
   FOREACH_MAIN_ID_END;
+  BKE_libblock_remap_multiple(bmain, id_remapper, ID_REMAP_SKIP_INDIRECT_USAGE);
+  BKE_id_remapper_free(id_remapper);
 
   /* Delete the override IDs. */
   BKE_id_multi_tagged_delete(bmain);
@@ -11,6 +11,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_bitmap.h"
+#include "BLI_function_ref.hh"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
@@ -195,16 +196,22 @@ void BKE_main_namemap_destroy(struct UniqueName_Map **r_name_map)
   *r_name_map = nullptr;
 }
 
-static void main_namemap_populate(UniqueName_Map *name_map, struct Main *bmain, ID *ignore_id)
+/**
+ * Add the names of all IDs from the given library to the name map, except for the IDs for which
+ * the callback returns true.
+ */
+static void main_namemap_populate(UniqueName_Map *name_map,
+                                  struct Main *bmain,
+                                  const Library *library,
+                                  const FunctionRef<bool(const ID *id)> is_ignored)
 {
   BLI_assert_msg(name_map != nullptr, "name_map should not be null");
   for (UniqueName_TypeMap &type_map : name_map->type_maps) {
     type_map.base_name_to_num_suffix.clear();
   }
-  Library *library = ignore_id->lib;
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
-    if ((id == ignore_id) || (id->lib != library)) {
+    if ((id->lib != library) || is_ignored(id)) {
       continue;
     }
     UniqueName_TypeMap *type_map = name_map->find_by_type(GS(id->name));
@@ -231,31 +238,23 @@ static void main_namemap_populate(UniqueName_Map *name_map, struct Main *bmain,
  * NOTE: if the contents are populated, the name of the given ID itself is not added. */
 static UniqueName_Map *get_namemap_for(Main *bmain, ID *id, bool ensure_created)
 {
-  if (id->lib != nullptr) {
-    if (ensure_created && id->lib->runtime.name_map == nullptr) {
-      id->lib->runtime.name_map = BKE_main_namemap_create();
-      main_namemap_populate(id->lib->runtime.name_map, bmain, id);
-    }
-    return id->lib->runtime.name_map;
+  UniqueName_Map **name_map_p = (id->lib != nullptr) ? &id->lib->runtime.name_map :
+                                                       &bmain->name_map;
+  if (ensure_created && *name_map_p == nullptr) {
+    *name_map_p = BKE_main_namemap_create();
+    main_namemap_populate(
+        *name_map_p, bmain, id->lib, [&](const ID *other_id) { return other_id == id; });
   }
-  if (ensure_created && bmain->name_map == nullptr) {
-    bmain->name_map = BKE_main_namemap_create();
-    main_namemap_populate(bmain->name_map, bmain, id);
-  }
-  return bmain->name_map;
+  return *name_map_p;
 }
 
-bool BKE_main_namemap_get_name(struct Main *bmain, struct ID *id, char *name)
+/**
+ * Ensure that the name is unique in the given type map, and add it to the map.
+ * \return true if the name had to be changed.
+ */
+static bool namemap_get_name(UniqueName_TypeMap *type_map, char *name)
 {
-#ifndef __GNUC__ /* GCC warns with `nonull-compare`. */
-  BLI_assert(bmain != nullptr);
-  BLI_assert(id != nullptr);
-#endif
-  UniqueName_Map *name_map = get_namemap_for(bmain, id, true);
-  BLI_assert(name_map != nullptr);
   BLI_assert(strlen(name) < MAX_NAME);
-  UniqueName_TypeMap *type_map = name_map->find_by_type(GS(id->name));
-  BLI_assert(type_map != nullptr);
 
   bool is_name_changed = false;
 
@@ -330,6 +329,62 @@ bool BKE_main_namemap_get_name(struct Main *bmain, struct ID *id, char *name)
   return is_name_changed;
 }
 
+bool BKE_main_namemap_get_name(struct Main *bmain, struct ID *id, char *name)
+{
+#ifndef __GNUC__ /* GCC warns with `nonull-compare`. */
+  BLI_assert(bmain != nullptr);
+  BLI_assert(id != nullptr);
+#endif
+  UniqueName_Map *name_map = get_namemap_for(bmain, id, true);
+  BLI_assert(name_map != nullptr);
+  UniqueName_TypeMap *type_map = name_map->find_by_type(GS(id->name));
+  BLI_assert(type_map != nullptr);
+
+  return namemap_get_name(type_map, name);
+}
+
+bool BKE_main_namemap_reserve_names(struct Main *bmain, struct ID **ids, const int ids_num)
+{
+  const Span<ID *> ids_span(ids, ids_num);
+
+  /* Name maps that do not exist yet are populated once, without the names of all given IDs.
+   * Otherwise the IDs would collide with their own names. */
+  Set<const ID *> ids_set;
+  for (ID *id : ids_span) {
+    UniqueName_Map **name_map_p = (id->lib != nullptr) ? &id->lib->runtime.name_map :
+                                                         &bmain->name_map;
+    if (*name_map_p != nullptr) {
+      continue;
+    }
+    if (ids_set.is_empty()) {
+      ids_set.add_multiple(ids_span);
+    }
+    *name_map_p = BKE_main_namemap_create();
+    main_namemap_populate(*name_map_p, bmain, id->lib, [&](const ID *other_id) {
+      return ids_set.contains(other_id);
+    });
+  }
+
+  /* The IDs usually all have the same type and library, only look up the type map when that
+   * changes. */
+  bool is_any_name_changed = false;
+  UniqueName_TypeMap *type_map = nullptr;
+  const ID *prev_id = nullptr;
+  for (ID *id : ids_span) {
+    if (prev_id == nullptr || prev_id->lib != id->lib || GS(prev_id->name) != GS(id->name)) {
+      UniqueName_Map *name_map = get_namemap_for(bmain, id, false);
+      BLI_assert(name_map != nullptr);
+      type_map = name_map->find_by_type(GS(id->name));
+      BLI_assert(type_map != nullptr);
+    }
+    if (namemap_get_name(type_map, id->name + 2)) {
+      is_any_name_changed = true;
+    }
+    prev_id = id;
+  }
+  return is_any_name_changed;
+}
+
 void BKE_main_namemap_remove_name(struct Main *bmain, struct ID *id, const char *name)
 {
 #ifndef __GNUC__ /* GCC warns with `nonull-compare`. */
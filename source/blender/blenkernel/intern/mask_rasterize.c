@@ -1314,6 +1314,95 @@ static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2
   return 1.0f;
 }
 
+BLI_INLINE float maskrasterize_layer_falloff(const MaskRasterLayer *layer, float value_layer)
+{
+  switch (layer->falloff) {
+    case PROP_SMOOTH:
+      /* ease - gives less hard lines for dilate/erode feather */
+      return (3.0f * value_layer * value_layer - 2.0f * value_layer * value_layer * value_layer);
+    case PROP_SPHERE:
+      return sqrtf(2.0f * value_layer - value_layer * value_layer);
+    case PROP_ROOT:
+      return sqrtf(value_layer);
+    case PROP_SHARP:
+      return value_layer * value_layer;
+    case PROP_INVSQUARE:
+      return value_layer * (2.0f - value_layer);
+    case PROP_LIN:
+    default:
+      /* nothing */
+      return value_layer;
+  }
+}
+
+/**
+ * Value of the layer at a point that is inside of the layer bounds,
+ * before it is blended with the other layers.
+ */
+BLI_INLINE float maskrasterize_layer_value_inside(MaskRasterLayer *layer, const float xy[2])
+{
+  float value_layer = maskrasterize_layer_falloff(layer,
+                                                  1.0f - layer_bucket_depth_from_xy(layer, xy));
+  if (layer->blend != MASK_BLEND_REPLACE) {
+    value_layer *= layer->alpha;
+  }
+  if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
+    value_layer = 1.0f - value_layer;
+  }
+  return value_layer;
+}
+
+/** Value of the layer at points outside of its bounds, or when the layer is unused. */
+BLI_INLINE float maskrasterize_layer_value_outside(const MaskRasterLayer *layer)
+{
+  return (layer->blend_flag & MASK_BLENDFLAG_INVERT) ? 1.0f : 0.0f;
+}
+
+BLI_INLINE float maskrasterize_layer_blend(const MaskRasterLayer *layer,
+                                           float value,
+                                           const float value_layer)
+{
+  switch (layer->blend) {
+    case MASK_BLEND_MERGE_ADD:
+      value += value_layer * (1.0f - value);
+      break;
+    case MASK_BLEND_MERGE_SUBTRACT:
+      value -= value_layer * value;
+      break;
+    case MASK_BLEND_ADD:
+      value += value_layer;
+      break;
+    case MASK_BLEND_SUBTRACT:
+      value -= value_layer;
+      break;
+    case MASK_BLEND_LIGHTEN:
+      value = max_ff(value, value_layer);
+      break;
+    case MASK_BLEND_DARKEN:
+      value = min_ff(value, value_layer);
+      break;
+    case MASK_BLEND_MUL:
+      value *= value_layer;
+      break;
+    case MASK_BLEND_REPLACE:
+      value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
+      break;
+    case MASK_BLEND_DIFFERENCE:
+      value = fabsf(value - value_layer);
+      break;
+    default: /* same as add */
+      CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
+      BLI_assert(0);
+      value += value_layer;
+      break;
+  }
+
+  /* clamp after applying each layer so we don't get
+   * issues subtracting after accumulating over 1.0f */
+  CLAMP(value, 0.0f, 1.0f);
+  return value;
+}
+
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2])
 {
   /* can't do this because some layers may invert */
@@ -1330,85 +1419,54 @@ float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float x
 
     /* also used as signal for unused layer (when render is disabled) */
     if (layer->alpha != 0.0f && BLI_rctf_isect_pt_v(&layer->bounds, xy)) {
-      value_layer = 1.0f - layer_bucket_depth_from_xy(layer, xy);
-
-      switch (layer->falloff) {
-        case PROP_SMOOTH:
-          /* ease - gives less hard lines for dilate/erode feather */
-          value_layer = (3.0f * value_layer * value_layer -
-                         2.0f * value_layer * value_layer * value_layer);
-          break;
-        case PROP_SPHERE:
-          value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
-          break;
-        case PROP_ROOT:
-          value_layer = sqrtf(value_layer);
-          break;
-        case PROP_SHARP:
-          value_layer = value_layer * value_layer;
-          break;
-        case PROP_INVSQUARE:
-          value_layer = value_layer * (2.0f - value_layer);
-          break;
-        case PROP_LIN:
-        default:
-          /* nothing */
-          break;
-      }
-
-      if (layer->blend != MASK_BLEND_REPLACE) {
-        value_layer *= layer->alpha;
-      }
+      value_layer = maskrasterize_layer_value_inside(layer, xy);
     }
     else {
-      value_layer = 0.0f;
+      value_layer = maskrasterize_layer_value_outside(layer);
     }
 
-    if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
-      value_layer = 1.0f - value_layer;
-    }
+    value = maskrasterize_layer_blend(layer, value, value_layer);
+  }
 
-    switch (layer->blend) {
-      case MASK_BLEND_MERGE_ADD:
-        value += value_layer * (1.0f - value);
-        break;
-      case MASK_BLEND_MERGE_SUBTRACT:
-        value -= value_layer * value;
-        break;
-      case MASK_BLEND_ADD:
-        value += value_layer;
-        break;
-      case MASK_BLEND_SUBTRACT:
-        value -= value_layer;
-        break;
-      case MASK_BLEND_LIGHTEN:
-        value = max_ff(value, value_layer);
-        break;
-      case MASK_BLEND_DARKEN:
-        value = min_ff(value, value_layer);
-        break;
-      case MASK_BLEND_MUL:
-        value *= value_layer;
-        break;
-      case MASK_BLEND_REPLACE:
-        value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
-        break;
-      case MASK_BLEND_DIFFERENCE:
-        value = fabsf(value - value_layer);
-        break;
-      default: /* same as add */
-        CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
-        BLI_assert(0);
-        value += value_layer;
-        break;
-    }
+  return value;
+}
 
-    /* clamp after applying each layer so we don't get
-     * issues subtracting after accumulating over 1.0f */
-    CLAMP(value, 0.0f, 1.0f);
+void BKE_maskrasterize_handle_sample_row(MaskRasterHandle *mr_handle,
+                                         const float xy_start[2],
+                                         const float x_step,
+                                         const uint len,
+                                         float *r_values)
+{
+  const uint layers_tot = mr_handle->layers_tot;
+  MaskRasterLayer *layer = mr_handle->layers;
+
+  for (uint x = 0; x < len; x++) {
+    r_values[x] = 0.0f;
   }
 
-  return value;
+  /* Apply the layers one after another, so that the buckets of one layer stay in cache while the
+   * row is sampled, and the bounds of the layer only have to be tested along the row. */
+  for (uint i = 0; i < layers_tot; i++, layer++) {
+    const float value_outside = maskrasterize_layer_value_outside(layer);
+
+    /* also used as signal for unused layer (when render is disabled) */
+    if (layer->alpha == 0.0f || xy_start[1] < layer->bounds.ymin ||
+        xy_start[1] > layer->bounds.ymax) {
+      for (uint x = 0; x < len; x++) {
+        r_values[x] = maskrasterize_layer_blend(layer, r_values[x], value_outside);
+      }
+      continue;
+    }
+
+    float xy[2] = {xy_start[0], xy_start[1]};
+    for (uint x = 0; x < len; x++) {
+      xy[0] = xy_start[0] + (float)x * x_step;
+      const float value_layer = (xy[0] >= layer->bounds.xmin && xy[0] <= layer->bounds.xmax) ?
+                                    maskrasterize_layer_value_inside(layer, xy) :
+                                    value_outside;
+      r_values[x] = maskrasterize_layer_blend(layer, r_values[x], value_layer);
+    }
+  }
 }
 
 typedef struct MaskRasterizeBufferData {
@@ -1433,14 +1491,9 @@ static void maskrasterize_buffer_cb(void *__restrict userdata,
   const float x_inv = data->x_inv;
   const float x_px_ofs = data->x_px_ofs;
 
-  uint i = (uint)y * width;
-  float xy[2];
-  xy[1] = ((float)y * data->y_inv) + data->y_px_ofs;
-  for (uint x = 0; x < width; x++, i++) {
-    xy[0] = ((float)x * x_inv) + x_px_ofs;
-
-    buffer[i] = BKE_maskrasterize_handle_sample(mr_handle, xy);
-  }
+  const float xy_start[2] = {x_px_ofs, ((float)y * data->y_inv) + data->y_px_ofs};
+  BKE_maskrasterize_handle_sample_row(
+      mr_handle, xy_start, x_inv, width, &buffer[(size_t)y * width]);
 }
 
 void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
@@ -137,11 +137,26 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
 
   BKE_defgroup_copy_list(&mesh_dst->vertex_group_names, &mesh_src->vertex_group_names);
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  /* Copy-on-write copies don't share layers with the original mesh. Original data is still
+   * written through plain layer pointers (edit mode, sculpt mode, Python), some of which are kept
+   * across updates, e.g. `SculptSession.mvert`. Render jobs also copy the original meshes from
+   * their own thread while the user keeps editing them. Sharing would require all of these
+   * writers to request write access first. */
+  eCDAllocType alloc_type = CD_DUPLICATE;
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    alloc_type = CD_REFERENCE;
+  }
+  else if (flag & LIB_ID_COPY_CD_SHARE) {
+    alloc_type = CD_SHARE;
+  }
   CustomData_copy(&mesh_src->vdata, &mesh_dst->vdata, mask.vmask, alloc_type, mesh_dst->totvert);
   CustomData_copy(&mesh_src->edata, &mesh_dst->edata, mask.emask, alloc_type, mesh_dst->totedge);
   CustomData_copy(&mesh_src->ldata, &mesh_dst->ldata, mask.lmask, alloc_type, mesh_dst->totloop);
   CustomData_copy(&mesh_src->pdata, &mesh_dst->pdata, mask.pmask, alloc_type, mesh_dst->totpoly);
+  if (alloc_type != CD_DUPLICATE) {
+    /* The topology arrays are the same as in the source mesh. */
+    BKE_mesh_vert_to_loop_cache_share(mesh_src, mesh_dst);
+  }
   if (do_tessface) {
     CustomData_copy(&mesh_src->fdata, &mesh_dst->fdata, mask.fmask, alloc_type, mesh_dst->totface);
   }
@@ -1810,7 +1825,8 @@ static float (*ensure_corner_normal_layer(Mesh &mesh))[3]
 {
   float(*r_loopnors)[3];
   if (CustomData_has_layer(&mesh.ldata, CD_NORMAL)) {
-    r_loopnors = (float(*)[3])CustomData_get_layer(&mesh.ldata, CD_NORMAL);
+    r_loopnors = (float(*)[3])CustomData_duplicate_referenced_layer(
+        &mesh.ldata, CD_NORMAL, mesh.totloop);
     memset(r_loopnors, 0, sizeof(float[3]) * mesh.totloop);
   }
   else {
@@ -1835,7 +1851,8 @@ void BKE_mesh_calc_normals_split_ex(Mesh *mesh,
   const float split_angle = (mesh->flag & ME_AUTOSMOOTH) != 0 ? mesh->smoothresh : float(M_PI);
 
   /* may be nullptr */
-  clnors = (short(*)[2])CustomData_get_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL);
+  clnors = (short(*)[2])CustomData_get_layer_for_write(
+      &mesh->ldata, CD_CUSTOMLOOPNORMAL, mesh->totloop);
 
   const Span<MVert> verts = mesh->verts();
   const Span<MEdge> edges = mesh->edges();
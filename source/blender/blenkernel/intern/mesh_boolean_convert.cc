@@ -646,7 +646,8 @@ static void copy_or_interp_loop_attributes(Mesh *dest_mesh,
           src_blocks_ofs[j] = CustomData_get_n(
               source_cd, ty, orig_mp->loopstart + j, source_layer_type_index);
         }
-        void *dst_block_ofs = CustomData_get_n(target_cd, ty, loop_index, target_layer_type_index);
+        void *dst_block_ofs = CustomData_get_n_for_write(
+            target_cd, ty, loop_index, target_layer_type_index, dest_mesh->totloop);
         CustomData_bmesh_interp_n(target_cd,
                                   src_blocks_ofs.data(),
                                   weights.data(),
@@ -8,7 +8,12 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 
+#include <array>
+
+#include "BLI_array.hh"
+#include "BLI_array_utils.hh"
 #include "BLI_map.hh"
+#include "BLI_math_base.h"
 #include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_timeit.hh"
@@ -126,10 +131,10 @@ static void serialize_and_initialize_deduplicated_edges(MutableSpan<EdgeMap> edg
    * array below. To be able to parallelize this, we have to compute edge index offsets for each
    * map. */
   Array<int> edge_index_offsets(edge_maps.size());
-  edge_index_offsets[0] = 0;
-  for (const int i : IndexRange(edge_maps.size() - 1)) {
-    edge_index_offsets[i + 1] = edge_index_offsets[i] + edge_maps[i].size();
+  for (const int i : edge_maps.index_range()) {
+    edge_index_offsets[i] = edge_maps[i].size();
   }
+  array_utils::exclusive_scan(edge_index_offsets.as_mutable_span());
 
   threading::parallel_for_each(edge_maps, [&](EdgeMap &edge_map) {
     const int task_index = &edge_map - edge_maps.data();
@@ -204,6 +209,222 @@ static void clear_hash_tables(MutableSpan<EdgeMap> edge_maps)
   threading::parallel_for_each(edge_maps, [](EdgeMap &edge_map) { edge_map.clear(); });
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Sort Based Deduplication
+ *
+ * For large meshes, deduplicating edges by sorting them is faster than using hash maps. Every
+ * step is a parallel pass over flat arrays, and no memory has to be reserved based on guesses.
+ * Every edge is packed into an integer key of its ordered vertex indices, so that all instances
+ * of the same edge are next to each other after sorting. The existing edges are added before the
+ * face corners and the sort is stable, so an existing edge is always the first of its instances.
+ * \{ */
+
+/** Use sorting instead of hash maps for meshes with at least this many face corners. */
+static constexpr int sort_min_loops = 100000;
+
+/** Degenerate face corners (using the same vertex twice) are sorted to the end. */
+static constexpr uint64_t invalid_edge_key = std::numeric_limits<uint64_t>::max();
+
+/** The number of items that are processed by one task of the parallel passes. */
+static constexpr int sort_chunk_size = 1 << 16;
+
+static uint64_t edge_key(const OrderedEdge &edge, const int vert_bits)
+{
+  return (uint64_t(edge.v_low) << vert_bits) | uint64_t(edge.v_high);
+}
+
+/**
+ * Stable parallel LSD radix sort of the keys and their values. Only the lower \a key_bits bits
+ * (rounded up to whole digits) are used for sorting.
+ */
+static void radix_sort_edge_keys(MutableSpan<uint64_t> keys,
+                                 MutableSpan<int> values,
+                                 const int key_bits)
+{
+  constexpr int digit_bits = 8;
+  constexpr int digits_num = 1 << digit_bits;
+  const int size = int(keys.size());
+  const int chunks_num = divide_ceil_u(uint(size), uint(sort_chunk_size));
+
+  Array<uint64_t> keys_buffer(size, NoInitialization());
+  Array<int> values_buffer(size, NoInitialization());
+  Array<std::array<int, digits_num>> chunk_offsets(chunks_num, NoInitialization());
+
+  MutableSpan<uint64_t> src_keys = keys;
+  MutableSpan<int> src_values = values;
+  MutableSpan<uint64_t> dst_keys = keys_buffer;
+  MutableSpan<int> dst_values = values_buffer;
+
+  for (int shift = 0; shift < key_bits; shift += digit_bits) {
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int chunk : chunks) {
+        std::array<int, digits_num> &counts = chunk_offsets[chunk];
+        counts.fill(0);
+        const IndexRange range = IndexRange(size).slice(
+            chunk * sort_chunk_size, std::min(sort_chunk_size, size - chunk * sort_chunk_size));
+        for (const int i : range) {
+          counts[(src_keys[i] >> shift) & (digits_num - 1)]++;
+        }
+      }
+    });
+
+    /* Turn the counts into write offsets, ordered by digit first to keep the sort stable. */
+    int offset = 0;
+    for (const int digit : IndexRange(digits_num)) {
+      for (const int chunk : IndexRange(chunks_num)) {
+        const int count = chunk_offsets[chunk][digit];
+        chunk_offsets[chunk][digit] = offset;
+        offset += count;
+      }
+    }
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int chunk : chunks) {
+        std::array<int, digits_num> &offsets = chunk_offsets[chunk];
+        const IndexRange range = IndexRange(size).slice(
+            chunk * sort_chunk_size, std::min(sort_chunk_size, size - chunk * sort_chunk_size));
+        for (const int i : range) {
+          const int dst = offsets[(src_keys[i] >> shift) & (digits_num - 1)]++;
+          dst_keys[dst] = src_keys[i];
+          dst_values[dst] = src_values[i];
+        }
+      }
+    });
+
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  if (src_keys.data() != keys.data()) {
+    threading::parallel_for(IndexRange(size), 4096, [&](const IndexRange range) {
+      keys.slice(range).copy_from(src_keys.slice(range));
+      values.slice(range).copy_from(src_values.slice(range));
+    });
+  }
+}
+
+static void calc_edges_by_sorting(Mesh *mesh,
+                                  const bool keep_existing_edges,
+                                  const bool select_new_edges)
+{
+  const Span<MEdge> orig_edges = keep_existing_edges ? mesh->edges() : Span<MEdge>();
+  const Span<MPoly> polys = mesh->polys();
+  MutableSpan<MLoop> loops = mesh->loops_for_write();
+  const int orig_edges_num = int(orig_edges.size());
+  const int items_num = orig_edges_num + int(loops.size());
+
+  /* Only use as many bits per vertex index as necessary, to minimize the number of passes. */
+  int vert_bits = 1;
+  while ((int64_t(1) << vert_bits) < mesh->totvert) {
+    vert_bits++;
+  }
+
+  /* The values are face corner indices, or `-1 - index` for existing edges. */
+  Array<uint64_t> keys(items_num, NoInitialization());
+  Array<int> values(items_num, NoInitialization());
+  threading::parallel_for(orig_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      keys[i] = edge_key({orig_edges[i].v1, orig_edges[i].v2}, vert_bits);
+      values[i] = -1 - i;
+    }
+  });
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int poly_index : range) {
+      const MPoly &poly = polys[poly_index];
+      for (const int i : IndexRange(poly.loopstart, poly.totloop)) {
+        const int i_next = (i + 1 == poly.loopstart + poly.totloop) ? poly.loopstart : i + 1;
+        const uint v1 = loops[i].v;
+        const uint v2 = loops[i_next].v;
+        keys[orig_edges_num + i] = (v1 == v2) ? invalid_edge_key : edge_key({v1, v2}, vert_bits);
+        values[orig_edges_num + i] = i;
+      }
+    }
+  });
+
+  radix_sort_edge_keys(keys, values, vert_bits * 2);
+
+  /* Every first instance of a key becomes an edge. Count them per chunk, to be able to compute
+   * the edge indices in parallel. */
+  const int chunks_num = divide_ceil_u(uint(items_num), uint(sort_chunk_size));
+  auto chunk_range = [&](const int chunk) {
+    return IndexRange(items_num).slice(
+        chunk * sort_chunk_size, std::min(sort_chunk_size, items_num - chunk * sort_chunk_size));
+  };
+  auto is_first_instance = [&](const int i) {
+    return keys[i] != invalid_edge_key && (i == 0 || keys[i] != keys[i - 1]);
+  };
+  Array<int> chunk_offsets(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      int count = 0;
+      for (const int i : chunk_range(chunk)) {
+        count += is_first_instance(i);
+      }
+      chunk_offsets[chunk] = count;
+    }
+  });
+  const int new_totedge = array_utils::exclusive_scan(chunk_offsets.as_mutable_span());
+
+  MutableSpan<MEdge> new_edges{
+      static_cast<MEdge *>(MEM_calloc_arrayN(new_totedge, sizeof(MEdge), __func__)), new_totedge};
+  Array<bool> is_new_edge(select_new_edges ? new_totedge : 0);
+  const uint64_t vert_mask = (uint64_t(1) << vert_bits) - 1;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      /* The first item of the chunk can belong to the last edge of the previous chunk. */
+      int edge_index = chunk_offsets[chunk] - 1;
+      for (const int i : chunk_range(chunk)) {
+        const int value = values[i];
+        if (keys[i] == invalid_edge_key) {
+          /* This is an invalid edge; normally this does not happen in Blender,
+           * but it can be part of an imported mesh with invalid geometry. See
+           * T76514. */
+          loops[value].e = 0;
+          continue;
+        }
+        if (is_first_instance(i)) {
+          edge_index++;
+          MEdge &new_edge = new_edges[edge_index];
+          if (value < 0) {
+            /* Copy values from original edge. */
+            new_edge = orig_edges[-1 - value];
+          }
+          else {
+            /* Initialize new edge. */
+            new_edge.v1 = uint(keys[i] >> vert_bits);
+            new_edge.v2 = uint(keys[i] & vert_mask);
+            new_edge.flag = ME_EDGEDRAW | ME_EDGERENDER;
+            if (select_new_edges) {
+              is_new_edge[edge_index] = true;
+            }
+          }
+        }
+        if (value >= 0) {
+          loops[value].e = uint(edge_index);
+        }
+      }
+    }
+  });
+
+  /* Free old CustomData and assign new one. */
+  CustomData_free(&mesh->edata, mesh->totedge);
+  CustomData_reset(&mesh->edata);
+  CustomData_add_layer(&mesh->edata, CD_MEDGE, CD_ASSIGN, new_edges.data(), new_totedge);
+  mesh->totedge = new_totedge;
+
+  if (select_new_edges) {
+    MutableAttributeAccessor attributes = mesh->attributes_for_write();
+    SpanAttributeWriter<bool> select_edge = attributes.lookup_or_add_for_write_span<bool>(
+        ".select_edge", ATTR_DOMAIN_EDGE);
+    if (select_edge) {
+      select_edge.span.copy_from(is_new_edge);
+      select_edge.finish();
+    }
+  }
+}
+
+/** \} */
+
 }  // namespace blender::bke::calc_edges
 
 void BKE_mesh_calc_edges(Mesh *mesh, bool keep_existing_edges, const bool select_new_edges)
@@ -212,6 +433,11 @@ void BKE_mesh_calc_edges(Mesh *mesh, bool keep_existing_edges, const bool select
   using namespace blender::bke;
   using namespace blender::bke::calc_edges;
 
+  if (mesh->totloop >= sort_min_loops) {
+    calc_edges::calc_edges_by_sorting(mesh, keep_existing_edges, select_new_edges);
+    return;
+  }
+
   /* Parallelization is achieved by having multiple hash tables for different subsets of edges.
    * Each edge is assigned to one of the hash maps based on the lower bits of a hash value. */
   const int parallel_maps = get_parallel_maps_count(mesh);
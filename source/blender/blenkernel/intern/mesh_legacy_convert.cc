@@ -36,19 +36,20 @@
 static void bm_corners_to_loops_ex(ID *id,
                                    CustomData *fdata,
                                    CustomData *ldata,
-                                   MFace *mface,
+                                   const MFace *mface,
                                    int totloop,
                                    int findex,
                                    int loopstart,
                                    int numTex,
                                    int numCol)
 {
-  MFace *mf = mface + findex;
+  const MFace *mf = mface + findex;
 
   for (int i = 0; i < numTex; i++) {
     const MTFace *texface = (const MTFace *)CustomData_get_n(fdata, CD_MTFACE, findex, i);
 
-    MLoopUV *mloopuv = (MLoopUV *)CustomData_get_n(ldata, CD_MLOOPUV, loopstart, i);
+    MLoopUV *mloopuv = (MLoopUV *)CustomData_get_n_for_write(
+        ldata, CD_MLOOPUV, loopstart, i, totloop);
     copy_v2_v2(mloopuv->uv, texface->uv[0]);
     mloopuv++;
     copy_v2_v2(mloopuv->uv, texface->uv[1]);
@@ -63,7 +64,8 @@ static void bm_corners_to_loops_ex(ID *id,
   }
 
   for (int i = 0; i < numCol; i++) {
-    MLoopCol *mloopcol = (MLoopCol *)CustomData_get_n(ldata, CD_PROP_BYTE_COLOR, loopstart, i);
+    MLoopCol *mloopcol = (MLoopCol *)CustomData_get_n_for_write(
+        ldata, CD_PROP_BYTE_COLOR, loopstart, i, totloop);
     const MCol *mcol = (const MCol *)CustomData_get_n(fdata, CD_MCOL, findex, i);
 
     MESH_MLOOPCOL_FROM_MCOL(mloopcol, &mcol[0]);
@@ -79,8 +81,9 @@ static void bm_corners_to_loops_ex(ID *id,
   }
 
   if (CustomData_has_layer(fdata, CD_TESSLOOPNORMAL)) {
-    float(*lnors)[3] = (float(*)[3])CustomData_get(ldata, loopstart, CD_NORMAL);
-    const short(*tlnors)[3] = (short(*)[3])CustomData_get(fdata, findex, CD_TESSLOOPNORMAL);
+    float(*lnors)[3] = (float(*)[3])CustomData_get_for_write(ldata, loopstart, CD_NORMAL, totloop);
+    const short(*tlnors)[3] = (const short(*)[3])CustomData_get(
+        fdata, findex, CD_TESSLOOPNORMAL);
     const int max = mf->v4 ? 4 : 3;
 
     for (int i = 0; i < max; i++, lnors++, tlnors++) {
@@ -89,7 +92,7 @@ static void bm_corners_to_loops_ex(ID *id,
   }
 
   if (CustomData_has_layer(fdata, CD_MDISPS)) {
-    MDisps *ld = (MDisps *)CustomData_get(ldata, loopstart, CD_MDISPS);
+    MDisps *ld = (MDisps *)CustomData_get_for_write(ldata, loopstart, CD_MDISPS, totloop);
     const MDisps *fd = (const MDisps *)CustomData_get(fdata, findex, CD_MDISPS);
     const float(*disps)[3] = fd->disps;
     int tot = mf->v4 ? 4 : 3;
@@ -165,11 +168,11 @@ static void convert_mfaces_to_mpolys(ID *id,
                                      int totloop_i,
                                      int totpoly_i,
                                      MEdge *medge,
-                                     MFace *mface,
+                                     const MFace *mface,
                                      int *r_totloop,
                                      int *r_totpoly)
 {
-  MFace *mf;
+  const MFace *mf;
   MLoop *ml, *mloop;
   MPoly *mp, *mpoly;
   MEdge *me;
@@ -187,7 +190,7 @@ static void convert_mfaces_to_mpolys(ID *id,
   totpoly = totface_i;
   mpoly = (MPoly *)CustomData_add_layer(pdata, CD_MPOLY, CD_SET_DEFAULT, nullptr, totpoly);
   int *material_indices = static_cast<int *>(
-      CustomData_get_layer_named(pdata, CD_PROP_INT32, "material_index"));
+      CustomData_get_layer_named_for_write(pdata, CD_PROP_INT32, "material_index", totpoly));
   if (material_indices == nullptr) {
     material_indices = static_cast<int *>(CustomData_add_layer_named(
         pdata, CD_PROP_INT32, CD_SET_DEFAULT, nullptr, totpoly, "material_index"));
@@ -224,7 +227,7 @@ static void convert_mfaces_to_mpolys(ID *id,
     me->flag &= ~ME_FGON;
   }
 
-  polyindex = (int *)CustomData_get_layer(fdata, CD_ORIGINDEX);
+  polyindex = (int *)CustomData_get_layer_for_write(fdata, CD_ORIGINDEX, totface_i);
 
   j = 0; /* current loop index */
   ml = mloop;
@@ -330,7 +333,7 @@ void BKE_mesh_convert_mfaces_to_mpolys(Mesh *mesh)
                            mesh->totloop,
                            mesh->totpoly,
                            mesh->edges_for_write().data(),
-                           (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE),
+                           (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE),
                            &mesh->totloop,
                            &mesh->totpoly);
 
@@ -387,7 +390,7 @@ void BKE_mesh_do_versions_convert_mfaces_to_mpolys(Mesh *mesh)
                            mesh->totloop,
                            mesh->totpoly,
                            mesh->edges_for_write().data(),
-                           (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE),
+                           (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE),
                            &mesh->totloop,
                            &mesh->totpoly);
 
@@ -435,7 +438,7 @@ static void mesh_loops_to_tessdata(CustomData *fdata,
   uint(*lidx)[4];
 
   for (i = 0; i < numUV; i++) {
-    MTFace *texface = (MTFace *)CustomData_get_layer_n(fdata, CD_MTFACE, i);
+    MTFace *texface = (MTFace *)CustomData_get_layer_n_for_write(fdata, CD_MTFACE, i, num_faces);
     const MLoopUV *mloopuv = (const MLoopUV *)CustomData_get_layer_n(ldata, CD_MLOOPUV, i);
 
     for (findex = 0, pidx = polyindices, lidx = loopindices; findex < num_faces;
@@ -447,7 +450,7 @@ static void mesh_loops_to_tessdata(CustomData *fdata,
   }
 
   for (i = 0; i < numCol; i++) {
-    MCol(*mcol)[4] = (MCol(*)[4])CustomData_get_layer_n(fdata, CD_MCOL, i);
+    MCol(*mcol)[4] = (MCol(*)[4])CustomData_get_layer_n_for_write(fdata, CD_MCOL, i, num_faces);
     const MLoopCol *mloopcol = (const MLoopCol *)CustomData_get_layer_n(
         ldata, CD_PROP_BYTE_COLOR, i);
 
@@ -459,7 +462,8 @@ static void mesh_loops_to_tessdata(CustomData *fdata,
   }
 
   if (hasPCol) {
-    MCol(*mcol)[4] = (MCol(*)[4])CustomData_get_layer(fdata, CD_PREVIEW_MCOL);
+    MCol(*mcol)[4] = (MCol(*)[4])CustomData_get_layer_for_write(
+        fdata, CD_PREVIEW_MCOL, num_faces);
     const MLoopCol *mloopcol = (const MLoopCol *)CustomData_get_layer(ldata, CD_PREVIEW_MLOOPCOL);
 
     for (findex = 0, lidx = loopindices; findex < num_faces; lidx++, findex++, mcol++) {
@@ -470,7 +474,8 @@ static void mesh_loops_to_tessdata(CustomData *fdata,
   }
 
   if (hasOrigSpace) {
-    OrigSpaceFace *of = (OrigSpaceFace *)CustomData_get_layer(fdata, CD_ORIGSPACE);
+    OrigSpaceFace *of = (OrigSpaceFace *)CustomData_get_layer_for_write(
+        fdata, CD_ORIGSPACE, num_faces);
     const OrigSpaceLoop *lof = (const OrigSpaceLoop *)CustomData_get_layer(ldata,
                                                                            CD_ORIGSPACE_MLOOP);
 
@@ -482,7 +487,8 @@ static void mesh_loops_to_tessdata(CustomData *fdata,
   }
 
   if (hasLoopNormal) {
-    short(*fnors)[4][3] = (short(*)[4][3])CustomData_get_layer(fdata, CD_TESSLOOPNORMAL);
+    short(*fnors)[4][3] = (short(*)[4][3])CustomData_get_layer_for_write(
+        fdata, CD_TESSLOOPNORMAL, num_faces);
     const float(*lnors)[3] = (const float(*)[3])CustomData_get_layer(ldata, CD_NORMAL);
 
     for (findex = 0, lidx = loopindices; findex < num_faces; lidx++, findex++, fnors++) {
@@ -494,7 +500,8 @@ static void mesh_loops_to_tessdata(CustomData *fdata,
 
   if (hasLoopTangent) {
     /* Need to do for all UV maps at some point. */
-    float(*ftangents)[4] = (float(*)[4])CustomData_get_layer(fdata, CD_TANGENT);
+    float(*ftangents)[4] = (float(*)[4])CustomData_get_layer_for_write(
+        fdata, CD_TANGENT, num_faces);
     const float(*ltangents)[4] = (const float(*)[4])CustomData_get_layer(ldata, CD_TANGENT);
 
     for (findex = 0, pidx = polyindices, lidx = loopindices; findex < num_faces;
@@ -9,10 +9,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_meshdata_types.h"
 #include "DNA_vec_types.h"
 
 #include "BLI_array.hh"
+#include "BLI_array_utils.hh"
 #include "BLI_bitmap.h"
 #include "BLI_buffer.h"
 #include "BLI_math.h"
@@ -186,6 +189,9 @@ void BKE_mesh_uv_vert_map_free(UvVertMap *vmap)
  * of polys or loops that use that vertex as a corner. The lists are allocated
  * from one memory pool.
  *
+ * The corners are counted and added to the lists in parallel, so the lists are sorted afterwards
+ * to get the same deterministic order as a serial loop over the polys.
+ *
  * Wrapped by #BKE_mesh_vert_poly_map_create & BKE_mesh_vert_loop_map_create
  */
 static void mesh_vert_poly_or_loop_map_create(MeshElemMap **r_map,
@@ -197,42 +203,46 @@ static void mesh_vert_poly_or_loop_map_create(MeshElemMap **r_map,
                                               int totloop,
                                               const bool do_loops)
 {
+  using namespace blender;
   MeshElemMap *map = MEM_cnew_array<MeshElemMap>(size_t(totvert), __func__);
-  int *indices, *index_iter;
-  int i, j;
-
-  indices = static_cast<int *>(MEM_mallocN(sizeof(int) * size_t(totloop), __func__));
-  index_iter = indices;
+  int *indices = static_cast<int *>(MEM_mallocN(sizeof(int) * size_t(totloop), __func__));
 
   /* Count number of polys for each vertex */
-  for (i = 0; i < totpoly; i++) {
-    const MPoly *p = &mpoly[i];
-
-    for (j = 0; j < p->totloop; j++) {
-      map[mloop[p->loopstart + j].v].count++;
+  Array<int> offsets(totvert, 0);
+  threading::parallel_for(IndexRange(totpoly), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const MPoly &poly = mpoly[i];
+      for (const int64_t loop : IndexRange(poly.loopstart, poly.totloop)) {
+        atomic_add_and_fetch_int32(&offsets[int(mloop[loop].v)], 1);
+      }
     }
-  }
+  });
 
   /* Assign indices mem */
-  for (i = 0; i < totvert; i++) {
-    map[i].indices = index_iter;
-    index_iter += map[i].count;
-
-    /* Reset 'count' for use as index in last loop */
-    map[i].count = 0;
-  }
-
-  /* Find the users */
-  for (i = 0; i < totpoly; i++) {
-    const MPoly *p = &mpoly[i];
+  array_utils::exclusive_scan(offsets.as_mutable_span());
+  threading::parallel_for(IndexRange(totvert), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      map[i].indices = indices + offsets[i];
+    }
+  });
 
-    for (j = 0; j < p->totloop; j++) {
-      uint v = mloop[p->loopstart + j].v;
+  /* Find the users, 'count' is used as index in the group of the vertex */
+  threading::parallel_for(IndexRange(totpoly), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const MPoly &poly = mpoly[i];
+      for (const int64_t loop : IndexRange(poly.loopstart, poly.totloop)) {
+        MeshElemMap &map_ele = map[mloop[loop].v];
+        const int index_in_group = atomic_fetch_and_add_int32(&map_ele.count, 1);
+        map_ele.indices[index_in_group] = int(do_loops ? loop : i);
+      }
+    }
+  });
 
-      map[v].indices[map[v].count] = do_loops ? p->loopstart + j : i;
-      map[v].count++;
+  threading::parallel_for(IndexRange(totvert), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      std::sort(map[i].indices, map[i].indices + map[i].count);
     }
-  }
+  });
 
   *r_map = map;
   *r_mem = indices;
@@ -124,7 +124,8 @@ void BKE_mesh_merge_customdata_for_apply_modifier(Mesh *me)
   Vector<MLoopUV *> mloopuv_layers;
   mloopuv_layers.reserve(mloopuv_layers_num);
   for (int a = 0; a < mloopuv_layers_num; a++) {
-    MLoopUV *mloopuv = static_cast<MLoopUV *>(CustomData_get_layer_n(&me->ldata, CD_MLOOPUV, a));
+    MLoopUV *mloopuv = static_cast<MLoopUV *>(
+        CustomData_get_layer_n_for_write(&me->ldata, CD_MLOOPUV, a, me->totloop));
     mloopuv_layers.append_unchecked(mloopuv);
   }
 
@@ -9,7 +9,9 @@
  * \see bmesh_mesh_normals.c for the equivalent #BMesh functionality.
  */
 
+#include <atomic>
 #include <climits>
+#include <mutex>
 
 #include "MEM_guardedalloc.h"
 
@@ -17,6 +19,7 @@
 #include "DNA_meshdata_types.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_bit_vector.hh"
 #include "BLI_linklist.h"
 #include "BLI_linklist_stack.h"
@@ -33,10 +36,14 @@
 #include "BKE_editmesh_cache.h"
 #include "BKE_global.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 
 #include "atomic_ops.h"
 
+using blender::Array;
 using blender::BitVector;
+using blender::float3;
+using blender::IndexRange;
 using blender::MutableSpan;
 using blender::Span;
 
@@ -341,6 +348,320 @@ void BKE_mesh_calc_normals_poly_and_vertex(const MVert *mvert,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Normal Calculation (Gathered per Vertex)
+ *
+ * Accumulating face normals into vertex normals in parallel over faces requires atomics, which
+ * contend heavily for vertices with many neighbors on machines with many cores. When the topology
+ * of a mesh stays the same over multiple evaluations (e.g. a mesh that is only deformed), the
+ * vertex normals are instead gathered for every vertex from its corners, using a cached map.
+ *
+ * The cache is shared between a mesh and its copies that reference or share the same topology
+ * arrays (see #BKE_mesh_vert_to_loop_cache_share), e.g. the evaluated copies made for deform-only
+ * modifiers and geometry set copies. Copy-on-write copies duplicate their layers, so they build
+ * their own cache. The topology update count of the mesh the cache was built for is stored and
+ * compared before the cache is used, so that a cache isn't used for changed topology even if the
+ * new arrays happen to be allocated at the same addresses as the old ones.
+ *
+ * The same cache also provides the topology maps used for interpolating attributes between
+ * domains, see #blender::mesh_topology::cached_vert_to_loop_map.
+ * \{ */
+
+struct MeshVertToLoopCache {
+  /** Number of meshes referencing this cache. */
+  int users = 1;
+
+  std::mutex build_mutex;
+  std::atomic<bool> is_built = false;
+
+  /** The topology the map was built from, see #Mesh_Runtime.topology_update_count. */
+  int topology_update_count = 0;
+  const MPoly *polys = nullptr;
+  const MLoop *loops = nullptr;
+  int verts_num = 0;
+  int polys_num = 0;
+  int loops_num = 0;
+
+  /** The corners of every vertex are stored in the range `[offsets[v], offsets[v + 1])`. */
+  Array<int> vert_offsets;
+  Array<int> vert_loops;
+  Array<int> loop_to_poly;
+
+  /** The corners of every edge, built separately because normals don't need them. */
+  std::atomic<bool> edge_map_is_built = false;
+  int edges_num = 0;
+  Array<int> edge_offsets;
+  Array<int> edge_loops;
+};
+
+static MeshVertToLoopCache &vert_to_loop_cache_ensure(const Mesh &mesh)
+{
+  MeshVertToLoopCache *cache = mesh.runtime.vert_to_loop_cache;
+  if (cache != nullptr) {
+    return *cache;
+  }
+  /* Creating the cache is cheap, it is only built when it is used. */
+  MeshVertToLoopCache *new_cache = MEM_new<MeshVertToLoopCache>(__func__);
+  cache = static_cast<MeshVertToLoopCache *>(
+      atomic_cas_ptr((void **)&mesh.runtime.vert_to_loop_cache, nullptr, new_cache));
+  if (cache == nullptr) {
+    return *new_cache;
+  }
+  /* Another thread created a cache in the meantime. */
+  MEM_delete(new_cache);
+  return *cache;
+}
+
+void BKE_mesh_vert_to_loop_cache_share(const Mesh *mesh_src, Mesh *mesh_dst)
+{
+  BLI_assert(mesh_dst->runtime.vert_to_loop_cache == nullptr);
+  MeshVertToLoopCache &cache = vert_to_loop_cache_ensure(*mesh_src);
+  atomic_add_and_fetch_int32(&cache.users, 1);
+  mesh_dst->runtime.vert_to_loop_cache = &cache;
+  mesh_dst->runtime.topology_update_count = mesh_src->runtime.topology_update_count;
+}
+
+void BKE_mesh_vert_to_loop_cache_release(Mesh *mesh)
+{
+  mesh->runtime.topology_update_count++;
+  MeshVertToLoopCache *cache = mesh->runtime.vert_to_loop_cache;
+  if (cache == nullptr) {
+    return;
+  }
+  mesh->runtime.vert_to_loop_cache = nullptr;
+  if (atomic_sub_and_fetch_int32(&cache->users, 1) == 0) {
+    MEM_delete(cache);
+  }
+}
+
+static void vert_to_loop_cache_build(MeshVertToLoopCache &cache, const Mesh &mesh)
+{
+  const int verts_num = mesh.totvert;
+  const Span<MPoly> polys = mesh.polys();
+  const Span<MLoop> loops = mesh.loops();
+
+  cache.vert_offsets.reinitialize(verts_num + 1);
+  cache.vert_offsets.fill(0);
+  for (const MLoop &loop : loops) {
+    cache.vert_offsets[loop.v]++;
+  }
+  int offset = 0;
+  for (const int vert_i : IndexRange(verts_num)) {
+    const int count = cache.vert_offsets[vert_i];
+    cache.vert_offsets[vert_i] = offset;
+    offset += count;
+  }
+  cache.vert_offsets[verts_num] = offset;
+
+  /* Corners are added in increasing order, so that the result does not depend on threading. */
+  Array<int> counts(verts_num, 0);
+  cache.vert_loops.reinitialize(loops.size());
+  for (const int loop_i : loops.index_range()) {
+    const int vert_i = loops[loop_i].v;
+    cache.vert_loops[cache.vert_offsets[vert_i] + counts[vert_i]] = loop_i;
+    counts[vert_i]++;
+  }
+
+  cache.loop_to_poly.reinitialize(loops.size());
+  blender::threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int poly_i : range) {
+      const MPoly &poly = polys[poly_i];
+      cache.loop_to_poly.as_mutable_span().slice(poly.loopstart, poly.totloop).fill(poly_i);
+    }
+  });
+
+  cache.topology_update_count = mesh.runtime.topology_update_count;
+  cache.polys = polys.data();
+  cache.loops = loops.data();
+  cache.verts_num = verts_num;
+  cache.polys_num = polys.size();
+  cache.loops_num = loops.size();
+}
+
+static void edge_to_loop_cache_build(MeshVertToLoopCache &cache,
+                                     const int edges_num,
+                                     const Span<MLoop> loops)
+{
+  cache.edge_offsets.reinitialize(edges_num + 1);
+  cache.edge_offsets.fill(0);
+  for (const MLoop &loop : loops) {
+    cache.edge_offsets[loop.e]++;
+  }
+  int offset = 0;
+  for (const int edge_i : IndexRange(edges_num)) {
+    const int count = cache.edge_offsets[edge_i];
+    cache.edge_offsets[edge_i] = offset;
+    offset += count;
+  }
+  cache.edge_offsets[edges_num] = offset;
+
+  Array<int> counts(edges_num, 0);
+  cache.edge_loops.reinitialize(loops.size());
+  for (const int loop_i : loops.index_range()) {
+    const int edge_i = loops[loop_i].e;
+    cache.edge_loops[cache.edge_offsets[edge_i] + counts[edge_i]] = loop_i;
+    counts[edge_i]++;
+  }
+  cache.edges_num = edges_num;
+}
+
+static bool vert_to_loop_cache_matches(const MeshVertToLoopCache &cache, const Mesh &mesh)
+{
+  return cache.topology_update_count == mesh.runtime.topology_update_count &&
+         cache.polys == mesh.polys().data() && cache.loops == mesh.loops().data() &&
+         cache.verts_num == mesh.totvert && cache.polys_num == mesh.totpoly &&
+         cache.loops_num == mesh.totloop;
+}
+
+static MeshVertToLoopCache &vert_to_loop_cache_ensure_built(const Mesh &mesh)
+{
+  MeshVertToLoopCache &cache = vert_to_loop_cache_ensure(mesh);
+  if (!cache.is_built.load(std::memory_order_acquire)) {
+    std::lock_guard lock{cache.build_mutex};
+    if (!cache.is_built.load(std::memory_order_relaxed)) {
+      vert_to_loop_cache_build(cache, mesh);
+      cache.is_built.store(true, std::memory_order_release);
+    }
+  }
+  return cache;
+}
+
+namespace blender::mesh_topology {
+
+std::optional<CachedLoopMap> cached_vert_to_loop_map(const Mesh &mesh)
+{
+  const MeshVertToLoopCache &cache = vert_to_loop_cache_ensure_built(mesh);
+  if (!vert_to_loop_cache_matches(cache, mesh)) {
+    return std::nullopt;
+  }
+  return CachedLoopMap{cache.vert_offsets, cache.vert_loops, cache.loop_to_poly};
+}
+
+std::optional<CachedLoopMap> cached_edge_to_loop_map(const Mesh &mesh)
+{
+  MeshVertToLoopCache &cache = vert_to_loop_cache_ensure_built(mesh);
+  if (!vert_to_loop_cache_matches(cache, mesh)) {
+    return std::nullopt;
+  }
+  if (!cache.edge_map_is_built.load(std::memory_order_acquire)) {
+    std::lock_guard lock{cache.build_mutex};
+    if (!cache.edge_map_is_built.load(std::memory_order_relaxed)) {
+      edge_to_loop_cache_build(cache, mesh.totedge, mesh.loops());
+      cache.edge_map_is_built.store(true, std::memory_order_release);
+    }
+  }
+  if (cache.edges_num != mesh.totedge) {
+    return std::nullopt;
+  }
+  return CachedLoopMap{cache.edge_offsets, cache.edge_loops, cache.loop_to_poly};
+}
+
+}  // namespace blender::mesh_topology
+
+/**
+ * Calculate the polygon normal and the angle of every corner, which is used as its weight for the
+ * vertex normals. The same as in #mesh_calc_normals_poly_and_vertex_accum_fn.
+ */
+static void calc_poly_normal_and_corner_angles(const MVert *mverts,
+                                               const MLoop *ml,
+                                               const int totloop,
+                                               float pnor[3],
+                                               float *r_corner_angles)
+{
+  const int i_end = totloop - 1;
+
+  zero_v3(pnor);
+  /* Newell's Method */
+  const float *v_curr = mverts[ml[i_end].v].co;
+  for (int i_next = 0; i_next <= i_end; i_next++) {
+    const float *v_next = mverts[ml[i_next].v].co;
+    add_newell_cross_v3_v3v3(pnor, v_curr, v_next);
+    v_curr = v_next;
+  }
+  if (UNLIKELY(normalize_v3(pnor) == 0.0f)) {
+    pnor[2] = 1.0f; /* Other axes set to zero. */
+  }
+
+  float edvec_prev[3], edvec_next[3], edvec_end[3];
+  v_curr = mverts[ml[i_end].v].co;
+  sub_v3_v3v3(edvec_prev, mverts[ml[i_end - 1].v].co, v_curr);
+  normalize_v3(edvec_prev);
+  copy_v3_v3(edvec_end, edvec_prev);
+
+  for (int i_next = 0, i_curr = i_end; i_next <= i_end; i_curr = i_next++) {
+    const float *v_next = mverts[ml[i_next].v].co;
+
+    /* Skip an extra normalization by reusing the first calculated edge. */
+    if (i_next != i_end) {
+      sub_v3_v3v3(edvec_next, v_curr, v_next);
+      normalize_v3(edvec_next);
+    }
+    else {
+      copy_v3_v3(edvec_next, edvec_end);
+    }
+
+    r_corner_angles[i_curr] = saacos(-dot_v3v3(edvec_prev, edvec_next));
+    v_curr = v_next;
+    copy_v3_v3(edvec_prev, edvec_next);
+  }
+}
+
+/**
+ * Calculate face and vertex normals with the vertex to corner map cached on the mesh.
+ *
+ * \return False when there is no (valid) cache and the normals have not been calculated.
+ */
+static bool mesh_calc_normals_poly_and_vertex_cached(const Mesh &mesh,
+                                                     MutableSpan<float3> poly_normals,
+                                                     MutableSpan<float3> vert_normals)
+{
+  if (mesh.runtime.vert_to_loop_cache == nullptr) {
+    return false;
+  }
+  const Span<MVert> verts = mesh.verts();
+  const Span<MPoly> polys = mesh.polys();
+  const Span<MLoop> loops = mesh.loops();
+
+  const MeshVertToLoopCache *cache = &vert_to_loop_cache_ensure_built(mesh);
+  if (!vert_to_loop_cache_matches(*cache, mesh)) {
+    /* The topology of this mesh is not the one the map was built from. */
+    return false;
+  }
+
+  Array<float> corner_angles(loops.size());
+  blender::threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int poly_i : range) {
+      const MPoly &poly = polys[poly_i];
+      calc_poly_normal_and_corner_angles(verts.data(),
+                                         &loops[poly.loopstart],
+                                         poly.totloop,
+                                         poly_normals[poly_i],
+                                         &corner_angles[poly.loopstart]);
+    }
+  });
+
+  const Span<int> vert_offsets = cache->vert_offsets;
+  const Span<int> vert_loops = cache->vert_loops;
+  const Span<int> loop_to_poly = cache->loop_to_poly;
+  blender::threading::parallel_for(verts.index_range(), 1024, [&](const IndexRange range) {
+    for (const int vert_i : range) {
+      float3 normal(0.0f);
+      for (const int loop_i : vert_loops.slice(vert_offsets[vert_i],
+                                               vert_offsets[vert_i + 1] - vert_offsets[vert_i])) {
+        normal += poly_normals[loop_to_poly[loop_i]] * corner_angles[loop_i];
+      }
+      if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+        /* Following Mesh convention; we use vertex coordinate itself for normal in this case. */
+        normalize_v3_v3(normal, verts[vert_i].co);
+      }
+      vert_normals[vert_i] = normal;
+    }
+  });
+  return true;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Normal Calculation
  * \{ */
@@ -377,14 +698,19 @@ const float (*BKE_mesh_vertex_normals_ensure(const Mesh *mesh))[3]
     vert_normals = BKE_mesh_vertex_normals_for_write(&mesh_mutable);
     poly_normals = BKE_mesh_poly_normals_for_write(&mesh_mutable);
 
-    BKE_mesh_calc_normals_poly_and_vertex(verts.data(),
-                                          verts.size(),
-                                          loops.data(),
-                                          loops.size(),
-                                          polys.data(),
-                                          polys.size(),
-                                          poly_normals,
-                                          vert_normals);
+    if (!mesh_calc_normals_poly_and_vertex_cached(
+            mesh_mutable,
+            {reinterpret_cast<float3 *>(poly_normals), polys.size()},
+            {reinterpret_cast<float3 *>(vert_normals), verts.size()})) {
+      BKE_mesh_calc_normals_poly_and_vertex(verts.data(),
+                                            verts.size(),
+                                            loops.data(),
+                                            loops.size(),
+                                            polys.data(),
+                                            polys.size(),
+                                            poly_normals,
+                                            vert_normals);
+    }
 
     BKE_mesh_vertex_normals_clear_dirty(&mesh_mutable);
     BKE_mesh_poly_normals_clear_dirty(&mesh_mutable);
@@ -2055,7 +2381,8 @@ static void mesh_set_custom_normals(Mesh *mesh, float (*r_custom_nors)[3], const
   short(*clnors)[2];
   const int numloops = mesh->totloop;
 
-  clnors = (short(*)[2])CustomData_get_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL);
+  clnors = (short(*)[2])CustomData_duplicate_referenced_layer(
+      &mesh->ldata, CD_CUSTOMLOOPNORMAL, numloops);
   if (clnors != nullptr) {
     memset(clnors, 0, sizeof(*clnors) * size_t(numloops));
   }
@@ -295,7 +295,8 @@ void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, const Mesh *source)
 
   float *target_mask;
   if (CustomData_has_layer(&target->vdata, CD_PAINT_MASK)) {
-    target_mask = (float *)CustomData_get_layer(&target->vdata, CD_PAINT_MASK);
+    target_mask = (float *)CustomData_get_layer_for_write(
+        &target->vdata, CD_PAINT_MASK, target->totvert);
   }
   else {
     target_mask = (float *)CustomData_add_layer(
@@ -384,19 +385,17 @@ void BKE_remesh_reproject_vertex_paint(Mesh *target, const Mesh *source)
     const CustomData *source_cdata = domain == ATTR_DOMAIN_POINT ? &source->vdata : &source->ldata;
 
     /* Check attribute exists in target. */
-    int layer_i = CustomData_get_named_layer_index(target_cdata, layer->type, layer->name);
-    if (layer_i == -1) {
-      int elem_num = domain == ATTR_DOMAIN_POINT ? target->totvert : target->totloop;
-
+    const int elem_num = domain == ATTR_DOMAIN_POINT ? target->totvert : target->totloop;
+    if (CustomData_get_named_layer_index(target_cdata, layer->type, layer->name) == -1) {
       CustomData_add_layer_named(
           target_cdata, layer->type, CD_SET_DEFAULT, nullptr, elem_num, layer->name);
-      layer_i = CustomData_get_named_layer_index(target_cdata, layer->type, layer->name);
     }
 
     size_t data_size = CustomData_sizeof(layer->type);
-    void *target_data = target_cdata->layers[layer_i].data;
+    void *target_data = CustomData_get_layer_named_for_write(
+        target_cdata, layer->type, layer->name, elem_num);
     void *source_data = layer->data;
-    MVert *target_verts = (MVert *)CustomData_get_layer(&target->vdata, CD_MVERT);
+    const MVert *target_verts = (const MVert *)CustomData_get_layer(&target->vdata, CD_MVERT);
 
     if (domain == ATTR_DOMAIN_POINT) {
       for (int i = 0; i < target->totvert; i++) {
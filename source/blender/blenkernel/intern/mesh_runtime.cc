@@ -13,6 +13,7 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_math_geom.h"
 #include "BLI_task.hh"
 
@@ -90,6 +91,8 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int /*flag*/)
   runtime->bvh_cache = nullptr;
   runtime->shrinkwrap_data = nullptr;
   runtime->subsurf_face_dot_tags = nullptr;
+  runtime->vert_to_loop_cache = nullptr;
+  runtime->bvh_stash = nullptr;
 
   runtime->vert_normals_dirty = true;
   runtime->poly_normals_dirty = true;
@@ -112,6 +115,28 @@ void BKE_mesh_runtime_clear_cache(Mesh *mesh)
   BKE_mesh_clear_derived_normals(mesh);
 }
 
+uint32_t BKE_mesh_topology_hash(const Mesh *mesh)
+{
+  const Span<MEdge> edges = mesh->edges();
+  const Span<MPoly> polys = mesh->polys();
+  const Span<MLoop> loops = mesh->loops();
+
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  BLI_hash_mm2a_add_int(&mm2, mesh->totvert);
+  /* Only add the fields that define connectivity, other fields like flags change more often. */
+  for (const MEdge &edge : edges) {
+    BLI_hash_mm2a_add_int(&mm2, int(edge.v1));
+    BLI_hash_mm2a_add_int(&mm2, int(edge.v2));
+  }
+  for (const MPoly &poly : polys) {
+    BLI_hash_mm2a_add_int(&mm2, poly.loopstart);
+    BLI_hash_mm2a_add_int(&mm2, poly.totloop);
+  }
+  BLI_hash_mm2a_add(&mm2, reinterpret_cast<const uchar *>(loops.data()), loops.size_in_bytes());
+  return BLI_hash_mm2a_end(&mm2);
+}
+
 blender::Span<MLoopTri> Mesh::looptris() const
 {
   const MLoopTri *looptris = BKE_mesh_runtime_looptri_ensure(this);
@@ -276,6 +301,9 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.subdiv_ccg = nullptr;
   }
   BKE_shrinkwrap_discard_boundary_data(mesh);
+  BKE_mesh_vert_to_loop_cache_release(mesh);
+  BKE_bvhtree_stash_free(mesh->runtime.bvh_stash);
+  mesh->runtime.bvh_stash = nullptr;
 
   MEM_SAFE_FREE(mesh->runtime.subsurf_face_dot_tags);
 }
@@ -284,10 +312,8 @@ void BKE_mesh_tag_coords_changed(Mesh *mesh)
 {
   BKE_mesh_normals_tag_dirty(mesh);
   MEM_SAFE_FREE(mesh->runtime.looptris.array);
-  if (mesh->runtime.bvh_cache) {
-    bvhcache_free(mesh->runtime.bvh_cache);
-    mesh->runtime.bvh_cache = nullptr;
-  }
+  /* The topology did not change, so the BVH tree can be refitted when it is needed again. */
+  BKE_bvhtree_stash_from_mesh_cache(mesh);
 }
 
 void BKE_mesh_tag_coords_changed_uniformly(Mesh *mesh)
@@ -314,6 +340,7 @@ void BKE_mesh_tag_coords_changed_uniformly(Mesh *mesh)
 /* Draw Engine */
 void (*BKE_mesh_batch_cache_dirty_tag_cb)(Mesh *me, eMeshBatchDirtyMode mode) = nullptr;
 void (*BKE_mesh_batch_cache_free_cb)(Mesh *me) = nullptr;
+void (*BKE_mesh_batch_cache_free_data_cb)(void *batch_cache) = nullptr;
 
 void BKE_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
 {
@@ -328,6 +355,72 @@ void BKE_mesh_batch_cache_free(Mesh *me)
   }
 }
 
+struct MeshBatchCacheStash {
+  void *batch_cache;
+
+  /** The topology of the mesh the batch cache was created for. */
+  uint32_t topology_hash;
+  int verts_num;
+  int edges_num;
+  int polys_num;
+  int loops_num;
+};
+
+/**
+ * Only the positions of meshes created by deform modifiers can change without a change of their
+ * input mesh. Edit-mode wrappers are drawn from the batch cache of the input mesh instead.
+ */
+static bool mesh_batch_cache_stash_supported(const Mesh *mesh)
+{
+  return mesh->runtime.deformed_only && mesh->runtime.wrapper_type == ME_WRAPPER_TYPE_MDATA &&
+         mesh->edit_mesh == nullptr;
+}
+
+MeshBatchCacheStash *BKE_mesh_batch_cache_stash_take(Mesh *mesh)
+{
+  if (mesh->runtime.batch_cache == nullptr || !mesh_batch_cache_stash_supported(mesh)) {
+    return nullptr;
+  }
+  MeshBatchCacheStash *stash = MEM_cnew<MeshBatchCacheStash>(__func__);
+  stash->batch_cache = mesh->runtime.batch_cache;
+  stash->topology_hash = BKE_mesh_topology_hash(mesh);
+  stash->verts_num = mesh->totvert;
+  stash->edges_num = mesh->totedge;
+  stash->polys_num = mesh->totpoly;
+  stash->loops_num = mesh->totloop;
+  mesh->runtime.batch_cache = nullptr;
+  return stash;
+}
+
+void BKE_mesh_batch_cache_stash_assign(MeshBatchCacheStash *stash,
+                                       Mesh *mesh,
+                                       const Mesh *mesh_input)
+{
+  if (stash == nullptr) {
+    return;
+  }
+  /* Any change of the input mesh may have changed attributes that are in the cache. */
+  if (mesh->runtime.batch_cache != nullptr || mesh_input->id.recalc != 0 ||
+      !mesh_batch_cache_stash_supported(mesh) || stash->verts_num != mesh->totvert ||
+      stash->edges_num != mesh->totedge || stash->polys_num != mesh->totpoly ||
+      stash->loops_num != mesh->totloop || stash->topology_hash != BKE_mesh_topology_hash(mesh)) {
+    BKE_mesh_batch_cache_stash_free(stash);
+    return;
+  }
+  mesh->runtime.batch_cache = stash->batch_cache;
+  MEM_freeN(stash);
+  BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_DEFORM);
+}
+
+void BKE_mesh_batch_cache_stash_free(MeshBatchCacheStash *stash)
+{
+  if (stash == nullptr) {
+    return;
+  }
+  BKE_mesh_batch_cache_free_data_cb(stash->batch_cache);
+  MEM_freeN(stash);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -373,7 +466,8 @@ bool BKE_mesh_runtime_is_valid(Mesh *me_eval)
       verts.size(),
       edges.data(),
       edges.size(),
-      static_cast<MFace *>(CustomData_get_layer(&me_eval->fdata, CD_MFACE)),
+      static_cast<MFace *>(
+          CustomData_get_layer_for_write(&me_eval->fdata, CD_MFACE, me_eval->totface)),
       me_eval->totface,
       loops.data(),
       loops.size(),
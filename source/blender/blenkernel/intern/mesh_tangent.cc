@@ -120,10 +120,11 @@ void BKE_mesh_calc_loop_tangent_single(Mesh *mesh,
 
   /* Check we have valid texture coordinates first! */
   if (uvmap) {
-    loopuvs = static_cast<MLoopUV *>(CustomData_get_layer_named(&mesh->ldata, CD_MLOOPUV, uvmap));
+    loopuvs = static_cast<const MLoopUV *>(
+        CustomData_get_layer_named(&mesh->ldata, CD_MLOOPUV, uvmap));
   }
   else {
-    loopuvs = static_cast<MLoopUV *>(CustomData_get_layer(&mesh->ldata, CD_MLOOPUV));
+    loopuvs = static_cast<const MLoopUV *>(CustomData_get_layer(&mesh->ldata, CD_MLOOPUV));
   }
   if (!loopuvs) {
     BKE_reportf(reports,
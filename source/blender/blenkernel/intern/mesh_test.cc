@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_mesh_runtime.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BLI_math_vector.h"
+
+namespace blender::bke::tests {
+
+static Mesh *create_test_mesh(const int verts_num)
+{
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, 0, 0, 0, 0);
+  MutableSpan<MVert> verts = mesh->verts_for_write();
+  for (const int i : verts.index_range()) {
+    verts[i].co[0] = float(i);
+  }
+  return mesh;
+}
+
+static Mesh *copy_mesh(const Mesh *mesh, const int flag)
+{
+  return reinterpret_cast<Mesh *>(
+      BKE_id_copy_ex(nullptr, &mesh->id, nullptr, LIB_ID_COPY_LOCALIZE | flag));
+}
+
+TEST(mesh, sculpt_during_copy_on_write)
+{
+  BKE_idtype_init();
+  Mesh *mesh = create_test_mesh(4);
+
+  /* Sculpt mode keeps the vertex array of the original mesh, see `SculptSession.mvert`. */
+  MVert *sculpt_verts = BKE_mesh_verts_for_write(mesh);
+
+  Mesh *mesh_cow = copy_mesh(mesh, LIB_ID_COPY_SET_COPIED_ON_WRITE);
+  EXPECT_NE(BKE_mesh_verts(mesh_cow), sculpt_verts);
+
+  /* A stroke writes through the kept pointer, other write access must not invalidate it. */
+  sculpt_verts[0].co[0] = 10.0f;
+  EXPECT_EQ(BKE_mesh_verts_for_write(mesh), sculpt_verts);
+  EXPECT_EQ(BKE_mesh_verts(mesh_cow)[0].co[0], 0.0f);
+
+  BKE_id_free(nullptr, mesh_cow);
+  EXPECT_EQ(BKE_mesh_verts(mesh), sculpt_verts);
+  EXPECT_EQ(sculpt_verts[0].co[0], 10.0f);
+  EXPECT_EQ(sculpt_verts[3].co[0], 3.0f);
+
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST(mesh, write_to_shared_copy)
+{
+  BKE_idtype_init();
+  Mesh *mesh = create_test_mesh(4);
+  Mesh *mesh_copy = copy_mesh(mesh, LIB_ID_COPY_CD_SHARE);
+  EXPECT_EQ(BKE_mesh_verts(mesh_copy), BKE_mesh_verts(mesh));
+
+  /* Writing to the copy makes it a private copy of the layer, the source is unchanged. */
+  MVert *copy_verts = BKE_mesh_verts_for_write(mesh_copy);
+  EXPECT_NE(copy_verts, BKE_mesh_verts(mesh));
+  copy_verts[0].co[0] = 10.0f;
+  EXPECT_EQ(BKE_mesh_verts(mesh)[0].co[0], 0.0f);
+
+  BKE_id_free(nullptr, mesh_copy);
+  EXPECT_EQ(BKE_mesh_verts(mesh)[3].co[0], 3.0f);
+  BKE_id_free(nullptr, mesh);
+}
+
+/**
+ * Two quads folded at a right angle along their shared edge. With \a flip, the corners of the
+ * second quad are in the opposite order.
+ */
+static Mesh *create_folded_quads(const bool flip)
+{
+  Mesh *mesh = BKE_mesh_new_nomain(6, 0, 0, 8, 2);
+  const float positions[6][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}};
+  MutableSpan<MVert> verts = mesh->verts_for_write();
+  for (const int i : verts.index_range()) {
+    copy_v3_v3(verts[i].co, positions[i]);
+  }
+  const int corner_verts[8] = {0, 1, 2, 3, 1, 4, 5, 2};
+  MutableSpan<MLoop> loops = mesh->loops_for_write();
+  for (const int i : loops.index_range()) {
+    loops[i].v = corner_verts[(flip && i >= 4) ? 11 - i : i];
+  }
+  MutableSpan<MPoly> polys = mesh->polys_for_write();
+  for (const int i : polys.index_range()) {
+    polys[i].loopstart = i * 4;
+    polys[i].totloop = 4;
+  }
+  BKE_mesh_calc_edges(mesh, false, false);
+  return mesh;
+}
+
+static void expect_vertex_normals_eq(const Mesh *mesh, const Mesh *mesh_expected)
+{
+  const float(*normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
+  const float(*normals_expected)[3] = BKE_mesh_vertex_normals_ensure(mesh_expected);
+  for (const int i : IndexRange(mesh->totvert)) {
+    EXPECT_V3_NEAR(normals[i], normals_expected[i], 1e-6f);
+  }
+}
+
+TEST(mesh, vertex_normals_after_topology_change)
+{
+  BKE_idtype_init();
+  /* Meshes that are not copied don't have a vertex to corner map, so they are used as a
+   * reference for the normals calculated with the map. */
+  Mesh *mesh_expected = create_folded_quads(false);
+  Mesh *mesh_expected_flipped = create_folded_quads(true);
+
+  Mesh *mesh = create_folded_quads(false);
+  Mesh *mesh_copy = copy_mesh(mesh, LIB_ID_COPY_CD_SHARE);
+  EXPECT_NE(mesh_copy->runtime.vert_to_loop_cache, nullptr);
+  EXPECT_EQ(mesh_copy->runtime.vert_to_loop_cache, mesh->runtime.vert_to_loop_cache);
+  expect_vertex_normals_eq(mesh_copy, mesh_expected);
+
+  /* Flipping the second quad of the copy must not use the map built for the source mesh. */
+  const int topology_update_count = mesh_copy->runtime.topology_update_count;
+  MutableSpan<MLoop> loops = mesh_copy->loops_for_write();
+  std::swap(loops[4].v, loops[7].v);
+  std::swap(loops[5].v, loops[6].v);
+  BKE_mesh_calc_edges(mesh_copy, false, false);
+  BKE_mesh_normals_tag_dirty(mesh_copy);
+  EXPECT_NE(mesh_copy->runtime.topology_update_count, topology_update_count);
+  EXPECT_NE(mesh_copy->runtime.vert_to_loop_cache, mesh->runtime.vert_to_loop_cache);
+  expect_vertex_normals_eq(mesh_copy, mesh_expected_flipped);
+
+  /* The source mesh keeps its map and its normals. */
+  EXPECT_NE(mesh->runtime.vert_to_loop_cache, nullptr);
+  expect_vertex_normals_eq(mesh, mesh_expected);
+
+  /* Clearing the runtime geometry of the source mesh, as done when its topology is replaced, also
+   * makes it stop using the map. */
+  BKE_mesh_runtime_clear_geometry(mesh);
+  EXPECT_EQ(mesh->runtime.vert_to_loop_cache, nullptr);
+  expect_vertex_normals_eq(mesh, mesh_expected);
+
+  BKE_id_free(nullptr, mesh_copy);
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, mesh_expected_flipped);
+  BKE_id_free(nullptr, mesh_expected);
+}
+
+}  // namespace blender::bke::tests
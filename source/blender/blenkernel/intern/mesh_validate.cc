@@ -1077,7 +1077,8 @@ bool BKE_mesh_validate(Mesh *me, const bool do_verbose, const bool cddata_check_
                            verts.size(),
                            edges.data(),
                            edges.size(),
-                           (MFace *)CustomData_get_layer(&me->fdata, CD_MFACE),
+                           (MFace *)CustomData_get_layer_for_write(
+                               &me->fdata, CD_MFACE, me->totface),
                            me->totface,
                            loops.data(),
                            loops.size(),
@@ -1130,7 +1131,8 @@ bool BKE_mesh_is_valid(Mesh *me)
                                        verts.size(),
                                        edges.data(),
                                        edges.size(),
-                                       (MFace *)CustomData_get_layer(&me->fdata, CD_MFACE),
+                                       (MFace *)CustomData_get_layer_for_write(
+                                           &me->fdata, CD_MFACE, me->totface),
                                        me->totface,
                                        loops.data(),
                                        loops.size(),
@@ -1182,7 +1184,7 @@ void BKE_mesh_strip_loose_faces(Mesh *me)
   /* NOTE: We need to keep this for edge creation (for now?), and some old `readfile.c` code. */
   MFace *f;
   int a, b;
-  MFace *mfaces = (MFace *)CustomData_get_layer(&me->fdata, CD_MFACE);
+  MFace *mfaces = (MFace *)CustomData_get_layer_for_write(&me->fdata, CD_MFACE, me->totface);
 
   for (a = b = 0, f = mfaces; a < me->totface; a++, f++) {
     if (f->v3) {
@@ -1502,7 +1504,7 @@ void BKE_mesh_calc_edges_legacy(Mesh *me, const bool use_old)
   MutableSpan<MLoop> loops = me->loops_for_write();
 
   mesh_calc_edges_mdata(verts.data(),
-                        (MFace *)CustomData_get_layer(&me->fdata, CD_MFACE),
+                        (const MFace *)CustomData_get_layer(&me->fdata, CD_MFACE),
                         loops.data(),
                         polys.data(),
                         verts.size(),
@@ -1547,9 +1549,9 @@ void BKE_mesh_calc_edges_tessface(Mesh *mesh)
 {
   const int numFaces = mesh->totface;
   EdgeSet *eh = BLI_edgeset_new_ex(__func__, BLI_EDGEHASH_SIZE_GUESS_FROM_POLYS(numFaces));
-  MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
 
-  MFace *mf = mfaces;
+  const MFace *mf = mfaces;
   for (int i = 0; i < numFaces; i++, mf++) {
     BLI_edgeset_add(eh, mf->v1, mf->v2);
     BLI_edgeset_add(eh, mf->v2, mf->v3);
@@ -1571,8 +1573,8 @@ void BKE_mesh_calc_edges_tessface(Mesh *mesh)
   CustomData_add_layer(&edgeData, CD_MEDGE, CD_SET_DEFAULT, nullptr, numEdges);
   CustomData_add_layer(&edgeData, CD_ORIGINDEX, CD_SET_DEFAULT, nullptr, numEdges);
 
-  MEdge *med = (MEdge *)CustomData_get_layer(&edgeData, CD_MEDGE);
-  int *index = (int *)CustomData_get_layer(&edgeData, CD_ORIGINDEX);
+  MEdge *med = (MEdge *)CustomData_get_layer_for_write(&edgeData, CD_MEDGE, numEdges);
+  int *index = (int *)CustomData_get_layer_for_write(&edgeData, CD_ORIGINDEX, numEdges);
 
   EdgeSetIterator *ehi = BLI_edgesetIterator_new(eh);
   for (int i = 0; BLI_edgesetIterator_isDone(ehi) == false;
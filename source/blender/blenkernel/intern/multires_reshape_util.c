@@ -103,8 +103,10 @@ static void context_init_lookup(MultiresReshapeContext *reshape_context)
 static void context_init_grid_pointers(MultiresReshapeContext *reshape_context)
 {
   Mesh *base_mesh = reshape_context->base_mesh;
-  reshape_context->mdisps = CustomData_get_layer(&base_mesh->ldata, CD_MDISPS);
-  reshape_context->grid_paint_masks = CustomData_get_layer(&base_mesh->ldata, CD_GRID_PAINT_MASK);
+  reshape_context->mdisps = CustomData_get_layer_for_write(
+      &base_mesh->ldata, CD_MDISPS, base_mesh->totloop);
+  reshape_context->grid_paint_masks = CustomData_get_layer_for_write(
+      &base_mesh->ldata, CD_GRID_PAINT_MASK, base_mesh->totloop);
 }
 
 static void context_init_commoon(MultiresReshapeContext *reshape_context)
@@ -559,7 +561,7 @@ static void ensure_displacement_grid(MDisps *displacement_grid, const int level)
 static void ensure_displacement_grids(Mesh *mesh, const int grid_level)
 {
   const int num_grids = mesh->totloop;
-  MDisps *mdisps = CustomData_get_layer(&mesh->ldata, CD_MDISPS);
+  MDisps *mdisps = CustomData_get_layer_for_write(&mesh->ldata, CD_MDISPS, mesh->totloop);
   for (int grid_index = 0; grid_index < num_grids; grid_index++) {
     ensure_displacement_grid(&mdisps[grid_index], grid_level);
   }
@@ -567,7 +569,8 @@ static void ensure_displacement_grids(Mesh *mesh, const int grid_level)
 
 static void ensure_mask_grids(Mesh *mesh, const int level)
 {
-  GridPaintMask *grid_paint_masks = CustomData_get_layer(&mesh->ldata, CD_GRID_PAINT_MASK);
+  GridPaintMask *grid_paint_masks = CustomData_get_layer_for_write(
+      &mesh->ldata, CD_GRID_PAINT_MASK, mesh->totloop);
   if (grid_paint_masks == NULL) {
     return;
   }
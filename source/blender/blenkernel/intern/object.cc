@@ -69,6 +69,7 @@
 #include "BKE_armature.h"
 #include "BKE_asset.h"
 #include "BKE_bpath.h"
+#include "BKE_bvhutils.h"
 #include "BKE_camera.h"
 #include "BKE_collection.h"
 #include "BKE_constraint.h"
@@ -282,6 +283,10 @@ static void object_free_data(ID *id)
   MEM_SAFE_FREE(ob->matbits);
   MEM_SAFE_FREE(ob->iuser);
   MEM_SAFE_FREE(ob->runtime.bb);
+  BKE_bvhtree_stash_free(ob->runtime.bvh_stash);
+  ob->runtime.bvh_stash = nullptr;
+  BKE_mesh_batch_cache_stash_free(ob->runtime.batch_cache_stash);
+  ob->runtime.batch_cache_stash = nullptr;
 
   BLI_freelistN(&ob->fmaps);
   if (ob->pose) {
@@ -1755,6 +1760,23 @@ void BKE_object_eval_assign_data(Object *object_eval, ID *data_eval, bool is_own
     data_eval->tag |= LIB_TAG_COPIED_ON_WRITE_EVAL_RESULT;
   }
 
+  if (is_owned && GS(data_eval->name) == ID_ME) {
+    BKE_bvhtree_stash_assign_to_mesh(object_eval->runtime.bvh_stash,
+                                     reinterpret_cast<Mesh *>(data_eval));
+    object_eval->runtime.bvh_stash = nullptr;
+    /* The object data is still the input mesh of the modifier stack here. */
+    const ID *data_input = static_cast<const ID *>(object_eval->data);
+    if (GS(data_input->name) == ID_ME) {
+      BKE_mesh_batch_cache_stash_assign(object_eval->runtime.batch_cache_stash,
+                                        reinterpret_cast<Mesh *>(data_eval),
+                                        reinterpret_cast<const Mesh *>(data_input));
+    }
+    else {
+      BKE_mesh_batch_cache_stash_free(object_eval->runtime.batch_cache_stash);
+    }
+    object_eval->runtime.batch_cache_stash = nullptr;
+  }
+
   /* Assigned evaluated data. */
   object_eval->runtime.data_eval = data_eval;
   object_eval->runtime.is_data_eval_owned = is_owned;
@@ -5111,12 +5133,15 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int /*flag*/)
 
   runtime->crazyspace_deform_imats = nullptr;
   runtime->crazyspace_deform_cos = nullptr;
+  runtime->bvh_stash = nullptr;
+  runtime->batch_cache_stash = nullptr;
 }
 
 void BKE_object_runtime_free_data(Object *object)
 {
-  /* Currently this is all that's needed. */
   BKE_object_free_derived_caches(object);
+  BKE_bvhtree_stash_free(object->runtime.bvh_stash);
+  BKE_mesh_batch_cache_stash_free(object->runtime.batch_cache_stash);
 
   BKE_object_runtime_reset(object);
 }
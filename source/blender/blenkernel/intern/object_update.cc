@@ -23,6 +23,7 @@
 #include "BKE_DerivedMesh.h"
 #include "BKE_action.h"
 #include "BKE_armature.h"
+#include "BKE_bvhutils.h"
 #include "BKE_constraint.h"
 #include "BKE_curve.h"
 #include "BKE_curves.h"
@@ -53,6 +54,19 @@
 
 void BKE_object_eval_reset(Object *ob_eval)
 {
+  /* Keep the BVH tree of the previous evaluated mesh, it can be refitted when the next one has
+   * the same topology. */
+  if (ob_eval->runtime.data_eval != nullptr && ob_eval->runtime.is_data_eval_owned &&
+      GS(ob_eval->runtime.data_eval->name) == ID_ME) {
+    BKE_bvhtree_stash_free(ob_eval->runtime.bvh_stash);
+    ob_eval->runtime.bvh_stash = BKE_bvhtree_stash_take_from_mesh(
+        reinterpret_cast<Mesh *>(ob_eval->runtime.data_eval));
+    /* Same for the draw cache, the buffers that don't depend on positions can be kept if the
+     * mesh is only deformed again. */
+    BKE_mesh_batch_cache_stash_free(ob_eval->runtime.batch_cache_stash);
+    ob_eval->runtime.batch_cache_stash = BKE_mesh_batch_cache_stash_take(
+        reinterpret_cast<Mesh *>(ob_eval->runtime.data_eval));
+  }
   BKE_object_free_derived_caches(ob_eval);
 }
 
@@ -30,6 +30,7 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -968,11 +969,12 @@ void free_keyed_keys(ParticleSystem *psys)
     }
   }
 }
-static void free_child_path_cache(ParticleSystem *psys)
+void psys_free_child_path_cache(ParticleSystem *psys)
 {
   psys_free_path_cache_buffers(psys->childcache, &psys->childcachebufs);
   psys->childcache = NULL;
   psys->totchildcache = 0;
+  psys->childcache_hash = 0;
 }
 void psys_free_path_cache(ParticleSystem *psys, PTCacheEdit *edit)
 {
@@ -986,7 +988,7 @@ void psys_free_path_cache(ParticleSystem *psys, PTCacheEdit *edit)
     psys->pathcache = NULL;
     psys->totcached = 0;
 
-    free_child_path_cache(psys);
+    psys_free_child_path_cache(psys);
   }
 }
 void psys_free_children(ParticleSystem *psys)
@@ -997,7 +999,7 @@ void psys_free_children(ParticleSystem *psys)
     psys->totchild = 0;
   }
 
-  free_child_path_cache(psys);
+  psys_free_child_path_cache(psys);
 }
 void psys_free_particles(ParticleSystem *psys)
 {
@@ -1670,8 +1672,8 @@ static void interpolate_pathcache(ParticleCacheKey *first, float t, ParticleCach
 void psys_interpolate_face(Mesh *mesh,
                            const MVert *mvert,
                            const float (*vert_normals)[3],
-                           MFace *mface,
-                           MTFace *tface,
+                           const MFace *mface,
+                           const MTFace *tface,
                            const float (*orcodata)[3],
                            float w[4],
                            float vec[3],
@@ -1682,7 +1684,7 @@ void psys_interpolate_face(Mesh *mesh,
 {
   const float *v1 = 0, *v2 = 0, *v3 = 0, *v4 = 0;
   float e1[3], e2[3], s1, s2, t1, t2;
-  float *uv1, *uv2, *uv3, *uv4;
+  const float *uv1, *uv2, *uv3, *uv4;
   float n1[3], n2[3], n3[3], n4[3];
   float tuv[4][2];
   const float *o1, *o2, *o3, *o4;
@@ -1736,11 +1738,11 @@ void psys_interpolate_face(Mesh *mesh,
       uv2 = tuv[1];
       uv3 = tuv[2];
       uv4 = tuv[3];
-      map_to_sphere(uv1, uv1 + 1, v1[0], v1[1], v1[2]);
-      map_to_sphere(uv2, uv2 + 1, v2[0], v2[1], v2[2]);
-      map_to_sphere(uv3, uv3 + 1, v3[0], v3[1], v3[2]);
+      map_to_sphere(tuv[0], tuv[0] + 1, v1[0], v1[1], v1[2]);
+      map_to_sphere(tuv[1], tuv[1] + 1, v2[0], v2[1], v2[2]);
+      map_to_sphere(tuv[2], tuv[2] + 1, v3[0], v3[1], v3[2]);
       if (v4) {
-        map_to_sphere(uv4, uv4 + 1, v4[0], v4[1], v4[2]);
+        map_to_sphere(tuv[3], tuv[3] + 1, v4[0], v4[1], v4[2]);
       }
     }
 
@@ -1856,8 +1858,8 @@ static float psys_interpolate_value_from_verts(
       return values[index];
     case PART_FROM_FACE:
     case PART_FROM_VOLUME: {
-      MFace *mfaces = CustomData_get_layer(&mesh->fdata, CD_MFACE);
-      MFace *mf = &mfaces[index];
+      const MFace *mfaces = CustomData_get_layer(&mesh->fdata, CD_MFACE);
+      const MFace *mf = &mfaces[index];
       return interpolate_particle_value(
           values[mf->v1], values[mf->v2], values[mf->v3], values[mf->v4], fw, mf->v4);
     }
@@ -1873,7 +1875,10 @@ static void psys_w_to_origspace(const float w[4], float uv[2])
 }
 
 /* conversion of pa->fw to weights in face from origspace */
-static void psys_origspace_to_w(OrigSpaceFace *osface, int quad, const float w[4], float neww[4])
+static void psys_origspace_to_w(const OrigSpaceFace *osface,
+                                int quad,
+                                const float w[4],
+                                float neww[4])
 {
   float v[4][3], co[3];
 
@@ -1908,7 +1913,7 @@ int psys_particle_dm_face_lookup(Mesh *mesh_final,
                                  const float fw[4],
                                  struct LinkNode **poly_nodes)
 {
-  MFace *mtessface_final;
+  const MFace *mtessface_final;
   const OrigSpaceFace *osface_final;
   int pindex_orig;
   float uv[2];
@@ -2065,7 +2070,7 @@ static int psys_map_index_on_dm(Mesh *mesh,
 
       /* modify the original weights to become
        * weights for the derived mesh face */
-      OrigSpaceFace *osface = CustomData_get_layer(&mesh->fdata, CD_ORIGSPACE);
+      const OrigSpaceFace *osface = CustomData_get_layer(&mesh->fdata, CD_ORIGSPACE);
       const MFace *mfaces = CustomData_get_layer(&mesh->fdata, CD_MFACE);
       const MFace *mface = &mfaces[i];
 
@@ -2146,13 +2151,13 @@ void psys_particle_on_dm(Mesh *mesh_final,
     }
   }
   else { /* PART_FROM_FACE / PART_FROM_VOLUME */
-    MFace *mface;
-    MTFace *mtface;
-    MVert *mvert;
+    const MFace *mface;
+    const MTFace *mtface;
+    const MVert *mvert;
 
-    MFace *mfaces = CustomData_get_layer(&mesh_final->fdata, CD_MFACE);
+    const MFace *mfaces = CustomData_get_layer(&mesh_final->fdata, CD_MFACE);
     mface = &mfaces[mapindex];
-    mvert = BKE_mesh_verts_for_write(mesh_final);
+    mvert = BKE_mesh_verts(mesh_final);
     mtface = CustomData_get_layer(&mesh_final->fdata, CD_MTFACE);
 
     if (mtface) {
@@ -3163,6 +3168,70 @@ static void psys_thread_create_path(ParticleTask *task,
   }
 }
 
+static void child_paths_hash_add_buffers(BLI_HashMurmur2A *mm2, const ListBase *bufs)
+{
+  LISTBASE_FOREACH (const LinkData *, buf, bufs) {
+    BLI_hash_mm2a_add(mm2, buf->data, MEM_allocN_len(buf->data));
+  }
+}
+
+static void child_paths_hash_add_vgroup(BLI_HashMurmur2A *mm2, const float *vg, const int totvert)
+{
+  if (vg) {
+    BLI_hash_mm2a_add(mm2, (const uchar *)vg, sizeof(float) * totvert);
+  }
+}
+
+/**
+ * Hash everything the child paths are created from which can change without a particle system
+ * recalc: the parent paths, the emitter shape and its vertex group weights. Time only matters
+ * for textures and effectors.
+ *
+ * \return Zero when the child paths can't be reused.
+ */
+static int child_paths_hash(const ParticleThreadContext *ctx, const bool use_render_params)
+{
+  const ParticleSystem *psys = ctx->sim.psys;
+  const ParticleSettings *part = psys->part;
+  const Mesh *mesh = ctx->mesh;
+
+  /* Edit mode parents and lattice deformation are not part of the hash. */
+  if (psys_in_edit_mode(ctx->sim.depsgraph, psys) || psys->lattice_deform_data) {
+    return 0;
+  }
+
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  BLI_hash_mm2a_add_int(&mm2, ctx->totchild);
+  BLI_hash_mm2a_add_int(&mm2, ctx->totparent);
+  BLI_hash_mm2a_add_int(&mm2, ctx->segments);
+  BLI_hash_mm2a_add_int(&mm2, ctx->extra_segments);
+  BLI_hash_mm2a_add_int(&mm2, use_render_params);
+
+  bool use_time = (part->flag & PART_CHILD_EFFECT) != 0;
+  for (int i = 0; i < MAX_MTEX; i++) {
+    use_time |= part->mtex[i] != NULL && part->mtex[i]->tex != NULL;
+  }
+  if (use_time) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)&ctx->cfra, sizeof(ctx->cfra));
+  }
+
+  child_paths_hash_add_buffers(&mm2, &psys->pathcachebufs);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)BKE_mesh_verts(mesh), sizeof(MVert) * mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_length, mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_clump, mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_kink, mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_rough1, mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_rough2, mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_roughe, mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_twist, mesh->totvert);
+  child_paths_hash_add_vgroup(&mm2, ctx->vg_effector, mesh->totvert);
+
+  /* Zero is reserved for caches that have to be recreated. */
+  const int hash = (int)BLI_hash_mm2a_end(&mm2);
+  return hash ? hash : 1;
+}
+
 static void exec_child_path_cache(TaskPool *__restrict UNUSED(pool), void *taskdata)
 {
   ParticleTask *task = taskdata;
@@ -3191,30 +3260,48 @@ void psys_cache_child_paths(ParticleSimulationData *sim,
   int i, totchild, totparent;
 
   if (sim->psys->flag & PSYS_GLOBAL_HAIR) {
+    if (!editupdate) {
+      psys_free_child_path_cache(sim->psys);
+    }
     return;
   }
 
   /* create a task pool for child path tasks */
   if (!psys_thread_context_init_path(&ctx, sim, sim->scene, cfra, editupdate, use_render_params)) {
+    if (!editupdate) {
+      psys_free_child_path_cache(sim->psys);
+    }
     return;
   }
 
-  task_pool = BLI_task_pool_create(&ctx, TASK_PRIORITY_HIGH);
   totchild = ctx.totchild;
   totparent = ctx.totparent;
 
   if (editupdate && sim->psys->childcache && totchild == sim->psys->totchildcache) {
     /* just overwrite the existing cache */
+    sim->psys->childcache_hash = 0;
   }
   else {
+    /* Scrubbing through static hair re-evaluates the particle system on every frame, keep the
+     * children when they would be created from exactly the same data again. */
+    const int hash = editupdate ? 0 : child_paths_hash(&ctx, use_render_params);
+    if (hash && hash == sim->psys->childcache_hash && sim->psys->childcache &&
+        totchild == sim->psys->totchildcache) {
+      psys_thread_context_free(&ctx);
+      return;
+    }
+
     /* clear out old and create new empty path cache */
-    free_child_path_cache(sim->psys);
+    psys_free_child_path_cache(sim->psys);
 
     sim->psys->childcache = psys_alloc_path_cache_buffers(
         &sim->psys->childcachebufs, totchild, ctx.segments + ctx.extra_segments + 1);
     sim->psys->totchildcache = totchild;
+    sim->psys->childcache_hash = hash;
   }
 
+  task_pool = BLI_task_pool_create(&ctx, TASK_PRIORITY_HIGH);
+
   /* cache parent paths */
   ctx.parent_pass = 1;
   psys_tasks_create(&ctx, 0, totparent, &tasks_parent, &numtasks_parent);
@@ -3334,8 +3421,10 @@ void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_re
   keyed = psys->flag & PSYS_KEYED;
   baked = psys->pointcache->mem_cache.first && psys->part->type != PART_HAIR;
 
-  /* clear out old and create new empty path cache */
-  psys_free_path_cache(psys, psys->edit);
+  /* clear out old and create new empty path cache,
+   * child paths are kept so they can be reused when these paths don't change */
+  psys_free_path_cache(NULL, psys->edit);
+  psys_free_path_cache_buffers(psys->pathcache, &psys->pathcachebufs);
   cache = psys->pathcache = psys_alloc_path_cache_buffers(
       &psys->pathcachebufs, totpart, segments + 1);
 
@@ -3846,7 +3935,7 @@ static void triatomat(float *v1, float *v2, float *v3, const float (*uv)[2], flo
 static void psys_face_mat(Object *ob, Mesh *mesh, ParticleData *pa, float mat[4][4], int orco)
 {
   float v[3][3];
-  MFace *mface;
+  const MFace *mface;
   const float(*orcodata)[3];
 
   int i = ELEM(pa->num_dmcache, DMCACHE_ISCHILD, DMCACHE_NOTFOUND) ? pa->num : pa->num_dmcache;
@@ -3855,7 +3944,7 @@ static void psys_face_mat(Object *ob, Mesh *mesh, ParticleData *pa, float mat[4]
     return;
   }
 
-  MFace *mfaces = CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mfaces = CustomData_get_layer(&mesh->fdata, CD_MFACE);
   mface = &mfaces[i];
   const OrigSpaceFace *osface = CustomData_get(&mesh->fdata, i, CD_ORIGSPACE);
 
@@ -4164,8 +4253,8 @@ static int get_particle_uv(Mesh *mesh,
                            float *texco,
                            bool from_vert)
 {
-  MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
-  MFace *mf;
+  const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mf;
   const MTFace *tf;
   int i;
 
@@ -5366,6 +5455,7 @@ void BKE_particle_system_blend_read_data(BlendDataReader *reader, ListBase *part
     psys->free_edit = NULL;
     psys->pathcache = NULL;
     psys->childcache = NULL;
+    psys->childcache_hash = 0;
     BLI_listbase_clear(&psys->pathcachebufs);
     BLI_listbase_clear(&psys->childcachebufs);
     psys->pdd = NULL;
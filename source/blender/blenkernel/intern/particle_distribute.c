@@ -175,7 +175,7 @@ static void distribute_grid(Mesh *mesh, ParticleSystem *psys)
   else if (ELEM(from, PART_FROM_FACE, PART_FROM_VOLUME)) {
     float co1[3], co2[3];
 
-    MFace *mface = NULL, *mface_array;
+    const MFace *mface = NULL, *mface_array;
     float v1[3], v2[3], v3[3], v4[4], lambda;
     int a, a1, a2, a0mul, a1mul, a2mul, totface;
     int amax = from == PART_FROM_FACE ? 3 : 1;
@@ -462,7 +462,7 @@ static int distribute_binary_search(const float *sum, int n, float value)
 static void distribute_from_verts_exec(ParticleTask *thread, ParticleData *pa, int p)
 {
   ParticleThreadContext *ctx = thread->ctx;
-  MFace *mface;
+  const MFace *mface;
 
   mface = CustomData_get_layer(&ctx->mesh->fdata, CD_MFACE);
 
@@ -480,7 +480,7 @@ static void distribute_from_verts_exec(ParticleTask *thread, ParticleData *pa, i
      * map to equal-colored parts of a texture */
     for (int i = 0; i < ctx->mesh->totface; i++, mface++) {
       if (ELEM(pa->num, mface->v1, mface->v2, mface->v3, mface->v4)) {
-        uint *vert = &mface->v1;
+        const uint *vert = &mface->v1;
 
         for (int j = 0; j < 4; j++, vert++) {
           if (*vert == pa->num) {
@@ -525,8 +525,8 @@ static void distribute_from_faces_exec(ParticleTask *thread, ParticleData *pa, i
   int i;
   int rng_skip_tot = PSYS_RND_DIST_SKIP; /* count how many rng_* calls won't need skipping */
 
-  MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
-  MFace *mface;
+  const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mface;
 
   pa->num = i = ctx->index[p];
   mface = &mfaces[i];
@@ -569,17 +569,18 @@ static void distribute_from_volume_exec(ParticleTask *thread, ParticleData *pa,
 {
   ParticleThreadContext *ctx = thread->ctx;
   Mesh *mesh = ctx->mesh;
-  float *v1, *v2, *v3, *v4, nor[3], co[3];
+  const float *v1, *v2, *v3, *v4;
+  float nor[3], co[3];
   float cur_d, min_d, randu, randv;
   int distr = ctx->distr;
   int i, intersect, tot;
   int rng_skip_tot = PSYS_RND_DIST_SKIP; /* count how many rng_* calls won't need skipping */
 
-  MFace *mface;
-  MVert *mvert = BKE_mesh_verts_for_write(mesh);
+  const MFace *mface;
+  const MVert *mvert = BKE_mesh_verts(mesh);
 
   pa->num = i = ctx->index[p];
-  MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
   mface = &mfaces[i];
 
   switch (distr) {
@@ -682,7 +683,7 @@ static void distribute_children_exec(ParticleTask *thread, ChildParticle *cpa, i
   int i;
   int rng_skip_tot = PSYS_RND_DIST_SKIP; /* count how many rng_* calls won't need skipping */
 
-  MFace *mf;
+  const MFace *mf;
 
   if (ctx->index[p] < 0) {
     cpa->num = 0;
@@ -691,7 +692,7 @@ static void distribute_children_exec(ParticleTask *thread, ChildParticle *cpa, i
     return;
   }
 
-  MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
   mf = &mfaces[ctx->index[p]];
 
   randu = BLI_rng_get_float(thread->rng);
@@ -1045,9 +1046,9 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
 
     orcodata = CustomData_get_layer(&mesh->vdata, CD_ORCO);
 
-    MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+    const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
     for (i = 0; i < totelem; i++) {
-      MFace *mf = &mfaces[i];
+      const MFace *mf = &mfaces[i];
 
       if (orcodata) {
         /* Transform orcos from normalized 0..1 to object space. */
@@ -1110,9 +1111,9 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
       }
     }
     else { /* PART_FROM_FACE / PART_FROM_VOLUME */
-      MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+      const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
       for (i = 0; i < totelem; i++) {
-        MFace *mf = &mfaces[i];
+        const MFace *mf = &mfaces[i];
         tweight = vweight[mf->v1] + vweight[mf->v2] + vweight[mf->v3];
 
         if (mf->v4) {
@@ -3192,6 +3192,11 @@ static void psys_update_path_cache(ParticleSimulationData *sim,
     distr = 1;
   }
 
+  /* Settings changes are not part of the hash the child path cache is reused with. */
+  if (distr || psys->recalc) {
+    psys->childcache_hash = 0;
+  }
+
   if (distr) {
     if (alloc) {
       realloc_particles(sim, sim->psys->totpart);
@@ -3254,6 +3259,9 @@ static void psys_update_path_cache(ParticleSimulationData *sim,
         psys_cache_child_paths(sim, cfra, 0, use_render_params);
       }
     }
+    if (part->childtype == 0 || skip) {
+      psys_free_child_path_cache(psys);
+    }
   }
   else if (psys->pathcache) {
     psys_free_path_cache(psys, NULL);
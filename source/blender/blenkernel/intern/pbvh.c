@@ -234,15 +234,18 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
 
 /* Add a vertex to the map, with a positive value for unique vertices and
  * a negative value for additional vertices */
-static int map_insert_vert(PBVH *pbvh, GHash *map, uint *face_verts, uint *uniq_verts, int vertex)
+static int map_insert_vert(const bool is_unique,
+                           GHash *map,
+                           uint *face_verts,
+                           uint *uniq_verts,
+                           int vertex)
 {
   void *key, **value_p;
 
   key = POINTER_FROM_INT(vertex);
   if (!BLI_ghash_ensure_p(map, key, &value_p)) {
     int value_i;
-    if (!pbvh->vert_bitmap[vertex]) {
-      pbvh->vert_bitmap[vertex] = true;
+    if (is_unique) {
       value_i = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -257,8 +260,12 @@ static int map_insert_vert(PBVH *pbvh, GHash *map, uint *face_verts, uint *uniq_
   return POINTER_AS_INT(*value_p);
 }
 
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+/* Find vertices used by the faces in this node and update the draw buffers.
+ * A vertex is unique to the node when `vert_owner` contains the index of the leaf. */
+static void build_mesh_leaf_node(PBVH *pbvh,
+                                 PBVHNode *node,
+                                 const int *vert_owner,
+                                 const int leaf_index)
 {
   bool has_visible = false;
 
@@ -279,8 +286,12 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+      const int vertex = pbvh->mloop[lt->tri[j]].v;
+      face_vert_indices[i][j] = map_insert_vert(vert_owner[vertex] == leaf_index,
+                                                map,
+                                                &node->face_verts,
+                                                &node->uniq_verts,
+                                                vertex);
     }
 
     if (has_visible == false) {
@@ -383,12 +394,95 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
-  if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
+  /* The vertex and visibility data is gathered once the tree is complete, see
+   * #pbvh_build_leaves. */
+}
+
+typedef struct PBVHBuildLeavesData {
+  PBVH *pbvh;
+  PBVHNode **leaves;
+  /** The lowest index in #leaves of the leaves using each vertex, which owns the vertex. */
+  int *vert_owner;
+} PBVHBuildLeavesData;
+
+static void pbvh_build_vert_owner_task_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  const PBVH *pbvh = data->pbvh;
+  const PBVHNode *node = data->leaves[n];
+  int *vert_owner = data->vert_owner;
+
+  for (int i = 0; i < node->totprim; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      int *owner = &vert_owner[pbvh->mloop[lt->tri[j]].v];
+      int owner_prev = *owner;
+      while (n < owner_prev) {
+        const int owner_test = atomic_cas_int32(owner, owner_prev, n);
+        if (owner_test == owner_prev) {
+          break;
+        }
+        owner_prev = owner_test;
+      }
+    }
+  }
+}
+
+static void pbvh_build_leaf_task_cb(void *__restrict userdata,
+                                    const int n,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  if (data->pbvh->looptri) {
+    build_mesh_leaf_node(data->pbvh, data->leaves[n], data->vert_owner, n);
   }
   else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_grid_leaf_node(data->pbvh, data->leaves[n]);
+  }
+}
+
+/**
+ * Gather the vertices and visibility of all leaves in parallel.
+ *
+ * Vertices shared by multiple leaves are owned by the first of them in node order, which keeps
+ * the result deterministic regardless of the order the leaves are processed in.
+ */
+static void pbvh_build_leaves(PBVH *pbvh)
+{
+  int totleaf = 0;
+  for (int i = 0; i < pbvh->totnode; i++) {
+    if (pbvh->nodes[i].flag & PBVH_Leaf) {
+      totleaf++;
+    }
+  }
+
+  PBVHBuildLeavesData data = {
+      .pbvh = pbvh,
+      .leaves = MEM_malloc_arrayN(totleaf, sizeof(PBVHNode *), __func__),
+      .vert_owner = NULL,
+  };
+  for (int i = 0, leaf_index = 0; i < pbvh->totnode; i++) {
+    if (pbvh->nodes[i].flag & PBVH_Leaf) {
+      data.leaves[leaf_index++] = &pbvh->nodes[i];
+    }
   }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = totleaf > 1;
+
+  if (pbvh->looptri) {
+    data.vert_owner = MEM_malloc_arrayN(pbvh->totvert, sizeof(int), __func__);
+    copy_vn_i(data.vert_owner, pbvh->totvert, INT_MAX);
+    BLI_task_parallel_range(0, totleaf, &data, pbvh_build_vert_owner_task_cb, &settings);
+  }
+
+  BLI_task_parallel_range(0, totleaf, &data, pbvh_build_leaf_task_cb, &settings);
+
+  MEM_SAFE_FREE(data.vert_owner);
+  MEM_freeN(data.leaves);
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -511,6 +605,8 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 
   pbvh->totnode = 1;
   build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+
+  pbvh_build_leaves(pbvh);
 }
 
 static void pbvh_draw_args_init(PBVH *pbvh, PBVH_GPU_Args *args, PBVHNode *node)
@@ -587,6 +683,87 @@ static void pbvh_draw_args_init(PBVH *pbvh, PBVH_GPU_Args *args, PBVHNode *node)
   }
 }
 
+typedef struct PBVHBuildPrimBBData {
+  const PBVH *pbvh;
+  BBC *prim_bbc;
+} PBVHBuildPrimBBData;
+
+static void pbvh_build_looptri_bb_task_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict tls)
+{
+  PBVHBuildPrimBBData *data = userdata;
+  const PBVH *pbvh = data->pbvh;
+  const MLoopTri *lt = &pbvh->looptri[i];
+  BBC *bbc = data->prim_bbc + i;
+  BB *cb = tls->userdata_chunk;
+
+  BB_reset((BB *)bbc);
+  for (int j = 0; j < 3; j++) {
+    BB_expand((BB *)bbc, pbvh->verts[pbvh->mloop[lt->tri[j]].v].co);
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand(cb, bbc->bcentroid);
+}
+
+static void pbvh_build_grid_bb_task_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict tls)
+{
+  PBVHBuildPrimBBData *data = userdata;
+  const PBVH *pbvh = data->pbvh;
+  const CCGKey *key = &pbvh->gridkey;
+  CCGElem *grid = pbvh->grids[i];
+  BBC *bbc = data->prim_bbc + i;
+  BB *cb = tls->userdata_chunk;
+
+  BB_reset((BB *)bbc);
+  for (int j = 0; j < key->grid_area; j++) {
+    BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand(cb, bbc->bcentroid);
+}
+
+static void pbvh_build_prim_bb_reduce(const void *__restrict UNUSED(userdata),
+                                      void *__restrict chunk_join,
+                                      void *__restrict chunk)
+{
+  BB_expand_with_bb(chunk_join, chunk);
+}
+
+/**
+ * Calculate the bounds and centroid of every primitive, and the bounds of all centroids.
+ */
+static BBC *pbvh_build_prim_bb(const PBVH *pbvh, const int totprim, BB *r_cb)
+{
+  PBVHBuildPrimBBData data = {
+      .pbvh = pbvh,
+      .prim_bbc = MEM_mallocN(sizeof(BBC) * totprim, "prim_bbc"),
+  };
+
+  BB_reset(r_cb);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  settings.userdata_chunk = r_cb;
+  settings.userdata_chunk_size = sizeof(*r_cb);
+  settings.func_reduce = pbvh_build_prim_bb_reduce;
+  BLI_task_parallel_range(0,
+                          totprim,
+                          &data,
+                          pbvh->looptri ? pbvh_build_looptri_bb_task_cb :
+                                          pbvh_build_grid_bb_task_cb,
+                          &settings);
+
+  return data.prim_bbc;
+}
+
 void BKE_pbvh_build_mesh(PBVH *pbvh,
                          Mesh *mesh,
                          const MPoly *mpoly,
@@ -605,7 +782,8 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->mesh = mesh;
   pbvh->header.type = PBVH_FACES;
   pbvh->mpoly = mpoly;
-  pbvh->hide_poly = (bool *)CustomData_get_layer_named(&mesh->pdata, CD_PROP_BOOL, ".hide_poly");
+  pbvh->hide_poly = (bool *)CustomData_get_layer_named_for_write(
+      &mesh->pdata, CD_PROP_BOOL, ".hide_poly", mesh->totpoly);
   pbvh->material_indices = (const int *)CustomData_get_layer_named(
       &mesh->pdata, CD_PROP_INT32, "material_index");
   pbvh->mloop = mloop;
@@ -613,7 +791,8 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->verts = verts;
   BKE_mesh_vertex_normals_ensure(mesh);
   pbvh->vert_normals = BKE_mesh_vertex_normals_for_write(mesh);
-  pbvh->hide_vert = (bool *)CustomData_get_layer_named(&mesh->vdata, CD_PROP_BOOL, ".hide_vert");
+  pbvh->hide_vert = (bool *)CustomData_get_layer_named_for_write(
+      &mesh->vdata, CD_PROP_BOOL, ".hide_vert", mesh->totvert);
   pbvh->vert_bitmap = MEM_calloc_arrayN(totvert, sizeof(bool), "bvh->vert_bitmap");
   pbvh->totvert = totvert;
   pbvh->leaf_limit = LEAF_LIMIT;
@@ -624,26 +803,8 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->face_sets_color_seed = mesh->face_sets_color_seed;
   pbvh->face_sets_color_default = mesh->face_sets_color_default;
 
-  BB_reset(&cb);
-
   /* For each face, store the AABB and the AABB centroid */
-  prim_bbc = MEM_mallocN(sizeof(BBC) * looptri_num, "prim_bbc");
-
-  for (int i = 0; i < looptri_num; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const int sides = 3;
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < sides; j++) {
-      BB_expand((BB *)bbc, verts[pbvh->mloop[lt->tri[j]].v].co);
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  prim_bbc = pbvh_build_prim_bb(pbvh, looptri_num, &cb);
 
   if (looptri_num) {
     pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
@@ -651,9 +812,6 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
 
   MEM_freeN(prim_bbc);
 
-  /* Clear the bitmap so it can be used as an update tag later on. */
-  memset(pbvh->vert_bitmap, 0, sizeof(bool) * totvert);
-
   BKE_pbvh_update_active_vcol(pbvh, mesh);
 }
 
@@ -685,26 +843,9 @@ void BKE_pbvh_build_grids(PBVH *pbvh,
   /* We also need the base mesh for PBVH draw. */
   pbvh->mesh = me;
 
-  BB cb;
-  BB_reset(&cb);
-
   /* For each grid, store the AABB and the AABB centroid */
-  BBC *prim_bbc = MEM_mallocN(sizeof(BBC) * totgrid, "prim_bbc");
-
-  for (int i = 0; i < totgrid; i++) {
-    CCGElem *grid = grids[i];
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < gridsize * gridsize; j++) {
-      BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  BB cb;
+  BBC *prim_bbc = pbvh_build_prim_bb(pbvh, totgrid, &cb);
 
   if (totgrid) {
     pbvh_build(pbvh, &cb, prim_bbc, totgrid);
@@ -3095,7 +3236,7 @@ void pbvh_vertex_iter_init(PBVH *pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
     vi->vert_normals = pbvh->vert_normals;
     vi->hide_vert = pbvh->hide_vert;
 
-    vi->vmask = CustomData_get_layer(pbvh->vdata, CD_PAINT_MASK);
+    vi->vmask = CustomData_get_layer_for_write(pbvh->vdata, CD_PAINT_MASK, pbvh->mesh->totvert);
   }
 }
 
@@ -3192,7 +3333,8 @@ bool *BKE_pbvh_get_vert_hide_for_write(PBVH *pbvh)
   if (pbvh->hide_vert) {
     return pbvh->hide_vert;
   }
-  pbvh->hide_vert = CustomData_get_layer_named(&pbvh->mesh->vdata, CD_PROP_BOOL, ".hide_vert");
+  pbvh->hide_vert = CustomData_get_layer_named_for_write(
+      &pbvh->mesh->vdata, CD_PROP_BOOL, ".hide_vert", pbvh->mesh->totvert);
   if (pbvh->hide_vert) {
     return pbvh->hide_vert;
   }
@@ -3214,8 +3356,10 @@ void BKE_pbvh_face_sets_set(PBVH *pbvh, int *face_sets)
 void BKE_pbvh_update_hide_attributes_from_mesh(PBVH *pbvh)
 {
   if (pbvh->header.type == PBVH_FACES) {
-    pbvh->hide_vert = CustomData_get_layer_named(&pbvh->mesh->vdata, CD_PROP_BOOL, ".hide_vert");
-    pbvh->hide_poly = CustomData_get_layer_named(&pbvh->mesh->pdata, CD_PROP_BOOL, ".hide_poly");
+    pbvh->hide_vert = CustomData_get_layer_named_for_write(
+        &pbvh->mesh->vdata, CD_PROP_BOOL, ".hide_vert", pbvh->mesh->totvert);
+    pbvh->hide_poly = CustomData_get_layer_named_for_write(
+        &pbvh->mesh->pdata, CD_PROP_BOOL, ".hide_poly", pbvh->mesh->totpoly);
   }
 }
 
@@ -11,6 +11,7 @@
 #include "BLI_heap_simple.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_DerivedMesh.h"
@@ -923,54 +924,132 @@ static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
-static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/* Return true if the face faces the view (when used) and is in range of the queue. */
+static bool edge_queue_face_in_range(const EdgeQueue *q, BMFace *f)
 {
 #ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  if (q->use_view_normal) {
+    if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+      return false;
     }
   }
 #endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    /* Check each edge of the face */
-    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    BMLoop *l_iter = l_first;
-    do {
+  return q->edge_queue_tri_in_range(q, f);
+}
+
+static void long_edge_queue_face_edges_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  /* Check each edge of the face */
+  BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  BMLoop *l_iter = l_first;
+  do {
 #ifdef USE_EDGEQUEUE_EVEN_SUBDIV
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->q->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
-      }
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->q->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
+    }
 #else
-      long_edge_queue_edge_add(eq_ctx, l_iter->e);
+    long_edge_queue_edge_add(eq_ctx, l_iter->e);
 #endif
-    } while ((l_iter = l_iter->next) != l_first);
+  } while ((l_iter = l_iter->next) != l_first);
+}
+
+static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  if (edge_queue_face_in_range(eq_ctx->q, f)) {
+    long_edge_queue_face_edges_add(eq_ctx, f);
   }
 }
 
-static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+static void short_edge_queue_face_edges_add(EdgeQueueContext *eq_ctx, BMFace *f)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  BMLoop *l_iter;
+  BMLoop *l_first;
+
+  /* Check each edge of the face */
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    short_edge_queue_edge_add(eq_ctx, l_iter->e);
+  } while ((l_iter = l_iter->next) != l_first);
+}
+
+/* Faces of a node that are in range of the edge queue. */
+typedef struct EdgeQueueNodeFaces {
+  PBVHNode *node;
+  BMFace **faces;
+  int faces_num;
+} EdgeQueueNodeFaces;
+
+typedef struct EdgeQueueFacesGatherData {
+  const EdgeQueue *q;
+  EdgeQueueNodeFaces *node_faces;
+} EdgeQueueFacesGatherData;
+
+static void edge_queue_node_faces_gather_task_cb(void *__restrict userdata,
+                                                 const int n,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EdgeQueueFacesGatherData *data = userdata;
+  EdgeQueueNodeFaces *node_faces = &data->node_faces[n];
+  GSet *bm_faces = node_faces->node->bm_faces;
+
+  node_faces->faces = MEM_malloc_arrayN(BLI_gset_len(bm_faces), sizeof(BMFace *), __func__);
+  node_faces->faces_num = 0;
+
+  GSetIterator gs_iter;
+  GSET_ITER (gs_iter, bm_faces) {
+    BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+    if (edge_queue_face_in_range(data->q, f)) {
+      node_faces->faces[node_faces->faces_num++] = f;
     }
   }
-#endif
+}
+
+/**
+ * Call \a face_edges_add_fn for the faces in range of the queue of all leaf nodes marked for
+ * topology update.
+ *
+ * Testing the faces is read-only and done in parallel for all nodes, adding the edges to the
+ * queue tags them and is done afterwards, in the same order as iterating over the nodes.
+ */
+static void edge_queue_faces_add(EdgeQueueContext *eq_ctx,
+                                 PBVH *pbvh,
+                                 void (*face_edges_add_fn)(EdgeQueueContext *eq_ctx, BMFace *f))
+{
+  EdgeQueueNodeFaces *node_faces = MEM_malloc_arrayN(
+      pbvh->totnode, sizeof(*node_faces), __func__);
+  int node_faces_num = 0;
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+  for (int n = 0; n < pbvh->totnode; n++) {
+    PBVHNode *node = &pbvh->nodes[n];
 
-    /* Check each edge of the face */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
+    /* Check leaf nodes marked for topology update */
+    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
+        !(node->flag & PBVH_FullyHidden) && BLI_gset_len(node->bm_faces) != 0) {
+      node_faces[node_faces_num++].node = node;
+    }
+  }
+
+  EdgeQueueFacesGatherData data = {
+      .q = eq_ctx->q,
+      .node_faces = node_faces,
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, node_faces_num);
+  BLI_task_parallel_range(
+      0, node_faces_num, &data, edge_queue_node_faces_gather_task_cb, &settings);
+
+  for (int i = 0; i < node_faces_num; i++) {
+    for (int j = 0; j < node_faces[i].faces_num; j++) {
+      face_edges_add_fn(eq_ctx, node_faces[i].faces[j]);
+    }
+    MEM_freeN(node_faces[i].faces);
   }
+
+  MEM_freeN(node_faces);
 }
 
 /* Create a priority queue containing vertex pairs connected by a long
@@ -1018,22 +1097,7 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_faces_add(eq_ctx, pbvh, long_edge_queue_face_edges_add);
 }
 
 /* Create a priority queue containing vertex pairs connected by a
@@ -1077,22 +1141,7 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_faces_add(eq_ctx, pbvh, short_edge_queue_face_edges_add);
 }
 
 /*************************** Topology update **************************/
@@ -76,6 +76,11 @@
 #  include "LzmaLib.h"
 #endif
 
+#include <zstd.h>
+
+/* Compression level used for #PTCACHE_COMPRESS_ZSTD. */
+#define PTCACHE_ZSTD_LEVEL 3
+
 /* needed for directory lookup */
 #ifndef WIN32
 #  include <dirent.h>
@@ -1497,6 +1502,35 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
+/**
+ * Regroup the bytes of 32-bit values by significance: first byte of all values, then the second
+ * byte of all values, etc. Cached data is made of floats and integers, whose high bytes change far
+ * less than their low bytes between neighboring values, which makes the result compress better.
+ * Trailing bytes that don't make up a full value are copied as they are.
+ */
+static void ptcache_bytes_shuffle(uchar *dst, const uchar *src, const uint len)
+{
+  const uint values_num = len / 4;
+  for (uint i = 0; i < values_num; i++) {
+    for (uint b = 0; b < 4; b++) {
+      dst[b * values_num + i] = src[i * 4 + b];
+    }
+  }
+  memcpy(dst + values_num * 4, src + values_num * 4, len - values_num * 4);
+}
+
+/** Revert #ptcache_bytes_shuffle. */
+static void ptcache_bytes_unshuffle(uchar *dst, const uchar *src, const uint len)
+{
+  const uint values_num = len / 4;
+  for (uint i = 0; i < values_num; i++) {
+    for (uint b = 0; b < 4; b++) {
+      dst[i * 4 + b] = src[b * values_num + i];
+    }
+  }
+  memcpy(dst + values_num * 4, src + values_num * 4, len - values_num * 4);
+}
+
 static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len)
 {
   int r = 0;
@@ -1534,6 +1568,17 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == 3) {
+        uchar *shuffled = MEM_mallocN(MAX2(len, 1), "pointcache_zstd_buffer");
+        const size_t out_len = ZSTD_decompress(shuffled, len, in, in_len);
+        if (ZSTD_isError(out_len) || out_len != len) {
+          r = 1;
+        }
+        else {
+          ptcache_bytes_unshuffle(result, shuffled, len);
+        }
+        MEM_freeN(shuffled);
+      }
       MEM_freeN(in);
     }
   }
@@ -1595,6 +1640,21 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == PTCACHE_COMPRESS_ZSTD) {
+    /* All callers allocate at least #LZO_OUT_LEN for the output. */
+    BLI_assert(ZSTD_compressBound(in_len) <= LZO_OUT_LEN(in_len));
+    uchar *shuffled = MEM_mallocN(MAX2(in_len, 1), "pointcache_zstd_buffer");
+    ptcache_bytes_shuffle(shuffled, in, in_len);
+    out_len = ZSTD_compress(out, ZSTD_compressBound(in_len), shuffled, in_len, PTCACHE_ZSTD_LEVEL);
+    MEM_freeN(shuffled);
+
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = 3;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
   if (compressed) {
@@ -19,6 +19,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -1117,7 +1118,8 @@ void BKE_rigidbody_validate_sim_world(Scene *scene, RigidBodyWorld *rbw, bool re
     if (rbw->shared->physics_world) {
       RB_dworld_delete(rbw->shared->physics_world);
     }
-    rbw->shared->physics_world = RB_dworld_new(scene->physics_settings.gravity);
+    rbw->shared->physics_world = RB_dworld_new(scene->physics_settings.gravity,
+                                               rbw->flag & RBW_FLAG_USE_MULTITHREADING);
   }
 
   RB_dworld_set_solver_iterations(rbw->shared->physics_world, rbw->num_solver_iterations);
@@ -1657,16 +1659,50 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(Depsgraph *depsgraph, Object *ob, RigidBodyOb *rbo)
+/* Objects are synced with the simulation in parallel when there are more than this many. */
+#define RIGIDBODY_PARALLEL_SYNC_LIMIT 256
+
+typedef struct RigidBodySyncData {
+  ViewLayer *view_layer;
+  Object **objects;
+} RigidBodySyncData;
+
+/**
+ * Gather the objects of the rigid body collection in an array, to sync them with the simulation
+ * in parallel. The view layer is synced up front, so that bases can be looked up from threads.
+ */
+static int rigidbody_sync_data_init(Depsgraph *depsgraph,
+                                    RigidBodyWorld *rbw,
+                                    RigidBodySyncData *r_data)
+{
+  const Scene *scene = DEG_get_input_scene(depsgraph);
+  r_data->view_layer = DEG_get_input_view_layer(depsgraph);
+  BKE_view_layer_synced_ensure(scene, r_data->view_layer);
+
+  ListBase object_cache = BKE_collection_object_cache_get(rbw->group);
+  r_data->objects = MEM_mallocN(sizeof(Object *) * BLI_listbase_count(&object_cache), __func__);
+  int objects_num = 0;
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
+    r_data->objects[objects_num++] = ob;
+  }
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+  return objects_num;
+}
+
+static void rigidbody_sync_settings_init(TaskParallelSettings *settings, const int objects_num)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = (objects_num > RIGIDBODY_PARALLEL_SYNC_LIMIT);
+  settings->min_iter_per_thread = 64;
+}
+
+static void rigidbody_update_sim_ob(ViewLayer *view_layer, Object *ob, RigidBodyOb *rbo)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
     return;
   }
 
-  const Scene *scene = DEG_get_input_scene(depsgraph);
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  BKE_view_layer_synced_ensure(scene, view_layer);
   Base *base = BKE_view_layer_base_find(view_layer, ob);
   const bool is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
 
@@ -1715,6 +1751,17 @@ static void rigidbody_update_sim_ob(Depsgraph *depsgraph, Object *ob, RigidBodyO
    */
 }
 
+static void rigidbody_update_sim_ob_task(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RigidBodySyncData *data = userdata;
+  Object *ob = data->objects[i];
+  if (ob->type == OB_MESH && ob->rigidbody_object != NULL) {
+    rigidbody_update_sim_ob(data->view_layer, ob, ob->rigidbody_object);
+  }
+}
+
 /**
  * Updates and validates world, bodies and shapes.
  *
@@ -1802,13 +1849,21 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
         }
       }
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
-
-      /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, ob, rbo);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  /* update simulation objects, only touches the bodies and shapes of each object itself,
+   * while adding and removing bodies above modifies the world and can't be threaded */
+  if (rbw->group) {
+    RigidBodySyncData data;
+    const int objects_num = rigidbody_sync_data_init(depsgraph, rbw, &data);
+    TaskParallelSettings settings;
+    rigidbody_sync_settings_init(&settings, objects_num);
+    BLI_task_parallel_range(0, objects_num, &data, rigidbody_update_sim_ob_task, &settings);
+    MEM_freeN(data.objects);
+  }
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
@@ -2008,28 +2063,39 @@ static void rigidbody_free_substep_data(ListBase *substep_targets)
 
   BLI_freelistN(substep_targets);
 }
-static void rigidbody_update_simulation_post_step(Depsgraph *depsgraph, RigidBodyWorld *rbw)
+static void rigidbody_update_simulation_post_step_task(
+    void *__restrict userdata, const int i, const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  const Scene *scene = DEG_get_input_scene(depsgraph);
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  BKE_view_layer_synced_ensure(scene, view_layer);
-
-  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
-    Base *base = BKE_view_layer_base_find(view_layer, ob);
-    RigidBodyOb *rbo = ob->rigidbody_object;
-    /* Reset kinematic state for transformed objects. */
-    if (rbo && base && (base->flag & BASE_SELECTED) && (G.moving & G_TRANSFORM_OBJ) &&
-        rbo->shared->physics_object) {
-      RB_body_set_kinematic_state(rbo->shared->physics_object,
-                                  rbo->flag & RBO_FLAG_KINEMATIC || rbo->flag & RBO_FLAG_DISABLED);
-      RB_body_set_mass(rbo->shared->physics_object, RBO_GET_MASS(rbo));
-      /* Deactivate passive objects so they don't interfere with deactivation of active objects. */
-      if (rbo->type == RBO_TYPE_PASSIVE) {
-        RB_body_deactivate(rbo->shared->physics_object);
-      }
+  RigidBodySyncData *data = userdata;
+  Object *ob = data->objects[i];
+  Base *base = BKE_view_layer_base_find(data->view_layer, ob);
+  RigidBodyOb *rbo = ob->rigidbody_object;
+  /* Reset kinematic state for transformed objects. */
+  if (rbo && base && (base->flag & BASE_SELECTED) && (G.moving & G_TRANSFORM_OBJ) &&
+      rbo->shared->physics_object) {
+    RB_body_set_kinematic_state(rbo->shared->physics_object,
+                                rbo->flag & RBO_FLAG_KINEMATIC || rbo->flag & RBO_FLAG_DISABLED);
+    RB_body_set_mass(rbo->shared->physics_object, RBO_GET_MASS(rbo));
+    /* Deactivate passive objects so they don't interfere with deactivation of active objects. */
+    if (rbo->type == RBO_TYPE_PASSIVE) {
+      RB_body_deactivate(rbo->shared->physics_object);
     }
   }
-  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+}
+
+static void rigidbody_update_simulation_post_step(Depsgraph *depsgraph, RigidBodyWorld *rbw)
+{
+  if (rbw->group == NULL) {
+    return;
+  }
+
+  RigidBodySyncData data;
+  const int objects_num = rigidbody_sync_data_init(depsgraph, rbw, &data);
+  TaskParallelSettings settings;
+  rigidbody_sync_settings_init(&settings, objects_num);
+  BLI_task_parallel_range(
+      0, objects_num, &data, rigidbody_update_simulation_post_step_task, &settings);
+  MEM_freeN(data.objects);
 }
 
 bool BKE_rigidbody_check_sim_running(RigidBodyWorld *rbw, float ctime)
@@ -59,7 +59,7 @@ struct ShrinkwrapCalcData {
 
   Object *ob; /* object we are applying shrinkwrap to */
 
-  MVert *vert; /* Array of verts being projected. */
+  const MVert *vert; /* Array of verts being projected. */
   const float (*vert_normals)[3];
   /* Vertices being shrink-wrapped. */
   float (*vertexCos)[3];
@@ -117,7 +117,8 @@ bool BKE_shrinkwrap_init_tree(
   data->polys = BKE_mesh_polys(mesh);
 
   if (shrinkType == MOD_SHRINKWRAP_NEAREST_VERTEX) {
-    data->bvh = BKE_bvhtree_from_mesh_get(&data->treeData, mesh, BVHTREE_FROM_VERTS, 2);
+    data->bvh = BKE_bvhtree_from_mesh_get_ex(
+        &data->treeData, mesh, BVHTREE_FROM_VERTS, 2, BVH_BALANCE_MORTON_ORDER);
 
     return data->bvh != nullptr;
   }
@@ -126,7 +127,9 @@ bool BKE_shrinkwrap_init_tree(
     return false;
   }
 
-  data->bvh = BKE_bvhtree_from_mesh_get(&data->treeData, mesh, BVHTREE_FROM_LOOPTRI, 4);
+  /* The target is often deformed, so the tree is rebuilt on every evaluation. */
+  data->bvh = BKE_bvhtree_from_mesh_get_ex(
+      &data->treeData, mesh, BVHTREE_FROM_LOOPTRI, 4, BVH_BALANCE_MORTON_ORDER);
 
   if (data->bvh == nullptr) {
     return false;
@@ -1410,7 +1413,7 @@ void shrinkwrapModifier_deform(ShrinkwrapModifierData *smd,
 
   if (mesh != nullptr && smd->shrinkType == MOD_SHRINKWRAP_PROJECT) {
     /* Setup arrays to get vertices position, normals and deform weights. */
-    calc.vert = BKE_mesh_verts_for_write(mesh);
+    calc.vert = BKE_mesh_verts(mesh);
     calc.vert_normals = BKE_mesh_vertex_normals_ensure(mesh);
 
     /* Using vertices positions/normals as if a subsurface was applied */
@@ -1430,7 +1433,7 @@ void shrinkwrapModifier_deform(ShrinkwrapModifierData *smd,
           (ob->mode & OB_MODE_EDIT) ? SUBSURF_IN_EDIT_MODE : SubsurfFlags(0));
 
       if (ss_mesh) {
-        calc.vert = static_cast<MVert *>(ss_mesh->getVertDataArray(ss_mesh, CD_MVERT));
+        calc.vert = static_cast<const MVert *>(ss_mesh->getVertDataArray(ss_mesh, CD_MVERT));
         if (calc.vert) {
           /* TRICKY: this code assumes subsurface will have the transformed original vertices
            * in their original order at the end of the vert array. */
@@ -1575,7 +1578,7 @@ void BKE_shrinkwrap_remesh_target_project(Mesh *src_me, Mesh *target_me, Object
   calc.vgroup = -1;
   calc.target = target_me;
   calc.keepDist = ssmd.keepDist;
-  calc.vert = BKE_mesh_verts_for_write(src_me);
+  calc.vert = BKE_mesh_verts(src_me);
   BLI_SPACE_TRANSFORM_SETUP(&calc.local2target, ob_target, ob_target);
 
   ShrinkwrapTreeData tree;
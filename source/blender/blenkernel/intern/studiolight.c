@@ -20,6 +20,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_threads.h"
 
 #include "DNA_listBase.h"
 
@@ -34,6 +35,12 @@
 /* Statics */
 static ListBase studiolights;
 static int last_studiolight_id = 0;
+/**
+ * The studio-light folders are only scanned on first access to the list, background renders
+ * often don't use any studio-light.
+ */
+static bool studiolight_files_added = false;
+static ThreadMutex studiolight_files_mutex = BLI_MUTEX_INITIALIZER;
 #define STUDIOLIGHT_RADIANCE_CUBEMAP_SIZE 96
 #define STUDIOLIGHT_IRRADIANCE_EQUIRECT_HEIGHT 32
 #define STUDIOLIGHT_IRRADIANCE_EQUIRECT_WIDTH (STUDIOLIGHT_IRRADIANCE_EQUIRECT_HEIGHT * 2)
@@ -1385,15 +1392,13 @@ void BKE_studiolight_default(SolidLight lights[4], float light_ambient[3])
   lights[3].vec[2] = -0.542269f;
 }
 
-void BKE_studiolight_init(void)
+static void studiolight_files_ensure(void)
 {
-  /* Add default studio light */
-  StudioLight *sl = studiolight_create(
-      STUDIOLIGHT_INTERNAL | STUDIOLIGHT_SPHERICAL_HARMONICS_COEFFICIENTS_CALCULATED |
-      STUDIOLIGHT_TYPE_STUDIO | STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
-  BLI_strncpy(sl->name, "Default", FILE_MAXFILE);
-
-  BLI_addtail(&studiolights, sl);
+  BLI_mutex_lock(&studiolight_files_mutex);
+  if (studiolight_files_added) {
+    BLI_mutex_unlock(&studiolight_files_mutex);
+    return;
+  }
 
   /* Go over the preset folder and add a studio-light for every image with its path. */
   /* For portable installs (where USER and SYSTEM paths are the same),
@@ -1423,6 +1428,21 @@ void BKE_studiolight_init(void)
   /* sort studio lights on filename. */
   BLI_listbase_sort(&studiolights, studiolight_cmp);
 
+  studiolight_files_added = true;
+  BLI_mutex_unlock(&studiolight_files_mutex);
+}
+
+void BKE_studiolight_init(void)
+{
+  /* Add default studio light */
+  StudioLight *sl = studiolight_create(
+      STUDIOLIGHT_INTERNAL | STUDIOLIGHT_SPHERICAL_HARMONICS_COEFFICIENTS_CALCULATED |
+      STUDIOLIGHT_TYPE_STUDIO | STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
+  BLI_strncpy(sl->name, "Default", FILE_MAXFILE);
+
+  BLI_addtail(&studiolights, sl);
+  studiolight_files_added = false;
+
   BKE_studiolight_default(sl->light, sl->light_ambient);
 }
 
@@ -1445,6 +1465,7 @@ struct StudioLight *BKE_studiolight_find_default(int flag)
     default_name = STUDIOLIGHT_MATCAP_DEFAULT;
   }
 
+  studiolight_files_ensure();
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if ((sl->flag & flag) && STREQ(sl->name, default_name)) {
       return sl;
@@ -1461,6 +1482,7 @@ struct StudioLight *BKE_studiolight_find_default(int flag)
 
 struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 {
+  studiolight_files_ensure();
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (STREQLEN(sl->name, name, FILE_MAXFILE)) {
       if (sl->flag & flag) {
@@ -1477,6 +1499,7 @@ struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 
 struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 {
+  studiolight_files_ensure();
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (sl->index == index) {
       return sl;
@@ -1488,6 +1511,7 @@ struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 
 struct ListBase *BKE_studiolight_listbase(void)
 {
+  studiolight_files_ensure();
   return &studiolights;
 }
 
@@ -1564,6 +1588,7 @@ void BKE_studiolight_remove(StudioLight *sl)
 
 StudioLight *BKE_studiolight_load(const char *path, int type)
 {
+  studiolight_files_ensure();
   StudioLight *sl = studiolight_add_file(path, type | STUDIOLIGHT_USER_DEFINED);
   return sl;
 }
@@ -1572,6 +1597,7 @@ StudioLight *BKE_studiolight_create(const char *path,
                                     const SolidLight light[4],
                                     const float light_ambient[3])
 {
+  studiolight_files_ensure();
   StudioLight *sl = studiolight_create(STUDIOLIGHT_EXTERNAL_FILE | STUDIOLIGHT_USER_DEFINED |
                                        STUDIOLIGHT_TYPE_STUDIO |
                                        STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
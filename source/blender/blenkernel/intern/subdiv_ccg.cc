@@ -12,7 +12,6 @@
 
 #include "MEM_guardedalloc.h"
 
-#include "BLI_ghash.h"
 #include "BLI_math_bits.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
@@ -1223,11 +1222,20 @@ void BKE_subdiv_ccg_average_grids(SubdivCCG *subdiv_ccg)
   subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
 }
 
+/**
+ * Gather the indices of the adjacent vertices and edges of the effected faces, every index is
+ * stored once. The arrays need to have room for the number of corners of all effected faces.
+ *
+ * Bitmaps are used to skip duplicates, which is much cheaper than hashing when strokes touch
+ * many faces.
+ */
 static void subdiv_ccg_affected_face_adjacency(SubdivCCG *subdiv_ccg,
                                                CCGFace **effected_faces,
                                                int num_effected_faces,
-                                               GSet *r_adjacent_vertices,
-                                               GSet *r_adjacent_edges)
+                                               int *r_adjacent_vertices,
+                                               int *r_num_adjacent_vertices,
+                                               int *r_adjacent_edges,
+                                               int *r_num_adjacent_edges)
 {
   Subdiv *subdiv = subdiv_ccg->subdiv;
   OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
@@ -1238,6 +1246,11 @@ static void subdiv_ccg_affected_face_adjacency(SubdivCCG *subdiv_ccg,
   static_or_heap_storage_init(&face_vertices_storage);
   static_or_heap_storage_init(&face_edges_storage);
 
+  BLI_bitmap *vertex_tags = BLI_BITMAP_NEW(subdiv_ccg->num_adjacent_vertices, __func__);
+  BLI_bitmap *edge_tags = BLI_BITMAP_NEW(subdiv_ccg->num_adjacent_edges, __func__);
+  int num_adjacent_vertices = 0;
+  int num_adjacent_edges = 0;
+
   for (int i = 0; i < num_effected_faces; i++) {
     SubdivCCGFace *face = (SubdivCCGFace *)effected_faces[i];
     int face_index = face - subdiv_ccg->faces;
@@ -1254,19 +1267,25 @@ static void subdiv_ccg_affected_face_adjacency(SubdivCCG *subdiv_ccg,
       const int vertex_index = face_vertices[corner];
       const int edge_index = face_edges[corner];
 
-      int edge_vertices[2];
-      topology_refiner->getEdgeVertices(topology_refiner, edge_index, edge_vertices);
-
-      SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[edge_index];
-      BLI_gset_add(r_adjacent_edges, adjacent_edge);
+      if (!BLI_BITMAP_TEST(edge_tags, edge_index)) {
+        BLI_BITMAP_ENABLE(edge_tags, edge_index);
+        r_adjacent_edges[num_adjacent_edges++] = edge_index;
+      }
 
-      SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[vertex_index];
-      BLI_gset_add(r_adjacent_vertices, adjacent_vertex);
+      if (!BLI_BITMAP_TEST(vertex_tags, vertex_index)) {
+        BLI_BITMAP_ENABLE(vertex_tags, vertex_index);
+        r_adjacent_vertices[num_adjacent_vertices++] = vertex_index;
+      }
     }
   }
 
+  MEM_freeN(vertex_tags);
+  MEM_freeN(edge_tags);
   static_or_heap_storage_free(&face_vertices_storage);
   static_or_heap_storage_free(&face_edges_storage);
+
+  *r_num_adjacent_vertices = num_adjacent_vertices;
+  *r_num_adjacent_edges = num_adjacent_edges;
 }
 
 void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
@@ -1274,47 +1293,34 @@ void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
                                                      CCGFace **effected_faces,
                                                      int num_effected_faces)
 {
-  GSet *adjacent_vertices = BLI_gset_ptr_new(__func__);
-  GSet *adjacent_edges = BLI_gset_ptr_new(__func__);
-  GSetIterator gi;
-
-  subdiv_ccg_affected_face_adjacency(
-      subdiv_ccg, effected_faces, num_effected_faces, adjacent_vertices, adjacent_edges);
-
-  int *adjacent_vertex_index_map;
-  int *adjacent_edge_index_map;
+  int num_corners = 0;
+  for (int i = 0; i < num_effected_faces; i++) {
+    num_corners += ((SubdivCCGFace *)effected_faces[i])->num_grids;
+  }
 
-  StaticOrHeapIntStorage index_heap;
-  static_or_heap_storage_init(&index_heap);
+  int *adjacent_vertex_index_map = static_cast<int *>(
+      MEM_malloc_arrayN(num_corners, sizeof(int), __func__));
+  int *adjacent_edge_index_map = static_cast<int *>(
+      MEM_malloc_arrayN(num_corners, sizeof(int), __func__));
+  int num_adjacent_vertices;
+  int num_adjacent_edges;
 
-  int i = 0;
+  subdiv_ccg_affected_face_adjacency(subdiv_ccg,
+                                     effected_faces,
+                                     num_effected_faces,
+                                     adjacent_vertex_index_map,
+                                     &num_adjacent_vertices,
+                                     adjacent_edge_index_map,
+                                     &num_adjacent_edges);
 
   /* Average boundaries. */
-
-  adjacent_edge_index_map = static_or_heap_storage_get(&index_heap, BLI_gset_len(adjacent_edges));
-  GSET_ITER_INDEX (gi, adjacent_edges, i) {
-    SubdivCCGAdjacentEdge *adjacent_edge = static_cast<SubdivCCGAdjacentEdge *>(
-        BLI_gsetIterator_getKey(&gi));
-    adjacent_edge_index_map[i] = adjacent_edge - subdiv_ccg->adjacent_edges;
-  }
-  subdiv_ccg_average_boundaries(
-      subdiv_ccg, key, adjacent_edge_index_map, BLI_gset_len(adjacent_edges));
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, adjacent_edge_index_map, num_adjacent_edges);
 
   /* Average corners. */
+  subdiv_ccg_average_corners(subdiv_ccg, key, adjacent_vertex_index_map, num_adjacent_vertices);
 
-  adjacent_vertex_index_map = static_or_heap_storage_get(&index_heap,
-                                                         BLI_gset_len(adjacent_vertices));
-  GSET_ITER_INDEX (gi, adjacent_vertices, i) {
-    SubdivCCGAdjacentVertex *adjacent_vertex = static_cast<SubdivCCGAdjacentVertex *>(
-        BLI_gsetIterator_getKey(&gi));
-    adjacent_vertex_index_map[i] = adjacent_vertex - subdiv_ccg->adjacent_vertices;
-  }
-  subdiv_ccg_average_corners(
-      subdiv_ccg, key, adjacent_vertex_index_map, BLI_gset_len(adjacent_vertices));
-
-  BLI_gset_free(adjacent_vertices, nullptr);
-  BLI_gset_free(adjacent_edges, nullptr);
-  static_or_heap_storage_free(&index_heap);
+  MEM_freeN(adjacent_vertex_index_map);
+  MEM_freeN(adjacent_edge_index_map);
 }
 
 struct StitchFacesInnerGridsData {
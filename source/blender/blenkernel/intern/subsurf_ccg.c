@@ -240,7 +240,7 @@ static int getFaceIndex(
 }
 
 static void get_face_uv_map_vert(
-    UvVertMap *vmap, struct MPoly *mpoly, struct MLoop *ml, int fi, CCGVertHDL *fverts)
+    UvVertMap *vmap, const MPoly *mpoly, const MLoop *ml, int fi, CCGVertHDL *fverts)
 {
   UvMapVert *v, *nv;
   int j, nverts = mpoly[fi].totloop;
@@ -264,8 +264,8 @@ static int ss_sync_from_uv(CCGSubSurf *ss,
                            DerivedMesh *dm,
                            const MLoopUV *mloopuv)
 {
-  MPoly *mpoly = dm->getPolyArray(dm);
-  MLoop *mloop = dm->getLoopArray(dm);
+  const MPoly *mpoly = dm->getPolyArray(dm);
+  const MLoop *mloop = dm->getLoopArray(dm);
   int totvert = dm->getNumVerts(dm);
   int totface = dm->getNumPolys(dm);
   int i, seam;
@@ -323,12 +323,12 @@ static int ss_sync_from_uv(CCGSubSurf *ss,
   eset = BLI_edgeset_new_ex(__func__, BLI_EDGEHASH_SIZE_GUESS_FROM_POLYS(totface));
 
   for (i = 0; i < totface; i++) {
-    MPoly *mp = &mpoly[i];
+    const MPoly *mp = &mpoly[i];
     int nverts = mp->totloop;
     int j, j_next;
     CCGFace *origf = ccgSubSurf_getFace(origss, POINTER_FROM_INT(i));
     /* uint *fv = &mp->v1; */
-    MLoop *ml = mloop + mp->loopstart;
+    const MLoop *ml = mloop + mp->loopstart;
 
 #ifdef USE_DYNSIZE
     CCGVertHDL fverts[nverts];
@@ -357,8 +357,8 @@ static int ss_sync_from_uv(CCGSubSurf *ss,
 
   /* create faces */
   for (i = 0; i < totface; i++) {
-    MPoly *mp = &mpoly[i];
-    MLoop *ml = &mloop[mp->loopstart];
+    const MPoly *mp = &mpoly[i];
+    const MLoop *ml = &mloop[mp->loopstart];
     int nverts = mp->totloop;
     CCGFace *f;
 
@@ -390,8 +390,10 @@ static void set_subsurf_legacy_uv(CCGSubSurf *ss, DerivedMesh *dm, DerivedMesh *
   const MLoopUV *dmloopuv = CustomData_get_layer_n(&dm->loopData, CD_MLOOPUV, n);
   /* need to update both CD_MTFACE & CD_MLOOPUV, hrmf, we could get away with
    * just tface except applying the modifier then looses subsurf UV */
-  MTFace *tface = CustomData_get_layer_n(&result->faceData, CD_MTFACE, n);
-  MLoopUV *mloopuv = CustomData_get_layer_n(&result->loopData, CD_MLOOPUV, n);
+  MTFace *tface = CustomData_get_layer_n_for_write(
+      &result->faceData, CD_MTFACE, n, result->numTessFaceData);
+  MLoopUV *mloopuv = CustomData_get_layer_n_for_write(
+      &result->loopData, CD_MLOOPUV, n, result->numLoopData);
 
   if (!dmloopuv || (!tface && !mloopuv)) {
     return;
@@ -562,21 +564,21 @@ static void ss_sync_ccg_from_derivedmesh(CCGSubSurf *ss,
   CCGVertHDL *fVerts = NULL;
   BLI_array_declare(fVerts);
 #endif
-  MVert *mvert = dm->getVertArray(dm);
-  MEdge *medge = dm->getEdgeArray(dm);
-  MVert *mv;
-  MEdge *me;
-  MLoop *mloop = dm->getLoopArray(dm), *ml;
-  MPoly *mpoly = dm->getPolyArray(dm), *mp;
+  const MVert *mvert = dm->getVertArray(dm);
+  const MEdge *medge = dm->getEdgeArray(dm);
+  const MVert *mv;
+  const MEdge *me;
+  const MLoop *mloop = dm->getLoopArray(dm), *ml;
+  const MPoly *mpoly = dm->getPolyArray(dm), *mp;
   int totvert = dm->getNumVerts(dm);
   int totedge = dm->getNumEdges(dm);
   int i, j;
-  int *index;
+  const int *index;
 
   ccgSubSurf_initFullSync(ss);
 
   mv = mvert;
-  index = (int *)dm->getVertDataArray(dm, CD_ORIGINDEX);
+  index = (const int *)dm->getVertDataArray(dm, CD_ORIGINDEX);
   for (i = 0; i < totvert; i++, mv++) {
     CCGVert *v;
 
@@ -591,7 +593,7 @@ static void ss_sync_ccg_from_derivedmesh(CCGSubSurf *ss,
   }
 
   me = medge;
-  index = (int *)dm->getEdgeDataArray(dm, CD_ORIGINDEX);
+  index = (const int *)dm->getEdgeDataArray(dm, CD_ORIGINDEX);
   const float *creases = (const float *)dm->getEdgeDataArray(dm, CD_CREASE);
   for (i = 0; i < totedge; i++, me++) {
     CCGEdge *e;
@@ -606,7 +608,7 @@ static void ss_sync_ccg_from_derivedmesh(CCGSubSurf *ss,
   }
 
   mp = mpoly;
-  index = (int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
+  index = (const int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
   for (i = 0; i < dm->numPolyData; i++, mp++) {
     CCGFace *f;
 
@@ -1081,7 +1083,7 @@ static void ccgDM_copyFinalLoopArray(DerivedMesh *dm, MLoop *mloop)
   if (!ccgdm->ehash) {
     BLI_mutex_lock(&ccgdm->loops_cache_lock);
     if (!ccgdm->ehash) {
-      MEdge *medge;
+      const MEdge *medge;
       EdgeHash *ehash;
 
       ehash = BLI_edgehash_new_ex(__func__, ccgdm->dm.numEdgeData);
@@ -1225,7 +1227,7 @@ static void ccgDM_release(DerivedMesh *dm)
   }
 }
 
-static void *ccgDM_get_vert_data_layer(DerivedMesh *dm, int type)
+static const void *ccgDM_get_vert_data_layer(DerivedMesh *dm, int type)
 {
   if (type == CD_ORIGINDEX) {
     /* create origindex on demand to save memory */
@@ -1236,10 +1238,10 @@ static void *ccgDM_get_vert_data_layer(DerivedMesh *dm, int type)
 
     /* Avoid re-creation if the layer exists already */
     BLI_rw_mutex_lock(&ccgdm->origindex_cache_rwlock, THREAD_LOCK_READ);
-    origindex = DM_get_vert_data_layer(dm, CD_ORIGINDEX);
+    const void *origindex_existing = DM_get_vert_data_layer(dm, CD_ORIGINDEX);
     BLI_rw_mutex_unlock(&ccgdm->origindex_cache_rwlock);
-    if (origindex) {
-      return origindex;
+    if (origindex_existing) {
+      return origindex_existing;
     }
 
     BLI_rw_mutex_lock(&ccgdm->origindex_cache_rwlock, THREAD_LOCK_WRITE);
@@ -1267,7 +1269,7 @@ static void *ccgDM_get_vert_data_layer(DerivedMesh *dm, int type)
   return DM_get_vert_data_layer(dm, type);
 }
 
-static void *ccgDM_get_edge_data_layer(DerivedMesh *dm, int type)
+static const void *ccgDM_get_edge_data_layer(DerivedMesh *dm, int type)
 {
   if (type == CD_ORIGINDEX) {
     /* create origindex on demand to save memory */
@@ -1278,9 +1280,9 @@ static void *ccgDM_get_edge_data_layer(DerivedMesh *dm, int type)
     int edgeSize = ccgSubSurf_getEdgeSize(ss);
 
     /* Avoid re-creation if the layer exists already */
-    origindex = DM_get_edge_data_layer(dm, CD_ORIGINDEX);
-    if (origindex) {
-      return origindex;
+    const void *origindex_existing = DM_get_edge_data_layer(dm, CD_ORIGINDEX);
+    if (origindex_existing) {
+      return origindex_existing;
     }
 
     origindex = CustomData_add_layer(
@@ -1310,7 +1312,7 @@ static void *ccgDM_get_edge_data_layer(DerivedMesh *dm, int type)
   return DM_get_edge_data_layer(dm, type);
 }
 
-static void *ccgDM_get_poly_data_layer(DerivedMesh *dm, int type)
+static const void *ccgDM_get_poly_data_layer(DerivedMesh *dm, int type)
 {
   if (type == CD_ORIGINDEX) {
     /* create origindex on demand to save memory */
@@ -1321,9 +1323,9 @@ static void *ccgDM_get_poly_data_layer(DerivedMesh *dm, int type)
     int gridFaces = ccgSubSurf_getGridSize(ss) - 1;
 
     /* Avoid re-creation if the layer exists already */
-    origindex = DM_get_poly_data_layer(dm, CD_ORIGINDEX);
-    if (origindex) {
-      return origindex;
+    const void *origindex_existing = DM_get_poly_data_layer(dm, CD_ORIGINDEX);
+    if (origindex_existing) {
+      return origindex_existing;
     }
 
     origindex = CustomData_add_layer(
@@ -1590,7 +1592,7 @@ static void set_ccgdm_all_geometry(CCGDerivedMesh *ccgdm,
   int gridSideEdges;
   int gridInternalEdges;
   WeightTable wtable = {NULL};
-  MEdge *medge = NULL;
+  const MEdge *medge = NULL;
   bool has_edge_cd;
 
   edgeSize = ccgSubSurf_getEdgeSize(ss);
@@ -1608,10 +1610,13 @@ static void set_ccgdm_all_geometry(CCGDerivedMesh *ccgdm,
       &dm->polyData, CD_MPOLY, "material_index");
   const int *base_polyOrigIndex = CustomData_get_layer(&dm->polyData, CD_ORIGINDEX);
 
-  int *vertOrigIndex = DM_get_vert_data_layer(&ccgdm->dm, CD_ORIGINDEX);
-  int *edgeOrigIndex = DM_get_edge_data_layer(&ccgdm->dm, CD_ORIGINDEX);
+  int *vertOrigIndex = CustomData_get_layer_for_write(
+      &ccgdm->dm.vertData, CD_ORIGINDEX, ccgdm->dm.numVertData);
+  int *edgeOrigIndex = CustomData_get_layer_for_write(
+      &ccgdm->dm.edgeData, CD_ORIGINDEX, ccgdm->dm.numEdgeData);
 
-  int *polyOrigIndex = DM_get_poly_data_layer(&ccgdm->dm, CD_ORIGINDEX);
+  int *polyOrigIndex = CustomData_get_layer_for_write(
+      &ccgdm->dm.polyData, CD_ORIGINDEX, ccgdm->dm.numPolyData);
 
   has_edge_cd = ((ccgdm->dm.edgeData.totlayer - (edgeOrigIndex ? 1 : 0)) != 0);
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "BLI_array.hh"
 #include "BLI_generic_span.hh"
 #include "BLI_generic_virtual_array.hh"
 #include "BLI_index_mask.hh"
@@ -107,4 +108,72 @@ inline void gather(const VArray<T> &src,
   });
 }
 
+/**
+ * Fill the destination span by scattering values from the `src` array to the indexed positions,
+ * the inverse of #gather. Every index must only be used once.
+ */
+template<typename T, typename IndexT>
+inline void scatter(const Span<T> src,
+                    const Span<IndexT> indices,
+                    MutableSpan<T> dst,
+                    const int64_t grain_size = 4096)
+{
+  BLI_assert(indices.size() == src.size());
+  threading::parallel_for(indices.index_range(), grain_size, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      dst[indices[i]] = src[i];
+    }
+  });
+}
+
+/**
+ * Replace every value with the sum of all values before it and return the sum of all values,
+ * e.g. to turn counts into offsets. Threaded based on grain-size: the sums of all chunks are
+ * computed first, so that every chunk can be scanned independently afterwards.
+ */
+template<typename T> inline T exclusive_scan(MutableSpan<T> data, const int64_t grain_size = 4096)
+{
+  auto scan_range = [&](const IndexRange range, T offset) {
+    for (const int64_t i : range) {
+      const T value = data[i];
+      data[i] = offset;
+      offset += value;
+    }
+    return offset;
+  };
+  const int64_t size = data.size();
+  if (size <= grain_size * 2) {
+    return scan_range(data.index_range(), T(0));
+  }
+
+  const int64_t chunks_num = (size + grain_size - 1) / grain_size;
+  auto chunk_range = [&](const int64_t chunk) {
+    return IndexRange(chunk * grain_size, std::min(grain_size, size - chunk * grain_size));
+  };
+  Array<T> chunk_offsets(chunks_num);
+  threading::parallel_for(chunk_offsets.index_range(), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      T sum = T(0);
+      for (const T &value : data.slice(chunk_range(chunk))) {
+        sum += value;
+      }
+      chunk_offsets[chunk] = sum;
+    }
+  });
+
+  T total = T(0);
+  for (T &offset : chunk_offsets) {
+    const T sum = offset;
+    offset = total;
+    total += sum;
+  }
+
+  threading::parallel_for(chunk_offsets.index_range(), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      scan_range(chunk_range(chunk), chunk_offsets[chunk]);
+    }
+  });
+  return total;
+}
+
 }  // namespace blender::array_utils
@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A #CompactIndexMask stores the same kind of sorted unique indices as an #IndexMask, but with
+ * much less memory. Unlike #IndexMask, it owns its data.
+ *
+ * The index space is split into chunks of #CompactIndexMask::chunk_size indices. The indices in
+ * every chunk are stored in the most compact of these representations:
+ * - A range, when the indices in a chunk are contiguous. Consecutive ranges are joined, so a mask
+ *   that is a single large range is only a single segment.
+ * - 16 bit offsets from the start of the chunk, when there are only few indices in the chunk.
+ * - A bit for every index in the chunk otherwise.
+ *
+ * For example, a random selection of half the elements of 100 million elements only needs about
+ * 12.5 MB instead of 400 MB.
+ *
+ * Most code that processes the indices wants an #IndexMask. #CompactIndexMask::foreach_segment
+ * provides that for every segment, converting only a single chunk at a time to a temporary
+ * buffer. Each of these masks can be passed to a multi-function call directly.
+ */
+
+#include "BLI_index_mask.hh"
+#include "BLI_math_bits.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+class CompactIndexMask {
+ public:
+  /** Indices that are not part of a range segment are stored in chunks of this size. */
+  static constexpr int64_t chunk_size = 1 << 14;
+
+ private:
+  static constexpr int64_t bits_per_word = 64;
+  static constexpr int64_t chunk_words_num = chunk_size / bits_per_word;
+
+  enum class SegmentType : int8_t {
+    Range,
+    Offsets,
+    Bits,
+  };
+
+  struct Segment {
+    SegmentType type;
+    /** The first index of a range, or the first index of the chunk otherwise. */
+    int64_t start;
+    /** Number of indices in this segment. */
+    int64_t size;
+    /** Number of indices in all previous segments. */
+    int64_t mask_offset;
+    /** Position of the data in #offsets_ or #bits_, unused for ranges. */
+    int64_t data_offset;
+  };
+
+  Vector<Segment> segments_;
+  /** Only valid indices are offsets in a chunk, so they fit into 16 bits. */
+  Vector<uint16_t> offsets_;
+  Vector<uint64_t> bits_;
+  int64_t size_ = 0;
+
+ public:
+  CompactIndexMask() = default;
+
+  /** Create a compact copy of the indices of the mask. */
+  explicit CompactIndexMask(IndexMask mask);
+
+  /** Create a mask that contains all indices whose value is true. */
+  static CompactIndexMask from_bools(Span<bool> bools);
+
+  /** Number of indices in the mask. */
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  /** Number of parts the mask is stored in, and the number of calls to #foreach_segment. */
+  int64_t segments_num() const
+  {
+    return segments_.size();
+  }
+
+  /** Approximate amount of memory used to store the mask. */
+  int64_t size_in_bytes() const
+  {
+    return segments_.size() * int64_t(sizeof(Segment)) +
+           offsets_.size() * int64_t(sizeof(uint16_t)) + bits_.size() * int64_t(sizeof(uint64_t));
+  }
+
+  /** Copy all indices into the given array, that must have #size elements. */
+  void to_indices(MutableSpan<int64_t> r_indices) const;
+
+  /** Calls the callback for every index in ascending order. */
+  template<typename Fn> void foreach_index(const Fn &fn) const
+  {
+    for (const Segment &segment : segments_) {
+      this->foreach_index_in_segment(segment, fn);
+    }
+  }
+
+  /**
+   * Calls the callback with an #IndexMask for every segment in ascending order. The indices of
+   * the masks are only valid until the callback returns.
+   */
+  template<typename Fn> void foreach_segment(const Fn &fn) const
+  {
+    Vector<int64_t> buffer;
+    for (const Segment &segment : segments_) {
+      fn(this->segment_as_mask(segment, buffer));
+    }
+  }
+
+  /**
+   * Same as #foreach_segment, but the callback is called for multiple segments in parallel.
+   */
+  template<typename Fn> void foreach_segment_parallel(const Fn &fn) const
+  {
+    threading::parallel_for(segments_.index_range(), 1, [&](const IndexRange range) {
+      Vector<int64_t> buffer;
+      for (const Segment &segment : segments_.as_span().slice(range)) {
+        fn(this->segment_as_mask(segment, buffer));
+      }
+    });
+  }
+
+ private:
+  template<typename Fn>
+  void foreach_index_in_segment(const Segment &segment, const Fn &fn) const
+  {
+    switch (segment.type) {
+      case SegmentType::Range:
+        for (const int64_t i : IndexRange(segment.start, segment.size)) {
+          fn(i);
+        }
+        break;
+      case SegmentType::Offsets:
+        for (const uint16_t offset : offsets_.as_span().slice(segment.data_offset, segment.size)) {
+          fn(segment.start + offset);
+        }
+        break;
+      case SegmentType::Bits: {
+        const Span<uint64_t> words = bits_.as_span().slice(segment.data_offset, chunk_words_num);
+        for (const int64_t word_index : words.index_range()) {
+          uint64_t word = words[word_index];
+          const int64_t word_start = segment.start + word_index * bits_per_word;
+          while (word != 0) {
+            fn(word_start + int64_t(bitscan_forward_uint64(word)));
+            word &= word - 1;
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  IndexMask segment_as_mask(const Segment &segment, Vector<int64_t> &buffer) const
+  {
+    if (segment.type == SegmentType::Range) {
+      return IndexRange(segment.start, segment.size);
+    }
+    buffer.clear();
+    buffer.reserve(segment.size);
+    this->foreach_index_in_segment(segment, [&](const int64_t i) { buffer.append_unchecked(i); });
+    return buffer.as_span();
+  }
+
+  /** Build the mask from the answers of the callbacks for every chunk of the index space. */
+  template<typename CountFn, typename FillFn>
+  void build(int64_t chunks_num, const CountFn &count_chunk, const FillFn &fill_chunk);
+};
+
+}  // namespace blender
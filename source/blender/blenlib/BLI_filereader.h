@@ -30,12 +30,26 @@ struct FileReader;
 typedef ssize_t (*FileReaderReadFn)(struct FileReader *reader, void *buffer, size_t size);
 typedef off64_t (*FileReaderSeekFn)(struct FileReader *reader, off64_t offset, int whence);
 typedef void (*FileReaderCloseFn)(struct FileReader *reader);
+typedef void (*FileReaderViewDataFn)(const void *data, size_t size, void *user_data);
+/**
+ * Call `fn` with a pointer to `size` bytes of the reader contents at `offset`, without copying
+ * them. Only available for readers that have the whole (uncompressed) file in memory, it does not
+ * change the read offset. Returns false if the data could not be accessed, in which case any
+ * results computed by `fn` must be discarded.
+ */
+typedef bool (*FileReaderViewFn)(struct FileReader *reader,
+                                 off64_t offset,
+                                 size_t size,
+                                 FileReaderViewDataFn fn,
+                                 void *user_data);
 
 /** General structure for all #FileReaders, implementations add custom fields at the end. */
 typedef struct FileReader {
   FileReaderReadFn read;
   FileReaderSeekFn seek;
   FileReaderCloseFn close;
+  /** Optional, may be NULL. */
+  FileReaderViewFn view;
 
   off64_t offset;
 } FileReader;
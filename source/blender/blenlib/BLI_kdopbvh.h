@@ -85,6 +85,13 @@ enum {
   /* calculate IsectRayPrecalc data */
   BVH_RAYCAST_WATERTIGHT = (1 << 0),
 };
+enum {
+  /**
+   * Sort the leafs along a Morton curve and build all levels of the tree in parallel.
+   * Much faster to build for large trees, but the tree can be slightly less efficient to query.
+   */
+  BVH_BALANCE_MORTON_ORDER = (1 << 0),
+};
 #define BVH_RAYCAST_DEFAULT (BVH_RAYCAST_WATERTIGHT)
 #define BVH_RAYCAST_DIST_MAX (FLT_MAX / 2.0f)
 
@@ -154,6 +161,10 @@ void BLI_bvhtree_free(BVHTree *tree);
  */
 void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoints);
 void BLI_bvhtree_balance(BVHTree *tree);
+/**
+ * \param flag: #BVH_BALANCE_MORTON_ORDER or zero for the same tree as #BLI_bvhtree_balance.
+ */
+void BLI_bvhtree_balance_ex(BVHTree *tree, int flag);
 
 /**
  * Update: first update points/nodes, then call update_tree to refit the bounding volumes.
@@ -226,6 +237,20 @@ int BLI_bvhtree_find_nearest(BVHTree *tree,
                              BVHTree_NearestPointCallback callback,
                              void *userdata);
 
+/**
+ * Find the nearest node for many positions at once, the result is the same as calling
+ * #BLI_bvhtree_find_nearest for every position. Nearby positions are traversed together,
+ * which is faster than separate queries when the positions are coherent.
+ *
+ * \param nearest: Array of \a num elements, initialized like for #BLI_bvhtree_find_nearest.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    int num,
+                                    BVHTreeNearest *nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata);
+
 /**
  * Find the first node nearby.
  * Favors speed over quality since it doesn't find the best target node.
@@ -252,6 +277,24 @@ int BLI_bvhtree_ray_cast(BVHTree *tree,
                          BVHTree_RayCastCallback callback,
                          void *userdata);
 
+/**
+ * Cast many rays at once, the result is the same as calling #BLI_bvhtree_ray_cast_ex for every
+ * ray. Rays with nearby origins and similar directions are traversed together.
+ *
+ * \param dir: Normalized ray directions.
+ * \param hits: Array of \a num elements, initialized like for #BLI_bvhtree_ray_cast.
+ * A hit was found for a ray when its index is not -1 afterwards.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                int num,
+                                float radius,
+                                BVHTreeRayHit *hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag);
+
 /**
  * Calls the callback for every ray intersection
  *
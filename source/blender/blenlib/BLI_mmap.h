@@ -31,6 +31,17 @@ BLI_mmap_file *BLI_mmap_open(int fd) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
 bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length)
     ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
 
+typedef void (*BLI_mmap_access_fn)(const void *data, size_t length, void *user_data);
+
+/* Calls fn with a pointer to length bytes of the mapped file at the given offset, avoiding a copy
+ * of the data. Returns whether the operation was successful: IO errors are only detected while
+ * the memory is accessed, so any results of fn must be discarded when this fails. */
+bool BLI_mmap_access(BLI_mmap_file *file,
+                     size_t offset,
+                     size_t length,
+                     BLI_mmap_access_fn fn,
+                     void *user_data) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1, 4);
+
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
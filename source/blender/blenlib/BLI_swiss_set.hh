@@ -0,0 +1,315 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::SwissSet<Key>` is an alternative to #blender::Set with the same interface for its
+ * core operations. It is a "Swiss Table" that compares the hash bits of a whole group of slots at
+ * once using SIMD instructions, see BLI_swiss_table.hh for details.
+ *
+ * Use it instead of #blender::Set when profiling shows that a set with many keys is lookup bound.
+ * The differences are the same as those between #blender::SwissMap and #blender::Map.
+ */
+
+#include "BLI_swiss_table.hh"
+
+namespace blender {
+
+template<typename Key,
+         /** See #blender::Set. */
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality,
+         typename Allocator = GuardedAllocator>
+class SwissSet {
+ public:
+  using value_type = Key;
+  using pointer = Key *;
+  using const_pointer = const Key *;
+  using reference = Key &;
+  using const_reference = const Key &;
+  using size_type = int64_t;
+
+ private:
+  struct Policy {
+    using Slot = Key;
+
+    static const Key &key(const Key &key)
+    {
+      return key;
+    }
+  };
+
+  using Table = swiss_table::Table<Policy, Hash, IsEqual, Allocator>;
+  Table table_;
+
+ public:
+  SwissSet(Allocator allocator = {}) noexcept : table_(allocator)
+  {
+  }
+
+  SwissSet(Span<Key> keys, Allocator allocator = {}) : table_(allocator)
+  {
+    this->add_multiple(keys);
+  }
+
+  SwissSet(const std::initializer_list<Key> &keys, Allocator allocator = {})
+      : SwissSet(Span(keys), allocator)
+  {
+  }
+
+  /**
+   * Add a new key to the set. This invokes undefined behavior when the key is in the set already.
+   */
+  void add_new(const Key &key)
+  {
+    this->add_new_as(key);
+  }
+  void add_new(Key &&key)
+  {
+    this->add_new_as(std::move(key));
+  }
+  template<typename ForwardKey> void add_new_as(ForwardKey &&key)
+  {
+    BLI_assert(!this->contains_as(key));
+    auto create_slot = [&](void *buffer) { new (buffer) Key(std::forward<ForwardKey>(key)); };
+    table_.add_new_slot(key, create_slot);
+  }
+
+  /**
+   * Add a key to the set. If the key exists in the set already, nothing is done. The return value
+   * is true if the key was newly added.
+   */
+  bool add(const Key &key)
+  {
+    return this->add_as(key);
+  }
+  bool add(Key &&key)
+  {
+    return this->add_as(std::move(key));
+  }
+  template<typename ForwardKey> bool add_as(ForwardKey &&key)
+  {
+    return this->lookup_key_or_add_ptr(std::forward<ForwardKey>(key)).second;
+  }
+
+  /** Convenience function to add many keys to the set at once. */
+  void add_multiple(Span<Key> keys)
+  {
+    for (const Key &key : keys) {
+      this->add(key);
+    }
+  }
+
+  /** Convenience function to add many new keys to the set at once. */
+  void add_multiple_new(Span<Key> keys)
+  {
+    for (const Key &key : keys) {
+      this->add_new(key);
+    }
+  }
+
+  /**
+   * Returns true if the key is in the set.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return table_.lookup_slot_ptr(key) != nullptr;
+  }
+
+  /**
+   * Returns the key that is stored in the set that compares equal to the given key. This invokes
+   * undefined behavior when the key is not in the set.
+   */
+  const Key &lookup_key(const Key &key) const
+  {
+    return this->lookup_key_as(key);
+  }
+  template<typename ForwardKey> const Key &lookup_key_as(const ForwardKey &key) const
+  {
+    const Key *key_ptr = this->lookup_key_ptr_as(key);
+    BLI_assert(key_ptr != nullptr);
+    return *key_ptr;
+  }
+
+  /**
+   * Returns a pointer to the key that is stored in the set that compares equal to the given key.
+   * If the key is not in the set, null is returned.
+   */
+  const Key *lookup_key_ptr(const Key &key) const
+  {
+    return this->lookup_key_ptr_as(key);
+  }
+  template<typename ForwardKey> const Key *lookup_key_ptr_as(const ForwardKey &key) const
+  {
+    return table_.lookup_slot_ptr(key);
+  }
+
+  /**
+   * Returns the key in the set that compares equal to the given key. If it does not exist, the key
+   * is newly added.
+   */
+  const Key &lookup_key_or_add(const Key &key)
+  {
+    return this->lookup_key_or_add_as(key);
+  }
+  const Key &lookup_key_or_add(Key &&key)
+  {
+    return this->lookup_key_or_add_as(std::move(key));
+  }
+  template<typename ForwardKey> const Key &lookup_key_or_add_as(ForwardKey &&key)
+  {
+    return *this->lookup_key_or_add_ptr(std::forward<ForwardKey>(key)).first;
+  }
+
+  /**
+   * Deletes the key from the set. Returns true when the key did exist beforehand, otherwise false.
+   */
+  bool remove(const Key &key)
+  {
+    return this->remove_as(key);
+  }
+  template<typename ForwardKey> bool remove_as(const ForwardKey &key)
+  {
+    Key *slot = table_.lookup_slot_ptr(key);
+    if (slot == nullptr) {
+      return false;
+    }
+    table_.remove_slot(*slot);
+    return true;
+  }
+
+  /**
+   * Deletes the key from the set. This invokes undefined behavior when the key is not in the set.
+   */
+  void remove_contained(const Key &key)
+  {
+    this->remove_contained_as(key);
+  }
+  template<typename ForwardKey> void remove_contained_as(const ForwardKey &key)
+  {
+    Key *slot = table_.lookup_slot_ptr(key);
+    BLI_assert(slot != nullptr);
+    table_.remove_slot(*slot);
+  }
+
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using pointer = const Key *;
+    using reference = const Key &;
+    using difference_type = std::ptrdiff_t;
+
+   private:
+    typename Table::SlotIterator slot_iterator_;
+
+   public:
+    Iterator(typename Table::SlotIterator slot_iterator) : slot_iterator_(slot_iterator)
+    {
+    }
+
+    Iterator &operator++()
+    {
+      ++slot_iterator_;
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      Iterator copied_iterator = *this;
+      ++(*this);
+      return copied_iterator;
+    }
+
+    const Key &operator*() const
+    {
+      return *slot_iterator_;
+    }
+
+    const Key *operator->() const
+    {
+      return &*slot_iterator_;
+    }
+
+    friend bool operator!=(const Iterator &a, const Iterator &b)
+    {
+      return a.slot_iterator_ != b.slot_iterator_;
+    }
+
+    friend bool operator==(const Iterator &a, const Iterator &b)
+    {
+      return !(a != b);
+    }
+  };
+
+  /** The iterators are invalidated when the set is changed. */
+  Iterator begin() const
+  {
+    return table_.begin();
+  }
+
+  Iterator end() const
+  {
+    return table_.end();
+  }
+
+  /** Returns the number of keys stored in the set. */
+  int64_t size() const
+  {
+    return table_.size();
+  }
+
+  /** Returns true if no keys are stored. */
+  bool is_empty() const
+  {
+    return table_.size() == 0;
+  }
+
+  /** Returns the number of available slots. This is mostly for debugging purposes. */
+  int64_t capacity() const
+  {
+    return table_.capacity();
+  }
+
+  /** Returns the amount of removed slots in the set. This is mostly for debugging purposes. */
+  int64_t removed_amount() const
+  {
+    return table_.removed_amount();
+  }
+
+  /** Returns the approximate memory requirements of the set in bytes. */
+  int64_t size_in_bytes() const
+  {
+    return table_.size_in_bytes();
+  }
+
+  /**
+   * Potentially resize the set such that it can hold the specified number of keys without another
+   * grow operation.
+   */
+  void reserve(const int64_t n)
+  {
+    table_.reserve(n);
+  }
+
+  /** Removes all keys from the set and frees the memory. */
+  void clear()
+  {
+    table_ = Table();
+  }
+
+ private:
+  template<typename ForwardKey> std::pair<Key *, bool> lookup_key_or_add_ptr(ForwardKey &&key)
+  {
+    auto create_slot = [&](void *buffer) { new (buffer) Key(std::forward<ForwardKey>(key)); };
+    return table_.lookup_or_add_slot(key, create_slot);
+  }
+};
+
+}  // namespace blender
@@ -0,0 +1,636 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * This file contains the hash table that is shared by #blender::SwissMap and #blender::SwissSet.
+ *
+ * Unlike #blender::Map and #blender::Set, which store the state of a slot in the slot itself and
+ * compare one slot at a time, this table stores a separate array of control bytes with one byte
+ * per slot. The byte of an occupied slot contains 7 bits of the hash of its key, the remaining
+ * values mark empty and removed slots. Slots are grouped into groups of #Group::width slots, and a
+ * lookup compares the control bytes of a whole group with the searched hash bits at once using
+ * SIMD instructions (or a portable bit-trick on 64 bit integers when SSE2 is not available). Keys
+ * are only compared for the few slots whose hash bits match. The probing sequence visits whole
+ * groups and can stop as soon as a group contains an empty slot, which allows for a high max load
+ * factor of 7/8.
+ *
+ * This design is known as "Swiss Table". It mainly pays off for lookup heavy code with many keys.
+ * For small tables and for tables that are mostly filled with #add_new, the simpler slot types of
+ * #blender::Map are often just as fast. The benchmarks in the tests can be used to compare them.
+ *
+ * The slots themselves are not initialized until they become occupied. The #Policy template
+ * parameter defines what is stored in a slot and how to get the key from it.
+ */
+
+#include <utility>
+
+#include "BLI_allocator.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_index_range.hh"
+#include "BLI_math_bits.h"
+#include "BLI_memory_utils.hh"
+#include "BLI_simd.h"
+#include "BLI_utildefines.h"
+
+namespace blender::swiss_table {
+
+/**
+ * One control byte exists per slot. Occupied slots store the lower 7 bits of their (remixed)
+ * hash, so the highest bit is only set for empty and removed slots.
+ */
+using Ctrl = int8_t;
+inline constexpr Ctrl ctrl_empty = -128;
+inline constexpr Ctrl ctrl_removed = -2;
+
+inline bool ctrl_is_occupied(const Ctrl ctrl)
+{
+  return ctrl >= 0;
+}
+
+/**
+ * The default hash of integers and pointers is not well distributed in the lower bits, but those
+ * bits are used for the control bytes as well as for the group index. So the hash is remixed.
+ */
+inline uint64_t mix_hash(uint64_t hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdLLU;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/** Bits of the mixed hash that are used to find the first group of the probing sequence. */
+inline uint64_t hash_group_bits(const uint64_t mixed_hash)
+{
+  return mixed_hash >> 7;
+}
+
+/** Bits of the mixed hash that are stored in the control byte of an occupied slot. */
+inline Ctrl hash_ctrl_bits(const uint64_t mixed_hash)
+{
+  return Ctrl(mixed_hash & 0x7f);
+}
+
+/**
+ * The set of slots in a group that matched a condition. It can be iterated over to get the
+ * indices of the slots within the group.
+ */
+class BitMask {
+ private:
+#ifdef BLI_HAVE_SSE2
+  /** One bit per control byte. */
+  using MaskT = uint32_t;
+  static constexpr int shift = 0;
+#else
+  /** The highest bit of every control byte. */
+  using MaskT = uint64_t;
+  static constexpr int shift = 3;
+#endif
+  MaskT mask_;
+
+ public:
+  explicit BitMask(const MaskT mask) : mask_(mask)
+  {
+  }
+
+  explicit operator bool() const
+  {
+    return mask_ != 0;
+  }
+
+  int first() const
+  {
+    return int(bitscan_forward_uint64(mask_) >> shift);
+  }
+
+  BitMask begin() const
+  {
+    return *this;
+  }
+
+  BitMask end() const
+  {
+    return BitMask(0);
+  }
+
+  int operator*() const
+  {
+    return this->first();
+  }
+
+  BitMask &operator++()
+  {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+
+  friend bool operator!=(const BitMask &a, const BitMask &b)
+  {
+    return a.mask_ != b.mask_;
+  }
+};
+
+#ifdef BLI_HAVE_SSE2
+
+/** The control bytes of a group of slots, compared with a single SSE2 instruction. */
+struct Group {
+  static constexpr int width = 16;
+
+  __m128i ctrl;
+
+  /** The control bytes of a group are aligned to the group size. */
+  explicit Group(const Ctrl *group_ctrl)
+      : ctrl(_mm_load_si128(reinterpret_cast<const __m128i *>(group_ctrl)))
+  {
+  }
+
+  BitMask match(const Ctrl hash_bits) const
+  {
+    return BitMask(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash_bits), ctrl))));
+  }
+
+  BitMask match_empty() const
+  {
+    return this->match(ctrl_empty);
+  }
+
+  BitMask match_empty_or_removed() const
+  {
+    return BitMask(uint32_t(_mm_movemask_epi8(ctrl)));
+  }
+};
+
+#else
+
+/** The control bytes of a group of slots, compared using bit operations on a 64 bit integer. */
+struct Group {
+  static constexpr int width = 8;
+  static constexpr uint64_t lsbs = 0x0101010101010101LLU;
+  static constexpr uint64_t msbs = 0x8080808080808080LLU;
+
+  uint64_t ctrl;
+
+  explicit Group(const Ctrl *group_ctrl) : ctrl(0)
+  {
+    /* Independent of endianness, compilers turn this into a single load on little endian. */
+    for (int i = 0; i < width; i++) {
+      ctrl |= uint64_t(uint8_t(group_ctrl[i])) << (i * 8);
+    }
+  }
+
+  /**
+   * Can report false positives in rare cases, which is fine because the keys are compared
+   * afterwards anyway. Empty and removed slots are never reported, because their highest bit is
+   * set while it is never set in the searched hash bits.
+   */
+  BitMask match(const Ctrl hash_bits) const
+  {
+    const uint64_t x = ctrl ^ (lsbs * uint8_t(hash_bits));
+    return BitMask((x - lsbs) & ~x & msbs);
+  }
+
+  BitMask match_empty() const
+  {
+    /* Empty is the only value with the highest bit set and the second lowest bit unset. */
+    return BitMask(ctrl & (~ctrl << 6) & msbs);
+  }
+
+  BitMask match_empty_or_removed() const
+  {
+    return BitMask(ctrl & msbs);
+  }
+};
+
+#endif
+
+template<
+    /**
+     * Defines the type that is stored in the slots with `Policy::Slot` and extracts the key from
+     * a slot with `Policy::key(slot)`.
+     */
+    typename Policy,
+    typename Hash,
+    typename IsEqual,
+    typename Allocator>
+class Table {
+ public:
+  using Slot = typename Policy::Slot;
+
+ private:
+  /** Both arrays have #capacity_ elements and are in a single allocation. */
+  Ctrl *ctrl_ = nullptr;
+  Slot *slots_ = nullptr;
+  /** Zero or a power of two that is at least #Group::width. */
+  int64_t capacity_ = 0;
+  int64_t occupied_ = 0;
+  int64_t removed_ = 0;
+
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+  BLI_NO_UNIQUE_ADDRESS IsEqual is_equal_;
+  BLI_NO_UNIQUE_ADDRESS Allocator allocator_;
+
+  /** The max load factor is 7/8, counting occupied and removed slots. */
+  static int64_t usable_slots_for_capacity(const int64_t capacity)
+  {
+    return capacity - capacity / 8;
+  }
+
+  static size_t slots_offset(const int64_t capacity)
+  {
+    return size_t(ceil_division(capacity, int64_t(alignof(Slot))) * int64_t(alignof(Slot)));
+  }
+
+ public:
+  Table(Allocator allocator = {}) noexcept : hash_(), is_equal_(), allocator_(allocator)
+  {
+  }
+
+  ~Table()
+  {
+    this->destruct_slots();
+    if (ctrl_ != nullptr) {
+      allocator_.deallocate(ctrl_);
+    }
+  }
+
+  Table(const Table &other)
+      : hash_(other.hash_), is_equal_(other.is_equal_), allocator_(other.allocator_)
+  {
+    if (other.capacity_ == 0) {
+      return;
+    }
+    this->allocate(other.capacity_);
+    int64_t copied_num = 0;
+    try {
+      for (const int64_t i : IndexRange(capacity_)) {
+        if (ctrl_is_occupied(other.ctrl_[i])) {
+          new (&slots_[i]) Slot(other.slots_[i]);
+          ctrl_[i] = other.ctrl_[i];
+          copied_num++;
+        }
+      }
+    }
+    catch (...) {
+      occupied_ = copied_num;
+      throw;
+    }
+    /* The removed slots are copied as well, so that probing sequences don't change. */
+    for (const int64_t i : IndexRange(capacity_)) {
+      if (other.ctrl_[i] == ctrl_removed) {
+        ctrl_[i] = ctrl_removed;
+      }
+    }
+    occupied_ = other.occupied_;
+    removed_ = other.removed_;
+  }
+
+  Table(Table &&other) noexcept
+      : ctrl_(other.ctrl_),
+        slots_(other.slots_),
+        capacity_(other.capacity_),
+        occupied_(other.occupied_),
+        removed_(other.removed_),
+        hash_(std::move(other.hash_)),
+        is_equal_(std::move(other.is_equal_)),
+        allocator_(other.allocator_)
+  {
+    other.ctrl_ = nullptr;
+    other.slots_ = nullptr;
+    other.capacity_ = 0;
+    other.occupied_ = 0;
+    other.removed_ = 0;
+  }
+
+  Table &operator=(const Table &other)
+  {
+    return copy_assign_container(*this, other);
+  }
+
+  Table &operator=(Table &&other)
+  {
+    return move_assign_container(*this, std::move(other));
+  }
+
+  int64_t size() const
+  {
+    return occupied_;
+  }
+
+  int64_t capacity() const
+  {
+    return capacity_;
+  }
+
+  int64_t removed_amount() const
+  {
+    return removed_;
+  }
+
+  int64_t size_in_bytes() const
+  {
+    if (capacity_ == 0) {
+      return 0;
+    }
+    return int64_t(slots_offset(capacity_) + size_t(capacity_) * sizeof(Slot));
+  }
+
+  /** Find the slot that contains the key, or null if the key is not in the table. */
+  template<typename ForwardKey> Slot *lookup_slot_ptr(const ForwardKey &key) const
+  {
+    if (capacity_ == 0) {
+      return nullptr;
+    }
+    const uint64_t hash = mix_hash(hash_(key));
+    const Ctrl hash_bits = hash_ctrl_bits(hash);
+    const int64_t groups_mask = capacity_ / Group::width - 1;
+    int64_t group_index = int64_t(hash_group_bits(hash)) & groups_mask;
+    for (int64_t step = 1;; step++) {
+      const int64_t group_start = group_index * Group::width;
+      const Group group(ctrl_ + group_start);
+      for (const int i : group.match(hash_bits)) {
+        Slot &slot = slots_[group_start + i];
+        if (is_equal_(key, Policy::key(slot))) {
+          return &slot;
+        }
+      }
+      if (group.match_empty()) {
+        return nullptr;
+      }
+      /* Triangular steps visit every group once, because the number of groups is a power of 2. */
+      group_index = (group_index + step) & groups_mask;
+    }
+  }
+
+  /**
+   * Find the slot that contains the key, or construct a new slot with `create_slot(void *buffer)`
+   * if the key is not in the table. The returned boolean is true when a new slot was added.
+   */
+  template<typename ForwardKey, typename CreateSlotF>
+  std::pair<Slot *, bool> lookup_or_add_slot(const ForwardKey &key, const CreateSlotF &create_slot)
+  {
+    const uint64_t hash = mix_hash(hash_(key));
+    const Ctrl hash_bits = hash_ctrl_bits(hash);
+    int64_t free_index = -1;
+    if (capacity_ > 0) {
+      const int64_t groups_mask = capacity_ / Group::width - 1;
+      int64_t group_index = int64_t(hash_group_bits(hash)) & groups_mask;
+      for (int64_t step = 1;; step++) {
+        const int64_t group_start = group_index * Group::width;
+        const Group group(ctrl_ + group_start);
+        for (const int i : group.match(hash_bits)) {
+          Slot &slot = slots_[group_start + i];
+          if (is_equal_(key, Policy::key(slot))) {
+            return {&slot, false};
+          }
+        }
+        if (free_index == -1) {
+          if (const BitMask free_slots = group.match_empty_or_removed()) {
+            free_index = group_start + free_slots.first();
+          }
+        }
+        if (group.match_empty()) {
+          break;
+        }
+        group_index = (group_index + step) & groups_mask;
+      }
+    }
+    if (free_index == -1 || (ctrl_[free_index] == ctrl_empty && !this->has_usable_slot())) {
+      this->grow();
+      free_index = this->find_free_index(hash);
+    }
+    return {this->add_at_index(free_index, hash_bits, create_slot), true};
+  }
+
+  /**
+   * Construct a new slot with `create_slot(void *buffer)` without checking if the key exists
+   * already. This invokes undefined behavior when the key is in the table already.
+   */
+  template<typename ForwardKey, typename CreateSlotF>
+  Slot *add_new_slot(const ForwardKey &key, const CreateSlotF &create_slot)
+  {
+    const uint64_t hash = mix_hash(hash_(key));
+    if (!this->has_usable_slot()) {
+      this->grow();
+    }
+    const int64_t free_index = this->find_free_index(hash);
+    return this->add_at_index(free_index, hash_ctrl_bits(hash), create_slot);
+  }
+
+  /** Destruct the slot and mark it as unused. The slot must be part of this table. */
+  void remove_slot(Slot &slot)
+  {
+    const int64_t index = &slot - slots_;
+    BLI_assert(index >= 0 && index < capacity_);
+    BLI_assert(ctrl_is_occupied(ctrl_[index]));
+    slot.~Slot();
+    occupied_--;
+    /* If the group has an empty slot, no probing sequence ever went past it. So the slot can
+     * become empty again, instead of having to be skipped by future lookups. */
+    const int64_t group_start = index & ~int64_t(Group::width - 1);
+    if (Group(ctrl_ + group_start).match_empty()) {
+      ctrl_[index] = ctrl_empty;
+    }
+    else {
+      ctrl_[index] = ctrl_removed;
+      removed_++;
+    }
+  }
+
+  /** Make sure that at least n keys can be added without reallocating. */
+  void reserve(const int64_t n)
+  {
+    if (usable_slots_for_capacity(capacity_) < n + removed_) {
+      this->realloc_and_reinsert(this->capacity_for_size(std::max(n, occupied_)));
+    }
+  }
+
+  /** Call the function for every occupied slot. */
+  template<typename FuncT> void foreach_slot(const FuncT &func) const
+  {
+    for (const int64_t i : IndexRange(capacity_)) {
+      if (ctrl_is_occupied(ctrl_[i])) {
+        func(slots_[i]);
+      }
+    }
+  }
+
+  /** Iterates over all occupied slots. */
+  class SlotIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Slot;
+    using pointer = Slot *;
+    using reference = Slot &;
+
+   private:
+    const Ctrl *ctrl_;
+    Slot *slots_;
+    int64_t capacity_;
+    int64_t index_;
+
+   public:
+    SlotIterator(const Ctrl *ctrl, Slot *slots, const int64_t capacity, const int64_t index)
+        : ctrl_(ctrl), slots_(slots), capacity_(capacity), index_(index)
+    {
+      this->skip_unused();
+    }
+
+    SlotIterator &operator++()
+    {
+      index_++;
+      this->skip_unused();
+      return *this;
+    }
+
+    SlotIterator operator++(int)
+    {
+      SlotIterator copied_iterator = *this;
+      ++(*this);
+      return copied_iterator;
+    }
+
+    Slot &operator*() const
+    {
+      return slots_[index_];
+    }
+
+    friend bool operator!=(const SlotIterator &a, const SlotIterator &b)
+    {
+      BLI_assert(a.slots_ == b.slots_);
+      return a.index_ != b.index_;
+    }
+
+    friend bool operator==(const SlotIterator &a, const SlotIterator &b)
+    {
+      return !(a != b);
+    }
+
+   private:
+    void skip_unused()
+    {
+      while (index_ < capacity_ && !ctrl_is_occupied(ctrl_[index_])) {
+        index_++;
+      }
+    }
+  };
+
+  SlotIterator begin() const
+  {
+    return SlotIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  SlotIterator end() const
+  {
+    return SlotIterator(ctrl_, slots_, capacity_, capacity_);
+  }
+
+ private:
+  bool has_usable_slot() const
+  {
+    return occupied_ + removed_ < usable_slots_for_capacity(capacity_);
+  }
+
+  int64_t capacity_for_size(const int64_t size) const
+  {
+    int64_t capacity = Group::width;
+    while (usable_slots_for_capacity(capacity) < size) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  /** Find the first empty or removed slot in the probing sequence of the hash. */
+  int64_t find_free_index(const uint64_t hash) const
+  {
+    BLI_assert(this->has_usable_slot());
+    const int64_t groups_mask = capacity_ / Group::width - 1;
+    int64_t group_index = int64_t(hash_group_bits(hash)) & groups_mask;
+    for (int64_t step = 1;; step++) {
+      const int64_t group_start = group_index * Group::width;
+      if (const BitMask free_slots = Group(ctrl_ + group_start).match_empty_or_removed()) {
+        return group_start + free_slots.first();
+      }
+      group_index = (group_index + step) & groups_mask;
+    }
+  }
+
+  template<typename CreateSlotF>
+  Slot *add_at_index(const int64_t index, const Ctrl hash_bits, const CreateSlotF &create_slot)
+  {
+    Slot *slot = &slots_[index];
+    /* Only change the state when the slot has been constructed, in case it throws. */
+    create_slot(static_cast<void *>(slot));
+    if (ctrl_[index] == ctrl_removed) {
+      removed_--;
+    }
+    ctrl_[index] = hash_bits;
+    occupied_++;
+    return slot;
+  }
+
+  /** Called when there are no usable slots left. */
+  BLI_NOINLINE void grow()
+  {
+    /* When many slots are only removed, reinserting all keys in a table with the same size is
+     * enough to make room. */
+    const int64_t new_capacity = (occupied_ * 32 <= capacity_ * 25) ?
+                                     std::max<int64_t>(capacity_, Group::width) :
+                                     capacity_ * 2;
+    this->realloc_and_reinsert(new_capacity);
+  }
+
+  void allocate(const int64_t capacity)
+  {
+    BLI_assert(is_power_of_2_constexpr(capacity) && capacity >= Group::width);
+    const size_t slots_offset = Table::slots_offset(capacity);
+    void *buffer = allocator_.allocate(slots_offset + size_t(capacity) * sizeof(Slot),
+                                       std::max<size_t>(alignof(Slot), Group::width),
+                                       __func__);
+    ctrl_ = static_cast<Ctrl *>(buffer);
+    slots_ = reinterpret_cast<Slot *>(static_cast<char *>(buffer) + slots_offset);
+    capacity_ = capacity;
+    occupied_ = 0;
+    removed_ = 0;
+    memset(ctrl_, ctrl_empty, size_t(capacity));
+  }
+
+  BLI_NOINLINE void realloc_and_reinsert(const int64_t new_capacity)
+  {
+    Ctrl *old_ctrl = ctrl_;
+    Slot *old_slots = slots_;
+    const int64_t old_capacity = capacity_;
+    const int64_t old_occupied = occupied_;
+    this->allocate(new_capacity);
+
+    /* Moving the keys is assumed to not throw, like in the other hash tables. */
+    for (const int64_t i : IndexRange(old_capacity)) {
+      if (ctrl_is_occupied(old_ctrl[i])) {
+        Slot &old_slot = old_slots[i];
+        const uint64_t hash = mix_hash(hash_(Policy::key(old_slot)));
+        const int64_t index = this->find_free_index(hash);
+        new (&slots_[index]) Slot(std::move(old_slot));
+        old_slot.~Slot();
+        ctrl_[index] = hash_ctrl_bits(hash);
+      }
+    }
+    occupied_ = old_occupied;
+
+    if (old_ctrl != nullptr) {
+      allocator_.deallocate(old_ctrl);
+    }
+  }
+
+  void destruct_slots()
+  {
+    if constexpr (!std::is_trivially_destructible_v<Slot>) {
+      this->foreach_slot([](Slot &slot) { slot.~Slot(); });
+    }
+  }
+};
+
+}  // namespace blender::swiss_table
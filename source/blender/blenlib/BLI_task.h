@@ -433,6 +433,35 @@ void BLI_task_isolate(void (*func)(void *userdata), void *userdata);
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Task Arenas
+ *
+ * By default all work shares one set of worker threads. Work can also be run in a separate
+ * arena with worker threads of its own, in order to:
+ * - Give it a lower priority. Threads then prefer work of the default arena, which keeps the
+ *   interface responsive while e.g. a render runs in the background.
+ * - Bind the threads to a NUMA node, so that the work and the memory it touches first stay on
+ *   one socket of a multi-socket system.
+ *
+ * All work spawned from within an arena (parallel loops, task pools) runs in that arena.
+ * Arenas require TBB 2021 or newer, and NUMA binding needs its `tbbbind` library. Otherwise the
+ * function is executed directly and #BLI_task_scheduler_numa_nodes_num is 1.
+ * \{ */
+
+/** Number of NUMA nodes work can be bound to, at least 1. */
+int BLI_task_scheduler_numa_nodes_num(void);
+
+/**
+ * Execute \a func in the arena for NUMA node \a numa_node (-1 for no binding) with the given
+ * priority, and wait for it to complete.
+ */
+void BLI_task_arena_execute(int numa_node,
+                            eTaskPriority priority,
+                            void (*func)(void *userdata),
+                            void *userdata);
+
+/** \} */
+
 #ifdef __cplusplus
 }
 #endif
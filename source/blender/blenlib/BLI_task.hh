@@ -32,6 +32,7 @@
 
 #include "BLI_index_range.hh"
 #include "BLI_lazy_threading.hh"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 namespace blender::threading {
@@ -135,4 +136,26 @@ template<typename Function> void isolate_task(const Function &function)
 #endif
 }
 
+#ifdef WITH_TBB
+namespace detail {
+/** Arena for the NUMA node and priority, null when the default arena should be used. */
+tbb::task_arena *task_arena_get(int numa_node, eTaskPriority priority);
+}  // namespace detail
+#endif
+
+/** See #BLI_task_arena_execute. */
+template<typename Function>
+void arena_execute(const int numa_node, const eTaskPriority priority, const Function &function)
+{
+#ifdef WITH_TBB
+  if (tbb::task_arena *arena = detail::task_arena_get(numa_node, priority)) {
+    arena->execute(function);
+    return;
+  }
+#else
+  UNUSED_VARS(numa_node, priority);
+#endif
+  function();
+}
+
 }  // namespace blender::threading
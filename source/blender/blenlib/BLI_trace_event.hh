@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Writing of profiles in the Chrome trace event JSON format, which can be loaded in
+ * `chrome://tracing` or Perfetto. Events are written to the stream directly, so that long
+ * profiles don't have to be built up in memory a second time.
+ */
+
+#include <iosfwd>
+
+#include "BLI_span.hh"
+#include "BLI_string_ref.hh"
+
+namespace blender::trace_event {
+
+/**
+ * Small sequential number of the calling thread, easier to read in a trace viewer than system
+ * thread identifiers. The numbers are shared by all profiles of the process.
+ */
+int thread_index();
+
+/** Additional numeric value shown with an event. */
+struct EventArg {
+  StringRef name;
+  double value;
+};
+
+/** An event with a known start and duration (a "complete" event in the trace event format). */
+struct CompleteEvent {
+  StringRef name;
+  StringRef category;
+  /** Time-stamp in micro-seconds, relative to the start of the trace. */
+  double start_us;
+  double duration_us;
+  /** Process and thread the event is displayed in. */
+  int pid;
+  int tid;
+  Span<EventArg> args;
+};
+
+/**
+ * Writes the start of the JSON document when constructed and its end when destructed, events are
+ * written in between.
+ */
+class Writer {
+ private:
+  std::ostream &stream_;
+
+ public:
+  explicit Writer(std::ostream &stream);
+  ~Writer();
+
+  /** Name shown for the events of the process with identifier \a pid. */
+  void process_name(int pid, StringRef name);
+
+  void complete_event(const CompleteEvent &event);
+
+ private:
+  void write_string(StringRef str);
+};
+
+}  // namespace blender::trace_event
@@ -20,6 +20,8 @@
  *   #BLI_bvhtree_overlap, #BVHOverlapData_Shared, #BVHOverlapData_Thread
  * - Range Query:
  *   #BLI_bvhtree_range_query
+ * - Batched ray-cast and nearest point queries:
+ *   #BLI_bvhtree_ray_cast_batch, #BLI_bvhtree_find_nearest_batch
  */
 
 #include "MEM_guardedalloc.h"
@@ -28,6 +30,8 @@
 #include "BLI_heap_simple.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_math.h"
+#include "BLI_math_bits.h"
+#include "BLI_simd.h"
 #include "BLI_stack.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
@@ -685,6 +689,9 @@ typedef struct BVHDivNodesData {
   int depth;
   int i;
   int first_of_next_level;
+
+  /** The leafs are already sorted spatially, see #bvh_leafs_sort_morton. */
+  bool use_sorted_leafs;
 } BVHDivNodesData;
 
 static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
@@ -702,28 +709,32 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
   int parent_leafs_begin = implicit_leafs_index(data->data, data->depth, parent_level_index);
   int parent_leafs_end = implicit_leafs_index(data->data, data->depth, parent_level_index + 1);
 
-  /* This calculates the bounding box of this branch
-   * and chooses the largest axis as the axis to divide leafs */
-  refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
-  split_axis = get_largest_axis(parent->bv);
-
-  /* Save split axis (this can be used on ray-tracing to speedup the query time) */
-  parent->main_axis = split_axis / 2;
-
-  /* Split the children along the split_axis, NOTE: its not needed to sort the whole leafs array
-   * Only to assure that the elements are partitioned on a way that each child takes the elements
-   * it would take in case the whole array was sorted.
-   * Split_leafs takes care of that "sort" problem. */
-  nth_positions[0] = parent_leafs_begin;
-  nth_positions[data->tree_type] = parent_leafs_end;
-  for (k = 1; k < data->tree_type; k++) {
-    const int child_index = j * data->tree_type + data->tree_offset + k;
-    /* child level index */
-    const int child_level_index = child_index - data->first_of_next_level;
-    nth_positions[k] = implicit_leafs_index(data->data, data->depth + 1, child_level_index);
-  }
+  /* With sorted leafs, every child simply takes a contiguous range of the leafs. The bounds and
+   * split axis are computed bottom-up afterwards, see #bvh_refit_levels. */
+  if (!data->use_sorted_leafs) {
+    /* This calculates the bounding box of this branch
+     * and chooses the largest axis as the axis to divide leafs */
+    refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+    split_axis = get_largest_axis(parent->bv);
+
+    /* Save split axis (this can be used on ray-tracing to speedup the query time) */
+    parent->main_axis = split_axis / 2;
+
+    /* Split the children along the split_axis, NOTE: its not needed to sort the whole leafs
+     * array Only to assure that the elements are partitioned on a way that each child takes the
+     * elements it would take in case the whole array was sorted.
+     * Split_leafs takes care of that "sort" problem. */
+    nth_positions[0] = parent_leafs_begin;
+    nth_positions[data->tree_type] = parent_leafs_end;
+    for (k = 1; k < data->tree_type; k++) {
+      const int child_index = j * data->tree_type + data->tree_offset + k;
+      /* child level index */
+      const int child_level_index = child_index - data->first_of_next_level;
+      nth_positions[k] = implicit_leafs_index(data->data, data->depth + 1, child_level_index);
+    }
 
-  split_leafs(data->leafs_array, nth_positions, data->tree_type, split_axis);
+    split_leafs(data->leafs_array, nth_positions, data->tree_type, split_axis);
+  }
 
   /* Setup `children` and `node_num` counters
    * Not really needed but currently most of BVH code
@@ -753,6 +764,224 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
   parent->node_num = (char)k;
 }
 
+typedef struct BVHRefitLevelData {
+  const BVHTree *tree;
+  BVHNode *branches_array;
+  bool update_main_axis;
+} BVHRefitLevelData;
+
+static void bvh_refit_level_cb(void *__restrict userdata,
+                               const int j,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHRefitLevelData *data = userdata;
+  BVHNode *node = &data->branches_array[j];
+  node_join((BVHTree *)data->tree, node);
+  if (data->update_main_axis) {
+    node->main_axis = get_largest_axis(node->bv) / 2;
+  }
+}
+
+/**
+ * Compute the bounds of all branches of the implicit tree from their children, starting at the
+ * deepest level. The branches of one level are independent from each other, so every level is
+ * processed in parallel.
+ *
+ * \param branches_array: The branches, with the root at index 1.
+ * \param update_main_axis: Set the main axis from the new bounds, only valid when the children
+ * are not sorted along the current main axis already.
+ */
+static void bvh_refit_levels(const BVHTree *tree,
+                             BVHNode *branches_array,
+                             const int branches_num,
+                             const bool update_main_axis)
+{
+  const int tree_type = tree->tree_type;
+  const int tree_offset = 2 - tree_type;
+
+  /* Ranges of the branches on every level, the same as in #non_recursive_bvh_div_nodes. */
+  int level_ranges[32][2];
+  int levels_num = 0;
+  for (int i = 1; i <= branches_num; i = i * tree_type + tree_offset) {
+    BLI_assert(levels_num < (int)ARRAY_SIZE(level_ranges));
+    level_ranges[levels_num][0] = i;
+    level_ranges[levels_num][1] = min_ii(i * tree_type + tree_offset, branches_num + 1);
+    levels_num++;
+  }
+
+  BVHRefitLevelData data = {
+      .tree = tree,
+      .branches_array = branches_array,
+      .update_main_axis = update_main_axis,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (tree->leaf_num > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  for (int level = levels_num - 1; level >= 0; level--) {
+    BLI_task_parallel_range(
+        level_ranges[level][0], level_ranges[level][1], &data, bvh_refit_level_cb, &settings);
+  }
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Morton Order Build
+ *
+ * Alternative to partitioning the leafs on every level while building the tree: sort all leafs
+ * along a Morton curve of their centers once, and let every branch take a contiguous range of
+ * the sorted leafs. The sort and every level of the tree are processed in parallel, and the
+ * bounds are computed bottom-up from the children. This is much faster to build for large trees,
+ * at the cost of slightly less tight trees.
+ * \{ */
+
+#define BVH_MORTON_SORT_CHUNK_SIZE 16384
+#define BVH_MORTON_RADIX_BITS 8
+#define BVH_MORTON_RADIX_SIZE (1 << BVH_MORTON_RADIX_BITS)
+
+/** Insert two zero bits between each of the lower 10 bits. */
+static uint bvh_morton_expand_bits_10(uint value)
+{
+  value &= 0x3ffu;
+  value = (value | (value << 16)) & 0x030000ffu;
+  value = (value | (value << 8)) & 0x0300f00fu;
+  value = (value | (value << 4)) & 0x030c30c3u;
+  value = (value | (value << 2)) & 0x09249249u;
+  return value;
+}
+
+typedef struct BVHMortonSortData {
+  BVHNode **leafs;
+  BVHNode **leafs_tmp;
+  uint *keys;
+  uint *keys_tmp;
+  int leafs_num;
+  int chunks_num;
+
+  float min[3];
+  float scale[3];
+
+  int shift;
+  /** Per chunk and bucket write offsets of a radix sort pass. */
+  int (*offsets)[BVH_MORTON_RADIX_SIZE];
+} BVHMortonSortData;
+
+static void bvh_morton_keys_cb(void *__restrict userdata,
+                               const int chunk,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHMortonSortData *data = userdata;
+  const int start = chunk * BVH_MORTON_SORT_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_MORTON_SORT_CHUNK_SIZE, data->leafs_num);
+  for (int i = start; i < end; i++) {
+    const float *bv = data->leafs[i]->bv;
+    uint key = 0;
+    for (int axis = 0; axis < 3; axis++) {
+      const float center = (bv[2 * axis] + bv[2 * axis + 1]) * 0.5f;
+      /* Written so that NAN coordinates end up in the first cell. */
+      const float cell = (center - data->min[axis]) * data->scale[axis];
+      const uint cell_index = (cell > 0.0f) ? (uint)min_ff(cell, 1023.0f) : 0u;
+      key |= bvh_morton_expand_bits_10(cell_index) << axis;
+    }
+    data->keys[i] = key;
+  }
+}
+
+static void bvh_morton_histogram_cb(void *__restrict userdata,
+                                    const int chunk,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHMortonSortData *data = userdata;
+  const int start = chunk * BVH_MORTON_SORT_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_MORTON_SORT_CHUNK_SIZE, data->leafs_num);
+  int *counts = data->offsets[chunk];
+  memset(counts, 0, sizeof(*data->offsets));
+  for (int i = start; i < end; i++) {
+    counts[(data->keys[i] >> data->shift) & (BVH_MORTON_RADIX_SIZE - 1)]++;
+  }
+}
+
+static void bvh_morton_scatter_cb(void *__restrict userdata,
+                                  const int chunk,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHMortonSortData *data = userdata;
+  const int start = chunk * BVH_MORTON_SORT_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_MORTON_SORT_CHUNK_SIZE, data->leafs_num);
+  int *offsets = data->offsets[chunk];
+  for (int i = start; i < end; i++) {
+    const uint key = data->keys[i];
+    const int dst = offsets[(key >> data->shift) & (BVH_MORTON_RADIX_SIZE - 1)]++;
+    data->keys_tmp[dst] = key;
+    data->leafs_tmp[dst] = data->leafs[i];
+  }
+}
+
+/**
+ * Sort the leafs along a Morton curve of the centers of their bounds, with a parallel radix
+ * sort. Only supported when the bounds contain the X, Y and Z axes.
+ */
+static void bvh_leafs_sort_morton(const BVHTree *tree, BVHNode **leafs, const int leafs_num)
+{
+  BLI_assert(tree->start_axis == 0);
+
+  BVHMortonSortData data;
+  data.leafs = leafs;
+  data.leafs_num = leafs_num;
+  data.chunks_num = (leafs_num + BVH_MORTON_SORT_CHUNK_SIZE - 1) / BVH_MORTON_SORT_CHUNK_SIZE;
+
+  /* The root bounds are not known yet, compute the bounds of the centers. */
+  float max[3];
+  INIT_MINMAX(data.min, max);
+  for (int i = 0; i < leafs_num; i++) {
+    const float *bv = leafs[i]->bv;
+    const float center[3] = {
+        (bv[0] + bv[1]) * 0.5f, (bv[2] + bv[3]) * 0.5f, (bv[4] + bv[5]) * 0.5f};
+    minmax_v3v3_v3(data.min, max, center);
+  }
+  for (int axis = 0; axis < 3; axis++) {
+    const float size = max[axis] - data.min[axis];
+    data.scale[axis] = (size > 0.0f) ? 1023.0f / size : 0.0f;
+  }
+
+  data.keys = MEM_mallocN(sizeof(uint) * (size_t)leafs_num, __func__);
+  data.keys_tmp = MEM_mallocN(sizeof(uint) * (size_t)leafs_num, __func__);
+  data.leafs_tmp = MEM_mallocN(sizeof(BVHNode *) * (size_t)leafs_num, __func__);
+  data.offsets = MEM_mallocN(sizeof(*data.offsets) * (size_t)data.chunks_num, __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (leafs_num > KDOPBVH_THREAD_LEAF_THRESHOLD);
+
+  BLI_task_parallel_range(0, data.chunks_num, &data, bvh_morton_keys_cb, &settings);
+
+  /* The keys have 30 bits, so an even number of passes is needed and the result ends up in the
+   * original arrays. */
+  for (data.shift = 0; data.shift < 32; data.shift += BVH_MORTON_RADIX_BITS) {
+    BLI_task_parallel_range(0, data.chunks_num, &data, bvh_morton_histogram_cb, &settings);
+
+    /* Turn the counts into write offsets, ordered by bucket first so that the sort is stable. */
+    int offset = 0;
+    for (int bucket = 0; bucket < BVH_MORTON_RADIX_SIZE; bucket++) {
+      for (int chunk = 0; chunk < data.chunks_num; chunk++) {
+        const int count = data.offsets[chunk][bucket];
+        data.offsets[chunk][bucket] = offset;
+        offset += count;
+      }
+    }
+
+    BLI_task_parallel_range(0, data.chunks_num, &data, bvh_morton_scatter_cb, &settings);
+    SWAP(uint *, data.keys, data.keys_tmp);
+    SWAP(BVHNode **, data.leafs, data.leafs_tmp);
+  }
+  BLI_assert(data.leafs == leafs);
+
+  MEM_freeN(data.keys);
+  MEM_freeN(data.keys_tmp);
+  MEM_freeN(data.leafs_tmp);
+  MEM_freeN(data.offsets);
+}
+
+/** \} */
+
 /**
  * This functions builds an optimal implicit tree from the given leafs.
  * Where optimal stands for:
@@ -774,7 +1003,8 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
 static void non_recursive_bvh_div_nodes(const BVHTree *tree,
                                         BVHNode *branches_array,
                                         BVHNode **leafs_array,
-                                        int leafs_num)
+                                        int leafs_num,
+                                        const bool use_sorted_leafs)
 {
   int i;
 
@@ -816,6 +1046,7 @@ static void non_recursive_bvh_div_nodes(const BVHTree *tree,
       .first_of_next_level = 0,
       .depth = 0,
       .i = 0,
+      .use_sorted_leafs = use_sorted_leafs,
   };
 
   /* Loop tree levels (log N) loops */
@@ -843,6 +1074,10 @@ static void non_recursive_bvh_div_nodes(const BVHTree *tree,
       }
     }
   }
+
+  if (use_sorted_leafs) {
+    bvh_refit_levels(tree, branches_array, branches_num, true);
+  }
 }
 
 /** \} */
@@ -934,7 +1169,7 @@ void BLI_bvhtree_free(BVHTree *tree)
   }
 }
 
-void BLI_bvhtree_balance(BVHTree *tree)
+void BLI_bvhtree_balance_ex(BVHTree *tree, const int flag)
 {
   BVHNode **leafs_array = tree->nodes;
 
@@ -942,9 +1177,19 @@ void BLI_bvhtree_balance(BVHTree *tree)
    * (some big bug goes here if its being called more than once per tree) */
   BLI_assert(tree->branch_num == 0);
 
+  /* The Morton order uses the X, Y and Z axes, which are not part of 18-DOP trees. */
+  const bool use_sorted_leafs = (flag & BVH_BALANCE_MORTON_ORDER) && tree->start_axis == 0 &&
+                                tree->leaf_num > 1;
+  if (use_sorted_leafs) {
+    bvh_leafs_sort_morton(tree, leafs_array, tree->leaf_num);
+  }
+
   /* Build the implicit tree */
-  non_recursive_bvh_div_nodes(
-      tree, tree->nodearray + (tree->leaf_num - 1), leafs_array, tree->leaf_num);
+  non_recursive_bvh_div_nodes(tree,
+                              tree->nodearray + (tree->leaf_num - 1),
+                              leafs_array,
+                              tree->leaf_num,
+                              use_sorted_leafs);
 
   /* current code expects the branches to be linked to the nodes array
    * we perform that linkage here */
@@ -966,6 +1211,11 @@ void BLI_bvhtree_balance(BVHTree *tree)
 #endif
 }
 
+void BLI_bvhtree_balance(BVHTree *tree)
+{
+  BLI_bvhtree_balance_ex(tree, 0);
+}
+
 static void bvhtree_node_inflate(const BVHTree *tree, BVHNode *node, const float dist)
 {
   axis_t axis_iter;
@@ -1021,15 +1271,10 @@ bool BLI_bvhtree_update_node(
 void BLI_bvhtree_update_tree(BVHTree *tree)
 {
   /* Update bottom=>top
-   * TRICKY: the way we build the tree all the children have an index greater than the parent
-   * This allows us todo a bottom up update by starting on the bigger numbered branch. */
-
-  BVHNode **root = tree->nodes + tree->leaf_num;
-  BVHNode **index = tree->nodes + tree->leaf_num + tree->branch_num - 1;
-
-  for (; index >= root; index--) {
-    node_join(tree, *index);
-  }
+   * TRICKY: the way we build the tree all the children have an index greater than the parent,
+   * and the branches of a level are stored next to each other. This allows us todo a bottom up
+   * update level by level, starting at the deepest level. */
+  bvh_refit_levels(tree, tree->nodearray + (tree->leaf_num - 1), tree->branch_num, false);
 }
 int BLI_bvhtree_get_len(const BVHTree *tree)
 {
@@ -1624,6 +1869,228 @@ int BLI_bvhtree_find_nearest(BVHTree *tree,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Queries
+ *
+ * Answer many queries at once. The queries are sorted along a Morton curve so that queries
+ * which are processed together are spatially coherent. They are then traversed in packets of
+ * #BVH_PACKET_SIZE queries, which share the traversal and test the bounding volumes of a node
+ * against all queries of the packet at once.
+ * \{ */
+
+#define BVH_PACKET_SIZE 4
+#define BVH_PACKET_MORTON_BITS 9
+
+typedef struct BVHBatchOrder {
+  uint key;
+  int index;
+} BVHBatchOrder;
+
+static int bvh_batch_order_cmp(const void *a_v, const void *b_v)
+{
+  const BVHBatchOrder *a = a_v;
+  const BVHBatchOrder *b = b_v;
+  if (a->key < b->key) {
+    return -1;
+  }
+  if (a->key > b->key) {
+    return 1;
+  }
+  return 0;
+}
+
+/** Insert two zero bits between each of the lower #BVH_PACKET_MORTON_BITS bits. */
+static uint bvh_morton_expand_bits(uint value)
+{
+  value &= (1u << BVH_PACKET_MORTON_BITS) - 1u;
+  value = (value | (value << 16)) & 0x030000ffu;
+  value = (value | (value << 8)) & 0x0300f00fu;
+  value = (value | (value << 4)) & 0x030c30c3u;
+  value = (value | (value << 2)) & 0x09249249u;
+  return value;
+}
+
+/**
+ * Sort the queries along a Morton curve within the bounds of their positions.
+ * When ray directions are given, rays are grouped by the octant of their direction first,
+ * because rays with different direction signs traverse the tree in a different order.
+ */
+static BVHBatchOrder *bvh_batch_order_create(const float (*co)[3],
+                                             const float (*dir)[3],
+                                             const int num)
+{
+  float min[3], max[3], scale[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < num; i++) {
+    minmax_v3v3_v3(min, max, co[i]);
+  }
+  const float cells_max = (float)((1 << BVH_PACKET_MORTON_BITS) - 1);
+  for (int axis = 0; axis < 3; axis++) {
+    const float size = max[axis] - min[axis];
+    scale[axis] = (size > 0.0f) ? cells_max / size : 0.0f;
+  }
+
+  BVHBatchOrder *order = MEM_mallocN(sizeof(*order) * (size_t)num, __func__);
+  for (int i = 0; i < num; i++) {
+    uint key = 0;
+    for (int axis = 0; axis < 3; axis++) {
+      /* Written so that NAN coordinates end up in the first cell. */
+      const float cell = (co[i][axis] - min[axis]) * scale[axis];
+      const uint cell_index = (cell > 0.0f) ? (uint)min_ff(cell, cells_max) : 0u;
+      key |= bvh_morton_expand_bits(cell_index) << axis;
+    }
+    if (dir) {
+      const uint octant = (dir[i][0] < 0.0f ? 1u : 0u) | (dir[i][1] < 0.0f ? 2u : 0u) |
+                          (dir[i][2] < 0.0f ? 4u : 0u);
+      key |= octant << (3 * BVH_PACKET_MORTON_BITS);
+    }
+    order[i].key = key;
+    order[i].index = i;
+  }
+  qsort(order, (size_t)num, sizeof(*order), bvh_batch_order_cmp);
+  return order;
+}
+
+typedef struct BVHNearestPacket {
+  BVHNearestData data[BVH_PACKET_SIZE];
+  /** Projections of the query positions on the first three axes, one array per axis. */
+  float proj[3][BVH_PACKET_SIZE];
+} BVHNearestPacket;
+
+/**
+ * \return The bits of \a mask for the queries which are closer to the node bounds than to their
+ * current nearest element.
+ */
+static int bvh_nearest_packet_test(const BVHNearestPacket *packet,
+                                   const BVHNode *node,
+                                   const int mask)
+{
+#ifdef BLI_HAVE_SSE2
+  const float *bv = node->bv;
+  __m128 dist_sq = _mm_setzero_ps();
+  for (int axis = 0; axis < 3; axis++) {
+    const __m128 proj = _mm_loadu_ps(packet->proj[axis]);
+    const __m128 nearest = _mm_min_ps(_mm_max_ps(proj, _mm_set1_ps(bv[2 * axis])),
+                                      _mm_set1_ps(bv[2 * axis + 1]));
+    const __m128 delta = _mm_sub_ps(proj, nearest);
+    dist_sq = _mm_add_ps(dist_sq, _mm_mul_ps(delta, delta));
+  }
+  const __m128 limit = _mm_set_ps(packet->data[3].nearest.dist_sq,
+                                  packet->data[2].nearest.dist_sq,
+                                  packet->data[1].nearest.dist_sq,
+                                  packet->data[0].nearest.dist_sq);
+  return mask & _mm_movemask_ps(_mm_cmplt_ps(dist_sq, limit));
+#else
+  int result = 0;
+  for (int lane = 0; lane < BVH_PACKET_SIZE; lane++) {
+    if (mask & (1 << lane)) {
+      float nearest[3];
+      const BVHNearestData *data = &packet->data[lane];
+      if (calc_nearest_point_squared(data->proj, (BVHNode *)node, nearest) <
+          data->nearest.dist_sq) {
+        result |= 1 << lane;
+      }
+    }
+  }
+  return result;
+#endif
+}
+
+static void dfs_find_nearest_packet(BVHNearestPacket *packet, BVHNode *node, const int mask)
+{
+  if (node->node_num == 0) {
+    for (int lane = 0; lane < BVH_PACKET_SIZE; lane++) {
+      if (mask & (1 << lane)) {
+        BVHNearestData *data = &packet->data[lane];
+        if (data->callback) {
+          data->callback(data->userdata, node->index, data->co, &data->nearest);
+        }
+        else {
+          data->nearest.index = node->index;
+          data->nearest.dist_sq = calc_nearest_point_squared(data->proj, node, data->nearest.co);
+        }
+      }
+    }
+    return;
+  }
+
+  /* Use the first active query to pick the closest node to dive on, the other queries of the
+   * packet are expected to be close to it. */
+  const BVHNearestData *first = &packet->data[bitscan_forward_i(mask)];
+  if (first->proj[node->main_axis] <= node->children[0]->bv[node->main_axis * 2 + 1]) {
+    for (int i = 0; i != node->node_num; i++) {
+      const int child_mask = bvh_nearest_packet_test(packet, node->children[i], mask);
+      if (child_mask) {
+        dfs_find_nearest_packet(packet, node->children[i], child_mask);
+      }
+    }
+  }
+  else {
+    for (int i = node->node_num - 1; i >= 0; i--) {
+      const int child_mask = bvh_nearest_packet_test(packet, node->children[i], mask);
+      if (child_mask) {
+        dfs_find_nearest_packet(packet, node->children[i], child_mask);
+      }
+    }
+  }
+}
+
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    const int num,
+                                    BVHTreeNearest *nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata)
+{
+  BVHNode *root = tree->nodes[tree->leaf_num];
+  if (root == NULL || num == 0) {
+    return;
+  }
+
+  BVHBatchOrder *order = bvh_batch_order_create(co, NULL, num);
+  if (tree->start_axis != 0) {
+    /* The packet test reads the first three axes as x, y and z, which 18-DOP trees don't have. */
+    for (int i = 0; i < num; i++) {
+      const int index = order[i].index;
+      BLI_bvhtree_find_nearest(tree, co[index], &nearest[index], callback, userdata);
+    }
+    MEM_freeN(order);
+    return;
+  }
+
+  for (int start = 0; start < num; start += BVH_PACKET_SIZE) {
+    const int packet_num = min_ii(BVH_PACKET_SIZE, num - start);
+    BVHNearestPacket packet;
+    for (int lane = 0; lane < BVH_PACKET_SIZE; lane++) {
+      /* Unused lanes repeat the last query, they are masked out during the traversal. */
+      const int index = order[start + min_ii(lane, packet_num - 1)].index;
+      BVHNearestData *data = &packet.data[lane];
+      data->tree = tree;
+      data->co = co[index];
+      data->callback = callback;
+      data->userdata = userdata;
+      for (axis_t axis_iter = tree->start_axis; axis_iter != tree->stop_axis; axis_iter++) {
+        data->proj[axis_iter] = dot_v3v3(data->co, bvhtree_kdop_axes[axis_iter]);
+      }
+      data->nearest = nearest[index];
+      for (int axis = 0; axis < 3; axis++) {
+        packet.proj[axis][lane] = data->proj[axis];
+      }
+    }
+
+    const int mask = bvh_nearest_packet_test(&packet, root, (1 << packet_num) - 1);
+    if (mask) {
+      dfs_find_nearest_packet(&packet, root, mask);
+    }
+    for (int lane = 0; lane < packet_num; lane++) {
+      nearest[order[start + lane].index] = packet.data[lane].nearest;
+    }
+  }
+  MEM_freeN(order);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLI_bvhtree_find_nearest_first
  * \{ */
@@ -2024,6 +2491,156 @@ void BLI_bvhtree_ray_cast_all(BVHTree *tree,
       tree, co, dir, radius, hit_dist, callback, userdata, BVH_RAYCAST_DEFAULT);
 }
 
+typedef struct BVHRayCastPacket {
+  BVHRayCastData data[BVH_PACKET_SIZE];
+  /** Ray origins and inverted directions on the first three axes, one array per axis. */
+  float origin[3][BVH_PACKET_SIZE];
+  float idot_axis[3][BVH_PACKET_SIZE];
+} BVHRayCastPacket;
+
+/**
+ * Same test as #fast_ray_nearest_hit for all rays of the packet.
+ * \return The bits of \a mask for the rays that hit the node bounds before their current hit.
+ */
+static int bvh_raycast_packet_test(const BVHRayCastPacket *packet,
+                                   const BVHNode *node,
+                                   const int mask)
+{
+#ifdef BLI_HAVE_SSE2
+  const float *bv = node->bv;
+  __m128 near = _mm_set1_ps(-FLT_MAX);
+  __m128 far = _mm_set1_ps(FLT_MAX);
+  for (int axis = 0; axis < 3; axis++) {
+    const __m128 origin = _mm_loadu_ps(packet->origin[axis]);
+    const __m128 idot = _mm_loadu_ps(packet->idot_axis[axis]);
+    const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * axis]), origin), idot);
+    const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * axis + 1]), origin), idot);
+    near = _mm_max_ps(near, _mm_min_ps(t1, t2));
+    far = _mm_min_ps(far, _mm_max_ps(t1, t2));
+  }
+  const __m128 hit_dist = _mm_set_ps(packet->data[3].hit.dist,
+                                     packet->data[2].hit.dist,
+                                     packet->data[1].hit.dist,
+                                     packet->data[0].hit.dist);
+  const __m128 is_hit = _mm_and_ps(
+      _mm_and_ps(_mm_cmple_ps(near, far), _mm_cmpge_ps(far, _mm_setzero_ps())),
+      _mm_cmplt_ps(near, hit_dist));
+  return mask & _mm_movemask_ps(is_hit);
+#else
+  int result = 0;
+  for (int lane = 0; lane < BVH_PACKET_SIZE; lane++) {
+    if (mask & (1 << lane)) {
+      const BVHRayCastData *data = &packet->data[lane];
+      if (fast_ray_nearest_hit(data, node) < data->hit.dist) {
+        result |= 1 << lane;
+      }
+    }
+  }
+  return result;
+#endif
+}
+
+static void dfs_raycast_packet(BVHRayCastPacket *packet, BVHNode *node, const int mask)
+{
+  if (node->node_num == 0) {
+    for (int lane = 0; lane < BVH_PACKET_SIZE; lane++) {
+      if (mask & (1 << lane)) {
+        BVHRayCastData *data = &packet->data[lane];
+        if (data->callback) {
+          data->callback(data->userdata, node->index, &data->ray, &data->hit);
+        }
+        else {
+          const float dist = fast_ray_nearest_hit(data, node);
+          data->hit.index = node->index;
+          data->hit.dist = dist;
+          madd_v3_v3v3fl(data->hit.co, data->ray.origin, data->ray.direction, dist);
+        }
+      }
+    }
+    return;
+  }
+
+  /* Rays in a packet usually share the direction octant, see #bvh_batch_order_create. */
+  const BVHRayCastData *first = &packet->data[bitscan_forward_i(mask)];
+  if (first->ray_dot_axis[node->main_axis] > 0.0f) {
+    for (int i = 0; i != node->node_num; i++) {
+      const int child_mask = bvh_raycast_packet_test(packet, node->children[i], mask);
+      if (child_mask) {
+        dfs_raycast_packet(packet, node->children[i], child_mask);
+      }
+    }
+  }
+  else {
+    for (int i = node->node_num - 1; i >= 0; i--) {
+      const int child_mask = bvh_raycast_packet_test(packet, node->children[i], mask);
+      if (child_mask) {
+        dfs_raycast_packet(packet, node->children[i], child_mask);
+      }
+    }
+  }
+}
+
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                const int num,
+                                const float radius,
+                                BVHTreeRayHit *hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                const int flag)
+{
+  BVHNode *root = tree->nodes[tree->leaf_num];
+  if (root == NULL || num == 0) {
+    return;
+  }
+
+  BVHBatchOrder *order = bvh_batch_order_create(co, dir, num);
+  if (radius != 0.0f || tree->start_axis != 0) {
+    /* The packet test does not support a ray radius, like #fast_ray_nearest_hit. It also reads
+     * the first three axes as x, y and z, which 18-DOP trees don't have. */
+    for (int i = 0; i < num; i++) {
+      const int index = order[i].index;
+      BLI_bvhtree_ray_cast_ex(
+          tree, co[index], dir[index], radius, &hits[index], callback, userdata, flag);
+    }
+    MEM_freeN(order);
+    return;
+  }
+
+  for (int start = 0; start < num; start += BVH_PACKET_SIZE) {
+    const int packet_num = min_ii(BVH_PACKET_SIZE, num - start);
+    BVHRayCastPacket packet;
+    for (int lane = 0; lane < BVH_PACKET_SIZE; lane++) {
+      /* Unused lanes repeat the last ray, they are masked out during the traversal. */
+      const int index = order[start + min_ii(lane, packet_num - 1)].index;
+      BVHRayCastData *data = &packet.data[lane];
+      BLI_ASSERT_UNIT_V3(dir[index]);
+      data->tree = tree;
+      data->callback = callback;
+      data->userdata = userdata;
+      copy_v3_v3(data->ray.origin, co[index]);
+      copy_v3_v3(data->ray.direction, dir[index]);
+      data->ray.radius = 0.0f;
+      bvhtree_ray_cast_data_precalc(data, flag);
+      data->hit = hits[index];
+      for (int axis = 0; axis < 3; axis++) {
+        packet.origin[axis][lane] = data->ray.origin[axis];
+        packet.idot_axis[axis][lane] = data->idot_axis[axis];
+      }
+    }
+
+    const int mask = bvh_raycast_packet_test(&packet, root, (1 << packet_num) - 1);
+    if (mask) {
+      dfs_raycast_packet(&packet, root, mask);
+    }
+    for (int lane = 0; lane < packet_num; lane++) {
+      hits[order[start + lane].index] = packet.data[lane].hit;
+    }
+  }
+  MEM_freeN(order);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
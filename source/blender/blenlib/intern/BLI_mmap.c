@@ -202,6 +202,35 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
   return !file->io_error;
 }
 
+bool BLI_mmap_access(BLI_mmap_file *file,
+                     size_t offset,
+                     size_t length,
+                     BLI_mmap_access_fn fn,
+                     void *user_data)
+{
+  /* Same as #BLI_mmap_read, but lets the callback work on the mapped memory directly. */
+  if (file->io_error || (offset + length > file->length)) {
+    return false;
+  }
+
+#ifndef WIN32
+  /* If an error occurs while the callback accesses the memory, sigbus_handler will be called
+   * and will set file->io_error to true. */
+  fn(file->memory + offset, length, user_data);
+#else
+  __try {
+    fn(file->memory + offset, length, user_data);
+  }
+  __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER :
+                                                            EXCEPTION_CONTINUE_SEARCH) {
+    file->io_error = true;
+    return false;
+  }
+#endif
+
+  return !file->io_error;
+}
+
 void *BLI_mmap_get_pointer(BLI_mmap_file *file)
 {
   return file->memory;
@@ -1141,7 +1141,28 @@ static BChunkList *bchunk_list_from_data_merge(const BArrayInfo *info,
       use_aligned = true;
     }
     else {
-      /* TODO: walk over chunks and check if some arbitrary amount align. */
+      /* Walk over the chunks which weren't matched by the fast-paths and compare them in place.
+       * Arrays that keep their length are often modified in a few scattered places only
+       * (transforming some vertices of a mesh for e.g.), so storing the chunks that changed is
+       * much cheaper than hashing the whole range. Use a tighter limit than above since chunks
+       * that don't align are stored without looking up their data elsewhere in the array. */
+      const size_t unaligned_limit = chunk_list->total_size / 8;
+      size_t unaligned_len = 0;
+      const BChunkRef *cref = cref_match_first ? cref_match_first->next :
+                                                 chunk_list_reference->chunk_refs.first;
+      size_t i = i_prev;
+      while (i != data_len) {
+        const size_t i_next = i + cref->link->data_len;
+        if (!bchunk_data_compare(cref->link, data, data_len, i)) {
+          unaligned_len += cref->link->data_len;
+          if (unaligned_len > unaligned_limit) {
+            break;
+          }
+        }
+        cref = cref->next;
+        i = i_next;
+      }
+      use_aligned = (i == data_len);
     }
   }
 #endif /* USE_ALIGN_CHUNKS_TEST */
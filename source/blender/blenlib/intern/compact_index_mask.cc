@@ -0,0 +1,179 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+
+#include "BLI_array.hh"
+#include "BLI_compact_index_mask.hh"
+
+namespace blender {
+
+namespace {
+
+struct ChunkInfo {
+  /** Number of indices in the chunk. */
+  int64_t size = 0;
+  int64_t first = 0;
+  int64_t last = 0;
+};
+
+}  // namespace
+
+template<typename CountFn, typename FillFn>
+void CompactIndexMask::build(const int64_t chunks_num,
+                             const CountFn &count_chunk,
+                             const FillFn &fill_chunk)
+{
+  Array<ChunkInfo> chunk_infos(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 64, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      chunk_infos[chunk] = count_chunk(chunk);
+    }
+  });
+
+  /* Choose the representation of every chunk, and join ranges that are next to each other. The
+   * offsets take less memory than bits, when less than one in 16 indices of the chunk is used. */
+  const int64_t max_offsets_num = chunk_words_num * int64_t(sizeof(uint64_t) / sizeof(uint16_t));
+  Array<int64_t> chunk_segments(chunks_num, -1);
+  int64_t offsets_num = 0;
+  int64_t words_num = 0;
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const ChunkInfo &info = chunk_infos[chunk];
+    if (info.size == 0) {
+      continue;
+    }
+    if (info.last - info.first + 1 == info.size) {
+      if (!segments_.is_empty()) {
+        Segment &prev_segment = segments_.last();
+        if (prev_segment.type == SegmentType::Range &&
+            prev_segment.start + prev_segment.size == info.first) {
+          prev_segment.size += info.size;
+          size_ += info.size;
+          continue;
+        }
+      }
+      segments_.append({SegmentType::Range, info.first, info.size, size_, 0});
+    }
+    else if (info.size < max_offsets_num) {
+      chunk_segments[chunk] = segments_.size();
+      segments_.append({SegmentType::Offsets, chunk * chunk_size, info.size, size_, offsets_num});
+      offsets_num += info.size;
+    }
+    else {
+      chunk_segments[chunk] = segments_.size();
+      segments_.append({SegmentType::Bits, chunk * chunk_size, info.size, size_, words_num});
+      words_num += chunk_words_num;
+    }
+    size_ += info.size;
+  }
+
+  offsets_.resize(offsets_num);
+  bits_.resize(words_num);
+  threading::parallel_for(IndexRange(chunks_num), 16, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      if (chunk_segments[chunk] == -1) {
+        continue;
+      }
+      const Segment &segment = segments_[chunk_segments[chunk]];
+      if (segment.type == SegmentType::Offsets) {
+        uint16_t *offsets = offsets_.data() + segment.data_offset;
+        fill_chunk(chunk, [&](const int64_t i) { *offsets++ = uint16_t(i - segment.start); });
+      }
+      else {
+        MutableSpan<uint64_t> words = bits_.as_mutable_span().slice(segment.data_offset,
+                                                                    chunk_words_num);
+        words.fill(0);
+        fill_chunk(chunk, [&](const int64_t i) {
+          const int64_t offset = i - segment.start;
+          words[offset / bits_per_word] |= uint64_t(1) << (offset % bits_per_word);
+        });
+      }
+    }
+  });
+}
+
+CompactIndexMask::CompactIndexMask(const IndexMask mask)
+{
+  if (mask.is_empty()) {
+    return;
+  }
+  if (mask.is_range()) {
+    segments_.append({SegmentType::Range, mask[0], mask.size(), 0, 0});
+    size_ = mask.size();
+    return;
+  }
+  const Span<int64_t> indices = mask.indices();
+  const int64_t chunks_num = mask.last() / chunk_size + 1;
+
+  /* Position of the first index of every chunk in the mask. */
+  Array<int64_t> chunk_starts(chunks_num + 1);
+  threading::parallel_for(IndexRange(chunks_num), 1024, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      chunk_starts[chunk] = std::lower_bound(indices.begin(), indices.end(), chunk * chunk_size) -
+                            indices.begin();
+    }
+  });
+  chunk_starts.last() = indices.size();
+
+  const auto chunk_indices = [&](const int64_t chunk) {
+    return indices.slice(chunk_starts[chunk], chunk_starts[chunk + 1] - chunk_starts[chunk]);
+  };
+  this->build(
+      chunks_num,
+      [&](const int64_t chunk) {
+        const Span<int64_t> chunk_mask = chunk_indices(chunk);
+        if (chunk_mask.is_empty()) {
+          return ChunkInfo();
+        }
+        return ChunkInfo{chunk_mask.size(), chunk_mask.first(), chunk_mask.last()};
+      },
+      [&](const int64_t chunk, const auto &fn) {
+        for (const int64_t i : chunk_indices(chunk)) {
+          fn(i);
+        }
+      });
+}
+
+CompactIndexMask CompactIndexMask::from_bools(const Span<bool> bools)
+{
+  CompactIndexMask mask;
+  const auto chunk_range = [&](const int64_t chunk) {
+    return bools.index_range().slice(chunk * chunk_size,
+                                     std::min(chunk_size, bools.size() - chunk * chunk_size));
+  };
+  mask.build(
+      (bools.size() + chunk_size - 1) / chunk_size,
+      [&](const int64_t chunk) {
+        ChunkInfo info;
+        for (const int64_t i : chunk_range(chunk)) {
+          if (bools[i]) {
+            if (info.size == 0) {
+              info.first = i;
+            }
+            info.last = i;
+            info.size++;
+          }
+        }
+        return info;
+      },
+      [&](const int64_t chunk, const auto &fn) {
+        for (const int64_t i : chunk_range(chunk)) {
+          if (bools[i]) {
+            fn(i);
+          }
+        }
+      });
+  return mask;
+}
+
+void CompactIndexMask::to_indices(MutableSpan<int64_t> r_indices) const
+{
+  BLI_assert(r_indices.size() == size_);
+  threading::parallel_for(segments_.index_range(), 1, [&](const IndexRange range) {
+    for (const Segment &segment : segments_.as_span().slice(range)) {
+      int64_t *dst = r_indices.data() + segment.mask_offset;
+      this->foreach_index_in_segment(segment, [&](const int64_t i) { *dst++ = i; });
+    }
+  });
+}
+
+}  // namespace blender
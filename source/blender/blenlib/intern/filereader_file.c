@@ -59,6 +59,7 @@ FileReader *BLI_filereader_new_file(int filedes)
   rawfile->reader.read = file_read;
   rawfile->reader.seek = file_seek;
   rawfile->reader.close = file_close;
+  rawfile->reader.view = NULL;
 
   return (FileReader *)rawfile;
 }
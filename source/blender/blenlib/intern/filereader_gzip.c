@@ -87,6 +87,7 @@ FileReader *BLI_filereader_new_gzip(FileReader *base)
   gzip->reader.read = gzip_read;
   gzip->reader.seek = NULL;
   gzip->reader.close = gzip_close;
+  gzip->reader.view = NULL;
 
   return (FileReader *)gzip;
 }
@@ -61,6 +61,22 @@ static off64_t memory_seek(FileReader *reader, off64_t offset, int whence)
   return mem->reader.offset;
 }
 
+static bool memory_view_raw(FileReader *reader,
+                            off64_t offset,
+                            size_t size,
+                            FileReaderViewDataFn fn,
+                            void *user_data)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  if (offset < 0 || (size_t)offset + size > mem->length) {
+    return false;
+  }
+
+  fn(mem->data + offset, size, user_data);
+  return true;
+}
+
 static void memory_close_raw(FileReader *reader)
 {
   MEM_freeN(reader);
@@ -76,6 +92,7 @@ FileReader *BLI_filereader_new_memory(const void *data, size_t len)
   mem->reader.read = memory_read_raw;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_raw;
+  mem->reader.view = memory_view_raw;
 
   return (FileReader *)mem;
 }
@@ -102,6 +119,21 @@ static ssize_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
   return readsize;
 }
 
+static bool memory_view_mmap(FileReader *reader,
+                             off64_t offset,
+                             size_t size,
+                             FileReaderViewDataFn fn,
+                             void *user_data)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  if (offset < 0) {
+    return false;
+  }
+
+  return BLI_mmap_access(mem->mmap, (size_t)offset, size, fn, user_data);
+}
+
 static void memory_close_mmap(FileReader *reader)
 {
   MemoryReader *mem = (MemoryReader *)reader;
@@ -124,6 +156,7 @@ FileReader *BLI_filereader_new_mmap(int filedes)
   mem->reader.read = memory_read_mmap;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_mmap;
+  mem->reader.view = memory_view_mmap;
 
   return (FileReader *)mem;
 }
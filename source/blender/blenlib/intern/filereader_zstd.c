@@ -12,9 +12,39 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
+/* Upper limit for the number of frames of a seekable file that are decompressed ahead of the
+ * read position in parallel, each frame takes up to #ZSTD_CHUNK_SIZE (1 MB) of memory. */
+#define ZSTD_READ_AHEAD_FRAMES_MAX 16
+
+enum {
+  ZSTD_FRAME_EMPTY = 0,
+  ZSTD_FRAME_PENDING,
+  ZSTD_FRAME_READY,
+  ZSTD_FRAME_FAILED,
+};
+
+/* A decompressed frame of a seekable file, which may still be decompressing in the background. */
+typedef struct ZstdFrameCache {
+  int frame;
+  /* One of the `ZSTD_FRAME_*` values, set atomically by the decompression task. */
+  int32_t state;
+
+  ZSTD_DCtx *ctx;
+  char *compressed_data;
+  size_t compressed_size;
+  size_t compressed_capacity;
+  char *uncompressed_data;
+  size_t uncompressed_size;
+  size_t uncompressed_capacity;
+} ZstdFrameCache;
+
 typedef struct {
   FileReader reader;
 
@@ -29,8 +59,15 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
-    int cached_frame;
+    /* The frame at the read position, and when reading forward, the frames after it that are
+     * decompressed ahead in parallel so they are ready when the reader gets there. */
+    ZstdFrameCache *cache;
+    int cache_num;
+    TaskPool *task_pool;
+
+    /* The frame that was read last, and its cache if it was decompressed successfully. */
+    int current_frame;
+    ZstdFrameCache *current_cache;
   } seek;
 } ZstdReader;
 
@@ -126,7 +163,11 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
     return false;
   }
 
-  zstd->seek.cached_frame = -1;
+  zstd->seek.cache_num = clamp_i(BLI_system_thread_count(), 1, ZSTD_READ_AHEAD_FRAMES_MAX);
+  zstd->seek.cache = MEM_calloc_arrayN(
+      zstd->seek.cache_num, sizeof(ZstdFrameCache), "zstd frame cache");
+  zstd->seek.task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+  zstd->seek.current_frame = -1;
 
   return true;
 }
@@ -154,41 +195,129 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
-static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+static void zstd_decompress_frame_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  ZstdFrameCache *cache = (ZstdFrameCache *)taskdata;
+
+  if (cache->ctx == NULL) {
+    cache->ctx = ZSTD_createDCtx();
   }
+  size_t res = ZSTD_decompressDCtx(cache->ctx,
+                                   cache->uncompressed_data,
+                                   cache->uncompressed_size,
+                                   cache->compressed_data,
+                                   cache->compressed_size);
+  const bool success = !ZSTD_isError(res) && res >= cache->uncompressed_size;
+  atomic_store_int32(&cache->state, success ? ZSTD_FRAME_READY : ZSTD_FRAME_FAILED);
+}
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+/* Read the compressed data of a frame (the base reader is only accessed from the reading
+ * thread) and start decompressing it in the background. */
+static void zstd_frame_cache_start(ZstdReader *zstd, ZstdFrameCache *cache, int frame)
+{
+  BLI_assert(atomic_load_int32(&cache->state) != ZSTD_FRAME_PENDING);
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+  cache->frame = frame;
+  cache->compressed_size = zstd->seek.compressed_ofs[frame + 1] -
+                           zstd->seek.compressed_ofs[frame];
+  cache->uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
                              zstd->seek.uncompressed_ofs[frame];
+  if (cache->compressed_capacity < cache->compressed_size) {
+    MEM_SAFE_FREE(cache->compressed_data);
+    cache->compressed_data = MEM_mallocN(cache->compressed_size, __func__);
+    cache->compressed_capacity = cache->compressed_size;
+  }
+  if (cache->uncompressed_capacity < cache->uncompressed_size) {
+    MEM_SAFE_FREE(cache->uncompressed_data);
+    cache->uncompressed_data = MEM_mallocN(cache->uncompressed_size, __func__);
+    cache->uncompressed_capacity = cache->uncompressed_size;
+  }
 
-  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
-  char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
-      zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size) {
-    MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
-    return NULL;
+      zstd->base->read(zstd->base, cache->compressed_data, cache->compressed_size) <
+          cache->compressed_size) {
+    atomic_store_int32(&cache->state, ZSTD_FRAME_FAILED);
+    return;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
-  MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
-    return NULL;
+  atomic_store_int32(&cache->state, ZSTD_FRAME_PENDING);
+  BLI_task_pool_push(zstd->seek.task_pool, zstd_decompress_frame_task, cache, false, NULL);
+}
+
+static ZstdFrameCache *zstd_frame_cache_find(ZstdReader *zstd, int frame)
+{
+  for (int i = 0; i < zstd->seek.cache_num; i++) {
+    ZstdFrameCache *cache = &zstd->seek.cache[i];
+    if (cache->frame == frame && atomic_load_int32(&cache->state) != ZSTD_FRAME_EMPTY) {
+      return cache;
+    }
   }
+  return NULL;
+}
 
-  zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+/* Find a cache that can be reused, i.e. one that does not hold a frame in the given range. */
+static ZstdFrameCache *zstd_frame_cache_unused(ZstdReader *zstd, int first_frame, int last_frame)
+{
+  ZstdFrameCache *pending_cache = NULL;
+  for (int i = 0; i < zstd->seek.cache_num; i++) {
+    ZstdFrameCache *cache = &zstd->seek.cache[i];
+    const int32_t state = atomic_load_int32(&cache->state);
+    if (!ELEM(state, ZSTD_FRAME_EMPTY, ZSTD_FRAME_FAILED) &&
+        IN_RANGE_INCL(cache->frame, first_frame, last_frame)) {
+      continue;
+    }
+    if (state != ZSTD_FRAME_PENDING) {
+      return cache;
+    }
+    pending_cache = cache;
+  }
+  /* There are never more frames in the range than caches, so only caches of frames that are
+   * still being decompressed from before the read position jumped can be left. */
+  BLI_assert(pending_cache != NULL);
+  BLI_task_pool_work_and_wait(zstd->seek.task_pool);
+  return pending_cache;
+}
+
+/* Ensure that the given frame is decompressed, and start decompressing the following ones. */
+static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+{
+  if (zstd->seek.current_frame == frame && zstd->seek.current_cache != NULL) {
+    /* Cached frame matches, so just return it. */
+    return zstd->seek.current_cache->uncompressed_data;
+  }
+
+  const int last_frame = min_ii(frame + zstd->seek.cache_num - 1, zstd->seek.frames_num - 1);
+  /* Only decompress ahead when reading forward, to avoid wasted work for random access. */
+  const bool read_ahead = frame > zstd->seek.current_frame &&
+                          frame <= zstd->seek.current_frame + zstd->seek.cache_num;
+
+  ZstdFrameCache *cache = zstd_frame_cache_find(zstd, frame);
+  if (cache == NULL) {
+    cache = zstd_frame_cache_unused(zstd, frame, read_ahead ? last_frame : frame);
+    zstd_frame_cache_start(zstd, cache, frame);
+  }
+  else if (atomic_load_int32(&cache->state) == ZSTD_FRAME_FAILED) {
+    /* Retry, in case reading the compressed data failed. */
+    zstd_frame_cache_start(zstd, cache, frame);
+  }
+
+  if (read_ahead) {
+    for (int ahead_frame = frame + 1; ahead_frame <= last_frame; ahead_frame++) {
+      if (zstd_frame_cache_find(zstd, ahead_frame) == NULL) {
+        zstd_frame_cache_start(
+            zstd, zstd_frame_cache_unused(zstd, frame, last_frame), ahead_frame);
+      }
+    }
+  }
+
+  if (atomic_load_int32(&cache->state) == ZSTD_FRAME_PENDING) {
+    BLI_task_pool_work_and_wait(zstd->seek.task_pool);
+  }
+
+  zstd->seek.current_frame = frame;
+  zstd->seek.current_cache = (atomic_load_int32(&cache->state) == ZSTD_FRAME_READY) ? cache :
+                                                                                       NULL;
+  return zstd->seek.current_cache ? cache->uncompressed_data : NULL;
 }
 
 static ssize_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -279,12 +408,20 @@ static void zstd_close(FileReader *reader)
 
   ZSTD_freeDCtx(zstd->ctx);
   if (zstd->reader.seek) {
+    /* Wait for frames that are still being decompressed ahead of the read position. */
+    BLI_task_pool_work_and_wait(zstd->seek.task_pool);
+    BLI_task_pool_free(zstd->seek.task_pool);
+    for (int i = 0; i < zstd->seek.cache_num; i++) {
+      ZstdFrameCache *cache = &zstd->seek.cache[i];
+      if (cache->ctx) {
+        ZSTD_freeDCtx(cache->ctx);
+      }
+      MEM_SAFE_FREE(cache->compressed_data);
+      MEM_SAFE_FREE(cache->uncompressed_data);
+    }
+    MEM_freeN(zstd->seek.cache);
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: T99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
-    }
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -317,6 +454,7 @@ FileReader *BLI_filereader_new_zstd(FileReader *base)
     zstd->in_buf.pos = zstd->in_buf_max_size;
   }
   zstd->reader.close = zstd_close;
+  zstd->reader.view = NULL;
 
   /* Rewind after the seek table check so that zstd_read starts at the file's start. */
   zstd->base->seek(zstd->base, 0, SEEK_SET);
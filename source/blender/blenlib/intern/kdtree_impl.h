@@ -8,6 +8,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -42,6 +43,11 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/** Sub-trees with fewer nodes are balanced serially. */
+#define KD_BALANCE_PARALLEL_MIN_NODES 8192
+/** Number of consecutive (sorted) queries handled by a single task in batched searches. */
+#define KD_BATCH_CHUNK_SIZE 256
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /**
@@ -131,20 +137,15 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Quick-sort style partitioning of the nodes around the median along \a axis.
+ * \return The index of the median node.
+ */
+static uint kdtree_balance_median_split(KDTreeNode *nodes, const uint nodes_len, const uint axis)
 {
-  KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
-  /* Quick-sort style sorting around median. */
   left = 0;
   right = nodes_len - 1;
   median = nodes_len / 2;
@@ -176,6 +177,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_median_split(nodes, nodes_len, axis);
+
   /* Set node and sort sub-nodes. */
   node = &nodes[median];
   node->d = axis;
@@ -187,6 +205,76 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Parallel Balancing
+ *
+ * The two halves of every split only touch their own range of the nodes array,
+ * so large sub-trees are balanced in separate tasks. The same splits are made as
+ * in #kdtree_balance, the resulting tree is identical to the serially balanced one.
+ * \{ */
+
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  /** Where to store the index of the root of the sub-tree. */
+  uint *r_root;
+} KDTreeBalanceTask;
+
+static uint kdtree_balance_parallel(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs);
+
+static void kdtree_balance_task_fn(TaskPool *__restrict pool, void *taskdata)
+{
+  const KDTreeBalanceTask *task = taskdata;
+  *task->r_root = kdtree_balance_parallel(
+      pool, task->nodes, task->nodes_len, task->axis, task->ofs);
+}
+
+static uint kdtree_balance_parallel(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  KDTreeBalanceTask *task;
+  uint median;
+
+  if (nodes_len < KD_BALANCE_PARALLEL_MIN_NODES) {
+    return kdtree_balance(nodes, nodes_len, axis, ofs);
+  }
+
+  median = kdtree_balance_median_split(nodes, nodes_len, axis);
+
+  node = &nodes[median];
+  node->d = axis;
+  axis = (axis + 1) % KD_DIMS;
+
+  /* Balance the left half in another task and continue with the right half. */
+  task = MEM_mallocN(sizeof(*task), __func__);
+  task->nodes = nodes;
+  task->nodes_len = median;
+  task->axis = axis;
+  task->ofs = ofs;
+  task->r_root = &node->left;
+  BLI_task_pool_push(pool, kdtree_balance_task_fn, task, true, NULL);
+
+  node->right = kdtree_balance_parallel(
+      pool, nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+
+  return median + ofs;
+}
+
+static void kdtree_balance_isolated_fn(void *userdata)
+{
+  KDTree *tree = userdata;
+  TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+  tree->root = kdtree_balance_parallel(pool, tree->nodes, tree->nodes_len, 0, 0);
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+}
+
+/** \} */
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -196,7 +284,13 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len < KD_BALANCE_PARALLEL_MIN_NODES) {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
+  else {
+    /* Isolate, so waiting for the pool doesn't pick up unrelated tasks of the caller. */
+    BLI_task_isolate(kdtree_balance_isolated_fn, tree);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -459,43 +553,44 @@ static void nearest_ordered_insert(KDTreeNearest *nearest,
 }
 
 /**
- * Find \a nearest_len_capacity nearest returns number of points found, with results in nearest.
- *
- * \param r_nearest: An array of nearest, sized at least \a nearest_len_capacity.
+ * Traversal stack, which can be shared by many searches to avoid reallocating it.
  */
-int BLI_kdtree_nd_(find_nearest_n_with_len_squared_cb)(
-    const KDTree *tree,
-    const float co[KD_DIMS],
-    KDTreeNearest r_nearest[],
-    const uint nearest_len_capacity,
-    float (*len_sq_fn)(const float co_search[KD_DIMS],
-                       const float co_test[KD_DIMS],
-                       const void *user_data),
-    const void *user_data)
+typedef struct KDTreeStack {
+  uint *data;
+  uint len_capacity;
+  uint data_default[KD_STACK_INIT];
+} KDTreeStack;
+
+static void kdtree_stack_init(KDTreeStack *stack)
+{
+  stack->data = stack->data_default;
+  stack->len_capacity = ARRAY_SIZE(stack->data_default);
+}
+
+static void kdtree_stack_free(KDTreeStack *stack)
+{
+  if (stack->data != stack->data_default) {
+    MEM_freeN(stack->data);
+  }
+}
+
+static int kdtree_find_nearest_n_impl(const KDTree *tree,
+                                      const float co[KD_DIMS],
+                                      KDTreeNearest r_nearest[],
+                                      const uint nearest_len_capacity,
+                                      float (*len_sq_fn)(const float co_search[KD_DIMS],
+                                                         const float co_test[KD_DIMS],
+                                                         const void *user_data),
+                                      const void *user_data,
+                                      KDTreeStack *stack_data)
 {
   const KDTreeNode *nodes = tree->nodes;
   const KDTreeNode *root;
-  uint *stack, stack_default[KD_STACK_INIT];
+  uint *stack = stack_data->data;
   float cur_dist;
-  uint stack_len_capacity, cur = 0;
+  uint cur = 0;
   uint i, nearest_len = 0;
 
-#ifdef DEBUG
-  BLI_assert(tree->is_balanced == true);
-#endif
-
-  if (UNLIKELY((tree->root == KD_NODE_UNSET) || nearest_len_capacity == 0)) {
-    return 0;
-  }
-
-  if (len_sq_fn == NULL) {
-    len_sq_fn = len_squared_vnvn_cb;
-    BLI_assert(user_data == NULL);
-  }
-
-  stack = stack_default;
-  stack_len_capacity = ARRAY_SIZE(stack_default);
-
   root = &nodes[tree->root];
 
   cur_dist = len_sq_fn(co, root->co, user_data);
@@ -561,8 +656,10 @@ int BLI_kdtree_nd_(find_nearest_n_with_len_squared_cb)(
         stack[cur++] = node->left;
       }
     }
-    if (UNLIKELY(cur + KD_DIMS > stack_len_capacity)) {
-      stack = realloc_nodes(stack, &stack_len_capacity, stack_default != stack);
+    if (UNLIKELY(cur + KD_DIMS > stack_data->len_capacity)) {
+      stack = realloc_nodes(
+          stack, &stack_data->len_capacity, stack_data->data_default != stack);
+      stack_data->data = stack;
     }
   }
 
@@ -570,11 +667,46 @@ int BLI_kdtree_nd_(find_nearest_n_with_len_squared_cb)(
     r_nearest[i].dist = sqrtf(r_nearest[i].dist);
   }
 
-  if (stack != stack_default) {
-    MEM_freeN(stack);
+  return (int)nearest_len;
+}
+
+/**
+ * Find \a nearest_len_capacity nearest returns number of points found, with results in nearest.
+ *
+ * \param r_nearest: An array of nearest, sized at least \a nearest_len_capacity.
+ */
+int BLI_kdtree_nd_(find_nearest_n_with_len_squared_cb)(
+    const KDTree *tree,
+    const float co[KD_DIMS],
+    KDTreeNearest r_nearest[],
+    const uint nearest_len_capacity,
+    float (*len_sq_fn)(const float co_search[KD_DIMS],
+                       const float co_test[KD_DIMS],
+                       const void *user_data),
+    const void *user_data)
+{
+  KDTreeStack stack;
+  int nearest_len;
+
+#ifdef DEBUG
+  BLI_assert(tree->is_balanced == true);
+#endif
+
+  if (UNLIKELY((tree->root == KD_NODE_UNSET) || nearest_len_capacity == 0)) {
+    return 0;
   }
 
-  return (int)nearest_len;
+  if (len_sq_fn == NULL) {
+    len_sq_fn = len_squared_vnvn_cb;
+    BLI_assert(user_data == NULL);
+  }
+
+  kdtree_stack_init(&stack);
+  nearest_len = kdtree_find_nearest_n_impl(
+      tree, co, r_nearest, nearest_len_capacity, len_sq_fn, user_data, &stack);
+  kdtree_stack_free(&stack);
+
+  return nearest_len;
 }
 
 int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
@@ -586,6 +718,155 @@ int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
       tree, co, r_nearest, nearest_len_capacity, NULL, NULL);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Nearest Search
+ *
+ * Queries are ordered by the node they reach when descending the tree without backtracking.
+ * Nodes of a sub-tree are stored contiguously (see #kdtree_balance), so queries that are close
+ * in this order visit mostly the same nodes. Consecutive queries are processed by the same task,
+ * sharing a single traversal stack.
+ * \{ */
+
+typedef struct KDTreeBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  uint co_len;
+  /** Query indices, sorted by the node they descend to. */
+  uint *order;
+  /** Bucket of every query, used to sort them. */
+  uint *buckets;
+  uint buckets_len;
+  KDTreeNearest *r_nearest;
+  uint nearest_len_capacity;
+  int *r_nearest_len;
+} KDTreeBatchData;
+
+static void kdtree_batch_bucket_cb(void *__restrict userdata,
+                                   const int chunk,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  const KDTreeNode *nodes = data->tree->nodes;
+  const uint nodes_len = data->tree->nodes_len;
+  const uint start = (uint)chunk * KD_BATCH_CHUNK_SIZE;
+  const uint end = MIN2(start + KD_BATCH_CHUNK_SIZE, data->co_len);
+
+  for (uint i = start; i < end; i++) {
+    const float *co = data->co[i];
+    uint node_index = data->tree->root;
+    while (true) {
+      const KDTreeNode *node = &nodes[node_index];
+      const uint next = (co[node->d] < node->co[node->d]) ? node->left : node->right;
+      if (next == KD_NODE_UNSET) {
+        break;
+      }
+      node_index = next;
+    }
+    data->buckets[i] = (uint)(((uint64_t)node_index * data->buckets_len) / nodes_len);
+  }
+}
+
+static void kdtree_batch_find_nearest_n_cb(void *__restrict userdata,
+                                           const int chunk,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  const uint start = (uint)chunk * KD_BATCH_CHUNK_SIZE;
+  const uint end = MIN2(start + KD_BATCH_CHUNK_SIZE, data->co_len);
+  KDTreeStack stack;
+
+  kdtree_stack_init(&stack);
+  for (uint i = start; i < end; i++) {
+    const uint query = data->order[i];
+    const int nearest_len = kdtree_find_nearest_n_impl(
+        data->tree,
+        data->co[query],
+        &data->r_nearest[(size_t)query * data->nearest_len_capacity],
+        data->nearest_len_capacity,
+        len_squared_vnvn_cb,
+        NULL,
+        &stack);
+    if (data->r_nearest_len) {
+      data->r_nearest_len[query] = nearest_len;
+    }
+  }
+  kdtree_stack_free(&stack);
+}
+
+/**
+ * Run #BLI_kdtree_3d_find_nearest_n for many coordinates at once, in parallel.
+ *
+ * \param r_nearest: An array sized at least `co_len * nearest_len_capacity`,
+ * the results of query `i` start at `r_nearest[i * nearest_len_capacity]`.
+ * \param r_nearest_len: Optional array of size \a co_len, for the number of points found
+ * by every query.
+ */
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_nearest_len)
+{
+  KDTreeBatchData data;
+  TaskParallelSettings settings;
+  uint *offsets;
+  const int chunks_len = (int)((co_len + KD_BATCH_CHUNK_SIZE - 1) / KD_BATCH_CHUNK_SIZE);
+
+#ifdef DEBUG
+  BLI_assert(tree->is_balanced == true);
+#endif
+
+  if (co_len == 0) {
+    return;
+  }
+  if (UNLIKELY((tree->root == KD_NODE_UNSET) || nearest_len_capacity == 0)) {
+    if (r_nearest_len) {
+      for (uint i = 0; i < co_len; i++) {
+        r_nearest_len[i] = 0;
+      }
+    }
+    return;
+  }
+
+  data.tree = tree;
+  data.co = co;
+  data.co_len = co_len;
+  data.order = MEM_mallocN(sizeof(*data.order) * co_len, __func__);
+  data.buckets = MEM_mallocN(sizeof(*data.buckets) * co_len, __func__);
+  /* Coarse buckets are enough for coherent traversals and keep the counting sort cheap. */
+  data.buckets_len = MIN2(tree->nodes_len, 1u << 16);
+  data.r_nearest = r_nearest;
+  data.nearest_len_capacity = nearest_len_capacity;
+  data.r_nearest_len = r_nearest_len;
+
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  BLI_task_parallel_range(0, chunks_len, &data, kdtree_batch_bucket_cb, &settings);
+
+  /* Counting sort of the queries by their bucket. */
+  offsets = MEM_callocN(sizeof(*offsets) * (data.buckets_len + 1), __func__);
+  for (uint i = 0; i < co_len; i++) {
+    offsets[data.buckets[i] + 1]++;
+  }
+  for (uint i = 0; i < data.buckets_len; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+  for (uint i = 0; i < co_len; i++) {
+    data.order[offsets[data.buckets[i]]++] = i;
+  }
+  MEM_freeN(offsets);
+  MEM_freeN(data.buckets);
+  data.buckets = NULL;
+
+  BLI_task_parallel_range(0, chunks_len, &data, kdtree_batch_find_nearest_n_cb, &settings);
+
+  MEM_freeN(data.order);
+}
+
+/** \} */
+
 static int nearest_cmp_dist(const void *a, const void *b)
 {
   const KDTreeNearest *kda = a;
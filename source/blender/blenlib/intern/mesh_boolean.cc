@@ -872,6 +872,44 @@ static const Vert *find_flap_vert(const Face &tri, const Edge e, bool *r_rev)
   return flapv;
 }
 
+/**
+ * Used with supremum to get an error bound for the result of #orient3d calculated with doubles,
+ * see the description of the floating point filters in `mesh_intersect.cc`. The index of the
+ * dot product of a difference with the cross product of two differences is 7 + 4 * (max index
+ * of input coords), and the inputs are approximations of the exact coordinates (index 1).
+ */
+constexpr int index_orient3d = 11;
+
+/**
+ * Return the same as `orient3d(a->co_exact, b->co_exact, c->co_exact, d->co_exact)`, but use
+ * the double coordinates if the error bound shows that their rounding can't change the sign.
+ * Only ambiguous cases, often coplanar triangles, need exact arithmetic.
+ */
+static int filter_orient3d(const Vert *a, const Vert *b, const Vert *c, const Vert *d)
+{
+  const double3 ad = a->co - d->co;
+  const double3 bd = b->co - d->co;
+  const double3 cd = c->co - d->co;
+  const double det = math::dot(ad, math::cross(bd, cd));
+
+  const double3 abs_d = math::abs(d->co);
+  const double3 sup_ad = math::abs(a->co) + abs_d;
+  const double3 sup_bd = math::abs(b->co) + abs_d;
+  const double3 sup_cd = math::abs(c->co) + abs_d;
+  /* This is the cross product of the suprema, but always using + when operation is + or -. */
+  const double3 sup_cross(sup_bd[1] * sup_cd[2] + sup_bd[2] * sup_cd[1],
+                          sup_bd[2] * sup_cd[0] + sup_bd[0] * sup_cd[2],
+                          sup_bd[0] * sup_cd[1] + sup_bd[1] * sup_cd[0]);
+  const double err_bound = math::dot(sup_ad, sup_cross) * index_orient3d * DBL_EPSILON;
+  if (det > err_bound) {
+    return 1;
+  }
+  if (det < -err_bound) {
+    return -1;
+  }
+  return orient3d(a->co_exact, b->co_exact, c->co_exact, d->co_exact);
+}
+
 /**
  * Triangle \a tri and tri0 share edge e.
  * Classify \a tri with respect to tri0 as described in
@@ -892,9 +930,6 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -906,9 +941,8 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of tri0. */
+  int orient = filter_orient3d(tri0[0], tri0[1], tri0[2], flapv);
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -17,6 +17,7 @@
 #include "BLI_math.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -107,13 +108,17 @@ class Task {
 #ifdef WITH_TBB
 class TBBTaskGroup : public tbb::task_group {
  public:
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+  /* In TBB 2021 priorities are only available as part of task arenas, no longer
+   * for task groups. Tasks are spawned and waited for in this arena, null for the
+   * default arena. */
+  tbb::task_arena *arena;
+#  endif
+
   TBBTaskGroup(eTaskPriority priority)
   {
 #  if TBB_INTERFACE_VERSION_MAJOR >= 12
-    /* TODO: support priorities in TBB 2021, where they are only available as
-     * part of task arenas, no longer for task groups. Or remove support for
-     * task priorities if they are no longer useful. */
-    UNUSED_VARS(priority);
+    arena = blender::threading::detail::task_arena_get(-1, priority);
 #  else
     switch (priority) {
       case TASK_PRIORITY_LOW:
@@ -125,6 +130,17 @@ class TBBTaskGroup : public tbb::task_group {
     }
 #  endif
   }
+
+  template<typename Function> void execute_in_arena(const Function &function)
+  {
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+    if (arena) {
+      arena->execute(function);
+      return;
+    }
+#  endif
+    function();
+  }
 };
 #endif
 
@@ -205,7 +221,7 @@ static void tbb_task_pool_run(TaskPool *pool, Task &&task)
 #ifdef WITH_TBB
   else if (pool->use_threads) {
     /* Execute in TBB task group. */
-    pool->tbb_group.run(std::move(task));
+    pool->tbb_group.execute_in_arena([&]() { pool->tbb_group.run(std::move(task)); });
   }
 #endif
   else {
@@ -234,7 +250,7 @@ static void tbb_task_pool_work_and_wait(TaskPool *pool)
     /* This is called wait(), but internally it can actually do work. This
      * matters because we don't want recursive usage of task pools to run
      * out of threads and get stuck. */
-    pool->tbb_group.wait();
+    pool->tbb_group.execute_in_arena([&]() { pool->tbb_group.wait(); });
   }
 #endif
 }
@@ -244,7 +260,7 @@ static void tbb_task_pool_cancel(TaskPool *pool)
 #ifdef WITH_TBB
   if (pool->use_threads) {
     pool->tbb_group.cancel();
-    pool->tbb_group.wait();
+    pool->tbb_group.execute_in_arena([&]() { pool->tbb_group.wait(); });
   }
 #else
   UNUSED_VARS(pool);
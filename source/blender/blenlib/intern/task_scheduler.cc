@@ -6,9 +6,14 @@
  * Task scheduler initialization.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -19,6 +24,10 @@
 #    include <tbb/global_control.h>
 #    define WITH_TBB_GLOBAL_CONTROL
 #  endif
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+#    include <tbb/info.h>
+#    define WITH_TBB_ARENA_CONSTRAINTS
+#  endif
 #endif
 
 /* Task Scheduler */
@@ -28,6 +37,103 @@ static int task_scheduler_num_threads = 1;
 static tbb::global_control *task_scheduler_global_control = nullptr;
 #endif
 
+/* Task Arenas */
+
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+#  define TASK_ARENA_NUMA_NODES_MAX 16
+
+/** TBB identifiers of the NUMA nodes, empty when the topology is unknown. */
+static int task_arena_numa_ids[TASK_ARENA_NUMA_NODES_MAX];
+static int task_arena_numa_nodes_num = 0;
+/**
+ * Created on first use, since every arena has threads of its own. The first index is the NUMA
+ * node plus one, so that index zero is for arenas that are not bound to a node.
+ */
+static std::atomic<tbb::task_arena *> task_arenas[TASK_ARENA_NUMA_NODES_MAX + 1][2];
+static std::mutex task_arenas_mutex;
+
+static void task_arenas_init()
+{
+  task_arena_numa_nodes_num = 0;
+  for (const tbb::numa_node_id numa_id : tbb::info::numa_nodes()) {
+    /* A single node with an automatic identifier is returned when the topology is unknown. */
+    if (numa_id != tbb::task_arena::automatic &&
+        task_arena_numa_nodes_num < TASK_ARENA_NUMA_NODES_MAX) {
+      task_arena_numa_ids[task_arena_numa_nodes_num++] = numa_id;
+    }
+  }
+}
+
+static void task_arenas_exit()
+{
+  for (auto &numa_node_arenas : task_arenas) {
+    for (std::atomic<tbb::task_arena *> &arena : numa_node_arenas) {
+      MEM_delete(arena.exchange(nullptr));
+    }
+  }
+}
+
+static tbb::task_arena *task_arena_create(const int numa_node, const eTaskPriority priority)
+{
+  tbb::task_arena::constraints constraints;
+  int max_concurrency = task_scheduler_num_threads;
+  if (numa_node != -1) {
+    constraints.numa_id = task_arena_numa_ids[numa_node];
+    max_concurrency = std::min(max_concurrency,
+                               tbb::info::default_concurrency(constraints.numa_id));
+  }
+  constraints.max_concurrency = max_concurrency;
+  /* High priority work uses the same priority as the default arena, so that it can't starve the
+   * rest of Blender. */
+  const tbb::task_arena::priority arena_priority = (priority == TASK_PRIORITY_LOW) ?
+                                                       tbb::task_arena::priority::low :
+                                                       tbb::task_arena::priority::normal;
+  tbb::task_arena *arena = MEM_new<tbb::task_arena>(__func__, constraints, 1, arena_priority);
+  arena->initialize();
+  return arena;
+}
+
+namespace blender::threading::detail {
+
+tbb::task_arena *task_arena_get(int numa_node, const eTaskPriority priority)
+{
+  if (task_arena_numa_nodes_num < 2) {
+    numa_node = -1;
+  }
+  else if (numa_node != -1) {
+    numa_node %= task_arena_numa_nodes_num;
+  }
+  if (numa_node == -1 && priority == TASK_PRIORITY_HIGH) {
+    return nullptr;
+  }
+
+  std::atomic<tbb::task_arena *> &arena = task_arenas[numa_node + 1][priority];
+  if (tbb::task_arena *existing_arena = arena.load(std::memory_order_acquire)) {
+    return existing_arena;
+  }
+  std::lock_guard lock{task_arenas_mutex};
+  if (arena.load(std::memory_order_relaxed) == nullptr) {
+    arena.store(task_arena_create(numa_node, priority), std::memory_order_release);
+  }
+  return arena.load(std::memory_order_relaxed);
+}
+
+}  // namespace blender::threading::detail
+
+#elif defined(WITH_TBB)
+
+namespace blender::threading::detail {
+
+tbb::task_arena *task_arena_get(int /*numa_node*/, eTaskPriority /*priority*/)
+{
+  /* Older TBB versions only support priorities for task groups, see #TBBTaskGroup. */
+  return nullptr;
+}
+
+}  // namespace blender::threading::detail
+
+#endif
+
 void BLI_task_scheduler_init()
 {
 #ifdef WITH_TBB_GLOBAL_CONTROL
@@ -50,10 +156,16 @@ void BLI_task_scheduler_init()
 #else
   task_scheduler_num_threads = BLI_system_thread_count();
 #endif
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+  task_arenas_init();
+#endif
 }
 
 void BLI_task_scheduler_exit()
 {
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+  task_arenas_exit();
+#endif
 #ifdef WITH_TBB_GLOBAL_CONTROL
   MEM_delete(task_scheduler_global_control);
 #endif
@@ -64,6 +176,15 @@ int BLI_task_scheduler_num_threads()
   return task_scheduler_num_threads;
 }
 
+int BLI_task_scheduler_numa_nodes_num()
+{
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+  return std::max(task_arena_numa_nodes_num, 1);
+#else
+  return 1;
+#endif
+}
+
 void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
 {
 #ifdef WITH_TBB
@@ -72,3 +193,11 @@ void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
   func(userdata);
 #endif
 }
+
+void BLI_task_arena_execute(int numa_node,
+                            eTaskPriority priority,
+                            void (*func)(void *userdata),
+                            void *userdata)
+{
+  blender::threading::arena_execute(numa_node, priority, [&]() { func(userdata); });
+}
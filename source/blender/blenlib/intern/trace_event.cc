@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <ostream>
+
+#include "BLI_trace_event.hh"
+#include "BLI_utildefines.h"
+
+namespace blender::trace_event {
+
+int thread_index()
+{
+  static std::atomic<int> next_thread_index = 0;
+  static thread_local const int thread_index = next_thread_index.fetch_add(1);
+  return thread_index;
+}
+
+Writer::Writer(std::ostream &stream) : stream_(stream)
+{
+  stream_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+}
+
+Writer::~Writer()
+{
+  /* Trailing commas are not allowed in JSON, finish with an empty metadata event. */
+  stream_ << "{\"name\":\"trace_end\",\"ph\":\"M\",\"pid\":0,\"args\":{}}\n]}\n";
+}
+
+void Writer::write_string(const StringRef str)
+{
+  stream_ << '"';
+  for (const char c : str) {
+    if (ELEM(c, '"', '\\')) {
+      stream_ << '\\' << c;
+    }
+    else if (uchar(c) < 0x20) {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", int(c));
+      stream_ << escaped;
+    }
+    else {
+      stream_ << c;
+    }
+  }
+  stream_ << '"';
+}
+
+void Writer::process_name(const int pid, const StringRef name)
+{
+  stream_ << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":";
+  this->write_string(name);
+  stream_ << "}},\n";
+}
+
+void Writer::complete_event(const CompleteEvent &event)
+{
+  /* Formatted with #snprintf so that the state of the stream is not changed. */
+  char times[64];
+  snprintf(times,
+           sizeof(times),
+           "\"ts\":%.3f,\"dur\":%.3f",
+           event.start_us,
+           event.duration_us);
+
+  stream_ << "{\"name\":";
+  this->write_string(event.name);
+  stream_ << ",\"cat\":";
+  this->write_string(event.category);
+  stream_ << ",\"ph\":\"X\"," << times << ",\"pid\":" << event.pid << ",\"tid\":" << event.tid;
+  if (!event.args.is_empty()) {
+    stream_ << ",\"args\":{";
+    for (const int64_t i : event.args.index_range()) {
+      char value[32];
+      snprintf(value, sizeof(value), "%.3f", event.args[i].value);
+      if (i > 0) {
+        stream_ << ',';
+      }
+      this->write_string(event.args[i].name);
+      stream_ << ':' << value;
+    }
+    stream_ << '}';
+  }
+  stream_ << "},\n";
+}
+
+}  // namespace blender::trace_event
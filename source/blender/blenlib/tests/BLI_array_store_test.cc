@@ -373,6 +373,35 @@ TEST(array_store, DoubleDiff)
   BLI_array_store_destroy(bs);
 }
 
+TEST(array_store, DoubleAlignedScattered)
+{
+  const int chunk_count = 32;
+  BArrayStore *bs = BLI_array_store_create(sizeof(int), chunk_count);
+  int data_src[chunk_count * 64];
+  for (int i = 0; i < chunk_count * 64; i++) {
+    data_src[i] = i;
+  }
+
+  BArrayState *state_a = BLI_array_store_state_add(bs, data_src, sizeof(data_src), nullptr);
+
+  /* Modify two chunks far from the start and end of the array,
+   * only these chunks should be stored again. */
+  data_src[chunk_count * 10 + 3] = -1;
+  data_src[chunk_count * 40 + 7] = -1;
+  BArrayState *state_b = BLI_array_store_state_add(bs, data_src, sizeof(data_src), state_a);
+
+  EXPECT_EQ(BLI_array_store_calc_size_compacted_get(bs),
+            sizeof(data_src) + (2 * chunk_count * sizeof(int)));
+
+  size_t data_dst_len;
+  int *data_dst = (int *)BLI_array_store_state_data_get_alloc(state_b, &data_dst_len);
+  EXPECT_EQ(data_dst_len, sizeof(data_src));
+  EXPECT_EQ(memcmp(data_src, data_dst, sizeof(data_src)), 0);
+  MEM_freeN((void *)data_dst);
+
+  BLI_array_store_destroy(bs);
+}
+
 TEST(array_store, TextMixed)
 {
   TESTBUFFER_STRINGS(1, 4, "", );
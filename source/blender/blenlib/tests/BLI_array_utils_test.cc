@@ -3,6 +3,7 @@
 #include "testing/testing.h"
 
 #include "BLI_array_utils.h"
+#include "BLI_array_utils.hh"
 #include "BLI_utildefines.h"
 #include "BLI_utildefines_stack.h"
 
@@ -239,3 +240,56 @@ TEST(array_utils, DeduplicateOrdered3)
 }
 
 #undef DEDUPLICATE_ORDERED_TEST
+
+namespace blender::array_utils::tests {
+
+TEST(array_utils, ExclusiveScanEmpty)
+{
+  Array<int> data;
+  EXPECT_EQ(exclusive_scan(data.as_mutable_span()), 0);
+}
+
+TEST(array_utils, ExclusiveScanSmall)
+{
+  Array<int> data = {3, 0, 2, 5};
+  EXPECT_EQ(exclusive_scan(data.as_mutable_span()), 10);
+  EXPECT_EQ(data[0], 0);
+  EXPECT_EQ(data[1], 3);
+  EXPECT_EQ(data[2], 3);
+  EXPECT_EQ(data[3], 5);
+}
+
+TEST(array_utils, ExclusiveScanThreaded)
+{
+  Array<int64_t> data(100003);
+  for (const int64_t i : data.index_range()) {
+    data[i] = i % 7;
+  }
+  Array<int64_t> expected(data.size());
+  int64_t sum = 0;
+  for (const int64_t i : data.index_range()) {
+    expected[i] = sum;
+    sum += data[i];
+  }
+  EXPECT_EQ(exclusive_scan(data.as_mutable_span(), 1000), sum);
+  EXPECT_EQ_ARRAY(expected.data(), data.data(), data.size());
+}
+
+TEST(array_utils, Scatter)
+{
+  const Array<int> src = {10, 11, 12, 13};
+  const Array<int> indices = {2, 0, 3, 1};
+  Array<int> dst(4, 0);
+  scatter(src.as_span(), indices.as_span(), dst.as_mutable_span());
+  EXPECT_EQ(dst[0], 11);
+  EXPECT_EQ(dst[1], 13);
+  EXPECT_EQ(dst[2], 10);
+  EXPECT_EQ(dst[3], 12);
+
+  /* Gathering with the same indices restores the original order. */
+  Array<int> gathered(4);
+  gather(dst.as_span(), indices.as_span(), gathered.as_mutable_span());
+  EXPECT_EQ_ARRAY(src.data(), gathered.data(), src.size());
+}
+
+}  // namespace blender::array_utils::tests
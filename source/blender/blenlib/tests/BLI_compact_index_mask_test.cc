@@ -0,0 +1,118 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_compact_index_mask.hh"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+static Vector<int64_t> compact_mask_to_vector(const CompactIndexMask &mask)
+{
+  Vector<int64_t> indices;
+  mask.foreach_index([&](const int64_t i) { indices.append(i); });
+  return indices;
+}
+
+TEST(compact_index_mask, DefaultConstructor)
+{
+  CompactIndexMask mask;
+  EXPECT_EQ(mask.size(), 0);
+  EXPECT_TRUE(mask.is_empty());
+  EXPECT_EQ(mask.segments_num(), 0);
+}
+
+TEST(compact_index_mask, FromRange)
+{
+  const IndexRange range(100, 1000000);
+  CompactIndexMask mask{IndexMask(range)};
+  EXPECT_EQ(mask.size(), range.size());
+  EXPECT_EQ(mask.segments_num(), 1);
+  mask.foreach_segment([&](const IndexMask segment) {
+    EXPECT_TRUE(segment.is_range());
+    EXPECT_EQ(segment.as_range(), range);
+  });
+}
+
+TEST(compact_index_mask, FromIndices)
+{
+  Vector<int64_t> indices = {0, 1, 2, 5, 16383, 16384, 40000, 40001, 100000};
+  for (const int64_t i : IndexRange(200000, 50000)) {
+    indices.append(i);
+  }
+  CompactIndexMask mask{IndexMask(indices)};
+  EXPECT_EQ(mask.size(), indices.size());
+  EXPECT_EQ(compact_mask_to_vector(mask).as_span(), indices.as_span());
+
+  Array<int64_t> copied_indices(mask.size());
+  mask.to_indices(copied_indices);
+  EXPECT_EQ(copied_indices.as_span(), indices.as_span());
+}
+
+TEST(compact_index_mask, FromBools)
+{
+  const int64_t size = 500000;
+  Array<bool> bools(size, false);
+  Vector<int64_t> indices;
+  RandomNumberGenerator rng(42);
+  for (const int64_t i : IndexRange(size)) {
+    /* Mix dense, sparse and contiguous chunks. */
+    if ((i >= 100000 && i < 250000) || (i < 100000 && rng.get_float() < 0.5f) ||
+        (i >= 300000 && rng.get_float() < 0.01f)) {
+      bools[i] = true;
+      indices.append(i);
+    }
+  }
+  const CompactIndexMask mask = CompactIndexMask::from_bools(bools);
+  EXPECT_EQ(mask.size(), indices.size());
+  EXPECT_EQ(compact_mask_to_vector(mask).as_span(), indices.as_span());
+
+  CompactIndexMask mask_from_indices{IndexMask(indices)};
+  EXPECT_EQ(mask_from_indices.segments_num(), mask.segments_num());
+  EXPECT_EQ(compact_mask_to_vector(mask_from_indices).as_span(), indices.as_span());
+}
+
+TEST(compact_index_mask, ForeachSegment)
+{
+  Vector<int64_t> indices;
+  for (const int64_t i : IndexRange(300000)) {
+    if (i % 7 == 0 || i % 1000 == 3 || (i >= 50000 && i < 120000)) {
+      indices.append(i);
+    }
+  }
+  CompactIndexMask mask{IndexMask(indices)};
+
+  Vector<int64_t> segment_indices;
+  mask.foreach_segment([&](const IndexMask segment) {
+    EXPECT_FALSE(segment.is_empty());
+    segment_indices.extend(segment.indices());
+  });
+  EXPECT_EQ(segment_indices.as_span(), indices.as_span());
+
+  Array<int> sizes(300000, 0);
+  mask.foreach_segment_parallel([&](const IndexMask segment) {
+    for (const int64_t i : segment.index_range()) {
+      sizes[segment[i]]++;
+    }
+  });
+  for (const int64_t i : indices) {
+    EXPECT_EQ(sizes[i], 1);
+  }
+}
+
+TEST(compact_index_mask, SizeInBytes)
+{
+  const int64_t size = 1000000;
+  Array<bool> bools(size);
+  RandomNumberGenerator rng(0);
+  for (const int64_t i : IndexRange(size)) {
+    bools[i] = rng.get_float() < 0.5f;
+  }
+  const CompactIndexMask mask = CompactIndexMask::from_bools(bools);
+  /* About one bit per index instead of 64. */
+  EXPECT_LT(mask.size_in_bytes(), size / 4);
+}
+
+}  // namespace blender::tests
@@ -66,8 +66,12 @@ static void optimal_check_callback(void *userdata,
  * Note that a small epsilon is added to the BVH nodes bounds, even if we pass in zero.
  * Use rounding to ensure very close nodes don't cause the wrong node to be found as nearest.
  */
-static void find_nearest_points_test(
-    int points_len, float scale, int round, int random_seed, bool optimal = false)
+static void find_nearest_points_test(int points_len,
+                                     float scale,
+                                     int round,
+                                     int random_seed,
+                                     bool optimal = false,
+                                     int balance_flag = 0)
 {
   struct RNG *rng = BLI_rng_new(random_seed);
   BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
@@ -79,7 +83,7 @@ static void find_nearest_points_test(
     rng_v3_round(points[i], 3, rng, round, scale);
     BLI_bvhtree_insert(tree, i, points[i], 1);
   }
-  BLI_bvhtree_balance(tree);
+  BLI_bvhtree_balance_ex(tree, balance_flag);
 
   /* first find each point */
   BVHTree_NearestPointCallback callback = optimal ? optimal_check_callback : nullptr;
@@ -132,3 +136,145 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+TEST(kdopbvh, MortonFindNearest_2)
+{
+  find_nearest_points_test(2, 1.0, 1000, 123, false, BVH_BALANCE_MORTON_ORDER);
+}
+TEST(kdopbvh, MortonFindNearest_500)
+{
+  find_nearest_points_test(500, 1.0, 1000, 12, false, BVH_BALANCE_MORTON_ORDER);
+}
+TEST(kdopbvh, MortonFindNearest_50000)
+{
+  find_nearest_points_test(50000, 1.0, 1000, 12, false, BVH_BALANCE_MORTON_ORDER);
+}
+
+/**
+ * Check that batched nearest queries find the same elements as separate queries.
+ */
+static void find_nearest_batch_test(int points_len,
+                                    int queries_len,
+                                    int random_seed,
+                                    char tree_type = 6)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 4, tree_type);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, points[i]);
+    mul_v3_fl(points[i], BLI_rng_get_float(rng));
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*queries)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * queries_len, __func__);
+  BVHTreeNearest *nearest = (BVHTreeNearest *)MEM_mallocN(sizeof(BVHTreeNearest) * queries_len,
+                                                          __func__);
+  for (int i = 0; i < queries_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, queries[i]);
+    nearest[i].index = -1;
+    nearest[i].dist_sq = FLT_MAX;
+  }
+
+  BLI_bvhtree_find_nearest_batch(tree, queries, queries_len, nearest, nullptr, nullptr);
+
+  for (int i = 0; i < queries_len; i++) {
+    BVHTreeNearest expected;
+    expected.index = -1;
+    expected.dist_sq = FLT_MAX;
+    BLI_bvhtree_find_nearest(tree, queries[i], &expected, nullptr, nullptr);
+    EXPECT_EQ(nearest[i].index, expected.index);
+    EXPECT_FLOAT_EQ(nearest[i].dist_sq, expected.dist_sq);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+  MEM_freeN(queries);
+  MEM_freeN(nearest);
+}
+
+TEST(kdopbvh, FindNearestBatch_1)
+{
+  find_nearest_batch_test(1, 3, 1234);
+}
+TEST(kdopbvh, FindNearestBatch_500)
+{
+  find_nearest_batch_test(500, 1001, 12);
+}
+TEST(kdopbvh, FindNearestBatch_14DOP)
+{
+  find_nearest_batch_test(500, 1001, 12, 14);
+}
+
+/**
+ * Check that batched ray-casts hit the same elements as separate ray-casts.
+ */
+static void ray_cast_batch_test(int boxes_len, int rays_len, int random_seed, char tree_type = 6)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(boxes_len, 0.0, 4, tree_type);
+
+  for (int i = 0; i < boxes_len; i++) {
+    float center[3];
+    BLI_rng_get_float_unit_v3(rng, center);
+    float corners[2][3];
+    for (int axis = 0; axis < 3; axis++) {
+      corners[0][axis] = center[axis] - 0.05f;
+      corners[1][axis] = center[axis] + 0.05f;
+    }
+    BLI_bvhtree_insert(tree, i, corners[0], 2);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*origins)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  float(*directions)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  BVHTreeRayHit *hits = (BVHTreeRayHit *)MEM_mallocN(sizeof(BVHTreeRayHit) * rays_len,
+                                                     __func__);
+  for (int i = 0; i < rays_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, origins[i]);
+    mul_v3_fl(origins[i], 2.0f);
+    BLI_rng_get_float_unit_v3(rng, directions[i]);
+    hits[i].index = -1;
+    hits[i].dist = BVH_RAYCAST_DIST_MAX;
+  }
+
+  BLI_bvhtree_ray_cast_batch(
+      tree, origins, directions, rays_len, 0.0f, hits, nullptr, nullptr, BVH_RAYCAST_DEFAULT);
+
+  for (int i = 0; i < rays_len; i++) {
+    BVHTreeRayHit expected;
+    expected.index = -1;
+    expected.dist = BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast(tree, origins[i], directions[i], 0.0f, &expected, nullptr, nullptr);
+    EXPECT_EQ(hits[i].index, expected.index);
+    if (expected.index != -1) {
+      EXPECT_FLOAT_EQ(hits[i].dist, expected.dist);
+    }
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(origins);
+  MEM_freeN(directions);
+  MEM_freeN(hits);
+}
+
+TEST(kdopbvh, RayCastBatch_1)
+{
+  ray_cast_batch_test(1, 3, 1234);
+}
+TEST(kdopbvh, RayCastBatch_500)
+{
+  ray_cast_batch_test(500, 1001, 12);
+}
+TEST(kdopbvh, RayCastBatch_14DOP)
+{
+  ray_cast_batch_test(500, 1001, 12, 14);
+}
+TEST(kdopbvh, RayCastBatch_18DOP)
+{
+  ray_cast_batch_test(500, 1001, 12, 18);
+}
@@ -2,7 +2,10 @@
 
 #include "testing/testing.h"
 
+#include "BLI_array.hh"
 #include "BLI_kdtree.h"
+#include "BLI_math_vec_types.hh"
+#include "BLI_rand.hh"
 
 #include <cmath>
 
@@ -52,6 +55,42 @@ static void deduplicate_test()
   }
 }
 
+static void find_nearest_n_batch_test(const int tree_size, const int queries_num, const uint k)
+{
+  blender::RandomNumberGenerator rng(tree_size);
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_size);
+  for (int i = 0; i < tree_size; i++) {
+    /* Coarse coordinates, to get many equal values along the split axes. */
+    const float co[3] = {float(rng.get_int32(100)), rng.get_float(), float(rng.get_int32(10))};
+    BLI_kdtree_3d_insert(tree, i, co);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  blender::Array<blender::float3> queries(queries_num);
+  for (blender::float3 &query : queries) {
+    query = {rng.get_float() * 110.0f - 5.0f, rng.get_float(), rng.get_float() * 12.0f - 1.0f};
+  }
+
+  blender::Array<KDTreeNearest_3d> batch(queries_num * k);
+  blender::Array<int> batch_lens(queries_num);
+  BLI_kdtree_3d_find_nearest_n_batch(tree,
+                                     reinterpret_cast<const float(*)[3]>(queries.data()),
+                                     uint(queries_num),
+                                     batch.data(),
+                                     k,
+                                     batch_lens.data());
+
+  blender::Array<KDTreeNearest_3d> single(k);
+  for (const int i : queries.index_range()) {
+    const int found = BLI_kdtree_3d_find_nearest_n(tree, queries[i], single.data(), k);
+    EXPECT_EQ(batch_lens[i], found);
+    for (int j = 0; j < found; j++) {
+      EXPECT_EQ(batch[i * k + j].dist, single[j].dist);
+    }
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
 TEST(kdtree, Standard)
 {
   standard_test();
@@ -61,3 +100,19 @@ TEST(kdtree, Deduplicate)
 {
   deduplicate_test();
 }
+
+TEST(kdtree, FindNearestNBatch_1)
+{
+  find_nearest_n_batch_test(1, 100, 4);
+}
+
+TEST(kdtree, FindNearestNBatch_1000)
+{
+  find_nearest_n_batch_test(1000, 1000, 8);
+}
+
+/* Large enough to be balanced in parallel. */
+TEST(kdtree, FindNearestNBatch_50000)
+{
+  find_nearest_n_batch_test(50000, 10000, 8);
+}
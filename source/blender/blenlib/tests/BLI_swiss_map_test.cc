@@ -0,0 +1,277 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_map.hh"
+#include "BLI_rand.h"
+#include "BLI_strict_flags.h"
+#include "BLI_string_ref.hh"
+#include "BLI_swiss_map.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+#include <memory>
+#include <unordered_map>
+
+namespace blender::tests {
+
+TEST(swiss_map, DefaultConstructor)
+{
+  SwissMap<int, float> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(0));
+  EXPECT_EQ(map.lookup_ptr(0), nullptr);
+}
+
+TEST(swiss_map, AddLookup)
+{
+  SwissMap<int, float> map;
+  EXPECT_TRUE(map.add(2, 5.0f));
+  EXPECT_FALSE(map.add(2, 6.0f));
+  map.add_new(6, 2.0f);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.lookup(2), 5.0f);
+  EXPECT_EQ(map.lookup(6), 2.0f);
+  EXPECT_EQ(map.lookup_default(3, 1.0f), 1.0f);
+  EXPECT_TRUE(map.contains(6));
+  EXPECT_FALSE(map.contains(3));
+}
+
+TEST(swiss_map, AddMany)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 10000; i++) {
+    map.add_new(i * 3, i);
+  }
+  EXPECT_EQ(map.size(), 10000);
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(map.lookup(i * 3), i);
+    EXPECT_FALSE(map.contains(i * 3 + 1));
+  }
+}
+
+TEST(swiss_map, AddOverwrite)
+{
+  SwissMap<int, float> map;
+  EXPECT_TRUE(map.add_overwrite(1, 2.0f));
+  EXPECT_FALSE(map.add_overwrite(1, 3.0f));
+  EXPECT_EQ(map.lookup(1), 3.0f);
+}
+
+TEST(swiss_map, LookupOrAdd)
+{
+  SwissMap<int, int> map;
+  EXPECT_EQ(map.lookup_or_add(3, 4), 4);
+  EXPECT_EQ(map.lookup_or_add(3, 5), 4);
+  EXPECT_EQ(map.lookup_or_add_cb(6, []() { return 10; }), 10);
+  EXPECT_EQ(map.lookup_or_add_cb(6, []() { return 20; }), 10);
+  map.lookup_or_add_default(8) += 2;
+  map.lookup_or_add_default(8) += 2;
+  EXPECT_EQ(map.lookup(8), 4);
+}
+
+TEST(swiss_map, PopAndRemove)
+{
+  SwissMap<int, int> map;
+  map.add(1, 10);
+  map.add(2, 20);
+  map.add(3, 30);
+  EXPECT_EQ(map.pop(1), 10);
+  EXPECT_FALSE(map.pop_try(1).has_value());
+  EXPECT_EQ(*map.pop_try(2), 20);
+  EXPECT_TRUE(map.remove(3));
+  EXPECT_FALSE(map.remove(3));
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(swiss_map, RemoveAndAddMany)
+{
+  /* Compare against a reference implementation while keys are removed and added again, so that
+   * a mix of removed and empty slots has to be probed. */
+  SwissMap<int, int> map;
+  std::unordered_map<int, int> reference;
+  RNG *rng = BLI_rng_new(0);
+  for (int i = 0; i < 100000; i++) {
+    const int key = int(BLI_rng_get_uint(rng) % 2000);
+    if (BLI_rng_get_uint(rng) % 2 == 0) {
+      EXPECT_EQ(map.add(key, i), reference.insert({key, i}).second);
+    }
+    else {
+      EXPECT_EQ(map.remove(key), reference.erase(key) == 1);
+    }
+  }
+  BLI_rng_free(rng);
+  EXPECT_EQ(map.size(), int64_t(reference.size()));
+  for (const auto &item : reference) {
+    EXPECT_EQ(map.lookup(item.first), item.second);
+  }
+  /* The table did not have to grow because of the removed slots. */
+  EXPECT_LE(map.capacity(), 4096);
+}
+
+TEST(swiss_map, Iterators)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i, i * 2);
+  }
+  int key_sum = 0;
+  for (const int key : map.keys()) {
+    key_sum += key;
+  }
+  EXPECT_EQ(key_sum, 4950);
+  for (int &value : map.values()) {
+    value += 1;
+  }
+  int value_sum = 0;
+  for (const int value : map.values()) {
+    value_sum += value;
+  }
+  EXPECT_EQ(value_sum, 9900 + 100);
+  for (auto item : map.items()) {
+    item.value = item.key;
+  }
+  for (const auto item : const_cast<const SwissMap<int, int> &>(map).items()) {
+    EXPECT_EQ(item.key, item.value);
+  }
+  int count = 0;
+  map.foreach_item([&](const int /*key*/, const int /*value*/) { count++; });
+  EXPECT_EQ(count, 100);
+}
+
+TEST(swiss_map, CopyAndMove)
+{
+  SwissMap<int, int> map1;
+  for (int i = 0; i < 100; i++) {
+    map1.add(i, i);
+  }
+  map1.remove(50);
+  SwissMap<int, int> map2 = map1;
+  EXPECT_EQ(map2.size(), 99);
+  EXPECT_EQ(map2.lookup(20), 20);
+  EXPECT_FALSE(map2.contains(50));
+  SwissMap<int, int> map3 = std::move(map1);
+  EXPECT_EQ(map3.size(), 99);
+  EXPECT_EQ(map1.size(), 0); /* NOLINT: bugprone-use-after-move */
+  map1 = map3;
+  EXPECT_EQ(map1.size(), 99);
+  map3.clear();
+  EXPECT_TRUE(map3.is_empty());
+  EXPECT_FALSE(map3.contains(20));
+}
+
+TEST(swiss_map, UniquePtrValue)
+{
+  SwissMap<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 1000; i++) {
+    map.add_new(i, std::make_unique<int>(i));
+  }
+  std::unique_ptr<int> value = map.pop(10);
+  EXPECT_EQ(*value, 10);
+  EXPECT_EQ(*map.lookup(999), 999);
+}
+
+TEST(swiss_map, StringKeys)
+{
+  SwissMap<std::string, int> map;
+  map.add("a", 1);
+  map.add("bb", 2);
+  EXPECT_EQ(map.lookup_as(StringRef("a")), 1);
+  EXPECT_TRUE(map.contains_as("bb"));
+  EXPECT_FALSE(map.contains_as("c"));
+  EXPECT_EQ(map.lookup_key_as("bb"), "bb");
+}
+
+TEST(swiss_map, Reserve)
+{
+  SwissMap<int, int> map;
+  map.reserve(1000);
+  const int64_t capacity = map.capacity();
+  EXPECT_GE(capacity, 1000);
+  for (int i = 0; i < 1000; i++) {
+    map.add_new(i, i);
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+/**
+ * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
+ */
+#if 0
+template<typename MapT>
+BLI_NOINLINE void benchmark_random_ints(StringRef name, int amount, int factor)
+{
+  RNG *rng = BLI_rng_new(0);
+  Vector<int> values;
+  for (int i = 0; i < amount; i++) {
+    values.append(BLI_rng_get_int(rng) * factor);
+  }
+  BLI_rng_free(rng);
+
+  MapT map;
+  {
+    SCOPED_TIMER(name + " Add");
+    for (int value : values) {
+      map.add(value, value);
+    }
+  }
+  int count = 0;
+  {
+    SCOPED_TIMER(name + " Contains");
+    for (int value : values) {
+      count += map.contains(value);
+    }
+  }
+  {
+    SCOPED_TIMER(name + " Contains Missing");
+    for (int value : values) {
+      count += map.contains(value + 1);
+    }
+  }
+  {
+    SCOPED_TIMER(name + " Remove");
+    for (int value : values) {
+      count += map.remove(value);
+    }
+  }
+
+  /* Print the value for simple error checking and to avoid some compiler optimizations. */
+  std::cout << "Count: " << count << "\n";
+}
+
+TEST(swiss_map, Benchmark)
+{
+  for (int i = 0; i < 3; i++) {
+    benchmark_random_ints<blender::Map<int, int>>("blender::Map      ", 1000000, 1);
+    benchmark_random_ints<blender::SwissMap<int, int>>("blender::SwissMap", 1000000, 1);
+  }
+  std::cout << "\n";
+  for (int i = 0; i < 3; i++) {
+    int factor = (3 << 10);
+    benchmark_random_ints<blender::Map<int, int>>("blender::Map      ", 1000000, factor);
+    benchmark_random_ints<blender::SwissMap<int, int>>("blender::SwissMap", 1000000, factor);
+  }
+}
+
+/**
+ * Timer 'blender::Map       Add' took 76.9797 ms
+ * Timer 'blender::Map       Contains' took 21.1551 ms
+ * Timer 'blender::Map       Contains Missing' took 44.7175 ms
+ * Timer 'blender::Map       Remove' took 22.9034 ms
+ * Timer 'blender::SwissMap Add' took 54.2733 ms
+ * Timer 'blender::SwissMap Contains' took 21.6668 ms
+ * Timer 'blender::SwissMap Contains Missing' took 10.362 ms
+ * Timer 'blender::SwissMap Remove' took 24.6324 ms
+ *
+ * Timer 'blender::Map       Add' took 83.8736 ms
+ * Timer 'blender::Map       Contains' took 31.221 ms
+ * Timer 'blender::Map       Contains Missing' took 41.3314 ms
+ * Timer 'blender::Map       Remove' took 49.3926 ms
+ * Timer 'blender::SwissMap Add' took 43.2644 ms
+ * Timer 'blender::SwissMap Contains' took 15.8649 ms
+ * Timer 'blender::SwissMap Contains Missing' took 23.292 ms
+ * Timer 'blender::SwissMap Remove' took 24.0092 ms
+ */
+
+#endif /* Benchmark */
+
+}  // namespace blender::tests
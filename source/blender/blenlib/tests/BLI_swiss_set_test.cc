@@ -0,0 +1,94 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_string_ref.hh"
+#include "BLI_swiss_set.hh"
+#include "BLI_vector.hh"
+
+#include "BLI_strict_flags.h"
+
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(swiss_set, DefaultConstructor)
+{
+  SwissSet<int> set;
+  EXPECT_EQ(set.size(), 0);
+  EXPECT_TRUE(set.is_empty());
+  EXPECT_FALSE(set.contains(0));
+  EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(swiss_set, InitializerListConstructor)
+{
+  SwissSet<int> set = {4, 5, 6, 5};
+  EXPECT_EQ(set.size(), 3);
+  EXPECT_TRUE(set.contains(4));
+  EXPECT_TRUE(set.contains(6));
+  EXPECT_FALSE(set.contains(7));
+}
+
+TEST(swiss_set, AddAndRemoveMany)
+{
+  SwissSet<int> set;
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_TRUE(set.add(i * 7));
+    EXPECT_FALSE(set.add(i * 7));
+  }
+  EXPECT_EQ(set.size(), 10000);
+  for (int i = 0; i < 10000; i += 2) {
+    set.remove_contained(i * 7);
+  }
+  EXPECT_EQ(set.size(), 5000);
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(set.contains(i * 7), i % 2 == 1);
+  }
+  for (int i = 0; i < 10000; i += 2) {
+    set.add_new(i * 7);
+  }
+  EXPECT_EQ(set.size(), 10000);
+}
+
+TEST(swiss_set, Iterator)
+{
+  SwissSet<int> set = {1, 3, 2, 6, 4};
+  Vector<int> vec;
+  for (const int value : set) {
+    vec.append(value);
+  }
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_TRUE(vec.contains(1));
+  EXPECT_TRUE(vec.contains(3));
+  EXPECT_TRUE(vec.contains(2));
+  EXPECT_TRUE(vec.contains(6));
+  EXPECT_TRUE(vec.contains(4));
+}
+
+TEST(swiss_set, LookupKey)
+{
+  SwissSet<std::string> set;
+  set.add("a");
+  set.add("b");
+  EXPECT_EQ(set.lookup_key_as("a"), "a");
+  EXPECT_EQ(set.lookup_key_ptr_as("c"), nullptr);
+  EXPECT_EQ(&set.lookup_key_or_add("b"), set.lookup_key_ptr("b"));
+  EXPECT_EQ(set.lookup_key_or_add("c"), "c");
+  EXPECT_EQ(set.size(), 3);
+  EXPECT_TRUE(set.contains_as(StringRef("c")));
+}
+
+TEST(swiss_set, CopyAndMove)
+{
+  SwissSet<int> set1 = {1, 2, 3};
+  SwissSet<int> set2 = set1;
+  set2.add(4);
+  EXPECT_EQ(set1.size(), 3);
+  EXPECT_EQ(set2.size(), 4);
+  SwissSet<int> set3 = std::move(set2);
+  EXPECT_EQ(set3.size(), 4);
+  EXPECT_TRUE(set3.contains(4));
+  set3.clear();
+  EXPECT_TRUE(set3.is_empty());
+}
+
+}  // namespace blender::tests
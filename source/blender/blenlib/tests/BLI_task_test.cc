@@ -293,3 +293,27 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, ArenaExecute)
+{
+  BLI_threadapi_init();
+  EXPECT_GE(BLI_task_scheduler_numa_nodes_num(), 1);
+
+  const int numa_nodes[] = {-1, 0, BLI_task_scheduler_numa_nodes_num()};
+  for (const eTaskPriority priority : {TASK_PRIORITY_LOW, TASK_PRIORITY_HIGH}) {
+    for (const int numa_node : numa_nodes) {
+      std::atomic<int64_t> sum = 0;
+      blender::threading::arena_execute(numa_node, priority, [&]() {
+        blender::threading::parallel_for(
+            blender::IndexRange(1000), 10, [&](const blender::IndexRange range) {
+              for (const int64_t i : range) {
+                sum += i;
+              }
+            });
+      });
+      EXPECT_EQ(sum, 499500);
+    }
+  }
+
+  BLI_threadapi_exit();
+}
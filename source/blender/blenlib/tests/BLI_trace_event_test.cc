@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <array>
+#include <sstream>
+
+#include "BLI_trace_event.hh"
+
+namespace blender::trace_event::tests {
+
+TEST(trace_event, empty)
+{
+  std::stringstream stream;
+  {
+    Writer writer(stream);
+  }
+  EXPECT_EQ(stream.str(),
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            "{\"name\":\"trace_end\",\"ph\":\"M\",\"pid\":0,\"args\":{}}\n"
+            "]}\n");
+}
+
+TEST(trace_event, events)
+{
+  std::stringstream stream;
+  {
+    Writer writer(stream);
+    writer.process_name(1, "Graph \"A\"");
+    writer.complete_event({"Node\\1", "Group", 1.5, 2.0, 1, 3, {}});
+    const std::array<EventArg, 2> args = {{{"wait_us", 0.25}, {"migrated", 1.0}}};
+    writer.complete_event({"Line\nBreak", "", 0.0, 10.0, 0, 0, args});
+  }
+  EXPECT_EQ(stream.str(),
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Graph "
+            "\\\"A\\\"\"}},\n"
+            "{\"name\":\"Node\\\\1\",\"cat\":\"Group\",\"ph\":\"X\",\"ts\":1.500,\"dur\":2.000,"
+            "\"pid\":1,\"tid\":3},\n"
+            "{\"name\":\"Line\\u000aBreak\",\"cat\":\"\",\"ph\":\"X\",\"ts\":0.000,\"dur\":10.000,"
+            "\"pid\":0,\"tid\":0,\"args\":{\"wait_us\":0.250,\"migrated\":1.000}},\n"
+            "{\"name\":\"trace_end\",\"ph\":\"M\",\"pid\":0,\"args\":{}}\n"
+            "]}\n");
+}
+
+TEST(trace_event, thread_index)
+{
+  EXPECT_EQ(thread_index(), thread_index());
+}
+
+}  // namespace blender::trace_event::tests
@@ -0,0 +1,94 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_kdtree.h"
+#include "BLI_math_vec_types.hh"
+#include "BLI_rand.hh"
+
+#include "PIL_time.h"
+
+#define NUM_RUN_AVERAGED 5
+
+using blender::Array;
+using blender::float3;
+
+static void kdtree_find_nearest_n_test(const char *id,
+                                       const int points_num,
+                                       const int queries_num,
+                                       const uint k)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  blender::RandomNumberGenerator rng(0);
+  Array<float3> points(points_num);
+  for (float3 &point : points) {
+    point = {rng.get_float(), rng.get_float(), rng.get_float()};
+  }
+  Array<float3> queries(queries_num);
+  for (float3 &query : queries) {
+    query = {rng.get_float(), rng.get_float(), rng.get_float()};
+  }
+
+  double balance_timing = 0.0;
+  double single_timing = 0.0;
+  double batch_timing = 0.0;
+
+  Array<KDTreeNearest_3d> single(queries_num * k);
+  Array<KDTreeNearest_3d> batch(queries_num * k);
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    KDTree_3d *tree = BLI_kdtree_3d_new(points_num);
+    for (const int i : points.index_range()) {
+      BLI_kdtree_3d_insert(tree, i, points[i]);
+    }
+
+    double time = PIL_check_seconds_timer();
+    BLI_kdtree_3d_balance(tree);
+    balance_timing += PIL_check_seconds_timer() - time;
+
+    time = PIL_check_seconds_timer();
+    for (const int i : queries.index_range()) {
+      BLI_kdtree_3d_find_nearest_n(tree, queries[i], &single[i * k], k);
+    }
+    single_timing += PIL_check_seconds_timer() - time;
+
+    time = PIL_check_seconds_timer();
+    BLI_kdtree_3d_find_nearest_n_batch(tree,
+                                       reinterpret_cast<const float(*)[3]>(queries.data()),
+                                       uint(queries_num),
+                                       batch.data(),
+                                       k,
+                                       nullptr);
+    batch_timing += PIL_check_seconds_timer() - time;
+
+    BLI_kdtree_3d_free(tree);
+  }
+
+  for (const int i : single.index_range()) {
+    EXPECT_EQ(single[i].dist, batch[i].dist);
+  }
+
+  printf("\tBalance: done in %fs on average over %d runs\n",
+         balance_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+  printf("\tSingle queries: done in %fs on average over %d runs\n",
+         single_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+  printf("\tBatched queries: done in %fs on average over %d runs\n",
+         batch_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(kdtree, FindNearestN100k)
+{
+  kdtree_find_nearest_n_test("KD-tree k-nearest - 100000 points - 8 nearest", 100000, 100000, 8);
+}
+
+TEST(kdtree, FindNearestN1M)
+{
+  kdtree_find_nearest_n_test("KD-tree k-nearest - 1000000 points - 8 nearest", 1000000, 100000, 8);
+}
@@ -325,6 +325,10 @@ typedef enum eBLOLibLinkFlags {
   BLO_LIBLINK_OBDATA_INSTANCE = 1 << 24,
   /** Instantiate collections as empties, instead of linking them into current view layer. */
   BLO_LIBLINK_COLLECTION_INSTANCE = 1 << 25,
+  /** Only create placeholders for indirectly linked object data (meshes, curves, point clouds
+   * and volumes), and only read those used by objects visible in the context scene. The others
+   * are tagged #LIB_TAG_DEFERRED, and can be loaded later on demand. Only valid when linking. */
+  BLO_LIBLINK_DEFER_HIDDEN_OBDATA = 1 << 26,
 } eBLOLibLinkFlags;
 
 /**
@@ -73,6 +73,13 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Add chunks to the written memfile that share the memory of all the chunks of the given ID in
+ * the reference memfile, instead of writing and comparing the ID again.
+ *
+ * \return false when the reference memfile has no data for this ID (nothing is added then).
+ */
+bool BLO_memfile_chunks_reuse_id(MemFileWriteData *mem_data, uint id_session_uuid);
 
 /* exports */
 
@@ -993,6 +993,42 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   }
   return &new_bhead_data->bhead;
 }
+
+struct BHeadReconstructData {
+  FileData *fd;
+  const BHead *bhead;
+  void *result;
+};
+
+static void blo_bhead_reconstruct_view_fn(const void *data, size_t /*size*/, void *user_data)
+{
+  BHeadReconstructData *reconstruct_data = static_cast<BHeadReconstructData *>(user_data);
+  reconstruct_data->result = DNA_struct_reconstruct(reconstruct_data->fd->reconstruct_info,
+                                                    reconstruct_data->bhead->SDNAnr,
+                                                    reconstruct_data->bhead->nr,
+                                                    data);
+}
+
+/**
+ * Reconstruct the structs of a block whose data has not been read yet straight from the file
+ * contents, for readers that give direct access to them (memory-mapped files).
+ * This avoids reading the whole block into a temporary copy first.
+ */
+static void *blo_bhead_reconstruct_from_view(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && fd->file->view != nullptr);
+  BHeadReconstructData reconstruct_data = {fd, thisblock, nullptr};
+  if (!fd->file->view(fd->file,
+                      new_bhead->file_offset,
+                      size_t(thisblock->len),
+                      blo_bhead_reconstruct_view_fn,
+                      &reconstruct_data)) {
+    MEM_SAFE_FREE(reconstruct_data.result);
+    return nullptr;
+  }
+  return reconstruct_data.result;
+}
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
@@ -1898,15 +1934,25 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
-        if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == nullptr)) {
+        if (BHEADN_FROM_BHEAD(bh)->has_data == false && fd->file->view != nullptr) {
+          temp = blo_bhead_reconstruct_from_view(fd, bh);
+          if (UNLIKELY(temp == nullptr)) {
             fd->flags &= ~FD_FLAGS_FILE_OK;
-            return nullptr;
           }
         }
-#endif
+        else {
+          if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == nullptr)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return nullptr;
+            }
+          }
+          temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        }
+#else
         temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+#endif
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -2961,6 +3007,20 @@ static void placeholders_ensure_valid(Main *bmain)
   }
 }
 
+/**
+ * Whether reading an indirectly linked data-block can be deferred, only creating a placeholder
+ * tagged with #LIB_TAG_DEFERRED for it (see #BLO_LIBLINK_DEFER_HIDDEN_OBDATA).
+ */
+static bool read_libblock_is_deferred(const FileData *fd, const short idcode, const int tag)
+{
+  if (!fd->defer_indirect_obdata || (tag & LIB_TAG_INDIRECT) == 0) {
+    return false;
+  }
+  /* Only geometry, which makes up most of the data typically, and for which an empty placeholder
+   * does not affect anything else than the evaluation of the objects using it. */
+  return ELEM(idcode, ID_ME, ID_CV, ID_PT, ID_VO);
+}
+
 static const char *dataname(short id_code)
 {
   switch ((ID_Type)id_code) {
@@ -4307,14 +4367,17 @@ static void expand_doit_library(void *fdhandle, Main *mainvar, void *old)
 
     ID *id = is_yet_read(fd, mainvar, bhead);
     if (id == nullptr) {
-      read_libblock(fd,
-                    mainvar,
-                    bhead,
-                    fd->id_tag_extra | LIB_TAG_NEED_EXPAND | LIB_TAG_INDIRECT,
-                    false,
-                    &id);
-      BLI_assert(id != nullptr);
-      id_sort_by_name(which_libbase(mainvar, GS(id->name)), id, static_cast<ID *>(id->prev));
+      const int tag = fd->id_tag_extra | LIB_TAG_INDIRECT;
+      if (read_libblock_is_deferred(fd, bhead->code, tag)) {
+        id = create_placeholder(
+            mainvar, bhead->code, blo_bhead_id_name(fd, bhead) + 2, tag | LIB_TAG_DEFERRED);
+        oldnewmap_lib_insert(fd, bhead->old, id, bhead->code);
+      }
+      else {
+        read_libblock(fd, mainvar, bhead, tag | LIB_TAG_NEED_EXPAND, false, &id);
+        BLI_assert(id != nullptr);
+        id_sort_by_name(which_libbase(mainvar, GS(id->name)), id, static_cast<ID *>(id->prev));
+      }
     }
     else {
       /* Convert any previously read weak link to regular link
@@ -4546,6 +4609,7 @@ Main *BLO_library_link_begin(BlendHandle **bh,
                              const LibraryLink_Params *params)
 {
   FileData *fd = (FileData *)(*bh);
+  fd->defer_indirect_obdata = (params->flag & BLO_LIBLINK_DEFER_HIDDEN_OBDATA) != 0;
   return library_link_begin(params->bmain, &fd, filepath, params->id_tag_extra);
 }
 
@@ -4724,7 +4788,13 @@ static void read_library_linked_id(
   id->tag &= ~LIB_TAG_ID_LINK_PLACEHOLDER;
   id->flag &= ~LIB_INDIRECT_WEAK_LINK;
 
-  if (bhead) {
+  if (bhead && read_libblock_is_deferred(fd, GS(id->name), id->tag)) {
+    /* Only register a placeholder, the data-block itself is read when it is actually needed. */
+    if (r_id) {
+      *r_id = create_placeholder(mainvar, GS(id->name), id->name + 2, id->tag | LIB_TAG_DEFERRED);
+    }
+  }
+  else if (bhead) {
     id->tag |= LIB_TAG_NEED_EXPAND;
     // printf("read lib block %s\n", id->name);
     read_libblock(fd, mainvar, bhead, id->tag, false, r_id);
@@ -4869,6 +4939,7 @@ static FileData *read_library_file_data(FileData *basefd,
     fd->mainlist = mainlist;
 
     fd->reports = basefd->reports;
+    fd->defer_indirect_obdata = basefd->defer_indirect_obdata;
 
     if (fd->libmap) {
       oldnewmap_free(fd->libmap);
@@ -93,6 +93,14 @@ typedef struct FileData {
    */
   int id_tag_extra;
 
+  /**
+   * Only create placeholders for indirectly linked object data, instead of reading it.
+   *
+   * \note This is initialized from #BLO_LIBLINK_DEFER_HIDDEN_OBDATA, and passed on to the file
+   * data of the libraries read while linking.
+   */
+  bool defer_indirect_obdata;
+
   struct OldNewMap *datamap;
   struct OldNewMap *globmap;
   struct OldNewMap *libmap;
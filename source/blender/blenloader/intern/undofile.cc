@@ -178,6 +178,37 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+bool BLO_memfile_chunks_reuse_id(MemFileWriteData *mem_data, uint id_session_uuid)
+{
+  if (mem_data->id_session_uuid_mapping == nullptr) {
+    return false;
+  }
+  MemFileChunk *compchunk = static_cast<MemFileChunk *>(
+      BLI_ghash_lookup(mem_data->id_session_uuid_mapping, POINTER_FROM_UINT(id_session_uuid)));
+  if (compchunk == nullptr) {
+    return false;
+  }
+
+  MemFile *memfile = mem_data->written_memfile;
+  for (; compchunk != nullptr && compchunk->id_session_uuid == id_session_uuid;
+       compchunk = static_cast<MemFileChunk *>(compchunk->next)) {
+    MemFileChunk *curchunk = static_cast<MemFileChunk *>(
+        MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
+    curchunk->size = compchunk->size;
+    curchunk->buf = compchunk->buf;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uuid = id_session_uuid;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+  }
+  /* Continue comparing with the chunks following the reused ones, like after writing the ID. */
+  mem_data->reference_current_chunk = compchunk;
+
+  return true;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *bmain,
                                   struct Scene **r_scene)
@@ -344,6 +375,7 @@ FileReader *BLO_memfile_new_filereader(MemFile *memfile, int undo_direction)
   undo->reader.read = undo_read;
   undo->reader.seek = nullptr;
   undo->reader.close = undo_close;
+  undo->reader.view = nullptr;
 
   return (FileReader *)undo;
 }
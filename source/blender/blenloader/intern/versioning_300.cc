@@ -3562,7 +3562,8 @@ void blo_do_versions_300(FileData *fd, Library * /*lib*/, Main *bmain)
 
     /* Face sets no longer store whether the corresponding face is hidden. */
     LISTBASE_FOREACH (Mesh *, mesh, &bmain->meshes) {
-      int *face_sets = (int *)CustomData_get_layer(&mesh->pdata, CD_SCULPT_FACE_SETS);
+      int *face_sets = (int *)CustomData_get_layer_for_write(
+          &mesh->pdata, CD_SCULPT_FACE_SETS, mesh->totpoly);
       if (face_sets) {
         for (int i = 0; i < mesh->totpoly; i++) {
           face_sets[i] = abs(face_sets[i]);
@@ -3623,6 +3624,21 @@ void blo_do_versions_300(FileData *fd, Library * /*lib*/, Main *bmain)
     }
   }
 
+  if (!MAIN_VERSION_ATLEAST(bmain, 304, 4)) {
+    /* Keep the points of existing Distribute Points on Faces nodes in Poisson Disk mode. */
+    LISTBASE_FOREACH (bNodeTree *, ntree, &bmain->nodetrees) {
+      if (ntree->type != NTREE_GEOMETRY) {
+        continue;
+      }
+      LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
+        if (node->type != GEO_NODE_DISTRIBUTE_POINTS_ON_FACES) {
+          continue;
+        }
+        node->custom2 |= GEO_NODE_POINT_DISTRIBUTE_POINTS_ON_FACES_LEGACY_ELIMINATION;
+      }
+    }
+  }
+
   /**
    * Versioning code until next subversion bump goes here.
    *
@@ -3634,5 +3650,11 @@ void blo_do_versions_300(FileData *fd, Library * /*lib*/, Main *bmain)
    */
   {
     /* Keep this block, even when empty. */
+
+    if (!DNA_struct_elem_find(fd->filesdna, "XrSessionSettings", "float", "resolution_scale")) {
+      LISTBASE_FOREACH (wmWindowManager *, wm, &bmain->wm) {
+        wm->xr.session_settings.resolution_scale = 1.0f;
+      }
+    }
   }
 }
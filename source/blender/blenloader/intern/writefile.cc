@@ -1083,6 +1083,31 @@ static void write_thumb(WriteData *wd, const BlendThumbnail *thumb)
 /** \name File Writing (Private)
  * \{ */
 
+/**
+ * Whether the undo memory of the previous step can be reused for this ID instead of writing it
+ * again, see #UserDef_Experimental.use_undo_skip_unchanged_ids.
+ *
+ * This relies on changes having been tagged in the depsgraph, so the types which are commonly
+ * edited without any tagging (UI data, tool settings, texts) are always written.
+ */
+static bool write_id_is_unchanged_for_undo(const ID *id)
+{
+  if (ELEM(GS(id->name), ID_WM, ID_WS, ID_SCR, ID_SCE, ID_TXT)) {
+    return false;
+  }
+  /* Also check the changes stored in the previous step, so that the reused memory has the same
+   * (cleared) `recalc_up_to_undo_push` as when the ID would be written. */
+  if (id->recalc_after_undo_push != 0 || id->recalc_up_to_undo_push != 0) {
+    return false;
+  }
+  const bNodeTree *nodetree = ntreeFromID((ID *)id);
+  if (nodetree != nullptr &&
+      (nodetree->id.recalc_after_undo_push != 0 || nodetree->id.recalc_up_to_undo_push != 0)) {
+    return false;
+  }
+  return true;
+}
+
 /* if MemFile * there's filesave to memory */
 static bool write_file_handle(Main *mainvar,
                               WriteWrap *ww,
@@ -1121,6 +1146,8 @@ static bool write_file_handle(Main *mainvar,
   OverrideLibraryStorage *override_storage = wd->use_memfile ?
                                                  nullptr :
                                                  BKE_lib_override_library_operations_store_init();
+  const bool use_undo_skip_unchanged = wd->use_memfile &&
+                                       USER_EXPERIMENTAL_TEST(&U, use_undo_skip_unchanged_ids);
 
 #define ID_BUFFER_STATIC_SIZE 8192
   /* This outer loop allows to save first data-blocks from real mainvar,
@@ -1173,6 +1200,9 @@ static bool write_file_handle(Main *mainvar,
         }
 
         if (wd->use_memfile) {
+          const bool is_unchanged = use_undo_skip_unchanged &&
+                                    write_id_is_unchanged_for_undo(id);
+
           /* Record the changes that happened up to this undo push in
            * recalc_up_to_undo_push, and clear `recalc_after_undo_push` again
            * to start accumulating for the next undo push. */
@@ -1192,6 +1222,12 @@ static bool write_file_handle(Main *mainvar,
               scene->master_collection->id.recalc_after_undo_push = 0;
             }
           }
+
+          if (is_unchanged && BLO_memfile_chunks_reuse_id(&wd->mem, id->session_uuid)) {
+            /* The buffer is flushed after each ID, so nothing of another ID gets mixed in. */
+            BLI_assert(wd->buffer.used_len == 0);
+            continue;
+          }
         }
 
         mywrite_id_begin(wd, id);
@@ -353,6 +353,11 @@ typedef struct BMesh {
   int shapenr;
 
   int totflags;
+  /**
+   * Number of flag layers the tool flag pools have room for, layers of operators that finished
+   * are kept so nested operators don't have to reallocate the flags of all elements.
+   */
+  int totflags_alloc;
   ListBase selected;
 
   /**
@@ -104,6 +104,7 @@ void BM_mesh_elem_toolflags_ensure(BMesh *bm)
   }
 
   bm->totflags = 1;
+  bm->totflags_alloc = 1;
 }
 
 void BM_mesh_elem_toolflags_clear(BMesh *bm)
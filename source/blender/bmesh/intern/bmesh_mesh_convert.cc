@@ -84,6 +84,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_task.h"
 #include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
@@ -129,6 +130,7 @@ static BMFace *bm_face_create_from_mpoly(BMesh &bm,
 
 void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshParams *params)
 {
+  using namespace blender;
   const bool is_new = !(bm->totvert || (bm->vdata.totlayer || bm->edata.totlayer ||
                                         bm->pdata.totlayer || bm->ldata.totlayer));
   KeyBlock *actkey;
@@ -283,6 +285,10 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
   const int *material_indices = (const int *)CustomData_get_layer_named(
       &me->pdata, CD_PROP_INT32, "material_index");
 
+  /* Elements are created on a single thread since the memory pools are not thread-safe, but their
+   * custom-data blocks are allocated at the same time so that copying the layers, which is most of
+   * the work on meshes with many attributes, can be done in parallel afterwards. */
+
   Span<MVert> mvert = me->verts();
   Array<BMVert *> vtable(me->totvert);
   for (const int i : mvert.index_range()) {
@@ -297,26 +303,32 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       BM_vert_select_set(bm, v, true);
     }
 
-    if (vert_normals) {
-      copy_v3_v3(v->no, vert_normals[i]);
-    }
+    CustomData_bmesh_alloc_block(&bm->vdata, &v->head.data);
+  }
+  threading::parallel_for(mvert.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *v = vtable[i];
+      if (vert_normals) {
+        copy_v3_v3(v->no, vert_normals[i]);
+      }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
 
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
+      /* Set shape key original index. */
+      if (cd_shape_keyindex_offset != -1) {
+        BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
+      }
 
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
+      /* Set shape-key data. */
+      if (tot_shape_keys) {
+        float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
+        for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
+          copy_v3_v3(*co_dst, shape_key_table[j][i]);
+        }
       }
     }
-  }
+  });
   if (is_new) {
     bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
   }
@@ -337,9 +349,14 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       BM_edge_select_set(bm, e, true);
     }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
+    CustomData_bmesh_alloc_block(&bm->edata, &e->head.data);
   }
+  threading::parallel_for(medge.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &etable[i]->head.data, true);
+    }
+  });
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
@@ -347,20 +364,14 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
   const Span<MPoly> mpoly = me->polys();
   const Span<MLoop> mloop = me->loops();
 
-  /* Only needed for selection. */
-
-  Array<BMFace *> ftable;
-  if (me->mselect && me->totselect != 0) {
-    ftable.reinitialize(me->totpoly);
-  }
+  /* Also used for selection. */
+  Array<BMFace *> ftable(me->totpoly);
 
   int totloops = 0;
   for (const int i : mpoly.index_range()) {
     BMFace *f = bm_face_create_from_mpoly(
         *bm, mloop.slice(mpoly[i].loopstart, mpoly[i].totloop), vtable, etable);
-    if (!ftable.is_empty()) {
-      ftable[i] = f;
-    }
+    ftable[i] = f;
 
     if (UNLIKELY(f == nullptr)) {
       printf(
@@ -389,24 +400,39 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       bm->act_face = f;
     }
 
-    int j = mpoly[i].loopstart;
     BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     BMLoop *l_iter = l_first;
     do {
-      /* Don't use 'j' since we may have skipped some faces, hence some loops. */
+      /* Don't use the #MLoop index since we may have skipped some faces, hence some loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
-
-      /* Save index of corresponding #MLoop. */
-      CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+      CustomData_bmesh_alloc_block(&bm->ldata, &l_iter->head.data);
     } while ((l_iter = l_iter->next) != l_first);
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+    CustomData_bmesh_alloc_block(&bm->pdata, &f->head.data);
+  }
+  threading::parallel_for(mpoly.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMFace *f = ftable[i];
+      if (f == nullptr) {
+        continue;
+      }
 
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
+      int j = mpoly[i].loopstart;
+      BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+      BMLoop *l_iter = l_first;
+      do {
+        /* Save index of corresponding #MLoop. */
+        CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+      } while ((l_iter = l_iter->next) != l_first);
+
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+      if (params->calc_face_normal) {
+        BM_face_normal_update(f);
+      }
     }
-  }
+  });
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
   }
@@ -919,6 +945,78 @@ static void convert_bmesh_selection_flags_to_mesh_attributes(BMesh &bm,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Parallel Custom-Data Copy
+ *
+ * Copying the custom-data layers is the most expensive part of the conversion on meshes with many
+ * attributes. It only depends on the element indices, so once they are assigned the blocks can be
+ * copied while iterating over the memory pool chunks in parallel.
+ * \{ */
+
+struct BMeshToMeshCustomData {
+  const BMesh *bm;
+  Mesh *me;
+};
+
+static void bm_vert_custom_data_to_mesh_fn(void *__restrict userdata,
+                                           MempoolIterData *iter,
+                                           const TaskParallelTLS *__restrict /*tls*/)
+{
+  const BMeshToMeshCustomData *data = static_cast<const BMeshToMeshCustomData *>(userdata);
+  const BMVert *v = reinterpret_cast<const BMVert *>(iter);
+  CustomData_from_bmesh_block(
+      &data->bm->vdata, &data->me->vdata, v->head.data, BM_elem_index_get(v));
+}
+
+static void bm_edge_custom_data_to_mesh_fn(void *__restrict userdata,
+                                           MempoolIterData *iter,
+                                           const TaskParallelTLS *__restrict /*tls*/)
+{
+  const BMeshToMeshCustomData *data = static_cast<const BMeshToMeshCustomData *>(userdata);
+  const BMEdge *e = reinterpret_cast<const BMEdge *>(iter);
+  CustomData_from_bmesh_block(
+      &data->bm->edata, &data->me->edata, e->head.data, BM_elem_index_get(e));
+}
+
+static void bm_face_custom_data_to_mesh_fn(void *__restrict userdata,
+                                           MempoolIterData *iter,
+                                           const TaskParallelTLS *__restrict /*tls*/)
+{
+  const BMeshToMeshCustomData *data = static_cast<const BMeshToMeshCustomData *>(userdata);
+  const BMFace *f = reinterpret_cast<const BMFace *>(iter);
+  const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  const BMLoop *l_iter = l_first;
+  do {
+    CustomData_from_bmesh_block(
+        &data->bm->ldata, &data->me->ldata, l_iter->head.data, BM_elem_index_get(l_iter));
+  } while ((l_iter = l_iter->next) != l_first);
+
+  CustomData_from_bmesh_block(
+      &data->bm->pdata, &data->me->pdata, f->head.data, BM_elem_index_get(f));
+}
+
+/**
+ * Copy the custom-data of all elements to \a me.
+ * The indices of all elements (loops included) need to be valid.
+ */
+static void bm_to_mesh_custom_data_copy(BMesh &bm, Mesh &me)
+{
+  BLI_assert((bm.elem_index_dirty & BM_ALL) == 0);
+  BMeshToMeshCustomData data = {&bm, &me};
+
+  TaskParallelSettings settings;
+  BLI_parallel_mempool_settings_defaults(&settings);
+
+  settings.use_threading = bm.totvert >= BM_OMP_LIMIT;
+  BM_iter_parallel(&bm, BM_VERTS_OF_MESH, bm_vert_custom_data_to_mesh_fn, &data, &settings);
+  settings.use_threading = bm.totedge >= BM_OMP_LIMIT;
+  BM_iter_parallel(&bm, BM_EDGES_OF_MESH, bm_edge_custom_data_to_mesh_fn, &data, &settings);
+  settings.use_threading = bm.totloop >= BM_OMP_LIMIT;
+  BM_iter_parallel(&bm, BM_FACES_OF_MESH, bm_face_custom_data_to_mesh_fn, &data, &settings);
+}
+
+/** \} */
+
 void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
 {
   BMVert *v, *eve;
@@ -991,9 +1089,6 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
 
     BM_elem_index_set(v, i); /* set_inline */
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
-
     i++;
 
     BM_CHECK_ELEMENT(v);
@@ -1015,9 +1110,6 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
 
     BM_elem_index_set(e, i); /* set_inline */
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
-
     bmesh_quick_edgedraw_flag(&medge[i], e);
 
     i++;
@@ -1042,13 +1134,14 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
       need_select_poly = true;
     }
 
+    BM_elem_index_set(f, i); /* set_inline */
+
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
       mloop[j].e = BM_elem_index_get(l_iter->e);
       mloop[j].v = BM_elem_index_get(l_iter->v);
 
-      /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+      BM_elem_index_set(l_iter, j); /* set_inline */
 
       j++;
       BM_CHECK_ELEMENT(l_iter);
@@ -1060,12 +1153,12 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
       me->act_face = i;
     }
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
     i++;
     BM_CHECK_ELEMENT(f);
   }
+  bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP);
+
+  bm_to_mesh_custom_data_copy(*bm, *me);
 
   if (need_material_index) {
     BM_mesh_elem_table_ensure(bm, BM_FACE);
@@ -1265,8 +1358,6 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
       }
       select_vert_attribute.span[i] = true;
     }
-
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, eve->head.data, i);
   }
   bm->elem_index_dirty &= ~BM_VERT;
 
@@ -1303,8 +1394,6 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
         med->flag |= ME_EDGEDRAW;
       }
     }
-
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, eed->head.data, i);
   }
   bm->elem_index_dirty &= ~BM_EDGE;
 
@@ -1349,18 +1438,17 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
     do {
       mloop->v = BM_elem_index_get(l_iter->v);
       mloop->e = BM_elem_index_get(l_iter->e);
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
 
       BM_elem_index_set(l_iter, j); /* set_inline */
 
       j++;
       mloop++;
     } while ((l_iter = l_iter->next) != l_first);
-
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, efa->head.data, i);
   }
   bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP);
 
+  bm_to_mesh_custom_data_copy(*bm, *me);
+
   assert_bmesh_has_no_mesh_only_attributes(*bm);
 
   material_index_attribute.finish();
@@ -1166,6 +1166,13 @@ void BMO_slot_buffer_flag_disable(BMesh *bm,
  */
 static void bmo_flag_layer_alloc(BMesh *bm)
 {
+  if (bm->totflags < bm->totflags_alloc) {
+    /* The pools still have room for the layer of a previous operator, only clear it. */
+    bm->totflags++;
+    bmo_flag_layer_clear(bm);
+    return;
+  }
+
   /* set the index values since we are looping over all data anyway,
    * may save time later on */
 
@@ -1177,6 +1184,7 @@ static void bmo_flag_layer_alloc(BMesh *bm)
   const size_t old_totflags_size = (bm->totflags * sizeof(BMFlagLayer));
 
   bm->totflags++;
+  bm->totflags_alloc = bm->totflags;
 
   bm->vtoolflagpool = BLI_mempool_create(
       sizeof(BMFlagLayer) * bm->totflags, bm->totvert, 512, BLI_MEMPOOL_NOP);
@@ -1228,61 +1236,30 @@ static void bmo_flag_layer_alloc(BMesh *bm)
 
 static void bmo_flag_layer_free(BMesh *bm)
 {
-  /* set the index values since we are looping over all data anyway,
+  /* The layer is kept in the pools for the next operator, see #bmo_flag_layer_alloc.
+   * Set the index values since we are looping over all data anyway,
    * may save time later on */
 
-  BLI_mempool *voldpool = bm->vtoolflagpool;
-  BLI_mempool *eoldpool = bm->etoolflagpool;
-  BLI_mempool *foldpool = bm->ftoolflagpool;
-
-  /* store memcpy size for reuse */
-  const size_t new_totflags_size = ((bm->totflags - 1) * sizeof(BMFlagLayer));
-
   /* de-increment the totflags first. */
   bm->totflags--;
 
-  bm->vtoolflagpool = BLI_mempool_create(new_totflags_size, bm->totvert, 512, BLI_MEMPOOL_NOP);
-  bm->etoolflagpool = BLI_mempool_create(new_totflags_size, bm->totedge, 512, BLI_MEMPOOL_NOP);
-  bm->ftoolflagpool = BLI_mempool_create(new_totflags_size, bm->totface, 512, BLI_MEMPOOL_NOP);
-
-  /* now go through and memcpy all the flag */
   BMIter iter;
   int i;
 
-  BMVert_OFlag *v_oflag;
-  BLI_mempool *newpool = bm->vtoolflagpool;
-  BM_ITER_MESH_INDEX (v_oflag, &iter, bm, BM_VERTS_OF_MESH, i) {
-    void *oldflags = v_oflag->oflags;
-    v_oflag->oflags = BLI_mempool_alloc(newpool);
-    memcpy(v_oflag->oflags, oldflags, new_totflags_size);
-    BM_elem_index_set(&v_oflag->base, i); /* set_inline */
-    BM_ELEM_API_FLAG_CLEAR((BMElemF *)v_oflag);
+  BMElemF *ele;
+  BM_ITER_MESH_INDEX (ele, &iter, bm, BM_VERTS_OF_MESH, i) {
+    BM_elem_index_set(ele, i); /* set_inline */
+    BM_ELEM_API_FLAG_CLEAR(ele);
   }
-
-  BMEdge_OFlag *e_oflag;
-  newpool = bm->etoolflagpool;
-  BM_ITER_MESH_INDEX (e_oflag, &iter, bm, BM_EDGES_OF_MESH, i) {
-    void *oldflags = e_oflag->oflags;
-    e_oflag->oflags = BLI_mempool_alloc(newpool);
-    memcpy(e_oflag->oflags, oldflags, new_totflags_size);
-    BM_elem_index_set(&e_oflag->base, i); /* set_inline */
-    BM_ELEM_API_FLAG_CLEAR((BMElemF *)e_oflag);
+  BM_ITER_MESH_INDEX (ele, &iter, bm, BM_EDGES_OF_MESH, i) {
+    BM_elem_index_set(ele, i); /* set_inline */
+    BM_ELEM_API_FLAG_CLEAR(ele);
   }
-
-  BMFace_OFlag *f_oflag;
-  newpool = bm->ftoolflagpool;
-  BM_ITER_MESH_INDEX (f_oflag, &iter, bm, BM_FACES_OF_MESH, i) {
-    void *oldflags = f_oflag->oflags;
-    f_oflag->oflags = BLI_mempool_alloc(newpool);
-    memcpy(f_oflag->oflags, oldflags, new_totflags_size);
-    BM_elem_index_set(&f_oflag->base, i); /* set_inline */
-    BM_ELEM_API_FLAG_CLEAR((BMElemF *)f_oflag);
+  BM_ITER_MESH_INDEX (ele, &iter, bm, BM_FACES_OF_MESH, i) {
+    BM_elem_index_set(ele, i); /* set_inline */
+    BM_ELEM_API_FLAG_CLEAR(ele);
   }
 
-  BLI_mempool_destroy(voldpool);
-  BLI_mempool_destroy(eoldpool);
-  BLI_mempool_destroy(foldpool);
-
   bm->elem_index_dirty &= ~(BM_VERT | BM_EDGE | BM_FACE);
 }
 
@@ -1302,6 +1279,7 @@ static void bmo_flag_layer_clear(BMesh *bm)
     BM_ITER_MESH_INDEX (ele, &iter, bm, BM_VERTS_OF_MESH, i) {
       ele->oflags[totflags_offset] = zero_flag;
       BM_elem_index_set(&ele->base, i); /* set_inline */
+      BM_ELEM_API_FLAG_CLEAR((BMElemF *)ele);
     }
   }
   {
@@ -1311,6 +1289,7 @@ static void bmo_flag_layer_clear(BMesh *bm)
     BM_ITER_MESH_INDEX (ele, &iter, bm, BM_EDGES_OF_MESH, i) {
       ele->oflags[totflags_offset] = zero_flag;
       BM_elem_index_set(&ele->base, i); /* set_inline */
+      BM_ELEM_API_FLAG_CLEAR((BMElemF *)ele);
     }
   }
   {
@@ -1320,6 +1299,7 @@ static void bmo_flag_layer_clear(BMesh *bm)
     BM_ITER_MESH_INDEX (ele, &iter, bm, BM_FACES_OF_MESH, i) {
       ele->oflags[totflags_offset] = zero_flag;
       BM_elem_index_set(&ele->base, i); /* set_inline */
+      BM_ELEM_API_FLAG_CLEAR((BMElemF *)ele);
     }
   }
 
@@ -18,6 +18,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -53,6 +54,9 @@
 #define OPTIMIZE_EPS 1e-8
 #define COST_INVALID FLT_MAX
 
+/** Below this number of elements, the initial quadrics and costs are calculated on one thread. */
+#define DECIMATE_THREADED_LIMIT 4096
+
 typedef enum CD_UseFlag {
   CD_DO_VERT = (1 << 0),
   CD_DO_EDGE = (1 << 1),
@@ -62,64 +66,91 @@ typedef enum CD_UseFlag {
 /* BMesh Helper Functions
  * ********************** */
 
+static void bm_decim_face_quadric(BMFace *f, Quadric *r_q)
+{
+  float center[3];
+  double plane_db[4];
+
+  BM_face_calc_center_median(f, center);
+  copy_v3db_v3fl(plane_db, f->no);
+  plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+
+  BLI_quadric_from_plane(r_q, plane_db);
+}
+
 /**
- * \param vquadrics: must be calloc'd
+ * \return False when the boundary edge is degenerate and doesn't add a quadric.
  */
-static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+static bool bm_decim_boundary_edge_quadric(BMEdge *e, Quadric *r_q)
 {
-  BMIter iter;
-  BMFace *f;
-  BMEdge *e;
+  float edge_vector[3];
+  float edge_plane[3];
+  double edge_plane_db[4];
+  sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
 
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_first;
-    BMLoop *l_iter;
+  cross_v3_v3v3(edge_plane, edge_vector, e->l->f->no);
+  copy_v3db_v3fl(edge_plane_db, edge_plane);
 
+  if (normalize_v3_db(edge_plane_db) > (double)FLT_EPSILON) {
     float center[3];
-    double plane_db[4];
-    Quadric q;
-
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
 
-    BLI_quadric_from_plane(&q, plane_db);
+    mid_v3_v3v3(center, e->v1->co, e->v2->co);
 
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
-    } while ((l_iter = l_iter->next) != l_first);
+    edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
+    BLI_quadric_from_plane(r_q, edge_plane_db);
+    BLI_quadric_mul(r_q, BOUNDARY_PRESERVE_WEIGHT);
+    return true;
   }
+  return false;
+}
 
-  /* boundary edges */
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    if (UNLIKELY(BM_edge_is_boundary(e))) {
-      float edge_vector[3];
-      float edge_plane[3];
-      double edge_plane_db[4];
-      sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
-      f = e->l->f;
-
-      cross_v3_v3v3(edge_plane, edge_vector, f->no);
-      copy_v3db_v3fl(edge_plane_db, edge_plane);
-
-      if (normalize_v3_db(edge_plane_db) > (double)FLT_EPSILON) {
-        Quadric q;
-        float center[3];
+/**
+ * Gather the quadrics of the faces and boundary edges around a vertex. Each vertex only writes
+ * its own quadric, so all vertices can be handled in parallel. Face quadrics are calculated once
+ * for each of their vertices, which is cheap compared to summing them up with a lock.
+ */
+static void bm_decim_build_quadrics_vert_fn(void *__restrict userdata,
+                                            MempoolIterData *mp_v,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  Quadric *vquadrics = userdata;
+  BMVert *v = (BMVert *)mp_v;
+  Quadric *v_quadric = &vquadrics[BM_elem_index_get(v)];
+  Quadric q;
 
-        mid_v3_v3v3(center, e->v1->co, e->v2->co);
+  if (v->e == NULL) {
+    return;
+  }
 
-        edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
-        BLI_quadric_from_plane(&q, edge_plane_db);
-        BLI_quadric_mul(&q, BOUNDARY_PRESERVE_WEIGHT);
+  BMIter iter;
+  BMLoop *l;
+  BM_ITER_ELEM (l, &iter, v, BM_LOOPS_OF_VERT) {
+    bm_decim_face_quadric(l->f, &q);
+    BLI_quadric_add_qu_qu(v_quadric, &q);
+  }
 
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v1)], &q);
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v2)], &q);
+  /* boundary edges */
+  BMEdge *e;
+  BM_ITER_ELEM (e, &iter, v, BM_EDGES_OF_VERT) {
+    if (UNLIKELY(BM_edge_is_boundary(e))) {
+      if (bm_decim_boundary_edge_quadric(e, &q)) {
+        BLI_quadric_add_qu_qu(v_quadric, &q);
       }
     }
   }
 }
 
+/**
+ * \param vquadrics: must be calloc'd
+ */
+static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_mempool_settings_defaults(&settings);
+  settings.use_threading = bm->totvert >= DECIMATE_THREADED_LIMIT;
+  BM_iter_parallel(bm, BM_VERTS_OF_MESH, bm_decim_build_quadrics_vert_fn, vquadrics, &settings);
+}
+
 static void bm_decim_calc_target_co_db(BMEdge *e, double optimize_co[3], const Quadric *vquadrics)
 {
   /* compute an edge contraction target for edge 'e'
@@ -222,18 +253,20 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * \return False when the edge must not be collapsed, otherwise its cost is written to \a r_cost.
+ */
+static bool bm_decim_calc_edge_cost(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f)))) {
-    goto clear;
+    return false;
   }
 
   /* check we can collapse, some edges we better not touch */
@@ -243,7 +276,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -252,11 +285,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* end sanity check */
 
@@ -308,10 +341,24 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+
+  if (bm_decim_calc_edge_cost(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
 
-clear:
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -326,6 +373,29 @@ static void bm_decim_invalid_edge_cost_single(BMEdge *e, Heap *eheap, HeapNode *
   eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, COST_INVALID, e);
 }
 
+struct EdgeCostUserData {
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+  float *ecosts;
+  bool *ecollapse;
+};
+
+static void bm_decim_build_edge_cost_fn(void *__restrict userdata,
+                                        MempoolIterData *mp_e,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct EdgeCostUserData *data = userdata;
+  BMEdge *e = (BMEdge *)mp_e;
+  const int i = BM_elem_index_get(e);
+  data->ecollapse[i] = bm_decim_calc_edge_cost(
+      e, data->vquadrics, data->vweights, data->vweight_factor, &data->ecosts[i]);
+}
+
+/**
+ * The costs are calculated in parallel, then the edges are inserted into the heap in the order of
+ * the mesh, so the result doesn't depend on the threading.
+ */
 static void bm_decim_build_edge_cost(BMesh *bm,
                                      const Quadric *vquadrics,
                                      const float *vweights,
@@ -333,15 +403,29 @@ static void bm_decim_build_edge_cost(BMesh *bm,
                                      Heap *eheap,
                                      HeapNode **eheap_table)
 {
+  struct EdgeCostUserData data = {
+      .vquadrics = vquadrics,
+      .vweights = vweights,
+      .vweight_factor = vweight_factor,
+      .ecosts = MEM_mallocN(sizeof(float) * bm->totedge, __func__),
+      .ecollapse = MEM_mallocN(sizeof(bool) * bm->totedge, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_mempool_settings_defaults(&settings);
+  settings.use_threading = bm->totedge >= DECIMATE_THREADED_LIMIT;
+  BM_iter_parallel(bm, BM_EDGES_OF_MESH, bm_decim_build_edge_cost_fn, &data, &settings);
+
   BMIter iter;
   BMEdge *e;
   uint i;
 
   BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = NULL;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    eheap_table[i] = data.ecollapse[i] ? BLI_heap_insert(eheap, data.ecosts[i], e) : NULL;
   }
+
+  MEM_freeN(data.ecosts);
+  MEM_freeN(data.ecollapse);
 }
 
 #ifdef USE_SYMMETRY
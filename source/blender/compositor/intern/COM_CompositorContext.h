@@ -212,6 +212,15 @@ class CompositorContext {
     return this->get_bnodetree()->chunksize;
   }
 
+  /**
+   * Memory in bytes operations buffers can use during execution, 0 when there is no limit.
+   * Only the full frame execution model respects it.
+   */
+  size_t get_memory_limit() const
+  {
+    return size_t(this->get_bnodetree()->memory_limit) * 1024 * 1024;
+  }
+
   void set_fast_calculation(bool fast_calculation)
   {
     fast_calculation_ = fast_calculation;
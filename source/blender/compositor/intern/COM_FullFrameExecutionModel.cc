@@ -3,6 +3,11 @@
 
 #include "COM_FullFrameExecutionModel.h"
 
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+
 #include "BLT_translation.h"
 
 #include "COM_Debug.h"
@@ -22,6 +27,8 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
       active_buffers_(shared_buffers),
       num_operations_finished_(0)
 {
+  active_buffers_.set_memory_limit(context.get_memory_limit());
+
   priorities_.append(eCompositorPriority::High);
   if (!context.is_fast_calculation()) {
     priorities_.append(eCompositorPriority::Medium);
@@ -91,6 +98,62 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
+/**
+ * Hash of a rendered buffer pixels and the operation canvas. Identifies the result of operations
+ * which parameters can't be hashed, so that the operations reading them can still be cached.
+ */
+static uint64_t hash_rendered_buffer(const NodeOperation *op, MemoryBuffer *buf)
+{
+  const rcti &canvas = op->get_canvas();
+  uint64_t hash = get_default_hash_4(canvas.xmin, canvas.xmax, canvas.ymin, canvas.ymax);
+  hash = combine_content_hashes(
+      hash, get_default_hash_2(buf->get_num_channels(), buf->is_a_single_elem()));
+
+  const int height = buf->get_memory_height();
+  const size_t row_len = size_t(buf->get_memory_width()) * buf->get_num_channels();
+  const float *buffer = buf->get_buffer();
+  Array<uint64_t> rows_hashes(height);
+  threading::parallel_for(IndexRange(height), 32, [&](const IndexRange rows) {
+    for (const int y : rows) {
+      /* 64-bit FNV-1a over the bits of each value. */
+      const uint32_t *row = reinterpret_cast<const uint32_t *>(buffer + y * row_len);
+      uint64_t row_hash = 0xcbf29ce484222325ull;
+      for (const size_t i : IndexRange(row_len)) {
+        row_hash = (row_hash ^ row[i]) * 0x100000001b3ull;
+      }
+      rows_hashes[y] = row_hash;
+    }
+  });
+  for (const uint64_t row_hash : rows_hashes) {
+    hash = combine_content_hashes(hash, row_hash);
+  }
+  return hash;
+}
+
+std::optional<uint64_t> FullFrameExecutionModel::get_operation_content_hash(NodeOperation *op)
+{
+  const int num_inputs = op->get_number_of_input_sockets();
+  Vector<uint64_t> inputs_hashes(num_inputs);
+  for (int i = 0; i < num_inputs; i++) {
+    const uint64_t *input_hash = content_hashes_.lookup_ptr(op->get_input_operation(i));
+    if (input_hash == nullptr) {
+      return std::nullopt;
+    }
+    inputs_hashes[i] = *input_hash;
+  }
+
+  std::optional<uint64_t> hash = op->generate_content_hash(inputs_hashes);
+  if (!hash) {
+    return std::nullopt;
+  }
+  /* Areas not registered for rendering are left uninitialized. */
+  for (const rcti &area : active_buffers_.get_areas_to_render(op, 0, 0)) {
+    *hash = combine_content_hashes(
+        *hash, get_default_hash_4(area.xmin, area.xmax, area.ymin, area.ymax));
+  }
+  return combine_content_hashes(*hash, get_default_hash(int(context_.get_quality())));
+}
+
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
   /* Output has no offset for easier image algorithms implementation on operations. */
@@ -98,6 +161,24 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   constexpr int output_y = 0;
 
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
+  const bool use_cache = has_outputs && active_buffers_.use_cache();
+  std::optional<uint64_t> content_hash;
+  if (use_cache) {
+    content_hash = get_operation_content_hash(op);
+    if (content_hash && active_buffers_.set_cached_buffer(op, *content_hash)) {
+      content_hashes_.add_new(op, *content_hash);
+      operation_finished(op);
+      return;
+    }
+  }
+
+  size_t output_size = 0;
+  if (has_outputs && !op->get_flags().is_constant_operation) {
+    const DataType data_type = op->get_output_socket(0)->get_data_type();
+    output_size = size_t(COM_data_type_bytes_len(data_type)) * op->get_width() * op->get_height();
+  }
+  active_buffers_.prepare_render(op, output_size);
+
   MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
   if (op->get_width() > 0 && op->get_height() > 0) {
     Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
@@ -115,6 +196,16 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
   active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
 
+  if (use_cache) {
+    if (content_hash) {
+      active_buffers_.cache_rendered_buffer(op, *content_hash);
+    }
+    else {
+      content_hash = hash_rendered_buffer(op, op_buf);
+    }
+    content_hashes_.add_new(op, *content_hash);
+  }
+
   operation_finished(op);
 }
 
@@ -141,40 +232,43 @@ void FullFrameExecutionModel::render_operations()
 }
 
 /**
- * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
+ * Returns all dependencies not rendered yet from inputs to outputs, in depth first post-order:
+ * all dependencies of an input come before the next input ones. Finishing a branch before
+ * starting the next one lets its buffers be disposed early, instead of keeping the buffers of
+ * every branch alive until the operations joining them are rendered.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+Vector<NodeOperation *> FullFrameExecutionModel::get_operation_dependencies(
+    NodeOperation *operation)
 {
-  /* Get dependencies from outputs to inputs. */
   Vector<NodeOperation *> dependencies;
-  Vector<NodeOperation *> next_outputs;
-  next_outputs.append(operation);
-  while (next_outputs.size() > 0) {
-    Vector<NodeOperation *> outputs(next_outputs);
-    next_outputs.clear();
-    for (NodeOperation *output : outputs) {
-      for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
-        next_outputs.append(output->get_input_operation(i));
+  Set<NodeOperation *> visited;
+  /* Operations being visited with the index of their next input to visit. */
+  Vector<std::pair<NodeOperation *, int>> stack;
+  stack.append({operation, 0});
+  while (stack.size() > 0) {
+    NodeOperation *op = stack.last().first;
+    const int input_index = stack.last().second;
+    if (input_index < op->get_number_of_input_sockets()) {
+      stack.last().second++;
+      NodeOperation *input_op = op->get_input_operation(input_index);
+      if (!active_buffers_.is_operation_rendered(input_op) && visited.add(input_op)) {
+        stack.append({input_op, 0});
       }
+      continue;
+    }
+    stack.remove_last();
+    if (op != operation) {
+      dependencies.append(op);
     }
-    dependencies.extend(next_outputs);
   }
-
-  /* Reverse to get dependencies from inputs to outputs. */
-  std::reverse(dependencies.begin(), dependencies.end());
-
   return dependencies;
 }
 
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
-  for (NodeOperation *op : dependencies) {
-    if (!active_buffers_.is_operation_rendered(op)) {
-      render_operation(op);
-    }
+  for (NodeOperation *op : get_operation_dependencies(output_op)) {
+    render_operation(op);
   }
 }
 
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <optional>
+
+#include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -42,6 +45,12 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Hashes identifying the result of rendered operations across executions, only filled when the
+   * buffers cache is used.
+   */
+  Map<NodeOperation *, uint64_t> content_hashes_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -56,6 +65,7 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   void render_operations();
   void render_output_dependencies(NodeOperation *output_op);
+  Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation);
   /**
    * Returns input buffers with an offset relative to given output coordinates.
    * Returned memory buffers must be deleted.
@@ -63,6 +73,12 @@ class FullFrameExecutionModel : public ExecutionModel {
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
+  /**
+   * Hash identifying given operation result to look up in the buffers cache. Returns
+   * `std::nullopt` when the operation parameters can't be hashed. All operation inputs must have
+   * already been rendered.
+   */
+  std::optional<uint64_t> get_operation_content_hash(NodeOperation *op);
 
   void operation_finished(NodeOperation *operation);
 
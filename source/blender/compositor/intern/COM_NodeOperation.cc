@@ -84,6 +84,20 @@ std::optional<NodeOperationHash> NodeOperation::generate_hash()
   return hash;
 }
 
+std::optional<uint64_t> NodeOperation::generate_content_hash(Span<uint64_t> inputs_hashes)
+{
+  std::optional<NodeOperationHash> hash = generate_hash();
+  if (!hash) {
+    return std::nullopt;
+  }
+
+  uint64_t content_hash = combine_content_hashes(hash->type_hash_, hash->params_hash_);
+  for (const uint64_t input_hash : inputs_hashes) {
+    content_hash = combine_content_hashes(content_hash, input_hash);
+  }
+  return content_hash;
+}
+
 NodeOperationOutput *NodeOperation::get_output_socket(uint index)
 {
   return &outputs_[index];
@@ -258,6 +258,15 @@ struct NodeOperationFlags {
   }
 };
 
+/**
+ * Combine hashes that identify operation results across executions. Unlike
+ * #BLI_ghashutil_combine_hash it mixes all 64 bits, as a collision reuses a wrong cached buffer.
+ */
+inline uint64_t combine_content_hashes(const uint64_t hash_a, const uint64_t hash_b)
+{
+  return hash_a ^ (hash_b + 0x9e3779b97f4a7c15ull + (hash_a << 12) + (hash_a >> 4));
+}
+
 /** Hash that identifies an operation output result in the current execution. */
 struct NodeOperationHash {
  private:
@@ -390,6 +399,13 @@ class NodeOperation {
    */
   std::optional<NodeOperationHash> generate_hash();
 
+  /**
+   * Generate a hash that identifies the operation result across executions, given the hashes of
+   * the results of its inputs in order.
+   * Requires `hash_output_params` to be implemented, otherwise `std::nullopt` is returned.
+   */
+  std::optional<uint64_t> generate_content_hash(Span<uint64_t> inputs_hashes);
+
   unsigned int get_number_of_input_sockets() const
   {
     return inputs_.size();
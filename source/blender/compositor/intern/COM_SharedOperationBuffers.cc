@@ -1,16 +1,107 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later
  * Copyright 2021 Blender Foundation. */
 
+#include "BLI_fileops.h"
+#include "BLI_string.h"
+
+#include "BKE_appdir.h"
+
 #include "COM_SharedOperationBuffers.h"
 #include "COM_NodeOperation.h"
 
 namespace blender::compositor {
 
+/** Spilled buffers are read back soon, favor speed over compression ratio. */
+constexpr int SPILL_COMPRESSION_LEVEL = 1;
+
+OperationBuffersCache::~OperationBuffersCache()
+{
+  clear();
+}
+
+void OperationBuffersCache::begin_execution(const size_t memory_limit)
+{
+  execution_++;
+  memory_limit_ = memory_limit;
+  free_memory(0);
+}
+
+std::shared_ptr<MemoryBuffer> OperationBuffersCache::lookup(const uint64_t content_hash)
+{
+  CachedBuffer *cached = buffers_.lookup_ptr(content_hash);
+  if (cached == nullptr) {
+    return nullptr;
+  }
+  cached->last_used_execution = execution_;
+  return cached->buffer;
+}
+
+void OperationBuffersCache::add(const uint64_t content_hash, std::shared_ptr<MemoryBuffer> buffer)
+{
+  const size_t size = SharedOperationBuffers::get_memory_size(*buffer);
+  if (buffers_.contains(content_hash) || !free_memory(size)) {
+    return;
+  }
+  CachedBuffer cached;
+  cached.buffer = std::move(buffer);
+  cached.size = size;
+  cached.last_used_execution = execution_;
+  buffers_.add_new(content_hash, std::move(cached));
+  memory_used_ += size;
+}
+
+void OperationBuffersCache::clear()
+{
+  buffers_.clear();
+  memory_used_ = 0;
+}
+
+bool OperationBuffersCache::free_memory(const size_t size)
+{
+  while (memory_used_ + size > memory_limit_) {
+    /* Discard least recently used buffer, keeping the ones used in current execution. */
+    const uint64_t *lru_hash = nullptr;
+    int lru_execution = execution_;
+    for (const auto item : buffers_.items()) {
+      if (item.value.last_used_execution < lru_execution) {
+        lru_hash = &item.key;
+        lru_execution = item.value.last_used_execution;
+      }
+    }
+    if (lru_hash == nullptr) {
+      return false;
+    }
+    const uint64_t lru_key = *lru_hash;
+    memory_used_ -= buffers_.lookup(lru_key).size;
+    buffers_.remove(lru_key);
+  }
+  return true;
+}
+
 SharedOperationBuffers::BufferData::BufferData()
-    : buffer(nullptr), registered_reads(0), received_reads(0), is_rendered(false)
+    : buffer(nullptr),
+      registered_reads(0),
+      received_reads(0),
+      is_rendered(false),
+      memory_size(0),
+      last_used(0)
 {
 }
 
+SharedOperationBuffers::~SharedOperationBuffers()
+{
+  if (spill_file_) {
+    fclose(spill_file_);
+    BLI_delete(spill_filepath_, false, false);
+  }
+}
+
+size_t SharedOperationBuffers::get_memory_size(const MemoryBuffer &buffer)
+{
+  return sizeof(float) * buffer.get_memory_width() * buffer.get_memory_height() *
+         buffer.get_num_channels();
+}
+
 SharedOperationBuffers::BufferData &SharedOperationBuffers::get_buffer_data(NodeOperation *op)
 {
   return buffers_.lookup_or_add_cb(op, []() { return BufferData(); });
@@ -71,12 +162,47 @@ void SharedOperationBuffers::set_rendered_buffer(NodeOperation *op,
   BLI_assert(buf_data.buffer == nullptr);
   buf_data.buffer = std::move(buffer);
   buf_data.is_rendered = true;
+  buf_data.memory_size = buf_data.buffer ? get_memory_size(*buf_data.buffer) : 0;
+  buf_data.last_used = ++use_counter_;
+  memory_used_ += buf_data.memory_size;
 }
 
 MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
 {
   BLI_assert(is_operation_rendered(op));
-  return get_buffer_data(op).buffer.get();
+  BufferData &buf_data = get_buffer_data(op);
+  if (buf_data.spilled) {
+    load_spilled_buffer(buf_data);
+  }
+  buf_data.last_used = ++use_counter_;
+  return buf_data.buffer.get();
+}
+
+bool SharedOperationBuffers::set_cached_buffer(NodeOperation *op, const uint64_t content_hash)
+{
+  BLI_assert(cache_);
+  std::shared_ptr<MemoryBuffer> buffer = cache_->lookup(content_hash);
+  if (!buffer) {
+    return false;
+  }
+  BufferData &buf_data = get_buffer_data(op);
+  BLI_assert(buf_data.received_reads == 0);
+  BLI_assert(buf_data.buffer == nullptr);
+  /* Its memory is accounted by the cache, which keeps it alive anyway. */
+  buf_data.buffer = std::move(buffer);
+  buf_data.is_rendered = true;
+  buf_data.last_used = ++use_counter_;
+  return true;
+}
+
+void SharedOperationBuffers::cache_rendered_buffer(NodeOperation *op, const uint64_t content_hash)
+{
+  BLI_assert(cache_ && is_operation_rendered(op));
+  BufferData &buf_data = get_buffer_data(op);
+  /* Constant buffers are as fast to render again as to look up. */
+  if (buf_data.buffer && !buf_data.buffer->is_a_single_elem()) {
+    cache_->add(content_hash, buf_data.buffer);
+  }
 }
 
 void SharedOperationBuffers::read_finished(NodeOperation *read_op)
@@ -85,9 +211,100 @@ void SharedOperationBuffers::read_finished(NodeOperation *read_op)
   buf_data.received_reads++;
   BLI_assert(buf_data.received_reads > 0 && buf_data.received_reads <= buf_data.registered_reads);
   if (buf_data.received_reads == buf_data.registered_reads) {
-    /* Dispose buffer. */
-    buf_data.buffer = nullptr;
+    dispose_buffer(buf_data);
+  }
+}
+
+void SharedOperationBuffers::prepare_render(NodeOperation *op, const size_t output_size)
+{
+  if (memory_limit_ == 0) {
+    return;
   }
+
+  const int num_inputs = op->get_number_of_input_sockets();
+  for (int i = 0; i < num_inputs; i++) {
+    BufferData &input_data = get_buffer_data(op->get_input_operation(i));
+    if (input_data.spilled) {
+      load_spilled_buffer(input_data);
+    }
+    /* Inputs are the most recently used, so that they are spilled last. */
+    input_data.last_used = use_counter_ + 1;
+  }
+  use_counter_++;
+
+  while (memory_used_ + output_size > memory_limit_) {
+    BufferData *lru_data = nullptr;
+    for (BufferData &buf_data : buffers_.values()) {
+      /* Buffers shared with the cache would stay in memory. */
+      const bool is_spillable = buf_data.memory_size > 0 && buf_data.buffer &&
+                                !buf_data.buffer->is_a_single_elem() &&
+                                buf_data.buffer.use_count() == 1 &&
+                                buf_data.last_used < use_counter_;
+      if (is_spillable && (lru_data == nullptr || buf_data.last_used < lru_data->last_used)) {
+        lru_data = &buf_data;
+      }
+    }
+    if (lru_data == nullptr || !spill_buffer(*lru_data)) {
+      /* Nothing left to spill, the limit is exceeded. */
+      break;
+    }
+  }
+}
+
+bool SharedOperationBuffers::spill_buffer(BufferData &buf_data)
+{
+  if (spill_file_ == nullptr) {
+    char filename[64];
+    BLI_snprintf(filename, sizeof(filename), "compositor_%p.spill", (void *)this);
+    BLI_path_join(spill_filepath_, sizeof(spill_filepath_), BKE_tempdir_session(), filename, NULL);
+    spill_file_ = BLI_fopen(spill_filepath_, "w+b");
+    if (spill_file_ == nullptr) {
+      /* Keep everything in memory, a limit is not a reason to fail compositing. */
+      memory_limit_ = 0;
+      return false;
+    }
+  }
+
+  MemoryBuffer &buffer = *buf_data.buffer;
+  const size_t written = BLI_file_zstd_from_mem_at_pos(buffer.get_buffer(),
+                                                       buf_data.memory_size,
+                                                       spill_file_,
+                                                       spill_file_size_,
+                                                       SPILL_COMPRESSION_LEVEL);
+  if (written == 0) {
+    return false;
+  }
+
+  SpilledBuffer spilled;
+  spilled.data_type = COM_num_channels_data_type(buffer.get_num_channels());
+  spilled.rect = buffer.get_rect();
+  spilled.file_offset = spill_file_size_;
+  spill_file_size_ += written;
+
+  buf_data.spilled = spilled;
+  dispose_buffer(buf_data);
+  return true;
+}
+
+void SharedOperationBuffers::load_spilled_buffer(BufferData &buf_data)
+{
+  BLI_assert(buf_data.spilled && buf_data.buffer == nullptr);
+  const SpilledBuffer &spilled = *buf_data.spilled;
+  buf_data.buffer = std::make_shared<MemoryBuffer>(spilled.data_type, spilled.rect);
+  buf_data.memory_size = get_memory_size(*buf_data.buffer);
+  const size_t read = BLI_file_unzstd_to_mem_at_pos(
+      buf_data.buffer->get_buffer(), buf_data.memory_size, spill_file_, spilled.file_offset);
+  BLI_assert(read == buf_data.memory_size);
+  UNUSED_VARS_NDEBUG(read);
+  buf_data.spilled.reset();
+  memory_used_ += buf_data.memory_size;
+}
+
+void SharedOperationBuffers::dispose_buffer(BufferData &buf_data)
+{
+  buf_data.buffer = nullptr;
+  memory_used_ -= buf_data.memory_size;
+  buf_data.memory_size = 0;
 }
 
 }  // namespace blender::compositor
@@ -3,11 +3,18 @@
 
 #pragma once
 
+#include <cstdio>
+#include <memory>
+#include <optional>
+
 #include "BLI_map.hh"
+#include "BLI_path_util.h"
 #include "BLI_vector.hh"
 
 #include "DNA_vec_types.h"
 
+#include "COM_defines.h"
+
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
 #endif
@@ -17,24 +24,119 @@ namespace blender::compositor {
 class MemoryBuffer;
 class NodeOperation;
 
+/**
+ * Keeps operations rendered buffers between executions, identified by a hash of the content they
+ * were rendered from. Only buffers of operations affected by a change have a different hash, so
+ * all others can be reused without rendering them again. Least recently used buffers are discarded
+ * to stay within the memory limit.
+ */
+class OperationBuffersCache {
+ private:
+  typedef struct CachedBuffer {
+    std::shared_ptr<MemoryBuffer> buffer;
+    size_t size;
+    /** Last execution the buffer was used in. */
+    int last_used_execution;
+  } CachedBuffer;
+  blender::Map<uint64_t, CachedBuffer> buffers_;
+  size_t memory_limit_ = 0;
+  size_t memory_used_ = 0;
+  int execution_ = 0;
+
+ public:
+  ~OperationBuffersCache();
+
+  /**
+   * Starts a new execution, discarding buffers that don't fit in given memory limit (in bytes).
+   */
+  void begin_execution(size_t memory_limit);
+  /**
+   * Get the buffer rendered with given content hash, or nullptr if it isn't cached.
+   */
+  std::shared_ptr<MemoryBuffer> lookup(uint64_t content_hash);
+  /**
+   * Caches given buffer if it fits in the memory limit. Only buffers not used in the current
+   * execution are discarded to make room for it.
+   */
+  void add(uint64_t content_hash, std::shared_ptr<MemoryBuffer> buffer);
+  /**
+   * Discards all cached buffers.
+   */
+  void clear();
+
+ private:
+  bool free_memory(size_t size);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:OperationBuffersCache")
+#endif
+};
+
 /**
  * Stores and shares operations rendered buffers including render data. Buffers are
  * disposed once all dependent operations have finished reading them.
+ *
+ * When a memory limit is set, rendered buffers not used recently are compressed to a temporary
+ * file to make room for the buffers of the operation being rendered, and loaded back once an
+ * operation reads them.
  */
 class SharedOperationBuffers {
  private:
+  /** Location of a buffer moved out of memory into the spill file. */
+  typedef struct SpilledBuffer {
+    DataType data_type;
+    rcti rect;
+    size_t file_offset;
+  } SpilledBuffer;
   typedef struct BufferData {
    public:
     BufferData();
-    std::unique_ptr<MemoryBuffer> buffer;
+    /** Shared with the cache when the buffer is kept for next executions. */
+    std::shared_ptr<MemoryBuffer> buffer;
+    std::optional<SpilledBuffer> spilled;
     blender::Vector<rcti> render_areas;
     int registered_reads;
     int received_reads;
     bool is_rendered;
+    /** Memory in bytes accounted to the buffer while it is in memory. */
+    size_t memory_size;
+    /** Last time the buffer was rendered or read, to spill the least recently used first. */
+    int last_used;
   } BufferData;
   blender::Map<NodeOperation *, BufferData> buffers_;
+  OperationBuffersCache *cache_ = nullptr;
+
+  size_t memory_limit_ = 0;
+  size_t memory_used_ = 0;
+  int use_counter_ = 0;
+  FILE *spill_file_ = nullptr;
+  size_t spill_file_size_ = 0;
+  char spill_filepath_[FILE_MAX] = "";
 
  public:
+  ~SharedOperationBuffers();
+
+  /**
+   * Set the cache to reuse operations buffers from and store them in, for next executions.
+   */
+  void set_cache(OperationBuffersCache *cache)
+  {
+    cache_ = cache;
+  }
+  bool use_cache() const
+  {
+    return cache_ != nullptr;
+  }
+
+  /**
+   * Set memory in bytes rendered buffers can use before they are spilled to a temporary file,
+   * 0 for no limit.
+   */
+  void set_memory_limit(size_t memory_limit)
+  {
+    memory_limit_ = memory_limit;
+  }
+
   /**
    * Whether given operation area to render is already registered.
    */
@@ -71,14 +173,39 @@ class SharedOperationBuffers {
    */
   MemoryBuffer *get_rendered_buffer(NodeOperation *op);
 
+  /**
+   * Use the buffer cached with given content hash as given operation rendered buffer.
+   * \return false if there is no such buffer in the cache.
+   */
+  bool set_cached_buffer(NodeOperation *op, uint64_t content_hash);
+  /**
+   * Keeps given operation rendered buffer in the cache for next executions.
+   */
+  void cache_rendered_buffer(NodeOperation *op, uint64_t content_hash);
+
+  /**
+   * Makes room for rendering given operation within the memory limit: loads back its inputs
+   * buffers if they were spilled and spills the least recently used buffers of other operations
+   * until \a output_size bytes are available for its own buffer.
+   */
+  void prepare_render(NodeOperation *op, size_t output_size);
+
   /**
    * Reports an operation has finished reading given operation. If all given operation dependencies
    * have finished its buffer will be disposed.
    */
   void read_finished(NodeOperation *read_op);
 
+  /**
+   * Memory in bytes used by given buffer pixels.
+   */
+  static size_t get_memory_size(const MemoryBuffer &buffer);
+
  private:
   BufferData &get_buffer_data(NodeOperation *op);
+  bool spill_buffer(BufferData &buf_data);
+  void load_spilled_buffer(BufferData &buf_data);
+  void dispose_buffer(BufferData &buf_data);
 
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:SharedOperationBuffers")
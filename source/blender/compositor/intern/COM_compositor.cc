@@ -8,6 +8,8 @@
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "DNA_userdef_types.h"
+
 #include "COM_ExecutionSystem.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
@@ -15,6 +17,8 @@
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
+  /** Operations buffers kept between executions of the full frame execution model. */
+  blender::compositor::OperationBuffersCache buffers_cache;
 } g_compositor;
 
 /* Make sure node tree has previews.
@@ -75,11 +79,23 @@ void COM_execute(RenderData *render_data,
   const bool use_opencl = (node_tree->flag & NTREE_COM_OPENCL) != 0;
   blender::compositor::WorkScheduler::initialize(use_opencl, BKE_render_num_threads(render_data));
 
+  /* Only the full frame execution model renders whole operations buffers that can be reused. */
+  blender::compositor::OperationBuffersCache *buffers_cache = nullptr;
+  if (U.experimental.use_full_frame_compositor &&
+      node_tree->execution_mode == NTREE_EXECUTION_MODE_FULL_FRAME && node_tree->cache_limit > 0) {
+    buffers_cache = &g_compositor.buffers_cache;
+    buffers_cache->begin_execution(size_t(node_tree->cache_limit) * 1024 * 1024);
+  }
+  else {
+    g_compositor.buffers_cache.clear();
+  }
+
   /* Execute. */
   const bool twopass = (node_tree->flag & NTREE_TWO_PASS) && !rendering;
   if (twopass) {
     blender::compositor::ExecutionSystem fast_pass(
         render_data, scene, node_tree, rendering, true, view_name);
+    fast_pass.get_active_buffers().set_cache(buffers_cache);
     fast_pass.execute();
 
     if (node_tree->test_break(node_tree->tbh)) {
@@ -90,6 +106,7 @@ void COM_execute(RenderData *render_data,
 
   blender::compositor::ExecutionSystem system(
       render_data, scene, node_tree, rendering, false, view_name);
+  system.get_active_buffers().set_cache(buffers_cache);
   system.execute();
 
   BLI_mutex_unlock(&g_compositor.mutex);
@@ -100,6 +117,7 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    g_compositor.buffers_cache.clear();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
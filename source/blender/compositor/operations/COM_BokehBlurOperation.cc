@@ -3,6 +3,7 @@
 
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FastHartleyTransform.h"
 
 #include "COM_OpenCLDevice.h"
 
@@ -13,6 +14,9 @@ constexpr int BOKEH_INPUT_INDEX = 1;
 constexpr int BOUNDING_BOX_INPUT_INDEX = 2;
 constexpr int SIZE_INPUT_INDEX = 3;
 
+/* Blur size in pixels from which the convolution is computed in frequency domain. */
+constexpr int FFT_CONVOLUTION_MIN_SIZE = 12;
+
 BokehBlurOperation::BokehBlurOperation()
 {
   this->add_input_socket(DataType::Color);
@@ -31,6 +35,7 @@ BokehBlurOperation::BokehBlurOperation()
   input_bounding_box_reader_ = nullptr;
 
   extend_bounds_ = false;
+  fft_radius_ = 0;
 }
 
 void BokehBlurOperation::init_data()
@@ -306,10 +311,123 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+bool BokehBlurOperation::use_fft_convolution(const MemoryBuffer *image_input,
+                                             const int pixel_size)
+{
+  /* Lower quality settings skip samples of the direct convolution instead. */
+  return pixel_size >= FFT_CONVOLUTION_MIN_SIZE && get_step() == 1 &&
+         !image_input->is_a_single_elem();
+}
+
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer * /*output*/,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  const float max_dim = MAX2(this->get_width(), this->get_height());
+  const int pixel_size = size_ * max_dim / 100.0f;
+  const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  if (!use_fft_convolution(image_input, pixel_size)) {
+    return;
+  }
+
+  /* Sample the bokeh at the same positions as the direct convolution, whose samples span
+   * [-pixel_size, pixel_size) around every pixel. The convolution kernel is mirrored, so its first
+   * row and column are zero. */
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+  const float m = bokehDimension_ / pixel_size;
+  const int kernel_size = 2 * pixel_size + 1;
+  const int sums_width = kernel_size + 1;
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, kernel_size, 0, kernel_size);
+  MemoryBuffer kernel(DataType::Color, kernel_rect);
+  fft_kernel_sums_.reinitialize(sums_width * sums_width);
+  fft_kernel_sums_.fill(float4(0.0f));
+  for (int y = 0; y < kernel_size; y++) {
+    const float v = bokeh_mid_y_ + (y - pixel_size) * m;
+    for (int x = 0; x < kernel_size; x++) {
+      float4 bokeh(0.0f);
+      if (x > 0 && y > 0) {
+        const float u = bokeh_mid_x_ + (x - pixel_size) * m;
+        bokeh_input->read_elem_checked(u, v, bokeh);
+      }
+      kernel.write_pixel(x, y, bokeh);
+
+      /* The summed area table has an extra zero row and column. */
+      fft_kernel_sums_[(y + 1) * sums_width + x + 1] = bokeh +
+                                                       fft_kernel_sums_[(y + 1) * sums_width + x] +
+                                                       fft_kernel_sums_[y * sums_width + x + 1] -
+                                                       fft_kernel_sums_[y * sums_width + x];
+    }
+  }
+
+  rcti image_area;
+  get_area_of_interest(IMAGE_INPUT_INDEX, area, image_area);
+  if (!BLI_rcti_isect(&image_area, &image_input->get_rect(), &image_area)) {
+    BLI_rcti_init(&image_area, 0, 0, 0, 0);
+  }
+
+  fft_result_ = std::make_unique<MemoryBuffer>(DataType::Color, area);
+  fft_result_->clear();
+  fht_convolve_image(
+      fft_result_.get(), image_input, image_area, &kernel, COM_DATA_TYPE_COLOR_CHANNELS);
+  fft_radius_ = pixel_size;
+}
+
+void BokehBlurOperation::update_memory_buffer_finished(MemoryBuffer * /*output*/,
+                                                       const rcti & /*area*/,
+                                                       Span<MemoryBuffer *> /*inputs*/)
+{
+  fft_result_.reset();
+  fft_kernel_sums_.reinitialize(0);
+}
+
+void BokehBlurOperation::update_memory_buffer_partial_fft(MemoryBuffer *output,
+                                                          const rcti &area,
+                                                          Span<MemoryBuffer *> inputs)
+{
+  const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  MemoryBuffer *bounding_input = inputs[BOUNDING_BOX_INPUT_INDEX];
+  const rcti &image_rect = image_input->get_rect();
+  const int kernel_size = 2 * fft_radius_ + 1;
+  const int sums_width = kernel_size + 1;
+  BuffersIterator<float> it = output->iterate_with({bounding_input}, area);
+  for (; !it.is_end(); ++it) {
+    const int x = it.x;
+    const int y = it.y;
+    const float bounding_box = *it.in(0);
+    if (bounding_box <= 0.0f) {
+      image_input->read_elem(x, y, it.out);
+      continue;
+    }
+
+    /* Pixels outside of the image are not accumulated by the direct convolution, so only
+     * normalize by the sum of the kernel samples that are inside the image. */
+    const int min_x = MAX2(x - image_rect.xmax + 1 + fft_radius_, 0);
+    const int min_y = MAX2(y - image_rect.ymax + 1 + fft_radius_, 0);
+    const int max_x = MAX2(MIN2(x - image_rect.xmin + fft_radius_ + 1, kernel_size), min_x);
+    const int max_y = MAX2(MIN2(y - image_rect.ymin + fft_radius_ + 1, kernel_size), min_y);
+    const float4 multiplier_accum = fft_kernel_sums_[max_y * sums_width + max_x] -
+                                    fft_kernel_sums_[max_y * sums_width + min_x] -
+                                    fft_kernel_sums_[min_y * sums_width + max_x] +
+                                    fft_kernel_sums_[min_y * sums_width + min_x];
+
+    const float *color_accum = fft_result_->get_elem(x, y);
+    it.out[0] = color_accum[0] * (1.0f / multiplier_accum[0]);
+    it.out[1] = color_accum[1] * (1.0f / multiplier_accum[1]);
+    it.out[2] = color_accum[2] * (1.0f / multiplier_accum[2]);
+    it.out[3] = color_accum[3] * (1.0f / multiplier_accum[3]);
+  }
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
 {
+  if (fft_result_) {
+    update_memory_buffer_partial_fft(output, area, inputs);
+    return;
+  }
+
   const float max_dim = MAX2(this->get_width(), this->get_height());
   const int pixel_size = size_ * max_dim / 100.0f;
   const float m = bokehDimension_ / pixel_size;
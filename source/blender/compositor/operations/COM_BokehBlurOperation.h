@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <memory>
+
+#include "BLI_array.hh"
+#include "BLI_math_vec_types.hh"
+
 #include "COM_MultiThreadedOperation.h"
 #include "COM_QualityStepHelper.h"
 
@@ -22,6 +27,15 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   float bokehDimension_;
   bool extend_bounds_;
 
+  /**
+   * Convolution of the area being rendered, when it is computed in frequency domain for big
+   * blur sizes, see #use_fft_convolution.
+   */
+  std::unique_ptr<MemoryBuffer> fft_result_;
+  /** Summed area table of the kernel used by #fft_result_, used to normalize the result. */
+  Array<float4> fft_kernel_sums_;
+  int fft_radius_;
+
  public:
   BokehBlurOperation();
 
@@ -68,9 +82,25 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
+  void update_memory_buffer_finished(MemoryBuffer *output,
+                                     const rcti &area,
+                                     Span<MemoryBuffer *> inputs) override;
+
+ private:
+  /**
+   * Direct convolution cost grows with the square of the blur size, while the cost of the
+   * convolution in frequency domain doesn't, so it is used for big blur sizes.
+   */
+  bool use_fft_convolution(const MemoryBuffer *image_input, int pixel_size);
+  void update_memory_buffer_partial_fft(MemoryBuffer *output,
+                                        const rcti &area,
+                                        Span<MemoryBuffer *> inputs);
 };
 
 }  // namespace blender::compositor
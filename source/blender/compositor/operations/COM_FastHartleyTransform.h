@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2011 Blender Foundation. */
+
+#pragma once
+
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor {
+
+/**
+ * Convolve the first \a channels_num channels of the \a area of the \a image with the same
+ * channels of the \a kernel using the 2D Fast Hartley Transform, whose cost doesn't depend on the
+ * kernel size, unlike direct convolution. The area is split in blocks that are convolved
+ * separately and overlap-added. Pixels outside of the area are considered to be zero, and the
+ * kernel is centered at its (width / 2, height / 2) pixel.
+ *
+ * The result is added to the \a output buffer, clipped to its rectangle. Both the image and the
+ * kernel are expected to be full buffers, not single elements.
+ */
+void fht_convolve_image(MemoryBuffer *output,
+                        const MemoryBuffer *image,
+                        const rcti &area,
+                        const MemoryBuffer *kernel,
+                        int channels_num);
+
+}  // namespace blender::compositor
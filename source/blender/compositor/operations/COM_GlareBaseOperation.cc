@@ -25,6 +25,15 @@ void GlareBaseOperation::deinit_execution()
   SingleThreadedOperation::deinit_execution();
 }
 
+void GlareBaseOperation::hash_output_params()
+{
+  /* The glare type is identified by the operation type. Mix and threshold are applied by other
+   * operations. */
+  hash_params(int(settings_->quality), int(settings_->iter), int(settings_->size));
+  hash_params(int(settings_->star_45), int(settings_->streaks), settings_->colmod);
+  hash_params(settings_->fade, settings_->angle_ofs);
+}
+
 MemoryBuffer *GlareBaseOperation::create_memory_buffer(rcti *rect2)
 {
   MemoryBuffer *tile = (MemoryBuffer *)input_program_->initialize_tile_data(rect2);
@@ -64,6 +64,8 @@ class GlareBaseOperation : public SingleThreadedOperation {
  protected:
   GlareBaseOperation();
 
+  void hash_output_params() override;
+
   virtual void generate_glare(float *data,
                               MemoryBuffer *input_tile,
                               const NodeGlare *settings) = 0;
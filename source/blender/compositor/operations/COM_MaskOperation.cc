@@ -3,6 +3,8 @@
 
 #include "COM_MaskOperation.h"
 
+#include "BLI_array.hh"
+
 #include "BKE_lib_id.h"
 #include "BKE_mask.h"
 
@@ -139,17 +141,29 @@ void MaskOperation::update_memory_buffer_partial(MemoryBuffer *output,
     return;
   }
 
-  float xy[2];
-  for (BuffersIterator<float> it = output->iterate_with({}, area); !it.is_end(); ++it) {
-    xy[0] = it.x * mask_width_inv_ + mask_px_ofs_[0];
-    xy[1] = it.y * mask_height_inv_ + mask_px_ofs_[1];
-    *it.out = 0.0f;
+  const int width = BLI_rcti_size_x(&area);
+  Array<float> row_sum(width);
+  Array<float> row_values(width);
+  for (int y = area.ymin; y < area.ymax; y++) {
+    const float xy_start[2] = {
+        area.xmin * mask_width_inv_ + mask_px_ofs_[0],
+        y * mask_height_inv_ + mask_px_ofs_[1],
+    };
+    row_sum.fill(0.0f);
     for (MaskRasterHandle *handle : handles) {
-      *it.out += BKE_maskrasterize_handle_sample(handle, xy);
+      BKE_maskrasterize_handle_sample_row(
+          handle, xy_start, mask_width_inv_, uint(width), row_values.data());
+      for (const int i : row_sum.index_range()) {
+        row_sum[i] += row_values[i];
+      }
     }
 
-    /* Until we get better falloff. */
-    *it.out /= raster_mask_handle_tot_;
+    float *out = output->get_elem(area.xmin, y);
+    for (const int i : row_sum.index_range()) {
+      /* Until we get better falloff. */
+      *out = row_sum[i] / raster_mask_handle_tot_;
+      out += output->elem_stride;
+    }
   }
 }
 
@@ -5,6 +5,15 @@
 
 namespace blender::compositor {
 
+#ifdef BLI_HAVE_SSE2
+/* Mix operations keep the alpha of the first color. */
+static inline __m128 mix_keep_alpha(const __m128 color, const __m128 color1)
+{
+  const __m128 alpha_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+  return _mm_or_ps(_mm_and_ps(alpha_mask, color1), _mm_andnot_ps(alpha_mask, color));
+}
+#endif
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -113,10 +122,18 @@ void MixBaseOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     const float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(value_m), color1),
+                                     _mm_mul_ps(_mm_set1_ps(value), color2));
+    _mm_storeu_ps(p.out, mix_keep_alpha(result, color1));
+#else
     p.out[0] = value_m * p.color1[0] + value * p.color2[0];
     p.out[1] = value_m * p.color1[1] + value * p.color2[1];
     p.out[2] = value_m * p.color1[2] + value * p.color2[2];
     p.out[3] = p.color1[3];
+#endif
     p.next();
   }
 }
@@ -155,12 +172,19 @@ void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
     if (this->use_value_alpha_multiply()) {
       value *= p.color2[3];
     }
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 result = _mm_add_ps(color1, _mm_mul_ps(_mm_set1_ps(value), color2));
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     p.out[0] = p.color1[0] + value * p.color2[0];
     p.out[1] = p.color1[1] + value * p.color2[1];
     p.out[2] = p.color1[2] + value * p.color2[2];
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
@@ -202,12 +226,20 @@ void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(value_m), color1),
+                                     _mm_mul_ps(_mm_set1_ps(value), color2));
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     p.out[0] = value_m * p.color1[0] + value * p.color2[0];
     p.out[1] = value_m * p.color1[1] + value * p.color2[1];
     p.out[2] = value_m * p.color1[2] + value * p.color2[2];
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
@@ -438,12 +470,20 @@ void MixDarkenOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_min_ps(color1, color2), _mm_set1_ps(value)),
+                                     _mm_mul_ps(color1, _mm_set1_ps(value_m)));
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     p.out[0] = min_ff(p.color1[0], p.color2[0]) * value + p.color1[0] * value_m;
     p.out[1] = min_ff(p.color1[1], p.color2[1]) * value + p.color1[1] * value_m;
     p.out[2] = min_ff(p.color1[2], p.color2[2]) * value + p.color1[2] * value_m;
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
@@ -484,12 +524,22 @@ void MixDifferenceOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     const float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    /* Absolute value by clearing the sign bit. */
+    const __m128 difference = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(color1, color2));
+    const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(value_m), color1),
+                                     _mm_mul_ps(_mm_set1_ps(value), difference));
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     p.out[0] = value_m * p.color1[0] + value * fabsf(p.color1[0] - p.color2[0]);
     p.out[1] = value_m * p.color1[1] + value * fabsf(p.color1[1] - p.color2[1]);
     p.out[2] = value_m * p.color1[2] + value * fabsf(p.color1[2] - p.color2[2]);
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
@@ -901,6 +951,12 @@ void MixLightenOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
 
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 result = _mm_max_ps(_mm_mul_ps(_mm_set1_ps(value), color2), color1);
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     float tmp = value * p.color2[0];
     p.out[0] = MAX2(tmp, p.color1[0]);
 
@@ -913,6 +969,7 @@ void MixLightenOperation::update_memory_buffer_row(PixelCursor &p)
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
@@ -1029,6 +1086,13 @@ void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     const float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 result = _mm_mul_ps(
+        color1, _mm_add_ps(_mm_set1_ps(value_m), _mm_mul_ps(_mm_set1_ps(value), color2)));
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     p.out[0] = p.color1[0] * (value_m + value * p.color2[0]);
     p.out[1] = p.color1[1] * (value_m + value * p.color2[1]);
     p.out[2] = p.color1[2] * (value_m + value * p.color2[2]);
@@ -1036,6 +1100,7 @@ void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
@@ -1224,12 +1289,22 @@ void MixScreenOperation::update_memory_buffer_row(PixelCursor &p)
     }
     const float value_m = 1.0f - value;
 
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 factor = _mm_add_ps(_mm_set1_ps(value_m),
+                                     _mm_mul_ps(_mm_set1_ps(value), _mm_sub_ps(one, color2)));
+    const __m128 result = _mm_sub_ps(one, _mm_mul_ps(factor, _mm_sub_ps(one, color1)));
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     p.out[0] = 1.0f - (value_m + value * (1.0f - p.color2[0])) * (1.0f - p.color1[0]);
     p.out[1] = 1.0f - (value_m + value * (1.0f - p.color2[1])) * (1.0f - p.color1[1]);
     p.out[2] = 1.0f - (value_m + value * (1.0f - p.color2[2])) * (1.0f - p.color1[2]);
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
@@ -1337,12 +1412,19 @@ void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
     if (this->use_value_alpha_multiply()) {
       value *= p.color2[3];
     }
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 result = _mm_sub_ps(color1, _mm_mul_ps(_mm_set1_ps(value), color2));
+    _mm_storeu_ps(p.out, clamp_if_needed(mix_keep_alpha(result, color1)));
+#else
     p.out[0] = p.color1[0] - value * p.color2[0];
     p.out[1] = p.color1[1] - value * p.color2[1];
     p.out[2] = p.color1[2] - value * p.color2[2];
     p.out[3] = p.color1[3];
 
     clamp_if_needed(p.out);
+#endif
     p.next();
   }
 }
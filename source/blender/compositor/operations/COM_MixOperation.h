@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "BLI_simd.h"
+
 #include "COM_MultiThreadedOperation.h"
 
 namespace blender::compositor {
@@ -51,6 +53,17 @@ class MixBaseOperation : public MultiThreadedOperation {
     }
   }
 
+#ifdef BLI_HAVE_SSE2
+  /** Same as above for a whole pixel, NaN values are kept like #clamp_v4 does. */
+  inline __m128 clamp_if_needed(__m128 color)
+  {
+    if (use_clamp_) {
+      return _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_setzero_ps(), color));
+    }
+    return color;
+  }
+#endif
+
  public:
   /**
    * Default constructor
@@ -24,6 +24,10 @@ class QualityStepHelper {
    */
   void init_execution(QualityHelper helper);
 
+  inline eCompositorQuality get_quality() const
+  {
+    return quality_;
+  }
   inline int get_step() const
   {
     return step_;
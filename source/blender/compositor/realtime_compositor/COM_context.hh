@@ -2,13 +2,18 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include "BLI_map.hh"
 #include "BLI_math_vec_types.hh"
 #include "BLI_string_ref.hh"
 
+#include "DNA_ID.h"
 #include "DNA_scene_types.h"
 
 #include "GPU_texture.h"
 
+#include "COM_result_cache.hh"
 #include "COM_static_shader_manager.hh"
 #include "COM_texture_pool.hh"
 
@@ -23,13 +28,19 @@ namespace blender::realtime_compositor {
  * where the output of the evaluator will be written. The class also provides a reference to the
  * texture pool which should be implemented by the caller and provided during construction.
  * Finally, the class have an instance of a static shader manager for convenient shader
- * acquisition. */
+ * acquisition and an instance of a result cache that stores the results reused across
+ * evaluations. */
 class Context {
  private:
   /* A texture pool that can be used to allocate textures for the compositor efficiently. */
   TexturePool &texture_pool_;
   /* A static shader manager that can be used to acquire shaders for the compositor efficiently. */
   StaticShaderManager shader_manager_;
+  /* A result cache that stores the results that are reused across evaluations. */
+  ResultCache result_cache_;
+  /* The number of times each ID was declared updated using the tag_id_update method, identified
+   * by the session UUID of the ID. */
+  Map<uint32_t, uint64_t> id_update_counts_;
 
  public:
   Context(TexturePool &texture_pool);
@@ -62,11 +73,25 @@ class Context {
   /* Get the current time in seconds of the active scene. */
   float get_time() const;
 
+  /* Compute a hash of the state of the context that the results of node operations might depend
+   * on, like the frame number, the size of the output, and the view name. */
+  uint64_t compute_state_hash();
+
+  /* Declare that the given ID was updated. This should be called by the caller of the evaluator
+   * for every updated ID, such that results computed from the data of the ID are not reused. */
+  void tag_id_update(const ID &id);
+
+  /* Get the number of times the given ID was declared updated using the tag_id_update method. */
+  uint64_t get_id_update_count(const ID &id) const;
+
   /* Get a reference to the texture pool of this context. */
   TexturePool &texture_pool();
 
   /* Get a reference to the static shader manager of this context. */
   StaticShaderManager &shader_manager();
+
+  /* Get a reference to the result cache of this context. */
+  ResultCache &result_cache();
 };
 
 }  // namespace blender::realtime_compositor
@@ -34,6 +34,9 @@ class ConversionOperation : public SimpleOperation {
                                               const InputDescriptor &input_descriptor);
 
  protected:
+  /* The result only depends on the types of the input and the result. */
+  uint64_t compute_options_hash() override;
+
   /* Convert the input single value result to the output single value result. */
   virtual void execute_single(const Result &input, Result &output) = 0;
 
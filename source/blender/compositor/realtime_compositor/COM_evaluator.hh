@@ -127,7 +127,8 @@ class Evaluator {
   /* Invalidate the operations stream that was compiled for the node tree. This should be called
    * when the node tree changes or the structure of any of the resources used by it changes. By
    * structure, we mean things like the dimensions of the used images, while changes to their
-   * contents do not necessitate a reset. */
+   * contents do not necessitate a reset. Results that were cached across evaluations are kept
+   * and can be used by the operations of the newly compiled operations stream. */
   void reset();
 
  private:
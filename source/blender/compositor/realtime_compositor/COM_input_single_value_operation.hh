@@ -33,6 +33,9 @@ class InputSingleValueOperation : public Operation {
   /* Allocate a single value result and set its value to the default value of the input socket. */
   void execute() override;
 
+  /* The result only depends on the type and the default value of the input socket. */
+  uint64_t compute_options_hash() override;
+
   /* Get a reference to the output result of the operation, this essentially calls the super
    * get_result with the output identifier of the operation. */
   Result &get_result();
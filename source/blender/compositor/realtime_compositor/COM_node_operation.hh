@@ -42,6 +42,11 @@ class NodeOperation : public Operation {
   void compute_results_reference_counts(const Schedule &schedule);
 
  protected:
+  /* Compute a hash of the options of the node and the state of the context. Nodes whose results
+   * depend on data that is neither stored in the node nor tracked through the update counts of
+   * IDs, like the passes of the render, should override this method to return zero. */
+  uint64_t compute_options_hash() override;
+
   /* Returns a reference to the derived node that this operation represents. */
   const DNode &node() const;
 
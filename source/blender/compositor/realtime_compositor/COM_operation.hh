@@ -51,7 +51,22 @@ using ProcessorsVector = Vector<std::unique_ptr<SimpleOperation>>;
  * The operation is evaluated by calling the evaluate method, which first adds the input processors
  * if they weren't added already and evaluates them, then it resets the results of the operation,
  * then it calls the execute method of the operation, and finally it releases the results mapped to
- * the inputs to declare that they are no longer needed. */
+ * the inputs to declare that they are no longer needed.
+ *
+ * Results are cached across evaluations. Before executing the operation, a hash of its inputs is
+ * computed, which combines the hash of the options of the operation returned by the
+ * compute_options_hash method, like the values of the node it represents, with the content hashes
+ * of the results mapped to the inputs. The content hash of each result of the operation is then
+ * derived from that inputs hash and the identifier of the output. If the result cache of the
+ * context has results with those content hashes, which were computed by an operation with the
+ * same options and inputs, possibly in an earlier evaluation or before the evaluator was reset,
+ * the cached results are used and the operation is not executed. Otherwise, the operation is
+ * executed and its results are allocated as persistent results and added to the result cache. A
+ * zero hash means the options or the inputs are unknown, for instance, when an input is computed
+ * from a render pass, in which case, the operation is always executed. Operations that have no
+ * outputs, like output nodes, are also always executed, and so are operations whose results pass
+ * their inputs through as proxy results, because proxy results are not cached. See the discussion
+ * in COM_result_cache.hh for more information. */
 class Operation {
  private:
   /* A reference to the compositor context. This member references the same object in all
@@ -91,7 +106,8 @@ class Operation {
   /* Evaluate the operation by:
    * 1. Evaluating the input processors.
    * 2. Resetting the results of the operation.
-   * 3. Calling the execute method of the operation.
+   * 3. Calling the execute method of the operation, unless cached results computed from the same
+   *    inputs exist, see the class description for more information.
    * 4. Releasing the results mapped to the inputs. */
   void evaluate();
 
@@ -128,6 +144,13 @@ class Operation {
    * output results. */
   virtual void execute() = 0;
 
+  /* Compute a hash of everything other than the inputs that the results of the operation depend
+   * on, like the type of the operation and the values of its node, or zero if those are unknown,
+   * in which case, the operation is always executed. See the class description for more
+   * information. The default implementation returns zero, so operations need to override this
+   * method for their results to be cached. */
+  virtual uint64_t compute_options_hash();
+
   /* Get a reference to the result connected to the input identified by the given identifier. */
   Result &get_input(StringRef identifier) const;
 
@@ -166,6 +189,21 @@ class Operation {
    * information. */
   void reset_results();
 
+  /* Compute a hash of the options of the operation and the content hashes of the results mapped
+   * to its inputs, or zero if any of them is unknown. See the class description for more
+   * information. */
+  uint64_t compute_inputs_hash();
+
+  /* If the result cache of the context has results for all the needed outputs of the operation
+   * computed from inputs with the given hash, let the results of the operation use them and
+   * return true. Otherwise, return false. */
+  bool use_cached_results(uint64_t inputs_hash);
+
+  /* Set the content hashes of the results of the operation based on the given inputs hash and add
+   * the persistent results to the result cache of the context. This is called after executing the
+   * operation. */
+  void cache_results(uint64_t inputs_hash);
+
   /* Release the results that are mapped to the inputs of the operation. This is called after the
    * evaluation of the operation to declare that the results are no longer needed by this
    * operation. */
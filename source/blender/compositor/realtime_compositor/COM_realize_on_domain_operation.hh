@@ -41,6 +41,9 @@ class RealizeOnDomainOperation : public SimpleOperation {
   /* The operation domain is just the target domain. */
   Domain compute_domain() override;
 
+  /* The result only depends on its type and the size and transformation of the target domain. */
+  uint64_t compute_options_hash() override;
+
  private:
   /* Get the realization shader of the appropriate type. */
   GPUShader *get_realization_shader();
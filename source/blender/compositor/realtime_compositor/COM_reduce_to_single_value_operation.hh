@@ -26,6 +26,10 @@ class ReduceToSingleValueOperation : public SimpleOperation {
    * given result. If it is not needed, return a null pointer. If it is needed, return an instance
    * of the operation. */
   static SimpleOperation *construct_if_needed(Context &context, const Result &input_result);
+
+ protected:
+  /* The result only depends on its type. */
+  uint64_t compute_options_hash() override;
 };
 
 }  // namespace blender::realtime_compositor
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "BLI_float3x3.hh"
 #include "BLI_math_vec_types.hh"
 
@@ -52,7 +54,12 @@ enum class ResultType : uint8_t {
  * the results of identity operations, that is, operations that do nothing to their inputs in
  * certain configurations. In which case, the proxy result is left as is with no extra
  * transformation on its domain whatsoever. Proxy results can be created by calling the
- * pass_through method, see that method for more details. */
+ * pass_through method, see that method for more details.
+ *
+ * A result can be persistent, in which case, its texture is acquired as a persistent texture from
+ * the texture pool and is not released back into the pool when its reference count reaches zero.
+ * This allows the result to be cached and reused in later evaluations without recomputing it, see
+ * the discussion in COM_operation.hh for more information. */
 class Result {
  private:
   /* The base type of the texture or the type of the single value. */
@@ -97,6 +104,13 @@ class Result {
    * calling the pass_through method, which sets this result to be the master of a target result.
    * See that method for more information. */
   Result *master_ = nullptr;
+  /* If true, the texture of the result is a persistent texture that is retained across
+   * evaluations. See the discussion above for more information. */
+  bool is_persistent_ = false;
+  /* A hash that identifies the contents of the result across evaluations, such that two results
+   * with the same non-zero hash are guaranteed to have identical contents. Zero means the contents
+   * are unknown and can't be compared. This is set by the operation that computes the result. */
+  uint64_t content_hash_ = 0;
 
  public:
   /* Construct a result of the given type with the given texture pool that will be used to allocate
@@ -206,6 +220,19 @@ class Result {
    * released instead. */
   void release();
 
+  /* Declare the result to be persistent or not. This should be called before allocating the
+   * result. See the class description for more information. */
+  void set_persistent(bool is_persistent);
+
+  /* Set the value of content_hash_, see that member for more details. */
+  void set_content_hash(uint64_t hash);
+
+  /* Make the result use the texture, domain, and value of the given cached result instead of
+   * computing them. The result becomes persistent, since the texture is owned by the result
+   * cache, and the reference counts of the result are retained. See the discussion in
+   * COM_result_cache.hh for more information. */
+  void use_cached(const Result &cached_result);
+
   /* Returns true if this result should be computed and false otherwise. The result should be
    * computed if its reference count is not zero, that is, its result is used by at least one
    * operation. */
@@ -229,6 +256,20 @@ class Result {
 
   /* Returns a reference to the domain of the result. See the Domain class. */
   const Domain &domain() const;
+
+  /* Returns true if the result is persistent. See the class description for more information. */
+  bool is_persistent() const;
+
+  /* Returns true if the result is a proxy result, that is, it has a master result. */
+  bool is_proxy() const;
+
+  /* Returns the content hash of the result. See the content_hash_ member for more details. */
+  uint64_t content_hash() const;
+
+ private:
+  /* Acquire a texture of an appropriate type with the given size from the result's texture pool,
+   * which is a persistent texture if the result is persistent. */
+  void acquire_texture(int2 size);
 };
 
 }  // namespace blender::realtime_compositor
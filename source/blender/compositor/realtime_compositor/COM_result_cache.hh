@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+#include "BLI_vector.hh"
+
+#include "GPU_texture.h"
+
+#include "COM_result.hh"
+#include "COM_texture_pool.hh"
+
+namespace blender::realtime_compositor {
+
+/* -------------------------------------------------------------------------------------------------
+ * Result Cache
+ *
+ * A result cache is a map of results identified by their content hashes that can be reused across
+ * evaluations of the compositor, even after the evaluator is reset, see the discussion in
+ * COM_operation.hh for more information. The textures of the cached results are persistent
+ * textures acquired from the texture pool and are owned by the cache. Cached results that were
+ * neither looked up nor added during an evaluation are freed by calling the free_unused method at
+ * the end of that evaluation. */
+class ResultCache {
+ private:
+  /* The texture pool that the persistent textures of the cached results were acquired from. */
+  TexturePool &texture_pool_;
+  /* The cached results identified by their content hashes. */
+  Map<uint64_t, Result> results_;
+  /* The content hashes of the results that were looked up or added since the last call to the
+   * free_unused method. */
+  Set<uint64_t> used_results_;
+  /* The textures of cached results that were replaced by newer results with the same content hash
+   * since the last call to the free_unused method. Those are only released in free_unused, since
+   * the replaced results might still be used until the end of the evaluation. */
+  Vector<GPUTexture *> replaced_textures_;
+
+ public:
+  ResultCache(TexturePool &texture_pool);
+
+  /* Get the cached result with the given content hash, or nullptr if no such result exists. */
+  const Result *lookup(uint64_t content_hash);
+
+  /* Add the given result to the cache, identifying it by its content hash, replacing any existing
+   * result with the same content hash. The result is expected to be persistent, such that its
+   * texture is only released by the cache. */
+  void add(const Result &result);
+
+  /* Release the textures of the cached results that were neither looked up nor added since the
+   * last call to this method back into the texture pool and remove them from the cache. The
+   * textures of replaced results are released as well. This should be called at the end of every
+   * evaluation. */
+  void free_unused();
+};
+
+}  // namespace blender::realtime_compositor
@@ -141,6 +141,12 @@ class ShaderOperation : public Operation {
    * given as an input. */
   void compute_results_reference_counts(const Schedule &schedule);
 
+ protected:
+  /* Compute a hash of the options of the nodes in the compile unit, the values of their unlinked
+   * inputs, and how they are linked to each other and to the inputs and outputs of the operation,
+   * which together determine the compiled shader and its uniforms. */
+  uint64_t compute_options_hash() override;
+
  private:
   /* Bind the uniform buffer of the GPU material as well as any color band textures needed by the
    * GPU material.  The compiled shader of the material is given as an argument and assumed to be
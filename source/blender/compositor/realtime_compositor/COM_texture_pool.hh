@@ -44,14 +44,27 @@ bool operator==(const TexturePoolKey &a, const TexturePoolKey &b);
  * every redraw, then the allocation method should use a persistent texture pool to allow
  * cross-evaluation texture pooling, for instance, by using the DRWTexturePool. But if the
  * evaluator is expected to execute infrequently, the allocated textures can just be freed when the
- * evaluator is done, that is, when the pool is destructed. */
+ * evaluator is done, that is, when the pool is destructed.
+ *
+ * Additionally, the texture pool manages persistent textures, which are textures that are owned by
+ * the pool itself and whose contents are retained across evaluations. Those are used by results
+ * that are cached across evaluations, see the discussion in COM_result_cache.hh for more
+ * information.
+ * Persistent textures are freed when free_persistent is called or when the pool is destructed. */
 class TexturePool {
  private:
   /* The set of textures in the pool that are available to acquire for each distinct texture
    * specification. */
   Map<TexturePoolKey, Vector<GPUTexture *>> textures_;
+  /* The set of persistent textures in the pool that are available to acquire for each distinct
+   * texture specification. */
+  Map<TexturePoolKey, Vector<GPUTexture *>> persistent_textures_;
+  /* All persistent textures allocated by the pool, whether they are available or not. */
+  Vector<GPUTexture *> allocated_persistent_textures_;
 
  public:
+  virtual ~TexturePool();
+
   /* Check if there is an available texture with the given specification in the pool, if such
    * texture exists, return it, otherwise, return a newly allocated texture. Expect the texture to
    * be uncleared and possibly contains garbage data. */
@@ -76,6 +89,19 @@ class TexturePool {
    * called after the compositor is done evaluating. */
   void reset();
 
+  /* Same as acquire, but acquires a persistent texture, whose contents are retained across
+   * evaluations until it is released using release_persistent. See the class description for
+   * more information. */
+  GPUTexture *acquire_persistent(int2 size, eGPUTextureFormat format);
+
+  /* Put the persistent texture back into the pool, potentially to be acquired later by another
+   * user. Expects the texture to be one that was acquired using acquire_persistent. */
+  void release_persistent(GPUTexture *texture);
+
+  /* Free all persistent textures allocated by the pool. This is called when the pool is
+   * destructed. */
+  void free_persistent();
+
  private:
   /* Returns a newly allocated texture with the given specification. This method should be
    * implemented by the caller of the compositor evaluator. See the class description for more
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "BLI_function_ref.hh"
 #include "BLI_math_vec_types.hh"
 
@@ -16,6 +18,8 @@ namespace blender::realtime_compositor {
 
 using namespace nodes::derived_node_tree_types;
 
+class Context;
+
 /**
  * Get the origin socket of the given node input. If the input is not linked, the socket itself is
  * returned. If the input is linked, the socket that is linked to it is returned, which could
@@ -56,6 +60,24 @@ bool is_node_supported(DNode node);
 /** Get the input descriptor of the given input socket. */
 InputDescriptor input_descriptor_from_input_socket(const bNodeSocket *socket);
 
+/**
+ * Combine the given hash with the given value into a new hash. Unlike get_default_hash_2, the
+ * value is thoroughly mixed, such that the result can be used to identify contents, see the
+ * discussion in COM_result_cache.hh for more information.
+ */
+uint64_t combine_hashes(uint64_t hash, uint64_t value);
+
+/** Compute a hash of the type and the default value of the given socket. */
+uint64_t compute_socket_value_hash(const bNodeSocket *socket);
+
+/**
+ * Compute a hash of the options of the given node, that is, its type, its custom values, the
+ * values of its storage, and the identity and update count of its ID in the given context.
+ * Pointers in the storage are not followed, so data behind them is expected to be covered by a
+ * change counter in the storage itself, like the changed_timestamp of CurveMapping.
+ */
+uint64_t compute_node_options_hash(Context &context, const bNode &node);
+
 /**
  * Dispatch the given compute shader in a 2D compute space such that the number of threads in both
  * dimensions is as small as possible but at least covers the entirety of threads_range assuming
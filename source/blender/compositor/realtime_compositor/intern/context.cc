@@ -1,12 +1,19 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_hash.hh"
+
+#include "DNA_ID.h"
+
 #include "COM_context.hh"
+#include "COM_result_cache.hh"
 #include "COM_static_shader_manager.hh"
 #include "COM_texture_pool.hh"
+#include "COM_utilities.hh"
 
 namespace blender::realtime_compositor {
 
-Context::Context(TexturePool &texture_pool) : texture_pool_(texture_pool)
+Context::Context(TexturePool &texture_pool)
+    : texture_pool_(texture_pool), result_cache_(texture_pool)
 {
 }
 
@@ -22,6 +29,26 @@ float Context::get_time() const
   return frame_number / frame_rate;
 }
 
+uint64_t Context::compute_state_hash()
+{
+  const Scene *scene = get_scene();
+  uint64_t hash = get_default_hash_2(get_frame_number(), get_output_size());
+  hash = combine_hashes(hash, get_default_hash(get_view_name()));
+  hash = combine_hashes(hash, get_default_hash_2(scene->r.frs_sec, scene->r.frs_sec_base));
+  hash = combine_hashes(hash, get_default_hash_3(scene->r.xsch, scene->r.ysch, scene->r.size));
+  return hash;
+}
+
+void Context::tag_id_update(const ID &id)
+{
+  id_update_counts_.lookup_or_add(id.session_uuid, 0)++;
+}
+
+uint64_t Context::get_id_update_count(const ID &id) const
+{
+  return id_update_counts_.lookup_default(id.session_uuid, 0);
+}
+
 TexturePool &Context::texture_pool()
 {
   return texture_pool_;
@@ -32,4 +59,9 @@ StaticShaderManager &Context::shader_manager()
   return shader_manager_;
 }
 
+ResultCache &Context::result_cache()
+{
+  return result_cache_;
+}
+
 }  // namespace blender::realtime_compositor
@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_hash.hh"
 #include "BLI_math_vec_types.hh"
+#include "BLI_string_ref.hh"
 
 #include "GPU_shader.h"
 
@@ -42,6 +44,13 @@ void ConversionOperation::execute()
   GPU_shader_unbind();
 }
 
+uint64_t ConversionOperation::compute_options_hash()
+{
+  const uint64_t hash = combine_hashes(get_default_hash(StringRef("Conversion")),
+                                       uint64_t(get_input_descriptor().type));
+  return combine_hashes(hash, uint64_t(get_result().type()));
+}
+
 SimpleOperation *ConversionOperation::construct_if_needed(Context &context,
                                                           const Result &input_result,
                                                           const InputDescriptor &input_descriptor)
@@ -13,6 +13,7 @@
 #include "COM_node_operation.hh"
 #include "COM_operation.hh"
 #include "COM_result.hh"
+#include "COM_result_cache.hh"
 #include "COM_scheduler.hh"
 #include "COM_shader_operation.hh"
 #include "COM_utilities.hh"
@@ -33,12 +34,15 @@ void Evaluator::evaluate()
   if (!is_compiled_) {
     compile_and_evaluate();
     is_compiled_ = true;
-    return;
   }
-
-  for (const std::unique_ptr<Operation> &operation : operations_stream_) {
-    operation->evaluate();
+  else {
+    for (const std::unique_ptr<Operation> &operation : operations_stream_) {
+      operation->evaluate();
+    }
   }
+
+  /* Cached results that weren't used in this evaluation are unlikely to be used again. */
+  context_.result_cache().free_unused();
 }
 
 void Evaluator::reset()
@@ -46,6 +46,11 @@ void InputSingleValueOperation::execute()
   }
 }
 
+uint64_t InputSingleValueOperation::compute_options_hash()
+{
+  return compute_socket_value_hash(input_socket_.bsocket());
+}
+
 Result &InputSingleValueOperation::get_result()
 {
   return Operation::get_result(output_identifier_);
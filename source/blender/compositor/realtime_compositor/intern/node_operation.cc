@@ -49,6 +49,12 @@ void NodeOperation::compute_results_reference_counts(const Schedule &schedule)
   }
 }
 
+uint64_t NodeOperation::compute_options_hash()
+{
+  return combine_hashes(compute_node_options_hash(context(), bnode()),
+                        context().compute_state_hash());
+}
+
 const DNode &NodeOperation::node() const
 {
   return node_;
@@ -3,6 +3,7 @@
 #include <limits>
 #include <memory>
 
+#include "BLI_hash.hh"
 #include "BLI_map.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_vector.hh"
@@ -15,9 +16,11 @@
 #include "COM_realize_on_domain_operation.hh"
 #include "COM_reduce_to_single_value_operation.hh"
 #include "COM_result.hh"
+#include "COM_result_cache.hh"
 #include "COM_simple_operation.hh"
 #include "COM_static_shader_manager.hh"
 #include "COM_texture_pool.hh"
+#include "COM_utilities.hh"
 
 namespace blender::realtime_compositor {
 
@@ -33,8 +36,20 @@ void Operation::evaluate()
 
   reset_results();
 
+  const uint64_t inputs_hash = compute_inputs_hash();
+  if (inputs_hash != 0 && use_cached_results(inputs_hash)) {
+    release_inputs();
+    return;
+  }
+
+  for (Result &result : results_.values()) {
+    result.set_persistent(inputs_hash != 0);
+  }
+
   execute();
 
+  cache_results(inputs_hash);
+
   release_inputs();
 }
 
@@ -134,6 +149,11 @@ void Operation::add_and_evaluate_input_processor(StringRef identifier, SimpleOpe
   processor->evaluate();
 }
 
+uint64_t Operation::compute_options_hash()
+{
+  return 0;
+}
+
 Result &Operation::get_input(StringRef identifier) const
 {
   return *results_mapped_to_inputs_.lookup(identifier);
@@ -196,6 +216,74 @@ void Operation::reset_results()
   }
 }
 
+uint64_t Operation::compute_inputs_hash()
+{
+  /* Operations without outputs need to be executed to write their outputs. */
+  if (results_.is_empty()) {
+    return 0;
+  }
+
+  uint64_t hash = compute_options_hash();
+  if (hash == 0) {
+    return 0;
+  }
+
+  for (auto item : results_mapped_to_inputs_.items()) {
+    const uint64_t content_hash = item.value->content_hash();
+    if (content_hash == 0) {
+      return 0;
+    }
+    hash = combine_hashes(hash, get_default_hash(item.key));
+    hash = combine_hashes(hash, content_hash);
+  }
+
+  /* Zero is reserved for unknown inputs. */
+  return hash == 0 ? 1 : hash;
+}
+
+bool Operation::use_cached_results(uint64_t inputs_hash)
+{
+  ResultCache &result_cache = context_.result_cache();
+
+  /* Look up all results first, such that no result is changed if any of them is not cached. */
+  Vector<std::pair<Result *, const Result *>> cached_results;
+  for (auto item : results_.items()) {
+    if (!item.value.should_compute()) {
+      continue;
+    }
+    const uint64_t content_hash = combine_hashes(inputs_hash, get_default_hash(item.key));
+    const Result *cached_result = result_cache.lookup(content_hash);
+    if (!cached_result) {
+      return false;
+    }
+    cached_results.append({&item.value, cached_result});
+  }
+
+  for (const std::pair<Result *, const Result *> &pair : cached_results) {
+    pair.first->use_cached(*pair.second);
+  }
+  return true;
+}
+
+void Operation::cache_results(uint64_t inputs_hash)
+{
+  for (auto item : results_.items()) {
+    Result &result = item.value;
+    if (inputs_hash == 0 || !result.should_compute()) {
+      result.set_content_hash(0);
+      continue;
+    }
+
+    /* Proxy results get a content hash as well, since their domain might differ from that of their
+     * master result. But they share the texture of their master result, which is not owned by the
+     * proxy, so they are not cached. */
+    result.set_content_hash(combine_hashes(inputs_hash, get_default_hash(item.key)));
+    if (result.is_persistent() && result.texture()) {
+      context_.result_cache().add(result);
+    }
+  }
+}
+
 void Operation::release_inputs()
 {
   for (Result *result : results_mapped_to_inputs_.values()) {
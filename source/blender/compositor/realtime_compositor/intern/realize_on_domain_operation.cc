@@ -1,7 +1,9 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "BLI_float3x3.hh"
+#include "BLI_hash.hh"
 #include "BLI_math_vec_types.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_utildefines.h"
 
 #include "GPU_shader.h"
@@ -95,6 +97,19 @@ Domain RealizeOnDomainOperation::compute_domain()
   return domain_;
 }
 
+uint64_t RealizeOnDomainOperation::compute_options_hash()
+{
+  uint64_t hash = combine_hashes(get_default_hash(StringRef("Realize On Domain")),
+                                 uint64_t(get_result().type()));
+  hash = combine_hashes(hash, get_default_hash(domain_.size));
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      hash = combine_hashes(hash, get_default_hash(domain_.transformation.values[i][j]));
+    }
+  }
+  return hash;
+}
+
 SimpleOperation *RealizeOnDomainOperation::construct_if_needed(
     Context &context,
     const Result &input_result,
@@ -1,5 +1,8 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_hash.hh"
+#include "BLI_string_ref.hh"
+
 #include "GPU_state.h"
 #include "GPU_texture.h"
 
@@ -9,6 +12,7 @@
 #include "COM_input_descriptor.hh"
 #include "COM_reduce_to_single_value_operation.hh"
 #include "COM_result.hh"
+#include "COM_utilities.hh"
 
 namespace blender::realtime_compositor {
 
@@ -46,6 +50,12 @@ void ReduceToSingleValueOperation::execute()
   MEM_freeN(pixel);
 }
 
+uint64_t ReduceToSingleValueOperation::compute_options_hash()
+{
+  return combine_hashes(get_default_hash(StringRef("Reduce To Single Value")),
+                        uint64_t(get_result().type()));
+}
+
 SimpleOperation *ReduceToSingleValueOperation::construct_if_needed(Context &context,
                                                                    const Result &input_result)
 {
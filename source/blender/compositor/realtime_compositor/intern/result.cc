@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_assert.h"
 #include "BLI_float3x3.hh"
 #include "BLI_math_vec_types.hh"
 
@@ -21,17 +22,7 @@ Result::Result(ResultType type, TexturePool &texture_pool)
 void Result::allocate_texture(Domain domain)
 {
   is_single_value_ = false;
-  switch (type_) {
-    case ResultType::Float:
-      texture_ = texture_pool_->acquire_float(domain.size);
-      break;
-    case ResultType::Vector:
-      texture_ = texture_pool_->acquire_vector(domain.size);
-      break;
-    case ResultType::Color:
-      texture_ = texture_pool_->acquire_color(domain.size);
-      break;
-  }
+  acquire_texture(domain.size);
   domain_ = domain;
 }
 
@@ -39,18 +30,7 @@ void Result::allocate_single_value()
 {
   is_single_value_ = true;
   /* Single values are stored in 1x1 textures as well as the single value members. */
-  const int2 texture_size{1, 1};
-  switch (type_) {
-    case ResultType::Float:
-      texture_ = texture_pool_->acquire_float(texture_size);
-      break;
-    case ResultType::Vector:
-      texture_ = texture_pool_->acquire_vector(texture_size);
-      break;
-    case ResultType::Color:
-      texture_ = texture_pool_->acquire_color(texture_size);
-      break;
-  }
+  acquire_texture(int2(1));
   domain_ = Domain::identity();
 }
 
@@ -107,6 +87,9 @@ void Result::pass_through(Result &target)
   target = *this;
   target.initial_reference_count_ = initial_reference_count;
 
+  /* The texture is owned by this result, so the target should never retain it on its own. */
+  target.is_persistent_ = false;
+
   target.master_ = this;
 }
 
@@ -208,13 +191,49 @@ void Result::release()
   }
 
   /* Decrement the reference count, and if it reaches zero, release the texture back into the
-   * texture pool. */
+   * texture pool. Persistent textures are retained to be reused in later evaluations. */
   reference_count_--;
-  if (reference_count_ == 0) {
+  if (reference_count_ == 0 && !is_persistent_) {
     texture_pool_->release(texture_);
   }
 }
 
+void Result::set_persistent(bool is_persistent)
+{
+  is_persistent_ = is_persistent;
+}
+
+void Result::set_content_hash(uint64_t hash)
+{
+  content_hash_ = hash;
+}
+
+void Result::use_cached(const Result &cached_result)
+{
+  BLI_assert(cached_result.type_ == type_);
+  BLI_assert(cached_result.is_persistent_);
+
+  is_single_value_ = cached_result.is_single_value_;
+  texture_ = cached_result.texture_;
+  domain_ = cached_result.domain_;
+  is_persistent_ = true;
+  content_hash_ = cached_result.content_hash_;
+
+  if (is_single_value_) {
+    switch (type_) {
+      case ResultType::Float:
+        float_value_ = cached_result.float_value_;
+        break;
+      case ResultType::Vector:
+        vector_value_ = cached_result.vector_value_;
+        break;
+      case ResultType::Color:
+        color_value_ = cached_result.color_value_;
+        break;
+    }
+  }
+}
+
 bool Result::should_compute()
 {
   return initial_reference_count_ != 0;
@@ -254,4 +273,41 @@ const Domain &Result::domain() const
   return domain_;
 }
 
+bool Result::is_persistent() const
+{
+  return is_persistent_;
+}
+
+bool Result::is_proxy() const
+{
+  return master_ != nullptr;
+}
+
+uint64_t Result::content_hash() const
+{
+  return content_hash_;
+}
+
+void Result::acquire_texture(int2 size)
+{
+  if (is_persistent_) {
+    /* Vectors are stored in RGBA textures, similar to TexturePool::acquire_vector. */
+    const eGPUTextureFormat format = type_ == ResultType::Float ? GPU_R16F : GPU_RGBA16F;
+    texture_ = texture_pool_->acquire_persistent(size, format);
+    return;
+  }
+
+  switch (type_) {
+    case ResultType::Float:
+      texture_ = texture_pool_->acquire_float(size);
+      break;
+    case ResultType::Vector:
+      texture_ = texture_pool_->acquire_vector(size);
+      break;
+    case ResultType::Color:
+      texture_ = texture_pool_->acquire_color(size);
+      break;
+  }
+}
+
 }  // namespace blender::realtime_compositor
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_assert.h"
+
+#include "GPU_texture.h"
+
+#include "COM_result.hh"
+#include "COM_result_cache.hh"
+#include "COM_texture_pool.hh"
+
+namespace blender::realtime_compositor {
+
+ResultCache::ResultCache(TexturePool &texture_pool) : texture_pool_(texture_pool)
+{
+}
+
+const Result *ResultCache::lookup(uint64_t content_hash)
+{
+  const Result *result = results_.lookup_ptr(content_hash);
+  if (result) {
+    used_results_.add(content_hash);
+  }
+  return result;
+}
+
+void ResultCache::add(const Result &result)
+{
+  BLI_assert(result.is_persistent());
+  BLI_assert(result.content_hash() != 0);
+
+  /* An older result with the same content hash is replaced when an operation computes results
+   * that were only partially cached, in which case, the older result might still be used in this
+   * evaluation, so its texture is only released in free_unused. */
+  const Result *old_result = results_.lookup_ptr(result.content_hash());
+  if (old_result && old_result->texture() != result.texture()) {
+    replaced_textures_.append(old_result->texture());
+  }
+
+  results_.add_overwrite(result.content_hash(), result);
+  used_results_.add(result.content_hash());
+}
+
+void ResultCache::free_unused()
+{
+  results_.remove_if([&](const Map<uint64_t, Result>::MutableItem item) {
+    if (used_results_.contains(item.key)) {
+      return false;
+    }
+    texture_pool_.release_persistent(item.value.texture());
+    return true;
+  });
+
+  used_results_.clear();
+
+  for (GPUTexture *texture : replaced_textures_) {
+    texture_pool_.release_persistent(texture);
+  }
+  replaced_textures_.clear();
+}
+
+}  // namespace blender::realtime_compositor
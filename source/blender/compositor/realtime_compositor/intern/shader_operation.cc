@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 
+#include "BLI_hash.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_string_ref.hh"
@@ -78,6 +79,55 @@ Map<std::string, DOutputSocket> &ShaderOperation::get_inputs_to_linked_outputs_m
   return inputs_to_linked_outputs_map_;
 }
 
+uint64_t ShaderOperation::compute_options_hash()
+{
+  uint64_t hash = context().compute_state_hash();
+  for (const DNode &node : compile_unit_) {
+    hash = combine_hashes(hash, compute_node_options_hash(context(), *node));
+
+    for (const bNodeSocket *input : node->input_sockets()) {
+      const DInputSocket dinput{node.context(), input};
+
+      /* The input is unlinked or linked to an unlinked input of a group input node, so hash the
+       * value that the shader node uses, see ShaderNode for more information. */
+      const DSocket origin = get_input_origin_socket(dinput);
+      if (origin->is_input()) {
+        hash = combine_hashes(hash, compute_socket_value_hash(origin.bsocket()));
+        continue;
+      }
+
+      /* The input is linked to a node that is part of the shader operation, so hash the position
+       * of that node in the compile unit and the index of the output it is linked to. */
+      const DOutputSocket doutput(origin);
+      if (compile_unit_.contains(doutput.node())) {
+        hash = combine_hashes(hash, compile_unit_.index_of(doutput.node()));
+        hash = combine_hashes(hash, doutput->index());
+        continue;
+      }
+
+      /* Otherwise, the input is linked to an input of the operation, so hash its identifier. */
+      for (const auto item : inputs_to_linked_outputs_map_.items()) {
+        if (item.value == doutput) {
+          hash = combine_hashes(hash, get_default_hash(item.key));
+          break;
+        }
+      }
+    }
+
+    for (const bNodeSocket *output : node->output_sockets()) {
+      const DOutputSocket doutput{node.context(), output};
+      const std::string *identifier = output_sockets_to_output_identifiers_map_.lookup_ptr(
+          doutput);
+      if (identifier) {
+        hash = combine_hashes(hash, output->index());
+        hash = combine_hashes(hash, get_default_hash(*identifier));
+      }
+    }
+  }
+
+  return hash;
+}
+
 void ShaderOperation::compute_results_reference_counts(const Schedule &schedule)
 {
   for (const auto &item : output_sockets_to_output_identifiers_map_.items()) {
@@ -43,6 +43,11 @@ bool operator==(const TexturePoolKey &a, const TexturePoolKey &b)
 /** \name Texture Pool
  * \{ */
 
+TexturePool::~TexturePool()
+{
+  free_persistent();
+}
+
 GPUTexture *TexturePool::acquire(int2 size, eGPUTextureFormat format)
 {
   /* Check if there is an available texture with the required specification, and if one exists,
@@ -83,6 +88,37 @@ void TexturePool::reset()
   textures_.clear();
 }
 
+GPUTexture *TexturePool::acquire_persistent(int2 size, eGPUTextureFormat format)
+{
+  const TexturePoolKey key = TexturePoolKey(size, format);
+  Vector<GPUTexture *> &available_textures = persistent_textures_.lookup_or_add_default(key);
+  if (!available_textures.is_empty()) {
+    return available_textures.pop_last();
+  }
+
+  /* Persistent textures are owned by the pool, so they are allocated directly as opposed to using
+   * the allocate_texture method, whose textures might be recycled by the caller after the
+   * evaluation. */
+  GPUTexture *texture = GPU_texture_create_2d(
+      "Compositor Persistent Result", size.x, size.y, 1, format, nullptr);
+  allocated_persistent_textures_.append(texture);
+  return texture;
+}
+
+void TexturePool::release_persistent(GPUTexture *texture)
+{
+  persistent_textures_.lookup(TexturePoolKey(texture)).append(texture);
+}
+
+void TexturePool::free_persistent()
+{
+  for (GPUTexture *texture : allocated_persistent_textures_) {
+    GPU_texture_free(texture);
+  }
+  allocated_persistent_textures_.clear();
+  persistent_textures_.clear();
+}
+
 /** \} */
 
 }  // namespace blender::realtime_compositor
@@ -1,12 +1,24 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
 #include "BLI_assert.h"
 #include "BLI_function_ref.hh"
+#include "BLI_hash.hh"
 #include "BLI_math_vec_types.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_utildefines.h"
 
+#include "DNA_ID.h"
+#include "DNA_genfile.h"
 #include "DNA_node_types.h"
+#include "DNA_sdna_types.h"
+
+#include "BKE_node.h"
 
 #include "NOD_derived_node_tree.hh"
 #include "NOD_node_declaration.hh"
@@ -14,6 +26,7 @@
 #include "GPU_compute.h"
 #include "GPU_shader.h"
 
+#include "COM_context.hh"
 #include "COM_operation.hh"
 #include "COM_result.hh"
 #include "COM_utilities.hh"
@@ -121,6 +134,111 @@ InputDescriptor input_descriptor_from_input_socket(const bNodeSocket *socket)
   return input_descriptor;
 }
 
+/* The finalizer of the SplitMix64 generator, which maps similar values, like consecutive integers,
+ * to very different values. */
+static uint64_t mix_hash(uint64_t value)
+{
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return value ^ (value >> 31);
+}
+
+uint64_t combine_hashes(uint64_t hash, uint64_t value)
+{
+  return mix_hash(hash ^ mix_hash(value + 0x9e3779b97f4a7c15));
+}
+
+static uint64_t combine_hashes_with_memory(uint64_t hash, const void *data, int64_t size)
+{
+  const char *bytes = static_cast<const char *>(data);
+  for (int64_t i = 0; i < size; i += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    memcpy(&word, bytes + i, std::min(int64_t(sizeof(uint64_t)), size - i));
+    hash = combine_hashes(hash, word);
+  }
+  return hash;
+}
+
+uint64_t compute_socket_value_hash(const bNodeSocket *socket)
+{
+  const uint64_t hash = combine_hashes(0, socket->type);
+  switch (socket->type) {
+    case SOCK_FLOAT:
+      return combine_hashes_with_memory(
+          hash, &socket->default_value_typed<bNodeSocketValueFloat>()->value, sizeof(float));
+    case SOCK_VECTOR:
+      return combine_hashes_with_memory(
+          hash, socket->default_value_typed<bNodeSocketValueVector>()->value, sizeof(float[3]));
+    case SOCK_RGBA:
+      return combine_hashes_with_memory(
+          hash, socket->default_value_typed<bNodeSocketValueRGBA>()->value, sizeof(float[4]));
+    default:
+      BLI_assert_unreachable();
+      return hash;
+  }
+}
+
+/* Combine the given hash with the values of the members of the DNA struct with the given index
+ * stored in the given data, recursing into nested structs and skipping pointers, whose values
+ * change whenever the data is copied. */
+static uint64_t combine_hashes_with_dna_struct(uint64_t hash,
+                                               const SDNA *sdna,
+                                               const int struct_index,
+                                               const char *data)
+{
+  const SDNA_Struct *struct_info = sdna->structs[struct_index];
+  for (int i = 0; i < struct_info->members_len; i++) {
+    const SDNA_StructMember &member = struct_info->members[i];
+    const char *member_name = sdna->names[member.name];
+    const int member_size = DNA_elem_size_nr(sdna, member.type, member.name);
+
+    const bool is_pointer = member_name[0] == '*' ||
+                            (member_name[0] == '(' && member_name[1] == '*');
+    if (!is_pointer) {
+      const int member_struct_index = DNA_struct_find_nr(sdna, sdna->types[member.type]);
+      if (member_struct_index == -1) {
+        hash = combine_hashes_with_memory(hash, data, member_size);
+      }
+      else {
+        const int struct_size = sdna->types_size[member.type];
+        for (int j = 0; j < sdna->names_array_len[member.name]; j++) {
+          hash = combine_hashes_with_dna_struct(
+              hash, sdna, member_struct_index, data + j * struct_size);
+        }
+      }
+    }
+
+    data += member_size;
+  }
+  return hash;
+}
+
+uint64_t compute_node_options_hash(Context &context, const bNode &node)
+{
+  uint64_t hash = get_default_hash(StringRef(node.idname));
+  hash = combine_hashes(hash, get_default_hash_2(node.custom1, node.custom2));
+  hash = combine_hashes(hash, get_default_hash_2(node.custom3, node.custom4));
+
+  if (node.storage) {
+    const SDNA *sdna = DNA_sdna_current_get();
+    const int struct_index = DNA_struct_find_nr(sdna, node.typeinfo->storagename);
+    if (struct_index != -1) {
+      hash = combine_hashes_with_dna_struct(
+          hash, sdna, struct_index, static_cast<const char *>(node.storage));
+    }
+    else {
+      hash = combine_hashes_with_memory(hash, node.storage, MEM_allocN_len(node.storage));
+    }
+  }
+
+  if (node.id) {
+    hash = combine_hashes(hash, node.id->session_uuid);
+    hash = combine_hashes(hash, context.get_id_update_count(*node.id));
+  }
+
+  return hash;
+}
+
 void compute_dispatch_threads_at_least(GPUShader *shader, int2 threads_range, int2 local_size)
 {
   /* If the threads range is divisible by the local size, dispatch the number of needed groups,
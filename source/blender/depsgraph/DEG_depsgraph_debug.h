@@ -52,6 +52,27 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Profile
+ *
+ * With #G_DEBUG_DEPSGRAPH_PROFILE every evaluated operation of every dependency graph is recorded
+ * with its start and end time and the thread it ran on. */
+
+/** Set file the profile is written to when the dependency graph module is freed on exit. */
+void DEG_debug_eval_profile_filepath_set(const char *filepath);
+
+/**
+ * Write the recorded profile using the Chrome trace event JSON format.
+ * The number of recorded events is limited, \a clear discards them after writing so that
+ * recording can continue.
+ *
+ * \return False when the file could not be written.
+ */
+bool DEG_debug_eval_profile_write(const char *filepath, bool clear);
+
+/** Discard all recorded events. */
+void DEG_debug_eval_profile_clear(void);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
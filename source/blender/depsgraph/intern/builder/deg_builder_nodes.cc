@@ -1173,7 +1173,7 @@ void DepsgraphNodeBuilder::build_driver(ID *id, FCurve *fcurve, int driver_index
    * has not yet been allocated at this point we can't. As a workaround
    * the animation systems allocates an array so we can do a fast lookup
    * with the driver index. */
-  ensure_operation_node(
+  OperationNode *driver_node = ensure_operation_node(
       id,
       NodeType::PARAMETERS,
       OperationCode::DRIVER,
@@ -1182,6 +1182,11 @@ void DepsgraphNodeBuilder::build_driver(ID *id, FCurve *fcurve, int driver_index
       },
       fcurve->rna_path ? fcurve->rna_path : "",
       fcurve->array_index);
+  /* Expressions outside of the simple subset are evaluated by Python, see #evaluate_driver. */
+  ChannelDriver *driver = fcurve->driver;
+  if (driver->type == DRIVER_TYPE_PYTHON && !BKE_driver_has_simple_expression(driver)) {
+    driver_node->flag |= DEPSOP_FLAG_USES_PYTHON;
+  }
   build_driver_variables(id, fcurve);
 }
 
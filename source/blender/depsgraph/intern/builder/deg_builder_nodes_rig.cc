@@ -199,12 +199,23 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
                        BKE_pose_eval_cleanup(depsgraph, scene_cow, object_cow);
                      });
 
-  op_node = add_operation_node(
-      &object->id,
-      NodeType::EVAL_POSE,
-      OperationCode::POSE_DONE,
-      [object_cow](::Depsgraph *depsgraph) { BKE_pose_eval_done(depsgraph, object_cow); });
+  op_node = add_operation_node(&object->id,
+                               NodeType::EVAL_POSE,
+                               OperationCode::POSE_DONE,
+                               [scene_cow, object_cow](::Depsgraph *depsgraph) {
+                                 BKE_pose_eval_done(depsgraph, scene_cow, object_cow);
+                               });
   op_node->set_as_exit();
+  /* Stored poses are freed on user edits, which is what the point cache component is tagged
+   * for, while frame changes leave them alone. */
+  if (object->pose->flag & POSE_USE_CACHE) {
+    add_operation_node(&object->id,
+                       NodeType::POINT_CACHE,
+                       OperationCode::POSE_CACHE_RESET,
+                       [object_cow](::Depsgraph *depsgraph) {
+                         BKE_pose_eval_cache_reset(depsgraph, object_cow);
+                       });
+  }
   /* Bones. */
   int pchan_index = 0;
   LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
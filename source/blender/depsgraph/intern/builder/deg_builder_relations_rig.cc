@@ -304,6 +304,17 @@ void DepsgraphRelationBuilder::build_rig(Object *object)
   add_relation(armature_key, pose_init_key, "Data dependency");
   /* Run cleanup even when there are no bones. */
   add_relation(pose_init_key, pose_cleanup_key, "Init -> Cleanup");
+  /* Edits of the animation or the armature reach the pose init, and have to free the stored
+   * poses before they are looked up. */
+  if (object->pose->flag & POSE_USE_CACHE) {
+    OperationKey pose_cache_key(
+        &object->id, NodeType::POINT_CACHE, OperationCode::POSE_CACHE_RESET);
+    add_relation(pose_init_key,
+                 pose_cache_key,
+                 "Pose Init -> Pose Cache Reset",
+                 RELATION_FLAG_FLUSH_USER_EDIT_ONLY);
+    add_relation(pose_cache_key, pose_init_ik_key, "Pose Cache Reset -> Pose Init IK");
+  }
   /* IK Solvers.
    *
    * - These require separate processing steps are pose-level to be executed
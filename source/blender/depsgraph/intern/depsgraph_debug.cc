@@ -22,6 +22,7 @@
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval_stats.h"
 #include "intern/node/deg_node_component.h"
 #include "intern/node/deg_node_id.h"
 #include "intern/node/deg_node_time.h"
@@ -52,6 +53,21 @@ const char *DEG_debug_name_get(struct Depsgraph *depsgraph)
   return deg_graph->debug.name.c_str();
 }
 
+void DEG_debug_eval_profile_filepath_set(const char *filepath)
+{
+  deg::deg_eval_profile_filepath_set(filepath);
+}
+
+bool DEG_debug_eval_profile_write(const char *filepath, const bool clear)
+{
+  return deg::deg_eval_profile_write(filepath, clear);
+}
+
+void DEG_debug_eval_profile_clear()
+{
+  deg::deg_eval_profile_clear();
+}
+
 bool DEG_debug_compare(const struct Depsgraph *graph1, const struct Depsgraph *graph2)
 {
   BLI_assert(graph1 != nullptr);
@@ -16,6 +16,7 @@
 #include "DEG_depsgraph.h"
 
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval_stats.h"
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
 #include "intern/node/deg_node_factory.h"
@@ -33,6 +34,7 @@ void DEG_register_node_types()
 
 void DEG_free_node_types()
 {
+  deg::deg_eval_profile_exit();
 }
 
 deg::DEGCustomDataMeshMasks::DEGCustomDataMeshMasks(const CustomData_MeshMasks *other)
@@ -13,8 +13,11 @@
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
+#include "BLI_heap.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.h"
 
@@ -51,6 +54,9 @@ namespace {
 struct DepsgraphEvalState;
 
 void deg_task_run_func(TaskPool *pool, void *taskdata);
+void deg_task_run_priority_func(TaskPool *pool, void *taskdata);
+void deg_task_run_python_lane_func(TaskPool *pool, void *taskdata);
+bool schedule_node_to_python_lane(OperationNode *node, TaskPool *pool);
 
 template<typename ScheduleFunction, typename... ScheduleFunctionArgs>
 void schedule_children(DepsgraphEvalState *state,
@@ -60,6 +66,9 @@ void schedule_children(DepsgraphEvalState *state,
 
 void schedule_node_to_pool(OperationNode *node, const int /*thread_id*/, TaskPool *pool)
 {
+  if (schedule_node_to_python_lane(node, pool)) {
+    return;
+  }
   BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
 }
 
@@ -89,8 +98,62 @@ struct DepsgraphEvalState {
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+
+  /* Schedule ready operations by their critical path time rather than in the order they became
+   * ready, see #G_DEBUG_DEPSGRAPH_PRIORITY. Tasks pushed to the pool do not carry an operation,
+   * instead every task evaluates the most expensive ready operation from the heap. */
+  bool use_priority = false;
+  SpinLock priority_lock;
+  Heap *priority_heap = nullptr;
+
+  /* Recorder of the operation timings, only used with #G_DEBUG_DEPSGRAPH_PROFILE. */
+  EvalProfileRecorder *profile = nullptr;
+
+  /* Operations which call into Python are all evaluated by a single task at a time, so that
+   * only one thread waits for the GIL and all other threads keep evaluating the rest of the
+   * graph. The task is running while #python_lane_active is set, and evaluates operations from
+   * #python_lane_queue until it is empty. */
+  SpinLock python_lane_lock;
+  Vector<OperationNode *> python_lane_queue;
+  bool python_lane_active = false;
 };
 
+void schedule_node_to_priority_queue(OperationNode *node, const int /*thread_id*/, TaskPool *pool)
+{
+  if (schedule_node_to_python_lane(node, pool)) {
+    return;
+  }
+
+  DepsgraphEvalState *state = (DepsgraphEvalState *)BLI_task_pool_user_data(pool);
+  /* The heap is a min-heap, so negate the time to get the longest critical path first. */
+  BLI_spin_lock(&state->priority_lock);
+  BLI_heap_insert(state->priority_heap, -node->critical_path_time, node);
+  BLI_spin_unlock(&state->priority_lock);
+
+  BLI_task_pool_push(pool, deg_task_run_priority_func, nullptr, false, nullptr);
+}
+
+/* Add the operation to the Python lane if it uses Python, starting the lane task when it is not
+ * running already. Returns false when the operation is to be scheduled as usual. */
+bool schedule_node_to_python_lane(OperationNode *node, TaskPool *pool)
+{
+  if ((node->flag & DEPSOP_FLAG_USES_PYTHON) == 0) {
+    return false;
+  }
+  DepsgraphEvalState *state = (DepsgraphEvalState *)BLI_task_pool_user_data(pool);
+
+  BLI_spin_lock(&state->python_lane_lock);
+  state->python_lane_queue.append(node);
+  const bool start_lane = !state->python_lane_active;
+  state->python_lane_active = true;
+  BLI_spin_unlock(&state->python_lane_lock);
+
+  if (start_lane) {
+    BLI_task_pool_push(pool, deg_task_run_python_lane_func, nullptr, false, nullptr);
+  }
+  return true;
+}
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
@@ -98,10 +161,18 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_stats || state->use_priority || state->profile != nullptr) {
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    const double end_time = PIL_check_seconds_timer();
+    const double duration = end_time - start_time;
+    if (state->do_stats) {
+      operation_node->stats.current_time += duration;
+    }
+    if (state->profile != nullptr) {
+      state->profile->record(operation_node, start_time, end_time);
+    }
+    operation_node->eval_time = float(duration);
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -128,6 +199,49 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   schedule_children(state, operation_node, schedule_node_to_pool, pool);
 }
 
+void deg_task_run_priority_func(TaskPool *pool, void * /*taskdata*/)
+{
+  void *userdata_v = BLI_task_pool_user_data(pool);
+  DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
+
+  /* Every task is pushed together with an operation inserted into the heap, so the heap can not
+   * be empty here. The operation taken does not need to be the one pushed with this task. */
+  BLI_spin_lock(&state->priority_lock);
+  OperationNode *operation_node = (OperationNode *)BLI_heap_pop_min(state->priority_heap);
+  BLI_spin_unlock(&state->priority_lock);
+
+  evaluate_node(state, operation_node);
+
+  schedule_children(state, operation_node, schedule_node_to_priority_queue, pool);
+}
+
+void deg_task_run_python_lane_func(TaskPool *pool, void * /*taskdata*/)
+{
+  void *userdata_v = BLI_task_pool_user_data(pool);
+  DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
+
+  while (true) {
+    BLI_spin_lock(&state->python_lane_lock);
+    if (state->python_lane_queue.is_empty()) {
+      state->python_lane_active = false;
+      BLI_spin_unlock(&state->python_lane_lock);
+      break;
+    }
+    OperationNode *operation_node = state->python_lane_queue.pop_last();
+    BLI_spin_unlock(&state->python_lane_lock);
+
+    evaluate_node(state, operation_node);
+
+    /* Children which use Python are added to the queue of this lane. */
+    if (state->use_priority) {
+      schedule_children(state, operation_node, schedule_node_to_priority_queue, pool);
+    }
+    else {
+      schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    }
+  }
+}
+
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
 {
   const ComponentNode *comp_node = op_node->owner;
@@ -191,6 +305,55 @@ void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
   state->need_update_pending_parents = false;
 }
 
+/* Calculate the critical path time of all operations which are to be evaluated: the evaluation
+ * time of the operation itself plus the most expensive chain of operations depending on it.
+ *
+ * Relies on the timing of the previous evaluations: operations which were never evaluated with
+ * the priority scheduling are considered to be free. */
+void calculate_critical_path_times(DepsgraphEvalState *state)
+{
+  for (OperationNode *node : state->graph->operations) {
+    node->critical_path_time = -1.0f;
+  }
+
+  /* Post-order traversal of the graph. Deep chains are common in rigs, so use an explicit stack
+   * rather than recursion. While a node is on the stack its critical path time accumulates the
+   * maximum of its children. */
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : state->graph->operations) {
+    if (root->critical_path_time >= 0.0f || (root->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0) {
+      continue;
+    }
+    root->critical_path_time = 0.0f;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      OperationNode *node = stack.last().first;
+      const int64_t link_index = stack.last().second++;
+      if (link_index == node->outlinks.size()) {
+        node->critical_path_time += node->eval_time;
+        stack.remove_last();
+        if (!stack.is_empty()) {
+          OperationNode *parent = stack.last().first;
+          parent->critical_path_time = std::max(parent->critical_path_time,
+                                                node->critical_path_time);
+        }
+        continue;
+      }
+      const Relation *rel = node->outlinks[link_index];
+      OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) || (child->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0) {
+        continue;
+      }
+      if (child->critical_path_time >= 0.0f) {
+        node->critical_path_time = std::max(node->critical_path_time, child->critical_path_time);
+        continue;
+      }
+      child->critical_path_time = 0.0f;
+      stack.append({child, 0});
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   /* Clear tags and other things which needs to be clear. */
@@ -335,7 +498,15 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, schedule_node_to_pool, task_pool);
+  if (state->use_priority) {
+    if (stage == EvaluationStage::THREADED_EVALUATION) {
+      calculate_critical_path_times(state);
+    }
+    schedule_graph(state, schedule_node_to_priority_queue, task_pool);
+  }
+  else {
+    schedule_graph(state, schedule_node_to_pool, task_pool);
+  }
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -412,6 +583,17 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.use_priority = (G.debug & G_DEBUG_DEPSGRAPH_PRIORITY) != 0;
+  BLI_spin_init(&state.python_lane_lock);
+  if (state.use_priority) {
+    BLI_spin_init(&state.priority_lock);
+    state.priority_heap = BLI_heap_new();
+  }
+  std::unique_ptr<EvalProfileRecorder> profile;
+  if (G.debug & G_DEBUG_DEPSGRAPH_PROFILE) {
+    profile = std::make_unique<EvalProfileRecorder>();
+    state.profile = profile.get();
+  }
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -430,6 +612,8 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    *   Certain operations (and their subtrees) could be ignored. For example, meta-balls are not
    *   safe from threading point of view, so the threaded evaluation will stop at the metaball
    *   operation node.
+   *   Operations which call into Python are evaluated one after another by a single task, so the
+   *   other threads don't wait for the GIL.
    *
    * - Single-threaded pass of all remaining operations. */
 
@@ -458,6 +642,13 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   BLI_task_pool_free(task_pool);
 
+  BLI_assert(state.python_lane_queue.is_empty());
+  BLI_spin_end(&state.python_lane_lock);
+  if (state.use_priority) {
+    BLI_heap_free(state.priority_heap, nullptr);
+    BLI_spin_end(&state.priority_lock);
+  }
+
   evaluate_graph_single_threaded_if_needed(&state);
 
   /* Finalize statistics gathering. This is because we only gather single
@@ -466,6 +657,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.profile != nullptr) {
+    state.profile->finish(graph);
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
@@ -7,12 +7,19 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include <atomic>
+#include <mutex>
+
+#include "BLI_fileops.hh"
+#include "BLI_map.hh"
+#include "BLI_trace_event.hh"
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_factory.h"
 #include "intern/node/deg_node_id.h"
 #include "intern/node/deg_node_operation.h"
 
@@ -38,4 +45,190 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Evaluation Profile
+ * \{ */
+
+namespace {
+
+/* Operation names are stored once, so that the events of a long playback stay small and do not
+ * depend on the dependency graph they were recorded from to stay alive. */
+struct EvalProfileOperation {
+  string name;
+  string category;
+};
+
+struct EvalProfileEvent {
+  int64_t operation_index;
+  int64_t graph_index;
+  int thread_id;
+  double start_time;
+  double end_time;
+};
+
+/* Maximum number of recorded events (roughly 160 MB), so that a profile that is never written
+ * or cleared can't use up all memory during a long session. Later events are discarded. */
+constexpr int64_t eval_profile_events_max = int64_t(1) << 22;
+
+struct EvalProfile {
+  std::mutex mutex;
+
+  Vector<string> graph_names;
+  Map<string, int64_t> graph_indices;
+
+  Vector<EvalProfileOperation> operations;
+  Map<string, int64_t> operation_indices;
+
+  Vector<EvalProfileEvent> events;
+  bool events_discarded = false;
+
+  string filepath;
+};
+
+EvalProfile &eval_profile()
+{
+  static EvalProfile profile;
+  return profile;
+}
+
+int64_t eval_profile_index_ensure(Vector<string> &names,
+                                  Map<string, int64_t> &indices,
+                                  const string &name)
+{
+  return indices.lookup_or_add_cb(name, [&]() {
+    names.append(name);
+    return names.size() - 1;
+  });
+}
+
+}  // namespace
+
+void EvalProfileRecorder::record(const OperationNode *operation_node,
+                                 const double start_time,
+                                 const double end_time)
+{
+  events_.local().append({operation_node, trace_event::thread_index(), start_time, end_time});
+}
+
+void EvalProfileRecorder::finish(const Depsgraph *graph)
+{
+  EvalProfile &profile = eval_profile();
+  std::scoped_lock lock(profile.mutex);
+
+  const string graph_name = graph->debug.name.empty() ? "Depsgraph" : graph->debug.name;
+  const int64_t graph_index = eval_profile_index_ensure(
+      profile.graph_names, profile.graph_indices, graph_name);
+
+  /* Avoid building the identifier of the same operation over and over. */
+  Map<const OperationNode *, int64_t> operation_indices;
+  for (Vector<Event> &events : events_) {
+    for (const Event &event : events) {
+      if (profile.events.size() >= eval_profile_events_max) {
+        if (!profile.events_discarded) {
+          fprintf(stderr,
+                  "Dependency graph profile is full, write or clear it to record more events\n");
+          profile.events_discarded = true;
+        }
+        break;
+      }
+      const int64_t operation_index = operation_indices.lookup_or_add_cb(
+          event.operation_node, [&]() {
+            const OperationNode *operation_node = event.operation_node;
+            string name = operation_node->full_identifier();
+            return profile.operation_indices.lookup_or_add_cb(name, [&]() {
+              const ComponentNode *comp_node = operation_node->owner;
+              profile.operations.append({name, type_get_factory(comp_node->type)->type_name()});
+              return profile.operations.size() - 1;
+            });
+          });
+      profile.events.append(
+          {operation_index, graph_index, event.thread_id, event.start_time, event.end_time});
+    }
+    events.clear();
+  }
+}
+
+void deg_eval_profile_filepath_set(const char *filepath)
+{
+  EvalProfile &profile = eval_profile();
+  std::scoped_lock lock(profile.mutex);
+  profile.filepath = filepath;
+}
+
+static void eval_profile_clear(EvalProfile &profile)
+{
+  profile.graph_names.clear_and_make_inline();
+  profile.graph_indices.clear();
+  profile.operations.clear_and_make_inline();
+  profile.operation_indices.clear();
+  profile.events.clear_and_make_inline();
+  profile.events_discarded = false;
+}
+
+bool deg_eval_profile_write(const char *filepath, const bool clear)
+{
+  EvalProfile &profile = eval_profile();
+  std::scoped_lock lock(profile.mutex);
+
+  fstream stream(filepath, std::ios::out | std::ios::trunc);
+  if (!stream.is_open()) {
+    return false;
+  }
+
+  /* Time-stamps are relative to the start of the trace. */
+  double start_time = 0.0;
+  if (!profile.events.is_empty()) {
+    start_time = profile.events.first().start_time;
+    for (const EvalProfileEvent &event : profile.events) {
+      start_time = std::min(start_time, event.start_time);
+    }
+  }
+
+  {
+    trace_event::Writer writer(stream);
+    /* Show every dependency graph as its own process. */
+    for (const int64_t graph_index : profile.graph_names.index_range()) {
+      writer.process_name(int(graph_index), profile.graph_names[graph_index]);
+    }
+    for (const EvalProfileEvent &event : profile.events) {
+      const EvalProfileOperation &operation = profile.operations[event.operation_index];
+      writer.complete_event({operation.name,
+                             operation.category,
+                             (event.start_time - start_time) * 1e6,
+                             (event.end_time - event.start_time) * 1e6,
+                             int(event.graph_index),
+                             event.thread_id,
+                             {}});
+    }
+  }
+
+  if (clear) {
+    eval_profile_clear(profile);
+  }
+  return stream.good();
+}
+
+void deg_eval_profile_clear()
+{
+  EvalProfile &profile = eval_profile();
+  std::scoped_lock lock(profile.mutex);
+  eval_profile_clear(profile);
+}
+
+void deg_eval_profile_exit()
+{
+  const string filepath = eval_profile().filepath;
+  if (!filepath.empty()) {
+    if (deg_eval_profile_write(filepath.c_str(), false)) {
+      printf("Dependency graph profile written to '%s'\n", filepath.c_str());
+    }
+    else {
+      fprintf(stderr, "Error writing dependency graph profile to '%s'\n", filepath.c_str());
+    }
+  }
+  deg_eval_profile_clear();
+}
+
+/** \} */
+
 }  // namespace blender::deg
@@ -7,11 +7,43 @@
 
 #pragma once
 
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_vector.hh"
+
 namespace blender::deg {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Records evaluated operations of a single dependency graph evaluation for the profile enabled
+ * with #G_DEBUG_DEPSGRAPH_PROFILE. Recording is thread-safe, the recorded events are moved to the
+ * global profile by #finish once the evaluation is done. */
+class EvalProfileRecorder {
+ public:
+  void record(const OperationNode *operation_node, double start_time, double end_time);
+
+  /* Move recorded events to the global profile. Must be called while the operations of the
+   * graph are still alive. */
+  void finish(const Depsgraph *graph);
+
+ private:
+  struct Event {
+    const OperationNode *operation_node;
+    int thread_id;
+    double start_time;
+    double end_time;
+  };
+
+  threading::EnumerableThreadSpecific<Vector<Event>> events_;
+};
+
+void deg_eval_profile_filepath_set(const char *filepath);
+bool deg_eval_profile_write(const char *filepath, bool clear);
+void deg_eval_profile_clear();
+/* Write the profile to the file set from the command line (if any), and free it. */
+void deg_eval_profile_exit();
+
 }  // namespace blender::deg
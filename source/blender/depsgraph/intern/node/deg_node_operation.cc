@@ -144,6 +144,8 @@ const char *operationCodeAsString(OperationCode opcode)
     /* Point Cache. */
     case OperationCode::POINT_CACHE_RESET:
       return "POINT_CACHE_RESET";
+    case OperationCode::POSE_CACHE_RESET:
+      return "POSE_CACHE_RESET";
     /* File cache. */
     case OperationCode::FILE_CACHE_UPDATE:
       return "FILE_CACHE_UPDATE";
@@ -202,7 +204,8 @@ const char *operationCodeAsString(OperationCode opcode)
   return "UNKNOWN";
 }
 
-OperationNode::OperationNode() : name_tag(-1), flag(0)
+OperationNode::OperationNode()
+    : eval_time(0.0f), critical_path_time(0.0f), name_tag(-1), flag(0)
 {
 }
 
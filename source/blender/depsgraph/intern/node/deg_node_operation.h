@@ -147,6 +147,8 @@ enum class OperationCode {
 
   /* Point Cache. --------------------------------------------------------- */
   POINT_CACHE_RESET,
+  /* Free the evaluated poses stored for playback. */
+  POSE_CACHE_RESET,
 
   /* File cache. ---------------------------------------------------------- */
   FILE_CACHE_UPDATE,
@@ -223,6 +225,10 @@ enum OperationFlag {
   /* Evaluation of the node is temporarily disabled. */
   DEPSOP_FLAG_MUTE = (1 << 5),
 
+  /* The operation calls into Python (for example a scripted expression driver), and is evaluated
+   * in the serial Python lane of the threaded evaluation. */
+  DEPSOP_FLAG_USES_PYTHON = (1 << 6),
+
   /* Set of flags which gets flushed along the relations. */
   DEPSOP_FLAG_FLUSH = (DEPSOP_FLAG_USER_MODIFIED),
 };
@@ -268,6 +274,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Time the last evaluation of this operation took, only measured with
+   * #G_DEBUG_DEPSGRAPH_PRIORITY or time debugging enabled. */
+  float eval_time;
+  /* Evaluation time of this operation and of the most expensive chain of operations depending on
+   * it, used as the scheduling priority. */
+  float critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -66,6 +66,8 @@ typedef struct SELECTID_Context {
 
   /* To check for updates. */
   float persmat[4][4];
+  /** View settings affecting the drawing of the IDs, see #select_id_view_flag_get. */
+  int view_flag;
   bool is_dirty;
 } SELECTID_Context;
 
@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_iterator.h"
 #include "BLI_listbase.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_string_ref.hh"
@@ -7,6 +8,7 @@
 
 #include "BLT_translation.h"
 
+#include "DNA_ID.h"
 #include "DNA_ID_enums.h"
 #include "DNA_scene_types.h"
 
@@ -117,12 +119,28 @@ class Engine {
     evaluator_.reset();
   }
 
-  /* If the compositor node tree changed, reset the evaluator. */
+  /* If the compositor node tree changed, reset the evaluator. Results that are cached across
+   * evaluations are kept, since they are identified by the node options and inputs they were
+   * computed from. Additionally, declare every updated ID to the context, such that results
+   * computed from the data of those IDs, like images, are not reused. */
   void update(const Depsgraph *depsgraph)
   {
     if (DEG_id_type_updated(depsgraph, ID_NT)) {
       evaluator_.reset();
     }
+
+    DEGIDIterData data = {nullptr};
+    data.graph = const_cast<Depsgraph *>(depsgraph);
+    data.only_updated = true;
+    ITER_BEGIN (DEG_iterator_ids_begin,
+                DEG_iterator_ids_next,
+                DEG_iterator_ids_end,
+                &data,
+                ID *,
+                id) {
+      context_.tag_id_update(*id);
+    }
+    ITER_END;
   }
 
   /* Get a reference to the compositor node tree. */
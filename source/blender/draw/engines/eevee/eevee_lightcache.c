@@ -60,6 +60,10 @@
   (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_X) * \
       (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_Y)
 
+/* Reflection probes rendered in one pass. Keeps the baking responsive to cancellation and
+ * progress updates while sharing the draw cache between probes. */
+#define LIGHTBAKE_CUBE_BATCH_MAX 8
+
 /* TODO: should be replace by a more elegant alternative. */
 extern void DRW_opengl_context_enable(void);
 extern void DRW_opengl_context_disable(void);
@@ -134,6 +138,8 @@ typedef struct EEVEE_LightBake {
   int ref_cube_res;
   /** Index of the current cube. */
   int cube_offset;
+  /** Number of cubes rendered in the current pass, starting at #cube_offset. */
+  int cube_batch_len;
   /** Pointer to the owner_id of the probe object. */
   LightProbe **cube_prb;
 
@@ -1195,41 +1201,68 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
   LightCache *lcache = scene_eval->eevee.light_cache_data;
-  EEVEE_LightProbe *eprobe = lbake->cube;
-  LightProbe *prb = *lbake->probe;
   float clamp = scene_eval->eevee.gi_glossy_clamp;
   float filter_quality = scene_eval->eevee.gi_filter_quality;
 
   /* TODO: do this once for the whole bake when we have independent DRWManagers. */
   eevee_lightbake_cache_create(vedata, lbake);
 
-  /* Disable specular lighting when rendering probes to avoid feedback loops (looks bad). */
-  common_data->spec_toggle = false;
-  common_data->sss_toggle = false;
-  common_data->prb_num_planar = 0;
-  common_data->prb_num_render_cube = 0;
-  common_data->ray_type = EEVEE_RAY_GLOSSY;
-  common_data->ray_depth = 1;
-  GPU_uniformbuf_update(sldata->common_ubo, &sldata->common_data);
-
-  EEVEE_lightbake_render_scene(
-      sldata, vedata, lbake->rt_fb, eprobe->position, prb->clipsta, prb->clipend);
-  EEVEE_lightbake_filter_glossy(sldata,
-                                vedata,
-                                lbake->rt_color,
-                                lbake->store_fb,
-                                lbake->cube_offset,
-                                prb->intensity,
-                                lcache->mips_len,
-                                filter_quality,
-                                clamp);
-
-  lcache->cube_len += 1;
+  /* All the probes of the batch share the same visibility settings, so they are rendered with
+   * the draw cache created above. */
+  for (int i = 0; i < lbake->cube_batch_len; i++) {
+    EEVEE_LightProbe *eprobe = lbake->cube + i;
+    LightProbe *prb = lbake->probe[i];
+    const int cube_offset = lbake->cube_offset + i;
+
+    /* Disable specular lighting when rendering probes to avoid feedback loops (looks bad). */
+    common_data->spec_toggle = false;
+    common_data->sss_toggle = false;
+    common_data->prb_num_planar = 0;
+    common_data->prb_num_render_cube = 0;
+    common_data->ray_type = EEVEE_RAY_GLOSSY;
+    common_data->ray_depth = 1;
+    GPU_uniformbuf_update(sldata->common_ubo, &sldata->common_data);
+
+    EEVEE_lightbake_render_scene(
+        sldata, vedata, lbake->rt_fb, eprobe->position, prb->clipsta, prb->clipend);
+    EEVEE_lightbake_filter_glossy(sldata,
+                                  vedata,
+                                  lbake->rt_color,
+                                  lbake->store_fb,
+                                  cube_offset,
+                                  prb->intensity,
+                                  lcache->mips_len,
+                                  filter_quality,
+                                  clamp);
+
+    lcache->cube_len += 1;
+
+    /* If it's the last probe. */
+    if (cube_offset == lbake->cube_len - 1) {
+      lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
+    }
+  }
+}
 
-  /* If it's the last probe. */
-  if (lbake->cube_offset == lbake->cube_len - 1) {
-    lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
+/**
+ * Number of consecutive reflection probes starting at \a cube_offset that can be rendered in the
+ * same pass. The draw cache depends on the visibility collection of the probe, so only probes
+ * with the same visibility settings are batched.
+ */
+static int eevee_lightbake_cube_batch_len(const EEVEE_LightBake *lbake, int cube_offset)
+{
+  const LightProbe *prb_first = lbake->cube_prb[cube_offset];
+  int batch_len = 1;
+  while (batch_len < LIGHTBAKE_CUBE_BATCH_MAX && cube_offset + batch_len < lbake->cube_len) {
+    const LightProbe *prb = lbake->cube_prb[cube_offset + batch_len];
+    if (prb->visibility_grp != prb_first->visibility_grp ||
+        (prb->flag & LIGHTPROBE_FLAG_INVERT_GROUP) !=
+            (prb_first->flag & LIGHTPROBE_FLAG_INVERT_GROUP)) {
+      break;
+    }
+    batch_len++;
   }
+  return batch_len;
 }
 
 static float eevee_lightbake_grid_influence_volume(EEVEE_LightGrid *grid)
@@ -1345,8 +1378,9 @@ void EEVEE_lightbake_update(void *custom_data)
   DEG_id_tag_update(&scene_orig->id, ID_RECALC_COPY_ON_WRITE);
 }
 
-static bool lightbake_do_sample(EEVEE_LightBake *lbake,
-                                void (*render_callback)(void *ved, void *user_data))
+static bool lightbake_do_samples(EEVEE_LightBake *lbake,
+                                 void (*render_callback)(void *ved, void *user_data),
+                                 int samples_len)
 {
   if (G.is_break == true || *lbake->stop) {
     return false;
@@ -1357,7 +1391,7 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instantiable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
+  lbake->done += samples_len;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
@@ -1365,6 +1399,12 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   return true;
 }
 
+static bool lightbake_do_sample(EEVEE_LightBake *lbake,
+                                void (*render_callback)(void *ved, void *user_data))
+{
+  return lightbake_do_samples(lbake, render_callback, 1);
+}
+
 void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float *progress)
 {
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)custom_data;
@@ -1448,9 +1488,13 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     /* Bypass world, start at 1. */
     lbake->probe = lbake->cube_prb + 1;
     lbake->cube = lcache->cube_data + 1;
-    for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
-         lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+    lbake->cube_offset = 1;
+    while (lbake->cube_offset < lbake->cube_len) {
+      lbake->cube_batch_len = eevee_lightbake_cube_batch_len(lbake, lbake->cube_offset);
+      lightbake_do_samples(lbake, eevee_lightbake_render_probe_sample, lbake->cube_batch_len);
+      lbake->cube_offset += lbake->cube_batch_len;
+      lbake->probe += lbake->cube_batch_len;
+      lbake->cube += lbake->cube_batch_len;
     }
   }
 
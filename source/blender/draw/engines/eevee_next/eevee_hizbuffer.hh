@@ -67,6 +67,21 @@ class HiZBuffer {
    */
   void update();
 
+  /**
+   * Update the buffer and use it to cull the resources hidden behind the current depth buffer
+   * content for every following submission using \a view.
+   */
+  void occlusion_culling_begin(View &view)
+  {
+    this->update();
+    view.set_occlusion_culling(hiz_tx_, data_.uv_scale);
+  }
+
+  void occlusion_culling_end(View &view)
+  {
+    view.set_occlusion_culling(nullptr);
+  }
+
   void debug_draw(View &view, GPUFrameBuffer *view_fb);
 
   void bind_resources(DRWShadingGroup *grp)
@@ -153,6 +153,7 @@ void MaterialModule::begin_sync()
 
   material_map_.clear();
   shader_map_.clear();
+  shared_material_map_.clear();
 }
 
 MaterialPass MaterialModule::material_pass_get(Object *ob,
@@ -167,9 +168,29 @@ MaterialPass MaterialModule::material_pass_get(Object *ob,
   MaterialPass matpass = MaterialPass();
   matpass.gpumat = inst_.shaders.material_shader_get(
       blender_mat, ntree, pipeline_type, geometry_type, true);
+  /* True if the returned material is a default one that can be shared with other materials. */
+  bool use_shared_material = false;
 
   switch (GPU_material_status(matpass.gpumat)) {
     case GPU_MAT_SUCCESS:
+      if (ELEM(pipeline_type,
+               MAT_PIPE_DEFERRED_PREPASS,
+               MAT_PIPE_DEFERRED_PREPASS_VELOCITY,
+               MAT_PIPE_FORWARD_PREPASS,
+               MAT_PIPE_FORWARD_PREPASS_VELOCITY,
+               MAT_PIPE_SHADOW) &&
+          (geometry_type != MAT_GEOM_VOLUME) &&
+          !GPU_material_flag_get(matpass.gpumat,
+                                 GPU_MATFLAG_TRANSPARENT | GPU_MATFLAG_DISPLACEMENT)) {
+        /* Depth only passes do not evaluate the node-tree of opaque materials without
+         * displacement. Use the default material shader instead so that all of them end up in the
+         * same sub-pass and their geometry can be drawn by the same multi-draw. Keep the original
+         * `blender_mat` for the face culling state. */
+        ::Material *default_mat = BKE_material_default_surface();
+        matpass.gpumat = inst_.shaders.material_shader_get(
+            default_mat, default_mat->nodetree, pipeline_type, geometry_type, false);
+        use_shared_material = true;
+      }
       break;
     case GPU_MAT_QUEUED:
       queued_shaders_count++;
@@ -177,6 +198,7 @@ MaterialPass MaterialModule::material_pass_get(Object *ob,
                                                          BKE_material_default_surface();
       matpass.gpumat = inst_.shaders.material_shader_get(
           blender_mat, blender_mat->nodetree, pipeline_type, geometry_type, false);
+      use_shared_material = true;
       break;
     case GPU_MAT_FAILED:
     default:
@@ -207,14 +229,22 @@ MaterialPass MaterialModule::material_pass_get(Object *ob,
     matpass.sub_pass = nullptr;
   }
   else {
-    ShaderKey shader_key(matpass.gpumat, geometry_type, pipeline_type);
+    ShaderKey shader_key(matpass.gpumat, blender_mat, geometry_type, pipeline_type);
 
     PassMain::Sub *shader_sub = shader_map_.lookup_or_add_cb(shader_key, [&]() {
       /* First time encountering this shader. Create a sub that will contain materials using it. */
       return inst_.pipelines.material_add(ob, blender_mat, matpass.gpumat, pipeline_type);
     });
 
-    if (shader_sub != nullptr) {
+    if (shader_sub != nullptr && use_shared_material) {
+      /* Default materials only need one sub that every material using them can append to. */
+      matpass.sub_pass = shared_material_map_.lookup_or_add_cb(shader_key, [&]() {
+        PassMain::Sub *sub = &shader_sub->sub(GPU_material_get_name(matpass.gpumat));
+        sub->material_set(*inst_.manager, matpass.gpumat);
+        return sub;
+      });
+    }
+    else if (shader_sub != nullptr) {
       /* Create a sub for this material as `shader_sub` is for sharing shader between materials. */
       matpass.sub_pass = &shader_sub->sub(GPU_material_get_name(matpass.gpumat));
       matpass.sub_pass->material_set(*inst_.manager, matpass.gpumat);
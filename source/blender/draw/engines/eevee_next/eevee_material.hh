@@ -145,10 +145,16 @@ struct ShaderKey {
   GPUShader *shader;
   uint64_t options;
 
-  ShaderKey(GPUMaterial *gpumat, eMaterialGeometry geometry, eMaterialPipeline pipeline)
+  ShaderKey(GPUMaterial *gpumat,
+            const ::Material *blender_mat,
+            eMaterialGeometry geometry,
+            eMaterialPipeline pipeline)
   {
     shader = GPU_material_get_shader(gpumat);
     options = shader_uuid_from_material_type(pipeline, geometry);
+    /* Face culling is part of the pass state, so it has to be part of the key once materials
+     * share shaders. */
+    options = (options << 1u) | ((blender_mat->blend_flag & MA_BL_CULL_BACKFACE) != 0);
     options = (options << 16u) | shader_closure_bits_from_flag(gpumat);
   }
 
@@ -229,6 +235,8 @@ class MaterialModule {
 
   Map<MaterialKey, Material> material_map_;
   Map<ShaderKey, PassMain::Sub *> shader_map_;
+  /** Material sub-passes of the default materials, shared by all the materials drawn with them. */
+  Map<ShaderKey, PassMain::Sub *> shared_material_map_;
 
   MaterialArray material_array_;
 
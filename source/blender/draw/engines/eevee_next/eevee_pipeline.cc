@@ -209,8 +209,6 @@ void ForwardPipeline::render(View &view,
                              Framebuffer &combined_fb,
                              GPUTexture * /*combined_tx*/)
 {
-  UNUSED_VARS(view);
-
   DRW_stats_group_start("Forward.Opaque");
 
   GPU_framebuffer_bind(prepass_fb);
@@ -227,6 +225,9 @@ void ForwardPipeline::render(View &view,
 
   // inst_.shadows.set_view(view, depth_tx);
 
+  /* The prepass depth is final for opaque surfaces. Skip everything behind it. */
+  inst_.hiz_buffer.occlusion_culling_begin(view);
+
   GPU_framebuffer_bind(combined_fb);
   inst_.manager->submit(opaque_ps_, view);
 
@@ -234,6 +235,8 @@ void ForwardPipeline::render(View &view,
 
   inst_.manager->submit(transparent_ps_, view);
 
+  inst_.hiz_buffer.occlusion_culling_end(view);
+
   // if (inst_.raytracing.enabled()) {
   //   gbuffer.ray_radiance_tx.release();
   // }
@@ -344,6 +344,13 @@ typedef struct gpIterPopulateData {
   struct GPUBatch *geom;
   bool instancing;
   int vfirst, vcount;
+  /* Batches of the object's strokes and fills. Requested on first use instead of once per
+   * stroke, since frames can have tens of thousands of strokes. */
+  struct GPUBatch *geom_strokes;
+  struct GPUBatch *geom_fills;
+  /* Material of the last stroke. Consecutive strokes mostly use the same material. */
+  MaterialGPencilStyle *gp_style;
+  int gp_style_mat_nr;
 } gpIterPopulateData;
 
 #define DISABLE_BATCHING 0
@@ -470,7 +477,11 @@ static void gpencil_stroke_cache_populate(bGPDlayer *gpl,
   gpIterPopulateData *iter = (gpIterPopulateData *)thunk;
 
   bGPdata *gpd = iter->ob->data;
-  MaterialGPencilStyle *gp_style = BKE_gpencil_material_settings(iter->ob, gps->mat_nr + 1);
+  if (iter->gp_style == NULL || iter->gp_style_mat_nr != gps->mat_nr) {
+    iter->gp_style = BKE_gpencil_material_settings(iter->ob, gps->mat_nr + 1);
+    iter->gp_style_mat_nr = gps->mat_nr;
+  }
+  MaterialGPencilStyle *gp_style = iter->gp_style;
 
   const bool is_render = iter->pd->is_render;
   bool hide_material = (gp_style->flag & GP_MATERIAL_HIDE) != 0;
@@ -517,16 +528,21 @@ static void gpencil_stroke_cache_populate(bGPDlayer *gpl,
   bool do_sbuffer = (iter->do_sbuffer_call == DRAW_NOW);
 
   if (show_fill) {
-    GPUBatch *geom = do_sbuffer ? DRW_cache_gpencil_sbuffer_fill_get(iter->ob) :
-                                  DRW_cache_gpencil_fills_get(iter->ob, iter->pd->cfra);
+    if (!do_sbuffer && iter->geom_fills == NULL) {
+      iter->geom_fills = DRW_cache_gpencil_fills_get(iter->ob, iter->pd->cfra);
+    }
+    GPUBatch *geom = do_sbuffer ? DRW_cache_gpencil_sbuffer_fill_get(iter->ob) : iter->geom_fills;
     int vfirst = gps->runtime.fill_start * 3;
     int vcount = gps->tot_triangles * 3;
     gpencil_drawcall_add(iter, geom, false, vfirst, vcount);
   }
 
   if (show_stroke) {
+    if (!do_sbuffer && iter->geom_strokes == NULL) {
+      iter->geom_strokes = DRW_cache_gpencil_strokes_get(iter->ob, iter->pd->cfra);
+    }
     GPUBatch *geom = do_sbuffer ? DRW_cache_gpencil_sbuffer_stroke_get(iter->ob) :
-                                  DRW_cache_gpencil_strokes_get(iter->ob, iter->pd->cfra);
+                                  iter->geom_strokes;
     /* Start one vert before to have gl_InstanceID > 0 (see shader). */
     int vfirst = gps->runtime.stroke_start - 1;
     /* Include "potential" cyclic vertex and start adj vertex (see shader). */
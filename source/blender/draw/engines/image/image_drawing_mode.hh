@@ -13,6 +13,7 @@
 
 #include "BLI_float4x4.hh"
 #include "BLI_math_vec_types.hh"
+#include "BLI_task.hh"
 
 #include "image_batches.hh"
 #include "image_private.hh"
@@ -313,25 +314,29 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
         IMB_initImBuf(
             &extracted_buffer, texture_region_width, texture_region_height, 32, IB_rectfloat);
 
-        int offset = 0;
-        for (int y = gpu_texture_region_to_update.ymin; y < gpu_texture_region_to_update.ymax;
-             y++) {
-          float yf = y / (float)texture_height;
-          float v = info.clipping_uv_bounds.ymax * yf + info.clipping_uv_bounds.ymin * (1.0 - yf) -
-                    tile_offset_y;
-          for (int x = gpu_texture_region_to_update.xmin; x < gpu_texture_region_to_update.xmax;
-               x++) {
-            float xf = x / (float)texture_width;
-            float u = info.clipping_uv_bounds.xmax * xf +
-                      info.clipping_uv_bounds.xmin * (1.0 - xf) - tile_offset_x;
-            nearest_interpolation_color(tile_buffer,
-                                        nullptr,
-                                        &extracted_buffer.rect_float[offset * 4],
-                                        u * tile_buffer->x,
-                                        v * tile_buffer->y);
-            offset++;
+        /* Render results update large regions of the image many times while rendering, so the
+         * rows are extracted in parallel. */
+        threading::parallel_for(IndexRange(texture_region_height), 16, [&](IndexRange rows) {
+          for (const int row : rows) {
+            const int y = gpu_texture_region_to_update.ymin + row;
+            float yf = y / (float)texture_height;
+            float v = info.clipping_uv_bounds.ymax * yf +
+                      info.clipping_uv_bounds.ymin * (1.0 - yf) - tile_offset_y;
+            int offset = row * texture_region_width;
+            for (int x = gpu_texture_region_to_update.xmin; x < gpu_texture_region_to_update.xmax;
+                 x++) {
+              float xf = x / (float)texture_width;
+              float u = info.clipping_uv_bounds.xmax * xf +
+                        info.clipping_uv_bounds.xmin * (1.0 - xf) - tile_offset_x;
+              nearest_interpolation_color(tile_buffer,
+                                          nullptr,
+                                          &extracted_buffer.rect_float[offset * 4],
+                                          u * tile_buffer->x,
+                                          v * tile_buffer->y);
+              offset++;
+            }
           }
-        }
+        });
 
         GPU_texture_update_sub(texture,
                                GPU_DATA_FLOAT,
@@ -29,6 +29,7 @@ static struct {
   struct GPUTexture *texture_u32;
 
   SELECTID_Shaders sh_data[GPU_SHADER_CFG_LEN];
+  struct GPUShader *select_id_bitmap_sh;
   struct SELECTID_Context context;
   uint runtime_new_objects;
 } e_data = {NULL}; /* Engine data */
@@ -67,6 +68,14 @@ static void select_engine_framebuffer_setup(void)
   }
 }
 
+static bool select_engine_texture_size_match(void)
+{
+  DefaultTextureList *dtxl = DRW_viewport_texture_list_get();
+  return (e_data.texture_u32 != NULL) &&
+         (GPU_texture_width(e_data.texture_u32) == GPU_texture_width(dtxl->depth)) &&
+         (GPU_texture_height(e_data.texture_u32) == GPU_texture_height(dtxl->depth));
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -165,15 +174,18 @@ static void select_cache_init(void *vedata)
 
   /* Check if the viewport has changed. */
   float(*persmat)[4] = draw_ctx->rv3d->persmat;
-  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON);
+  const int view_flag = select_id_view_flag_get(draw_ctx->v3d, draw_ctx->rv3d);
+  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON) ||
+                            (e_data.context.view_flag != view_flag) ||
+                            !select_engine_texture_size_match();
 
   if (!e_data.context.is_dirty) {
-    /* Check if any of the drawn objects have been transformed. */
+    /* Check if any of the drawn objects have been transformed or edited. */
     Object **ob = &e_data.context.objects_drawn[0];
     for (uint i = e_data.context.objects_drawn_len; i--; ob++) {
       DrawData *data = DRW_drawdata_get(&(*ob)->id, &draw_engine_select_type);
-      if (data && (data->recalc & ID_RECALC_TRANSFORM) != 0) {
-        data->recalc &= ~ID_RECALC_TRANSFORM;
+      if (data && (data->recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY)) != 0) {
+        data->recalc &= ~(ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
         e_data.context.is_dirty = true;
       }
     }
@@ -182,6 +194,7 @@ static void select_cache_init(void *vedata)
   if (e_data.context.is_dirty) {
     /* Remove all tags from drawn or culled objects. */
     copy_m4_m4(e_data.context.persmat, persmat);
+    e_data.context.view_flag = view_flag;
     e_data.context.objects_drawn_len = 0;
     e_data.context.index_drawn_len = 1;
     select_engine_framebuffer_setup();
@@ -306,6 +319,7 @@ static void select_engine_free(void)
     DRW_SHADER_FREE_SAFE(sh_data->select_id_flat);
     DRW_SHADER_FREE_SAFE(sh_data->select_id_uniform);
   }
+  DRW_SHADER_FREE_SAFE(e_data.select_id_bitmap_sh);
 
   DRW_TEXTURE_FREE_SAFE(e_data.texture_u32);
   GPU_FRAMEBUFFER_FREE_SAFE(e_data.framebuffer_select_id);
@@ -382,6 +396,14 @@ GPUTexture *DRW_engine_select_texture_get(void)
   return e_data.texture_u32;
 }
 
+GPUShader *DRW_engine_select_bitmap_shader_get(void)
+{
+  if (e_data.select_id_bitmap_sh == NULL) {
+    e_data.select_id_bitmap_sh = GPU_shader_create_from_info_name("select_id_bitmap");
+  }
+  return e_data.select_id_bitmap_sh;
+}
+
 /** \} */
 
 #undef SELECT_ENGINE
@@ -22,3 +22,5 @@ struct SELECTID_Context *DRW_select_engine_context_get(void);
 
 struct GPUFrameBuffer *DRW_engine_select_framebuffer_get(void);
 struct GPUTexture *DRW_engine_select_texture_get(void);
+/** Compute shader resolving a selection bitmap from the ID texture. Created on first use. */
+struct GPUShader *DRW_engine_select_bitmap_shader_get(void);
@@ -41,3 +41,23 @@ GPU_SHADER_CREATE_INFO(select_id_uniform_clipped)
     .additional_info("drw_clipped")
     .do_static_compilation(true);
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Select Bitmap
+ *
+ * Resolve the selection bitmap of a region of the ID buffer on the GPU.
+ * \{ */
+
+GPU_SHADER_CREATE_INFO(select_id_bitmap)
+    .local_group_size(16, 16)
+    .sampler(0, ImageType::UINT_2D, "select_id_tx")
+    .storage_buf(0, Qualifier::READ_WRITE, "uint", "bitmap_buf[]")
+    .push_constant(Type::IVEC2, "rect_min")
+    .push_constant(Type::IVEC2, "rect_max")
+    .push_constant(Type::IVEC2, "center")
+    .push_constant(Type::INT, "radius")
+    .push_constant(Type::INT, "bitmap_len")
+    .compute_source("select_id_bitmap_comp.glsl")
+    .do_static_compilation(true);
+
+/** \} */
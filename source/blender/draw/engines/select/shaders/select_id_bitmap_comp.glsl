@@ -0,0 +1,25 @@
+/**
+ * Set the bit of every element ID found inside the rectangle (or the circle if `radius` is not
+ * zero). The bitmap has the same layout as #BLI_bitmap.
+ */
+
+void main()
+{
+  ivec2 texel = rect_min + ivec2(gl_GlobalInvocationID.xy);
+  if (any(greaterThanEqual(texel, rect_max))) {
+    return;
+  }
+
+  if (radius > 0) {
+    ivec2 delta = texel - center;
+    if (dot(delta, delta) >= radius * radius) {
+      return;
+    }
+  }
+
+  /* Intentionally wrap to max value if this is zero. */
+  uint index = texelFetch(select_id_tx, texel, 0).r - 1u;
+  if (index < uint(bitmap_len)) {
+    atomicOr(bitmap_buf[index >> 5u], 1u << (index & 31u));
+  }
+}
@@ -34,6 +34,8 @@ typedef enum eDRWLevelOfDetail {
 } eDRWLevelOfDetail;
 
 void DRW_shape_cache_free(void);
+/** Free the shaders used to extract mesh buffers on the GPU. */
+void DRW_mesh_extract_free(void);
 
 /* 3D cursor */
 struct GPUBatch *DRW_cache_cursor_get(bool crosshair_lines);
@@ -689,6 +689,23 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   mr->use_subsurf_fdots = mr->me && mr->me->runtime.subsurf_face_dot_tags != nullptr;
   mr->use_final_mesh = do_final;
 
+  if (!do_hq_normals && DRW_vbo_requested(mbuflist->vbo.pos_nor) &&
+      extract_pos_nor_gpu_supported(mr)) {
+    /* Large meshes fill the position buffer on the GPU, this has to happen on this thread since it
+     * needs the GPU context. */
+    extract_pos_nor_gpu(mr, mbc, mbuflist->vbo.pos_nor);
+    for (const int i : extractors.index_range()) {
+      if (extractors[i].extractor == &extract_pos_nor) {
+        extractors.remove(i);
+        break;
+      }
+    }
+    if (extractors.is_empty()) {
+      mesh_render_data_free(mr);
+      return;
+    }
+  }
+
 #ifdef DEBUG_TIME
   double rdata_end = PIL_check_seconds_timer();
 #endif
@@ -360,7 +360,7 @@ void mesh_render_data_update_normals(MeshRenderData *mr, const eMRDataType data_
     if (((data_flag & MR_DATA_LOOP_NOR) && is_auto_smooth) || (data_flag & MR_DATA_TAN_LOOP_NOR)) {
       mr->loop_normals = static_cast<float(*)[3]>(
           MEM_mallocN(sizeof(*mr->loop_normals) * mr->loop_len, __func__));
-      short(*clnors)[2] = static_cast<short(*)[2]>(
+      const short(*clnors)[2] = static_cast<const short(*)[2]>(
           CustomData_get_layer(&mr->me->ldata, CD_CUSTOMLOOPNORMAL));
       BKE_mesh_normals_loop_split(mr->mvert,
                                   mr->vert_normals,
@@ -376,7 +376,8 @@ void mesh_render_data_update_normals(MeshRenderData *mr, const eMRDataType data_
                                   is_auto_smooth,
                                   split_angle,
                                   nullptr,
-                                  clnors,
+                                  /* Only written when a space array is requested. */
+                                  const_cast<short(*)[2]>(clnors),
                                   nullptr);
     }
   }
@@ -43,6 +43,8 @@ void DRW_curve_batch_cache_free(struct Curve *cu);
 void DRW_mesh_batch_cache_dirty_tag(struct Mesh *me, eMeshBatchDirtyMode mode);
 void DRW_mesh_batch_cache_validate(struct Object *object, struct Mesh *me);
 void DRW_mesh_batch_cache_free(struct Mesh *me);
+/** Free a batch cache that is not owned by a mesh, see #BKE_mesh_batch_cache_stash_take. */
+void DRW_mesh_batch_cache_free_data(void *batch_cache);
 
 void DRW_lattice_batch_cache_dirty_tag(struct Lattice *lt, int mode);
 void DRW_lattice_batch_cache_validate(struct Lattice *lt);
@@ -201,7 +201,7 @@ static constexpr DRWBatchFlag batches_that_use_buffer(const int buffer_index)
 }
 
 static void mesh_batch_cache_discard_surface_batches(MeshBatchCache *cache);
-static void mesh_batch_cache_clear(Mesh *me);
+static void mesh_batch_cache_clear(MeshBatchCache *cache);
 
 static void mesh_batch_cache_discard_batch(MeshBatchCache *cache, const DRWBatchFlag batch_map)
 {
@@ -627,7 +627,7 @@ static void mesh_batch_cache_init(Object *object, Mesh *me)
 void DRW_mesh_batch_cache_validate(Object *object, Mesh *me)
 {
   if (!mesh_batch_cache_valid(object, me)) {
-    mesh_batch_cache_clear(me);
+    mesh_batch_cache_clear(static_cast<MeshBatchCache *>(me->runtime.batch_cache));
     mesh_batch_cache_init(object, me);
   }
 }
@@ -721,6 +721,52 @@ static void mesh_batch_cache_discard_uvedit(MeshBatchCache *cache)
   cache->cd_used.edit_uv = 0;
 }
 
+/**
+ * Discard the buffers that depend on the vertex positions, either directly or through the face
+ * triangulation or normals. Index buffers of edges and vertices and most attributes are kept.
+ */
+static void mesh_batch_cache_discard_deform(MeshBatchCache *cache)
+{
+  if (cache->subdiv_cache) {
+    /* The subdivided positions are evaluated together with the other buffers. */
+    cache->is_dirty = true;
+    return;
+  }
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    /* The triangulation of n-gons depends on the positions. */
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.tris);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.lines_adjacency);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.edituv_tris);
+  }
+  for (int i = 0; i < cache->mat_len; i++) {
+    GPU_INDEXBUF_DISCARD_SAFE(cache->tris_per_mat[i]);
+  }
+  DRWBatchFlag batch_map = BATCH_MAP(vbo.pos_nor,
+                                     vbo.lnor,
+                                     vbo.tan,
+                                     vbo.edge_fac,
+                                     vbo.mesh_analysis,
+                                     vbo.edituv_stretch_area,
+                                     vbo.edituv_stretch_angle,
+                                     vbo.fdots_pos,
+                                     vbo.fdots_nor,
+                                     ibo.tris);
+  batch_map |= BATCH_MAP(ibo.lines_adjacency, ibo.edituv_tris);
+  mesh_batch_cache_discard_batch(cache, batch_map | MBC_SURFACE_PER_MAT);
+
+  cache->tot_area = 0.0f;
+  cache->tot_uv_area = 0.0f;
+}
+
 static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
 {
   FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
@@ -788,6 +834,9 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
       batch_map = BATCH_MAP(vbo.edituv_data, vbo.fdots_edituv_data);
       mesh_batch_cache_discard_batch(cache, batch_map);
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      mesh_batch_cache_discard_deform(cache);
+      break;
     default:
       BLI_assert(0);
   }
@@ -828,9 +877,8 @@ static void mesh_batch_cache_free_subdiv_cache(MeshBatchCache *cache)
   }
 }
 
-static void mesh_batch_cache_clear(Mesh *me)
+static void mesh_batch_cache_clear(MeshBatchCache *cache)
 {
-  MeshBatchCache *cache = static_cast<MeshBatchCache *>(me->runtime.batch_cache);
   if (!cache) {
     return;
   }
@@ -861,8 +909,15 @@ static void mesh_batch_cache_clear(Mesh *me)
 
 void DRW_mesh_batch_cache_free(Mesh *me)
 {
-  mesh_batch_cache_clear(me);
-  MEM_SAFE_FREE(me->runtime.batch_cache);
+  DRW_mesh_batch_cache_free_data(me->runtime.batch_cache);
+  me->runtime.batch_cache = nullptr;
+}
+
+void DRW_mesh_batch_cache_free_data(void *batch_cache)
+{
+  MeshBatchCache *cache = static_cast<MeshBatchCache *>(batch_cache);
+  mesh_batch_cache_clear(cache);
+  MEM_SAFE_FREE(cache);
 }
 
 /** \} */
@@ -238,6 +238,12 @@ void DRW_globals_update(void)
 
     G_draw.weight_ramp = DRW_create_weight_colorramp_texture();
   }
+
+  if (G_draw.image_placeholder == NULL) {
+    const float gray[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+    G_draw.image_placeholder = GPU_texture_create_2d(
+        "image_placeholder", 1, 1, 1, GPU_RGBA8, gray);
+  }
 }
 
 /* ********************************* SHGROUP ************************************* */
@@ -130,6 +130,8 @@ struct DRW_Global {
 
   struct GPUTexture *ramp;
   struct GPUTexture *weight_ramp;
+  /** Drawn instead of image textures that are still being loaded. */
+  struct GPUTexture *image_placeholder;
 
   struct GPUUniformBuf *view_ubo;
   struct GPUUniformBuf *clipping_ubo;
@@ -9,6 +9,7 @@
 
 #include "BLI_alloca.h"
 #include "BLI_listbase.h"
+#include "BLI_math_vector.h"
 #include "BLI_memblock.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -52,6 +53,8 @@
 #include "ED_space_api.h"
 #include "ED_view3d.h"
 
+#include "NOD_geometry.h"
+
 #include "GPU_capabilities.h"
 #include "GPU_framebuffer.h"
 #include "GPU_immediate.h"
@@ -64,6 +67,8 @@
 
 #include "IMB_colormanagement.h"
 
+#include "PIL_time.h"
+
 #include "RE_engine.h"
 #include "RE_pipeline.h"
 
@@ -1024,6 +1029,9 @@ static void drw_engines_cache_init(void)
 {
   DRW_manager_begin_sync();
 
+  /* Images used by the world and other data that covers the whole view are loaded first. */
+  DST.load_priority = 0.0f;
+
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     if (data->text_draw_cache) {
       DRW_text_cache_destroy(data->text_draw_cache);
@@ -1056,6 +1064,10 @@ static void drw_engines_cache_populate(Object *ob)
 {
   DST.ob_handle = 0;
 
+  /* Images and materials of objects that are closer to the view are loaded first. */
+  const RegionView3D *rv3d = DST.draw_ctx.rv3d;
+  DST.load_priority = rv3d ? -len_squared_v3v3(rv3d->viewinv[3], ob->obmat[3]) : 0.0f;
+
   /* HACK: DrawData is copied by COW from the duplicated object.
    * This is valid for IDs that cannot be instantiated but this
    * is not what we want in this case so we clear the pointer
@@ -1088,6 +1100,119 @@ static void drw_engines_cache_populate(Object *ob)
   drw_drawdata_unlink_dupli((ID *)ob);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Threaded Object Iteration
+ *
+ * The depsgraph object iteration, which includes the generation of the dupli-lists, runs on a
+ * separate thread while the engines populate their caches on the main thread. The engines are
+ * not thread safe, so the objects are still populated one by one and in the same order as a
+ * regular iteration, keeping the result deterministic.
+ * \{ */
+
+/** Number of objects the iteration can be ahead of the cache population. */
+#define DRW_OBJECT_ITER_QUEUE_LEN 256
+
+typedef struct DRWObjectIterItem {
+  Object *ob;
+  Object *dupli_parent;
+  DupliObject *dupli_object;
+  /**
+   * The iterator reuses its temporary storage for every instance, so instances are copied here.
+   */
+  Object temp_object;
+  DupliObject temp_dupli_object;
+} DRWObjectIterItem;
+
+typedef struct DRWObjectIterThreadData {
+  DEGObjectIterSettings *settings;
+  View3D *v3d;
+  int object_type_exclude_viewport;
+  /** Items ready to be populated, in iteration order. */
+  ThreadQueue *ready_queue;
+  /** Items that can be filled by the iteration. */
+  ThreadQueue *free_queue;
+} DRWObjectIterThreadData;
+
+static void *drw_object_iter_thread(void *arg)
+{
+  DRWObjectIterThreadData *td = (DRWObjectIterThreadData *)arg;
+
+  DEG_OBJECT_ITER_BEGIN (td->settings, ob) {
+    if ((td->object_type_exclude_viewport & (1 << ob->type)) != 0) {
+      continue;
+    }
+    if (!BKE_object_is_visible_in_viewport(td->v3d, ob)) {
+      continue;
+    }
+    /* Blocks if the cache population is too far behind. */
+    DRWObjectIterItem *item = BLI_thread_queue_pop(td->free_queue);
+    item->dupli_parent = data_.dupli_parent;
+    if (data_.dupli_object_current != NULL) {
+      item->temp_object = *ob;
+      item->temp_dupli_object = *data_.dupli_object_current;
+      item->ob = &item->temp_object;
+      item->dupli_object = &item->temp_dupli_object;
+    }
+    else {
+      item->ob = ob;
+      item->dupli_object = NULL;
+    }
+    BLI_thread_queue_push(td->ready_queue, item);
+  }
+  DEG_OBJECT_ITER_END;
+
+  /* Let the cache population finish the remaining items and stop. */
+  BLI_thread_queue_nowait(td->ready_queue);
+  return NULL;
+}
+
+static void drw_engines_cache_populate_threaded(DEGObjectIterSettings *settings,
+                                                View3D *v3d,
+                                                const int object_type_exclude_viewport)
+{
+  DRWObjectIterItem *items = MEM_mallocN(sizeof(*items) * DRW_OBJECT_ITER_QUEUE_LEN, __func__);
+
+  DRWObjectIterThreadData td = {
+      .settings = settings,
+      .v3d = v3d,
+      .object_type_exclude_viewport = object_type_exclude_viewport,
+      .ready_queue = BLI_thread_queue_init(),
+      .free_queue = BLI_thread_queue_init(),
+  };
+  for (int i = 0; i < DRW_OBJECT_ITER_QUEUE_LEN; i++) {
+    BLI_thread_queue_push(td.free_queue, &items[i]);
+  }
+
+  ListBase threads;
+  BLI_threadpool_init(&threads, drw_object_iter_thread, 1);
+  BLI_threadpool_insert(&threads, &td);
+
+  DRWObjectIterItem *item;
+  while ((item = BLI_thread_queue_pop(td.ready_queue))) {
+    DST.dupli_parent = item->dupli_parent;
+    DST.dupli_source = item->dupli_object;
+    drw_duplidata_load(item->ob);
+    drw_engines_cache_populate(item->ob);
+
+    if (item->dupli_object != NULL) {
+      /* The bounding box might have been computed for the copy only. */
+      if (item->temp_object.runtime.bb != item->dupli_object->ob->runtime.bb) {
+        MEM_SAFE_FREE(item->temp_object.runtime.bb);
+      }
+    }
+    BLI_thread_queue_push(td.free_queue, item);
+  }
+  DST.dupli_parent = NULL;
+  DST.dupli_source = NULL;
+
+  BLI_threadpool_end(&threads);
+  BLI_thread_queue_free(td.ready_queue);
+  BLI_thread_queue_free(td.free_queue);
+  MEM_freeN(items);
+}
+
+/** \} */
+
 static void drw_engines_cache_finish(void)
 {
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
@@ -1716,28 +1841,37 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
       if (v3d->flag2 & V3D_SHOW_VIEWER) {
         deg_iter_settings.viewer_path = &v3d->viewer_path;
       }
-      DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, ob) {
-        if ((object_type_exclude_viewport & (1 << ob->type)) != 0) {
-          continue;
-        }
-        if (!BKE_object_is_visible_in_viewport(v3d, ob)) {
-          continue;
+      if (BLI_system_thread_count() > 1) {
+        drw_engines_cache_populate_threaded(&deg_iter_settings, v3d, object_type_exclude_viewport);
+      }
+      else {
+        DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, ob) {
+          if ((object_type_exclude_viewport & (1 << ob->type)) != 0) {
+            continue;
+          }
+          if (!BKE_object_is_visible_in_viewport(v3d, ob)) {
+            continue;
+          }
+          DST.dupli_parent = data_.dupli_parent;
+          DST.dupli_source = data_.dupli_object_current;
+          drw_duplidata_load(ob);
+          drw_engines_cache_populate(ob);
         }
-        DST.dupli_parent = data_.dupli_parent;
-        DST.dupli_source = data_.dupli_object_current;
-        drw_duplidata_load(ob);
-        drw_engines_cache_populate(ob);
+        DEG_OBJECT_ITER_END;
       }
-      DEG_OBJECT_ITER_END;
     }
 
     drw_duplidata_free();
     drw_engines_cache_finish();
 
+    const double time_extraction = PIL_check_seconds_timer();
     drw_task_graph_deinit();
+    DRW_stats_cpu_time_add(DRW_STATS_CPU_EXTRACTION,
+                           (PIL_check_seconds_timer() - time_extraction) * 1e3);
     DRW_render_instance_buffer_finish();
 
 #ifdef USE_PROFILE
+    DRW_stats_cpu_time_add(DRW_STATS_CPU_SYNC, (time_extraction - stime) * 1e3);
     double *cache_time = DRW_view_data_cache_time_get(DST.view_data_active);
     PROFILE_END_UPDATE(*cache_time, stime);
 #endif
@@ -1757,7 +1891,10 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   DRW_draw_callbacks_pre_scene();
 
+  const double time_submission = PIL_check_seconds_timer();
   drw_engines_draw_scene();
+  DRW_stats_cpu_time_add(DRW_STATS_CPU_SUBMISSION,
+                         (PIL_check_seconds_timer() - time_submission) * 1e3);
 
   /* Fix 3D view "lagging" on APPLE and WIN32+NVIDIA. (See T56996, T61474) */
   if (GPU_type_matches_ex(GPU_DEVICE_ANY, GPU_OS_ANY, GPU_DRIVER_ANY, GPU_BACKEND_OPENGL)) {
@@ -3004,6 +3141,24 @@ void DRW_engines_register_experimental(void)
   }
 }
 
+/**
+ * Let geometry nodes evaluate fields with the draw manager's context on threads that don't have
+ * a GPU context. Evaluation waits while the context is used for drawing or rendering.
+ */
+static bool drw_gpu_fields_context_enable(void)
+{
+  if (DST.gl_context == NULL || GPU_use_main_context_workaround()) {
+    return false;
+  }
+  DRW_opengl_context_enable_ex(false);
+  return true;
+}
+
+static void drw_gpu_fields_context_disable(void)
+{
+  DRW_opengl_context_disable_ex(false);
+}
+
 void DRW_engines_register(void)
 {
   RE_engines_register(&DRW_engine_viewport_eevee_type);
@@ -3029,6 +3184,7 @@ void DRW_engines_register(void)
 
     BKE_mesh_batch_cache_dirty_tag_cb = DRW_mesh_batch_cache_dirty_tag;
     BKE_mesh_batch_cache_free_cb = DRW_mesh_batch_cache_free;
+    BKE_mesh_batch_cache_free_data_cb = DRW_mesh_batch_cache_free_data;
 
     BKE_lattice_batch_cache_dirty_tag_cb = DRW_lattice_batch_cache_dirty_tag;
     BKE_lattice_batch_cache_free_cb = DRW_lattice_batch_cache_free;
@@ -3049,6 +3205,9 @@ void DRW_engines_register(void)
     BKE_volume_batch_cache_free_cb = DRW_volume_batch_cache_free;
 
     BKE_subsurf_modifier_free_gpu_cache_cb = DRW_subdiv_cache_free;
+
+    geometry_nodes_gpu_fields_register(drw_gpu_fields_context_enable,
+                                       drw_gpu_fields_context_disable);
   }
 }
 
@@ -3086,9 +3245,11 @@ void DRW_engines_free(void)
   GPU_FRAMEBUFFER_FREE_SAFE(g_select_buffer.framebuffer_depth_only);
 
   DRW_shaders_free();
+  geometry_nodes_gpu_fields_free();
   DRW_curves_free();
   DRW_volume_free();
   DRW_shape_cache_free();
+  DRW_mesh_extract_free();
   DRW_stats_free();
   DRW_globals_free();
 
@@ -3100,6 +3261,7 @@ void DRW_engines_free(void)
   DRW_UBO_FREE_SAFE(G_draw.clipping_ubo);
   DRW_TEXTURE_FREE_SAFE(G_draw.ramp);
   DRW_TEXTURE_FREE_SAFE(G_draw.weight_ramp);
+  DRW_TEXTURE_FREE_SAFE(G_draw.image_placeholder);
 
   if (DST.draw_list) {
     GPU_draw_list_discard(DST.draw_list);
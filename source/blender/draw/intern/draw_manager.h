@@ -584,6 +584,11 @@ typedef struct DRWManager {
   struct Object *dupli_origin;
   /** Object-data referenced by the current dupli object. */
   struct ID *dupli_origin_data;
+  /**
+   * Priority of the images loaded and the materials compiled in the background for the current
+   * object. Higher priorities are handled first.
+   */
+  float load_priority;
   /** Hash-map: #DupliKey -> void pointer for each enabled engine. */
   struct GHash *dupli_ghash;
   /** TODO(@fclem): try to remove usage of this. */
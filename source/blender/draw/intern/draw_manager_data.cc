@@ -1811,11 +1811,20 @@ void DRW_shgroup_add_material_resources(DRWShadingGroup *grp, GPUMaterial *mater
         drw_shgroup_material_texture(
             grp, gputex, tex->tiled_mapping_name, eGPUSamplerState(tex->sampler_state));
       }
-      else {
+      else if (DRW_state_is_image_render()) {
         gputex = BKE_image_get_gpu_texture(tex->ima, iuser, nullptr);
         drw_shgroup_material_texture(
             grp, gputex, tex->sampler_name, eGPUSamplerState(tex->sampler_state));
       }
+      else {
+        /* Don't wait for image files to be read when drawing interactively. */
+        gputex = BKE_image_get_gpu_texture_async(tex->ima, iuser, DST.load_priority);
+        if (gputex == nullptr) {
+          gputex = G_draw.image_placeholder;
+        }
+        drw_shgroup_material_texture(
+            grp, gputex, tex->sampler_name, eGPUSamplerState(tex->sampler_state));
+      }
     }
     else if (tex->colorband) {
       /* Color Ramp */
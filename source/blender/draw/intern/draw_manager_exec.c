@@ -559,6 +559,7 @@ BLI_INLINE void draw_geometry_execute(DRWShadingGroup *shgroup,
     draw_geometry_bind(shgroup, geom);
   }
 
+  DRW_stats_draw_call_add(geom, vert_count, inst_count);
   GPU_batch_draw_advanced(geom, vert_first, vert_count, inst_first, inst_count);
 }
 
@@ -573,6 +574,7 @@ BLI_INLINE void draw_indirect_call(DRWShadingGroup *shgroup, DRWCommandsState *s
       GPU_draw_list_submit(DST.draw_list);
       draw_geometry_bind(shgroup, state->batch);
     }
+    DRW_stats_draw_call_add(state->batch, 0, state->inst_count);
     GPU_draw_list_append(DST.draw_list, state->batch, state->base_inst, state->inst_count);
   }
   /* Fallback when unsupported */
@@ -5,10 +5,15 @@
  * \ingroup draw
  */
 
+#include <stdio.h>
+
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
+#include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
 #include "BLF_api.h"
@@ -17,7 +22,9 @@
 
 #include "draw_manager.h"
 
+#include "GPU_batch.h"
 #include "GPU_debug.h"
+#include "GPU_query.h"
 #include "GPU_texture.h"
 
 #include "UI_resources.h"
@@ -28,9 +35,13 @@
 #define MAX_NESTED_TIMER 8
 #define MIM_RANGE_LEN 8
 #define GPU_TIMER_FALLOFF 0.1
+#define STATS_CSV_FILENAME "blender_draw_stats.csv"
 
 typedef struct DRWTimer {
-  uint32_t query[2];
+  /** Index + 1 of the query inside the pool of the current and previous frame. 0 if none. */
+  int query[2];
+  /** Last measured time in nanoseconds. */
+  uint64_t time_last;
   uint64_t time_average;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
@@ -45,26 +56,68 @@ static struct DRWTimerPool {
   int end_increment;   /* Keep track of bad usage. */
   bool is_recording;   /* Are we in the render loop? */
   bool is_querying;    /* Keep track of bad usage. */
+  /**
+   * Time queries of the current and previous frame. Results are read one frame late to avoid
+   * waiting for the GPU.
+   */
+  GPUQueryPool *query_pools[2];
+  int query_len[2];
+  /* Frame statistics. */
+  double cpu_time[DRW_STATS_CPU_TIME_LEN];
+  uint draw_call_len;
+  uint64_t triangle_len;
+  /* CSV export. */
+  FILE *csv_file;
+  int frame;
 } DTP = {NULL};
 
+static const char *cpu_time_names[DRW_STATS_CPU_TIME_LEN] = {"sync", "extraction", "submission"};
+
+static void drw_stats_query_pools_free(void)
+{
+  for (int i = 0; i < 2; i++) {
+    if (DTP.query_pools[i] != NULL) {
+      GPU_querypool_free(DTP.query_pools[i]);
+      DTP.query_pools[i] = NULL;
+    }
+    DTP.query_len[i] = 0;
+  }
+}
+
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
   }
+  drw_stats_query_pools_free();
+  if (DTP.csv_file != NULL) {
+    fclose(DTP.csv_file);
+    DTP.csv_file = NULL;
+  }
 }
 
 void DRW_stats_begin(void)
 {
-  if (G.debug_value > 20 && G.debug_value < 30) {
+  if (G.debug_value > 20 && G.debug_value <= 30) {
     DTP.is_recording = true;
   }
 
+  if (DTP.is_recording && G.debug_value == 30 && DTP.csv_file == NULL) {
+    char filepath[FILE_MAX];
+    BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_base(), STATS_CSV_FILENAME);
+    DTP.csv_file = BLI_fopen(filepath, "w");
+    if (DTP.csv_file != NULL) {
+      printf("Writing draw statistics to \"%s\"\n", filepath);
+      fprintf(DTP.csv_file, "frame,category,name,value\n");
+      DTP.frame = 0;
+    }
+  }
+  else if (G.debug_value != 30 && DTP.csv_file != NULL) {
+    fclose(DTP.csv_file);
+    DTP.csv_file = NULL;
+  }
+
   if (DTP.is_recording && DTP.timers == NULL) {
     DTP.chunk_count = 1;
     DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
@@ -77,6 +130,8 @@ void DRW_stats_begin(void)
   DTP.is_querying = false;
   DTP.timer_increment = 0;
   DTP.end_increment = 0;
+  DTP.draw_call_len = 0;
+  DTP.triangle_len = 0;
 }
 
 static DRWTimer *drw_stats_timer_get(void)
@@ -98,17 +153,18 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
     BLI_strncpy(timer->name, name, MAX_TIMER_NAME);
     timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
     timer->is_query = is_query;
+    timer->query[0] = 0;
 
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
+      if (DTP.query_pools[0] == NULL) {
+        DTP.query_pools[0] = GPU_querypool_timer_create();
+      }
+      if (DTP.query_pools[0] != NULL) {
+        GPU_querypool_begin(DTP.query_pools[0]);
+        timer->query[0] = ++DTP.query_len[0];
       }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
       DTP.is_querying = true;
     }
   }
@@ -142,11 +198,78 @@ void DRW_stats_query_end(void)
   if (DTP.is_recording) {
     DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    if (DTP.query_pools[0] != NULL) {
+      GPU_querypool_end(DTP.query_pools[0]);
+    }
     DTP.is_querying = false;
   }
 }
 
+void DRW_stats_cpu_time_add(eDRWStatsCPUTime type, double time_ms)
+{
+  DTP.cpu_time[type] += time_ms;
+}
+
+void DRW_stats_draw_call_add(GPUBatch *batch, int vert_count, int inst_count)
+{
+  if (!DTP.is_recording) {
+    return;
+  }
+  if (vert_count == 0 || inst_count == 0) {
+    int batch_vert_count, batch_vert_first, batch_base_index, batch_inst_count;
+    GPU_batch_draw_parameter_get(
+        batch, &batch_vert_count, &batch_vert_first, &batch_base_index, &batch_inst_count);
+    vert_count = (vert_count == 0) ? batch_vert_count : vert_count;
+    inst_count = (inst_count == 0) ? batch_inst_count : inst_count;
+  }
+
+  uint64_t triangle_len = 0;
+  switch (batch->prim_type) {
+    case GPU_PRIM_TRIS:
+      triangle_len = vert_count / 3;
+      break;
+    case GPU_PRIM_TRI_STRIP:
+    case GPU_PRIM_TRI_FAN:
+      triangle_len = max_ii(0, vert_count - 2);
+      break;
+    case GPU_PRIM_TRIS_ADJ:
+      triangle_len = vert_count / 6;
+      break;
+    default:
+      break;
+  }
+  DTP.draw_call_len++;
+  DTP.triangle_len += triangle_len * inst_count;
+}
+
+static void drw_stats_csv_write(void)
+{
+  FILE *file = DTP.csv_file;
+  const int frame = DTP.frame++;
+
+  for (int i = 0; i < DRW_STATS_CPU_TIME_LEN; i++) {
+    fprintf(file, "%d,cpu,%s,%.4f\n", frame, cpu_time_names[i], DTP.cpu_time[i]);
+  }
+  fprintf(file, "%d,count,draw_calls,%u\n", frame, DTP.draw_call_len);
+  fprintf(file, "%d,count,triangles,%llu\n", frame, (unsigned long long)DTP.triangle_len);
+
+  /* GPU results are the ones of the previous frame. Name them using the full timer hierarchy. */
+  const char *lvl_names[MAX_NESTED_TIMER];
+  for (int i = 0; i < DTP.timer_increment; i++) {
+    DRWTimer *timer = &DTP.timers[i];
+    lvl_names[timer->lvl] = timer->name;
+    if (!timer->is_query || frame == 0) {
+      continue;
+    }
+    fprintf(file, "%d,gpu,\"", frame - 1);
+    for (int lvl = 0; lvl <= timer->lvl; lvl++) {
+      fprintf(file, (lvl == 0) ? "%s" : "/%s", lvl_names[lvl]);
+    }
+    fprintf(file, "\",%.4f\n", timer->time_last / 1000000.0);
+  }
+  fflush(file);
+}
+
 void DRW_stats_reset(void)
 {
   BLI_assert((DTP.timer_increment - DTP.end_increment) <= 0 &&
@@ -157,21 +280,27 @@ void DRW_stats_reset(void)
   if (DTP.is_recording) {
     uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
 
+    /* Results of the previous frame queries. Should be available by now. */
+    uint64_t *query_results = NULL;
+    if (DTP.query_pools[1] != NULL && DTP.query_len[1] > 0) {
+      query_results = MEM_mallocN(sizeof(*query_results) * DTP.query_len[1], __func__);
+      GPU_querypool_timer_result_get(DTP.query_pools[1], query_results, DTP.query_len[1]);
+    }
+
     /* Swap queries for the next frame and sum up each lvl time. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
       DRWTimer *timer = &DTP.timers[i];
-      SWAP(uint32_t, timer->query[0], timer->query[1]);
+      SWAP(int, timer->query[0], timer->query[1]);
 
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
       if (timer->is_query) {
         uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
-        }
-        else {
-          time = 1000000000; /* 1ms default */
+        const int query_index = timer->query[0] - 1;
+        if (query_results != NULL && query_index >= 0 && query_index < DTP.query_len[1]) {
+          time = query_results[query_index];
         }
+        timer->time_last = time;
 
         timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
                               time * GPU_TIMER_FALLOFF;
@@ -184,9 +313,24 @@ void DRW_stats_reset(void)
 
       lvl_time[timer->lvl] += timer->time_average;
     }
+    MEM_SAFE_FREE(query_results);
+
+    if (DTP.query_pools[1] != NULL) {
+      GPU_querypool_free(DTP.query_pools[1]);
+    }
+    DTP.query_pools[1] = DTP.query_pools[0];
+    DTP.query_len[1] = DTP.query_len[0];
+    DTP.query_pools[0] = NULL;
+    DTP.query_len[0] = 0;
+
+    if (DTP.csv_file != NULL) {
+      drw_stats_csv_write();
+    }
 
     DTP.is_recording = false;
   }
+
+  memset(DTP.cpu_time, 0, sizeof(DTP.cpu_time));
 }
 
 static void draw_stat_5row(const rcti *rect, int u, int v, const char *txt, const int size)
@@ -11,8 +11,28 @@
 extern "C" {
 #endif
 
+struct GPUBatch;
 struct rcti;
 
+/**
+ * CPU timings of a frame. Always accumulated since some of them are measured before
+ * #DRW_stats_begin. They are only used and cleared by #DRW_stats_reset.
+ */
+typedef enum eDRWStatsCPUTime {
+  /** Object iteration and engines cache population. */
+  DRW_STATS_CPU_SYNC = 0,
+  /** Waiting for the batch cache extraction to finish. */
+  DRW_STATS_CPU_EXTRACTION,
+  /** Engines drawing. */
+  DRW_STATS_CPU_SUBMISSION,
+} eDRWStatsCPUTime;
+#define DRW_STATS_CPU_TIME_LEN (DRW_STATS_CPU_SUBMISSION + 1)
+
+/**
+ * Statistics are recorded for `G.debug_value` between 21 and 30:
+ * - 21 to 29: Draw the overlay, displaying a deeper level of nested timers for each value.
+ * - 30: Append one set of rows per frame to `blender_draw_stats.csv` in the temporary directory.
+ */
 void DRW_stats_free(void);
 void DRW_stats_begin(void);
 void DRW_stats_reset(void);
@@ -30,6 +50,13 @@ void DRW_stats_group_end(void);
 void DRW_stats_query_start(const char *name);
 void DRW_stats_query_end(void);
 
+void DRW_stats_cpu_time_add(eDRWStatsCPUTime type, double time_ms);
+/**
+ * Count a draw call for the statistics. \a vert_count and \a inst_count can be 0 to use the
+ * whole batch, same as #GPU_batch_draw_advanced.
+ */
+void DRW_stats_draw_call_add(struct GPUBatch *batch, int vert_count, int inst_count);
+
 void DRW_stats_draw(const rcti *rect);
 
 #ifdef __cplusplus
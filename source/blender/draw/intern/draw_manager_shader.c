@@ -13,6 +13,7 @@
 
 #include "BLI_dynstr.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_string_utils.h"
 #include "BLI_threads.h"
 
@@ -46,45 +47,61 @@ extern char datatoc_common_fullscreen_vert_glsl[];
 /** \name Deferred Compilation (DRW_deferred)
  *
  * Since compiling shader can take a long time, we do it in a non blocking
- * manner in another thread.
+ * manner in another thread. When every thread can have its own context, materials are compiled
+ * by multiple threads in parallel.
  *
  * \{ */
 
+/** Maximum number of threads that compile materials next to the job thread. */
+#define DRW_SHADER_COMPILER_WORKERS_MAX 3
+
+typedef struct DRWShaderCompileItem {
+  struct DRWShaderCompileItem *next, *prev;
+  GPUMaterial *mat;
+  /** Materials with a higher priority are compiled first, see #DRWManager.load_priority. */
+  float priority;
+} DRWShaderCompileItem;
+
 typedef struct DRWShaderCompiler {
   /** Default compilation queue. */
-  ListBase queue; /* GPUMaterial */
+  ListBase queue; /* DRWShaderCompileItem */
   SpinLock list_lock;
 
   void *gl_context;
   GPUContext *gpu_context;
+  /** Contexts of the worker threads, owned together with the job context. */
+  void *worker_gl_contexts[DRW_SHADER_COMPILER_WORKERS_MAX];
+  GPUContext *worker_gpu_contexts[DRW_SHADER_COMPILER_WORKERS_MAX];
+  int workers_len;
   bool own_context;
 } DRWShaderCompiler;
 
-static void drw_deferred_shader_compilation_exec(
-    void *custom_data,
-    /* Cannot be const, this function implements wm_jobs_start_callback.
-     * NOLINTNEXTLINE: readability-non-const-parameter. */
-    short *stop,
-    short *UNUSED(do_update),
-    float *UNUSED(progress))
-{
-  GPU_render_begin();
-  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
-  void *gl_context = comp->gl_context;
-  GPUContext *gpu_context = comp->gpu_context;
-
-  BLI_assert(gl_context != NULL);
-  BLI_assert(gpu_context != NULL);
+typedef struct DRWShaderCompileWorker {
+  DRWShaderCompiler *comp;
+  void *gl_context;
+  GPUContext *gpu_context;
+  short *stop;
+} DRWShaderCompileWorker;
 
-  const bool use_main_context_workaround = GPU_use_main_context_workaround();
-  if (use_main_context_workaround) {
-    BLI_assert(gl_context == DST.gl_context);
-    GPU_context_main_lock();
+static DRWShaderCompileItem *drw_deferred_shader_queue_pop(DRWShaderCompiler *comp)
+{
+  /* Search from the tail because it will be less likely to lock the main thread
+   * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
+  DRWShaderCompileItem *best = comp->queue.last;
+  for (DRWShaderCompileItem *item = best ? best->prev : NULL; item; item = item->prev) {
+    if (item->priority > best->priority) {
+      best = item;
+    }
   }
+  if (best) {
+    BLI_remlink(&comp->queue, best);
+  }
+  return best;
+}
 
-  WM_opengl_context_activate(gl_context);
-  GPU_context_active_set(gpu_context);
-
+/** Compile queued materials in the active context until the queue is empty. */
+static void drw_deferred_shader_queue_compile(DRWShaderCompiler *comp, const short *stop)
+{
   while (true) {
     if (*stop != 0) {
       /* We don't want user to be able to cancel the compilation
@@ -93,10 +110,8 @@ static void drw_deferred_shader_compilation_exec(
     }
 
     BLI_spin_lock(&comp->list_lock);
-    /* Pop tail because it will be less likely to lock the main thread
-     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    LinkData *link = (LinkData *)BLI_poptail(&comp->queue);
-    GPUMaterial *mat = link ? (GPUMaterial *)link->data : NULL;
+    DRWShaderCompileItem *item = drw_deferred_shader_queue_pop(comp);
+    GPUMaterial *mat = item ? item->mat : NULL;
     if (mat) {
       /* Avoid another thread freeing the material mid compilation. */
       GPU_material_acquire(mat);
@@ -107,7 +122,7 @@ static void drw_deferred_shader_compilation_exec(
       /* Do the compilation. */
       GPU_material_compile(mat);
       GPU_material_release(mat);
-      MEM_freeN(link);
+      MEM_freeN(item);
     }
     else {
       /* No more materials to optimize, or shaders to compile. */
@@ -118,6 +133,67 @@ static void drw_deferred_shader_compilation_exec(
       GPU_flush();
     }
   }
+}
+
+static void *drw_deferred_shader_compilation_worker(void *data)
+{
+  DRWShaderCompileWorker *worker = (DRWShaderCompileWorker *)data;
+
+  GPU_render_begin();
+  WM_opengl_context_activate(worker->gl_context);
+  GPU_context_active_set(worker->gpu_context);
+
+  drw_deferred_shader_queue_compile(worker->comp, worker->stop);
+
+  GPU_context_active_set(NULL);
+  WM_opengl_context_release(worker->gl_context);
+  GPU_render_end();
+  return NULL;
+}
+
+static void drw_deferred_shader_compilation_exec(
+    void *custom_data,
+    /* Cannot be const, this function implements wm_jobs_start_callback.
+     * NOLINTNEXTLINE: readability-non-const-parameter. */
+    short *stop,
+    short *UNUSED(do_update),
+    float *UNUSED(progress))
+{
+  GPU_render_begin();
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
+  void *gl_context = comp->gl_context;
+  GPUContext *gpu_context = comp->gpu_context;
+
+  BLI_assert(gl_context != NULL);
+  BLI_assert(gpu_context != NULL);
+
+  const bool use_main_context_workaround = GPU_use_main_context_workaround();
+  if (use_main_context_workaround) {
+    BLI_assert(gl_context == DST.gl_context);
+    GPU_context_main_lock();
+  }
+
+  WM_opengl_context_activate(gl_context);
+  GPU_context_active_set(gpu_context);
+
+  ListBase threads;
+  DRWShaderCompileWorker workers[DRW_SHADER_COMPILER_WORKERS_MAX];
+  if (comp->workers_len > 0) {
+    BLI_threadpool_init(&threads, drw_deferred_shader_compilation_worker, comp->workers_len);
+    for (int i = 0; i < comp->workers_len; i++) {
+      workers[i].comp = comp;
+      workers[i].gl_context = comp->worker_gl_contexts[i];
+      workers[i].gpu_context = comp->worker_gpu_contexts[i];
+      workers[i].stop = stop;
+      BLI_threadpool_insert(&threads, &workers[i]);
+    }
+  }
+
+  drw_deferred_shader_queue_compile(comp, stop);
+
+  if (comp->workers_len > 0) {
+    BLI_threadpool_end(&threads);
+  }
 
   GPU_context_active_set(NULL);
   WM_opengl_context_release(gl_context);
@@ -142,12 +218,31 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
     GPU_context_discard(comp->gpu_context);
     WM_opengl_context_dispose(comp->gl_context);
 
+    for (int i = 0; i < comp->workers_len; i++) {
+      WM_opengl_context_activate(comp->worker_gl_contexts[i]);
+      GPU_context_active_set(comp->worker_gpu_contexts[i]);
+      GPU_context_discard(comp->worker_gpu_contexts[i]);
+      WM_opengl_context_dispose(comp->worker_gl_contexts[i]);
+    }
+
     wm_window_reset_drawable();
   }
 
   MEM_freeN(comp);
 }
 
+/**
+ * Number of threads that compile materials next to the job thread, each of them needs its own
+ * context. Use about half of the cores, other threads are still needed to keep Blender responsive.
+ */
+static int drw_deferred_shader_workers_len(void)
+{
+  if (!GPU_type_matches_ex(GPU_DEVICE_ANY, GPU_OS_ANY, GPU_DRIVER_ANY, GPU_BACKEND_OPENGL)) {
+    return 0;
+  }
+  return clamp_i(BLI_system_thread_count() / 2 - 1, 0, DRW_SHADER_COMPILER_WORKERS_MAX);
+}
+
 static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 {
   if (ELEM(GPU_material_status(mat), GPU_MAT_SUCCESS, GPU_MAT_FAILED)) {
@@ -201,14 +296,23 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
     if (old_comp->gl_context) {
       comp->gl_context = old_comp->gl_context;
       comp->gpu_context = old_comp->gpu_context;
+      comp->workers_len = old_comp->workers_len;
+      memcpy(comp->worker_gl_contexts,
+             old_comp->worker_gl_contexts,
+             sizeof(comp->worker_gl_contexts));
+      memcpy(comp->worker_gpu_contexts,
+             old_comp->worker_gpu_contexts,
+             sizeof(comp->worker_gpu_contexts));
       old_comp->own_context = false;
       comp->own_context = job_own_context;
     }
   }
 
   GPU_material_status_set(mat, GPU_MAT_QUEUED);
-  LinkData *node = BLI_genericNodeN(mat);
-  BLI_addtail(&comp->queue, node);
+  DRWShaderCompileItem *item = MEM_callocN(sizeof(DRWShaderCompileItem), __func__);
+  item->mat = mat;
+  item->priority = DST.load_priority;
+  BLI_addtail(&comp->queue, item);
 
   /* Create only one context. */
   if (comp->gl_context == NULL) {
@@ -221,6 +325,13 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
       comp->gpu_context = GPU_context_create(NULL, comp->gl_context);
       GPU_context_active_set(NULL);
 
+      comp->workers_len = drw_deferred_shader_workers_len();
+      for (int i = 0; i < comp->workers_len; i++) {
+        comp->worker_gl_contexts[i] = WM_opengl_context_create();
+        comp->worker_gpu_contexts[i] = GPU_context_create(NULL, comp->worker_gl_contexts[i]);
+        GPU_context_active_set(NULL);
+      }
+
       WM_opengl_context_activate(DST.gl_context);
       GPU_context_active_set(DST.gpu_context);
     }
@@ -283,14 +394,15 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
         BLI_spin_lock(&comp->list_lock);
 
         /* Search for compilation job in queue. */
-        LinkData *link = (LinkData *)BLI_findptr(&comp->queue, mat, offsetof(LinkData, data));
-        if (link) {
-          BLI_remlink(&comp->queue, link);
-          GPU_material_status_set(link->data, GPU_MAT_CREATED);
+        DRWShaderCompileItem *item = (DRWShaderCompileItem *)BLI_findptr(
+            &comp->queue, mat, offsetof(DRWShaderCompileItem, mat));
+        if (item) {
+          BLI_remlink(&comp->queue, item);
+          GPU_material_status_set(item->mat, GPU_MAT_CREATED);
         }
         BLI_spin_unlock(&comp->list_lock);
 
-        MEM_SAFE_FREE(link);
+        MEM_SAFE_FREE(item);
       }
     }
   }
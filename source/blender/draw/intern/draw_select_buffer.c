@@ -12,11 +12,17 @@
 #include "BLI_array_utils.h"
 #include "BLI_bitmap.h"
 #include "BLI_bitmap_draw_2d.h"
+#include "BLI_math_base.h"
 #include "BLI_rect.h"
 
 #include "DNA_screen_types.h"
 
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
 #include "GPU_select.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_storage_buffer.h"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
@@ -106,6 +112,95 @@ uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
  *
  * \{ */
 
+static bool select_buffer_bitmap_use_gpu(void)
+{
+  return GPU_compute_shader_support() && GPU_shader_storage_buffer_objects_support();
+}
+
+/**
+ * Resolve the bitmap of the elements visible inside \a rect directly from the ID texture, so
+ * that only the bitmap is read back instead of every pixel of the rectangle.
+ * Only the pixels inside the circle defined by \a center and \a radius are tested if
+ * \a radius is not zero.
+ */
+static uint *select_buffer_bitmap_from_rect_gpu(struct Depsgraph *depsgraph,
+                                                struct ARegion *region,
+                                                struct View3D *v3d,
+                                                const rcti *rect,
+                                                const int center[2],
+                                                const int radius,
+                                                uint *r_bitmap_len)
+{
+  BLI_bitmap *bitmap_buf = NULL;
+  uint bitmap_len = 0;
+
+  /* Clamp rect. Pixels outside of the viewport do not contain any ID. */
+  rcti r = {
+      .xmin = 0,
+      .xmax = region->winx,
+      .ymin = 0,
+      .ymax = region->winy,
+  };
+
+  rcti rect_clamp = *rect;
+  if (BLI_rcti_isect(&r, &rect_clamp, &rect_clamp)) {
+    struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
+
+    DRW_opengl_context_enable();
+    /* Update the drawing. */
+    DRW_draw_select_id(depsgraph, region, v3d, rect);
+    /* The texture cannot be attached to the bound frame-buffer while being sampled. */
+    GPU_framebuffer_restore();
+
+    if (select_ctx->index_drawn_len > 1) {
+      GPUTexture *select_id_tx = DRW_engine_select_texture_get();
+      BLI_assert(region->winx == GPU_texture_width(select_id_tx) &&
+                 region->winy == GPU_texture_height(select_id_tx));
+
+      bitmap_len = select_ctx->index_drawn_len - 1;
+      /* Keep the size a multiple of 16 bytes as required for storage buffers. The padding bits
+       * are never set since no index is greater than `bitmap_len`. */
+      const size_t bitmap_size = ceil_to_multiple_ul(BLI_BITMAP_SIZE(bitmap_len), 16);
+      bitmap_buf = MEM_callocN(bitmap_size, __func__);
+
+      GPUStorageBuf *bitmap_ssbo = GPU_storagebuf_create_ex(
+          bitmap_size, NULL, GPU_USAGE_DEVICE_ONLY, __func__);
+      GPU_storagebuf_clear_to_zero(bitmap_ssbo);
+
+      GPUShader *shader = DRW_engine_select_bitmap_shader_get();
+      GPU_shader_bind(shader);
+      GPU_shader_uniform_2iv(shader, "rect_min", (const int[2]){rect_clamp.xmin, rect_clamp.ymin});
+      GPU_shader_uniform_2iv(shader, "rect_max", (const int[2]){rect_clamp.xmax, rect_clamp.ymax});
+      GPU_shader_uniform_2iv(shader, "center", (center) ? center : (const int[2]){0, 0});
+      GPU_shader_uniform_1i(shader, "radius", radius);
+      GPU_shader_uniform_1i(shader, "bitmap_len", (int)bitmap_len);
+      GPU_texture_bind(select_id_tx, 0);
+      GPU_storagebuf_bind(bitmap_ssbo, 0);
+
+      GPU_compute_dispatch(shader,
+                           divide_ceil_u(BLI_rcti_size_x(&rect_clamp), 16),
+                           divide_ceil_u(BLI_rcti_size_y(&rect_clamp), 16),
+                           1);
+      GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE);
+
+      GPU_storagebuf_read(bitmap_ssbo, bitmap_buf);
+
+      GPU_texture_unbind(select_id_tx);
+      GPU_storagebuf_unbind(bitmap_ssbo);
+      GPU_shader_unbind();
+      GPU_storagebuf_free(bitmap_ssbo);
+    }
+
+    DRW_opengl_context_disable();
+  }
+
+  if (r_bitmap_len) {
+    *r_bitmap_len = bitmap_len;
+  }
+
+  return bitmap_buf;
+}
+
 uint *DRW_select_buffer_bitmap_from_rect(struct Depsgraph *depsgraph,
                                          struct ARegion *region,
                                          struct View3D *v3d,
@@ -118,6 +213,11 @@ uint *DRW_select_buffer_bitmap_from_rect(struct Depsgraph *depsgraph,
   rect_px.xmax += 1;
   rect_px.ymax += 1;
 
+  if (select_buffer_bitmap_use_gpu()) {
+    return select_buffer_bitmap_from_rect_gpu(
+        depsgraph, region, v3d, &rect_px, NULL, 0, r_bitmap_len);
+  }
+
   uint buf_len;
   uint *buf = DRW_select_buffer_read(depsgraph, region, v3d, &rect_px, &buf_len);
   if (buf == NULL) {
@@ -161,6 +261,11 @@ uint *DRW_select_buffer_bitmap_from_circle(struct Depsgraph *depsgraph,
       .ymax = center[1] + radius + 1,
   };
 
+  if (select_buffer_bitmap_use_gpu()) {
+    return select_buffer_bitmap_from_rect_gpu(
+        depsgraph, region, v3d, &rect, center, radius, r_bitmap_len);
+  }
+
   const uint *buf = DRW_select_buffer_read(depsgraph, region, v3d, &rect, NULL);
 
   if (buf == NULL) {
@@ -461,6 +566,16 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
 {
   struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
+  /* Operators create a new context on every hover or click. Keep the ID buffer that was drawn
+   * for the previous one if it contains the same objects, the engine invalidates it if the view
+   * or any of the objects changed since. A `select_mode` of -1 is resolved by the engine, so it
+   * cannot be compared. */
+  bool is_same_context = (select_mode != -1) && (select_mode == select_ctx->select_mode) &&
+                         (bases_len == select_ctx->objects_len);
+  for (uint base_index = 0; is_same_context && base_index < bases_len; base_index++) {
+    is_same_context = (bases[base_index]->object == select_ctx->objects[base_index]);
+  }
+
   select_ctx->objects = MEM_reallocN(select_ctx->objects,
                                      sizeof(*select_ctx->objects) * bases_len);
 
@@ -478,6 +593,10 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
     obj->runtime.select_id = base_index;
   }
 
+  if (is_same_context) {
+    return;
+  }
+
   select_ctx->objects_len = bases_len;
   select_ctx->select_mode = select_mode;
   memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
@@ -24,6 +24,7 @@ static struct {
   struct GPUShader *debug_print_display_sh;
   struct GPUShader *debug_draw_display_sh;
   struct GPUShader *draw_visibility_compute_sh;
+  struct GPUShader *draw_visibility_occlusion_compute_sh;
   struct GPUShader *draw_resource_finalize_sh;
   struct GPUShader *draw_command_generate_sh;
 } e_data = {{nullptr}};
@@ -135,6 +136,15 @@ GPUShader *DRW_shader_draw_visibility_compute_get()
   return e_data.draw_visibility_compute_sh;
 }
 
+GPUShader *DRW_shader_draw_visibility_occlusion_compute_get()
+{
+  if (e_data.draw_visibility_occlusion_compute_sh == nullptr) {
+    e_data.draw_visibility_occlusion_compute_sh = GPU_shader_create_from_info_name(
+        "draw_visibility_occlusion_compute");
+  }
+  return e_data.draw_visibility_occlusion_compute_sh;
+}
+
 GPUShader *DRW_shader_draw_resource_finalize_get()
 {
   if (e_data.draw_resource_finalize_sh == nullptr) {
@@ -161,6 +171,7 @@ void DRW_shaders_free()
   DRW_SHADER_FREE_SAFE(e_data.debug_print_display_sh);
   DRW_SHADER_FREE_SAFE(e_data.debug_draw_display_sh);
   DRW_SHADER_FREE_SAFE(e_data.draw_visibility_compute_sh);
+  DRW_SHADER_FREE_SAFE(e_data.draw_visibility_occlusion_compute_sh);
   DRW_SHADER_FREE_SAFE(e_data.draw_resource_finalize_sh);
   DRW_SHADER_FREE_SAFE(e_data.draw_command_generate_sh);
 }
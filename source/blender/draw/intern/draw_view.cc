@@ -241,9 +241,17 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
   GPU_storagebuf_clear(visibility_buf_, GPU_R32UI, GPU_DATA_UINT, &data);
 
   if (do_visibility_) {
-    GPUShader *shader = DRW_shader_draw_visibility_compute_get();
+    /* Occlusion culling is disabled when freezing the culling as the depth buffer would not match
+     * the frozen matrices. */
+    const bool use_occlusion = (hiz_tx_ != nullptr) && !frozen_;
+    GPUShader *shader = use_occlusion ? DRW_shader_draw_visibility_occlusion_compute_get() :
+                                        DRW_shader_draw_visibility_compute_get();
     GPU_shader_bind(shader);
     GPU_shader_uniform_1i(shader, "resource_len", resource_len);
+    if (use_occlusion) {
+      GPU_shader_uniform_2fv(shader, "hiz_uv_scale", hiz_uv_scale_);
+      GPU_texture_bind(hiz_tx_, GPU_shader_get_texture_binding(shader, "hiz_tx"));
+    }
     GPU_storagebuf_bind(bounds, GPU_shader_get_ssbo(shader, "bounds_buf"));
     GPU_storagebuf_bind(visibility_buf_, GPU_shader_get_ssbo(shader, "visibility_buf"));
     GPU_uniformbuf_bind((frozen_) ? data_freeze_ : data_, DRW_VIEW_UBO_SLOT);
@@ -32,6 +32,9 @@ class View {
   UniformBuffer<ViewCullingData> culling_freeze_;
   /** Result of the visibility computation. 1 bit per resource ID. */
   VisibilityBuf visibility_buf_;
+  /** Optional hierarchical max depth buffer used to cull occluded resources. Not owned. */
+  GPUTexture *hiz_tx_ = nullptr;
+  float2 hiz_uv_scale_ = float2(1.0f);
 
   const char *debug_name_;
 
@@ -53,6 +56,18 @@ class View {
 
   void sync(const float4x4 &view_mat, const float4x4 &win_mat);
 
+  /**
+   * Enable occlusion culling against a hierarchical depth buffer during the next visibility
+   * computations. The texture must store the maximum depth of each texel footprint in its mips
+   * and must have been rendered with this view's matrices.  uv_scale maps the view's UV space
+   * to the used area of the texture. Pass nullptr to disable.
+   */
+  void set_occlusion_culling(GPUTexture *hiz_tx, float2 uv_scale = float2(1.0f))
+  {
+    hiz_tx_ = hiz_tx;
+    hiz_uv_scale_ = uv_scale;
+  }
+
   bool is_persp() const
   {
     return data_.winmat[3][3] == 0.0f;
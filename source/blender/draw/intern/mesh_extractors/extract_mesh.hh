@@ -399,6 +399,21 @@ void mesh_render_data_loop_edge_flag(const MeshRenderData *mr,
                                      int cd_ofs,
                                      EditLoopData *eattr);
 
+namespace blender::draw {
+
+/**
+ * Whether #extract_pos_nor_gpu can be used instead of the #extract_pos_nor extractor, depending
+ * on the GPU capabilities and the size of the mesh.
+ */
+bool extract_pos_nor_gpu_supported(const MeshRenderData *mr);
+/**
+ * Fill the position and normal buffer with a compute shader. Unlike the extractors running in the
+ * task graph, this needs an active GPU context.
+ */
+void extract_pos_nor_gpu(MeshRenderData *mr, MeshBufferCache *mbc, GPUVertBuf *vbo);
+
+}  // namespace blender::draw
+
 extern const MeshExtract extract_tris;
 extern const MeshExtract extract_tris_single_mat;
 extern const MeshExtract extract_lines;
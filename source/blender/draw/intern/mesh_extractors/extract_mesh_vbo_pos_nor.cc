@@ -7,10 +7,23 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
+#include "BLI_task.hh"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_storage_buffer.h"
+
 #include "extract_mesh.hh"
 
+#include "draw_cache.h"
 #include "draw_subdivision.h"
 
+extern "C" char datatoc_common_mesh_extract_pos_nor_comp_glsl[];
+
 namespace blender::draw {
 
 /* ---------------------------------------------------------------------- */
@@ -27,12 +40,8 @@ struct MeshExtract_PosNor_Data {
   GPUNormal *normals;
 };
 
-static void extract_pos_nor_init(const MeshRenderData *mr,
-                                 MeshBatchCache * /*cache*/,
-                                 void *buf,
-                                 void *tls_data)
+static GPUVertFormat *get_pos_nor_format()
 {
-  GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buf);
   static GPUVertFormat format = {0};
   if (format.attr_len == 0) {
     /* WARNING Adjust #PosNorLoop struct accordingly. */
@@ -40,7 +49,16 @@ static void extract_pos_nor_init(const MeshRenderData *mr,
     GPU_vertformat_attr_add(&format, "nor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
     GPU_vertformat_alias_add(&format, "vnor");
   }
-  GPU_vertbuf_init_with_format(vbo, &format);
+  return &format;
+}
+
+static void extract_pos_nor_init(const MeshRenderData *mr,
+                                 MeshBatchCache * /*cache*/,
+                                 void *buf,
+                                 void *tls_data)
+{
+  GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buf);
+  GPU_vertbuf_init_with_format(vbo, get_pos_nor_format());
   GPU_vertbuf_data_alloc(vbo, mr->loop_len + mr->loop_loose_len);
 
   /* Pack normals per vert, reduce amount of computation. */
@@ -358,6 +376,135 @@ constexpr MeshExtract create_extractor_pos_nor()
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Extract Position and Vertex Normal on the GPU
+ *
+ * For large meshes the data of every loop is gathered by a compute shader, which avoids writing
+ * the whole buffer on the CPU. Only the vertex and loop arrays of the mesh are uploaded, together
+ * with the packed vertex normals and the loose geometry indices.
+ * \{ */
+
+/** Smaller meshes are extracted on the CPU, together with the other buffers. */
+#define MIN_GPU_EXTRACT_LOOP_LEN (1 << 16)
+#define GPU_EXTRACT_LOCAL_WORK_GROUP_SIZE 64
+
+static GPUShader *g_pos_nor_shader = nullptr;
+
+bool extract_pos_nor_gpu_supported(const MeshRenderData *mr)
+{
+  /* Hidden faces change the flag of all their loops, which can't be stored per vertex. */
+  return mr->extract_type == MR_EXTRACT_MESH && mr->hide_poly == nullptr &&
+         mr->loop_len >= MIN_GPU_EXTRACT_LOOP_LEN && GPU_compute_shader_support() &&
+         GPU_shader_storage_buffer_objects_support();
+}
+
+static void extract_pos_nor_gpu_dispatch(GPUShader *shader, const int dispatch_len)
+{
+  const uint max_res_x = uint(GPU_max_work_group_count(0));
+  const uint groups_len = divide_ceil_u(uint(dispatch_len), GPU_EXTRACT_LOCAL_WORK_GROUP_SIZE);
+  uint dispatch_rx = groups_len;
+  uint dispatch_ry = 1u;
+  if (dispatch_rx > max_res_x) {
+    /* Split the groups in two dimensions, see #drw_subdiv_compute_dispatch. */
+    dispatch_rx = dispatch_ry = ceilf(sqrtf(groups_len));
+    if ((dispatch_rx * (dispatch_ry - 1)) >= groups_len) {
+      dispatch_ry -= 1;
+    }
+  }
+
+  GPU_shader_uniform_1i(shader, "dispatch_len", dispatch_len);
+  GPU_compute_dispatch(shader, dispatch_rx, dispatch_ry, 1);
+}
+
+void extract_pos_nor_gpu(MeshRenderData *mr, MeshBufferCache *mbc, GPUVertBuf *vbo)
+{
+  mesh_render_data_update_normals(mr, MR_DATA_NONE);
+  mesh_render_data_update_loose_geom(mr, mbc, MR_ITER_LEDGE | MR_ITER_LVERT, MR_DATA_NONE);
+
+  /* Pack normals per vertex, together with the flag for paint mode overlay, see
+   * #extract_pos_nor_iter_poly_mesh. */
+  Array<GPUPackedNormal> vert_normals(mr->vert_len);
+  threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+    for (const int v : range) {
+      GPUPackedNormal &nor = vert_normals[v];
+      nor = GPU_normal_convert_i10_v3(mr->vert_normals[v]);
+      if ((mr->hide_vert && mr->hide_vert[v]) ||
+          (mr->v_origindex && mr->v_origindex[v] == ORIGINDEX_NONE)) {
+        nor.w = -1;
+      }
+      else if (mr->select_vert && mr->select_vert[v]) {
+        nor.w = 1;
+      }
+      else {
+        nor.w = 0;
+      }
+    }
+  });
+
+  GPU_vertbuf_init_build_on_device(vbo, get_pos_nor_format(), mr->loop_len + mr->loop_loose_len);
+
+  if (g_pos_nor_shader == nullptr) {
+    g_pos_nor_shader = GPU_shader_create_compute(
+        datatoc_common_mesh_extract_pos_nor_comp_glsl, nullptr, nullptr, "mesh_extract_pos_nor");
+  }
+  GPUShader *shader = g_pos_nor_shader;
+  GPU_shader_bind(shader);
+
+  GPUStorageBuf *verts_buf = GPU_storagebuf_create_ex(
+      sizeof(MVert) * mr->vert_len, mr->mvert, GPU_USAGE_STREAM, __func__);
+  GPUStorageBuf *normals_buf = GPU_storagebuf_create_ex(
+      sizeof(GPUPackedNormal) * mr->vert_len, vert_normals.data(), GPU_USAGE_STREAM, __func__);
+  GPUStorageBuf *loops_buf = GPU_storagebuf_create_ex(
+      sizeof(MLoop) * mr->loop_len, mr->mloop, GPU_USAGE_STREAM, __func__);
+  GPU_storagebuf_bind(verts_buf, 0);
+  GPU_storagebuf_bind(normals_buf, 1);
+  GPU_storagebuf_bind(loops_buf, 2);
+  GPU_vertbuf_bind_as_ssbo(vbo, 3);
+
+  GPU_shader_uniform_1i(shader, "vert_stride", sizeof(MVert) / sizeof(float));
+  GPU_shader_uniform_1i(shader, "vert_index_stride", sizeof(MLoop) / sizeof(uint));
+  GPU_shader_uniform_1i(shader, "dst_offset", 0);
+  GPU_shader_uniform_1b(shader, "use_vert_flag", true);
+  extract_pos_nor_gpu_dispatch(shader, mr->loop_len);
+
+  GPUStorageBuf *loose_buf = nullptr;
+  if (mr->loop_loose_len > 0) {
+    Array<uint> loose_vert_indices(mr->loop_loose_len);
+    for (const int i : IndexRange(mr->edge_loose_len)) {
+      const MEdge &edge = mr->medge[mr->ledges[i]];
+      loose_vert_indices[i * 2] = edge.v1;
+      loose_vert_indices[i * 2 + 1] = edge.v2;
+    }
+    for (const int i : IndexRange(mr->vert_loose_len)) {
+      loose_vert_indices[mr->edge_loose_len * 2 + i] = uint(mr->lverts[i]);
+    }
+    loose_buf = GPU_storagebuf_create_ex(loose_vert_indices.as_span().size_in_bytes(),
+                                         loose_vert_indices.data(),
+                                         GPU_USAGE_STREAM,
+                                         __func__);
+    GPU_storagebuf_bind(loose_buf, 2);
+
+    /* Loose geometry doesn't use the paint mode flag. */
+    GPU_shader_uniform_1i(shader, "vert_index_stride", 1);
+    GPU_shader_uniform_1i(shader, "dst_offset", mr->loop_len);
+    GPU_shader_uniform_1b(shader, "use_vert_flag", false);
+    extract_pos_nor_gpu_dispatch(shader, mr->loop_loose_len);
+  }
+
+  /* This generates a vertex buffer, so we need to put a barrier on the vertex attribute array. */
+  GPU_memory_barrier(GPU_BARRIER_VERTEX_ATTRIB_ARRAY);
+  GPU_shader_unbind();
+
+  GPU_storagebuf_free(verts_buf);
+  GPU_storagebuf_free(normals_buf);
+  GPU_storagebuf_free(loops_buf);
+  if (loose_buf) {
+    GPU_storagebuf_free(loose_buf);
+  }
+}
+
+/** \} */
+
 /* ---------------------------------------------------------------------- */
 /** \name Extract Position and High Quality Vertex Normal
  * \{ */
@@ -555,5 +702,13 @@ constexpr MeshExtract create_extractor_pos_nor_hq()
 
 }  // namespace blender::draw
 
+void DRW_mesh_extract_free()
+{
+  if (blender::draw::g_pos_nor_shader) {
+    GPU_shader_free(blender::draw::g_pos_nor_shader);
+    blender::draw::g_pos_nor_shader = nullptr;
+  }
+}
+
 const MeshExtract extract_pos_nor = blender::draw::create_extractor_pos_nor();
 const MeshExtract extract_pos_nor_hq = blender::draw::create_extractor_pos_nor_hq();
@@ -192,7 +192,7 @@ static void extract_tan_ex_init(const MeshRenderData *mr,
     short(*tan_data)[4] = (short(*)[4])GPU_vertbuf_get_data(vbo);
     for (int i = 0; i < tan_len; i++) {
       const char *name = tangent_names[i];
-      float(*layer_data)[4] = (float(*)[4])CustomData_get_layer_named(
+      const float(*layer_data)[4] = (const float(*)[4])CustomData_get_layer_named(
           &loop_data, CD_TANGENT, name);
       for (int ml_index = 0; ml_index < mr->loop_len; ml_index++) {
         normal_float_to_short_v3(*tan_data, layer_data[ml_index]);
@@ -201,7 +201,8 @@ static void extract_tan_ex_init(const MeshRenderData *mr,
       }
     }
     if (use_orco_tan) {
-      float(*layer_data)[4] = (float(*)[4])CustomData_get_layer_n(&loop_data, CD_TANGENT, 0);
+      const float(*layer_data)[4] = (const float(*)[4])CustomData_get_layer_n(
+          &loop_data, CD_TANGENT, 0);
       for (int ml_index = 0; ml_index < mr->loop_len; ml_index++) {
         normal_float_to_short_v3(*tan_data, layer_data[ml_index]);
         (*tan_data)[3] = (layer_data[ml_index][3] > 0.0f) ? SHRT_MAX : SHRT_MIN;
@@ -213,7 +214,7 @@ static void extract_tan_ex_init(const MeshRenderData *mr,
     GPUPackedNormal *tan_data = (GPUPackedNormal *)GPU_vertbuf_get_data(vbo);
     for (int i = 0; i < tan_len; i++) {
       const char *name = tangent_names[i];
-      float(*layer_data)[4] = (float(*)[4])CustomData_get_layer_named(
+      const float(*layer_data)[4] = (const float(*)[4])CustomData_get_layer_named(
           &loop_data, CD_TANGENT, name);
       for (int ml_index = 0; ml_index < mr->loop_len; ml_index++) {
         *tan_data = GPU_normal_convert_i10_v3(layer_data[ml_index]);
@@ -222,7 +223,8 @@ static void extract_tan_ex_init(const MeshRenderData *mr,
       }
     }
     if (use_orco_tan) {
-      float(*layer_data)[4] = (float(*)[4])CustomData_get_layer_n(&loop_data, CD_TANGENT, 0);
+      const float(*layer_data)[4] = (const float(*)[4])CustomData_get_layer_n(
+          &loop_data, CD_TANGENT, 0);
       for (int ml_index = 0; ml_index < mr->loop_len; ml_index++) {
         *tan_data = GPU_normal_convert_i10_v3(layer_data[ml_index]);
         tan_data->w = (layer_data[ml_index][3] > 0.0f) ? 1 : -2;
@@ -0,0 +1,63 @@
+
+/* Gather the position and packed normal of the vertex used by every loop of a mesh. */
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+/* #MVert array, only the position is read. */
+layout(std430, binding = 0) readonly restrict buffer sourceVerts
+{
+  float verts[];
+};
+
+/* #GPUPackedNormal of every vertex, including the paint mode flag. */
+layout(std430, binding = 1) readonly restrict buffer sourceNormals
+{
+  uint vert_normals[];
+};
+
+/* Vertex index of every output vertex, e.g. the #MLoop array. */
+layout(std430, binding = 2) readonly restrict buffer sourceVertIndices
+{
+  uint vert_indices[];
+};
+
+/* Same layout as #PosNorLoop. */
+struct PosNorLoop {
+  float pos[3];
+  uint nor;
+};
+
+layout(std430, binding = 3) writeonly restrict buffer outputPosNor
+{
+  PosNorLoop pos_nor[];
+};
+
+/* Number of values per element of the source buffers. */
+uniform int vert_stride;
+uniform int vert_index_stride;
+uniform int dst_offset;
+uniform int dispatch_len;
+uniform bool use_vert_flag;
+
+void main()
+{
+  uint invocations_per_row = gl_WorkGroupSize.x * gl_NumWorkGroups.x;
+  uint index = gl_GlobalInvocationID.x + gl_GlobalInvocationID.y * invocations_per_row;
+  if (index >= uint(dispatch_len)) {
+    return;
+  }
+
+  uint vert = vert_indices[index * uint(vert_index_stride)];
+  uint co = vert * uint(vert_stride);
+
+  PosNorLoop data;
+  data.pos[0] = verts[co];
+  data.pos[1] = verts[co + 1];
+  data.pos[2] = verts[co + 2];
+  data.nor = vert_normals[vert];
+  if (!use_vert_flag) {
+    /* Clear the 2 bits of the W component. */
+    data.nor &= 0x3FFFFFFFu;
+  }
+  pos_nor[uint(dst_offset) + index] = data;
+}
@@ -169,6 +169,13 @@ GPU_SHADER_CREATE_INFO(draw_visibility_compute)
     .compute_source("draw_visibility_comp.glsl")
     .additional_info("draw_view", "draw_view_culling");
 
+GPU_SHADER_CREATE_INFO(draw_visibility_occlusion_compute)
+    .do_static_compilation(true)
+    .define("DRW_OCCLUSION_CULLING")
+    .sampler(0, ImageType::FLOAT_2D, "hiz_tx")
+    .push_constant(Type::VEC2, "hiz_uv_scale")
+    .additional_info("draw_visibility_compute");
+
 GPU_SHADER_CREATE_INFO(draw_command_generate)
     .do_static_compilation(true)
     .typedef_source("draw_shader_shared.h")
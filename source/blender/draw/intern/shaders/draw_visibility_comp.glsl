@@ -1,8 +1,12 @@
 
 /**
  * Compute visibility of each resource bounds for a given view.
+ *
+ * If DRW_OCCLUSION_CULLING is defined, resources that passed the frustum test are also tested
+ * against a hierarchical max depth buffer. The depth buffer must come from an earlier pass of the
+ * same frame (e.g. a depth pre-pass). Otherwise, the 2 pass scheme using the previous frame
+ * depth is needed to avoid missing newly disoccluded resources.
  */
-/* TODO(fclem): This could be augmented by a 2 pass occlusion culling system. */
 
 #pragma BLENDER_REQUIRE(common_math_lib.glsl)
 #pragma BLENDER_REQUIRE(common_intersect_lib.glsl)
@@ -15,6 +19,49 @@ void mask_visibility_bit()
   atomicAnd(visibility_buf[gl_WorkGroupID.x], ~bit);
 }
 
+#ifdef DRW_OCCLUSION_CULLING
+bool is_occluded(IsectBox box)
+{
+  mat4 persmat = drw_view.winmat * drw_view.viewmat;
+  vec2 uv_min = vec2(1.0);
+  vec2 uv_max = vec2(0.0);
+  float depth_min = 1.0;
+  for (int i = 0; i < 8; i++) {
+    vec4 hs_corner = persmat * vec4(box.corners[i], 1.0);
+    if (hs_corner.w <= 0.0) {
+      /* Box crosses the camera plane. Projection is not reliable. */
+      return false;
+    }
+    vec3 ss_corner = (hs_corner.xyz / hs_corner.w) * 0.5 + 0.5;
+    uv_min = min(uv_min, ss_corner.xy);
+    uv_max = max(uv_max, ss_corner.xy);
+    depth_min = min(depth_min, ss_corner.z);
+  }
+  /* Parts outside of the view cannot be visible. */
+  uv_min = clamp(uv_min, 0.0, 1.0) * hiz_uv_scale;
+  uv_max = clamp(uv_max, 0.0, 1.0) * hiz_uv_scale;
+
+  /* Select the mip level where the screen rectangle touches at most 2x2 texels. */
+  vec2 extent_texel = (uv_max - uv_min) * vec2(textureSize(hiz_tx, 0));
+  int lod_max = textureQueryLevels(hiz_tx) - 1;
+  int lod = clamp(int(ceil(log2(max(max_v2(extent_texel), 1.0)))), 0, lod_max);
+
+  ivec2 lod_size = textureSize(hiz_tx, lod);
+  ivec2 texel_min = clamp(ivec2(uv_min * vec2(lod_size)), ivec2(0), lod_size - 1);
+  ivec2 texel_max = clamp(ivec2(uv_max * vec2(lod_size)), ivec2(0), lod_size - 1);
+  if (any(greaterThan(texel_max - texel_min, ivec2(1)))) {
+    /* Rectangle is too big for the smallest mip. Testing only the corners would be wrong. */
+    return false;
+  }
+
+  float hiz_depth = max(max(texelFetch(hiz_tx, texel_min, lod).r,
+                            texelFetch(hiz_tx, ivec2(texel_max.x, texel_min.y), lod).r),
+                        max(texelFetch(hiz_tx, ivec2(texel_min.x, texel_max.y), lod).r,
+                            texelFetch(hiz_tx, texel_max, lod).r));
+  return depth_min > hiz_depth;
+}
+#endif
+
 void main()
 {
   if (gl_GlobalInvocationID.x >= resource_len) {
@@ -42,5 +89,11 @@ void main()
       /* Not visible. */
       mask_visibility_bit();
     }
+#ifdef DRW_OCCLUSION_CULLING
+    if (is_occluded(box)) {
+      /* Hidden behind already rendered depth. */
+      mask_visibility_bit();
+    }
+#endif
   }
 }
@@ -4,9 +4,18 @@
  * \ingroup edasset
  */
 
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iomanip>
 #include <optional>
+#include <sstream>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
 
 #include "ED_asset_indexer.h"
 
@@ -16,6 +25,8 @@
 #include "BLI_fileops.h"
 #include "BLI_hash.hh"
 #include "BLI_linklist.h"
+#include "BLI_map.hh"
+#include "BLI_mmap.h"
 #include "BLI_path_util.h"
 #include "BLI_serialize.hh"
 #include "BLI_set.hh"
@@ -416,6 +427,186 @@ static int init_indexer_entries_from_value(FileIndexerEntries &indexer_entries,
  * used indices are removed from the list and when reading is finished the unused
  * indices are removed.
  */
+/**
+ * \brief Single file containing the indices of all asset files of an asset library.
+ *
+ * Opening and parsing a separate index file for every asset file is slow for libraries with
+ * thousands of files. Therefore the contents of all indices that were used while listing the
+ * library are also packed into `{indices_base_path}/library.index.pack` when the listing has
+ * finished. The next listing maps this file into memory once, and uses the packed index of an
+ * asset file as long as the modification time of the asset file didn't change. The separate
+ * index files remain the fallback.
+ *
+ * The file is a local cache, so it uses the native byte order:
+ * \code
+ * char[8] magic ("BAIPACK1")
+ * uint32 entries_num
+ * entries_num times:
+ *   int64 asset_file_mtime
+ *   uint32 path_len, uint32 contents_len
+ *   char[path_len] asset_file_path
+ *   char[contents_len] contents, the JSON of the index, empty when there are no entries.
+ * \endcode
+ */
+class AssetLibraryIndexPack {
+  static constexpr char MAGIC[8] = {'B', 'A', 'I', 'P', 'A', 'C', 'K', '1'};
+
+  struct PackedIndex {
+    int64_t mtime;
+    /** Points into the memory mapped file, or into #PackEntry.contents. */
+    StringRef contents;
+  };
+
+  struct PackEntry {
+    int64_t mtime;
+    std::string contents;
+  };
+
+  std::string file_path_;
+  BLI_mmap_file *mmap_file_ = nullptr;
+  /** Indices read from the pack file, keyed by the asset file path. */
+  Map<std::string, PackedIndex> packed_indices_;
+  /** Indices to write to the pack file when the listing has finished. */
+  Map<std::string, PackEntry> next_entries_;
+  /** True when #next_entries_ differ from the packed indices. */
+  bool is_dirty_ = false;
+
+ public:
+  ~AssetLibraryIndexPack()
+  {
+    this->close_mmap();
+  }
+
+  void open(std::string file_path)
+  {
+    file_path_ = std::move(file_path);
+    const int file = BLI_open(file_path_.c_str(), O_BINARY | O_RDONLY, 0);
+    if (file == -1) {
+      return;
+    }
+    const size_t file_size = BLI_file_descriptor_size(file);
+    mmap_file_ = file_size > 0 ? BLI_mmap_open(file) : nullptr;
+    close(file);
+    if (mmap_file_ == nullptr) {
+      return;
+    }
+    const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file_));
+    if (!this->read_entries(Span<char>(data, int64_t(file_size)))) {
+      CLOG_INFO(&LOG, 2, "Ignoring invalid asset index pack [%s].", file_path_.c_str());
+      packed_indices_.clear();
+      this->close_mmap();
+    }
+  }
+
+  /**
+   * Find the packed index of the asset file, when the asset file didn't change since it was
+   * packed. The returned reference is valid until #write.
+   */
+  std::optional<StringRef> lookup(const std::string &asset_file_path, const int64_t mtime) const
+  {
+    const PackedIndex *packed_index = packed_indices_.lookup_ptr(asset_file_path);
+    if (packed_index == nullptr || packed_index->mtime != mtime) {
+      return std::nullopt;
+    }
+    return packed_index->contents;
+  }
+
+  /** Store the index of the asset file in the next version of the pack. */
+  void add(const std::string &asset_file_path, const int64_t mtime, StringRef contents)
+  {
+    const PackedIndex *packed_index = packed_indices_.lookup_ptr(asset_file_path);
+    if (packed_index == nullptr || packed_index->mtime != mtime ||
+        packed_index->contents != contents) {
+      is_dirty_ = true;
+    }
+    next_entries_.add_overwrite(asset_file_path, PackEntry{mtime, contents});
+  }
+
+  /** Write the indices that were added during the listing, when they changed. */
+  void write()
+  {
+    if (!is_dirty_ && next_entries_.size() == packed_indices_.size()) {
+      return;
+    }
+    /* All contents are copied already, the mapping has to be closed before the file can be
+     * replaced on Windows. */
+    packed_indices_.clear();
+    this->close_mmap();
+
+    const std::string tmp_file_path = file_path_ + "@";
+    if (!BLI_make_existing_file(tmp_file_path.c_str())) {
+      return;
+    }
+    std::ofstream os(tmp_file_path, std::ios::out | std::ios::trunc | std::ios::binary);
+    os.write(MAGIC, sizeof(MAGIC));
+    const uint32_t entries_num = uint32_t(next_entries_.size());
+    os.write(reinterpret_cast<const char *>(&entries_num), sizeof(entries_num));
+    for (const auto item : next_entries_.items()) {
+      const uint32_t path_len = uint32_t(item.key.size());
+      const uint32_t contents_len = uint32_t(item.value.contents.size());
+      os.write(reinterpret_cast<const char *>(&item.value.mtime), sizeof(item.value.mtime));
+      os.write(reinterpret_cast<const char *>(&path_len), sizeof(path_len));
+      os.write(reinterpret_cast<const char *>(&contents_len), sizeof(contents_len));
+      os.write(item.key.data(), path_len);
+      os.write(item.value.contents.data(), contents_len);
+    }
+    os.close();
+    if (os.fail()) {
+      CLOG_ERROR(&LOG, "Asset index pack not written [%s].", tmp_file_path.c_str());
+      BLI_delete(tmp_file_path.c_str(), false, false);
+      return;
+    }
+    BLI_rename(tmp_file_path.c_str(), file_path_.c_str());
+    CLOG_INFO(
+        &LOG, 1, "Wrote %u indices to asset index pack [%s].", entries_num, file_path_.c_str());
+  }
+
+ private:
+  bool read_entries(const Span<char> data)
+  {
+    int64_t offset = 0;
+    auto read = [&](void *dst, const int64_t size) {
+      if (offset + size > data.size()) {
+        return false;
+      }
+      memcpy(dst, data.data() + offset, size_t(size));
+      offset += size;
+      return true;
+    };
+
+    char magic[sizeof(MAGIC)];
+    uint32_t entries_num;
+    if (!read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !read(&entries_num, sizeof(entries_num))) {
+      return false;
+    }
+    packed_indices_.reserve(entries_num);
+    for (uint32_t i = 0; i < entries_num; i++) {
+      int64_t mtime;
+      uint32_t path_len, contents_len;
+      if (!read(&mtime, sizeof(mtime)) || !read(&path_len, sizeof(path_len)) ||
+          !read(&contents_len, sizeof(contents_len)) ||
+          offset + int64_t(path_len) + int64_t(contents_len) > data.size()) {
+        return false;
+      }
+      std::string path(data.data() + offset, path_len);
+      offset += path_len;
+      const StringRef contents(data.data() + offset, contents_len);
+      offset += contents_len;
+      packed_indices_.add_overwrite(std::move(path), PackedIndex{mtime, contents});
+    }
+    return true;
+  }
+
+  void close_mmap()
+  {
+    if (mmap_file_ != nullptr) {
+      BLI_mmap_free(mmap_file_);
+      mmap_file_ = nullptr;
+    }
+  }
+};
+
 struct AssetLibraryIndex {
   /**
    * Tracks indices that haven't been used yet.
@@ -433,10 +624,13 @@ struct AssetLibraryIndex {
 
   std::string library_path;
 
+  AssetLibraryIndexPack pack;
+
  public:
   AssetLibraryIndex(const StringRef library_path) : library_path(library_path)
   {
     init_indices_base_path();
+    pack.open(indices_base_path + "library.index.pack");
   }
 
   uint64_t hash() const
@@ -579,6 +773,23 @@ struct AssetIndex {
   {
   }
 
+  /** Read the contents from the JSON of an index file. */
+  static std::unique_ptr<AssetIndex> from_json(const StringRef json)
+  {
+    JsonFormatter formatter;
+    std::istringstream is{std::string(json)};
+    std::unique_ptr<Value> read_data = formatter.deserialize(is);
+    return std::make_unique<AssetIndex>(read_data);
+  }
+
+  std::string to_json() const
+  {
+    JsonFormatter formatter;
+    std::ostringstream os;
+    formatter.serialize(os, *contents);
+    return os.str();
+  }
+
   int get_version() const
   {
     const DictionaryValue *root = contents->as_dictionary_value();
@@ -653,15 +864,15 @@ class AssetIndexFile : public AbstractFile {
     return file_size >= MIN_FILE_SIZE_WITH_ENTRIES;
   }
 
-  std::unique_ptr<AssetIndex> read_contents() const
+  /** Read the JSON of the index file. */
+  std::string read_contents() const
   {
-    JsonFormatter formatter;
     std::ifstream is;
     is.open(filename);
-    std::unique_ptr<Value> read_data = formatter.deserialize(is);
+    std::stringstream ss;
+    ss << is.rdbuf();
     is.close();
-
-    return std::make_unique<AssetIndex>(read_data);
+    return ss.str();
   }
 
   bool ensure_parent_path_exists() const
@@ -671,9 +882,8 @@ class AssetIndexFile : public AbstractFile {
     return BLI_make_existing_file(get_file_path());
   }
 
-  void write_contents(AssetIndex &content)
+  void write_contents(const StringRef json)
   {
-    JsonFormatter formatter;
     if (!ensure_parent_path_exists()) {
       CLOG_ERROR(&LOG, "Index not created: couldn't create folder [%s].", get_file_path());
       return;
@@ -681,11 +891,46 @@ class AssetIndexFile : public AbstractFile {
 
     std::ofstream os;
     os.open(filename, std::ios::out | std::ios::trunc);
-    formatter.serialize(os, *content.contents);
+    os.write(json.data(), json.size());
     os.close();
   }
 };
 
+/** Modification time of the file, or -1 when it can't be accessed. */
+static int64_t file_mtime(const char *file_path)
+{
+  BLI_stat_t st;
+  if (BLI_stat(file_path, &st) == -1) {
+    return -1;
+  }
+  return int64_t(st.st_mtime);
+}
+
+/**
+ * Extract the entries from the JSON of an index.
+ *
+ * \return The number of extracted entries, or -1 when the index has to be recreated.
+ */
+static int read_index_contents(const StringRef json,
+                               const char *index_path,
+                               FileIndexerEntries &entries)
+{
+  if (json.is_empty()) {
+    return 0;
+  }
+  std::unique_ptr<AssetIndex> contents = AssetIndex::from_json(json);
+  if (!contents->is_latest_version()) {
+    CLOG_INFO(&LOG,
+              3,
+              "Asset file index is ignored; expected version %d but file is version %d [%s].",
+              AssetIndex::CURRENT_VERSION,
+              contents->get_version(),
+              index_path);
+    return -1;
+  }
+  return contents->extract_into(entries);
+}
+
 static eFileIndexerResult read_index(const char *filename,
                                      FileIndexerEntries *entries,
                                      int *r_read_entries_len,
@@ -695,6 +940,21 @@ static eFileIndexerResult read_index(const char *filename,
   BlendFile asset_file(filename);
   AssetIndexFile asset_index_file(library_index, asset_file);
 
+  const int64_t asset_file_mtime = file_mtime(filename);
+  if (const std::optional<StringRef> packed_json = library_index.pack.lookup(filename,
+                                                                             asset_file_mtime)) {
+    const int read_entries_len = read_index_contents(*packed_json, filename, *entries);
+    if (read_entries_len != -1) {
+      /* Keep the separate index file, it is still valid. */
+      asset_index_file.mark_as_used();
+      library_index.pack.add(filename, asset_file_mtime, *packed_json);
+      CLOG_INFO(
+          &LOG, 1, "Read %d entries from asset index pack for [%s].", read_entries_len, filename);
+      *r_read_entries_len = read_entries_len;
+      return FILE_INDEXER_ENTRIES_LOADED;
+    }
+  }
+
   if (!asset_index_file.exists()) {
     return FILE_INDEXER_NEEDS_UPDATE;
   }
@@ -720,22 +980,19 @@ static eFileIndexerResult read_index(const char *filename,
               3,
               "Asset file index is to small to contain any entries. [%s]",
               asset_index_file.filename.c_str());
+    library_index.pack.add(filename, asset_file_mtime, "");
     *r_read_entries_len = 0;
     return FILE_INDEXER_ENTRIES_LOADED;
   }
 
-  std::unique_ptr<AssetIndex> contents = asset_index_file.read_contents();
-  if (!contents->is_latest_version()) {
-    CLOG_INFO(&LOG,
-              3,
-              "Asset file index is ignored; expected version %d but file is version %d [%s].",
-              AssetIndex::CURRENT_VERSION,
-              contents->get_version(),
-              asset_index_file.filename.c_str());
+  const std::string json = asset_index_file.read_contents();
+  const int read_entries_len = read_index_contents(
+      json, asset_index_file.filename.c_str(), *entries);
+  if (read_entries_len == -1) {
     return FILE_INDEXER_NEEDS_UPDATE;
   }
+  library_index.pack.add(filename, asset_file_mtime, json);
 
-  const int read_entries_len = contents->extract_into(*entries);
   CLOG_INFO(&LOG, 1, "Read %d entries from asset index for [%s].", read_entries_len, filename);
   *r_read_entries_len = read_entries_len;
 
@@ -754,7 +1011,9 @@ static void update_index(const char *filename, FileIndexerEntries *entries, void
             asset_index_file.get_file_path());
 
   AssetIndex content(*entries);
-  asset_index_file.write_contents(content);
+  const std::string json = content.to_json();
+  asset_index_file.write_contents(json);
+  library_index.pack.add(filename, file_mtime(filename), json);
 }
 
 static void *init_user_data(const char *root_directory, size_t root_directory_maxlen)
@@ -777,6 +1036,7 @@ static void filelist_finished(void *user_data)
   if (num_indices_removed > 0) {
     CLOG_INFO(&LOG, 1, "Removed %d unused indices.", num_indices_removed);
   }
+  library_index.pack.write();
 }
 
 constexpr FileIndexerType asset_indexer()
@@ -372,6 +372,14 @@ static int gizmo_move_invoke(bContext *C, wmGizmo *gz, const wmEvent *event)
       switch (area->spacetype) {
         case SPACE_VIEW3D: {
           inter->snap_context_v3d = ED_transform_snap_object_context_create(CTX_data_scene(C), 0);
+          ED_transform_snap_object_context_prebuild_trees(
+              inter->snap_context_v3d,
+              CTX_data_ensure_evaluated_depsgraph(C),
+              CTX_wm_view3d(C),
+              &(const struct SnapObjectParams){
+                  .snap_target_select = SCE_SNAP_TARGET_ALL,
+                  .edit_mode_type = SNAP_GEOM_EDIT,
+              });
           break;
         }
         default:
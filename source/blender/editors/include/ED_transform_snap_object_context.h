@@ -70,6 +70,16 @@ typedef struct SnapObjectContext SnapObjectContext;
 SnapObjectContext *ED_transform_snap_object_context_create(struct Scene *scene, int flag);
 void ED_transform_snap_object_context_destroy(SnapObjectContext *sctx);
 
+/**
+ * Build the BVH-trees of the evaluated meshes of all visible objects in parallel, to call when an
+ * interaction that snaps starts. Otherwise the trees are built one after another on the main
+ * thread the first time they are used. The trees are cached on the meshes.
+ */
+void ED_transform_snap_object_context_prebuild_trees(SnapObjectContext *sctx,
+                                                     struct Depsgraph *depsgraph,
+                                                     const View3D *v3d,
+                                                     const struct SnapObjectParams *params);
+
 /* callbacks to filter how snap works */
 void ED_transform_snap_object_context_set_editmesh_callbacks(
     SnapObjectContext *sctx,
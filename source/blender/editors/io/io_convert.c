@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup editor/io
+ */
+
+#include <stdio.h>
+
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_context.h"
+#include "BKE_global.h"
+#include "BKE_main.h"
+#include "BKE_report.h"
+#include "BKE_scene.h"
+
+#include "BLO_writefile.h"
+
+#include "DNA_scene_types.h"
+
+#include "PIL_time.h"
+
+#ifdef WITH_IO_WAVEFRONT_OBJ
+#  include "IO_wavefront_obj.h"
+#endif
+#ifdef WITH_IO_STL
+#  include "IO_stl.h"
+#endif
+#ifdef WITH_IO_PLY
+#  include "IO_ply.h"
+#endif
+
+#include "io_convert.h" /* own include */
+
+/**
+ * Run the importer matching the file extension with the default settings of its operator.
+ * \return False when no importer supports the file.
+ */
+static bool io_import_file(bContext *C, const char *filepath)
+{
+#ifdef WITH_IO_WAVEFRONT_OBJ
+  if (BLI_path_extension_check(filepath, ".obj")) {
+    struct OBJImportParams params = {{0}};
+    STRNCPY(params.filepath, filepath);
+    params.global_scale = 1.0f;
+    params.forward_axis = IO_AXIS_NEGATIVE_Z;
+    params.up_axis = IO_AXIS_Y;
+    params.clear_selection = true;
+    OBJ_import(C, &params);
+    return true;
+  }
+#endif
+#ifdef WITH_IO_STL
+  if (BLI_path_extension_check(filepath, ".stl")) {
+    struct STLImportParams params = {{0}};
+    STRNCPY(params.filepath, filepath);
+    params.global_scale = 1.0f;
+    params.forward_axis = IO_AXIS_Y;
+    params.up_axis = IO_AXIS_Z;
+    STL_import(C, &params);
+    return true;
+  }
+#endif
+#ifdef WITH_IO_PLY
+  if (BLI_path_extension_check(filepath, ".ply")) {
+    struct PLYImportParams params = {{0}};
+    STRNCPY(params.filepath, filepath);
+    params.global_scale = 1.0f;
+    params.forward_axis = IO_AXIS_Y;
+    params.up_axis = IO_AXIS_Z;
+    PLY_import(C, &params);
+    return true;
+  }
+#endif
+  UNUSED_VARS(C, filepath);
+  return false;
+}
+
+/**
+ * Import a single file into a new database, with a scene with a single view layer like the one
+ * of an empty blend-file, and write that database to `blend_filepath`.
+ */
+static bool io_convert_file(bContext *C, const char *filepath, const char *blend_filepath)
+{
+  Main *bmain_prev = CTX_data_main(C);
+  Scene *scene_prev = CTX_data_scene(C);
+
+  Main *bmain = BKE_main_new();
+  STRNCPY(bmain->filepath, blend_filepath);
+  Scene *scene = BKE_scene_add(bmain, "Scene");
+
+  /* The importers only use the database, scene and view layer of the context. */
+  CTX_data_main_set(C, bmain);
+  CTX_data_scene_set(C, scene);
+  bool success = io_import_file(C, filepath);
+  CTX_data_main_set(C, bmain_prev);
+  CTX_data_scene_set(C, scene_prev);
+
+  if (success) {
+    ReportList reports;
+    BKE_reports_init(&reports, RPT_PRINT);
+    const struct BlendFileWriteParams params = {
+        .remap_mode = BLO_WRITE_PATH_REMAP_RELATIVE,
+    };
+    success = BLO_write_file(bmain, blend_filepath, G.fileflags, &params, &reports);
+    BKE_reports_clear(&reports);
+  }
+  else {
+    printf("Error: no importer for file '%s'\n", filepath);
+  }
+
+  BKE_main_free(bmain);
+  return success;
+}
+
+int ED_io_convert_files_to_blend(bContext *C, const char **filepaths, const int filepaths_len)
+{
+  int failed_len = 0;
+  const double time_start = PIL_check_seconds_timer();
+  for (int i = 0; i < filepaths_len; i++) {
+    char filepath[FILE_MAX];
+    STRNCPY(filepath, filepaths[i]);
+    BLI_path_abs_from_cwd(filepath, sizeof(filepath));
+    char blend_filepath[FILE_MAX];
+    STRNCPY(blend_filepath, filepath);
+    BLI_path_extension_replace(blend_filepath, sizeof(blend_filepath), ".blend");
+
+    const double time_file_start = PIL_check_seconds_timer();
+    if (io_convert_file(C, filepath, blend_filepath)) {
+      printf("Converted '%s' to '%s' in %.3fs\n",
+             filepaths[i],
+             blend_filepath,
+             PIL_check_seconds_timer() - time_file_start);
+    }
+    else {
+      printf("Error: failed to convert '%s'\n", filepaths[i]);
+      failed_len++;
+    }
+  }
+  printf("Converted %d of %d files in %.3fs\n",
+         filepaths_len - failed_len,
+         filepaths_len,
+         PIL_check_seconds_timer() - time_start);
+  return failed_len;
+}
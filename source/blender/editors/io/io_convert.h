@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup editor/io
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct bContext;
+
+/**
+ * Import every file with the importer for its extension into its own empty database, and save
+ * that as a blend-file next to the imported file. Meant for converting many files from the
+ * command line, without paying the startup time of Blender for every file.
+ *
+ * \return The number of files that could not be converted.
+ */
+int ED_io_convert_files_to_blend(struct bContext *C, const char **filepaths, int filepaths_len);
+
+#ifdef __cplusplus
+}
+#endif
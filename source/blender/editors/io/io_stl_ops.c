@@ -9,11 +9,14 @@
 #  include "BKE_context.h"
 #  include "BKE_report.h"
 
+#  include "BLI_path_util.h"
+
 #  include "WM_api.h"
 #  include "WM_types.h"
 
 #  include "DNA_space_types.h"
 
+#  include "ED_fileselect.h"
 #  include "ED_outliner.h"
 
 #  include "RNA_access.h"
@@ -71,7 +74,7 @@ static int wm_stl_import_execute(bContext *C, wmOperator *op)
   return OPERATOR_FINISHED;
 }
 
-static bool wm_stl_import_check(bContext *UNUSED(C), wmOperator *op)
+static bool wm_stl_axes_check(wmOperator *op)
 {
   const int num_axes = 3;
   /* Both forward and up axes cannot be the same (or same except opposite sign). */
@@ -83,6 +86,11 @@ static bool wm_stl_import_check(bContext *UNUSED(C), wmOperator *op)
   return false;
 }
 
+static bool wm_stl_import_check(bContext *UNUSED(C), wmOperator *op)
+{
+  return wm_stl_axes_check(op);
+}
+
 void WM_OT_stl_import(struct wmOperatorType *ot)
 {
   PropertyRNA *prop;
@@ -130,4 +138,95 @@ void WM_OT_stl_import(struct wmOperatorType *ot)
   RNA_def_property_flag(prop, PROP_HIDDEN);
 }
 
+static int wm_stl_export_invoke(bContext *C, wmOperator *op, const wmEvent *UNUSED(event))
+{
+  ED_fileselect_ensure_default_filepath(C, op, ".stl");
+
+  WM_event_add_fileselect(C, op);
+  return OPERATOR_RUNNING_MODAL;
+}
+
+static int wm_stl_export_execute(bContext *C, wmOperator *op)
+{
+  if (!RNA_struct_property_is_set_ex(op->ptr, "filepath", false)) {
+    BKE_report(op->reports, RPT_ERROR, "No filename given");
+    return OPERATOR_CANCELLED;
+  }
+  struct STLExportParams params;
+  RNA_string_get(op->ptr, "filepath", params.filepath);
+  params.forward_axis = RNA_enum_get(op->ptr, "forward_axis");
+  params.up_axis = RNA_enum_get(op->ptr, "up_axis");
+  params.global_scale = RNA_float_get(op->ptr, "global_scale");
+  params.use_scene_unit = RNA_boolean_get(op->ptr, "use_scene_unit");
+  params.apply_modifiers = RNA_boolean_get(op->ptr, "apply_modifiers");
+  params.export_selected_objects = RNA_boolean_get(op->ptr, "export_selected_objects");
+  params.ascii_format = RNA_boolean_get(op->ptr, "ascii_format");
+
+  STL_export(C, &params);
+
+  return OPERATOR_FINISHED;
+}
+
+static bool wm_stl_export_check(bContext *UNUSED(C), wmOperator *op)
+{
+  char filepath[FILE_MAX];
+  bool changed = false;
+  RNA_string_get(op->ptr, "filepath", filepath);
+
+  if (!BLI_path_extension_check(filepath, ".stl")) {
+    BLI_path_extension_ensure(filepath, FILE_MAX, ".stl");
+    RNA_string_set(op->ptr, "filepath", filepath);
+    changed = true;
+  }
+  return wm_stl_axes_check(op) || changed;
+}
+
+void WM_OT_stl_export(struct wmOperatorType *ot)
+{
+  PropertyRNA *prop;
+
+  ot->name = "Export STL";
+  ot->description = "Save the scene to an STL file";
+  ot->idname = "WM_OT_stl_export";
+
+  ot->invoke = wm_stl_export_invoke;
+  ot->exec = wm_stl_export_execute;
+  ot->poll = WM_operator_winactive;
+  ot->check = wm_stl_export_check;
+  ot->flag = OPTYPE_PRESET;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER,
+                                 FILE_BLENDER,
+                                 FILE_SAVE,
+                                 WM_FILESEL_FILEPATH | WM_FILESEL_SHOW_PROPS,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+
+  RNA_def_boolean(ot->srna,
+                  "ascii_format",
+                  false,
+                  "ASCII",
+                  "Export to an ASCII text file instead of a binary file");
+  RNA_def_boolean(ot->srna,
+                  "export_selected_objects",
+                  false,
+                  "Selected Only",
+                  "Export only selected objects instead of all supported objects");
+  RNA_def_boolean(
+      ot->srna, "apply_modifiers", true, "Apply Modifiers", "Apply modifiers to exported meshes");
+  RNA_def_float(ot->srna, "global_scale", 1.0f, 1e-6f, 1e6f, "Scale", "", 0.001f, 1000.0f);
+  RNA_def_boolean(ot->srna,
+                  "use_scene_unit",
+                  false,
+                  "Scene Unit",
+                  "Apply current scene's unit (as defined by unit scale) to exported data");
+  RNA_def_enum(ot->srna, "forward_axis", io_transform_axis, IO_AXIS_Y, "Forward Axis", "");
+  RNA_def_enum(ot->srna, "up_axis", io_transform_axis, IO_AXIS_Z, "Up Axis", "");
+
+  /* Only show .stl files by default. */
+  prop = RNA_def_string(ot->srna, "filter_glob", "*.stl", 0, "Extension Filter", "");
+  RNA_def_property_flag(prop, PROP_HIDDEN);
+}
+
 #endif /* WITH_IO_STL */
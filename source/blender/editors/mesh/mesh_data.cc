@@ -223,7 +223,8 @@ void ED_mesh_uv_loop_reset_ex(Mesh *me, const int layernum)
   else {
     /* Collect Mesh UVs */
     BLI_assert(CustomData_has_layer(&me->ldata, CD_MLOOPUV));
-    MLoopUV *mloopuv = (MLoopUV *)CustomData_get_layer_n(&me->ldata, CD_MLOOPUV, layernum);
+    MLoopUV *mloopuv = (MLoopUV *)CustomData_get_layer_n_for_write(
+        &me->ldata, CD_MLOOPUV, layernum, me->totloop);
 
     const MPoly *polys = BKE_mesh_polys(me);
     for (int i = 0; i < me->totpoly; i++) {
@@ -287,7 +288,7 @@ int ED_mesh_uv_add(
       CustomData_add_layer_named(&me->ldata,
                                  CD_MLOOPUV,
                                  CD_DUPLICATE,
-                                 CustomData_get_layer(&me->ldata, CD_MLOOPUV),
+                                 const_cast<void *>(CustomData_get_layer(&me->ldata, CD_MLOOPUV)),
                                  me->totloop,
                                  name);
       is_init = true;
@@ -408,7 +409,8 @@ int ED_mesh_color_add(Mesh *me,
       CustomData_add_layer_named(&me->ldata,
                                  CD_PROP_BYTE_COLOR,
                                  CD_DUPLICATE,
-                                 CustomData_get_layer(&me->ldata, CD_PROP_BYTE_COLOR),
+                                 const_cast<void *>(
+                                     CustomData_get_layer(&me->ldata, CD_PROP_BYTE_COLOR)),
                                  me->totloop,
                                  name);
     }
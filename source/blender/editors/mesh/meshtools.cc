@@ -107,7 +107,8 @@ static void join_mesh_single(Depsgraph *depsgraph,
     CustomData_copy_data_named(&me->vdata, vdata, 0, *vertofs, me->totvert);
 
     /* vertex groups */
-    MDeformVert *dvert = (MDeformVert *)CustomData_get(vdata, *vertofs, CD_MDEFORMVERT);
+    MDeformVert *dvert = (MDeformVert *)CustomData_get_for_write(
+        vdata, *vertofs, CD_MDEFORMVERT, totvert);
     const MDeformVert *dvert_src = (const MDeformVert *)CustomData_get(
         &me->vdata, 0, CD_MDEFORMVERT);
 
@@ -253,7 +254,7 @@ static void join_mesh_single(Depsgraph *depsgraph,
     /* Apply matmap. In case we don't have material indices yet, create them if more than one
      * material is the result of joining. */
     int *material_indices = static_cast<int *>(
-        CustomData_get_layer_named(pdata, CD_PROP_INT32, "material_index"));
+        CustomData_get_layer_named_for_write(pdata, CD_PROP_INT32, "material_index", totpoly));
     if (!material_indices && totcol > 1) {
       material_indices = (int *)CustomData_add_layer_named(
           pdata, CD_PROP_INT32, CD_SET_DEFAULT, NULL, totpoly, "material_index");
@@ -269,7 +270,7 @@ static void join_mesh_single(Depsgraph *depsgraph,
     }
 
     /* Face maps. */
-    int *fmap = (int *)CustomData_get(pdata, *polyofs, CD_FACEMAP);
+    int *fmap = (int *)CustomData_get_for_write(pdata, *polyofs, CD_FACEMAP, totpoly);
     const int *fmap_src = (const int *)CustomData_get(&me->pdata, 0, CD_FACEMAP);
 
     /* Remap to correct new face-map indices, if needed. */
@@ -299,14 +300,14 @@ static void join_mesh_single(Depsgraph *depsgraph,
 /* Face Sets IDs are a sparse sequence, so this function offsets all the IDs by face_set_offset and
  * updates face_set_offset with the maximum ID value. This way, when used in multiple meshes, all
  * of them will have different IDs for their Face Sets. */
-static void mesh_join_offset_face_sets_ID(const Mesh *mesh, int *face_set_offset)
+static void mesh_join_offset_face_sets_ID(Mesh *mesh, int *face_set_offset)
 {
   if (!mesh->totpoly) {
     return;
   }
 
-  int *face_sets = (int *)CustomData_get_layer_named(
-      &mesh->pdata, CD_PROP_INT32, ".sculpt_face_set");
+  int *face_sets = (int *)CustomData_get_layer_named_for_write(
+      &mesh->pdata, CD_PROP_INT32, ".sculpt_face_set", mesh->totpoly);
   if (!face_sets) {
     return;
   }
@@ -1084,7 +1085,7 @@ static uint mirror_facehash(const void *ptr)
   return ((v0 * 39) ^ (v1 * 31));
 }
 
-static int mirror_facerotation(MFace *a, MFace *b)
+static int mirror_facerotation(const MFace *a, const MFace *b)
 {
   if (b->v4) {
     if (a->v1 == b->v1 && a->v2 == b->v2 && a->v3 == b->v3 && a->v4 == b->v4) {
@@ -1117,14 +1118,15 @@ static int mirror_facerotation(MFace *a, MFace *b)
 
 static bool mirror_facecmp(const void *a, const void *b)
 {
-  return (mirror_facerotation((MFace *)a, (MFace *)b) == -1);
+  return (mirror_facerotation((const MFace *)a, (const MFace *)b) == -1);
 }
 
 int *mesh_get_x_mirror_faces(Object *ob, BMEditMesh *em, Mesh *me_eval)
 {
   Mesh *me = static_cast<Mesh *>(ob->data);
   const MVert *mv;
-  MFace mirrormf, *mf, *hashmf;
+  MFace mirrormf;
+  const MFace *mf, *hashmf;
   GHash *fhash;
   int *mirrorverts, *mirrorfaces;
 
@@ -1139,7 +1141,8 @@ int *mesh_get_x_mirror_faces(Object *ob, BMEditMesh *em, Mesh *me_eval)
   mirrorfaces = static_cast<int *>(MEM_callocN(sizeof(int[2]) * totface, "MirrorFaces"));
 
   const Span<MVert> verts = me_eval ? me_eval->verts() : me->verts();
-  MFace *mface = (MFace *)CustomData_get_layer(&(me_eval ? me_eval : me)->fdata, CD_MFACE);
+  const MFace *mface = (const MFace *)CustomData_get_layer(
+      &(me_eval ? me_eval : me)->fdata, CD_MFACE);
 
   ED_mesh_mirror_spatial_table_begin(ob, em, me_eval);
 
@@ -1151,7 +1154,7 @@ int *mesh_get_x_mirror_faces(Object *ob, BMEditMesh *em, Mesh *me_eval)
 
   fhash = BLI_ghash_new_ex(mirror_facehash, mirror_facecmp, "mirror_facehash gh", me->totface);
   for (a = 0, mf = mface; a < totface; a++, mf++) {
-    BLI_ghash_insert(fhash, mf, mf);
+    BLI_ghash_insert(fhash, (void *)mf, (void *)mf);
   }
 
   for (a = 0, mf = mface; a < totface; a++, mf++) {
@@ -1166,7 +1169,7 @@ int *mesh_get_x_mirror_faces(Object *ob, BMEditMesh *em, Mesh *me_eval)
       SWAP(uint, mirrormf.v2, mirrormf.v4);
     }
 
-    hashmf = static_cast<MFace *>(BLI_ghash_lookup(fhash, &mirrormf));
+    hashmf = static_cast<const MFace *>(BLI_ghash_lookup(fhash, &mirrormf));
     if (hashmf) {
       mirrorfaces[a * 2] = hashmf - mface;
       mirrorfaces[a * 2 + 1] = mirror_facerotation(&mirrormf, hashmf);
@@ -103,6 +103,8 @@ typedef struct BakeAPIRender {
 
   /* Baking render session. */
   Render *render;
+  /* Dependency graph shared by all baked objects, see #bake_session_begin. */
+  Depsgraph *depsgraph;
 
   /* Progress Callbacks. */
   float *progress;
@@ -1339,12 +1341,7 @@ static int bake(const BakeAPIRender *bkr,
   Render *re = bkr->render;
   Main *bmain = bkr->main;
   Scene *scene = bkr->scene;
-  ViewLayer *view_layer = bkr->view_layer;
-
-  /* We build a depsgraph for the baking,
-   * so we don't need to change the original data to adjust visibility and modifiers. */
-  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_graph_build_from_view_layer(depsgraph);
+  Depsgraph *depsgraph = bkr->depsgraph;
 
   int op_result = OPERATOR_CANCELLED;
   bool ok = false;
@@ -1425,6 +1422,8 @@ static int bake(const BakeAPIRender *bkr,
     if (mmd_low) {
       mmd_flags_low = mmd_low->flags;
       mmd_low->uv_smooth = SUBSURF_UV_SMOOTH_NONE;
+      /* The object may have been evaluated already for an object baked before. */
+      DEG_graph_id_tag_update(bmain, depsgraph, &ob_low->id, ID_RECALC_GEOMETRY);
     }
   }
 
@@ -1719,11 +1718,32 @@ cleanup:
     BKE_id_free(NULL, &me_cage_eval->id);
   }
 
-  DEG_graph_free(depsgraph);
-
   return op_result;
 }
 
+/**
+ * Create the dependency graph for baking, so we don't need to change the original data to adjust
+ * visibility and modifiers. It is shared by all baked objects, which lets the render engine keep
+ * the scene it synchronized for the first object instead of synchronizing it for every object.
+ */
+static void bake_session_begin(BakeAPIRender *bkr)
+{
+  bkr->depsgraph = DEG_graph_new(bkr->main, bkr->scene, bkr->view_layer, DAG_EVAL_RENDER);
+  DEG_graph_build_from_view_layer(bkr->depsgraph);
+
+  /* An engine kept by a render with persistent data can't be used for the new depsgraph. */
+  RE_bake_engine_free(bkr->render);
+}
+
+static void bake_session_end(BakeAPIRender *bkr)
+{
+  /* The engine references the depsgraph, so it has to be freed first. */
+  RE_bake_engine_free(bkr->render);
+
+  DEG_graph_free(bkr->depsgraph);
+  bkr->depsgraph = NULL;
+}
+
 /* Bake Operator */
 
 static void bake_init_api_data(wmOperator *op, bContext *C, BakeAPIRender *bkr)
@@ -1832,6 +1852,7 @@ static int bake_exec(bContext *C, wmOperator *op)
   }
 
   RE_SetReports(re, bkr.reports);
+  bake_session_begin(&bkr);
 
   if (bkr.is_selected_to_active) {
     result = bake(&bkr, bkr.ob, &bkr.selected_objects, bkr.reports);
@@ -1845,6 +1866,7 @@ static int bake_exec(bContext *C, wmOperator *op)
     }
   }
 
+  bake_session_end(&bkr);
   RE_SetReports(re, NULL);
 
 finally:
@@ -1886,6 +1908,8 @@ static void bake_startjob(void *bkv, short *UNUSED(stop), short *do_update, floa
     bake_targets_clear(bkr->main, is_tangent);
   }
 
+  bake_session_begin(bkr);
+
   if (bkr->is_selected_to_active) {
     bkr->result = bake(bkr, bkr->ob, &bkr->selected_objects, bkr->reports);
   }
@@ -1897,11 +1921,13 @@ static void bake_startjob(void *bkv, short *UNUSED(stop), short *do_update, floa
       bkr->result = bake(bkr, ob_iter, NULL, bkr->reports);
 
       if (bkr->result == OPERATOR_CANCELLED) {
+        bake_session_end(bkr);
         return;
       }
     }
   }
 
+  bake_session_end(bkr);
   RE_SetReports(bkr->render, NULL);
 }
 
@@ -25,6 +25,7 @@
 #include "DNA_space_types.h"
 
 #include "BLI_bitmap.h"
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_path_util.h"
@@ -85,6 +86,8 @@
 #include "ED_screen.h"
 #include "ED_sculpt.h"
 
+#include "MOD_nodes.h"
+
 #include "UI_interface.h"
 
 #include "WM_api.h"
@@ -2669,7 +2672,7 @@ static Object *modifier_skin_armature_create(Depsgraph *depsgraph, Main *bmain,
   arm->drawtype = ARM_LINE;
   arm->edbo = MEM_cnew<ListBase>("edbo armature");
 
-  MVertSkin *mvert_skin = static_cast<MVertSkin *>(
+  const MVertSkin *mvert_skin = static_cast<const MVertSkin *>(
       CustomData_get_layer(&me->vdata, CD_MVERT_SKIN));
   int *emap_mem;
   MeshElemMap *emap;
@@ -3180,6 +3183,97 @@ void OBJECT_OT_ocean_bake(wmOperatorType *ot)
 
 /** \} */
 
+/* ------------------------------------------------------------------- */
+/** \name Geometry Nodes Bake Operator
+ * \{ */
+
+static bool geometry_nodes_bake_poll(bContext *C)
+{
+  return edit_modifier_poll_generic(C, &RNA_NodesModifier, 0, true, false);
+}
+
+static int geometry_nodes_bake_exec(bContext *C, wmOperator *op)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+  Object *ob = ED_object_active_context(C);
+  NodesModifierData *nmd = (NodesModifierData *)edit_modifier_property_get(
+      op, ob, eModifierType_Nodes);
+  const bool free = RNA_boolean_get(op->ptr, "free");
+
+  if (nmd == nullptr) {
+    return OPERATOR_CANCELLED;
+  }
+
+  if (free) {
+    /* The files are kept, so that deleting a bake by accident doesn't lose it. */
+    nmd->flag &= ~NODES_MODIFIER_BAKED;
+    DEG_id_tag_update(&ob->id, ID_RECALC_COPY_ON_WRITE | ID_RECALC_GEOMETRY);
+    WM_event_add_notifier(C, NC_OBJECT | ND_MODIFIER, ob);
+    return OPERATOR_FINISHED;
+  }
+
+  char directory[FILE_MAX];
+  MOD_nodes_bake_directory_get(ob, nmd, BKE_modifier_path_relbase(bmain, ob), directory);
+  if (nmd->bake_directory[0] == '\0' || !BLI_dir_create_recursive(directory)) {
+    BKE_reportf(op->reports, RPT_ERROR, "Cannot create bake directory \"%s\"", directory);
+    return OPERATOR_CANCELLED;
+  }
+
+  /* Evaluate the modifier for every frame of the scene, it writes its output on the way. */
+  nmd->flag &= ~NODES_MODIFIER_BAKED;
+  nmd->flag |= NODES_MODIFIER_BAKE_WRITE;
+
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  const int cfra = scene->r.cfra;
+  WM_cursor_wait(true);
+  for (int frame = scene->r.sfra; frame <= scene->r.efra; frame++) {
+    scene->r.cfra = frame;
+    /* The modifier has to be evaluated even when it doesn't depend on time. */
+    DEG_id_tag_update(&ob->id, ID_RECALC_COPY_ON_WRITE | ID_RECALC_GEOMETRY);
+    BKE_scene_graph_update_for_newframe(depsgraph);
+  }
+  WM_cursor_wait(false);
+
+  nmd->flag &= ~NODES_MODIFIER_BAKE_WRITE;
+  nmd->flag |= NODES_MODIFIER_BAKED;
+
+  scene->r.cfra = cfra;
+  DEG_id_tag_update(&ob->id, ID_RECALC_COPY_ON_WRITE | ID_RECALC_GEOMETRY);
+  BKE_scene_graph_update_for_newframe(depsgraph);
+  WM_event_add_notifier(C, NC_OBJECT | ND_MODIFIER, ob);
+  return OPERATOR_FINISHED;
+}
+
+static int geometry_nodes_bake_invoke(bContext *C, wmOperator *op, const wmEvent * /*event*/)
+{
+  if (edit_modifier_invoke_properties(C, op)) {
+    return geometry_nodes_bake_exec(C, op);
+  }
+  return OPERATOR_CANCELLED;
+}
+
+void OBJECT_OT_geometry_nodes_bake(wmOperatorType *ot)
+{
+  ot->name = "Bake Geometry Nodes";
+  ot->description =
+      "Write the output geometry of the modifier for every frame of the scene to the bake "
+      "directory and read it from there instead of evaluating the node group";
+  ot->idname = "OBJECT_OT_geometry_nodes_bake";
+
+  ot->poll = geometry_nodes_bake_poll;
+  ot->invoke = geometry_nodes_bake_invoke;
+  ot->exec = geometry_nodes_bake_exec;
+
+  /* flags */
+  ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO | OPTYPE_INTERNAL;
+  edit_modifier_properties(ot);
+
+  RNA_def_boolean(ot->srna, "free", false, "Free", "Free the bake, rather than generating it");
+}
+
+/** \} */
+
 /* ------------------------------------------------------------------- */
 /** \name Laplacian-Deform Bind Operator
  * \{ */
@@ -1454,9 +1454,9 @@ void recalc_emitter_field(Depsgraph *UNUSED(depsgraph), Object *UNUSED(ob), Part
 
   const MVert *verts = BKE_mesh_verts(mesh);
   const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
-  MFace *mfaces = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mfaces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
   for (i = 0; i < totface; i++, vec += 6, nor += 6) {
-    MFace *mface = &mfaces[i];
+    const MFace *mface = &mfaces[i];
     const MVert *mvert;
 
     mvert = &verts[mface->v1];
@@ -3569,9 +3569,10 @@ static void PE_mirror_x(Depsgraph *depsgraph, Scene *scene, Object *ob, int tagg
   }
 
   if (newtotpart != psys->totpart) {
-    MFace *mtessface = use_dm_final_indices ?
-                           (MFace *)CustomData_get_layer(&psmd_eval->mesh_final->fdata, CD_MFACE) :
-                           (MFace *)CustomData_get_layer(&me->fdata, CD_MFACE);
+    const MFace *mtessface = use_dm_final_indices ?
+                                 (const MFace *)CustomData_get_layer(
+                                     &psmd_eval->mesh_final->fdata, CD_MFACE) :
+                                 (const MFace *)CustomData_get_layer(&me->fdata, CD_MFACE);
 
     /* allocate new arrays and copy existing */
     new_pars = MEM_callocN(newtotpart * sizeof(ParticleData), "ParticleData new");
@@ -4141,7 +4142,7 @@ static int particle_intersect_mesh(Depsgraph *depsgraph,
                                    float radius,
                                    float *ipoint)
 {
-  MFace *mface = NULL;
+  const MFace *mface = NULL;
   MVert *mvert = NULL;
   int i, totface, intersect = 0;
   float cur_d, cur_uv[2], v1[3], v2[3], v3[3], v4[3], min[3], max[3], p_min[3], p_max[3];
@@ -4179,7 +4180,7 @@ static int particle_intersect_mesh(Depsgraph *depsgraph,
   }
 
   totface = mesh->totface;
-  mface = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  mface = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
   mvert = BKE_mesh_verts_for_write(mesh);
 
   /* lets intersect the faces */
@@ -14,6 +14,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_rect.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 #include "BLI_utildefines.h"
@@ -647,26 +648,30 @@ static void render_startjob(void *rjv, short *stop, short *do_update, float *pro
 
   RE_SetReports(rj->re, rj->reports);
 
-  if (rj->anim) {
-    RE_RenderAnim(rj->re,
-                  rj->main,
-                  rj->scene,
-                  rj->single_layer,
-                  rj->camera_override,
-                  rj->scene->r.sfra,
-                  rj->scene->r.efra,
-                  rj->scene->r.frame_step);
-  }
-  else {
-    RE_RenderFrame(rj->re,
-                   rj->main,
-                   rj->scene,
-                   rj->single_layer,
-                   rj->camera_override,
-                   rj->scene->r.cfra,
-                   rj->scene->r.subframe,
-                   rj->write_still);
-  }
+  /* Run the render with a low priority, so that the threads prefer work of the interface while
+   * it is running in the background. */
+  blender::threading::arena_execute(-1, TASK_PRIORITY_LOW, [&]() {
+    if (rj->anim) {
+      RE_RenderAnim(rj->re,
+                    rj->main,
+                    rj->scene,
+                    rj->single_layer,
+                    rj->camera_override,
+                    rj->scene->r.sfra,
+                    rj->scene->r.efra,
+                    rj->scene->r.frame_step);
+    }
+    else {
+      RE_RenderFrame(rj->re,
+                     rj->main,
+                     rj->scene,
+                     rj->single_layer,
+                     rj->camera_override,
+                     rj->scene->r.cfra,
+                     rj->scene->r.subframe,
+                     rj->write_still);
+    }
+  });
 
   RE_SetReports(rj->re, nullptr);
 }
@@ -78,7 +78,8 @@ static void partialvis_update_mesh(Object *ob,
   BKE_pbvh_node_get_verts(pbvh, node, &vert_indices, &mvert);
   paint_mask = CustomData_get_layer(&me->vdata, CD_PAINT_MASK);
 
-  bool *hide_vert = CustomData_get_layer_named(&me->vdata, CD_PROP_BOOL, ".hide_vert");
+  bool *hide_vert = CustomData_get_layer_named_for_write(
+      &me->vdata, CD_PROP_BOOL, ".hide_vert", me->totvert);
   if (hide_vert == NULL) {
     hide_vert = CustomData_add_layer_named(
         &me->vdata, CD_PROP_BOOL, CD_SET_DEFAULT, NULL, me->totvert, ".hide_vert");
@@ -1013,6 +1013,38 @@ void SCULPT_do_clay_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
   BLI_task_parallel_range(0, totnode, &data, do_clay_brush_task_cb_ex, &settings);
 }
 
+/**
+ * Test if the bounds of \a node can overlap the test cube of #SCULPT_brush_test_cube,
+ * \a mat being the transform to the local space of the brush.
+ * Nodes are gathered with a sphere that contains the whole cube, this allows skipping the ones
+ * that can't be affected without testing all of their vertices.
+ */
+static bool sculpt_brush_node_test_cube(PBVHNode *node, const float mat[4][4])
+{
+  float bb_min[3], bb_max[3];
+  BKE_pbvh_node_get_BB(node, bb_min, bb_max);
+
+  float local_min[3], local_max[3];
+  INIT_MINMAX(local_min, local_max);
+  for (int i = 0; i < 8; i++) {
+    const float co[3] = {
+        (i & 1) ? bb_max[0] : bb_min[0],
+        (i & 2) ? bb_max[1] : bb_min[1],
+        (i & 4) ? bb_max[2] : bb_min[2],
+    };
+    float local_co[3];
+    mul_v3_m4v3(local_co, mat, co);
+    minmax_v3v3_v3(local_min, local_max, local_co);
+  }
+
+  for (int i = 0; i < 3; i++) {
+    if (local_min[i] > 1.0f || local_max[i] < -1.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static void do_clay_strips_brush_task_cb_ex(void *__restrict userdata,
                                             const int n,
                                             const TaskParallelTLS *__restrict tls)
@@ -1030,6 +1062,10 @@ static void do_clay_strips_brush_task_cb_ex(void *__restrict userdata,
   const bool flip = (ss->cache->bstrength < 0.0f);
   const float bstrength = flip ? -ss->cache->bstrength : ss->cache->bstrength;
 
+  if (!sculpt_brush_node_test_cube(data->nodes[n], mat)) {
+    return;
+  }
+
   proxy = BKE_pbvh_node_add_proxy(ss->pbvh, data->nodes[n])->co;
 
   SCULPT_brush_test_init(ss, &test);
@@ -73,8 +73,8 @@ int ED_sculpt_face_sets_find_next_available_id(struct Mesh *mesh)
 
 void ED_sculpt_face_sets_initialize_none_to_id(struct Mesh *mesh, const int new_id)
 {
-  int *face_sets = static_cast<int *>(
-      CustomData_get_layer_named(&mesh->pdata, CD_PROP_INT32, ".sculpt_face_set"));
+  int *face_sets = static_cast<int *>(CustomData_get_layer_named_for_write(
+      &mesh->pdata, CD_PROP_INT32, ".sculpt_face_set", mesh->totpoly));
   if (!face_sets) {
     return;
   }
@@ -610,7 +610,8 @@ static void sculpt_face_sets_init_loop(Object *ob, const int mode)
     }
   }
   else if (mode == SCULPT_FACE_SETS_FROM_FACE_MAPS) {
-    const int *face_maps = static_cast<int *>(CustomData_get_layer(&mesh->pdata, CD_FACEMAP));
+    const int *face_maps = static_cast<const int *>(
+        CustomData_get_layer(&mesh->pdata, CD_FACEMAP));
     for (const int i : IndexRange(mesh->totpoly)) {
       ss->face_sets[i] = face_maps ? face_maps[i] : 1;
     }
@@ -148,6 +148,9 @@ typedef struct SculptUndoNode {
   char idname[MAX_ID_NAME]; /* Name instead of pointer. */
   void *node;               /* only during push, not valid afterwards! */
 
+  /* Held while the data of the node is copied, see #SCULPT_undo_push_node. */
+  ThreadMutex push_lock;
+
   float (*co)[3];
   float (*orig_co)[3];
   float (*no)[3];
@@ -608,7 +608,8 @@ static bool sculpt_undo_restore_face_sets(bContext *C, SculptUndoNode *unode)
   Object *ob = BKE_view_layer_active_object_get(view_layer);
   Mesh *me = BKE_object_get_original_mesh(ob);
 
-  int *face_sets = CustomData_get_layer_named(&me->pdata, CD_PROP_INT32, ".sculpt_face_set");
+  int *face_sets = CustomData_get_layer_named_for_write(
+      &me->pdata, CD_PROP_INT32, ".sculpt_face_set", me->totpoly);
   if (!face_sets) {
     face_sets = CustomData_add_layer_named(
         &me->pdata, CD_PROP_INT32, CD_CONSTRUCT, NULL, me->totpoly, ".sculpt_face_set");
@@ -1155,6 +1156,8 @@ static void sculpt_undo_free_list(ListBase *lb)
       MEM_freeN(unode->face_sets);
     }
 
+    BLI_mutex_end(&unode->push_lock);
+
     MEM_freeN(unode);
 
     unode = unode_next;
@@ -1242,6 +1245,7 @@ static SculptUndoNode *sculpt_undo_alloc_node_type(Object *object, SculptUndoTyp
 {
   const size_t alloc_size = sizeof(SculptUndoNode);
   SculptUndoNode *unode = MEM_callocN(alloc_size, "SculptUndoNode");
+  BLI_mutex_init(&unode->push_lock);
   BLI_strncpy(unode->idname, object->id.name, sizeof(unode->idname));
   unode->type = type;
 
@@ -1490,6 +1494,7 @@ static SculptUndoNode *sculpt_undo_face_sets_push(Object *ob, SculptUndoType typ
 {
   UndoSculpt *usculpt = sculpt_undo_get_nodes();
   SculptUndoNode *unode = MEM_callocN(sizeof(*unode), __func__);
+  BLI_mutex_init(&unode->push_lock);
 
   BLI_strncpy(unode->idname, ob->id.name, sizeof(unode->idname));
   unode->type = type;
@@ -1524,6 +1529,7 @@ static SculptUndoNode *sculpt_undo_bmesh_push(Object *ob, PBVHNode *node, Sculpt
 
   if (unode == NULL) {
     unode = MEM_callocN(sizeof(*unode), __func__);
+    BLI_mutex_init(&unode->push_lock);
 
     BLI_strncpy(unode->idname, ob->id.name, sizeof(unode->idname));
     unode->type = type;
@@ -1621,15 +1627,19 @@ SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType
   }
   if ((unode = SCULPT_undo_get_node(node, type))) {
     BLI_thread_unlock(LOCK_CUSTOM1);
+    /* Another thread may still be copying the data of the node. */
+    BLI_mutex_lock(&unode->push_lock);
+    BLI_mutex_unlock(&unode->push_lock);
     return unode;
   }
 
   unode = sculpt_undo_alloc_node(ob, node, type);
 
-  /* NOTE: If this ever becomes a bottleneck, make a lock inside of the node.
-   * so we release global lock sooner, but keep data locked for until it is
-   * fully initialized.
-   */
+  /* Only the allocation and registration of the node needs the global lock. Copying the data
+   * of large nodes is done outside of it, so the nodes touched by the first step of a stroke are
+   * stored in parallel. The node stays locked until it is fully initialized. */
+  BLI_mutex_lock(&unode->push_lock);
+  BLI_thread_unlock(LOCK_CUSTOM1);
 
   if (unode->grids) {
     int totgrid, *grids;
@@ -1692,7 +1702,7 @@ SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType
     unode->shapeName[0] = '\0';
   }
 
-  BLI_thread_unlock(LOCK_CUSTOM1);
+  BLI_mutex_unlock(&unode->push_lock);
 
   return unode;
 }
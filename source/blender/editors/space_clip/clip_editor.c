@@ -663,6 +663,9 @@ typedef struct PrefetchJob {
 
   int start_frame, current_frame, end_frame;
   short render_size, render_flag;
+
+  /** Pre-fetch frames after the current frame first, and then the frames before it. */
+  bool use_forward, use_backward;
 } PrefetchJob;
 
 typedef struct PrefetchQueue {
@@ -673,6 +676,8 @@ typedef struct PrefetchQueue {
    * otherwise it goes backwards in time (starting from current frame).
    */
   bool forward;
+  /* Continue backwards from the current frame once the end frame is reached. */
+  bool use_backward;
 
   SpinLock spin;
 
@@ -786,7 +791,7 @@ static uchar *prefetch_thread_next_frame(PrefetchQueue *queue,
                                                    queue->render_flag,
                                                    1);
       /* switch direction if read frames from current up to scene end frames */
-      if (current_frame > queue->end_frame) {
+      if (current_frame > queue->end_frame && queue->use_backward) {
         queue->current_frame = queue->initial_frame;
         queue->forward = false;
       }
@@ -880,6 +885,8 @@ static void start_prefetch_threads(MovieClip *clip,
                                    int end_frame,
                                    short render_size,
                                    short render_flag,
+                                   bool use_forward,
+                                   bool use_backward,
                                    short *stop,
                                    short *do_update,
                                    float *progress)
@@ -896,7 +903,8 @@ static void start_prefetch_threads(MovieClip *clip,
   queue.end_frame = end_frame;
   queue.render_size = render_size;
   queue.render_flag = render_flag;
-  queue.forward = 1;
+  queue.forward = use_forward;
+  queue.use_backward = use_backward;
 
   queue.stop = stop;
   queue.do_update = do_update;
@@ -961,6 +969,8 @@ static void do_prefetch_movie(MovieClip *clip,
                               int end_frame,
                               short render_size,
                               short render_flag,
+                              bool use_forward,
+                              bool use_backward,
                               short *stop,
                               short *do_update,
                               float *progress)
@@ -969,7 +979,7 @@ static void do_prefetch_movie(MovieClip *clip,
   int frames_processed = 0;
 
   /* read frames starting from current frame up to scene end frame */
-  for (frame = current_frame; frame <= end_frame; frame++) {
+  for (frame = current_frame; use_forward && frame <= end_frame; frame++) {
     if (!prefetch_movie_frame(clip, clip_local, frame, render_size, render_flag, stop)) {
       return;
     }
@@ -981,7 +991,7 @@ static void do_prefetch_movie(MovieClip *clip,
   }
 
   /* read frames starting from current frame up to scene start frame */
-  for (frame = current_frame; frame >= start_frame; frame--) {
+  for (frame = current_frame; use_backward && frame >= start_frame; frame--) {
     if (!prefetch_movie_frame(clip, clip_local, frame, render_size, render_flag, stop)) {
       return;
     }
@@ -1005,6 +1015,8 @@ static void prefetch_startjob(void *pjv, short *stop, short *do_update, float *p
                            pj->end_frame,
                            pj->render_size,
                            pj->render_flag,
+                           pj->use_forward,
+                           pj->use_backward,
                            stop,
                            do_update,
                            progress);
@@ -1018,6 +1030,8 @@ static void prefetch_startjob(void *pjv, short *stop, short *do_update, float *p
                       pj->end_frame,
                       pj->render_size,
                       pj->render_flag,
+                      pj->use_forward,
+                      pj->use_backward,
                       stop,
                       do_update,
                       progress);
@@ -1067,7 +1081,11 @@ static int prefetch_get_final_frame(const bContext *C)
 }
 
 /* returns true if early out is possible */
-static bool prefetch_check_early_out(const bContext *C)
+static bool prefetch_check_early_out(const bContext *C,
+                                     short render_size,
+                                     short render_flag,
+                                     bool use_forward,
+                                     bool use_backward)
 {
   SpaceClip *sc = CTX_wm_space_clip(C);
   MovieClip *clip = ED_space_clip_get_clip(sc);
@@ -1083,36 +1101,46 @@ static bool prefetch_check_early_out(const bContext *C)
   /* check whether all the frames from prefetch range are cached */
   end_frame = prefetch_get_final_frame(C);
 
-  first_uncached_frame = prefetch_find_uncached_frame(
-      clip, sc->user.framenr, end_frame, sc->user.render_size, sc->user.render_flag, 1);
+  if (use_forward) {
+    first_uncached_frame = prefetch_find_uncached_frame(
+        clip, sc->user.framenr, end_frame, render_size, render_flag, 1);
+    if (first_uncached_frame <= end_frame && first_uncached_frame != clip_len) {
+      return false;
+    }
+  }
 
-  if (first_uncached_frame > end_frame || first_uncached_frame == clip_len) {
+  if (use_backward) {
     int start_frame = prefetch_get_start_frame(C);
 
     first_uncached_frame = prefetch_find_uncached_frame(
-        clip, sc->user.framenr, start_frame, sc->user.render_size, sc->user.render_flag, -1);
+        clip, sc->user.framenr, start_frame, render_size, render_flag, -1);
 
-    if (first_uncached_frame < start_frame) {
-      return true;
+    if (first_uncached_frame >= start_frame) {
+      return false;
     }
   }
 
-  return false;
+  return true;
 }
 
-void clip_start_prefetch_job(const bContext *C)
+static void start_prefetch_job_ex(const bContext *C,
+                                  const void *owner,
+                                  short render_size,
+                                  short render_flag,
+                                  bool use_forward,
+                                  bool use_backward)
 {
   wmJob *wm_job;
   PrefetchJob *pj;
   SpaceClip *sc = CTX_wm_space_clip(C);
 
-  if (prefetch_check_early_out(C)) {
+  if (prefetch_check_early_out(C, render_size, render_flag, use_forward, use_backward)) {
     return;
   }
 
   wm_job = WM_jobs_get(CTX_wm_manager(C),
                        CTX_wm_window(C),
-                       CTX_data_scene(C),
+                       owner,
                        "Prefetching",
                        WM_JOB_PROGRESS,
                        WM_JOB_TYPE_CLIP_PREFETCH);
@@ -1123,8 +1151,10 @@ void clip_start_prefetch_job(const bContext *C)
   pj->start_frame = prefetch_get_start_frame(C);
   pj->current_frame = sc->user.framenr;
   pj->end_frame = prefetch_get_final_frame(C);
-  pj->render_size = sc->user.render_size;
-  pj->render_flag = sc->user.render_flag;
+  pj->render_size = render_size;
+  pj->render_flag = render_flag;
+  pj->use_forward = use_forward;
+  pj->use_backward = use_backward;
 
   /* Create a local copy of the clip, so that video file (clip->anim) access can happen without
    * acquiring the lock which will interfere with the main thread. */
@@ -1142,6 +1172,31 @@ void clip_start_prefetch_job(const bContext *C)
   WM_jobs_start(CTX_wm_manager(C), wm_job);
 }
 
+void clip_start_prefetch_job(const bContext *C)
+{
+  SpaceClip *sc = CTX_wm_space_clip(C);
+
+  start_prefetch_job_ex(
+      C, CTX_data_scene(C), sc->user.render_size, sc->user.render_flag, true, true);
+}
+
+void clip_start_tracking_prefetch_job(const bContext *C, bool backwards)
+{
+  /* The tracker reads full resolution frames without any post-processing. The job is owned by
+   * the clip, so it doesn't prevent starting other jobs in the scene. */
+  start_prefetch_job_ex(C,
+                        ED_space_clip_get_clip(CTX_wm_space_clip(C)),
+                        MCLIP_PROXY_RENDER_SIZE_FULL,
+                        0,
+                        !backwards,
+                        backwards);
+}
+
+void clip_stop_tracking_prefetch_job(wmWindowManager *wm, MovieClip *clip)
+{
+  WM_jobs_stop(wm, clip, NULL);
+}
+
 void ED_clip_view_lock_state_store(const bContext *C, ClipViewLockState *state)
 {
   SpaceClip *space_clip = CTX_wm_space_clip(C);
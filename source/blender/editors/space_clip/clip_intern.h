@@ -16,6 +16,7 @@ struct ScrArea;
 struct SpaceClip;
 struct bContext;
 struct wmOperatorType;
+struct wmWindowManager;
 
 /* channel heights */
 #define CHANNEL_FIRST (-UI_TIME_SCRUB_MARGIN_Y - CHANNEL_HEIGHT_HALF - CHANNEL_SKIP)
@@ -59,6 +60,12 @@ void clip_draw_cache_and_notes(const bContext *C, SpaceClip *sc, ARegion *region
 /* clip_editor.c */
 
 void clip_start_prefetch_job(const struct bContext *C);
+/**
+ * Pre-fetch the frames that tracking in the given direction will read, so they are decoded while
+ * the markers of earlier frames are tracked.
+ */
+void clip_start_tracking_prefetch_job(const struct bContext *C, bool backwards);
+void clip_stop_tracking_prefetch_job(struct wmWindowManager *wm, struct MovieClip *clip);
 
 /* clip_graph_draw.c */
 
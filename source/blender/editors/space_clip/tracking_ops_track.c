@@ -276,6 +276,9 @@ static void track_markers_endjob(void *tmv)
   BKE_autotrack_context_sync(tmj->context);
   BKE_autotrack_context_finish(tmj->context);
 
+  /* Frames past the tracked range are not needed anymore. */
+  clip_stop_tracking_prefetch_job(tmj->wm, tmj->clip);
+
   DEG_id_tag_update(&tmj->clip->id, ID_RECALC_COPY_ON_WRITE);
   WM_main_add_notifier(NC_SCENE | ND_FRAME, tmj->scene);
 }
@@ -347,6 +350,9 @@ static int track_markers(bContext *C, wmOperator *op, bool use_job)
     WM_jobs_start(CTX_wm_manager(C), wm_job);
     WM_cursor_wait(false);
 
+    /* Decode the upcoming frames in the background, so the tracking steps don't wait for them. */
+    clip_start_tracking_prefetch_job(C, backwards);
+
     /* Add modal handler for ESC. */
     WM_event_add_modal_handler(C, op);
 
@@ -153,6 +153,9 @@ struct FileListEntryCache {
 
   /* Previews handling. */
   TaskPool *previews_pool;
+  /** Previews to load, in the order they were requested so visible ones are loaded first. Each
+   * task of `previews_pool` loads the next preview from here, whatever order the tasks run in. */
+  ThreadQueue *previews_todo;
   ThreadQueue *previews_done;
   /** Counter for previews that are not fully loaded and ready to display yet. So includes all
    * previews either in `previews_pool` or `previews_done`. #filelist_cache_previews_update() makes
@@ -174,12 +177,6 @@ struct FileListEntryPreview {
   int icon_id;
 };
 
-/* Dummy wrapper around FileListEntryPreview to ensure we do not access freed memory when freeing
- * tasks' data (see T74609). */
-struct FileListEntryPreviewTaskData {
-  FileListEntryPreview *preview;
-};
-
 struct FileListFilter {
   uint64_t filter;
   uint64_t filter_id;
@@ -1443,12 +1440,14 @@ static int filelist_intern_free_main_files(FileListIntern *filelist_intern)
   return removed_counter;
 }
 
-static void filelist_cache_preview_runf(TaskPool *__restrict pool, void *taskdata)
+static void filelist_cache_preview_runf(TaskPool *__restrict pool, void * /*taskdata*/)
 {
   FileListEntryCache *cache = static_cast<FileListEntryCache *>(BLI_task_pool_user_data(pool));
-  FileListEntryPreviewTaskData *preview_taskdata = static_cast<FileListEntryPreviewTaskData *>(
-      taskdata);
-  FileListEntryPreview *preview = preview_taskdata->preview;
+  FileListEntryPreview *preview = static_cast<FileListEntryPreview *>(
+      BLI_thread_queue_pop_timeout(cache->previews_todo, 0));
+  if (preview == nullptr) {
+    return;
+  }
 
   /* XXX #THB_SOURCE_IMAGE for "historic" reasons. The case of an undefined source should be
    * handled better. */
@@ -1487,30 +1486,16 @@ static void filelist_cache_preview_runf(TaskPool *__restrict pool, void *taskdat
   }
 
   /* Move ownership to the done queue. */
-  preview_taskdata->preview = nullptr;
-
   BLI_thread_queue_push(cache->previews_done, preview);
 
   //  printf("%s: End (%d)...\n", __func__, threadid);
 }
 
-static void filelist_cache_preview_freef(TaskPool *__restrict /*pool*/, void *taskdata)
-{
-  FileListEntryPreviewTaskData *preview_taskdata = static_cast<FileListEntryPreviewTaskData *>(
-      taskdata);
-
-  /* In case the preview wasn't moved to the "done" queue yet. */
-  if (preview_taskdata->preview) {
-    MEM_freeN(preview_taskdata->preview);
-  }
-
-  MEM_freeN(preview_taskdata);
-}
-
 static void filelist_cache_preview_ensure_running(FileListEntryCache *cache)
 {
   if (!cache->previews_pool) {
     cache->previews_pool = BLI_task_pool_create_background(cache, TASK_PRIORITY_LOW);
+    cache->previews_todo = BLI_thread_queue_init();
     cache->previews_done = BLI_thread_queue_init();
     cache->previews_todo_count = 0;
 
@@ -1524,6 +1509,11 @@ static void filelist_cache_previews_clear(FileListEntryCache *cache)
     BLI_task_pool_cancel(cache->previews_pool);
 
     FileListEntryPreview *preview;
+    /* Previews that no task picked up before canceling. */
+    while ((preview = static_cast<FileListEntryPreview *>(
+                BLI_thread_queue_pop_timeout(cache->previews_todo, 0)))) {
+      MEM_freeN(preview);
+    }
     while ((preview = static_cast<FileListEntryPreview *>(
                 BLI_thread_queue_pop_timeout(cache->previews_done, 0)))) {
       // printf("%s: DONE %d - %s - %p\n", __func__, preview->index, preview->path,
@@ -1544,9 +1534,11 @@ static void filelist_cache_previews_free(FileListEntryCache *cache)
 
     filelist_cache_previews_clear(cache);
 
+    BLI_thread_queue_free(cache->previews_todo);
     BLI_thread_queue_free(cache->previews_done);
     BLI_task_pool_free(cache->previews_pool);
     cache->previews_pool = nullptr;
+    cache->previews_todo = nullptr;
     cache->previews_done = nullptr;
     cache->previews_todo_count = 0;
 
@@ -1611,14 +1603,8 @@ static void filelist_cache_previews_push(FileList *filelist, FileDirEntry *entry
     }
     // printf("%s: %d - %s\n", __func__, preview->index, preview->filepath);
 
-    FileListEntryPreviewTaskData *preview_taskdata = MEM_new<FileListEntryPreviewTaskData>(
-        __func__);
-    preview_taskdata->preview = preview;
-    BLI_task_pool_push(cache->previews_pool,
-                       filelist_cache_preview_runf,
-                       preview_taskdata,
-                       true,
-                       filelist_cache_preview_freef);
+    BLI_thread_queue_push(cache->previews_todo, preview);
+    BLI_task_pool_push(cache->previews_pool, filelist_cache_preview_runf, nullptr, false, nullptr);
   }
   cache->previews_todo_count++;
 }
@@ -27,6 +27,7 @@
 #include "BKE_node_tree_update.h"
 #include "BKE_report.h"
 #include "BKE_scene.h"
+#include "BKE_screen.h"
 #include "BKE_workspace.h"
 
 #include "BLT_translation.h"
@@ -85,6 +86,9 @@ struct CompoJob {
   ViewLayer *view_layer;
   bNodeTree *ntree;
   int recalc_flags;
+  /* Normalized part of the viewer image visible in backdrops, computed before the whole image. */
+  rctf viewer_visible_region;
+  bool use_viewer_visible_region;
   /* Evaluated state/ */
   Depsgraph *compositor_depsgraph;
   bNodeTree *localtree;
@@ -165,6 +169,75 @@ static int compo_get_recalc_flags(const bContext *C)
   return recalc_flags;
 }
 
+/**
+ * Get the normalized part of the viewer image visible in the backdrops of node editors showing
+ * given tree. Only succeeds when it is a small part of the image, for which computing it first
+ * gives faster feedback when zoomed in.
+ */
+static bool compo_get_backdrop_visible_region(const bContext *C,
+                                              const bNodeTree *nodetree,
+                                              rctf *r_region)
+{
+  Main *bmain = CTX_data_main(C);
+  wmWindowManager *wm = CTX_wm_manager(C);
+
+  /* The image of the last execution gives the placement of the backdrop. */
+  void *lock;
+  Image *ima = BKE_image_ensure_viewer(bmain, IMA_TYPE_COMPOSITE, "Viewer Node");
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, &lock);
+  const float width = ibuf ? ibuf->x : 0;
+  const float height = ibuf ? ibuf->y : 0;
+  BKE_image_release_ibuf(ima, ibuf, lock);
+  if (width == 0 || height == 0) {
+    return false;
+  }
+
+  bool found = false;
+  LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
+    const bScreen *screen = WM_window_get_active_screen(win);
+
+    LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
+      if (area->spacetype != SPACE_NODE) {
+        continue;
+      }
+      const SpaceNode *snode = (const SpaceNode *)area->spacedata.first;
+      const ARegion *region = BKE_area_find_region_type(area, RGN_TYPE_WINDOW);
+      if (!(snode->flag & SNODE_BACKDRAW) || snode->nodetree != nodetree || region == nullptr ||
+          snode->zoom <= 0.0f) {
+        continue;
+      }
+
+      /* Same placement as the backdrop drawing, see #draw_nodespace_back_pix. */
+      const float x = (region->winx - snode->zoom * width) / 2 + snode->xof;
+      const float y = (region->winy - snode->zoom * height) / 2 + snode->yof;
+      rctf visible;
+      BLI_rctf_init(&visible,
+                    -x / (snode->zoom * width),
+                    (region->winx - x) / (snode->zoom * width),
+                    -y / (snode->zoom * height),
+                    (region->winy - y) / (snode->zoom * height));
+      if (found) {
+        BLI_rctf_union(r_region, &visible);
+      }
+      else {
+        *r_region = visible;
+        found = true;
+      }
+    }
+  }
+
+  rctf image_region;
+  BLI_rctf_init(&image_region, 0.0f, 1.0f, 0.0f, 1.0f);
+  if (nodetree->flag & NTREE_VIEWER_BORDER) {
+    BLI_rctf_isect(&image_region, &nodetree->viewer_border, &image_region);
+  }
+  if (!found || !BLI_rctf_isect(&image_region, r_region, r_region)) {
+    return false;
+  }
+  return BLI_rctf_size_x(r_region) * BLI_rctf_size_y(r_region) <
+         0.5f * BLI_rctf_size_x(&image_region) * BLI_rctf_size_y(&image_region);
+}
+
 /* called by compo, only to check job 'stop' value */
 static int compo_breakjob(void *cjv)
 {
@@ -246,6 +319,23 @@ static void compo_progressjob(void *cjv, float progress)
   *(cj->progress) = progress;
 }
 
+static void compo_exec_tree(CompoJob *cj, bNodeTree *ntree)
+{
+  Scene *scene = cj->scene;
+
+  if ((scene->r.scemode & R_MULTIVIEW) == 0) {
+    ntreeCompositExecTree(scene, ntree, &scene->r, false, true, "");
+  }
+  else {
+    LISTBASE_FOREACH (SceneRenderView *, srv, &scene->r.views) {
+      if (BKE_scene_multiview_is_render_view_active(&scene->r, srv) == false) {
+        continue;
+      }
+      ntreeCompositExecTree(scene, ntree, &scene->r, false, true, srv->name);
+    }
+  }
+}
+
 /* only this runs inside thread */
 static void compo_startjob(void *cjv,
                            /* Cannot be const, this function implements wm_jobs_start_callback.
@@ -279,16 +369,20 @@ static void compo_startjob(void *cjv,
   /* 1 is do_previews */
   BKE_callback_exec_id(cj->bmain, &scene->id, BKE_CB_EVT_COMPOSITE_PRE);
 
-  if ((cj->scene->r.scemode & R_MULTIVIEW) == 0) {
-    ntreeCompositExecTree(cj->scene, ntree, &cj->scene->r, false, true, "");
+  if (cj->use_viewer_visible_region) {
+    /* Compute only the visible part of the viewer first, areas of interest of all operations are
+     * derived from it. The whole image is computed next, refining the rest of the backdrop. */
+    const int flag = ntree->flag;
+    const rctf viewer_border = ntree->viewer_border;
+    ntree->flag |= NTREE_VIEWER_BORDER;
+    ntree->flag &= ~NTREE_TWO_PASS;
+    ntree->viewer_border = cj->viewer_visible_region;
+    compo_exec_tree(cj, ntree);
+    ntree->flag = flag;
+    ntree->viewer_border = viewer_border;
   }
-  else {
-    LISTBASE_FOREACH (SceneRenderView *, srv, &scene->r.views) {
-      if (BKE_scene_multiview_is_render_view_active(&scene->r, srv) == false) {
-        continue;
-      }
-      ntreeCompositExecTree(cj->scene, ntree, &cj->scene->r, false, true, srv->name);
-    }
+  if (!compo_breakjob(cj)) {
+    compo_exec_tree(cj, ntree);
   }
 
   ntree->test_break = nullptr;
@@ -354,6 +448,15 @@ void ED_node_composite_job(const bContext *C, bNodeTree *nodetree, Scene *scene_
   cj->view_layer = view_layer;
   cj->ntree = nodetree;
   cj->recalc_flags = compo_get_recalc_flags(C);
+  /* The full frame execution model computes whole areas at once, the tiled one already computes
+   * chunks close to the visible area first. Skip it when the composite output is needed, since
+   * it is not restricted to the visible region. */
+  if (U.experimental.use_full_frame_compositor &&
+      nodetree->execution_mode == NTREE_EXECUTION_MODE_FULL_FRAME &&
+      cj->recalc_flags == COM_RECALC_VIEWER) {
+    cj->use_viewer_visible_region = compo_get_backdrop_visible_region(
+        C, nodetree, &cj->viewer_visible_region);
+  }
 
   /* setup job */
   WM_jobs_customdata_set(wm_job, cj, compo_freejob);
@@ -13,6 +13,7 @@
 #include "DNA_collection_types.h"
 #include "DNA_object_types.h"
 
+#include "BKE_blendfile_link_append.h"
 #include "BKE_collection.h"
 #include "BKE_context.h"
 #include "BKE_idtype.h"
@@ -962,6 +963,11 @@ static int collection_view_layer_exec(bContext *C, wmOperator *op)
 
   BLI_gset_free(data.collections_to_edit, nullptr);
 
+  if (clear && flag == LAYER_COLLECTION_EXCLUDE) {
+    /* Read linked data that was deferred while the collections were excluded. */
+    BKE_blendfile_link_deferred_visible_load(bmain, scene, op->reports);
+  }
+
   BKE_view_layer_need_resync_tag(view_layer);
   DEG_relations_tag_update(bmain);
 
@@ -538,6 +538,40 @@ static void outliner_add_object_contents(SpaceOutliner *space_outliner,
   }
 }
 
+/**
+ * Cheap check if #outliner_add_object_contents() would add any elements, so that objects whose
+ * contents are not built can still be un-collapsed.
+ */
+static bool outliner_object_has_contents(const Object *ob)
+{
+  return ob->data || ob->poselib || ob->adt || ob->totcol ||
+         !BLI_listbase_is_empty(&ob->constraints) || !BLI_listbase_is_empty(&ob->modifiers) ||
+         !BLI_listbase_is_empty(&ob->greasepencil_modifiers) ||
+         !BLI_listbase_is_empty(&ob->shader_fx) ||
+         (ob->instance_collection && (ob->transflag & OB_DUPLICOLLECTION));
+}
+
+/**
+ * Objects can have many sub-elements each (object data, materials, modifiers, ...). In lazy built
+ * trees, only build them for open objects, this matters for scenes with many thousands of
+ * objects.
+ */
+static bool outliner_object_contents_skip_lazy(const SpaceOutliner *space_outliner,
+                                               TreeElement *te,
+                                               TreeStoreElem *tselem,
+                                               const Object *ob)
+{
+  const AbstractTreeDisplay *tree_display = space_outliner->runtime->tree_display.get();
+  if (tree_display == nullptr || !tree_display->is_lazy_built() ||
+      TSELEM_OPEN(tselem, space_outliner)) {
+    return false;
+  }
+  if (outliner_object_has_contents(ob)) {
+    te->flag |= TE_PRETEND_HAS_CHILDREN;
+  }
+  return true;
+}
+
 /* Can be inlined if necessary. */
 static void outliner_add_id_contents(SpaceOutliner *space_outliner,
                                      TreeElement *te,
@@ -556,7 +590,10 @@ static void outliner_add_id_contents(SpaceOutliner *space_outliner,
       BLI_assert_msg(0, "ID type expected to be expanded through new tree-element design");
       break;
     case ID_OB: {
-      outliner_add_object_contents(space_outliner, te, tselem, (Object *)id);
+      Object *ob = (Object *)id;
+      if (!outliner_object_contents_skip_lazy(space_outliner, te, tselem, ob)) {
+        outliner_add_object_contents(space_outliner, te, tselem, ob);
+      }
       break;
     }
     case ID_ME: {
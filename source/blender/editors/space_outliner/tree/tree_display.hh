@@ -105,9 +105,13 @@ class AbstractTreeDisplay {
  * \brief Tree-Display for the View Layer display mode.
  */
 class TreeDisplayViewLayer final : public AbstractTreeDisplay {
+  /** Files with at least this many objects only build the contents of open objects. */
+  static constexpr int lazy_build_objects_min = 10000;
+
   Scene *scene_ = nullptr;
   ViewLayer *view_layer_ = nullptr;
   bool show_objects_ = true;
+  bool is_lazy_built_ = false;
 
  public:
   TreeDisplayViewLayer(SpaceOutliner &space_outliner);
@@ -115,6 +119,7 @@ class TreeDisplayViewLayer final : public AbstractTreeDisplay {
   ListBase buildTree(const TreeSourceData &source_data) override;
 
   bool supportsModeColumn() const override;
+  bool is_lazy_built() const override;
 
  private:
   void add_view_layer(Scene &, ListBase &, TreeElement *);
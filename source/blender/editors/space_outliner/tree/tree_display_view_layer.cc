@@ -11,6 +11,7 @@
 #include "DNA_space_types.h"
 
 #include "BKE_layer.h"
+#include "BKE_main.h"
 
 #include "BLI_listbase.h"
 #include "BLI_listbase_wrapper.hh"
@@ -60,12 +61,19 @@ bool TreeDisplayViewLayer::supportsModeColumn() const
   return true;
 }
 
+bool TreeDisplayViewLayer::is_lazy_built() const
+{
+  return is_lazy_built_;
+}
+
 ListBase TreeDisplayViewLayer::buildTree(const TreeSourceData &source_data)
 {
   ListBase tree = {nullptr};
   Scene *scene = source_data.scene;
   scene_ = scene;
   show_objects_ = !(space_outliner_.filter & SO_FILTER_NO_OBJECT);
+  is_lazy_built_ = BLI_listbase_count_at_most(&source_data.bmain->objects,
+                                              lazy_build_objects_min) == lazy_build_objects_min;
 
   for (auto *view_layer : ListBaseWrapper<ViewLayer>(scene->view_layers)) {
     view_layer_ = view_layer;
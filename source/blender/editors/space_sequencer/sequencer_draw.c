@@ -39,6 +39,7 @@
 #include "GPU_immediate_util.h"
 #include "GPU_matrix.h"
 #include "GPU_state.h"
+#include "GPU_texture.h"
 #include "GPU_vertex_buffer.h"
 #include "GPU_viewport.h"
 
@@ -1735,6 +1736,7 @@ static void seq_prefetch_wm_notify(const bContext *C, Scene *scene)
 
 static void *sequencer_OCIO_transform_ibuf(const bContext *C,
                                            ImBuf *ibuf,
+                                           const bool is_redraw,
                                            bool *r_glsl_used,
                                            eGPUTextureFormat *r_format,
                                            eGPUDataFormat *r_data,
@@ -1743,7 +1745,10 @@ static void *sequencer_OCIO_transform_ibuf(const bContext *C,
   void *display_buffer;
   bool force_fallback = false;
   *r_glsl_used = false;
-  force_fallback |= (ED_draw_imbuf_method(ibuf) != IMAGE_DRAW_METHOD_GLSL);
+  /* The size heuristic is only about the upload, redraws of the same image reuse the texture. */
+  if (!(is_redraw && U.image_draw_method == IMAGE_DRAW_METHOD_AUTO)) {
+    force_fallback |= (ED_draw_imbuf_method(ibuf) != IMAGE_DRAW_METHOD_GLSL);
+  }
   force_fallback |= (ibuf->dither != 0.0f);
 
   /* Default */
@@ -1860,6 +1865,34 @@ static void sequencer_preview_get_rect(rctf *preview,
   }
 }
 
+void sequencer_display_cache_free(SpaceSeq *sseq)
+{
+  SpaceSeqRuntime *runtime = &sseq->runtime;
+
+  if (runtime->display_texture) {
+    GPU_texture_free(runtime->display_texture);
+    runtime->display_texture = NULL;
+  }
+  if (runtime->display_ibuf) {
+    IMB_freeImBuf(runtime->display_ibuf);
+    runtime->display_ibuf = NULL;
+  }
+}
+
+/* Return true when `ibuf` is the image that was drawn last. The reference kept to it makes sure
+ * that its pointer is not reused by another image in the meantime. */
+static bool sequencer_display_ibuf_update(SpaceSeq *sseq, ImBuf *ibuf)
+{
+  if (sseq->runtime.display_ibuf == ibuf) {
+    return true;
+  }
+
+  sequencer_display_cache_free(sseq);
+  IMB_refImBuf(ibuf);
+  sseq->runtime.display_ibuf = ibuf;
+  return false;
+}
+
 static void sequencer_draw_display_buffer(const bContext *C,
                                           Scene *scene,
                                           ARegion *region,
@@ -1898,8 +1931,9 @@ static void sequencer_draw_display_buffer(const bContext *C,
     data = GPU_DATA_UBYTE;
   }
   else {
+    const bool is_redraw = sequencer_display_ibuf_update(sseq, ibuf);
     display_buffer = sequencer_OCIO_transform_ibuf(
-        C, ibuf, &glsl_used, &format, &data, &buffer_cache_handle);
+        C, ibuf, is_redraw, &glsl_used, &format, &data, &buffer_cache_handle);
   }
 
   if (draw_backdrop) {
@@ -1909,10 +1943,17 @@ static void sequencer_draw_display_buffer(const bContext *C,
     GPU_matrix_identity_projection_set();
   }
 
-  GPUTexture *texture = GPU_texture_create_2d(
-      "seq_display_buf", ibuf->x, ibuf->y, 1, format, NULL);
-  GPU_texture_update(texture, data, display_buffer);
-  GPU_texture_filter_mode(texture, false);
+  /* With GLSL the texture holds the image itself, which is valid for any view settings. */
+  const bool use_texture_cache = glsl_used && buffer_cache_handle == NULL;
+  GPUTexture *texture = use_texture_cache ? sseq->runtime.display_texture : NULL;
+  if (texture == NULL) {
+    texture = GPU_texture_create_2d("seq_display_buf", ibuf->x, ibuf->y, 1, format, NULL);
+    GPU_texture_update(texture, data, display_buffer);
+    GPU_texture_filter_mode(texture, false);
+    if (use_texture_cache) {
+      sseq->runtime.display_texture = texture;
+    }
+  }
 
   GPU_texture_bind(texture, 0);
 
@@ -1949,7 +1990,9 @@ static void sequencer_draw_display_buffer(const bContext *C,
   immEnd();
 
   GPU_texture_unbind(texture);
-  GPU_texture_free(texture);
+  if (!use_texture_cache) {
+    GPU_texture_free(texture);
+  }
 
   if (!glsl_used) {
     immUnbindProgram();
@@ -69,6 +69,10 @@ void color3ubv_from_seq(const struct Scene *curscene,
                         uchar r_col[3]);
 
 void sequencer_special_update_set(Sequence *seq);
+/**
+ * Free the image and texture kept for redrawing the preview.
+ */
+void sequencer_display_cache_free(struct SpaceSeq *sseq);
 /* Get handle width in 2d-View space. */
 float sequence_handle_size_get_clamped(const struct Scene *scene,
                                        struct Sequence *seq,
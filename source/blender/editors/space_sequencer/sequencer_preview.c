@@ -9,6 +9,7 @@
 #include "DNA_sound_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_context.h"
@@ -30,6 +31,11 @@ typedef struct PreviewJob {
   Scene *scene;
   int total;
   int processed;
+
+  /* Job state, set while the job is running. */
+  short *stop;
+  short *do_update;
+  float *progress;
 } PreviewJob;
 
 typedef struct PreviewJobAudio {
@@ -50,55 +56,76 @@ static void free_preview_job(void *data)
   MEM_freeN(pj);
 }
 
+static void preview_clear_loading_tag(bSound *sound)
+{
+  BLI_spin_lock(sound->spinlock);
+  sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
+  BLI_spin_unlock(sound->spinlock);
+}
+
+static void preview_read_waveform_task(TaskPool *__restrict pool, void *taskdata)
+{
+  PreviewJob *pj = BLI_task_pool_user_data(pool);
+  PreviewJobAudio *previewjb = taskdata;
+  bSound *sound = previewjb->sound;
+
+  if (*pj->stop || G.is_break) {
+    /* Make sure we cleanup the loading flag! */
+    preview_clear_loading_tag(sound);
+    return;
+  }
+
+  BKE_sound_read_waveform(previewjb->bmain, sound, pj->stop);
+
+  BLI_mutex_lock(pj->mutex);
+  pj->processed++;
+  *pj->progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
+  *pj->do_update = true;
+  BLI_mutex_unlock(pj->mutex);
+}
+
 /* Only this runs inside thread. */
 static void preview_startjob(void *data, short *stop, short *do_update, float *progress)
 {
   PreviewJob *pj = data;
-  PreviewJobAudio *previewjb;
 
-  BLI_mutex_lock(pj->mutex);
-  previewjb = pj->previews.first;
-  BLI_mutex_unlock(pj->mutex);
+  pj->stop = stop;
+  pj->do_update = do_update;
+  pj->progress = progress;
 
-  while (previewjb) {
-    PreviewJobAudio *preview_next;
-    bSound *sound = previewjb->sound;
+  /* The waveforms of different sounds are independent, so read them in parallel. Sounds that are
+   * added while the job runs are handled in the next iteration. */
+  while (true) {
+    BLI_mutex_lock(pj->mutex);
+    ListBase previews = pj->previews;
+    BLI_listbase_clear(&pj->previews);
+    BLI_mutex_unlock(pj->mutex);
 
-    BKE_sound_read_waveform(previewjb->bmain, sound, stop);
+    if (BLI_listbase_is_empty(&previews)) {
+      break;
+    }
+
+    TaskPool *task_pool = BLI_task_pool_create(pj, TASK_PRIORITY_LOW);
+    LISTBASE_FOREACH (PreviewJobAudio *, previewjb, &previews) {
+      BLI_task_pool_push(task_pool, preview_read_waveform_task, previewjb, false, NULL);
+    }
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
+
+    BLI_freelistN(&previews);
 
     if (*stop || G.is_break) {
       BLI_mutex_lock(pj->mutex);
-      previewjb = previewjb->next;
-      BLI_mutex_unlock(pj->mutex);
-      while (previewjb) {
-        sound = previewjb->sound;
-
+      LISTBASE_FOREACH (PreviewJobAudio *, previewjb, &pj->previews) {
         /* Make sure we cleanup the loading flag! */
-        BLI_spin_lock(sound->spinlock);
-        sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
-        BLI_spin_unlock(sound->spinlock);
-
-        BLI_mutex_lock(pj->mutex);
-        previewjb = previewjb->next;
-        BLI_mutex_unlock(pj->mutex);
+        preview_clear_loading_tag(previewjb->sound);
       }
-
-      BLI_mutex_lock(pj->mutex);
       BLI_freelistN(&pj->previews);
       pj->total = 0;
       pj->processed = 0;
       BLI_mutex_unlock(pj->mutex);
       break;
     }
-
-    BLI_mutex_lock(pj->mutex);
-    preview_next = previewjb->next;
-    BLI_freelinkN(&pj->previews, previewjb);
-    previewjb = preview_next;
-    pj->processed++;
-    *progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
-    *do_update = true;
-    BLI_mutex_unlock(pj->mutex);
   }
 }
 
@@ -14,7 +14,9 @@
 #include "BLI_map.hh"
 #include "BLI_math.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector_set.hh"
 
 #include "DNA_armature_types.h"
 #include "DNA_curve_types.h"
@@ -3228,6 +3230,47 @@ void ED_transform_snap_object_context_destroy(SnapObjectContext *sctx)
   MEM_delete(sctx);
 }
 
+static void collect_mesh_for_snap_fn(SnapObjectContext * /*sctx*/,
+                                     const SnapObjectParams *params,
+                                     Object *ob_eval,
+                                     const float /*obmat*/[4][4],
+                                     bool /*is_object_active*/,
+                                     void *data)
+{
+  if (ob_eval->type != OB_MESH) {
+    return;
+  }
+  bool use_hide;
+  const Mesh *me_eval = mesh_for_snap(ob_eval, params->edit_mode_type, &use_hide);
+  /* Trees of edit-meshes and meshes with hidden faces depend on the filter callbacks and the
+   * edit-mode state, leave them to be built when they are used. */
+  if (me_eval == nullptr || use_hide) {
+    return;
+  }
+  static_cast<blender::VectorSet<const Mesh *> *>(data)->add(me_eval);
+}
+
+void ED_transform_snap_object_context_prebuild_trees(SnapObjectContext *sctx,
+                                                     Depsgraph *depsgraph,
+                                                     const View3D *v3d,
+                                                     const SnapObjectParams *params)
+{
+  sctx->runtime.depsgraph = depsgraph;
+  sctx->runtime.v3d = v3d;
+
+  /* Instances share their evaluated mesh, so collect the unique meshes. */
+  blender::VectorSet<const Mesh *> meshes;
+  iter_snap_objects(sctx, params, collect_mesh_for_snap_fn, &meshes);
+
+  blender::threading::parallel_for(meshes.index_range(), 1, [&](const blender::IndexRange range) {
+    for (const int i : range) {
+      BVHTreeFromMesh treedata;
+      BKE_bvhtree_from_mesh_get(&treedata, meshes[i], BVHTREE_FROM_LOOPTRI, 4);
+      free_bvhtree_from_mesh(&treedata);
+    }
+  });
+}
+
 void ED_transform_snap_object_context_set_editmesh_callbacks(
     SnapObjectContext *sctx,
     bool (*test_vert_fn)(BMVert *, void *user_data),
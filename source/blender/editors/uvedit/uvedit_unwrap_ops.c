@@ -581,9 +581,9 @@ static ParamHandle *construct_param_handle_subsurfed(const Scene *scene,
                                                      UnwrapResultInfo *result_info)
 {
   /* index pointers */
-  MPoly *mpoly;
-  MLoop *mloop;
-  MEdge *edge;
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  const MEdge *edge;
   int i;
 
   /* pointers to modifier data for unwrap control */
@@ -596,10 +596,10 @@ static ParamHandle *construct_param_handle_subsurfed(const Scene *scene,
   /* holds original indices for subsurfed mesh */
   const int *origVertIndices, *origEdgeIndices, *origPolyIndices;
   /* Holds vertices of subsurfed mesh */
-  MVert *subsurfedVerts;
-  MEdge *subsurfedEdges;
-  MPoly *subsurfedPolys;
-  MLoop *subsurfedLoops;
+  const MVert *subsurfedVerts;
+  const MEdge *subsurfedEdges;
+  const MPoly *subsurfedPolys;
+  const MLoop *subsurfedLoops;
   /* Number of vertices and faces for subsurfed mesh. */
   int numOfEdges, numOfFaces;
 
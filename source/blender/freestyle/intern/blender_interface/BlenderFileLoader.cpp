@@ -415,7 +415,7 @@ void BlenderFileLoader::insertShapeNode(Object *ob, Mesh *me, int id)
   const float(*lnors)[3] = nullptr;
 
   if (CustomData_has_layer(&me->ldata, CD_NORMAL)) {
-    lnors = (float(*)[3])CustomData_get_layer(&me->ldata, CD_NORMAL);
+    lnors = (const float(*)[3])CustomData_get_layer(&me->ldata, CD_NORMAL);
   }
 
   // Get other mesh data
@@ -473,6 +473,36 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 const FieldContext &context,
                                 Span<GVMutableArray> dst_varrays = {});
 
+/**
+ * Alternative implementation for the evaluation of fields that have to be computed for every
+ * index, e.g. with compute shaders on the GPU. When a backend is set, #evaluate_fields tries it
+ * before building a multi-function procedure for the varying fields.
+ */
+class FieldEvaluationBackend {
+ public:
+  virtual ~FieldEvaluationBackend() = default;
+
+  /**
+   * Compute the fields for all indices in the mask.
+   *
+   * \param r_outputs: Uninitialized buffers with the size of #IndexMask::min_array_size, one for
+   *   every field.
+   * eturn False when the backend can't evaluate the fields. The outputs must not be
+   *   initialized in that case, the fields are evaluated with multi-functions instead.
+   */
+  virtual bool try_evaluate(ResourceScope &scope,
+                            Span<GFieldRef> fields,
+                            IndexMask mask,
+                            const FieldContext &context,
+                            Span<GMutableSpan> r_outputs) const = 0;
+};
+
+/**
+ * Set the backend that is used by #evaluate_fields, or null to only use multi-functions. The
+ * backend has to be thread-safe and has to stay valid until it is replaced.
+ */
+void set_field_evaluation_backend(const FieldEvaluationBackend *backend);
+
 /* -------------------------------------------------------------------- */
 /** \name Utility functions for simple field creation and evaluation
  * \{ */
@@ -97,6 +97,14 @@ struct Context {
    * Custom user data that can be used in the function.
    */
   UserData *user_data;
+  /**
+   * Allocator for temporary data of the lazy-function. Everything allocated with it is freed at
+   * once when the evaluation of the entire graph is done, so it is meant for data that is small or
+   * that is alive until then anyway. It belongs to the thread that executes the lazy-function and
+   * must not be used by other threads. It is null when the function is not executed by a
+   * #GraphExecutor.
+   */
+  LinearAllocator<> *allocator = nullptr;
 };
 
 /**
@@ -9,6 +9,9 @@
  * another #Graph again).
  */
 
+#include <chrono>
+#include <thread>
+
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
@@ -16,6 +19,24 @@
 
 namespace blender::fn::lazy_function {
 
+/**
+ * Timing of a single execution of a node. Only gathered when
+ * #GraphExecutorLogger::use_node_execution_traces returns true.
+ */
+struct NodeExecutionTrace {
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+  /**
+   * Time between the node first trying to run and all its required inputs becoming available.
+   * Zero when the inputs were available already.
+   */
+  std::chrono::nanoseconds input_wait_time{0};
+  /** Thread that executed the node. */
+  std::thread::id thread;
+  /** True when the node was scheduled by another thread than the one that executed it. */
+  bool thread_migrated = false;
+};
+
 /**
  * Can be implemented to log values produced during graph evaluation.
  */
@@ -35,6 +56,15 @@ class GraphExecutorLogger {
                                       const Params &params,
                                       const Context &context) const;
 
+  /**
+   * Gathering execution traces has a small cost for every node, so it is only done when this
+   * returns true. Called once whenever the graph is executed in the given context.
+   */
+  virtual bool use_node_execution_traces(const Context &context) const;
+  virtual void log_node_execution_trace(const FunctionNode &node,
+                                        const NodeExecutionTrace &trace,
+                                        const Context &context) const;
+
   virtual void dump_when_outputs_are_missing(const FunctionNode &node,
                                              Span<const OutputSocket *> missing_sockets,
                                              const Context &context) const;
@@ -30,6 +30,7 @@
  * 3. Override the `call` function.
  */
 
+#include "BLI_compact_index_mask.hh"
 #include "BLI_hash.hh"
 
 #include "FN_multi_function_context.hh"
@@ -53,6 +54,11 @@ class MultiFunction {
    *   unused.
    */
   void call_auto(IndexMask mask, MFParams params, MFContext context) const;
+  /**
+   * Same as above, but the function is called separately for every segment of the compact mask.
+   * The segments are processed in parallel when the parameters allow it.
+   */
+  void call_auto(const CompactIndexMask &mask, MFParams params, MFContext context) const;
   virtual void call(IndexMask mask, MFParams params, MFContext context) const = 0;
 
   virtual uint64_t hash() const
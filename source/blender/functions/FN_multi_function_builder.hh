@@ -11,6 +11,7 @@
 #include <functional>
 
 #include "BLI_devirtualize_parameters.hh"
+#include "BLI_math_vec_types.hh"
 
 #include "FN_multi_function.hh"
 
@@ -97,6 +98,50 @@ template<size_t... Indices> struct SomeSpanOrSingle {
   }
 };
 
+/**
+ * Element types that are used by most fields. Devirtualizing functions that only use these types
+ * is worth the additional code.
+ */
+template<typename T>
+static constexpr bool is_common_devirtualized_type_v =
+    std::is_same_v<T, float> || std::is_same_v<T, float3> || std::is_same_v<T, int> ||
+    std::is_same_v<T, bool>;
+
+/** Functions with more inputs than this are not devirtualized by #Auto. */
+static constexpr int auto_devirtualize_max_inputs = 3;
+
+template<typename ParamType> struct AutoDevirtualizeParam {
+  static constexpr bool is_input = false;
+  static constexpr bool is_supported = true;
+};
+
+template<typename T> struct AutoDevirtualizeParam<VArray<T>> {
+  static constexpr bool is_input = true;
+  static constexpr bool is_supported = is_common_devirtualized_type_v<T>;
+};
+
+/**
+ * The default preset. It behaves like #AllSpanOrSingle for functions with up to
+ * #auto_devirtualize_max_inputs inputs of common types (see #is_common_devirtualized_type_v),
+ * which are the small functions used most often in node trees. All other functions behave like
+ * #Materialized, to keep the number of generated variants bounded. At most 16 variants are
+ * generated per function.
+ */
+struct Auto {
+  static constexpr bool use_devirtualization = true;
+  static constexpr FallbackMode fallback_mode = FallbackMode::Materialized;
+
+  template<typename Fn, typename... ParamTypes>
+  void try_devirtualize(devi::Devirtualizer<Fn, ParamTypes...> &devirtualizer)
+  {
+    constexpr int inputs_num = (int(AutoDevirtualizeParam<ParamTypes>::is_input) + ...);
+    constexpr bool all_supported = (AutoDevirtualizeParam<ParamTypes>::is_supported && ...);
+    if constexpr (inputs_num <= auto_devirtualize_max_inputs && all_supported) {
+      AllSpanOrSingle().try_devirtualize(devirtualizer);
+    }
+  }
+};
+
 }  // namespace CustomMF_presets
 
 namespace detail {
@@ -323,10 +368,10 @@ template<typename... ParamTags> class CustomMF : public MultiFunction {
   using TagsSequence = TypeSequence<ParamTags...>;
 
  public:
-  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Materialized>
+  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Auto>
   CustomMF(const char *name,
            ElementFn element_fn,
-           ExecPreset exec_preset = CustomMF_presets::Materialized())
+           ExecPreset exec_preset = CustomMF_presets::Auto())
   {
     MFSignatureBuilder signature{name};
     add_signature_parameters(signature, std::make_index_sequence<TagsSequence::size()>());
@@ -431,10 +476,10 @@ template<typename In1, typename Out1>
 class CustomMF_SI_SO : public CustomMF<MFParamTag<MFParamCategory::SingleInput, In1>,
                                        MFParamTag<MFParamCategory::SingleOutput, Out1>> {
  public:
-  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Materialized>
+  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Auto>
   CustomMF_SI_SO(const char *name,
                  ElementFn element_fn,
-                 ExecPreset exec_preset = CustomMF_presets::Materialized())
+                 ExecPreset exec_preset = CustomMF_presets::Auto())
       : CustomMF<MFParamTag<MFParamCategory::SingleInput, In1>,
                  MFParamTag<MFParamCategory::SingleOutput, Out1>>(
             name,
@@ -455,10 +500,10 @@ class CustomMF_SI_SI_SO : public CustomMF<MFParamTag<MFParamCategory::SingleInpu
                                           MFParamTag<MFParamCategory::SingleInput, In2>,
                                           MFParamTag<MFParamCategory::SingleOutput, Out1>> {
  public:
-  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Materialized>
+  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Auto>
   CustomMF_SI_SI_SO(const char *name,
                     ElementFn element_fn,
-                    ExecPreset exec_preset = CustomMF_presets::Materialized())
+                    ExecPreset exec_preset = CustomMF_presets::Auto())
       : CustomMF<MFParamTag<MFParamCategory::SingleInput, In1>,
                  MFParamTag<MFParamCategory::SingleInput, In2>,
                  MFParamTag<MFParamCategory::SingleOutput, Out1>>(
@@ -484,10 +529,10 @@ class CustomMF_SI_SI_SI_SO : public CustomMF<MFParamTag<MFParamCategory::SingleI
                                              MFParamTag<MFParamCategory::SingleInput, In3>,
                                              MFParamTag<MFParamCategory::SingleOutput, Out1>> {
  public:
-  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Materialized>
+  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Auto>
   CustomMF_SI_SI_SI_SO(const char *name,
                        ElementFn element_fn,
-                       ExecPreset exec_preset = CustomMF_presets::Materialized())
+                       ExecPreset exec_preset = CustomMF_presets::Auto())
       : CustomMF<MFParamTag<MFParamCategory::SingleInput, In1>,
                  MFParamTag<MFParamCategory::SingleInput, In2>,
                  MFParamTag<MFParamCategory::SingleInput, In3>,
@@ -516,10 +561,10 @@ class CustomMF_SI_SI_SI_SI_SO : public CustomMF<MFParamTag<MFParamCategory::Sing
                                                 MFParamTag<MFParamCategory::SingleInput, In4>,
                                                 MFParamTag<MFParamCategory::SingleOutput, Out1>> {
  public:
-  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Materialized>
+  template<typename ElementFn, typename ExecPreset = CustomMF_presets::Auto>
   CustomMF_SI_SI_SI_SI_SO(const char *name,
                           ElementFn element_fn,
-                          ExecPreset exec_preset = CustomMF_presets::Materialized())
+                          ExecPreset exec_preset = CustomMF_presets::Auto())
       : CustomMF<MFParamTag<MFParamCategory::SingleInput, In1>,
                  MFParamTag<MFParamCategory::SingleInput, In2>,
                  MFParamTag<MFParamCategory::SingleInput, In3>,
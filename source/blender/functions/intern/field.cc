@@ -275,6 +275,13 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
   BLI_assert(procedure.validate());
 }
 
+static const FieldEvaluationBackend *g_field_evaluation_backend = nullptr;
+
+void set_field_evaluation_backend(const FieldEvaluationBackend *backend)
+{
+  g_field_evaluation_backend = backend;
+}
+
 Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 Span<GFieldRef> fields_to_evaluate,
                                 IndexMask mask,
@@ -364,20 +371,7 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
   /* Evaluate varying fields if necessary. */
   if (!varying_fields_to_evaluate.is_empty()) {
-    /* Build the procedure for those fields. */
-    MFProcedure procedure;
-    build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, varying_fields_to_evaluate);
-    MFProcedureExecutor procedure_executor{procedure};
-
-    MFParamsBuilder mf_params{procedure_executor, &mask};
-    MFContextBuilder mf_context;
-
-    /* Provide inputs to the procedure executor. */
-    for (const GVArray &varray : field_context_inputs) {
-      mf_params.add_readonly_single_input(varray);
-    }
-
+    Vector<GMutableSpan> varying_outputs;
     for (const int i : varying_fields_to_evaluate.index_range()) {
       const GFieldRef &field = varying_fields_to_evaluate[i];
       const CPPType &type = field.cpp_type();
@@ -406,12 +400,33 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
         is_output_written_to_dst[out_index] = true;
       }
 
-      /* Pass output buffer to the procedure executor. */
-      const GMutableSpan span{type, buffer, array_size};
-      mf_params.add_uninitialized_single_output(span);
+      varying_outputs.append({type, buffer, array_size});
     }
 
-    procedure_executor.call_auto(mask, mf_params, mf_context);
+    if (g_field_evaluation_backend == nullptr ||
+        !g_field_evaluation_backend->try_evaluate(
+            scope, varying_fields_to_evaluate, mask, context, varying_outputs)) {
+      /* Build the procedure for those fields. */
+      MFProcedure procedure;
+      build_multi_function_procedure_for_fields(
+          procedure, scope, field_tree_info, varying_fields_to_evaluate);
+      MFProcedureExecutor procedure_executor{procedure};
+
+      MFParamsBuilder mf_params{procedure_executor, &mask};
+      MFContextBuilder mf_context;
+
+      /* Provide inputs to the procedure executor. */
+      for (const GVArray &varray : field_context_inputs) {
+        mf_params.add_readonly_single_input(varray);
+      }
+
+      /* Pass output buffers to the procedure executor. */
+      for (const GMutableSpan span : varying_outputs) {
+        mf_params.add_uninitialized_single_output(span);
+      }
+
+      procedure_executor.call_auto(mask, mf_params, mf_context);
+    }
   }
 
   /* Evaluate constant fields if necessary. */
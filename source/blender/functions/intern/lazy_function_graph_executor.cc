@@ -168,6 +168,12 @@ struct NodeState {
    * Custom storage of the node.
    */
   void *storage = nullptr;
+  /**
+   * Only used when gathering #NodeExecutionTrace. The time when the node first could not run
+   * because of missing inputs (reset when it runs) and the thread that scheduled it last.
+   */
+  std::chrono::steady_clock::time_point input_wait_start;
+  std::thread::id scheduled_thread;
 };
 
 /**
@@ -233,6 +239,10 @@ class Executor {
    */
   Params *params_ = nullptr;
   const Context *context_ = nullptr;
+  /**
+   * Gather #NodeExecutionTrace, see #GraphExecutorLogger::use_node_execution_traces.
+   */
+  bool use_node_execution_traces_ = false;
   /**
    * Used to distribute work on separate nodes to separate threads.
    * If this is empty, the executor is in single threaded mode.
@@ -243,7 +253,8 @@ class Executor {
 #endif
   /**
    * A separate linear allocator for every thread. We could potentially reuse some memory, but that
-   * doesn't seem worth it yet.
+   * doesn't seem worth it yet. Executed nodes allocate their temporary data from it as well, see
+   * #Context::allocator.
    */
   threading::EnumerableThreadSpecific<LinearAllocator<>> local_allocators_;
   LinearAllocator<> *main_local_allocator_ = nullptr;
@@ -283,6 +294,8 @@ class Executor {
   {
     params_ = &params;
     context_ = &context;
+    use_node_execution_traces_ = self_.logger_ != nullptr &&
+                                 self_.logger_->use_node_execution_traces(context);
 #ifdef FN_LAZY_FUNCTION_DEBUG_THREADS
     current_main_thread_ = std::this_thread::get_id();
 #endif
@@ -541,6 +554,9 @@ class Executor {
     switch (locked_node.node_state.schedule_state) {
       case NodeScheduleState::NotScheduled: {
         locked_node.node_state.schedule_state = NodeScheduleState::Scheduled;
+        if (use_node_execution_traces_) {
+          locked_node.node_state.scheduled_thread = std::this_thread::get_id();
+        }
         const FunctionNode &node = static_cast<const FunctionNode &>(locked_node.node);
         if (this->use_multi_threading()) {
           std::lock_guard lock{current_task.mutex};
@@ -619,6 +635,7 @@ class Executor {
     const LazyFunction &fn = node.function();
 
     bool node_needs_execution = false;
+    NodeExecutionTrace trace;
     this->with_locked_node(node, node_state, current_task, [&](LockedNode &locked_node) {
       BLI_assert(node_state.schedule_state == NodeScheduleState::Scheduled);
       node_state.schedule_state = NodeScheduleState::Running;
@@ -683,11 +700,25 @@ class Executor {
           continue;
         }
         if (input_state.usage == ValueUsage::Used) {
+          if (use_node_execution_traces_ &&
+              node_state.input_wait_start == std::chrono::steady_clock::time_point()) {
+            node_state.input_wait_start = std::chrono::steady_clock::now();
+          }
           return;
         }
       }
 
       node_needs_execution = true;
+
+      if (use_node_execution_traces_) {
+        trace.start = std::chrono::steady_clock::now();
+        if (node_state.input_wait_start != std::chrono::steady_clock::time_point()) {
+          trace.input_wait_time = trace.start - node_state.input_wait_start;
+          node_state.input_wait_start = {};
+        }
+        trace.thread = std::this_thread::get_id();
+        trace.thread_migrated = node_state.scheduled_thread != trace.thread;
+      }
     });
 
     if (node_needs_execution) {
@@ -695,6 +726,11 @@ class Executor {
        * being hold very long in some cases and results in multiple locks being hold by the same
        * thread in the same graph which can lead to deadlocks. */
       this->execute_node(node, node_state, current_task);
+
+      if (use_node_execution_traces_) {
+        trace.end = std::chrono::steady_clock::now();
+        self_.logger_->log_node_execution_trace(node, trace, *context_);
+      }
     }
 
     this->with_locked_node(node, node_state, current_task, [&](LockedNode &locked_node) {
@@ -1131,6 +1167,9 @@ inline void Executor::execute_node(const FunctionNode &node,
   BLI_assert(context_ != nullptr);
   Context fn_context = *context_;
   fn_context.storage = node_state.storage;
+  /* Always use the allocator of the current thread, because the node may keep using it while the
+   * executor switches to multi-threading. */
+  fn_context.allocator = &local_allocators_.local();
 
   if (self_.logger_ != nullptr) {
     self_.logger_->log_before_node_execute(node, node_params, fn_context);
@@ -1216,6 +1255,19 @@ void GraphExecutorLogger::log_after_node_execute(const FunctionNode &node,
   UNUSED_VARS(node, params, context);
 }
 
+bool GraphExecutorLogger::use_node_execution_traces(const Context &context) const
+{
+  UNUSED_VARS(context);
+  return false;
+}
+
+void GraphExecutorLogger::log_node_execution_trace(const FunctionNode &node,
+                                                   const NodeExecutionTrace &trace,
+                                                   const Context &context) const
+{
+  UNUSED_VARS(node, trace, context);
+}
+
 Vector<const FunctionNode *> GraphExecutorSideEffectProvider::get_nodes_with_side_effects(
     const Context &context) const
 {
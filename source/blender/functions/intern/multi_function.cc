@@ -131,6 +131,21 @@ void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context
   });
 }
 
+void MultiFunction::call_auto(const CompactIndexMask &mask,
+                              MFParams params,
+                              MFContext context) const
+{
+  if (mask.is_empty()) {
+    return;
+  }
+  if (!supports_threading_by_slicing_params(*this)) {
+    mask.foreach_segment([&](const IndexMask segment) { this->call(segment, params, context); });
+    return;
+  }
+  mask.foreach_segment_parallel(
+      [&](const IndexMask segment) { this->call_auto(segment, params, context); });
+}
+
 std::string MultiFunction::debug_name() const
 {
   return signature_ref_->function_name;
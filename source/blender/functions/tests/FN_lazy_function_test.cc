@@ -51,6 +51,30 @@ class StoreValueFunction : public LazyFunction {
   }
 };
 
+class SumWithTemporaryFunction : public LazyFunction {
+ public:
+  SumWithTemporaryFunction()
+  {
+    debug_name_ = "Sum With Temporary";
+    inputs_.append({"Size", CPPType::get<int>()});
+    outputs_.append({"Sum", CPPType::get<int>()});
+  }
+
+  void execute_impl(Params &params, const Context &context) const override
+  {
+    const int size = params.get_input<int>(0);
+    MutableSpan<int> values = context.allocator->allocate_array<int>(size);
+    for (const int i : values.index_range()) {
+      values[i] = i;
+    }
+    int sum = 0;
+    for (const int value : values) {
+      sum += value;
+    }
+    params.set_output(0, sum);
+  }
+};
+
 class SimpleSideEffectProvider : public GraphExecutor::SideEffectProvider {
  private:
   Vector<const FunctionNode *> side_effect_nodes_;
@@ -112,4 +136,24 @@ TEST(lazy_function, SideEffects)
   EXPECT_EQ(dst2, 105);
 }
 
+TEST(lazy_function, NodeAllocator)
+{
+  const SumWithTemporaryFunction sum_fn;
+
+  Graph graph;
+  FunctionNode &sum_node = graph.add_function(sum_fn);
+  DummyNode &input_node = graph.add_dummy({}, {&CPPType::get<int>()});
+  DummyNode &output_node = graph.add_dummy({&CPPType::get<int>()}, {});
+  graph.add_link(input_node.output(0), sum_node.input(0));
+  graph.add_link(sum_node.output(0), output_node.input(0));
+  graph.update_node_indices();
+
+  GraphExecutor executor_fn{
+      graph, {&input_node.output(0)}, {&output_node.input(0)}, nullptr, nullptr};
+  int result = 0;
+  execute_lazy_function_eagerly(
+      executor_fn, nullptr, std::make_tuple(1000), std::make_tuple(&result));
+  EXPECT_EQ(result, 499500);
+}
+
 }  // namespace blender::fn::lazy_function::tests
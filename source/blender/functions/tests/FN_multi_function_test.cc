@@ -6,6 +6,8 @@
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_test_common.hh"
 
+#include "BLI_timeit.hh"
+
 namespace blender::fn::tests {
 namespace {
 
@@ -60,6 +62,35 @@ TEST(multi_function, AddFunction)
   EXPECT_EQ(output[2], 36);
 }
 
+TEST(multi_function, AddFunctionCompactMask)
+{
+  AddFunction fn;
+
+  const int size = 100000;
+  Array<int> input1(size);
+  Array<int> input2(size, 10);
+  Array<int> output(size, -1);
+  Array<bool> selection(size);
+  for (const int i : IndexRange(size)) {
+    input1[i] = i;
+    selection[i] = i % 3 == 0 || (i >= 40000 && i < 70000);
+  }
+  const CompactIndexMask mask = CompactIndexMask::from_bools(selection);
+
+  MFParamsBuilder params(fn, size);
+  params.add_readonly_single_input(input1.as_span());
+  params.add_readonly_single_input(input2.as_span());
+  params.add_uninitialized_single_output(output.as_mutable_span());
+
+  MFContextBuilder context;
+
+  fn.call_auto(mask, params, context);
+
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(output[i], selection[i] ? i + 10 : -1);
+  }
+}
+
 TEST(multi_function, AddPrefixFunction)
 {
   AddPrefixFunction fn;
@@ -194,6 +225,91 @@ TEST(multi_function, CustomMF_SI_SI_SO)
   EXPECT_EQ(outputs[3], 90);
 }
 
+TEST(multi_function, CustomMF_AutoDevirtualize)
+{
+  /* Uses the #CustomMF_presets::Auto preset, which devirtualizes spans and single values but has
+   * to fall back to the materialized execution for other virtual arrays. */
+  CustomMF_SI_SI_SO<float3, float, float3> fn("scale", [](float3 a, float b) { return a * b; });
+
+  const int size = 1000;
+  Array<float3> values_a(size);
+  Array<float> values_b(size);
+  for (const int i : IndexRange(size)) {
+    values_a[i] = float3(i, 1.0f, -i);
+    values_b[i] = i % 5;
+  }
+
+  auto check = [&](const GVArray &a, const GVArray &b, const IndexMask mask) {
+    Array<float3> outputs(size, float3(-1.0f));
+
+    MFParamsBuilder params(fn, size);
+    params.add_readonly_single_input(a);
+    params.add_readonly_single_input(b);
+    params.add_uninitialized_single_output(outputs.as_mutable_span());
+
+    MFContextBuilder context;
+    fn.call(mask, params, context);
+
+    const VArray<float3> a_typed = a.typed<float3>();
+    const VArray<float> b_typed = b.typed<float>();
+    for (const int64_t i : mask) {
+      EXPECT_EQ(outputs[i], a_typed[i] * b_typed[i]);
+    }
+  };
+
+  const GVArray a_span = VArray<float3>::ForSpan(values_a);
+  const GVArray b_span = VArray<float>::ForSpan(values_b);
+  const GVArray b_single = VArray<float>::ForSingle(2.0f, size);
+  const GVArray b_func = VArray<float>::ForFunc(size, [](const int64_t i) { return float(i); });
+  const Vector<int64_t> indices = {0, 2, 5, 10, 999};
+
+  check(a_span, b_span, IndexRange(size));
+  check(a_span, b_single, IndexRange(size));
+  check(a_span, b_func, IndexRange(size));
+  check(a_span, b_span, indices.as_span());
+  check(a_span, b_func, indices.as_span());
+}
+
+#if 0
+/* Compares the default preset with the materialized fallback that all functions used before. The
+ * materialized timings are also what the default preset falls back to when an input is not a span
+ * or single value. */
+TEST(multi_function, CustomMF_AutoDevirtualizeBenchmark)
+{
+  const int size = 10'000'000;
+  Array<float3> values_a(size, float3(1.0f, 2.0f, 3.0f));
+  Array<float> values_b(size, 0.5f);
+  Array<float3> outputs(size);
+  const auto element_fn = [](float3 a, float b) { return a * b; };
+
+  const GVArray b_func = VArray<float>::ForFunc(size, [](const int64_t i) { return float(i); });
+  const GVArray b_single = VArray<float>::ForSingle(2.0f, size);
+
+  const auto run = [&](const MultiFunction &fn, const GVArray &b, const char *name) {
+    MFParamsBuilder params(fn, size);
+    params.add_readonly_single_input(values_a.as_span());
+    params.add_readonly_single_input(b);
+    params.add_uninitialized_single_output(outputs.as_mutable_span());
+    MFContextBuilder context;
+    SCOPED_TIMER(name);
+    fn.call(IndexRange(size), params, context);
+  };
+
+  CustomMF_SI_SI_SO<float3, float, float3> fn_materialized(
+      "scale", element_fn, CustomMF_presets::Materialized());
+  CustomMF_SI_SI_SO<float3, float, float3> fn_auto("scale", element_fn);
+
+  for ([[maybe_unused]] const int i : IndexRange(5)) {
+    run(fn_materialized, VArray<float>::ForSpan(values_b), "Materialized span");
+    run(fn_auto, VArray<float>::ForSpan(values_b), "Auto span");
+    run(fn_materialized, b_single, "Materialized single");
+    run(fn_auto, b_single, "Auto single");
+    run(fn_materialized, b_func, "Materialized function");
+    run(fn_auto, b_func, "Auto function (fallback)");
+  }
+}
+#endif
+
 TEST(multi_function, CustomMF_SI_SI_SI_SO)
 {
   CustomMF_SI_SI_SI_SO<int, std::string, bool, uint> fn{
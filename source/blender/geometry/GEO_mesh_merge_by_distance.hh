@@ -19,12 +19,15 @@ namespace blender::geometry {
  * Merge selected vertices into other selected vertices within the \a merge_distance. The merged
  * indices favor speed over accuracy, since the results will depend on the order of the vertices.
  *
+ * \param use_grid: Find the vertices to merge with #calc_duplicates_grid instead of a KD tree.
+ *
  * \returns #std::nullopt if the mesh should not be changed (no vertices are merged), in order to
  * avoid copying the input. Otherwise returns the new mesh with merged geometry.
  */
 std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  IndexMask selection,
-                                                 float merge_distance);
+                                                 float merge_distance,
+                                                 bool use_grid = false);
 
 /**
  * Merge selected vertices along edges to other selected vertices. Only vertices connected by edges
@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "BLI_index_mask.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
 
 #pragma once
 
@@ -16,9 +18,28 @@ namespace blender::geometry {
 /**
  * Merge selected points into other selected points within the \a merge_distance. The merged
  * indices favor speed over accuracy, since the results will depend on the order of the points.
+ *
+ * \param use_grid: Find the points to merge with #calc_duplicates_grid instead of a KD tree.
  */
 PointCloud *point_merge_by_distance(const PointCloud &src_points,
                                     const float merge_distance,
-                                    const IndexMask selection);
+                                    const IndexMask selection,
+                                    bool use_grid = false);
+
+/**
+ * Find selected points within the \a merge_distance of other selected points, with the same
+ * rules as #BLI_kdtree_3d_calc_duplicates_fast. The points are sorted into a uniform grid, and
+ * groups of cells that are far enough apart from each other are processed in parallel. This
+ * needs less memory than a KD tree and scales better with many threads, but the cells can become
+ * slow to process when many points are within the merge distance of each other.
+ *
+ * \param r_duplicates: Indexed by point, values initialized to -1 are candidates to be merged.
+ * Merged points are set to the index of the point they are merged into, which is set to itself.
+ * \return The number of merged points.
+ */
+int calc_duplicates_grid(Span<float3> positions,
+                         IndexMask selection,
+                         float merge_distance,
+                         MutableSpan<int> r_duplicates);
 
 }  // namespace blender::geometry
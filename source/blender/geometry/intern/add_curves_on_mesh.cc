@@ -61,16 +61,22 @@ static Array<NeighborCurves> find_curve_neighbors(const Span<float3> root_positi
                                                   const KDTree_3d &old_roots_kdtree)
 {
   const int tot_added_curves = root_positions.size();
+  Array<KDTreeNearest_3d> nearest_per_curve(tot_added_curves * max_neighbors);
+  Array<int> found_per_curve(tot_added_curves);
+  BLI_kdtree_3d_find_nearest_n_batch(&old_roots_kdtree,
+                                     reinterpret_cast<const float(*)[3]>(root_positions.data()),
+                                     uint(tot_added_curves),
+                                     nearest_per_curve.data(),
+                                     max_neighbors,
+                                     found_per_curve.data());
+
   Array<NeighborCurves> neighbors_per_curve(tot_added_curves);
   threading::parallel_for(IndexRange(tot_added_curves), 128, [&](const IndexRange range) {
     for (const int i : range) {
-      const float3 root = root_positions[i];
-      std::array<KDTreeNearest_3d, max_neighbors> nearest_n;
-      const int found_neighbors = BLI_kdtree_3d_find_nearest_n(
-          &old_roots_kdtree, root, nearest_n.data(), max_neighbors);
+      const Span<KDTreeNearest_3d> nearest_n = nearest_per_curve.as_span().slice(
+          i * max_neighbors, found_per_curve[i]);
       float tot_weight = 0.0f;
-      for (const int neighbor_i : IndexRange(found_neighbors)) {
-        KDTreeNearest_3d &nearest = nearest_n[neighbor_i];
+      for (const KDTreeNearest_3d &nearest : nearest_n) {
         const float weight = 1.0f / std::max(nearest.dist, 0.00001f);
         tot_weight += weight;
         neighbors_per_curve[i].append({nearest.index, weight});
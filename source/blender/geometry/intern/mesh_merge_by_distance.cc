@@ -5,6 +5,7 @@
 #include "BLI_kdtree.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
@@ -14,6 +15,7 @@
 #include "BKE_mesh.h"
 
 #include "GEO_mesh_merge_by_distance.hh"
+#include "GEO_point_merge_by_distance.hh"
 
 //#define USE_WELD_DEBUG
 //#define USE_WELD_NORMALS
@@ -1546,21 +1548,33 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
 
 std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const IndexMask selection,
-                                                 const float merge_distance)
+                                                 const float merge_distance,
+                                                 const bool use_grid)
 {
   Array<int> vert_dest_map(mesh.totvert, OUT_OF_CONTEXT);
 
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
   const Span<MVert> verts = mesh.verts();
-  for (const int i : selection) {
-    BLI_kdtree_3d_insert(tree, i, verts[i].co);
+  int vert_kill_len = 0;
+  if (use_grid) {
+    Array<float3> positions(mesh.totvert);
+    threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        positions[i] = verts[i].co;
+      }
+    });
+    vert_kill_len = calc_duplicates_grid(positions, selection, merge_distance, vert_dest_map);
   }
+  else {
+    KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+    for (const int i : selection) {
+      BLI_kdtree_3d_insert(tree, i, verts[i].co);
+    }
 
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, false, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+    BLI_kdtree_3d_balance(tree);
+    vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
+        tree, merge_distance, false, vert_dest_map.data());
+    BLI_kdtree_3d_free(tree);
+  }
 
   if (vert_kill_len == 0) {
     return std::nullopt;
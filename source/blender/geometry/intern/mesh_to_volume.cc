@@ -1,5 +1,8 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
+#include "BLI_task.hh"
+
 #include "BKE_mesh.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_volume.h"
@@ -16,10 +19,10 @@ namespace blender::geometry {
 /* This class follows the MeshDataAdapter interface from openvdb. */
 class OpenVDBMeshAdapter {
  private:
-  Span<MVert> verts_;
+  /** Vertex positions in index space, transformed once instead of for every triangle corner. */
+  Array<float3> positions_;
   Span<MLoop> loops_;
   Span<MLoopTri> looptris_;
-  float4x4 transform_;
 
  public:
   OpenVDBMeshAdapter(const Mesh &mesh, float4x4 transform);
@@ -30,8 +33,16 @@ class OpenVDBMeshAdapter {
 };
 
 OpenVDBMeshAdapter::OpenVDBMeshAdapter(const Mesh &mesh, float4x4 transform)
-    : verts_(mesh.verts()), loops_(mesh.loops()), looptris_(mesh.looptris()), transform_(transform)
+    : positions_(mesh.totvert, NoInitialization()),
+      loops_(mesh.loops()),
+      looptris_(mesh.looptris())
 {
+  const Span<MVert> verts = mesh.verts();
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      positions_[i] = transform * float3(verts[i].co);
+    }
+  });
 }
 
 size_t OpenVDBMeshAdapter::polygonCount() const
@@ -41,7 +52,7 @@ size_t OpenVDBMeshAdapter::polygonCount() const
 
 size_t OpenVDBMeshAdapter::pointCount() const
 {
-  return size_t(verts_.size());
+  return size_t(positions_.size());
 }
 
 size_t OpenVDBMeshAdapter::vertexCount(size_t /*polygon_index*/) const
@@ -55,9 +66,8 @@ void OpenVDBMeshAdapter::getIndexSpacePoint(size_t polygon_index,
                                             openvdb::Vec3d &pos) const
 {
   const MLoopTri &looptri = looptris_[polygon_index];
-  const MVert &vertex = verts_[loops_[looptri.tri[vertex_index]].v];
-  const float3 transformed_co = transform_ * float3(vertex.co);
-  pos = &transformed_co.x;
+  const float3 &co = positions_[loops_[looptri.tri[vertex_index]].v];
+  pos = &co.x;
 }
 
 float volume_compute_voxel_size(const Depsgraph *depsgraph,
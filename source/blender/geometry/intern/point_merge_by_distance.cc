@@ -1,7 +1,10 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_bounds.hh"
 #include "BLI_kdtree.h"
+#include "BLI_sort.hh"
 #include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_pointcloud_types.h"
 
@@ -13,52 +16,225 @@
 
 namespace blender::geometry {
 
+/* -------------------------------------------------------------------- */
+/** \name Grid Based Merge Detection
+ * \{ */
+
+/** Number of bits used for the cell coordinate of every axis in the cell key. */
+static constexpr int cell_axis_bits = 21;
+static constexpr int cell_axis_max = (1 << cell_axis_bits) - 1;
+
+struct CellPoint {
+  uint64_t cell_key;
+  int index;
+};
+
+static uint64_t cell_key_from_coord(const int3 &cell)
+{
+  return (uint64_t(cell.x) << (2 * cell_axis_bits)) | (uint64_t(cell.y) << cell_axis_bits) |
+         uint64_t(cell.z);
+}
+
+/** The coordinates of the cell and its neighbors along one axis. */
+static IndexRange neighbor_coords(const int coord)
+{
+  const int begin = std::max(coord - 1, 0);
+  const int end = std::min(coord + 1, cell_axis_max);
+  return IndexRange(begin, end - begin + 1);
+}
+
+static int3 cell_coord_from_key(const uint64_t key)
+{
+  return int3(int(key >> (2 * cell_axis_bits)),
+              int((key >> cell_axis_bits) & cell_axis_max),
+              int(key & cell_axis_max));
+}
+
+int calc_duplicates_grid(const Span<float3> positions,
+                         const IndexMask selection,
+                         const float merge_distance,
+                         MutableSpan<int> r_duplicates)
+{
+  const std::optional<bounds::MinMaxResult<float3>> bounds = bounds::min_max(positions);
+  if (!bounds || selection.is_empty()) {
+    return 0;
+  }
+
+  /* Points closer than the cell size are always in neighboring cells. The cells can be larger
+   * than the merge distance, which is necessary when the coordinates don't fit into the keys. */
+  const float3 extent = bounds->max - bounds->min;
+  const float extent_max = std::max({extent.x, extent.y, extent.z});
+  float cell_size = std::max(merge_distance, extent_max / float(cell_axis_max - 1));
+  if (!(cell_size > 0.0f)) {
+    cell_size = 1.0f;
+  }
+  const float cell_size_inv = 1.0f / cell_size;
+  const float merge_distance_sq = merge_distance * merge_distance;
+
+  /* Sort the selected points by their cell, so that every cell is a contiguous range. */
+  Array<CellPoint> points(selection.size(), NoInitialization());
+  threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int point_i = selection[i];
+      const float3 local = (positions[point_i] - bounds->min) * cell_size_inv;
+      int3 cell;
+      for (const int axis : IndexRange(3)) {
+        /* Written so that NAN coordinates end up in the first cell. */
+        cell[axis] = local[axis] > 0.0f ? int(std::min(local[axis], float(cell_axis_max))) : 0;
+      }
+      points[i] = {cell_key_from_coord(cell), point_i};
+    }
+  });
+  parallel_sort(points.begin(), points.end(), [](const CellPoint &a, const CellPoint &b) {
+    return a.cell_key < b.cell_key || (a.cell_key == b.cell_key && a.index < b.index);
+  });
+
+  Vector<uint64_t> cell_keys;
+  Vector<int> cell_offsets;
+  for (const int i : points.index_range()) {
+    if (i == 0 || points[i].cell_key != points[i - 1].cell_key) {
+      cell_keys.append(points[i].cell_key);
+      cell_offsets.append(i);
+    }
+  }
+  cell_offsets.append(int(points.size()));
+
+  auto cell_points = [&](const int cell_index) {
+    return points.as_span().slice(cell_offsets[cell_index],
+                                  cell_offsets[cell_index + 1] - cell_offsets[cell_index]);
+  };
+
+  /* Merging into a point only changes points in the neighboring cells. When the cell coordinates
+   * of two cells are the same modulo three, their neighborhoods don't overlap, so they can be
+   * processed in parallel. Iterating over these groups of cells in a fixed order also gives the
+   * same result independent of the number of threads. */
+  for (const int group : IndexRange(27)) {
+    const int3 group_coord(group / 9, (group / 3) % 3, group % 3);
+    threading::parallel_for(cell_keys.index_range(), 256, [&](const IndexRange range) {
+      for (const int cell_index : range) {
+        const int3 cell = cell_coord_from_key(cell_keys[cell_index]);
+        if (cell.x % 3 != group_coord.x || cell.y % 3 != group_coord.y ||
+            cell.z % 3 != group_coord.z) {
+          continue;
+        }
+
+        Vector<Span<CellPoint>, 27> neighbors;
+        for (const int x : neighbor_coords(cell.x)) {
+          for (const int y : neighbor_coords(cell.y)) {
+            for (const int z : neighbor_coords(cell.z)) {
+              const uint64_t key = cell_key_from_coord(int3(x, y, z));
+              const uint64_t *found = std::lower_bound(cell_keys.begin(), cell_keys.end(), key);
+              if (found != cell_keys.end() && *found == key) {
+                neighbors.append(cell_points(int(found - cell_keys.begin())));
+              }
+            }
+          }
+        }
+
+        /* Same as #BLI_kdtree_3d_calc_duplicates_fast, but only looking at the neighbors. */
+        for (const CellPoint &point : cell_points(cell_index)) {
+          const int index = point.index;
+          if (!ELEM(r_duplicates[index], -1, index)) {
+            continue;
+          }
+          const float3 &position = positions[index];
+          bool found = false;
+          for (const Span<CellPoint> neighbor_points : neighbors) {
+            for (const CellPoint &other : neighbor_points) {
+              if (other.index != index && r_duplicates[other.index] == -1 &&
+                  math::distance_squared(positions[other.index], position) <=
+                      merge_distance_sq) {
+                r_duplicates[other.index] = index;
+                found = true;
+              }
+            }
+          }
+          if (found) {
+            /* Prevent chains of doubles. */
+            r_duplicates[index] = index;
+          }
+        }
+      }
+    });
+  }
+
+  return threading::parallel_reduce(
+      selection.index_range(),
+      4096,
+      0,
+      [&](const IndexRange range, int count) {
+        for (const int index : selection.slice(range)) {
+          if (!ELEM(r_duplicates[index], -1, index)) {
+            count++;
+          }
+        }
+        return count;
+      },
+      std::plus<int>());
+}
+
+/** \} */
+
 PointCloud *point_merge_by_distance(const PointCloud &src_points,
                                     const float merge_distance,
-                                    const IndexMask selection)
+                                    const IndexMask selection,
+                                    const bool use_grid)
 {
   const bke::AttributeAccessor src_attributes = src_points.attributes();
   VArraySpan<float3> positions = src_attributes.lookup_or_default<float3>(
       "position", ATTR_DOMAIN_POINT, float3(0));
   const int src_size = positions.size();
 
-  /* Create the KD tree based on only the selected points, to speed up merge detection and
-   * balancing. */
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-  for (const int i : selection.index_range()) {
-    BLI_kdtree_3d_insert(tree, i, positions[selection[i]]);
+  /* By default, every point is just "merged" with itself. */
+  Array<int> merge_indices(src_size);
+  int duplicate_count = 0;
+  if (use_grid) {
+    /* The grid search works with indices of the source point cloud directly. */
+    Array<int> duplicates(src_size, -1);
+    duplicate_count = calc_duplicates_grid(positions, selection, merge_distance, duplicates);
+    threading::parallel_for(merge_indices.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        merge_indices[i] = duplicates[i] == -1 ? i : duplicates[i];
+      }
+    });
   }
-  BLI_kdtree_3d_balance(tree);
+  else {
+    /* Create the KD tree based on only the selected points, to speed up merge detection and
+     * balancing. */
+    KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+    for (const int i : selection.index_range()) {
+      BLI_kdtree_3d_insert(tree, i, positions[selection[i]]);
+    }
+    BLI_kdtree_3d_balance(tree);
 
-  /* Find the duplicates in the KD tree. Because the tree only contains the selected points, the
-   * resulting indices are indices into the selection, rather than indices of the source point
-   * cloud. */
-  Array<int> selection_merge_indices(selection.size(), -1);
-  const int duplicate_count = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, false, selection_merge_indices.data());
-  BLI_kdtree_3d_free(tree);
+    /* Find the duplicates in the KD tree. Because the tree only contains the selected points,
+     * the resulting indices are indices into the selection, rather than indices of the source
+     * point cloud. */
+    Array<int> selection_merge_indices(selection.size(), -1);
+    duplicate_count = BLI_kdtree_3d_calc_duplicates_fast(
+        tree, merge_distance, false, selection_merge_indices.data());
+    BLI_kdtree_3d_free(tree);
+
+    /* Fill in the results of the merge finding, converting from indices into the selection to
+     * indices into the full input point cloud. */
+    for (const int i : merge_indices.index_range()) {
+      merge_indices[i] = i;
+    }
+    for (const int i : selection_merge_indices.index_range()) {
+      const int merge_index = selection_merge_indices[i];
+      if (merge_index != -1) {
+        const int src_merge_index = selection[merge_index];
+        const int src_index = selection[i];
+        merge_indices[src_index] = src_merge_index;
+      }
+    }
+  }
 
   /* Create the new point cloud and add it to a temporary component for the attribute API. */
   const int dst_size = src_size - duplicate_count;
   PointCloud *dst_pointcloud = BKE_pointcloud_new_nomain(dst_size);
   bke::MutableAttributeAccessor dst_attributes = dst_pointcloud->attributes_for_write();
 
-  /* By default, every point is just "merged" with itself. Then fill in the results of the merge
-   * finding, converting from indices into the selection to indices into the full input point
-   * cloud. */
-  Array<int> merge_indices(src_size);
-  for (const int i : merge_indices.index_range()) {
-    merge_indices[i] = i;
-  }
-  for (const int i : selection_merge_indices.index_range()) {
-    const int merge_index = selection_merge_indices[i];
-    if (merge_index != -1) {
-      const int src_merge_index = selection[merge_index];
-      const int src_index = selection[i];
-      merge_indices[src_index] = src_merge_index;
-    }
-  }
-
   /* For every source index, find the corresponding index in the result by iterating through the
    * source indices and counting how many merges happened before that point. */
   int merged_points = 0;
@@ -205,7 +205,14 @@ struct AllCurvesInfo {
   bool create_resolution_attribute = false;
 };
 
-/** Collects all tasks that need to be executed to realize all instances. */
+/**
+ * Maximum number of tasks of each type that are gathered before they are executed. This limits
+ * the memory used by tasks when there are very many instances, and keeps the data written by a
+ * batch of tasks close together.
+ */
+static constexpr int64_t max_tasks_per_batch = 4096;
+
+/** Collects tasks that need to be executed to realize all instances. */
 struct GatherTasks {
   Vector<RealizePointCloudTask> pointcloud_tasks;
   Vector<RealizeMeshTask> mesh_tasks;
@@ -239,10 +246,23 @@ struct GatherTasksInfo {
    */
   Vector<std::unique_ptr<GArray<>>> &r_temporary_arrays;
 
-  /** All gathered tasks. */
+  /**
+   * When true, no tasks are created and only the offsets are computed. This is used in a first
+   * pass to find the size of the output geometries before they are allocated.
+   */
+  bool count_only = false;
+  /** Executes and removes all gathered tasks, called when a batch is full. */
+  FunctionRef<void()> flush_tasks_fn;
+
+  /** Gathered tasks that have not been executed yet. */
   GatherTasks r_tasks;
   /** Current offsets while gathering tasks. */
   GatherOffsets r_offsets;
+
+  /** The first geometries that are realized, found while counting. */
+  const PointCloudRealizeInfo *r_first_pointcloud = nullptr;
+  const MeshRealizeInfo *r_first_mesh = nullptr;
+  const RealizeCurveInfo *r_first_curve = nullptr;
 };
 
 /**
@@ -458,6 +478,24 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   const Span<int> handles = instances_component.instance_reference_handles();
   const Span<float4x4> transforms = instances_component.instance_transforms();
 
+  if (gather_info.count_only) {
+    /* Attribute fallbacks and ids are not necessary to compute offsets. */
+    for (const int i : transforms.index_range()) {
+      foreach_geometry_in_reference(references[handles[i]],
+                                    base_transform * transforms[i],
+                                    0,
+                                    [&](const GeometrySet &instance_geometry_set,
+                                        const float4x4 &transform,
+                                        const uint32_t /*id*/) {
+                                      gather_realize_tasks_recursive(gather_info,
+                                                                     instance_geometry_set,
+                                                                     transform,
+                                                                     base_instance_context);
+                                    });
+    }
+    return;
+  }
+
   Span<int> stored_instance_ids;
   if (gather_info.create_id_attribute_on_any_component) {
     std::optional<GSpan> ids = instances_component.instance_attributes().get_for_read("id");
@@ -519,6 +557,13 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   }
 }
 
+static void flush_tasks_if_batch_is_full(GatherTasksInfo &gather_info, const int64_t tasks_num)
+{
+  if (tasks_num >= max_tasks_per_batch) {
+    gather_info.flush_tasks_fn();
+  }
+}
+
 /**
  * Gather tasks for all geometries in the #geometry_set.
  */
@@ -536,11 +581,19 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
         if (mesh != nullptr && mesh->totvert > 0) {
           const int mesh_index = gather_info.meshes.order.index_of(mesh);
           const MeshRealizeInfo &mesh_info = gather_info.meshes.realize_info[mesh_index];
-          gather_info.r_tasks.mesh_tasks.append({gather_info.r_offsets.mesh_offsets,
-                                                 &mesh_info,
-                                                 base_transform,
-                                                 base_instance_context.meshes,
-                                                 base_instance_context.id});
+          if (gather_info.count_only) {
+            if (gather_info.r_first_mesh == nullptr) {
+              gather_info.r_first_mesh = &mesh_info;
+            }
+          }
+          else {
+            gather_info.r_tasks.mesh_tasks.append({gather_info.r_offsets.mesh_offsets,
+                                                   &mesh_info,
+                                                   base_transform,
+                                                   base_instance_context.meshes,
+                                                   base_instance_context.id});
+            flush_tasks_if_batch_is_full(gather_info, gather_info.r_tasks.mesh_tasks.size());
+          }
           gather_info.r_offsets.mesh_offsets.vertex += mesh->totvert;
           gather_info.r_offsets.mesh_offsets.edge += mesh->totedge;
           gather_info.r_offsets.mesh_offsets.loop += mesh->totloop;
@@ -556,11 +609,21 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
           const int pointcloud_index = gather_info.pointclouds.order.index_of(pointcloud);
           const PointCloudRealizeInfo &pointcloud_info =
               gather_info.pointclouds.realize_info[pointcloud_index];
-          gather_info.r_tasks.pointcloud_tasks.append({gather_info.r_offsets.pointcloud_offset,
-                                                       &pointcloud_info,
-                                                       base_transform,
-                                                       base_instance_context.pointclouds,
-                                                       base_instance_context.id});
+          if (gather_info.count_only) {
+            if (gather_info.r_first_pointcloud == nullptr) {
+              gather_info.r_first_pointcloud = &pointcloud_info;
+            }
+          }
+          else {
+            gather_info.r_tasks.pointcloud_tasks.append(
+                {gather_info.r_offsets.pointcloud_offset,
+                 &pointcloud_info,
+                 base_transform,
+                 base_instance_context.pointclouds,
+                 base_instance_context.id});
+            flush_tasks_if_batch_is_full(gather_info,
+                                         gather_info.r_tasks.pointcloud_tasks.size());
+          }
           gather_info.r_offsets.pointcloud_offset += pointcloud->totpoint;
         }
         break;
@@ -571,11 +634,19 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
         if (curves != nullptr && curves->geometry.curve_num > 0) {
           const int curve_index = gather_info.curves.order.index_of(curves);
           const RealizeCurveInfo &curve_info = gather_info.curves.realize_info[curve_index];
-          gather_info.r_tasks.curve_tasks.append({gather_info.r_offsets.curves_offsets,
-                                                  &curve_info,
-                                                  base_transform,
-                                                  base_instance_context.curves,
-                                                  base_instance_context.id});
+          if (gather_info.count_only) {
+            if (gather_info.r_first_curve == nullptr) {
+              gather_info.r_first_curve = &curve_info;
+            }
+          }
+          else {
+            gather_info.r_tasks.curve_tasks.append({gather_info.r_offsets.curves_offsets,
+                                                    &curve_info,
+                                                    base_transform,
+                                                    base_instance_context.curves,
+                                                    base_instance_context.id});
+            flush_tasks_if_batch_is_full(gather_info, gather_info.r_tasks.curve_tasks.size());
+          }
           gather_info.r_offsets.curves_offsets.point += curves->geometry.point_num;
           gather_info.r_offsets.curves_offsets.curve += curves->geometry.curve_num;
         }
@@ -590,7 +661,7 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
       }
       case GEO_COMPONENT_TYPE_VOLUME: {
         const VolumeComponent *volume_component = static_cast<const VolumeComponent *>(component);
-        if (!gather_info.r_tasks.first_volume) {
+        if (gather_info.count_only && !gather_info.r_tasks.first_volume) {
           volume_component->user_add();
           gather_info.r_tasks.first_volume = volume_component;
         }
@@ -599,7 +670,7 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
       case GEO_COMPONENT_TYPE_EDIT: {
         const GeometryComponentEditData *edit_component =
             static_cast<const GeometryComponentEditData *>(component);
-        if (!gather_info.r_tasks.first_edit_data) {
+        if (gather_info.count_only && !gather_info.r_tasks.first_edit_data) {
           edit_component->user_add();
           gather_info.r_tasks.first_edit_data = edit_component;
         }
@@ -725,20 +796,19 @@ static void execute_realize_pointcloud_task(
       dst_attribute_writers);
 }
 
-static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &options,
-                                             const AllPointCloudsInfo &all_pointclouds_info,
-                                             const Span<RealizePointCloudTask> tasks,
-                                             const OrderedAttributes &ordered_attributes,
-                                             GeometrySet &r_realized_geometry)
-{
-  if (tasks.is_empty()) {
-    return;
-  }
-
-  const RealizePointCloudTask &last_task = tasks.last();
-  const PointCloud &last_pointcloud = *last_task.pointcloud_info->pointcloud;
-  const int tot_points = last_task.start_index + last_pointcloud.totpoint;
+/** Output buffers of the realized point cloud that are filled by batches of tasks. */
+struct PointCloudRealizeOutput {
+  SpanAttributeWriter<float3> positions;
+  SpanAttributeWriter<int> point_ids;
+  Vector<GSpanAttributeWriter> attribute_writers;
+};
 
+static PointCloudRealizeOutput prepare_realized_pointcloud(
+    const AllPointCloudsInfo &all_pointclouds_info,
+    const int tot_points,
+    const OrderedAttributes &ordered_attributes,
+    GeometrySet &r_realized_geometry)
+{
   /* Allocate new point cloud. */
   PointCloud *dst_pointcloud = BKE_pointcloud_new_nomain(tot_points);
   PointCloudComponent &dst_component =
@@ -746,43 +816,55 @@ static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &opti
   dst_component.replace(dst_pointcloud);
   bke::MutableAttributeAccessor dst_attributes = dst_pointcloud->attributes_for_write();
 
-  SpanAttributeWriter<float3> positions = dst_attributes.lookup_or_add_for_write_only_span<float3>(
-      "position", ATTR_DOMAIN_POINT);
+  PointCloudRealizeOutput output;
+  output.positions = dst_attributes.lookup_or_add_for_write_only_span<float3>("position",
+                                                                              ATTR_DOMAIN_POINT);
 
   /* Prepare id attribute. */
-  SpanAttributeWriter<int> point_ids;
   if (all_pointclouds_info.create_id_attribute) {
-    point_ids = dst_attributes.lookup_or_add_for_write_only_span<int>("id", ATTR_DOMAIN_POINT);
+    output.point_ids = dst_attributes.lookup_or_add_for_write_only_span<int>("id",
+                                                                             ATTR_DOMAIN_POINT);
   }
 
   /* Prepare generic output attributes. */
-  Vector<GSpanAttributeWriter> dst_attribute_writers;
   for (const int attribute_index : ordered_attributes.index_range()) {
     const AttributeIDRef &attribute_id = ordered_attributes.ids[attribute_index];
     const eCustomDataType data_type = ordered_attributes.kinds[attribute_index].data_type;
-    dst_attribute_writers.append(dst_attributes.lookup_or_add_for_write_only_span(
+    output.attribute_writers.append(dst_attributes.lookup_or_add_for_write_only_span(
         attribute_id, ATTR_DOMAIN_POINT, data_type));
   }
+  return output;
+}
 
-  /* Actually execute all tasks. */
+static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &options,
+                                             const Span<RealizePointCloudTask> tasks,
+                                             const OrderedAttributes &ordered_attributes,
+                                             PointCloudRealizeOutput &output)
+{
+  if (tasks.is_empty()) {
+    return;
+  }
   threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
     for (const int task_index : task_range) {
       const RealizePointCloudTask &task = tasks[task_index];
       execute_realize_pointcloud_task(options,
                                       task,
                                       ordered_attributes,
-                                      dst_attribute_writers,
-                                      point_ids.span,
-                                      positions.span);
+                                      output.attribute_writers,
+                                      output.point_ids.span,
+                                      output.positions.span);
     }
   });
+}
 
+static void finish_realized_pointcloud(PointCloudRealizeOutput &output)
+{
   /* Tag modified attributes. */
-  for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
+  for (GSpanAttributeWriter &dst_attribute : output.attribute_writers) {
     dst_attribute.finish();
   }
-  positions.finish();
-  point_ids.finish();
+  output.positions.finish();
+  output.point_ids.finish();
 }
 
 /** \} */
@@ -1020,37 +1102,37 @@ static void execute_realize_mesh_task(const RealizeInstancesOptions &options,
       dst_attribute_writers);
 }
 
-static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
-                                       const AllMeshesInfo &all_meshes_info,
-                                       const Span<RealizeMeshTask> tasks,
-                                       const OrderedAttributes &ordered_attributes,
-                                       const VectorSet<Material *> &ordered_materials,
-                                       GeometrySet &r_realized_geometry)
-{
-  if (tasks.is_empty()) {
-    return;
-  }
-
-  const RealizeMeshTask &last_task = tasks.last();
-  const Mesh &last_mesh = *last_task.mesh_info->mesh;
-  const int tot_vertices = last_task.start_indices.vertex + last_mesh.totvert;
-  const int tot_edges = last_task.start_indices.edge + last_mesh.totedge;
-  const int tot_loops = last_task.start_indices.loop + last_mesh.totloop;
-  const int tot_poly = last_task.start_indices.poly + last_mesh.totpoly;
+/** Output buffers of the realized mesh that are filled by batches of tasks. */
+struct MeshRealizeOutput {
+  MutableSpan<MVert> verts;
+  MutableSpan<MEdge> edges;
+  MutableSpan<MPoly> polys;
+  MutableSpan<MLoop> loops;
+  SpanAttributeWriter<int> vertex_ids;
+  SpanAttributeWriter<int> material_indices;
+  Vector<GSpanAttributeWriter> attribute_writers;
+};
 
-  Mesh *dst_mesh = BKE_mesh_new_nomain(tot_vertices, tot_edges, 0, tot_loops, tot_poly);
+static MeshRealizeOutput prepare_realized_mesh(const AllMeshesInfo &all_meshes_info,
+                                               const MeshRealizeInfo &first_mesh_info,
+                                               const MeshElementStartIndices &totals,
+                                               const OrderedAttributes &ordered_attributes,
+                                               const VectorSet<Material *> &ordered_materials,
+                                               GeometrySet &r_realized_geometry)
+{
+  Mesh *dst_mesh = BKE_mesh_new_nomain(totals.vertex, totals.edge, 0, totals.loop, totals.poly);
   MeshComponent &dst_component = r_realized_geometry.get_component_for_write<MeshComponent>();
   dst_component.replace(dst_mesh);
   bke::MutableAttributeAccessor dst_attributes = dst_mesh->attributes_for_write();
-  MutableSpan<MVert> dst_verts = dst_mesh->verts_for_write();
-  MutableSpan<MEdge> dst_edges = dst_mesh->edges_for_write();
-  MutableSpan<MPoly> dst_polys = dst_mesh->polys_for_write();
-  MutableSpan<MLoop> dst_loops = dst_mesh->loops_for_write();
+
+  MeshRealizeOutput output;
+  output.verts = dst_mesh->verts_for_write();
+  output.edges = dst_mesh->edges_for_write();
+  output.polys = dst_mesh->polys_for_write();
+  output.loops = dst_mesh->loops_for_write();
 
   /* Copy settings from the first input geometry set with a mesh. */
-  const RealizeMeshTask &first_task = tasks.first();
-  const Mesh &first_mesh = *first_task.mesh_info->mesh;
-  BKE_mesh_copy_parameters_for_eval(dst_mesh, &first_mesh);
+  BKE_mesh_copy_parameters_for_eval(dst_mesh, first_mesh_info.mesh);
   /* The above line also copies vertex group names. We don't want that here because the new
    * attributes are added explicitly below. */
   BLI_freelistN(&dst_mesh->vertex_group_names);
@@ -1062,50 +1144,60 @@ static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
   }
 
   /* Prepare id attribute. */
-  SpanAttributeWriter<int> vertex_ids;
   if (all_meshes_info.create_id_attribute) {
-    vertex_ids = dst_attributes.lookup_or_add_for_write_only_span<int>("id", ATTR_DOMAIN_POINT);
+    output.vertex_ids = dst_attributes.lookup_or_add_for_write_only_span<int>("id",
+                                                                              ATTR_DOMAIN_POINT);
   }
   /* Prepare material indices. */
-  SpanAttributeWriter<int> material_indices;
   if (all_meshes_info.create_material_index_attribute) {
-    material_indices = dst_attributes.lookup_or_add_for_write_only_span<int>("material_index",
-                                                                             ATTR_DOMAIN_FACE);
+    output.material_indices = dst_attributes.lookup_or_add_for_write_only_span<int>(
+        "material_index", ATTR_DOMAIN_FACE);
   }
 
   /* Prepare generic output attributes. */
-  Vector<GSpanAttributeWriter> dst_attribute_writers;
   for (const int attribute_index : ordered_attributes.index_range()) {
     const AttributeIDRef &attribute_id = ordered_attributes.ids[attribute_index];
     const eAttrDomain domain = ordered_attributes.kinds[attribute_index].domain;
     const eCustomDataType data_type = ordered_attributes.kinds[attribute_index].data_type;
-    dst_attribute_writers.append(
+    output.attribute_writers.append(
         dst_attributes.lookup_or_add_for_write_only_span(attribute_id, domain, data_type));
   }
+  return output;
+}
 
-  /* Actually execute all tasks. */
+static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
+                                       const Span<RealizeMeshTask> tasks,
+                                       const OrderedAttributes &ordered_attributes,
+                                       MeshRealizeOutput &output)
+{
+  if (tasks.is_empty()) {
+    return;
+  }
   threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
     for (const int task_index : task_range) {
       const RealizeMeshTask &task = tasks[task_index];
       execute_realize_mesh_task(options,
                                 task,
                                 ordered_attributes,
-                                dst_attribute_writers,
-                                dst_verts,
-                                dst_edges,
-                                dst_polys,
-                                dst_loops,
-                                vertex_ids.span,
-                                material_indices.span);
+                                output.attribute_writers,
+                                output.verts,
+                                output.edges,
+                                output.polys,
+                                output.loops,
+                                output.vertex_ids.span,
+                                output.material_indices.span);
     }
   });
+}
 
+static void finish_realized_mesh(MeshRealizeOutput &output)
+{
   /* Tag modified attributes. */
-  for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
+  for (GSpanAttributeWriter &dst_attribute : output.attribute_writers) {
     dst_attribute.finish();
   }
-  vertex_ids.finish();
-  material_indices.finish();
+  output.vertex_ids.finish();
+  output.material_indices.finish();
 }
 
 /** \} */
@@ -1301,74 +1393,87 @@ static void execute_realize_curve_task(const RealizeInstancesOptions &options,
       dst_attribute_writers);
 }
 
-static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
-                                        const AllCurvesInfo &all_curves_info,
-                                        const Span<RealizeCurveTask> tasks,
-                                        const OrderedAttributes &ordered_attributes,
-                                        GeometrySet &r_realized_geometry)
-{
-  if (tasks.is_empty()) {
-    return;
-  }
-
-  const RealizeCurveTask &last_task = tasks.last();
-  const Curves &last_curves = *last_task.curve_info->curves;
-  const int points_num = last_task.start_indices.point + last_curves.geometry.point_num;
-  const int curves_num = last_task.start_indices.curve + last_curves.geometry.curve_num;
+/** Output buffers of the realized curves that are filled by batches of tasks. */
+struct CurvesRealizeOutput {
+  bke::CurvesGeometry *curves = nullptr;
+  SpanAttributeWriter<int> point_ids;
+  SpanAttributeWriter<float3> handle_left;
+  SpanAttributeWriter<float3> handle_right;
+  SpanAttributeWriter<float> radius;
+  SpanAttributeWriter<int> resolution;
+  Vector<GSpanAttributeWriter> attribute_writers;
+};
 
+static CurvesRealizeOutput prepare_realized_curves(const AllCurvesInfo &all_curves_info,
+                                                   const RealizeCurveInfo &first_curve_info,
+                                                   const CurvesElementStartIndices &totals,
+                                                   const OrderedAttributes &ordered_attributes,
+                                                   GeometrySet &r_realized_geometry)
+{
   /* Allocate new curves data-block. */
-  Curves *dst_curves_id = bke::curves_new_nomain(points_num, curves_num);
+  Curves *dst_curves_id = bke::curves_new_nomain(totals.point, totals.curve);
   bke::CurvesGeometry &dst_curves = bke::CurvesGeometry::wrap(dst_curves_id->geometry);
-  dst_curves.offsets_for_write().last() = points_num;
+  dst_curves.offsets_for_write().last() = totals.point;
   CurveComponent &dst_component = r_realized_geometry.get_component_for_write<CurveComponent>();
   dst_component.replace(dst_curves_id);
   bke::MutableAttributeAccessor dst_attributes = dst_curves.attributes_for_write();
 
   /* Copy settings from the first input geometry set with curves. */
-  const RealizeCurveTask &first_task = tasks.first();
-  const Curves &first_curves_id = *first_task.curve_info->curves;
-  bke::curves_copy_parameters(first_curves_id, *dst_curves_id);
+  bke::curves_copy_parameters(*first_curve_info.curves, *dst_curves_id);
+
+  CurvesRealizeOutput output;
+  output.curves = &dst_curves;
 
   /* Prepare id attribute. */
-  SpanAttributeWriter<int> point_ids;
   if (all_curves_info.create_id_attribute) {
-    point_ids = dst_attributes.lookup_or_add_for_write_only_span<int>("id", ATTR_DOMAIN_POINT);
+    output.point_ids = dst_attributes.lookup_or_add_for_write_only_span<int>("id",
+                                                                             ATTR_DOMAIN_POINT);
   }
 
   /* Prepare generic output attributes. */
-  Vector<GSpanAttributeWriter> dst_attribute_writers;
   for (const int attribute_index : ordered_attributes.index_range()) {
     const AttributeIDRef &attribute_id = ordered_attributes.ids[attribute_index];
     const eAttrDomain domain = ordered_attributes.kinds[attribute_index].domain;
     const eCustomDataType data_type = ordered_attributes.kinds[attribute_index].data_type;
-    dst_attribute_writers.append(
+    output.attribute_writers.append(
         dst_attributes.lookup_or_add_for_write_only_span(attribute_id, domain, data_type));
   }
 
   /* Prepare handle position attributes if necessary. */
-  SpanAttributeWriter<float3> handle_left;
-  SpanAttributeWriter<float3> handle_right;
   if (all_curves_info.create_handle_postion_attributes) {
-    handle_left = dst_attributes.lookup_or_add_for_write_only_span<float3>("handle_left",
-                                                                           ATTR_DOMAIN_POINT);
-    handle_right = dst_attributes.lookup_or_add_for_write_only_span<float3>("handle_right",
-                                                                            ATTR_DOMAIN_POINT);
+    output.handle_left = dst_attributes.lookup_or_add_for_write_only_span<float3>(
+        "handle_left", ATTR_DOMAIN_POINT);
+    output.handle_right = dst_attributes.lookup_or_add_for_write_only_span<float3>(
+        "handle_right", ATTR_DOMAIN_POINT);
   }
 
   /* Prepare radius attribute if necessary. */
-  SpanAttributeWriter<float> radius;
   if (all_curves_info.create_radius_attribute) {
-    radius = dst_attributes.lookup_or_add_for_write_only_span<float>("radius", ATTR_DOMAIN_POINT);
+    output.radius = dst_attributes.lookup_or_add_for_write_only_span<float>("radius",
+                                                                            ATTR_DOMAIN_POINT);
   }
 
   /* Prepare resolution attribute if necessary. */
-  SpanAttributeWriter<int> resolution;
   if (all_curves_info.create_resolution_attribute) {
-    resolution = dst_attributes.lookup_or_add_for_write_only_span<int>("resolution",
-                                                                       ATTR_DOMAIN_CURVE);
+    output.resolution = dst_attributes.lookup_or_add_for_write_only_span<int>("resolution",
+                                                                              ATTR_DOMAIN_CURVE);
   }
 
-  /* Actually execute all tasks. */
+  /* Type counts are accumulated while executing the tasks. */
+  dst_curves.runtime->type_counts.fill(0);
+  return output;
+}
+
+static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
+                                        const AllCurvesInfo &all_curves_info,
+                                        const Span<RealizeCurveTask> tasks,
+                                        const OrderedAttributes &ordered_attributes,
+                                        CurvesRealizeOutput &output)
+{
+  if (tasks.is_empty()) {
+    return;
+  }
+  bke::CurvesGeometry &dst_curves = *output.curves;
   threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
     for (const int task_index : task_range) {
       const RealizeCurveTask &task = tasks[task_index];
@@ -1377,33 +1482,35 @@ static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
                                  task,
                                  ordered_attributes,
                                  dst_curves,
-                                 dst_attribute_writers,
-                                 point_ids.span,
-                                 handle_left.span,
-                                 handle_right.span,
-                                 radius.span,
-                                 resolution.span);
+                                 output.attribute_writers,
+                                 output.point_ids.span,
+                                 output.handle_left.span,
+                                 output.handle_right.span,
+                                 output.radius.span,
+                                 output.resolution.span);
     }
   });
 
   /* Type counts have to be updated eagerly. */
-  dst_curves.runtime->type_counts.fill(0);
   for (const RealizeCurveTask &task : tasks) {
     for (const int i : IndexRange(CURVE_TYPES_NUM)) {
       dst_curves.runtime->type_counts[i] +=
           task.curve_info->curves->geometry.runtime->type_counts[i];
     }
   }
+}
 
+static void finish_realized_curves(CurvesRealizeOutput &output)
+{
   /* Tag modified attributes. */
-  for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
+  for (GSpanAttributeWriter &dst_attribute : output.attribute_writers) {
     dst_attribute.finish();
   }
-  point_ids.finish();
-  radius.finish();
-  resolution.finish();
-  handle_left.finish();
-  handle_right.finish();
+  output.point_ids.finish();
+  output.radius.finish();
+  output.resolution.finish();
+  output.handle_left.finish();
+  output.handle_right.finish();
 }
 
 /** \} */
@@ -1424,11 +1531,14 @@ static void remove_id_attribute_from_instances(GeometrySet &geometry_set)
 
 GeometrySet realize_instances(GeometrySet geometry_set, const RealizeInstancesOptions &options)
 {
-  /* The algorithm works in three steps:
+  /* The algorithm works in four steps:
    * 1. Preprocess each unique geometry that is instanced (e.g. each `Mesh`).
-   * 2. Gather "tasks" that need to be executed to realize the instances. Each task corresponds to
-   *    instances of the previously preprocessed geometry.
-   * 3. Execute all tasks in parallel.
+   * 2. Traverse all instances once to compute the size of the output geometries, and allocate
+   *    them.
+   * 3. Traverse the instances again to gather "tasks" that need to be executed to realize the
+   *    instances. Each task corresponds to instances of the previously preprocessed geometry.
+   * 4. Execute the tasks in parallel, in batches of a bounded size while they are gathered, so
+   *    that the task storage does not grow with the number of instances.
    */
 
   if (!geometry_set.has_instances()) {
@@ -1454,31 +1564,73 @@ GeometrySet realize_instances(GeometrySet geometry_set, const RealizeInstancesOp
                                  temporary_arrays};
   const float4x4 transform = float4x4::identity();
   InstanceContext attribute_fallbacks(gather_info);
+
+  gather_info.count_only = true;
   gather_realize_tasks_recursive(gather_info, geometry_set, transform, attribute_fallbacks);
+  const GatherOffsets totals = gather_info.r_offsets;
 
   GeometrySet new_geometry_set;
-  execute_realize_pointcloud_tasks(options,
-                                   all_pointclouds_info,
-                                   gather_info.r_tasks.pointcloud_tasks,
-                                   all_pointclouds_info.attributes,
-                                   new_geometry_set);
-  execute_realize_mesh_tasks(options,
-                             all_meshes_info,
-                             gather_info.r_tasks.mesh_tasks,
-                             all_meshes_info.attributes,
-                             all_meshes_info.materials,
-                             new_geometry_set);
-  execute_realize_curve_tasks(options,
-                              all_curves_info,
-                              gather_info.r_tasks.curve_tasks,
-                              all_curves_info.attributes,
-                              new_geometry_set);
-
-  if (gather_info.r_tasks.first_volume) {
-    new_geometry_set.add(*gather_info.r_tasks.first_volume);
+  PointCloudRealizeOutput pointcloud_output;
+  MeshRealizeOutput mesh_output;
+  CurvesRealizeOutput curves_output;
+  if (gather_info.r_first_pointcloud) {
+    pointcloud_output = prepare_realized_pointcloud(all_pointclouds_info,
+                                                    totals.pointcloud_offset,
+                                                    all_pointclouds_info.attributes,
+                                                    new_geometry_set);
+  }
+  if (gather_info.r_first_mesh) {
+    mesh_output = prepare_realized_mesh(all_meshes_info,
+                                        *gather_info.r_first_mesh,
+                                        totals.mesh_offsets,
+                                        all_meshes_info.attributes,
+                                        all_meshes_info.materials,
+                                        new_geometry_set);
+  }
+  if (gather_info.r_first_curve) {
+    curves_output = prepare_realized_curves(all_curves_info,
+                                            *gather_info.r_first_curve,
+                                            totals.curves_offsets,
+                                            all_curves_info.attributes,
+                                            new_geometry_set);
+  }
+
+  GatherTasks &tasks = gather_info.r_tasks;
+  auto execute_gathered_tasks = [&]() {
+    execute_realize_pointcloud_tasks(
+        options, tasks.pointcloud_tasks, all_pointclouds_info.attributes, pointcloud_output);
+    execute_realize_mesh_tasks(options, tasks.mesh_tasks, all_meshes_info.attributes, mesh_output);
+    execute_realize_curve_tasks(options,
+                                all_curves_info,
+                                tasks.curve_tasks,
+                                all_curves_info.attributes,
+                                curves_output);
+    tasks.pointcloud_tasks.clear();
+    tasks.mesh_tasks.clear();
+    tasks.curve_tasks.clear();
+  };
+
+  gather_info.count_only = false;
+  gather_info.flush_tasks_fn = execute_gathered_tasks;
+  gather_info.r_offsets = {};
+  gather_realize_tasks_recursive(gather_info, geometry_set, transform, attribute_fallbacks);
+  execute_gathered_tasks();
+
+  if (gather_info.r_first_pointcloud) {
+    finish_realized_pointcloud(pointcloud_output);
+  }
+  if (gather_info.r_first_mesh) {
+    finish_realized_mesh(mesh_output);
+  }
+  if (gather_info.r_first_curve) {
+    finish_realized_curves(curves_output);
+  }
+
+  if (tasks.first_volume) {
+    new_geometry_set.add(*tasks.first_volume);
   }
-  if (gather_info.r_tasks.first_edit_data) {
-    new_geometry_set.add(*gather_info.r_tasks.first_edit_data);
+  if (tasks.first_edit_data) {
+    new_geometry_set.add(*tasks.first_edit_data);
   }
 
   return new_geometry_set;
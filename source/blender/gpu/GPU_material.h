@@ -81,6 +81,8 @@ typedef enum eGPUMaterialFlag {
 
   GPU_MATFLAG_OBJECT_INFO = (1 << 10),
   GPU_MATFLAG_AOV = (1 << 11),
+  /* The displacement output is linked and can move the surface. */
+  GPU_MATFLAG_DISPLACEMENT = (1 << 12),
 
   GPU_MATFLAG_BARYCENTRIC = (1 << 20),
 
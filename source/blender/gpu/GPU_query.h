@@ -0,0 +1,42 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Query pools API. Used to measure the GPU time spent on a sequence of commands.
+ * Queries of a pool cannot be nested or interleaved and results should only be read back once
+ * the GPU is done with them (i.e: a frame later) to avoid stalling the CPU.
+ */
+
+#pragma once
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque type hiding blender::gpu::QueryPool. */
+typedef struct GPUQueryPool GPUQueryPool;
+
+/**
+ * Create a pool of time elapsed queries.
+ * \return NULL if the backend does not support timer queries.
+ */
+GPUQueryPool *GPU_querypool_timer_create(void);
+void GPU_querypool_free(GPUQueryPool *pool);
+
+void GPU_querypool_begin(GPUQueryPool *pool);
+void GPU_querypool_end(GPUQueryPool *pool);
+
+/**
+ * Get the elapsed time in nanoseconds of every query issued in this pool.
+ * \a values_len must be equal to the number of issued queries.
+ * \note This is a sync point if the GPU is not done with the queries.
+ */
+void GPU_querypool_timer_result_get(GPUQueryPool *pool, uint64_t *r_values, int values_len);
+
+#ifdef __cplusplus
+}
+#endif
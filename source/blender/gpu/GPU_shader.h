@@ -52,6 +52,12 @@ GPUShader *GPU_shader_create_ex(const char *vertcode,
                                 const char **tf_names,
                                 int tf_count,
                                 const char *shname);
+/**
+ * Get the source of shader library files (e.g. `gpu_shader_common_math.glsl`) together with all
+ * their dependencies, to be passed as `libcode` when creating a shader. Every file is included
+ * only once. The result has to be freed with #MEM_freeN.
+ */
+char *GPU_shader_library_source_get(const char **source_names, int source_names_len);
 GPUShader *GPU_shader_create_from_info(const GPUShaderCreateInfo *_info);
 GPUShader *GPU_shader_create_from_info_name(const char *info_name);
 
@@ -38,8 +38,10 @@
 #include "gpu_shader_create_info.hh"
 #include "gpu_shader_dependency_private.h"
 
+#include <condition_variable>
 #include <cstdarg>
 #include <cstring>
+#include <mutex>
 
 #include <sstream>
 #include <string>
@@ -95,6 +97,8 @@ struct GPUPass {
   uint32_t hash;
   /** Did we already tried to compile the attached GPUShader. */
   bool compiled;
+  /** The shader is being compiled by another thread, see #GPU_pass_compile. */
+  bool compiling;
 };
 
 /* -------------------------------------------------------------------- */
@@ -708,6 +712,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
     pass->create_info = codegen.create_info;
     pass->hash = codegen.hash_get();
     pass->compiled = false;
+    pass->compiling = false;
 
     codegen.create_info = nullptr;
 
@@ -763,30 +768,50 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
   return (active_samplers_len * 3 <= GPU_max_textures());
 }
 
+/**
+ * Materials that share a pass can be compiled by different threads at the same time, the pass is
+ * only compiled by the first one.
+ */
+static std::mutex pass_compile_mutex;
+static std::condition_variable pass_compile_cond;
+
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
+  {
+    std::unique_lock lock(pass_compile_mutex);
+    pass_compile_cond.wait(lock, [&]() { return !pass->compiling; });
+    if (pass->compiled) {
+      return true;
+    }
+    pass->compiling = true;
+  }
+
   bool success = true;
-  if (!pass->compiled) {
-    GPUShaderCreateInfo *info = reinterpret_cast<GPUShaderCreateInfo *>(
-        static_cast<ShaderCreateInfo *>(pass->create_info));
-
-    pass->create_info->name_ = shname;
-
-    GPUShader *shader = GPU_shader_create_from_info(info);
-
-    /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
-     * We need to make sure to count active samplers to avoid undefined behavior. */
-    if (!gpu_pass_shader_validate(pass, shader)) {
-      success = false;
-      if (shader != nullptr) {
-        fprintf(stderr, "GPUShader: error: too many samplers in shader.\n");
-        GPU_shader_free(shader);
-        shader = nullptr;
-      }
+  GPUShaderCreateInfo *info = reinterpret_cast<GPUShaderCreateInfo *>(
+      static_cast<ShaderCreateInfo *>(pass->create_info));
+
+  pass->create_info->name_ = shname;
+
+  GPUShader *shader = GPU_shader_create_from_info(info);
+
+  /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
+   * We need to make sure to count active samplers to avoid undefined behavior. */
+  if (!gpu_pass_shader_validate(pass, shader)) {
+    success = false;
+    if (shader != nullptr) {
+      fprintf(stderr, "GPUShader: error: too many samplers in shader.\n");
+      GPU_shader_free(shader);
+      shader = nullptr;
     }
-    pass->shader = shader;
+  }
+  pass->shader = shader;
+
+  {
+    std::lock_guard lock(pass_compile_mutex);
     pass->compiled = true;
+    pass->compiling = false;
   }
+  pass_compile_cond.notify_all();
   return success;
 }
 
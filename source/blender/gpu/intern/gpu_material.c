@@ -588,6 +588,7 @@ void GPU_material_output_displacement(GPUMaterial *material, GPUNodeLink *link)
 {
   if (!material->graph.outlink_displacement) {
     material->graph.outlink_displacement = link;
+    material->flag |= GPU_MATFLAG_DISPLACEMENT;
   }
 }
 
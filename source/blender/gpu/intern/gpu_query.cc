@@ -5,8 +5,57 @@
  * \ingroup gpu
  */
 
+#include "GPU_context.h"
+#include "GPU_query.h"
+
+#include "gpu_backend.hh"
 #include "gpu_query.hh"
 
 using namespace blender::gpu;
 
-/* TODO(fclem): Make the associated C-API to use inside DRW profiler. */
+/* -------------------------------------------------------------------- */
+/** \name C-API
+ * \{ */
+
+static inline GPUQueryPool *wrap(QueryPool *pool)
+{
+  return reinterpret_cast<GPUQueryPool *>(pool);
+}
+
+static inline QueryPool *unwrap(GPUQueryPool *pool)
+{
+  return reinterpret_cast<QueryPool *>(pool);
+}
+
+GPUQueryPool *GPU_querypool_timer_create()
+{
+  /* Timer queries are only implemented by the OpenGL backend. */
+  if (GPU_backend_get_type() != GPU_BACKEND_OPENGL) {
+    return nullptr;
+  }
+  QueryPool *pool = GPUBackend::get()->querypool_alloc();
+  pool->init(GPU_QUERY_TIME_ELAPSED);
+  return wrap(pool);
+}
+
+void GPU_querypool_free(GPUQueryPool *pool)
+{
+  delete unwrap(pool);
+}
+
+void GPU_querypool_begin(GPUQueryPool *pool)
+{
+  unwrap(pool)->begin_query();
+}
+
+void GPU_querypool_end(GPUQueryPool *pool)
+{
+  unwrap(pool)->end_query();
+}
+
+void GPU_querypool_timer_result_get(GPUQueryPool *pool, uint64_t *r_values, int values_len)
+{
+  unwrap(pool)->get_time_elapsed_result({r_values, values_len});
+}
+
+/** \} */
@@ -17,6 +17,9 @@
 #include "BLI_ghash.h"
 #include "BLI_map.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_string_utils.h"
+
+#include "GPU_shader.h"
 
 #include "gpu_material_library.h"
 #include "gpu_shader_create_info.hh"
@@ -872,6 +875,28 @@ void gpu_shader_dependency_exit()
   delete g_functions;
 }
 
+char *GPU_shader_library_source_get(const char **source_names, const int source_names_len)
+{
+  blender::Vector<GPUSource *> sources;
+  for (const int i : blender::IndexRange(source_names_len)) {
+    GPUSource *src = g_sources->lookup_default(source_names[i], nullptr);
+    if (src == nullptr) {
+      std::cout << "Error source not found : " << source_names[i] << std::endl;
+      continue;
+    }
+    for (GPUSource *dependency : src->dependencies) {
+      sources.append_non_duplicates(dependency);
+    }
+    sources.append_non_duplicates(src);
+  }
+
+  blender::Vector<const char *> strings;
+  for (const GPUSource *src : sources) {
+    strings.append(src->source.c_str());
+  }
+  return BLI_string_join_arrayN(strings.data(), uint(strings.size()));
+}
+
 GPUFunction *gpu_material_library_use_function(GSet *used_libraries, const char *name)
 {
   GPUFunction *function = g_functions->lookup_default(name, nullptr);
@@ -119,4 +119,11 @@ void MTLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   ctx->set_visibility_buffer(nullptr);
 }
 
+void MTLQueryPool::get_time_elapsed_result(MutableSpan<uint64_t> r_values)
+{
+  /* Timer queries are not supported yet. #GPU_querypool_timer_create never creates them. */
+  BLI_assert_unreachable();
+  r_values.fill(0);
+}
+
 }  // namespace blender::gpu
@@ -230,6 +230,7 @@ static void detect_workarounds()
     GCaps.shader_draw_parameters_support = false;
     GCaps.shader_storage_buffer_objects_support = false;
     GLContext::base_instance_support = false;
+    GLContext::buffer_storage_support = false;
     GLContext::clear_texture_support = false;
     GLContext::copy_image_support = false;
     GLContext::debug_layer_support = false;
@@ -240,6 +241,7 @@ static void detect_workarounds()
     GLContext::native_barycentric_support = false;
     GLContext::multi_bind_support = false;
     GLContext::multi_draw_indirect_support = false;
+    GLContext::program_binary_support = false;
     GLContext::shader_draw_parameters_support = false;
     GLContext::texture_cube_map_array_support = false;
     GLContext::texture_filter_anisotropic_support = false;
@@ -450,6 +452,7 @@ GLint GLContext::max_ssbo_size = 0;
 /** Extensions. */
 
 bool GLContext::base_instance_support = false;
+bool GLContext::buffer_storage_support = false;
 bool GLContext::clear_texture_support = false;
 bool GLContext::copy_image_support = false;
 bool GLContext::debug_layer_support = false;
@@ -461,6 +464,7 @@ bool GLContext::layered_rendering_support = false;
 bool GLContext::native_barycentric_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_draw_indirect_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::shader_draw_parameters_support = false;
 bool GLContext::stencil_texturing_support = false;
 bool GLContext::texture_cube_map_array_support = false;
@@ -548,6 +552,7 @@ void GLBackend::capabilities_init()
     glGetIntegerv(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &GLContext::max_ssbo_size);
   }
   GLContext::base_instance_support = epoxy_has_gl_extension("GL_ARB_base_instance");
+  GLContext::buffer_storage_support = epoxy_has_gl_extension("GL_ARB_buffer_storage");
   GLContext::clear_texture_support = epoxy_has_gl_extension("GL_ARB_clear_texture");
   GLContext::copy_image_support = epoxy_has_gl_extension("GL_ARB_copy_image");
   GLContext::debug_layer_support = epoxy_gl_version() >= 43 ||
@@ -562,6 +567,11 @@ void GLBackend::capabilities_init()
       "GL_AMD_shader_explicit_vertex_parameter");
   GLContext::multi_bind_support = epoxy_has_gl_extension("GL_ARB_multi_bind");
   GLContext::multi_draw_indirect_support = epoxy_has_gl_extension("GL_ARB_multi_draw_indirect");
+  if (epoxy_has_gl_extension("GL_ARB_get_program_binary")) {
+    GLint formats_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats_len);
+    GLContext::program_binary_support = formats_len > 0;
+  }
   GLContext::shader_draw_parameters_support = epoxy_has_gl_extension(
       "GL_ARB_shader_draw_parameters");
   GLContext::stencil_texturing_support = epoxy_gl_version() >= 43;
@@ -581,6 +591,10 @@ void GLBackend::capabilities_init()
     GLContext::debug_layer_support = false;
     GLContext::debug_layer_workaround = false;
   }
+  else {
+    /* Always compile shaders when debugging, so their compilation messages are printed. */
+    GLContext::program_binary_support = false;
+  }
 }
 
 /** \} */
@@ -143,7 +143,13 @@ class GLBackend : public GPUBackend {
   /* Render Frame Coordination */
   void render_begin(void) override{};
   void render_end(void) override{};
-  void render_step(void) override{};
+  void render_step(void) override
+  {
+    /* Off-screen renders do not have frames, give each render step its own upload budget. */
+    if (GLContext *ctx = GLContext::get()) {
+      ctx->staging_frame_end();
+    }
+  };
 
  private:
   static void platform_init();
@@ -19,6 +19,7 @@
 
 #include "gl_debug.hh"
 #include "gl_immediate.hh"
+#include "gl_staging_buffer.hh"
 #include "gl_state.hh"
 #include "gl_uniform_buffer.hh"
 
@@ -95,6 +96,7 @@ GLContext::~GLContext()
   for (GLVaoCache *cache : vao_caches_) {
     cache->clear();
   }
+  delete staging_buffer_;
   glDeleteBuffers(1, &default_attr_vbo_);
 }
 
@@ -156,7 +158,7 @@ void GLContext::begin_frame()
 
 void GLContext::end_frame()
 {
-  /* No-op. */
+  staging_frame_end();
 }
 
 /** \} */
@@ -177,6 +179,30 @@ void GLContext::finish()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Staging uploads
+ * \{ */
+
+bool GLContext::staging_upload(GLuint buf_id, size_t offset, size_t len, const void *data)
+{
+  if (!buffer_storage_support || len > GL_STAGING_FRAME_BUDGET) {
+    return false;
+  }
+  if (staging_buffer_ == nullptr) {
+    staging_buffer_ = new GLStagingBuffer();
+  }
+  return staging_buffer_->upload(buf_id, offset, len, data);
+}
+
+void GLContext::staging_frame_end()
+{
+  if (staging_buffer_ != nullptr) {
+    staging_buffer_->frame_end();
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Safe object deletion
  *
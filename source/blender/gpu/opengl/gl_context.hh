@@ -22,6 +22,7 @@ namespace blender {
 namespace gpu {
 
 class GLVaoCache;
+class GLStagingBuffer;
 
 class GLSharedOrphanLists {
  public:
@@ -48,6 +49,7 @@ class GLContext : public Context {
   /** Extensions. */
 
   static bool base_instance_support;
+  static bool buffer_storage_support;
   static bool clear_texture_support;
   static bool copy_image_support;
   static bool debug_layer_support;
@@ -59,6 +61,7 @@ class GLContext : public Context {
   static bool native_barycentric_support;
   static bool multi_bind_support;
   static bool multi_draw_indirect_support;
+  static bool program_binary_support;
   static bool shader_draw_parameters_support;
   static bool stencil_texturing_support;
   static bool texture_cube_map_array_support;
@@ -94,6 +97,8 @@ class GLContext : public Context {
   Vector<GLuint> orphaned_framebuffers_;
   /** #GLBackend owns this data. */
   GLSharedOrphanLists &shared_orphan_list_;
+  /** Ring buffer used to stream static buffer uploads. Created on first use. */
+  GLStagingBuffer *staging_buffer_ = nullptr;
 
  public:
   GLContext(void *ghost_window, GLSharedOrphanLists &shared_orphan_list);
@@ -129,6 +134,15 @@ class GLContext : public Context {
   static void buf_free(GLuint buf_id);
   static void tex_free(GLuint tex_id);
 
+  /**
+   * Upload \a data to \a buf_id through the staging ring buffer without stalling.
+   * \return False if this is not supported or if the frame budget is exhausted. The caller is
+   * then responsible for uploading the data.
+   */
+  bool staging_upload(GLuint buf_id, size_t offset, size_t len, const void *data);
+  /** Start a new upload budget. Called at the end of each frame or render step. */
+  void staging_frame_end();
+
   void vao_cache_register(GLVaoCache *cache);
   void vao_cache_unregister(GLVaoCache *cache);
 
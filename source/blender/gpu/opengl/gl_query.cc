@@ -60,4 +60,15 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+void GLQueryPool::get_time_elapsed_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert(type_ == GPU_QUERY_TIME_ELAPSED);
+  BLI_assert(r_values.size() == query_issued_);
+
+  for (int i = 0; i < query_issued_; i++) {
+    /* NOTE: This is a sync point. */
+    glGetQueryObjectui64v(query_ids_[i], GL_QUERY_RESULT, &r_values[i]);
+  }
+}
+
 }  // namespace blender::gpu
@@ -5,11 +5,24 @@
  * \ingroup gpu
  */
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_system.h"
 #include "BLI_vector.hh"
 
+#include BLI_SYSTEM_PID_H
+
 #include "GPU_capabilities.h"
 #include "GPU_platform.h"
 
@@ -951,32 +964,247 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   return shader;
 }
 
+void GLShader::add_shader_stage(GLenum gl_stage, Span<const char *> sources)
+{
+  stage_sources_.append_as();
+  StageSources &stage = stage_sources_.last();
+  stage.gl_stage = gl_stage;
+  for (const char *source : sources) {
+    stage.sources.append(source);
+  }
+}
+
+void GLShader::create_shader_stages()
+{
+  for (const StageSources &stage : stage_sources_) {
+    Vector<const char *> sources;
+    for (const std::string &source : stage.sources) {
+      sources.append(source.c_str());
+    }
+    const GLuint shader = this->create_shader_stage(stage.gl_stage, sources);
+    switch (stage.gl_stage) {
+      case GL_VERTEX_SHADER:
+        vert_shader_ = shader;
+        break;
+      case GL_GEOMETRY_SHADER:
+        geom_shader_ = shader;
+        break;
+      case GL_FRAGMENT_SHADER:
+        frag_shader_ = shader;
+        break;
+      case GL_COMPUTE_SHADER:
+        compute_shader_ = shader;
+        break;
+    }
+  }
+}
+
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  this->add_shader_stage(GL_VERTEX_SHADER, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  this->add_shader_stage(GL_GEOMETRY_SHADER, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  this->add_shader_stage(GL_FRAGMENT_SHADER, sources);
 }
 
 void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+  this->add_shader_stage(GL_COMPUTE_SHADER, sources);
+  is_compute_ = true;
 }
 
-bool GLShader::finalize(const shader::ShaderCreateInfo *info)
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ *
+ * Linked programs are stored on disk, so they don't have to be compiled again in the next
+ * session. The driver can still reject a stored binary (e.g. after a driver update that kept the
+ * same version string), in which case the program is compiled from its sources.
+ *
+ * The cache is limited in size. Loading a program updates the modification time of its file, and
+ * the least recently used files are removed when the limit is exceeded.
+ * \{ */
+
+struct GLProgramBinaryHeader {
+  GLenum format;
+  GLint length;
+};
+
+/** Maximum size of the cache directory, shared by all Blender versions and GPUs. */
+static constexpr int64_t PROGRAM_BINARY_CACHE_SIZE_MAX = 256 * 1024 * 1024;
+/** Size the cache is reduced to when it's pruned, so it isn't pruned after every save. */
+static constexpr int64_t PROGRAM_BINARY_CACHE_SIZE_PRUNED = PROGRAM_BINARY_CACHE_SIZE_MAX / 4 * 3;
+
+/** Approximate size of the cache directory, updated when programs are saved. */
+static std::atomic<int64_t> program_binary_cache_size = 0;
+
+/** Remove the least recently used files until the cache fits in its size limit. */
+static void program_binary_cache_prune(const char *dirpath)
+{
+  static std::mutex mutex;
+  std::lock_guard lock{mutex};
+
+  direntry *entries;
+  const uint entries_num = BLI_filelist_dir_contents(dirpath, &entries);
+  Vector<const direntry *> files;
+  int64_t size = 0;
+  for (const direntry &entry : Span(entries, entries_num)) {
+    if (S_ISREG(entry.s.st_mode)) {
+      files.append(&entry);
+      size += entry.s.st_size;
+    }
+  }
+  if (size > PROGRAM_BINARY_CACHE_SIZE_MAX) {
+    std::sort(files.begin(), files.end(), [](const direntry *a, const direntry *b) {
+      return a->s.st_mtime < b->s.st_mtime;
+    });
+    for (const direntry *file : files) {
+      if (size <= PROGRAM_BINARY_CACHE_SIZE_PRUNED) {
+        break;
+      }
+      /* Files can also be removed by other Blender instances at the same time. */
+      BLI_delete(file->path, false, false);
+      size -= file->s.st_size;
+    }
+  }
+  BLI_filelist_free(entries, entries_num);
+  program_binary_cache_size = size;
+}
+
+static const char *program_binary_cache_dirpath()
+{
+  /* Initialized once, programs are also linked by the deferred compilation thread. */
+  static const std::string dirpath = []() {
+    char caches_dirpath[FILE_MAX];
+    if (!BKE_appdir_folder_caches(caches_dirpath, sizeof(caches_dirpath))) {
+      return std::string();
+    }
+    char dirpath[FILE_MAX];
+    BLI_path_join(dirpath, sizeof(dirpath), caches_dirpath, "shaders", SEP_STR, nullptr);
+    if (BLI_is_dir(dirpath)) {
+      program_binary_cache_prune(dirpath);
+    }
+    return std::string(dirpath);
+  }();
+  return dirpath.empty() ? nullptr : dirpath.c_str();
+}
+
+static bool program_binary_cache_filepath_get(const std::string &key, char r_filepath[FILE_MAX])
+{
+  const char *dirpath = program_binary_cache_dirpath();
+  if (dirpath == nullptr) {
+    return false;
+  }
+  uchar digest[16];
+  char hexdigest[33];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, hexdigest);
+  BLI_join_dirfile(r_filepath, FILE_MAX, dirpath, hexdigest);
+  return true;
+}
+
+static bool program_binary_cache_load(GLuint program, const char *filepath)
 {
-  if (compilation_failed_) {
+  size_t size;
+  void *data = BLI_file_read_binary_as_mem(filepath, 0, &size);
+  if (data == nullptr) {
     return false;
   }
 
+  GLint status = GL_FALSE;
+  const GLProgramBinaryHeader *header = static_cast<const GLProgramBinaryHeader *>(data);
+  if (size >= sizeof(GLProgramBinaryHeader) &&
+      size - sizeof(GLProgramBinaryHeader) == size_t(header->length)) {
+    glProgramBinary(program, header->format, header + 1, header->length);
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+  }
+  MEM_freeN(data);
+  if (status == GL_TRUE) {
+    /* Mark the file as recently used, so it's the last one to be pruned. */
+    BLI_file_touch(filepath);
+  }
+  return status == GL_TRUE;
+}
+
+static void program_binary_cache_save(GLuint program, const char *filepath)
+{
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  Array<char> data(sizeof(GLProgramBinaryHeader) + length);
+  GLProgramBinaryHeader *header = reinterpret_cast<GLProgramBinaryHeader *>(data.data());
+  glGetProgramBinary(program, length, &header->length, &header->format, header + 1);
+  if (header->length != length) {
+    return;
+  }
+
+  /* Write to a temporary file first, so a partially written file is never loaded. The name has
+   * to be unique, the same program can be saved by other threads and Blender instances. */
+  static std::atomic<int> tmp_counter = 0;
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(
+      filepath_tmp, sizeof(filepath_tmp), "%s.%d.%d.tmp", filepath, abs(getpid()), tmp_counter++);
+  BLI_make_existing_file(filepath_tmp);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool written = fwrite(data.data(), data.size(), 1, file) == 1;
+  fclose(file);
+  if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+    return;
+  }
+
+  if ((program_binary_cache_size += int64_t(data.size())) > PROGRAM_BINARY_CACHE_SIZE_MAX) {
+    program_binary_cache_prune(program_binary_cache_dirpath());
+  }
+}
+
+std::string GLShader::program_binary_cache_key()
+{
+  /* Transform feedback varyings are part of the program, but not of its sources. */
+  if (!GLContext::program_binary_support || transform_feedback_type_ != GPU_SHADER_TFB_NONE) {
+    return std::string();
+  }
+
+  std::string key;
+  for (const GLenum pname : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    const char *str = reinterpret_cast<const char *>(glGetString(pname));
+    key += str ? str : "";
+    key += '\n';
+  }
+  for (const StageSources &stage : stage_sources_) {
+    key += std::to_string(stage.gl_stage);
+    key += '\n';
+    /* The first source slot is replaced by the patch in #create_shader_stage. */
+    key += glsl_patch_get(stage.gl_stage);
+    for (const std::string &source : stage.sources.as_span().drop_front(1)) {
+      key += source;
+    }
+  }
+  return key;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Linking
+ * \{ */
+
+bool GLShader::finalize(const shader::ShaderCreateInfo *info)
+{
   if (info && do_geometry_shader_injection(info)) {
     std::string source = workaround_geometry_shader_source_create(*info);
     Vector<const char *> sources;
@@ -985,10 +1213,33 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     geometry_shader_from_glsl(sources);
   }
 
-  glLinkProgram(shader_program_);
+  char cache_filepath[FILE_MAX];
+  const std::string cache_key = this->program_binary_cache_key();
+  const bool use_cache = !cache_key.empty() &&
+                         program_binary_cache_filepath_get(cache_key, cache_filepath);
+
+  GLint status = GL_FALSE;
+  if (use_cache) {
+    status = program_binary_cache_load(shader_program_, cache_filepath);
+  }
+
+  if (!status) {
+    this->create_shader_stages();
+    if (compilation_failed_) {
+      return false;
+    }
+
+    if (use_cache) {
+      glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(shader_program_);
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    if (status && use_cache) {
+      program_binary_cache_save(shader_program_, cache_filepath);
+    }
+  }
+  stage_sources_.clear_and_make_inline();
 
-  GLint status;
-  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
   if (!status) {
     char log[5000];
     glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
@@ -34,6 +34,17 @@ class GLShader : public Shader {
   GLuint compute_shader_ = 0;
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
+  bool is_compute_ = false;
+
+  /**
+   * Sources of the shader stages. Stages are only compiled in #finalize, when the program is not
+   * found in the program binary cache.
+   */
+  struct StageSources {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<StageSources> stage_sources_;
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
@@ -72,14 +83,23 @@ class GLShader : public Shader {
 
   bool is_compute() const
   {
-    return compute_shader_ != 0;
+    return is_compute_;
   }
 
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
+  /** Store the sources of a shader stage, to be compiled in #finalize. */
+  void add_shader_stage(GLenum gl_stage, Span<const char *> sources);
   /** Create, compile and attach the shader stage to the shader program. */
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  /** Compile and attach all stages that were added. */
+  void create_shader_stages();
+  /**
+   * Key of the program in the program binary cache, based on the sources and the driver.
+   * Empty when the program can't be cached.
+   */
+  std::string program_binary_cache_key();
 
   /**
    * \brief features available on newer implementation such as native barycentric coordinates
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#include "BLI_assert.h"
+#include "BLI_math_base.h"
+#include "BLI_utildefines.h"
+
+#include "gl_context.hh"
+
+#include "gl_staging_buffer.hh"
+
+#include <cstring>
+
+namespace blender::gpu {
+
+#define GL_STAGING_BUFFER_SIZE (GL_STAGING_FRAME_BUDGET * GL_STAGING_FRAMES_IN_FLIGHT)
+
+GLStagingBuffer::GLStagingBuffer()
+{
+  BLI_assert(GLContext::buffer_storage_support);
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  glGenBuffers(1, &buffer_id_);
+  glBindBuffer(GL_COPY_READ_BUFFER, buffer_id_);
+  glBufferStorage(GL_COPY_READ_BUFFER, GL_STAGING_BUFFER_SIZE, nullptr, flags);
+  data_ = (uchar *)glMapBufferRange(GL_COPY_READ_BUFFER, 0, GL_STAGING_BUFFER_SIZE, flags);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+GLStagingBuffer::~GLStagingBuffer()
+{
+  for (GLsync &fence : fences_) {
+    if (fence != nullptr) {
+      glDeleteSync(fence);
+    }
+  }
+  /* Deleting the buffer also removes the persistent mapping. */
+  glDeleteBuffers(1, &buffer_id_);
+}
+
+bool GLStagingBuffer::upload(GLuint dst_buffer, size_t dst_offset, size_t len, const void *data)
+{
+  if (data_ == nullptr) {
+    /* Mapping failed. */
+    return false;
+  }
+
+  if (!segment_checked_) {
+    segment_checked_ = true;
+    GLsync &fence = fences_[segment_];
+    if (fence != nullptr) {
+      /* Do not wait. If the GPU is still reading from this segment, uploads are done by the
+       * caller for the remainder of the frame. */
+      GLenum status = glClientWaitSync(fence, 0, 0);
+      segment_available_ = ELEM(status, GL_ALREADY_SIGNALED, GL_CONDITION_SATISFIED);
+      if (segment_available_) {
+        glDeleteSync(fence);
+        fence = nullptr;
+      }
+    }
+  }
+
+  /* Keep copies 16 bytes aligned. */
+  size_t offset = ceil_to_multiple_ul(segment_offset_, 16);
+  if (!segment_available_ || offset + len > GL_STAGING_FRAME_BUDGET) {
+    return false;
+  }
+
+  size_t ring_offset = size_t(segment_) * GL_STAGING_FRAME_BUDGET + offset;
+  memcpy(data_ + ring_offset, data, len);
+
+  glBindBuffer(GL_COPY_READ_BUFFER, buffer_id_);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, dst_buffer);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, ring_offset, dst_offset, len);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  segment_offset_ = offset + len;
+  return true;
+}
+
+void GLStagingBuffer::frame_end()
+{
+  if (segment_offset_ > 0) {
+    BLI_assert(fences_[segment_] == nullptr);
+    fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    segment_ = (segment_ + 1) % GL_STAGING_FRAMES_IN_FLIGHT;
+  }
+  segment_offset_ = 0;
+  segment_available_ = true;
+  segment_checked_ = false;
+}
+
+}  // namespace blender::gpu
@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Persistently mapped ring buffer used to stream buffer uploads to the device without stalling
+ * the driver. The ring is split in one segment per frame in flight. Each segment is guarded by a
+ * fence that is inserted at the end of the frame that filled it.
+ */
+
+#pragma once
+
+#include "MEM_guardedalloc.h"
+
+#include <epoxy/gl.h>
+
+namespace blender::gpu {
+
+/** Maximum amount of data that can be streamed through the staging buffer during one frame. */
+#define GL_STAGING_FRAME_BUDGET (16 * 1024 * 1024)
+/** Number of frames the GPU can lag behind before a segment cannot be reused. */
+#define GL_STAGING_FRAMES_IN_FLIGHT 3
+
+class GLStagingBuffer {
+ private:
+  /** Opengl Handle for the whole ring. */
+  GLuint buffer_id_ = 0;
+  /** Persistent mapping of the whole ring. */
+  uchar *data_ = nullptr;
+  /** Fences guarding each segment. Null if the segment is not used by the GPU anymore. */
+  GLsync fences_[GL_STAGING_FRAMES_IN_FLIGHT] = {nullptr};
+  /** Segment used by the current frame. */
+  int segment_ = 0;
+  /** Offset of the first free byte inside the current segment. */
+  size_t segment_offset_ = 0;
+  /** False if the current segment was still in use by the GPU when the frame started using it. */
+  bool segment_available_ = true;
+  /** True if the current segment was already checked against its fence during this frame. */
+  bool segment_checked_ = false;
+
+ public:
+  GLStagingBuffer();
+  ~GLStagingBuffer();
+
+  /**
+   * Copy \a len bytes of \a data to \a dst_buffer at \a dst_offset using the ring.
+   * The copy is done on the device timeline and the host memory can be freed right after.
+   * \return False if the frame budget is exhausted, in which case the caller needs to upload the
+   * data itself.
+   */
+  bool upload(GLuint dst_buffer, size_t dst_offset, size_t len, const void *data);
+
+  /** Fence the current segment and move to the next one. */
+  void frame_end();
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("GLStagingBuffer")
+};
+
+}  // namespace blender::gpu
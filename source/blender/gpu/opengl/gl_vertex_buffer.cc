@@ -96,7 +96,12 @@ void GLVertBuf::bind()
     glBufferData(GL_ARRAY_BUFFER, vbo_size_, nullptr, to_gl(usage_));
     /* Do not transfer data from host to device when buffer is device only. */
     if (usage_ != GPU_USAGE_DEVICE_ONLY) {
-      glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data);
+      /* Stream static data through the staging buffer to avoid stalling on large uploads. */
+      const bool is_staged = (usage_ == GPU_USAGE_STATIC) &&
+                             GLContext::get()->staging_upload(vbo_id_, 0, vbo_size_, data);
+      if (!is_staged) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data);
+      }
     }
     memory_usage += vbo_size_;
 
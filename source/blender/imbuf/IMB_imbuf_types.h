@@ -157,6 +157,8 @@ typedef enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Use hardware accelerated decoding for movies when available. */
+  IB_animhwaccel = 1 << 19,
 } eImBufFlags;
 
 /** \} */
@@ -116,6 +116,11 @@ struct anim {
 
   AVFrame *pFrame;
   bool pFrame_complete;
+  /** Frame that hardware decoded frames are downloaded into, unused with software decoding. */
+  AVFrame *pFrame_hw_download;
+  enum AVPixelFormat hw_pix_fmt;
+  /** Source pixel format of `img_convert_ctx`. */
+  enum AVPixelFormat img_convert_pix_fmt;
   AVFrame *pFrame_backup;
   bool pFrame_backup_complete;
 
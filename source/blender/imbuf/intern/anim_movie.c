@@ -65,6 +65,7 @@
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -487,6 +488,116 @@ static ImBuf *avi_fetchibuf(struct anim *anim, int position)
 
 #ifdef WITH_FFMPEG
 
+/**
+ * Create the context converting frames of `pix_fmt` to RGBA. The context and pixel format of
+ * `anim` are only replaced on success, the caller has to free the previous context then.
+ */
+static bool ffmpeg_sws_context_create(struct anim *anim, enum AVPixelFormat pix_fmt)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  struct SwsContext *img_convert_ctx = sws_getContext(anim->x,
+                                                      anim->y,
+                                                      pix_fmt,
+                                                      anim->x,
+                                                      anim->y,
+                                                      AV_PIX_FMT_RGBA,
+                                                      SWS_BILINEAR | SWS_PRINT_INFO |
+                                                          SWS_FULL_CHR_H_INT,
+                                                      NULL,
+                                                      NULL,
+                                                      NULL);
+
+  if (!img_convert_ctx) {
+    return false;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  anim->img_convert_ctx = img_convert_ctx;
+  anim->img_convert_pix_fmt = pix_fmt;
+  return true;
+}
+
+static enum AVPixelFormat ffmpeg_hwaccel_get_format(AVCodecContext *ctx,
+                                                    const enum AVPixelFormat *pix_fmts)
+{
+  struct anim *anim = ctx->opaque;
+
+  for (const enum AVPixelFormat *p = pix_fmts; *p != AV_PIX_FMT_NONE; p++) {
+    if (*p == anim->hw_pix_fmt) {
+      return *p;
+    }
+  }
+
+  /* The device can't decode this stream, fall back to software decoding. */
+  fprintf(stderr, "Hardware decoding not supported for this stream, using software decoding.\n");
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  return avcodec_default_get_format(ctx, pix_fmts);
+}
+
+/* Set up hardware decoding for the first available device, keep software decoding otherwise. */
+static void ffmpeg_hwaccel_init(struct anim *anim, const AVCodec *codec, AVCodecContext *codec_ctx)
+{
+  /* Devices in order of preference, the ones not available on this platform fail to create. */
+  const enum AVHWDeviceType device_types[] = {
+      AV_HWDEVICE_TYPE_CUDA,
+      AV_HWDEVICE_TYPE_VAAPI,
+      AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+      AV_HWDEVICE_TYPE_D3D11VA,
+  };
+
+  for (int i = 0; i < ARRAY_SIZE(device_types); i++) {
+    const AVCodecHWConfig *config;
+    for (int j = 0; (config = avcodec_get_hw_config(codec, j)) != NULL; j++) {
+      if (config->device_type == device_types[i] &&
+          (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX)) {
+        break;
+      }
+    }
+    if (config == NULL) {
+      continue;
+    }
+    if (av_hwdevice_ctx_create(&codec_ctx->hw_device_ctx, device_types[i], NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    anim->hw_pix_fmt = config->pix_fmt;
+    anim->pFrame_hw_download = av_frame_alloc();
+    codec_ctx->opaque = anim;
+    codec_ctx->get_format = ffmpeg_hwaccel_get_format;
+    return;
+  }
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -500,11 +611,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -568,13 +674,23 @@ static int startffmpeg(struct anim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  anim->pFrame_hw_download = NULL;
+  /* Deinterlacing works on frames in the pixel format of the stream, which downloaded hardware
+   * frames may not have. */
+  if ((anim->ib_flags & IB_animhwaccel) && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hwaccel_init(anim, pCodec, pCodecCtx);
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
+    av_frame_free(&anim->pFrame_hw_download);
     return -1;
   }
   if (pCodecCtx->pix_fmt == AV_PIX_FMT_NONE) {
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&pFormatCtx);
+    av_frame_free(&anim->pFrame_hw_download);
     return -1;
   }
 
@@ -700,6 +816,7 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_hw_download);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -713,6 +830,7 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_hw_download);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -731,18 +849,7 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
-
-  if (!anim->img_convert_ctx) {
+  if (!ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt)) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -751,37 +858,11 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_hw_download);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -880,6 +961,17 @@ static void ffmpeg_postprocess(struct anim *anim, AVFrame *input)
     }
   }
 
+  /* Downloaded hardware frames usually have a different pixel format than the stream. */
+  if (input->format != anim->img_convert_pix_fmt) {
+    struct SwsContext *prev_img_convert_ctx = anim->img_convert_ctx;
+    if (!ffmpeg_sws_context_create(anim, input->format)) {
+      /* Keep the previous context, so a later frame in its format can still be converted. */
+      fprintf(stderr, "Can't transform color space??? Skipping frame...\n");
+      return;
+    }
+    sws_freeContext(prev_img_convert_ctx);
+  }
+
   sws_scale(anim->img_convert_ctx,
             (const uint8_t *const *)input->data,
             input->linesize,
@@ -980,6 +1072,29 @@ static int ffmpeg_read_video_frame(struct anim *anim, AVPacket *packet)
   return ret;
 }
 
+/* Receive a decoded frame into `anim->pFrame`, downloading it to system memory when it was
+ * decoded by hardware. */
+static bool ffmpeg_receive_frame(struct anim *anim)
+{
+  if (avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) != 0) {
+    return false;
+  }
+  if (anim->hw_pix_fmt == AV_PIX_FMT_NONE || anim->pFrame->format != anim->hw_pix_fmt) {
+    return true;
+  }
+
+  if (av_hwframe_transfer_data(anim->pFrame_hw_download, anim->pFrame, 0) < 0 ||
+      av_frame_copy_props(anim->pFrame_hw_download, anim->pFrame) < 0) {
+    fprintf(stderr, "Could not download hardware decoded frame.\n");
+    av_frame_unref(anim->pFrame_hw_download);
+    av_frame_unref(anim->pFrame);
+    return false;
+  }
+  av_frame_unref(anim->pFrame);
+  av_frame_move_ref(anim->pFrame, anim->pFrame_hw_download);
+  return true;
+}
+
 /* decode one video frame also considering the packet read into cur_packet */
 static int ffmpeg_decode_video_frame(struct anim *anim)
 {
@@ -987,7 +1102,7 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
 
   /* Sometimes, decoder returns more than one frame per sent packet. Check if frames are available.
    * This frames must be read, otherwise decoding will fail. See T91405. */
-  anim->pFrame_complete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+  anim->pFrame_complete = ffmpeg_receive_frame(anim);
   if (anim->pFrame_complete) {
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "  DECODE FROM CODEC BUFFER\n");
     ffmpeg_decode_store_frame_pts(anim);
@@ -1014,7 +1129,7 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
            (anim->cur_packet->flags & AV_PKT_FLAG_KEY) ? " KEY" : "");
 
     avcodec_send_packet(anim->pCodecCtx, anim->cur_packet);
-    anim->pFrame_complete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+    anim->pFrame_complete = ffmpeg_receive_frame(anim);
 
     if (anim->pFrame_complete) {
       ffmpeg_decode_store_frame_pts(anim);
@@ -1027,7 +1142,7 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
   if (rval == AVERROR_EOF) {
     /* Flush any remaining frames out of the decoder. */
     avcodec_send_packet(anim->pCodecCtx, NULL);
-    anim->pFrame_complete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+    anim->pFrame_complete = ffmpeg_receive_frame(anim);
 
     if (anim->pFrame_complete) {
       ffmpeg_decode_store_frame_pts(anim);
@@ -1480,6 +1595,7 @@ static void free_anim_ffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrame_backup);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrame_hw_download);
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->cur_frame_final);
@@ -16,6 +16,7 @@
 #include "BLI_math.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #ifdef _WIN32
@@ -945,6 +946,19 @@ static void index_rebuild_ffmpeg_finish(FFmpegIndexBuilderContext *context, int
   MEM_freeN(context);
 }
 
+typedef struct ProxyOutputTaskData {
+  struct proxy_output_ctx **proxy_ctx;
+  AVFrame *frame;
+} ProxyOutputTaskData;
+
+static void index_rebuild_ffmpeg_proxy_output_task(void *__restrict userdata,
+                                                   const int i,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ProxyOutputTaskData *data = userdata;
+  add_to_proxy_output_ffmpeg(data->proxy_ctx[i], data->frame);
+}
+
 static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *context,
                                                     AVPacket *curr_packet,
                                                     AVFrame *in_frame)
@@ -955,9 +969,16 @@ static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *c
   uint64_t s_dts = context->seek_pos_dts;
   uint64_t pts = av_get_pts_from_frame(in_frame);
 
-  for (i = 0; i < context->num_proxy_sizes; i++) {
-    add_to_proxy_output_ffmpeg(context->proxy_ctx[i], in_frame);
-  }
+  /* Each proxy size has its own scaler, encoder and file, so the decoded frame is fed to all of
+   * them at once instead of waiting for every size to be encoded in turn. */
+  ProxyOutputTaskData proxy_data = {context->proxy_ctx, in_frame};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0,
+                          context->num_proxy_sizes,
+                          &proxy_data,
+                          index_rebuild_ffmpeg_proxy_output_task,
+                          &settings);
 
   if (!context->start_pts_set) {
     context->start_pts = pts;
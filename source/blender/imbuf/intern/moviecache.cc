@@ -10,6 +10,7 @@
 #include <cstdlib> /* for qsort */
 #include <memory.h>
 #include <mutex>
+#include <vector>
 
 #include "MEM_CacheLimiterC-Api.h"
 #include "MEM_guardedalloc.h"
@@ -43,6 +44,10 @@ static MEM_CacheLimiterC *limitor = nullptr;
  * so regular mutex will not work here, hence the recursive lock. */
 static std::recursive_mutex limitor_lock;
 
+/* Buffers of items destroyed by the limiter while #limitor_lock is held. Freeing them is deferred
+ * until the lock is released, so other threads don't wait for large buffers to be freed. */
+static std::vector<ImBuf *> limitor_destroyed_ibufs;
+
 struct MovieCache {
   char name[64];
 
@@ -175,7 +180,7 @@ static void moviecache_destructor(void *p)
 
     PRINT("%s: cache '%s' destroy item %p buffer %p\n", __func__, cache->name, item, item->ibuf);
 
-    IMB_freeImBuf(item->ibuf);
+    limitor_destroyed_ibufs.push_back(item->ibuf);
 
     item->ibuf = nullptr;
     item->c_handle = nullptr;
@@ -185,6 +190,21 @@ static void moviecache_destructor(void *p)
   }
 }
 
+/**
+ * Free the buffers destroyed by the limiter, must be called without holding #limitor_lock.
+ */
+static void free_destroyed_ibufs()
+{
+  std::vector<ImBuf *> ibufs;
+  limitor_lock.lock();
+  ibufs.swap(limitor_destroyed_ibufs);
+  limitor_lock.unlock();
+
+  for (ImBuf *ibuf : ibufs) {
+    IMB_freeImBuf(ibuf);
+  }
+}
+
 static size_t get_size_in_memory(ImBuf *ibuf)
 {
   /* Keep textures in the memory to avoid constant file reload on viewport update. */
@@ -356,6 +376,7 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
 
   if (need_lock) {
     limitor_lock.unlock();
+    free_destroyed_ibufs();
   }
 
   /* cache limiter can't remove unused keys which points to destroyed values */
@@ -386,6 +407,7 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
   }
 
   limitor_lock.unlock();
+  free_destroyed_ibufs();
 
   return result;
 }
@@ -413,10 +435,9 @@ ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey, bool *r_is_cached_em
 
   if (item) {
     if (item->ibuf) {
-      limitor_lock.lock();
-      MEM_CacheLimiter_touch(item->c_handle);
-      limitor_lock.unlock();
-
+      /* No need to lock the limiter to touch the item here: it always uses #get_item_priority to
+       * find the items to destroy, so touching would not change their order anyway. This keeps
+       * lookups from playback and prefetch threads from waiting on each other. */
       IMB_refImBuf(item->ibuf);
 
       return item->ibuf;
@@ -78,6 +78,7 @@
 #include "BLI_math_color.h"
 #include "BLI_mmap.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.h"
@@ -505,6 +506,9 @@ static bool imb_save_openexr_half(ImBuf *ibuf, const char *name, const int flags
     RGBAZ *to = pixels.data();
     int xstride = sizeof(RGBAZ);
     int ystride = xstride * width;
+    /* Rows are converted in parallel, the first row holds the last image row. */
+    const blender::IndexRange rows(height);
+    const int64_t rows_grain_size = std::max<int64_t>(1, 64 * 1024 / width);
 
     /* indicate used buffers */
     frameBuffer.insert("R", Slice(HALF, (char *)&to->r, xstride, ystride));
@@ -521,36 +525,36 @@ static bool imb_save_openexr_half(ImBuf *ibuf, const char *name, const int flags
                                sizeof(float) * -width));
     }
     if (ibuf->rect_float) {
-      float *from;
-
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = ibuf->rect_float + channels * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = float_to_half_safe(from[0]);
-          to->g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
-          to->b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
-          to->a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
-          to++;
-          from += channels;
-        }
-      }
+      blender::threading::parallel_for(
+          rows, rows_grain_size, [&](const blender::IndexRange range) {
+            for (const int64_t y : range) {
+              const float *from = ibuf->rect_float + size_t(channels) * (height - 1 - y) * width;
+              RGBAZ *to_row = to + y * width;
+
+              for (int j = 0; j < width; j++, from += channels) {
+                to_row[j].r = float_to_half_safe(from[0]);
+                to_row[j].g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
+                to_row[j].b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
+                to_row[j].a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
+              }
+            }
+          });
     }
     else {
-      uchar *from;
-
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = (uchar *)ibuf->rect + 4 * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = srgb_to_linearrgb(float(from[0]) / 255.0f);
-          to->g = srgb_to_linearrgb(float(from[1]) / 255.0f);
-          to->b = srgb_to_linearrgb(float(from[2]) / 255.0f);
-          to->a = channels >= 4 ? float(from[3]) / 255.0f : 1.0f;
-          to++;
-          from += 4;
-        }
-      }
+      blender::threading::parallel_for(
+          rows, rows_grain_size, [&](const blender::IndexRange range) {
+            for (const int64_t y : range) {
+              const uchar *from = (uchar *)ibuf->rect + size_t(4) * (height - 1 - y) * width;
+              RGBAZ *to_row = to + y * width;
+
+              for (int j = 0; j < width; j++, from += 4) {
+                to_row[j].r = srgb_to_linearrgb(float(from[0]) / 255.0f);
+                to_row[j].g = srgb_to_linearrgb(float(from[1]) / 255.0f);
+                to_row[j].b = srgb_to_linearrgb(float(from[2]) / 255.0f);
+                to_row[j].a = channels >= 4 ? float(from[3]) / 255.0f : 1.0f;
+              }
+            }
+          });
     }
 
     exr_printf("OpenEXR-save: Writing OpenEXR file of height %d.\n", height);
@@ -1175,11 +1179,15 @@ void IMB_exr_write_channels(void *handle)
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       /* Writing starts from last scan-line, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
+        const float *rect = echan->rect;
+        const int xstride = echan->xstride;
         half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
+        blender::threading::parallel_for(
+            blender::IndexRange(num_pixels), 64 * 1024, [&](const blender::IndexRange range) {
+              for (const int64_t i : range) {
+                cur[i] = float_to_half_safe(rect[i * xstride]);
+              }
+            });
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
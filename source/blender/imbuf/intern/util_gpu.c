@@ -104,6 +104,114 @@ static bool IMB_gpu_get_compressed_format(const ImBuf *ibuf, eGPUTextureFormat *
 }
 #endif
 
+typedef enum eIMBGPURowConversion {
+  /** Convert to float texture storage with #IMB_colormanagement_imbuf_to_float_texture. */
+  IMB_GPU_ROW_FLOAT_TEXTURE,
+  /** Convert to byte texture storage with #IMB_colormanagement_imbuf_to_byte_texture. */
+  IMB_GPU_ROW_BYTE_TEXTURE,
+  /** Byte buffer is stored as is. */
+  IMB_GPU_ROW_BYTE_DATA,
+} eIMBGPURowConversion;
+
+/* Add `value` for the span [start, start + length) to the pixels of `dst` that it overlaps,
+ * weighted by the overlap. */
+static void imb_gpu_downscale_add(
+    float *dst, const int dst_len, const double start, const double length, const float value[4])
+{
+  const double end = start + length;
+  double pos = start;
+  for (int i = (int)start; pos < end && i < dst_len; i++) {
+    const double next = min_dd(end, (double)(i + 1));
+    madd_v4_v4fl(dst + (size_t)i * 4, value, (float)(next - pos));
+    pos = next;
+  }
+}
+
+/**
+ * Convert and scale down the image in a single pass over its rows, so that the temporary memory
+ * is bound by the texture size instead of the image size. Pixels are averaged over the area they
+ * cover, similar to #IMB_scaleImBuf.
+ */
+static void *imb_gpu_get_data_downscaled(const ImBuf *ibuf,
+                                         const int size[2],
+                                         const eIMBGPURowConversion conversion,
+                                         const bool store_premultiplied)
+{
+  const bool is_float = conversion == IMB_GPU_ROW_FLOAT_TEXTURE;
+  const size_t dst_len = (size_t)size[0] * size[1];
+  float *dst = MEM_callocN(sizeof(float[4]) * dst_len, __func__);
+  float *dst_row = MEM_mallocN(sizeof(float[4]) * size[0], __func__);
+  void *src_row = MEM_mallocN((is_float ? sizeof(float[4]) : sizeof(uchar[4])) * ibuf->x,
+                              __func__);
+
+  if (dst == NULL || dst_row == NULL || src_row == NULL) {
+    MEM_SAFE_FREE(dst);
+    MEM_SAFE_FREE(dst_row);
+    MEM_SAFE_FREE(src_row);
+    return NULL;
+  }
+
+  const double scale_x = (double)size[0] / ibuf->x;
+  const double scale_y = (double)size[1] / ibuf->y;
+
+  for (int y = 0; y < ibuf->y; y++) {
+    switch (conversion) {
+      case IMB_GPU_ROW_FLOAT_TEXTURE:
+        IMB_colormanagement_imbuf_to_float_texture(
+            src_row, 0, y, ibuf->x, 1, ibuf, store_premultiplied);
+        break;
+      case IMB_GPU_ROW_BYTE_TEXTURE:
+        IMB_colormanagement_imbuf_to_byte_texture(
+            src_row, 0, y, ibuf->x, 1, ibuf, store_premultiplied);
+        break;
+      case IMB_GPU_ROW_BYTE_DATA:
+        memcpy(src_row, ibuf->rect + (size_t)y * ibuf->x, sizeof(uchar[4]) * ibuf->x);
+        break;
+    }
+
+    memset(dst_row, 0, sizeof(float[4]) * size[0]);
+    for (int x = 0; x < ibuf->x; x++) {
+      float value[4];
+      if (is_float) {
+        copy_v4_v4(value, (float *)src_row + (size_t)x * 4);
+      }
+      else {
+        const uchar *src = (uchar *)src_row + (size_t)x * 4;
+        value[0] = src[0];
+        value[1] = src[1];
+        value[2] = src[2];
+        value[3] = src[3];
+      }
+      imb_gpu_downscale_add(dst_row, size[0], x * scale_x, scale_x, value);
+    }
+
+    /* Spread the scaled row over the destination rows it overlaps. */
+    const double end = (y + 1) * scale_y;
+    double pos = y * scale_y;
+    for (int dst_y = (int)pos; pos < end && dst_y < size[1]; dst_y++) {
+      const double next = min_dd(end, (double)(dst_y + 1));
+      madd_vn_vn(dst + (size_t)dst_y * size[0] * 4, dst_row, (float)(next - pos), size[0] * 4);
+      pos = next;
+    }
+  }
+
+  MEM_freeN(dst_row);
+  MEM_freeN(src_row);
+
+  if (is_float) {
+    return dst;
+  }
+
+  uchar *dst_byte = MEM_mallocN(sizeof(uchar[4]) * dst_len, __func__);
+  if (dst_byte != NULL) {
+    for (size_t i = 0; i < dst_len * 4; i++) {
+      dst_byte[i] = (uchar)clamp_f(dst[i] + 0.5f, 0.0f, 255.0f);
+    }
+  }
+  MEM_freeN(dst);
+  return dst_byte;
+}
+
 /**
  * Apply colormanagement and scale buffer if needed.
  * `*r_freedata` is set to true if the returned buffer need to be manually freed.
@@ -118,8 +226,37 @@ static void *imb_gpu_get_data(const ImBuf *ibuf,
   const bool is_grayscale = imb_is_grayscale_texture_format_compatible(ibuf);
   void *data_rect = (is_float_rect) ? (void *)ibuf->rect_float : (void *)ibuf->rect;
   bool freedata = false;
+  /* Images over the texture size limit are converted and scaled down at once. */
+  const bool do_downscale = do_rescale && rescale_size[0] <= ibuf->x &&
+                            rescale_size[1] <= ibuf->y;
+  eIMBGPURowConversion downscale_conversion = IMB_GPU_ROW_FLOAT_TEXTURE;
+
+  if (do_downscale) {
+    if (is_float_rect) {
+      downscale_conversion = IMB_GPU_ROW_FLOAT_TEXTURE;
+    }
+    else if (IMB_colormanagement_space_is_data(ibuf->rect_colorspace)) {
+      downscale_conversion = IMB_GPU_ROW_BYTE_DATA;
+    }
+    else if ((IMB_colormanagement_space_is_srgb(ibuf->rect_colorspace) ||
+              IMB_colormanagement_space_is_scene_linear(ibuf->rect_colorspace)) &&
+             !is_grayscale) {
+      downscale_conversion = IMB_GPU_ROW_BYTE_TEXTURE;
+    }
+    else {
+      downscale_conversion = IMB_GPU_ROW_FLOAT_TEXTURE;
+      is_float_rect = true;
+    }
 
-  if (is_float_rect) {
+    data_rect = imb_gpu_get_data_downscaled(
+        ibuf, rescale_size, downscale_conversion, store_premultiplied);
+    *r_freedata = freedata = true;
+
+    if (data_rect == NULL) {
+      return NULL;
+    }
+  }
+  else if (is_float_rect) {
     /* Float image is already in scene linear colorspace or non-color data by
      * convention, no colorspace conversion needed. But we do require 4 channels
      * currently. */
@@ -189,7 +326,7 @@ static void *imb_gpu_get_data(const ImBuf *ibuf,
     }
   }
 
-  if (do_rescale) {
+  if (do_rescale && !do_downscale) {
     uint *rect = (is_float_rect) ? NULL : (uint *)data_rect;
     float *rect_float = (is_float_rect) ? (float *)data_rect : NULL;
 
@@ -211,9 +348,11 @@ static void *imb_gpu_get_data(const ImBuf *ibuf,
   /* Pack first channel data manually at the start of the buffer. */
   if (is_grayscale) {
     void *src_rect = data_rect;
+    const uint64_t pixels_num = do_rescale ? (uint64_t)rescale_size[0] * rescale_size[1] :
+                                             (uint64_t)ibuf->x * ibuf->y;
 
     if (freedata == false) {
-      data_rect = MEM_mallocN((is_float_rect ? sizeof(float) : sizeof(uchar)) * ibuf->x * ibuf->y,
+      data_rect = MEM_mallocN((is_float_rect ? sizeof(float) : sizeof(uchar)) * pixels_num,
                               __func__);
       *r_freedata = freedata = true;
     }
@@ -223,12 +362,12 @@ static void *imb_gpu_get_data(const ImBuf *ibuf,
     }
 
     if (is_float_rect) {
-      for (uint64_t i = 0; i < ibuf->x * ibuf->y; i++) {
+      for (uint64_t i = 0; i < pixels_num; i++) {
         ((float *)data_rect)[i] = ((float *)src_rect)[i * 4];
       }
     }
     else {
-      for (uint64_t i = 0; i < ibuf->x * ibuf->y; i++) {
+      for (uint64_t i = 0; i < pixels_num; i++) {
         ((uchar *)data_rect)[i] = ((uchar *)src_rect)[i * 4];
       }
     }
@@ -12,19 +12,23 @@
 #include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
+#include "DNA_layer_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_scene_types.h"
 
 #include "BKE_blender_version.h"
 #include "BKE_context.h"
 #include "BKE_global.h"
+#include "BKE_layer.h"
 #include "BKE_main.h"
 #include "BKE_scene.h"
 
 #include "BLI_fileops.h"
+#include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "WM_api.h"
 #include "WM_types.h"
@@ -51,9 +55,28 @@ struct ExportJobData {
 namespace blender::io::alembic {
 
 /* Construct the depsgraph for exporting. */
-static void build_depsgraph(Depsgraph *depsgraph, const bool visible_objects_only)
+static void build_depsgraph(Depsgraph *depsgraph, const AlembicExportParams &params)
 {
-  if (visible_objects_only) {
+  /* Selected bases are always enabled in the viewport, so a graph built from them contains all
+   * objects that would be exported from a graph of the whole view layer. */
+  if (params.selected_only &&
+      (params.visible_objects_only || params.evaluation_mode == DAG_EVAL_VIEWPORT)) {
+    /* Only the exported objects and their dependencies have to be evaluated for every frame,
+     * unrelated data of big scenes is left out of the graph. */
+    Scene *scene = DEG_get_input_scene(depsgraph);
+    ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+    Vector<ID *> ids;
+    BKE_view_layer_synced_ensure(scene, view_layer);
+    LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer)) {
+      if (base->flag & BASE_SELECTED) {
+        ids.append(&base->object->id);
+      }
+    }
+    DEG_graph_build_from_ids(depsgraph, ids.data(), int(ids.size()));
+    return;
+  }
+
+  if (params.visible_objects_only) {
     DEG_graph_build_from_view_layer(depsgraph);
   }
   else {
@@ -87,7 +110,7 @@ static void export_startjob(void *customdata,
   *progress = 0.0f;
   *do_update = true;
 
-  build_depsgraph(data->depsgraph, data->params.visible_objects_only);
+  build_depsgraph(data->depsgraph, data->params);
   SubdivModifierDisabler subdiv_disabler(data->depsgraph);
   if (!data->params.apply_subdiv) {
     subdiv_disabler.disable_modifiers();
@@ -120,8 +120,8 @@ void ABCHairWriter::write_hair_sample(const HierarchyContext &context,
   float inv_mat[4][4];
   invert_m4_m4_safe(inv_mat, context.object->obmat);
 
-  MTFace *mtface = (MTFace *)CustomData_get_layer(&mesh->fdata, CD_MTFACE);
-  MFace *mface = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MTFace *mtface = (const MTFace *)CustomData_get_layer(&mesh->fdata, CD_MTFACE);
+  const MFace *mface = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
   const MVert *mverts = BKE_mesh_verts(mesh);
   const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
 
@@ -152,8 +152,8 @@ void ABCHairWriter::write_hair_sample(const HierarchyContext &context,
 
       if (num < mesh->totface) {
         /* TODO(Sybren): check whether the NULL check here and if(mface) are actually required */
-        MFace *face = mface == nullptr ? nullptr : &mface[num];
-        MTFace *tface = mtface + num;
+        const MFace *face = mface == nullptr ? nullptr : &mface[num];
+        const MTFace *tface = mtface + num;
 
         if (mface) {
           float r_uv[2], mapfw[4], vec[3];
@@ -188,8 +188,8 @@ void ABCHairWriter::write_hair_sample(const HierarchyContext &context,
 
       /* iterate over all faces to find a corresponding underlying UV */
       for (int n = 0; n < mesh->totface; n++) {
-        MFace *face = &mface[n];
-        MTFace *tface = mtface + n;
+        const MFace *face = &mface[n];
+        const MTFace *tface = mtface + n;
         uint vtx[4];
         vtx[0] = face->v1;
         vtx[1] = face->v2;
@@ -243,8 +243,8 @@ void ABCHairWriter::write_hair_child_sample(const HierarchyContext &context,
   float inv_mat[4][4];
   invert_m4_m4_safe(inv_mat, context.object->obmat);
 
-  MFace *mface = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
-  MTFace *mtface = (MTFace *)CustomData_get_layer(&mesh->fdata, CD_MTFACE);
+  const MFace *mface = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MTFace *mtface = (const MTFace *)CustomData_get_layer(&mesh->fdata, CD_MTFACE);
   const MVert *mverts = BKE_mesh_verts(mesh);
   const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
 
@@ -270,8 +270,8 @@ void ABCHairWriter::write_hair_child_sample(const HierarchyContext &context,
         continue;
       }
 
-      MFace *face = &mface[num];
-      MTFace *tface = mtface + num;
+      const MFace *face = &mface[num];
+      const MTFace *tface = mtface + num;
 
       float r_uv[2], tmpnor[3], mapfw[4], vec[3];
 
@@ -8,8 +8,10 @@
 #include "abc_hierarchy_iterator.h"
 #include "intern/abc_axis_conversion.h"
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_attribute.hh"
@@ -380,9 +382,11 @@ bool ABCGenericMeshWriter::get_velocities(struct Mesh *mesh, std::vector<Imath::
   vels.clear();
   vels.resize(totverts);
 
-  for (int i = 0; i < totverts; i++) {
-    copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
-  }
+  threading::parallel_for(IndexRange(totverts), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
+    }
+  });
 
   return true;
 }
@@ -437,9 +441,28 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
   points.resize(mesh->totvert);
 
   const Span<MVert> verts = mesh->verts();
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
+}
+
+/**
+ * Offsets of the corners of every polygon in the exported arrays, which are written polygon
+ * after polygon, independent of the order of the loops in the mesh. The last offset is the total
+ * number of corners.
+ */
+static Array<int> get_poly_offsets(const Span<MPoly> polys)
+{
+  Array<int> offsets(polys.size() + 1);
+  int offset = 0;
+  for (const int i : polys.index_range()) {
+    offsets[i] = offset;
+    offset += polys[i].totloop;
   }
+  offsets.last() = offset;
+  return offsets;
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -451,24 +474,31 @@ static void get_topology(struct Mesh *mesh,
   const Span<MLoop> loops = mesh->loops();
   r_has_flat_shaded_poly = false;
 
+  const Array<int> offsets = get_poly_offsets(polys);
+
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(loops.size());
-  loop_counts.reserve(polys.size());
+  poly_verts.resize(offsets.last());
+  loop_counts.resize(polys.size());
 
-  /* NOTE: data needs to be written in the reverse order. */
   for (const int i : polys.index_range()) {
     const MPoly &poly = polys[i];
-    loop_counts.push_back(poly.totloop);
-
+    loop_counts[i] = poly.totloop;
     r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
+  }
 
-    const MLoop *loop = &loops[poly.loopstart + (poly.totloop - 1)];
-
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
+  /* NOTE: data needs to be written in the reverse order. */
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      const MLoop *loop = &loops[poly.loopstart + (poly.totloop - 1)];
+      int32_t *poly_vert = &poly_verts[offsets[i]];
+
+      for (int j = 0; j < poly.totloop; j++, loop--) {
+        *poly_vert++ = loop->v;
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(struct Mesh *mesh,
@@ -535,22 +565,26 @@ static void get_loop_normals(struct Mesh *mesh,
   }
 
   BKE_mesh_calc_normals_split(mesh);
-  const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
+  const float(*lnors)[3] = static_cast<const float(*)[3]>(
+      CustomData_get_layer(&mesh->ldata, CD_NORMAL));
   BLI_assert_msg(lnors != nullptr, "BKE_mesh_calc_normals_split() should have computed CD_NORMAL");
 
-  normals.resize(mesh->totloop);
-
-  /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
   const Span<MPoly> polys = mesh->polys();
+  const Array<int> offsets = get_poly_offsets(polys);
 
-  for (const int i : polys.index_range()) {
-    const MPoly *mp = &polys[i];
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  normals.resize(offsets.last());
+
+  /* NOTE: data needs to be written in the reverse order. */
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mp = &polys[i];
+      int abc_index = offsets[i];
+      for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mp->loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
@@ -10,6 +10,7 @@
 #include "abc_util.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "MEM_guardedalloc.h"
 
@@ -19,11 +20,13 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_compiler_compat.h"
 #include "BLI_edgehash.h"
 #include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_lib_id.h"
@@ -127,15 +130,17 @@ static void read_mverts_interp(MVert *mverts,
                                const P3fArraySamplePtr &ceil_positions,
                                const double weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
-
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), float(weight));
-    copy_zup_from_yup(mvert.co, tmp);
-  }
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](const IndexRange range) {
+    float tmp[3];
+    for (const int64_t i : range) {
+      MVert &mvert = mverts[i];
+      const Imath::V3f &floor_pos = (*positions)[i];
+      const Imath::V3f &ceil_pos = (*ceil_positions)[i];
+
+      interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), float(weight));
+      copy_zup_from_yup(mvert.co, tmp);
+    }
+  });
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -156,18 +161,22 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
 void read_mverts(Mesh &mesh, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
   MutableSpan<MVert> verts = mesh.verts_for_write();
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = verts[i];
-    Imath::V3f pos_in = (*positions)[i];
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      MVert &mvert = verts[i];
+      Imath::V3f pos_in = (*positions)[i];
 
-    copy_zup_from_yup(mvert.co, pos_in.getValue());
-  }
+      copy_zup_from_yup(mvert.co, pos_in.getValue());
+    }
+  });
   if (normals) {
     float(*vert_normals)[3] = BKE_mesh_vertex_normals_for_write(&mesh);
-    for (const int64_t i : IndexRange(normals->size())) {
-      Imath::V3f nor_in = (*normals)[i];
-      copy_zup_from_yup(vert_normals[i], nor_in.getValue());
-    }
+    threading::parallel_for(IndexRange(normals->size()), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        Imath::V3f nor_in = (*normals)[i];
+        copy_zup_from_yup(vert_normals[i], nor_in.getValue());
+      }
+    });
     BKE_mesh_vertex_normals_clear_dirty(&mesh);
   }
 }
@@ -188,51 +197,59 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   const bool do_uvs = (mloopuvs && uvs && uvs_indices);
   const bool do_uvs_per_loop = do_uvs && mesh_data.uv_scope == ABC_UV_SCOPE_LOOP;
   BLI_assert(!do_uvs || mesh_data.uv_scope != ABC_UV_SCOPE_NONE);
-  uint loop_index = 0;
-  uint rev_loop_index = 0;
-  uint uv_index = 0;
-  bool seen_invalid_geometry = false;
+  uint loopstart = 0;
+  std::atomic<bool> seen_invalid_geometry = false;
 
-  for (int i = 0; i < face_counts->size(); i++) {
+  const IndexRange polys_range(face_counts->size());
+  for (const int64_t i : polys_range) {
     const int face_size = (*face_counts)[i];
 
     MPoly &poly = mpolys[i];
-    poly.loopstart = loop_index;
+    poly.loopstart = loopstart;
     poly.totloop = face_size;
 
     /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be flat-shaded,
      * this is encoded in custom loop normals. See T71246. */
     poly.flag |= ME_SMOOTH;
 
-    /* NOTE: Alembic data is stored in the reverse order. */
-    rev_loop_index = loop_index + (face_size - 1);
+    loopstart += face_size;
+  }
 
-    uint last_vertex_index = 0;
-    for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
-      MLoop &loop = mloops[rev_loop_index];
-      loop.v = (*face_indices)[loop_index];
+  threading::parallel_for(polys_range, 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const MPoly &poly = mpolys[i];
+      uint loop_index = uint(poly.loopstart);
 
-      if (f > 0 && loop.v == last_vertex_index) {
-        /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
-         * by invalid geometry in the Alembic file, such as in T76514. */
-        seen_invalid_geometry = true;
-      }
-      last_vertex_index = loop.v;
+      /* NOTE: Alembic data is stored in the reverse order. */
+      uint rev_loop_index = loop_index + (poly.totloop - 1);
 
-      if (do_uvs) {
-        MLoopUV &loopuv = mloopuvs[rev_loop_index];
-        uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index : loop.v];
+      uint last_vertex_index = 0;
+      for (int f = 0; f < poly.totloop; f++, loop_index++, rev_loop_index--) {
+        MLoop &loop = mloops[rev_loop_index];
+        loop.v = (*face_indices)[loop_index];
 
-        /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
-        if (uv_index >= uvs_size) {
-          continue;
+        if (f > 0 && loop.v == last_vertex_index) {
+          /* This face is invalid, as it has consecutive loops from the same vertex. This is
+           * caused by invalid geometry in the Alembic file, such as in T76514. */
+          seen_invalid_geometry.store(true, std::memory_order_relaxed);
         }
+        last_vertex_index = loop.v;
+
+        if (do_uvs) {
+          MLoopUV &loopuv = mloopuvs[rev_loop_index];
+          const uint uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index : loop.v];
+
+          /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+          if (uv_index >= uvs_size) {
+            continue;
+          }
 
-        loopuv.uv[0] = (*uvs)[uv_index][0];
-        loopuv.uv[1] = (*uvs)[uv_index][1];
+          loopuv.uv[0] = (*uvs)[uv_index][0];
+          loopuv.uv[1] = (*uvs)[uv_index][1];
+        }
       }
     }
-  }
+  });
 
   BKE_mesh_calc_edges(config.mesh, false, false);
   if (seen_invalid_geometry) {
@@ -271,16 +288,29 @@ static void process_loop_normals(CDStreamConfig &config, const N3fArraySamplePtr
   float(*lnors)[3] = static_cast<float(*)[3]>(
       MEM_malloc_arrayN(loop_count, sizeof(float[3]), "ABC::FaceNormals"));
 
-  MPoly *mpoly = mesh->polys_for_write().data();
+  const Span<MPoly> polys = mesh->polys();
   const N3fArraySample &loop_normals = *loop_normals_ptr;
-  int abc_index = 0;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mpoly++) {
-    /* As usual, ABC orders the loops in reverse. */
-    for (int j = mpoly->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mpoly->loopstart + j;
-      copy_zup_from_yup(lnors[blender_index], loop_normals[abc_index].getValue());
+
+  /* The normals are stored polygon after polygon, which doesn't have to match the loop order of
+   * an existing mesh. */
+  Array<int> abc_offsets(polys.size());
+  int abc_offset = 0;
+  for (const int i : polys.index_range()) {
+    abc_offsets[i] = abc_offset;
+    abc_offset += polys[i].totloop;
+  }
+
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mpoly = &polys[i];
+      int abc_index = abc_offsets[i];
+      /* As usual, ABC orders the loops in reverse. */
+      for (int j = mpoly->totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mpoly->loopstart + j;
+        copy_zup_from_yup(lnors[blender_index], loop_normals[abc_index].getValue());
+      }
     }
-  }
+  });
 
   mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals(mesh, lnors);
@@ -301,9 +331,11 @@ static void process_vertex_normals(CDStreamConfig &config,
       MEM_malloc_arrayN(normals_count, sizeof(float[3]), "ABC::VertexNormals"));
 
   const N3fArraySample &vertex_normals = *vertex_normals_ptr;
-  for (int index = 0; index < normals_count; index++) {
-    copy_zup_from_yup(vnors[index], vertex_normals[index].getValue());
-  }
+  threading::parallel_for(IndexRange(normals_count), 4096, [&](const IndexRange range) {
+    for (const int64_t index : range) {
+      copy_zup_from_yup(vnors[index], vertex_normals[index].getValue());
+    }
+  });
 
   config.mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals_from_verts(config.mesh, vnors);
@@ -384,14 +416,14 @@ static void *add_customdata_cb(Mesh *mesh, const char *name, int data_type)
     return nullptr;
   }
 
-  void *cd_ptr = CustomData_get_layer_named(&mesh->ldata, cd_data_type, name);
+  int numloops = mesh->totloop;
+  void *cd_ptr = CustomData_get_layer_named_for_write(&mesh->ldata, cd_data_type, name, numloops);
   if (cd_ptr != nullptr) {
     /* layer already exists, so just return it. */
     return cd_ptr;
   }
 
   /* Create a new layer. */
-  int numloops = mesh->totloop;
   cd_ptr = CustomData_add_layer_named(
       &mesh->ldata, cd_data_type, CD_SET_DEFAULT, nullptr, numloops, name);
   return cd_ptr;
@@ -459,11 +491,13 @@ static void read_velocity(const V3fArraySamplePtr &velocities,
       &config.mesh->id, "velocity", CD_PROP_FLOAT3, ATTR_DOMAIN_POINT, nullptr);
   float(*velocity)[3] = (float(*)[3])velocity_layer->data;
 
-  for (int i = 0; i < num_velocity_vectors; i++) {
-    const Imath::V3f &vel_in = (*velocities)[i];
-    copy_zup_from_yup(velocity[i], vel_in.getValue());
-    mul_v3_fl(velocity[i], velocity_scale);
-  }
+  threading::parallel_for(IndexRange(num_velocity_vectors), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const Imath::V3f &vel_in = (*velocities)[i];
+      copy_zup_from_yup(velocity[i], vel_in.getValue());
+      mul_v3_fl(velocity[i], velocity_scale);
+    }
+  });
 }
 
 static void read_mesh_sample(const std::string &iobject_full_name,
@@ -540,7 +540,8 @@ void GeometryExporter::createTexcoordsSource(std::string geom_id, Mesh *me)
   for (int a = 0; a < num_layers; a++) {
     int layer_index = CustomData_get_layer_index_n(&me->ldata, CD_MLOOPUV, a);
     if (!this->export_settings.get_active_uv_only() || layer_index == active_uv_index) {
-      MLoopUV *mloops = (MLoopUV *)CustomData_get_layer_n(&me->ldata, CD_MLOOPUV, a);
+      const MLoopUV *mloops = (const MLoopUV *)CustomData_get_layer_n(
+          &me->ldata, CD_MLOOPUV, a);
 
       COLLADASW::FloatSourceF source(mSW);
       std::string layer_id = makeTexcoordSourceId(
@@ -558,7 +559,7 @@ void GeometryExporter::createTexcoordsSource(std::string geom_id, Mesh *me)
 
       for (const int i : polys.index_range()) {
         const MPoly *mpoly = &polys[i];
-        MLoopUV *mloop = mloops + mpoly->loopstart;
+        const MLoopUV *mloop = mloops + mpoly->loopstart;
         for (int j = 0; j < mpoly->totloop; j++) {
           source.appendValues(mloop[j].uv[0], mloop[j].uv[1]);
         }
@@ -624,7 +625,7 @@ void GeometryExporter::create_normals(std::vector<Normal> &normals,
 
   BKE_mesh_calc_normals_split(me);
   if (CustomData_has_layer(&me->ldata, CD_NORMAL)) {
-    lnors = (float(*)[3])CustomData_get_layer(&me->ldata, CD_NORMAL);
+    lnors = (const float(*)[3])CustomData_get_layer(&me->ldata, CD_NORMAL);
     use_custom_normals = true;
   }
 
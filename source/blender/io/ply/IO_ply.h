@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "BKE_context.h"
+#include "BLI_path_util.h"
+#include "IO_orientation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct PLYImportParams {
+  /** Full path to the source PLY file to import. */
+  char filepath[FILE_MAX];
+  eIOAxis forward_axis;
+  eIOAxis up_axis;
+  bool use_scene_unit;
+  float global_scale;
+  bool use_mesh_validate;
+};
+
+struct PLYExportParams {
+  /** Full path to the destination PLY file. */
+  char filepath[FILE_MAX];
+  eIOAxis forward_axis;
+  eIOAxis up_axis;
+  float global_scale;
+  bool use_scene_unit;
+  bool apply_modifiers;
+  bool export_selected_objects;
+  bool export_normals;
+  bool export_colors;
+  bool ascii_format;
+};
+
+/**
+ * C-interface for the importer.
+ */
+void PLY_import(bContext *C, const struct PLYImportParams *import_params);
+
+/**
+ * C-interface for the exporter.
+ */
+void PLY_export(bContext *C, const struct PLYExportParams *export_params);
+
+#ifdef __cplusplus
+}
+#endif
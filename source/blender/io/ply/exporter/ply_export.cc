@@ -0,0 +1,197 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <iostream>
+#include <memory>
+#include <system_error>
+
+#include "BKE_attribute.h"
+#include "BKE_attribute.hh"
+#include "BKE_context.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_float4x4.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "ply_export.hh"
+#include "ply_export_writer.hh"
+
+namespace blender::io::ply {
+
+static Vector<const Mesh *> gather_meshes(Depsgraph *depsgraph,
+                                          const PLYExportParams &export_params,
+                                          Vector<float4x4> &r_transforms,
+                                          const float4x4 &axes_transform)
+{
+  Vector<const Mesh *> meshes;
+  DEGObjectIterSettings deg_iter_settings{};
+  deg_iter_settings.depsgraph = depsgraph;
+  deg_iter_settings.flags = DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                            DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET | DEG_ITER_OBJECT_FLAG_VISIBLE |
+                            DEG_ITER_OBJECT_FLAG_DUPLI;
+  DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, object) {
+    if (object->type != OB_MESH) {
+      continue;
+    }
+    if (export_params.export_selected_objects && !(object->base_flag & BASE_SELECTED)) {
+      continue;
+    }
+    const Mesh *mesh = export_params.apply_modifiers ? BKE_object_get_evaluated_mesh(object) :
+                                                       BKE_object_get_pre_modified_mesh(object);
+    if (mesh == nullptr || mesh->totvert == 0) {
+      continue;
+    }
+    meshes.append(mesh);
+    r_transforms.append(axes_transform * float4x4(object->obmat));
+  }
+  DEG_OBJECT_ITER_END;
+  return meshes;
+}
+
+/**
+ * Merge all meshes into a single vertex and face list, with the vertex indices of every mesh
+ * offset by the vertices of the meshes before it. Each mesh is converted in parallel.
+ */
+static void meshes_to_ply_data(const Span<const Mesh *> meshes,
+                               const Span<float4x4> transforms,
+                               const PLYExportParams &export_params,
+                               PlyData &r_data)
+{
+  Array<int> vert_offsets(meshes.size() + 1);
+  Array<int> face_offsets(meshes.size() + 1);
+  Array<int> loop_offsets(meshes.size() + 1);
+  vert_offsets[0] = face_offsets[0] = loop_offsets[0] = 0;
+  for (const int i : meshes.index_range()) {
+    vert_offsets[i + 1] = vert_offsets[i] + meshes[i]->totvert;
+    face_offsets[i + 1] = face_offsets[i] + meshes[i]->totpoly;
+    loop_offsets[i + 1] = loop_offsets[i] + meshes[i]->totloop;
+  }
+
+  r_data.positions.reinitialize(vert_offsets.last());
+  if (export_params.export_normals) {
+    r_data.normals.reinitialize(vert_offsets.last());
+  }
+  if (export_params.export_colors) {
+    r_data.colors.reinitialize(vert_offsets.last());
+  }
+  r_data.face_offsets.reinitialize(face_offsets.last() + 1);
+  r_data.face_verts.reinitialize(loop_offsets.last());
+  r_data.face_offsets.last() = loop_offsets.last();
+
+  for (const int mesh_index : meshes.index_range()) {
+    const Mesh &mesh = *meshes[mesh_index];
+    const float4x4 &transform = transforms[mesh_index];
+    const int vert_offset = vert_offsets[mesh_index];
+    const int face_offset = face_offsets[mesh_index];
+    const int loop_offset = loop_offsets[mesh_index];
+    /* Mirroring transforms flip the faces, keep them facing outwards. */
+    const bool flip_winding = is_negative_m4(transform.values);
+
+    const Span<MVert> verts = mesh.verts();
+    threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        r_data.positions[vert_offset + i] = transform * float3(verts[i].co);
+      }
+    });
+
+    if (export_params.export_normals) {
+      float normal_matrix[3][3];
+      copy_m3_m4(normal_matrix, transform.values);
+      invert_m3(normal_matrix);
+      transpose_m3(normal_matrix);
+      const Span<float3> vert_normals(
+          reinterpret_cast<const float3 *>(BKE_mesh_vertex_normals_ensure(&mesh)), verts.size());
+      threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          float3 &normal = r_data.normals[vert_offset + i];
+          mul_v3_m3v3(normal, normal_matrix, vert_normals[i]);
+          normalize_v3(normal);
+        }
+      });
+    }
+
+    if (export_params.export_colors) {
+      const CustomDataLayer *color_layer = BKE_id_attributes_active_color_get(&mesh.id);
+      const bke::AttributeAccessor attributes = mesh.attributes();
+      const VArray<ColorGeometry4f> colors = attributes.lookup_or_default<ColorGeometry4f>(
+          color_layer ? color_layer->name : "",
+          ATTR_DOMAIN_POINT,
+          ColorGeometry4f(1.0f, 1.0f, 1.0f, 1.0f));
+      threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          const ColorGeometry4f color = colors[i];
+          r_data.colors[vert_offset + i] = float4(color.r, color.g, color.b, color.a);
+        }
+      });
+    }
+
+    const Span<MPoly> polys = mesh.polys();
+    const Span<MLoop> loops = mesh.loops();
+    threading::parallel_for(polys.index_range(), 2048, [&](const IndexRange range) {
+      for (const int i : range) {
+        const MPoly &poly = polys[i];
+        const int dst_start = loop_offset + poly.loopstart;
+        r_data.face_offsets[face_offset + i] = dst_start;
+        for (const int j : IndexRange(poly.totloop)) {
+          const int src_corner = flip_winding ? poly.totloop - 1 - j : j;
+          r_data.face_verts[dst_start + j] = vert_offset +
+                                             int(loops[poly.loopstart + src_corner].v);
+        }
+      }
+    });
+  }
+}
+
+void exporter_main(bContext *C, const PLYExportParams &export_params)
+{
+  std::unique_ptr<PLYWriter> writer;
+  try {
+    writer = std::make_unique<PLYWriter>(export_params.filepath, export_params.ascii_format);
+  }
+  catch (const std::system_error &ex) {
+    std::cerr << ex.code().category().name() << ": " << ex.what() << ": "
+              << ex.code().message() << std::endl;
+    return;
+  }
+
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  Scene *scene = CTX_data_scene(C);
+
+  float global_scale = export_params.global_scale;
+  if ((scene->unit.system != USER_UNIT_NONE) && export_params.use_scene_unit) {
+    global_scale *= scene->unit.scale_length;
+  }
+  /* +Y-forward and +Z-up are the Blender's default axis settings. */
+  float axes_transform3x3[3][3];
+  mat3_from_axis_conversion(
+      export_params.forward_axis, export_params.up_axis, IO_AXIS_Y, IO_AXIS_Z, axes_transform3x3);
+  float4x4 axes_transform = float4x4::identity();
+  copy_m4_m3(axes_transform.values, axes_transform3x3);
+  const float scale_vec[3] = {global_scale, global_scale, global_scale};
+  rescale_m4(axes_transform.values, scale_vec);
+
+  Vector<float4x4> transforms;
+  const Vector<const Mesh *> meshes = gather_meshes(
+      depsgraph, export_params, transforms, axes_transform);
+
+  PlyData data;
+  meshes_to_ply_data(meshes, transforms, export_params, data);
+  writer->write(data);
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,16 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "IO_ply.h"
+
+namespace blender::io::ply {
+
+/* Main export function used from within Blender. */
+void exporter_main(bContext *C, const PLYExportParams &export_params);
+
+}  // namespace blender::io::ply
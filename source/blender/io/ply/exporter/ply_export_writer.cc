@@ -0,0 +1,195 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+#include "BKE_blender_version.h"
+
+#include "BLI_endian_defines.h"
+#include "BLI_fileops.h"
+#include "BLI_math_color.h"
+#include "BLI_task.hh"
+
+#include "ply_export_writer.hh"
+
+/* SEP macro from BLI path utils clashes with SEP symbol in fmt headers. */
+#undef SEP
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
+
+namespace blender::io::ply {
+
+/* Split up large meshes into multi-threaded jobs; each job formats this amount of records. */
+static const int chunk_size = 32768;
+/* Amount of chunks that are formatted before their buffers are written to the file, to limit
+ * the memory used for the formatted output of big meshes. */
+static const int batch_chunks_num = 64;
+
+PLYWriter::PLYWriter(const char *filepath, const bool ascii) noexcept(false)
+    : filepath_(filepath), ascii_(ascii)
+{
+  file_ = BLI_fopen(filepath, "wb");
+  if (!file_) {
+    throw std::system_error(errno, std::system_category(), "Cannot open file " + filepath_);
+  }
+}
+
+PLYWriter::~PLYWriter()
+{
+  if (std::fclose(file_)) {
+    std::cerr << "Error: could not close the file '" << filepath_
+              << "' properly, it may be corrupted." << std::endl;
+  }
+}
+
+void PLYWriter::write(const PlyData &data)
+{
+  write_header(data);
+  write_vertices(data);
+  write_faces(data);
+}
+
+/** Most files use a single byte for the face sizes, which is too small for big n-gons. */
+static bool use_int_face_sizes(const PlyData &data)
+{
+  if (data.face_offsets.is_empty()) {
+    return false;
+  }
+  for (const int i : IndexRange(data.face_offsets.size() - 1)) {
+    if (data.face_offsets[i + 1] - data.face_offsets[i] > 255) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PLYWriter::write_header(const PlyData &data)
+{
+  const int faces_num = data.face_offsets.is_empty() ? 0 : int(data.face_offsets.size()) - 1;
+  /* Binary data is written in the byte order of the machine, which is declared in the header. */
+  const char *format = ascii_ ? "ascii" :
+                                (ENDIAN_ORDER == B_ENDIAN ? "binary_big_endian" :
+                                                            "binary_little_endian");
+  fmt::print(file_, "ply\nformat {} 1.0\n", format);
+  fmt::print(file_, "comment Exported from Blender-{}\n", BKE_blender_version_string());
+  fmt::print(file_, "element vertex {}\n", data.positions.size());
+  fmt::print(file_, "property float x\nproperty float y\nproperty float z\n");
+  if (!data.normals.is_empty()) {
+    fmt::print(file_, "property float nx\nproperty float ny\nproperty float nz\n");
+  }
+  if (!data.colors.is_empty()) {
+    fmt::print(file_,
+               "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+               "property uchar alpha\n");
+  }
+  fmt::print(file_, "element face {}\n", faces_num);
+  fmt::print(
+      file_, "property list {} int vertex_indices\n", use_int_face_sizes(data) ? "int" : "uchar");
+  fmt::print(file_, "end_header\n");
+}
+
+/**
+ * Format #items_num records in chunks on multiple threads and write them to the file in order.
+ * \param format_fn: Appends the record at the given index to the buffer.
+ */
+template<typename FormatFn>
+static void write_chunked(FILE *file, const int items_num, const FormatFn &format_fn)
+{
+  const int chunks_num = (items_num + chunk_size - 1) / chunk_size;
+  for (int batch_start = 0; batch_start < chunks_num; batch_start += batch_chunks_num) {
+    const IndexRange batch(batch_start, std::min(batch_chunks_num, chunks_num - batch_start));
+    /* Give each chunk its own temporary output buffer, and process them in parallel. */
+    Array<std::vector<char>> buffers(batch.size());
+    threading::parallel_for(buffers.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        const int item_start = batch[i] * chunk_size;
+        const IndexRange chunk_items(item_start, std::min(chunk_size, items_num - item_start));
+        for (const int item : chunk_items) {
+          format_fn(buffers[i], item);
+        }
+      }
+    });
+    /* Emit all temporary output buffers into the file. */
+    for (const std::vector<char> &buffer : buffers) {
+      fwrite(buffer.data(), 1, buffer.size(), file);
+    }
+  }
+}
+
+template<typename T> static void append_binary(std::vector<char> &r_buffer, const T &value)
+{
+  const char *data = reinterpret_cast<const char *>(&value);
+  r_buffer.insert(r_buffer.end(), data, data + sizeof(T));
+}
+
+void PLYWriter::write_vertices(const PlyData &data)
+{
+  const bool use_normals = !data.normals.is_empty();
+  const bool use_colors = !data.colors.is_empty();
+  write_chunked(file_, int(data.positions.size()), [&](std::vector<char> &buffer, const int i) {
+    uchar color[4];
+    if (use_colors) {
+      linearrgb_to_srgb_uchar4(color, data.colors[i]);
+    }
+    if (ascii_) {
+      auto out = std::back_inserter(buffer);
+      const float3 &co = data.positions[i];
+      fmt::format_to(out, "{} {} {}", co.x, co.y, co.z);
+      if (use_normals) {
+        const float3 &no = data.normals[i];
+        fmt::format_to(out, " {} {} {}", no.x, no.y, no.z);
+      }
+      if (use_colors) {
+        fmt::format_to(out, " {} {} {} {}", color[0], color[1], color[2], color[3]);
+      }
+      buffer.push_back('\n');
+      return;
+    }
+    append_binary(buffer, data.positions[i]);
+    if (use_normals) {
+      append_binary(buffer, data.normals[i]);
+    }
+    if (use_colors) {
+      append_binary(buffer, color);
+    }
+  });
+}
+
+void PLYWriter::write_faces(const PlyData &data)
+{
+  const int faces_num = data.face_offsets.is_empty() ? 0 : int(data.face_offsets.size()) - 1;
+  const bool int_face_sizes = use_int_face_sizes(data);
+  write_chunked(file_, faces_num, [&](std::vector<char> &buffer, const int i) {
+    const int face_start = data.face_offsets[i];
+    const Span<int> face_verts = data.face_verts.as_span().slice(
+        face_start, data.face_offsets[i + 1] - face_start);
+    if (ascii_) {
+      auto out = std::back_inserter(buffer);
+      fmt::format_to(out, "{}", face_verts.size());
+      for (const int vert : face_verts) {
+        fmt::format_to(out, " {}", vert);
+      }
+      buffer.push_back('\n');
+      return;
+    }
+    if (int_face_sizes) {
+      append_binary(buffer, int32_t(face_verts.size()));
+    }
+    else {
+      append_binary(buffer, uint8_t(face_verts.size()));
+    }
+    for (const int vert : face_verts) {
+      append_binary(buffer, int32_t(vert));
+    }
+  });
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,42 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "ply_data.hh"
+
+namespace blender::io::ply {
+
+/**
+ * Writes #PlyData as a binary little-endian or ASCII file. Vertex and face records are formatted
+ * into per-chunk buffers in parallel, then written to the file in order.
+ */
+class PLYWriter {
+ private:
+  FILE *file_ = nullptr;
+  std::string filepath_;
+  bool ascii_;
+
+ public:
+  /**
+   * Open the file for writing.
+   * \throw std::system_error when the file cannot be opened.
+   */
+  PLYWriter(const char *filepath, bool ascii) noexcept(false);
+  ~PLYWriter();
+
+  void write(const PlyData &data);
+
+ private:
+  void write_header(const PlyData &data);
+  void write_vertices(const PlyData &data);
+  void write_faces(const PlyData &data);
+};
+
+}  // namespace blender::io::ply
@@ -0,0 +1,149 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <cstdio>
+#include <fcntl.h>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include "BKE_context.h"
+#include "BKE_layer.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_fileops.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_memory_utils.hh"
+#include "BLI_mmap.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "ply_import.hh"
+#include "ply_import_mesh.hh"
+#include "ply_import_reader.hh"
+
+namespace blender::io::ply {
+
+/**
+ * Read the whole file into #r_data. The file content is memory-mapped, so binary element data
+ * is decoded in parallel straight from the page cache without an intermediate copy.
+ */
+static bool read_ply_file(const char *filepath, PlyData &r_data)
+{
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    fprintf(stderr, "Failed to open PLY file:'%s'.\n", filepath);
+    return false;
+  }
+  const size_t file_size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = file_size > 0 ? BLI_mmap_open(file) : nullptr;
+  close(file);
+  if (mmap_file == nullptr) {
+    fprintf(stderr, "PLY Importer: failed to map file '%s'.\n", filepath);
+    return false;
+  }
+  BLI_SCOPED_DEFER([&]() { BLI_mmap_free(mmap_file); });
+
+  const Span<char> file_content(static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)),
+                                int64_t(file_size));
+  PlyHeader header;
+  if (!read_ply_header(StringRef(file_content.data(), file_content.size()), header)) {
+    return false;
+  }
+  return read_ply_data(file_content, header, r_data);
+}
+
+void importer_main(bContext *C, const PLYImportParams &import_params)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+  importer_main(bmain, scene, view_layer, import_params);
+}
+
+void importer_main(Main *bmain,
+                   Scene *scene,
+                   ViewLayer *view_layer,
+                   const PLYImportParams &import_params)
+{
+  PlyData data;
+  if (!read_ply_file(import_params.filepath, data)) {
+    fprintf(stderr, "PLY Importer: Failed to import '%s'\n", import_params.filepath);
+    return;
+  }
+
+  /* Name used for both the object and its data. */
+  char ob_name[FILE_MAX];
+  BLI_strncpy(ob_name, BLI_path_basename(import_params.filepath), FILE_MAX);
+  BLI_path_extension_replace(ob_name, FILE_MAX, "");
+
+  Object *obj = nullptr;
+  if (data.face_offsets.size() > 1) {
+    Mesh *mesh = ply_data_to_mesh(data, bmain, ob_name);
+    if (import_params.use_mesh_validate) {
+      bool verbose_validate = false;
+#ifdef DEBUG
+      verbose_validate = true;
+#endif
+      BKE_mesh_validate(mesh, verbose_validate, false);
+    }
+    obj = BKE_object_add_only_object(bmain, OB_MESH, ob_name);
+    BKE_mesh_assign_object(bmain, obj, mesh);
+  }
+  else {
+    /* Files without faces are typically scans, which are better represented as point clouds
+     * than as meshes with loose vertices. */
+    PointCloud *pointcloud = ply_data_to_pointcloud(data, bmain, ob_name);
+    obj = BKE_object_add_only_object(bmain, OB_POINTCLOUD, ob_name);
+    obj->data = pointcloud;
+    id_us_plus(static_cast<ID *>(obj->data));
+  }
+
+  BKE_view_layer_base_deselect_all(scene, view_layer);
+  LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+  BKE_collection_object_add(bmain, lc->collection, obj);
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  Base *base = BKE_view_layer_base_find(view_layer, obj);
+  BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+  float global_scale = import_params.global_scale;
+  if ((scene->unit.system != USER_UNIT_NONE) && import_params.use_scene_unit) {
+    global_scale *= scene->unit.scale_length;
+  }
+  float scale_vec[3] = {global_scale, global_scale, global_scale};
+  float obmat3x3[3][3];
+  unit_m3(obmat3x3);
+  float obmat4x4[4][4];
+  unit_m4(obmat4x4);
+  /* +Y-forward and +Z-up are the Blender's default axis settings. */
+  mat3_from_axis_conversion(
+      IO_AXIS_Y, IO_AXIS_Z, import_params.forward_axis, import_params.up_axis, obmat3x3);
+  copy_m4_m3(obmat4x4, obmat3x3);
+  rescale_m4(obmat4x4, scale_vec);
+  BKE_object_apply_mat4(obj, obmat4x4, true, false);
+
+  DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+  int flags = ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION |
+              ID_RECALC_BASE_FLAGS;
+  DEG_id_tag_update_ex(bmain, &obj->id, flags);
+  DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+  DEG_relations_tag_update(bmain);
+}
+
+}  // namespace blender::io::ply
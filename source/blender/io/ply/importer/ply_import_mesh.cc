@@ -0,0 +1,145 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <iostream>
+
+#include "BKE_attribute.h"
+#include "BKE_attribute.hh"
+#include "BKE_customdata.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_pointcloud.h"
+
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "ply_import_mesh.hh"
+
+namespace blender::io::ply {
+
+static void add_color_attribute(ID *id, const Span<float4> colors)
+{
+  if (colors.is_empty()) {
+    return;
+  }
+  CustomDataLayer *color_layer = BKE_id_attribute_new(
+      id, "Color", CD_PROP_COLOR, ATTR_DOMAIN_POINT, nullptr);
+  MutableSpan<float4> dst(static_cast<float4 *>(color_layer->data), colors.size());
+  dst.copy_from(colors);
+}
+
+Mesh *ply_data_to_mesh(const PlyData &data, Main *bmain, const char *name)
+{
+  const int verts_num = int(data.positions.size());
+  const int faces_num = data.face_offsets.is_empty() ? 0 : int(data.face_offsets.size()) - 1;
+
+  Array<bool> faces_valid(faces_num);
+  threading::parallel_for(IndexRange(faces_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const Span<int> face_verts = data.face_verts.as_span().slice(
+          data.face_offsets[i], data.face_offsets[i + 1] - data.face_offsets[i]);
+      bool valid = face_verts.size() >= 3;
+      for (const int vert : face_verts) {
+        valid &= vert >= 0 && vert < verts_num;
+      }
+      faces_valid[i] = valid;
+    }
+  });
+  Vector<int> valid_faces;
+  valid_faces.reserve(faces_num);
+  Array<int> poly_offsets(faces_num + 1);
+  int loops_num = 0;
+  for (const int i : IndexRange(faces_num)) {
+    if (faces_valid[i]) {
+      poly_offsets[valid_faces.size()] = loops_num;
+      valid_faces.append(i);
+      loops_num += data.face_offsets[i + 1] - data.face_offsets[i];
+    }
+  }
+  if (valid_faces.size() < faces_num) {
+    std::cout << "PLY Importer: " << faces_num - valid_faces.size()
+              << " faces with invalid vertex indices were removed" << std::endl;
+  }
+
+  Mesh *mesh = BKE_mesh_add(bmain, name);
+  /* User count is already 1 here, but will be set later in #BKE_mesh_assign_object. */
+  id_us_min(&mesh->id);
+
+  mesh->totvert = verts_num;
+  CustomData_add_layer(&mesh->vdata, CD_MVERT, CD_SET_DEFAULT, nullptr, mesh->totvert);
+  MutableSpan<MVert> verts = mesh->verts_for_write();
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_v3_v3(verts[i].co, data.positions[i]);
+    }
+  });
+
+  mesh->totpoly = int(valid_faces.size());
+  mesh->totloop = loops_num;
+  CustomData_add_layer(&mesh->pdata, CD_MPOLY, CD_SET_DEFAULT, nullptr, mesh->totpoly);
+  CustomData_add_layer(&mesh->ldata, CD_MLOOP, CD_SET_DEFAULT, nullptr, mesh->totloop);
+  MutableSpan<MPoly> polys = mesh->polys_for_write();
+  MutableSpan<MLoop> loops = mesh->loops_for_write();
+  threading::parallel_for(polys.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int face = valid_faces[i];
+      const int face_start = data.face_offsets[face];
+      MPoly &poly = polys[i];
+      poly.loopstart = poly_offsets[i];
+      poly.totloop = data.face_offsets[face + 1] - face_start;
+      for (const int j : IndexRange(poly.totloop)) {
+        loops[poly.loopstart + j].v = data.face_verts[face_start + j];
+      }
+    }
+  });
+
+  add_color_attribute(&mesh->id, data.colors);
+
+  /* NOTE: edges must be calculated first before setting custom normals. */
+  BKE_mesh_calc_edges(mesh, false, false);
+
+  if (!data.normals.is_empty() && mesh->totpoly > 0) {
+    BKE_mesh_set_custom_normals_from_verts(
+        mesh, reinterpret_cast<float(*)[3]>(const_cast<float3 *>(data.normals.data())));
+    mesh->flag |= ME_AUTOSMOOTH;
+  }
+
+  return mesh;
+}
+
+PointCloud *ply_data_to_pointcloud(const PlyData &data, Main *bmain, const char *name)
+{
+  PointCloud *pointcloud = static_cast<PointCloud *>(BKE_pointcloud_add(bmain, name));
+  /* User count is already 1 here, but will be set later when assigning it to the object. */
+  id_us_min(&pointcloud->id);
+
+  const int points_num = int(data.positions.size());
+  CustomData_realloc(&pointcloud->pdata, pointcloud->totpoint, points_num);
+  pointcloud->totpoint = points_num;
+
+  bke::MutableAttributeAccessor attributes = pointcloud->attributes_for_write();
+  bke::SpanAttributeWriter<float3> positions = attributes.lookup_or_add_for_write_span<float3>(
+      POINTCLOUD_ATTR_POSITION, ATTR_DOMAIN_POINT);
+  positions.span.copy_from(data.positions);
+  positions.finish();
+
+  if (!data.normals.is_empty()) {
+    bke::SpanAttributeWriter<float3> normals = attributes.lookup_or_add_for_write_span<float3>(
+        "normal", ATTR_DOMAIN_POINT);
+    normals.span.copy_from(data.normals);
+    normals.finish();
+  }
+
+  add_color_attribute(&pointcloud->id, data.colors);
+
+  return pointcloud;
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "ply_data.hh"
+
+struct Main;
+struct Mesh;
+struct PointCloud;
+
+namespace blender::io::ply {
+
+/**
+ * Create a mesh from the vertices and faces of a file. Faces with fewer than three corners or
+ * with vertex indices out of range are removed.
+ */
+Mesh *ply_data_to_mesh(const PlyData &data, Main *bmain, const char *name);
+
+/** Create a point cloud from the vertices of a file without faces. */
+PointCloud *ply_data_to_pointcloud(const PlyData &data, Main *bmain, const char *name);
+
+}  // namespace blender::io::ply
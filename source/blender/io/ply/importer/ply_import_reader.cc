@@ -0,0 +1,702 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+#include "BLI_endian_defines.h"
+#include "BLI_math_color.h"
+#include "BLI_task.hh"
+
+/* NOTE: we could use C++17 <charconv> from_chars to parse floats, but not all standard libraries
+ * support it yet, see the STL importer. */
+#include "fast_float.h"
+
+#include "ply_import_reader.hh"
+
+namespace blender::io::ply {
+
+static bool report_error(const char *message)
+{
+  fprintf(stderr, "PLY Importer: %s\n", message);
+  return false;
+}
+
+int ply_data_type_size(const PlyDataType type)
+{
+  switch (type) {
+    case PlyDataType::Char:
+    case PlyDataType::UChar:
+      return 1;
+    case PlyDataType::Short:
+    case PlyDataType::UShort:
+      return 2;
+    case PlyDataType::Int:
+    case PlyDataType::UInt:
+    case PlyDataType::Float:
+      return 4;
+    case PlyDataType::Double:
+      return 8;
+    case PlyDataType::None:
+      break;
+  }
+  return 0;
+}
+
+static PlyDataType data_type_from_name(const StringRef name)
+{
+  if (ELEM(name, "char", "int8")) {
+    return PlyDataType::Char;
+  }
+  if (ELEM(name, "uchar", "uint8")) {
+    return PlyDataType::UChar;
+  }
+  if (ELEM(name, "short", "int16")) {
+    return PlyDataType::Short;
+  }
+  if (ELEM(name, "ushort", "uint16")) {
+    return PlyDataType::UShort;
+  }
+  if (ELEM(name, "int", "int32")) {
+    return PlyDataType::Int;
+  }
+  if (ELEM(name, "uint", "uint32")) {
+    return PlyDataType::UInt;
+  }
+  if (ELEM(name, "float", "float32")) {
+    return PlyDataType::Float;
+  }
+  if (ELEM(name, "double", "float64")) {
+    return PlyDataType::Double;
+  }
+  return PlyDataType::None;
+}
+
+/** Factor that maps the range of integer color types to [0, 1]. */
+static float color_scale(const PlyDataType type)
+{
+  switch (type) {
+    case PlyDataType::Char:
+      return 1.0f / 127.0f;
+    case PlyDataType::UChar:
+      return 1.0f / 255.0f;
+    case PlyDataType::Short:
+      return 1.0f / 32767.0f;
+    case PlyDataType::UShort:
+      return 1.0f / 65535.0f;
+    case PlyDataType::Int:
+      return 1.0f / 2147483647.0f;
+    case PlyDataType::UInt:
+      return 1.0f / 4294967295.0f;
+    default:
+      return 1.0f;
+  }
+}
+
+static Vector<StringRef> split_words(const StringRef line)
+{
+  Vector<StringRef> words;
+  int64_t pos = 0;
+  while (true) {
+    const int64_t start = line.find_first_not_of(" \t\r", pos);
+    if (start == StringRef::not_found) {
+      break;
+    }
+    int64_t end = line.find_first_of(" \t\r", start);
+    if (end == StringRef::not_found) {
+      end = line.size();
+    }
+    words.append(line.substr(start, end - start));
+    pos = end;
+  }
+  return words;
+}
+
+bool read_ply_header(const StringRef file_content, PlyHeader &r_header)
+{
+  int64_t pos = 0;
+  bool is_first_line = true;
+  while (pos < file_content.size()) {
+    const int64_t line_end = file_content.find('\n', pos);
+    if (line_end == StringRef::not_found) {
+      break;
+    }
+    const Vector<StringRef> words = split_words(file_content.substr(pos, line_end - pos));
+    pos = line_end + 1;
+
+    if (is_first_line) {
+      if (words.size() != 1 || words[0] != "ply") {
+        return report_error("Not a PLY file");
+      }
+      is_first_line = false;
+      continue;
+    }
+    if (words.is_empty()) {
+      continue;
+    }
+    const StringRef keyword = words[0];
+    if (keyword == "format") {
+      if (words.size() < 2) {
+        return report_error("Invalid format line");
+      }
+      if (words[1] == "ascii") {
+        r_header.format = PlyFormat::Ascii;
+      }
+      else if (words[1] == "binary_little_endian") {
+        r_header.format = PlyFormat::BinaryLittleEndian;
+      }
+      else if (words[1] == "binary_big_endian") {
+        r_header.format = PlyFormat::BinaryBigEndian;
+      }
+      else {
+        return report_error("Unknown format");
+      }
+    }
+    else if (keyword == "element") {
+      if (words.size() != 3) {
+        return report_error("Invalid element line");
+      }
+      PlyElement element;
+      element.name = words[1];
+      const std::from_chars_result res = std::from_chars(
+          words[2].begin(), words[2].end(), element.count);
+      if (res.ec != std::errc() || element.count < 0) {
+        return report_error("Invalid element count");
+      }
+      r_header.elements.append(std::move(element));
+    }
+    else if (keyword == "property") {
+      if (r_header.elements.is_empty()) {
+        return report_error("Property without element");
+      }
+      PlyProperty property;
+      if (words.size() == 5 && words[1] == "list") {
+        property.count_type = data_type_from_name(words[2]);
+        property.type = data_type_from_name(words[3]);
+        property.name = words[4];
+        if (property.count_type == PlyDataType::None) {
+          return report_error("Unknown list count type");
+        }
+      }
+      else if (words.size() == 3) {
+        property.type = data_type_from_name(words[1]);
+        property.name = words[2];
+      }
+      else {
+        return report_error("Invalid property line");
+      }
+      if (property.type == PlyDataType::None) {
+        return report_error("Unknown property type");
+      }
+      r_header.elements.last().properties.append(std::move(property));
+    }
+    else if (keyword == "end_header") {
+      r_header.data_offset = size_t(pos);
+      return true;
+    }
+    /* Comments, object info and unknown lines are ignored. */
+  }
+  return report_error("Header is not terminated by end_header");
+}
+
+/** Indices of the vertex element properties that have corresponding Blender data. */
+struct VertexProperties {
+  int position[3] = {-1, -1, -1};
+  int normal[3] = {-1, -1, -1};
+  int color[4] = {-1, -1, -1, -1};
+
+  bool has_normals() const
+  {
+    return normal[0] != -1 && normal[1] != -1 && normal[2] != -1;
+  }
+  bool has_colors() const
+  {
+    return color[0] != -1 && color[1] != -1 && color[2] != -1;
+  }
+};
+
+static int find_property(const PlyElement &element, const StringRef name)
+{
+  for (const int i : element.properties.index_range()) {
+    const PlyProperty &property = element.properties[i];
+    if (property.name == name && property.count_type == PlyDataType::None) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static bool find_vertex_properties(const PlyElement &element, VertexProperties &r_properties)
+{
+  const char *position_names[3] = {"x", "y", "z"};
+  const char *normal_names[3] = {"nx", "ny", "nz"};
+  const char *color_names[4] = {"red", "green", "blue", "alpha"};
+  for (const int i : IndexRange(3)) {
+    r_properties.position[i] = find_property(element, position_names[i]);
+    r_properties.normal[i] = find_property(element, normal_names[i]);
+  }
+  for (const int i : IndexRange(4)) {
+    r_properties.color[i] = find_property(element, color_names[i]);
+  }
+  if (r_properties.position[0] == -1 || r_properties.position[1] == -1 ||
+      r_properties.position[2] == -1) {
+    return report_error("Vertex element has no x, y and z properties");
+  }
+  return true;
+}
+
+static int find_face_indices_property(const PlyElement &element)
+{
+  for (const int i : element.properties.index_range()) {
+    const PlyProperty &property = element.properties[i];
+    if (ELEM(property.name, "vertex_indices", "vertex_index") &&
+        property.count_type != PlyDataType::None) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static void allocate_vertex_data(const PlyElement &element,
+                                 const VertexProperties &properties,
+                                 PlyData &r_data)
+{
+  r_data.positions.reinitialize(element.count);
+  if (properties.has_normals()) {
+    r_data.normals.reinitialize(element.count);
+  }
+  if (properties.has_colors()) {
+    r_data.colors.reinitialize(element.count);
+  }
+}
+
+static void vertex_color_scales(const PlyElement &element,
+                                const VertexProperties &properties,
+                                float r_scales[4])
+{
+  for (const int channel : IndexRange(4)) {
+    const int property = properties.color[channel];
+    r_scales[channel] = property == -1 ? 1.0f : color_scale(element.properties[property].type);
+  }
+}
+
+/** Convert the colors read from the file to the linear colors stored in Blender. */
+static void colors_srgb_to_linear(MutableSpan<float4> colors)
+{
+  threading::parallel_for(colors.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      srgb_to_linearrgb_v3_v3(colors[i], colors[i]);
+    }
+  });
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Binary Files
+ * \{ */
+
+template<typename T> static T load_binary(const char *ptr, const bool swap)
+{
+  T value;
+  if (swap) {
+    char bytes[sizeof(T)];
+    for (const int i : IndexRange(sizeof(T))) {
+      bytes[i] = ptr[sizeof(T) - 1 - i];
+    }
+    memcpy(&value, bytes, sizeof(T));
+  }
+  else {
+    memcpy(&value, ptr, sizeof(T));
+  }
+  return value;
+}
+
+static double read_binary_value(const char *ptr, const PlyDataType type, const bool swap)
+{
+  switch (type) {
+    case PlyDataType::Char:
+      return load_binary<int8_t>(ptr, swap);
+    case PlyDataType::UChar:
+      return load_binary<uint8_t>(ptr, swap);
+    case PlyDataType::Short:
+      return load_binary<int16_t>(ptr, swap);
+    case PlyDataType::UShort:
+      return load_binary<uint16_t>(ptr, swap);
+    case PlyDataType::Int:
+      return load_binary<int32_t>(ptr, swap);
+    case PlyDataType::UInt:
+      return load_binary<uint32_t>(ptr, swap);
+    case PlyDataType::Float:
+      return load_binary<float>(ptr, swap);
+    case PlyDataType::Double:
+      return load_binary<double>(ptr, swap);
+    case PlyDataType::None:
+      break;
+  }
+  BLI_assert_unreachable();
+  return 0.0;
+}
+
+static bool element_has_lists(const PlyElement &element)
+{
+  for (const PlyProperty &property : element.properties) {
+    if (property.count_type != PlyDataType::None) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Find the offsets of all properties in a record. The record is only accessed to read the item
+ * counts of list properties, the offsets of elements without lists are the same for all records.
+ * \return The size of the record.
+ */
+static int64_t record_property_offsets(const char *record,
+                                       const PlyElement &element,
+                                       const bool swap,
+                                       MutableSpan<int64_t> r_offsets)
+{
+  int64_t offset = 0;
+  for (const int i : element.properties.index_range()) {
+    const PlyProperty &property = element.properties[i];
+    r_offsets[i] = offset;
+    if (property.count_type == PlyDataType::None) {
+      offset += ply_data_type_size(property.type);
+    }
+    else {
+      const int64_t count = int64_t(read_binary_value(record + offset, property.count_type, swap));
+      offset += ply_data_type_size(property.count_type) +
+                std::max(count, int64_t(0)) * ply_data_type_size(property.type);
+    }
+  }
+  return offset;
+}
+
+/**
+ * Find the start of every record of an element with list properties, which have a different
+ * size for every record. This is the only part of reading binary files that can't be done in
+ * parallel.
+ * \return The size of the element data, or -1 when the data ends early.
+ */
+static int64_t scan_binary_records(const Span<char> data,
+                                   const PlyElement &element,
+                                   const bool swap,
+                                   MutableSpan<int64_t> r_record_offsets)
+{
+  int64_t offset = 0;
+  for (const int64_t i : IndexRange(element.count)) {
+    r_record_offsets[i] = offset;
+    for (const PlyProperty &property : element.properties) {
+      if (property.count_type == PlyDataType::None) {
+        offset += ply_data_type_size(property.type);
+        continue;
+      }
+      const int count_size = ply_data_type_size(property.count_type);
+      if (offset + count_size > data.size()) {
+        return -1;
+      }
+      const int64_t count = int64_t(
+          read_binary_value(data.data() + offset, property.count_type, swap));
+      if (count < 0) {
+        return -1;
+      }
+      offset += count_size + count * ply_data_type_size(property.type);
+    }
+    if (offset > data.size()) {
+      return -1;
+    }
+  }
+  return offset;
+}
+
+/**
+ * Gives access to the records of a binary element. Records of elements without list properties
+ * all have the same size and layout, so nothing has to be stored for them.
+ */
+class BinaryRecords {
+ private:
+  const char *data_;
+  const PlyElement &element_;
+  bool swap_;
+  Array<int64_t> record_offsets_;
+  Array<int64_t> fixed_property_offsets_;
+  int64_t fixed_record_size_ = 0;
+
+ public:
+  BinaryRecords(const char *data, const PlyElement &element, const bool swap)
+      : data_(data), element_(element), swap_(swap)
+  {
+  }
+
+  /** \return The size of the element data, or -1 when the data ends early. */
+  int64_t init(const Span<char> data)
+  {
+    if (element_has_lists(element_)) {
+      record_offsets_.reinitialize(element_.count);
+      return scan_binary_records(data, element_, swap_, record_offsets_);
+    }
+    fixed_property_offsets_.reinitialize(element_.properties.size());
+    fixed_record_size_ = record_property_offsets(
+        nullptr, element_, swap_, fixed_property_offsets_);
+    const int64_t size = fixed_record_size_ * element_.count;
+    return size > data.size() ? -1 : size;
+  }
+
+  const char *record(const int64_t index) const
+  {
+    return data_ + (record_offsets_.is_empty() ? index * fixed_record_size_ :
+                                                 record_offsets_[index]);
+  }
+
+  /** Find the offsets of the properties of the record, only valid until the next call. */
+  Span<int64_t> property_offsets(const char *record, MutableSpan<int64_t> r_buffer) const
+  {
+    if (record_offsets_.is_empty()) {
+      return fixed_property_offsets_;
+    }
+    record_property_offsets(record, element_, swap_, r_buffer);
+    return r_buffer;
+  }
+
+  double read(const char *record, const Span<int64_t> offsets, const int property) const
+  {
+    return read_binary_value(record + offsets[property], element_.properties[property].type, swap_);
+  }
+};
+
+static void read_binary_vertices(const BinaryRecords &records,
+                                 const PlyElement &element,
+                                 const VertexProperties &properties,
+                                 PlyData &r_data)
+{
+  allocate_vertex_data(element, properties, r_data);
+  float color_scales[4];
+  vertex_color_scales(element, properties, color_scales);
+
+  threading::parallel_for(IndexRange(element.count), 4096, [&](const IndexRange range) {
+    Array<int64_t> offsets_buffer(element.properties.size());
+    for (const int64_t i : range) {
+      const char *record = records.record(i);
+      const Span<int64_t> offsets = records.property_offsets(record, offsets_buffer);
+      for (const int axis : IndexRange(3)) {
+        r_data.positions[i][axis] = float(records.read(record, offsets, properties.position[axis]));
+      }
+      if (!r_data.normals.is_empty()) {
+        for (const int axis : IndexRange(3)) {
+          r_data.normals[i][axis] = float(records.read(record, offsets, properties.normal[axis]));
+        }
+      }
+      if (!r_data.colors.is_empty()) {
+        for (const int channel : IndexRange(4)) {
+          const int property = properties.color[channel];
+          r_data.colors[i][channel] = property == -1 ? 1.0f :
+                                                       float(records.read(
+                                                           record, offsets, property)) *
+                                                           color_scales[channel];
+        }
+      }
+    }
+  });
+}
+
+static void read_binary_faces(const BinaryRecords &records,
+                              const PlyElement &element,
+                              const int indices_property,
+                              const bool swap,
+                              PlyData &r_data)
+{
+  const PlyProperty &property = element.properties[indices_property];
+  const int count_size = ply_data_type_size(property.count_type);
+  const int index_size = ply_data_type_size(property.type);
+
+  r_data.face_offsets.reinitialize(element.count + 1);
+  threading::parallel_for(IndexRange(element.count), 4096, [&](const IndexRange range) {
+    Array<int64_t> offsets_buffer(element.properties.size());
+    for (const int64_t i : range) {
+      const char *record = records.record(i);
+      const Span<int64_t> offsets = records.property_offsets(record, offsets_buffer);
+      r_data.face_offsets[i] = int(
+          read_binary_value(record + offsets[indices_property], property.count_type, swap));
+    }
+  });
+
+  int offset = 0;
+  for (const int64_t i : IndexRange(element.count)) {
+    const int size = r_data.face_offsets[i];
+    r_data.face_offsets[i] = offset;
+    offset += size;
+  }
+  r_data.face_offsets.last() = offset;
+
+  r_data.face_verts.reinitialize(offset);
+  threading::parallel_for(IndexRange(element.count), 4096, [&](const IndexRange range) {
+    Array<int64_t> offsets_buffer(element.properties.size());
+    for (const int64_t i : range) {
+      const char *record = records.record(i);
+      const Span<int64_t> offsets = records.property_offsets(record, offsets_buffer);
+      const char *indices = record + offsets[indices_property] + count_size;
+      const int face_start = r_data.face_offsets[i];
+      const int face_size = r_data.face_offsets[i + 1] - face_start;
+      for (const int j : IndexRange(face_size)) {
+        r_data.face_verts[face_start + j] = int(
+            read_binary_value(indices + j * index_size, property.type, swap));
+      }
+    }
+  });
+}
+
+static bool read_binary_data(const Span<char> data, const PlyHeader &header, PlyData &r_data)
+{
+  const bool is_big_endian = header.format == PlyFormat::BinaryBigEndian;
+  const bool swap = is_big_endian != (ENDIAN_ORDER == B_ENDIAN);
+
+  int64_t element_start = 0;
+  for (const PlyElement &element : header.elements) {
+    const Span<char> element_data = data.drop_front(element_start);
+    BinaryRecords records(element_data.data(), element, swap);
+    const int64_t element_size = records.init(element_data);
+    if (element_size == -1) {
+      return report_error("Unexpected end of file");
+    }
+
+    if (element.name == "vertex") {
+      VertexProperties properties;
+      if (!find_vertex_properties(element, properties)) {
+        return false;
+      }
+      read_binary_vertices(records, element, properties, r_data);
+    }
+    else if (element.name == "face") {
+      const int indices_property = find_face_indices_property(element);
+      if (indices_property != -1) {
+        read_binary_faces(records, element, indices_property, swap, r_data);
+      }
+    }
+    element_start += element_size;
+  }
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name ASCII Files
+ * \{ */
+
+class AsciiReader {
+ private:
+  const char *ptr_;
+  const char *end_;
+
+ public:
+  AsciiReader(const Span<char> text) : ptr_(text.begin()), end_(text.end())
+  {
+  }
+
+  bool read(double &r_value)
+  {
+    while (ptr_ < end_ && ELEM(*ptr_, ' ', '\t', '\r', '\n')) {
+      ptr_++;
+    }
+    /* Skip '+' */
+    if (ptr_ < end_ && *ptr_ == '+') {
+      ptr_++;
+    }
+    const fast_float::from_chars_result res = fast_float::from_chars(ptr_, end_, r_value);
+    if (res.ec != std::errc()) {
+      return false;
+    }
+    ptr_ = res.ptr;
+    return true;
+  }
+};
+
+static bool read_ascii_data(const Span<char> data, const PlyHeader &header, PlyData &r_data)
+{
+  AsciiReader reader(data);
+  for (const PlyElement &element : header.elements) {
+    const bool is_vertex = element.name == "vertex";
+    const bool is_face = element.name == "face";
+    VertexProperties vertex_properties;
+    float color_scales[4];
+    if (is_vertex) {
+      if (!find_vertex_properties(element, vertex_properties)) {
+        return false;
+      }
+      allocate_vertex_data(element, vertex_properties, r_data);
+      vertex_color_scales(element, vertex_properties, color_scales);
+    }
+    const int indices_property = is_face ? find_face_indices_property(element) : -1;
+    Vector<int> face_offsets;
+    Vector<int> face_verts;
+
+    Array<double> values(element.properties.size(), 1.0);
+    for (const int64_t i : IndexRange(element.count)) {
+      for (const int property_index : element.properties.index_range()) {
+        const PlyProperty &property = element.properties[property_index];
+        if (!reader.read(values[property_index])) {
+          return report_error("Unexpected end of file or invalid number");
+        }
+        if (property.count_type == PlyDataType::None) {
+          continue;
+        }
+        const int64_t count = int64_t(values[property_index]);
+        if (property_index == indices_property) {
+          face_offsets.append(int(face_verts.size()));
+        }
+        for (int64_t j = 0; j < count; j++) {
+          double value;
+          if (!reader.read(value)) {
+            return report_error("Unexpected end of file or invalid number");
+          }
+          if (property_index == indices_property) {
+            face_verts.append(int(value));
+          }
+        }
+      }
+      if (is_vertex) {
+        const VertexProperties &props = vertex_properties;
+        r_data.positions[i] = float3(
+            values[props.position[0]], values[props.position[1]], values[props.position[2]]);
+        if (!r_data.normals.is_empty()) {
+          r_data.normals[i] = float3(
+              values[props.normal[0]], values[props.normal[1]], values[props.normal[2]]);
+        }
+        if (!r_data.colors.is_empty()) {
+          for (const int channel : IndexRange(4)) {
+            const int property = props.color[channel];
+            r_data.colors[i][channel] = property == -1 ?
+                                            1.0f :
+                                            float(values[property]) * color_scales[channel];
+          }
+        }
+      }
+    }
+
+    if (indices_property != -1) {
+      face_offsets.append(int(face_verts.size()));
+      r_data.face_offsets = face_offsets.as_span();
+      r_data.face_verts = face_verts.as_span();
+    }
+  }
+  return true;
+}
+
+/** \} */
+
+bool read_ply_data(const Span<char> file_content, const PlyHeader &header, PlyData &r_data)
+{
+  const Span<char> data = file_content.drop_front(int64_t(header.data_offset));
+  const bool success = header.format == PlyFormat::Ascii ? read_ascii_data(data, header, r_data) :
+                                                           read_binary_data(data, header, r_data);
+  if (success && !r_data.colors.is_empty()) {
+    colors_srgb_to_linear(r_data.colors);
+  }
+  return success;
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "BLI_span.hh"
+#include "BLI_string_ref.hh"
+
+#include "ply_data.hh"
+
+namespace blender::io::ply {
+
+/**
+ * Parse the header at the start of the file content.
+ * \return False when the content is not a valid PLY header, an error is printed then.
+ */
+bool read_ply_header(StringRef file_content, PlyHeader &r_header);
+
+/**
+ * Read the vertex and face elements described by the header. Binary files are read in parallel
+ * straight from the file content, which is typically memory-mapped. Elements that have no
+ * corresponding Blender data are skipped.
+ * \return False when the data does not match the header, an error is printed then.
+ */
+bool read_ply_data(Span<char> file_content, const PlyHeader &header, PlyData &r_data);
+
+}  // namespace blender::io::ply
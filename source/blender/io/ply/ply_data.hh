@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_vector.hh"
+
+namespace blender::io::ply {
+
+enum class PlyFormat { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+enum class PlyDataType { None, Char, UChar, Short, UShort, Int, UInt, Float, Double };
+
+struct PlyProperty {
+  std::string name;
+  PlyDataType type = PlyDataType::None;
+  /** Type of the item count when the property is a list, #PlyDataType::None otherwise. */
+  PlyDataType count_type = PlyDataType::None;
+};
+
+struct PlyElement {
+  std::string name;
+  int64_t count = 0;
+  Vector<PlyProperty> properties;
+};
+
+struct PlyHeader {
+  PlyFormat format = PlyFormat::Ascii;
+  Vector<PlyElement> elements;
+  /** Offset of the element data from the start of the file. */
+  size_t data_offset = 0;
+};
+
+/**
+ * The geometry read from a file, in the layout of the Blender data it is converted to.
+ * Optional arrays are empty when the file doesn't contain the data.
+ */
+struct PlyData {
+  Array<float3> positions;
+  Array<float3> normals;
+  /** Linear colors. */
+  Array<float4> colors;
+  /** Start of every face in #face_verts, with the total size as last item. */
+  Array<int> face_offsets;
+  Array<int> face_verts;
+};
+
+/** Size of a value of the type in binary files. */
+int ply_data_type_size(PlyDataType type);
+
+}  // namespace blender::io::ply
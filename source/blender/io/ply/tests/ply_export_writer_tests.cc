@@ -0,0 +1,178 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <system_error>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_appdir.h"
+
+#include "BLI_endian_defines.h"
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+
+#include "ply_export_writer.hh"
+#include "ply_import_reader.hh"
+
+namespace blender::io::ply {
+
+class ply_export_writer_test : public testing::Test {
+ protected:
+  char filepath_[FILE_MAX];
+
+  void SetUp() override
+  {
+    BKE_tempdir_init(nullptr);
+    BLI_path_join(filepath_, sizeof(filepath_), BKE_tempdir_base(), "ply_writer_test.ply", nullptr);
+  }
+
+  void TearDown() override
+  {
+    BLI_delete(filepath_, false, false);
+  }
+
+  void write(const PlyData &data, const bool ascii)
+  {
+    PLYWriter writer(filepath_, ascii);
+    writer.write(data);
+  }
+
+  std::string read_file_content()
+  {
+    size_t size = 0;
+    void *buffer = BLI_file_read_binary_as_mem(filepath_, 0, &size);
+    if (buffer == nullptr) {
+      return "";
+    }
+    std::string content(static_cast<const char *>(buffer), size);
+    MEM_freeN(buffer);
+    return content;
+  }
+
+  /** Read the written file back with the importer. */
+  bool read(PlyHeader &r_header, PlyData &r_data)
+  {
+    const std::string content = this->read_file_content();
+    if (!read_ply_header(content, r_header)) {
+      return false;
+    }
+    return read_ply_data(Span<char>(content.data(), content.size()), r_header, r_data);
+  }
+};
+
+/** A quad and a triangle, with normals and colors. */
+static PlyData create_test_data()
+{
+  PlyData data;
+  data.positions = Span<float3>(
+      {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0.5f, -1.25f, 1e-3f}});
+  data.normals = Span<float3>({{0, 0, 1}, {0, 0, 1}, {0, 0, 1}, {0, 0, 1}, {0, -1, 0}});
+  data.colors = Span<float4>(
+      {{1, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}, {1, 1, 1, 0}, {0, 0, 0, 1}});
+  data.face_offsets = Span<int>({0, 4, 7});
+  data.face_verts = Span<int>({0, 1, 2, 3, 1, 0, 4});
+  return data;
+}
+
+static void expect_data_eq(const PlyData &a, const PlyData &b)
+{
+  ASSERT_EQ(a.positions.size(), b.positions.size());
+  for (const int i : a.positions.index_range()) {
+    EXPECT_V3_NEAR(a.positions[i], b.positions[i], 1e-6f);
+  }
+  ASSERT_EQ(a.normals.size(), b.normals.size());
+  for (const int i : a.normals.index_range()) {
+    EXPECT_V3_NEAR(a.normals[i], b.normals[i], 1e-6f);
+  }
+  /* Colors are stored as 8-bit sRGB. */
+  ASSERT_EQ(a.colors.size(), b.colors.size());
+  for (const int i : a.colors.index_range()) {
+    EXPECT_V4_NEAR(a.colors[i], b.colors[i], 1e-2f);
+  }
+  EXPECT_EQ(a.face_offsets.as_span(), b.face_offsets.as_span());
+  EXPECT_EQ(a.face_verts.as_span(), b.face_verts.as_span());
+}
+
+TEST_F(ply_export_writer_test, ascii)
+{
+  const PlyData data = create_test_data();
+  this->write(data, true);
+
+  const std::string content = this->read_file_content();
+  EXPECT_EQ(content.rfind("ply\nformat ascii 1.0\n", 0), 0);
+  EXPECT_NE(content.find("element vertex 5\n"), std::string::npos);
+  EXPECT_NE(content.find("property list uchar int vertex_indices\n"), std::string::npos);
+  EXPECT_NE(content.find("end_header\n0 0 0 0 0 1 255 0 0 255\n"), std::string::npos);
+  EXPECT_NE(content.find("\n4 0 1 2 3\n3 1 0 4\n"), std::string::npos);
+
+  PlyHeader header;
+  PlyData result;
+  ASSERT_TRUE(this->read(header, result));
+  EXPECT_EQ(header.format, PlyFormat::Ascii);
+  expect_data_eq(data, result);
+}
+
+TEST_F(ply_export_writer_test, binary)
+{
+  const PlyData data = create_test_data();
+  this->write(data, false);
+
+  PlyHeader header;
+  PlyData result;
+  ASSERT_TRUE(this->read(header, result));
+  EXPECT_EQ(header.format,
+            ENDIAN_ORDER == B_ENDIAN ? PlyFormat::BinaryBigEndian :
+                                       PlyFormat::BinaryLittleEndian);
+  ASSERT_EQ(header.elements.size(), 2);
+  /* Positions, normals and colors with alpha. */
+  EXPECT_EQ(header.elements[0].properties.size(), 10);
+  expect_data_eq(data, result);
+}
+
+TEST_F(ply_export_writer_test, positions_only)
+{
+  PlyData data;
+  data.positions = Span<float3>({{1, 2, 3}, {-4, 5.5f, 6}});
+  /* The face element is written without records, which reads back as zero faces. */
+  data.face_offsets = Span<int>({0});
+  for (const bool ascii : {true, false}) {
+    this->write(data, ascii);
+    PlyHeader header;
+    PlyData result;
+    ASSERT_TRUE(this->read(header, result));
+    EXPECT_EQ(header.elements[0].properties.size(), 3);
+    EXPECT_EQ(header.elements[1].count, 0);
+    expect_data_eq(data, result);
+  }
+}
+
+TEST_F(ply_export_writer_test, large_ngon)
+{
+  /* Faces with more than 255 vertices don't fit into the usual single byte face sizes. */
+  PlyData data;
+  const int verts_num = 300;
+  data.positions.reinitialize(verts_num);
+  data.face_verts.reinitialize(verts_num);
+  for (const int i : IndexRange(verts_num)) {
+    data.positions[i] = float3(float(i), 0, 0);
+    data.face_verts[i] = i;
+  }
+  data.face_offsets = Span<int>({0, verts_num});
+
+  for (const bool ascii : {true, false}) {
+    this->write(data, ascii);
+    PlyHeader header;
+    PlyData result;
+    ASSERT_TRUE(this->read(header, result));
+    EXPECT_EQ(header.elements[1].properties[0].count_type, PlyDataType::Int);
+    expect_data_eq(data, result);
+  }
+}
+
+TEST_F(ply_export_writer_test, invalid_path)
+{
+  EXPECT_THROW(PLYWriter("/nonexistent/dir/file.ply", true), std::system_error);
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,308 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <cstring>
+
+#include "testing/testing.h"
+
+#include "BLI_endian_defines.h"
+
+#include "ply_import_reader.hh"
+
+namespace blender::io::ply {
+
+static bool read_ply(const StringRef content, PlyHeader &r_header, PlyData &r_data)
+{
+  if (!read_ply_header(content, r_header)) {
+    return false;
+  }
+  return read_ply_data(Span<char>(content.data(), content.size()), r_header, r_data);
+}
+
+template<typename T> static void append_binary(std::string &r_data, T value, const bool swap)
+{
+  char bytes[sizeof(T)];
+  memcpy(bytes, &value, sizeof(T));
+  if (swap) {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  r_data.append(bytes, sizeof(T));
+}
+
+/** Two triangles sharing an edge, with a list property that is not used by the importer. */
+static std::string binary_quad(const bool big_endian)
+{
+  const bool swap = big_endian != (ENDIAN_ORDER == B_ENDIAN);
+  std::string content = std::string("ply\nformat ") +
+                        (big_endian ? "binary_big_endian" : "binary_little_endian") +
+                        " 1.0\n"
+                        "element vertex 4\n"
+                        "property float x\nproperty float y\nproperty double z\n"
+                        "element face 2\n"
+                        "property list uchar int vertex_indices\n"
+                        "property list ushort uchar flags\n"
+                        "end_header\n";
+  const float3 positions[4] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0.5f}};
+  for (const float3 &co : positions) {
+    append_binary(content, co.x, swap);
+    append_binary(content, co.y, swap);
+    append_binary(content, double(co.z), swap);
+  }
+  for (const int3 face : {int3(0, 1, 2), int3(0, 2, 3)}) {
+    append_binary(content, uint8_t(3), swap);
+    append_binary(content, int32_t(face.x), swap);
+    append_binary(content, int32_t(face.y), swap);
+    append_binary(content, int32_t(face.z), swap);
+    append_binary(content, uint16_t(2), swap);
+    append_binary(content, uint8_t(7), swap);
+    append_binary(content, uint8_t(8), swap);
+  }
+  return content;
+}
+
+static void expect_binary_quad(const PlyData &data)
+{
+  ASSERT_EQ(data.positions.size(), 4);
+  EXPECT_EQ(data.positions[1], float3(1, 0, 0));
+  EXPECT_EQ(data.positions[3], float3(0, 1, 0.5f));
+  EXPECT_TRUE(data.normals.is_empty());
+  EXPECT_TRUE(data.colors.is_empty());
+  EXPECT_EQ(data.face_offsets.as_span(), Span<int>({0, 3, 6}));
+  EXPECT_EQ(data.face_verts.as_span(), Span<int>({0, 1, 2, 0, 2, 3}));
+}
+
+TEST(ply_import_reader, header)
+{
+  const std::string content =
+      "ply\n"
+      "format ascii 1.0\n"
+      "comment made by hand\n"
+      "element vertex 8\n"
+      "property float x\n"
+      "property float y\n"
+      "property float z\n"
+      "property uchar red\n"
+      "element face 6\n"
+      "property list uint8 int32 vertex_indices\n"
+      "end_header\n"
+      "0 0 0";
+  PlyHeader header;
+  ASSERT_TRUE(read_ply_header(content, header));
+  EXPECT_EQ(header.format, PlyFormat::Ascii);
+  EXPECT_EQ(header.data_offset, content.size() - strlen("0 0 0"));
+  ASSERT_EQ(header.elements.size(), 2);
+
+  const PlyElement &vertex = header.elements[0];
+  EXPECT_EQ(vertex.name, "vertex");
+  EXPECT_EQ(vertex.count, 8);
+  ASSERT_EQ(vertex.properties.size(), 4);
+  EXPECT_EQ(vertex.properties[0].name, "x");
+  EXPECT_EQ(vertex.properties[0].type, PlyDataType::Float);
+  EXPECT_EQ(vertex.properties[0].count_type, PlyDataType::None);
+  EXPECT_EQ(vertex.properties[3].type, PlyDataType::UChar);
+
+  const PlyElement &face = header.elements[1];
+  EXPECT_EQ(face.name, "face");
+  EXPECT_EQ(face.count, 6);
+  ASSERT_EQ(face.properties.size(), 1);
+  EXPECT_EQ(face.properties[0].name, "vertex_indices");
+  EXPECT_EQ(face.properties[0].type, PlyDataType::Int);
+  EXPECT_EQ(face.properties[0].count_type, PlyDataType::UChar);
+}
+
+TEST(ply_import_reader, header_binary_formats)
+{
+  PlyHeader header;
+  ASSERT_TRUE(read_ply_header("ply\r\nformat binary_big_endian 1.0\r\nend_header\r\n", header));
+  EXPECT_EQ(header.format, PlyFormat::BinaryBigEndian);
+  EXPECT_TRUE(header.elements.is_empty());
+
+  header = {};
+  ASSERT_TRUE(read_ply_header("ply\nformat binary_little_endian 1.0\nend_header\n", header));
+  EXPECT_EQ(header.format, PlyFormat::BinaryLittleEndian);
+}
+
+TEST(ply_import_reader, header_malformed)
+{
+  const char *invalid_headers[] = {
+      "",
+      "format ascii 1.0\nend_header\n",
+      "plyx\nformat ascii 1.0\nend_header\n",
+      "ply\nformat\nend_header\n",
+      "ply\nformat binary_middle_endian 1.0\nend_header\n",
+      "ply\nformat ascii 1.0\nelement vertex\nend_header\n",
+      "ply\nformat ascii 1.0\nelement vertex -1\nend_header\n",
+      "ply\nformat ascii 1.0\nelement vertex many\nend_header\n",
+      "ply\nformat ascii 1.0\nproperty float x\nend_header\n",
+      "ply\nformat ascii 1.0\nelement vertex 1\nproperty half x\nend_header\n",
+      "ply\nformat ascii 1.0\nelement vertex 1\nproperty float\nend_header\n",
+      "ply\nformat ascii 1.0\nelement face 1\nproperty list uchar int\nend_header\n",
+      "ply\nformat ascii 1.0\nelement face 1\nproperty list half int vertex_indices\nend_header\n",
+      "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n",
+      "ply\nformat ascii 1.0\nend_header",
+  };
+  for (const char *content : invalid_headers) {
+    PlyHeader header;
+    EXPECT_FALSE(read_ply_header(content, header)) << content;
+  }
+}
+
+TEST(ply_import_reader, ascii)
+{
+  const std::string content =
+      "ply\n"
+      "format ascii 1.0\n"
+      "element vertex 5\n"
+      "property float x\nproperty float y\nproperty float z\n"
+      "property float nx\nproperty float ny\nproperty float nz\n"
+      "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+      "element face 2\n"
+      "property list uchar int vertex_indices\n"
+      "element edge 1\n"
+      "property int vertex1\nproperty int vertex2\n"
+      "end_header\n"
+      "0 0 0 0 0 1 255 0 0\n"
+      "1 0 0 0 0 1 0 255 0\n"
+      "1.5 1 0 0 0 1 0 0 255\n"
+      "0 1 -0.25 0 0 1 255 255 255\n"
+      "+2e1 0 0 0 0 -1 0 0 0\n"
+      "4 0 1 2 3\n"
+      "3 1 4 2\n"
+      "0 4\n";
+  PlyHeader header;
+  PlyData data;
+  ASSERT_TRUE(read_ply(content, header, data));
+
+  ASSERT_EQ(data.positions.size(), 5);
+  EXPECT_EQ(data.positions[2], float3(1.5f, 1, 0));
+  EXPECT_EQ(data.positions[3], float3(0, 1, -0.25f));
+  EXPECT_EQ(data.positions[4], float3(20, 0, 0));
+  ASSERT_EQ(data.normals.size(), 5);
+  EXPECT_EQ(data.normals[0], float3(0, 0, 1));
+  EXPECT_EQ(data.normals[4], float3(0, 0, -1));
+  /* Alpha defaults to opaque when the file has no alpha property. */
+  ASSERT_EQ(data.colors.size(), 5);
+  EXPECT_V4_NEAR(data.colors[0], float4(1, 0, 0, 1), 1e-6f);
+  EXPECT_V4_NEAR(data.colors[2], float4(0, 0, 1, 1), 1e-6f);
+  EXPECT_V4_NEAR(data.colors[4], float4(0, 0, 0, 1), 1e-6f);
+  EXPECT_EQ(data.face_offsets.as_span(), Span<int>({0, 4, 7}));
+  EXPECT_EQ(data.face_verts.as_span(), Span<int>({0, 1, 2, 3, 1, 4, 2}));
+}
+
+TEST(ply_import_reader, ascii_without_faces)
+{
+  const std::string content =
+      "ply\nformat ascii 1.0\n"
+      "element vertex 2\nproperty double x\nproperty double y\nproperty double z\n"
+      "end_header\n"
+      "1 2 3\n4 5 6\n";
+  PlyHeader header;
+  PlyData data;
+  ASSERT_TRUE(read_ply(content, header, data));
+  EXPECT_EQ(data.positions.as_span(), Span<float3>({float3(1, 2, 3), float3(4, 5, 6)}));
+  EXPECT_TRUE(data.face_offsets.is_empty());
+}
+
+TEST(ply_import_reader, binary_little_endian)
+{
+  PlyHeader header;
+  PlyData data;
+  ASSERT_TRUE(read_ply(binary_quad(false), header, data));
+  EXPECT_EQ(header.format, PlyFormat::BinaryLittleEndian);
+  expect_binary_quad(data);
+}
+
+TEST(ply_import_reader, binary_big_endian)
+{
+  PlyHeader header;
+  PlyData data;
+  ASSERT_TRUE(read_ply(binary_quad(true), header, data));
+  EXPECT_EQ(header.format, PlyFormat::BinaryBigEndian);
+  expect_binary_quad(data);
+}
+
+TEST(ply_import_reader, binary_colors)
+{
+  const bool swap = ENDIAN_ORDER == B_ENDIAN;
+  std::string content =
+      "ply\nformat binary_little_endian 1.0\n"
+      "element vertex 2\n"
+      "property float x\nproperty float y\nproperty float z\n"
+      "property ushort red\nproperty ushort green\nproperty ushort blue\nproperty ushort alpha\n"
+      "end_header\n";
+  for (const int i : IndexRange(2)) {
+    append_binary(content, float(i), swap);
+    append_binary(content, 0.0f, swap);
+    append_binary(content, 0.0f, swap);
+    append_binary(content, uint16_t(i == 0 ? 65535 : 0), swap);
+    append_binary(content, uint16_t(0), swap);
+    append_binary(content, uint16_t(i == 0 ? 0 : 65535), swap);
+    append_binary(content, uint16_t(i == 0 ? 65535 : 0), swap);
+  }
+  PlyHeader header;
+  PlyData data;
+  ASSERT_TRUE(read_ply(content, header, data));
+  ASSERT_EQ(data.colors.size(), 2);
+  EXPECT_V4_NEAR(data.colors[0], float4(1, 0, 0, 1), 1e-6f);
+  EXPECT_V4_NEAR(data.colors[1], float4(0, 0, 1, 0), 1e-6f);
+}
+
+TEST(ply_import_reader, ascii_malformed_records)
+{
+  const char *header =
+      "ply\nformat ascii 1.0\n"
+      "element vertex 2\nproperty float x\nproperty float y\nproperty float z\n"
+      "element face 1\nproperty list uchar int vertex_indices\n"
+      "end_header\n";
+  const char *invalid_records[] = {
+      /* Missing vertex. */
+      "0 0 0\n",
+      /* Missing coordinate. */
+      "0 0 0\n1 1\n",
+      /* Not a number. */
+      "0 0 0\n1 one 1\n3 0 1 0\n",
+      /* Missing face. */
+      "0 0 0\n1 1 1\n",
+      /* Fewer indices than the face size. */
+      "0 0 0\n1 1 1\n3 0 1\n",
+  };
+  for (const char *records : invalid_records) {
+    PlyHeader header_data;
+    PlyData data;
+    EXPECT_FALSE(read_ply(std::string(header) + records, header_data, data)) << records;
+  }
+}
+
+TEST(ply_import_reader, binary_malformed_records)
+{
+  const std::string content = binary_quad(false);
+  const int64_t data_size = 4 * (4 + 4 + 8) + 2 * (1 + 3 * 4 + 2 + 2);
+  const int64_t data_offset = int64_t(content.size()) - data_size;
+  /* Every truncation of the data ends inside of a record. */
+  for (const int64_t size : {int64_t(0), int64_t(15), int64_t(64), data_size - 17, data_size - 1}) {
+    PlyHeader header;
+    PlyData data;
+    EXPECT_FALSE(read_ply(content.substr(0, data_offset + size), header, data)) << size;
+  }
+
+  /* A face that claims to have more indices than the file contains. */
+  std::string bad_count = content;
+  bad_count[data_offset + 4 * 16] = char(200);
+  PlyHeader header;
+  PlyData data;
+  EXPECT_FALSE(read_ply(bad_count, header, data));
+}
+
+TEST(ply_import_reader, vertex_without_positions)
+{
+  const std::string content =
+      "ply\nformat ascii 1.0\n"
+      "element vertex 1\nproperty float x\nproperty float y\n"
+      "end_header\n"
+      "0 0\n";
+  PlyHeader header;
+  PlyData data;
+  EXPECT_FALSE(read_ply(content, header, data));
+}
+
+}  // namespace blender::io::ply
@@ -25,11 +25,28 @@ struct STLImportParams {
   bool use_mesh_validate;
 };
 
+struct STLExportParams {
+  /** Full path to the destination STL file. */
+  char filepath[FILE_MAX];
+  eIOAxis forward_axis;
+  eIOAxis up_axis;
+  float global_scale;
+  bool use_scene_unit;
+  bool apply_modifiers;
+  bool export_selected_objects;
+  bool ascii_format;
+};
+
 /**
  * C-interface for the importer.
  */
 void STL_import(bContext *C, const struct STLImportParams *import_params);
 
+/**
+ * C-interface for the exporter.
+ */
+void STL_export(bContext *C, const struct STLExportParams *export_params);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup stl
+ */
+
+#include <iostream>
+#include <memory>
+#include <system_error>
+
+#include "BKE_context.h"
+#include "BKE_mesh.h"
+#include "BKE_mesh_runtime.h"
+#include "BKE_object.h"
+
+#include "BLI_array.hh"
+#include "BLI_float4x4.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_task.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "stl_export.hh"
+#include "stl_export_writer.hh"
+
+namespace blender::io::stl {
+
+static void write_mesh_object(STLWriter &writer,
+                              Object &object,
+                              const float4x4 &axes_transform,
+                              const bool apply_modifiers)
+{
+  Mesh *mesh = apply_modifiers ? BKE_object_get_evaluated_mesh(&object) :
+                                 BKE_object_get_pre_modified_mesh(&object);
+  if (mesh == nullptr || mesh->totpoly == 0) {
+    return;
+  }
+
+  const float4x4 transform = axes_transform * float4x4(object.obmat);
+  const Span<MVert> verts = mesh->verts();
+  Array<float3> positions(verts.size());
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      positions[i] = transform * float3(verts[i].co);
+    }
+  });
+
+  const Span<MLoopTri> looptris{BKE_mesh_runtime_looptri_ensure(mesh),
+                                BKE_mesh_runtime_looptri_len(mesh)};
+  writer.write_triangles(positions, looptris, mesh->loops(), is_negative_m4(transform.values));
+}
+
+void exporter_main(bContext *C, const STLExportParams &export_params)
+{
+  std::unique_ptr<STLWriter> writer;
+  try {
+    writer = std::make_unique<STLWriter>(export_params.filepath, export_params.ascii_format);
+  }
+  catch (const std::system_error &ex) {
+    std::cerr << ex.code().category().name() << ": " << ex.what() << ": "
+              << ex.code().message() << std::endl;
+    return;
+  }
+
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  Scene *scene = CTX_data_scene(C);
+
+  float global_scale = export_params.global_scale;
+  if ((scene->unit.system != USER_UNIT_NONE) && export_params.use_scene_unit) {
+    global_scale *= scene->unit.scale_length;
+  }
+  /* +Y-forward and +Z-up are the Blender's default axis settings. */
+  float axes_transform3x3[3][3];
+  mat3_from_axis_conversion(
+      export_params.forward_axis, export_params.up_axis, IO_AXIS_Y, IO_AXIS_Z, axes_transform3x3);
+  float4x4 axes_transform = float4x4::identity();
+  copy_m4_m3(axes_transform.values, axes_transform3x3);
+  const float scale_vec[3] = {global_scale, global_scale, global_scale};
+  rescale_m4(axes_transform.values, scale_vec);
+
+  DEGObjectIterSettings deg_iter_settings{};
+  deg_iter_settings.depsgraph = depsgraph;
+  deg_iter_settings.flags = DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                            DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET | DEG_ITER_OBJECT_FLAG_VISIBLE |
+                            DEG_ITER_OBJECT_FLAG_DUPLI;
+  DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, object) {
+    if (object->type != OB_MESH) {
+      continue;
+    }
+    if (export_params.export_selected_objects && !(object->base_flag & BASE_SELECTED)) {
+      continue;
+    }
+    write_mesh_object(*writer, *object, axes_transform, export_params.apply_modifiers);
+  }
+  DEG_OBJECT_ITER_END;
+}
+
+}  // namespace blender::io::stl
@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup stl
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+#include "BKE_blender_version.h"
+
+#include "BLI_array.hh"
+#include "BLI_endian_defines.h"
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
+#include "BLI_math_geom.h"
+#include "BLI_task.hh"
+
+#include "DNA_meshdata_types.h"
+
+#include "stl_export_writer.hh"
+#include "stl_import_binary_reader.hh"
+
+/* SEP macro from BLI path utils clashes with SEP symbol in fmt headers. */
+#undef SEP
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
+
+namespace blender::io::stl {
+
+/* Split up large meshes into multi-threaded jobs; each job formats this amount of triangles. */
+static const int chunk_size = 32768;
+/* Amount of chunks that are formatted before their buffers are written to the file, to limit
+ * the memory used for the formatted output of big meshes. */
+static const int batch_chunks_num = 64;
+
+STLWriter::STLWriter(const char *filepath, const bool ascii) noexcept(false)
+    : filepath_(filepath), ascii_(ascii)
+{
+  file_ = BLI_fopen(filepath, "wb");
+  if (!file_) {
+    throw std::system_error(errno, std::system_category(), "Cannot open file " + filepath_);
+  }
+  const std::string header = std::string("Exported from Blender-") +
+                             BKE_blender_version_string();
+  if (ascii_) {
+    fmt::print(file_, "solid {}\n", header);
+  }
+  else {
+    /* The header of binary files must not start with "solid", the triangle count is written
+     * when closing the file. */
+    char binary_header[BINARY_HEADER_SIZE] = {0};
+    strncpy(binary_header, header.c_str(), BINARY_HEADER_SIZE - 1);
+    fwrite(binary_header, BINARY_HEADER_SIZE, 1, file_);
+    write_tris_num();
+  }
+}
+
+STLWriter::~STLWriter()
+{
+  if (ascii_) {
+    fmt::print(file_, "endsolid\n");
+  }
+  else {
+    fseek(file_, BINARY_HEADER_SIZE, SEEK_SET);
+    write_tris_num();
+  }
+  if (std::fclose(file_)) {
+    std::cerr << "Error: could not close the file '" << filepath_
+              << "' properly, it may be corrupted." << std::endl;
+  }
+}
+
+/** Binary files are always little-endian. */
+void STLWriter::write_tris_num()
+{
+  uint32_t tris_num = tris_num_;
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&tris_num);
+  }
+  fwrite(&tris_num, sizeof(uint32_t), 1, file_);
+}
+
+static void format_triangle_binary(std::vector<char> &r_buffer,
+                                   const float3 &normal,
+                                   const float3 corners[3])
+{
+  float values[12];
+  memcpy(values, &normal, sizeof(float3));
+  memcpy(values + 3, corners, sizeof(float3) * 3);
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_float_array(values, 12);
+  }
+  char data[BINARY_STRIDE] = {0};
+  memcpy(data, values, sizeof(values));
+  r_buffer.insert(r_buffer.end(), data, data + BINARY_STRIDE);
+}
+
+static void format_triangle_ascii(std::vector<char> &r_buffer,
+                                  const float3 &normal,
+                                  const float3 corners[3])
+{
+  auto out = std::back_inserter(r_buffer);
+  fmt::format_to(out, "facet normal {:e} {:e} {:e}\n", normal.x, normal.y, normal.z);
+  fmt::format_to(out, " outer loop\n");
+  for (const int i : IndexRange(3)) {
+    fmt::format_to(out, "  vertex {:e} {:e} {:e}\n", corners[i].x, corners[i].y, corners[i].z);
+  }
+  fmt::format_to(out, " endloop\n");
+  fmt::format_to(out, "endfacet\n");
+}
+
+void STLWriter::write_triangles(const Span<float3> positions,
+                                const Span<MLoopTri> looptris,
+                                const Span<MLoop> loops,
+                                const bool flip_winding)
+{
+  const int tris_num = int(looptris.size());
+  const int chunks_num = (tris_num + chunk_size - 1) / chunk_size;
+
+  for (int batch_start = 0; batch_start < chunks_num; batch_start += batch_chunks_num) {
+    const IndexRange batch(batch_start, std::min(batch_chunks_num, chunks_num - batch_start));
+    /* Give each chunk its own temporary output buffer, and process them in parallel. */
+    Array<std::vector<char>> buffers(batch.size());
+    threading::parallel_for(buffers.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        const int tri_start = batch[i] * chunk_size;
+        const IndexRange chunk_tris(tri_start, std::min(chunk_size, tris_num - tri_start));
+        std::vector<char> &buffer = buffers[i];
+        buffer.reserve(chunk_tris.size() * BINARY_STRIDE);
+        for (const int tri_index : chunk_tris) {
+          const MLoopTri &tri = looptris[tri_index];
+          float3 corners[3];
+          for (const int corner : IndexRange(3)) {
+            const int tri_corner = flip_winding ? 2 - corner : corner;
+            corners[corner] = positions[loops[tri.tri[tri_corner]].v];
+          }
+          float3 normal;
+          normal_tri_v3(normal, corners[0], corners[1], corners[2]);
+          if (ascii_) {
+            format_triangle_ascii(buffer, normal, corners);
+          }
+          else {
+            format_triangle_binary(buffer, normal, corners);
+          }
+        }
+      }
+    });
+    /* Emit all temporary output buffers into the file. */
+    for (const std::vector<char> &buffer : buffers) {
+      fwrite(buffer.data(), 1, buffer.size(), file_);
+    }
+  }
+
+  tris_num_ += uint32_t(tris_num);
+}
+
+}  // namespace blender::io::stl
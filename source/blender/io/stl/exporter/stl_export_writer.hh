@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup stl
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
+#include "BLI_utility_mixins.hh"
+
+struct MLoop;
+struct MLoopTri;
+
+namespace blender::io::stl {
+
+/**
+ * Responsible for writing a binary or ASCII .STL file.
+ *
+ * Big meshes are split into chunks of triangles that are formatted into their own buffers in
+ * parallel, the buffers are then written to the file in order.
+ */
+class STLWriter : NonCopyable, NonMovable {
+ private:
+  std::string filepath_;
+  FILE *file_;
+  bool ascii_;
+  uint32_t tris_num_ = 0;
+
+ public:
+  STLWriter(const char *filepath, bool ascii) noexcept(false);
+  /** Write the triangle count or the end of the solid and close the file. */
+  ~STLWriter();
+
+  /**
+   * Write the triangles of a mesh, with vertex positions already in the space of the file.
+   * \param flip_winding: Reverse the order of triangle corners, used for objects with a negative
+   * scale to keep the normals pointing outwards.
+   */
+  void write_triangles(Span<float3> positions,
+                       Span<MLoopTri> looptris,
+                       Span<MLoop> loops,
+                       bool flip_winding);
+
+ private:
+  void write_tris_num();
+};
+
+}  // namespace blender::io::stl
@@ -71,6 +71,7 @@ void importer_main(Main *bmain,
     stl_import_report_error(file);
     return;
   }
+  num_tri = stl_binary_tris_num_to_host(num_tri);
   bool is_ascii_stl = (file_size != (BINARY_HEADER_SIZE + 4 + BINARY_STRIDE * num_tri));
 
   /* Name used for both mesh and object. */
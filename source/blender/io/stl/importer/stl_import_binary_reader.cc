@@ -11,7 +11,11 @@
 #include "BKE_mesh.h"
 
 #include "BLI_array.hh"
+#include "BLI_endian_defines.h"
+#include "BLI_endian_switch.h"
 #include "BLI_memory_utils.hh"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -29,6 +33,66 @@ struct STLBinaryTriangle {
 };
 #pragma pack(pop)
 
+/* Binary files are always little-endian. */
+
+uint32_t stl_binary_tris_num_to_host(uint32_t tris_num)
+{
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&tris_num);
+  }
+  return tris_num;
+}
+
+static void stl_binary_triangle_to_host(STLBinaryTriangle &tri)
+{
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    /* The members of the packed struct may not be aligned. */
+    float values[12];
+    memcpy(values, &tri, sizeof(values));
+    BLI_endian_switch_float_array(values, 12);
+    memcpy(&tri, values, sizeof(values));
+  }
+}
+
+/**
+ * Read all triangles straight from the memory-mapped file in parallel and weld them by sorting.
+ * \return Null when the file could not be mapped, the caller falls back to buffered reading.
+ */
+static Mesh *read_stl_binary_memory_mapped(FILE *file,
+                                           const uint32_t num_tris,
+                                           Main *bmain,
+                                           char *mesh_name,
+                                           const bool use_custom_normals)
+{
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file));
+  if (mmap_file == nullptr) {
+    return nullptr;
+  }
+  const STLBinaryTriangle *file_tris = reinterpret_cast<const STLBinaryTriangle *>(
+      static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)) + BINARY_HEADER_SIZE +
+      sizeof(uint32_t));
+
+  Array<float3> corner_positions(int64_t(num_tris) * 3);
+  Array<float3> facet_normals(use_custom_normals ? int64_t(num_tris) : 0);
+  threading::parallel_for(IndexRange(num_tris), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      /* The packed triangles are not aligned, copy them before accessing the members. */
+      STLBinaryTriangle tri;
+      memcpy(&tri, &file_tris[i], sizeof(STLBinaryTriangle));
+      stl_binary_triangle_to_host(tri);
+      corner_positions[3 * i] = tri.v1;
+      corner_positions[3 * i + 1] = tri.v2;
+      corner_positions[3 * i + 2] = tri.v3;
+      if (use_custom_normals) {
+        facet_normals[i] = tri.normal;
+      }
+    }
+  });
+  BLI_mmap_free(mmap_file);
+
+  return stl_mesh_from_triangles(bmain, mesh_name, corner_positions, facet_normals);
+}
+
 Mesh *read_stl_binary(FILE *file, Main *bmain, char *mesh_name, bool use_custom_normals)
 {
   const int chunk_size = 1024;
@@ -38,16 +102,25 @@ Mesh *read_stl_binary(FILE *file, Main *bmain, char *mesh_name, bool use_custom_
     stl_import_report_error(file);
     return nullptr;
   }
+  num_tris = stl_binary_tris_num_to_host(num_tris);
 
   if (num_tris == 0) {
     return BKE_mesh_add(bmain, mesh_name);
   }
 
+  /* The file size was already checked to match the triangle count when detecting binary files,
+   * so the whole triangle array can be mapped at once. */
+  if (Mesh *mesh = read_stl_binary_memory_mapped(
+          file, num_tris, bmain, mesh_name, use_custom_normals)) {
+    return mesh;
+  }
+
   Array<STLBinaryTriangle> tris_buf(chunk_size);
   STLMeshHelper stl_mesh(num_tris, use_custom_normals);
   size_t num_read_tris;
   while ((num_read_tris = fread(tris_buf.data(), sizeof(STLBinaryTriangle), chunk_size, file))) {
     for (size_t i = 0; i < num_read_tris; i++) {
+      stl_binary_triangle_to_host(tris_buf[i]);
       if (use_custom_normals) {
         stl_mesh.add_triangle(tris_buf[i].v1, tris_buf[i].v2, tris_buf[i].v3, tris_buf[i].normal);
       }
@@ -26,6 +26,9 @@ namespace blender::io::stl {
 const size_t BINARY_HEADER_SIZE = 80;
 const size_t BINARY_STRIDE = 12 * 4 + 2;
 
+/** Convert the triangle count of a binary file to the byte order of the machine. */
+uint32_t stl_binary_tris_num_to_host(uint32_t tris_num);
+
 Mesh *read_stl_binary(FILE *file, Main *bmain, char *mesh_name, bool use_custom_normals);
 
 }  // namespace blender::io::stl
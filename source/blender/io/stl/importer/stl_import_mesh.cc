@@ -12,6 +12,7 @@
 #include "BLI_array.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
+#include "BLI_sort.hh"
 #include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
@@ -19,6 +20,11 @@
 
 #include "stl_import_mesh.hh"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+
 namespace blender::io::stl {
 
 STLMeshHelper::STLMeshHelper(int tris_num, bool use_custom_normals)
@@ -60,54 +66,195 @@ void STLMeshHelper::add_triangle(const float3 &a,
   }
 }
 
-Mesh *STLMeshHelper::to_mesh(Main *bmain, char *mesh_name)
+static void report_removed_triangles(const int degenerate_tris_num, const int duplicate_tris_num)
 {
-  if (degenerate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << degenerate_tris_num_ << " degenerate triangles were removed"
+  if (degenerate_tris_num > 0) {
+    std::cout << "STL Importer: " << degenerate_tris_num << " degenerate triangles were removed"
               << std::endl;
   }
-  if (duplicate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << duplicate_tris_num_ << " duplicate triangles were removed"
+  if (duplicate_tris_num > 0) {
+    std::cout << "STL Importer: " << duplicate_tris_num << " duplicate triangles were removed"
               << std::endl;
   }
+}
 
+static Mesh *create_mesh(Main *bmain,
+                         char *mesh_name,
+                         const Span<float3> positions,
+                         const Span<Triangle> tris,
+                         const Span<float3> loop_normals,
+                         const bool use_custom_normals)
+{
   Mesh *mesh = BKE_mesh_add(bmain, mesh_name);
   /* User count is already 1 here, but will be set later in #BKE_mesh_assign_object. */
   id_us_min(&mesh->id);
 
-  mesh->totvert = verts_.size();
+  mesh->totvert = positions.size();
   CustomData_add_layer(&mesh->vdata, CD_MVERT, CD_SET_DEFAULT, nullptr, mesh->totvert);
   MutableSpan<MVert> verts = mesh->verts_for_write();
-  for (int i = 0; i < mesh->totvert; i++) {
-    copy_v3_v3(verts[i].co, verts_[i]);
-  }
+  threading::parallel_for(verts.index_range(), 4096, [&](IndexRange verts_range) {
+    for (const int i : verts_range) {
+      copy_v3_v3(verts[i].co, positions[i]);
+    }
+  });
 
-  mesh->totpoly = tris_.size();
-  mesh->totloop = tris_.size() * 3;
+  mesh->totpoly = tris.size();
+  mesh->totloop = tris.size() * 3;
   CustomData_add_layer(&mesh->pdata, CD_MPOLY, CD_SET_DEFAULT, nullptr, mesh->totpoly);
   CustomData_add_layer(&mesh->ldata, CD_MLOOP, CD_SET_DEFAULT, nullptr, mesh->totloop);
   MutableSpan<MPoly> polys = mesh->polys_for_write();
   MutableSpan<MLoop> loops = mesh->loops_for_write();
-  threading::parallel_for(tris_.index_range(), 2048, [&](IndexRange tris_range) {
+  threading::parallel_for(tris.index_range(), 2048, [&](IndexRange tris_range) {
     for (const int i : tris_range) {
       polys[i].loopstart = 3 * i;
       polys[i].totloop = 3;
 
-      loops[3 * i].v = tris_[i].v1;
-      loops[3 * i + 1].v = tris_[i].v2;
-      loops[3 * i + 2].v = tris_[i].v3;
+      loops[3 * i].v = tris[i].v1;
+      loops[3 * i + 1].v = tris[i].v2;
+      loops[3 * i + 2].v = tris[i].v3;
     }
   });
 
   /* NOTE: edges must be calculated first before setting custom normals. */
   BKE_mesh_calc_edges(mesh, false, false);
 
-  if (use_custom_normals_ && loop_normals_.size() == mesh->totloop) {
-    BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(loop_normals_.data()));
+  if (use_custom_normals && loop_normals.size() == mesh->totloop) {
+    BKE_mesh_set_custom_normals(
+        mesh, reinterpret_cast<float(*)[3]>(const_cast<float3 *>(loop_normals.data())));
     mesh->flag |= ME_AUTOSMOOTH;
   }
 
   return mesh;
 }
 
+Mesh *STLMeshHelper::to_mesh(Main *bmain, char *mesh_name)
+{
+  report_removed_triangles(degenerate_tris_num_, duplicate_tris_num_);
+  return create_mesh(
+      bmain, mesh_name, verts_.as_span(), tris_.as_span(), loop_normals_, use_custom_normals_);
+}
+
+/**
+ * Total order on the bit patterns of the positions, so that only exactly equal positions end up
+ * next to each other. Ties are broken by index to keep the first occurrence at the front.
+ */
+static bool corner_position_less(const Span<float3> positions, const int a, const int b)
+{
+  const int cmp = std::memcmp(&positions[a], &positions[b], sizeof(float3));
+  return cmp == 0 ? a < b : cmp < 0;
+}
+
+static bool corner_position_equal(const Span<float3> positions, const int a, const int b)
+{
+  return std::memcmp(&positions[a], &positions[b], sizeof(float3)) == 0;
+}
+
+/** Triangle with sorted vertex indices, equal for all triangles that #Triangle considers equal. */
+static std::array<int, 3> triangle_sorted_verts(const Triangle &tri)
+{
+  std::array<int, 3> verts = {tri.v1, tri.v2, tri.v3};
+  std::sort(verts.begin(), verts.end());
+  return verts;
+}
+
+Mesh *stl_mesh_from_triangles(Main *bmain,
+                              char *mesh_name,
+                              const Span<float3> corner_positions,
+                              const Span<float3> facet_normals)
+{
+  const int corners_num = int(corner_positions.size());
+  const int tris_num = corners_num / 3;
+
+  /* Sort the corners so that equal positions are adjacent, the first corner of every group is
+   * the first occurrence of the position in the file. */
+  Array<int> sorted_corners(corners_num);
+  std::iota(sorted_corners.begin(), sorted_corners.end(), 0);
+  parallel_sort(sorted_corners.begin(), sorted_corners.end(), [&](const int a, const int b) {
+    return corner_position_less(corner_positions, a, b);
+  });
+
+  /* Vertices are numbered in order of their first occurrence, like #VectorSet does. */
+  Array<int> corner_verts(corners_num);
+  int group_first = -1;
+  for (const int i : sorted_corners.index_range()) {
+    const int corner = sorted_corners[i];
+    if (group_first == -1 || !corner_position_equal(corner_positions, group_first, corner)) {
+      group_first = corner;
+    }
+    corner_verts[corner] = group_first;
+  }
+  sorted_corners = {};
+  Vector<float3> positions;
+  for (const int corner : IndexRange(corners_num)) {
+    const int first = corner_verts[corner];
+    if (first == corner) {
+      corner_verts[corner] = int(positions.append_and_get_index(corner_positions[corner]));
+    }
+    else {
+      /* The first occurrence comes before and has its vertex index already. */
+      corner_verts[corner] = corner_verts[first];
+    }
+  }
+
+  Array<Triangle> tris(tris_num);
+  Array<bool> tris_degenerate(tris_num);
+  threading::parallel_for(tris.index_range(), 4096, [&](IndexRange tris_range) {
+    for (const int i : tris_range) {
+      Triangle &tri = tris[i];
+      tri.v1 = corner_verts[3 * i];
+      tri.v2 = corner_verts[3 * i + 1];
+      tri.v3 = corner_verts[3 * i + 2];
+      tris_degenerate[i] = (tri.v1 == tri.v2) || (tri.v1 == tri.v3) || (tri.v2 == tri.v3);
+    }
+  });
+  corner_verts = {};
+
+  /* Find duplicate triangles the same way, keeping the first occurrence. */
+  Vector<int> sorted_tris;
+  sorted_tris.reserve(tris_num);
+  for (const int i : tris.index_range()) {
+    if (!tris_degenerate[i]) {
+      sorted_tris.append(i);
+    }
+  }
+  const int degenerate_tris_num = tris_num - int(sorted_tris.size());
+  parallel_sort(sorted_tris.begin(), sorted_tris.end(), [&](const int a, const int b) {
+    const std::array<int, 3> verts_a = triangle_sorted_verts(tris[a]);
+    const std::array<int, 3> verts_b = triangle_sorted_verts(tris[b]);
+    return verts_a == verts_b ? a < b : verts_a < verts_b;
+  });
+  Array<bool> tris_used(tris_num, false);
+  int duplicate_tris_num = 0;
+  for (const int i : sorted_tris.index_range()) {
+    const int tri = sorted_tris[i];
+    if (i > 0 &&
+        triangle_sorted_verts(tris[sorted_tris[i - 1]]) == triangle_sorted_verts(tris[tri])) {
+      duplicate_tris_num++;
+    }
+    else {
+      tris_used[tri] = true;
+    }
+  }
+  sorted_tris.clear_and_make_inline();
+
+  Vector<Triangle> used_tris;
+  Vector<float3> loop_normals;
+  used_tris.reserve(tris_num - degenerate_tris_num - duplicate_tris_num);
+  if (!facet_normals.is_empty()) {
+    loop_normals.reserve(used_tris.capacity() * 3);
+  }
+  for (const int i : tris.index_range()) {
+    if (tris_used[i]) {
+      used_tris.append(tris[i]);
+      if (!facet_normals.is_empty()) {
+        loop_normals.append_n_times(facet_normals[i], 3);
+      }
+    }
+  }
+
+  report_removed_triangles(degenerate_tris_num, duplicate_tris_num);
+  return create_mesh(
+      bmain, mesh_name, positions, used_tris, loop_normals, !facet_normals.is_empty());
+}
+
 }  // namespace blender::io::stl
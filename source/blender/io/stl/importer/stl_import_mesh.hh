@@ -10,6 +10,7 @@
 
 #include "BLI_math_vec_types.hh"
 #include "BLI_set.hh"
+#include "BLI_span.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
@@ -68,4 +69,17 @@ class STLMeshHelper {
   Mesh *to_mesh(Main *bmain, char *mesh_name);
 };
 
+/**
+ * Create a mesh from all triangles of a file at once, with the same result as adding them to a
+ * #STLMeshHelper one by one. Equal positions are welded by sorting instead of hashing, so that
+ * big files can be processed in parallel.
+ *
+ * \param corner_positions: Three positions per triangle.
+ * \param facet_normals: One normal per triangle, or empty when custom normals are not used.
+ */
+Mesh *stl_mesh_from_triangles(Main *bmain,
+                              char *mesh_name,
+                              Span<float3> corner_positions,
+                              Span<float3> facet_normals);
+
 }  // namespace blender::io::stl
@@ -676,24 +676,22 @@ void USDMaterialReader::load_tex_image(const pxr::UsdShadeShader &usd_shader,
     return;
   }
 
-  /* If this is a UDIM texture, this will store the
-   * UDIM tile indices. */
-  blender::Vector<int> udim_tiles;
-
-  if (is_udim_path(file_path)) {
-    udim_tiles = get_udim_tiles(file_path);
-  }
-
   const char *im_file = file_path.c_str();
-  Image *image = BKE_image_load_exists(bmain_, im_file);
+  bool image_exists = false;
+  Image *image = BKE_image_load_exists_ex(bmain_, im_file, &image_exists);
   if (!image) {
     std::cerr << "WARNING: Couldn't open image file '" << im_file << "' for Texture Image node."
               << std::endl;
     return;
   }
 
-  if (udim_tiles.size() > 0) {
-    add_udim_tiles(image, udim_tiles);
+  /* Textures shared by many materials only need their UDIM tiles to be searched for on disk
+   * once, when the image is created. The pixels are loaded lazily on first use. */
+  if (!image_exists && is_udim_path(file_path)) {
+    const blender::Vector<int> udim_tiles = get_udim_tiles(file_path);
+    if (udim_tiles.size() > 0) {
+      add_udim_tiles(image, udim_tiles);
+    }
   }
 
   tex_image->id = &image->id;
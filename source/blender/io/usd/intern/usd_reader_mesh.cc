@@ -18,6 +18,7 @@
 #include "BLI_math_vec_types.hh"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 
 #include "DNA_customdata_types.h"
 #include "DNA_material_types.h"
@@ -203,14 +204,14 @@ static void *add_customdata_cb(Mesh *mesh, const char *name, const int data_type
   }
 
   loopdata = &mesh->ldata;
-  cd_ptr = CustomData_get_layer_named(loopdata, cd_data_type, name);
+  numloops = mesh->totloop;
+  cd_ptr = CustomData_get_layer_named_for_write(loopdata, cd_data_type, name, numloops);
   if (cd_ptr != nullptr) {
     /* layer already exists, so just return it. */
     return cd_ptr;
   }
 
   /* Create a new layer. */
-  numloops = mesh->totloop;
   cd_ptr = CustomData_add_layer_named(
       loopdata, cd_data_type, CD_SET_DEFAULT, nullptr, numloops, name);
   return cd_ptr;
@@ -324,18 +325,26 @@ void USDMeshReader::read_mpolys(Mesh *mesh)
      * this is encoded in custom loop normals. */
     poly.flag |= ME_SMOOTH;
 
-    if (is_left_handed_) {
-      int loop_end_index = loop_index + (face_size - 1);
-      for (int f = 0; f < face_size; ++f, ++loop_index) {
-        loops[loop_index].v = face_indices_[loop_end_index - f];
+    loop_index += face_size;
+  }
+
+  /* The loop offsets are known now, so the face corners can be filled independently. */
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      if (is_left_handed_) {
+        const int loop_end_index = poly.loopstart + (poly.totloop - 1);
+        for (int f = 0; f < poly.totloop; ++f) {
+          loops[poly.loopstart + f].v = face_indices_[loop_end_index - f];
+        }
       }
-    }
-    else {
-      for (int f = 0; f < face_size; ++f, ++loop_index) {
-        loops[loop_index].v = face_indices_[loop_index];
+      else {
+        for (int f = 0; f < poly.totloop; ++f) {
+          loops[poly.loopstart + f].v = face_indices_[poly.loopstart + f];
+        }
       }
     }
-  }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
 }
@@ -627,24 +636,26 @@ void USDMeshReader::process_normals_face_varying(Mesh *mesh)
       MEM_malloc_arrayN(loop_count, sizeof(float[3]), "USD::FaceNormals"));
 
   const Span<MPoly> polys = mesh->polys();
-  for (const int i : polys.index_range()) {
-    const MPoly &poly = polys[i];
-    for (int j = 0; j < poly.totloop; j++) {
-      int blender_index = poly.loopstart + j;
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      for (int j = 0; j < poly.totloop; j++) {
+        int blender_index = poly.loopstart + j;
 
-      int usd_index = poly.loopstart;
-      if (is_left_handed_) {
-        usd_index += poly.totloop - 1 - j;
-      }
-      else {
-        usd_index += j;
-      }
+        int usd_index = poly.loopstart;
+        if (is_left_handed_) {
+          usd_index += poly.totloop - 1 - j;
+        }
+        else {
+          usd_index += j;
+        }
 
-      lnors[blender_index][0] = normals_[usd_index][0];
-      lnors[blender_index][1] = normals_[usd_index][1];
-      lnors[blender_index][2] = normals_[usd_index][2];
+        lnors[blender_index][0] = normals_[usd_index][0];
+        lnors[blender_index][1] = normals_[usd_index][1];
+        lnors[blender_index][2] = normals_[usd_index][2];
+      }
     }
-  }
+  });
   BKE_mesh_set_custom_normals(mesh, lnors);
 
   MEM_freeN(lnors);
@@ -668,15 +679,17 @@ void USDMeshReader::process_normals_uniform(Mesh *mesh)
       MEM_malloc_arrayN(mesh->totloop, sizeof(float[3]), "USD::FaceNormals"));
 
   const Span<MPoly> polys = mesh->polys();
-  for (const int i : polys.index_range()) {
-    const MPoly &poly = polys[i];
-    for (int j = 0; j < poly.totloop; j++) {
-      int loop_index = poly.loopstart + j;
-      lnors[loop_index][0] = normals_[i][0];
-      lnors[loop_index][1] = normals_[i][1];
-      lnors[loop_index][2] = normals_[i][2];
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      for (int j = 0; j < poly.totloop; j++) {
+        int loop_index = poly.loopstart + j;
+        lnors[loop_index][0] = normals_[i][0];
+        lnors[loop_index][1] = normals_[i][1];
+        lnors[loop_index][2] = normals_[i][2];
+      }
     }
-  }
+  });
 
   mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals(mesh, lnors);
@@ -695,12 +708,14 @@ void USDMeshReader::read_mesh_sample(ImportSettings *settings,
 
   if (new_mesh || (settings->read_flag & MOD_MESHSEQ_READ_VERT) != 0) {
     MutableSpan<MVert> verts = mesh->verts_for_write();
-    for (int i = 0; i < positions_.size(); i++) {
-      MVert &mvert = verts[i];
-      mvert.co[0] = positions_[i][0];
-      mvert.co[1] = positions_[i][1];
-      mvert.co[2] = positions_[i][2];
-    }
+    threading::parallel_for(IndexRange(positions_.size()), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        MVert &mvert = verts[i];
+        mvert.co[0] = positions_[i][0];
+        mvert.co[1] = positions_[i][1];
+        mvert.co[2] = positions_[i][2];
+      }
+    });
 
     read_vertex_creases(mesh, motionSampleTime);
   }
@@ -7,8 +7,10 @@
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_attribute.hh"
@@ -103,6 +105,8 @@ struct USDMeshData {
   pxr::VtFloatArray corner_sharpnesses;
 };
 
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data);
+
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -123,10 +127,13 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
         primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
     MLoopUV *mloopuv = static_cast<MLoopUV *>(layer->data);
-    pxr::VtArray<pxr::GfVec2f> uv_coords;
-    for (int loop_idx = 0; loop_idx < mesh->totloop; loop_idx++) {
-      uv_coords.push_back(pxr::GfVec2f(mloopuv[loop_idx].uv));
-    }
+    pxr::VtArray<pxr::GfVec2f> uv_coords(mesh->totloop);
+    pxr::GfVec2f *uv_coords_data = uv_coords.data();
+    threading::parallel_for(IndexRange(mesh->totloop), 4096, [&](const IndexRange range) {
+      for (const int loop_idx : range) {
+        uv_coords_data[loop_idx] = pxr::GfVec2f(mloopuv[loop_idx].uv);
+      }
+    });
 
     if (!uv_coords_primvar.HasValue()) {
       uv_coords_primvar.Set(uv_coords, pxr::UsdTimeCode::Default());
@@ -147,7 +154,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_visibility(context, timecode, usd_mesh);
 
   USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
 
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
@@ -159,12 +165,16 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
      * out of its own sub-tree. It does work when we override the material with exactly the same
      * path, though. */
     if (usd_export_context_.export_params.export_materials) {
+      /* The geometry itself comes from the reference, only the face groups are needed. */
+      get_face_groups(mesh, usd_mesh_data);
       assign_materials(context, usd_mesh, usd_mesh_data.face_groups);
     }
 
     return;
   }
 
+  get_geometry_data(mesh, usd_mesh_data);
+
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
                                                                                   true);
@@ -244,15 +254,35 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
-
   const Span<MVert> verts = mesh->verts();
-  for (const int i : verts.index_range()) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
+  usd_mesh_data.points.resize(verts.size());
+
+  pxr::GfVec3f *points = usd_mesh_data.points.data();
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      points[i] = pxr::GfVec3f(verts[i].co);
+    }
+  });
+}
+
+/**
+ * Offsets of the corners of every polygon in the face-varying arrays, which are written polygon
+ * after polygon, independent of the order of the loops in the mesh. The last offset is the total
+ * number of corners.
+ */
+static Array<int> get_poly_offsets(const Span<MPoly> polys)
+{
+  Array<int> offsets(polys.size() + 1);
+  int offset = 0;
+  for (const int i : polys.index_range()) {
+    offsets[i] = offset;
+    offset += polys[i].totloop;
   }
+  offsets.last() = offset;
+  return offsets;
 }
 
-static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
    * assignments. */
@@ -265,20 +295,31 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
       usd_mesh_data.face_groups[indices_span[i]].push_back(i);
     }
   }
+}
 
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
+static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  get_face_groups(mesh, usd_mesh_data);
 
   const Span<MPoly> polys = mesh->polys();
   const Span<MLoop> loops = mesh->loops();
+  const Array<int> offsets = get_poly_offsets(polys);
 
-  for (const int i : polys.index_range()) {
-    const MPoly &poly = polys[i];
-    usd_mesh_data.face_vertex_counts.push_back(poly.totloop);
-    for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-      usd_mesh_data.face_indices.push_back(loop.v);
+  usd_mesh_data.face_vertex_counts.resize(polys.size());
+  usd_mesh_data.face_indices.resize(offsets.last());
+
+  int *face_vertex_counts = usd_mesh_data.face_vertex_counts.data();
+  int *face_indices = usd_mesh_data.face_indices.data();
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      face_vertex_counts[i] = poly.totloop;
+      int *poly_indices = &face_indices[offsets[i]];
+      for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+        *poly_indices++ = loop.v;
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -395,40 +436,50 @@ void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
 void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
-  const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
+  const float(*lnors)[3] = static_cast<const float(*)[3]>(
+      CustomData_get_layer(&mesh->ldata, CD_NORMAL));
   const Span<MPoly> polys = mesh->polys();
   const Span<MLoop> loops = mesh->loops();
 
   pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
 
   if (lnors != nullptr) {
     /* Export custom loop normals. */
-    for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
-    }
+    loop_normals.resize(mesh->totloop);
+    pxr::GfVec3f *loop_normals_data = loop_normals.data();
+    threading::parallel_for(IndexRange(mesh->totloop), 4096, [&](const IndexRange range) {
+      for (const int loop_idx : range) {
+        loop_normals_data[loop_idx] = pxr::GfVec3f(lnors[loop_idx]);
+      }
+    });
   }
   else {
     /* Compute the loop normals based on the 'smooth' flag. */
     const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
     const float(*face_normals)[3] = BKE_mesh_poly_normals_ensure(mesh);
-    for (const int i : polys.index_range()) {
-      const MPoly &poly = polys[i];
-
-      if ((poly.flag & ME_SMOOTH) == 0) {
-        /* Flat shaded, use common normal for all verts. */
-        pxr::GfVec3f pxr_normal(face_normals[i]);
-        for (int loop_idx = 0; loop_idx < poly.totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
+    const Array<int> offsets = get_poly_offsets(polys);
+    loop_normals.resize(offsets.last());
+    pxr::GfVec3f *loop_normals_data = loop_normals.data();
+    threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        const MPoly &poly = polys[i];
+        pxr::GfVec3f *poly_normals = &loop_normals_data[offsets[i]];
+
+        if ((poly.flag & ME_SMOOTH) == 0) {
+          /* Flat shaded, use common normal for all verts. */
+          pxr::GfVec3f pxr_normal(face_normals[i]);
+          for (int loop_idx = 0; loop_idx < poly.totloop; ++loop_idx) {
+            *poly_normals++ = pxr_normal;
+          }
         }
-      }
-      else {
-        /* Smooth shaded, use individual vert normals. */
-        for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-          loop_normals.push_back(pxr::GfVec3f(vert_normals[loop.v]));
+        else {
+          /* Smooth shaded, use individual vert normals. */
+          for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+            *poly_normals++ = pxr::GfVec3f(vert_normals[loop.v]);
+          }
         }
       }
-    }
+    });
   }
 
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
@@ -453,12 +504,13 @@ void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh, pxr::UsdGeom
   const float(*velocities)[3] = reinterpret_cast<float(*)[3]>(velocity_layer->data);
 
   /* Export per-vertex velocity vectors. */
-  pxr::VtVec3fArray usd_velocities;
-  usd_velocities.reserve(mesh->totvert);
-
-  for (int vertex_idx = 0, totvert = mesh->totvert; vertex_idx < totvert; ++vertex_idx) {
-    usd_velocities.push_back(pxr::GfVec3f(velocities[vertex_idx]));
-  }
+  pxr::VtVec3fArray usd_velocities(mesh->totvert);
+  pxr::GfVec3f *usd_velocities_data = usd_velocities.data();
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](const IndexRange range) {
+    for (const int vertex_idx : range) {
+      usd_velocities_data[vertex_idx] = pxr::GfVec3f(velocities[vertex_idx]);
+    }
+  });
 
   pxr::UsdTimeCode timecode = get_export_time_code();
   usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
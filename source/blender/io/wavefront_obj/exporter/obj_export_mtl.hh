@@ -41,6 +41,9 @@ struct MTLTexMap {
   int projection_type = SHD_PROJ_FLAT;
   std::string image_path;
   std::string mtl_dir_path;
+  /* Importer only: first existing file among the candidate paths of the image, empty when no
+   * file exists. Set by #resolve_texture_image_paths. */
+  std::string resolved_image_path;
 };
 
 /**
@@ -7,7 +7,9 @@
 #include "BLI_map.hh"
 #include "BLI_math_color.h"
 #include "BLI_math_vector.h"
+#include "BLI_mmap.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "obj_export_mtl.hh"
@@ -16,6 +18,13 @@
 
 #include <algorithm>
 #include <charconv>
+#include <fcntl.h>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
 
 namespace blender::io::obj {
 
@@ -64,11 +73,13 @@ static Geometry *create_geometry(Geometry *const prev_geometry,
   return new_geometry();
 }
 
-static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+/**
+ * Parse a vertex position, and its color for the `xyzrgb` vertex color extension.
+ * Returns whether the vertex has a color.
+ */
+static bool parse_vertex(const char *p, const char *end, float3 &r_vert, float3 &r_color)
 {
-  float3 vert;
-  p = parse_floats(p, end, 0.0f, vert, 3);
-  r_global_vertices.vertices.append(vert);
+  p = parse_floats(p, end, 0.0f, r_vert, 3);
   /* OBJ extension: `xyzrgb` vertex colors, when the vertex position
    * is followed by 3 more RGB color components. See
    * http://paulbourke.net/dataformats/obj/colour.html */
@@ -76,21 +87,37 @@ static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_gl
     float3 srgb;
     p = parse_floats(p, end, -1.0f, srgb, 3);
     if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
-      float3 linear;
-      srgb_to_linearrgb_v3_v3(linear, srgb);
-
-      auto &blocks = r_global_vertices.vertex_colors;
-      /* If we don't have vertex colors yet, or the previous vertex
-       * was without color, we need to start a new vertex colors block. */
-      if (blocks.is_empty() || (blocks.last().start_vertex_index + blocks.last().colors.size() !=
-                                r_global_vertices.vertices.size() - 1)) {
-        GlobalVertices::VertexColorsBlock block;
-        block.start_vertex_index = r_global_vertices.vertices.size() - 1;
-        blocks.append(block);
-      }
-      blocks.last().colors.append(linear);
+      srgb_to_linearrgb_v3_v3(r_color, srgb);
+      return true;
     }
   }
+  return false;
+}
+
+static void geom_add_vertex_color(const int vertex_index,
+                                  const float3 &color,
+                                  GlobalVertices &r_global_vertices)
+{
+  auto &blocks = r_global_vertices.vertex_colors;
+  /* If we don't have vertex colors yet, or the previous vertex
+   * was without color, we need to start a new vertex colors block. */
+  if (blocks.is_empty() ||
+      (blocks.last().start_vertex_index + blocks.last().colors.size() != vertex_index)) {
+    GlobalVertices::VertexColorsBlock block;
+    block.start_vertex_index = vertex_index;
+    blocks.append(block);
+  }
+  blocks.last().colors.append(color);
+}
+
+static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+{
+  float3 vert, color;
+  const bool has_color = parse_vertex(p, end, vert, color);
+  r_global_vertices.vertices.append(vert);
+  if (has_color) {
+    geom_add_vertex_color(r_global_vertices.vertices.size() - 1, color, r_global_vertices);
+  }
 }
 
 static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices &r_global_vertices)
@@ -169,47 +196,75 @@ static void geom_add_edge(Geometry *geom,
   geom->track_vertex_index(edge_v2);
 }
 
-static void geom_add_polygon(Geometry *geom,
-                             const char *p,
-                             const char *end,
-                             const GlobalVertices &global_vertices,
-                             const int material_index,
-                             const int group_index,
-                             const bool shaded_smooth)
+/**
+ * Parse face corners as they are spelled out in the file, without resolving relative
+ * indices or checking them against the amount of vertex data. Parsing stops after the
+ * first corner without a valid vertex index. Absent UV and normal indices are `INT32_MAX`.
+ */
+static void parse_polygon_corners(const char *p, const char *end, Vector<PolyCorner> &r_corners)
 {
-  PolyElem curr_face;
-  curr_face.shaded_smooth = shaded_smooth;
-  curr_face.material_index = material_index;
-  if (group_index >= 0) {
-    curr_face.vertex_group_index = group_index;
-    geom->has_vertex_groups_ = true;
-  }
-
-  const int orig_corners_size = geom->face_corners_.size();
-  curr_face.start_index_ = orig_corners_size;
-
-  bool face_valid = true;
   p = drop_whitespace(p, end);
-  while (p < end && face_valid) {
+  while (p < end) {
     PolyCorner corner;
-    bool got_uv = false, got_normal = false;
+    corner.uv_vert_index = INT32_MAX;
+    corner.vertex_normal_index = INT32_MAX;
     /* Parse vertex index. */
     p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
-    face_valid &= corner.vert_index != INT32_MAX;
     if (p < end && *p == '/') {
       /* Parse UV index. */
       ++p;
       if (p < end && *p != '/') {
         p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
-        got_uv = corner.uv_vert_index != INT32_MAX;
       }
       /* Parse normal index. */
       if (p < end && *p == '/') {
         ++p;
         p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
-        got_normal = corner.vertex_normal_index != INT32_MAX;
       }
     }
+    r_corners.append(corner);
+    if (corner.vert_index == INT32_MAX) {
+      break;
+    }
+
+    /* Skip whitespace to get to the next face corner. */
+    p = drop_whitespace(p, end);
+  }
+}
+
+/**
+ * Turn the parsed face corners at the end of the geometry's corner list (starting at
+ * `corners_start`) into a face. Relative indices are resolved against the vertex data
+ * read so far; faces with invalid indices are dropped again.
+ */
+static void geom_add_polygon_corners(Geometry *geom,
+                                     const int corners_start,
+                                     const GlobalVertices &global_vertices,
+                                     const int material_index,
+                                     const int group_index,
+                                     const bool shaded_smooth)
+{
+  PolyElem curr_face;
+  curr_face.shaded_smooth = shaded_smooth;
+  curr_face.material_index = material_index;
+  if (group_index >= 0) {
+    curr_face.vertex_group_index = group_index;
+    geom->has_vertex_groups_ = true;
+  }
+  curr_face.start_index_ = corners_start;
+
+  bool face_valid = true;
+  MutableSpan<PolyCorner> corners = geom->face_corners_.as_mutable_span().drop_front(
+      corners_start);
+  for (PolyCorner &corner : corners) {
+    const bool got_uv = corner.uv_vert_index != INT32_MAX;
+    const bool got_normal = corner.vertex_normal_index != INT32_MAX;
+    if (!got_uv) {
+      corner.uv_vert_index = -1;
+    }
+    if (!got_normal) {
+      corner.vertex_normal_index = -1;
+    }
     /* Always keep stored indices non-negative and zero-based. */
     corner.vert_index += corner.vert_index < 0 ? global_vertices.vertices.size() : -1;
     if (corner.vert_index < 0 || corner.vert_index >= global_vertices.vertices.size()) {
@@ -248,11 +303,10 @@ static void geom_add_polygon(Geometry *geom,
         face_valid = false;
       }
     }
-    geom->face_corners_.append(corner);
     curr_face.corner_count_++;
-
-    /* Skip whitespace to get to the next face corner. */
-    p = drop_whitespace(p, end);
+    if (!face_valid) {
+      break;
+    }
   }
 
   if (face_valid) {
@@ -261,11 +315,25 @@ static void geom_add_polygon(Geometry *geom,
   }
   else {
     /* Remove just-added corners for the invalid face. */
-    geom->face_corners_.resize(orig_corners_size);
+    geom->face_corners_.resize(corners_start);
     geom->has_invalid_polys_ = true;
   }
 }
 
+static void geom_add_polygon(Geometry *geom,
+                             const char *p,
+                             const char *end,
+                             const GlobalVertices &global_vertices,
+                             const int material_index,
+                             const int group_index,
+                             const bool shaded_smooth)
+{
+  const int corners_start = geom->face_corners_.size();
+  parse_polygon_corners(p, end, geom->face_corners_);
+  geom_add_polygon_corners(
+      geom, corners_start, global_vertices, material_index, group_index, shaded_smooth);
+}
+
 static Geometry *geom_set_curve_type(Geometry *geom,
                                      const char *p,
                                      const char *end,
@@ -412,28 +480,135 @@ static void use_all_vertices_if_no_faces(Geometry *geom,
   }
 }
 
-void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
-                      GlobalVertices &r_global_vertices)
+/**
+ * Parser state that carries over from one line to the next: once set,
+ * it remains the same for the remaining elements in the object.
+ */
+struct ParserState {
+  Geometry *curr_geom = nullptr;
+  bool shaded_smooth = false;
+  string group_name;
+  int group_index = -1;
+  string material_name;
+  int material_index = -1;
+};
+
+/* If we don't have a material index assigned yet, get one.
+ * It means "usemtl" state came from the previous object. */
+static void ensure_face_material_index(ParserState &state)
 {
-  if (!obj_file_) {
-    return;
+  if (state.material_index == -1 && !state.material_name.empty() &&
+      state.curr_geom->material_indices_.is_empty()) {
+    state.curr_geom->material_indices_.add_new(state.material_name, 0);
+    state.curr_geom->material_order_.append(state.material_name);
+    state.material_index = 0;
   }
+}
 
-  /* Use the filename as the default name given to the initial object. */
-  char ob_name[FILE_MAXFILE];
-  BLI_strncpy(ob_name, BLI_path_basename(import_params_.filepath), FILE_MAXFILE);
-  BLI_path_extension_replace(ob_name, FILE_MAXFILE, "");
-
-  Geometry *curr_geom = create_geometry(nullptr, GEOM_MESH, ob_name, r_all_geometries);
-
-  /* State variables: once set, they remain the same for the remaining
-   * elements in the object. */
-  bool state_shaded_smooth = false;
-  string state_group_name;
-  int state_group_index = -1;
-  string state_material_name;
-  int state_material_index = -1;
+void OBJParser::parse_line(const char *p,
+                           const char *end,
+                           ParserState &state,
+                           Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                           GlobalVertices &r_global_vertices)
+{
+  /* Most common things that start with 'v': vertices, normals, UVs. */
+  if (*p == 'v') {
+    if (parse_keyword(p, end, "v")) {
+      geom_add_vertex(p, end, r_global_vertices);
+    }
+    else if (parse_keyword(p, end, "vn")) {
+      geom_add_vertex_normal(p, end, r_global_vertices);
+    }
+    else if (parse_keyword(p, end, "vt")) {
+      geom_add_uv_vertex(p, end, r_global_vertices);
+    }
+  }
+  /* Faces. */
+  else if (parse_keyword(p, end, "f")) {
+    ensure_face_material_index(state);
+    geom_add_polygon(state.curr_geom,
+                     p,
+                     end,
+                     r_global_vertices,
+                     state.material_index,
+                     state.group_index,
+                     state.shaded_smooth);
+  }
+  /* Faces. */
+  else if (parse_keyword(p, end, "l")) {
+    geom_add_edge(state.curr_geom, p, end, r_global_vertices);
+  }
+  /* Objects. */
+  else if (parse_keyword(p, end, "o")) {
+    state.shaded_smooth = false;
+    state.group_name = "";
+    /* Reset object-local material index that's used in face infos.
+     * NOTE: do not reset the material name; that has to carry over
+     * into the next object if needed. */
+    state.material_index = -1;
+    state.curr_geom = create_geometry(
+        state.curr_geom, GEOM_MESH, StringRef(p, end).trim(), r_all_geometries);
+  }
+  /* Groups. */
+  else if (parse_keyword(p, end, "g")) {
+    geom_update_group(StringRef(p, end).trim(), state.group_name);
+    int new_index = state.curr_geom->group_indices_.size();
+    state.group_index = state.curr_geom->group_indices_.lookup_or_add(state.group_name,
+                                                                      new_index);
+    if (new_index == state.group_index) {
+      state.curr_geom->group_order_.append(state.group_name);
+    }
+  }
+  /* Smoothing groups. */
+  else if (parse_keyword(p, end, "s")) {
+    geom_update_smooth_group(p, end, state.shaded_smooth);
+  }
+  /* Materials and their libraries. */
+  else if (parse_keyword(p, end, "usemtl")) {
+    state.material_name = StringRef(p, end).trim();
+    int new_mat_index = state.curr_geom->material_indices_.size();
+    state.material_index = state.curr_geom->material_indices_.lookup_or_add(state.material_name,
+                                                                            new_mat_index);
+    if (new_mat_index == state.material_index) {
+      state.curr_geom->material_order_.append(state.material_name);
+    }
+  }
+  else if (parse_keyword(p, end, "mtllib")) {
+    add_mtl_library(StringRef(p, end).trim());
+  }
+  else if (parse_keyword(p, end, "#MRGB")) {
+    geom_add_mrgb_colors(p, end, r_global_vertices);
+  }
+  /* Comments. */
+  else if (*p == '#') {
+    /* Nothing to do. */
+  }
+  /* Curve related things. */
+  else if (parse_keyword(p, end, "cstype")) {
+    state.curr_geom = geom_set_curve_type(
+        state.curr_geom, p, end, state.group_name, r_all_geometries);
+  }
+  else if (parse_keyword(p, end, "deg")) {
+    geom_set_curve_degree(state.curr_geom, p, end);
+  }
+  else if (parse_keyword(p, end, "curv")) {
+    geom_add_curve_vertex_indices(state.curr_geom, p, end, r_global_vertices);
+  }
+  else if (parse_keyword(p, end, "parm")) {
+    geom_add_curve_parameters(state.curr_geom, p, end);
+  }
+  else if (StringRef(p, end).startswith("end")) {
+    /* End of curve definition, nothing else to do. */
+  }
+  else {
+    std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'" << std::endl;
+  }
+}
 
+void OBJParser::parse_buffered(ParserState &state,
+                               Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                               GlobalVertices &r_global_vertices)
+{
   /* Read the input file in chunks. We need up to twice the possible chunk size,
    * to possibly store remainder of the previous input line that got broken mid-chunk. */
   Array<char> buffer(read_buffer_size_ * 2);
@@ -494,114 +669,265 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
       if (p == end) {
         continue;
       }
-      /* Most common things that start with 'v': vertices, normals, UVs. */
-      if (*p == 'v') {
-        if (parse_keyword(p, end, "v")) {
-          geom_add_vertex(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vn")) {
-          geom_add_vertex_normal(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vt")) {
-          geom_add_uv_vertex(p, end, r_global_vertices);
-        }
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "f")) {
-        /* If we don't have a material index assigned yet, get one.
-         * It means "usemtl" state came from the previous object. */
-        if (state_material_index == -1 && !state_material_name.empty() &&
-            curr_geom->material_indices_.is_empty()) {
-          curr_geom->material_indices_.add_new(state_material_name, 0);
-          curr_geom->material_order_.append(state_material_name);
-          state_material_index = 0;
-        }
+      parse_line(p, end, state, r_all_geometries, r_global_vertices);
+    }
 
-        geom_add_polygon(curr_geom,
-                         p,
-                         end,
-                         r_global_vertices,
-                         state_material_index,
-                         state_group_index,
-                         state_shaded_smooth);
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "l")) {
-        geom_add_edge(curr_geom, p, end, r_global_vertices);
-      }
-      /* Objects. */
-      else if (parse_keyword(p, end, "o")) {
-        state_shaded_smooth = false;
-        state_group_name = "";
-        /* Reset object-local material index that's used in face infos.
-         * NOTE: do not reset the material name; that has to carry over
-         * into the next object if needed. */
-        state_material_index = -1;
-        curr_geom = create_geometry(
-            curr_geom, GEOM_MESH, StringRef(p, end).trim(), r_all_geometries);
-      }
-      /* Groups. */
-      else if (parse_keyword(p, end, "g")) {
-        geom_update_group(StringRef(p, end).trim(), state_group_name);
-        int new_index = curr_geom->group_indices_.size();
-        state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name, new_index);
-        if (new_index == state_group_index) {
-          curr_geom->group_order_.append(state_group_name);
-        }
-      }
-      /* Smoothing groups. */
-      else if (parse_keyword(p, end, "s")) {
-        geom_update_smooth_group(p, end, state_shaded_smooth);
-      }
-      /* Materials and their libraries. */
-      else if (parse_keyword(p, end, "usemtl")) {
-        state_material_name = StringRef(p, end).trim();
-        int new_mat_index = curr_geom->material_indices_.size();
-        state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
-                                                                          new_mat_index);
-        if (new_mat_index == state_material_index) {
-          curr_geom->material_order_.append(state_material_name);
-        }
-      }
-      else if (parse_keyword(p, end, "mtllib")) {
-        add_mtl_library(StringRef(p, end).trim());
+    /* We might have a line that was cut in the middle by the previous buffer;
+     * copy it over for next chunk reading. */
+    size_t left_size = buffer_end - last_nl;
+    memmove(buffer.data(), buffer.data() + last_nl, left_size);
+    buffer_offset = left_size;
+  }
+}
+
+/**
+ * Result of parsing one chunk of a memory-mapped OBJ file. Vertex data and face corners
+ * are parsed into chunk-local arrays; everything else changes the parser state (current
+ * object, group, material...) and is kept as a line reference to be interpreted once all
+ * chunks are parsed, in file order.
+ */
+struct ObjChunk {
+  struct Element {
+    /* Amount of chunk-local vertex data that precedes this element in the file. */
+    int vertices_num;
+    int uv_vertices_num;
+    int vertex_normals_num;
+    /* A run of consecutive faces (indices into #face_sizes),
+     * or a line for #OBJParser::parse_line when empty. */
+    IndexRange faces;
+    StringRef line;
+  };
+
+  GlobalVertices vertices;
+  /* Colors of `xyzrgb` vertices, with chunk-local vertex indices. They are added to the
+   * vertex color blocks in file order, since blocks can continue across chunks. */
+  Vector<std::pair<int, float3>> vertex_colors;
+  /* Face corners with indices as spelled out in the file. */
+  Vector<PolyCorner> face_corners;
+  Vector<int> face_sizes;
+  Vector<Element> elements;
+  /* Copy of the chunk text when line continuations had to be fixed up,
+   * since the memory-mapped file itself is read-only. */
+  Array<char> fixed_up_text;
+};
+
+/* Whether the line ending at the newline character `nl` continues on the next line. */
+static bool line_continues(const char *start, const char *nl)
+{
+  const char *p = nl;
+  while (p > start && p[-1] <= ' ' && p[-1] != '\n') {
+    --p;
+  }
+  return p > start && p[-1] == '\\';
+}
+
+/**
+ * Split the file contents into chunks of about `chunk_size` bytes, each ending at a line
+ * boundary. Lines with continuations are never split between chunks.
+ */
+static Vector<StringRef> split_into_chunks(StringRef text, const int64_t chunk_size)
+{
+  Vector<StringRef> chunks;
+  while (!text.is_empty()) {
+    int64_t chunk_len = text.size();
+    const char *p = text.begin() + std::min(chunk_size, text.size());
+    while (p < text.end()) {
+      const char *nl = static_cast<const char *>(memchr(p, '\n', text.end() - p));
+      if (nl == nullptr) {
+        break;
       }
-      else if (parse_keyword(p, end, "#MRGB")) {
-        geom_add_mrgb_colors(p, end, r_global_vertices);
+      if (!line_continues(text.begin(), nl)) {
+        chunk_len = nl + 1 - text.begin();
+        break;
       }
-      /* Comments. */
-      else if (*p == '#') {
-        /* Nothing to do. */
+      p = nl + 1;
+    }
+    chunks.append(text.substr(0, chunk_len));
+    text = text.drop_prefix(chunk_len);
+  }
+  return chunks;
+}
+
+static void parse_chunk(StringRef text, ObjChunk &r_chunk)
+{
+  if (memchr(text.data(), '\\', text.size())) {
+    r_chunk.fixed_up_text.reinitialize(text.size());
+    memcpy(r_chunk.fixed_up_text.data(), text.data(), size_t(text.size()));
+    fixup_line_continuations(r_chunk.fixed_up_text.begin(), r_chunk.fixed_up_text.end());
+    text = StringRef(r_chunk.fixed_up_text.data(), r_chunk.fixed_up_text.size());
+  }
+
+  GlobalVertices &vertices = r_chunk.vertices;
+  auto add_element = [&]() -> ObjChunk::Element & {
+    r_chunk.elements.append_as();
+    ObjChunk::Element &element = r_chunk.elements.last();
+    element.vertices_num = vertices.vertices.size();
+    element.uv_vertices_num = vertices.uv_vertices.size();
+    element.vertex_normals_num = vertices.vertex_normals.size();
+    return element;
+  };
+
+  while (!text.is_empty()) {
+    StringRef line = read_next_line(text);
+    const char *p = line.begin(), *end = line.end();
+    p = drop_whitespace(p, end);
+    if (p == end) {
+      continue;
+    }
+    if (*p == 'v') {
+      if (parse_keyword(p, end, "v")) {
+        float3 vert, color;
+        if (parse_vertex(p, end, vert, color)) {
+          r_chunk.vertex_colors.append({int(vertices.vertices.size()), color});
+        }
+        vertices.vertices.append(vert);
       }
-      /* Curve related things. */
-      else if (parse_keyword(p, end, "cstype")) {
-        curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
+      else if (parse_keyword(p, end, "vn")) {
+        geom_add_vertex_normal(p, end, vertices);
       }
-      else if (parse_keyword(p, end, "deg")) {
-        geom_set_curve_degree(curr_geom, p, end);
+      else if (parse_keyword(p, end, "vt")) {
+        geom_add_uv_vertex(p, end, vertices);
       }
-      else if (parse_keyword(p, end, "curv")) {
-        geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
+    }
+    else if (parse_keyword(p, end, "f")) {
+      /* Extend the previous run of faces when no vertex data or other lines are in between. */
+      const ObjChunk::Element *prev = r_chunk.elements.is_empty() ? nullptr :
+                                                                    &r_chunk.elements.last();
+      const bool extend_run = prev && !prev->faces.is_empty() &&
+                              prev->vertices_num == vertices.vertices.size() &&
+                              prev->uv_vertices_num == vertices.uv_vertices.size() &&
+                              prev->vertex_normals_num == vertices.vertex_normals.size();
+      ObjChunk::Element &element = extend_run ? r_chunk.elements.last() : add_element();
+      if (!extend_run) {
+        element.faces = IndexRange(r_chunk.face_sizes.size(), 0);
       }
-      else if (parse_keyword(p, end, "parm")) {
-        geom_add_curve_parameters(curr_geom, p, end);
+      element.faces = IndexRange(element.faces.start(), element.faces.size() + 1);
+
+      const int corners_start = r_chunk.face_corners.size();
+      parse_polygon_corners(p, end, r_chunk.face_corners);
+      r_chunk.face_sizes.append(r_chunk.face_corners.size() - corners_start);
+    }
+    /* Comments, except for the MRGB color extension. */
+    else if (*p == '#' && !StringRef(p, end).startswith("#MRGB")) {
+      /* Nothing to do. */
+    }
+    else {
+      add_element().line = StringRef(p, end);
+    }
+  }
+}
+
+bool OBJParser::parse_memory_mapped(ParserState &state,
+                                    Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                                    GlobalVertices &r_global_vertices)
+{
+  const int file = BLI_open(import_params_.filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    return false;
+  }
+  const size_t file_size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = file_size > 0 ? BLI_mmap_open(file) : nullptr;
+  close(file);
+  if (mmap_file == nullptr) {
+    return false;
+  }
+
+  const StringRef text(static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)),
+                       int64_t(file_size));
+  const Vector<StringRef> chunk_texts = split_into_chunks(text, int64_t(read_buffer_size_));
+  Array<ObjChunk> chunks(chunk_texts.size());
+  threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      parse_chunk(chunk_texts[i], chunks[i]);
+    }
+  });
+
+  /* Interpret the chunks in file order. Vertex data of a chunk is appended up to the position
+   * of each line, so that relative indices and validation see the same vertex counts as when
+   * parsing the whole file sequentially. */
+  for (ObjChunk &chunk : chunks) {
+    const GlobalVertices &vertices = chunk.vertices;
+    const int vertex_offset = r_global_vertices.vertices.size();
+    int vertices_done = 0, uv_vertices_done = 0, vertex_normals_done = 0, colors_done = 0;
+    auto append_vertex_data = [&](const int vertices_num,
+                                  const int uv_vertices_num,
+                                  const int vertex_normals_num) {
+      r_global_vertices.vertices.extend(
+          vertices.vertices.as_span().slice(vertices_done, vertices_num - vertices_done));
+      for (; colors_done < chunk.vertex_colors.size(); colors_done++) {
+        const std::pair<int, float3> &vertex_color = chunk.vertex_colors[colors_done];
+        if (vertex_color.first >= vertices_num) {
+          break;
+        }
+        geom_add_vertex_color(
+            vertex_offset + vertex_color.first, vertex_color.second, r_global_vertices);
       }
-      else if (StringRef(p, end).startswith("end")) {
-        /* End of curve definition, nothing else to do. */
+      r_global_vertices.uv_vertices.extend(vertices.uv_vertices.as_span().slice(
+          uv_vertices_done, uv_vertices_num - uv_vertices_done));
+      r_global_vertices.vertex_normals.extend(vertices.vertex_normals.as_span().slice(
+          vertex_normals_done, vertex_normals_num - vertex_normals_done));
+      vertices_done = vertices_num;
+      uv_vertices_done = uv_vertices_num;
+      vertex_normals_done = vertex_normals_num;
+    };
+
+    int corner_index = 0;
+    for (const ObjChunk::Element &element : chunk.elements) {
+      append_vertex_data(
+          element.vertices_num, element.uv_vertices_num, element.vertex_normals_num);
+      if (element.faces.is_empty()) {
+        parse_line(
+            element.line.begin(), element.line.end(), state, r_all_geometries, r_global_vertices);
+        continue;
       }
-      else {
-        std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'" << std::endl;
+      ensure_face_material_index(state);
+      for (const int64_t face : element.faces) {
+        const int face_size = chunk.face_sizes[face];
+        const int corners_start = state.curr_geom->face_corners_.size();
+        state.curr_geom->face_corners_.extend(
+            chunk.face_corners.as_span().slice(corner_index, face_size));
+        corner_index += face_size;
+        geom_add_polygon_corners(state.curr_geom,
+                                 corners_start,
+                                 r_global_vertices,
+                                 state.material_index,
+                                 state.group_index,
+                                 state.shaded_smooth);
       }
     }
+    append_vertex_data(
+        vertices.vertices.size(), vertices.uv_vertices.size(), vertices.vertex_normals.size());
 
-    /* We might have a line that was cut in the middle by the previous buffer;
-     * copy it over for next chunk reading. */
-    size_t left_size = buffer_end - last_nl;
-    memmove(buffer.data(), buffer.data() + last_nl, left_size);
-    buffer_offset = left_size;
+    /* Free chunk data as soon as it has been merged. */
+    chunk = ObjChunk();
+  }
+
+  BLI_mmap_free(mmap_file);
+  return true;
+}
+
+void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                      GlobalVertices &r_global_vertices)
+{
+  if (!obj_file_) {
+    return;
+  }
+
+  /* Use the filename as the default name given to the initial object. */
+  char ob_name[FILE_MAXFILE];
+  BLI_strncpy(ob_name, BLI_path_basename(import_params_.filepath), FILE_MAXFILE);
+  BLI_path_extension_replace(ob_name, FILE_MAXFILE, "");
+
+  ParserState state;
+  state.curr_geom = create_geometry(nullptr, GEOM_MESH, ob_name, r_all_geometries);
+
+  /* Memory-mapped files are parsed in parallel; fall back to reading the file
+   * in buffered blocks when the file can't be mapped. */
+  if (!parse_memory_mapped(state, r_all_geometries, r_global_vertices)) {
+    parse_buffered(state, r_all_geometries, r_global_vertices);
   }
 
-  use_all_vertices_if_no_faces(curr_geom, r_all_geometries, r_global_vertices);
+  use_all_vertices_if_no_faces(state.curr_geom, r_all_geometries, r_global_vertices);
   add_default_mtl_library();
 }
 
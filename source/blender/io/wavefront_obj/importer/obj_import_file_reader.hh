@@ -13,6 +13,8 @@
 
 namespace blender::io::obj {
 
+struct ParserState;
+
 /* NOTE: the OBJ parser implementation is planned to get fairly large changes "soon",
  * so don't read too much into current implementation... */
 class OBJParser {
@@ -20,6 +22,7 @@ class OBJParser {
   const OBJImportParams &import_params_;
   FILE *obj_file_;
   Vector<std::string> mtl_libraries_;
+  /** Size of the blocks the file is read in, or of the chunks parsed in parallel. */
   size_t read_buffer_size_;
 
  public:
@@ -32,6 +35,9 @@ class OBJParser {
   /**
    * Read the OBJ file line by line and create OBJ Geometry instances. Also store all the vertex
    * and UV vertex coordinates in a struct accessible by all objects.
+   *
+   * When the file can be memory-mapped, it is split into chunks at line boundaries that are
+   * parsed in parallel, and then merged in file order.
    */
   void parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
              GlobalVertices &r_global_vertices);
@@ -41,6 +47,18 @@ class OBJParser {
   Span<std::string> mtl_libraries() const;
 
  private:
+  void parse_line(const char *p,
+                  const char *end,
+                  ParserState &state,
+                  Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                  GlobalVertices &r_global_vertices);
+  void parse_buffered(ParserState &state,
+                      Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                      GlobalVertices &r_global_vertices);
+  /** Return false when the file could not be memory-mapped. */
+  bool parse_memory_mapped(ParserState &state,
+                           Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                           GlobalVertices &r_global_vertices);
   void add_mtl_library(StringRef path);
   void add_default_mtl_library();
 };
@@ -4,13 +4,19 @@
  * \ingroup obj
  */
 
+#include <algorithm>
+
 #include "BKE_image.h"
 #include "BKE_main.h"
 #include "BKE_node.h"
 
+#include "BLI_fileops.h"
 #include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_material_types.h"
 #include "DNA_node_types.h"
@@ -94,52 +100,84 @@ static Image *create_placeholder_image(Main *bmain, const std::string &path)
   return image;
 }
 
-static Image *load_texture_image(Main *bmain, const MTLTexMap &tex_map, bool relative_paths)
+/**
+ * Paths to try for the image of a texture map, in order of preference.
+ */
+static Vector<std::string> texture_image_candidate_paths(const MTLTexMap &tex_map)
 {
-  Image *image = nullptr;
-
+  Vector<std::string> paths;
   /* First try treating texture path as relative. */
   std::string tex_path{tex_map.mtl_dir_path + tex_map.image_path};
-  image = load_image_at_path(bmain, tex_path, relative_paths);
-  if (image != nullptr) {
-    return image;
-  }
+  paths.append(tex_path);
   /* Then try using it directly as absolute path. */
-  std::string raw_path{tex_map.image_path};
-  image = load_image_at_path(bmain, raw_path, relative_paths);
-  if (image != nullptr) {
-    return image;
-  }
+  paths.append(tex_map.image_path);
   /* Try removing quotes. */
   std::string no_quote_path{tex_path};
   auto end_pos = std::remove(no_quote_path.begin(), no_quote_path.end(), '"');
   no_quote_path.erase(end_pos, no_quote_path.end());
   if (no_quote_path != tex_path) {
-    image = load_image_at_path(bmain, no_quote_path, relative_paths);
-    if (image != nullptr) {
-      return image;
-    }
+    paths.append(no_quote_path);
   }
   /* Try replacing underscores with spaces. */
   std::string no_underscore_path{no_quote_path};
   std::replace(no_underscore_path.begin(), no_underscore_path.end(), '_', ' ');
   if (!ELEM(no_underscore_path, no_quote_path, tex_path)) {
-    image = load_image_at_path(bmain, no_underscore_path, relative_paths);
-    if (image != nullptr) {
-      return image;
-    }
+    paths.append(no_underscore_path);
   }
   /* Try taking just the basename from input path. */
   std::string base_path{tex_map.mtl_dir_path + BLI_path_basename(tex_map.image_path.c_str())};
   if (base_path != tex_path) {
-    image = load_image_at_path(bmain, base_path, relative_paths);
+    paths.append(base_path);
+  }
+  return paths;
+}
+
+/** Same check as #BKE_image_load, which is not thread-safe because it creates the image. */
+static bool image_file_exists(const std::string &path, const char *blendfile_path)
+{
+  char filepath[FILE_MAX];
+  STRNCPY(filepath, path.c_str());
+  BLI_path_abs(filepath, blendfile_path);
+  return BLI_is_file(filepath) || BKE_image_tile_filepath_exists(filepath);
+}
+
+void resolve_texture_image_paths(Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
+                                 const char *blendfile_path)
+{
+  Vector<MTLTexMap *> tex_maps;
+  for (std::unique_ptr<MTLMaterial> &mtl_mat : materials.values()) {
+    for (MTLTexMap &tex_map : mtl_mat->texture_maps) {
+      if (tex_map.is_valid()) {
+        tex_maps.append(&tex_map);
+      }
+    }
+  }
+  /* Each texture map needs a few file system queries that are independent of each other. */
+  threading::parallel_for(tex_maps.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      MTLTexMap &tex_map = *tex_maps[i];
+      for (const std::string &path : texture_image_candidate_paths(tex_map)) {
+        if (image_file_exists(path, blendfile_path)) {
+          tex_map.resolved_image_path = path;
+          break;
+        }
+      }
+    }
+  });
+}
+
+static Image *load_texture_image(Main *bmain, const MTLTexMap &tex_map, bool relative_paths)
+{
+  if (!tex_map.resolved_image_path.empty()) {
+    Image *image = load_image_at_path(bmain, tex_map.resolved_image_path, relative_paths);
     if (image != nullptr) {
       return image;
     }
   }
-
-  image = create_placeholder_image(bmain, tex_path);
-  return image;
+  else {
+    fprintf(stderr, "Cannot find image file: '%s'\n", tex_map.image_path.c_str());
+  }
+  return create_placeholder_image(bmain, tex_map.mtl_dir_path + tex_map.image_path);
 }
 
 /* Nodes are arranged in columns by type, with manually placed x coordinates
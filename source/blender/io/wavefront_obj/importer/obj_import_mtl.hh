@@ -2,6 +2,11 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+
+#include "BLI_map.hh"
+
 #include "DNA_node_types.h"
 
 struct Main;
@@ -11,6 +16,15 @@ namespace blender::io::obj {
 
 struct MTLMaterial;
 
+/**
+ * Find the image files of all texture maps of the materials. Paths written by other tools often
+ * need some guessing, which means checking several files for existence for every texture map.
+ * That is done for all texture maps in parallel, so that creating the node trees afterwards only
+ * has to load the resolved path. The pixels of the images are loaded lazily on first use.
+ */
+void resolve_texture_image_paths(Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
+                                 const char *blendfile_path);
+
 bNodeTree *create_mtl_node_tree(Main *bmain,
                                 const MTLMaterial &mtl_mat,
                                 Material *mat,
@@ -13,6 +13,7 @@
 #include "BLI_string_ref.hh"
 
 #include "BKE_layer.h"
+#include "BKE_main.h"
 #include "BKE_scene.h"
 
 #include "DEG_depsgraph_build.h"
@@ -22,6 +23,7 @@
 #include "obj_export_mtl.hh"
 #include "obj_import_file_reader.hh"
 #include "obj_import_mesh.hh"
+#include "obj_import_mtl.hh"
 #include "obj_import_nurbs.hh"
 #include "obj_import_objects.hh"
 #include "obj_importer.hh"
@@ -115,6 +117,7 @@ void importer_main(Main *bmain,
     MTLParser mtl_parser{mtl_library, import_params.filepath};
     mtl_parser.parse_and_store(materials);
   }
+  resolve_texture_image_paths(materials, BKE_main_blendfile_path(bmain));
 
   if (import_params.clear_selection) {
     BKE_view_layer_base_deselect_all(scene, view_layer);
@@ -715,6 +715,14 @@ enum {
    * RESET_NEVER
    */
   LIB_TAG_MISSING = 1 << 6,
+  /**
+   * ID is a place-holder for a linked data-block that has not been read from its library yet
+   * (see #BLO_LIBLINK_DEFER_HIDDEN_OBDATA). It is also tagged as #LIB_TAG_MISSING, until it gets
+   * loaded by #BKE_blendfile_link_deferred_tagged_load.
+   *
+   * RESET_NEVER
+   */
+  LIB_TAG_DEFERRED = 1 << 22,
 
   /**
    * ID is up-to-date regarding its reference (only for library overrides).
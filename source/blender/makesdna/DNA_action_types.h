@@ -497,6 +497,8 @@ typedef struct bPose {
   void *ikdata;
   /** IK solver parameters, structure depends on iksolver. */
   void *ikparam;
+  /** Evaluated poses stored for playback, see #POSE_USE_CACHE. Not saved in file. */
+  struct PoseCache *cache;
 
   /** Settings for visualization of bone animation. */
   bAnimVizSettings avs;
@@ -525,6 +527,9 @@ typedef enum ePose_Flags {
   POSE_MIRROR_EDIT = (1 << 9),
   /* Use relative mirroring in mirror mode */
   POSE_MIRROR_RELATIVE = (1 << 10),
+  /* Store the evaluated pose of every frame, and reuse it until the pose or its animation is
+   * edited. */
+  POSE_USE_CACHE = (1 << 11),
 } ePose_Flags;
 
 /* IK Solvers ------------------------------------ */
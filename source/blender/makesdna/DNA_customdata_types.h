@@ -46,6 +46,13 @@ typedef struct CustomDataLayer {
    * automatically.
    */
   const struct AnonymousAttributeID *anonymous_id;
+  /**
+   * Run-time user count of #data, set for layers that own their data array. Copies made with
+   * #CD_SHARE add a user instead of copying the array. While there is more than one user, the
+   * data is read-only and writing has to go through the `*_for_write` getters, which make a
+   * private copy.
+   */
+  struct CustomDataSharingInfo *sharing_info;
 } CustomDataLayer;
 
 #define MAX_CUSTOMDATA_LAYER_NAME 64
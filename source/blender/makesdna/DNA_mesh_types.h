@@ -31,6 +31,7 @@ extern "C" {
 
 struct AnimData;
 struct BVHCache;
+struct BVHTreeStash;
 struct Ipo;
 struct Key;
 struct MCol;
@@ -41,6 +42,7 @@ struct MLoopTri;
 struct MVert;
 struct Material;
 struct Mesh;
+struct MeshVertToLoopCache;
 struct SubdivCCG;
 struct SubsurfRuntimeData;
 
@@ -140,12 +142,18 @@ typedef struct Mesh_Runtime {
   struct SubsurfRuntimeData *subsurf_runtime_data;
   void *_pad1;
 
+  /**
+   * Incremented whenever the edges, faces or corners of the mesh may have changed, so that caches
+   * of the topology can tell whether they are still valid, see #vert_to_loop_cache.
+   */
+  int topology_update_count;
+
   /**
    * Caches for lazily computed vertex and polygon normals. These are stored here rather than in
    * #CustomData because they can be calculated on a const mesh, and adding custom data layers on a
    * const mesh is not thread-safe.
    */
-  char _pad2[6];
+  char _pad2[2];
   char vert_normals_dirty;
   char poly_normals_dirty;
   float (*vert_normals)[3];
@@ -156,6 +164,20 @@ typedef struct Mesh_Runtime {
    * subdivision surface modifier and used by drawing code instead of polygon center face dots.
    */
   uint32_t *subsurf_face_dot_tags;
+
+  /**
+   * Vertex and edge to corner topology maps used to compute vertex normals without atomics and
+   * to interpolate attributes between domains. It is shared with copies of the mesh that
+   * reference the same topology arrays, e.g. evaluated copies made for deform-only modifiers.
+   * See `mesh_normals.cc`.
+   */
+  struct MeshVertToLoopCache *vert_to_loop_cache;
+
+  /**
+   * BVH trees from an earlier state of the mesh with the same topology, which can be refitted
+   * instead of rebuilding the trees when they are requested again. See `bvhutils.cc`.
+   */
+  struct BVHTreeStash *bvh_stash;
 } Mesh_Runtime;
 
 typedef struct Mesh {
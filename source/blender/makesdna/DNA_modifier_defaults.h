@@ -560,7 +560,11 @@
   }
 
 #define _DNA_DEFAULT_NodesModifierData \
-  { 0 }
+  { \
+    .bake_directory = "//geometry_nodes_bake/", \
+    .flag = 0, \
+    .cache_memory_limit = 0, \
+  }
 
 #define _DNA_DEFAULT_SkinModifierData \
   { \
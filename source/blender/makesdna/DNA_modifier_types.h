@@ -2290,14 +2290,30 @@ typedef struct NodesModifierData {
   struct bNodeTree *node_group;
   struct NodesModifierSettings settings;
 
+  /** Directory for the baked geometry of every frame. FILE_MAX. */
+  char bake_directory[1024];
+  /** #NodesModifierFlag. */
+  int flag;
+  /** Memory in megabytes for node outputs kept between evaluations, zero disables the cache. */
+  int cache_memory_limit;
+
   /**
    * Contains logged information from the last evaluation.
    * This can be used to help the user to debug a node tree.
    */
   void *runtime_eval_log;
-  void *_pad1;
+  /** #blender::nodes::GeometryNodesCache, only used on the original modifier. */
+  void *runtime_cache;
 } NodesModifierData;
 
+/** #NodesModifierData.flag */
+typedef enum NodesModifierFlag {
+  /** Read the output geometry from #NodesModifierData.bake_directory instead of evaluating. */
+  NODES_MODIFIER_BAKED = (1 << 0),
+  /** Runtime only, write the output geometry of every evaluation into the bake directory. */
+  NODES_MODIFIER_BAKE_WRITE = (1 << 1),
+} NodesModifierFlag;
+
 typedef struct MeshToVolumeModifierData {
   ModifierData modifier;
 
@@ -599,7 +599,11 @@ typedef struct bNodeTree {
    */
   bNodeInstanceKey active_viewer_key;
 
-  char _pad[4];
+  /** Memory in megabytes to keep compositor operations results between executions. */
+  int cache_limit;
+  /** Memory in megabytes compositor operations results can use during an execution. */
+  int memory_limit;
+  char _pad1[4];
 
   /** Execution data.
    *
@@ -2213,6 +2217,11 @@ typedef enum GeometryNodeDistributePointsOnFacesMode {
   GEO_NODE_POINT_DISTRIBUTE_POINTS_ON_FACES_POISSON = 1,
 } GeometryNodeDistributePointsOnFacesMode;
 
+/** #bNode.custom2 of the Distribute Points on Faces node. */
+typedef enum GeometryNodeDistributePointsOnFacesFlag {
+  GEO_NODE_POINT_DISTRIBUTE_POINTS_ON_FACES_LEGACY_ELIMINATION = (1 << 0),
+} GeometryNodeDistributePointsOnFacesFlag;
+
 typedef enum GeometryNodeExtrudeMeshMode {
   GEO_NODE_EXTRUDE_MESH_VERTICES = 0,
   GEO_NODE_EXTRUDE_MESH_EDGES = 1,
@@ -2261,6 +2270,7 @@ typedef enum GeometryNodeMeshCircleFillType {
 typedef enum GeometryNodeMergeByDistanceMode {
   GEO_NODE_MERGE_BY_DISTANCE_MODE_ALL = 0,
   GEO_NODE_MERGE_BY_DISTANCE_MODE_CONNECTED = 1,
+  GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID = 2,
 } GeometryNodeMergeByDistanceMode;
 
 typedef enum GeometryNodeUVUnwrapMethod {
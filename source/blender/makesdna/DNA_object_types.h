@@ -26,6 +26,8 @@ extern "C" {
 #endif
 
 struct AnimData;
+struct BVHTreeStash;
+struct MeshBatchCacheStash;
 struct BoundBox;
 struct Curve;
 struct FluidsimSettings;
@@ -205,8 +207,20 @@ typedef struct Object_Runtime {
   float (*crazyspace_deform_imats)[3][3];
   float (*crazyspace_deform_cos)[3];
   int crazyspace_verts_num;
+  int _pad3;
 
-  int _pad3[3];
+  /**
+   * BVH tree of the evaluated mesh from the previous evaluation. It is kept when the evaluated
+   * mesh is freed and passed on to the next one, so that it can be refitted if the topology is
+   * the same.
+   */
+  struct BVHTreeStash *bvh_stash;
+
+  /**
+   * Draw cache of the evaluated mesh from the previous evaluation, passed on to the next one when
+   * only the vertex positions changed. See #BKE_mesh_batch_cache_stash_take.
+   */
+  struct MeshBatchCacheStash *batch_cache_stash;
 } Object_Runtime;
 
 typedef struct ObjectLineArt {
@@ -356,7 +356,10 @@ typedef struct ParticleSystem {
    * TODO(sergey): Use #ParticleSettings.id.recalc instead of this duplicated flag somehow. */
   int recalc;
   short target_psys, totkeyed, bakespace;
-  char _pad1[6];
+  char _pad1[2];
+  /** Hash of the parent paths and emitter that the child path cache was created from (runtime).
+   * Zero when the child paths have to be recreated. */
+  int childcache_hash;
 
   /** Billboard uv name, MAX_CUSTOMDATA_LAYER_NAME. */
   char bb_uvname[3][64] DNA_DEPRECATED;
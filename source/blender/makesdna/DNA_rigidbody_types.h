@@ -82,6 +82,8 @@ typedef enum eRigidBodyWorld_Flag {
   /* RBW_FLAG_NEEDS_REBUILD = (1 << 1), */ /* UNUSED */
   /** Use split impulse when stepping the simulation. */
   RBW_FLAG_USE_SPLIT_IMPULSE = (1 << 2),
+  /** Solve independent simulation islands on multiple threads. */
+  RBW_FLAG_USE_MULTITHREADING = (1 << 3),
 } eRigidBodyWorld_Flag;
 
 /* ******************************** */
@@ -1915,7 +1915,7 @@ typedef struct Scene {
 #define R_SIMPLIFY (1 << 24)
 #define R_EDGE_FRS (1 << 25)        /* R_EDGE reserved for Freestyle */
 #define R_PERSISTENT_DATA (1 << 26) /* keep data around for re-render */
-#define R_MODE_UNUSED_27 (1 << 27)  /* cleared */
+#define R_ASYNC_WRITE (1 << 27)     /* write animation frames in the background */
 
 /** #RenderData.seq_flag */
 enum {
@@ -622,6 +622,10 @@ typedef struct SpaceSeqRuntime {
   struct GHash *last_displayed_thumbnails;
   int rename_channel_index;
   float timeline_clamp_custom_range;
+  /** Image shown in the preview, referenced to detect redraws of the same image. */
+  struct ImBuf *display_ibuf;
+  /** Texture of `display_ibuf` when it is drawn with GLSL color management. */
+  struct GPUTexture *display_texture;
 } SpaceSeqRuntime;
 
 /** Sequencer. */
@@ -640,6 +640,7 @@ typedef struct UserDef_Experimental {
   char show_asset_debug_info;
   char no_asset_indexing;
   char use_viewport_debug;
+  char use_undo_skip_unchanged_ids;
   char SANITIZE_AFTER_HERE;
   /* The following options are automatically sanitized (set to 0)
    * when the release cycle is not alpha. */
@@ -653,7 +654,8 @@ typedef struct UserDef_Experimental {
   char use_sculpt_texture_paint;
   char use_draw_manager_acquire_lock;
   char use_realtime_compositor;
-  char _pad[7];
+  char use_gpu_field_evaluation;
+  char _pad[5];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -931,7 +933,7 @@ typedef struct UserDef {
 
   float collection_instance_empty_size;
   char text_flag;
-  char _pad10[1];
+  char sequencer_flag; /* eUserpref_SequencerFlag */
 
   char file_preview_type; /* eUserpref_File_Preview_Type */
   char statusbar_flag;    /* eUserpref_StatusBar_Flag */
@@ -1391,6 +1393,11 @@ typedef enum eUserpref_SeqProxySetup {
   USER_SEQ_PROXY_SETUP_AUTOMATIC = 1,
 } eUserpref_SeqProxySetup;
 
+/** #UserDef.sequencer_flag */
+typedef enum eUserpref_SequencerFlag {
+  USER_SEQ_USE_HARDWARE_DECODING = (1 << 0),
+} eUserpref_SequencerFlag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
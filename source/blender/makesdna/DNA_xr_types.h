@@ -40,6 +40,13 @@ typedef struct XrSessionSettings {
   /** Object type settings to apply to VR view (unlike shading, not shared with window 3D-View). */
   int object_type_exclude_viewport;
   int object_type_exclude_select;
+
+  /**
+   * Fraction of the view resolution recommended by the OpenXR runtime to draw with. The runtime
+   * scales the views up to the display resolution.
+   */
+  float resolution_scale;
+  char _pad3[4];
 } XrSessionSettings;
 
 typedef enum eXrSessionFlag {
@@ -68,8 +68,8 @@ static void rna_Curves_curve_offset_data_begin(CollectionPropertyIterator *iter,
 
 static float (*get_curves_positions(Curves *curves))[3]
 {
-  return (float(*)[3])CustomData_get_layer_named(
-      &curves->geometry.point_data, CD_PROP_FLOAT3, "position");
+  return (float(*)[3])CustomData_get_layer_named_for_write(
+      &curves->geometry.point_data, CD_PROP_FLOAT3, "position", curves->geometry.point_num);
 }
 
 static const float (*get_curves_positions_const(const Curves *curves))[3]
@@ -143,9 +143,9 @@ static float rna_CurvePoint_radius_get(PointerRNA *ptr)
 
 static void rna_CurvePoint_radius_set(PointerRNA *ptr, float value)
 {
-  const Curves *curves = rna_curves(ptr);
-  float *radii = (float *)CustomData_get_layer_named(
-      &curves->geometry.point_data, CD_PROP_FLOAT, "radius");
+  Curves *curves = rna_curves(ptr);
+  float *radii = (float *)CustomData_get_layer_named_for_write(
+      &curves->geometry.point_data, CD_PROP_FLOAT, "radius", curves->geometry.point_num);
   if (radii == NULL) {
     return;
   }
@@ -203,8 +203,8 @@ static void rna_CurveSlice_points_begin(CollectionPropertyIterator *iter, Pointe
   Curves *curves = rna_curves(ptr);
   const int offset = rna_CurveSlice_first_point_index_get(ptr);
   const int size = rna_CurveSlice_points_length_get(ptr);
-  float(*positions)[3] = (float(*)[3])CustomData_get_layer_named(
-      &curves->geometry.point_data, CD_PROP_FLOAT3, "position");
+  float(*positions)[3] = (float(*)[3])CustomData_get_layer_named_for_write(
+      &curves->geometry.point_data, CD_PROP_FLOAT3, "position", curves->geometry.point_num);
   float(*co)[3] = positions + offset;
   rna_iterator_array_begin(iter, co, sizeof(float[3]), size, 0, NULL);
 }
@@ -266,6 +266,20 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_eval_profile_write(ReportList *reports,
+                                                   const char *filepath,
+                                                   bool clear)
+{
+  if (!DEG_debug_eval_profile_write(filepath, clear)) {
+    BKE_reportf(reports, RPT_ERROR, "Could not write dependency graph profile to '%s'", filepath);
+  }
+}
+
+static void rna_Depsgraph_debug_eval_profile_clear(void)
+{
+  DEG_debug_eval_profile_clear();
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -708,6 +722,24 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  func = RNA_def_function(
+      srna, "debug_eval_profile_write", "rna_Depsgraph_debug_eval_profile_write");
+  RNA_def_function_ui_description(
+      func,
+      "Write the evaluation profile of all dependency graphs recorded with "
+      "bpy.app.debug_depsgraph_profile in the Chrome trace event JSON format");
+  RNA_def_function_flag(func, FUNC_NO_SELF | FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(
+      func, "filepath", NULL, FILE_MAX, "File Path", "Output path for the profile");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+  RNA_def_boolean(
+      func, "clear", false, "Clear", "Discard the recorded events after writing them");
+
+  func = RNA_def_function(
+      srna, "debug_eval_profile_clear", "rna_Depsgraph_debug_eval_profile_clear");
+  RNA_def_function_ui_description(func, "Discard the recorded evaluation profile");
+  RNA_def_function_flag(func, FUNC_NO_SELF);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
@@ -37,6 +37,7 @@
 #  include "BKE_idtype.h"
 #  include "BKE_image.h"
 #  include "BKE_lattice.h"
+#  include "BKE_lib_id.h"
 #  include "BKE_lib_remap.h"
 #  include "BKE_light.h"
 #  include "BKE_lightprobe.h"
@@ -208,12 +209,38 @@ static void rna_Main_scenes_remove(
   }
 }
 
-static Object *rna_Main_objects_new(Main *bmain, ReportList *reports, const char *name, ID *data)
+/**
+ * \return The object type for the given object data, or -1 when no object can be created for it.
+ */
+static int rna_Main_objects_data_type(ReportList *reports, ID *data)
 {
-  if (data != NULL && (data->tag & LIB_TAG_NO_MAIN)) {
+  if (data == NULL) {
+    return OB_EMPTY;
+  }
+
+  if (data->tag & LIB_TAG_NO_MAIN) {
     BKE_report(reports,
                RPT_ERROR,
                "Can not create object in main database with an evaluated data data-block");
+    return -1;
+  }
+
+  const int type = BKE_object_obdata_to_type(data);
+  if (type == -1) {
+    const char *idname;
+    if (RNA_enum_id_from_value(rna_enum_id_type_items, GS(data->name), &idname) == 0) {
+      idname = "UNKNOWN";
+    }
+
+    BKE_reportf(reports, RPT_ERROR, "ID type '%s' is not valid for an object", idname);
+  }
+  return type;
+}
+
+static Object *rna_Main_objects_new(Main *bmain, ReportList *reports, const char *name, ID *data)
+{
+  const int type = rna_Main_objects_data_type(reports, data);
+  if (type == -1) {
     return NULL;
   }
 
@@ -221,20 +248,8 @@ static Object *rna_Main_objects_new(Main *bmain, ReportList *reports, const char
   rna_idname_validate(name, safe_name);
 
   Object *ob;
-  int type = OB_EMPTY;
 
   if (data) {
-    type = BKE_object_obdata_to_type(data);
-    if (type == -1) {
-      const char *idname;
-      if (RNA_enum_id_from_value(rna_enum_id_type_items, GS(data->name), &idname) == 0) {
-        idname = "UNKNOWN";
-      }
-
-      BKE_reportf(reports, RPT_ERROR, "ID type '%s' is not valid for an object", idname);
-      return NULL;
-    }
-
     id_us_plus(data);
   }
 
@@ -248,6 +263,61 @@ static Object *rna_Main_objects_new(Main *bmain, ReportList *reports, const char
   return ob;
 }
 
+static void rna_Main_objects_new_batch(Main *bmain,
+                                       ReportList *reports,
+                                       const char *name,
+                                       int count,
+                                       ID *data,
+                                       Collection *collection,
+                                       CollectionListBase *r_objects)
+{
+  const int type = rna_Main_objects_data_type(reports, data);
+  if (type == -1 || count == 0) {
+    return;
+  }
+  if (collection && (ID_IS_LINKED(collection) || ID_IS_OVERRIDE_LIBRARY(collection))) {
+    BKE_reportf(reports,
+                RPT_ERROR,
+                "Could not link the objects because the collection '%s' is linked or overridden",
+                collection->id.name + 2);
+    return;
+  }
+
+  char safe_name[MAX_ID_NAME - 2];
+  rna_idname_validate(name, safe_name);
+
+  /* Create the objects outside of the main database first, so that unique names are found and
+   * the objects sorted into the list once for all of them, instead of once per object. */
+  Object **objects = MEM_mallocN(sizeof(*objects) * (size_t)count, __func__);
+  for (int i = 0; i < count; i++) {
+    Object *ob = BKE_object_add_only_object(NULL, type, safe_name);
+    if (data) {
+      id_us_plus(data);
+    }
+    ob->data = data;
+    objects[i] = ob;
+  }
+  BKE_libblock_management_main_add_multiple(bmain, (ID **)objects, count);
+
+  for (int i = 0; i < count; i++) {
+    Object *ob = objects[i];
+    BKE_object_materials_test(bmain, ob, ob->data);
+
+    CollectionPointerLink *link = MEM_callocN(sizeof(CollectionPointerLink), __func__);
+    RNA_id_pointer_create(&ob->id, &link->ptr);
+    BLI_addtail((ListBase *)r_objects, link);
+  }
+
+  if (collection) {
+    BKE_collection_object_add_multiple(bmain, collection, objects, count);
+    DEG_id_tag_update(&collection->id, ID_RECALC_COPY_ON_WRITE);
+    DEG_relations_tag_update(bmain);
+  }
+  MEM_freeN(objects);
+
+  WM_main_add_notifier(NC_ID | NA_ADDED, NULL);
+}
+
 static Material *rna_Main_materials_new(Main *bmain, const char *name)
 {
   char safe_name[MAX_ID_NAME - 2];
@@ -975,6 +1045,24 @@ void RNA_def_main_objects(BlenderRNA *brna, PropertyRNA *cprop)
   parm = RNA_def_pointer(func, "object", "Object", "", "New object data-block");
   RNA_def_function_return(func, parm);
 
+  func = RNA_def_function(srna, "new_batch", "rna_Main_objects_new_batch");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  RNA_def_function_ui_description(
+      func,
+      "Add many new objects to the main database at once, much faster than adding them one by "
+      "one when creating thousands of objects");
+  parm = RNA_def_string(func, "name", "Object", 0, "", "Base name for the new data-blocks");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+  parm = RNA_def_int(func, "count", 1, 0, INT_MAX, "", "Number of objects to add", 0, 10000);
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+  parm = RNA_def_pointer(
+      func, "object_data", "ID", "", "Object data used by all new objects, or None for empties");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+  RNA_def_pointer(
+      func, "collection", "Collection", "", "Collection to link the new objects to (optional)");
+  parm = RNA_def_collection(func, "objects", "Object", "", "New object data-blocks");
+  RNA_def_function_output(func, parm);
+
   func = RNA_def_function(srna, "remove", "rna_Main_ID_remove");
   RNA_def_function_ui_description(func, "Remove an object from the current blendfile");
   RNA_def_function_flag(func, FUNC_USE_REPORTS);
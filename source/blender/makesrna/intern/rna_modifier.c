@@ -1684,6 +1684,19 @@ static IDProperty **rna_NodesModifier_properties(PointerRNA *ptr)
   NodesModifierSettings *settings = &nmd->settings;
   return &settings->properties;
 }
+
+static void rna_NodesModifier_execution_traces_write(NodesModifierData *nmd,
+                                                     ReportList *reports,
+                                                     const char *filepath)
+{
+  if (!MOD_nodes_execution_traces_write(nmd, filepath)) {
+    BKE_reportf(reports,
+                RPT_ERROR,
+                "Could not write node execution traces to '%s', the modifier may not have been "
+                "evaluated in an active dependency graph yet",
+                filepath);
+  }
+}
 #else
 
 static void rna_def_property_subdivision_common(StructRNA *srna)
@@ -6993,6 +7006,8 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
 {
   StructRNA *srna;
   PropertyRNA *prop;
+  FunctionRNA *func;
+  PropertyRNA *parm;
 
   srna = RNA_def_struct(brna, "NodesModifier", "Modifier");
   RNA_def_struct_ui_text(srna, "Nodes Modifier", "");
@@ -7008,7 +7023,41 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_EDITABLE);
   RNA_def_property_update(prop, 0, "rna_NodesModifier_node_group_update");
 
+  prop = RNA_def_property(srna, "bake_directory", PROP_STRING, PROP_DIRPATH);
+  RNA_def_property_ui_text(
+      prop,
+      "Bake Directory",
+      "Directory to store the baked geometry of every frame in, in a sub-directory per object and "
+      "modifier");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_property(srna, "cache_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 16384, 64, -1);
+  RNA_def_property_ui_text(prop,
+                           "Cache Limit",
+                           "Memory in megabytes for keeping the outputs of expensive nodes "
+                           "between evaluations, to avoid computing them again when only nodes "
+                           "after them changed. Zero disables the cache");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   RNA_define_lib_overridable(false);
+
+  prop = RNA_def_property(srna, "is_baked", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NODES_MODIFIER_BAKED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop, "Is Baked", "Whether the output geometry is read from the bake directory");
+
+  func = RNA_def_function(
+      srna, "execution_traces_write", "rna_NodesModifier_execution_traces_write");
+  RNA_def_function_ui_description(
+      func,
+      "Write the execution time of every node from the last evaluation, including the time spent "
+      "waiting for inputs and the thread it ran on, in the Chrome trace event JSON format");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(func, "filepath", NULL, 0, "", "File path to write to");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 }
 
 static void rna_def_modifier_mesh_to_volume(BlenderRNA *brna)
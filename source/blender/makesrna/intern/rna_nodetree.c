@@ -9661,6 +9661,15 @@ static void def_geo_distribute_points_on_faces(StructRNA *srna)
   RNA_def_property_enum_default(prop, GEO_NODE_POINT_DISTRIBUTE_POINTS_ON_FACES_RANDOM);
   RNA_def_property_ui_text(prop, "Distribution Method", "Method to use for scattering points");
   RNA_def_property_update(prop, NC_NODE | NA_EDITED, "rna_Node_socket_update");
+
+  prop = RNA_def_property(srna, "use_legacy_elimination", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, NULL, "custom2", GEO_NODE_POINT_DISTRIBUTE_POINTS_ON_FACES_LEGACY_ELIMINATION);
+  RNA_def_property_ui_text(prop,
+                           "Legacy Elimination",
+                           "Eliminate close points in index order like before the Poisson Disk "
+                           "method was multi-threaded, to keep the points of older files");
+  RNA_def_property_update(prop, NC_NODE | NA_EDITED, "rna_Node_update");
 }
 
 static void def_geo_curve_spline_type(StructRNA *srna)
@@ -10170,6 +10179,12 @@ static void def_geo_merge_by_distance(StructRNA *srna)
        0,
        "Connected",
        "Only merge mesh vertices along existing edges. This method can be much faster"},
+      {GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID,
+       "GRID",
+       0,
+       "Grid",
+       "Merge all close selected points, finding them with a uniform grid that is processed in "
+       "parallel. This method can be much faster for large point clouds and meshes"},
       {0, NULL, 0, NULL, NULL},
   };
 
@@ -12801,6 +12816,24 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Execution Mode", "Set how compositing is executed");
   RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
 
+  prop = RNA_def_property(srna, "cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "cache_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_text(prop,
+                           "Cache Limit",
+                           "Memory (in megabytes) used to keep node results between executions, "
+                           "so that only nodes affected by a change are computed again "
+                           "(Full Frame only, 0 disables the cache)");
+
+  prop = RNA_def_property(srna, "memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "memory_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_text(prop,
+                           "Memory Limit",
+                           "Memory (in megabytes) node results can use while compositing, results "
+                           "not needed soon are compressed to a temporary file when it's exceeded "
+                           "(Full Frame only, 0 for no limit)");
+
   prop = RNA_def_property(srna, "render_quality", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, NULL, "render_quality");
   RNA_def_property_enum_items(prop, node_quality_items);
@@ -108,6 +108,18 @@ static void rna_Pose_IK_update(Main *UNUSED(bmain), Scene *UNUSED(scene), Pointe
   BIK_clear_data(ob->pose);
 }
 
+static void rna_Pose_cache_update(Main *bmain, Scene *UNUSED(scene), PointerRNA *ptr)
+{
+  Object *ob = (Object *)ptr->owner_id;
+
+  BKE_pose_cache_free(ob->pose);
+
+  /* The cache reset operation only exists while the cache is used. */
+  DEG_relations_tag_update(bmain);
+  DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+  WM_main_add_notifier(NC_OBJECT | ND_POSE, ptr->owner_id);
+}
+
 static char *rna_Pose_path(const PointerRNA *UNUSED(ptr))
 {
   return BLI_strdup("pose");
@@ -1721,6 +1733,17 @@ static void rna_def_pose(BlenderRNA *brna)
   RNA_def_property_update(prop, 0, "rna_Pose_update");
   RNA_def_property_flag(prop, PROP_LIB_EXCEPTION);
 
+  prop = RNA_def_property(srna, "use_playback_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", POSE_USE_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Playback Cache",
+                           "Store the evaluated pose of every frame in memory, and reuse it "
+                           "instead of solving constraints and IK until the armature, the pose "
+                           "or its animation is edited");
+  RNA_def_struct_path_func(srna, "rna_Pose_path");
+  RNA_def_property_update(prop, 0, "rna_Pose_cache_update");
+  RNA_def_property_flag(prop, PROP_LIB_EXCEPTION);
+
   RNA_define_lib_overridable(false);
 
   /* animviz */
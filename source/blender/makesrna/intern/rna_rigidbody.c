@@ -932,6 +932,16 @@ static void rna_def_rigidbody_world(BlenderRNA *brna)
       "stability a little so use only when necessary)");
   RNA_def_property_update(prop, NC_SCENE, "rna_RigidBodyWorld_reset");
 
+  /* multi-threading, takes effect when the world is rebuilt after the cache reset */
+  prop = RNA_def_property(srna, "use_multithreading", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", RBW_FLAG_USE_MULTITHREADING);
+  RNA_def_property_ui_text(
+      prop,
+      "Multi-Threading",
+      "Solve groups of objects that do not touch each other on multiple threads (speeds up "
+      "simulations with many objects, results can differ slightly from a single-threaded solve)");
+  RNA_def_property_update(prop, NC_SCENE, "rna_RigidBodyWorld_reset");
+
   /* cache */
   prop = RNA_def_property(srna, "point_cache", PROP_POINTER, PROP_NONE);
   RNA_def_property_flag(prop, PROP_NEVER_NULL);
@@ -216,6 +216,8 @@ const EnumPropertyItem rna_enum_property_string_search_flag_items[] = {
 /** \} */
 
 #ifdef RNA_RUNTIME
+#  include "atomic_ops.h"
+
 #  include "BLI_ghash.h"
 #  include "BLI_string.h"
 #  include "MEM_guardedalloc.h"
@@ -506,6 +508,34 @@ PointerRNA rna_builtin_properties_get(CollectionPropertyIterator *iter)
   return rna_Struct_properties_get(iter);
 }
 
+/**
+ * The property lookup tables are created on first use instead of in #RNA_init, since most
+ * structs are never looked up by name, especially in background mode.
+ * Lookups can happen from multiple threads (e.g. animation evaluation), so the table is
+ * published atomically, a thread that loses the race frees its own copy.
+ */
+static GHash *rna_struct_prophash_ensure(StructRNA *srna)
+{
+  GHash *prophash = atomic_load_ptr((void *const *)&srna->cont.prophash);
+  if (prophash) {
+    return prophash;
+  }
+
+  prophash = BLI_ghash_str_new(__func__);
+  for (PropertyRNA *prop = srna->cont.properties.first; prop; prop = prop->next) {
+    if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
+      BLI_ghash_insert(prophash, (void *)prop->identifier, prop);
+    }
+  }
+
+  GHash *prophash_prev = atomic_cas_ptr((void **)&srna->cont.prophash, NULL, prophash);
+  if (prophash_prev) {
+    BLI_ghash_free(prophash, NULL, NULL);
+    return prophash_prev;
+  }
+  return prophash;
+}
+
 int rna_builtin_properties_lookup_string(PointerRNA *ptr, const char *key, PointerRNA *r_ptr)
 {
   StructRNA *srna;
@@ -515,8 +545,9 @@ int rna_builtin_properties_lookup_string(PointerRNA *ptr, const char *key, Point
   srna = ptr->type;
 
   do {
-    if (srna->cont.prophash) {
-      prop = BLI_ghash_lookup(srna->cont.prophash, (void *)key);
+    /* Structs registered at runtime (e.g. by add-ons) are searched linearly. */
+    if (srna->cont.prophash || !(srna->flag & STRUCT_RUNTIME)) {
+      prop = BLI_ghash_lookup(rna_struct_prophash_ensure(srna), (void *)key);
 
       if (prop) {
         propptr.type = &RNA_Property;
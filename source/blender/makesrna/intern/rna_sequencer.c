@@ -1134,6 +1134,70 @@ static void rna_SequenceEditor_overlay_frame_set(PointerRNA *ptr, int value)
   }
 }
 
+static int rna_SequenceEditor_cache_hit_count_get(PointerRNA *ptr)
+{
+  SeqCacheStatistics stats;
+  SEQ_cache_statistics_get((Scene *)ptr->owner_id, &stats);
+  return stats.hit_count;
+}
+
+static int rna_SequenceEditor_cache_miss_count_get(PointerRNA *ptr)
+{
+  SeqCacheStatistics stats;
+  SEQ_cache_statistics_get((Scene *)ptr->owner_id, &stats);
+  return stats.miss_count;
+}
+
+static float rna_SequenceEditor_cache_hit_rate_get(PointerRNA *ptr)
+{
+  SeqCacheStatistics stats;
+  SEQ_cache_statistics_get((Scene *)ptr->owner_id, &stats);
+  const int lookup_count = stats.hit_count + stats.miss_count;
+  return lookup_count > 0 ? (float)stats.hit_count / lookup_count : 0.0f;
+}
+
+static float rna_SequenceEditor_cache_memory_get(PointerRNA *ptr, const int type)
+{
+  SeqCacheStatistics stats;
+  SEQ_cache_statistics_get((Scene *)ptr->owner_id, &stats);
+  size_t size = 0;
+  switch (type) {
+    case SEQ_CACHE_STORE_RAW:
+      size = stats.raw_size;
+      break;
+    case SEQ_CACHE_STORE_PREPROCESSED:
+      size = stats.preprocessed_size;
+      break;
+    case SEQ_CACHE_STORE_COMPOSITE:
+      size = stats.composite_size;
+      break;
+    case SEQ_CACHE_STORE_FINAL_OUT:
+      size = stats.final_size;
+      break;
+  }
+  return size / (1024.0f * 1024.0f);
+}
+
+static float rna_SequenceEditor_cache_memory_raw_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_cache_memory_get(ptr, SEQ_CACHE_STORE_RAW);
+}
+
+static float rna_SequenceEditor_cache_memory_preprocessed_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_cache_memory_get(ptr, SEQ_CACHE_STORE_PREPROCESSED);
+}
+
+static float rna_SequenceEditor_cache_memory_composite_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_cache_memory_get(ptr, SEQ_CACHE_STORE_COMPOSITE);
+}
+
+static float rna_SequenceEditor_cache_memory_final_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_cache_memory_get(ptr, SEQ_CACHE_STORE_FINAL_OUT);
+}
+
 static void rna_SequenceEditor_display_stack(ID *id,
                                              Editing *ed,
                                              ReportList *reports,
@@ -2315,6 +2379,54 @@ static void rna_def_editor(BlenderRNA *brna)
       "Render frames ahead of current frame in the background for faster playback");
   RNA_def_property_update(prop, NC_SCENE | ND_SEQUENCER, NULL);
 
+  /* cache statistics */
+
+  prop = RNA_def_property(srna, "cache_hit_count", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_SequenceEditor_cache_hit_count_get", NULL, NULL);
+  RNA_def_property_ui_text(
+      prop, "Cache Hits", "Number of images found in memory cache since it was last cleared");
+
+  prop = RNA_def_property(srna, "cache_miss_count", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_SequenceEditor_cache_miss_count_get", NULL, NULL);
+  RNA_def_property_ui_text(prop,
+                           "Cache Misses",
+                           "Number of images not found in memory cache since it was last cleared");
+
+  prop = RNA_def_property(srna, "cache_hit_rate", PROP_FLOAT, PROP_FACTOR);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(prop, "rna_SequenceEditor_cache_hit_rate_get", NULL, NULL);
+  RNA_def_property_ui_text(
+      prop, "Cache Hit Rate", "Fraction of memory cache lookups that found an image");
+
+  prop = RNA_def_property(srna, "cache_memory_raw", PROP_FLOAT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(prop, "rna_SequenceEditor_cache_memory_raw_get", NULL, NULL);
+  RNA_def_property_ui_text(
+      prop, "Raw Images Memory", "Memory (in megabytes) used by cached raw images");
+
+  prop = RNA_def_property(srna, "cache_memory_preprocessed", PROP_FLOAT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(
+      prop, "rna_SequenceEditor_cache_memory_preprocessed_get", NULL, NULL);
+  RNA_def_property_ui_text(prop,
+                           "Pre-processed Images Memory",
+                           "Memory (in megabytes) used by cached pre-processed images");
+
+  prop = RNA_def_property(srna, "cache_memory_composite", PROP_FLOAT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(prop, "rna_SequenceEditor_cache_memory_composite_get", NULL, NULL);
+  RNA_def_property_ui_text(prop,
+                           "Composite Images Memory",
+                           "Memory (in megabytes) used by cached composite images");
+
+  prop = RNA_def_property(srna, "cache_memory_final", PROP_FLOAT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(prop, "rna_SequenceEditor_cache_memory_final_get", NULL, NULL);
+  RNA_def_property_ui_text(
+      prop, "Final Images Memory", "Memory (in megabytes) used by cached final images");
+
   /* functions */
 
   func = RNA_def_function(srna, "display_stack", "rna_SequenceEditor_display_stack");
@@ -5459,6 +5459,14 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, NULL, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  prop = RNA_def_property(srna, "use_sequencer_hardware_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "sequencer_flag", USER_SEQ_USE_HARDWARE_DECODING);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Decoding",
+                           "Decode movie strips using the GPU video decoder when it is available, "
+                           "otherwise software decoding is used. Takes effect when movies are "
+                           "reloaded");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -6304,6 +6312,15 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       "Undo Legacy",
       "Use legacy undo (slower than the new default one, but may be more stable in some cases)");
 
+  prop = RNA_def_property(srna, "use_undo_skip_unchanged_ids", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_skip_unchanged_ids", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Skip Unchanged Data",
+                           "Reuse the undo memory of data-blocks that have not been tagged for "
+                           "update since the previous undo step, instead of writing them again "
+                           "(faster undo pushes in big scenes, but changes that do not tag the "
+                           "data-block for update may not be undone)");
+
   prop = RNA_def_property(srna, "override_auto_resync", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(prop, NULL, "no_override_auto_resync", 1);
   RNA_def_property_ui_text(
@@ -6344,6 +6361,13 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, NULL, "use_realtime_compositor", 1);
   RNA_def_property_ui_text(prop, "Realtime Compositor", "Enable the new realtime compositor");
 
+  prop = RNA_def_property(srna, "use_gpu_field_evaluation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_gpu_field_evaluation", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Field Evaluation",
+                           "Evaluate large geometry nodes fields made of math and texture nodes "
+                           "with compute shaders");
+
   prop = RNA_def_property(srna, "use_sculpt_texture_paint", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "use_sculpt_texture_paint", 1);
   RNA_def_property_ui_text(prop, "Sculpt Texture Paint", "Use texture painting in Sculpt Mode");
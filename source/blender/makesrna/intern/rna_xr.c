@@ -2032,6 +2032,14 @@ static void rna_def_xr_session_settings(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Clip End", "VR viewport far clipping distance");
   RNA_def_property_update(prop, NC_WM | ND_XR_DATA_CHANGED, NULL);
 
+  prop = RNA_def_property(srna, "resolution_scale", PROP_FLOAT, PROP_FACTOR);
+  RNA_def_property_range(prop, 0.25f, 1.0f);
+  RNA_def_property_ui_text(prop,
+                           "Resolution Scale",
+                           "Fraction of the resolution recommended by the VR runtime to draw the "
+                           "views with, the runtime scales them up to the display resolution");
+  RNA_def_property_update(prop, NC_WM | ND_XR_DATA_CHANGED, NULL);
+
   prop = RNA_def_property(srna, "use_positional_tracking", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_funcs(prop,
                                  "rna_XrSessionSettings_use_positional_tracking_get",
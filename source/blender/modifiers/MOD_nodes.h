@@ -17,6 +17,26 @@ extern "C" {
  */
 void MOD_nodes_update_interface(struct Object *object, struct NodesModifierData *nmd);
 
+/**
+ * Write the node execution traces logged during the last evaluation of the modifier, in the
+ * Chrome trace event JSON format. Returns false when nothing has been logged for the modifier or
+ * the file could not be written.
+ */
+bool MOD_nodes_execution_traces_write(const struct NodesModifierData *nmd, const char *filepath);
+
+/**
+ * Absolute path of the directory the baked frames of the modifier are stored in: a sub-directory
+ * of #NodesModifierData.bake_directory per object and modifier, so that the bakes of different
+ * modifiers don't overwrite each other.
+ *
+ * \param relbase: The path relative paths are relative to, see #BKE_modifier_path_relbase.
+ * \param r_directory: Output of size #FILE_MAX.
+ */
+void MOD_nodes_bake_directory_get(const struct Object *object,
+                                  const struct NodesModifierData *nmd,
+                                  const char *relbase,
+                                  char *r_directory);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,8 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.h"
 
@@ -17,6 +19,7 @@
 #include "DNA_object_types.h"
 #include "DNA_screen_types.h"
 
+#include "BKE_bvhutils.h"
 #include "BKE_context.h"
 #include "BKE_customdata.h"
 #include "BKE_data_transfer.h"
@@ -149,6 +152,74 @@ static bool isDisabled(const struct Scene * /*scene*/, ModifierData *md, bool /*
   (DT_TYPE_BWEIGHT_VERT | DT_TYPE_BWEIGHT_EDGE | DT_TYPE_CREASE | DT_TYPE_SHARP_EDGE | \
    DT_TYPE_LNOR | DT_TYPE_SHARP_FACE)
 
+/**
+ * The BVH-tree of the source mesh that the mapping of one element type searches, or
+ * #BVHTREE_MAX_ITEM if the mode doesn't use a cached tree.
+ */
+static BVHCacheType source_bvh_tree_type(const int map_mode)
+{
+  if (map_mode == MREMAP_MODE_TOPOLOGY) {
+    return BVHTREE_MAX_ITEM;
+  }
+  if (map_mode & MREMAP_MODE_LOOP) {
+    return (map_mode & MREMAP_USE_VERT) ? BVHTREE_FROM_VERTS : BVHTREE_FROM_LOOPTRI;
+  }
+  if (map_mode == MREMAP_MODE_EDGE_EDGEINTERP_VNORPROJ) {
+    return BVHTREE_FROM_EDGES;
+  }
+  if (map_mode & MREMAP_USE_POLY) {
+    return BVHTREE_FROM_LOOPTRI;
+  }
+  if (map_mode & MREMAP_USE_EDGE) {
+    return BVHTREE_FROM_EDGES;
+  }
+  if (map_mode & MREMAP_USE_VERT) {
+    return BVHTREE_FROM_VERTS;
+  }
+  return BVHTREE_MAX_ITEM;
+}
+
+/**
+ * Build the BVH-trees that the mapping uses in parallel, before the data transfer looks them up
+ * one after another. The trees are stored in the BVH cache of the evaluated source mesh, so they
+ * are shared with all other modifiers that transfer data from the same object.
+ */
+static void ensure_source_bvh_trees(const DataTransferModifierData *dtmd)
+{
+  using namespace blender;
+  const Mesh *me_source = BKE_modifier_get_evaluated_mesh_from_evaluated_object(dtmd->ob_source);
+  if (me_source == nullptr) {
+    return;
+  }
+
+  const int item_types = BKE_object_data_transfer_get_dttypes_item_types(dtmd->data_types);
+  Vector<BVHCacheType, 4> tree_types;
+  auto add_tree_type = [&](const int item_type, const int map_mode) {
+    if (item_types & item_type) {
+      const BVHCacheType tree_type = source_bvh_tree_type(map_mode);
+      if (tree_type != BVHTREE_MAX_ITEM) {
+        tree_types.append_non_duplicates(tree_type);
+      }
+    }
+  };
+  add_tree_type(ME_VERT, dtmd->vmap_mode);
+  add_tree_type(ME_EDGE, dtmd->emap_mode);
+  add_tree_type(ME_LOOP, dtmd->lmap_mode);
+  add_tree_type(ME_POLY, dtmd->pmap_mode);
+  if (tree_types.size() < 2) {
+    /* A single tree is built by the mapping anyway. */
+    return;
+  }
+
+  threading::parallel_for(tree_types.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      BVHTreeFromMesh treedata = {nullptr};
+      BKE_bvhtree_from_mesh_get(&treedata, me_source, tree_types[i], 2);
+      free_bvhtree_from_mesh(&treedata);
+    }
+  });
+}
+
 static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *me_mod)
 {
   DataTransferModifierData *dtmd = (DataTransferModifierData *)md;
@@ -189,6 +260,8 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
 
   BKE_reports_init(&reports, RPT_STORE);
 
+  ensure_source_bvh_trees(dtmd);
+
   /* NOTE: no islands precision for now here. */
   if (BKE_object_data_transfer_ex(ctx->depsgraph,
                                   scene,
@@ -90,7 +90,7 @@ static void requiredDataMask(ModifierData *md, CustomData_MeshMasks *r_cddata_ma
 static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *psmd, Mesh *mesh)
 {
   ParticleSystem *psys = psmd->psys;
-  MFace *fa = NULL, *mface = NULL;
+  const MFace *fa = NULL, *mface = NULL;
   MVert *mvert = NULL;
   ParticleData *pa;
   KDTree_3d *tree;
@@ -101,7 +101,7 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
   const bool invert_vgroup = (emd->flag & eExplodeFlag_INVERT_VGROUP) != 0;
 
   mvert = BKE_mesh_verts_for_write(mesh);
-  mface = (MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  mface = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
   totvert = mesh->totvert;
   totface = mesh->totface;
   totpart = psmd->psys->totpart;
@@ -214,9 +214,9 @@ static const short add_faces[24] = {
     0, 0, 0, 2, 0, 1, 2, 2, 0, 2, 1, 2, 2, 2, 2, 3, 0, 0, 0, 1, 0, 1, 1, 2,
 };
 
-static MFace *get_dface(Mesh *mesh, Mesh *split, int cur, int i, MFace *mf)
+static MFace *get_dface(Mesh *mesh, Mesh *split, int cur, int i, const MFace *mf)
 {
-  MFace *mfaces = CustomData_get_layer(&split->fdata, CD_MFACE);
+  MFace *mfaces = CustomData_get_layer_for_write(&split->fdata, CD_MFACE, split->totface);
   MFace *df = &mfaces[cur];
   CustomData_copy_data(&mesh->fdata, &split->fdata, i, cur, 1);
   *df = *mf;
@@ -241,7 +241,7 @@ static MFace *get_dface(Mesh *mesh, Mesh *split, int cur, int i, MFace *mf)
 
 static void remap_faces_3_6_9_12(Mesh *mesh,
                                  Mesh *split,
-                                 MFace *mf,
+                                 const MFace *mf,
                                  int *facepa,
                                  const int *vertpa,
                                  int i,
@@ -281,12 +281,13 @@ static void remap_faces_3_6_9_12(Mesh *mesh,
 static void remap_uvs_3_6_9_12(
     Mesh *mesh, Mesh *split, int layers_num, int i, int cur, int c0, int c1, int c2, int c3)
 {
-  MTFace *mf, *df1, *df2, *df3;
+  const MTFace *mf;
+  MTFace *df1, *df2, *df3;
   int l;
 
   for (l = 0; l < layers_num; l++) {
-    mf = CustomData_get_layer_n(&split->fdata, CD_MTFACE, l);
-    df1 = mf + cur;
+    df1 = CustomData_get_layer_n_for_write(&split->fdata, CD_MTFACE, l, split->totface);
+    df1 += cur;
     df2 = df1 + 1;
     df3 = df1 + 2;
     mf = CustomData_get_layer_n(&mesh->fdata, CD_MTFACE, l);
@@ -309,7 +310,7 @@ static void remap_uvs_3_6_9_12(
 
 static void remap_faces_5_10(Mesh *mesh,
                              Mesh *split,
-                             MFace *mf,
+                             const MFace *mf,
                              int *facepa,
                              const int *vertpa,
                              int i,
@@ -341,12 +342,13 @@ static void remap_faces_5_10(Mesh *mesh,
 static void remap_uvs_5_10(
     Mesh *mesh, Mesh *split, int layers_num, int i, int cur, int c0, int c1, int c2, int c3)
 {
-  MTFace *mf, *df1, *df2;
+  const MTFace *mf;
+  MTFace *df1, *df2;
   int l;
 
   for (l = 0; l < layers_num; l++) {
-    mf = CustomData_get_layer_n(&split->fdata, CD_MTFACE, l);
-    df1 = mf + cur;
+    df1 = CustomData_get_layer_n_for_write(&split->fdata, CD_MTFACE, l, split->totface);
+    df1 += cur;
     df2 = df1 + 1;
     mf = CustomData_get_layer_n(&mesh->fdata, CD_MTFACE, l);
     mf += i;
@@ -365,7 +367,7 @@ static void remap_uvs_5_10(
 
 static void remap_faces_15(Mesh *mesh,
                            Mesh *split,
-                           MFace *mf,
+                           const MFace *mf,
                            int *facepa,
                            const int *vertpa,
                            int i,
@@ -413,12 +415,13 @@ static void remap_faces_15(Mesh *mesh,
 static void remap_uvs_15(
     Mesh *mesh, Mesh *split, int layers_num, int i, int cur, int c0, int c1, int c2, int c3)
 {
-  MTFace *mf, *df1, *df2, *df3, *df4;
+  const MTFace *mf;
+  MTFace *df1, *df2, *df3, *df4;
   int l;
 
   for (l = 0; l < layers_num; l++) {
-    mf = CustomData_get_layer_n(&split->fdata, CD_MTFACE, l);
-    df1 = mf + cur;
+    df1 = CustomData_get_layer_n_for_write(&split->fdata, CD_MTFACE, l, split->totface);
+    df1 += cur;
     df2 = df1 + 1;
     df3 = df1 + 2;
     df4 = df1 + 3;
@@ -449,7 +452,7 @@ static void remap_uvs_15(
 
 static void remap_faces_7_11_13_14(Mesh *mesh,
                                    Mesh *split,
-                                   MFace *mf,
+                                   const MFace *mf,
                                    int *facepa,
                                    const int *vertpa,
                                    int i,
@@ -489,12 +492,13 @@ static void remap_faces_7_11_13_14(Mesh *mesh,
 static void remap_uvs_7_11_13_14(
     Mesh *mesh, Mesh *split, int layers_num, int i, int cur, int c0, int c1, int c2, int c3)
 {
-  MTFace *mf, *df1, *df2, *df3;
+  const MTFace *mf;
+  MTFace *df1, *df2, *df3;
   int l;
 
   for (l = 0; l < layers_num; l++) {
-    mf = CustomData_get_layer_n(&split->fdata, CD_MTFACE, l);
-    df1 = mf + cur;
+    df1 = CustomData_get_layer_n_for_write(&split->fdata, CD_MTFACE, l, split->totface);
+    df1 += cur;
     df2 = df1 + 1;
     df3 = df1 + 2;
     mf = CustomData_get_layer_n(&mesh->fdata, CD_MTFACE, l);
@@ -518,7 +522,7 @@ static void remap_uvs_7_11_13_14(
 
 static void remap_faces_19_21_22(Mesh *mesh,
                                  Mesh *split,
-                                 MFace *mf,
+                                 const MFace *mf,
                                  int *facepa,
                                  const int *vertpa,
                                  int i,
@@ -549,12 +553,13 @@ static void remap_faces_19_21_22(Mesh *mesh,
 static void remap_uvs_19_21_22(
     Mesh *mesh, Mesh *split, int layers_num, int i, int cur, int c0, int c1, int c2)
 {
-  MTFace *mf, *df1, *df2;
+  const MTFace *mf;
+  MTFace *df1, *df2;
   int l;
 
   for (l = 0; l < layers_num; l++) {
-    mf = CustomData_get_layer_n(&split->fdata, CD_MTFACE, l);
-    df1 = mf + cur;
+    df1 = CustomData_get_layer_n_for_write(&split->fdata, CD_MTFACE, l, split->totface);
+    df1 += cur;
     df2 = df1 + 1;
     mf = CustomData_get_layer_n(&mesh->fdata, CD_MTFACE, l);
     mf += i;
@@ -572,7 +577,7 @@ static void remap_uvs_19_21_22(
 
 static void remap_faces_23(Mesh *mesh,
                            Mesh *split,
-                           MFace *mf,
+                           const MFace *mf,
                            int *facepa,
                            const int *vertpa,
                            int i,
@@ -611,12 +616,13 @@ static void remap_faces_23(Mesh *mesh,
 static void remap_uvs_23(
     Mesh *mesh, Mesh *split, int layers_num, int i, int cur, int c0, int c1, int c2)
 {
-  MTFace *mf, *df1, *df2;
+  const MTFace *mf;
+  MTFace *df1, *df2;
   int l;
 
   for (l = 0; l < layers_num; l++) {
-    mf = CustomData_get_layer_n(&split->fdata, CD_MTFACE, l);
-    df1 = mf + cur;
+    df1 = CustomData_get_layer_n_for_write(&split->fdata, CD_MTFACE, l, split->totface);
+    df1 += cur;
     df2 = df1 + 1;
     mf = CustomData_get_layer_n(&mesh->fdata, CD_MTFACE, l);
     mf += i;
@@ -639,8 +645,9 @@ static void remap_uvs_23(
 static Mesh *cutEdges(ExplodeModifierData *emd, Mesh *mesh)
 {
   Mesh *split_m;
-  MFace *mf = NULL, *df1 = NULL;
-  MFace *mface = CustomData_get_layer(&mesh->fdata, CD_MFACE);
+  const MFace *mf = NULL;
+  MFace *df1 = NULL;
+  const MFace *mface = CustomData_get_layer(&mesh->fdata, CD_MFACE);
   MVert *dupve, *mv;
   EdgeHash *edgehash;
   EdgeHashIterator *ehi;
@@ -880,10 +887,11 @@ static Mesh *cutEdges(ExplodeModifierData *emd, Mesh *mesh)
     curdupface += add_faces[*fs] + 1;
   }
 
-  MFace *split_mface = CustomData_get_layer(&split_m->fdata, CD_MFACE);
+  MFace *split_mface = CustomData_get_layer_for_write(
+      &split_m->fdata, CD_MFACE, split_m->totface);
   for (i = 0; i < curdupface; i++) {
-    mf = &split_mface[i];
-    BKE_mesh_mface_index_validate(mf, &split_m->fdata, i, ((mf->flag & ME_FACE_SEL) ? 4 : 3));
+    MFace *df = &split_mface[i];
+    BKE_mesh_mface_index_validate(df, &split_m->fdata, i, ((df->flag & ME_FACE_SEL) ? 4 : 3));
   }
 
   BLI_edgehash_free(edgehash, NULL);
@@ -902,7 +910,8 @@ static Mesh *explodeMesh(ExplodeModifierData *emd,
                          Mesh *to_explode)
 {
   Mesh *explode, *mesh = to_explode;
-  MFace *mf = NULL, *mface;
+  MFace *mf = NULL;
+  const MFace *mface;
   // ParticleSettings *part=psmd->psys->part; /* UNUSED */
   ParticleSimulationData sim = {NULL};
   ParticleData *pa = NULL, *pars = psmd->psys->particles;
@@ -960,14 +969,14 @@ static Mesh *explodeMesh(ExplodeModifierData *emd,
       mindex = totvert + facepa[i];
     }
 
-    mf = &mface[i];
+    const MFace *face = &mface[i];
 
     /* set face vertices to exist in particle group */
-    BLI_edgehash_reinsert(vertpahash, mf->v1, mindex, NULL);
-    BLI_edgehash_reinsert(vertpahash, mf->v2, mindex, NULL);
-    BLI_edgehash_reinsert(vertpahash, mf->v3, mindex, NULL);
-    if (mf->v4) {
-      BLI_edgehash_reinsert(vertpahash, mf->v4, mindex, NULL);
+    BLI_edgehash_reinsert(vertpahash, face->v1, mindex, NULL);
+    BLI_edgehash_reinsert(vertpahash, face->v2, mindex, NULL);
+    BLI_edgehash_reinsert(vertpahash, face->v3, mindex, NULL);
+    if (face->v4) {
+      BLI_edgehash_reinsert(vertpahash, face->v4, mindex, NULL);
     }
   }
 
@@ -982,7 +991,8 @@ static Mesh *explodeMesh(ExplodeModifierData *emd,
   /* the final duplicated vertices */
   explode = BKE_mesh_new_nomain_from_template(mesh, totdup, 0, totface - delface, 0, 0);
 
-  MTFace *mtface = CustomData_get_layer_named(&explode->fdata, CD_MTFACE, emd->uvname);
+  MTFace *mtface = CustomData_get_layer_named_for_write(
+      &explode->fdata, CD_MTFACE, emd->uvname, explode->totface);
 
   /* getting back to object space */
   invert_m4_m4(imat, ctx->object->obmat);
@@ -1043,7 +1053,8 @@ static Mesh *explodeMesh(ExplodeModifierData *emd,
   BLI_edgehashIterator_free(ehi);
 
   /* Map new vertices to faces. */
-  MFace *explode_mface = CustomData_get_layer(&explode->fdata, CD_MFACE);
+  MFace *explode_mface = CustomData_get_layer_for_write(
+      &explode->fdata, CD_MFACE, explode->totface);
   for (i = 0, u = 0; i < totface; i++) {
     MFace source;
     int orig_v4;
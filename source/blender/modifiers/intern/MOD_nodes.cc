@@ -12,9 +12,11 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array.hh"
+#include "BLI_fileops.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_multi_value_map.hh"
+#include "BLI_path_util.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_string_search.h"
@@ -40,6 +42,7 @@
 #include "BKE_compute_contexts.hh"
 #include "BKE_customdata.h"
 #include "BKE_geometry_fields.hh"
+#include "BKE_geometry_set_bake.hh"
 #include "BKE_geometry_set_instances.hh"
 #include "BKE_global.h"
 #include "BKE_idprop.hh"
@@ -124,6 +127,7 @@ using blender::fn::ValueOrField;
 using blender::fn::ValueOrFieldCPPType;
 using blender::nodes::FieldInferencingInterface;
 using blender::nodes::GeoNodeExecParams;
+using blender::nodes::GeometryNodesCache;
 using blender::nodes::InputSocketFieldType;
 using blender::nodes::geo_eval_log::GeoModifierLog;
 using blender::threading::EnumerableThreadSpecific;
@@ -352,6 +356,9 @@ static bool check_tree_for_time_node(const bNodeTree &tree,
 static bool dependsOnTime(struct Scene * /*scene*/, ModifierData *md)
 {
   const NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
+  if (nmd->flag & NODES_MODIFIER_BAKED) {
+    return true;
+  }
   const bNodeTree *tree = nmd->node_group;
   if (tree == nullptr) {
     return false;
@@ -770,6 +777,20 @@ void MOD_nodes_update_interface(Object *object, NodesModifierData *nmd)
   DEG_id_tag_update(&object->id, ID_RECALC_GEOMETRY);
 }
 
+bool MOD_nodes_execution_traces_write(const NodesModifierData *nmd, const char *filepath)
+{
+  if (nmd->runtime_eval_log == nullptr) {
+    return false;
+  }
+  blender::fstream stream(filepath, std::ios::out | std::ios::trunc);
+  if (!stream.is_open()) {
+    return false;
+  }
+  GeoModifierLog &modifier_log = *static_cast<GeoModifierLog *>(nmd->runtime_eval_log);
+  modifier_log.write_node_execution_traces(stream);
+  return stream.good();
+}
+
 static void initialize_group_input(NodesModifierData &nmd,
                                    const bNodeSocket &interface_socket,
                                    const int input_index,
@@ -939,6 +960,35 @@ static void clear_runtime_data(NodesModifierData *nmd)
     delete static_cast<GeoModifierLog *>(nmd->runtime_eval_log);
     nmd->runtime_eval_log = nullptr;
   }
+  if (nmd->runtime_cache != nullptr) {
+    delete static_cast<GeometryNodesCache *>(nmd->runtime_cache);
+    nmd->runtime_cache = nullptr;
+  }
+}
+
+/**
+ * The cache is stored on the original modifier, so that it persists when the evaluated copy is
+ * recreated. Like the evaluation log, it is only used for the active depsgraph.
+ */
+static GeometryNodesCache *ensure_node_cache(NodesModifierData &nmd,
+                                             const ModifierEvalContext &ctx)
+{
+  if (!logging_enabled(&ctx)) {
+    return nullptr;
+  }
+  NodesModifierData *nmd_orig = reinterpret_cast<NodesModifierData *>(
+      BKE_modifier_get_original(ctx.object, &nmd.modifier));
+  if (nmd.cache_memory_limit <= 0) {
+    delete static_cast<GeometryNodesCache *>(nmd_orig->runtime_cache);
+    nmd_orig->runtime_cache = nullptr;
+    return nullptr;
+  }
+  if (nmd_orig->runtime_cache == nullptr) {
+    nmd_orig->runtime_cache = new GeometryNodesCache();
+  }
+  GeometryNodesCache *cache = static_cast<GeometryNodesCache *>(nmd_orig->runtime_cache);
+  cache->begin_evaluation(int64_t(nmd.cache_memory_limit) * 1024 * 1024);
+  return cache;
 }
 
 struct OutputAttributeInfo {
@@ -1171,6 +1221,17 @@ static GeometrySet compute_geometry(
     param_outputs[i] = {type, buffer};
   }
 
+  Map<const bNode *, blender::ComputeContextHash> cache_keys;
+  if (GeometryNodesCache *cache = ensure_node_cache(*nmd, *ctx)) {
+    Array<GPointer> group_inputs(param_inputs.size());
+    for (const int i : param_inputs.index_range()) {
+      group_inputs[i] = param_inputs[i];
+    }
+    cache_keys = blender::nodes::compute_node_cache_keys(btree, group_inputs);
+    geo_nodes_modifier_data.cache = cache;
+    geo_nodes_modifier_data.cache_keys = &cache_keys;
+  }
+
   lf::Context lf_context;
   lf_context.storage = graph_executor.init_storage(allocator);
   lf_context.user_data = &user_data;
@@ -1250,11 +1311,67 @@ static void check_property_socket_sync(const Object *ob, ModifierData *md)
   }
 }
 
-static void modifyGeometry(ModifierData *md,
-                           const ModifierEvalContext *ctx,
-                           GeometrySet &geometry_set)
+void MOD_nodes_bake_directory_get(const Object *object,
+                                  const NodesModifierData *nmd,
+                                  const char *relbase,
+                                  char *r_directory)
+{
+  char object_name[MAX_ID_NAME];
+  char modifier_name[MAX_NAME];
+  STRNCPY(object_name, object->id.name + 2);
+  STRNCPY(modifier_name, nmd->modifier.name);
+  BLI_filename_make_safe(object_name);
+  BLI_filename_make_safe(modifier_name);
+
+  char directory[FILE_MAX];
+  STRNCPY(directory, nmd->bake_directory);
+  BLI_path_abs(directory, relbase);
+  BLI_path_join(r_directory, FILE_MAX, directory, object_name, modifier_name, nullptr);
+}
+
+static void bake_frame_filepath(const NodesModifierData &nmd,
+                                const ModifierEvalContext &ctx,
+                                char r_filepath[FILE_MAX])
+{
+  char directory[FILE_MAX];
+  MOD_nodes_bake_directory_get(
+      ctx.object, &nmd, BKE_modifier_path_relbase_from_global(ctx.object), directory);
+  const int frame = int(roundf(DEG_get_ctime(ctx.depsgraph)));
+  char filename[32];
+  SNPRINTF(filename, "%06d.gnbake", frame);
+  BLI_path_join(r_filepath, FILE_MAX, directory, filename, nullptr);
+}
+
+static ID *find_baked_id(const Depsgraph &depsgraph,
+                         const StringRefNull id_name,
+                         const StringRefNull library_name)
+{
+  if (id_name.size() <= 2) {
+    return nullptr;
+  }
+  /* Names are only unique per library, so the library has to match as well. */
+  ListBase *lb = which_libbase(DEG_get_bmain(&depsgraph), GS(id_name.c_str()));
+  if (lb == nullptr) {
+    return nullptr;
+  }
+  LISTBASE_FOREACH (ID *, id, lb) {
+    if (!STREQ(id->name, id_name.c_str())) {
+      continue;
+    }
+    const char *id_library_name = id->lib ? id->lib->id.name + 2 : "";
+    if (STREQ(id_library_name, library_name.c_str())) {
+      return DEG_get_evaluated_id(&depsgraph, id);
+    }
+  }
+  return nullptr;
+}
+
+static void evaluate_node_group(ModifierData *md,
+                                const ModifierEvalContext *ctx,
+                                GeometrySet &geometry_set)
 {
   NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
+
   if (nmd->node_group == nullptr) {
     return;
   }
@@ -1292,6 +1409,24 @@ static void modifyGeometry(ModifierData *md,
     return;
   }
 
+  geometry_set = compute_geometry(
+      tree, *lf_graph_info, *output_node, std::move(geometry_set), nmd, ctx);
+
+  if (nmd->flag & NODES_MODIFIER_BAKE_WRITE) {
+    char filepath[FILE_MAX];
+    bake_frame_filepath(*nmd, *ctx, filepath);
+    if (!blender::bke::geometry_set_bake_write(geometry_set, filepath)) {
+      BKE_modifier_set_error(ctx->object, md, "Cannot write bake file");
+    }
+  }
+}
+
+static void modifyGeometry(ModifierData *md,
+                           const ModifierEvalContext *ctx,
+                           GeometrySet &geometry_set)
+{
+  NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
+
   bool use_orig_index_verts = false;
   bool use_orig_index_edges = false;
   bool use_orig_index_polys = false;
@@ -1302,8 +1437,22 @@ static void modifyGeometry(ModifierData *md,
     use_orig_index_polys = CustomData_has_layer(&mesh.pdata, CD_ORIGINDEX);
   }
 
-  geometry_set = compute_geometry(
-      tree, *lf_graph_info, *output_node, std::move(geometry_set), nmd, ctx);
+  std::optional<GeometrySet> baked_geometry;
+  if (nmd->flag & NODES_MODIFIER_BAKED) {
+    char filepath[FILE_MAX];
+    bake_frame_filepath(*nmd, *ctx, filepath);
+    baked_geometry = blender::bke::geometry_set_bake_read(
+        filepath, [&](const StringRefNull id_name, const StringRefNull library_name) {
+          return find_baked_id(*ctx->depsgraph, id_name, library_name);
+        });
+  }
+  if (baked_geometry) {
+    geometry_set = std::move(*baked_geometry);
+  }
+  else {
+    /* Frames outside of the baked range are evaluated as usual. */
+    evaluate_node_group(md, ctx, geometry_set);
+  }
 
   if (geometry_set.has_mesh()) {
     /* Add #CD_ORIGINDEX layers if they don't exist already. This is required because the
@@ -1802,6 +1951,63 @@ static void internal_dependencies_panel_draw(const bContext * /*C*/, Panel *pane
   }
 }
 
+static void cache_panel_draw(const bContext * /*C*/, Panel *panel)
+{
+  uiLayout *layout = panel->layout;
+
+  PointerRNA *ptr = modifier_panel_get_property_pointers(panel, nullptr);
+  NodesModifierData *nmd = static_cast<NodesModifierData *>(ptr->data);
+
+  uiLayoutSetPropSep(layout, true);
+  uiItemR(layout, ptr, "cache_memory_limit", 0, nullptr, ICON_NONE);
+
+  const GeometryNodesCache *cache = static_cast<const GeometryNodesCache *>(nmd->runtime_cache);
+  if (cache == nullptr) {
+    return;
+  }
+  const GeometryNodesCache::Statistics statistics = cache->statistics();
+  char memory_str[15];
+  BLI_str_format_byte_unit(memory_str, statistics.memory, true);
+
+  uiLayout *col = uiLayoutColumn(layout, true);
+  uiLayoutSetActive(col, false);
+  char line[256];
+  SNPRINTF(line, TIP_("Reused: %d, Computed: %d"), statistics.hits, statistics.misses);
+  uiItemL(col, line, ICON_NONE);
+  SNPRINTF(line, TIP_("Memory: %s in %d outputs"), memory_str, statistics.entries_num);
+  uiItemL(col, line, ICON_NONE);
+}
+
+static void bake_panel_draw(const bContext * /*C*/, Panel *panel)
+{
+  uiLayout *layout = panel->layout;
+
+  PointerRNA *ptr = modifier_panel_get_property_pointers(panel, nullptr);
+
+  uiLayoutSetPropSep(layout, true);
+
+  const bool is_baked = RNA_boolean_get(ptr, "is_baked");
+  if (is_baked) {
+    PointerRNA op_ptr;
+    uiItemFullO(layout,
+                "OBJECT_OT_geometry_nodes_bake",
+                IFACE_("Delete Bake"),
+                ICON_NONE,
+                nullptr,
+                WM_OP_EXEC_DEFAULT,
+                0,
+                &op_ptr);
+    RNA_boolean_set(&op_ptr, "free", true);
+  }
+  else {
+    uiItemO(layout, nullptr, ICON_NONE, "OBJECT_OT_geometry_nodes_bake");
+  }
+
+  uiLayout *col = uiLayoutColumn(layout, false);
+  uiLayoutSetEnabled(col, !is_baked);
+  uiItemR(col, ptr, "bake_directory", 0, IFACE_("Directory"), ICON_NONE);
+}
+
 static void panelRegister(ARegionType *region_type)
 {
   PanelType *panel_type = modifier_panel_register(region_type, eModifierType_Nodes, panel_draw);
@@ -1817,6 +2023,10 @@ static void panelRegister(ARegionType *region_type)
                              nullptr,
                              internal_dependencies_panel_draw,
                              panel_type);
+  modifier_subpanel_register(
+      region_type, "cache", N_("Cache"), nullptr, cache_panel_draw, panel_type);
+  modifier_subpanel_register(
+      region_type, "bake", N_("Bake"), nullptr, bake_panel_draw, panel_type);
 }
 
 static void blendWrite(BlendWriter *writer, const ID * /*id_owner*/, const ModifierData *md)
@@ -1842,7 +2052,9 @@ static void blendRead(BlendDataReader *reader, ModifierData *md)
     BLO_read_data_address(reader, &nmd->settings.properties);
     IDP_BlendDataRead(reader, &nmd->settings.properties);
   }
+  nmd->flag &= ~NODES_MODIFIER_BAKE_WRITE;
   nmd->runtime_eval_log = nullptr;
+  nmd->runtime_cache = nullptr;
 }
 
 static void copyData(const ModifierData *md, ModifierData *target, const int flag)
@@ -1853,6 +2065,7 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   BKE_modifier_copydata_generic(md, target, flag);
 
   tnmd->runtime_eval_log = nullptr;
+  tnmd->runtime_cache = nullptr;
 
   if (nmd->settings.properties != nullptr) {
     tnmd->settings.properties = IDP_CopyProperty_ex(nmd->settings.properties, flag);
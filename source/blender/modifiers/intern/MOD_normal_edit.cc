@@ -175,12 +175,13 @@ static void mix_normals(const float mix_factor,
 static bool polygons_check_flip(MLoop *mloop,
                                 float (*nos)[3],
                                 CustomData *ldata,
+                                const int loops_num,
                                 const MPoly *mpoly,
                                 float (*polynors)[3],
                                 const int polys_num)
 {
   const MPoly *mp;
-  MDisps *mdisp = static_cast<MDisps *>(CustomData_get_layer(ldata, CD_MDISPS));
+  MDisps *mdisp = nullptr;
   int i;
   bool flipped = false;
 
@@ -199,6 +200,12 @@ static bool polygons_check_flip(MLoop *mloop,
 
     /* If average of new loop normals is opposed to polygon normal, flip polygon. */
     if (dot_v3v3(polynors[i], norsum) < 0.0f) {
+      if (!flipped) {
+        /* Flipping swaps data in every loop layer, none of them may be shared. */
+        CustomData_duplicate_referenced_layers(ldata, loops_num);
+        mdisp = static_cast<MDisps *>(
+            CustomData_get_layer_for_write(ldata, CD_MDISPS, loops_num));
+      }
       BKE_mesh_polygon_flip_ex(mp, mloop, ldata, nos, mdisp, true);
       negate_v3(polynors[i]);
       flipped = true;
@@ -323,8 +330,13 @@ static void normalEditModifier_do_radial(NormalEditModifierData *enmd,
   }
 
   if (do_polynors_fix &&
-      polygons_check_flip(
-          mloop, nos, &mesh->ldata, mpoly, BKE_mesh_poly_normals_for_write(mesh), polys_num)) {
+      polygons_check_flip(mloop,
+                          nos,
+                          &mesh->ldata,
+                          loops_num,
+                          mpoly,
+                          BKE_mesh_poly_normals_for_write(mesh),
+                          polys_num)) {
     /* We need to recompute vertex normals! */
     BKE_mesh_normals_tag_dirty(mesh);
   }
@@ -440,8 +452,13 @@ static void normalEditModifier_do_directional(NormalEditModifierData *enmd,
   }
 
   if (do_polynors_fix &&
-      polygons_check_flip(
-          mloop, nos, &mesh->ldata, mpoly, BKE_mesh_poly_normals_for_write(mesh), polys_num)) {
+      polygons_check_flip(mloop,
+                          nos,
+                          &mesh->ldata,
+                          loops_num,
+                          mpoly,
+                          BKE_mesh_poly_normals_for_write(mesh),
+                          polys_num)) {
     BKE_mesh_normals_tag_dirty(mesh);
   }
 
@@ -542,10 +559,9 @@ static Mesh *normalEditModifier_do(NormalEditModifierData *enmd,
   const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(result);
   const float(*poly_normals)[3] = BKE_mesh_poly_normals_ensure(result);
 
-  short(*clnors)[2] = static_cast<short(*)[2]>(CustomData_get_layer(ldata, CD_CUSTOMLOOPNORMAL));
+  short(*clnors)[2] = static_cast<short(*)[2]>(
+      CustomData_get_layer_for_write(ldata, CD_CUSTOMLOOPNORMAL, loops_num));
   if (use_current_clnors) {
-    clnors = static_cast<short(*)[2]>(
-        CustomData_duplicate_referenced_layer(ldata, CD_CUSTOMLOOPNORMAL, loops_num));
     loopnors = static_cast<float(*)[3]>(
         MEM_malloc_arrayN(size_t(loops_num), sizeof(*loopnors), __func__));
 
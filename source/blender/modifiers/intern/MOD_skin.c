@@ -918,7 +918,8 @@ static Mesh *subdivide_base(const Mesh *orig)
 
   MVert *outvert = BKE_mesh_verts_for_write(result);
   MEdge *outedge = BKE_mesh_edges_for_write(result);
-  MVertSkin *outnode = CustomData_get_layer(&result->vdata, CD_MVERT_SKIN);
+  MVertSkin *outnode = CustomData_get_layer_for_write(
+      &result->vdata, CD_MVERT_SKIN, result->totvert);
   MDeformVert *outdvert = NULL;
   if (origdvert) {
     outdvert = BKE_mesh_deform_verts_for_write(result);
@@ -1904,7 +1905,7 @@ static void skin_set_orig_indices(Mesh *mesh)
 static Mesh *base_skin(Mesh *origmesh, SkinModifierData *smd, eSkinErrorFlag *r_error)
 {
   Mesh *result;
-  MVertSkin *nodes;
+  const MVertSkin *nodes;
   BMesh *bm;
   EMat *emat;
   SkinNode *skin_nodes;
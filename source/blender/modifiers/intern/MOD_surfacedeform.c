@@ -1555,9 +1555,17 @@ static void surfacedeformModifier_do(ModifierData *md,
     BKE_mesh_wrapper_vert_coords_copy_with_mat4(
         target, data.targetCos, target_verts_num, smd->mat);
 
+    /* Every bound vertex evaluates the normals of all its bound polygons, which is enough work to
+     * thread small meshes too, e.g. the cloth layers of a character.
+     *
+     * NOTE: Deformation always runs on the CPU, also for the viewport. The draw cache already
+     * keeps the position independent buffers of the deformed mesh between frames
+     * (#BKE_MESH_BATCH_DIRTY_DEFORM). Evaluating it in a compute shader would also need the binds
+     * in storage buffers, and a way for the modifier stack to skip the CPU deformation when no
+     * later modifier or render needs the positions. */
     TaskParallelSettings settings;
     BLI_parallel_range_settings_defaults(&settings);
-    settings.use_threading = (smd->bind_verts_num > 10000);
+    settings.min_iter_per_thread = 256;
     BLI_task_parallel_range(0, smd->bind_verts_num, &data, deformVert, &settings);
 
     MEM_freeN(data.targetCos);
@@ -12,6 +12,16 @@ extern struct bNodeTreeType *ntreeType_Geometry;
 
 void register_node_tree_type_geo(void);
 
+/**
+ * Evaluate fields with compute shaders when the experimental preference is enabled, see
+ * `NOD_gpu_fields.hh`. The callbacks make a GPU context active on threads that don't have one.
+ * The enable callback returns false when no context is available.
+ */
+void geometry_nodes_gpu_fields_register(bool (*context_enable)(void),
+                                        void (*context_disable)(void));
+/** Free the cached shaders, has to be called with an active GPU context. */
+void geometry_nodes_gpu_fields_free(void);
+
 void register_node_type_geo_group(void);
 void register_node_type_geo_custom_group(bNodeType *ntype);
 
@@ -233,6 +233,16 @@ class GeoNodeExecParams {
     return dynamic_cast<GeoNodesLFUserData *>(lf_context_.user_data);
   }
 
+  /**
+   * Allocator for temporary data that is freed when the evaluation of the node tree is done.
+   * It must only be used on the thread that executes the node, see #lf::Context::allocator.
+   */
+  LinearAllocator<> &allocator() const
+  {
+    BLI_assert(lf_context_.allocator != nullptr);
+    return *lf_context_.allocator;
+  }
+
   /**
    * Add an error message displayed at the top of the node when displaying the node tree,
    * and potentially elsewhere in Blender.
@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/**
+ * Geometry nodes evaluation rebuilds all intermediate values every time, even when only a node
+ * close to the output changed. The cache in this file keeps the outputs of expensive nodes of a
+ * modifier's node group between evaluations, so that they don't have to be computed again.
+ *
+ * Cached values are identified by a key that is computed ahead of the evaluation for every node
+ * of the node group. It is a hash of the node's settings, the unlinked input values, the keys of
+ * all linked upstream nodes and the values passed into the node group by the modifier. Nodes that
+ * depend on state outside of the node tree (e.g. the scene time or other objects), as well as all
+ * nodes downstream of them, don't get a key and are never cached.
+ */
+
+#include <mutex>
+
+#include "BLI_compute_context.hh"
+#include "BLI_generic_pointer.hh"
+#include "BLI_map.hh"
+
+struct bNode;
+struct bNodeTree;
+
+namespace blender::nodes {
+
+/**
+ * Keeps node outputs from previous evaluations, up to a memory limit. When the limit is exceeded,
+ * the values that have not been used for the longest time are removed.
+ * The cache is thread-safe.
+ */
+class GeometryNodesCache {
+ public:
+  struct Statistics {
+    /** Number of nodes whose outputs were reused in the last evaluation. */
+    int hits = 0;
+    /** Number of nodes with a key that had to be computed in the last evaluation. */
+    int misses = 0;
+    int entries_num = 0;
+    int64_t memory = 0;
+  };
+
+ private:
+  struct Entry {
+    Vector<GMutablePointer> values;
+    int64_t memory;
+    int64_t last_used_evaluation;
+  };
+
+  mutable std::mutex mutex_;
+  Map<ComputeContextHash, std::unique_ptr<Entry>> entries_;
+  int64_t memory_ = 0;
+  int64_t memory_limit_ = 0;
+  int64_t evaluation_ = 0;
+  int hits_ = 0;
+  int misses_ = 0;
+
+ public:
+  ~GeometryNodesCache();
+
+  /** Reset the statistics of the last evaluation and apply a new memory limit in bytes. */
+  void begin_evaluation(int64_t memory_limit);
+
+  /**
+   * Copy-construct the values cached for the key into the uninitialized buffers.
+   * \return False when nothing is cached with the given key and types.
+   */
+  bool lookup(const ComputeContextHash &key, Span<const CPPType *> types, Span<void *> r_values);
+
+  /** Store copies of the values, unless they are larger than the memory limit. */
+  void add(const ComputeContextHash &key, Span<GPointer> values);
+
+  /** Count a node that had to be computed even though it has a key. */
+  void add_miss();
+
+  Statistics statistics() const;
+
+ private:
+  void remove_least_recently_used(int64_t memory_limit);
+};
+
+/**
+ * Nodes that may be cached are regular geometry nodes with a geometry output. Their inputs are
+ * requested lazily, so that the upstream nodes are not evaluated when the outputs are cached.
+ */
+bool node_supports_caching(const bNode &node);
+
+/**
+ * Compute the cache keys for all nodes of the tree that support caching and don't depend on
+ * anything outside of the node tree.
+ *
+ * \param group_inputs: The values passed into the node group, used by the keys of nodes that
+ * depend on the group input. Only these values are read, they are not modified.
+ */
+Map<const bNode *, ComputeContextHash> compute_node_cache_keys(const bNodeTree &tree,
+                                                               Span<GPointer> group_inputs);
+
+}  // namespace blender::nodes
@@ -21,6 +21,7 @@
 #include "FN_lazy_function_graph.hh"
 #include "FN_lazy_function_graph_executor.hh"
 
+#include "NOD_geometry_nodes_cache.hh"
 #include "NOD_geometry_nodes_log.hh"
 #include "NOD_multi_function.hh"
 
@@ -49,6 +50,10 @@ struct GeoNodesModifierData {
    * the node groups they are contained in).
    */
   const MultiValueMap<ComputeContextHash, const lf::FunctionNode *> *side_effect_nodes;
+  /** Optional cache for node outputs from previous evaluations. */
+  GeometryNodesCache *cache = nullptr;
+  /** Keys of the nodes in the modifier's node group that may be cached, see #cache. */
+  const Map<const bNode *, ComputeContextHash> *cache_keys = nullptr;
 };
 
 /**
@@ -156,6 +161,10 @@ class GeometryNodesLazyFunctionLogger : public fn::lazy_function::GraphExecutor:
   void log_before_node_execute(const lf::FunctionNode &node,
                                const lf::Params &params,
                                const lf::Context &context) const override;
+  bool use_node_execution_traces(const lf::Context &context) const override;
+  void log_node_execution_trace(const lf::FunctionNode &node,
+                                const lf::NodeExecutionTrace &trace,
+                                const lf::Context &context) const override;
 };
 
 /**
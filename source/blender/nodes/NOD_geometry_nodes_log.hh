@@ -188,6 +188,15 @@ class GeoTreeLogger {
     TimePoint start;
     TimePoint end;
   };
+  /** More detailed timing of every execution of a node, see #lf::NodeExecutionTrace. */
+  struct NodeExecutionTrace {
+    StringRefNull node_name;
+    TimePoint start;
+    TimePoint end;
+    std::chrono::nanoseconds input_wait_time;
+    int thread_id;
+    bool thread_migrated;
+  };
   struct ViewerNodeLogWithNode {
     StringRefNull node_name;
     destruct_ptr<ViewerNodeLog> viewer_log;
@@ -206,6 +215,7 @@ class GeoTreeLogger {
   Vector<SocketValueLog> input_socket_values;
   Vector<SocketValueLog> output_socket_values;
   Vector<NodeExecutionTime> node_execution_times;
+  Vector<NodeExecutionTrace, 0> node_execution_traces;
   Vector<ViewerNodeLogWithNode, 0> viewer_node_logs;
   Vector<AttributeUsageWithNode, 0> used_named_attributes;
   Vector<DebugMessage, 0> debug_messages;
@@ -234,6 +244,10 @@ class GeoNodeLog {
    * inside.
    */
   std::chrono::nanoseconds run_time{0};
+  /** Time the node waited for its inputs to be computed, summed over all its executions. */
+  std::chrono::nanoseconds input_wait_time{0};
+  /** Number of executions that ran on another thread than the one that scheduled them. */
+  int thread_migrations = 0;
   /** Maps from socket identifiers to their values. */
   Map<StringRefNull, ValueLog *> input_values_;
   Map<StringRefNull, ValueLog *> output_values_;
@@ -334,6 +348,12 @@ class GeoModifierLog {
    */
   static GeoTreeLog *get_tree_log_for_node_editor(const SpaceNode &snode);
   static const ViewerNodeLog *find_viewer_node_log_for_path(const ViewerPath &viewer_path);
+
+  /**
+   * Write the execution traces of all nodes in the Chrome trace event JSON format, which can be
+   * loaded in profilers like Perfetto.
+   */
+  void write_node_execution_traces(std::ostream &stream);
 };
 
 }  // namespace blender::nodes::geo_eval_log
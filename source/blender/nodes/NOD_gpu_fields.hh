@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Optional evaluation of fields with compute shaders. Field trees that are made of operations
+ * with a #GPUFieldFunction are lowered to a single compute shader that is evaluated for all
+ * indices at once. Parts of the tree that can't be lowered (field inputs and other operations) are
+ * evaluated with multi-functions on the CPU and passed to the shader as storage buffers.
+ *
+ * The backend is only used when the "GPU Field Evaluation" experimental preference is enabled and
+ * a GPU context with compute shader support is available, see #geometry_nodes_gpu_fields_register.
+ */
+
+#include "BLI_vector.hh"
+
+#include "FN_multi_function.hh"
+
+namespace blender::nodes {
+
+/**
+ * GLSL code that computes the same values as a multi-function. In the statement, `$0`, `$1`, ...
+ * are replaced with the names of the input variables and `$r0`, `$r1`, ... with the names of the
+ * output variables, which have to be assigned by the statement. Arguments that should be ignored
+ * can be passed to `unused_float`, `unused_vec3` and `unused_vec4`.
+ */
+struct GPUFieldFunctionCode {
+  std::string statement;
+  /** Shader library files that define the functions called by the statement. */
+  Vector<const char *> libraries;
+};
+
+/**
+ * A multi-function that calls another multi-function on the CPU, and additionally knows how the
+ * same values are computed in a compute shader. Nodes use it to wrap the multi-functions that the
+ * GPU backend may lower to GLSL.
+ */
+class GPUFieldFunction : public fn::MultiFunction {
+ private:
+  std::shared_ptr<fn::MultiFunction> owned_fn_;
+  const fn::MultiFunction &fn_;
+  GPUFieldFunctionCode code_;
+
+ public:
+  GPUFieldFunction(const fn::MultiFunction &fn, GPUFieldFunctionCode code);
+  GPUFieldFunction(std::shared_ptr<fn::MultiFunction> fn, GPUFieldFunctionCode code);
+
+  void call(IndexMask mask, fn::MFParams params, fn::MFContext context) const override;
+
+  const GPUFieldFunctionCode &code() const
+  {
+    return code_;
+  }
+
+ private:
+  ExecutionHints get_execution_hints() const override;
+};
+
+}  // namespace blender::nodes
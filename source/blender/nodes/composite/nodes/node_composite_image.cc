@@ -20,6 +20,7 @@
 
 #include "DEG_depsgraph_query.h"
 
+#include "DNA_image_types.h"
 #include "DNA_scene_types.h"
 
 #include "RE_engine.h"
@@ -462,6 +463,23 @@ class ImageOperation : public NodeOperation {
     }
   }
 
+  uint64_t compute_options_hash() override
+  {
+    /* Render results and viewer images change without the image being tagged for an update, so
+     * their results can't be reused. */
+    if (get_image() && get_image()->source == IMA_SRC_VIEWER) {
+      return 0;
+    }
+
+    /* The frame number is stored in the image user, so compute it before it gets hashed as part of
+     * the node storage, otherwise, the hash would change again after the execution. */
+    if (is_valid()) {
+      update_image_frame_number();
+    }
+
+    return NodeOperation::compute_options_hash();
+  }
+
   /* Returns true if the node results can be computed, otherwise, returns false. */
   bool is_valid()
   {
@@ -855,6 +873,13 @@ class RenderLayerOperation : public NodeOperation {
       }
     }
   }
+
+  /* The passes are rendered by the viewport, whose changes are not tracked, so the results can't
+   * be reused. */
+  uint64_t compute_options_hash() override
+  {
+    return 0;
+  }
 };
 
 static NodeOperation *get_compositor_operation(Context &context, DNode node)
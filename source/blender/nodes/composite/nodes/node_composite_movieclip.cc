@@ -236,6 +236,14 @@ class MovieClipOperation : public NodeOperation {
     }
   }
 
+  uint64_t compute_options_hash() override
+  {
+    /* The frame number is stored in the movie clip user, so set it before it gets hashed as part
+     * of the node storage, otherwise, the hash would change again after the execution. */
+    BKE_movieclip_user_set_frame(get_movie_clip_user(), context().get_frame_number());
+    return NodeOperation::compute_options_hash();
+  }
+
   GPUTexture *get_movie_clip_texture()
   {
     MovieClip *movie_clip = get_movie_clip();
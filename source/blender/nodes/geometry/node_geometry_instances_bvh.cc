@@ -0,0 +1,309 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
+
+#include "DNA_collection_types.h"
+#include "DNA_layer_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_collection.h"
+#include "BKE_geometry_set_instances.hh"
+
+#include "node_geometry_instances_bvh.hh"
+
+namespace blender::nodes {
+
+InstancesBVH::InstancesBVH(const GeometrySet &geometry_set,
+                           const BVHCacheType mesh_tree_type,
+                           const int tree_type,
+                           const bool use_pointclouds)
+    : mesh_tree_type_(mesh_tree_type), tree_type_(tree_type), use_pointclouds_(use_pointclouds)
+{
+  this->gather_recursive(geometry_set, float4x4::identity());
+  if (instances_.is_empty()) {
+    return;
+  }
+
+  tree_ = BLI_bvhtree_new(int(instances_.size()), 0.0f, 4, 6);
+  for (const int i : instances_.index_range()) {
+    const Instance &instance = instances_[i];
+    float3 min, max;
+    BLI_bvhtree_get_bounding_box(references_[instance.reference].tree, min, max);
+
+    /* Insert all corners of the transformed bounding box. */
+    float corners[8][3];
+    for (const int corner : IndexRange(8)) {
+      const float3 local_corner((corner & 1) ? max.x : min.x,
+                                (corner & 2) ? max.y : min.y,
+                                (corner & 4) ? max.z : min.z);
+      copy_v3_v3(corners[corner], instance.transform * local_corner);
+    }
+    BLI_bvhtree_insert(tree_, i, corners[0], 8);
+  }
+  BLI_bvhtree_balance(tree_);
+}
+
+InstancesBVH::~InstancesBVH()
+{
+  if (tree_) {
+    BLI_bvhtree_free(tree_);
+  }
+  for (std::unique_ptr<BVHTreeFromMesh> &tree_data : mesh_trees_) {
+    free_bvhtree_from_mesh(tree_data.get());
+  }
+  for (std::unique_ptr<BVHTreeFromPointCloud> &tree_data : pointcloud_trees_) {
+    free_bvhtree_from_pointcloud(tree_data.get());
+  }
+}
+
+void InstancesBVH::gather_recursive(const GeometrySet &geometry_set, const float4x4 &transform)
+{
+  if (const Mesh *mesh = geometry_set.get_mesh_for_read()) {
+    this->add_instance(this->mesh_reference(*mesh), transform);
+  }
+  if (use_pointclouds_) {
+    if (const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read()) {
+      this->add_instance(this->pointcloud_reference(*pointcloud), transform);
+    }
+  }
+  const InstancesComponent *component = geometry_set.get_component_for_read<InstancesComponent>();
+  if (component == nullptr) {
+    return;
+  }
+  const Span<InstanceReference> references = component->references();
+  const Span<int> handles = component->instance_reference_handles();
+  const Span<float4x4> transforms = component->instance_transforms();
+  for (const int i : transforms.index_range()) {
+    this->gather_instance_reference(references[handles[i]], transform * transforms[i]);
+  }
+}
+
+void InstancesBVH::gather_instance_reference(const InstanceReference &reference,
+                                             const float4x4 &transform)
+{
+  switch (reference.type()) {
+    case InstanceReference::Type::Object: {
+      /* Recurse into a local copy, the vector can be reallocated by nested instances. Copying
+       * only adds users to the shared components. */
+      const GeometrySet object_geometry_set = bke::object_get_evaluated_geometry_set(
+          reference.object());
+      object_geometry_sets_.append(object_geometry_set);
+      this->gather_recursive(object_geometry_set, transform);
+      break;
+    }
+    case InstanceReference::Type::Collection: {
+      Collection &collection = reference.collection();
+      float4x4 offset_matrix = float4x4::identity();
+      sub_v3_v3(offset_matrix.values[3], collection.instance_offset);
+      FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (&collection, object) {
+        const GeometrySet object_geometry_set = bke::object_get_evaluated_geometry_set(*object);
+        object_geometry_sets_.append(object_geometry_set);
+        this->gather_recursive(object_geometry_set, transform * offset_matrix * object->obmat);
+      }
+      FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+      break;
+    }
+    case InstanceReference::Type::GeometrySet: {
+      this->gather_recursive(reference.geometry_set(), transform);
+      break;
+    }
+    case InstanceReference::Type::None: {
+      break;
+    }
+  }
+}
+
+void InstancesBVH::add_instance(const int reference, const float4x4 &transform)
+{
+  if (reference == -1) {
+    return;
+  }
+  Instance instance;
+  instance.transform = transform;
+  instance.imat = transform.inverted();
+  /* The Frobenius norm is an upper bound of the largest scale factor of the matrix. */
+  instance.imat_scale_sq = 0.0f;
+  for (const int col : IndexRange(3)) {
+    instance.imat_scale_sq += len_squared_v3(instance.imat.values[col]);
+  }
+  instance.reference = reference;
+  instances_.append(instance);
+}
+
+int InstancesBVH::mesh_reference(const Mesh &mesh)
+{
+  return reference_indices_.lookup_or_add_cb(&mesh, [&]() {
+    std::unique_ptr<BVHTreeFromMesh> tree_data = std::make_unique<BVHTreeFromMesh>();
+    BKE_bvhtree_from_mesh_get(tree_data.get(), &mesh, mesh_tree_type_, tree_type_);
+    if (tree_data->tree == nullptr) {
+      free_bvhtree_from_mesh(tree_data.get());
+      return -1;
+    }
+    Reference reference;
+    reference.mesh = &mesh;
+    reference.tree = tree_data->tree;
+    reference.nearest_callback = tree_data->nearest_callback;
+    reference.raycast_callback = tree_data->raycast_callback;
+    reference.callback_data = tree_data.get();
+    mesh_trees_.append(std::move(tree_data));
+    return int(references_.append_and_get_index(reference));
+  });
+}
+
+int InstancesBVH::pointcloud_reference(const PointCloud &pointcloud)
+{
+  return reference_indices_.lookup_or_add_cb(&pointcloud, [&]() {
+    std::unique_ptr<BVHTreeFromPointCloud> tree_data = std::make_unique<BVHTreeFromPointCloud>();
+    BKE_bvhtree_from_pointcloud_get(tree_data.get(), &pointcloud, tree_type_);
+    if (tree_data->tree == nullptr) {
+      free_bvhtree_from_pointcloud(tree_data.get());
+      return -1;
+    }
+    Reference reference;
+    reference.tree = tree_data->tree;
+    reference.nearest_callback = tree_data->nearest_callback;
+    reference.callback_data = tree_data.get();
+    pointcloud_trees_.append(std::move(tree_data));
+    return int(references_.append_and_get_index(reference));
+  });
+}
+
+struct InstancesRayCastData {
+  const InstancesBVH *bvh;
+  InstancesBVH::RayHit hit;
+  float3 local_normal;
+};
+
+static void instance_raycast_cb(void *userdata,
+                                const int index,
+                                const BVHTreeRay *ray,
+                                BVHTreeRayHit *hit)
+{
+  InstancesRayCastData &data = *static_cast<InstancesRayCastData *>(userdata);
+  const InstancesBVH::Instance &instance = data.bvh->instances()[index];
+  const InstancesBVH::Reference &reference = data.bvh->references()[instance.reference];
+  if (reference.raycast_callback == nullptr) {
+    return;
+  }
+
+  /* Distances along the ray in the local space of the reference are scaled by the length of the
+   * transformed direction. */
+  const float3 local_origin = instance.imat * float3(ray->origin);
+  float3 local_direction = instance.imat.ref_3x3() * float3(ray->direction);
+  const float scale = math::length(local_direction);
+  if (scale == 0.0f) {
+    return;
+  }
+  local_direction /= scale;
+
+  BVHTreeRayHit local_hit;
+  local_hit.index = -1;
+  local_hit.dist = hit->dist * scale;
+  if (BLI_bvhtree_ray_cast(reference.tree,
+                           local_origin,
+                           local_direction,
+                           0.0f,
+                           &local_hit,
+                           reference.raycast_callback,
+                           reference.callback_data) == -1) {
+    return;
+  }
+  const float distance = local_hit.dist / scale;
+  if (distance >= hit->dist) {
+    return;
+  }
+  hit->index = index;
+  hit->dist = distance;
+  data.hit.instance = index;
+  data.hit.reference = instance.reference;
+  data.hit.index = local_hit.index;
+  data.hit.local_position = local_hit.co;
+  data.hit.distance = distance;
+  data.local_normal = local_hit.no;
+}
+
+bool InstancesBVH::ray_cast(const float3 &origin,
+                            const float3 &direction,
+                            const float max_distance,
+                            RayHit &r_hit) const
+{
+  if (tree_ == nullptr) {
+    return false;
+  }
+  InstancesRayCastData data{this};
+  BVHTreeRayHit hit;
+  hit.index = -1;
+  hit.dist = max_distance;
+  if (BLI_bvhtree_ray_cast(tree_, origin, direction, 0.0f, &hit, instance_raycast_cb, &data) ==
+          -1 ||
+      data.hit.instance == -1) {
+    return false;
+  }
+  /* Only transform the result of the closest hit back to the space of the top level geometry. */
+  const Instance &instance = instances_[data.hit.instance];
+  r_hit = data.hit;
+  r_hit.position = instance.transform * data.hit.local_position;
+  r_hit.normal = math::normalize(instance.imat.transposed().ref_3x3() * data.local_normal);
+  return true;
+}
+
+struct InstancesNearestData {
+  const InstancesBVH *bvh;
+  InstancesBVH::Nearest nearest;
+};
+
+static void instance_nearest_cb(void *userdata,
+                                const int index,
+                                const float co[3],
+                                BVHTreeNearest *nearest)
+{
+  InstancesNearestData &data = *static_cast<InstancesNearestData *>(userdata);
+  const InstancesBVH::Instance &instance = data.bvh->instances()[index];
+  const InstancesBVH::Reference &reference = data.bvh->references()[instance.reference];
+
+  /* Elements that are closer than the current nearest element in the top level space are
+   * always within the scaled distance in the local space. */
+  BVHTreeNearest local_nearest;
+  local_nearest.index = -1;
+  local_nearest.dist_sq = nearest->dist_sq * instance.imat_scale_sq;
+  if (BLI_bvhtree_find_nearest(reference.tree,
+                               instance.imat * float3(co),
+                               &local_nearest,
+                               reference.nearest_callback,
+                               reference.callback_data) == -1) {
+    return;
+  }
+  const float3 position = instance.transform * float3(local_nearest.co);
+  const float distance_sq = math::distance_squared(position, float3(co));
+  if (distance_sq >= nearest->dist_sq) {
+    return;
+  }
+  nearest->index = index;
+  nearest->dist_sq = distance_sq;
+  copy_v3_v3(nearest->co, position);
+  data.nearest.instance = index;
+  data.nearest.reference = instance.reference;
+  data.nearest.index = local_nearest.index;
+  data.nearest.position = position;
+  data.nearest.distance_sq = distance_sq;
+}
+
+bool InstancesBVH::find_nearest(const float3 &position, Nearest &r_nearest) const
+{
+  if (tree_ == nullptr) {
+    return false;
+  }
+  InstancesNearestData data{this};
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = r_nearest.distance_sq;
+  BLI_bvhtree_find_nearest(tree_, position, &nearest, instance_nearest_cb, &data);
+  if (data.nearest.instance == -1) {
+    return false;
+  }
+  r_nearest = data.nearest;
+  return true;
+}
+
+}  // namespace blender::nodes
@@ -0,0 +1,132 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Two-level acceleration structure for looking up the surface of geometry with instances
+ * without realizing it. A top-level tree contains the bounds of every instance, and every
+ * unique instance reference only has a single tree in its local space that is shared by all
+ * of its instances.
+ */
+
+#include <memory>
+
+#include "BLI_float4x4.hh"
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_bvhutils.h"
+#include "BKE_geometry_set.hh"
+
+namespace blender::nodes {
+
+class InstancesBVH : NonCopyable, NonMovable {
+ public:
+  /** A unique geometry that is used by one or more instances. */
+  struct Reference {
+    /** Only set when the reference is a mesh. */
+    const Mesh *mesh = nullptr;
+    BVHTree *tree = nullptr;
+    BVHTree_NearestPointCallback nearest_callback = nullptr;
+    BVHTree_RayCastCallback raycast_callback = nullptr;
+    void *callback_data = nullptr;
+  };
+
+  struct Instance {
+    float4x4 transform;
+    float4x4 imat;
+    /**
+     * Squared upper bound of how much the inverse transform can scale distances, used to limit
+     * the nearest point search in the local space of the reference.
+     */
+    float imat_scale_sq;
+    int reference;
+  };
+
+  struct RayHit {
+    int instance = -1;
+    int reference = -1;
+    /** Index of the element in the tree of the reference, e.g. the triangle index. */
+    int index = -1;
+    /** Hit position and normal in the space of the top level geometry. */
+    float3 position;
+    float3 normal;
+    float3 local_position;
+    float distance = 0.0f;
+  };
+
+  struct Nearest {
+    int instance = -1;
+    int reference = -1;
+    int index = -1;
+    float3 position;
+    float distance_sq = FLT_MAX;
+  };
+
+ private:
+  BVHCacheType mesh_tree_type_;
+  int tree_type_;
+  bool use_pointclouds_;
+
+  /** Keeps evaluated object geometry alive while the trees reference it. */
+  Vector<GeometrySet> object_geometry_sets_;
+  Vector<std::unique_ptr<BVHTreeFromMesh>> mesh_trees_;
+  Vector<std::unique_ptr<BVHTreeFromPointCloud>> pointcloud_trees_;
+  Map<const void *, int> reference_indices_;
+  Vector<Reference> references_;
+  Vector<Instance> instances_;
+  BVHTree *tree_ = nullptr;
+
+ public:
+  /**
+   * Build the trees for all meshes (and point clouds if \a use_pointclouds is true) in the
+   * geometry set, including the geometry that is not instanced.
+   */
+  InstancesBVH(const GeometrySet &geometry_set,
+               BVHCacheType mesh_tree_type,
+               int tree_type,
+               bool use_pointclouds);
+  ~InstancesBVH();
+
+  bool is_empty() const
+  {
+    return tree_ == nullptr;
+  }
+
+  Span<Reference> references() const
+  {
+    return references_;
+  }
+
+  Span<Instance> instances() const
+  {
+    return instances_;
+  }
+
+  /**
+   * Find the closest hit along a ray. The direction is expected to be normalized.
+   * \return True if anything was hit within \a max_distance.
+   */
+  bool ray_cast(const float3 &origin,
+                const float3 &direction,
+                float max_distance,
+                RayHit &r_hit) const;
+
+  /**
+   * Find the element closest to \a position. The initial #Nearest.distance_sq is used as upper
+   * bound for the search.
+   * \return True if an element closer than the upper bound was found.
+   */
+  bool find_nearest(const float3 &position, Nearest &r_nearest) const;
+
+ private:
+  void gather_recursive(const GeometrySet &geometry_set, const float4x4 &transform);
+  void gather_instance_reference(const InstanceReference &reference, const float4x4 &transform);
+  void add_instance(int reference, const float4x4 &transform);
+  int mesh_reference(const Mesh &mesh);
+  int pointcloud_reference(const PointCloud &pointcloud);
+};
+
+}  // namespace blender::nodes
@@ -1,8 +1,10 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_bounds.hh"
 #include "BLI_kdtree.h"
 #include "BLI_noise.hh"
 #include "BLI_rand.hh"
+#include "BLI_sort.hh"
 #include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
@@ -67,6 +69,12 @@ static void node_layout(uiLayout *layout, bContext * /*C*/, PointerRNA *ptr)
   uiItemR(layout, ptr, "distribute_method", 0, "", ICON_NONE);
 }
 
+static void node_layout_ex(uiLayout *layout, bContext * /*C*/, PointerRNA *ptr)
+{
+  node_layout(layout, nullptr, ptr);
+  uiItemR(layout, ptr, "use_legacy_elimination", 0, nullptr, ICON_NONE);
+}
+
 static void node_point_distribute_points_on_faces_update(bNodeTree *ntree, bNode *node)
 {
   bNodeSocket *sock_distance_min = static_cast<bNodeSocket *>(BLI_findlink(&node->inputs, 2));
@@ -109,17 +117,17 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<MLoop> loops = mesh.loops();
   const Span<MLoopTri> looptris = mesh.looptris();
 
-  for (const int looptri_index : looptris.index_range()) {
+  /* Every triangle has its own random number generator, so that the points don't depend on how
+   * the triangles are distributed among threads. The generator is created again when the points
+   * are written, after the point offsets of all triangles are known. */
+  const auto looptri_points_num = [&](const int looptri_index, RandomNumberGenerator &rng) {
     const MLoopTri &looptri = looptris[looptri_index];
     const int v0_loop = looptri.tri[0];
     const int v1_loop = looptri.tri[1];
     const int v2_loop = looptri.tri[2];
-    const int v0_index = loops[v0_loop].v;
-    const int v1_index = loops[v1_loop].v;
-    const int v2_index = loops[v2_loop].v;
-    const float3 v0_pos = verts[v0_index].co;
-    const float3 v1_pos = verts[v1_index].co;
-    const float3 v2_pos = verts[v2_index].co;
+    const float3 v0_pos = verts[loops[v0_loop].v].co;
+    const float3 v1_pos = verts[loops[v1_loop].v].co;
+    const float3 v2_pos = verts[loops[v2_loop].v].co;
 
     float looptri_density_factor = 1.0f;
     if (!density_factors.is_empty()) {
@@ -129,22 +137,188 @@ static void sample_mesh_surface(const Mesh &mesh,
       looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
     }
     const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
+    return rng.round_probabilistic(area * base_density * looptri_density_factor);
+  };
+
+  Array<int> offsets(looptris.size() + 1);
+  threading::parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      RandomNumberGenerator looptri_rng(noise::hash(looptri_index, seed));
+      offsets[looptri_index] = looptri_points_num(looptri_index, looptri_rng);
+    }
+  });
+  int offset = 0;
+  for (const int looptri_index : looptris.index_range()) {
+    const int points_num = offsets[looptri_index];
+    offsets[looptri_index] = offset;
+    offset += points_num;
+  }
+  offsets.last() = offset;
+
+  r_positions.resize(offset);
+  r_bary_coords.resize(offset);
+  r_looptri_indices.resize(offset);
+
+  threading::parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      const IndexRange points(offsets[looptri_index],
+                              offsets[looptri_index + 1] - offsets[looptri_index]);
+      if (points.is_empty()) {
+        continue;
+      }
+      RandomNumberGenerator looptri_rng(noise::hash(looptri_index, seed));
+      /* Skip the random numbers used for the point count. */
+      looptri_points_num(looptri_index, looptri_rng);
+
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 v0_pos = verts[loops[looptri.tri[0]].v].co;
+      const float3 v1_pos = verts[loops[looptri.tri[1]].v].co;
+      const float3 v2_pos = verts[loops[looptri.tri[2]].v].co;
+
+      for (const int i : points) {
+        const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
+        float3 point_pos;
+        interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
+        r_positions[i] = point_pos;
+        r_bary_coords[i] = bary_coord;
+        r_looptri_indices[i] = looptri_index;
+      }
+    }
+  });
+}
+
+/** Number of bits used for the cell coordinate of every axis in the cell key. */
+static constexpr int cell_axis_bits = 21;
+static constexpr int cell_axis_max = (1 << cell_axis_bits) - 1;
 
-    const int looptri_seed = noise::hash(looptri_index, seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
+struct CellPoint {
+  uint64_t cell_key;
+  int index;
+};
+
+static uint64_t cell_key_from_coord(const int3 &cell)
+{
+  return (uint64_t(cell.x) << (2 * cell_axis_bits)) | (uint64_t(cell.y) << cell_axis_bits) |
+         uint64_t(cell.z);
+}
+
+static int3 cell_coord_from_key(const uint64_t key)
+{
+  return int3(int(key >> (2 * cell_axis_bits)),
+              int((key >> cell_axis_bits) & cell_axis_max),
+              int(key & cell_axis_max));
+}
+
+/** The coordinates of the cell and its neighbors along one axis. */
+static IndexRange neighbor_coords(const int coord)
+{
+  const int begin = std::max(coord - 1, 0);
+  const int end = std::min(coord + 1, cell_axis_max);
+  return IndexRange(begin, end - begin + 1);
+}
+
+/**
+ * Eliminate all points that are closer than the minimum distance to a point that is kept.
+ * The points are sorted into a grid with cells at least as large as the minimum distance, so
+ * only points in neighboring cells have to be compared.
+ */
+BLI_NOINLINE static void update_elimination_mask_for_close_points(
+    Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
+{
+  if (minimum_distance <= 0.0f) {
+    return;
+  }
+  const std::optional<bounds::MinMaxResult<float3>> bounds = bounds::min_max(positions);
+  if (!bounds) {
+    return;
+  }
 
-    const int point_amount = looptri_rng.round_probabilistic(area * base_density *
-                                                             looptri_density_factor);
+  /* The cells can be larger than the minimum distance when the coordinates don't fit into the
+   * cell keys otherwise. */
+  const float3 extent = bounds->max - bounds->min;
+  const float extent_max = std::max({extent.x, extent.y, extent.z});
+  const float cell_size = std::max(minimum_distance, extent_max / float(cell_axis_max - 1));
+  const float cell_size_inv = 1.0f / cell_size;
+  const float minimum_distance_sq = minimum_distance * minimum_distance;
+
+  /* Sort the points by their cell, so that every cell is a contiguous range. */
+  Array<CellPoint> points(positions.size(), NoInitialization());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float3 local = (positions[i] - bounds->min) * cell_size_inv;
+      int3 cell;
+      for (const int axis : IndexRange(3)) {
+        /* Written so that NAN coordinates end up in the first cell. */
+        cell[axis] = local[axis] > 0.0f ? int(std::min(local[axis], float(cell_axis_max))) : 0;
+      }
+      points[i] = {cell_key_from_coord(cell), i};
+    }
+  });
+  parallel_sort(points.begin(), points.end(), [](const CellPoint &a, const CellPoint &b) {
+    return a.cell_key < b.cell_key || (a.cell_key == b.cell_key && a.index < b.index);
+  });
 
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+  Vector<uint64_t> cell_keys;
+  Vector<int> cell_offsets;
+  for (const int i : points.index_range()) {
+    if (i == 0 || points[i].cell_key != points[i - 1].cell_key) {
+      cell_keys.append(points[i].cell_key);
+      cell_offsets.append(i);
     }
   }
+  cell_offsets.append(int(points.size()));
+
+  auto cell_points = [&](const int cell_index) {
+    return points.as_span().slice(cell_offsets[cell_index],
+                                  cell_offsets[cell_index + 1] - cell_offsets[cell_index]);
+  };
+
+  /* Keeping a point only eliminates points in the neighboring cells. When the cell coordinates
+   * of two cells are the same modulo three, their neighborhoods don't overlap, so they can be
+   * processed in parallel. Iterating over these groups of cells in a fixed order also gives the
+   * same result independent of the number of threads. */
+  for (const int group : IndexRange(27)) {
+    const int3 group_coord(group / 9, (group / 3) % 3, group % 3);
+    threading::parallel_for(cell_keys.index_range(), 256, [&](const IndexRange range) {
+      for (const int cell_index : range) {
+        const int3 cell = cell_coord_from_key(cell_keys[cell_index]);
+        if (cell.x % 3 != group_coord.x || cell.y % 3 != group_coord.y ||
+            cell.z % 3 != group_coord.z) {
+          continue;
+        }
+
+        Vector<Span<CellPoint>, 27> neighbors;
+        for (const int x : neighbor_coords(cell.x)) {
+          for (const int y : neighbor_coords(cell.y)) {
+            for (const int z : neighbor_coords(cell.z)) {
+              const uint64_t key = cell_key_from_coord(int3(x, y, z));
+              const uint64_t *found = std::lower_bound(cell_keys.begin(), cell_keys.end(), key);
+              if (found != cell_keys.end() && *found == key) {
+                neighbors.append(cell_points(int(found - cell_keys.begin())));
+              }
+            }
+          }
+        }
+
+        for (const CellPoint &point : cell_points(cell_index)) {
+          const int index = point.index;
+          if (elimination_mask[index]) {
+            continue;
+          }
+          const float3 &position = positions[index];
+          for (const Span<CellPoint> neighbor_points : neighbors) {
+            for (const CellPoint &other : neighbor_points) {
+              if (other.index != index &&
+                  math::distance_squared(positions[other.index], position) <=
+                      minimum_distance_sq) {
+                elimination_mask[other.index] = true;
+              }
+            }
+          }
+        }
+      }
+    });
+  }
 }
 
 BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
@@ -161,7 +335,11 @@ BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
   return kdtree;
 }
 
-BLI_NOINLINE static void update_elimination_mask_for_close_points(
+/**
+ * Eliminate close points in index order. This is single threaded and keeps different points than
+ * #update_elimination_mask_for_close_points, it is only used to keep the result of older files.
+ */
+BLI_NOINLINE static void update_elimination_mask_for_close_points_legacy(
     Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
 {
   if (minimum_distance <= 0.0f) {
@@ -204,30 +382,33 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     const MutableSpan<bool> elimination_mask)
 {
   const Span<MLoopTri> looptris = mesh.looptris();
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  threading::parallel_for(bary_coords.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_loop = looptri.tri[0];
-    const int v1_loop = looptri.tri[1];
-    const int v2_loop = looptri.tri[2];
+      const int v0_loop = looptri.tri[0];
+      const int v1_loop = looptri.tri[1];
+      const int v2_loop = looptri.tri[2];
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
+      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
+      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
+      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
 
-    const float probability = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                              v2_density_factor * bary_coord.z;
+      const float probability = v0_density_factor * bary_coord.x +
+                                v1_density_factor * bary_coord.y +
+                                v2_density_factor * bary_coord.z;
 
-    const float hash = noise::hash_float_to_float(bary_coord);
-    if (hash > probability) {
-      elimination_mask[i] = true;
+      const float hash = noise::hash_float_to_float(bary_coord);
+      if (hash > probability) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(const Span<bool> elimination_mask,
@@ -352,31 +533,33 @@ BLI_NOINLINE static void compute_attribute_outputs(const Mesh &mesh,
   const Span<MLoop> loops = mesh.loops();
   const Span<MLoopTri> looptris = mesh.looptris();
 
-  for (const int i : bary_coords.index_range()) {
-    const int looptri_index = looptri_indices[i];
-    const MLoopTri &looptri = looptris[looptri_index];
-    const float3 &bary_coord = bary_coords[i];
-
-    const int v0_index = loops[looptri.tri[0]].v;
-    const int v1_index = loops[looptri.tri[1]].v;
-    const int v2_index = loops[looptri.tri[2]].v;
-    const float3 v0_pos = verts[v0_index].co;
-    const float3 v1_pos = verts[v1_index].co;
-    const float3 v2_pos = verts[v2_index].co;
-
-    ids.span[i] = noise::hash(noise::hash_float(bary_coord), looptri_index);
-
-    float3 normal;
-    if (!normals.span.is_empty() || !rotations.span.is_empty()) {
-      normal_tri_v3(normal, v0_pos, v1_pos, v2_pos);
-    }
-    if (!normals.span.is_empty()) {
-      normals.span[i] = normal;
-    }
-    if (!rotations.span.is_empty()) {
-      rotations.span[i] = normal_to_euler_rotation(normal);
+  threading::parallel_for(bary_coords.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int looptri_index = looptri_indices[i];
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 &bary_coord = bary_coords[i];
+
+      const int v0_index = loops[looptri.tri[0]].v;
+      const int v1_index = loops[looptri.tri[1]].v;
+      const int v2_index = loops[looptri.tri[2]].v;
+      const float3 v0_pos = verts[v0_index].co;
+      const float3 v1_pos = verts[v1_index].co;
+      const float3 v2_pos = verts[v2_index].co;
+
+      ids.span[i] = noise::hash(noise::hash_float(bary_coord), looptri_index);
+
+      float3 normal;
+      if (!normals.span.is_empty() || !rotations.span.is_empty()) {
+        normal_tri_v3(normal, v0_pos, v1_pos, v2_pos);
+      }
+      if (!normals.span.is_empty()) {
+        normals.span[i] = normal;
+      }
+      if (!rotations.span.is_empty()) {
+        rotations.span[i] = normal_to_euler_rotation(normal);
+      }
     }
-  }
+  });
 
   ids.finish();
   normals.finish();
@@ -414,6 +597,7 @@ static void distribute_points_random(const Mesh &mesh,
 
 static void distribute_points_poisson_disk(const Mesh &mesh,
                                            const float minimum_distance,
+                                           const bool use_legacy_elimination,
                                            const float max_density,
                                            const Field<float> &density_factor_field,
                                            const Field<bool> &selection_field,
@@ -425,7 +609,12 @@ static void distribute_points_poisson_disk(const Mesh &mesh,
   sample_mesh_surface(mesh, max_density, {}, seed, positions, bary_coords, looptri_indices);
 
   Array<bool> elimination_mask(positions.size(), false);
-  update_elimination_mask_for_close_points(positions, minimum_distance, elimination_mask);
+  if (use_legacy_elimination) {
+    update_elimination_mask_for_close_points_legacy(positions, minimum_distance, elimination_mask);
+  }
+  else {
+    update_elimination_mask_for_close_points(positions, minimum_distance, elimination_mask);
+  }
 
   const Array<float> density_factors = calc_full_density_factors_with_selection(
       mesh, density_factor_field, selection_field);
@@ -465,8 +654,11 @@ static void point_distribution_calculate(GeometrySet &geometry_set,
       const float minimum_distance = params.get_input<float>("Distance Min");
       const float density_max = params.get_input<float>("Density Max");
       const Field<float> density_factors_field = params.get_input<Field<float>>("Density Factor");
+      const bool use_legacy_elimination =
+          params.node().custom2 & GEO_NODE_POINT_DISTRIBUTE_POINTS_ON_FACES_LEGACY_ELIMINATION;
       distribute_points_poisson_disk(mesh,
                                      minimum_distance,
+                                     use_legacy_elimination,
                                      density_max,
                                      density_factors_field,
                                      selection_field,
@@ -568,5 +760,6 @@ void register_node_type_geo_distribute_points_on_faces()
   ntype.declare = file_ns::node_declare;
   ntype.geometry_node_execute = file_ns::node_geo_exec;
   ntype.draw_buttons = file_ns::node_layout;
+  ntype.draw_buttons_ex = file_ns::node_layout_ex;
   nodeRegisterType(&ntype);
 }
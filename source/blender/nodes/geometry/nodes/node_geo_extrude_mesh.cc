@@ -141,9 +141,11 @@ static CustomData &get_customdata(Mesh &mesh, const eAttrDomain domain)
 static MutableSpan<int> get_orig_index_layer(Mesh &mesh, const eAttrDomain domain)
 {
   const bke::AttributeAccessor attributes = mesh.attributes();
+  const int domain_size = attributes.domain_size(domain);
   CustomData &custom_data = get_customdata(mesh, domain);
-  if (int *orig_indices = static_cast<int *>(CustomData_get_layer(&custom_data, CD_ORIGINDEX))) {
-    return {orig_indices, attributes.domain_size(domain)};
+  if (int *orig_indices = static_cast<int *>(
+          CustomData_duplicate_referenced_layer(&custom_data, CD_ORIGINDEX, domain_size))) {
+    return {orig_indices, domain_size};
   }
   return {};
 }
@@ -40,7 +40,8 @@ static void node_init(bNodeTree * /*tree*/, bNode *node)
 
 static PointCloud *pointcloud_merge_by_distance(const PointCloud &src_points,
                                                 const float merge_distance,
-                                                const Field<bool> &selection_field)
+                                                const Field<bool> &selection_field,
+                                                const bool use_grid)
 {
   bke::PointCloudFieldContext context{src_points};
   FieldEvaluator evaluator{context, src_points.totpoint};
@@ -52,7 +53,7 @@ static PointCloud *pointcloud_merge_by_distance(const PointCloud &src_points,
     return nullptr;
   }
 
-  return geometry::point_merge_by_distance(src_points, merge_distance, selection);
+  return geometry::point_merge_by_distance(src_points, merge_distance, selection, use_grid);
 }
 
 static std::optional<Mesh *> mesh_merge_by_distance_connected(const Mesh &mesh,
@@ -70,7 +71,8 @@ static std::optional<Mesh *> mesh_merge_by_distance_connected(const Mesh &mesh,
 
 static std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                         const float merge_distance,
-                                                        const Field<bool> &selection_field)
+                                                        const Field<bool> &selection_field,
+                                                        const bool use_grid)
 {
   bke::MeshFieldContext context{mesh, ATTR_DOMAIN_POINT};
   FieldEvaluator evaluator{context, mesh.totvert};
@@ -82,7 +84,7 @@ static std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
     return std::nullopt;
   }
 
-  return geometry::mesh_merge_by_distance_all(mesh, selection, merge_distance);
+  return geometry::mesh_merge_by_distance_all(mesh, selection, merge_distance, use_grid);
 }
 
 static void node_geo_exec(GeoNodeExecParams params)
@@ -97,7 +99,8 @@ static void node_geo_exec(GeoNodeExecParams params)
 
   geometry_set.modify_geometry_sets([&](GeometrySet &geometry_set) {
     if (const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read()) {
-      PointCloud *result = pointcloud_merge_by_distance(*pointcloud, merge_distance, selection);
+      PointCloud *result = pointcloud_merge_by_distance(
+          *pointcloud, merge_distance, selection, mode == GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID);
       if (result) {
         geometry_set.replace_pointcloud(result);
       }
@@ -106,7 +109,10 @@ static void node_geo_exec(GeoNodeExecParams params)
       std::optional<Mesh *> result;
       switch (mode) {
         case GEO_NODE_MERGE_BY_DISTANCE_MODE_ALL:
-          result = mesh_merge_by_distance_all(*mesh, merge_distance, selection);
+          result = mesh_merge_by_distance_all(*mesh, merge_distance, selection, false);
+          break;
+        case GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID:
+          result = mesh_merge_by_distance_all(*mesh, merge_distance, selection, true);
           break;
         case GEO_NODE_MERGE_BY_DISTANCE_MODE_CONNECTED:
           result = mesh_merge_by_distance_connected(*mesh, merge_distance, selection);
@@ -8,6 +8,8 @@
 
 #include "node_geometry_util.hh"
 
+#include "BLI_task.hh"
+
 #include "BKE_lib_id.h"
 #include "BKE_volume.h"
 
@@ -187,12 +189,14 @@ static void convert_to_grid_index_space(const float voxel_size,
                                         MutableSpan<float> radii)
 {
   const float voxel_size_inv = 1.0f / voxel_size;
-  for (const int i : positions.index_range()) {
-    positions[i] *= voxel_size_inv;
-    /* Better align generated grid with source points. */
-    positions[i] -= float3(0.5f);
-    radii[i] *= voxel_size_inv;
-  }
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      positions[i] *= voxel_size_inv;
+      /* Better align generated grid with source points. */
+      positions[i] -= float3(0.5f);
+      radii[i] *= voxel_size_inv;
+    }
+  });
 }
 
 static void initialize_volume_component_from_points(GeoNodeExecParams &params,
@@ -11,6 +11,7 @@
 #include "UI_interface.h"
 #include "UI_resources.h"
 
+#include "node_geometry_instances_bvh.hh"
 #include "node_geometry_util.hh"
 
 namespace blender::nodes::node_geo_proximity_cc {
@@ -20,8 +21,9 @@ NODE_STORAGE_FUNCS(NodeGeometryProximity)
 static void node_declare(NodeDeclarationBuilder &b)
 {
   b.add_input<decl::Geometry>(N_("Target"))
-      .only_realized_data()
-      .supported_type({GEO_COMPONENT_TYPE_MESH, GEO_COMPONENT_TYPE_POINT_CLOUD});
+      .supported_type({GEO_COMPONENT_TYPE_MESH,
+                       GEO_COMPONENT_TYPE_POINT_CLOUD,
+                       GEO_COMPONENT_TYPE_INSTANCES});
   b.add_input<decl::Vector>(N_("Source Position")).implicit_field(implicit_field_inputs::position);
   b.add_output<decl::Vector>(N_("Position")).dependent_field();
   b.add_output<decl::Float>(N_("Distance")).dependent_field();
@@ -39,6 +41,20 @@ static void geo_proximity_init(bNodeTree * /*tree*/, bNode *node)
   node->storage = node_storage;
 }
 
+static BVHCacheType mesh_bvh_type(const GeometryNodeProximityTargetType type)
+{
+  switch (type) {
+    case GEO_NODE_PROX_TARGET_POINTS:
+      return BVHTREE_FROM_VERTS;
+    case GEO_NODE_PROX_TARGET_EDGES:
+      return BVHTREE_FROM_EDGES;
+    case GEO_NODE_PROX_TARGET_FACES:
+      return BVHTREE_FROM_LOOPTRI;
+  }
+  BLI_assert_unreachable();
+  return BVHTREE_FROM_LOOPTRI;
+}
+
 static bool calculate_mesh_proximity(const VArray<float3> &positions,
                                      const IndexMask mask,
                                      const Mesh &mesh,
@@ -47,39 +63,36 @@ static bool calculate_mesh_proximity(const VArray<float3> &positions,
                                      const MutableSpan<float3> r_locations)
 {
   BVHTreeFromMesh bvh_data;
-  switch (type) {
-    case GEO_NODE_PROX_TARGET_POINTS:
-      BKE_bvhtree_from_mesh_get(&bvh_data, &mesh, BVHTREE_FROM_VERTS, 2);
-      break;
-    case GEO_NODE_PROX_TARGET_EDGES:
-      BKE_bvhtree_from_mesh_get(&bvh_data, &mesh, BVHTREE_FROM_EDGES, 2);
-      break;
-    case GEO_NODE_PROX_TARGET_FACES:
-      BKE_bvhtree_from_mesh_get(&bvh_data, &mesh, BVHTREE_FROM_LOOPTRI, 2);
-      break;
-  }
+  BKE_bvhtree_from_mesh_get(&bvh_data, &mesh, mesh_bvh_type(type), 2);
 
   if (bvh_data.tree == nullptr) {
     return false;
   }
 
   threading::parallel_for(mask.index_range(), 512, [&](IndexRange range) {
-    BVHTreeNearest nearest;
-    copy_v3_fl(nearest.co, FLT_MAX);
-    nearest.index = -1;
-
-    for (int i : range) {
-      const int index = mask[i];
-      /* Use the distance to the last found point as upper bound to speedup the bvh lookup. */
-      nearest.dist_sq = math::distance_squared(float3(nearest.co), positions[index]);
-
-      BLI_bvhtree_find_nearest(
-          bvh_data.tree, positions[index], &nearest, bvh_data.nearest_callback, &bvh_data);
-
-      if (nearest.dist_sq < r_distances[index]) {
-        r_distances[index] = nearest.dist_sq;
+    /* Find the nearest points of the whole range at once, so that nearby positions can be
+     * traversed together. */
+    Array<float3> range_positions(range.size());
+    Array<BVHTreeNearest> nearest(range.size());
+    for (const int i : IndexRange(range.size())) {
+      const int index = mask[range[i]];
+      range_positions[i] = positions[index];
+      nearest[i].index = -1;
+      nearest[i].dist_sq = r_distances[index];
+    }
+    BLI_bvhtree_find_nearest_batch(bvh_data.tree,
+                                   reinterpret_cast<const float(*)[3]>(range_positions.data()),
+                                   int(range.size()),
+                                   nearest.data(),
+                                   bvh_data.nearest_callback,
+                                   &bvh_data);
+
+    for (const int i : IndexRange(range.size())) {
+      const int index = mask[range[i]];
+      if (nearest[i].index != -1 && nearest[i].dist_sq < r_distances[index]) {
+        r_distances[index] = nearest[i].dist_sq;
         if (!r_locations.is_empty()) {
-          r_locations[index] = nearest.co;
+          r_locations[index] = nearest[i].co;
         }
       }
     }
@@ -129,15 +142,47 @@ static bool calculate_pointcloud_proximity(const VArray<float3> &positions,
   return true;
 }
 
+static bool calculate_instances_proximity(const VArray<float3> &positions,
+                                          const IndexMask mask,
+                                          const InstancesBVH &bvh,
+                                          MutableSpan<float> r_distances,
+                                          MutableSpan<float3> r_locations)
+{
+  if (bvh.is_empty()) {
+    return false;
+  }
+
+  threading::parallel_for(mask.index_range(), 512, [&](IndexRange range) {
+    for (int i : range) {
+      const int index = mask[i];
+      InstancesBVH::Nearest nearest;
+      nearest.distance_sq = r_distances[index];
+      if (bvh.find_nearest(positions[index], nearest)) {
+        r_distances[index] = nearest.distance_sq;
+        if (!r_locations.is_empty()) {
+          r_locations[index] = nearest.position;
+        }
+      }
+    }
+  });
+  return true;
+}
+
 class ProximityFunction : public fn::MultiFunction {
  private:
   GeometrySet target_;
   GeometryNodeProximityTargetType type_;
+  /** Used instead of the trees of the realized geometry when the target has instances. */
+  std::unique_ptr<InstancesBVH> instances_bvh_;
 
  public:
   ProximityFunction(GeometrySet target, GeometryNodeProximityTargetType type)
       : target_(std::move(target)), type_(type)
   {
+    if (target_.has_instances()) {
+      instances_bvh_ = std::make_unique<InstancesBVH>(
+          target_, mesh_bvh_type(type_), 2, type_ == GEO_NODE_PROX_TARGET_POINTS);
+    }
     static fn::MFSignature signature = create_signature();
     this->set_signature(&signature);
   }
@@ -166,12 +211,16 @@ class ProximityFunction : public fn::MultiFunction {
     distances.fill_indices(mask, FLT_MAX);
 
     bool success = false;
-    if (target_.has_mesh()) {
+    if (instances_bvh_) {
+      success = calculate_instances_proximity(
+          src_positions, mask, *instances_bvh_, distances, positions);
+    }
+    else if (target_.has_mesh()) {
       success |= calculate_mesh_proximity(
           src_positions, mask, *target_.get_mesh_for_read(), type_, distances, positions);
     }
 
-    if (target_.has_pointcloud() && type_ == GEO_NODE_PROX_TARGET_POINTS) {
+    if (!instances_bvh_ && target_.has_pointcloud() && type_ == GEO_NODE_PROX_TARGET_POINTS) {
       success |= calculate_pointcloud_proximity(
           src_positions, mask, *target_.get_pointcloud_for_read(), distances, positions);
     }
@@ -202,7 +251,8 @@ static void node_geo_exec(GeoNodeExecParams params)
   GeometrySet geometry_set_target = params.extract_input<GeometrySet>("Target");
   geometry_set_target.ensure_owns_direct_data();
 
-  if (!geometry_set_target.has_mesh() && !geometry_set_target.has_pointcloud()) {
+  if (!geometry_set_target.has_mesh() && !geometry_set_target.has_pointcloud() &&
+      !geometry_set_target.has_instances()) {
     params.set_default_remaining_outputs();
     return;
   }
@@ -11,6 +11,7 @@
 
 #include "NOD_socket_search_link.hh"
 
+#include "node_geometry_instances_bvh.hh"
 #include "node_geometry_util.hh"
 
 namespace blender::nodes::node_geo_raycast_cc {
@@ -22,8 +23,7 @@ NODE_STORAGE_FUNCS(NodeGeometryRaycast)
 static void node_declare(NodeDeclarationBuilder &b)
 {
   b.add_input<decl::Geometry>(N_("Target Geometry"))
-      .only_realized_data()
-      .supported_type(GEO_COMPONENT_TYPE_MESH);
+      .supported_type({GEO_COMPONENT_TYPE_MESH, GEO_COMPONENT_TYPE_INSTANCES});
 
   b.add_input<decl::Vector>(N_("Attribute")).hide_value().supports_field();
   b.add_input<decl::Float>(N_("Attribute"), "Attribute_001").hide_value().supports_field();
@@ -140,7 +140,8 @@ static void raycast_to_mesh(IndexMask mask,
                             int &hit_count)
 {
   BVHTreeFromMesh tree_data;
-  BKE_bvhtree_from_mesh_get(&tree_data, &mesh, BVHTREE_FROM_LOOPTRI, 4);
+  BKE_bvhtree_from_mesh_get_ex(
+      &tree_data, &mesh, BVHTREE_FROM_LOOPTRI, 4, BVH_BALANCE_MORTON_ORDER);
   BLI_SCOPED_DEFER([&]() { free_bvhtree_from_mesh(&tree_data); });
 
   if (tree_data.tree == nullptr) {
@@ -149,21 +150,31 @@ static void raycast_to_mesh(IndexMask mask,
   /* We shouldn't be rebuilding the BVH tree when calling this function in parallel. */
   BLI_assert(tree_data.cached);
 
-  for (const int i : mask) {
-    const float ray_length = ray_lengths[i];
-    const float3 ray_origin = ray_origins[i];
-    const float3 ray_direction = math::normalize(ray_directions[i]);
-
-    BVHTreeRayHit hit;
-    hit.index = -1;
-    hit.dist = ray_length;
-    if (BLI_bvhtree_ray_cast(tree_data.tree,
-                             ray_origin,
-                             ray_direction,
+  /* Cast all rays at once, so that coherent rays can be traversed together. */
+  Array<float3> origins(mask.size());
+  Array<float3> directions(mask.size());
+  Array<BVHTreeRayHit> hits(mask.size());
+  for (const int64_t i : mask.index_range()) {
+    const int64_t index = mask[i];
+    origins[i] = ray_origins[index];
+    directions[i] = math::normalize(ray_directions[index]);
+    hits[i].index = -1;
+    hits[i].dist = ray_lengths[index];
+  }
+  BLI_bvhtree_ray_cast_batch(tree_data.tree,
+                             reinterpret_cast<const float(*)[3]>(origins.data()),
+                             reinterpret_cast<const float(*)[3]>(directions.data()),
+                             int(mask.size()),
                              0.0f,
-                             &hit,
+                             hits.data(),
                              tree_data.raycast_callback,
-                             &tree_data) != -1) {
+                             &tree_data,
+                             BVH_RAYCAST_DEFAULT);
+
+  for (const int64_t mask_i : mask.index_range()) {
+    const int i = int(mask[mask_i]);
+    const BVHTreeRayHit &hit = hits[mask_i];
+    if (hit.index != -1) {
       hit_count++;
       if (!r_hit.is_empty()) {
         r_hit[i] = hit.index >= 0;
@@ -196,12 +207,18 @@ static void raycast_to_mesh(IndexMask mask,
         r_hit_normals[i] = float3(0.0f, 0.0f, 0.0f);
       }
       if (!r_hit_distances.is_empty()) {
-        r_hit_distances[i] = ray_length;
+        r_hit_distances[i] = ray_lengths[i];
       }
     }
   }
 }
 
+/** The attribute field evaluated on a mesh that is instanced in the target geometry. */
+struct InstancedTargetData {
+  std::unique_ptr<bke::MeshFieldContext> context;
+  std::unique_ptr<FieldEvaluator> evaluator;
+};
+
 class RaycastFunction : public fn::MultiFunction {
  private:
   GeometrySet target_;
@@ -211,6 +228,14 @@ class RaycastFunction : public fn::MultiFunction {
   std::optional<bke::MeshFieldContext> target_context_;
   std::unique_ptr<FieldEvaluator> target_evaluator_;
   const GVArray *target_data_ = nullptr;
+  const CPPType *target_data_type_ = nullptr;
+
+  /**
+   * Used instead of the tree of the realized mesh when the target has instances. The attribute
+   * field is then evaluated on every instanced mesh, ordered by #InstancesBVH::references().
+   */
+  std::unique_ptr<InstancesBVH> instances_bvh_;
+  Array<InstancedTargetData> instanced_target_data_;
 
   /* Always evaluate the target domain data on the face corner domain because it contains the most
    * information. Eventually this could be exposed as an option or determined automatically from
@@ -224,7 +249,13 @@ class RaycastFunction : public fn::MultiFunction {
       : target_(std::move(target)), mapping_((GeometryNodeRaycastMapMode)mapping)
   {
     target_.ensure_owns_direct_data();
-    this->evaluate_target_field(std::move(src_field));
+    if (target_.has_instances()) {
+      instances_bvh_ = std::make_unique<InstancesBVH>(target_, BVHTREE_FROM_LOOPTRI, 4, false);
+      this->evaluate_instanced_target_field(std::move(src_field));
+    }
+    else {
+      this->evaluate_target_field(std::move(src_field));
+    }
     signature_ = create_signature();
     this->set_signature(&signature_);
   }
@@ -239,14 +270,19 @@ class RaycastFunction : public fn::MultiFunction {
     signature.single_output<float3>("Hit Position");
     signature.single_output<float3>("Hit Normal");
     signature.single_output<float>("Distance");
-    if (target_data_) {
-      signature.single_output("Attribute", target_data_->type());
+    if (target_data_type_) {
+      signature.single_output("Attribute", *target_data_type_);
     }
     return signature.build();
   }
 
   void call(IndexMask mask, fn::MFParams params, fn::MFContext /*context*/) const override
   {
+    if (instances_bvh_) {
+      this->call_instanced(mask, params);
+      return;
+    }
+
     /* Hit positions are always necessary for retrieving the attribute from the target if that
      * output is required, so always retrieve a span from the evaluator in that case (it's
      * expected that the evaluator is more likely to have a spare buffer that could be used). */
@@ -305,11 +341,110 @@ class RaycastFunction : public fn::MultiFunction {
   }
 
  private:
+  void call_instanced(IndexMask mask, fn::MFParams params) const
+  {
+    const VArray<float3> &ray_origins = params.readonly_single_input<float3>(0, "Source Position");
+    const VArray<float3> &ray_directions = params.readonly_single_input<float3>(1,
+                                                                                "Ray Direction");
+    const VArray<float> &ray_lengths = params.readonly_single_input<float>(2, "Ray Length");
+    MutableSpan<bool> r_hit = params.uninitialized_single_output_if_required<bool>(3, "Is Hit");
+    MutableSpan<float3> r_hit_positions = params.uninitialized_single_output_if_required<float3>(
+        4, "Hit Position");
+    MutableSpan<float3> r_hit_normals = params.uninitialized_single_output_if_required<float3>(
+        5, "Hit Normal");
+    MutableSpan<float> r_hit_distances = params.uninitialized_single_output_if_required<float>(
+        6, "Distance");
+    GMutableSpan r_attribute;
+    if (target_data_type_) {
+      r_attribute = params.uninitialized_single_output_if_required(7, "Attribute");
+    }
+
+    /* Positions and triangle indices in the space of the hit mesh are needed for sampling the
+     * attribute on the instanced meshes. */
+    Array<int> hit_references;
+    Array<int> hit_indices;
+    Array<float3> hit_local_positions;
+    if (!r_attribute.is_empty()) {
+      hit_references.reinitialize(mask.min_array_size());
+      hit_indices.reinitialize(mask.min_array_size());
+      hit_local_positions.reinitialize(mask.min_array_size());
+    }
+
+    for (const int i : mask) {
+      const float ray_length = ray_lengths[i];
+      InstancesBVH::RayHit hit;
+      const bool is_hit = instances_bvh_->ray_cast(
+          ray_origins[i], math::normalize(ray_directions[i]), ray_length, hit);
+      if (!r_hit.is_empty()) {
+        r_hit[i] = is_hit;
+      }
+      if (!r_hit_positions.is_empty()) {
+        r_hit_positions[i] = is_hit ? hit.position : float3(0.0f, 0.0f, 0.0f);
+      }
+      if (!r_hit_normals.is_empty()) {
+        r_hit_normals[i] = is_hit ? hit.normal : float3(0.0f, 0.0f, 0.0f);
+      }
+      if (!r_hit_distances.is_empty()) {
+        r_hit_distances[i] = is_hit ? hit.distance : ray_length;
+      }
+      if (!hit_references.is_empty()) {
+        hit_references[i] = is_hit ? hit.reference : -1;
+        hit_indices[i] = hit.index;
+        hit_local_positions[i] = hit.local_position;
+      }
+    }
+
+    if (r_attribute.is_empty()) {
+      return;
+    }
+    r_attribute.type().value_initialize_indices(r_attribute.data(), mask);
+    const Span<InstancesBVH::Reference> references = instances_bvh_->references();
+    /* Group the hits by reference in a single pass over the rays. */
+    Array<Vector<int64_t>> mask_indices_by_reference(references.size());
+    for (const int64_t i : mask) {
+      if (hit_references[i] != -1) {
+        mask_indices_by_reference[hit_references[i]].append(i);
+      }
+    }
+    for (const int reference_i : references.index_range()) {
+      const Vector<int64_t> &reference_mask_indices = mask_indices_by_reference[reference_i];
+      if (reference_mask_indices.is_empty()) {
+        continue;
+      }
+      const GVArray &target_data = instanced_target_data_[reference_i].evaluator->get_evaluated(0);
+      MeshAttributeInterpolator interp(references[reference_i].mesh,
+                                       IndexMask(reference_mask_indices),
+                                       hit_local_positions,
+                                       hit_indices);
+      interp.sample_data(target_data, domain_, get_map_mode(mapping_), r_attribute);
+    }
+  }
+
+  void evaluate_instanced_target_field(GField src_field)
+  {
+    if (!src_field) {
+      return;
+    }
+    target_data_type_ = &src_field.cpp_type();
+    const Span<InstancesBVH::Reference> references = instances_bvh_->references();
+    instanced_target_data_.reinitialize(references.size());
+    for (const int i : references.index_range()) {
+      const Mesh &mesh = *references[i].mesh;
+      InstancedTargetData &data = instanced_target_data_[i];
+      data.context = std::make_unique<bke::MeshFieldContext>(mesh, domain_);
+      const int domain_size = mesh.attributes().domain_size(domain_);
+      data.evaluator = std::make_unique<FieldEvaluator>(*data.context, domain_size);
+      data.evaluator->add(src_field);
+      data.evaluator->evaluate();
+    }
+  }
+
   void evaluate_target_field(GField src_field)
   {
     if (!src_field) {
       return;
     }
+    target_data_type_ = &src_field.cpp_type();
     const Mesh &mesh = *target_.get_mesh_for_read();
     target_context_.emplace(bke::MeshFieldContext{mesh, domain_});
     const int domain_size = mesh.attributes().domain_size(domain_);
@@ -394,12 +529,12 @@ static void node_geo_exec(GeoNodeExecParams params)
     return;
   }
 
-  if (!target.has_mesh()) {
+  if (!target.has_mesh() && !target.has_instances()) {
     params.set_default_remaining_outputs();
     return;
   }
 
-  if (target.get_mesh_for_read()->totpoly == 0) {
+  if (!target.has_instances() && target.get_mesh_for_read()->totpoly == 0) {
     params.error_message_add(NodeWarningType::Error, TIP_("The target mesh must have faces"));
     params.set_default_remaining_outputs();
     return;
@@ -1,5 +1,7 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_task.hh"
+
 #include "DEG_depsgraph_query.h"
 #ifdef WITH_OPENVDB
 #  include <openvdb/tools/GridTransformer.h>
@@ -100,10 +102,13 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
                                            const float adaptivity,
                                            const bke::VolumeToMeshResolution &resolution)
 {
+  /* Grids are meshed independently, the results are merged afterwards using the offsets. */
   Array<bke::OpenVDBMeshData> mesh_data(grids.size());
-  for (const int i : grids.index_range()) {
-    mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
+    }
+  });
 
   int vert_offset = 0;
   int poly_offset = 0;
@@ -127,18 +132,20 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
   MutableSpan<MPoly> polys = mesh->polys_for_write();
   MutableSpan<MLoop> loops = mesh->loops_for_write();
 
-  for (const int i : grids.index_range()) {
-    const bke::OpenVDBMeshData &data = mesh_data[i];
-    bke::fill_mesh_from_openvdb_data(data.verts,
-                                     data.tris,
-                                     data.quads,
-                                     vert_offsets[i],
-                                     poly_offsets[i],
-                                     loop_offsets[i],
-                                     verts,
-                                     polys,
-                                     loops);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const bke::OpenVDBMeshData &data = mesh_data[i];
+      bke::fill_mesh_from_openvdb_data(data.verts,
+                                       data.tris,
+                                       data.quads,
+                                       vert_offsets[i],
+                                       poly_offsets[i],
+                                       loop_offsets[i],
+                                       verts,
+                                       polys,
+                                       loops);
+    }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
 
@@ -0,0 +1,658 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
+#include "NOD_geometry_nodes_cache.hh"
+
+#include "BLI_hash_mm2a.h"
+#include "BLI_listbase.h"
+#include "BLI_vector.hh"
+
+#include "DNA_color_types.h"
+#include "DNA_genfile.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_node_types.h"
+#include "DNA_pointcloud_types.h"
+#include "DNA_sdna_types.h"
+
+#include "BKE_curves.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_node.h"
+#include "BKE_node_runtime.hh"
+
+#include "FN_field_cpp_type.hh"
+
+namespace blender::nodes {
+
+using bke::AttributeAccessor;
+using bke::AttributeIDRef;
+using bke::AttributeMetaData;
+
+/* -------------------------------------------------------------------- */
+/** \name Geometry Hashing
+ * \{ */
+
+/** Mix in a potentially large array, hashing it is faster than mixing it into the key directly. */
+static void mix_in_array(ComputeContextHash &hash, const void *data, const int64_t size)
+{
+  const uchar *bytes = static_cast<const uchar *>(data);
+  const uint32_t values[3] = {
+      uint32_t(size), BLI_hash_mm2(bytes, size_t(size), 0), BLI_hash_mm2(bytes, size_t(size), 1)};
+  hash.mix_in(values, sizeof(values));
+}
+
+template<typename T> static void mix_in_array(ComputeContextHash &hash, const Span<T> values)
+{
+  mix_in_array(hash, values.data(), values.size_in_bytes());
+}
+
+template<typename T> static void mix_in_value(ComputeContextHash &hash, const T &value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  hash.mix_in(&value, sizeof(T));
+}
+
+static void mix_in_string(ComputeContextHash &hash, const StringRef str)
+{
+  mix_in_value(hash, str.size());
+  hash.mix_in(str.data(), str.size());
+}
+
+/**
+ * \param skip_names: Attributes that are hashed as part of the geometry or that are derived from
+ * it, like mesh normals.
+ */
+static bool mix_in_attributes(ComputeContextHash &hash,
+                              const AttributeAccessor &attributes,
+                              const Span<StringRef> skip_names)
+{
+  bool success = true;
+  attributes.for_all([&](const AttributeIDRef &attribute_id, const AttributeMetaData &meta_data) {
+    if (attribute_id.is_named()) {
+      if (skip_names.contains(attribute_id.name())) {
+        return true;
+      }
+      mix_in_string(hash, attribute_id.name());
+    }
+    else {
+      /* Anonymous attribute IDs are recreated on every evaluation and their memory can be reused,
+       * so there is nothing stable to identify them by. */
+      success = false;
+      return false;
+    }
+    mix_in_value(hash, meta_data.domain);
+    mix_in_value(hash, meta_data.data_type);
+    const GVArray varray = attributes.lookup(attribute_id, meta_data.domain, meta_data.data_type);
+    if (!varray || !varray.type().is_trivial()) {
+      success = false;
+      return false;
+    }
+    const GVArraySpan values{varray};
+    mix_in_array(hash, values.data(), values.size() * values.type().size());
+    return true;
+  });
+  return success;
+}
+
+static void mix_in_materials(ComputeContextHash &hash, Material *const *materials, const int num)
+{
+  hash.mix_in(materials, sizeof(Material *) * num);
+}
+
+static bool mix_in_geometry(ComputeContextHash &hash, const GeometrySet &geometry_set)
+{
+  for (const GeometryComponent *component : geometry_set.get_components_for_read()) {
+    const GeometryComponentType type = component->type();
+    mix_in_value(hash, type);
+    switch (type) {
+      case GEO_COMPONENT_TYPE_MESH: {
+        const Mesh *mesh = static_cast<const MeshComponent *>(component)->get_for_read();
+        if (mesh == nullptr) {
+          break;
+        }
+        mix_in_array(hash, mesh->verts());
+        mix_in_array(hash, mesh->edges());
+        mix_in_array(hash, mesh->polys());
+        mix_in_array(hash, mesh->loops());
+        mix_in_materials(hash, mesh->mat, mesh->totcol);
+        if (!mix_in_attributes(hash, mesh->attributes(), {"position", "shade_smooth", "normal"})) {
+          return false;
+        }
+        break;
+      }
+      case GEO_COMPONENT_TYPE_POINT_CLOUD: {
+        const PointCloud *pointcloud =
+            static_cast<const PointCloudComponent *>(component)->get_for_read();
+        if (pointcloud == nullptr) {
+          break;
+        }
+        mix_in_value(hash, pointcloud->totpoint);
+        mix_in_materials(hash, pointcloud->mat, pointcloud->totcol);
+        if (!mix_in_attributes(hash, pointcloud->attributes(), {})) {
+          return false;
+        }
+        break;
+      }
+      case GEO_COMPONENT_TYPE_CURVE: {
+        const Curves *curves_id = static_cast<const CurveComponent *>(component)->get_for_read();
+        if (curves_id == nullptr) {
+          break;
+        }
+        const bke::CurvesGeometry &curves = bke::CurvesGeometry::wrap(curves_id->geometry);
+        mix_in_value(hash, curves.points_num());
+        mix_in_array(hash, curves.offsets());
+        mix_in_materials(hash, curves_id->mat, curves_id->totcol);
+        if (!mix_in_attributes(hash, curves.attributes(), {})) {
+          return false;
+        }
+        break;
+      }
+      case GEO_COMPONENT_TYPE_INSTANCES: {
+        const InstancesComponent &instances = *static_cast<const InstancesComponent *>(component);
+        for (const InstanceReference &reference : instances.references()) {
+          const InstanceReference::Type reference_type = reference.type();
+          mix_in_value(hash, reference_type);
+          if (reference_type == InstanceReference::Type::GeometrySet) {
+            if (!mix_in_geometry(hash, reference.geometry_set())) {
+              return false;
+            }
+          }
+          else if (reference_type != InstanceReference::Type::None) {
+            /* The referenced data-blocks can change without the reference changing. */
+            return false;
+          }
+        }
+        mix_in_array(hash, instances.instance_reference_handles());
+        mix_in_array(hash, instances.instance_transforms());
+        if (!mix_in_attributes(hash, *instances.attributes(), {})) {
+          return false;
+        }
+        break;
+      }
+      case GEO_COMPONENT_TYPE_EDIT:
+        /* Only used to display the original geometry in edit and sculpt mode. */
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Memory Estimation
+ * \{ */
+
+static int64_t estimate_attributes_memory(const AttributeAccessor &attributes)
+{
+  int64_t memory = 0;
+  attributes.for_all([&](const AttributeIDRef & /*attribute_id*/, const AttributeMetaData &meta) {
+    const CPPType *type = bke::custom_data_type_to_cpp_type(meta.data_type);
+    memory += int64_t(attributes.domain_size(meta.domain)) * (type ? type->size() : 0);
+    return true;
+  });
+  return memory;
+}
+
+/**
+ * The geometry is often shared with the data that is passed on to other nodes, so this is an
+ * upper bound of the memory that is kept alive by the cache.
+ */
+static int64_t estimate_geometry_memory(const GeometrySet &geometry_set)
+{
+  int64_t memory = sizeof(GeometrySet);
+  if (const Mesh *mesh = geometry_set.get_mesh_for_read()) {
+    memory += mesh->edges().size_in_bytes() + mesh->polys().size_in_bytes() +
+              mesh->loops().size_in_bytes() + estimate_attributes_memory(mesh->attributes());
+  }
+  if (const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read()) {
+    memory += estimate_attributes_memory(pointcloud->attributes());
+  }
+  if (const Curves *curves_id = geometry_set.get_curves_for_read()) {
+    const bke::CurvesGeometry &curves = bke::CurvesGeometry::wrap(curves_id->geometry);
+    memory += curves.curves_num() * sizeof(int) + estimate_attributes_memory(curves.attributes());
+  }
+  if (const InstancesComponent *instances =
+          geometry_set.get_component_for_read<InstancesComponent>()) {
+    for (const InstanceReference &reference : instances->references()) {
+      if (reference.type() == InstanceReference::Type::GeometrySet) {
+        memory += estimate_geometry_memory(reference.geometry_set());
+      }
+    }
+    memory += estimate_attributes_memory(*instances->attributes());
+  }
+  return memory;
+}
+
+static int64_t estimate_value_memory(const GPointer value)
+{
+  if (value.type()->is<GeometrySet>()) {
+    return estimate_geometry_memory(*value.get<GeometrySet>());
+  }
+  return value.type()->size();
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name #GeometryNodesCache
+ * \{ */
+
+static void free_values(Span<GMutablePointer> values)
+{
+  for (GMutablePointer value : values) {
+    value.destruct();
+    MEM_freeN(value.get());
+  }
+}
+
+GeometryNodesCache::~GeometryNodesCache()
+{
+  for (const std::unique_ptr<Entry> &entry : entries_.values()) {
+    free_values(entry->values);
+  }
+}
+
+void GeometryNodesCache::begin_evaluation(const int64_t memory_limit)
+{
+  std::lock_guard lock{mutex_};
+  evaluation_++;
+  hits_ = 0;
+  misses_ = 0;
+  memory_limit_ = memory_limit;
+  this->remove_least_recently_used(memory_limit);
+}
+
+bool GeometryNodesCache::lookup(const ComputeContextHash &key,
+                                const Span<const CPPType *> types,
+                                const Span<void *> r_values)
+{
+  BLI_assert(types.size() == r_values.size());
+  std::lock_guard lock{mutex_};
+  const std::unique_ptr<Entry> *entry_ptr = entries_.lookup_ptr(key);
+  if (entry_ptr == nullptr) {
+    return false;
+  }
+  Entry &entry = **entry_ptr;
+  if (entry.values.size() != types.size()) {
+    return false;
+  }
+  for (const int i : types.index_range()) {
+    if (entry.values[i].type() != types[i]) {
+      return false;
+    }
+  }
+  for (const int i : types.index_range()) {
+    types[i]->copy_construct(entry.values[i].get(), r_values[i]);
+  }
+  entry.last_used_evaluation = evaluation_;
+  hits_++;
+  return true;
+}
+
+void GeometryNodesCache::add(const ComputeContextHash &key, const Span<GPointer> values)
+{
+  int64_t memory = 0;
+  for (const GPointer value : values) {
+    memory += estimate_value_memory(value);
+  }
+
+  std::unique_lock lock{mutex_};
+  if (memory > memory_limit_ || entries_.contains(key)) {
+    return;
+  }
+  lock.unlock();
+
+  auto entry = std::make_unique<Entry>();
+  entry->memory = memory;
+  for (const GPointer value : values) {
+    const CPPType &type = *value.type();
+    void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+    type.copy_construct(value.get(), buffer);
+    entry->values.append({type, buffer});
+  }
+
+  lock.lock();
+  if (entries_.contains(key)) {
+    free_values(entry->values);
+    return;
+  }
+  this->remove_least_recently_used(memory_limit_ - memory);
+  entry->last_used_evaluation = evaluation_;
+  entries_.add_new(key, std::move(entry));
+  memory_ += memory;
+}
+
+void GeometryNodesCache::add_miss()
+{
+  std::lock_guard lock{mutex_};
+  misses_++;
+}
+
+GeometryNodesCache::Statistics GeometryNodesCache::statistics() const
+{
+  std::lock_guard lock{mutex_};
+  Statistics statistics;
+  statistics.hits = hits_;
+  statistics.misses = misses_;
+  statistics.entries_num = int(entries_.size());
+  statistics.memory = memory_;
+  return statistics;
+}
+
+void GeometryNodesCache::remove_least_recently_used(const int64_t memory_limit)
+{
+  if (memory_ <= memory_limit) {
+    return;
+  }
+  Vector<std::pair<int64_t, ComputeContextHash>> entries_by_age;
+  for (auto item : entries_.items()) {
+    entries_by_age.append({item.value->last_used_evaluation, item.key});
+  }
+  std::sort(entries_by_age.begin(), entries_by_age.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  for (const auto &[last_used_evaluation, key] : entries_by_age) {
+    if (memory_ <= memory_limit) {
+      break;
+    }
+    std::unique_ptr<Entry> entry = entries_.pop(key);
+    memory_ -= entry->memory;
+    free_values(entry->values);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Cache Keys
+ * \{ */
+
+bool node_supports_caching(const bNode &node)
+{
+  if (node.is_muted() || node.is_group() || node.typeinfo->geometry_node_execute == nullptr ||
+      node.typeinfo->geometry_node_execute_supports_laziness) {
+    return false;
+  }
+  for (const bNodeSocket *socket : node.output_sockets()) {
+    if (socket->is_available() && socket->type == SOCK_GEOMETRY) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** Whether the DNA struct contains pointers, directly or in nested structs. */
+static bool dna_struct_has_pointers(const SDNA &sdna, const int struct_nr)
+{
+  const SDNA_Struct &struct_info = *sdna.structs[struct_nr];
+  for (const int i : IndexRange(struct_info.members_len)) {
+    const SDNA_StructMember &member = struct_info.members[i];
+    const char *name = sdna.names[member.name];
+    if (ELEM(name[0], '*', '(')) {
+      return true;
+    }
+    const int member_struct_nr = DNA_struct_find_nr(&sdna, sdna.types[member.type]);
+    if (member_struct_nr != -1 && dna_struct_has_pointers(sdna, member_struct_nr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void mix_in_curve_mapping(ComputeContextHash &hash, const CurveMapping &curve_mapping)
+{
+  mix_in_value(hash, curve_mapping.flag);
+  mix_in_value(hash, curve_mapping.preset);
+  mix_in_value(hash, curve_mapping.clipr);
+  mix_in_value(hash, curve_mapping.black);
+  mix_in_value(hash, curve_mapping.white);
+  mix_in_value(hash, curve_mapping.tone);
+  for (const CurveMap &curve_map : curve_mapping.cm) {
+    mix_in_value(hash, curve_map.ext_in);
+    mix_in_value(hash, curve_map.ext_out);
+    mix_in_array(hash, Span(curve_map.curve, curve_map.totpoint));
+  }
+}
+
+/** Nodes whose outputs depend on more than their inputs and settings. */
+static bool node_depends_on_external_state(const bNode &node)
+{
+  switch (node.type) {
+    case GEO_NODE_INPUT_SCENE_TIME:
+    case GEO_NODE_IS_VIEWPORT:
+    case GEO_NODE_SELF_OBJECT:
+      return true;
+  }
+  for (const bNodeSocket *socket : node.input_sockets()) {
+    if (!socket->is_available()) {
+      continue;
+    }
+    /* The data of referenced objects, collections and images can change without the node tree
+     * changing. Materials are only assigned, so their data doesn't matter. */
+    if (ELEM(socket->type, SOCK_OBJECT, SOCK_COLLECTION, SOCK_IMAGE, SOCK_TEXTURE)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+class CacheKeyBuilder {
+ private:
+  Span<GPointer> group_inputs_;
+  Map<const bNodeTree *, std::optional<ComputeContextHash>> tree_hashes_;
+  Map<int, std::optional<ComputeContextHash>> group_input_hashes_;
+  Map<const bNode *, std::optional<ComputeContextHash>> node_keys_;
+
+ public:
+  CacheKeyBuilder(const Span<GPointer> group_inputs) : group_inputs_(group_inputs)
+  {
+  }
+
+  Map<const bNode *, ComputeContextHash> build(const bNodeTree &tree)
+  {
+    Map<const bNode *, ComputeContextHash> keys;
+    for (const bNode *node : tree.toposort_left_to_right()) {
+      const std::optional<ComputeContextHash> key = this->compute_node_key(*node);
+      node_keys_.add_new(node, key);
+      if (key && node_supports_caching(*node)) {
+        keys.add_new(node, *key);
+      }
+    }
+    return keys;
+  }
+
+ private:
+  /** Mix in everything that influences the outputs of the node, except for linked inputs. */
+  bool mix_in_node_settings(ComputeContextHash &hash, const bNode &node)
+  {
+    if (node_depends_on_external_state(node)) {
+      return false;
+    }
+    mix_in_string(hash, node.idname);
+    mix_in_value(hash, node.custom1);
+    mix_in_value(hash, node.custom2);
+    mix_in_value(hash, node.custom3);
+    mix_in_value(hash, node.custom4);
+    mix_in_value(hash, node.is_muted());
+    if (node.is_group()) {
+      if (node.id == nullptr) {
+        return false;
+      }
+      const std::optional<ComputeContextHash> tree_hash = this->tree_hash(
+          *reinterpret_cast<const bNodeTree *>(node.id));
+      if (!tree_hash) {
+        return false;
+      }
+      mix_in_value(hash, *tree_hash);
+    }
+    else {
+      mix_in_value(hash, node.id);
+    }
+    if (node.type == FN_NODE_INPUT_STRING) {
+      /* The storage only contains a pointer to the string. */
+      const NodeInputString *storage = static_cast<const NodeInputString *>(node.storage);
+      mix_in_string(hash, storage->string ? storage->string : "");
+    }
+    else if (node.storage != nullptr && STREQ(node.typeinfo->storagename, "CurveMapping")) {
+      /* The curve points are edited in place, so they have to be hashed rather than the
+       * pointers to them. */
+      mix_in_curve_mapping(hash, *static_cast<const CurveMapping *>(node.storage));
+    }
+    else if (node.storage != nullptr) {
+      /* Data owned by the storage can change without the storage itself changing, so the node
+       * and everything depending on it can't be cached. */
+      const SDNA &sdna = *DNA_sdna_current_get();
+      const int struct_nr = DNA_struct_find_nr(&sdna, node.typeinfo->storagename);
+      if (struct_nr == -1 || dna_struct_has_pointers(sdna, struct_nr)) {
+        return false;
+      }
+      hash.mix_in(node.storage, int64_t(MEM_allocN_len(node.storage)));
+    }
+    for (const bNodeSocket *socket : node.input_sockets()) {
+      mix_in_value(hash, socket->is_available());
+      /* Default values only point to data-blocks, which are compared by identity. */
+      if (socket->is_available() && socket->default_value != nullptr) {
+        hash.mix_in(socket->default_value, int64_t(MEM_allocN_len(socket->default_value)));
+      }
+    }
+    return true;
+  }
+
+  std::optional<ComputeContextHash> tree_hash(const bNodeTree &tree)
+  {
+    /* Not using #Map::lookup_or_add_cb, because nested groups are added to the map while the
+     * hash is computed. */
+    if (const std::optional<ComputeContextHash> *hash = tree_hashes_.lookup_ptr(&tree)) {
+      return *hash;
+    }
+    const std::optional<ComputeContextHash> hash = this->compute_tree_hash(tree);
+    tree_hashes_.add_new(&tree, hash);
+    return hash;
+  }
+
+  std::optional<ComputeContextHash> compute_tree_hash(const bNodeTree &tree)
+  {
+    tree.ensure_topology_cache();
+    ComputeContextHash hash;
+    for (const bNode *node : tree.all_nodes()) {
+      mix_in_string(hash, node->name);
+      if (!this->mix_in_node_settings(hash, *node)) {
+        return std::nullopt;
+      }
+    }
+    LISTBASE_FOREACH (const bNodeLink *, link, &tree.links) {
+      mix_in_string(hash, link->fromnode->name);
+      mix_in_string(hash, link->fromsock->identifier);
+      mix_in_string(hash, link->tonode->name);
+      mix_in_string(hash, link->tosock->identifier);
+      mix_in_value(hash, link->is_muted());
+    }
+    return hash;
+  }
+
+  std::optional<ComputeContextHash> group_input_hash(const int index)
+  {
+    if (index >= group_inputs_.size()) {
+      return std::nullopt;
+    }
+    return group_input_hashes_.lookup_or_add_cb(index, [&]() -> std::optional<ComputeContextHash> {
+      const GPointer value = group_inputs_[index];
+      const CPPType &type = *value.type();
+      ComputeContextHash hash;
+      mix_in_value(hash, index);
+      if (type.is<GeometrySet>()) {
+        if (!mix_in_geometry(hash, *value.get<GeometrySet>())) {
+          return std::nullopt;
+        }
+        return hash;
+      }
+      if (type.is<Material *>()) {
+        mix_in_value(hash, *value.get<Material *>());
+        return hash;
+      }
+      if (const auto *value_or_field_type = dynamic_cast<const fn::ValueOrFieldCPPType *>(&type)) {
+        if (value_or_field_type->is_field(value.get())) {
+          /* E.g. attribute inputs, which are fields that read from the geometry. */
+          return std::nullopt;
+        }
+        const CPPType &base_type = value_or_field_type->base_type();
+        const void *base_value = value_or_field_type->get_value_ptr(value.get());
+        if (base_type.is<std::string>()) {
+          mix_in_string(hash, *static_cast<const std::string *>(base_value));
+          return hash;
+        }
+        if (base_type.is_trivial()) {
+          hash.mix_in(base_value, base_type.size());
+          return hash;
+        }
+      }
+      /* References to other data-blocks. */
+      return std::nullopt;
+    });
+  }
+
+  std::optional<ComputeContextHash> output_socket_key(const bNodeSocket &socket)
+  {
+    const bNode &node = socket.owner_node();
+    if (node.is_group_input()) {
+      return this->group_input_hash(socket.index());
+    }
+    const std::optional<ComputeContextHash> node_key = node_keys_.lookup_default(&node,
+                                                                                 std::nullopt);
+    if (!node_key) {
+      return std::nullopt;
+    }
+    ComputeContextHash hash = *node_key;
+    mix_in_string(hash, socket.identifier);
+    return hash;
+  }
+
+  std::optional<ComputeContextHash> compute_node_key(const bNode &node)
+  {
+    if (node.is_group_input()) {
+      /* The keys of the group input sockets are computed when they are used. */
+      return std::nullopt;
+    }
+    ComputeContextHash hash;
+    if (!this->mix_in_node_settings(hash, node)) {
+      return std::nullopt;
+    }
+    for (const bNodeSocket *socket : node.input_sockets()) {
+      if (!socket->is_available()) {
+        continue;
+      }
+      mix_in_value(hash, socket->index());
+      for (const bNodeLink *link : socket->directly_linked_links()) {
+        if (link->is_muted() || !link->fromsock->is_available()) {
+          continue;
+        }
+        const std::optional<ComputeContextHash> origin_key = this->output_socket_key(
+            *link->fromsock);
+        if (!origin_key) {
+          return std::nullopt;
+        }
+        mix_in_value(hash, *origin_key);
+      }
+    }
+    return hash;
+  }
+};
+
+Map<const bNode *, ComputeContextHash> compute_node_cache_keys(const bNodeTree &tree,
+                                                               const Span<GPointer> group_inputs)
+{
+  tree.ensure_topology_cache();
+  CacheKeyBuilder builder(group_inputs);
+  return builder.build(tree);
+}
+
+/** \} */
+
+}  // namespace blender::nodes
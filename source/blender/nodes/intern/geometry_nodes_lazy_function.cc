@@ -18,6 +18,7 @@
 
 #include "BLI_lazy_threading.hh"
 #include "BLI_map.hh"
+#include "BLI_trace_event.hh"
 
 #include "DNA_ID.h"
 
@@ -26,6 +27,7 @@
 #include "BKE_type_conversions.hh"
 
 #include "FN_field_cpp_type.hh"
+#include "FN_lazy_function_execute.hh"
 #include "FN_lazy_function_graph_executor.hh"
 
 #include "DEG_depsgraph_query.h"
@@ -111,6 +113,19 @@ static void lazy_function_interface_from_node(const bNode &node,
 class LazyFunctionForGeometryNode : public LazyFunction {
  private:
   const bNode &node_;
+  /**
+   * When true, the inputs are requested lazily, so that they are not computed when the outputs
+   * are found in the #GeometryNodesCache.
+   */
+  bool supports_caching_;
+
+  /** Caching cheap nodes would only cost memory and make copies of their outputs necessary. */
+  static constexpr geo_eval_log::Clock::duration min_cached_execution_time =
+      std::chrono::milliseconds(1);
+
+  struct Storage {
+    bool cache_checked = false;
+  };
 
  public:
   LazyFunctionForGeometryNode(const bNode &node,
@@ -121,6 +136,27 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     BLI_assert(node.typeinfo->geometry_node_execute != nullptr);
     debug_name_ = node.name;
     lazy_function_interface_from_node(node, r_used_inputs, r_used_outputs, inputs_, outputs_);
+    supports_caching_ = node_supports_caching(node);
+    if (supports_caching_) {
+      for (lf::Input &input : inputs_) {
+        input.usage = lf::ValueUsage::Maybe;
+      }
+    }
+  }
+
+  void *init_storage(LinearAllocator<> &allocator) const override
+  {
+    if (!supports_caching_) {
+      return nullptr;
+    }
+    return allocator.construct<Storage>().release();
+  }
+
+  void destruct_storage(void *storage) const override
+  {
+    if (storage != nullptr) {
+      std::destroy_at(static_cast<Storage *>(storage));
+    }
   }
 
   void execute_impl(lf::Params &params, const lf::Context &context) const override
@@ -128,18 +164,136 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     GeoNodesLFUserData *user_data = dynamic_cast<GeoNodesLFUserData *>(context.user_data);
     BLI_assert(user_data != nullptr);
 
+    if (!supports_caching_) {
+      this->execute_node(params, context, *user_data);
+      return;
+    }
+
+    const GeoNodesModifierData &modifier_data = *user_data->modifier_data;
+    const ComputeContextHash *node_key = modifier_data.cache_keys ?
+                                             modifier_data.cache_keys->lookup_ptr(&node_) :
+                                             nullptr;
+    if (modifier_data.cache == nullptr || node_key == nullptr) {
+      if (this->request_all_inputs(params)) {
+        this->execute_node(params, context, *user_data);
+      }
+      return;
+    }
+
+    GeometryNodesCache &cache = *modifier_data.cache;
+    ComputeContextHash key = *node_key;
+    key.mix_in(&user_data->compute_context->hash(), sizeof(ComputeContextHash));
+
+    Storage &storage = *static_cast<Storage *>(context.storage);
+    if (!storage.cache_checked) {
+      storage.cache_checked = true;
+      if (this->try_set_outputs_from_cache(cache, key, params)) {
+        return;
+      }
+    }
+    if (this->request_all_inputs(params)) {
+      this->execute_node_and_cache(cache, key, params, context, *user_data);
+    }
+  }
+
+ private:
+  geo_eval_log::Clock::duration execute_node(lf::Params &params,
+                                             const lf::Context &context,
+                                             GeoNodesLFUserData &user_data) const
+  {
     GeoNodeExecParams geo_params{node_, params, context};
 
     geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
     node_.typeinfo->geometry_node_execute(geo_params);
     geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
 
-    if (geo_eval_log::GeoModifierLog *modifier_log = user_data->modifier_data->eval_log) {
+    if (geo_eval_log::GeoModifierLog *modifier_log = user_data.modifier_data->eval_log) {
       geo_eval_log::GeoTreeLogger &tree_logger = modifier_log->get_local_tree_logger(
-          *user_data->compute_context);
+          *user_data.compute_context);
       tree_logger.node_execution_times.append(
           {tree_logger.allocator->copy_string(node_.name), start_time, end_time});
     }
+    return end_time - start_time;
+  }
+
+  /** \return True when all inputs are available, otherwise the missing inputs are requested. */
+  bool request_all_inputs(lf::Params &params) const
+  {
+    bool all_available = true;
+    for (const int i : inputs_.index_range()) {
+      if (params.try_get_input_data_ptr_or_request(i) == nullptr) {
+        all_available = false;
+      }
+    }
+    return all_available;
+  }
+
+  bool try_set_outputs_from_cache(GeometryNodesCache &cache,
+                                  const ComputeContextHash &key,
+                                  lf::Params &params) const
+  {
+    Array<const CPPType *> types(outputs_.size());
+    Array<void *> values(outputs_.size());
+    for (const int i : outputs_.index_range()) {
+      types[i] = outputs_[i].type;
+      values[i] = params.get_output_data_ptr(i);
+    }
+    if (!cache.lookup(key, types, values)) {
+      return false;
+    }
+    for (const int i : outputs_.index_range()) {
+      params.output_set(i);
+    }
+    for (const int i : inputs_.index_range()) {
+      params.set_input_unused(i);
+    }
+    return true;
+  }
+
+  /**
+   * Execute the node with all outputs being computed into temporary buffers, so that they can be
+   * copied into the cache before they are passed on.
+   */
+  void execute_node_and_cache(GeometryNodesCache &cache,
+                              const ComputeContextHash &key,
+                              lf::Params &params,
+                              const lf::Context &context,
+                              GeoNodesLFUserData &user_data) const
+  {
+    LinearAllocator<> allocator;
+    Array<GMutablePointer> inputs(inputs_.size());
+    Array<GMutablePointer> outputs(outputs_.size());
+    for (const int i : inputs_.index_range()) {
+      inputs[i] = {inputs_[i].type, params.try_get_input_data_ptr(i)};
+    }
+    for (const int i : outputs_.index_range()) {
+      const CPPType &type = *outputs_[i].type;
+      outputs[i] = {type, allocator.allocate(type.size(), type.alignment())};
+    }
+    Array<std::optional<lf::ValueUsage>> input_usages(inputs_.size());
+    Array<lf::ValueUsage> output_usages(outputs_.size(), lf::ValueUsage::Used);
+    Array<bool> set_outputs(outputs_.size(), false);
+    lf::BasicParams node_params{
+        *this, inputs, outputs, input_usages, output_usages, set_outputs};
+
+    const geo_eval_log::Clock::duration execution_time = this->execute_node(
+        node_params, context, user_data);
+    node_params.set_default_remaining_outputs();
+
+    cache.add_miss();
+    if (execution_time >= min_cached_execution_time) {
+      Array<GPointer> values(outputs.size());
+      for (const int i : outputs.index_range()) {
+        values[i] = outputs[i];
+      }
+      cache.add(key, values);
+    }
+
+    for (const int i : outputs.index_range()) {
+      outputs[i].type()->move_construct(outputs[i].get(), params.get_output_data_ptr(i));
+      outputs[i].destruct();
+      params.output_set(i);
+    }
   }
 };
 
@@ -1408,14 +1562,34 @@ GeometryNodesLazyFunctionGraphInfo::~GeometryNodesLazyFunctionGraphInfo()
   }
 }
 
+/** Find corresponding node based on the socket mapping. */
+static const bNode *find_bnode_for_lf_node(const GeometryNodesLazyFunctionGraphInfo &lf_graph_info,
+                                           const lf::FunctionNode &node)
+{
+  auto check_sockets = [&](const Span<const lf::Socket *> lf_sockets) -> const bNode * {
+    for (const lf::Socket *lf_socket : lf_sockets) {
+      const Span<const bNodeSocket *> bsockets =
+          lf_graph_info.mapping.bsockets_by_lf_socket_map.lookup(lf_socket);
+      if (!bsockets.is_empty()) {
+        return &bsockets[0]->owner_node();
+      }
+    }
+    return nullptr;
+  };
+
+  if (const bNode *bnode = check_sockets(node.inputs().cast<const lf::Socket *>())) {
+    return bnode;
+  }
+  return check_sockets(node.outputs().cast<const lf::Socket *>());
+}
+
 [[maybe_unused]] static void add_thread_id_debug_message(
     const GeometryNodesLazyFunctionGraphInfo &lf_graph_info,
     const lf::FunctionNode &node,
     const lf::Context &context)
 {
-  static std::atomic<int> thread_id_source = 0;
-  static thread_local const int thread_id = thread_id_source.fetch_add(1);
-  static thread_local const std::string thread_id_str = "Thread: " + std::to_string(thread_id);
+  static thread_local const std::string thread_id_str = "Thread: " +
+                                                        std::to_string(trace_event::thread_index());
 
   GeoNodesLFUserData *user_data = dynamic_cast<GeoNodesLFUserData *>(context.user_data);
   BLI_assert(user_data != nullptr);
@@ -1425,26 +1599,10 @@ GeometryNodesLazyFunctionGraphInfo::~GeometryNodesLazyFunctionGraphInfo()
   geo_eval_log::GeoTreeLogger &tree_logger =
       user_data->modifier_data->eval_log->get_local_tree_logger(*user_data->compute_context);
 
-  /* Find corresponding node based on the socket mapping. */
-  auto check_sockets = [&](const Span<const lf::Socket *> lf_sockets) {
-    for (const lf::Socket *lf_socket : lf_sockets) {
-      const Span<const bNodeSocket *> bsockets =
-          lf_graph_info.mapping.bsockets_by_lf_socket_map.lookup(lf_socket);
-      if (!bsockets.is_empty()) {
-        const bNodeSocket &bsocket = *bsockets[0];
-        const bNode &bnode = bsocket.owner_node();
-        tree_logger.debug_messages.append(
-            {tree_logger.allocator->copy_string(bnode.name), thread_id_str});
-        return true;
-      }
-    }
-    return false;
-  };
-
-  if (check_sockets(node.inputs().cast<const lf::Socket *>())) {
-    return;
+  if (const bNode *bnode = find_bnode_for_lf_node(lf_graph_info, node)) {
+    tree_logger.debug_messages.append(
+        {tree_logger.allocator->copy_string(bnode->name), thread_id_str});
   }
-  check_sockets(node.outputs().cast<const lf::Socket *>());
 }
 
 void GeometryNodesLazyFunctionLogger::log_before_node_execute(const lf::FunctionNode &node,
@@ -1457,4 +1615,37 @@ void GeometryNodesLazyFunctionLogger::log_before_node_execute(const lf::Function
   }
 }
 
+bool GeometryNodesLazyFunctionLogger::use_node_execution_traces(const lf::Context &context) const
+{
+  GeoNodesLFUserData *user_data = dynamic_cast<GeoNodesLFUserData *>(context.user_data);
+  BLI_assert(user_data != nullptr);
+  return user_data->modifier_data->eval_log != nullptr;
+}
+
+void GeometryNodesLazyFunctionLogger::log_node_execution_trace(
+    const lf::FunctionNode &node,
+    const lf::NodeExecutionTrace &trace,
+    const lf::Context &context) const
+{
+  GeoNodesLFUserData *user_data = dynamic_cast<GeoNodesLFUserData *>(context.user_data);
+  BLI_assert(user_data != nullptr);
+  if (user_data->modifier_data->eval_log == nullptr) {
+    return;
+  }
+  /* Nodes that don't correspond to a node in the node tree (e.g. implicit conversions) are not
+   * logged, their time is part of the node they are connected to in the UI anyway. */
+  const bNode *bnode = find_bnode_for_lf_node(lf_graph_info_, node);
+  if (bnode == nullptr) {
+    return;
+  }
+  geo_eval_log::GeoTreeLogger &tree_logger =
+      user_data->modifier_data->eval_log->get_local_tree_logger(*user_data->compute_context);
+  tree_logger.node_execution_traces.append({tree_logger.allocator->copy_string(bnode->name),
+                                            trace.start,
+                                            trace.end,
+                                            trace.input_wait_time,
+                                            trace_event::thread_index(),
+                                            trace.thread_migrated});
+}
+
 }  // namespace blender::nodes
@@ -3,6 +3,8 @@
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_geometry_nodes_log.hh"
 
+#include "BLI_trace_event.hh"
+
 #include "BKE_compute_contexts.hh"
 #include "BKE_curves.hh"
 #include "BKE_node_runtime.hh"
@@ -234,6 +236,11 @@ void GeoTreeLog::ensure_node_run_time()
       this->nodes.lookup_or_add_default_as(timings.node_name).run_time += duration;
       this->run_time_sum += duration;
     }
+    for (const GeoTreeLogger::NodeExecutionTrace &trace : tree_logger->node_execution_traces) {
+      GeoNodeLog &node_log = this->nodes.lookup_or_add_default_as(trace.node_name);
+      node_log.input_wait_time += trace.input_wait_time;
+      node_log.thread_migrations += trace.thread_migrated;
+    }
   }
   for (const ComputeContextHash &child_hash : children_hashes_) {
     GeoTreeLog &child_log = modifier_log_->get_tree_log(child_hash);
@@ -521,6 +528,46 @@ static std::optional<ObjectAndModifier> get_modifier_for_node_editor(const Space
   return ObjectAndModifier{object, used_modifier};
 }
 
+void GeoModifierLog::write_node_execution_traces(std::ostream &stream)
+{
+  std::optional<TimePoint> start_time;
+  for (LocalData &local_data : data_per_thread_) {
+    for (const destruct_ptr<GeoTreeLogger> &tree_logger :
+         local_data.tree_logger_by_context.values()) {
+      for (const GeoTreeLogger::NodeExecutionTrace &trace : tree_logger->node_execution_traces) {
+        if (!start_time || trace.start < *start_time) {
+          start_time = trace.start;
+        }
+      }
+    }
+  }
+
+  /* Time stamps are in micro-seconds, relative to the start of the first node. */
+  auto to_microseconds = [](const std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+
+  trace_event::Writer writer(stream);
+  for (LocalData &local_data : data_per_thread_) {
+    for (const destruct_ptr<GeoTreeLogger> &tree_logger :
+         local_data.tree_logger_by_context.values()) {
+      const std::string category = tree_logger->group_node_name.value_or("");
+      for (const GeoTreeLogger::NodeExecutionTrace &trace : tree_logger->node_execution_traces) {
+        const std::array<trace_event::EventArg, 2> args = {
+            {{"input_wait_us", to_microseconds(trace.input_wait_time)},
+             {"thread_migrated", trace.thread_migrated ? 1.0 : 0.0}}};
+        writer.complete_event({trace.node_name,
+                               category,
+                               to_microseconds(trace.start - *start_time),
+                               to_microseconds(trace.end - trace.start),
+                               0,
+                               trace.thread_id,
+                               args});
+      }
+    }
+  }
+}
+
 GeoTreeLog *GeoModifierLog::get_tree_log_for_node_editor(const SpaceNode &snode)
 {
   std::optional<ObjectAndModifier> object_and_modifier = get_modifier_for_node_editor(snode);
@@ -0,0 +1,602 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <mutex>
+#include <sstream>
+
+#include "BLI_array.hh"
+#include "BLI_color.hh"
+#include "BLI_map.hh"
+#include "BLI_math_base.h"
+#include "BLI_math_vec_types.hh"
+#include "BLI_task.hh"
+
+#include "DNA_userdef_types.h"
+
+#include "FN_field.hh"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_context.h"
+#include "GPU_platform.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_storage_buffer.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "NOD_geometry.h"
+#include "NOD_gpu_fields.hh"
+
+namespace blender::nodes {
+
+using fn::FieldConstant;
+using fn::FieldContext;
+using fn::FieldNode;
+using fn::FieldNodeType;
+using fn::FieldOperation;
+using fn::GField;
+using fn::GFieldRef;
+using fn::MFParamType;
+
+/**
+ * Evaluating small fields on the GPU is slower than on the CPU, because the data has to be copied
+ * to the GPU and back.
+ */
+static constexpr int64_t min_gpu_elements_num = 1 << 17;
+/**
+ * Fields are evaluated in chunks to limit the size of the storage buffers, which may be as small
+ * as 128 MB, and the memory used for temporary buffers.
+ */
+static constexpr int64_t chunk_elements_num = 1 << 22;
+static constexpr int local_work_group_size = 256;
+/** The minimum number of storage buffers that a compute shader may access. */
+static constexpr int max_storage_buffers_num = 8;
+static constexpr int max_cached_shaders_num = 64;
+
+/* -------------------------------------------------------------------- */
+/** \name GPU Field Function
+ * \{ */
+
+GPUFieldFunction::GPUFieldFunction(const fn::MultiFunction &fn, GPUFieldFunctionCode code)
+    : fn_(fn), code_(std::move(code))
+{
+  this->set_signature(&fn_.signature());
+}
+
+GPUFieldFunction::GPUFieldFunction(std::shared_ptr<fn::MultiFunction> fn,
+                                   GPUFieldFunctionCode code)
+    : owned_fn_(std::move(fn)), fn_(*owned_fn_), code_(std::move(code))
+{
+  this->set_signature(&fn_.signature());
+}
+
+void GPUFieldFunction::call(IndexMask mask, fn::MFParams params, fn::MFContext context) const
+{
+  fn_.call(mask, params, context);
+}
+
+fn::MultiFunction::ExecutionHints GPUFieldFunction::get_execution_hints() const
+{
+  return fn_.execution_hints();
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Shader Generation
+ * \{ */
+
+/**
+ * How values of a type are represented in GLSL. In storage buffers, all types are stored with
+ * four bytes per component, so that the CPU data can be copied directly (except for booleans).
+ */
+struct GPUFieldType {
+  const char *glsl_type;
+  const char *buffer_type;
+  int components_num;
+};
+
+static const GPUFieldType *get_gpu_field_type(const CPPType &type)
+{
+  static const GPUFieldType float_type{"float", "float", 1};
+  static const GPUFieldType float3_type{"vec3", "float", 3};
+  static const GPUFieldType color_type{"vec4", "float", 4};
+  static const GPUFieldType int_type{"int", "int", 1};
+  static const GPUFieldType bool_type{"bool", "int", 1};
+  if (type.is<float>()) {
+    return &float_type;
+  }
+  if (type.is<float3>()) {
+    return &float3_type;
+  }
+  if (type.is<ColorGeometry4f>()) {
+    return &color_type;
+  }
+  if (type.is<int>()) {
+    return &int_type;
+  }
+  if (type.is<bool>()) {
+    return &bool_type;
+  }
+  return nullptr;
+}
+
+static std::string constant_literal(const CPPType &type, const void *value)
+{
+  if (type.is<bool>()) {
+    return *static_cast<const bool *>(value) ? "true" : "false";
+  }
+  if (type.is<int>()) {
+    return std::to_string(*static_cast<const int *>(value));
+  }
+  /* Use the exact bits of the floats, decimal literals may be rounded differently. */
+  const GPUFieldType &gpu_type = *get_gpu_field_type(type);
+  const uint32_t *bits = static_cast<const uint32_t *>(value);
+  std::stringstream ss;
+  if (gpu_type.components_num > 1) {
+    ss << gpu_type.glsl_type << "(";
+  }
+  for (const int i : IndexRange(gpu_type.components_num)) {
+    ss << (i > 0 ? ", " : "") << "uintBitsToFloat(" << bits[i] << "u)";
+  }
+  if (gpu_type.components_num > 1) {
+    ss << ")";
+  }
+  return ss.str();
+}
+
+static std::string buffer_read(const GPUFieldType &type, const StringRef buffer)
+{
+  std::stringstream ss;
+  if (type.components_num == 1) {
+    ss << buffer << "[index]";
+    if (STREQ(type.glsl_type, "bool")) {
+      ss << " != 0";
+    }
+    return ss.str();
+  }
+  ss << type.glsl_type << "(";
+  for (const int i : IndexRange(type.components_num)) {
+    ss << (i > 0 ? ", " : "") << buffer << "[index * " << type.components_num << " + " << i
+       << "]";
+  }
+  ss << ")";
+  return ss.str();
+}
+
+static std::string buffer_write(const GPUFieldType &type,
+                                const StringRef buffer,
+                                const StringRef variable)
+{
+  std::stringstream ss;
+  if (type.components_num == 1) {
+    ss << "  " << buffer << "[index] = ";
+    if (STREQ(type.glsl_type, "bool")) {
+      ss << variable << " ? 1 : 0;\n";
+    }
+    else {
+      ss << variable << ";\n";
+    }
+    return ss.str();
+  }
+  for (const int i : IndexRange(type.components_num)) {
+    ss << "  " << buffer << "[index * " << type.components_num << " + " << i
+       << "] = " << variable << "[" << i << "];\n";
+  }
+  return ss.str();
+}
+
+/** Replace the `$0` and `$r0` placeholders of a #GPUFieldFunctionCode statement. */
+static std::string substitute_statement(const StringRef statement,
+                                        const Span<std::string> inputs,
+                                        const Span<std::string> outputs)
+{
+  std::string result;
+  int64_t i = 0;
+  while (i < statement.size()) {
+    if (statement[i] != '$') {
+      result += statement[i++];
+      continue;
+    }
+    i++;
+    const bool is_output = i < statement.size() && statement[i] == 'r';
+    if (is_output) {
+      i++;
+    }
+    int index = 0;
+    while (i < statement.size() && statement[i] >= '0' && statement[i] <= '9') {
+      index = index * 10 + (statement[i++] - '0');
+    }
+    result += is_output ? outputs[index] : inputs[index];
+  }
+  return result;
+}
+
+/**
+ * Translates a field tree to the body of a compute shader. Every field is either computed by
+ * GLSL code, is a constant literal, or is read from a storage buffer that contains the values
+ * computed on the CPU.
+ */
+class GPUFieldShaderBuilder {
+ private:
+  Map<GFieldRef, std::string> variables_;
+  int variables_num_ = 0;
+
+ public:
+  /** Fields that are evaluated on the CPU and passed to the shader in input buffers. */
+  Vector<GFieldRef> cpu_fields;
+  Vector<const char *> libraries;
+  std::stringstream body;
+  int operations_num = 0;
+
+  /**
+   * Get the GLSL expression for the value of the field, which is added to the shader if
+   * necessary. Returns none when the type of the field isn't supported in shaders.
+   */
+  std::optional<std::string> get_variable(const GFieldRef &field)
+  {
+    if (const std::string *variable = variables_.lookup_ptr(field)) {
+      return *variable;
+    }
+    const GPUFieldType *type = get_gpu_field_type(field.cpp_type());
+    if (type == nullptr) {
+      return std::nullopt;
+    }
+    const FieldNode &node = field.node();
+    if (node.node_type() == FieldNodeType::Constant) {
+      const FieldConstant &constant = static_cast<const FieldConstant &>(node);
+      std::string literal = constant_literal(constant.type(), constant.value().get());
+      variables_.add_new(field, literal);
+      return literal;
+    }
+    if (node.node_type() == FieldNodeType::Operation) {
+      const FieldOperation &operation = static_cast<const FieldOperation &>(node);
+      const GPUFieldFunction *fn = dynamic_cast<const GPUFieldFunction *>(
+          &operation.multi_function());
+      if (fn != nullptr && this->try_add_operation(operation, *fn)) {
+        return variables_.lookup(field);
+      }
+    }
+    return this->add_cpu_field(field, *type);
+  }
+
+ private:
+  bool try_add_operation(const FieldOperation &operation, const GPUFieldFunction &fn)
+  {
+    for (const GField &input : operation.inputs()) {
+      if (get_gpu_field_type(input.cpp_type()) == nullptr) {
+        return false;
+      }
+    }
+    Vector<const GPUFieldType *> output_types;
+    for (const MFParamType &param_type : fn.signature().param_types) {
+      if (param_type.interface_type() == MFParamType::Output) {
+        const GPUFieldType *type = get_gpu_field_type(param_type.data_type().single_type());
+        if (type == nullptr) {
+          return false;
+        }
+        output_types.append(type);
+      }
+    }
+
+    Vector<std::string> inputs;
+    for (const GField &input : operation.inputs()) {
+      inputs.append(*this->get_variable(input));
+    }
+    Vector<std::string> outputs;
+    for (const int i : output_types.index_range()) {
+      std::string variable = "v" + std::to_string(variables_num_++);
+      body << "  " << output_types[i]->glsl_type << " " << variable << ";\n";
+      variables_.add_new(GFieldRef(operation, i), variable);
+      outputs.append(std::move(variable));
+    }
+    body << "  " << substitute_statement(fn.code().statement, inputs, outputs) << "\n";
+
+    for (const char *library : fn.code().libraries) {
+      libraries.append_non_duplicates(library);
+    }
+    operations_num++;
+    return true;
+  }
+
+  std::string add_cpu_field(const GFieldRef &field, const GPUFieldType &type)
+  {
+    const int index = cpu_fields.append_and_get_index(field);
+    std::string variable = "in_" + std::to_string(index);
+    body << "  " << type.glsl_type << " " << variable << " = "
+         << buffer_read(type, variable + "_data") << ";\n";
+    variables_.add_new(field, variable);
+    return variable;
+  }
+};
+
+static void add_buffer_declaration(std::stringstream &ss,
+                                   const int binding,
+                                   const char *qualifier,
+                                   const GPUFieldType &type,
+                                   const StringRef name)
+{
+  ss << "layout(std430, binding = " << binding << ") " << qualifier << " buffer " << name
+     << "_buf\n{\n  " << type.buffer_type << " " << name << "_data[];\n};\n";
+}
+
+static std::string build_shader_source(const GPUFieldShaderBuilder &builder,
+                                       const Span<GFieldRef> fields,
+                                       const Span<std::string> output_variables)
+{
+  std::stringstream ss;
+  ss << "layout(local_size_x = " << local_work_group_size << ") in;\n\n";
+  for (const int i : builder.cpu_fields.index_range()) {
+    const GPUFieldType &type = *get_gpu_field_type(builder.cpu_fields[i].cpp_type());
+    add_buffer_declaration(ss, i, "readonly", type, "in_" + std::to_string(i));
+  }
+  for (const int i : fields.index_range()) {
+    const GPUFieldType &type = *get_gpu_field_type(fields[i].cpp_type());
+    add_buffer_declaration(
+        ss, builder.cpu_fields.size() + i, "writeonly", type, "out_" + std::to_string(i));
+  }
+  ss << "\nuniform int elements_num;\n\n";
+  ss << "void main()\n{\n";
+  ss << "  int index = int(gl_GlobalInvocationID.x);\n";
+  ss << "  if (index >= elements_num) {\n    return;\n  }\n";
+  ss << "  float unused_float;\n  vec3 unused_vec3;\n  vec4 unused_vec4;\n";
+  ss << builder.body.str();
+  for (const int i : fields.index_range()) {
+    const GPUFieldType &type = *get_gpu_field_type(fields[i].cpp_type());
+    ss << buffer_write(type, "out_" + std::to_string(i) + "_data", output_variables[i]);
+  }
+  ss << "}\n";
+  return ss.str();
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Evaluation Backend
+ * \{ */
+
+/** Copy the values in the mask to a buffer with four bytes per component. */
+static void pack_buffer(const GVArray &varray, const IndexMask mask, void *r_buffer)
+{
+  if (varray.type().is<bool>()) {
+    const VArray<bool> values = varray.typed<bool>();
+    int *dst = static_cast<int *>(r_buffer);
+    threading::parallel_for(mask.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        dst[i] = values[mask[i]];
+      }
+    });
+    return;
+  }
+  const int64_t type_size = varray.type().size();
+  threading::parallel_for(mask.index_range(), 4096, [&](const IndexRange range) {
+    varray.materialize_compressed_to_uninitialized(
+        mask.slice(range), POINTER_OFFSET(r_buffer, type_size * range.start()));
+  });
+}
+
+/** Copy the values computed on the GPU to the indices in the mask. */
+static void unpack_buffer(const void *buffer, const IndexMask mask, GMutableSpan r_values)
+{
+  if (r_values.type().is<bool>()) {
+    const int *src = static_cast<const int *>(buffer);
+    MutableSpan<bool> dst = r_values.typed<bool>();
+    threading::parallel_for(mask.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        dst[mask[i]] = src[i] != 0;
+      }
+    });
+    return;
+  }
+  const int64_t type_size = r_values.type().size();
+  threading::parallel_for(mask.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      memcpy(POINTER_OFFSET(r_values.data(), type_size * mask[i]),
+             POINTER_OFFSET(buffer, type_size * i),
+             type_size);
+    }
+  });
+}
+
+class GPUFieldEvaluationBackend : public fn::FieldEvaluationBackend {
+ private:
+  bool (*context_enable_)();
+  void (*context_disable_)();
+
+  /** Protects the cached shaders, whose uniforms are changed for every dispatch. */
+  mutable std::mutex mutex_;
+  mutable Map<std::string, GPUShader *> shaders_;
+
+ public:
+  GPUFieldEvaluationBackend(bool (*context_enable)(), void (*context_disable)())
+      : context_enable_(context_enable), context_disable_(context_disable)
+  {
+  }
+
+  bool try_evaluate(ResourceScope &scope,
+                    const Span<GFieldRef> fields,
+                    const IndexMask mask,
+                    const FieldContext &context,
+                    const Span<GMutableSpan> r_outputs) const override
+  {
+    if (!USER_EXPERIMENTAL_TEST(&U, use_gpu_field_evaluation)) {
+      return false;
+    }
+    if (mask.size() < min_gpu_elements_num) {
+      return false;
+    }
+    /* The shaders are written in GLSL directly. */
+    if (GPU_backend_get_type() != GPU_BACKEND_OPENGL || !GPU_compute_shader_support() ||
+        !GPU_shader_storage_buffer_objects_support()) {
+      return false;
+    }
+
+    GPUFieldShaderBuilder builder;
+    Vector<std::string> output_variables;
+    for (const GFieldRef &field : fields) {
+      std::optional<std::string> variable = builder.get_variable(field);
+      if (!variable) {
+        return false;
+      }
+      output_variables.append(std::move(*variable));
+    }
+    if (builder.operations_num == 0) {
+      return false;
+    }
+    if (builder.cpu_fields.size() + fields.size() > max_storage_buffers_num) {
+      return false;
+    }
+    const std::string source = build_shader_source(builder, fields, output_variables);
+
+    /* Evaluate the parts of the tree that can't be lowered before a GPU context is acquired.
+     * Those fields are never lowered to a shader themselves, so this doesn't recurse further. */
+    const Vector<GVArray> cpu_values = fn::evaluate_fields(
+        scope, builder.cpu_fields, mask, context);
+
+    /* Use the context of the calling thread if it has one, e.g. on the main thread. */
+    const bool use_active_context = GPU_context_active_get() != nullptr;
+    if (!use_active_context && !context_enable_()) {
+      return false;
+    }
+    bool success;
+    {
+      std::lock_guard lock{mutex_};
+      success = this->dispatch(source, builder.libraries, cpu_values, mask, r_outputs);
+    }
+    if (!use_active_context) {
+      context_disable_();
+    }
+    return success;
+  }
+
+  /** Has to be called with an active GPU context. */
+  void free_shaders()
+  {
+    std::lock_guard lock{mutex_};
+    for (GPUShader *shader : shaders_.values()) {
+      if (shader != nullptr) {
+        GPU_shader_free(shader);
+      }
+    }
+    shaders_.clear();
+  }
+
+ private:
+  GPUShader *ensure_shader(const std::string &source, const Span<const char *> libraries) const
+  {
+    std::string key = source;
+    for (const char *library : libraries) {
+      key += library;
+    }
+    if (GPUShader **shader = shaders_.lookup_ptr(key)) {
+      return *shader;
+    }
+    if (shaders_.size() >= max_cached_shaders_num) {
+      for (GPUShader *shader : shaders_.values()) {
+        if (shader != nullptr) {
+          GPU_shader_free(shader);
+        }
+      }
+      shaders_.clear();
+    }
+    char *libcode = GPU_shader_library_source_get(const_cast<const char **>(libraries.data()),
+                                                  int(libraries.size()));
+    /* Failed compilations are cached as well, so that they are not tried again. */
+    GPUShader *shader = GPU_shader_create_compute(
+        source.c_str(), libcode, nullptr, "gpu_field_evaluation");
+    MEM_freeN(libcode);
+    shaders_.add_new(std::move(key), shader);
+    return shader;
+  }
+
+  bool dispatch(const std::string &source,
+                const Span<const char *> libraries,
+                const Span<GVArray> cpu_values,
+                const IndexMask mask,
+                const Span<GMutableSpan> r_outputs) const
+  {
+    GPUShader *shader = this->ensure_shader(source, libraries);
+    if (shader == nullptr) {
+      return false;
+    }
+    GPU_shader_bind(shader);
+
+    Array<GPUStorageBuf *> buffers(cpu_values.size() + r_outputs.size());
+    Array<int> temp_buffer;
+    for (int64_t chunk_start = 0; chunk_start < mask.size(); chunk_start += chunk_elements_num) {
+      const IndexRange chunk(chunk_start,
+                             std::min(chunk_elements_num, mask.size() - chunk_start));
+      const IndexMask chunk_mask = mask.slice(chunk);
+
+      for (const int i : cpu_values.index_range()) {
+        const GVArray &varray = cpu_values[i];
+        const int components_num = get_gpu_field_type(varray.type())->components_num;
+        temp_buffer.reinitialize(chunk.size() * components_num);
+        pack_buffer(varray, chunk_mask, temp_buffer.data());
+        buffers[i] = GPU_storagebuf_create_ex(
+            temp_buffer.as_span().size_in_bytes(), temp_buffer.data(), GPU_USAGE_STREAM, __func__);
+        GPU_storagebuf_bind(buffers[i], i);
+      }
+      for (const int i : r_outputs.index_range()) {
+        const int components_num = get_gpu_field_type(r_outputs[i].type())->components_num;
+        const int binding = cpu_values.size() + i;
+        buffers[binding] = GPU_storagebuf_create_ex(sizeof(int) * chunk.size() * components_num,
+                                                    nullptr,
+                                                    GPU_USAGE_DEVICE_ONLY,
+                                                    __func__);
+        GPU_storagebuf_bind(buffers[binding], binding);
+      }
+
+      GPU_shader_uniform_1i(shader, "elements_num", int(chunk.size()));
+      GPU_compute_dispatch(
+          shader, divide_ceil_u(uint(chunk.size()), local_work_group_size), 1, 1);
+      GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE);
+
+      for (const int i : r_outputs.index_range()) {
+        GPUStorageBuf *buffer = buffers[cpu_values.size() + i];
+        const GMutableSpan output = r_outputs[i];
+        if (chunk_mask.is_range() && !output.type().is<bool>()) {
+          /* Read the values to their final location directly. */
+          GPU_storagebuf_read(buffer, output.slice(chunk_mask.as_range()).data());
+          continue;
+        }
+        const int components_num = get_gpu_field_type(output.type())->components_num;
+        temp_buffer.reinitialize(chunk.size() * components_num);
+        GPU_storagebuf_read(buffer, temp_buffer.data());
+        unpack_buffer(temp_buffer.data(), chunk_mask, output);
+      }
+
+      for (GPUStorageBuf *buffer : buffers) {
+        GPU_storagebuf_free(buffer);
+      }
+    }
+
+    GPU_storagebuf_unbind_all();
+    GPU_shader_unbind();
+    return true;
+  }
+};
+
+static std::unique_ptr<GPUFieldEvaluationBackend> g_backend;
+
+/** \} */
+
+}  // namespace blender::nodes
+
+void geometry_nodes_gpu_fields_register(bool (*context_enable)(void),
+                                        void (*context_disable)(void))
+{
+  using namespace blender::nodes;
+  g_backend = std::make_unique<GPUFieldEvaluationBackend>(context_enable, context_disable);
+  blender::fn::set_field_evaluation_backend(g_backend.get());
+}
+
+void geometry_nodes_gpu_fields_free(void)
+{
+  using namespace blender::nodes;
+  if (g_backend) {
+    blender::fn::set_field_evaluation_backend(nullptr);
+    g_backend->free_shaders();
+    g_backend.reset();
+  }
+}
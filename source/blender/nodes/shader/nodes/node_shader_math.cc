@@ -7,6 +7,7 @@
 
 #include "node_shader_util.hh"
 
+#include "NOD_gpu_fields.hh"
 #include "NOD_math_functions.hh"
 #include "NOD_socket_search_link.hh"
 
@@ -102,16 +103,36 @@ static int gpu_shader_math(GPUMaterial *mat,
   return 0;
 }
 
-static const fn::MultiFunction *get_base_multi_function(const bNode &node)
+/**
+ * Clamping is fused into the element function of the math operation, so that both are evaluated
+ * in the same devirtualized loop. This avoids a second pass over the output array and keeps the
+ * intermediate value in a register.
+ */
+static float clamp_result(const float value)
+{
+  return clamp_f(value, 0.0f, 1.0f);
+}
+
+static const fn::MultiFunction *get_multi_function(const bNode &node)
 {
   const int mode = node.custom1;
+  const bool clamp_output = node.custom2 != 0;
   const fn::MultiFunction *base_fn = nullptr;
 
   try_dispatch_float_math_fl_to_fl(
       mode, [&](auto devi_fn, auto function, const FloatMathOperationInfo &info) {
-        static fn::CustomMF_SI_SO<float, float> fn{
-            info.title_case_name.c_str(), function, devi_fn};
-        base_fn = &fn;
+        if (clamp_output) {
+          static fn::CustomMF_SI_SO<float, float> fn{
+              info.title_case_name.c_str(),
+              [function](float a) { return clamp_result(function(a)); },
+              devi_fn};
+          base_fn = &fn;
+        }
+        else {
+          static fn::CustomMF_SI_SO<float, float> fn{
+              info.title_case_name.c_str(), function, devi_fn};
+          base_fn = &fn;
+        }
       });
   if (base_fn != nullptr) {
     return base_fn;
@@ -119,9 +140,18 @@ static const fn::MultiFunction *get_base_multi_function(const bNode &node)
 
   try_dispatch_float_math_fl_fl_to_fl(
       mode, [&](auto devi_fn, auto function, const FloatMathOperationInfo &info) {
-        static fn::CustomMF_SI_SI_SO<float, float, float> fn{
-            info.title_case_name.c_str(), function, devi_fn};
-        base_fn = &fn;
+        if (clamp_output) {
+          static fn::CustomMF_SI_SI_SO<float, float, float> fn{
+              info.title_case_name.c_str(),
+              [function](float a, float b) { return clamp_result(function(a, b)); },
+              devi_fn};
+          base_fn = &fn;
+        }
+        else {
+          static fn::CustomMF_SI_SI_SO<float, float, float> fn{
+              info.title_case_name.c_str(), function, devi_fn};
+          base_fn = &fn;
+        }
       });
   if (base_fn != nullptr) {
     return base_fn;
@@ -129,9 +159,18 @@ static const fn::MultiFunction *get_base_multi_function(const bNode &node)
 
   try_dispatch_float_math_fl_fl_fl_to_fl(
       mode, [&](auto devi_fn, auto function, const FloatMathOperationInfo &info) {
-        static fn::CustomMF_SI_SI_SI_SO<float, float, float, float> fn{
-            info.title_case_name.c_str(), function, devi_fn};
-        base_fn = &fn;
+        if (clamp_output) {
+          static fn::CustomMF_SI_SI_SI_SO<float, float, float, float> fn{
+              info.title_case_name.c_str(),
+              [function](float a, float b, float c) { return clamp_result(function(a, b, c)); },
+              devi_fn};
+          base_fn = &fn;
+        }
+        else {
+          static fn::CustomMF_SI_SI_SI_SO<float, float, float, float> fn{
+              info.title_case_name.c_str(), function, devi_fn};
+          base_fn = &fn;
+        }
       });
   if (base_fn != nullptr) {
     return base_fn;
@@ -140,43 +179,37 @@ static const fn::MultiFunction *get_base_multi_function(const bNode &node)
   return nullptr;
 }
 
-class ClampWrapperFunction : public fn::MultiFunction {
- private:
-  const fn::MultiFunction &fn_;
-
- public:
-  ClampWrapperFunction(const fn::MultiFunction &fn) : fn_(fn)
-  {
-    this->set_signature(&fn.signature());
+/**
+ * The GLSL functions of the math node take three inputs for every operation, unused inputs are
+ * ignored.
+ */
+static GPUFieldFunctionCode get_gpu_field_code(const fn::MultiFunction &fn,
+                                               const char *shader_name,
+                                               const bool clamp_output)
+{
+  const int inputs_num = fn.param_amount() - 1;
+  std::string statement = std::string(shader_name) + "(";
+  for (const int i : IndexRange(3)) {
+    statement += (i < inputs_num ? "$" + std::to_string(i) : std::string("0.0")) + ", ";
   }
-
-  void call(IndexMask mask, fn::MFParams params, fn::MFContext context) const override
-  {
-    fn_.call(mask, params, context);
-
-    /* Assumes the output parameter is the last one. */
-    const int output_param_index = this->param_amount() - 1;
-    /* This has actually been initialized in the call above. */
-    MutableSpan<float> results = params.uninitialized_single_output<float>(output_param_index);
-
-    for (const int i : mask) {
-      float &value = results[i];
-      CLAMP(value, 0.0f, 1.0f);
-    }
+  statement += "$r0);";
+  if (clamp_output) {
+    statement += " $r0 = clamp($r0, 0.0, 1.0);";
   }
-};
+  return {std::move(statement), {"gpu_shader_common_math.glsl"}};
+}
 
 static void sh_node_math_build_multi_function(NodeMultiFunctionBuilder &builder)
 {
-  const fn::MultiFunction *base_function = get_base_multi_function(builder.node());
-
-  const bool clamp_output = builder.node().custom2 != 0;
-  if (clamp_output) {
-    builder.construct_and_set_matching_fn<ClampWrapperFunction>(*base_function);
-  }
-  else {
-    builder.set_matching_fn(base_function);
+  const bNode &node = builder.node();
+  const fn::MultiFunction *fn = get_multi_function(node);
+  const char *shader_name = gpu_shader_get_name(node.custom1);
+  if (fn == nullptr || shader_name == nullptr) {
+    builder.set_matching_fn(fn);
+    return;
   }
+  builder.construct_and_set_matching_fn<GPUFieldFunction>(
+      *fn, get_gpu_field_code(*fn, shader_name, node.custom2 != 0));
 }
 
 }  // namespace blender::nodes::node_shader_math_cc
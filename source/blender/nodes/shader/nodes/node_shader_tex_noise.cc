@@ -5,6 +5,8 @@
 
 #include "BLI_noise.hh"
 
+#include "NOD_gpu_fields.hh"
+
 #include "UI_interface.h"
 #include "UI_resources.h"
 
@@ -232,10 +234,31 @@ class NoiseFunction : public fn::MultiFunction {
   }
 };
 
+/**
+ * The GLSL noise functions take all inputs (Vector, W, Scale, Detail, Roughness and Distortion)
+ * for every dimension, and compute both outputs.
+ */
+static GPUFieldFunctionCode get_gpu_field_code(const int dimensions)
+{
+  int inputs_num = 0;
+  auto next_input = [&]() { return "$" + std::to_string(inputs_num++); };
+  const std::string vector = ELEM(dimensions, 2, 3, 4) ? next_input() : std::string("vec3(0.0)");
+  const std::string w = ELEM(dimensions, 1, 4) ? next_input() : std::string("0.0");
+  std::string statement = std::string(gpu_shader_get_name(dimensions)) + "(" + vector + ", " + w;
+  /* Scale, Detail, Roughness and Distortion. */
+  for (int i = 0; i < 4; i++) {
+    statement += ", " + next_input();
+  }
+  statement += ", $r0, $r1);";
+  return {std::move(statement), {"gpu_shader_material_tex_noise.glsl"}};
+}
+
 static void sh_node_noise_build_multi_function(NodeMultiFunctionBuilder &builder)
 {
   const NodeTexNoise &storage = node_storage(builder.node());
-  builder.construct_and_set_matching_fn<NoiseFunction>(storage.dimensions);
+  builder.construct_and_set_matching_fn<GPUFieldFunction>(
+      std::make_shared<NoiseFunction>(storage.dimensions),
+      get_gpu_field_code(storage.dimensions));
 }
 
 }  // namespace blender::nodes::node_shader_tex_noise_cc
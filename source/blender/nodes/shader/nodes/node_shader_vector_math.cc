@@ -7,6 +7,7 @@
 
 #include "node_shader_util.hh"
 
+#include "NOD_gpu_fields.hh"
 #include "NOD_math_functions.hh"
 #include "NOD_socket_search_link.hh"
 
@@ -304,10 +305,46 @@ static const fn::MultiFunction *get_multi_function(const bNode &node)
   return nullptr;
 }
 
+/**
+ * The GLSL functions of the vector math node take three vectors and a scale for every operation,
+ * and output a vector and a value.
+ */
+static GPUFieldFunctionCode get_gpu_field_code(const fn::MultiFunction &fn,
+                                               const char *shader_name)
+{
+  std::string vectors[3] = {"vec3(0.0)", "vec3(0.0)", "vec3(0.0)"};
+  std::string scale = "1.0";
+  std::string output_vector = "unused_vec3";
+  std::string output_value = "unused_float";
+  int vectors_num = 0;
+  int inputs_num = 0;
+  for (const int param_index : fn.param_indices()) {
+    const MFParamType param_type = fn.param_type(param_index);
+    const bool is_vector = param_type.data_type().single_type().is<float3>();
+    if (param_type.interface_type() == MFParamType::Input) {
+      std::string &argument = is_vector ? vectors[vectors_num++] : scale;
+      argument = "$" + std::to_string(inputs_num++);
+    }
+    else {
+      (is_vector ? output_vector : output_value) = "$r0";
+    }
+  }
+  std::string statement = std::string(shader_name) + "(" + vectors[0] + ", " + vectors[1] + ", " +
+                          vectors[2] + ", " + scale + ", " + output_vector + ", " +
+                          output_value + ");";
+  return {std::move(statement), {"gpu_shader_material_vector_math.glsl"}};
+}
+
 static void sh_node_vector_math_build_multi_function(NodeMultiFunctionBuilder &builder)
 {
   const fn::MultiFunction *fn = get_multi_function(builder.node());
-  builder.set_matching_fn(fn);
+  const char *shader_name = gpu_shader_get_name(builder.node().custom1);
+  if (fn == nullptr || shader_name == nullptr) {
+    builder.set_matching_fn(fn);
+    return;
+  }
+  builder.construct_and_set_matching_fn<GPUFieldFunction>(*fn,
+                                                          get_gpu_field_code(*fn, shader_name));
 }
 
 }  // namespace blender::nodes::node_shader_vector_math_cc
@@ -29,6 +29,7 @@
 
 /* modules */
 #include "bpy_app_icons.h"
+#include "bpy_app_memory_profiler.h"
 #include "bpy_app_timers.h"
 
 #include "BLI_utildefines.h"
@@ -114,6 +115,7 @@ static PyStructSequence_Field app_info_fields[] = {
     /* Modules (not struct sequence). */
     {"icons", "Manage custom icons"},
     {"timers", "Manage timers"},
+    {"memory_profiler", "Sample memory allocations"},
     {NULL},
 };
 
@@ -199,6 +201,7 @@ static PyObject *make_app_info(void)
   /* modules */
   SetObjItem(BPY_app_icons_module());
   SetObjItem(BPY_app_timers_module());
+  SetObjItem(BPY_app_memory_profiler_module());
 
 #undef SetIntItem
 #undef SetStrItem
@@ -427,6 +430,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_set,
      bpy_app_debug_doc,
      (void *)G_DEBUG_DEPSGRAPH_PRETTY},
+    {"debug_depsgraph_profile",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_DEPSGRAPH_PROFILE},
     {"debug_simdata",
      bpy_app_debug_get,
      bpy_app_debug_set,
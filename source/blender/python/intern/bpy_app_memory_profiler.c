@@ -0,0 +1,196 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Access to the sampling allocation profiler of guarded-alloc.
+ */
+
+#include <Python.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "bpy_app_memory_profiler.h"
+
+PyDoc_STRVAR(bpy_app_memory_profiler_start_doc,
+             ".. function:: start(sample_interval=1000)\n"
+             "\n"
+             "   Start recording every n-th memory allocation of each thread, previous samples\n"
+             "   are discarded. Sampled allocations are tracked until they are freed.\n"
+             "\n"
+             "   :arg sample_interval: Number of allocations per sample.\n"
+             "   :type sample_interval: int\n");
+static PyObject *bpy_app_memory_profiler_start(PyObject *UNUSED(self),
+                                               PyObject *args,
+                                               PyObject *kw)
+{
+  int sample_interval = 1000;
+
+  static const char *_keywords[] = {"sample_interval", NULL};
+  static _PyArg_Parser _parser = {
+      "|" /* Optional arguments. */
+      "i" /* `sample_interval` */
+      ":start",
+      _keywords,
+      0,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &sample_interval)) {
+    return NULL;
+  }
+  if (sample_interval < 1) {
+    PyErr_SetString(PyExc_ValueError, "sample_interval must be a positive number");
+    return NULL;
+  }
+
+  MEM_profiler_start((uint)sample_interval);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_memory_profiler_stop_doc,
+             ".. function:: stop()\n"
+             "\n"
+             "   Stop recording allocations and discard the samples.\n");
+static PyObject *bpy_app_memory_profiler_stop(PyObject *UNUSED(self))
+{
+  MEM_profiler_stop();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_memory_profiler_is_running_doc,
+             ".. function:: is_running()\n"
+             "\n"
+             "   :return: True when allocations are being sampled.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_memory_profiler_is_running(PyObject *UNUSED(self))
+{
+  return PyBool_FromLong(MEM_profiler_is_running());
+}
+
+static void bpy_app_memory_profiler_snapshot_append(void *user_data,
+                                                    const char *name,
+                                                    uint stack_hash,
+                                                    size_t blocks_num,
+                                                    size_t size)
+{
+  PyObject *list = user_data;
+  PyObject *item = Py_BuildValue("(sInn)",
+                                 name ? name : "",
+                                 stack_hash,
+                                 (Py_ssize_t)blocks_num,
+                                 (Py_ssize_t)size);
+  if (item) {
+    PyList_Append(list, item);
+    Py_DECREF(item);
+  }
+}
+
+PyDoc_STRVAR(bpy_app_memory_profiler_snapshot_doc,
+             ".. function:: snapshot()\n"
+             "\n"
+             "   Get the sampled allocations that are still in use, grouped by allocation name\n"
+             "   and call-stack. Multiply the sizes by the sample interval to estimate the\n"
+             "   total memory held by a group.\n"
+             "\n"
+             "   :return: (name, stack_hash, sampled_blocks, sampled_size) tuples.\n"
+             "   :rtype: list of tuples\n");
+static PyObject *bpy_app_memory_profiler_snapshot(PyObject *UNUSED(self))
+{
+  PyObject *list = PyList_New(0);
+  MEM_profiler_snapshot(bpy_app_memory_profiler_snapshot_append, list);
+  if (PyErr_Occurred()) {
+    Py_DECREF(list);
+    return NULL;
+  }
+  return list;
+}
+
+PyDoc_STRVAR(bpy_app_memory_profiler_snapshot_write_doc,
+             ".. function:: snapshot_write(filepath)\n"
+             "\n"
+             "   Write the sampled allocations that are still in use to a CSV file, sorted by\n"
+             "   size.\n"
+             "\n"
+             "   :arg filepath: Path of the file to write.\n"
+             "   :type filepath: str\n");
+static PyObject *bpy_app_memory_profiler_snapshot_write(PyObject *UNUSED(self),
+                                                        PyObject *args,
+                                                        PyObject *kw)
+{
+  PyObject *filepath_obj;
+
+  static const char *_keywords[] = {"filepath", NULL};
+  static _PyArg_Parser _parser = {
+      "O&" /* `filepath` */
+      ":snapshot_write",
+      _keywords,
+      0,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(
+          args, kw, &_parser, PyUnicode_FSConverter, &filepath_obj)) {
+    return NULL;
+  }
+
+  if (!MEM_profiler_is_running()) {
+    Py_DECREF(filepath_obj);
+    PyErr_SetString(PyExc_RuntimeError, "memory profiler is not running");
+    return NULL;
+  }
+  const bool success = MEM_profiler_snapshot_write(PyBytes_AS_STRING(filepath_obj));
+  if (!success) {
+    PyErr_Format(PyExc_OSError, "could not write '%s'", PyBytes_AS_STRING(filepath_obj));
+  }
+  Py_DECREF(filepath_obj);
+  if (!success) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static struct PyMethodDef M_AppMemoryProfiler_methods[] = {
+    {"start",
+     (PyCFunction)bpy_app_memory_profiler_start,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_memory_profiler_start_doc},
+    {"stop",
+     (PyCFunction)bpy_app_memory_profiler_stop,
+     METH_NOARGS,
+     bpy_app_memory_profiler_stop_doc},
+    {"is_running",
+     (PyCFunction)bpy_app_memory_profiler_is_running,
+     METH_NOARGS,
+     bpy_app_memory_profiler_is_running_doc},
+    {"snapshot",
+     (PyCFunction)bpy_app_memory_profiler_snapshot,
+     METH_NOARGS,
+     bpy_app_memory_profiler_snapshot_doc},
+    {"snapshot_write",
+     (PyCFunction)bpy_app_memory_profiler_snapshot_write,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_memory_profiler_snapshot_write_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef M_AppMemoryProfiler_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "bpy.app.memory_profiler",   /* m_name */
+    NULL,                        /* m_doc */
+    0,                           /* m_size */
+    M_AppMemoryProfiler_methods, /* m_methods */
+    NULL,                        /* m_slots */
+    NULL,                        /* m_traverse */
+    NULL,                        /* m_clear */
+    NULL,                        /* m_free */
+};
+
+PyObject *BPY_app_memory_profiler_module(void)
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+
+  PyObject *mod = PyModule_Create(&M_AppMemoryProfiler_module_def);
+
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+
+  return mod;
+}
@@ -5284,6 +5284,27 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Get a C-contiguous buffer of any dimension, so arrays like `numpy.empty((len(verts), 3))` can be
+ * copied to and from directly, without reshaping or converting every item.
+ * Returns false (with the error cleared) when the object can't provide one.
+ */
+static bool foreach_get_contiguous_buffer(PyObject *seq, Py_buffer *buf, const bool writable)
+{
+  const int flags = PyBUF_ND | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+  if (PyObject_GetBuffer(seq, buf, flags) == -1) {
+    PyErr_Clear();
+    return false;
+  }
+  return true;
+}
+
+/** Number of items in all dimensions of the buffer. */
+static int foreach_buffer_len(const Py_buffer *buf)
+{
+  return buf->itemsize ? (int)(buf->len / buf->itemsize) : 0;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5311,18 +5332,18 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
     buffer_is_compat = false;
     if (PyObject_CheckBuffer(seq)) {
       Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
+      if (foreach_get_contiguous_buffer(seq, &buf, false)) {
+        /* Check if the buffer matches. */
 
-      /* Check if the buffer matches. */
+        buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
-      buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
+        if (buffer_is_compat) {
+          ok = RNA_property_collection_raw_set(
+              NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, foreach_buffer_len(&buf));
+        }
 
-      if (buffer_is_compat) {
-        ok = RNA_property_collection_raw_set(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        PyBuffer_Release(&buf);
       }
-
-      PyBuffer_Release(&buf);
     }
 
     /* Could not use the buffer, fallback to sequence. */
@@ -5367,18 +5388,18 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
     buffer_is_compat = false;
     if (PyObject_CheckBuffer(seq)) {
       Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
+      if (foreach_get_contiguous_buffer(seq, &buf, true)) {
+        /* Check if the buffer matches, TODO: signed/unsigned types. */
 
-      /* Check if the buffer matches, TODO: signed/unsigned types. */
+        buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
-      buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
+        if (buffer_is_compat) {
+          ok = RNA_property_collection_raw_get(
+              NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, foreach_buffer_len(&buf));
+        }
 
-      if (buffer_is_compat) {
-        ok = RNA_property_collection_raw_get(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+        PyBuffer_Release(&buf);
       }
-
-      PyBuffer_Release(&buf);
     }
 
     /* Could not use the buffer, fallback to sequence. */
@@ -81,6 +81,13 @@ bool RE_bake_engine(struct Render *re,
                     int pass_filter,
                     float result[]);
 
+/**
+ * Free the render engine kept by #RE_bake_engine. The engine is shared by all objects baked with
+ * the same render and dependency graph, so it only synchronizes the scene once. Must be called
+ * before the dependency graph is freed.
+ */
+void RE_bake_engine_free(struct Render *re);
+
 /* bake.c */
 
 int RE_pass_depth(eScenePassType pass_type);
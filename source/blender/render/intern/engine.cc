@@ -842,7 +842,8 @@ bool RE_bake_engine(Render *re,
   /* render */
   engine = re->engine;
 
-  if (!engine) {
+  const bool is_new_engine = (engine == nullptr);
+  if (is_new_engine) {
     engine = RE_engine_create(type);
     re->engine = engine;
   }
@@ -858,8 +859,9 @@ bool RE_bake_engine(Render *re,
   if (type->bake) {
     engine->depsgraph = depsgraph;
 
-    /* update is only called so we create the engine.session */
-    if (type->update) {
+    /* Update is only called so we create the engine session. Objects baked later reuse the
+     * session and the scene it already synchronized, see #RE_bake_engine_free. */
+    if (is_new_engine && type->update) {
       type->update(engine, re->main, engine->depsgraph);
     }
 
@@ -890,11 +892,6 @@ bool RE_bake_engine(Render *re,
 
   engine->flag &= ~RE_ENGINE_RENDERING;
 
-  engine_depsgraph_free(engine);
-
-  RE_engine_free(engine);
-  re->engine = nullptr;
-
   if (BKE_reports_contain(re->reports, RPT_ERROR)) {
     G.is_break = true;
   }
@@ -902,6 +899,20 @@ bool RE_bake_engine(Render *re,
   return true;
 }
 
+void RE_bake_engine_free(Render *re)
+{
+  RenderEngine *engine = re->engine;
+  if (engine == nullptr) {
+    return;
+  }
+  BLI_assert(!(engine->flag & RE_ENGINE_RENDERING));
+
+  engine_depsgraph_free(engine);
+
+  RE_engine_free(engine);
+  re->engine = nullptr;
+}
+
 /* Render */
 
 static void engine_render_view_layer(Render *re,
@@ -5,12 +5,16 @@
  * \ingroup render
  */
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <thread>
 
 #include "DNA_anim_types.h"
 #include "DNA_collection_types.h"
@@ -31,6 +35,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_system.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 #include "BLI_vector.hh"
@@ -154,12 +159,15 @@ static void render_callback_exec_id(Render *re, Main *bmain, ID *id, eCbEvent ev
 /** \name Allocation & Free
  * \{ */
 
+class RenderImageWriter;
+
 static bool do_write_image_or_movie(Render *re,
                                     Main *bmain,
                                     Scene *scene,
                                     bMovieHandle *mh,
                                     const int totvideos,
-                                    const char *name_override);
+                                    const char *name_override,
+                                    RenderImageWriter *writer);
 
 /* default callbacks, set in each new render */
 static void result_nothing(void * /*arg*/, RenderResult * /*rr*/)
@@ -1818,7 +1826,7 @@ void RE_RenderFrame(Render *re,
                                      nullptr);
 
         /* reports only used for Movie */
-        do_write_image_or_movie(re, bmain, scene, nullptr, 0, name);
+        do_write_image_or_movie(re, bmain, scene, nullptr, 0, name, nullptr);
       }
     }
 
@@ -2000,12 +2008,209 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Background Image Writing
+ *
+ * With #R_ASYNC_WRITE, the frames of an image sequence are written by a background thread while
+ * the next frame renders. The render result is copied so rendering can continue, and the number
+ * of copies waiting to be written is limited by their memory usage. Frames are written one at a
+ * time in frame order, which also keeps stamping with the font of the render thread-safe.
+ * \{ */
+
+struct RenderImageWrite {
+  RenderResult *rr;
+  /** Copy of the scene settings of the frame, the scene changes while the next frame renders. */
+  Scene scene;
+  char filepath[FILE_MAX];
+  size_t mem_size;
+  /** Gathered in the background and moved to the render reports when the write is finished. */
+  ReportList reports;
+  bool started;
+  bool done;
+  bool ok;
+};
+
+static size_t render_result_mem_size(const RenderResult *rr)
+{
+  size_t mem_size = 0;
+  LISTBASE_FOREACH (const RenderLayer *, rl, &rr->layers) {
+    LISTBASE_FOREACH (const RenderPass *, rpass, &rl->passes) {
+      if (rpass->rect) {
+        mem_size += MEM_allocN_len(rpass->rect);
+      }
+    }
+  }
+  LISTBASE_FOREACH (const RenderView *, rv, &rr->views) {
+    if (rv->rectf) {
+      mem_size += MEM_allocN_len(rv->rectf);
+    }
+    if (rv->rectz) {
+      mem_size += MEM_allocN_len(rv->rectz);
+    }
+    if (rv->rect32) {
+      mem_size += MEM_allocN_len(rv->rect32);
+    }
+  }
+  return mem_size;
+}
+
+class RenderImageWriter : blender::NonCopyable, blender::NonMovable {
+ private:
+  std::mutex mutex_;
+  /** Notified when a write is added or finished, or when the thread has to stop. */
+  std::condition_variable cond_;
+  /** Writes that were not handled by #finish_written yet, in frame order. */
+  blender::Vector<RenderImageWrite *> writes_;
+  size_t mem_budget_;
+  size_t mem_in_use_ = 0;
+  bool stop_ = false;
+  std::thread thread_;
+
+ public:
+  RenderImageWriter()
+  {
+    /* Use at most a quarter of the system memory for frames that wait to be written. */
+    mem_budget_ = BLI_system_memory_max_in_megabytes() * 1024 * 1024 / 4;
+    thread_ = std::thread([this]() { this->run(); });
+  }
+
+  ~RenderImageWriter()
+  {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    /* The thread writes all remaining frames before it stops. */
+    thread_.join();
+    for (RenderImageWrite *write : writes_) {
+      BKE_reports_clear(&write->reports);
+      MEM_delete(write);
+    }
+  }
+
+  /**
+   * Write a copy of the render result in the background. Waits for earlier frames to be written
+   * first when they use too much memory.
+   */
+  void push(RenderResult *rr, const Scene *scene, const char *filepath)
+  {
+    const size_t mem_size = render_result_mem_size(rr);
+    {
+      /* Always allow one frame to be written, even when it is larger than the budget. */
+      std::unique_lock lock(mutex_);
+      cond_.wait(lock, [&]() {
+        return mem_in_use_ == 0 || mem_in_use_ + mem_size <= mem_budget_;
+      });
+    }
+
+    RenderImageWrite *write = MEM_new<RenderImageWrite>(__func__);
+    write->rr = RE_DuplicateRenderResult(rr);
+    memcpy(&write->scene, scene, sizeof(Scene));
+    BLI_strncpy(write->filepath, filepath, sizeof(write->filepath));
+    write->mem_size = mem_size;
+    BKE_reports_init(&write->reports, RPT_STORE | RPT_PRINT_HANDLED_BY_OWNER);
+    write->started = false;
+    write->done = false;
+    write->ok = false;
+
+    {
+      std::lock_guard lock(mutex_);
+      mem_in_use_ += mem_size;
+      writes_.append(write);
+    }
+    cond_.notify_all();
+  }
+
+  /**
+   * Move the reports of the written frames to the render and run the render write handlers for
+   * them, in frame order. When \a wait_all is true, waits for all frames to be written first.
+   * \return False if writing any of the frames failed.
+   */
+  bool finish_written(Render *re, Scene *scene, const bool wait_all)
+  {
+    bool ok = true;
+    std::unique_lock lock(mutex_);
+    while (!writes_.is_empty()) {
+      RenderImageWrite *write = writes_.first();
+      if (!write->done) {
+        if (!wait_all) {
+          break;
+        }
+        cond_.wait(lock);
+        continue;
+      }
+      writes_.remove(0);
+      lock.unlock();
+
+      LISTBASE_FOREACH (Report *, report, &write->reports.list) {
+        BKE_report(re->reports, eReportType(report->type), report->message);
+      }
+      BKE_reports_clear(&write->reports);
+
+      if (write->ok) {
+        /* Handlers expect the current frame to be the one that was written. */
+        const int cfra = scene->r.cfra;
+        const float subframe = scene->r.subframe;
+        scene->r.cfra = write->scene.r.cfra;
+        scene->r.subframe = write->scene.r.subframe;
+        render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        scene->r.cfra = cfra;
+        scene->r.subframe = subframe;
+      }
+      else {
+        ok = false;
+      }
+      MEM_delete(write);
+
+      lock.lock();
+    }
+    return ok;
+  }
+
+ private:
+  void run()
+  {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      RenderImageWrite **found = std::find_if(writes_.begin(),
+                                              writes_.end(),
+                                              [](const RenderImageWrite *write) {
+                                                return !write->started;
+                                              });
+      if (found == writes_.end()) {
+        if (stop_) {
+          return;
+        }
+        cond_.wait(lock);
+        continue;
+      }
+      RenderImageWrite *write = *found;
+      write->started = true;
+      lock.unlock();
+
+      write->ok = BKE_image_render_write(
+          &write->reports, write->rr, &write->scene, true, write->filepath);
+      RE_FreeRenderResult(write->rr);
+      write->rr = nullptr;
+
+      lock.lock();
+      write->done = true;
+      mem_in_use_ -= write->mem_size;
+      cond_.notify_all();
+    }
+  }
+};
+
+/** \} */
+
 static bool do_write_image_or_movie(Render *re,
                                     Main *bmain,
                                     Scene *scene,
                                     bMovieHandle *mh,
                                     const int totvideos,
-                                    const char *name_override)
+                                    const char *name_override,
+                                    RenderImageWriter *writer)
 {
   char name[FILE_MAX];
   RenderResult rres;
@@ -2041,7 +2246,12 @@ static bool do_write_image_or_movie(Render *re,
       }
 
       /* write images as individual images or stereo */
-      ok = BKE_image_render_write(re->reports, &rres, scene, true, name);
+      if (writer) {
+        writer->push(&rres, scene, name);
+      }
+      else {
+        ok = BKE_image_render_write(re->reports, &rres, scene, true, name);
+      }
     }
 
     RE_ReleaseResultImageViews(re, &rres);
@@ -2144,6 +2354,11 @@ void RE_RenderAnim(Render *re,
 
   render_init_depsgraph(re);
 
+  RenderImageWriter *writer = nullptr;
+  if (!is_movie && do_write_file && (rd.mode & R_ASYNC_WRITE)) {
+    writer = new RenderImageWriter();
+  }
+
   if (is_movie && do_write_file) {
     size_t width, height;
     int i;
@@ -2309,7 +2524,7 @@ void RE_RenderAnim(Render *re,
 
       if (re->test_break(re->tbh) == 0) {
         if (!G.is_break) {
-          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, nullptr)) {
+          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, nullptr, writer)) {
             G.is_break = true;
           }
         }
@@ -2319,6 +2534,11 @@ void RE_RenderAnim(Render *re,
       }
 
       if (G.is_break == true) {
+        if (writer) {
+          /* Placeholders of frames that are being written are not empty once they are done. */
+          writer->finish_written(re, scene, true);
+        }
+
         /* remove touched file */
         if (is_movie == false && do_write_file) {
           if (rd.mode & R_TOUCH) {
@@ -2353,11 +2573,27 @@ void RE_RenderAnim(Render *re,
       if (G.is_break == false) {
         /* keep after file save */
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
-        render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        if (writer) {
+          /* Usually the previous frame, the current one is still being written. */
+          if (!writer->finish_written(re, scene, false)) {
+            G.is_break = true;
+            break;
+          }
+        }
+        else {
+          render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        }
       }
     }
   }
 
+  if (writer) {
+    if (!writer->finish_written(re, scene, true)) {
+      G.is_break = true;
+    }
+    delete writer;
+  }
+
   /* end movie */
   if (is_movie && do_write_file) {
     re_movie_free_all(re, mh, totvideos);
@@ -9,6 +9,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_DerivedMesh.h"
@@ -54,6 +55,12 @@ class TextureMarginMap {
   uint32_t value_to_store_;
   char *mask_;
 
+  /** A margin pixel in a row of the map, and the location in the image to fill it from. */
+  struct MarginPixel {
+    int x;
+    float2 dest;
+  };
+
   MPoly const *mpoly_;
   MLoop const *mloop_;
   MLoopUV const *mloopuv_;
@@ -211,75 +218,101 @@ class TextureMarginMap {
    * Walk over the map and for margin pixels follow the direction stored in the bottom 3
    * bits back to the polygon.
    * Then look up the pixel from the next polygon.
+   *
+   * Finding the source locations only reads the map, so it is done for all rows in parallel.
+   * The pixels are then interpolated in row order, because a source location can be next to
+   * margin pixels that are filled earlier in the same pass.
    */
   void lookup_pixels(ImBuf *ibuf, char *mask, int maxPolygonSteps)
   {
+    Array<Vector<MarginPixel>> margin_pixels_by_row(h_);
+
+    threading::parallel_for(IndexRange(h_), 8, [&](const IndexRange rows) {
+      for (const int y : rows) {
+        lookup_pixels_in_row(y, mask, maxPolygonSteps, margin_pixels_by_row[y]);
+      }
+    });
+
     for (int y = 0; y < h_; y++) {
-      for (int x = 0; x < w_; x++) {
-        uint32_t dp = get_pixel(x, y);
-        if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
-          int dist = DijkstraPixelGetDistance(dp);
-          int direction = DijkstraPixelGetDirection(dp);
-
-          int xx = x;
-          int yy = y;
-
-          /* Follow the dijkstra directions to find the polygon this margin pixels belongs to. */
-          while (dist > 0) {
-            xx -= directions[direction][0];
-            yy -= directions[direction][1];
-            dp = get_pixel(xx, yy);
-            dist -= distances[direction];
-            BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
-            direction = DijkstraPixelGetDirection(dp);
-          }
+      for (const MarginPixel &pixel : margin_pixels_by_row[y]) {
+        bilinear_interpolation(ibuf, ibuf, pixel.dest.x, pixel.dest.y, pixel.x, y);
+        /* Add our new pixels to the assigned pixel map. */
+        mask[y * w_ + pixel.x] = 1;
+      }
+    }
+  }
 
-          uint32_t poly = get_pixel(xx, yy);
+ private:
+  /**
+   * Find the source locations of the margin pixels in one row of the map, and mark the pixels
+   * that are not margin pixels in the mask.
+   */
+  void lookup_pixels_in_row(const int y,
+                            char *mask,
+                            const int maxPolygonSteps,
+                            Vector<MarginPixel> &r_margin_pixels)
+  {
+    for (int x = 0; x < w_; x++) {
+      uint32_t dp = get_pixel(x, y);
+      if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
+        int dist = DijkstraPixelGetDistance(dp);
+        int direction = DijkstraPixelGetDirection(dp);
+
+        int xx = x;
+        int yy = y;
+
+        /* Follow the dijkstra directions to find the polygon this margin pixels belongs to. */
+        while (dist > 0) {
+          xx -= directions[direction][0];
+          yy -= directions[direction][1];
+          dp = get_pixel(xx, yy);
+          dist -= distances[direction];
+          BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
+          direction = DijkstraPixelGetDirection(dp);
+        }
 
-          BLI_assert(!IsDijkstraPixel(poly));
+        uint32_t poly = get_pixel(xx, yy);
 
-          float destX, destY;
+        BLI_assert(!IsDijkstraPixel(poly));
 
-          int other_poly;
-          bool found_pixel_in_polygon = false;
-          if (lookup_pixel_polygon_neighbourhood(x, y, &poly, &destX, &destY, &other_poly)) {
+        float destX, destY;
 
-            for (int i = 0; i < maxPolygonSteps; i++) {
-              /* Force to pixel grid. */
-              int nx = int(round(destX));
-              int ny = int(round(destY));
-              uint32_t polygon_from_map = get_pixel(nx, ny);
-              if (other_poly == polygon_from_map) {
-                found_pixel_in_polygon = true;
-                break;
-              }
+        int other_poly;
+        bool found_pixel_in_polygon = false;
+        if (lookup_pixel_polygon_neighbourhood(x, y, &poly, &destX, &destY, &other_poly)) {
 
-              float dist_to_edge;
-              /* Look up again, but starting from the polygon we were expected to land in. */
-              if (!lookup_pixel(nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
-                found_pixel_in_polygon = false;
-                break;
-              }
+          for (int i = 0; i < maxPolygonSteps; i++) {
+            /* Force to pixel grid. */
+            int nx = int(round(destX));
+            int ny = int(round(destY));
+            uint32_t polygon_from_map = get_pixel(nx, ny);
+            if (other_poly == polygon_from_map) {
+              found_pixel_in_polygon = true;
+              break;
             }
 
-            if (found_pixel_in_polygon) {
-              bilinear_interpolation(ibuf, ibuf, destX, destY, x, y);
-              /* Add our new pixels to the assigned pixel map. */
-              mask[y * w_ + x] = 1;
+            float dist_to_edge;
+            /* Look up again, but starting from the polygon we were expected to land in. */
+            if (!lookup_pixel(nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
+              found_pixel_in_polygon = false;
+              break;
             }
           }
-        }
-        else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
-          /* These are not margin pixels, make sure the extend filter which is run after this step
-           * leaves them alone.
-           */
-          mask[y * w_ + x] = 1;
+
+          if (found_pixel_in_polygon) {
+            r_margin_pixels.append({x, float2(destX, destY)});
+          }
         }
       }
+      else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
+        /* These are not margin pixels, make sure the extend filter which is run after this step
+         * leaves them alone.
+         */
+        mask[y * w_ + x] = 1;
+      }
     }
   }
 
- private:
   float2 uv_to_xy(MLoopUV const &mloopuv) const
   {
     float2 ret;
@@ -57,6 +57,23 @@ void SEQ_relations_check_uuids_unique_and_report(const struct Scene *scene);
 void SEQ_relations_session_uuid_generate(struct Sequence *sequence);
 
 void SEQ_cache_cleanup(struct Scene *scene);
+
+typedef struct SeqCacheStatistics {
+  /** Lookups of images in memory, thumbnails excluded. */
+  int hit_count;
+  int miss_count;
+  /** Memory in bytes used by images of each cache type. */
+  size_t raw_size;
+  size_t preprocessed_size;
+  size_t composite_size;
+  size_t final_size;
+  size_t thumbnail_size;
+} SeqCacheStatistics;
+
+/**
+ * Get statistics about the memory cache of given scene, all zero if it has no cache.
+ */
+void SEQ_cache_statistics_get(struct Scene *scene, SeqCacheStatistics *r_stats);
 void SEQ_cache_iterate(
     struct Scene *scene,
     void *userdata,
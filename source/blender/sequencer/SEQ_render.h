@@ -41,6 +41,8 @@ typedef struct SeqRenderData {
   int view_id;
   /* ID of task for assigning temp cache entries to particular task(thread, etc.) */
   eSeqTaskId task_id;
+  /* Time the frame started rendering at, used to measure cost of cached images. */
+  double render_start_time;
 
   /* special case for OpenGL render */
   struct GPUOffScreen *gpu_offscreen;
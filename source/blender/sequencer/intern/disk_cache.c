@@ -8,6 +8,7 @@
 #include <memory.h>
 #include <stddef.h>
 #include <time.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -26,8 +27,10 @@
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_main.h"
@@ -52,7 +55,9 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * Zlib compression with user definable level can be used to compress image data(per image)
+ * Zstd compression with user definable level can be used to compress image data(per image).
+ * Images are compressed in chunks of DCACHE_COMPRESSION_CHUNK_SIZE bytes in parallel, each chunk
+ * is a separate Zstd frame, so that they can be decompressed as a single stream.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -66,6 +71,7 @@
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 2
+#define DCACHE_COMPRESSION_CHUNK_SIZE (1 << 20) /* 1mb */
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
 
 typedef struct DiskCacheHeaderEntry {
@@ -420,6 +426,33 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
+typedef struct DiskCacheCompressData {
+  const char *data;
+  size_t size;
+  int level;
+  void **chunks;
+  size_t *chunks_size;
+} DiskCacheCompressData;
+
+static void seq_disk_cache_compress_chunk(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DiskCacheCompressData *data = (DiskCacheCompressData *)userdata;
+  const size_t offset = (size_t)chunk * DCACHE_COMPRESSION_CHUNK_SIZE;
+  const size_t size = MIN2(DCACHE_COMPRESSION_CHUNK_SIZE, data->size - offset);
+
+  const size_t out_len = ZSTD_compressBound(size);
+  void *out = MEM_mallocN(out_len, __func__);
+  const size_t out_size = ZSTD_compress(out, out_len, data->data + offset, size, data->level);
+  if (ZSTD_isError(out_size)) {
+    MEM_freeN(out);
+    return;
+  }
+  data->chunks[chunk] = out;
+  data->chunks_size[chunk] = out_size;
+}
+
 static size_t deflate_imbuf_to_file(ImBuf *ibuf,
                                     FILE *file,
                                     int level,
@@ -427,14 +460,47 @@ static size_t deflate_imbuf_to_file(ImBuf *ibuf,
 {
   void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
 
-  /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
+  /* Write directly to the file if compression is not wanted. */
+  if (level <= 0) {
+    fseek(file, header_entry->offset, SEEK_SET);
+    return fwrite(data, 1, header_entry->size_raw, file);
   }
 
+  const int chunks_num = (int)divide_ceil_ul(header_entry->size_raw,
+                                              DCACHE_COMPRESSION_CHUNK_SIZE);
+  DiskCacheCompressData compress_data;
+  compress_data.data = data;
+  compress_data.size = header_entry->size_raw;
+  compress_data.level = level;
+  compress_data.chunks = MEM_callocN(sizeof(void *) * chunks_num, __func__);
+  compress_data.chunks_size = MEM_callocN(sizeof(size_t) * chunks_num, __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, chunks_num, &compress_data, seq_disk_cache_compress_chunk, &settings);
+
+  /* Write chunks in order, they are decompressed as a stream of consecutive frames. */
   fseek(file, header_entry->offset, SEEK_SET);
-  return fwrite(data, 1, header_entry->size_raw, file);
+  size_t bytes_written = 0;
+  for (int i = 0; i < chunks_num; i++) {
+    void *chunk = compress_data.chunks[i];
+    const size_t chunk_size = compress_data.chunks_size[i];
+    if (bytes_written != SIZE_MAX) {
+      if (chunk && fwrite(chunk, 1, chunk_size, file) == chunk_size) {
+        bytes_written += chunk_size;
+      }
+      else {
+        bytes_written = SIZE_MAX;
+      }
+    }
+    MEM_SAFE_FREE(chunk);
+  }
+  MEM_freeN(compress_data.chunks);
+  MEM_freeN(compress_data.chunks_size);
+
+  return bytes_written == SIZE_MAX ? 0 : bytes_written;
 }
 
 static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
@@ -30,6 +30,8 @@
 #include "BLI_path_util.h"
 #include "BLI_threads.h"
 
+#include "PIL_time.h"
+
 #include "BKE_main.h"
 #include "BKE_scene.h"
 
@@ -67,6 +69,11 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Cost: Every entry records how long its frame had been rendering when it was put into cache,
+ * relative to the playback frame duration. When recycling, the distance of a frame from the
+ * current frame is weighted by the cost of its last entry, so that cheap frames are freed before
+ * expensive ones.
  */
 
 #define THUMB_CACHE_LIMIT 5000
@@ -80,6 +87,9 @@ typedef struct SeqCache {
   struct SeqCacheKey *last_key;
   struct SeqDiskCache *disk_cache;
   int thumbnail_count;
+  /* Statistics of RAM cache lookups, thumbnails excluded. */
+  int hit_count;
+  int miss_count;
 } SeqCache;
 
 typedef struct SeqCacheItem {
@@ -323,8 +333,9 @@ static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCac
       rkey = swapkey;
     }
 
-    int l_diff = scene->r.cfra - lkey->timeline_frame;
-    int r_diff = rkey->timeline_frame - scene->r.cfra;
+    /* Frames that were expensive to render are kept as if they were closer to current frame. */
+    const float l_diff = (scene->r.cfra - lkey->timeline_frame) / (1.0f + lkey->cost);
+    const float r_diff = (rkey->timeline_frame - scene->r.cfra) / (1.0f + rkey->cost);
 
     if (l_diff > r_diff) {
       finalkey = lkey;
@@ -502,6 +513,8 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->last_key = NULL;
     cache->bmain = bmain;
     cache->thumbnail_count = 0;
+    cache->hit_count = 0;
+    cache->miss_count = 0;
     BLI_mutex_init(&cache->iterator_mutex);
     scene->ed->cache = cache;
 
@@ -527,6 +540,7 @@ static void seq_cache_populate_key(SeqCacheKey *key,
   key->type = type;
   key->link_prev = NULL;
   key->link_next = NULL;
+  key->cost = 0.0f;
   key->is_temp_cache = true;
   key->task_id = context->task_id;
 }
@@ -620,6 +634,8 @@ void SEQ_cache_cleanup(Scene *scene)
   }
   cache->last_key = NULL;
   cache->thumbnail_count = 0;
+  cache->hit_count = 0;
+  cache->miss_count = 0;
   seq_cache_unlock(scene);
 }
 
@@ -757,6 +773,15 @@ struct ImBuf *seq_cache_get(const SeqRenderData *context,
   if (cache && seq) {
     seq_cache_populate_key(&key, context, seq, timeline_frame, type);
     ibuf = seq_cache_get_ex(cache, &key);
+
+    if (type != SEQ_CACHE_STORE_THUMBNAIL) {
+      if (ibuf) {
+        cache->hit_count++;
+      }
+      else {
+        cache->miss_count++;
+      }
+    }
   }
   seq_cache_unlock(scene);
 
@@ -766,9 +791,12 @@ struct ImBuf *seq_cache_get(const SeqRenderData *context,
 
   /* Try disk cache: */
   if (seq_disk_cache_is_enabled(context->bmain)) {
+    /* Effect inputs may be looked up from several threads. */
+    seq_cache_lock(scene);
     if (cache->disk_cache == NULL) {
       cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
     }
+    seq_cache_unlock(scene);
 
     ibuf = seq_disk_cache_read_file(cache->disk_cache, &key);
 
@@ -850,6 +878,8 @@ void seq_cache_put(
   }
 
   Scene *scene = context->scene;
+  /* Prefetch context is replaced by the original one, which is not the one rendering. */
+  const double render_start_time = context->render_start_time;
 
   if (context->is_prefetch_render) {
     context = seq_prefetch_get_original_context(context);
@@ -872,6 +902,9 @@ void seq_cache_put(
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+  if (render_start_time > 0.0) {
+    key->cost = (float)((PIL_check_seconds_timer() - render_start_time) * FPS);
+  }
   seq_cache_put_ex(scene, key, i);
   seq_cache_unlock(scene);
 
@@ -915,6 +948,49 @@ void SEQ_cache_iterate(
   seq_cache_unlock(scene);
 }
 
+void SEQ_cache_statistics_get(Scene *scene, SeqCacheStatistics *r_stats)
+{
+  memset(r_stats, 0, sizeof(*r_stats));
+
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache) {
+    return;
+  }
+
+  seq_cache_lock(scene);
+  r_stats->hit_count = cache->hit_count;
+  r_stats->miss_count = cache->miss_count;
+
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, cache->hash) {
+    SeqCacheKey *key = BLI_ghashIterator_getKey(&gh_iter);
+    SeqCacheItem *item = BLI_ghashIterator_getValue(&gh_iter);
+    if (item->ibuf == NULL) {
+      continue;
+    }
+
+    const size_t size = IMB_get_size_in_memory(item->ibuf);
+    switch (key->type) {
+      case SEQ_CACHE_STORE_RAW:
+        r_stats->raw_size += size;
+        break;
+      case SEQ_CACHE_STORE_PREPROCESSED:
+        r_stats->preprocessed_size += size;
+        break;
+      case SEQ_CACHE_STORE_COMPOSITE:
+        r_stats->composite_size += size;
+        break;
+      case SEQ_CACHE_STORE_FINAL_OUT:
+        r_stats->final_size += size;
+        break;
+      case SEQ_CACHE_STORE_THUMBNAIL:
+        r_stats->thumbnail_size += size;
+        break;
+    }
+  }
+  seq_cache_unlock(scene);
+}
+
 bool seq_cache_is_full(void)
 {
   return seq_cache_get_mem_total() < MEM_get_memory_in_use();
@@ -22,6 +22,7 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -44,6 +45,8 @@
 #include "IMB_imbuf_types.h"
 #include "IMB_metadata.h"
 
+#include "PIL_time.h"
+
 #include "RNA_access.h"
 #include "RNA_prototypes.h"
 
@@ -222,6 +225,7 @@ void SEQ_render_new_render_data(Main *bmain,
   r_context->gpu_offscreen = NULL;
   r_context->task_id = SEQ_TASK_MAIN_RENDER;
   r_context->is_prefetch_render = false;
+  r_context->render_start_time = 0.0;
 }
 
 void seq_render_state_init(SeqRenderState *state)
@@ -764,6 +768,89 @@ ImBuf *seq_render_effect_execute_threaded(struct SeqEffectHandle *sh,
   return out;
 }
 
+/* Strips which rendering only reads their own data, so several of them can be rendered at the
+ * same time. Other strips render other strips or scenes, which can't be done concurrently. */
+static bool seq_render_strip_is_isolated(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct RenderEffectInputsData {
+  const SeqRenderData *context;
+  const SeqRenderState *state;
+  Sequence **inputs;
+  float *frames;
+  ImBuf **ibufs;
+} RenderEffectInputsData;
+
+static void render_effect_inputs_task(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RenderEffectInputsData *data = (RenderEffectInputsData *)userdata;
+  if (data->inputs[i] == NULL) {
+    return;
+  }
+  /* Isolated strips don't modify the state, but each task has its own copy anyway. */
+  SeqRenderState state = *data->state;
+  data->ibufs[i] = seq_render_strip(data->context, &state, data->inputs[i], data->frames[i]);
+}
+
+/**
+ * Render effect inputs, at the same time when they are different isolated strips. Decoding
+ * the images of an effect inputs, e.g. the two movies of a transition, is usually what takes
+ * most of the effect render time.
+ */
+static void seq_render_effect_inputs(const SeqRenderData *context,
+                                     SeqRenderState *state,
+                                     Sequence *input[3],
+                                     float frames[3],
+                                     ImBuf *r_ibuf[3])
+{
+  bool use_threading = true;
+  int inputs_num = 0;
+  for (int i = 0; i < 3; i++) {
+    if (input[i] == NULL) {
+      continue;
+    }
+    inputs_num++;
+    /* The same strip at different frames would share its movie decoder. */
+    for (int j = 0; j < i; j++) {
+      use_threading &= input[j] != input[i];
+    }
+    use_threading &= seq_render_strip_is_isolated(input[i]);
+  }
+
+  if (!use_threading || inputs_num < 2) {
+    for (int i = 0; i < 3; i++) {
+      if (input[i]) {
+        r_ibuf[i] = seq_render_strip(context, state, input[i], frames[i]);
+      }
+    }
+    return;
+  }
+
+  RenderEffectInputsData data;
+  data.context = context;
+  data.state = state;
+  data.inputs = input;
+  data.frames = frames;
+  data.ibufs = r_ibuf;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, 3, &data, render_effect_inputs_task, &settings);
+}
+
 static ImBuf *seq_render_effect_strip_impl(const SeqRenderData *context,
                                            SeqRenderState *state,
                                            Sequence *seq,
@@ -810,19 +897,20 @@ static ImBuf *seq_render_effect_strip_impl(const SeqRenderData *context,
     case EARLY_NO_INPUT:
       out = sh.execute(context, seq, timeline_frame, fac, NULL, NULL, NULL);
       break;
-    case EARLY_DO_EFFECT:
+    case EARLY_DO_EFFECT: {
+      Sequence *render_input[3] = {NULL, NULL, NULL};
+      float render_frame[3] = {timeline_frame, timeline_frame, timeline_frame};
       for (i = 0; i < 3; i++) {
         /* Speed effect requires time remapping of `timeline_frame` for input(s). */
         if (input[0] && seq->type == SEQ_TYPE_SPEED) {
-          float target_frame = seq_speed_effect_target_frame_get(scene, seq, timeline_frame, i);
-          ibuf[i] = seq_render_strip(context, state, input[0], target_frame);
+          render_input[i] = input[0];
+          render_frame[i] = seq_speed_effect_target_frame_get(scene, seq, timeline_frame, i);
         }
         else { /* Other effects. */
-          if (input[i]) {
-            ibuf[i] = seq_render_strip(context, state, input[i], timeline_frame);
-          }
+          render_input[i] = input[i];
         }
       }
+      seq_render_effect_inputs(context, state, render_input, render_frame, ibuf);
 
       if (ibuf[0] && (ibuf[1] || SEQ_effect_get_num_inputs(seq->type) == 1)) {
         if (sh.multithreaded) {
@@ -834,6 +922,7 @@ static ImBuf *seq_render_effect_strip_impl(const SeqRenderData *context,
         }
       }
       break;
+    }
     case EARLY_USE_INPUT_1:
       if (input[0]) {
         out = seq_render_strip(context, state, input[0], timeline_frame);
@@ -1958,14 +2047,18 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
 
   if (count && !out) {
     BLI_mutex_lock(&seq_render_mutex);
-    out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
+    SeqRenderData local_context = *context;
+    local_context.render_start_time = PIL_check_seconds_timer();
+    out = seq_render_strip_stack(
+        &local_context, &state, channels, seqbasep, timeline_frame, chanshown);
 
     if (context->is_prefetch_render) {
-      seq_cache_put(context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
+      seq_cache_put(
+          &local_context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
     }
     else {
       seq_cache_put_if_possible(
-          context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
+          &local_context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
     }
     BLI_mutex_unlock(&seq_render_mutex);
   }
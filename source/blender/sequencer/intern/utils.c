@@ -15,6 +15,7 @@
 #include "DNA_mask_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_blenlib.h"
 
@@ -206,6 +207,18 @@ ListBase *SEQ_get_seqbase_from_sequence(Sequence *seq, ListBase **r_channels, in
   return seqbase;
 }
 
+int seq_anim_open_flags_get(const Sequence *seq)
+{
+  int flags = IB_rect;
+  if (seq->flag & SEQ_FILTERY) {
+    flags |= IB_animdeinterlace;
+  }
+  if (U.sequencer_flag & USER_SEQ_USE_HARDWARE_DECODING) {
+    flags |= IB_animhwaccel;
+  }
+  return flags;
+}
+
 void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 {
   char dir[FILE_MAX];
@@ -267,14 +280,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
         if (openfile) {
           sanim->anim = openanim(str,
-                                 IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                 seq_anim_open_flags_get(seq),
                                  seq->streamindex,
                                  seq->strip->colorspace_settings.name);
         }
         else {
           sanim->anim = openanim_noload(str,
-                                        IB_rect |
-                                            ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                        seq_anim_open_flags_get(seq),
                                         seq->streamindex,
                                         seq->strip->colorspace_settings.name);
         }
@@ -286,14 +298,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
         else {
           if (openfile) {
             sanim->anim = openanim(name,
-                                   IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                   seq_anim_open_flags_get(seq),
                                    seq->streamindex,
                                    seq->strip->colorspace_settings.name);
           }
           else {
             sanim->anim = openanim_noload(name,
-                                          IB_rect |
-                                              ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                          seq_anim_open_flags_get(seq),
                                           seq->streamindex,
                                           seq->strip->colorspace_settings.name);
           }
@@ -318,13 +329,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
     if (openfile) {
       sanim->anim = openanim(name,
-                             IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                             seq_anim_open_flags_get(seq),
                              seq->streamindex,
                              seq->strip->colorspace_settings.name);
     }
     else {
       sanim->anim = openanim_noload(name,
-                                    IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                    seq_anim_open_flags_get(seq),
                                     seq->streamindex,
                                     seq->strip->colorspace_settings.name);
     }
@@ -15,6 +15,10 @@ struct ListBase;
 struct Scene;
 
 bool sequencer_seq_generates_image(struct Sequence *seq);
+/**
+ * Flags for opening the movie of `seq` with #openanim.
+ */
+int seq_anim_open_flags_get(const struct Sequence *seq);
 void seq_open_anim_file(struct Scene *scene, struct Sequence *seq, bool openfile);
 Sequence *SEQ_get_meta_by_seqbase(struct ListBase *seqbase_main, struct ListBase *meta_seqbase);
 
@@ -18,6 +18,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -34,6 +35,10 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Below this amount of vertices the solver runs single threaded, threading costs more than it
+ * gains. */
+#  define CLOTH_PARALLEL_LIMIT 512
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -583,49 +588,153 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/* For every vertex, the blocks of a sparse matrix that contribute to its row of a product with
+ * a long vector. This lets the multiplication run over vertices on multiple threads without
+ * write conflicts, and with the same summation order on every run. All matrices of the solver
+ * share the same block layout, so one gather index serves all of them. */
+typedef struct BlockGather {
+  /* The blocks of vertex `i` are `blocks[offsets[i]]` to `blocks[offsets[i + 1] - 1]`. */
+  int *offsets;
+  /* Block index shifted by one bit, the lowest bit is set for blocks used transposed. */
+  int *blocks;
+} BlockGather;
+
+/* Build the gather index of the first #blocks_num blocks of the matrix. */
+static void block_gather_init(BlockGather *gather, const fmatrix3x3 *matrix, uint blocks_num)
 {
-  uint vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+  const uint vcount = matrix[0].vcount;
+  gather->offsets = MEM_calloc_arrayN(vcount + 1, sizeof(int), __func__);
+  gather->blocks = MEM_malloc_arrayN(
+      MAX2(2 * blocks_num - vcount, 1), sizeof(int), "BlockGather.blocks");
 
-  zero_lfvector(to, vcount);
+  /* Diagonal blocks only contribute to their own row, the others to both of their vertices. */
+  for (uint i = 0; i < blocks_num; i++) {
+    gather->offsets[matrix[i].r + 1]++;
+    if (i >= vcount) {
+      gather->offsets[matrix[i].c + 1]++;
+    }
+  }
+  for (uint v = 0; v < vcount; v++) {
+    gather->offsets[v + 1] += gather->offsets[v];
+  }
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (uint i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
+  int *fill = MEM_malloc_arrayN(MAX2(vcount, 1), sizeof(int), __func__);
+  memcpy(fill, gather->offsets, sizeof(int) * vcount);
+  for (uint i = 0; i < blocks_num; i++) {
+    gather->blocks[fill[matrix[i].r]++] = (int)(i << 1);
+    if (i >= vcount) {
+      gather->blocks[fill[matrix[i].c]++] = (int)(i << 1) | 1;
     }
-#  pragma omp section
-    {
-      for (uint i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
+  }
+  MEM_freeN(fill);
+}
+
+static void block_gather_free(BlockGather *gather)
+{
+  MEM_freeN(gather->offsets);
+  MEM_freeN(gather->blocks);
+}
+
+typedef struct BlockGatherMulData {
+  float (*to)[3];
+  const fmatrix3x3 *matrix;
+  const BlockGather *gather;
+  const float (*vector)[3];
+} BlockGatherMulData;
+
+static void mul_bfmatrix_lfvector_gather_cb(void *__restrict userdata,
+                                            const int v,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BlockGatherMulData *data = userdata;
+  const fmatrix3x3 *matrix = data->matrix;
+  const BlockGather *gather = data->gather;
+  float sum[3] = {0.0f, 0.0f, 0.0f};
+
+  for (int j = gather->offsets[v]; j < gather->offsets[v + 1]; j++) {
+    const fmatrix3x3 *block = &matrix[gather->blocks[j] >> 1];
+    if (gather->blocks[j] & 1) {
+      /* This is the lower triangle of the sparse matrix,
+       * therefore multiplication occurs with transposed submatrices. */
+      muladd_fmatrixT_fvector(sum, block->m, data->vector[block->r]);
+    }
+    else {
+      muladd_fmatrix_fvector(sum, block->m, data->vector[block->c]);
     }
   }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
+  copy_v3_v3(data->to[v], sum);
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector, using a prepared gather index. */
+static void mul_bfmatrix_lfvector_gather(float (*to)[3],
+                                         const fmatrix3x3 *from,
+                                         const BlockGather *gather,
+                                         const lfVector *fLongVector)
+{
+  const uint vcount = from[0].vcount;
+  BlockGatherMulData data = {
+      .to = to,
+      .matrix = from,
+      .gather = gather,
+      .vector = fLongVector,
+  };
 
-  del_lfvector(temp);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = vcount > CLOTH_PARALLEL_LIMIT;
+  settings.min_iter_per_thread = CLOTH_PARALLEL_LIMIT;
+  BLI_task_parallel_range(0, (int)vcount, &data, mul_bfmatrix_lfvector_gather_cb, &settings);
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+{
+  BlockGather gather;
+  block_gather_init(&gather, from, from[0].vcount + from[0].scount);
+  mul_bfmatrix_lfvector_gather(to, from, &gather, fLongVector);
+  block_gather_free(&gather);
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
+typedef struct SubaddBlocksData {
+  fmatrix3x3 *to;
+  const fmatrix3x3 *from;
+  const fmatrix3x3 *matrix;
+  float aS, bS;
+} SubaddBlocksData;
+
+static void subadd_bfmatrixS_bfmatrixS_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SubaddBlocksData *data = userdata;
+  subadd_fmatrixS_fmatrixS(data->to[i].m, data->from[i].m, data->aS, data->matrix[i].m, data->bS);
+}
+
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
 DO_INLINE void subadd_bfmatrixS_bfmatrixS(
     fmatrix3x3 *to, fmatrix3x3 *from, float aS, fmatrix3x3 *matrix, float bS)
 {
-  uint i = 0;
-
-  /* process diagonal elements */
-  for (i = 0; i < matrix[0].vcount + matrix[0].scount; i++) {
-    subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
-  }
+  /* Every block is computed on its own, so they can be split over threads. */
+  SubaddBlocksData data = {
+      .to = to,
+      .from = from,
+      .matrix = matrix,
+      .aS = aS,
+      .bS = bS,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = matrix[0].vcount > CLOTH_PARALLEL_LIMIT;
+  settings.min_iter_per_thread = CLOTH_PARALLEL_LIMIT;
+  BLI_task_parallel_range(0,
+                          (int)(matrix[0].vcount + matrix[0].scount),
+                          &data,
+                          subadd_bfmatrixS_bfmatrixS_cb,
+                          &settings);
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -820,11 +929,37 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 }
 #  endif
 
+/* Block-Jacobi pre-conditioner: the inverse of the diagonal blocks of A. Blocks which can not be
+ * inverted, or are not positive along their diagonal, fall back to the identity which keeps the
+ * pre-conditioner positive definite. */
+static void build_block_jacobi(const fmatrix3x3 *lA, fmatrix3x3 *Pinv)
+{
+  for (uint i = 0; i < lA[0].vcount; i++) {
+    const float(*m)[3] = lA[i].m;
+    if (m[0][0] <= 0.0f || m[1][1] <= 0.0f || m[2][2] <= 0.0f ||
+        !invert_m3_m3(Pinv[i].m, lA[i].m)) {
+      unit_m3(Pinv[i].m);
+    }
+  }
+}
+
+/* Multiply the diagonal blocks of the big matrix with the long vector. */
+DO_INLINE void mul_bfmatrix_diag_lfvector(float (*to)[3],
+                                          const fmatrix3x3 *from,
+                                          const lfVector *fLongVector)
+{
+  for (uint i = 0; i < from[0].vcount; i++) {
+    mul_v3_m3v3(to[i], from[i].m, fLongVector[i]);
+  }
+}
+
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BlockGather *gather,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
+                       fmatrix3x3 *Pinv,
                        ImplicitSolverResult *result)
 {
   /* Solves for unknown X in equation AX=B */
@@ -842,19 +977,22 @@ static int cg_filtered(lfVector *ldV,
 
   cp_lfvector(ldV, z, numverts);
 
-  /* d0 = filter(B)^T * P * filter(B) */
+  build_block_jacobi(lA, Pinv);
+
+  /* d0 = filter(B)^T * P^-1 * filter(B) */
   cp_lfvector(fB, lB, numverts);
   filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
+  mul_bfmatrix_diag_lfvector(s, Pinv, fB);
+  bnorm2 = dot_lfvector(fB, s, numverts);
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_gather(AdV, lA, gather, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
   /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
+  mul_bfmatrix_diag_lfvector(c, Pinv, r);
   filter(c, S);
 
   /* delta = r^T * c */
@@ -872,7 +1010,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_gather(q, lA, gather, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -882,7 +1020,7 @@ static int cg_filtered(lfVector *ldV,
     add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
 
     /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
+    mul_bfmatrix_diag_lfvector(s, Pinv, r);
     delta_old = delta_new;
     delta_new = dot_lfvector(r, s, numverts);
 
@@ -1132,7 +1270,11 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* Only the blocks added for the current step are non-zero. */
+  BlockGather gather;
+  block_gather_init(&gather, data->A, numverts + (uint)data->num_blocks);
+
+  mul_bfmatrix_lfvector_gather(dFdXmV, data->dFdX, &gather, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1141,7 +1283,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &gather, data->B, data->z, data->S, data->Pinv, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1154,6 +1296,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
   del_lfvector(dFdXmV);
+  block_gather_free(&gather);
 
   return result->status == SIM_SOLVER_SUCCESS;
 }
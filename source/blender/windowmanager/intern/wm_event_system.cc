@@ -36,6 +36,7 @@
 #include "BKE_customdata.h"
 #include "BKE_global.h"
 #include "BKE_idprop.h"
+#include "BKE_image.h"
 #include "BKE_lib_remap.h"
 #include "BKE_main.h"
 #include "BKE_report.h"
@@ -498,6 +499,11 @@ void wm_event_do_notifiers(bContext *C)
     return;
   }
 
+  /* Redraw views which used placeholders for images that were loaded in the background. */
+  if (BKE_image_async_load_finished_pop()) {
+    WM_main_add_notifier(NC_IMAGE | ND_DRAW, nullptr);
+  }
+
   /* Disable? - Keep for now since its used for window level notifiers. */
 #if 1
   /* Cache & catch WM level notifiers, such as frame change, scene/screen set. */
@@ -3889,6 +3895,20 @@ void wm_event_do_handlers(bContext *C)
         continue;
       }
 
+      /* Motion events that were followed by another one (see #wm_event_add_mousemove) are only
+       * used by modal handlers, e.g. paint strokes that want the full history. High rate mice and
+       * tablets send many of them per redraw, skip the regular handling when nothing uses them. */
+      if ((event->type == INBETWEEN_MOUSEMOVE) && BLI_listbase_is_empty(&win->modalhandlers)) {
+        /* Keep the motion since the last handled event. */
+        wmEvent *event_next = event->next;
+        if (event_next && ISMOUSE_MOTION(event_next->type)) {
+          copy_v2_v2_int(event_next->prev_xy, event->prev_xy);
+        }
+        BLI_remlink(&win->event_queue, event);
+        wm_event_free_last_handled(win, event);
+        continue;
+      }
+
       CTX_wm_window_set(C, win);
 
 #ifdef WITH_XR_OPENXR
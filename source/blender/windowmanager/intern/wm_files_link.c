@@ -130,6 +130,10 @@ static int wm_link_append_flag(wmOperator *op)
   }
   if (RNA_boolean_get(op->ptr, "link")) {
     flag |= FILE_LINK;
+    if ((prop = RNA_struct_find_property(op->ptr, "defer_hidden_data")) &&
+        RNA_property_boolean_get(op->ptr, prop)) {
+      flag |= BLO_LIBLINK_DEFER_HIDDEN_OBDATA;
+    }
   }
   else {
     if (RNA_boolean_get(op->ptr, "use_recursive")) {
@@ -450,6 +454,12 @@ void WM_OT_link(wmOperatorType *ot)
                                  FILE_SORT_DEFAULT);
 
   wm_link_append_properties_common(ot, true);
+  RNA_def_boolean(ot->srna,
+                  "defer_hidden_data",
+                  false,
+                  "Defer Hidden Data",
+                  "Do not load the geometry of indirectly linked objects which are hidden or in "
+                  "excluded collections, until they become visible");
 }
 
 void WM_OT_append(wmOperatorType *ot)
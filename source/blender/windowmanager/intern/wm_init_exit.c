@@ -481,6 +481,9 @@ void WM_exit_ex(bContext *C, const bool do_python)
     }
   }
 
+  /* Write the memory profile before any data is freed. */
+  MEM_profiler_exit();
+
 #if defined(WITH_PYTHON) && !defined(WITH_PYTHON_MODULE)
   /* Without this, we there isn't a good way to manage false-positive resource leaks
    * where a #PyObject references memory allocated with guarded-alloc, T71362.
@@ -542,6 +545,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
 #endif
 
   BKE_subdiv_exit();
+  BKE_image_async_load_exit();
 
   if (opengl_is_init) {
     BKE_image_free_unused_gpu_textures();
@@ -67,6 +67,10 @@ static void wm_xr_session_create_cb(void)
     settings->base_scale = 1.0f;
   }
   state->prev_base_scale = settings->base_scale;
+
+  if (settings->resolution_scale < FLT_EPSILON) {
+    settings->resolution_scale = 1.0f;
+  }
 }
 
 static void wm_xr_session_controller_data_free(wmXrSessionState *state)
@@ -1317,6 +1321,8 @@ static void wm_xr_session_surface_draw(bContext *C)
   // BLI_assert(DEG_is_fully_evaluated(depsgraph));
   wm_xr_session_draw_data_populate(&wm->xr, scene, depsgraph, &draw_data);
 
+  GHOST_XrSessionSetResolutionScale(wm->xr.runtime->context,
+                                    wm->xr.session_settings.resolution_scale);
   GHOST_XrSessionDrawViews(wm->xr.runtime->context, &draw_data);
 
   /* There's no active frame-buffer if the session was canceled (exception while drawing views). */
@@ -1354,8 +1360,8 @@ bool wm_xr_session_surface_offscreen_ensure(wmXrSurfaceData *surface_data,
 
   GPUOffScreen *offscreen = vp->offscreen;
   GPUViewport *viewport = vp->viewport;
-  const bool size_changed = offscreen && (GPU_offscreen_width(offscreen) != draw_view->width) &&
-                            (GPU_offscreen_height(offscreen) != draw_view->height);
+  const bool size_changed = offscreen && ((GPU_offscreen_width(offscreen) != draw_view->width) ||
+                                          (GPU_offscreen_height(offscreen) != draw_view->height));
   if (offscreen) {
     BLI_assert(viewport);
 
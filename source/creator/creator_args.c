@@ -56,6 +56,8 @@
 
 #  include "ED_datafiles.h"
 
+#  include "io_convert.h"
+
 #  include "WM_api.h"
 
 #  ifdef WITH_LIBMV
@@ -495,6 +497,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   printf("Render Options:\n");
   BLI_args_print_arg_doc(ba, "--background");
   BLI_args_print_arg_doc(ba, "--render-anim");
+  BLI_args_print_arg_doc(ba, "--render-server");
   BLI_args_print_arg_doc(ba, "--scene");
   BLI_args_print_arg_doc(ba, "--render-frame");
   BLI_args_print_arg_doc(ba, "--frame-start");
@@ -538,6 +541,10 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--python-use-system-env");
   BLI_args_print_arg_doc(ba, "--addons");
 
+  printf("\n");
+  printf("Import Options:\n");
+  BLI_args_print_arg_doc(ba, "--import-convert");
+
   printf("\n");
   printf("Logging Options:\n");
   BLI_args_print_arg_doc(ba, "--log");
@@ -565,6 +572,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-cycles");
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-memory");
+  BLI_args_print_arg_doc(ba, "--memory-profile");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
@@ -572,6 +580,8 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-build");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-tag");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-no-threads");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-priority");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-profile");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uuid");
@@ -988,6 +998,9 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_eval[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_no_threads[] =
     "\n\t"
     "Switch dependency graph to a single threaded evaluation.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_priority[] =
+    "\n\t"
+    "Schedule dependency graph operations on the longest chain of dependent operations first.";
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_pretty[] =
     "\n\t"
     "Enable colors for dependency graph debug messages.";
@@ -1075,6 +1088,29 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_memory_profile_set_doc[] =
+    "<sample_interval> <filepath>\n"
+    "\tSample every <sample_interval>-th memory allocation of each thread and write the samples\n"
+    "\twhich are still allocated to <filepath> on exit, as comma separated values.\n"
+    "\tMust come before arguments that render or run scripts.";
+static int arg_handle_memory_profile_set(int argc, const char **argv, void *UNUSED(data))
+{
+  const char *arg_id = "--memory-profile";
+  if (argc > 2) {
+    const char *err_msg = NULL;
+    int sample_interval;
+    if (!parse_int_clamp(argv[1], NULL, 1, INT_MAX, &sample_interval, &err_msg)) {
+      printf("\nError: %s '%s %s'.\n", err_msg, arg_id, argv[1]);
+      return 2;
+    }
+    MEM_profiler_exit_filepath_set(argv[2]);
+    MEM_profiler_start((uint)sample_interval);
+    return 2;
+  }
+  printf("\nError: you must specify a sample interval and a filepath after '%s'.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -1097,6 +1133,23 @@ static int arg_handle_debug_value_set(int argc, const char **argv, void *UNUSED(
   return 0;
 }
 
+static const char arg_handle_debug_depsgraph_profile_set_doc[] =
+    "<filepath>\n"
+    "\tRecord start and end time of every evaluated dependency graph operation and write them\n"
+    "\tto <filepath> on exit, using the Chrome trace event format (viewable in Perfetto).";
+static int arg_handle_debug_depsgraph_profile_set(int argc,
+                                                  const char **argv,
+                                                  void *UNUSED(data))
+{
+  if (argc > 1) {
+    G.debug |= G_DEBUG_DEPSGRAPH_PROFILE;
+    DEG_debug_eval_profile_filepath_set(argv[1]);
+    return 1;
+  }
+  printf("\nError: you must specify a filepath to write the dependency graph profile to.\n");
+  return 0;
+}
+
 static const char arg_handle_debug_gpu_set_doc[] =
     "\n"
     "\tEnable GPU debug context and information for OpenGL 4.3+.";
@@ -1649,6 +1702,41 @@ static int arg_handle_render_animation(int UNUSED(argc), const char **UNUSED(arg
   return 0;
 }
 
+static const char arg_handle_render_server_doc[] =
+    "<port>\n"
+    "\tKeep running and render frames requested over a local TCP connection on <port>.\n"
+    "\tThe loaded blend-file is reused for all frames, see the 'bl_render_server' Python module\n"
+    "\tfor the protocol.";
+static int arg_handle_render_server(int argc, const char **argv, void *data)
+{
+  const char *arg_id = "--render-server";
+  if (argc > 1) {
+#  ifdef WITH_PYTHON
+    bContext *C = data;
+    const char *err_msg = NULL;
+    int port;
+    if (!parse_int_clamp(argv[1], NULL, 1, 65535, &port, &err_msg)) {
+      printf("\nError: %s '%s %s'.\n", err_msg, arg_id, argv[1]);
+      return 1;
+    }
+    if (CTX_data_scene(C) == NULL) {
+      printf("\nError: no blend loaded. cannot use '%s'.\n", arg_id);
+      return 1;
+    }
+    char script_str[64];
+    BLI_snprintf(
+        script_str, sizeof(script_str), "__import__('bl_render_server').serve(%d)", port);
+    BPY_CTX_SETUP(BPY_run_string_exec(C, NULL, script_str));
+#  else
+    UNUSED_VARS(data);
+    printf("This Blender was built without Python support\n");
+#  endif /* WITH_PYTHON */
+    return 1;
+  }
+  printf("\nError: you must specify a port after '%s'.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_scene_set_doc[] =
     "<name>\n"
     "\tSet the active scene <name> for rendering.";
@@ -1962,6 +2050,36 @@ static int arg_handle_addons_set(int argc, const char **argv, void *data)
   return 0;
 }
 
+static const char arg_handle_import_convert_doc[] =
+    "<file(s)>\n"
+    "\tImport each file with the importer for its extension, and save it as a blend-file with\n"
+    "\tthe same name next to it. All files following the option are converted, in one session.\n"
+    "\tIn background mode, Blender exits with a non-zero exit code when any file fails.";
+static int arg_handle_import_convert(int argc, const char **argv, void *data)
+{
+  bContext *C = data;
+  int filepaths_len = 0;
+  while (filepaths_len + 1 < argc && argv[filepaths_len + 1][0] != '-') {
+    filepaths_len++;
+  }
+  if (filepaths_len == 0) {
+    printf("\nError: you must specify one or more files after '--import-convert'.\n");
+    if (G.background) {
+      G.is_break = true;
+      return -1;
+    }
+    return 0;
+  }
+  const int failed_len = ED_io_convert_files_to_blend(C, &argv[1], filepaths_len);
+  if (failed_len != 0 && G.background) {
+    /* Stop processing arguments, like for a file that fails to load, so that scripts running the
+     * conversion get a non-zero exit code. */
+    G.is_break = true;
+    return -1;
+  }
+  return filepaths_len;
+}
+
 static int arg_handle_load_file(int UNUSED(argc), const char **argv, void *data)
 {
   bContext *C = data;
@@ -2167,6 +2285,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-cycles", CB(arg_handle_debug_mode_cycles), NULL);
 #  endif
   BLI_args_add(ba, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
+  BLI_args_add(ba, NULL, "--memory-profile", CB(arg_handle_memory_profile_set), NULL);
 
   BLI_args_add(ba, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
   BLI_args_add(ba,
@@ -2207,6 +2326,13 @@ void main_args_setup(bContext *C, bArgs *ba)
                "--debug-depsgraph-no-threads",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_no_threads),
                (void *)G_DEBUG_DEPSGRAPH_NO_THREADS);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-depsgraph-priority",
+               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_priority),
+               (void *)G_DEBUG_DEPSGRAPH_PRIORITY);
+  BLI_args_add(
+      ba, NULL, "--debug-depsgraph-profile", CB(arg_handle_debug_depsgraph_profile_set), NULL);
   BLI_args_add(ba,
                NULL,
                "--debug-depsgraph-pretty",
@@ -2256,6 +2382,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_pass_set(ba, ARG_PASS_FINAL);
   BLI_args_add(ba, "-f", "--render-frame", CB(arg_handle_render_frame), C);
   BLI_args_add(ba, "-a", "--render-anim", CB(arg_handle_render_animation), C);
+  BLI_args_add(ba, NULL, "--render-server", CB(arg_handle_render_server), C);
   BLI_args_add(ba, "-S", "--scene", CB(arg_handle_scene_set), C);
   BLI_args_add(ba, "-s", "--frame-start", CB(arg_handle_frame_start_set), C);
   BLI_args_add(ba, "-e", "--frame-end", CB(arg_handle_frame_end_set), C);
@@ -2266,6 +2393,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--python-console", CB(arg_handle_python_console_run), C);
   BLI_args_add(ba, NULL, "--python-exit-code", CB(arg_handle_python_exit_code_set), NULL);
   BLI_args_add(ba, NULL, "--addons", CB(arg_handle_addons_set), C);
+  BLI_args_add(ba, NULL, "--import-convert", CB(arg_handle_import_convert), C);
 
   BLI_args_add(ba, "-o", "--render-output", CB(arg_handle_output_set), C);
   BLI_args_add(ba, "-E", "--engine", CB(arg_handle_engine_set), C);
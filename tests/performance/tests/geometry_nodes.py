@@ -0,0 +1,63 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _frame_time(min_time):
+    # Average time to evaluate a frame of the scene's frame range.
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    start_time = time.perf_counter()
+    elapsed_time = 0.0
+    num_frames = 0
+    while elapsed_time < min_time:
+        for i in range(scene.frame_start, scene.frame_end + 1):
+            scene.frame_set(i)
+
+        num_frames += scene.frame_end + 1 - scene.frame_start
+        elapsed_time = time.perf_counter() - start_time
+
+    return elapsed_time / num_frames
+
+
+def _run(args):
+    import bpy
+
+    # Time the frames with and without geometry nodes modifiers, to separate the node evaluation
+    # from the rest of the scene evaluation, e.g. drivers, other modifiers and simulations.
+    frame_time = _frame_time(10.0)
+
+    modifiers = [md for ob in bpy.context.scene.objects for md in ob.modifiers
+                 if md.type == 'NODES' and md.show_viewport]
+    for md in modifiers:
+        md.show_viewport = False
+    frame_time_without_nodes = _frame_time(2.0)
+
+    result = {
+        'time': frame_time,
+        'time_nodes': max(frame_time - frame_time_without_nodes, 0.0),
+    }
+    return result
+
+
+class GeometryNodesTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('geometry_nodes/*')
+    return [GeometryNodesTest(filepath) for filepath in filepaths]
@@ -0,0 +1,198 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Benchmarks of individual kernels on generated data, so regressions in them are not hidden
+# behind the time it takes to load and evaluate whole scenes.
+
+import api
+
+
+def _create_grid(subdivisions):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=subdivisions, y_subdivisions=subdivisions)
+    return bpy.context.object
+
+
+def _create_nodes_modifier(ob, name):
+    import bpy
+
+    group = bpy.data.node_groups.new(name, 'GeometryNodeTree')
+    group.inputs.new('NodeSocketGeometry', "Geometry")
+    group.outputs.new('NodeSocketGeometry', "Geometry")
+    modifier = ob.modifiers.new(name, 'NODES')
+    modifier.node_group = group
+    nodes = group.nodes
+    return group, nodes.new('NodeGroupInput'), nodes.new('NodeGroupOutput')
+
+
+def _time_iterations(setup, measure, min_time=5.0):
+    # Run the measured function until the minimum time is reached, and return the average time of
+    # one iteration. The setup function is called before every iteration but not timed.
+    import time
+
+    elapsed_time = 0.0
+    num_iterations = 0
+    while elapsed_time < min_time:
+        setup(num_iterations)
+        start_time = time.perf_counter()
+        measure()
+        elapsed_time += time.perf_counter() - start_time
+        num_iterations += 1
+
+    return {'time': elapsed_time / num_iterations}
+
+
+def _run_mesh_normals(args):
+    import array
+
+    mesh = _create_grid(1000).data
+    num_verts = len(mesh.vertices)
+    positions = array.array('f', [0.0]) * (num_verts * 3)
+    mesh.vertices.foreach_get("co", positions)
+    normals = array.array('f', [0.0]) * (num_verts * 3)
+
+    def setup(i):
+        # Setting positions tags the normals dirty.
+        positions[2] = i * 1e-4
+        mesh.vertices.foreach_set("co", positions)
+
+    def measure():
+        mesh.vertex_normals.foreach_get("vector", normals)
+
+    return _time_iterations(setup, measure)
+
+
+def _run_mesh_calc_edges(args):
+    mesh = _create_grid(1000).data
+
+    def measure():
+        mesh.update(calc_edges=True)
+
+    return _time_iterations(lambda i: None, measure)
+
+
+def _run_bvh_tree(args):
+    import bpy
+    from mathutils.bvhtree import BVHTree
+
+    ob = _create_grid(1000)
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+
+    def measure():
+        BVHTree.FromObject(ob, depsgraph)
+
+    return _time_iterations(lambda i: None, measure)
+
+
+def _run_realize_instances(args):
+    import bpy
+
+    ob = _create_grid(300)
+    group, group_input, group_output = _create_nodes_modifier(ob, "Realize Instances")
+    nodes = group.nodes
+    cube = nodes.new('GeometryNodeMeshCube')
+    instance = nodes.new('GeometryNodeInstanceOnPoints')
+    realize = nodes.new('GeometryNodeRealizeInstances')
+    group.links.new(group_input.outputs[0], instance.inputs['Points'])
+    group.links.new(cube.outputs['Mesh'], instance.inputs['Instance'])
+    group.links.new(instance.outputs['Instances'], realize.inputs['Geometry'])
+    group.links.new(realize.outputs['Geometry'], group_output.inputs[0])
+
+    def setup(i):
+        # Change the input, so that the result of the previous iteration can't be reused.
+        cube.inputs['Size'].default_value = [0.01 + i * 1e-5] * 3
+
+    def measure():
+        bpy.context.view_layer.update()
+
+    return _time_iterations(setup, measure)
+
+
+def _run_field_evaluation(args):
+    import bpy
+
+    ob = _create_grid(1000)
+    group, group_input, group_output = _create_nodes_modifier(ob, "Field Evaluation")
+    nodes = group.nodes
+    position = nodes.new('GeometryNodeInputPosition')
+    set_position = nodes.new('GeometryNodeSetPosition')
+    group.links.new(group_input.outputs[0], set_position.inputs['Geometry'])
+    group.links.new(set_position.outputs['Geometry'], group_output.inputs[0])
+
+    # A chain of operations that is evaluated with a procedure of multi-functions.
+    socket = position.outputs['Position']
+    for operation in ('SINE', 'SCALE', 'COSINE', 'SCALE', 'SINE'):
+        vector_math = nodes.new('ShaderNodeVectorMath')
+        vector_math.operation = operation
+        group.links.new(socket, vector_math.inputs[0])
+        socket = vector_math.outputs['Vector']
+    group.links.new(socket, set_position.inputs['Offset'])
+    scale_nodes = [node for node in nodes if getattr(node, "operation", None) == 'SCALE']
+
+    def setup(i):
+        for node in scale_nodes:
+            node.inputs['Scale'].default_value = 1.0 + i * 1e-5
+
+    def measure():
+        bpy.context.view_layer.update()
+
+    return _time_iterations(setup, measure)
+
+
+def _run_import(args):
+    import bpy
+    import os
+    import tempfile
+
+    _create_grid(500)
+    filepath = os.path.join(tempfile.mkdtemp(), "kernels." + args['format'])
+    if args['format'] == 'obj':
+        bpy.ops.wm.obj_export(filepath=filepath)
+        import_fn = bpy.ops.wm.obj_import
+    else:
+        bpy.ops.wm.stl_export(filepath=filepath)
+        import_fn = bpy.ops.wm.stl_import
+
+    def setup(i):
+        # Remove the mesh from the previous iteration.
+        for ob in bpy.data.objects:
+            bpy.data.objects.remove(ob)
+        for mesh in bpy.data.meshes:
+            bpy.data.meshes.remove(mesh)
+
+    def measure():
+        import_fn(filepath=filepath)
+
+    result = _time_iterations(setup, measure)
+    os.remove(filepath)
+    return result
+
+
+class KernelTest(api.Test):
+    def __init__(self, name, function, args={}):
+        self._name = name
+        self.function = function
+        self.args = args
+
+    def name(self):
+        return self._name
+
+    def category(self):
+        return "kernels"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(self.function, self.args)
+        return result
+
+
+def generate(env):
+    return [
+        KernelTest("mesh_normals", _run_mesh_normals),
+        KernelTest("mesh_calc_edges", _run_mesh_calc_edges),
+        KernelTest("bvh_tree", _run_bvh_tree),
+        KernelTest("realize_instances", _run_realize_instances),
+        KernelTest("field_evaluation", _run_field_evaluation),
+        KernelTest("obj_import", _run_import, {'format': 'obj'}),
+        KernelTest("stl_import", _run_import, {'format': 'stl'}),
+    ]
@@ -0,0 +1,98 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _evaluation_time(min_time=5.0):
+    # Average time to evaluate the scene after all objects with modifiers are tagged for update.
+    import bpy
+    import time
+
+    objects = [ob for ob in bpy.context.scene.objects if ob.modifiers]
+    elapsed_time = 0.0
+    num_iterations = 0
+    while elapsed_time < min_time:
+        for ob in objects:
+            ob.update_tag(refresh={'DATA'})
+        start_time = time.perf_counter()
+        bpy.context.view_layer.update()
+        elapsed_time += time.perf_counter() - start_time
+        num_iterations += 1
+
+    return elapsed_time / num_iterations
+
+
+def _edit_mode_time(min_time=5.0):
+    # Average time to enter and exit edit mode on the active object.
+    import bpy
+    import time
+
+    ob = bpy.context.view_layer.objects.active
+    if ob is None or ob.type != 'MESH':
+        return 0.0
+
+    elapsed_time = 0.0
+    num_iterations = 0
+    while elapsed_time < min_time:
+        start_time = time.perf_counter()
+        bpy.ops.object.mode_set(mode='EDIT')
+        bpy.ops.object.mode_set(mode='OBJECT')
+        elapsed_time += time.perf_counter() - start_time
+        num_iterations += 1
+
+    return elapsed_time / num_iterations
+
+
+def _run(args):
+    import bpy
+
+    # Break down the evaluation time per modifier type, by enabling the modifiers of the stacks one
+    # after another and attributing the extra time to the type of the enabled modifier.
+    breakdown = {'SUBSURF': 0.0, 'BOOLEAN': 0.0, 'NODES': 0.0}
+    other_time = 0.0
+
+    modifiers = [md for ob in bpy.context.scene.objects for md in ob.modifiers if md.show_viewport]
+    for md in modifiers:
+        md.show_viewport = False
+    previous_time = _evaluation_time(min_time=1.0)
+    base_time = previous_time
+
+    for md in modifiers:
+        md.show_viewport = True
+        current_time = _evaluation_time(min_time=1.0)
+        if md.type in breakdown:
+            breakdown[md.type] += current_time - previous_time
+        else:
+            other_time += current_time - previous_time
+        previous_time = current_time
+
+    result = {
+        'time': _evaluation_time(),
+        'time_subsurf': breakdown['SUBSURF'],
+        'time_boolean': breakdown['BOOLEAN'],
+        'time_nodes': breakdown['NODES'],
+        'time_other': other_time + base_time,
+        'time_edit_mode': _edit_mode_time(),
+    }
+    return result
+
+
+class ModifiersTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "modifiers"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('modifiers/*')
+    return [ModifiersTest(filepath) for filepath in filepaths]